@@ -0,0 +1,108 @@
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# SPDX-FileCopyrightText: 2010-2022 C. Fernandez-Prades cfernandez(at)cttc.es
+# SPDX-License-Identifier: BSD-3-Clause
+
+# - Find Zstandard
+# Find the Zstandard includes and library
+# https://facebook.github.io/zstd/
+#
+# The environment variable ZSTD_ROOT allows to specify where to find
+# libzstd in non standard location.
+#
+#  ZSTD_INCLUDE_DIRS - where to find zstd.h, etc.
+#  ZSTD_LIBRARIES   - List of libraries when using zstd.
+#  ZSTD_FOUND       - True if zstd found.
+#
+# Provides the following imported target:
+# Zstd::zstd
+#
+
+if(NOT COMMAND feature_summary)
+    include(FeatureSummary)
+endif()
+
+if(NOT PKG_CONFIG_FOUND)
+    include(FindPkgConfig)
+endif()
+
+pkg_check_modules(PC_ZSTD libzstd QUIET)
+
+if(NOT ZSTD_ROOT)
+    set(ZSTD_ROOT_USER_PROVIDED /usr)
+else()
+    set(ZSTD_ROOT_USER_PROVIDED ${ZSTD_ROOT})
+endif()
+if(DEFINED ENV{ZSTD_ROOT})
+    set(ZSTD_ROOT_USER_PROVIDED
+        ${ZSTD_ROOT_USER_PROVIDED}
+        $ENV{ZSTD_ROOT}
+    )
+endif()
+
+find_path(ZSTD_INCLUDE_DIR
+    NAMES
+        zstd.h
+    HINTS
+        ${PC_ZSTD_INCLUDEDIR}
+    PATHS
+        ${ZSTD_ROOT_USER_PROVIDED}/include
+        /usr/include
+        /usr/local/include
+        /opt/local/include
+)
+
+find_library(ZSTD_LIBRARY
+    NAMES
+        zstd
+    HINTS
+        ${PC_ZSTD_LIBDIR}
+    PATHS
+        ${ZSTD_ROOT_USER_PROVIDED}/lib
+        ${ZSTD_ROOT_USER_PROVIDED}/lib64
+        /usr/lib
+        /usr/lib64
+        /usr/lib/x86_64-linux-gnu
+        /usr/lib/aarch64-linux-gnu
+        /usr/lib/arm-linux-gnueabihf
+        /usr/local/lib
+        /usr/local/lib64
+        /opt/local/lib
+)
+
+set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD DEFAULT_MSG ZSTD_INCLUDE_DIRS ZSTD_LIBRARIES)
+
+if(ZSTD_FOUND AND PC_ZSTD_VERSION)
+    set(ZSTD_VERSION ${PC_ZSTD_VERSION})
+endif()
+
+set_package_properties(ZSTD PROPERTIES
+    URL "https://facebook.github.io/zstd/"
+)
+
+if(ZSTD_FOUND AND ZSTD_VERSION)
+    set_package_properties(ZSTD PROPERTIES
+        DESCRIPTION "Fast real-time lossless compression library (found: v${ZSTD_VERSION})"
+    )
+else()
+    set_package_properties(ZSTD PROPERTIES
+        DESCRIPTION "Fast real-time lossless compression library"
+    )
+endif()
+
+if(ZSTD_FOUND AND NOT TARGET Zstd::zstd)
+    add_library(Zstd::zstd SHARED IMPORTED)
+    set_target_properties(Zstd::zstd PROPERTIES
+        IMPORTED_LINK_INTERFACE_LANGUAGES "CXX"
+        IMPORTED_LOCATION "${ZSTD_LIBRARIES}"
+        INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIRS}"
+        INTERFACE_LINK_LIBRARIES "${ZSTD_LIBRARIES}"
+    )
+endif()
+
+mark_as_advanced(ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
@@ -27,7 +27,9 @@
 #include "pvt_conf.h"                  // for Pvt_Conf
 #include "rtklib_rtkpos.h"             // for rtkfree, rtkinit
 #include <glog/logging.h>              // for LOG
+#include <algorithm>                   // for std::remove
 #include <iostream>                    // for std::cout
+#include <sstream>                     // for std::stringstream
 #if USE_OLD_BOOST_MATH_COMMON_FACTOR
 #include <boost/math/common_factor_rt.hpp>
 namespace bc = boost::math;
@@ -66,6 +68,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
 
     pvt_output_parameters.output_rate_ms = bc::lcm(static_cast<int>(pvt_output_parameters.observable_interval_ms), configuration->property(role + ".output_rate_ms", 500));
 
+    // skip the observable epochs far from an output, for high rate observables
+    pvt_output_parameters.decimate_epochs = configuration->property(role + ".decimate_epochs", pvt_output_parameters.decimate_epochs);
+
     // display rate
     pvt_output_parameters.display_rate_ms = bc::lcm(pvt_output_parameters.output_rate_ms, configuration->property(role + ".display_rate_ms", 500));
 
@@ -97,6 +102,8 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.flag_rtcm_server = configuration->property(role + ".flag_rtcm_server", false);
     pvt_output_parameters.rtcm_tcp_port = configuration->property(role + ".rtcm_tcp_port", 2101);
     pvt_output_parameters.rtcm_station_id = configuration->property(role + ".rtcm_station_id", 1234);
+    pvt_output_parameters.rtcm_ntrip_port = configuration->property(role + ".rtcm_ntrip_port", 0);
+    pvt_output_parameters.rtcm_ntrip_mountpoint = configuration->property(role + ".rtcm_ntrip_mountpoint", pvt_output_parameters.rtcm_ntrip_mountpoint);
     // RTCM message rates: least common multiple with output_rate_ms
     const int rtcm_MT1019_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1019_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
     const int rtcm_MT1020_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1020_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
@@ -479,6 +486,39 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
             positioning_mode = PMODE_SINGLE;
         }
 
+    // Additional solvers, e.g. PVT.extra_positioning_modes=Single,PPP_Kinematic
+    const std::string extra_positioning_modes_str = configuration->property(role + ".extra_positioning_modes", std::string(""));
+    std::stringstream extra_positioning_modes_ss(extra_positioning_modes_str);
+    std::string extra_mode_str;
+    while (std::getline(extra_positioning_modes_ss, extra_mode_str, ','))
+        {
+            extra_mode_str.erase(std::remove(extra_mode_str.begin(), extra_mode_str.end(), ' '), extra_mode_str.end());
+            if (extra_mode_str == "Single")
+                {
+                    pvt_output_parameters.extra_positioning_modes.push_back(PMODE_SINGLE);
+                }
+            else if (extra_mode_str == "Static")
+                {
+                    pvt_output_parameters.extra_positioning_modes.push_back(PMODE_STATIC);
+                }
+            else if (extra_mode_str == "Kinematic")
+                {
+                    pvt_output_parameters.extra_positioning_modes.push_back(PMODE_KINEMA);
+                }
+            else if (extra_mode_str == "PPP_Static")
+                {
+                    pvt_output_parameters.extra_positioning_modes.push_back(PMODE_PPP_STATIC);
+                }
+            else if (extra_mode_str == "PPP_Kinematic")
+                {
+                    pvt_output_parameters.extra_positioning_modes.push_back(PMODE_PPP_KINEMA);
+                }
+            else if (!extra_mode_str.empty())
+                {
+                    std::cout << "WARNING: Bad specification of extra positioning mode " << extra_mode_str << ", ignored.\n";
+                }
+        }
+
     int num_bands = 0;
 
     if ((gps_1C_count > 0) || (gal_1B_count > 0) || (gal_E6_count > 0) || (glo_1G_count > 0) || (bds_B1_count > 0))
@@ -617,6 +657,10 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     The excluded satellite is selected to indicate the minimum SSE. */
     const int raim_fde = configuration->property(role + ".raim_fde", 0);
 
+    /* Number of threads that solve the positions without each satellite in the RAIM FDE.
+    The excluded satellite is the same with any number of threads. */
+    const int raim_fde_threads = configuration->property(role + ".raim_fde_threads", 1);
+
     const int earth_tide = configuration->property(role + ".earth_tide", 0);
 
     int nsys = 0;
@@ -705,6 +749,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     const double min_elevation_to_fix_ambiguity = configuration->property(role + ".min_elevation_to_fix_ambiguity", 0.0); /* Set the minimum elevation (deg) to fix integer ambiguity.
                                                                                                                         If the elevation of the satellite is less than the value, the ambiguity is excluded from the fixed integer vector. */
 
+    const int max_iter_to_fix_ambiguity = configuration->property(role + ".max_iter_to_fix_ambiguity", 1); /* Set the maximum number of ratio-tests in an epoch. If the test fails,
+                                                                                                              the ambiguity of the lowest satellite is left float and the rest are tested again. */
+
     const int outage_reset_ambiguity = configuration->property(role + ".outage_reset_ambiguity", 5); /* Set the outage count to reset ambiguity. If the data outage count is over the value, the estimated ambiguity is reset to the initial value.  */
 
     const double slip_threshold = configuration->property(role + ".slip_threshold", 0.05); /* set the cycle‐slip threshold (m) of geometry‐free LC carrier‐phase difference between epochs */
@@ -761,7 +808,7 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         outage_reset_ambiguity,                                                            /* obs outage count to reset bias */
         min_lock_to_fix_ambiguity,                                                         /* min lock count to fix ambiguity */
         10,                                                                                /* min fix count to hold ambiguity */
-        1,                                                                                 /* max iteration to resolve ambiguity */
+        max_iter_to_fix_ambiguity,                                                         /* max iteration to resolve ambiguity */
         iono_model,                                                                        /* ionosphere option (IONOOPT_XXX) */
         trop_model,                                                                        /* troposphere option (TROPOPT_XXX) */
         dynamics_model,                                                                    /* dynamics model (0:none, 1:velocity, 2:accel) */
@@ -803,7 +850,8 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {{}, {}},                                                                          /* odisp[2][6*11] ocean tide loading parameters {rov,base} */
         {{}, {{}, {}}, {{}, {}}, {}, {}},                                                  /* exterr_t exterr   extended receiver error model */
         0,                                                                                 /* disable L2-AR */
-        {}                                                                                 /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        {},                                                                                /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        raim_fde_threads                                                                   /* int raimthreads  threads of the RAIM FDE (0,1: calling thread only) */
     };
 
     rtkinit(&rtk, &rtklib_configuration_options);
@@ -829,10 +877,21 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
     pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
 
+    // Warm start data, saved periodically and loaded at startup (disabled if no file is set)
+    pvt_output_parameters.warm_start_file = configuration->property(role + ".warm_start_file", std::string(""));
+    pvt_output_parameters.warm_start_rate_ms = bc::lcm(configuration->property(role + ".warm_start_rate_ms", 30000), pvt_output_parameters.output_rate_ms);
+
+    // Epochs that each printer can hold before dropping them, if it runs on its own thread (0: printers run in the PVT block thread)
+    pvt_output_parameters.output_queue_size = configuration->property(role + ".output_queue_size", 0);
+
     // Read PVT MONITOR Configuration
     pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
     pvt_output_parameters.udp_addresses = configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1"));
     pvt_output_parameters.udp_port = configuration->property(role + ".monitor_udp_port", 1234);
+    if (configuration->property(role + ".monitor_transport", std::string("udp")) == "shm")
+        {
+            pvt_output_parameters.monitor_shm_name = configuration->property(role + ".monitor_shm_name", std::string("/gnss-sdr-pvt-monitor"));
+        }
     pvt_output_parameters.protobuf_enabled = configuration->property(role + ".enable_protobuf", true);
     if (configuration->property("Monitor.enable_protobuf", false) == true)
         {
@@ -843,10 +902,15 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.monitor_ephemeris_enabled = configuration->property(role + ".enable_monitor_ephemeris", false);
     pvt_output_parameters.udp_eph_addresses = configuration->property(role + ".monitor_ephemeris_client_addresses", std::string("127.0.0.1"));
     pvt_output_parameters.udp_eph_port = configuration->property(role + ".monitor_ephemeris_udp_port", 1234);
+    pvt_output_parameters.monitor_ephemeris_only_new = configuration->property(role + ".monitor_ephemeris_only_new", pvt_output_parameters.monitor_ephemeris_only_new);
+    pvt_output_parameters.monitor_ephemeris_compact = configuration->property(role + ".monitor_ephemeris_compact", pvt_output_parameters.monitor_ephemeris_compact);
 
     // Show time in local zone
     pvt_output_parameters.show_local_time_zone = configuration->property(role + ".show_local_time_zone", false);
 
+    // Send the range rates predicted by the PVT solution to the tracking blocks
+    pvt_output_parameters.enable_vtl_aiding = configuration->property(role + ".enable_vtl_aiding", false);
+
     // Enable or disable rx clock correction in observables
     pvt_output_parameters.enable_rx_clock_correction = configuration->property(role + ".enable_rx_clock_correction", false);
 
@@ -891,6 +955,18 @@ bool Rtklib_Pvt::get_latest_PVT(double* longitude_deg,
 }
 
 
+bool Rtklib_Pvt::set_output_rate(const std::string& output, int32_t rate_ms)
+{
+    return pvt_->set_output_rate(output, rate_ms);
+}
+
+
+std::vector<Pvt_Satellite_Contribution> Rtklib_Pvt::get_satellite_contributions() const
+{
+    return pvt_->get_satellite_contributions();
+}
+
+
 void Rtklib_Pvt::clear_ephemeris()
 {
     pvt_->clear_ephemeris();
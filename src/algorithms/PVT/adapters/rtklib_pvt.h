@@ -28,6 +28,7 @@
 #include <ctime>                     // for time_t
 #include <map>                       // for map
 #include <string>                    // for string
+#include <vector>                    // for vector
 
 /** \addtogroup PVT
  * Computation of Position, Velocity and Time from GNSS observables.
@@ -220,6 +221,10 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) override;
 
+    bool set_output_rate(const std::string& output, int32_t rate_ms) override;
+
+    std::vector<Pvt_Satellite_Contribution> get_satellite_contributions() const override;
+
 private:
     rtklib_pvt_gs_sptr pvt_;
     rtk_t rtk{};
@@ -33,10 +33,15 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_frequencies.h"
+#include "gnss_nav_data_store.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_async_log.h"
+#include "gnss_sdr_block_stats.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_monitor_ring_writer.h"
+#include "gnss_signal_id.h"
 #include "gps_almanac.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
@@ -52,6 +57,8 @@
 #include "monitor_pvt_udp_sink.h"
 #include "nmea_printer.h"
 #include "pvt_conf.h"
+#include "pvt_output_worker.h"
+#include "pvt_solver_engines.h"
 #include "rinex_printer.h"
 #include "rtcm_printer.h"
 #include "rtklib_rtkcmn.h"
@@ -66,8 +73,9 @@
 #include <glog/logging.h>               // for LOG
 #include <gnuradio/io_signature.h>      // for io_signature
 #include <pmt/pmt_sugar.h>              // for mp
-#include <algorithm>                    // for sort, unique
+#include <algorithm>                    // for copy, sort, unique
 #include <cerrno>                       // for errno
+#include <cmath>                        // for round
 #include <cstring>                      // for strerror
 #include <exception>                    // for exception
 #include <fstream>                      // for ofstream
@@ -119,6 +127,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
           gr::io_signature::make(nchannels, nchannels, sizeof(Gnss_Synchro)),
           gr::io_signature::make(0, 0, 0)),
       d_dump_filename(conf_.dump_filename),
+      d_warm_start_file(conf_.warm_start_file),
       d_gps_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Ephemeris>).hash_code()),
       d_gps_iono_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Iono>).hash_code()),
       d_gps_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Utc_Model>).hash_code()),
@@ -148,6 +157,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_geojson_rate_ms(conf_.geojson_rate_ms),
       d_nmea_rate_ms(conf_.nmea_rate_ms),
       d_an_rate_ms(conf_.an_rate_ms),
+      d_warm_start_rate_ms(conf_.warm_start_rate_ms),
       d_output_rate_ms(conf_.output_rate_ms),
       d_display_rate_ms(conf_.display_rate_ms),
       d_report_rate_ms(1000),
@@ -168,9 +178,18 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_show_local_time_zone(conf_.show_local_time_zone),
       d_waiting_obs_block_rx_clock_offset_correction_msg(false),
       d_enable_rx_clock_correction(conf_.enable_rx_clock_correction),
+      d_enable_vtl_aiding(conf_.enable_vtl_aiding),
+      d_decimate_epochs(conf_.decimate_epochs),
       d_an_printer_enabled(conf_.an_output_enabled),
       d_log_timetag(conf_.log_source_timetag)
 {
+    d_work_stats = Gnss_Block_Stats_Registry::instance().make(unique_id());
+
+    // The observables of an epoch are stored without further allocations
+    d_gnss_observables_map.reserve(d_nchannels);
+    d_gnss_observables_map_t0.reserve(d_nchannels);
+    d_gnss_observables_map_t1.reserve(d_nchannels);
+
     // Send feedback message to observables block with the receiver clock offset
     this->message_port_register_out(pmt::mp("pvt_to_observables"));
     // Experimental: VLT commands from PVT to tracking channels
@@ -309,7 +328,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     const std::string rtcm_dump_filename = d_dump_filename;
     if (conf_.flag_rtcm_server || conf_.flag_rtcm_tty_port || conf_.rtcm_output_file_enabled)
         {
-            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path);
+            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path, conf_.rtcm_ntrip_port, conf_.rtcm_ntrip_mountpoint);
             std::map<int, int> rtcm_msg_rate_ms = conf_.rtcm_msg_rate_ms;
             if (rtcm_msg_rate_ms.find(1019) != rtcm_msg_rate_ms.end())
                 {
@@ -444,8 +463,42 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_an_printer = nullptr;
         }
 
+    // printers running on their own threads, so that slow outputs never stall the receiver
+    if (conf_.output_queue_size > 0)
+        {
+            const auto capacity = static_cast<size_t>(conf_.output_queue_size);
+            if (d_rinex_output_enabled)
+                {
+                    d_rinex_worker = std::make_unique<Pvt_Output_Worker>("RINEX", capacity);
+                }
+            if (d_kml_output_enabled)
+                {
+                    d_kml_worker = std::make_unique<Pvt_Output_Worker>("KML", capacity);
+                }
+            if (d_gpx_output_enabled)
+                {
+                    d_gpx_worker = std::make_unique<Pvt_Output_Worker>("GPX", capacity);
+                }
+            if (d_nmea_output_file_enabled)
+                {
+                    d_nmea_worker = std::make_unique<Pvt_Output_Worker>("NMEA", capacity);
+                }
+            if (d_geojson_output_enabled)
+                {
+                    d_geojson_worker = std::make_unique<Pvt_Output_Worker>("GeoJSON", capacity);
+                }
+            if (d_an_printer_enabled)
+                {
+                    d_an_worker = std::make_unique<Pvt_Output_Worker>("AN", capacity);
+                }
+        }
+
     // PVT MONITOR
-    if (d_flag_monitor_pvt_enabled)
+    if (d_flag_monitor_pvt_enabled && !conf_.monitor_shm_name.empty())
+        {
+            d_monitor_ring = std::make_unique<Gnss_Monitor_Ring_Writer>(conf_.monitor_shm_name, GNSS_SDR_MONITOR_RECORD_MONITOR_PVT, sizeof(Monitor_Pvt));
+        }
+    else if (d_flag_monitor_pvt_enabled)
         {
             std::string address_string = conf_.udp_addresses;
             std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
@@ -467,7 +520,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
 
-            d_eph_udp_sink_ptr = std::make_unique<Monitor_Ephemeris_Udp_Sink>(udp_addr_vec, conf_.udp_eph_port, conf_.protobuf_enabled);
+            d_eph_udp_sink_ptr = std::make_unique<Monitor_Ephemeris_Udp_Sink>(udp_addr_vec, conf_.udp_eph_port, conf_.protobuf_enabled, conf_.monitor_ephemeris_only_new, conf_.monitor_ephemeris_compact);
         }
     else
         {
@@ -543,6 +596,28 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_internal_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
             d_user_pvt_solver = d_internal_pvt_solver;
         }
+    d_user_pvt_solver->set_range_rate_predictions(d_enable_vtl_aiding);
+
+    // solvers with other positioning modes, fed with the epochs prepared by the user solver
+    if (!conf_.extra_positioning_modes.empty())
+        {
+            d_pvt_engines = std::make_unique<Pvt_Solver_Engines>(rtk.opt, conf_.extra_positioning_modes,
+                d_dump ? dump_ls_pvt_filename : std::string(), d_dump_mat, conf_.pre_2009_file,
+                static_cast<size_t>(std::max<int32_t>(conf_.output_queue_size, 1)));
+        }
+
+    // warm start: navigation data and receiver state of the previous run
+    if (!d_warm_start_file.empty())
+        {
+            if (d_internal_pvt_solver->load_warm_start(d_warm_start_file))
+                {
+                    if (d_user_pvt_solver != d_internal_pvt_solver)
+                        {
+                            d_user_pvt_solver->load_warm_start(d_warm_start_file);
+                        }
+                    std::cout << "Warm start data loaded from " << d_warm_start_file << '\n';
+                }
+        }
 
     d_mapStringValues["1C"] = evGPS_1C;
     d_mapStringValues["2S"] = evGPS_2S;
@@ -582,12 +657,24 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
 rtklib_pvt_gs::~rtklib_pvt_gs()
 {
     DLOG(INFO) << "PVT block destructor called.";
+    // run the pending outputs while the printers are still alive
+    d_rinex_worker.reset();
+    d_kml_worker.reset();
+    d_gpx_worker.reset();
+    d_nmea_worker.reset();
+    d_geojson_worker.reset();
+    d_an_worker.reset();
+    d_pvt_engines.reset();
     if (d_sysv_msqid != -1)
         {
             msgctl(d_sysv_msqid, IPC_RMID, nullptr);
         }
     try
         {
+            if (!d_warm_start_file.empty() && !d_first_fix)
+                {
+                    d_user_pvt_solver->save_warm_start(d_warm_start_file);
+                }
             if (d_xml_storage)
                 {
                     // save GPS L2CM ephemeris to XML file
@@ -1158,14 +1245,14 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                << "inserted with Toe=" << gps_eph->toe << " and GPS Week="
                                << gps_eph->WN;
 
-                    // todo: Send only new sets of ephemeris (new TOE), not sent to the client
-                    // send the new eph to the eph monitor (if enabled)
+                    // send the new eph to the eph monitor (if enabled). Sets of
+                    // ephemeris already sent are skipped by the sink.
                     if (d_flag_monitor_ephemeris_enabled)
                         {
                             d_eph_udp_sink_ptr->write_gps_ephemeris(gps_eph);
                         }
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled && (d_rinex_worker != nullptr || d_rp->is_rinex_header_written()))  // The header is already written, we can now log the navigation message data
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->gps_ephemeris_map.find(gps_eph->PRN) == d_internal_pvt_solver->gps_ephemeris_map.cend())
@@ -1184,10 +1271,11 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Gps_Ephemeris> new_eph;
                                     new_eph[gps_eph->PRN] = *gps_eph;
-                                    d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
+                                    log_rinex_nav([this, new_eph] { d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph); });
                                 }
                         }
                     d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                    gnss_nav_data_store().gps_ephemeris.write(gps_eph->PRN, *gps_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
@@ -1225,7 +1313,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV message ###
                     const auto gps_cnav_ephemeris = wht::any_cast<std::shared_ptr<Gps_CNAV_Ephemeris>>(pmt::any_ref(msg));
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled && (d_rinex_worker != nullptr || d_rp->is_rinex_header_written()))  // The header is already written, we can now log the navigation message data
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gps_cnav_ephemeris->PRN) == d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
@@ -1244,10 +1332,11 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Gps_CNAV_Ephemeris> new_cnav_eph;
                                     new_cnav_eph[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
-                                    d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
+                                    log_rinex_nav([this, new_cnav_eph] { d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph); });
                                 }
                         }
                     d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                    gnss_nav_data_store().gps_cnav_ephemeris.write(gps_cnav_ephemeris->PRN, *gps_cnav_ephemeris);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
@@ -1287,6 +1376,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS ALMANAC ###
                     const auto gps_almanac = wht::any_cast<std::shared_ptr<Gps_Almanac>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
+                    gnss_nav_data_store().gps_almanac.write(gps_almanac->PRN, *gps_almanac);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
@@ -1303,14 +1393,14 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     DLOG(INFO) << "Galileo New Ephemeris record inserted in global map with TOW =" << galileo_eph->tow
                                << ", GALILEO Week Number =" << galileo_eph->WN
                                << " and Ephemeris IOD = " << galileo_eph->IOD_ephemeris;
-                    // todo: Send only new sets of ephemeris (new TOE), not sent to the client
-                    // send the new eph to the eph monitor (if enabled)
+                    // send the new eph to the eph monitor (if enabled). Sets of
+                    // ephemeris already sent are skipped by the sink.
                     if (d_flag_monitor_ephemeris_enabled)
                         {
                             d_eph_udp_sink_ptr->write_galileo_ephemeris(galileo_eph);
                         }
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled && (d_rinex_worker != nullptr || d_rp->is_rinex_header_written()))  // The header is already written, we can now log the navigation message data
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->galileo_ephemeris_map.find(galileo_eph->PRN) == d_internal_pvt_solver->galileo_ephemeris_map.cend())
@@ -1329,10 +1419,11 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Galileo_Ephemeris> new_gal_eph;
                                     new_gal_eph[galileo_eph->PRN] = *galileo_eph;
-                                    d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
+                                    log_rinex_nav([this, new_gal_eph] { d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph); });
                                 }
                         }
                     d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                    gnss_nav_data_store().galileo_ephemeris.write(galileo_eph->PRN, *galileo_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
@@ -1378,6 +1469,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     if (sv1.PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv1.PRN] = sv1;
+                            gnss_nav_data_store().galileo_almanac.write(sv1.PRN, sv1);
                             if (d_enable_rx_clock_correction == true)
                                 {
                                     d_user_pvt_solver->galileo_almanac_map[sv1.PRN] = sv1;
@@ -1386,6 +1478,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     if (sv2.PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv2.PRN] = sv2;
+                            gnss_nav_data_store().galileo_almanac.write(sv2.PRN, sv2);
                             if (d_enable_rx_clock_correction == true)
                                 {
                                     d_user_pvt_solver->galileo_almanac_map[sv2.PRN] = sv2;
@@ -1394,6 +1487,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     if (sv3.PRN != 0)
                         {
                             d_internal_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
+                            gnss_nav_data_store().galileo_almanac.write(sv3.PRN, sv3);
                             if (d_enable_rx_clock_correction == true)
                                 {
                                     d_user_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
@@ -1407,6 +1501,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     const auto galileo_alm = wht::any_cast<std::shared_ptr<Galileo_Almanac>>(pmt::any_ref(msg));
                     // update/insert new almanac record to the global almanac map
                     d_internal_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
+                    gnss_nav_data_store().galileo_almanac.write(galileo_alm->PRN, *galileo_alm);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
@@ -1425,7 +1520,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
                                << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled && (d_rinex_worker != nullptr || d_rp->is_rinex_header_written()))  // The header is already written, we can now log the navigation message data
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(glonass_gnav_eph->PRN) == d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
@@ -1444,10 +1539,11 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Glonass_Gnav_Ephemeris> new_glo_eph;
                                     new_glo_eph[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
-                                    d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
+                                    log_rinex_nav([this, new_glo_eph] { d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph); });
                                 }
                         }
                     d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                    gnss_nav_data_store().glonass_gnav_ephemeris.write(glonass_gnav_eph->PRN, *glonass_gnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
@@ -1488,7 +1584,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                << "inserted with Toe=" << bds_dnav_eph->toe << " and BDS Week="
                                << bds_dnav_eph->WN;
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled && (d_rinex_worker != nullptr || d_rp->is_rinex_header_written()))  // The header is already written, we can now log the navigation message data
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(bds_dnav_eph->PRN) == d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
@@ -1507,10 +1603,11 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Beidou_Dnav_Ephemeris> new_bds_eph;
                                     new_bds_eph[bds_dnav_eph->PRN] = *bds_dnav_eph;
-                                    d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
+                                    log_rinex_nav([this, new_bds_eph] { d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph); });
                                 }
                         }
                     d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                    gnss_nav_data_store().beidou_dnav_ephemeris.write(bds_dnav_eph->PRN, *bds_dnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
@@ -1548,6 +1645,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### BeiDou ALMANAC ###
                     const auto bds_dnav_almanac = wht::any_cast<std::shared_ptr<Beidou_Dnav_Almanac>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
+                    gnss_nav_data_store().beidou_dnav_almanac.write(bds_dnav_almanac->PRN, *bds_dnav_almanac);
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
@@ -1589,42 +1687,59 @@ void rtklib_pvt_gs::msg_handler_has_data(const pmt::pmt_t& msg) const
 
 std::map<int, Gps_Ephemeris> rtklib_pvt_gs::get_gps_ephemeris_map() const
 {
-    return d_internal_pvt_solver->gps_ephemeris_map;
+    return *gnss_nav_data_store().gps_ephemeris.snapshot();
 }
 
 
 std::map<int, Gps_Almanac> rtklib_pvt_gs::get_gps_almanac_map() const
 {
-    return d_internal_pvt_solver->gps_almanac_map;
+    return *gnss_nav_data_store().gps_almanac.snapshot();
 }
 
 
 std::map<int, Galileo_Ephemeris> rtklib_pvt_gs::get_galileo_ephemeris_map() const
 {
-    return d_internal_pvt_solver->galileo_ephemeris_map;
+    return *gnss_nav_data_store().galileo_ephemeris.snapshot();
 }
 
 
 std::map<int, Galileo_Almanac> rtklib_pvt_gs::get_galileo_almanac_map() const
 {
-    return d_internal_pvt_solver->galileo_almanac_map;
+    return *gnss_nav_data_store().galileo_almanac.snapshot();
 }
 
 
 std::map<int, Beidou_Dnav_Ephemeris> rtklib_pvt_gs::get_beidou_dnav_ephemeris_map() const
 {
-    return d_internal_pvt_solver->beidou_dnav_ephemeris_map;
+    return *gnss_nav_data_store().beidou_dnav_ephemeris.snapshot();
 }
 
 
 std::map<int, Beidou_Dnav_Almanac> rtklib_pvt_gs::get_beidou_dnav_almanac_map() const
 {
-    return d_internal_pvt_solver->beidou_dnav_almanac_map;
+    return *gnss_nav_data_store().beidou_dnav_almanac.snapshot();
+}
+
+
+bool rtklib_pvt_gs::is_near_output_epoch(double rx_time_s) const
+{
+    // the output epoch is selected after the receiver clock correction
+    // (up to max_clock_offset_ms), interpolating between the epochs around it
+    const auto margin_ms = static_cast<int64_t>(d_observable_interval_ms) + d_max_obs_block_rx_clock_offset_ms;
+    const auto output_rate_ms = static_cast<int64_t>(d_output_rate_ms);
+    if (output_rate_ms <= 2 * margin_ms + static_cast<int64_t>(d_observable_interval_ms))
+        {
+            return true;  // all the epochs are needed
+        }
+    const auto rx_time_ms = static_cast<int64_t>(std::round(rx_time_s * 1000.0));
+    const int64_t remainder_ms = ((rx_time_ms % output_rate_ms) + output_rate_ms) % output_rate_ms;
+    return remainder_ms <= margin_ms || output_rate_ms - remainder_ms <= margin_ms;
 }
 
 
 void rtklib_pvt_gs::clear_ephemeris()
 {
+    gnss_nav_data_store().clear();
     d_internal_pvt_solver->gps_ephemeris_map.clear();
     d_internal_pvt_solver->gps_almanac_map.clear();
     d_internal_pvt_solver->galileo_ephemeris_map.clear();
@@ -1672,7 +1787,8 @@ bool rtklib_pvt_gs::save_gnss_synchro_map_xml(const std::string& file_name)
                 {
                     ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
                     boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gnss_synchro_map", d_gnss_observables_map);
+                    const std::map<int, Gnss_Synchro> gnss_observables_map = d_gnss_observables_map.to_map();
+                    xml << boost::serialization::make_nvp("GNSS-SDR_gnss_synchro_map", gnss_observables_map);
                     LOG(INFO) << "Saved gnss_sychro map data";
                 }
             catch (const std::exception& e)
@@ -1713,8 +1829,9 @@ bool rtklib_pvt_gs::load_gnss_synchro_map_xml(const std::string& file_name)
         {
             ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
             boost::archive::xml_iarchive xml(ifs);
-            d_gnss_observables_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gnss_synchro_map", d_gnss_observables_map);
+            std::map<int, Gnss_Synchro> gnss_observables_map;
+            xml >> boost::serialization::make_nvp("GNSS-SDR_gnss_synchro_map", gnss_observables_map);
+            d_gnss_observables_map.assign(gnss_observables_map);
             // std::cout << "Loaded gnss_synchro map data with " << gnss_synchro_map.size() << " pseudoranges\n";
         }
     catch (const std::exception& e)
@@ -1741,6 +1858,78 @@ std::vector<std::string> rtklib_pvt_gs::split_string(const std::string& s, char
 }
 
 
+void rtklib_pvt_gs::save_used_satellites()
+{
+    std::lock_guard<std::mutex> lock(d_used_satellites_mutex);
+    d_used_satellites.clear();
+    for (int sat = 0; sat < MAXSAT; sat++)
+        {
+            const ssat_t& ssat = d_user_pvt_solver->pvt_ssat[sat];
+            if (ssat.vs == 1)
+                {
+                    d_used_satellites.emplace_back(sat + 1, std::array<double, 2>{ssat.azel[0], ssat.azel[1]});
+                }
+        }
+}
+
+
+std::vector<Pvt_Satellite_Contribution> rtklib_pvt_gs::get_satellite_contributions() const
+{
+    std::vector<std::pair<int, std::array<double, 2>>> used;
+    {
+        std::lock_guard<std::mutex> lock(d_used_satellites_mutex);
+        used = d_used_satellites;
+    }
+    const auto n = static_cast<int>(used.size());
+    std::vector<double> azel;
+    azel.reserve(2 * used.size());
+    for (const auto& satellite : used)
+        {
+            azel.push_back(satellite.second[0]);
+            azel.push_back(satellite.second[1]);
+        }
+    std::array<double, 4> dop{};
+    dops(n, azel.data(), 0.0, dop.data());
+
+    std::vector<Pvt_Satellite_Contribution> contributions;
+    std::vector<double> azel_without(azel.size());
+    for (int i = 0; i < n; i++)
+        {
+            Pvt_Satellite_Contribution contribution;
+            int prn = 0;
+            switch (satsys(used[i].first, &prn))
+                {
+                case SYS_GPS:
+                    contribution.system = 'G';
+                    break;
+                case SYS_GLO:
+                    contribution.system = 'R';
+                    break;
+                case SYS_GAL:
+                    contribution.system = 'E';
+                    break;
+                case SYS_BDS:
+                    contribution.system = 'C';
+                    break;
+                default:
+                    continue;
+                }
+            contribution.prn = static_cast<uint32_t>(prn);
+            contribution.elevation_deg = used[i].second[1] * R2D;
+            contribution.gdop = dop[0];
+
+            // the same geometry without this satellite
+            std::copy(azel.begin(), azel.begin() + 2 * i, azel_without.begin());
+            std::copy(azel.begin() + 2 * (i + 1), azel.end(), azel_without.begin() + 2 * i);
+            std::array<double, 4> dop_without{};
+            dops(n - 1, azel_without.data(), 0.0, dop_without.data());
+            contribution.gdop_without = dop_without[0];
+            contributions.push_back(contribution);
+        }
+    return contributions;
+}
+
+
 bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
     double* latitude_deg,
     double* height_m,
@@ -1781,11 +1970,50 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
 }
 
 
-void rtklib_pvt_gs::apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
+bool rtklib_pvt_gs::set_output_rate(const std::string& output, int32_t rate_ms)
+{
+    // outputs are only written at the epochs of the PVT solution. The RINEX
+    // rate is not changed, because it is written in the file header.
+    if (rate_ms <= 0 or d_output_rate_ms <= 0 or rate_ms % d_output_rate_ms != 0)
+        {
+            return false;
+        }
+    std::atomic<int32_t>* rate = nullptr;
+    if (output == "kml" and d_kml_output_enabled)
+        {
+            rate = &d_kml_rate_ms;
+        }
+    else if (output == "gpx" and d_gpx_output_enabled)
+        {
+            rate = &d_gpx_rate_ms;
+        }
+    else if (output == "geojson" and d_geojson_output_enabled)
+        {
+            rate = &d_geojson_rate_ms;
+        }
+    else if (output == "nmea" and d_nmea_output_file_enabled)
+        {
+            rate = &d_nmea_rate_ms;
+        }
+    else if (output == "display" and d_display_rate_ms != 0)
+        {
+            rate = &d_display_rate_ms;
+        }
+    if (rate == nullptr)
+        {
+            return false;
+        }
+    *rate = rate_ms;
+    LOG(INFO) << "PVT " << output << " output rate set to " << rate_ms << " ms";
+    return true;
+}
+
+
+void rtklib_pvt_gs::apply_rx_clock_offset(Pvt_Observables& observables_map,
     double rx_clock_offset_s)
 {
     // apply corrections according to Rinex 3.04, Table 1: Observation Corrections for Receiver Clock Offset
-    std::map<int, Gnss_Synchro>::iterator observables_iter;
+    Pvt_Observables::iterator observables_iter;
 
     for (observables_iter = observables_map.begin(); observables_iter != observables_map.end(); observables_iter++)
         {
@@ -1835,11 +2063,12 @@ void rtklib_pvt_gs::apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observabl
 }
 
 
-std::map<int, Gnss_Synchro> rtklib_pvt_gs::interpolate_observables(const std::map<int, Gnss_Synchro>& observables_map_t0,
-    const std::map<int, Gnss_Synchro>& observables_map_t1,
-    double rx_time_s)
+void rtklib_pvt_gs::interpolate_observables(const Pvt_Observables& observables_map_t0,
+    const Pvt_Observables& observables_map_t1,
+    double rx_time_s,
+    Pvt_Observables& interp_observables_map)
 {
-    std::map<int, Gnss_Synchro> interp_observables_map;
+    interp_observables_map.clear();
     // Linear interpolation: y(t) = y(t0) + (y(t1) - y(t0)) * (t - t0) / (t1 - t0)
 
     // check TOW rollover
@@ -1859,35 +2088,56 @@ std::map<int, Gnss_Synchro> rtklib_pvt_gs::interpolate_observables(const std::ma
                               observables_map_t0.cbegin()->second.RX_time);
         }
 
-    std::map<int, Gnss_Synchro>::const_iterator observables_iter;
+    Pvt_Observables::const_iterator observables_iter;
     for (observables_iter = observables_map_t0.cbegin(); observables_iter != observables_map_t0.cend(); observables_iter++)
         {
             // 1. Check if the observable exist in t0 and t1
             // the map key is the channel ID (see work())
-            try
+            const auto t1_iter = observables_map_t1.find(observables_iter->first);
+            if (t1_iter != observables_map_t1.cend() && t1_iter->second.PRN == observables_iter->second.PRN)
                 {
-                    if (observables_map_t1.at(observables_iter->first).PRN == observables_iter->second.PRN)
-                        {
-                            interp_observables_map.insert(std::pair<int, Gnss_Synchro>(observables_iter->first, observables_iter->second));
-                            interp_observables_map.at(observables_iter->first).RX_time = rx_time_s;  // interpolation point
-                            interp_observables_map.at(observables_iter->first).Pseudorange_m += (observables_map_t1.at(observables_iter->first).Pseudorange_m - observables_iter->second.Pseudorange_m) * time_factor;
-                            interp_observables_map.at(observables_iter->first).Carrier_phase_rads += (observables_map_t1.at(observables_iter->first).Carrier_phase_rads - observables_iter->second.Carrier_phase_rads) * time_factor;
-                            interp_observables_map.at(observables_iter->first).Carrier_Doppler_hz += (observables_map_t1.at(observables_iter->first).Carrier_Doppler_hz - observables_iter->second.Carrier_Doppler_hz) * time_factor;
-                        }
+                    Gnss_Synchro interp = observables_iter->second;
+                    interp.RX_time = rx_time_s;  // interpolation point
+                    interp.Pseudorange_m += (t1_iter->second.Pseudorange_m - observables_iter->second.Pseudorange_m) * time_factor;
+                    interp.Carrier_phase_rads += (t1_iter->second.Carrier_phase_rads - observables_iter->second.Carrier_phase_rads) * time_factor;
+                    interp.Carrier_Doppler_hz += (t1_iter->second.Carrier_Doppler_hz - observables_iter->second.Carrier_Doppler_hz) * time_factor;
+                    interp_observables_map.insert(observables_iter->first, interp);
                 }
-            catch (const std::out_of_range& oor)
+        }
+}
+
+
+// Closes the vector tracking loop: sends to the tracking channels the range
+// rate of their satellites predicted by the current solution, stamped with the
+// sample counter of the observation they were computed from. All the channels
+// receive the same message, so it is published once per solution.
+void rtklib_pvt_gs::send_vtl_aiding()
+{
+    const std::shared_ptr<TrackingCmdMap> trk_cmds = std::make_shared<TrackingCmdMap>();
+    for (const auto &obs : d_gnss_observables_map)
+        {
+            double range_rate_m_s = 0.0;
+            if (d_user_pvt_solver->get_predicted_range_rate(obs.second, range_rate_m_s))
                 {
-                    // observable does not exist in t1
+                    TrackingCmd& trk_cmd = (*trk_cmds)[static_cast<uint32_t>(obs.second.Channel_ID)];
+                    trk_cmd.enable_carrier_nco_cmd = true;
+                    trk_cmd.range_rate_m_s = range_rate_m_s;
+                    trk_cmd.sample_counter = obs.second.Tracking_sample_counter;
+                    trk_cmd.channel_id = static_cast<uint32_t>(obs.second.Channel_ID);
+                    trk_cmd.PRN = obs.second.PRN;
                 }
         }
-    return interp_observables_map;
+    if (!trk_cmds->empty())
+        {
+            this->message_port_pub(pmt::mp("pvt_to_trk"), pmt::make_any(trk_cmds));
+        }
 }
 
 
 void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 {
     // we have a valid PVT. First check if we need to reset the initial carrier phase offsets to match their pseudoranges
-    std::map<int, Gnss_Synchro>::iterator observables_iter;
+    Pvt_Observables::iterator observables_iter;
     for (observables_iter = d_gnss_observables_map.begin(); observables_iter != d_gnss_observables_map.end(); observables_iter++)
         {
             // check if an initialization is required (new satellite or loss of lock)
@@ -1944,9 +2194,44 @@ void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 }
 
 
+void rtklib_pvt_gs::run_output(const std::unique_ptr<Pvt_Output_Worker>& worker, const std::function<void()>& job)
+{
+    if (worker)
+        {
+            worker->submit(job);
+        }
+    else
+        {
+            job();
+        }
+}
+
+
+void rtklib_pvt_gs::log_rinex_nav(const std::function<void()>& job)
+{
+    if (d_rinex_worker)
+        {
+            // the RINEX thread writes the header, so it also checks if it is written
+            // new navigation records are never dropped
+            d_rinex_worker->submit([this, job] {
+                if (d_rp->is_rinex_header_written())
+                    {
+                        job();
+                    }
+            },
+                false);
+        }
+    else
+        {
+            job();
+        }
+}
+
+
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    const Gnss_Block_Work_Timer work_timer(d_work_stats.get());
     //**************** time tags ****************
     if (d_enable_rx_clock_correction == false)  // todo: currently only works if clock correction is disabled
         {
@@ -2005,7 +2290,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
                                 {
                                     const uint32_t prn_aux = tmp_eph_iter_gps->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (std::string(in[i][epoch].Signal) == std::string("1C")) && (tmp_eph_iter_gps->second.SV_health == 0))
+                                    if ((prn_aux == in[i][epoch].PRN) && (gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_1C) && (tmp_eph_iter_gps->second.SV_health == 0))
                                         {
                                             store_valid_observable = true;
                                         }
@@ -2014,9 +2299,9 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                 {
                                     const uint32_t prn_aux = tmp_eph_iter_gal->second.PRN;
                                     if ((prn_aux == in[i][epoch].PRN) &&
-                                        (((std::string(in[i][epoch].Signal) == std::string("1B")) && (tmp_eph_iter_gal->second.E1B_DVS == false) && (tmp_eph_iter_gal->second.E1B_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("5X")) && (tmp_eph_iter_gal->second.E5a_DVS == false) && (tmp_eph_iter_gal->second.E5a_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("7X")) && (tmp_eph_iter_gal->second.E5b_DVS == false) && (tmp_eph_iter_gal->second.E5b_HS == 0))))
+                                        (((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_1B) && (tmp_eph_iter_gal->second.E1B_DVS == false) && (tmp_eph_iter_gal->second.E1B_HS == 0)) ||
+                                            ((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_5X) && (tmp_eph_iter_gal->second.E5a_DVS == false) && (tmp_eph_iter_gal->second.E5a_HS == 0)) ||
+                                            ((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_7X) && (tmp_eph_iter_gal->second.E5b_DVS == false) && (tmp_eph_iter_gal->second.E5b_HS == 0))))
                                         {
                                             store_valid_observable = true;
                                         }
@@ -2024,7 +2309,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
                                 {
                                     const uint32_t prn_aux = tmp_eph_iter_cnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("2S")) || (std::string(in[i][epoch].Signal) == std::string("L5")))))
+                                    if ((prn_aux == in[i][epoch].PRN) && (((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_2S) || (gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_L5))))
                                         {
                                             store_valid_observable = true;
                                         }
@@ -2032,7 +2317,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
                                     const uint32_t prn_aux = tmp_eph_iter_glo_gnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && ((std::string(in[i][epoch].Signal) == std::string("1G")) || (std::string(in[i][epoch].Signal) == std::string("2G"))))
+                                    if ((prn_aux == in[i][epoch].PRN) && ((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_1G) || (gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_2G)))
                                         {
                                             store_valid_observable = true;
                                         }
@@ -2040,7 +2325,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (tmp_eph_iter_bds_dnav != d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
                                     const uint32_t prn_aux = tmp_eph_iter_bds_dnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("B1")) || (std::string(in[i][epoch].Signal) == std::string("B3"))) && (tmp_eph_iter_bds_dnav->second.SV_health == 0)))
+                                    if ((prn_aux == in[i][epoch].PRN) && (((gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_B1) || (gnss_signal_code(in[i][epoch].Signal) == Gnss_Signal_Code::SIG_B3)) && (tmp_eph_iter_bds_dnav->second.SV_health == 0)))
                                         {
                                             store_valid_observable = true;
                                         }
@@ -2049,7 +2334,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (store_valid_observable)
                                 {
                                     // store valid observables in a map.
-                                    d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
+                                    d_gnss_observables_map.insert(static_cast<int>(i), in[i][epoch]);
                                 }
 
                             if (d_rtcm_enabled)
@@ -2060,28 +2345,28 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                                 {
                                                     if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(tmp_eph_iter_gps->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(tmp_eph_iter_gal->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(tmp_eph_iter_cnav->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                         }
                                                 }
                                             if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
                                                 {
                                                     if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
                                                         {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
+                                                            d_rtcm_printer->lock_time(tmp_eph_iter_glo_gnav->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                         }
                                                 }
                                         }
@@ -2103,6 +2388,13 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                         }
                 }
 
+            // With high rate observables, only the epochs that can lead to an
+            // output (those around output_rate_ms boundaries) are solved
+            if (d_decimate_epochs && !d_gnss_observables_map.empty() && !is_near_output_epoch(d_gnss_observables_map.cbegin()->second.RX_time))
+                {
+                    d_gnss_observables_map.clear();
+                }
+
             // ############ 2 COMPUTE THE PVT ################################
             bool flag_pvt_valid = false;
             if (d_gnss_observables_map.empty() == false)
@@ -2185,9 +2477,10 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                                             // std::cout << " obs time t0: " << d_gnss_observables_map_t0.cbegin()->second.RX_time
                                                             //           << " t1: " << d_gnss_observables_map_t1.cbegin()->second.RX_time
                                                             //           << " interp time: " << d_rx_time << '\n';
-                                                            d_gnss_observables_map = interpolate_observables(d_gnss_observables_map_t0,
+                                                            interpolate_observables(d_gnss_observables_map_t0,
                                                                 d_gnss_observables_map_t1,
-                                                                d_rx_time);
+                                                                d_rx_time,
+                                                                d_gnss_observables_map);
                                                             flag_compute_pvt_output = true;
                                                             // d_rx_time = current_RX_time;
                                                             // std::cout.precision(17);
@@ -2219,17 +2512,19 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     if (flag_compute_pvt_output == true)
                         {
                             flag_pvt_valid = d_user_pvt_solver->get_PVT(d_gnss_observables_map, false);
+                            if (d_pvt_engines)
+                                {
+                                    d_pvt_engines->submit(d_user_pvt_solver->get_epoch());
+                                }
                         }
 
 
                     if (flag_pvt_valid == true)
                         {
-                            // experimental VTL tests
-                            // send tracking command
-                            //                            const std::shared_ptr<TrackingCmd> trk_cmd_test = std::make_shared<TrackingCmd>(TrackingCmd());
-                            //                            trk_cmd_test->carrier_freq_hz = 12345.4;
-                            //                            trk_cmd_test->sample_counter = d_gnss_observables_map.begin()->second.Tracking_sample_counter;
-                            //                            this->message_port_pub(pmt::mp("pvt_to_trk"), pmt::make_any(trk_cmd_test));
+                            if (d_enable_vtl_aiding)
+                                {
+                                    send_vtl_aiding();
+                                }
 
                             // initialize (if needed) the accumulated phase offset and apply it to the active channels
                             // required to report accumulated phase cycles comparable to pseudoranges
@@ -2238,13 +2533,13 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             const double Rx_clock_offset_s = d_user_pvt_solver->get_time_offset_s();
                             if (d_enable_rx_clock_correction == true and fabs(Rx_clock_offset_s) > 0.000001)  // 1us !!
                                 {
-                                    LOG(INFO) << "Warning: Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[ms]"
-                                              << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
+                                    GNSS_SDR_LOG_EVERY_MS(INFO, 1000) << "Warning: Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[ms]"
+                                                                      << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
                                 }
                             else
                                 {
-                                    DLOG(INFO) << "Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[s]"
-                                               << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
+                                    GNSS_SDR_DLOG_EVERY_MS(INFO, 1000) << "Rx clock offset at interpolated RX time: " << Rx_clock_offset_s * 1000.0 << "[s]"
+                                                                       << " at RX time: " << static_cast<uint32_t>(d_rx_time * 1000.0) << " [ms]";
                                     // Optional debug code: export observables snapshot for rtklib unit testing
                                     // std::cout << "step 1: save gnss_synchro map\n";
                                     // save_gnss_synchro_map_xml("./gnss_synchro_map.xml");
@@ -2327,42 +2622,66 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                             send_sys_v_ttff_msg(ttff);
                                             d_first_fix = false;
                                         }
+                                    if (!d_warm_start_file.empty() && d_warm_start_rate_ms != 0)
+                                        {
+                                            if (current_RX_time_ms % d_warm_start_rate_ms == 0)
+                                                {
+                                                    d_user_pvt_solver->save_warm_start(d_warm_start_file);
+                                                }
+                                        }
+                                    // printers running on their own threads read a copy of this epoch
+                                    std::shared_ptr<const Rtklib_Solver> pvt_data = d_user_pvt_solver;
+                                    if (d_rinex_worker || d_kml_worker || d_gpx_worker || d_nmea_worker || d_geojson_worker)
+                                        {
+                                            pvt_data = d_user_pvt_solver->get_snapshot();
+                                        }
                                     if (d_kml_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_kml_rate_ms == 0)
                                                 {
-                                                    d_kml_dump->print_position(d_user_pvt_solver.get(), false);
+                                                    run_output(d_kml_worker, [this, pvt_data] { d_kml_dump->print_position(pvt_data.get(), false); });
                                                 }
                                         }
                                     if (d_gpx_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_gpx_rate_ms == 0)
                                                 {
-                                                    d_gpx_dump->print_position(d_user_pvt_solver.get(), false);
+                                                    run_output(d_gpx_worker, [this, pvt_data] { d_gpx_dump->print_position(pvt_data.get(), false); });
                                                 }
                                         }
                                     if (d_geojson_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_geojson_rate_ms == 0)
                                                 {
-                                                    d_geojson_printer->print_position(d_user_pvt_solver.get(), false);
+                                                    run_output(d_geojson_worker, [this, pvt_data] { d_geojson_printer->print_position(pvt_data.get(), false); });
                                                 }
                                         }
                                     if (d_nmea_output_file_enabled)
                                         {
                                             if (current_RX_time_ms % d_nmea_rate_ms == 0)
                                                 {
-                                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get(), false);
+                                                    run_output(d_nmea_worker, [this, pvt_data] { d_nmea_printer->Print_Nmea_Line(pvt_data.get(), false); });
                                                 }
                                         }
                                     if (d_rinex_output_enabled)
                                         {
-                                            d_rp->print_rinex_annotation(d_user_pvt_solver.get(), d_gnss_observables_map, d_rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                                            if (d_rinex_worker)
+                                                {
+                                                    const auto gnss_observables = std::make_shared<const std::map<int, Gnss_Synchro>>(d_gnss_observables_map.to_map());
+                                                    const double rx_time = d_rx_time;
+                                                    d_rinex_worker->submit([this, pvt_data, gnss_observables, rx_time, flag_write_RINEX_obs_output] {
+                                                        d_rp->print_rinex_annotation(pvt_data.get(), *gnss_observables, rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                                                    });
+                                                }
+                                            else
+                                                {
+                                                    d_rp->print_rinex_annotation(d_user_pvt_solver.get(), d_gnss_observables_map.to_map(), d_rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                                                }
                                         }
                                     if (d_rtcm_enabled)
                                         {
                                             d_rtcm_printer->Print_Rtcm_Messages(d_user_pvt_solver.get(),
-                                                d_gnss_observables_map,
+                                                d_gnss_observables_map.to_map(),
                                                 d_rx_time,
                                                 d_type_of_rx,
                                                 d_rtcm_MSM_rate_ms,
@@ -2417,6 +2736,23 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                 << "East: " << d_user_pvt_solver->get_rx_vel()[0] << " [m/s], North: " << d_user_pvt_solver->get_rx_vel()[1]
                                 << " [m/s], Up = " << d_user_pvt_solver->get_rx_vel()[2] << " [m/s]" << TEXT_RESET << '\n';
 
+                            if (d_pvt_engines)
+                                {
+                                    for (size_t i = 0; i < d_pvt_engines->size(); i++)
+                                        {
+                                            Monitor_Pvt engine_fix;
+                                            if (d_pvt_engines->get_monitor_pvt(i, engine_fix))
+                                                {
+                                                    std::cout
+                                                        << TEXT_GREEN
+                                                        << d_pvt_engines->name(i) << " solution: " << std::fixed << std::setprecision(9)
+                                                        << "Lat = " << engine_fix.latitude << " [deg], Long = " << engine_fix.longitude
+                                                        << std::fixed << std::setprecision(3)
+                                                        << " [deg], Height = " << engine_fix.height << " [m]" << TEXT_RESET << '\n';
+                                                }
+                                        }
+                                }
+
                             std::cout << std::setprecision(ss);
                             DLOG(INFO) << "RX clock drift: " << d_user_pvt_solver->get_clock_drift_ppm() << " [ppm]";
 
@@ -2445,8 +2781,13 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                             if (current_RX_time_ms % d_report_rate_ms == 0)
                                 {
                                     this->message_port_pub(pmt::mp("status"), pmt::make_any(monitor_pvt));
+                                    save_used_satellites();
                                 }
-                            if (d_flag_monitor_pvt_enabled)
+                            if (d_monitor_ring)
+                                {
+                                    d_monitor_ring->publish(monitor_pvt.get());
+                                }
+                            else if (d_flag_monitor_pvt_enabled)
                                 {
                                     d_udp_sink_ptr->write_monitor_pvt(monitor_pvt.get());
                                 }
@@ -2456,7 +2797,16 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                 {
                     if (d_local_counter_ms % static_cast<uint64_t>(d_an_rate_ms) == 0)
                         {
-                            d_an_printer->print_packet(d_user_pvt_solver.get(), d_gnss_observables_map);
+                            if (d_an_worker)
+                                {
+                                    const std::shared_ptr<const Rtklib_Solver> pvt_data = d_user_pvt_solver->get_snapshot();
+                                    const auto gnss_observables = std::make_shared<const std::map<int, Gnss_Synchro>>(d_gnss_observables_map.to_map());
+                                    d_an_worker->submit([this, pvt_data, gnss_observables] { d_an_printer->print_packet(pvt_data.get(), *gnss_observables); });
+                                }
+                            else
+                                {
+                                    d_an_printer->print_packet(d_user_pvt_solver.get(), d_gnss_observables_map.to_map());
+                                }
                         }
                 }
         }
@@ -20,22 +20,29 @@
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
+#include "pvt_interface.h"
+#include "pvt_observables.h"
 #include "rtklib.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gnuradio/sync_block.h>  // for sync_block
 #include <gnuradio/types.h>       // for gr_vector_const_void_star
 #include <pmt/pmt.h>              // for pmt_t
+#include <array>                  // for array
+#include <atomic>                 // for atomic
 #include <chrono>                 // for system_clock
 #include <cstddef>                // for size_t
 #include <cstdint>                // for int32_t
 #include <ctime>                  // for time_t
 #include <fstream>                // for std::fstream
+#include <functional>             // for std::function
 #include <map>                    // for map
 #include <memory>                 // for shared_ptr, unique_ptr
+#include <mutex>                  // for mutex
 #include <queue>                  // for std::queue
 #include <string>                 // for string
 #include <sys/types.h>            // for key_t
+#include <utility>                // for pair
 #include <vector>                 // for vector
 
 /** \addtogroup PVT
@@ -50,6 +57,8 @@ class Beidou_Dnav_Ephemeris;
 class Galileo_Almanac;
 class Galileo_Ephemeris;
 class GeoJSON_Printer;
+class Gnss_Block_Stats;
+class Gnss_Monitor_Ring_Writer;
 class Gps_Almanac;
 class Gps_Ephemeris;
 class Gpx_Printer;
@@ -58,6 +67,8 @@ class Monitor_Pvt_Udp_Sink;
 class Monitor_Ephemeris_Udp_Sink;
 class Nmea_Printer;
 class Pvt_Conf;
+class Pvt_Output_Worker;
+class Pvt_Solver_Engines;
 class Rinex_Printer;
 class Rtcm_Printer;
 class An_Packet_Printer;
@@ -124,6 +135,18 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) const;
 
+    /*!
+     * \brief Changes the rate of an output while the receiver runs
+     */
+    bool set_output_rate(const std::string& output, int32_t rate_ms);
+
+    /*!
+     * \brief Satellites used in the last reported position fix, with the
+     * GDOP that the fix would have without each of them. Can be called from
+     * any thread.
+     */
+    std::vector<Pvt_Satellite_Contribution> get_satellite_contributions() const;
+
     int work(int noutput_items, gr_vector_const_void_star& input_items,
         gr_vector_void_star& output_items);  //!< PVT Signal Processing
 
@@ -144,12 +167,21 @@ private:
 
     void initialize_and_apply_carrier_phase_offset();
 
-    void apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
+    void send_vtl_aiding();
+
+    void run_output(const std::unique_ptr<Pvt_Output_Worker>& worker, const std::function<void()>& job);
+
+    void log_rinex_nav(const std::function<void()>& job);
+
+    void apply_rx_clock_offset(Pvt_Observables& observables_map,
         double rx_clock_offset_s);
 
-    std::map<int, Gnss_Synchro> interpolate_observables(const std::map<int, Gnss_Synchro>& observables_map_t0,
-        const std::map<int, Gnss_Synchro>& observables_map_t1,
-        double rx_time_s);
+    void interpolate_observables(const Pvt_Observables& observables_map_t0,
+        const Pvt_Observables& observables_map_t1,
+        double rx_time_s,
+        Pvt_Observables& interp_observables_map);
+
+    bool is_near_output_epoch(double rx_time_s) const;
 
     inline std::time_t convert_to_time_t(const boost::posix_time::ptime pt) const
     {
@@ -165,6 +197,8 @@ private:
     } d_ttff_msgbuf;
     bool send_sys_v_ttff_msg(d_ttff_msgbuf ttff) const;
 
+    void save_used_satellites();
+
     bool save_gnss_synchro_map_xml(const std::string& file_name);  // debug helper function
     bool load_gnss_synchro_map_xml(const std::string& file_name);  // debug helper function
 
@@ -172,6 +206,10 @@ private:
 
     std::shared_ptr<Rtklib_Solver> d_internal_pvt_solver;
     std::shared_ptr<Rtklib_Solver> d_user_pvt_solver;
+    std::shared_ptr<Gnss_Block_Stats> d_work_stats;
+
+    std::vector<std::pair<int, std::array<double, 2>>> d_used_satellites;  // RTKLIB satellite number, and azimuth and elevation [rad]
+    mutable std::mutex d_used_satellites_mutex;
 
     std::unique_ptr<Rinex_Printer> d_rp;
     std::unique_ptr<Kml_Printer> d_kml_dump;
@@ -181,14 +219,23 @@ private:
     std::unique_ptr<Rtcm_Printer> d_rtcm_printer;
     std::unique_ptr<Monitor_Pvt_Udp_Sink> d_udp_sink_ptr;
     std::unique_ptr<Monitor_Ephemeris_Udp_Sink> d_eph_udp_sink_ptr;
+    std::unique_ptr<Gnss_Monitor_Ring_Writer> d_monitor_ring;
     std::unique_ptr<Has_Simple_Printer> d_has_simple_printer;
     std::unique_ptr<An_Packet_Printer> d_an_printer;
+    std::unique_ptr<Pvt_Output_Worker> d_rinex_worker;
+    std::unique_ptr<Pvt_Output_Worker> d_kml_worker;
+    std::unique_ptr<Pvt_Output_Worker> d_gpx_worker;
+    std::unique_ptr<Pvt_Output_Worker> d_nmea_worker;
+    std::unique_ptr<Pvt_Output_Worker> d_geojson_worker;
+    std::unique_ptr<Pvt_Output_Worker> d_an_worker;
+    std::unique_ptr<Pvt_Solver_Engines> d_pvt_engines;
 
     std::chrono::time_point<std::chrono::system_clock> d_start;
     std::chrono::time_point<std::chrono::system_clock> d_end;
 
     std::string d_dump_filename;
     std::string d_xml_base_path;
+    std::string d_warm_start_file;
     std::string d_local_time_str;
 
     std::vector<bool> d_channel_initialized;
@@ -211,9 +258,9 @@ private:
         evBDS_B3
     };
     std::map<std::string, StringValue_> d_mapStringValues;
-    std::map<int, Gnss_Synchro> d_gnss_observables_map;
-    std::map<int, Gnss_Synchro> d_gnss_observables_map_t0;
-    std::map<int, Gnss_Synchro> d_gnss_observables_map_t1;
+    Pvt_Observables d_gnss_observables_map;
+    Pvt_Observables d_gnss_observables_map_t0;
+    Pvt_Observables d_gnss_observables_map_t1;
 
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
 
@@ -255,13 +302,14 @@ private:
     int32_t d_rtcm_MT1087_rate_ms;  // GLONASS MSM7. The type 7 Multiple Signal Message format for the Russian GLONASS system
     int32_t d_rtcm_MT1097_rate_ms;  // Galileo MSM7. The type 7 Multiple Signal Message format for Europe’s Galileo system
     int32_t d_rtcm_MSM_rate_ms;
-    int32_t d_kml_rate_ms;
-    int32_t d_gpx_rate_ms;
-    int32_t d_geojson_rate_ms;
-    int32_t d_nmea_rate_ms;
+    std::atomic<int32_t> d_kml_rate_ms;  // these rates can be changed at run time
+    std::atomic<int32_t> d_gpx_rate_ms;
+    std::atomic<int32_t> d_geojson_rate_ms;
+    std::atomic<int32_t> d_nmea_rate_ms;
     int32_t d_an_rate_ms;
+    int32_t d_warm_start_rate_ms;
     int32_t d_output_rate_ms;
-    int32_t d_display_rate_ms;
+    std::atomic<int32_t> d_display_rate_ms;
     int32_t d_report_rate_ms;
     int32_t d_max_obs_block_rx_clock_offset_ms;
 
@@ -284,6 +332,8 @@ private:
     bool d_show_local_time_zone;
     bool d_waiting_obs_block_rx_clock_offset_correction_msg;
     bool d_enable_rx_clock_correction;
+    bool d_enable_vtl_aiding;
+    bool d_decimate_epochs;
     bool d_enable_has_messages;
     bool d_an_printer_enabled;
     bool d_log_timetag;
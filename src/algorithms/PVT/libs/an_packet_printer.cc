@@ -19,6 +19,8 @@
 
 
 #include "an_packet_printer.h"
+#include "gnss_sdr_stream_writer.h"
+#include "gnss_sdr_trace.h"
 #include "rtklib_solver.h"  // for Rtklib_Solver
 #include <glog/logging.h>   // for DLOG
 #include <cmath>            // for M_PI
@@ -37,6 +39,7 @@ An_Packet_Printer::An_Packet_Printer(const std::string& an_dump_devname)
 {
     if (d_an_dev_descriptor != -1)
         {
+            Gnss_Stream_Writer::instance().add(d_an_dev_descriptor, "AN output " + d_an_devname);
             DLOG(INFO) << "AN Printer writing on " << d_an_devname;
         }
 }
@@ -57,6 +60,7 @@ An_Packet_Printer::~An_Packet_Printer()
 
 bool An_Packet_Printer::print_packet(const Rtklib_Solver* const pvt_data, const std::map<int, Gnss_Synchro>& gnss_observables_map)
 {
+    GNSS_SDR_TRACE_ZONE("An_Packet_Printer::print_packet");
     an_packet_t an_packet{};
     sdr_gnss_packet_t sdr_gnss_packet{};
 
@@ -65,7 +69,7 @@ bool An_Packet_Printer::print_packet(const Rtklib_Solver* const pvt_data, const
 
     if (d_an_dev_descriptor != -1)
         {
-            if (write(d_an_dev_descriptor, &an_packet, sizeof(an_packet)) == -1)
+            if (!Gnss_Stream_Writer::instance().write(d_an_dev_descriptor, &an_packet, sizeof(an_packet)))
                 {
                     LOG(ERROR) << "Advanced Navigation printer cannot write on serial device " << d_an_devname;
                     return false;
@@ -79,6 +83,7 @@ void An_Packet_Printer::close_serial() const
 {
     if (d_an_dev_descriptor != -1)
         {
+            Gnss_Stream_Writer::instance().remove(d_an_dev_descriptor);
             close(d_an_dev_descriptor);
         }
 }
@@ -0,0 +1,343 @@
+/*!
+ * \file columnar_dump.cc
+ * \brief Append-only binary dump file organized in chunks of columns, with
+ * an index footer, and its memory-mapped reader
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "columnar_dump.h"
+#include <glog/logging.h>
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#include <algorithm>   // for std::upper_bound
+#include <exception>
+#include <utility>
+
+
+namespace
+{
+const char FILE_MAGIC[4] = {'G', 'S', 'C', 'D'};
+const char CHUNK_MAGIC[4] = {'C', 'H', 'N', 'K'};
+const char INDEX_MAGIC[4] = {'G', 'S', 'C', 'I'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t CHUNK_HEADER_LENGTH = 8;    // magic and number of records
+constexpr size_t INDEX_ENTRY_LENGTH = 12;    // chunk offset and number of records
+constexpr size_t INDEX_TRAILER_LENGTH = 12;  // number of chunks and magic
+
+
+template <typename T>
+void write_value(std::ofstream& file, T value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+
+template <typename T>
+T read_value(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+}  // namespace
+
+
+size_t columnar_dump_type_size(Columnar_Dump_Type type)
+{
+    switch (type)
+        {
+        case Columnar_Dump_Type::INT8:
+        case Columnar_Dump_Type::UINT8:
+            return 1;
+        case Columnar_Dump_Type::INT32:
+        case Columnar_Dump_Type::UINT32:
+        case Columnar_Dump_Type::FLOAT:
+            return 4;
+        case Columnar_Dump_Type::INT64:
+        case Columnar_Dump_Type::UINT64:
+        case Columnar_Dump_Type::DOUBLE:
+            return 8;
+        default:
+            return 0;
+        }
+}
+
+
+Columnar_Dump_Writer::Columnar_Dump_Writer(std::vector<Columnar_Dump_Column> columns,
+    size_t chunk_records) : d_columns(std::move(columns)),
+                            d_max_records(std::max<size_t>(chunk_records, 1))
+{
+}
+
+
+Columnar_Dump_Writer::~Columnar_Dump_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing the dump file " << e.what();
+        }
+}
+
+
+void Columnar_Dump_Writer::open(const std::string& filename)
+{
+    d_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    d_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    d_file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    write_value<uint32_t>(d_file, FORMAT_VERSION);
+    write_value<uint32_t>(d_file, static_cast<uint32_t>(d_columns.size()));
+    for (const auto& column : d_columns)
+        {
+            const auto length = static_cast<uint8_t>(std::min<size_t>(column.name.length(), 255));
+            write_value<uint8_t>(d_file, static_cast<uint8_t>(column.type));
+            write_value<uint8_t>(d_file, length);
+            d_file.write(column.name.data(), length);
+        }
+    d_chunk.clear();
+    for (const auto& column : d_columns)
+        {
+            d_chunk.emplace_back(d_max_records * columnar_dump_type_size(column.type));
+        }
+    d_records = 0;
+    d_total_records = 0;
+    d_chunk_offsets.clear();
+    d_chunk_records.clear();
+}
+
+
+void Columnar_Dump_Writer::commit()
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    d_records++;
+    d_total_records++;
+    if (d_records == d_max_records)
+        {
+            write_chunk();
+        }
+}
+
+
+void Columnar_Dump_Writer::write_chunk()
+{
+    if (d_records == 0)
+        {
+            return;
+        }
+    d_chunk_offsets.push_back(static_cast<uint64_t>(d_file.tellp()));
+    d_chunk_records.push_back(static_cast<uint32_t>(d_records));
+    d_file.write(CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+    write_value<uint32_t>(d_file, static_cast<uint32_t>(d_records));
+    for (size_t i = 0; i < d_columns.size(); i++)
+        {
+            d_file.write(d_chunk[i].data(), static_cast<std::streamsize>(d_records * columnar_dump_type_size(d_columns[i].type)));
+        }
+    d_records = 0;
+}
+
+
+void Columnar_Dump_Writer::close()
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    write_chunk();
+    for (size_t i = 0; i < d_chunk_offsets.size(); i++)
+        {
+            write_value<uint64_t>(d_file, d_chunk_offsets[i]);
+            write_value<uint32_t>(d_file, d_chunk_records[i]);
+        }
+    write_value<uint64_t>(d_file, static_cast<uint64_t>(d_chunk_offsets.size()));
+    d_file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    d_file.close();
+    d_chunk.clear();
+}
+
+
+Columnar_Dump_Reader::~Columnar_Dump_Reader()
+{
+    close();
+}
+
+
+bool Columnar_Dump_Reader::open(const std::string& filename)
+{
+    close();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            return false;
+        }
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) != 0 || st.st_size < 12)
+        {
+            ::close(fd);
+            return false;
+        }
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        {
+            return false;
+        }
+    madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    d_data = static_cast<const char*>(data);
+    d_length = static_cast<size_t>(st.st_size);
+
+    // header
+    if (std::memcmp(d_data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || read_value<uint32_t>(d_data + 4) != FORMAT_VERSION)
+        {
+            close();
+            return false;
+        }
+    const auto num_columns = read_value<uint32_t>(d_data + 8);
+    size_t pos = 12;
+    for (uint32_t i = 0; i < num_columns; i++)
+        {
+            if (pos + 2 > d_length || read_value<uint8_t>(d_data + pos) > static_cast<uint8_t>(Columnar_Dump_Type::DOUBLE) ||
+                pos + 2 + read_value<uint8_t>(d_data + pos + 1) > d_length)
+                {
+                    close();
+                    return false;
+                }
+            const auto type = static_cast<Columnar_Dump_Type>(read_value<uint8_t>(d_data + pos));
+            const auto length = read_value<uint8_t>(d_data + pos + 1);
+            d_columns.push_back({std::string(d_data + pos + 2, length), type});
+            d_column_offsets.push_back(d_record_size);
+            d_record_size += columnar_dump_type_size(type);
+            pos += 2 + length;
+        }
+    d_header_length = pos;
+
+    if (!read_footer())
+        {
+            walk_chunks();
+        }
+    for (const auto records : d_chunk_records)
+        {
+            d_chunk_first.push_back(d_total_records);
+            d_total_records += records;
+        }
+    return true;
+}
+
+
+bool Columnar_Dump_Reader::read_footer()
+{
+    if (d_length < d_header_length + INDEX_TRAILER_LENGTH ||
+        std::memcmp(d_data + d_length - sizeof(INDEX_MAGIC), INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+        {
+            return false;
+        }
+    const auto num_chunks = read_value<uint64_t>(d_data + d_length - INDEX_TRAILER_LENGTH);
+    if (num_chunks > (d_length - d_header_length - INDEX_TRAILER_LENGTH) / INDEX_ENTRY_LENGTH)
+        {
+            return false;
+        }
+    const size_t index_start = d_length - INDEX_TRAILER_LENGTH - num_chunks * INDEX_ENTRY_LENGTH;
+    for (uint64_t i = 0; i < num_chunks; i++)
+        {
+            const char* entry = d_data + index_start + i * INDEX_ENTRY_LENGTH;
+            const auto offset = read_value<uint64_t>(entry);
+            const auto records = read_value<uint32_t>(entry + 8);
+            if (offset < d_header_length || offset + CHUNK_HEADER_LENGTH + static_cast<uint64_t>(records) * d_record_size > index_start ||
+                std::memcmp(d_data + offset, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 ||
+                read_value<uint32_t>(d_data + offset + 4) != records)
+                {
+                    d_chunk_offsets.clear();
+                    d_chunk_records.clear();
+                    return false;
+                }
+            d_chunk_offsets.push_back(offset);
+            d_chunk_records.push_back(records);
+        }
+    return true;
+}
+
+
+void Columnar_Dump_Reader::walk_chunks()
+{
+    size_t pos = d_header_length;
+    while (pos + CHUNK_HEADER_LENGTH <= d_length && std::memcmp(d_data + pos, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) == 0)
+        {
+            const auto records = read_value<uint32_t>(d_data + pos + 4);
+            const size_t length = CHUNK_HEADER_LENGTH + static_cast<size_t>(records) * d_record_size;
+            if (records == 0 || pos + length > d_length)
+                {
+                    break;  // chunk being written
+                }
+            d_chunk_offsets.push_back(pos);
+            d_chunk_records.push_back(records);
+            pos += length;
+        }
+}
+
+
+void Columnar_Dump_Reader::close()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<char*>(d_data), d_length);
+        }
+    d_data = nullptr;
+    d_length = 0;
+    d_header_length = 0;
+    d_record_size = 0;
+    d_total_records = 0;
+    d_columns.clear();
+    d_column_offsets.clear();
+    d_chunk_offsets.clear();
+    d_chunk_records.clear();
+    d_chunk_first.clear();
+}
+
+
+int32_t Columnar_Dump_Reader::column_index(const std::string& name) const
+{
+    for (size_t i = 0; i < d_columns.size(); i++)
+        {
+            if (d_columns[i].name == name)
+                {
+                    return static_cast<int32_t>(i);
+                }
+        }
+    return -1;
+}
+
+
+const char* Columnar_Dump_Reader::chunk_data(size_t chunk, size_t column) const
+{
+    return d_data + d_chunk_offsets[chunk] + CHUNK_HEADER_LENGTH + d_chunk_records[chunk] * d_column_offsets[column];
+}
+
+
+const char* Columnar_Dump_Reader::locate(size_t column, uint64_t record, size_t size) const
+{
+    if (column >= d_columns.size() || record >= d_total_records || size != columnar_dump_type_size(d_columns[column].type))
+        {
+            return nullptr;
+        }
+    const auto it = std::upper_bound(d_chunk_first.cbegin(), d_chunk_first.cend(), record);
+    const auto chunk = static_cast<size_t>(it - d_chunk_first.cbegin()) - 1;
+    return chunk_data(chunk, column) + (record - d_chunk_first[chunk]) * size;
+}
@@ -0,0 +1,199 @@
+/*!
+ * \file columnar_dump.h
+ * \brief Append-only binary dump file organized in chunks of columns, with
+ * an index footer, and its memory-mapped reader
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COLUMNAR_DUMP_H
+#define GNSS_SDR_COLUMNAR_DUMP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Type of the values of a column
+ */
+enum class Columnar_Dump_Type : uint8_t
+{
+    INT8 = 0,
+    UINT8,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT,
+    DOUBLE
+};
+
+/*!
+ * \brief Size in bytes of a value of the given type
+ */
+size_t columnar_dump_type_size(Columnar_Dump_Type type);
+
+struct Columnar_Dump_Column
+{
+    std::string name;
+    Columnar_Dump_Type type;
+};
+
+
+/*!
+ * \brief Writes records of fixed columns to a binary file.
+ *
+ * The records are buffered and written in chunks, each one holding the
+ * values of a column next to each other:
+ *
+ *   header: "GSCD", version, number of columns, {type, name length, name}
+ *   chunk:  "CHNK", number of records, column 0 values, column 1 values...
+ *   footer: {chunk offset, number of records}, number of chunks, "GSCI"
+ *
+ * The footer is written by close(). A file without it (e.g. the receiver
+ * was killed) is still readable up to its last complete chunk. Values are
+ * stored in the byte order of the host.
+ */
+class Columnar_Dump_Writer
+{
+public:
+    explicit Columnar_Dump_Writer(std::vector<Columnar_Dump_Column> columns, size_t chunk_records = 1024);
+    ~Columnar_Dump_Writer();
+
+    /*!
+     * \brief Creates the file and writes the header. Throws
+     * std::ofstream::failure if the file cannot be written.
+     */
+    void open(const std::string& filename);
+
+    /*!
+     * \brief Writes the pending records and the index footer
+     */
+    void close();
+
+    bool is_open() const { return d_file.is_open(); }
+
+    /*!
+     * \brief Sets the value of a column of the current record. T must be
+     * the type of the column. Only valid while the file is open.
+     */
+    template <typename T>
+    void set(size_t column, T value)
+    {
+        std::memcpy(&d_chunk[column][d_records * sizeof(T)], &value, sizeof(T));
+    }
+
+    /*!
+     * \brief Ends the current record, writing the chunk if it is full
+     */
+    void commit();
+
+    /*!
+     * \brief Number of records committed since open()
+     */
+    uint64_t num_records() const { return d_total_records; }
+
+private:
+    void write_chunk();
+
+    std::vector<Columnar_Dump_Column> d_columns;
+    std::vector<std::vector<char>> d_chunk;
+    std::vector<uint64_t> d_chunk_offsets;
+    std::vector<uint32_t> d_chunk_records;
+    std::ofstream d_file;
+    size_t d_max_records;
+    size_t d_records{0};
+    uint64_t d_total_records{0};
+};
+
+
+/*!
+ * \brief Maps a file written by Columnar_Dump_Writer into memory and gives
+ * access to the values of each chunk without copying them.
+ */
+class Columnar_Dump_Reader
+{
+public:
+    Columnar_Dump_Reader() = default;
+    ~Columnar_Dump_Reader();
+    Columnar_Dump_Reader(const Columnar_Dump_Reader&) = delete;
+    Columnar_Dump_Reader& operator=(const Columnar_Dump_Reader&) = delete;
+
+    /*!
+     * \brief Maps the file and reads its index, from the footer or, if the
+     * file was not closed, by walking the chunks. Returns false if the file
+     * cannot be mapped or has no valid header.
+     */
+    bool open(const std::string& filename);
+    void close();
+
+    const std::vector<Columnar_Dump_Column>& columns() const { return d_columns; }
+
+    /*!
+     * \brief Index of the column with the given name, or -1
+     */
+    int32_t column_index(const std::string& name) const;
+
+    uint64_t num_records() const { return d_total_records; }
+    size_t num_chunks() const { return d_chunk_offsets.size(); }
+    uint32_t chunk_records(size_t chunk) const { return d_chunk_records[chunk]; }
+
+    /*!
+     * \brief Values of a column in a chunk, chunk_records(chunk) of them.
+     * They are not aligned to the size of the type.
+     */
+    const char* chunk_data(size_t chunk, size_t column) const;
+
+    /*!
+     * \brief Reads one value of a column. T must be the type of the column.
+     */
+    template <typename T>
+    bool read(size_t column, uint64_t record, T& value) const
+    {
+        const char* data = locate(column, record, sizeof(T));
+        if (data == nullptr)
+            {
+                return false;
+            }
+        std::memcpy(&value, data, sizeof(T));
+        return true;
+    }
+
+private:
+    const char* locate(size_t column, uint64_t record, size_t size) const;
+    bool read_footer();
+    void walk_chunks();
+
+    std::vector<Columnar_Dump_Column> d_columns;
+    std::vector<uint64_t> d_chunk_offsets;
+    std::vector<uint32_t> d_chunk_records;
+    std::vector<uint64_t> d_chunk_first;
+    std::vector<size_t> d_column_offsets;  // bytes of the previous columns per record
+    const char* d_data{nullptr};
+    size_t d_length{0};
+    size_t d_header_length{0};
+    size_t d_record_size{0};
+    uint64_t d_total_records{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COLUMNAR_DUMP_H
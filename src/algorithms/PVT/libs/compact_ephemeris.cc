@@ -0,0 +1,346 @@
+/*!
+ * \file compact_ephemeris.cc
+ * \brief Compact, delta-encoded binary form of the GPS and Galileo ephemeris
+ * sent by the ephemeris monitor
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compact_ephemeris.h"
+#include <algorithm>  // for std::max
+#include <cstring>    // for std::memcpy
+#include <utility>    // for std::move
+#include <vector>
+
+
+namespace
+{
+constexpr uint8_t KEY_RECORD = 0x01;
+
+// Fields of the records, in the order they are written. Bit i of the mask
+// is the i-th field of the integers, then of the floating point values, and
+// then of the flags.
+template <class Eph>
+struct Field_Table
+{
+    std::vector<int32_t Eph::*> integers;
+    std::vector<double Eph::*> doubles;
+    std::vector<bool Eph::*> flags;
+};
+
+
+const Field_Table<Gps_Ephemeris>& field_table(const Gps_Ephemeris& /*eph*/)
+{
+    static const Field_Table<Gps_Ephemeris> table{
+        {&Gnss_Ephemeris::toe, &Gnss_Ephemeris::toc, &Gnss_Ephemeris::WN, &Gnss_Ephemeris::tow,
+            &Gps_Ephemeris::code_on_L2, &Gps_Ephemeris::SV_accuracy, &Gps_Ephemeris::SV_health,
+            &Gps_Ephemeris::IODC, &Gps_Ephemeris::IODE_SF2, &Gps_Ephemeris::IODE_SF3, &Gps_Ephemeris::AODO},
+        {&Gnss_Ephemeris::M_0, &Gnss_Ephemeris::delta_n, &Gnss_Ephemeris::ecc, &Gnss_Ephemeris::sqrtA,
+            &Gnss_Ephemeris::OMEGA_0, &Gnss_Ephemeris::i_0, &Gnss_Ephemeris::omega, &Gnss_Ephemeris::OMEGAdot,
+            &Gnss_Ephemeris::idot, &Gnss_Ephemeris::Cuc, &Gnss_Ephemeris::Cus, &Gnss_Ephemeris::Crc,
+            &Gnss_Ephemeris::Crs, &Gnss_Ephemeris::Cic, &Gnss_Ephemeris::Cis, &Gnss_Ephemeris::af0,
+            &Gnss_Ephemeris::af1, &Gnss_Ephemeris::af2, &Gnss_Ephemeris::satClkDrift, &Gnss_Ephemeris::dtr,
+            &Gps_Ephemeris::TGD, &Gps_Ephemeris::spare1, &Gps_Ephemeris::spare2},
+        {&Gps_Ephemeris::L2_P_data_flag, &Gps_Ephemeris::fit_interval_flag, &Gps_Ephemeris::integrity_status_flag,
+            &Gps_Ephemeris::alert_flag, &Gps_Ephemeris::antispoofing_flag}};
+    return table;
+}
+
+
+const Field_Table<Galileo_Ephemeris>& field_table(const Galileo_Ephemeris& /*eph*/)
+{
+    static const Field_Table<Galileo_Ephemeris> table{
+        {&Gnss_Ephemeris::toe, &Gnss_Ephemeris::toc, &Gnss_Ephemeris::WN, &Gnss_Ephemeris::tow,
+            &Galileo_Ephemeris::IOD_ephemeris, &Galileo_Ephemeris::IOD_nav, &Galileo_Ephemeris::SISA,
+            &Galileo_Ephemeris::E5a_HS, &Galileo_Ephemeris::E5b_HS, &Galileo_Ephemeris::E1B_HS},
+        {&Gnss_Ephemeris::M_0, &Gnss_Ephemeris::delta_n, &Gnss_Ephemeris::ecc, &Gnss_Ephemeris::sqrtA,
+            &Gnss_Ephemeris::OMEGA_0, &Gnss_Ephemeris::i_0, &Gnss_Ephemeris::omega, &Gnss_Ephemeris::OMEGAdot,
+            &Gnss_Ephemeris::idot, &Gnss_Ephemeris::Cuc, &Gnss_Ephemeris::Cus, &Gnss_Ephemeris::Crc,
+            &Gnss_Ephemeris::Crs, &Gnss_Ephemeris::Cic, &Gnss_Ephemeris::Cis, &Gnss_Ephemeris::af0,
+            &Gnss_Ephemeris::af1, &Gnss_Ephemeris::af2, &Gnss_Ephemeris::satClkDrift, &Gnss_Ephemeris::dtr,
+            &Galileo_Ephemeris::BGD_E1E5a, &Galileo_Ephemeris::BGD_E1E5b},
+        {&Galileo_Ephemeris::E5a_DVS, &Galileo_Ephemeris::E5b_DVS, &Galileo_Ephemeris::E1B_DVS,
+            &Galileo_Ephemeris::flag_all_ephemeris}};
+    return table;
+}
+
+
+uint64_t double_bits(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+
+double bits_to_double(uint64_t bits)
+{
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+
+void put_varint(uint64_t value, std::string& out)
+{
+    while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+    out.push_back(static_cast<char>(value));
+}
+
+
+bool get_varint(const std::string& in, size_t& pos, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= in.size())
+                {
+                    return false;
+                }
+            const auto byte = static_cast<uint8_t>(in[pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value < 0 ? -1 : 0);
+}
+
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+
+// The XOR of two close values has its leading bytes (sign, exponent, first
+// bits of the mantissa) at zero, and broadcast parameters are scaled
+// integers, whose last mantissa bytes are zero. Only the bytes in between
+// are written, most significant first.
+void put_xor(uint64_t value, std::string& out)
+{
+    int leading = 0;
+    while (leading < 8 && ((value >> (8 * (7 - leading))) & 0xFF) == 0)
+        {
+            leading++;
+        }
+    int trailing = 0;
+    while (leading + trailing < 8 && ((value >> (8 * trailing)) & 0xFF) == 0)
+        {
+            trailing++;
+        }
+    out.push_back(static_cast<char>((leading << 4) | trailing));
+    for (int b = 7 - leading; b >= trailing; b--)
+        {
+            out.push_back(static_cast<char>((value >> (8 * b)) & 0xFF));
+        }
+}
+
+
+bool get_xor(const std::string& in, size_t& pos, uint64_t& value)
+{
+    if (pos >= in.size())
+        {
+            return false;
+        }
+    const auto header = static_cast<uint8_t>(in[pos++]);
+    const int leading = header >> 4;
+    const int trailing = header & 0x0F;
+    if (leading + trailing > 8 || pos + static_cast<size_t>(8 - leading - trailing) > in.size())
+        {
+            return false;
+        }
+    value = 0;
+    for (int b = 7 - leading; b >= trailing; b--)
+        {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(in[pos++])) << (8 * b);
+        }
+    return true;
+}
+}  // namespace
+
+
+Compact_Ephemeris_Encoder::Compact_Ephemeris_Encoder(uint32_t keyframe_interval)
+    : d_keyframe_interval(std::max<uint32_t>(keyframe_interval, 1))
+{
+}
+
+
+void Compact_Ephemeris_Encoder::encode(const Gps_Ephemeris& eph, std::string& out)
+{
+    encode(eph, 'g', d_gps, out);
+}
+
+
+void Compact_Ephemeris_Encoder::encode(const Galileo_Ephemeris& eph, std::string& out)
+{
+    encode(eph, 'e', d_galileo, out);
+}
+
+
+template <class Eph>
+void Compact_Ephemeris_Encoder::encode(const Eph& eph, char system, std::map<uint32_t, State<Eph>>& states, std::string& out)
+{
+    static const Eph zero{};
+    const auto& table = field_table(eph);
+    auto it = states.find(eph.PRN);
+    const bool key = it == states.end() || it->second.since_keyframe + 1 >= d_keyframe_interval;
+    if (it == states.end())
+        {
+            it = states.emplace(eph.PRN, State<Eph>()).first;
+        }
+    else
+        {
+            it->second.sequence++;
+        }
+    State<Eph>& state = it->second;
+    const Eph& base = key ? zero : state.last;
+
+    uint64_t mask = 0;
+    int bit = 0;
+    for (const auto field : table.integers)
+        {
+            mask |= static_cast<uint64_t>(key || eph.*field != base.*field) << bit++;
+        }
+    for (const auto field : table.doubles)
+        {
+            mask |= static_cast<uint64_t>(key || double_bits(eph.*field) != double_bits(base.*field)) << bit++;
+        }
+    for (const auto field : table.flags)
+        {
+            mask |= static_cast<uint64_t>(key || eph.*field != base.*field) << bit++;
+        }
+
+    out.clear();
+    out.push_back(system);
+    out.push_back(static_cast<char>(eph.PRN & 0xFF));
+    out.push_back(static_cast<char>(key ? KEY_RECORD : 0));
+    out.push_back(static_cast<char>(state.sequence));
+    put_varint(mask, out);
+    bit = 0;
+    for (const auto field : table.integers)
+        {
+            if ((mask >> bit++) & 1)
+                {
+                    put_varint(zigzag(static_cast<int64_t>(eph.*field) - static_cast<int64_t>(base.*field)), out);
+                }
+        }
+    for (const auto field : table.doubles)
+        {
+            if ((mask >> bit++) & 1)
+                {
+                    put_xor(double_bits(eph.*field) ^ double_bits(base.*field), out);
+                }
+        }
+    for (const auto field : table.flags)
+        {
+            if ((mask >> bit++) & 1)
+                {
+                    out.push_back(static_cast<char>(eph.*field ? 1 : 0));
+                }
+        }
+
+    state.last = eph;
+    state.since_keyframe = key ? 0 : state.since_keyframe + 1;
+}
+
+
+bool Compact_Ephemeris_Decoder::decode(const std::string& record, Gps_Ephemeris& eph)
+{
+    return decode(record, 'g', d_gps, eph);
+}
+
+
+bool Compact_Ephemeris_Decoder::decode(const std::string& record, Galileo_Ephemeris& eph)
+{
+    return decode(record, 'e', d_galileo, eph);
+}
+
+
+template <class Eph>
+bool Compact_Ephemeris_Decoder::decode(const std::string& record, char system, std::map<uint32_t, State<Eph>>& states, Eph& eph)
+{
+    static const Eph zero{};
+    if (record.size() < 5 || record[0] != system)
+        {
+            return false;
+        }
+    const auto prn = static_cast<uint32_t>(static_cast<uint8_t>(record[1]));
+    const bool key = (static_cast<uint8_t>(record[2]) & KEY_RECORD) != 0;
+    const auto sequence = static_cast<uint8_t>(record[3]);
+    State<Eph>& state = states[prn];
+    if (!key && (!state.valid || sequence != static_cast<uint8_t>(state.sequence + 1)))
+        {
+            state.valid = false;  // wait for the next key record
+            return false;
+        }
+
+    size_t pos = 4;
+    uint64_t mask = 0;
+    if (!get_varint(record, pos, mask))
+        {
+            return false;
+        }
+    const auto& table = field_table(eph);
+    Eph decoded = key ? zero : state.last;
+    int bit = 0;
+    for (const auto field : table.integers)
+        {
+            uint64_t value = 0;
+            if (((mask >> bit++) & 1) && !get_varint(record, pos, value))
+                {
+                    return false;
+                }
+            decoded.*field = static_cast<int32_t>(static_cast<int64_t>(decoded.*field) + unzigzag(value));
+        }
+    for (const auto field : table.doubles)
+        {
+            uint64_t value = 0;
+            if (((mask >> bit++) & 1) && !get_xor(record, pos, value))
+                {
+                    return false;
+                }
+            decoded.*field = bits_to_double(double_bits(decoded.*field) ^ value);
+        }
+    for (const auto field : table.flags)
+        {
+            if ((mask >> bit++) & 1)
+                {
+                    if (pos >= record.size())
+                        {
+                            return false;
+                        }
+                    decoded.*field = record[pos++] != 0;
+                }
+        }
+    if (pos != record.size())
+        {
+            return false;
+        }
+
+    decoded.PRN = prn;
+    state.last = decoded;
+    state.sequence = sequence;
+    state.valid = true;
+    eph = std::move(decoded);
+    return true;
+}
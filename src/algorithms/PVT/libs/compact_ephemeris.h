@@ -0,0 +1,119 @@
+/*!
+ * \file compact_ephemeris.h
+ * \brief Compact, delta-encoded binary form of the GPS and Galileo ephemeris
+ * sent by the ephemeris monitor
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPACT_EPHEMERIS_H
+#define GNSS_SDR_COMPACT_EPHEMERIS_H
+
+#include "galileo_ephemeris.h"
+#include "gps_ephemeris.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes ephemeris in a compact binary form, where each record only
+ * carries what changed since the previous record of the same satellite.
+ *
+ * A record is made of:
+ *  - 'g' (GPS) or 'e' (Galileo),
+ *  - the PRN (1 byte),
+ *  - flags (1 byte, bit 0 set in key records),
+ *  - a sequence number, counted per satellite (1 byte),
+ *  - the mask of the fields that follow, as a varint,
+ *  - the fields in the mask, in a fixed order. Integers are written as the
+ *    zigzag varint of their difference with the previous value. Floating
+ *    point values are written as their bits XORed with the previous ones,
+ *    without the leading and trailing zero bytes (one byte tells how many
+ *    were dropped). Flags take one byte each.
+ *
+ * In key records the previous values are all zero and every field is
+ * present, so that they can be decoded on their own. A key record is sent
+ * for the first ephemeris of each satellite and then every keyframe_interval
+ * records, so that a client that joins late or misses a datagram recovers.
+ */
+class Compact_Ephemeris_Encoder
+{
+public:
+    explicit Compact_Ephemeris_Encoder(uint32_t keyframe_interval = 4);
+
+    void encode(const Gps_Ephemeris& eph, std::string& out);      //!< Replaces the contents of out by the record
+    void encode(const Galileo_Ephemeris& eph, std::string& out);  //!< Replaces the contents of out by the record
+
+private:
+    template <class Eph>
+    struct State
+    {
+        Eph last;
+        uint32_t since_keyframe{};
+        uint8_t sequence{};
+    };
+
+    template <class Eph>
+    void encode(const Eph& eph, char system, std::map<uint32_t, State<Eph>>& states, std::string& out);
+
+    std::map<uint32_t, State<Gps_Ephemeris>> d_gps;
+    std::map<uint32_t, State<Galileo_Ephemeris>> d_galileo;
+    uint32_t d_keyframe_interval;
+};
+
+
+/*!
+ * \brief Rebuilds the ephemeris from the records of
+ * Compact_Ephemeris_Encoder.
+ */
+class Compact_Ephemeris_Decoder
+{
+public:
+    /*!
+     * \brief Decodes a GPS record ('g'). Returns false if the record is not a
+     * GPS record, is malformed, or is a delta whose previous record was not
+     * received. In that case the satellite is skipped until its next key
+     * record.
+     */
+    bool decode(const std::string& record, Gps_Ephemeris& eph);
+
+    /*!
+     * \brief Decodes a Galileo record ('e'), as above.
+     */
+    bool decode(const std::string& record, Galileo_Ephemeris& eph);
+
+private:
+    template <class Eph>
+    struct State
+    {
+        Eph last;
+        uint8_t sequence{};
+        bool valid{};
+    };
+
+    template <class Eph>
+    bool decode(const std::string& record, char system, std::map<uint32_t, State<Eph>>& states, Eph& eph);
+
+    std::map<uint32_t, State<Gps_Ephemeris>> d_gps;
+    std::map<uint32_t, State<Galileo_Ephemeris>> d_galileo;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPACT_EPHEMERIS_H
@@ -18,6 +18,7 @@
 
 #include "geojson_printer.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_trace.h"
 #include "pvt_solution.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -158,6 +159,7 @@ bool GeoJSON_Printer::set_headers(const std::string& filename, bool time_tag_nam
 
 bool GeoJSON_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
+    GNSS_SDR_TRACE_ZONE("GeoJSON_Printer::print_position");
     double latitude;
     double longitude;
     double height;
@@ -177,16 +179,17 @@ bool GeoJSON_Printer::print_position(const Pvt_Solution* const position, bool pr
 
     if (geojson_file.is_open())
         {
+            position_text.clear();
             if (first_pos == true)
                 {
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
                     first_pos = false;
                 }
             else
                 {
-                    geojson_file << ",\n";
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
+                    position_text << ",\n";
                 }
+            position_text << "       [" << longitude << ", " << latitude << ", " << height << "]";
+            geojson_file.write(position_text.data(), position_text.size());
             return true;
         }
     return false;
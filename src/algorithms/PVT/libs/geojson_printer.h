@@ -20,6 +20,7 @@
 #define GNSS_SDR_GEOJSON_PRINTER_H
 
 
+#include "pvt_text_format.h"
 #include <fstream>
 #include <string>
 
@@ -47,6 +48,7 @@ public:
 
 private:
     std::ofstream geojson_file;
+    Pvt_Text_Buffer position_text{14};  // reused by each position
     std::string filename_;
     std::string geojson_base_path;
     bool first_pos;
@@ -18,6 +18,7 @@
 
 #include "gpx_printer.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_trace.h"
 #include "pvt_solution.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -142,6 +143,7 @@ bool Gpx_Printer::set_headers(const std::string& filename, bool time_tag_name)
 
 bool Gpx_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
+    GNSS_SDR_TRACE_ZONE("Gpx_Printer::print_position");
     double latitude;
     double longitude;
     double height;
@@ -177,13 +179,15 @@ bool Gpx_Printer::print_position(const Pvt_Solution* const position, bool print_
 
     if (gpx_file.is_open())
         {
-            gpx_file << indent << indent << indent << "<trkpt lon=\"" << longitude << "\" lat=\"" << latitude << "\"><ele>" << height << "</ele>"
-                     << "<time>" << utc_time << "</time>"
-                     << "<hdop>" << hdop << "</hdop><vdop>" << vdop << "</vdop><pdop>" << pdop << "</pdop>"
-                     << "<extensions><gpxtpx:TrackPointExtension>"
-                     << "<gpxtpx:speed>" << speed_over_ground << "</gpxtpx:speed>"
-                     << "<gpxtpx:course>" << course_over_ground << "</gpxtpx:course>"
-                     << "</gpxtpx:TrackPointExtension></extensions></trkpt>\n";
+            position_text.clear();
+            position_text << indent << indent << indent << "<trkpt lon=\"" << longitude << "\" lat=\"" << latitude << "\"><ele>" << height << "</ele>"
+                          << "<time>" << utc_time << "</time>"
+                          << "<hdop>" << hdop << "</hdop><vdop>" << vdop << "</vdop><pdop>" << pdop << "</pdop>"
+                          << "<extensions><gpxtpx:TrackPointExtension>"
+                          << "<gpxtpx:speed>" << speed_over_ground << "</gpxtpx:speed>"
+                          << "<gpxtpx:course>" << course_over_ground << "</gpxtpx:course>"
+                          << "</gpxtpx:TrackPointExtension></extensions></trkpt>\n";
+            gpx_file.write(position_text.data(), position_text.size());
             return true;
         }
     return false;
@@ -20,6 +20,7 @@
 #define GNSS_SDR_GPX_PRINTER_H
 
 
+#include "pvt_text_format.h"
 #include <fstream>
 #include <string>
 
@@ -47,6 +48,7 @@ public:
 
 private:
     std::ofstream gpx_file;
+    Pvt_Text_Buffer position_text{14};  // reused by each position
     std::string gpx_filename;
     std::string indent;
     std::string gpx_base_path;
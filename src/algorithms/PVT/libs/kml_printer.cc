@@ -18,6 +18,7 @@
 
 #include "kml_printer.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_trace.h"
 #include "pvt_solution.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -211,6 +212,7 @@ bool Kml_Printer::set_headers(const std::string& filename, bool time_tag_name)
 
 bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_average_values)
 {
+    GNSS_SDR_TRACE_ZONE("Kml_Printer::print_position");
     double latitude;
     double longitude;
     double height;
@@ -247,34 +249,38 @@ bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_
     if (kml_file.is_open() && tmp_file.is_open())
         {
             point_id++;
-            kml_file << indent << indent << indent << "<Placemark>\n"
-                     << indent << indent << indent << indent << "<name>" << point_id << "</name>\n"
-                     << indent << indent << indent << indent << "<snippet/>\n"
-                     << indent << indent << indent << indent << "<description><![CDATA[\n"
-                     << indent << indent << indent << indent << indent << "<table>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Time:</td><td>" << utc_time << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Longitude:</td><td>" << longitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Latitude:</td><td>" << latitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Altitude:</td><td>" << height << "</td><td>m</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Speed:</td><td>" << speed_over_ground << "</td><td>m/s</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Course:</td><td>" << course_over_ground << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>HDOP:</td><td>" << hdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>VDOP:</td><td>" << vdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>PDOP:</td><td>" << pdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << "</table>\n"
-                     << indent << indent << indent << indent << "]]></description>\n"
-                     << indent << indent << indent << indent << "<TimeStamp>\n"
-                     << indent << indent << indent << indent << indent << "<when>" << utc_time << "</when>\n"
-                     << indent << indent << indent << indent << "</TimeStamp>\n"
-                     << indent << indent << indent << indent << "<styleUrl>#track</styleUrl>\n"
-                     << indent << indent << indent << indent << "<Point>\n"
-                     << indent << indent << indent << indent << indent << "<altitudeMode>absolute</altitudeMode>\n"
-                     << indent << indent << indent << indent << indent << "<coordinates>" << longitude << "," << latitude << "," << height << "</coordinates>\n"
-                     << indent << indent << indent << indent << "</Point>\n"
-                     << indent << indent << indent << "</Placemark>\n";
-
-            tmp_file << indent << indent << indent << indent << indent
-                     << longitude << "," << latitude << "," << height << '\n';
+            position_text.clear();
+            position_text << indent << indent << indent << "<Placemark>\n"
+                          << indent << indent << indent << indent << "<name>" << point_id << "</name>\n"
+                          << indent << indent << indent << indent << "<snippet/>\n"
+                          << indent << indent << indent << indent << "<description><![CDATA[\n"
+                          << indent << indent << indent << indent << indent << "<table>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Time:</td><td>" << utc_time << "</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Longitude:</td><td>" << longitude << "</td><td>deg</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Latitude:</td><td>" << latitude << "</td><td>deg</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Altitude:</td><td>" << height << "</td><td>m</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Speed:</td><td>" << speed_over_ground << "</td><td>m/s</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>Course:</td><td>" << course_over_ground << "</td><td>deg</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>HDOP:</td><td>" << hdop << "</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>VDOP:</td><td>" << vdop << "</td></tr>\n"
+                          << indent << indent << indent << indent << indent << indent << "<tr><td>PDOP:</td><td>" << pdop << "</td></tr>\n"
+                          << indent << indent << indent << indent << indent << "</table>\n"
+                          << indent << indent << indent << indent << "]]></description>\n"
+                          << indent << indent << indent << indent << "<TimeStamp>\n"
+                          << indent << indent << indent << indent << indent << "<when>" << utc_time << "</when>\n"
+                          << indent << indent << indent << indent << "</TimeStamp>\n"
+                          << indent << indent << indent << indent << "<styleUrl>#track</styleUrl>\n"
+                          << indent << indent << indent << indent << "<Point>\n"
+                          << indent << indent << indent << indent << indent << "<altitudeMode>absolute</altitudeMode>\n"
+                          << indent << indent << indent << indent << indent << "<coordinates>" << longitude << "," << latitude << "," << height << "</coordinates>\n"
+                          << indent << indent << indent << indent << "</Point>\n"
+                          << indent << indent << indent << "</Placemark>\n";
+            kml_file.write(position_text.data(), position_text.size());
+
+            position_text.clear();
+            position_text << indent << indent << indent << indent << indent
+                          << longitude << "," << latitude << "," << height << '\n';
+            tmp_file.write(position_text.data(), position_text.size());
 
             return true;
         }
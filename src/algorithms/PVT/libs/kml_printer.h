@@ -19,6 +19,7 @@
 #ifndef GNSS_SDR_KML_PRINTER_H
 #define GNSS_SDR_KML_PRINTER_H
 
+#include "pvt_text_format.h"
 #include <fstream>  // for ofstream
 #include <string>
 
@@ -47,6 +48,7 @@ public:
 private:
     std::ofstream kml_file;
     std::ofstream tmp_file;
+    Pvt_Text_Buffer position_text{14};  // reused by each position
     std::string kml_filename;
     std::string kml_base_path;
     std::string tmp_file_str;
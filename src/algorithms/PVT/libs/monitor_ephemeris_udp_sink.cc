@@ -23,8 +23,12 @@
 
 Monitor_Ephemeris_Udp_Sink::Monitor_Ephemeris_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
-    bool protobuf_enabled) : socket{io_context},
-                             use_protobuf(protobuf_enabled)
+    bool protobuf_enabled,
+    bool only_new_ephemeris,
+    bool compact_enabled) : socket{io_context},
+                            use_protobuf(protobuf_enabled),
+                            only_new(only_new_ephemeris),
+                            use_compact(compact_enabled)
 {
     for (const auto& address : addresses)
         {
@@ -41,8 +45,15 @@ Monitor_Ephemeris_Udp_Sink::Monitor_Ephemeris_Udp_Sink(const std::vector<std::st
 
 bool Monitor_Ephemeris_Udp_Sink::write_galileo_ephemeris(const std::shared_ptr<Galileo_Ephemeris>& monitor_gal_eph)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    if (only_new && !is_new(*monitor_gal_eph))
+        {
+            return true;
+        }
+    if (use_compact)
+        {
+            compact_encoder.encode(*monitor_gal_eph, outbound_data);
+        }
+    else if (use_protobuf == false)
         {
             std::ostringstream archive_stream;
             boost::archive::binary_oarchive oa{archive_stream};
@@ -54,32 +65,21 @@ bool Monitor_Ephemeris_Udp_Sink::write_galileo_ephemeris(const std::shared_ptr<G
             outbound_data = "E";
             outbound_data.append(serdes_gal.createProtobuffer(monitor_gal_eph));
         }
-
-    for (const auto& endpoint : endpoints)
-        {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            return false;
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    return false;
-                }
-        }
-    return true;
+    return send(outbound_data);
 }
 
 
 bool Monitor_Ephemeris_Udp_Sink::write_gps_ephemeris(const std::shared_ptr<Gps_Ephemeris>& monitor_gps_eph)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    if (only_new && !is_new(*monitor_gps_eph))
+        {
+            return true;
+        }
+    if (use_compact)
+        {
+            compact_encoder.encode(*monitor_gps_eph, outbound_data);
+        }
+    else if (use_protobuf == false)
         {
             std::ostringstream archive_stream;
             boost::archive::binary_oarchive oa{archive_stream};
@@ -91,7 +91,38 @@ bool Monitor_Ephemeris_Udp_Sink::write_gps_ephemeris(const std::shared_ptr<Gps_E
             outbound_data = "G";
             outbound_data.append(serdes_gps.createProtobuffer(monitor_gps_eph));
         }
+    return send(outbound_data);
+}
+
 
+bool Monitor_Ephemeris_Udp_Sink::is_new(const Gps_Ephemeris& eph)
+{
+    const std::array<int32_t, 4> issue{eph.IODC, eph.IODE_SF2, eph.IODE_SF3, eph.toe};
+    auto it = last_gps_issue.find(eph.PRN);
+    if (it != last_gps_issue.end() && it->second == issue)
+        {
+            return false;
+        }
+    last_gps_issue[eph.PRN] = issue;
+    return true;
+}
+
+
+bool Monitor_Ephemeris_Udp_Sink::is_new(const Galileo_Ephemeris& eph)
+{
+    const std::array<int32_t, 3> issue{eph.IOD_nav, eph.IOD_ephemeris, eph.toe};
+    auto it = last_galileo_issue.find(eph.PRN);
+    if (it != last_galileo_issue.end() && it->second == issue)
+        {
+            return false;
+        }
+    last_galileo_issue[eph.PRN] = issue;
+    return true;
+}
+
+
+bool Monitor_Ephemeris_Udp_Sink::send(const std::string& data)
+{
     for (const auto& endpoint : endpoints)
         {
             socket.open(endpoint.protocol(), error);
@@ -99,7 +130,7 @@ bool Monitor_Ephemeris_Udp_Sink::write_gps_ephemeris(const std::shared_ptr<Gps_E
 
             try
                 {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
+                    if (socket.send(boost::asio::buffer(data)) == 0)
                         {
                             return false;
                         }
@@ -18,11 +18,15 @@
 #ifndef GNSS_SDR_MONITOR_EPHEMERIS_UDP_SINK_H
 #define GNSS_SDR_MONITOR_EPHEMERIS_UDP_SINK_H
 
+#include "compact_ephemeris.h"
 #include "galileo_ephemeris.h"
 #include "gps_ephemeris.h"
 #include "serdes_galileo_eph.h"
 #include "serdes_gps_eph.h"
 #include <boost/asio.hpp>
+#include <array>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,21 +43,49 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+/*!
+ * \brief Sends the GPS and Galileo ephemeris to a set of UDP clients.
+ *
+ * If only_new_ephemeris is set, an ephemeris is only sent when its issue of
+ * data (IODC and IODE for GPS, IODnav for Galileo) or its reference time
+ * change, not every time the telemetry decoder delivers it again. If
+ * compact_enabled is set, the ephemeris are sent in the delta-encoded form of
+ * Compact_Ephemeris_Encoder instead of Boost archives or Protocol Buffers.
+ */
 class Monitor_Ephemeris_Udp_Sink
 {
 public:
-    Monitor_Ephemeris_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool protobuf_enabled);
+    Monitor_Ephemeris_Udp_Sink(const std::vector<std::string>& addresses,
+        const uint16_t& port,
+        bool protobuf_enabled,
+        bool only_new_ephemeris = false,
+        bool compact_enabled = false);
+
+    /*!
+     * \brief Sends the ephemeris if it is new. Returns false if the sending
+     * failed.
+     */
     bool write_gps_ephemeris(const std::shared_ptr<Gps_Ephemeris>& monitor_gps_eph);
     bool write_galileo_ephemeris(const std::shared_ptr<Galileo_Ephemeris>& monitor_gal_eph);
 
 private:
+    bool is_new(const Gps_Ephemeris& eph);
+    bool is_new(const Galileo_Ephemeris& eph);
+    bool send(const std::string& data);
+
     Serdes_Galileo_Eph serdes_gal;
     Serdes_Gps_Eph serdes_gps;
+    Compact_Ephemeris_Encoder compact_encoder;
+    std::map<uint32_t, std::array<int32_t, 4>> last_gps_issue;      // IODC, IODE_SF2, IODE_SF3, toe by PRN
+    std::map<uint32_t, std::array<int32_t, 3>> last_galileo_issue;  // IOD_nav, IOD_ephemeris, toe by PRN
+    std::string outbound_data;
     b_io_context io_context;
     boost::asio::ip::udp::socket socket;
     std::vector<boost::asio::ip::udp::endpoint> endpoints;
     boost::system::error_code error;
     bool use_protobuf;
+    bool only_new;
+    bool use_compact;
 };
 
 
@@ -16,60 +16,54 @@
  */
 
 #include "monitor_pvt_udp_sink.h"
+#include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_udp_sender.h"
 #include <boost/archive/binary_oarchive.hpp>
-#include <iostream>
-#include <sstream>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <glog/logging.h>
+#include <utility>
 
 
 Monitor_Pvt_Udp_Sink::Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
-    bool protobuf_enabled) : socket{io_context},
-                             use_protobuf(protobuf_enabled)
+    bool protobuf_enabled) : use_protobuf(protobuf_enabled)
 {
+    std::vector<boost::asio::ip::udp::endpoint> endpoints;
     for (const auto& address : addresses)
         {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
-        }
-
-    if (use_protobuf)
-        {
-            serdes = Serdes_Monitor_Pvt();
+            boost::system::error_code error;
+            const auto ip = boost::asio::ip::address::from_string(address, error);
+            if (error)
+                {
+                    LOG(WARNING) << "Invalid address for the PVT monitor: " << address;
+                    continue;
+                }
+            endpoints.emplace_back(ip, port);
         }
+    sender = std::make_unique<Gnss_Udp_Sender>(std::move(endpoints));
 }
 
 
+Monitor_Pvt_Udp_Sink::~Monitor_Pvt_Udp_Sink() = default;
+
+
 bool Monitor_Pvt_Udp_Sink::write_monitor_pvt(const Monitor_Pvt* const monitor_pvt)
 {
-    std::string outbound_data;
+    std::string outbound_data = sender->get_buffer();
     if (use_protobuf == false)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << *monitor_pvt;
-            outbound_data = archive_stream.str();
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << *monitor_pvt;
+            }
+            archive_stream.flush();
         }
     else
         {
-            outbound_data = serdes.createProtobuffer(monitor_pvt);
-        }
-
-    for (const auto& endpoint : endpoints)
-        {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            return false;
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    return false;
-                }
+            serdes.createProtobuffer(monitor_pvt, outbound_data);
         }
+    sender->send(std::move(outbound_data));
     return true;
 }
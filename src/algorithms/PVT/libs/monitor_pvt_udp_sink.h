@@ -37,22 +37,25 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+class Gnss_Udp_Sender;
+
+/*!
+ * \brief Sends serialized Monitor_Pvt objects over UDP to one or multiple
+ * endpoints, from the thread of a Gnss_Udp_Sender.
+ */
 class Monitor_Pvt_Udp_Sink
 {
 public:
     Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool protobuf_enabled);
+    ~Monitor_Pvt_Udp_Sink();
     bool write_monitor_pvt(const Monitor_Pvt* const monitor_pvt);
 
 private:
     Serdes_Monitor_Pvt serdes;
-    b_io_context io_context;
-    boost::asio::ip::udp::socket socket;
-    std::vector<boost::asio::ip::udp::endpoint> endpoints;
-    boost::system::error_code error;
+    std::unique_ptr<Gnss_Udp_Sender> sender;
     bool use_protobuf;
 };
 
-
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_MONITOR_PVT_UDP_SINK_H
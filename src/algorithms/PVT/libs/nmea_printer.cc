@@ -21,6 +21,8 @@
 
 #include "nmea_printer.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_stream_writer.h"
+#include "gnss_sdr_trace.h"
 #include "rtklib_solution.h"
 #include "rtklib_solver.h"
 #include <glog/logging.h>
@@ -93,6 +95,7 @@ Nmea_Printer::Nmea_Printer(const std::string& filename,
             nmea_dev_descriptor = init_serial(nmea_devname);
             if (nmea_dev_descriptor != -1)
                 {
+                    Gnss_Stream_Writer::instance().add(nmea_dev_descriptor, "NMEA output " + nmea_devname);
                     DLOG(INFO) << "NMEA printer writing on " << nmea_devname.c_str();
                 }
         }
@@ -185,6 +188,7 @@ void Nmea_Printer::close_serial() const
 {
     if (nmea_dev_descriptor != -1)
         {
+            Gnss_Stream_Writer::instance().remove(nmea_dev_descriptor);
             close(nmea_dev_descriptor);
         }
 }
@@ -192,34 +196,20 @@ void Nmea_Printer::close_serial() const
 
 bool Nmea_Printer::Print_Nmea_Line(const Rtklib_Solver* const pvt_data, bool print_average_values)
 {
+    GNSS_SDR_TRACE_ZONE("Nmea_Printer::Print_Nmea_Line");
     // set the new PVT data
     d_PVT_data = pvt_data;
     print_avg_pos = print_average_values;
 
-    // generate the NMEA sentences
-
-    // GPRMC
-    const std::string GPRMC = get_GPRMC();
-    // GPGGA (Global Positioning System Fixed Data)
-    const std::string GPGGA = get_GPGGA();
-    // GPGSA
-    const std::string GPGSA = get_GPGSA();
-    // GPGSV
-    const std::string GPGSV = get_GPGSV();
+    // generate the NMEA sentences, one after the other in the same buffer
+    const size_t length = print_sentences();
 
     // write to log file
     if (d_flag_nmea_output_file)
         {
             try
                 {
-                    // GPRMC
-                    nmea_file_descriptor << GPRMC;
-                    // GPGGA (Global Positioning System Fixed Data)
-                    nmea_file_descriptor << GPGGA;
-                    // GPGSA
-                    nmea_file_descriptor << GPGSA;
-                    // GPGSV
-                    nmea_file_descriptor << GPGSV;
+                    nmea_file_descriptor.write(reinterpret_cast<const char*>(d_sentences.data()), static_cast<std::streamsize>(length));
                 }
             catch (const std::exception& ex)
                 {
@@ -230,22 +220,7 @@ bool Nmea_Printer::Print_Nmea_Line(const Rtklib_Solver* const pvt_data, bool pri
     // write to serial device
     if (nmea_dev_descriptor != -1)
         {
-            if (write(nmea_dev_descriptor, GPRMC.c_str(), GPRMC.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGGA.c_str(), GPGGA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSA.c_str(), GPGSA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSV.c_str(), GPGSV.length()) == -1)
+            if (!Gnss_Stream_Writer::instance().write(nmea_dev_descriptor, d_sentences.data(), length))
                 {
                     DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
                     return false;
@@ -391,48 +366,21 @@ std::string Nmea_Printer::get_UTC_NMEA_time(const boost::posix_time::ptime d_pos
 }
 
 
-std::string Nmea_Printer::get_GPRMC() const
+size_t Nmea_Printer::print_sentences()
 {
+    const sol_t* sol = &d_PVT_data->pvt_sol;
+    const ssat_t* ssat = d_PVT_data->pvt_ssat.data();
+    unsigned char* p = d_sentences.data();
     // Sample -> $GPRMC,161229.487,A,3723.2475,N,12158.3416,W,0.13,309.62,120598,*10
-    std::stringstream sentence_str;
-    std::array<unsigned char, 1024> buff{};
-    outnmea_rmc(buff.data(), &d_PVT_data->pvt_sol);
-    sentence_str << buff.data();
-    return sentence_str.str();
-}
-
-
-std::string Nmea_Printer::get_GPGSA() const
-{
-    // $GPGSA,A,3,07,02,26,27,09,04,15, , , , , ,1.8,1.0,1.5*33
+    p += outnmea_rmc(p, sol);
+    // $GPGGA,104427.591,5920.7009,N,01803.2938,E,1,05,3.3,78.2,M,23.2,M,0.0,0000*4A
+    p += outnmea_gga(p, sol);
     // GSA-GNSS DOP and Active Satellites
-    std::stringstream sentence_str;
-    std::array<unsigned char, 1024> buff{};
-    outnmea_gsa(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
-    sentence_str << buff.data();
-    return sentence_str.str();
-}
-
-
-std::string Nmea_Printer::get_GPGSV() const
-{
+    // $GPGSA,A,3,07,02,26,27,09,04,15, , , , , ,1.8,1.0,1.5*33
+    p += outnmea_gsa(p, sol, ssat);
     // GSV-GNSS Satellites in View
     // $GPGSV,2,1,07,07,79,048,42,02,51,062,43,26,36,256,42,27,27,138,42*71
     // Notice that NMEA 2.1 only supports 12 channels
-    std::stringstream sentence_str;
-    std::array<unsigned char, 1024> buff{};
-    outnmea_gsv(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
-    sentence_str << buff.data();
-    return sentence_str.str();
-}
-
-
-std::string Nmea_Printer::get_GPGGA() const
-{
-    std::stringstream sentence_str;
-    std::array<unsigned char, 1024> buff{};
-    outnmea_gga(buff.data(), &d_PVT_data->pvt_sol);
-    sentence_str << buff.data();
-    return sentence_str.str();
-    // $GPGGA,104427.591,5920.7009,N,01803.2938,E,1,05,3.3,78.2,M,23.2,M,0.0,0000*4A
+    p += outnmea_gsv(p, sol, ssat);
+    return static_cast<size_t>(p - d_sentences.data());
 }
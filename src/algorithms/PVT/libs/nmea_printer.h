@@ -23,6 +23,8 @@
 #define GNSS_SDR_NMEA_PRINTER_H
 
 #include <boost/date_time/posix_time/ptime.hpp>  // for ptime
+#include <array>                                 // for array
+#include <cstddef>                               // for size_t
 #include <fstream>                               // for ofstream
 #include <memory>                                // for shared_ptr
 #include <string>                                // for string
@@ -62,10 +64,7 @@ public:
 private:
     int init_serial(const std::string& serial_device);  // serial port control
     void close_serial() const;
-    std::string get_GPGGA() const;  // fix data
-    std::string get_GPGSV() const;  // satellite data
-    std::string get_GPGSA() const;  // overall satellite reception data
-    std::string get_GPRMC() const;  // minimum recommended data
+    size_t print_sentences();  // GPRMC, GPGGA, GPGSA and GPGSV into d_sentences
     std::string get_UTC_NMEA_time(const boost::posix_time::ptime d_position_UTC_time) const;
     std::string longitude_to_hm(double longitude) const;
     std::string latitude_to_hm(double lat) const;
@@ -73,6 +72,9 @@ private:
 
     const Rtklib_Solver* d_PVT_data;
 
+    // each RTKLIB sentence writer is given up to 1024 bytes
+    std::array<unsigned char, 4 * 1024> d_sentences{};
+
     std::ofstream nmea_file_descriptor;  // Output file stream for NMEA log file
 
     std::string nmea_filename;  // String with the NMEA log filename
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -31,12 +32,14 @@ class Pvt_Conf
 {
 public:
     std::map<int, int> rtcm_msg_rate_ms;
+    std::vector<int> extra_positioning_modes;  // PMODE_XXX of additional solvers
 
     std::string rinex_name = std::string("-");
     std::string dump_filename;
     std::string nmea_dump_filename;
     std::string nmea_dump_devname;
     std::string rtcm_dump_devname;
+    std::string rtcm_ntrip_mountpoint = std::string("GNSSSDR");
     std::string an_dump_devname;
     std::string output_path = std::string(".");
     std::string rinex_output_path = std::string(".");
@@ -48,6 +51,8 @@ public:
     std::string rtcm_output_file_path = std::string(".");
     std::string udp_addresses;
     std::string udp_eph_addresses;
+    std::string monitor_shm_name;  // empty: the PVT monitor sends over UDP
+    std::string warm_start_file;
 
     uint32_t type_of_receiver = 0;
     uint32_t observable_interval_ms = 20;
@@ -61,6 +66,8 @@ public:
     int32_t rinex_version = 0;
     int32_t rinexobs_rate_ms = 0;
     int32_t an_rate_ms = 1000;
+    int32_t warm_start_rate_ms = 30000;
+    int32_t output_queue_size = 0;
     int32_t max_obs_block_rx_clock_offset_ms = 40;
     int udp_port = 0;
     int udp_eph_port = 0;
@@ -68,6 +75,7 @@ public:
 
     uint16_t rtcm_tcp_port = 0;
     uint16_t rtcm_station_id = 0;
+    uint16_t rtcm_ntrip_port = 0;
 
     bool flag_nmea_tty_port = false;
     bool flag_rtcm_server = false;
@@ -83,9 +91,13 @@ public:
     bool rtcm_output_file_enabled = true;
     bool monitor_enabled = false;
     bool monitor_ephemeris_enabled = false;
+    bool monitor_ephemeris_only_new = true;
+    bool monitor_ephemeris_compact = false;
     bool protobuf_enabled = true;
     bool enable_rx_clock_correction = true;
     bool show_local_time_zone = false;
+    bool enable_vtl_aiding = false;
+    bool decimate_epochs = false;
     bool pre_2009_file = false;
     bool dump = false;
     bool dump_mat = true;
@@ -0,0 +1,167 @@
+/*!
+ * \file pvt_observables.h
+ * \brief Flat container of the valid observables of an epoch, indexed by
+ * channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OBSERVABLES_H
+#define GNSS_SDR_PVT_OBSERVABLES_H
+
+#include "gnss_synchro.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Valid observables of an epoch, as pairs of channel and observable
+ * kept in channel order in a contiguous array, plus the position of each
+ * channel in it.
+ *
+ * It is iterated and searched like the std::map<int, Gnss_Synchro> that the
+ * printers take, but its storage is allocated once for all the channels:
+ * clear() and copies between epochs keep the capacity, so building the
+ * observables of an epoch and solving them does not allocate, and reading
+ * them does not chase tree nodes.
+ */
+class Pvt_Observables
+{
+public:
+    using value_type = std::pair<int, Gnss_Synchro>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    Pvt_Observables() = default;
+
+    explicit Pvt_Observables(uint32_t nchannels)
+    {
+        reserve(nchannels);
+    }
+
+    explicit Pvt_Observables(const std::map<int, Gnss_Synchro>& observables)
+    {
+        assign(observables);
+    }
+
+    void reserve(uint32_t nchannels)
+    {
+        d_observables.reserve(nchannels);
+        if (d_index.size() < nchannels)
+            {
+                d_index.resize(nchannels, -1);
+            }
+    }
+
+    void clear()
+    {
+        for (const auto& obs : d_observables)
+            {
+                d_index[obs.first] = -1;
+            }
+        d_observables.clear();
+    }
+
+    /*!
+     * \brief Adds the observable of a channel, unless the channel already
+     * has one, as std::map::insert. Appending in channel order, as the PVT
+     * block reads its inputs, takes constant time.
+     */
+    void insert(int channel, const Gnss_Synchro& obs)
+    {
+        if (channel < 0)
+            {
+                return;
+            }
+        if (static_cast<size_t>(channel) >= d_index.size())
+            {
+                d_index.resize(channel + 1, -1);
+            }
+        if (d_index[channel] >= 0)
+            {
+                return;
+            }
+        if (d_observables.empty() || d_observables.back().first < channel)
+            {
+                d_index[channel] = static_cast<int32_t>(d_observables.size());
+                d_observables.emplace_back(channel, obs);
+                return;
+            }
+        const auto it = std::lower_bound(d_observables.begin(), d_observables.end(), channel,
+            [](const value_type& a, int ch) { return a.first < ch; });
+        d_observables.emplace(it, channel, obs);
+        reindex();
+    }
+
+    void assign(const std::map<int, Gnss_Synchro>& observables)
+    {
+        clear();
+        for (const auto& obs : observables)
+            {
+                insert(obs.first, obs.second);
+            }
+    }
+
+    std::map<int, Gnss_Synchro> to_map() const
+    {
+        return std::map<int, Gnss_Synchro>(d_observables.cbegin(), d_observables.cend());
+    }
+
+    iterator find(int channel)
+    {
+        return contains(channel) ? d_observables.begin() + d_index[channel] : d_observables.end();
+    }
+
+    const_iterator find(int channel) const
+    {
+        return contains(channel) ? d_observables.cbegin() + d_index[channel] : d_observables.cend();
+    }
+
+    inline bool empty() const { return d_observables.empty(); }
+    inline size_t size() const { return d_observables.size(); }
+    inline iterator begin() { return d_observables.begin(); }
+    inline iterator end() { return d_observables.end(); }
+    inline const_iterator begin() const { return d_observables.cbegin(); }
+    inline const_iterator end() const { return d_observables.cend(); }
+    inline const_iterator cbegin() const { return d_observables.cbegin(); }
+    inline const_iterator cend() const { return d_observables.cend(); }
+
+private:
+    inline bool contains(int channel) const
+    {
+        return channel >= 0 && static_cast<size_t>(channel) < d_index.size() && d_index[channel] >= 0;
+    }
+
+    void reindex()
+    {
+        for (size_t k = 0; k < d_observables.size(); k++)
+            {
+                d_index[d_observables[k].first] = static_cast<int32_t>(k);
+            }
+    }
+
+    std::vector<value_type> d_observables;
+    std::vector<int32_t> d_index;  // position of each channel in d_observables, or -1
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OBSERVABLES_H
@@ -0,0 +1,99 @@
+/*!
+ * \file pvt_output_worker.cc
+ * \brief Thread that runs the jobs of a PVT printer out of the PVT block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_output_worker.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::find_if
+#include <exception>
+
+
+Pvt_Output_Worker::Pvt_Output_Worker(std::string name, size_t capacity)
+    : d_name(std::move(name)),
+      d_capacity(std::max<size_t>(capacity, 1))
+{
+    d_thread = std::thread(&Pvt_Output_Worker::run, this);
+}
+
+
+Pvt_Output_Worker::~Pvt_Output_Worker()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    d_thread.join();
+    if (d_dropped > 0)
+        {
+            LOG(WARNING) << d_name << " output: " << d_dropped << " epochs dropped because the output was too slow";
+        }
+}
+
+
+void Pvt_Output_Worker::submit(std::function<void()> job, bool droppable)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_jobs.size() >= d_capacity)
+            {
+                const auto oldest = std::find_if(d_jobs.begin(), d_jobs.end(),
+                    [](const std::pair<std::function<void()>, bool> &pending) { return pending.second; });
+                if (oldest != d_jobs.end())
+                    {
+                        d_jobs.erase(oldest);
+                        if (d_dropped++ == 0)
+                            {
+                                LOG(WARNING) << d_name << " output is too slow, dropping epochs";
+                            }
+                    }
+            }
+        d_jobs.emplace_back(std::move(job), droppable);
+    }
+    d_cond.notify_one();
+}
+
+
+uint64_t Pvt_Output_Worker::dropped() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped;
+}
+
+
+void Pvt_Output_Worker::run()
+{
+    while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop || !d_jobs.empty(); });
+                if (d_jobs.empty())
+                    {
+                        return;  // stopped, and nothing left to do
+                    }
+                job = std::move(d_jobs.front().first);
+                d_jobs.pop_front();
+            }
+            try
+                {
+                    job();
+                }
+            catch (const std::exception &e)
+                {
+                    LOG(WARNING) << d_name << " output: " << e.what();
+                }
+        }
+}
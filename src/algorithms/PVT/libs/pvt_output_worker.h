@@ -0,0 +1,75 @@
+/*!
+ * \file pvt_output_worker.h
+ * \brief Thread that runs the jobs of a PVT printer out of the PVT block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OUTPUT_WORKER_H
+#define GNSS_SDR_PVT_OUTPUT_WORKER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Runs the jobs of one printer (disk, serial port or network writes) in
+ * submission order on its own thread, so that a slow output never stalls the
+ * PVT block, and through it the observables and the tracking loops.
+ *
+ * At most capacity jobs are pending. When the queue is full, the oldest
+ * pending job that can be dropped is discarded, so the output lags the
+ * receiver by a bounded number of epochs. Jobs submitted with droppable set
+ * to false (e.g. new navigation data records) are never discarded.
+ * The destructor runs the pending jobs before joining the thread.
+ */
+class Pvt_Output_Worker
+{
+public:
+    Pvt_Output_Worker(std::string name, size_t capacity);
+    ~Pvt_Output_Worker();
+
+    Pvt_Output_Worker(const Pvt_Output_Worker &) = delete;
+    Pvt_Output_Worker &operator=(const Pvt_Output_Worker &) = delete;
+
+    void submit(std::function<void()> job, bool droppable = true);
+
+    uint64_t dropped() const;  //!< Number of jobs discarded so far
+
+private:
+    void run();
+
+    std::deque<std::pair<std::function<void()>, bool>> d_jobs;
+    std::string d_name;
+    std::thread d_thread;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    size_t d_capacity;
+    uint64_t d_dropped{0};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OUTPUT_WORKER_H
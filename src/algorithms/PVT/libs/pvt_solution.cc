@@ -72,6 +72,7 @@ int Pvt_Solution::cart2geo(double X, double Y, double Z, int elipsoid_selection)
 void Pvt_Solution::set_averaging_depth(int depth)
 {
     d_averaging_depth = depth;
+    reset_pos_averaging();
 }
 
 
@@ -81,50 +82,34 @@ void Pvt_Solution::set_averaging_flag(bool flag)
 }
 
 
+void Pvt_Solution::reset_pos_averaging()
+{
+    d_hist_llh.clear();
+    d_avg_llh = {d_latitude_d, d_longitude_d, d_height_m};
+    d_avg_comoment = {};
+    d_avg_count = 0;
+}
+
+
 void Pvt_Solution::perform_pos_averaging()
 {
-    // MOVING AVERAGE PVT
-    bool avg = d_flag_averaging;
-    if (avg == true)
+    // MOVING AVERAGE PVT, updated in O(1) per epoch (Welford's algorithm)
+    if (d_flag_averaging == true)
         {
-            if (d_hist_longitude_d.size() == static_cast<unsigned int>(d_averaging_depth))
+            const std::array<double, 3> llh = {d_latitude_d, d_longitude_d, d_height_m};
+            const bool unbounded = d_averaging_depth <= 0;
+            if (!unbounded)
                 {
-                    // Pop oldest value
-                    d_hist_longitude_d.pop_back();
-                    d_hist_latitude_d.pop_back();
-                    d_hist_height_m.pop_back();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
-                    d_avg_latitude_d = 0.0;
-                    d_avg_longitude_d = 0.0;
-                    d_avg_height_m = 0.0;
-                    for (size_t i = 0; i < d_hist_longitude_d.size(); i++)
+                    if (d_hist_llh.size() == static_cast<size_t>(d_averaging_depth))
                         {
-                            d_avg_latitude_d = d_avg_latitude_d + d_hist_latitude_d.at(i);
-                            d_avg_longitude_d = d_avg_longitude_d + d_hist_longitude_d.at(i);
-                            d_avg_height_m = d_avg_height_m + d_hist_height_m.at(i);
+                            // Pop oldest value
+                            remove_from_average(d_hist_llh.back());
+                            d_hist_llh.pop_back();
                         }
-                    d_avg_latitude_d = d_avg_latitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_longitude_d = d_avg_longitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_height_m = d_avg_height_m / static_cast<double>(d_averaging_depth);
-                    d_valid_position = true;
-                }
-            else
-                {
-                    // int current_depth=d_hist_longitude_d.size();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
-                    d_avg_latitude_d = d_latitude_d;
-                    d_avg_longitude_d = d_longitude_d;
-                    d_avg_height_m = d_height_m;
-                    d_valid_position = false;
+                    d_hist_llh.push_front(llh);
                 }
+            add_to_average(llh);
+            d_valid_position = unbounded || d_avg_count == static_cast<size_t>(d_averaging_depth);
         }
     else
         {
@@ -133,6 +118,52 @@ void Pvt_Solution::perform_pos_averaging()
 }
 
 
+void Pvt_Solution::add_to_average(const std::array<double, 3> &llh)
+{
+    d_avg_count++;
+    const double n = static_cast<double>(d_avg_count);
+    std::array<double, 3> delta{};
+    for (size_t i = 0; i < 3; i++)
+        {
+            delta[i] = llh[i] - d_avg_llh[i];
+            d_avg_llh[i] += delta[i] / n;
+        }
+    for (size_t i = 0; i < 3; i++)
+        {
+            for (size_t j = 0; j < 3; j++)
+                {
+                    d_avg_comoment[i][j] += delta[i] * (llh[j] - d_avg_llh[j]);
+                }
+        }
+}
+
+
+void Pvt_Solution::remove_from_average(const std::array<double, 3> &llh)
+{
+    if (d_avg_count <= 1)
+        {
+            d_avg_count = 0;
+            d_avg_comoment = {};
+            return;
+        }
+    d_avg_count--;
+    const double n = static_cast<double>(d_avg_count);
+    std::array<double, 3> delta{};
+    for (size_t i = 0; i < 3; i++)
+        {
+            delta[i] = llh[i] - d_avg_llh[i];
+            d_avg_llh[i] -= delta[i] / n;
+        }
+    for (size_t i = 0; i < 3; i++)
+        {
+            for (size_t j = 0; j < 3; j++)
+                {
+                    d_avg_comoment[i][j] -= delta[i] * (llh[j] - d_avg_llh[j]);
+                }
+        }
+}
+
+
 double Pvt_Solution::get_time_offset_s() const
 {
     return d_rx_dt_s;
@@ -201,19 +232,42 @@ double Pvt_Solution::get_course_over_ground() const
 
 double Pvt_Solution::get_avg_latitude() const
 {
-    return d_avg_latitude_d;
+    return d_avg_llh[0];
 }
 
 
 double Pvt_Solution::get_avg_longitude() const
 {
-    return d_avg_longitude_d;
+    return d_avg_llh[1];
 }
 
 
 double Pvt_Solution::get_avg_height() const
 {
-    return d_avg_height_m;
+    return d_avg_llh[2];
+}
+
+
+std::array<std::array<double, 3>, 3> Pvt_Solution::get_avg_covariance() const
+{
+    std::array<std::array<double, 3>, 3> covariance{};
+    if (d_avg_count > 1)
+        {
+            for (size_t i = 0; i < 3; i++)
+                {
+                    for (size_t j = 0; j < 3; j++)
+                        {
+                            covariance[i][j] = d_avg_comoment[i][j] / static_cast<double>(d_avg_count - 1);
+                        }
+                }
+        }
+    return covariance;
+}
+
+
+size_t Pvt_Solution::get_num_averaged_positions() const
+{
+    return d_avg_count;
 }
 
 
@@ -20,6 +20,7 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <array>
+#include <cstddef>
 #include <deque>
 
 /** \addtogroup PVT
@@ -49,9 +50,9 @@ public:
     void set_num_valid_observations(int num);    //!< Set the number of valid pseudorange observations (valid satellites)
     void set_pre_2009_file(bool pre_2009_file);  //!< Flag for the week rollover computation in post processing mode for signals older than 2009
     // averaging
-    void set_averaging_depth(int depth);  //!< Set length of averaging window
+    void set_averaging_depth(int depth);  //!< Set length of averaging window, or 0 to average all the positions (surveying). Restarts the averaging
     void set_averaging_flag(bool flag);
-    void perform_pos_averaging();
+    void perform_pos_averaging();  //!< Adds the current position to the average, in constant time
 
     std::array<double, 3> get_rx_pos() const;
     std::array<double, 3> get_rx_vel() const;
@@ -66,6 +67,8 @@ public:
     double get_avg_latitude() const;         //!< Get RX position averaged Latitude WGS84 [deg]
     double get_avg_longitude() const;        //!< Get RX position averaged Longitude WGS84 [deg]
     double get_avg_height() const;           //!< Get RX position averaged height WGS84 [m]
+    std::array<std::array<double, 3>, 3> get_avg_covariance() const;  //!< Get the sample covariance of the averaged latitude [deg], longitude [deg] and height [m]
+    size_t get_num_averaged_positions() const;                         //!< Get the number of positions in the average
     int get_num_valid_observations() const;  //!< Get the number of valid pseudorange observations (valid satellites)
     bool is_pre_2009() const;
     bool is_valid_position() const;
@@ -94,13 +97,15 @@ private:
      */
     int cart2geo(double X, double Y, double Z, int elipsoid_selection);
 
+    void reset_pos_averaging();
+    void add_to_average(const std::array<double, 3> &llh);
+    void remove_from_average(const std::array<double, 3> &llh);
+
     std::array<double, 3> d_rx_pos{};
     std::array<double, 3> d_rx_vel{};
     boost::posix_time::ptime d_position_UTC_time;
 
-    std::deque<double> d_hist_latitude_d;
-    std::deque<double> d_hist_longitude_d;
-    std::deque<double> d_hist_height_m;
+    std::deque<std::array<double, 3>> d_hist_llh;  // Averaging window of latitude [deg], longitude [deg] and height [m]
 
     double d_latitude_d{0.0};             // RX position Latitude WGS84 [deg]
     double d_longitude_d{0.0};            // RX position Longitude WGS84 [deg]
@@ -110,9 +115,9 @@ private:
     double d_speed_over_ground_m_s{0.0};  // RX speed over ground [m/s]
     double d_course_over_ground_d{0.0};   // RX course over ground [deg]
 
-    double d_avg_latitude_d{0.0};   // Averaged latitude in degrees
-    double d_avg_longitude_d{0.0};  // Averaged longitude in degrees
-    double d_avg_height_m{0.0};     // Averaged height [m]
+    std::array<double, 3> d_avg_llh{};                    // Averaged latitude [deg], longitude [deg] and height [m]
+    std::array<std::array<double, 3>, 3> d_avg_comoment{};  // Sums of the products of the deviations from d_avg_llh
+    size_t d_avg_count{0};                                  // Number of positions in the average
 
     int d_averaging_depth{0};     // Length of averaging window
     int d_valid_observations{0};  // Number of valid observations in this epoch
@@ -0,0 +1,135 @@
+/*!
+ * \file pvt_solver_engines.cc
+ * \brief Additional RTKLIB solvers of the PVT block, each on its own thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_solver_engines.h"
+#include "pvt_output_worker.h"
+#include "rtklib_rtkpos.h"  // for rtkinit, rtkfree
+#include "rtklib_solver.h"
+#include <glog/logging.h>
+
+
+Pvt_Solver_Engines::Engine::Engine(const prcopt_t& opt, const std::string& dump_filename, bool flag_dump_to_mat, bool pre_2009_file, size_t queue_size)
+    : name(Pvt_Solver_Engines::mode_name(opt.mode))
+{
+    // the filter states are sized for the positioning mode
+    rtkinit(&rtk, &opt);
+    solver = std::make_shared<Rtklib_Solver>(rtk, dump_filename, !dump_filename.empty(), flag_dump_to_mat && !dump_filename.empty());
+    solver->set_averaging_depth(1);
+    solver->set_pre_2009_file(pre_2009_file);
+    worker = std::make_unique<Pvt_Output_Worker>(name + " PVT engine", queue_size);
+}
+
+
+Pvt_Solver_Engines::Engine::~Engine()
+{
+    worker.reset();  // solves the pending epochs
+    solver.reset();
+    rtkfree(&rtk);
+}
+
+
+void Pvt_Solver_Engines::Engine::solve(const Rtklib_Epoch& epoch)
+{
+    const bool fix = solver->solve_epoch(epoch);
+    std::lock_guard<std::mutex> lock(mutex);
+    valid = fix;
+    if (fix)
+        {
+            last_fix = solver->get_monitor_pvt();
+        }
+}
+
+
+Pvt_Solver_Engines::Pvt_Solver_Engines(const prcopt_t& opt, const std::vector<int>& positioning_modes,
+    const std::string& dump_filename, bool flag_dump_to_mat, bool pre_2009_file, size_t queue_size)
+{
+    for (const int mode : positioning_modes)
+        {
+            prcopt_t engine_opt = opt;
+            engine_opt.mode = mode;
+            std::string engine_dump_filename;
+            if (!dump_filename.empty())
+                {
+                    // pvt.dat -> pvt_PPP_Kinematic.dat
+                    const auto dot = dump_filename.find_last_of('.');
+                    const auto slash = dump_filename.find_last_of('/');
+                    const bool has_extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+                    engine_dump_filename = has_extension ? dump_filename.substr(0, dot) + "_" + mode_name(mode) + dump_filename.substr(dot)
+                                                         : dump_filename + "_" + mode_name(mode);
+                }
+            d_engines.push_back(std::make_unique<Engine>(engine_opt, engine_dump_filename, flag_dump_to_mat, pre_2009_file, queue_size));
+            LOG(INFO) << "PVT engine " << d_engines.back()->name << " enabled";
+        }
+}
+
+
+Pvt_Solver_Engines::~Pvt_Solver_Engines() = default;
+
+
+void Pvt_Solver_Engines::submit(const std::shared_ptr<const Rtklib_Epoch>& epoch)
+{
+    if (epoch == nullptr)
+        {
+            return;
+        }
+    for (auto& engine : d_engines)
+        {
+            Engine* e = engine.get();
+            e->worker->submit([e, epoch] { e->solve(*epoch); });
+        }
+}
+
+
+std::string Pvt_Solver_Engines::name(size_t engine) const
+{
+    return engine < d_engines.size() ? d_engines[engine]->name : std::string();
+}
+
+
+bool Pvt_Solver_Engines::get_monitor_pvt(size_t engine, Monitor_Pvt& monitor_pvt) const
+{
+    if (engine >= d_engines.size())
+        {
+            return false;
+        }
+    const Engine& e = *d_engines[engine];
+    std::lock_guard<std::mutex> lock(e.mutex);
+    if (!e.valid)
+        {
+            return false;
+        }
+    monitor_pvt = e.last_fix;
+    return true;
+}
+
+
+std::string Pvt_Solver_Engines::mode_name(int positioning_mode)
+{
+    switch (positioning_mode)
+        {
+        case PMODE_SINGLE:
+            return "Single";
+        case PMODE_STATIC:
+            return "Static";
+        case PMODE_KINEMA:
+            return "Kinematic";
+        case PMODE_PPP_STATIC:
+            return "PPP_Static";
+        case PMODE_PPP_KINEMA:
+            return "PPP_Kinematic";
+        default:
+            return "Mode_" + std::to_string(positioning_mode);
+        }
+}
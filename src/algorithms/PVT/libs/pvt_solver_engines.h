@@ -0,0 +1,103 @@
+/*!
+ * \file pvt_solver_engines.h
+ * \brief Additional RTKLIB solvers of the PVT block, each on its own thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_SOLVER_ENGINES_H
+#define GNSS_SDR_PVT_SOLVER_ENGINES_H
+
+#include "monitor_pvt.h"
+#include "rtklib.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+class Pvt_Output_Worker;
+class Rtklib_Epoch;
+class Rtklib_Solver;
+
+
+/*!
+ * \brief Solvers with other positioning modes than the one of the PVT block
+ * (e.g. Single and PPP_Kinematic aside a Kinematic receiver), so that their
+ * solutions can be compared from a single receiver.
+ *
+ * They solve the epochs prepared by the solver of the block, so the ephemeris
+ * conversion, the observations and the navigation data are computed once per
+ * epoch, whatever the number of engines. Each engine runs on its own thread,
+ * with at most queue_size epochs pending: an engine that falls behind skips
+ * the oldest ones instead of delaying the PVT block.
+ */
+class Pvt_Solver_Engines
+{
+public:
+    /*!
+     * \brief One engine per positioning mode (PMODE_XXX), with the other
+     * options of opt. If dump_filename is not empty, each engine dumps its
+     * solutions to it with the name of its mode appended.
+     */
+    Pvt_Solver_Engines(const prcopt_t& opt, const std::vector<int>& positioning_modes,
+        const std::string& dump_filename, bool flag_dump_to_mat, bool pre_2009_file, size_t queue_size);
+    ~Pvt_Solver_Engines();
+
+    Pvt_Solver_Engines(const Pvt_Solver_Engines&) = delete;
+    Pvt_Solver_Engines& operator=(const Pvt_Solver_Engines&) = delete;
+
+    void submit(const std::shared_ptr<const Rtklib_Epoch>& epoch);
+
+    inline size_t size() const
+    {
+        return d_engines.size();
+    }
+
+    std::string name(size_t engine) const;
+
+    /*!
+     * \brief Solution of the last epoch solved by an engine. Returns false if
+     * that epoch had no fix.
+     */
+    bool get_monitor_pvt(size_t engine, Monitor_Pvt& monitor_pvt) const;
+
+    static std::string mode_name(int positioning_mode);
+
+private:
+    class Engine
+    {
+    public:
+        Engine(const prcopt_t& opt, const std::string& dump_filename, bool flag_dump_to_mat, bool pre_2009_file, size_t queue_size);
+        ~Engine();
+        void solve(const Rtklib_Epoch& epoch);
+
+        rtk_t rtk{};
+        std::shared_ptr<Rtklib_Solver> solver;
+        std::unique_ptr<Pvt_Output_Worker> worker;
+        std::string name;
+        mutable std::mutex mutex;
+        Monitor_Pvt last_fix{};
+        bool valid{false};
+    };
+
+    std::vector<std::unique_ptr<Engine>> d_engines;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_SOLVER_ENGINES_H
@@ -0,0 +1,135 @@
+/*!
+ * \file pvt_text_format.cc
+ * \brief Locale-free number formatting and reusable text buffer for the
+ * PVT outputs (RINEX, KML, GPX, GeoJSON)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_text_format.h"
+#include <algorithm>  // for std::min
+#include <array>      // for std::array
+#include <cmath>      // for std::fabs, std::floor, std::isfinite, std::nearbyint, std::signbit
+#include <cstdio>     // for std::snprintf
+#include <limits>     // for std::numeric_limits
+
+
+size_t format_fixed(double x, uint32_t precision, char* buffer)
+{
+    static const long double powers_of_ten[16] = {1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L,
+        1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L};
+    if (!std::isfinite(x) || precision > 15 || std::fabs(x) >= 1e15)
+        {
+            return 0;
+        }
+
+    // The scaled value carries one rounding error. printf rounds the exact
+    // binary value to nearest, ties to even, so the result is only
+    // guaranteed if the scaled value is not within that error of a tie.
+    const long double scaled = std::fabs(static_cast<long double>(x)) * powers_of_ten[precision];
+    const long double error = scaled * std::numeric_limits<long double>::epsilon();
+    const long double fraction = scaled - std::floor(scaled);
+    if (std::fabs(fraction - 0.5L) <= error || scaled >= 9.2e18L)
+        {
+            return 0;
+        }
+    auto digits = static_cast<uint64_t>(std::nearbyint(scaled));
+
+    // digits, from the last one
+    char reversed[FORMAT_BUFFER_SIZE];
+    size_t n = 0;
+    for (uint32_t i = 0; i < precision; i++)
+        {
+            reversed[n++] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+    if (precision > 0)
+        {
+            reversed[n++] = '.';
+        }
+    do
+        {
+            reversed[n++] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+    while (digits > 0);
+
+    size_t length = 0;
+    if (std::signbit(x))
+        {
+            buffer[length++] = '-';
+        }
+    while (n > 0)
+        {
+            buffer[length++] = reversed[--n];
+        }
+    return length;
+}
+
+
+size_t format_integer(int64_t x, char* buffer)
+{
+    // the magnitude of the most negative value does not fit in an int64_t
+    uint64_t magnitude = x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+    char reversed[FORMAT_BUFFER_SIZE];
+    size_t n = 0;
+    do
+        {
+            reversed[n++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        }
+    while (magnitude > 0);
+
+    size_t length = 0;
+    if (x < 0)
+        {
+            buffer[length++] = '-';
+        }
+    while (n > 0)
+        {
+            buffer[length++] = reversed[--n];
+        }
+    return length;
+}
+
+
+Pvt_Text_Buffer::Pvt_Text_Buffer(uint32_t precision, size_t capacity) : d_precision(precision)
+{
+    d_text.reserve(capacity);
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::operator<<(double x)
+{
+    char buffer[FORMAT_BUFFER_SIZE];
+    const size_t length = format_fixed(x, d_precision, buffer);
+    if (length > 0)
+        {
+            d_text.append(buffer, length);
+            return *this;
+        }
+    // enough for the 309 integer digits of the largest double
+    std::array<char, 400> slow{};
+    const int written = std::snprintf(slow.data(), slow.size(), "%.*f", static_cast<int>(d_precision), x);
+    if (written > 0)
+        {
+            d_text.append(slow.data(), std::min<size_t>(static_cast<size_t>(written), slow.size() - 1));
+        }
+    return *this;
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::append_integer(int64_t x)
+{
+    char buffer[FORMAT_BUFFER_SIZE];
+    d_text.append(buffer, format_integer(x, buffer));
+    return *this;
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file pvt_text_format.h
+ * \brief Locale-free number formatting and reusable text buffer for the
+ * PVT outputs (RINEX, KML, GPX, GeoJSON)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_TEXT_FORMAT_H
+#define GNSS_SDR_PVT_TEXT_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Size of the buffer passed to format_fixed() and format_integer()
+ */
+constexpr size_t FORMAT_BUFFER_SIZE = 40;
+
+/*!
+ * \brief Writes x with the given number of decimals to buffer, character by
+ * character the same as printf("%.*f", precision, x), without going through
+ * a stream or a locale and without allocating.
+ *
+ * Returns the number of characters written (no terminating null), or 0 if
+ * the value cannot be written by this fast path (not finite, |x| >= 1e15,
+ * precision > 15, or a rounding tie that the scaled value cannot resolve).
+ * The caller then falls back to printf or to a stream.
+ */
+size_t format_fixed(double x, uint32_t precision, char* buffer);
+
+/*!
+ * \brief Writes the decimal digits of x to buffer. Returns the number of
+ * characters written (no terminating null).
+ */
+size_t format_integer(int64_t x, char* buffer);
+
+
+/*!
+ * \brief Text of an output record, built in a buffer that keeps its
+ * capacity from one record to the next. Floating point values are written
+ * in fixed notation with the precision given at construction, as a stream
+ * with std::fixed and std::setprecision would do.
+ */
+class Pvt_Text_Buffer
+{
+public:
+    explicit Pvt_Text_Buffer(uint32_t precision = 6, size_t capacity = 4096);
+
+    void clear() { d_text.clear(); }
+    const char* data() const { return d_text.data(); }
+    size_t size() const { return d_text.size(); }
+    const std::string& str() const { return d_text; }
+
+    Pvt_Text_Buffer& operator<<(const char* text)
+    {
+        d_text.append(text);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& operator<<(const std::string& text)
+    {
+        d_text.append(text);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& operator<<(char c)
+    {
+        d_text.push_back(c);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& operator<<(int32_t x) { return append_integer(x); }
+    Pvt_Text_Buffer& operator<<(uint32_t x) { return append_integer(x); }
+    Pvt_Text_Buffer& operator<<(int64_t x) { return append_integer(x); }
+    Pvt_Text_Buffer& operator<<(double x);
+
+private:
+    Pvt_Text_Buffer& append_integer(int64_t x);
+
+    std::string d_text;
+    uint32_t d_precision;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_TEXT_FORMAT_H
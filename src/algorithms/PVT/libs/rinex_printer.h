@@ -38,6 +38,7 @@
 #ifndef GNSS_SDR_RINEX_PRINTER_H
 #define GNSS_SDR_RINEX_PRINTER_H
 
+#include "pvt_text_format.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <cstdint>  // for int32_t
 #include <cstdlib>  // for strtol, strtod
@@ -1224,6 +1225,12 @@ inline std::string asString(long double x, std::string::size_type precision)
 
 inline std::string Rinex_Printer::asString(double x, std::string::size_type precision) const
 {
+    char buffer[FORMAT_BUFFER_SIZE];
+    const size_t length = format_fixed(x, static_cast<uint32_t>(precision), buffer);
+    if (length > 0)
+        {
+            return std::string(buffer, length);
+        }
     std::ostringstream ss;
     ss << std::fixed << std::setprecision(precision) << x;
     return ss.str();
@@ -1266,6 +1273,21 @@ inline std::string Rinex_Printer::asString(const X x) const
 }
 
 
+// the LLI and SSI fields of every observable
+template <>
+inline std::string Rinex_Printer::asString<int16_t>(const int16_t x) const
+{
+    return std::to_string(x);
+}
+
+
+template <>
+inline std::string Rinex_Printer::asString<int32_t>(const int32_t x) const
+{
+    return std::to_string(x);
+}
+
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_RINEX_PRINTER_H
@@ -35,13 +35,25 @@
 #include <sstream>    // for std::stringstream
 
 
-Rtcm::Rtcm(uint16_t port) : RTCM_port(port), server_is_running(false)
+Rtcm::Rtcm(uint16_t port, uint16_t ntrip_port, const std::string& ntrip_mountpoint) : RTCM_port(port), NTRIP_port(ntrip_port), server_is_running(false)
 {
-    preamble = std::bitset<8>("11010011");
-    reserved_field = std::bitset<6>("000000");
     rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string>>();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
     servers.emplace_back(io_context, endpoint);
+    if (NTRIP_port != 0)
+        {
+            try
+                {
+                    boost::asio::ip::tcp::endpoint ntrip_endpoint(boost::asio::ip::tcp::v4(), NTRIP_port);
+                    caster = std::make_shared<Ntrip_Caster>(io_context, ntrip_endpoint, ntrip_mountpoint);
+                    servers.front().join(caster);
+                }
+            catch (const boost::system::system_error& e)
+                {
+                    LOG(WARNING) << "Cannot start the NTRIP caster on port " << NTRIP_port << ": " << e.what();
+                    caster.reset();
+                }
+        }
 }
 
 
@@ -74,6 +86,10 @@ Rtcm::~Rtcm()
 void Rtcm::run_server()
 {
     std::cout << "Starting a TCP/IP server of RTCM messages on port " << RTCM_port << '\n';
+    if (caster)
+        {
+            std::cout << "Starting a NTRIP caster of RTCM messages on port " << NTRIP_port << '\n';
+        }
     try
         {
             tq = std::thread([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, RTCM_port)->do_read_queue(); });
@@ -98,6 +114,10 @@ void Rtcm::stop_server()
     std::cout << "Stopping TCP/IP server on port " << RTCM_port << '\n';
     Rtcm::stop_service();
     servers.front().close_server();
+    if (caster)
+        {
+            caster->close_caster();
+        }
     rtcm_message_queue->push("Goodbye");  // this terminates tq
     tq.join();
     t.join();
@@ -123,26 +143,6 @@ bool Rtcm::is_server_running() const
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
-{
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
-}
-
-
 bool Rtcm::check_CRC(const std::string& message) const
 {
     boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM_CHECK;
@@ -399,17 +399,9 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 
 std::string Rtcm::build_message(const std::string& data) const
 {
-    const uint32_t msg_length_bits = data.length();
-    const uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    const auto message_length = std::bitset<10>(msg_length_bytes);
-    const uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    const std::string b(zeros_to_fill, '0');
-    const std::string msg_content = data + b;
-    const std::string msg_without_crc = preamble.to_string() +
-                                        reserved_field.to_string() +
-                                        message_length.to_string() +
-                                        msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
+    Rtcm_Bit_Writer writer(data.length());
+    writer.put(data);
+    return writer.frame();
 }
 
 
@@ -2289,7 +2281,9 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2299,11 +2293,11 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::put_MSM_1_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
+    Rtcm::put_MSM_1_content_signal_data(msg_writer, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
 
     if (server_is_running)
         {
@@ -2314,7 +2308,8 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::put_MSM_header(Rtcm_Bit_Writer& writer,
+    uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2341,40 +2336,37 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    writer.put(DF002);
+    writer.put(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            writer.put(DF034);
         }
     else
         {
             // GPS, Galileo Epoch Time
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            writer.put(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    writer.put(DF393);
+    writer.put(DF409);
+    writer.put(DF001_);
+    writer.put(DF411);
+    writer.put(DF417);
+    writer.put(DF412);
+    writer.put(DF418);
+    writer.put(DF394);
+    writer.put(DF395);
+    writer.put(Rtcm::set_DF396(observables));
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_1_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2404,16 +2396,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            writer.put(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_1_content_signal_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2434,10 +2423,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            writer.put(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2487,7 +2474,9 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2497,11 +2486,11 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::put_MSM_1_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_2_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2511,18 +2500,14 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_2_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2540,18 +2525,19 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF401.size());
+    const size_t second_data_type = writer.skip(Ncells * DF402.size());
+    const size_t third_data_type = writer.skip(Ncells * DF420.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            writer.put_at(first_data_type + cell * DF401.size(), DF401);
+            writer.put_at(second_data_type + cell * DF402.size(), DF402);
+            writer.put_at(third_data_type + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
 }
 
 
@@ -2601,7 +2587,9 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2611,11 +2599,11 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::put_MSM_1_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_3_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2625,19 +2613,14 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_3_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2655,20 +2638,22 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF400.size());
+    const size_t second_data_type = writer.skip(Ncells * DF401.size());
+    const size_t third_data_type = writer.skip(Ncells * DF402.size());
+    const size_t fourth_data_type = writer.skip(Ncells * DF420.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            writer.put_at(first_data_type + cell * DF400.size(), DF400);
+            writer.put_at(second_data_type + cell * DF401.size(), DF401);
+            writer.put_at(third_data_type + cell * DF402.size(), DF402);
+            writer.put_at(fourth_data_type + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
 }
 
 
@@ -2718,7 +2703,9 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
             msg_number = 1074;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2728,11 +2715,11 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::put_MSM_4_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_4_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2742,12 +2729,8 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_4_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2773,32 +2756,27 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    const size_t first_data_type = writer.skip(num_satellites * DF397.size());
+    const size_t second_data_type = writer.skip(num_satellites * DF398.size());
+
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            writer.put_at(first_data_type + nsat * DF397.size(), DF397);
+            writer.put_at(second_data_type + nsat * DF398.size(), DF398);
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_4_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2816,6 +2794,12 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF400.size());
+    const size_t second_data_type = writer.skip(Ncells * DF401.size());
+    const size_t third_data_type = writer.skip(Ncells * DF402.size());
+    const size_t fourth_data_type = writer.skip(Ncells * DF420.size());
+    const size_t fifth_data_type = writer.skip(Ncells * DF403.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2823,15 +2807,12 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            writer.put_at(first_data_type + cell * DF400.size(), DF400);
+            writer.put_at(second_data_type + cell * DF401.size(), DF401);
+            writer.put_at(third_data_type + cell * DF402.size(), DF402);
+            writer.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            writer.put_at(fifth_data_type + cell * DF403.size(), DF403);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -2881,7 +2862,9 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2891,11 +2874,11 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::put_MSM_5_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_5_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2905,14 +2888,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_5_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2938,37 +2915,31 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    const size_t first_data_type = writer.skip(num_satellites * DF397.size());
+    writer.skip(num_satellites * 4);  // reserved
+    const size_t third_data_type = writer.skip(num_satellites * DF398.size());
+    const size_t fourth_data_type = writer.skip(num_satellites * DF399.size());
+
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
-            auto reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            writer.put_at(first_data_type + nsat * DF397.size(), DF397);
+            writer.put_at(third_data_type + nsat * DF398.size(), DF398);
+            writer.put_at(fourth_data_type + nsat * DF399.size(), DF399);
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_5_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2986,6 +2957,13 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF400.size());
+    const size_t second_data_type = writer.skip(Ncells * DF401.size());
+    const size_t third_data_type = writer.skip(Ncells * DF402.size());
+    const size_t fourth_data_type = writer.skip(Ncells * DF420.size());
+    const size_t fifth_data_type = writer.skip(Ncells * DF403.size());
+    const size_t sixth_data_type = writer.skip(Ncells * DF404.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2994,16 +2972,13 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            writer.put_at(first_data_type + cell * DF400.size(), DF400);
+            writer.put_at(second_data_type + cell * DF401.size(), DF401);
+            writer.put_at(third_data_type + cell * DF402.size(), DF402);
+            writer.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            writer.put_at(fifth_data_type + cell * DF403.size(), DF403);
+            writer.put_at(sixth_data_type + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 
@@ -3053,7 +3028,9 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3063,11 +3040,11 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::put_MSM_4_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_6_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3077,20 +3054,14 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_6_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -3108,6 +3079,12 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF405.size());
+    const size_t second_data_type = writer.skip(Ncells * DF406.size());
+    const size_t third_data_type = writer.skip(Ncells * DF407.size());
+    const size_t fourth_data_type = writer.skip(Ncells * DF420.size());
+    const size_t fifth_data_type = writer.skip(Ncells * DF408.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3115,15 +3092,12 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            writer.put_at(first_data_type + cell * DF405.size(), DF405);
+            writer.put_at(second_data_type + cell * DF406.size(), DF406);
+            writer.put_at(third_data_type + cell * DF407.size(), DF407);
+            writer.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            writer.put_at(fifth_data_type + cell * DF408.size(), DF408);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -3173,7 +3147,9 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    msg_writer.clear();
+    Rtcm::put_MSM_header(msg_writer,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3183,11 +3159,11 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::put_MSM_5_content_sat_data(msg_writer, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_7_content_signal_data(msg_writer, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = msg_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3197,21 +3173,14 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_7_content_signal_data(Rtcm_Bit_Writer& writer,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -3229,6 +3198,13 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    const size_t first_data_type = writer.skip(Ncells * DF405.size());
+    const size_t second_data_type = writer.skip(Ncells * DF406.size());
+    const size_t third_data_type = writer.skip(Ncells * DF407.size());
+    const size_t fourth_data_type = writer.skip(Ncells * DF420.size());
+    const size_t fifth_data_type = writer.skip(Ncells * DF408.size());
+    const size_t sixth_data_type = writer.skip(Ncells * DF404.size());
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3237,16 +3213,13 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
+            writer.put_at(first_data_type + cell * DF405.size(), DF405);
+            writer.put_at(second_data_type + cell * DF406.size(), DF406);
+            writer.put_at(third_data_type + cell * DF407.size(), DF407);
+            writer.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            writer.put_at(fifth_data_type + cell * DF408.size(), DF408);
+            writer.put_at(sixth_data_type + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 
@@ -26,16 +26,20 @@
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_ephemeris.h"
+#include "rtcm_bit_writer.h"
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
 #include <algorithm>  // for min
 #include <array>
 #include <bitset>
+#include <cctype>   // for tolower
 #include <cstddef>  // for size_t
+#include <cstdio>   // for snprintf
 #include <cstdint>
 #include <cstring>  // for memcpy
 #include <deque>
+#include <istream>
 #include <list>
 #include <map>
 #include <memory>
@@ -90,7 +94,7 @@ using b_io_context = boost::asio::io_service;
 class Rtcm
 {
 public:
-    explicit Rtcm(uint16_t port = 2101);  //!< Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
+    explicit Rtcm(uint16_t port = 2101, uint16_t ntrip_port = 0, const std::string& ntrip_mountpoint = std::string("GNSSSDR"));  //!< If ntrip_port is not 0, the messages are also served by a NTRIP caster on that port. Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
     ~Rtcm();
 
     /*!
@@ -454,7 +458,8 @@ private:
      */
     std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void put_MSM_header(Rtcm_Bit_Writer& writer,
+        uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -464,17 +469,17 @@ private:
         bool divergence_free,
         bool more_messages);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_1_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_4_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_5_content_sat_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
 
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_1_content_signal_data(Rtcm_Bit_Writer& writer, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_2_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_3_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_4_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_5_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_6_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_7_content_signal_data(Rtcm_Bit_Writer& writer, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
 
     //
     // Utilities
@@ -590,11 +595,64 @@ private:
     };
 
 
+    // A message as written to the clients. It is encoded once and shared by
+    // the write queues of all the sessions.
+    using Shared_Msg = std::shared_ptr<const std::string>;
+
     class RtcmListener
     {
     public:
         virtual ~RtcmListener() = default;
-        virtual void deliver(const Rtcm_Message& msg) = 0;
+        virtual void deliver(const Shared_Msg& msg) = 0;
+    };
+
+
+    // Write queue of a client. If the client does not keep up, the oldest
+    // messages not being written are dropped, so a slow client costs neither
+    // memory nor delay to the others.
+    class Rtcm_Write_Queue
+    {
+    public:
+        // Returns true if a write has to be started
+        inline bool push(const Shared_Msg& msg)
+        {
+            const bool write_in_progress = !msgs_.empty();
+            if (msgs_.size() >= max_queued_msgs)
+                {
+                    msgs_.erase(msgs_.begin() + 1);  // the front one is being written
+                    if (dropped_msgs_++ % 100 == 0)
+                        {
+                            LOG(WARNING) << "RTCM client too slow, " << dropped_msgs_ << " messages dropped";
+                        }
+                }
+            msgs_.push_back(msg);
+            return !write_in_progress;
+        }
+
+        inline const std::string& front() const
+        {
+            return *msgs_.front();
+        }
+
+        // Returns true if there are more messages to write
+        inline bool pop()
+        {
+            msgs_.pop_front();
+            return !msgs_.empty();
+        }
+
+        inline bool empty() const
+        {
+            return msgs_.empty();
+        }
+
+    private:
+        enum
+        {
+            max_queued_msgs = 64
+        };
+        std::deque<Shared_Msg> msgs_;
+        uint64_t dropped_msgs_ = 0;
     };
 
 
@@ -616,6 +674,11 @@ private:
         }
 
         inline void deliver(const Rtcm_Message& msg)
+        {
+            deliver(std::make_shared<const std::string>(msg.body(), msg.body_length()));
+        }
+
+        inline void deliver(const Shared_Msg& msg)
         {
             recent_msgs_.push_back(msg);
             while (recent_msgs_.size() > max_recent_msgs)
@@ -635,7 +698,7 @@ private:
         {
             max_recent_msgs = 1
         };
-        std::deque<Rtcm_Message> recent_msgs_;
+        std::deque<Shared_Msg> recent_msgs_;
     };
 
 
@@ -651,11 +714,9 @@ private:
             do_read_message_header();
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const Shared_Msg& msg)
         {
-            bool write_in_progress = !write_msgs_.empty();
-            write_msgs_.push_back(msg);
-            if (!write_in_progress)
+            if (write_msgs_.push(msg))
                 {
                     do_write();
                 }
@@ -722,12 +783,11 @@ private:
         {
             auto self(shared_from_this());
             boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().body(), write_msgs_.front().body_length()),
+                boost::asio::buffer(write_msgs_.front()),
                 [this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
-                            write_msgs_.pop_front();
-                            if (!write_msgs_.empty())
+                            if (write_msgs_.pop())
                                 {
                                     do_write();
                                 }
@@ -743,7 +803,7 @@ private:
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room& room_;
         Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
+        Rtcm_Write_Queue write_msgs_;
         std::string client_says;
     };
 
@@ -894,6 +954,12 @@ private:
             acceptor_.close();
         }
 
+        // Adds a listener that receives all the messages sent to the server
+        inline void join(const std::shared_ptr<RtcmListener>& listener)
+        {
+            room_.join(listener);
+        }
+
     private:
         inline void do_accept()
         {
@@ -945,20 +1011,246 @@ private:
         bool start_session = true;
     };
 
+
+    // A client of the NTRIP caster. It reads the HTTP request, and then
+    // either streams the mountpoint or sends the sourcetable and closes.
+    class Ntrip_Session
+        : public RtcmListener,
+          public std::enable_shared_from_this<Ntrip_Session>
+    {
+    public:
+        Ntrip_Session(boost::asio::ip::tcp::socket socket,
+            const std::string& mountpoint,
+            const std::string& sourcetable,
+            Rtcm_Listener_Room& v1_room,
+            Rtcm_Listener_Room& v2_room)
+            : socket_(std::move(socket)),
+              mountpoint_(mountpoint),
+              sourcetable_(sourcetable),
+              v1_room_(v1_room),
+              v2_room_(v2_room)
+        {
+        }
+
+        inline void start()
+        {
+            auto self(shared_from_this());
+            boost::asio::async_read_until(socket_, request_, "\r\n\r\n",
+                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                    if (!ec)
+                        {
+                            handle_request();
+                        }
+                });
+        }
+
+        inline void deliver(const Shared_Msg& msg)
+        {
+            if (write_msgs_.push(msg))
+                {
+                    do_write();
+                }
+        }
+
+    private:
+        inline void handle_request()
+        {
+            std::istream request_stream(&request_);
+            std::string method;
+            std::string target;
+            std::string line;
+            request_stream >> method >> target;
+            std::getline(request_stream, line);
+            bool ntrip_v2 = false;
+            while (std::getline(request_stream, line) && line != "\r")
+                {
+                    std::transform(line.begin(), line.end(), line.begin(), [](unsigned char c) { return std::tolower(c); });
+                    if (line.compare(0, 24, "ntrip-version: ntrip/2.0") == 0)
+                        {
+                            ntrip_v2 = true;
+                        }
+                }
+
+            if (method != "GET")
+                {
+                    close_after_write_ = true;
+                    deliver(std::make_shared<const std::string>("HTTP/1.1 405 Method Not Allowed\r\nConnection: close\r\n\r\n"));
+                    return;
+                }
+            if (target != "/" + mountpoint_)
+                {
+                    close_after_write_ = true;
+                    std::string response;
+                    if (ntrip_v2)
+                        {
+                            response = "HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nServer: GNSS-SDR\r\nContent-Type: gnss/sourcetable\r\nConnection: close\r\n";
+                        }
+                    else
+                        {
+                            response = "SOURCETABLE 200 OK\r\nServer: GNSS-SDR\r\nContent-Type: text/plain\r\n";
+                        }
+                    response += "Content-Length: " + std::to_string(sourcetable_.length()) + "\r\n\r\n" + sourcetable_;
+                    deliver(std::make_shared<const std::string>(response));
+                    return;
+                }
+
+            if (ntrip_v2)
+                {
+                    deliver(std::make_shared<const std::string>("HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nServer: GNSS-SDR\r\nContent-Type: gnss/data\r\nTransfer-Encoding: chunked\r\nCache-Control: no-store, no-cache, max-age=0\r\nConnection: close\r\n\r\n"));
+                    room_ = &v2_room_;
+                }
+            else
+                {
+                    deliver(std::make_shared<const std::string>("ICY 200 OK\r\n\r\n"));
+                    room_ = &v1_room_;
+                }
+            boost::system::error_code ec;
+            const boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec);
+            LOG(INFO) << "NTRIP " << (ntrip_v2 ? "2.0" : "1.0") << " client " << (ec ? std::string("") : endpoint.address().to_string()) << " streaming mountpoint " << mountpoint_;
+            room_->join(shared_from_this());
+            do_read();
+        }
+
+        // The client has nothing to say once streaming, but reading tells
+        // when it goes away
+        inline void do_read()
+        {
+            auto self(shared_from_this());
+            socket_.async_read_some(boost::asio::buffer(read_buffer_),
+                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                    if (!ec)
+                        {
+                            do_read();
+                        }
+                    else
+                        {
+                            leave();
+                        }
+                });
+        }
+
+        inline void do_write()
+        {
+            auto self(shared_from_this());
+            boost::asio::async_write(socket_,
+                boost::asio::buffer(write_msgs_.front()),
+                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                    if (!ec)
+                        {
+                            if (write_msgs_.pop())
+                                {
+                                    do_write();
+                                }
+                            else if (close_after_write_)
+                                {
+                                    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+                                    socket_.close(ec);
+                                }
+                        }
+                    else
+                        {
+                            leave();
+                        }
+                });
+        }
+
+        inline void leave()
+        {
+            if (room_ != nullptr)
+                {
+                    room_->leave(shared_from_this());
+                    room_ = nullptr;
+                }
+            boost::system::error_code ec;
+            socket_.close(ec);
+        }
+
+        boost::asio::ip::tcp::socket socket_;
+        boost::asio::streambuf request_;
+        const std::string& mountpoint_;
+        const std::string& sourcetable_;
+        Rtcm_Listener_Room& v1_room_;
+        Rtcm_Listener_Room& v2_room_;
+        Rtcm_Listener_Room* room_ = nullptr;
+        Rtcm_Write_Queue write_msgs_;
+        std::array<char, 256> read_buffer_{};
+        bool close_after_write_ = false;
+    };
+
+
+    // NTRIP caster of the messages sent to the RTCM server. Each message is
+    // framed once for NTRIP 1.0 (raw) and once for NTRIP 2.0 (HTTP chunked)
+    // clients, whatever the number of clients.
+    class Ntrip_Caster : public RtcmListener
+    {
+    public:
+        Ntrip_Caster(b_io_context& io_context, const boost::asio::ip::tcp::endpoint& endpoint, const std::string& mountpoint)
+            : acceptor_(io_context), socket_(io_context), mountpoint_(mountpoint)
+        {
+            sourcetable_ = "STR;" + mountpoint_ + ";GNSS-SDR;RTCM 3.2;1005,1019,1020,1045,1077,1087,1097;2;GPS+GLO+GAL;GNSS-SDR;;0.00;0.00;0;0;GNSS-SDR;none;N;N;0;\r\nENDSOURCETABLE\r\n";
+            acceptor_.open(endpoint.protocol());
+            acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            acceptor_.bind(endpoint);
+            acceptor_.listen();
+            do_accept();
+        }
+
+        inline void close_caster()
+        {
+            boost::system::error_code ec;
+            socket_.close(ec);
+            acceptor_.close(ec);
+        }
+
+        inline void deliver(const Shared_Msg& msg)
+        {
+            v1_room_.deliver(msg);
+            char chunk_size[16];
+            std::snprintf(chunk_size, sizeof(chunk_size), "%zX\r\n", msg->size());
+            auto chunk = std::make_shared<std::string>(chunk_size);
+            chunk->reserve(chunk->size() + msg->size() + 2);
+            *chunk += *msg;
+            *chunk += "\r\n";
+            v2_room_.deliver(chunk);
+        }
+
+    private:
+        inline void do_accept()
+        {
+            acceptor_.async_accept(socket_, [this](boost::system::error_code ec) {
+                if (!ec)
+                    {
+                        std::make_shared<Ntrip_Session>(std::move(socket_), mountpoint_, sourcetable_, v1_room_, v2_room_)->start();
+                    }
+                if (acceptor_.is_open())
+                    {
+                        do_accept();
+                    }
+            });
+        }
+
+        boost::asio::ip::tcp::acceptor acceptor_;
+        boost::asio::ip::tcp::socket socket_;
+        std::string mountpoint_;
+        std::string sourcetable_;
+        Rtcm_Listener_Room v1_room_;
+        Rtcm_Listener_Room v2_room_;
+    };
+
     b_io_context io_context;
     std::shared_ptr<Concurrent_Queue<std::string>> rtcm_message_queue;
     std::thread t;
     std::thread tq;
     std::list<Rtcm::Tcp_Server> servers;
+    std::shared_ptr<Ntrip_Caster> caster;
+    uint16_t NTRIP_port;
     bool server_is_running;
     void stop_service();
 
     //
     // Transport Layer
     //
-    std::bitset<8> preamble;
-    std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
+    Rtcm_Bit_Writer msg_writer;  // MSM messages are written straight into it
     std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
 
     //
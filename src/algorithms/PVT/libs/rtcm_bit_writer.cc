@@ -0,0 +1,157 @@
+/*!
+ * \file rtcm_bit_writer.cc
+ * \brief Packs RTCM 3 data fields into a byte buffer and frames them with
+ * the transport layer (preamble, length and CRC-24Q)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bit_writer.h"
+#include <algorithm>  // for std::fill, std::min
+#include <array>
+#include <cstring>  // for memcpy
+
+
+namespace
+{
+constexpr uint8_t RTCM_PREAMBLE = 0xD3;
+constexpr uint32_t CRC24Q_POLY = 0x1864CFBU;
+
+
+std::array<uint32_t, 256> make_crc24q_table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i << 16;
+            for (int32_t j = 0; j < 8; j++)
+                {
+                    crc <<= 1;
+                    if (crc & 0x1000000U)
+                        {
+                            crc ^= CRC24Q_POLY;
+                        }
+                }
+            table[i] = crc & 0xFFFFFFU;
+        }
+    return table;
+}
+}  // namespace
+
+
+Rtcm_Bit_Writer::Rtcm_Bit_Writer(size_t reserved_bits)
+{
+    d_buffer.reserve((reserved_bits + 7) / 8);
+}
+
+
+void Rtcm_Bit_Writer::clear()
+{
+    std::fill(d_buffer.begin(), d_buffer.end(), 0);
+    d_bits = 0;
+}
+
+
+void Rtcm_Bit_Writer::write(size_t pos, uint64_t value, uint32_t bits)
+{
+    while (bits > 0)
+        {
+            const uint32_t room = 8 - static_cast<uint32_t>(pos % 8);
+            const uint32_t n = std::min(room, bits);
+            const uint32_t mask = ((1U << n) - 1U) << (room - n);
+            const auto chunk = static_cast<uint32_t>((value >> (bits - n)) << (room - n)) & mask;
+            uint8_t& byte = d_buffer[pos / 8];
+            byte = static_cast<uint8_t>((byte & ~mask) | chunk);
+            pos += n;
+            bits -= n;
+        }
+}
+
+
+void Rtcm_Bit_Writer::put(uint64_t value, uint32_t bits)
+{
+    if (bits == 0)
+        {
+            return;
+        }
+    const size_t pos = skip(bits);
+    write(pos, value, bits);
+}
+
+
+void Rtcm_Bit_Writer::put(const std::string& bits)
+{
+    size_t pos = skip(bits.length());
+    for (const char c : bits)
+        {
+            if (c == '1')
+                {
+                    d_buffer[pos / 8] |= static_cast<uint8_t>(0x80U >> (pos % 8));
+                }
+            pos++;
+        }
+}
+
+
+size_t Rtcm_Bit_Writer::skip(size_t bits)
+{
+    const size_t pos = d_bits;
+    d_bits += bits;
+    const size_t bytes = (d_bits + 7) / 8;
+    if (bytes > d_buffer.size())
+        {
+            d_buffer.resize(bytes, 0);
+        }
+    return pos;
+}
+
+
+void Rtcm_Bit_Writer::put_at(size_t pos, uint64_t value, uint32_t bits)
+{
+    if (bits == 0 || pos + bits > d_bits)
+        {
+            return;
+        }
+    write(pos, value, bits);
+}
+
+
+std::string Rtcm_Bit_Writer::frame() const
+{
+    const size_t data_bytes = (d_bits + 7) / 8;
+    const size_t length = data_bytes & 0x3FFU;  // the length field is 10 bits long
+    std::string message(3 + data_bytes + 3, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(&message[0]);
+    out[0] = RTCM_PREAMBLE;
+    out[1] = static_cast<uint8_t>(length >> 8);
+    out[2] = static_cast<uint8_t>(length & 0xFFU);
+    if (data_bytes > 0)
+        {
+            std::memcpy(out + 3, d_buffer.data(), data_bytes);
+        }
+    const uint32_t crc = crc24q(out, 3 + data_bytes);
+    out[3 + data_bytes] = static_cast<uint8_t>(crc >> 16);
+    out[4 + data_bytes] = static_cast<uint8_t>(crc >> 8);
+    out[5 + data_bytes] = static_cast<uint8_t>(crc);
+    return message;
+}
+
+
+uint32_t Rtcm_Bit_Writer::crc24q(const uint8_t* data, size_t length)
+{
+    static const std::array<uint32_t, 256> table = make_crc24q_table();
+    uint32_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8) & 0xFFFFFFU) ^ table[((crc >> 16) ^ data[i]) & 0xFFU];
+        }
+    return crc;
+}
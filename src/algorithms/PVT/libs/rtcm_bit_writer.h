@@ -0,0 +1,128 @@
+/*!
+ * \file rtcm_bit_writer.h
+ * \brief Packs RTCM 3 data fields into a byte buffer and frames them with
+ * the transport layer (preamble, length and CRC-24Q)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTCM_BIT_WRITER_H
+#define GNSS_SDR_RTCM_BIT_WRITER_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes the data fields of a RTCM 3 message most significant bit
+ * first, straight into a byte buffer that is kept between messages.
+ *
+ * frame() returns the message as sent on the wire, byte by byte the same as
+ * the one built from strings of '0' and '1' symbols by Rtcm::add_CRC:
+ *
+ *   | preamble | 000000 |  length   |    data message    |  parity  |
+ *   |<-- 8 --->|<- 6 -->|<-- 10 --->|<--- length x 8 --->|<-- 24 -->|
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    explicit Rtcm_Bit_Writer(size_t reserved_bits = 8192);
+
+    /*!
+     * \brief Empties the data message, keeping the allocated buffer
+     */
+    void clear();
+
+    /*!
+     * \brief Appends the bits least significant bits of value
+     */
+    void put(uint64_t value, uint32_t bits);
+
+    /*!
+     * \brief Appends a data field, most significant bit first
+     */
+    template <size_t N>
+    void put(const std::bitset<N>& field)
+    {
+        if (N <= 64)
+            {
+                put(field.to_ullong(), N);
+                return;
+            }
+        for (size_t i = N; i > 0; i--)
+            {
+                put(field[i - 1] ? 1U : 0U, 1);
+            }
+    }
+
+    /*!
+     * \brief Appends a string of '0' and '1' symbols
+     */
+    void put(const std::string& bits);
+
+    /*!
+     * \brief Appends bits zeros and returns the position of the first one,
+     * to be overwritten later with put_at(). Used by fields that are written
+     * in a different order than they are computed, such as the MSM columns.
+     */
+    size_t skip(size_t bits);
+
+    /*!
+     * \brief Overwrites the bits starting at pos, which must have been
+     * appended already with skip()
+     */
+    void put_at(size_t pos, uint64_t value, uint32_t bits);
+
+    template <size_t N>
+    void put_at(size_t pos, const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "put_at() does not handle fields longer than 64 bits");
+        put_at(pos, field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Length of the data message, in bits
+     */
+    inline size_t size() const
+    {
+        return d_bits;
+    }
+
+    /*!
+     * \brief Returns the data message padded with zeros to a whole byte,
+     * with the transport layer header and the CRC-24Q
+     */
+    std::string frame() const;
+
+    /*!
+     * \brief Qualcomm CRC-24Q of a byte buffer, as used by RTCM 3
+     */
+    static uint32_t crc24q(const uint8_t* data, size_t length);
+
+private:
+    void write(size_t pos, uint64_t value, uint32_t bits);
+
+    std::vector<uint8_t> d_buffer;  // data message, zeros past d_bits
+    size_t d_bits{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTCM_BIT_WRITER_H
@@ -23,6 +23,8 @@
 #include "glonass_gnav_utc_model.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_stream_writer.h"
+#include "gnss_sdr_trace.h"
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_ephemeris.h"
@@ -35,7 +37,7 @@
 #include <fcntl.h>    // for O_RDWR
 #include <iostream>   // for cout, cerr
 #include <termios.h>  // for tcgetattr
-#include <unistd.h>   // for close, write
+#include <unistd.h>   // for close
 
 
 Rtcm_Printer::Rtcm_Printer(const std::string& filename,
@@ -46,12 +48,14 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
     uint16_t rtcm_station_id,
     const std::string& rtcm_dump_devname,
     bool time_tag_name,
-    const std::string& base_path) : rtcm_base_path(base_path),
-                                    rtcm_devname(rtcm_dump_devname),
-                                    port(rtcm_tcp_port),
-                                    station_id(rtcm_station_id),
-                                    d_rtcm_writing_started(false),
-                                    d_rtcm_file_dump(flag_rtcm_file_dump)
+    const std::string& base_path,
+    uint16_t rtcm_ntrip_port,
+    const std::string& rtcm_ntrip_mountpoint) : rtcm_base_path(base_path),
+                                                rtcm_devname(rtcm_dump_devname),
+                                                port(rtcm_tcp_port),
+                                                station_id(rtcm_station_id),
+                                                d_rtcm_writing_started(false),
+                                                d_rtcm_file_dump(flag_rtcm_file_dump)
 {
     const boost::posix_time::ptime pt = boost::posix_time::second_clock::local_time();
     const tm timeinfo = boost::posix_time::to_tm(pt);
@@ -150,6 +154,7 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
             rtcm_dev_descriptor = init_serial(rtcm_devname.c_str());
             if (rtcm_dev_descriptor != -1)
                 {
+                    Gnss_Stream_Writer::instance().add(rtcm_dev_descriptor, "RTCM output " + rtcm_devname);
                     DLOG(INFO) << "RTCM printer writing on " << rtcm_devname.c_str();
                 }
         }
@@ -158,7 +163,7 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
             rtcm_dev_descriptor = -1;
         }
 
-    rtcm = std::make_unique<Rtcm>(port);
+    rtcm = std::make_unique<Rtcm>(port, rtcm_ntrip_port, rtcm_ntrip_mountpoint);
 
     if (flag_rtcm_server)
         {
@@ -232,6 +237,7 @@ void Rtcm_Printer::Print_Rtcm_Messages(const Rtklib_Solver* pvt_solver,
     bool flag_write_RTCM_1045_output,
     bool enable_rx_clock_correction)
 {
+    GNSS_SDR_TRACE_ZONE("Rtcm_Printer::Print_Rtcm_Messages");
     try
         {
             if (d_rtcm_writing_started)
@@ -1641,6 +1647,7 @@ void Rtcm_Printer::close_serial() const
 {
     if (rtcm_dev_descriptor != -1)
         {
+            Gnss_Stream_Writer::instance().remove(rtcm_dev_descriptor);
             close(rtcm_dev_descriptor);
         }
 }
@@ -1665,7 +1672,7 @@ bool Rtcm_Printer::Print_Message(const std::string& message)
     // write to serial device
     if (rtcm_dev_descriptor != -1)
         {
-            if (write(rtcm_dev_descriptor, message.c_str(), message.length()) == -1)
+            if (!Gnss_Stream_Writer::instance().write(rtcm_dev_descriptor, message.c_str(), message.length()))
                 {
                     DLOG(INFO) << "RTCM printer cannot write on serial device " << rtcm_devname.c_str();
                     std::cout << "RTCM printer cannot write on serial device " << rtcm_devname.c_str() << '\n';
@@ -58,7 +58,9 @@ public:
         uint16_t rtcm_station_id,
         const std::string& rtcm_dump_devname,
         bool time_tag_name = true,
-        const std::string& base_path = ".");
+        const std::string& base_path = ".",
+        uint16_t rtcm_ntrip_port = 0,
+        const std::string& rtcm_ntrip_mountpoint = std::string("GNSSSDR"));
 
     /*!
      * \brief Default destructor.
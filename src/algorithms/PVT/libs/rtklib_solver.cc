@@ -32,22 +32,130 @@
 
 #include "rtklib_solver.h"
 #include "Beidou_DNAV.h"
+#include "columnar_dump.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_trace.h"
+#include "gnss_signal_id.h"
 #include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/vector.hpp>
 #include <glog/logging.h>
 #include <matio.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>  // for std::rename
 #include <exception>
+#include <fstream>
 #include <utility>
 #include <vector>
 
 
+namespace
+{
+const uint32_t WARM_START_MAGIC = 0x47535753;  // "GSWS"
+const uint32_t WARM_START_VERSION = 1;
+
+
+// Number of leading filter states that survive a restart: position, velocity,
+// acceleration, clocks and atmosphere, but not the carrier phase biases, which
+// are meaningless once tracking has been reacquired.
+int warm_start_states(const prcopt_t &opt)
+{
+    if (opt.mode == PMODE_SINGLE)
+        {
+            return 0;
+        }
+    if (opt.mode <= PMODE_FIXED)
+        {
+            return NR_RTK(&opt);
+        }
+    return NR_PPP(&opt);
+}
+
+
+// Columns of the dump file, named as the variables of the .mat file
+std::vector<Columnar_Dump_Column> pvt_dump_columns()
+{
+    std::vector<Columnar_Dump_Column> columns{
+        {"TOW_at_current_symbol_ms", Columnar_Dump_Type::UINT32},
+        {"week", Columnar_Dump_Type::UINT32},
+        {"RX_time", Columnar_Dump_Type::DOUBLE},
+        {"user_clk_offset", Columnar_Dump_Type::DOUBLE}};
+    for (const auto *name : {"pos_x", "pos_y", "pos_z", "vel_x", "vel_y", "vel_z",
+             "cov_xx", "cov_yy", "cov_zz", "cov_xy", "cov_yz", "cov_zx",
+             "latitude", "longitude", "height"})
+        {
+            columns.push_back({name, Columnar_Dump_Type::DOUBLE});
+        }
+    for (const auto *name : {"valid_sats", "solution_status", "solution_type"})
+        {
+            columns.push_back({name, Columnar_Dump_Type::UINT8});
+        }
+    for (const auto *name : {"AR_ratio_factor", "AR_ratio_threshold"})
+        {
+            columns.push_back({name, Columnar_Dump_Type::FLOAT});
+        }
+    for (const auto *name : {"gdop", "pdop", "hdop", "vdop"})
+        {
+            columns.push_back({name, Columnar_Dump_Type::DOUBLE});
+        }
+    return columns;
+}
+
+
+void mat_class_and_type(Columnar_Dump_Type type, matio_classes &mat_class, matio_types &mat_type)
+{
+    switch (type)
+        {
+        case Columnar_Dump_Type::INT8:
+            mat_class = MAT_C_INT8;
+            mat_type = MAT_T_INT8;
+            break;
+        case Columnar_Dump_Type::UINT8:
+            mat_class = MAT_C_UINT8;
+            mat_type = MAT_T_UINT8;
+            break;
+        case Columnar_Dump_Type::INT32:
+            mat_class = MAT_C_INT32;
+            mat_type = MAT_T_INT32;
+            break;
+        case Columnar_Dump_Type::UINT32:
+            mat_class = MAT_C_UINT32;
+            mat_type = MAT_T_UINT32;
+            break;
+        case Columnar_Dump_Type::INT64:
+            mat_class = MAT_C_INT64;
+            mat_type = MAT_T_INT64;
+            break;
+        case Columnar_Dump_Type::UINT64:
+            mat_class = MAT_C_UINT64;
+            mat_type = MAT_T_UINT64;
+            break;
+        case Columnar_Dump_Type::FLOAT:
+            mat_class = MAT_C_SINGLE;
+            mat_type = MAT_T_SINGLE;
+            break;
+        case Columnar_Dump_Type::DOUBLE:
+        default:
+            mat_class = MAT_C_DOUBLE;
+            mat_type = MAT_T_DOUBLE;
+        }
+}
+}  // namespace
+
+
 Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     const std::string &dump_filename,
     bool flag_dump_to_file,
     bool flag_dump_to_mat) : d_rtk(rtk),
                              d_dump_filename(dump_filename),
+                             d_dump_writer(pvt_dump_columns()),
                              d_flag_dump_enabled(flag_dump_to_file),
                              d_flag_dump_mat_enabled(flag_dump_to_mat)
 {
@@ -56,12 +164,11 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (d_dump_writer.is_open() == false)
                 {
                     try
                         {
-                            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_writer.open(d_dump_filename);
                             LOG(INFO) << "PVT lib dump enabled Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ofstream::failure &e)
@@ -76,18 +183,18 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
 Rtklib_Solver::~Rtklib_Solver()
 {
     DLOG(INFO) << "Rtklib_Solver destructor called.";
-    if (d_dump_file.is_open() == true)
+    if (d_dump_writer.is_open() == true)
         {
-            const auto pos = d_dump_file.tellp();
+            const auto records = d_dump_writer.num_records();
             try
                 {
-                    d_dump_file.close();
+                    d_dump_writer.close();
                 }
             catch (const std::exception &ex)
                 {
                     LOG(WARNING) << "Exception in destructor closing the RTKLIB dump file " << ex.what();
                 }
-            if (pos == 0)
+            if (records == 0)
                 {
                     errorlib::error_code ec;
                     if (!fs::remove(fs::path(d_dump_filename), ec))
@@ -113,275 +220,368 @@ Rtklib_Solver::~Rtklib_Solver()
 
 bool Rtklib_Solver::save_matfile() const
 {
-    // READ DUMP FILE
-    const std::string dump_filename = d_dump_filename;
-    const int32_t number_of_double_vars = 21;
-    const int32_t number_of_uint32_vars = 2;
-    const int32_t number_of_uint8_vars = 3;
-    const int32_t number_of_float_vars = 2;
-    const int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars +
-                                     sizeof(uint32_t) * number_of_uint32_vars +
-                                     sizeof(uint8_t) * number_of_uint8_vars +
-                                     sizeof(float) * number_of_float_vars;
-    std::ifstream dump_file;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
+    // The dump file is mapped and exported column by column, chunk by chunk,
+    // so the memory used does not grow with the length of the run.
+    Columnar_Dump_Reader dump_file;
+    if (!dump_file.open(d_dump_filename))
         {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
+            std::cerr << "Problem opening dump file " << d_dump_filename << '\n';
+            return false;
         }
-    catch (const std::ifstream::failure &e)
+    std::cout << "Generating .mat file for " << d_dump_filename << '\n';
+
+    std::string filename = d_dump_filename;
+    filename.erase(filename.length() - 4, 4);
+    filename.append(".mat");
+    mat_t *matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (reinterpret_cast<int64_t *>(matfp) == nullptr)
         {
-            std::cerr << "Problem opening dump file:" << e.what() << '\n';
             return false;
         }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
+    for (size_t column = 0; column < dump_file.columns().size(); column++)
         {
-            std::cout << "Generating .mat file for " << dump_filename << '\n';
-            const std::ifstream::pos_type size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
+            const Columnar_Dump_Column &info = dump_file.columns()[column];
+            matio_classes mat_class;
+            matio_types mat_type;
+            mat_class_and_type(info.type, mat_class, mat_type);
+#if MATIO_MAJOR_VERSION > 1 || (MATIO_MAJOR_VERSION == 1 && (MATIO_MINOR_VERSION > 5 || (MATIO_MINOR_VERSION == 5 && MATIO_RELEASE_LEVEL >= 13)))
+            for (size_t chunk = 0; chunk < dump_file.num_chunks(); chunk++)
+                {
+                    std::array<size_t, 2> dims{1, static_cast<size_t>(dump_file.chunk_records(chunk))};
+                    matvar_t *matvar = Mat_VarCreate(info.name.c_str(), mat_class, mat_type, 2, dims.data(), const_cast<char *>(dump_file.chunk_data(chunk, column)), MAT_F_DONT_COPY_DATA);
+                    Mat_VarWriteAppend(matfp, matvar, MAT_COMPRESSION_ZLIB, 2);
+                    Mat_VarFree(matvar);
+                }
+#else
+            // no appending in this version of matio: one column at a time
+            const size_t size = columnar_dump_type_size(info.type);
+            std::vector<char> values(static_cast<size_t>(dump_file.num_records()) * size);
+            size_t pos = 0;
+            for (size_t chunk = 0; chunk < dump_file.num_chunks(); chunk++)
+                {
+                    const size_t length = dump_file.chunk_records(chunk) * size;
+                    std::copy(dump_file.chunk_data(chunk, column), dump_file.chunk_data(chunk, column) + length, values.begin() + pos);
+                    pos += length;
+                }
+            std::array<size_t, 2> dims{1, static_cast<size_t>(dump_file.num_records())};
+            matvar_t *matvar = Mat_VarCreate(info.name.c_str(), mat_class, mat_type, 2, dims.data(), values.data(), 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
+#endif
         }
-    else
+    Mat_Close(matfp);
+    return true;
+}
+
+
+bool Rtklib_Solver::save_warm_start(const std::string &file_name) const
+{
+    const std::string tmp_file_name = file_name + ".tmp";
+    const int nr = std::min(warm_start_states(d_rtk.opt), d_rtk.nx);
+    std::vector<double> x;
+    std::vector<double> P;
+    for (int i = 0; i < nr; i++)
         {
+            x.push_back(d_rtk.x[i]);
+            for (int j = 0; j < nr; j++)
+                {
+                    P.push_back(d_rtk.P[i + j * d_rtk.nx]);
+                }
+        }
+    const std::vector<double> rr(d_rtk.sol.rr, d_rtk.sol.rr + 6);
+    const std::vector<double> dtr(d_rtk.sol.dtr, d_rtk.sol.dtr + 6);
+    const auto sol_time = static_cast<int64_t>(d_rtk.sol.time.time);
+    try
+        {
+            std::ofstream ofs;
+            ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            ofs.open(tmp_file_name.c_str(), std::ofstream::trunc | std::ofstream::out | std::ofstream::binary);
+            {
+                boost::archive::binary_oarchive bin(ofs);
+                bin << WARM_START_MAGIC << WARM_START_VERSION;
+                bin << gps_ephemeris_map << gps_cnav_ephemeris_map << galileo_ephemeris_map << glonass_gnav_ephemeris_map << beidou_dnav_ephemeris_map;
+                bin << gps_almanac_map << galileo_almanac_map << glonass_gnav_almanac << beidou_dnav_almanac_map;
+                bin << gps_iono << gps_cnav_iono << galileo_iono << beidou_dnav_iono;
+                bin << gps_iono.valid << gps_cnav_iono.valid << beidou_dnav_iono.valid;  // not serialized by the iono models
+                bin << gps_utc_model << gps_cnav_utc_model << galileo_utc_model << glonass_gnav_utc_model << beidou_dnav_utc_model;
+                bin << sol_time << d_rtk.sol.time.sec << d_rtk.sol.stat << rr << dtr;
+                bin << d_rtk.opt.mode << nr << x << P;
+            }
+            ofs.close();
+        }
+    catch (const std::exception &e)
+        {
+            LOG(WARNING) << "Problem writing the warm start file " << tmp_file_name << ": " << e.what();
             return false;
         }
+    if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+        {
+            LOG(WARNING) << "Problem renaming the warm start file " << tmp_file_name;
+            return false;
+        }
+    DLOG(INFO) << "Saved warm start data to " << file_name;
+    return true;
+}
 
-    auto TOW_at_current_symbol_ms = std::vector<uint32_t>(num_epoch);
-    auto week = std::vector<uint32_t>(num_epoch);
-    auto RX_time = std::vector<double>(num_epoch);
-    auto user_clk_offset = std::vector<double>(num_epoch);
-    auto pos_x = std::vector<double>(num_epoch);
-    auto pos_y = std::vector<double>(num_epoch);
-    auto pos_z = std::vector<double>(num_epoch);
-    auto vel_x = std::vector<double>(num_epoch);
-    auto vel_y = std::vector<double>(num_epoch);
-    auto vel_z = std::vector<double>(num_epoch);
-    auto cov_xx = std::vector<double>(num_epoch);
-    auto cov_yy = std::vector<double>(num_epoch);
-    auto cov_zz = std::vector<double>(num_epoch);
-    auto cov_xy = std::vector<double>(num_epoch);
-    auto cov_yz = std::vector<double>(num_epoch);
-    auto cov_zx = std::vector<double>(num_epoch);
-    auto latitude = std::vector<double>(num_epoch);
-    auto longitude = std::vector<double>(num_epoch);
-    auto height = std::vector<double>(num_epoch);
-    auto valid_sats = std::vector<uint8_t>(num_epoch);
-    auto solution_status = std::vector<uint8_t>(num_epoch);
-    auto solution_type = std::vector<uint8_t>(num_epoch);
-    auto AR_ratio_factor = std::vector<float>(num_epoch);
-    auto AR_ratio_threshold = std::vector<float>(num_epoch);
-    auto gdop = std::vector<double>(num_epoch);
-    auto pdop = std::vector<double>(num_epoch);
-    auto hdop = std::vector<double>(num_epoch);
-    auto vdop = std::vector<double>(num_epoch);
 
+bool Rtklib_Solver::load_warm_start(const std::string &file_name)
+{
+    std::ifstream ifs(file_name.c_str(), std::ifstream::in | std::ifstream::binary);
+    if (!ifs.is_open())
+        {
+            LOG(INFO) << "Warm start file " << file_name << " not found";
+            return false;
+        }
+    int64_t sol_time = 0;
+    double sol_sec = 0.0;
+    uint8_t sol_stat = SOLQ_NONE;
+    std::vector<double> rr;
+    std::vector<double> dtr;
+    int mode = PMODE_SINGLE;
+    int nr = 0;
+    std::vector<double> x;
+    std::vector<double> P;
     try
         {
-            if (dump_file.is_open())
+            boost::archive::binary_iarchive bin(ifs);
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            bin >> magic >> version;
+            if (magic != WARM_START_MAGIC || version != WARM_START_VERSION)
                 {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_ms[i]), sizeof(uint32_t));
-                            dump_file.read(reinterpret_cast<char *>(&week[i]), sizeof(uint32_t));
-                            dump_file.read(reinterpret_cast<char *>(&RX_time[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&user_clk_offset[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_x[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_y[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_z[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_x[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_y[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_z[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_xx[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_yy[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_zz[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_xy[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_yz[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_zx[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&latitude[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&longitude[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&height[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&valid_sats[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&solution_status[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&solution_type[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&AR_ratio_factor[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&AR_ratio_threshold[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&gdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&hdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vdop[i]), sizeof(double));
-                        }
+                    LOG(WARNING) << "Unknown format of the warm start file " << file_name;
+                    return false;
                 }
-            dump_file.close();
+            bin >> gps_ephemeris_map >> gps_cnav_ephemeris_map >> galileo_ephemeris_map >> glonass_gnav_ephemeris_map >> beidou_dnav_ephemeris_map;
+            bin >> gps_almanac_map >> galileo_almanac_map >> glonass_gnav_almanac >> beidou_dnav_almanac_map;
+            bin >> gps_iono >> gps_cnav_iono >> galileo_iono >> beidou_dnav_iono;
+            bin >> gps_iono.valid >> gps_cnav_iono.valid >> beidou_dnav_iono.valid;
+            bin >> gps_utc_model >> gps_cnav_utc_model >> galileo_utc_model >> glonass_gnav_utc_model >> beidou_dnav_utc_model;
+            bin >> sol_time >> sol_sec >> sol_stat >> rr >> dtr;
+            bin >> mode >> nr >> x >> P;
         }
-    catch (const std::ifstream::failure &e)
+    catch (const std::exception &e)
         {
-            std::cerr << "Problem reading dump file:" << e.what() << '\n';
+            LOG(WARNING) << "Problem reading the warm start file " << file_name << ": " << e.what();
             return false;
         }
 
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
-    std::string filename = dump_filename;
-    filename.erase(filename.length() - 4, 4);
-    filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
+    if (sol_stat != SOLQ_NONE && rr.size() == 6 && dtr.size() == 6)
         {
-            std::array<size_t, 2> dims{1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("TOW_at_current_symbol_ms", MAT_C_UINT32, MAT_T_UINT32, 2, dims.data(), TOW_at_current_symbol_ms.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("week", MAT_C_UINT32, MAT_T_UINT32, 2, dims.data(), week.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), RX_time.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("user_clk_offset", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), user_clk_offset.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_x", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), pos_x.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_y", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), pos_y.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_z", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), pos_z.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_x", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), vel_x.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_y", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), vel_y.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_z", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), vel_z.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_xx", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_xx.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_yy", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_yy.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            // the last solution is the initial guess of the least squares
+            d_rtk.sol.time.time = static_cast<time_t>(sol_time);
+            d_rtk.sol.time.sec = sol_sec;
+            d_rtk.sol.stat = sol_stat;
+            std::copy(rr.cbegin(), rr.cend(), d_rtk.sol.rr);
+            std::copy(dtr.cbegin(), dtr.cend(), d_rtk.sol.dtr);
+        }
+    if (nr > 0 && mode == d_rtk.opt.mode && nr == std::min(warm_start_states(d_rtk.opt), d_rtk.nx) &&
+        x.size() == static_cast<size_t>(nr) && P.size() == static_cast<size_t>(nr * nr))
+        {
+            for (int i = 0; i < nr; i++)
+                {
+                    d_rtk.x[i] = x[i];
+                    for (int j = 0; j < nr; j++)
+                        {
+                            d_rtk.P[i + j * d_rtk.nx] = P[i * nr + j];
+                        }
+                }
+        }
+    LOG(INFO) << "Loaded warm start data from " << file_name << ": "
+              << gps_ephemeris_map.size() + gps_cnav_ephemeris_map.size() + galileo_ephemeris_map.size() + glonass_gnav_ephemeris_map.size() + beidou_dnav_ephemeris_map.size()
+              << " ephemeris, " << nr << " filter states";
+    return true;
+}
 
-            matvar = Mat_VarCreate("cov_zz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_zz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("cov_xy", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_xy.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+std::shared_ptr<const Rtklib_Solver> Rtklib_Solver::get_snapshot() const
+{
+    rtk_t rtk{};
+    rtk.opt = d_rtk.opt;
+    rtk.sol = d_rtk.sol;
+    auto snapshot = std::make_shared<Rtklib_Solver>(rtk, d_dump_filename, false, false);
+    static_cast<Pvt_Solution &>(*snapshot) = *this;
+    snapshot->pvt_sol = pvt_sol;
+    snapshot->pvt_ssat = pvt_ssat;
+    snapshot->galileo_ephemeris_map = galileo_ephemeris_map;
+    snapshot->gps_ephemeris_map = gps_ephemeris_map;
+    snapshot->gps_cnav_ephemeris_map = gps_cnav_ephemeris_map;
+    snapshot->glonass_gnav_ephemeris_map = glonass_gnav_ephemeris_map;
+    snapshot->beidou_dnav_ephemeris_map = beidou_dnav_ephemeris_map;
+    snapshot->galileo_utc_model = galileo_utc_model;
+    snapshot->galileo_iono = galileo_iono;
+    snapshot->galileo_almanac_map = galileo_almanac_map;
+    snapshot->gps_utc_model = gps_utc_model;
+    snapshot->gps_iono = gps_iono;
+    snapshot->gps_almanac_map = gps_almanac_map;
+    snapshot->gps_cnav_iono = gps_cnav_iono;
+    snapshot->gps_cnav_utc_model = gps_cnav_utc_model;
+    snapshot->glonass_gnav_utc_model = glonass_gnav_utc_model;
+    snapshot->glonass_gnav_almanac = glonass_gnav_almanac;
+    snapshot->beidou_dnav_utc_model = beidou_dnav_utc_model;
+    snapshot->beidou_dnav_iono = beidou_dnav_iono;
+    snapshot->beidou_dnav_almanac_map = beidou_dnav_almanac_map;
+    snapshot->d_dop = d_dop;
+    snapshot->d_monitor_pvt = d_monitor_pvt;
+    snapshot->d_snapshot_memory_gauge.set(snapshot->memory_bytes());
+    return snapshot;
+}
 
-            matvar = Mat_VarCreate("cov_yz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_yz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("cov_zx", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), cov_zx.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+double Rtklib_Solver::get_gdop() const
+{
+    return d_dop[0];
+}
 
-            matvar = Mat_VarCreate("latitude", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), latitude.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("longitude", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), longitude.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+double Rtklib_Solver::get_pdop() const
+{
+    return d_dop[1];
+}
 
-            matvar = Mat_VarCreate("height", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), height.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("valid_sats", MAT_C_UINT8, MAT_T_UINT8, 2, dims.data(), valid_sats.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+double Rtklib_Solver::get_hdop() const
+{
+    return d_dop[2];
+}
 
-            matvar = Mat_VarCreate("solution_status", MAT_C_UINT8, MAT_T_UINT8, 2, dims.data(), solution_status.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("solution_type", MAT_C_UINT8, MAT_T_UINT8, 2, dims.data(), solution_type.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+double Rtklib_Solver::get_vdop() const
+{
+    return d_dop[3];
+}
 
-            matvar = Mat_VarCreate("AR_ratio_factor", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), AR_ratio_factor.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("AR_ratio_threshold", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), AR_ratio_threshold.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
+{
+    return d_monitor_pvt;
+}
 
-            matvar = Mat_VarCreate("gdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), gdop.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("pdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), pdop.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+void Rtklib_Solver::set_range_rate_predictions(bool enable)
+{
+    d_range_rate_predictions = enable;
+    d_range_rates_m_s.clear();
+}
 
-            matvar = Mat_VarCreate("hdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), hdop.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("vdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), vdop.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+bool Rtklib_Solver::get_predicted_range_rate(const Gnss_Synchro &gnss_synchro, double &range_rate_m_s) const
+{
+    int sys = SYS_NONE;
+    switch (gnss_synchro.System)
+        {
+        case 'G':
+            sys = SYS_GPS;
+            break;
+        case 'E':
+            sys = SYS_GAL;
+            break;
+        case 'R':
+            sys = SYS_GLO;
+            break;
+        case 'C':
+            sys = SYS_BDS;
+            break;
+        default:
+            return false;
         }
-
-    Mat_Close(matfp);
+    const auto it = d_range_rates_m_s.find(satno(sys, static_cast<int>(gnss_synchro.PRN)));
+    if (it == d_range_rates_m_s.cend())
+        {
+            return false;
+        }
+    range_rate_m_s = it->second;
     return true;
 }
 
 
-double Rtklib_Solver::get_gdop() const
+void Rtklib_Solver::compute_range_rates(const Rtklib_Epoch &epoch)
 {
-    return d_dop[0];
+    d_range_rates_m_s.clear();
+    const int n_obs = epoch.n_obs;
+    if (n_obs <= 0)
+        {
+            return;
+        }
+    std::vector<double> rs(6 * n_obs);
+    std::vector<double> dts(2 * n_obs);
+    std::vector<double> var(n_obs);
+    std::vector<int> svh(n_obs);
+    satposs(epoch.obs[0].time, epoch.obs.data(), n_obs, &epoch.nav, EPHOPT_BRDC, rs.data(), dts.data(), var.data(), svh.data());
+    for (int i = 0; i < n_obs; i++)
+        {
+            std::array<double, 3> los{};
+            double range = 0.0;
+            for (int k = 0; k < 3; k++)
+                {
+                    los[k] = rs[6 * i + k] - pvt_sol.rr[k];
+                    range += los[k] * los[k];
+                }
+            range = std::sqrt(range);
+            if (range == 0.0 or norm_rtk(&rs[6 * i], 3) == 0.0)
+                {
+                    continue;  // no ephemeris for this satellite
+                }
+            double range_rate = 0.0;
+            for (int k = 0; k < 3; k++)
+                {
+                    range_rate += los[k] / range * (rs[6 * i + 3 + k] - pvt_sol.rr[3 + k]);
+                }
+            // dtr[5] is the receiver clock drift [m/s], dts[1] the satellite one [s/s]
+            d_range_rates_m_s[epoch.obs[i].sat] = range_rate + pvt_sol.dtr[5] - SPEED_OF_LIGHT_M_S * dts[2 * i + 1];
+        }
 }
 
 
-double Rtklib_Solver::get_pdop() const
+size_t Rtklib_Solver::memory_bytes() const
 {
-    return d_dop[1];
+    // the nodes of the maps are counted without their bookkeeping overhead
+    size_t bytes = galileo_ephemeris_map.size() * sizeof(Galileo_Ephemeris) +
+                   gps_ephemeris_map.size() * sizeof(Gps_Ephemeris) +
+                   gps_cnav_ephemeris_map.size() * sizeof(Gps_CNAV_Ephemeris) +
+                   glonass_gnav_ephemeris_map.size() * sizeof(Glonass_Gnav_Ephemeris) +
+                   beidou_dnav_ephemeris_map.size() * sizeof(Beidou_Dnav_Ephemeris) +
+                   galileo_almanac_map.size() * sizeof(Galileo_Almanac) +
+                   gps_almanac_map.size() * sizeof(Gps_Almanac) +
+                   beidou_dnav_almanac_map.size() * sizeof(Beidou_Dnav_Almanac) +
+                   d_range_rates_m_s.size() * sizeof(double) +
+                   d_eph_cache.memory_bytes();
+    // float and fixed states of the filter, and their covariances
+    const auto nx = static_cast<size_t>(std::max(d_rtk.nx, 0));
+    const auto na = static_cast<size_t>(std::max(d_rtk.na, 0));
+    bytes += (nx + nx * nx + na + na * na) * sizeof(double);
+    return bytes;
 }
 
 
-double Rtklib_Solver::get_hdop() const
+Rtklib_Epoch &Rtklib_Solver::writable_epoch()
 {
-    return d_dop[2];
+    // use_count() only decreases while other threads hold the epoch, so a
+    // stale value just allocates a new one
+    if (d_epoch == nullptr or d_epoch.use_count() > 1)
+        {
+            d_epoch = std::make_shared<Rtklib_Epoch>();
+        }
+    return *d_epoch;
 }
 
 
-double Rtklib_Solver::get_vdop() const
+std::shared_ptr<const Rtklib_Epoch> Rtklib_Solver::get_epoch() const
 {
-    return d_dop[3];
+    return d_epoch;
 }
 
 
-Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
+bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
-    return d_monitor_pvt;
+    return get_PVT(Pvt_Observables(gnss_observables_map), flag_averaging);
 }
 
 
-bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
+bool Rtklib_Solver::get_PVT(const Pvt_Observables &gnss_observables_map, bool flag_averaging)
 {
-    std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
+    GNSS_SDR_TRACE_ZONE("get_PVT");
+    Pvt_Observables::const_iterator gnss_observables_iter;
     std::map<int, Galileo_Ephemeris>::const_iterator galileo_ephemeris_iter;
     std::map<int, Gps_Ephemeris>::const_iterator gps_ephemeris_iter;
     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
@@ -395,12 +595,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     // ********************************************************************************
     // ****** PREPARE THE DATA (SV EPHEMERIS AND OBSERVATIONS) ************************
     // ********************************************************************************
+    Rtklib_Epoch &epoch = writable_epoch();
     int valid_obs = 0;      // valid observations counter
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
-    d_obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -415,12 +613,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'G':
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "1C")
+                        const Gnss_Signal_Code sig_ = gnss_signal_code(gnss_observables_iter->second.Signal);
+                        if (sig_ == Gnss_Signal_Code::SIG_1C)
                             {
                                 band1 = true;
                             }
-                        if (sig_ == "2S")
+                        if (sig_ == Gnss_Signal_Code::SIG_2S)
                             {
                                 band2 = true;
                             }
@@ -444,19 +642,19 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'E':
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
+                        const Gnss_Signal_Code sig_ = gnss_signal_code(gnss_observables_iter->second.Signal);
                         // Galileo E1
-                        if (sig_ == "1B")
+                        if (sig_ == Gnss_Signal_Code::SIG_1B)
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                        epoch.eph[valid_obs] = d_eph_cache.convert(galileo_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
-                                        obsd_t newobs{};
-                                        d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                        epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};
+                                        insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                             gnss_observables_iter->second,
                                             galileo_ephemeris_iter->second.WN,
                                             0);
@@ -469,7 +667,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                             }
 
                         // Galileo E5
-                        if ((sig_ == "5X") || (sig_ == "7X"))
+                        if ((sig_ == Gnss_Signal_Code::SIG_5X) || (sig_ == Gnss_Signal_Code::SIG_7X))
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -478,9 +676,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (epoch.eph[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
-                                                        d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
+                                                        insert_obs_to_rtklib(epoch.obs[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
                                                             galileo_ephemeris_iter->second.WN,
                                                             2);  // Band 3 (L5/E5)
@@ -492,13 +690,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E5 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                epoch.eph[valid_obs] = d_eph_cache.convert(galileo_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
-                                                const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
-                                                obsd_t newobs = {{0, 0}, '0', '0', {}, {},
-                                                    {default_code_, default_code_, default_code_},
-                                                    {}, {0.0, 0.0, 0.0}, {}};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};  // CODE_NONE in all the bands
+                                                insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                                     gnss_observables_iter->second,
                                                     galileo_ephemeris_iter->second.WN,
                                                     2);  // Band 3 (L5/E5)
@@ -509,7 +704,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     {
                                         DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
                                     }
-                                if (sig_ == "7X")
+                                if (sig_ == Gnss_Signal_Code::SIG_7X)
                                     {
                                         gal_e5_is_e5b = true;
                                     }
@@ -520,17 +715,17 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // GPS L1
                         // 1 GPS - find the ephemeris for the current GPS SV observation. The SV PRN ID is the map key
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "1C")
+                        const Gnss_Signal_Code sig_ = gnss_signal_code(gnss_observables_iter->second.Signal);
+                        if (sig_ == Gnss_Signal_Code::SIG_1C)
                             {
                                 gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second, this->is_pre_2009());
+                                        epoch.eph[valid_obs] = d_eph_cache.convert(gps_ephemeris_iter->second, this->is_pre_2009());
                                         // convert observation from GNSS-SDR class to RTKLIB structure
-                                        obsd_t newobs{};
-                                        d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                        epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};
+                                        insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                             gnss_observables_iter->second,
                                             gps_ephemeris_iter->second.WN,
                                             0,
@@ -543,7 +738,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L2 (todo: solve NAV/CNAV clash)
-                        if ((sig_ == "2S") and (gps_dual_band == false))
+                        if ((sig_ == Gnss_Signal_Code::SIG_2S) and (gps_dual_band == false))
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -557,12 +752,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (epoch.eph[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
-                                                                d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
+                                                                epoch.eph[i] = d_eph_cache.convert(gps_cnav_ephemeris_iter->second);
+                                                                insert_obs_to_rtklib(epoch.obs[i + glo_valid_obs],
                                                                     gnss_observables_iter->second,
-                                                                    eph_data[i].week,
+                                                                    epoch.eph[i].week,
                                                                     1);  // Band 2 (L2)
                                                                 break;
                                                             }
@@ -573,13 +768,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                epoch.eph[valid_obs] = d_eph_cache.convert(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
-                                                const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
-                                                obsd_t newobs = {{0, 0}, '0', '0', {}, {},
-                                                    {default_code_, default_code_, default_code_},
-                                                    {}, {0.0, 0.0, 0.0}, {}};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};  // CODE_NONE in all the bands
+                                                insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                                     gnss_observables_iter->second,
                                                     gps_cnav_ephemeris_iter->second.WN,
                                                     1);  // Band 2 (L2)
@@ -592,7 +784,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L5
-                        if (sig_ == "L5")
+                        if (sig_ == Gnss_Signal_Code::SIG_L5)
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -605,10 +797,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (epoch.eph[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
-                                                                d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i],
+                                                                epoch.eph[i] = d_eph_cache.convert(gps_cnav_ephemeris_iter->second);
+                                                                epoch.obs[i + glo_valid_obs] = insert_obs_to_rtklib(epoch.obs[i],
                                                                     gnss_observables_iter->second,
                                                                     gps_cnav_ephemeris_iter->second.WN,
                                                                     2);  // Band 3 (L5)
@@ -620,13 +812,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                epoch.eph[valid_obs] = d_eph_cache.convert(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
-                                                const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
-                                                obsd_t newobs = {{0, 0}, '0', '0', {}, {},
-                                                    {default_code_, default_code_, default_code_},
-                                                    {}, {0.0, 0.0, 0.0}, {}};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};  // CODE_NONE in all the bands
+                                                insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                                     gnss_observables_iter->second,
                                                     gps_cnav_ephemeris_iter->second.WN,
                                                     2);  // Band 3 (L5)
@@ -642,19 +831,19 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     }
                 case 'R':  // TODO This should be using rtk lib nomenclature
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
+                        const Gnss_Signal_Code sig_ = gnss_signal_code(gnss_observables_iter->second.Signal);
                         // GLONASS GNAV L1
-                        if (sig_ == "1G")
+                        if (sig_ == Gnss_Signal_Code::SIG_1G)
                             {
                                 // 1 Glo - find the ephemeris for the current GLONASS SV observation. The SV Slot Number (PRN ID) is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                        epoch.geph[glo_valid_obs] = d_eph_cache.convert(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
-                                        obsd_t newobs{};
-                                        d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                        epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};
+                                        insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                             gnss_observables_iter->second,
                                             glonass_gnav_ephemeris_iter->second.d_WN,
                                             0);  // Band 0 (L1)
@@ -666,7 +855,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GLONASS GNAV L2
-                        if (sig_ == "2G")
+                        if (sig_ == Gnss_Signal_Code::SIG_2G)
                             {
                                 // 1 GLONASS - find the ephemeris for the current GLONASS SV observation. The SV PRN ID is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -675,9 +864,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_L1_obs = false;
                                         for (int i = 0; i < glo_valid_obs; i++)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
+                                                if (epoch.geph[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
                                                     {
-                                                        d_obs_data[i + valid_obs] = insert_obs_to_rtklib(d_obs_data[i + valid_obs],
+                                                        insert_obs_to_rtklib(epoch.obs[i + valid_obs],
                                                             gnss_observables_iter->second,
                                                             glonass_gnav_ephemeris_iter->second.d_WN,
                                                             1);  // Band 1 (L2)
@@ -689,10 +878,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                epoch.geph[glo_valid_obs] = d_eph_cache.convert(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
-                                                obsd_t newobs{};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};
+                                                insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                                     gnss_observables_iter->second,
                                                     glonass_gnav_ephemeris_iter->second.d_WN,
                                                     1);  // Band 1 (L2)
@@ -710,17 +899,17 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // BEIDOU B1I
                         //  - find the ephemeris for the current BEIDOU SV observation. The SV PRN ID is the map key
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "B1")
+                        const Gnss_Signal_Code sig_ = gnss_signal_code(gnss_observables_iter->second.Signal);
+                        if (sig_ == Gnss_Signal_Code::SIG_B1)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                        epoch.eph[valid_obs] = d_eph_cache.convert(beidou_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
-                                        obsd_t newobs{};
-                                        d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                        epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};
+                                        insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                             gnss_observables_iter->second,
                                             beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
                                             0);
@@ -732,7 +921,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // BeiDou B3
-                        if (sig_ == "B3")
+                        if (sig_ == Gnss_Signal_Code::SIG_B3)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
@@ -740,9 +929,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_B1I_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
+                                                if (epoch.eph[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
                                                     {
-                                                        d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
+                                                        insert_obs_to_rtklib(epoch.obs[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
                                                             beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
                                                             2);  // Band 3 (L2/G2/B3)
@@ -754,13 +943,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert BeiDou B3I obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                                epoch.eph[valid_obs] = d_eph_cache.convert(beidou_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
-                                                const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
-                                                obsd_t newobs = {{0, 0}, '0', '0', {}, {},
-                                                    {default_code_, default_code_, default_code_},
-                                                    {}, {0.0, 0.0, 0.0}, {}};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                epoch.obs[valid_obs + glo_valid_obs] = obsd_t{};  // CODE_NONE in all the bands
+                                                insert_obs_to_rtklib(epoch.obs[valid_obs + glo_valid_obs],
                                                     gnss_observables_iter->second,
                                                     beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
                                                     2);  // Band 2 (L2/G2)
@@ -781,17 +967,26 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 }
         }
 
-    // **********************************************************************
-    // ****** SOLVE PVT******************************************************
-    // **********************************************************************
-
-    this->set_valid_position(false);
-    if ((valid_obs + glo_valid_obs) > 3)
+    epoch.n_obs = valid_obs + glo_valid_obs;
+    if (gnss_observables_map.empty() == false)
+        {
+            epoch.TOW_at_current_symbol_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
+            epoch.RX_time = gnss_observables_map.cbegin()->second.RX_time;
+        }
+    if (epoch.n_obs > 3)
         {
-            int result = 0;
-            nav_t nav_data{};
-            nav_data.eph = eph_data.data();
-            nav_data.geph = geph_data.data();
+            // the rest of nav_data is never written, so it is still zero if the epoch is reused
+            nav_t &nav_data = epoch.nav;
+            std::fill_n(nav_data.ion_gps, 8, 0.0);
+            std::fill_n(nav_data.ion_gal, 4, 0.0);
+            std::fill_n(nav_data.ion_cmp, 8, 0.0);
+            std::fill_n(nav_data.utc_gps, 4, 0.0);
+            std::fill_n(nav_data.utc_glo, 4, 0.0);
+            std::fill_n(nav_data.utc_gal, 4, 0.0);
+            std::fill_n(nav_data.utc_cmp, 4, 0.0);
+            nav_data.leaps = 0;
+            nav_data.eph = epoch.eph.data();
+            nav_data.geph = epoch.geph.data();
             nav_data.n = valid_obs;
             nav_data.ng = glo_valid_obs;
             if (gps_iono.valid)
@@ -890,8 +1085,23 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                 }
                         }
                 }
+        }
+
+    // **********************************************************************
+    // ****** SOLVE PVT******************************************************
+    // **********************************************************************
+
+    return solve_epoch(epoch);
+}
 
-            result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &nav_data);
+
+bool Rtklib_Solver::solve_epoch(const Rtklib_Epoch &epoch)
+{
+    this->set_valid_position(false);
+    if (epoch.n_obs > 3)
+        {
+            const nav_t &nav_data = epoch.nav;
+            const int result = rtkpos(&d_rtk, epoch.obs.data(), epoch.n_obs, &nav_data);
 
             if (result == 0)
                 {
@@ -904,6 +1114,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                     this->set_num_valid_observations(d_rtk.sol.ns);  // record the number of valid satellites used by the PVT solver
                     pvt_sol = d_rtk.sol;
+                    if (d_range_rate_predictions)
+                        {
+                            compute_range_rates(epoch);
+                        }
                     // DOP computation
                     unsigned int used_sats = 0;
                     for (unsigned int i = 0; i < MAXSAT; i++)
@@ -971,13 +1185,15 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
 
                     this->set_time_offset_s(rx_position_and_time[3]);
 
-                    DLOG(INFO) << "RTKLIB Position at RX TOW = " << gnss_observables_map.cbegin()->second.RX_time
+                    DLOG(INFO) << "RTKLIB Position at RX TOW = " << epoch.RX_time
                                << " in ECEF (X,Y,Z,t[meters]) = " << rx_position_and_time[0] << ", " << rx_position_and_time[1] << ", " << rx_position_and_time[2] << ", " << rx_position_and_time[3];
 
                     // gtime_t rtklib_utc_time = gpst2utc(pvt_sol.time); // Corrected RX Time (Non integer multiply of 1 ms of granularity)
                     // Uncorrected RX Time (integer multiply of 1 ms and the same observables time reported in RTCM and RINEX)
                     const gtime_t rtklib_time = timeadd(pvt_sol.time, rx_position_and_time[3]);  // uncorrected rx time
-                    const gtime_t rtklib_utc_time = gpst2utc(rtklib_time);
+                    epoch_time_t rx_epoch_time{};
+                    epoch_time(rtklib_time, &rx_epoch_time);
+                    const gtime_t rtklib_utc_time = rx_epoch_time.utc;
                     boost::posix_time::ptime p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
                     p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
 
@@ -990,11 +1206,11 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
 
                     // ######## PVT MONITOR #########
                     // TOW
-                    d_monitor_pvt.TOW_at_current_symbol_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
+                    d_monitor_pvt.TOW_at_current_symbol_ms = epoch.TOW_at_current_symbol_ms;
                     // WEEK
                     d_monitor_pvt.week = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
                     // PVT GPS time
-                    d_monitor_pvt.RX_time = gnss_observables_map.cbegin()->second.RX_time;
+                    d_monitor_pvt.RX_time = epoch.RX_time;
                     // User clock offset [s]
                     d_monitor_pvt.user_clk_offset = rx_position_and_time[3];
 
@@ -1049,78 +1265,55 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     // ######## LOG FILE #########
                     if (d_flag_dump_enabled == true)
                         {
-                            // MULTIPLEXED FILE RECORDING - Record results to file
+                            // COLUMNAR FILE RECORDING - Record results to file
                             try
                                 {
-                                    double tmp_double;
-                                    uint32_t tmp_uint32;
+                                    size_t column = 0;
                                     // TOW
-                                    tmp_uint32 = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
+                                    d_dump_writer.set<uint32_t>(column++, epoch.TOW_at_current_symbol_ms);
                                     // WEEK
-                                    tmp_uint32 = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
+                                    d_dump_writer.set<uint32_t>(column++, d_monitor_pvt.week);
                                     // PVT GPS time
-                                    tmp_double = gnss_observables_map.cbegin()->second.RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    d_dump_writer.set<double>(column++, epoch.RX_time);
                                     // User clock offset [s]
-                                    tmp_double = rx_position_and_time[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    d_dump_writer.set<double>(column++, rx_position_and_time[3]);
 
                                     // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
-                                    tmp_double = pvt_sol.rr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    for (const double value : pvt_sol.rr)
+                                        {
+                                            d_dump_writer.set<double>(column++, value);
+                                        }
 
                                     // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
-                                    tmp_double = pvt_sol.qr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    for (const float value : pvt_sol.qr)
+                                        {
+                                            d_dump_writer.set<double>(column++, value);
+                                        }
 
                                     // GEO user position Latitude [deg]
-                                    tmp_double = this->get_latitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    d_dump_writer.set<double>(column++, this->get_latitude());
                                     // GEO user position Longitude [deg]
-                                    tmp_double = this->get_longitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    d_dump_writer.set<double>(column++, this->get_longitude());
                                     // GEO user position Height [m]
-                                    tmp_double = this->get_height();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                                    d_dump_writer.set<double>(column++, this->get_height());
 
                                     // NUMBER OF VALID SATS
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ns), sizeof(uint8_t));
+                                    d_dump_writer.set<uint8_t>(column++, pvt_sol.ns);
                                     // RTKLIB solution status
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.stat), sizeof(uint8_t));
+                                    d_dump_writer.set<uint8_t>(column++, pvt_sol.stat);
                                     // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.type), sizeof(uint8_t));
+                                    d_dump_writer.set<uint8_t>(column++, pvt_sol.type);
                                     // AR ratio factor for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ratio), sizeof(float));
+                                    d_dump_writer.set<float>(column++, pvt_sol.ratio);
                                     // AR ratio threshold for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.thres), sizeof(float));
+                                    d_dump_writer.set<float>(column++, pvt_sol.thres);
 
                                     // GDOP / PDOP / HDOP / VDOP
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[0]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[1]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[2]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[3]), sizeof(double));
+                                    for (const double value : d_dop)
+                                        {
+                                            d_dump_writer.set<double>(column++, value);
+                                        }
+                                    d_dump_writer.commit();
                                 }
                             catch (const std::ifstream::failure &e)
                                 {
@@ -1129,5 +1322,6 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         }
                 }
         }
+    d_memory_gauge.set(memory_bytes());
     return this->is_valid_position();
 }
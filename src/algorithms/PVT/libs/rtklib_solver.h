@@ -39,6 +39,7 @@
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
+#include "columnar_dump.h"
 #include "galileo_almanac.h"
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
@@ -55,11 +56,15 @@
 #include "gps_iono.h"
 #include "gps_utc_model.h"
 #include "monitor_pvt.h"
+#include "gnss_sdr_memory_accounting.h"
+#include "pvt_observables.h"
 #include "pvt_solution.h"
 #include "rtklib.h"
+#include "rtklib_conversions.h"
 #include <array>
-#include <fstream>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 
 /** \addtogroup PVT
@@ -69,6 +74,28 @@
  * \{ */
 
 
+/*!
+ * \brief Observations and navigation data of one epoch, converted to the
+ * RTKLIB structures. It is prepared once by the solver that receives the
+ * observables and can be solved by several solvers with different options.
+ */
+class Rtklib_Epoch
+{
+public:
+    Rtklib_Epoch() = default;
+    Rtklib_Epoch(const Rtklib_Epoch&) = delete;  // nav points to the arrays below
+    Rtklib_Epoch& operator=(const Rtklib_Epoch&) = delete;
+
+    std::array<obsd_t, MAXOBS> obs{};  // only the first n_obs are set
+    std::array<eph_t, MAXOBS> eph{};
+    std::array<geph_t, MAXOBS> geph{};
+    nav_t nav{};
+    int n_obs{0};
+    uint32_t TOW_at_current_symbol_ms{0};
+    double RX_time{0.0};
+};
+
+
 /*!
  * \brief This class implements a PVT solution based on RTKLIB
  */
@@ -78,14 +105,64 @@ public:
     Rtklib_Solver(const rtk_t& rtk, const std::string& dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat);
     ~Rtklib_Solver();
 
+    bool get_PVT(const Pvt_Observables& gnss_observables_map, bool flag_averaging);
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
+    /*!
+     * \brief Solves an epoch prepared by get_PVT of another solver, with the
+     * options of this one. It does not use the navigation data of this solver.
+     */
+    bool solve_epoch(const Rtklib_Epoch& epoch);
+
+    /*!
+     * \brief Epoch prepared by the last call to get_PVT, to be solved by other
+     * solvers. The next call prepares a new one if this is still held.
+     */
+    std::shared_ptr<const Rtklib_Epoch> get_epoch() const;
+
     double get_hdop() const override;
     double get_vdop() const override;
     double get_pdop() const override;
     double get_gdop() const override;
     Monitor_Pvt get_monitor_pvt() const;
 
+    /*!
+     * \brief Enables the computation of the satellite range rates after
+     * each valid solution, used to aid the tracking loops.
+     */
+    void set_range_rate_predictions(bool enable);
+
+    /*!
+     * \brief Pseudorange rate of the satellite of the observation, as seen by
+     * the last PVT solution: line-of-sight velocity plus receiver clock drift
+     * minus satellite clock drift [m/s]. Returns false if it is not available.
+     */
+    bool get_predicted_range_rate(const Gnss_Synchro& gnss_synchro, double& range_rate_m_s) const;
+
+    /*!
+     * \brief Saves the navigation data (ephemeris, almanacs, ionospheric and
+     * UTC models) and the receiver state (last solution and, in DGNSS, RTK and
+     * PPP modes, the non-ambiguity states of the filter) to a binary file.
+     * The file is written aside and renamed, so it is never left half written.
+     */
+    bool save_warm_start(const std::string& file_name) const;
+
+    /*!
+     * \brief Loads the data saved by save_warm_start, so that a restarted
+     * receiver computes a fix as soon as it has observables instead of waiting
+     * for the broadcast ephemeris. Stale ephemeris are discarded by the
+     * ephemeris selection of each epoch. The filter state is only restored if
+     * it was saved with the same positioning mode and number of states.
+     */
+    bool load_warm_start(const std::string& file_name);
+
+    /*!
+     * \brief Copy of the last solution and of the navigation data, read by
+     * the printers that run out of the PVT block thread. It has no filter
+     * states, so it cannot compute solutions.
+     */
+    std::shared_ptr<const Rtklib_Solver> get_snapshot() const;
+
     sol_t pvt_sol{};
     std::array<ssat_t, MAXSAT> pvt_ssat{};
 
@@ -115,15 +192,23 @@ public:
 
 private:
     bool save_matfile() const;
+    void compute_range_rates(const Rtklib_Epoch& epoch);
+    Rtklib_Epoch& writable_epoch();
+    size_t memory_bytes() const;
 
-    std::array<obsd_t, MAXOBS> d_obs_data{};
+    std::shared_ptr<Rtklib_Epoch> d_epoch;  // reused while no other solver holds it
+    Rtklib_Ephemeris_Cache d_eph_cache;  // conversions reused until the ephemeris of a satellite changes
     std::array<double, 4> d_dop{};
+    std::map<int, double> d_range_rates_m_s;  // by RTKLIB satellite number
     rtk_t d_rtk{};
     Monitor_Pvt d_monitor_pvt{};
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Columnar_Dump_Writer d_dump_writer;
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
+    bool d_range_rate_predictions{false};
+    Gnss_Memory_Gauge d_memory_gauge{Gnss_Memory_Subsystem::PVT};
+    Gnss_Memory_Gauge d_snapshot_memory_gauge{Gnss_Memory_Subsystem::Printers};  // copies waiting for the printers
 };
 
 
@@ -74,9 +74,18 @@ public:
 
     inline std::string createProtobuffer(const Monitor_Pvt* const monitor)  //!< Serialization into a string
     {
-        monitor_.Clear();
-
         std::string data;
+        createProtobuffer(monitor, data);
+        return data;
+    }
+
+    /*!
+     * \brief Serialization into data, which keeps its capacity from one call
+     * to the next
+     */
+    inline void createProtobuffer(const Monitor_Pvt* const monitor, std::string& data)
+    {
+        monitor_.Clear();
 
         monitor_.set_tow_at_current_symbol_ms(monitor->TOW_at_current_symbol_ms);
         monitor_.set_week(monitor->week);
@@ -109,7 +118,6 @@ public:
         monitor_.set_user_clk_drift_ppm(monitor->user_clk_drift_ppm);
 
         monitor_.SerializeToString(&data);
-        return data;
     }
 
     inline Monitor_Pvt readProtobuffer(const gnss_sdr::MonitorPvt& mon) const  //!< Deserialization
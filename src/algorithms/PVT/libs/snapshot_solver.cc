@@ -0,0 +1,176 @@
+/*!
+ * \file snapshot_solver.cc
+ * \brief Coarse-time position fix from the code phases of a short capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "snapshot_solver.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, GNSS_OMEGA_EARTH_DOT
+#include <armadillo>
+#include <algorithm>  // for std::min_element
+#include <cmath>      // for std::sqrt, std::round, std::cos, std::sin
+#include <utility>    // for std::move
+
+
+namespace
+{
+constexpr double CODE_PERIOD_M = SPEED_OF_LIGHT_M_S * 1e-3;  // pseudorange ambiguity of the C/A code
+constexpr int MAX_ITERATIONS = 10;
+constexpr int MAX_AMBIGUITY_PASSES = 3;
+}  // namespace
+
+
+Snapshot_Solver::Snapshot_Solver(std::map<int, Gps_Ephemeris> ephemeris) : d_ephemeris(std::move(ephemeris))
+{
+}
+
+
+Snapshot_Solver::Prediction Snapshot_Solver::predict(Gps_Ephemeris& eph, const std::array<double, 3>& position, double rx_time_s) const
+{
+    Prediction prediction;
+    double range = 0.075 * SPEED_OF_LIGHT_M_S;
+    std::array<double, 3> sat{};
+    std::array<double, 3> vel{};
+    for (int i = 0; i < 3; i++)
+        {
+            // satellite at the transmission time, in the ECEF frame of the reception time
+            eph.satellitePosition(rx_time_s - range / SPEED_OF_LIGHT_M_S);
+            const double theta = GNSS_OMEGA_EARTH_DOT * range / SPEED_OF_LIGHT_M_S;
+            sat = {std::cos(theta) * eph.satpos_X + std::sin(theta) * eph.satpos_Y,
+                -std::sin(theta) * eph.satpos_X + std::cos(theta) * eph.satpos_Y,
+                eph.satpos_Z};
+            vel = {std::cos(theta) * eph.satvel_X + std::sin(theta) * eph.satvel_Y,
+                -std::sin(theta) * eph.satvel_X + std::cos(theta) * eph.satvel_Y,
+                eph.satvel_Z};
+            range = std::sqrt((sat[0] - position[0]) * (sat[0] - position[0]) +
+                              (sat[1] - position[1]) * (sat[1] - position[1]) +
+                              (sat[2] - position[2]) * (sat[2] - position[2]));
+        }
+    for (int j = 0; j < 3; j++)
+        {
+            prediction.los[j] = (sat[j] - position[j]) / range;
+            prediction.range_rate_mps += prediction.los[j] * vel[j];
+        }
+    const double sv_clock_s = eph.sv_clock_drift(rx_time_s - range / SPEED_OF_LIGHT_M_S) - eph.TGD;
+    prediction.pseudorange_m = range - SPEED_OF_LIGHT_M_S * sv_clock_s;
+    return prediction;
+}
+
+
+Snapshot_Solver::Solution Snapshot_Solver::solve(const std::vector<Measurement>& measurements, double approx_rx_time_s,
+    const std::array<double, 3>& approx_position_ecef_m)
+{
+    Solution solution;
+    std::vector<Gps_Ephemeris*> ephemeris;
+    std::vector<double> code_delay_m;
+    for (const auto& measurement : measurements)
+        {
+            const auto it = d_ephemeris.find(static_cast<int>(measurement.PRN));
+            if (it != d_ephemeris.end())
+                {
+                    ephemeris.push_back(&it->second);
+                    code_delay_m.push_back(measurement.code_delay_s * SPEED_OF_LIGHT_M_S);
+                }
+        }
+    const size_t n = ephemeris.size();
+    if (n < 5)
+        {
+            return solution;
+        }
+
+    std::array<double, 3> position = approx_position_ecef_m;
+    double rx_time_s = approx_rx_time_s;
+    double clock_bias_m = 0.0;
+    std::vector<Prediction> predictions(n);
+    std::vector<double> pseudoranges(n);
+    bool clock_bias_known = false;
+    arma::mat H(n, 5);
+    arma::vec y(n);
+    for (int pass = 0; pass < MAX_AMBIGUITY_PASSES; pass++)
+        {
+            // whole milliseconds of each pseudorange, from the current estimate
+            for (size_t k = 0; k < n; k++)
+                {
+                    predictions[k] = predict(*ephemeris[k], position, rx_time_s);
+                }
+            if (!clock_bias_known)
+                {
+                    // the nearest satellite fixes the clock bias modulo 1 ms
+                    const auto nearest = static_cast<size_t>(std::min_element(predictions.cbegin(), predictions.cend(), [](const Prediction& a, const Prediction& b) {
+                        return a.pseudorange_m < b.pseudorange_m;
+                    }) - predictions.cbegin());
+                    const double whole = std::round((predictions[nearest].pseudorange_m - code_delay_m[nearest]) / CODE_PERIOD_M);
+                    clock_bias_m = whole * CODE_PERIOD_M + code_delay_m[nearest] - predictions[nearest].pseudorange_m;
+                    clock_bias_known = true;
+                }
+            bool ambiguities_changed = false;
+            for (size_t k = 0; k < n; k++)
+                {
+                    const double pseudorange = std::round((predictions[k].pseudorange_m + clock_bias_m - code_delay_m[k]) / CODE_PERIOD_M) * CODE_PERIOD_M + code_delay_m[k];
+                    ambiguities_changed = ambiguities_changed or pass == 0 or pseudorange != pseudoranges[k];
+                    pseudoranges[k] = pseudorange;
+                }
+            if (!ambiguities_changed)
+                {
+                    break;
+                }
+
+            // position, clock bias and coarse time error
+            solution.valid = false;
+            for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++)
+                {
+                    for (size_t k = 0; k < n; k++)
+                        {
+                            predictions[k] = predict(*ephemeris[k], position, rx_time_s);
+                            H(k, 0) = -predictions[k].los[0];
+                            H(k, 1) = -predictions[k].los[1];
+                            H(k, 2) = -predictions[k].los[2];
+                            H(k, 3) = 1.0;
+                            H(k, 4) = predictions[k].range_rate_mps;
+                            y(k) = pseudoranges[k] - predictions[k].pseudorange_m - clock_bias_m;
+                        }
+                    arma::vec dx;
+                    if (!arma::solve(dx, H, y))
+                        {
+                            return solution;
+                        }
+                    for (int j = 0; j < 3; j++)
+                        {
+                            position[j] += dx(j);
+                        }
+                    clock_bias_m += dx(3);
+                    rx_time_s += dx(4);
+                    if (arma::norm(dx.head(4)) < 1e-4 and std::abs(dx(4)) < 1e-7)
+                        {
+                            solution.valid = true;
+                            break;
+                        }
+                }
+            if (!solution.valid)
+                {
+                    return solution;
+                }
+        }
+
+    double sum = 0.0;
+    for (size_t k = 0; k < n; k++)
+        {
+            const double residual = pseudoranges[k] - predict(*ephemeris[k], position, rx_time_s).pseudorange_m - clock_bias_m;
+            sum += residual * residual;
+        }
+    solution.position_ecef_m = position;
+    solution.rx_time_s = rx_time_s;
+    solution.clock_bias_m = clock_bias_m;
+    solution.residual_rms_m = std::sqrt(sum / static_cast<double>(n));
+    solution.satellites = static_cast<uint32_t>(n);
+    return solution;
+}
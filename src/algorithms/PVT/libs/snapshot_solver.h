@@ -0,0 +1,93 @@
+/*!
+ * \file snapshot_solver.h
+ * \brief Coarse-time position fix from the code phases of a short capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SNAPSHOT_SOLVER_H
+#define GNSS_SDR_SNAPSHOT_SOLVER_H
+
+#include "gps_ephemeris.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Position and time from a snapshot of a few milliseconds of GPS L1
+ * C/A signal, without tracking nor navigation message decoding.
+ *
+ * The acquisition only gives the code phase of each satellite, that is, its
+ * pseudorange modulo one code period (1 ms, about 300 km). The whole
+ * milliseconds are rebuilt from the ranges predicted with the ephemeris at
+ * an approximate position and time, which must be good to about 100 km and
+ * a minute. The coarse time error is then solved as a fifth unknown, along
+ * with the position and the clock bias, since the satellites move by up to
+ * 800 m/s along the line of sight (coarse-time navigation, F. van Diggelen,
+ * A-GPS: Assisted GPS, GNSS, and SBAS, Artech House, 2009, chapter 4).
+ * This needs at least five satellites.
+ */
+class Snapshot_Solver
+{
+public:
+    class Measurement
+    {
+    public:
+        uint32_t PRN{0};
+        double code_delay_s{0.0};  //!< Time from the reference sample of the capture to the next start of the code [s], in [0, 1 ms)
+    };
+
+    class Solution
+    {
+    public:
+        std::array<double, 3> position_ecef_m{};  //!< Receiver position, ECEF [m]
+        double rx_time_s{0.0};                    //!< GPS time of week of the reference sample [s]
+        double clock_bias_m{0.0};                 //!< Receiver clock bias, modulo 1 ms [m]
+        double residual_rms_m{0.0};               //!< RMS of the pseudorange residuals [m]
+        uint32_t satellites{0};                   //!< Satellites used in the fix
+        bool valid{false};
+    };
+
+    explicit Snapshot_Solver(std::map<int, Gps_Ephemeris> ephemeris);
+
+    /*!
+     * \brief Solves the fix from the measurements of the satellites with
+     * ephemeris. approx_rx_time_s is the GPS time of week of the reference
+     * sample, and approx_position_ecef_m the a priori position.
+     */
+    Solution solve(const std::vector<Measurement>& measurements, double approx_rx_time_s,
+        const std::array<double, 3>& approx_position_ecef_m);
+
+private:
+    class Prediction
+    {
+    public:
+        std::array<double, 3> los{};  // unit vector from the receiver to the satellite
+        double pseudorange_m{0.0};    // geometric range minus the satellite clock correction
+        double range_rate_mps{0.0};
+    };
+
+    Prediction predict(Gps_Ephemeris& eph, const std::array<double, 3>& position, double rx_time_s) const;
+
+    std::map<int, Gps_Ephemeris> d_ephemeris;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SNAPSHOT_SOLVER_H
@@ -166,6 +166,8 @@ GalileoE1PcpsAmbiguousAcquisitionFpga::GalileoE1PcpsAmbiguousAcquisitionFpga(
         }
 
     acq_parameters.all_fft_codes = d_all_fft_codes_.data();
+    acq_parameters.pipelined = configuration->property(role + ".pipelined", false);
+    acq_parameters.code_banks = configuration->property(role + ".code_banks", 1);
 
     acq_parameters.num_doppler_bins_step2 = configuration->property(role + ".second_nbins", 4);
     acq_parameters.doppler_step2 = configuration->property(role + ".second_doppler_step", static_cast<float>(125.0));
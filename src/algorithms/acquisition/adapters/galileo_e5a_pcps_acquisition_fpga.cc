@@ -169,6 +169,8 @@ GalileoE5aPcpsAcquisitionFpga::GalileoE5aPcpsAcquisitionFpga(
         }
 
     acq_parameters.all_fft_codes = d_all_fft_codes_.data();
+    acq_parameters.pipelined = configuration->property(role + ".pipelined", false);
+    acq_parameters.code_banks = configuration->property(role + ".code_banks", 1);
 
     // reference for the FPGA FFT-IFFT attenuation factor
     acq_parameters.total_block_exp = configuration->property(role + ".total_block_exp", 13);
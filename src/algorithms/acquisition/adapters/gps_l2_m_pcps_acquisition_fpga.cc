@@ -140,6 +140,8 @@ GpsL2MPcpsAcquisitionFpga::GpsL2MPcpsAcquisitionFpga(
         }
 
     acq_parameters.all_fft_codes = d_all_fft_codes_.data();
+    acq_parameters.pipelined = configuration->property(role + ".pipelined", false);
+    acq_parameters.code_banks = configuration->property(role + ".code_banks", 1);
 
     acquisition_fpga_ = pcps_make_acquisition_fpga(acq_parameters);
 
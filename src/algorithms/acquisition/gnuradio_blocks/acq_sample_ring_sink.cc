@@ -0,0 +1,43 @@
+/*!
+ * \file acq_sample_ring_sink.cc
+ * \brief Writes a stream into an Acq_Sample_Ring shared by several
+ * acquisition channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sample_ring_sink.h"
+#include <gnuradio/io_signature.h>
+#include <utility>
+
+
+acq_sample_ring_sink_sptr make_acq_sample_ring_sink(std::shared_ptr<Acq_Sample_Ring> ring)
+{
+    return acq_sample_ring_sink_sptr(new acq_sample_ring_sink(std::move(ring)));
+}
+
+
+acq_sample_ring_sink::acq_sample_ring_sink(std::shared_ptr<Acq_Sample_Ring> ring)
+    : gr::sync_block("acq_sample_ring_sink",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(0, 0, 0)),
+      d_ring(std::move(ring))
+{
+}
+
+
+int acq_sample_ring_sink::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    d_ring->write(reinterpret_cast<const gr_complex*>(input_items[0]), noutput_items);
+    return noutput_items;
+}
@@ -0,0 +1,64 @@
+/*!
+ * \file acq_sample_ring_sink.h
+ * \brief Writes a stream into an Acq_Sample_Ring shared by several
+ * acquisition channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SAMPLE_RING_SINK_H
+#define GNSS_SDR_ACQ_SAMPLE_RING_SINK_H
+
+#include "acq_sample_ring.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <memory>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup Acq_gnuradio_blocks
+ * \{ */
+
+
+class acq_sample_ring_sink;
+
+using acq_sample_ring_sink_sptr = gnss_shared_ptr<acq_sample_ring_sink>;
+
+acq_sample_ring_sink_sptr make_acq_sample_ring_sink(std::shared_ptr<Acq_Sample_Ring> ring);
+
+/*!
+ * \brief Copies its input once into the ring, where the acquisition channels
+ * connected to the same stream take their snapshots from.
+ *
+ * The sample stamps of the ring are the number of items read by this block,
+ * so it has to be connected from the start, to the same output as the
+ * acquisition blocks.
+ */
+class acq_sample_ring_sink : public gr::sync_block
+{
+public:
+    ~acq_sample_ring_sink() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend acq_sample_ring_sink_sptr make_acq_sample_ring_sink(std::shared_ptr<Acq_Sample_Ring> ring);
+    explicit acq_sample_ring_sink(std::shared_ptr<Acq_Sample_Ring> ring);
+
+    std::shared_ptr<Acq_Sample_Ring> d_ring;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SAMPLE_RING_SINK_H
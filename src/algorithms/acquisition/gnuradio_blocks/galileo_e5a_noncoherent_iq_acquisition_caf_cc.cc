@@ -27,11 +27,36 @@
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <exception>
 #include <sstream>
 
 
+namespace
+{
+// Splits the spectrum z of a + jb, where a and b are real, into the
+// conjugated spectra of a and b
+void split_conjugate_spectra(const gr_complex *z, gr_complex *a, gr_complex *b, int n)
+{
+    for (int k = 0; k < n; k++)
+        {
+            const gr_complex z_k = std::conj(z[k]);
+            const gr_complex z_minus_k = z[(n - k) % n];
+            a[k] = 0.5F * (z_k + z_minus_k);
+            b[k] = gr_complex(0.0F, 0.5F) * (z_k - z_minus_k);
+        }
+}
+
+
+bool is_real(const gr_complex *x, int n)
+{
+    return std::all_of(x, x + n, [](const gr_complex &sample) { return sample.imag() == 0.0F; });
+}
+}  // namespace
+
+
 galileo_e5a_noncoherentIQ_acquisition_caf_cc_sptr galileo_e5a_noncoherentIQ_make_acquisition_caf_cc(
     unsigned int sampled_ms,
     unsigned int max_dwells,
@@ -158,51 +183,52 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::~galileo_e5a_noncoherentIQ_acquisi
 
 void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_local_code(std::complex<float> *codeI, std::complex<float> *codeQ)
 {
-    // DATA SIGNAL
-    // Three replicas of data primary code. CODE A: (1,1,1)
-    memcpy(d_fft_if->get_inbuf(), codeI, sizeof(gr_complex) * d_fft_size);
+    // DATA AND PILOT SIGNALS
+    // Three replicas of the primary codes. CODE A: (1,1,1)
+    code_spectra(codeI, codeQ, 0, d_fft_code_I_A.data(), d_both_signal_components ? d_fft_code_Q_A.data() : nullptr);
 
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_I_A.data(), d_fft_if->get_outbuf(), d_fft_size);
-
-    // SAME FOR PILOT SIGNAL
-    if (d_both_signal_components == true)
-        {
-            // Three replicas of pilot primary code. CODE A: (1,1,1)
-            memcpy(d_fft_if->get_inbuf(), codeQ, sizeof(gr_complex) * d_fft_size);
-
-            d_fft_if->execute();  // We need the FFT of local code
-
-            // Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_Q_A.data(), d_fft_if->get_outbuf(), d_fft_size);
-        }
     // IF INTEGRATION TIME > 1 code, we need to evaluate the other possible combination
     // Note: max integration time allowed = 3ms (dealt in adapter)
     if (d_sampled_ms > 1)
         {
-            // DATA CODE B: First replica is inverted (0,1,1)
-            volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
-                &codeI[0], gr_complex(-1, 0),
-                d_samples_per_code);
-
-            d_fft_if->execute();  // We need the FFT of local code
+            // CODE B: First replica is inverted (0,1,1)
+            code_spectra(codeI, codeQ, d_samples_per_code, d_fft_code_I_B.data(), d_both_signal_components ? d_fft_code_Q_B.data() : nullptr);
+        }
+}
 
-            // Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_I_B.data(), d_fft_if->get_outbuf(), d_fft_size);
 
-            if (d_both_signal_components == true)
+void galileo_e5a_noncoherentIQ_acquisition_caf_cc::code_spectra(const gr_complex *codeI, const gr_complex *codeQ,
+    int inverted_samples, gr_complex *fft_code_I, gr_complex *fft_code_Q)
+{
+    gr_complex *fft_in = d_fft_if->get_inbuf();
+    if (fft_code_Q != nullptr and is_real(codeI, d_fft_size) and is_real(codeQ, d_fft_size))
+        {
+            // Real data and pilot codes: a single FFT of codeI + j codeQ
+            // gives both spectra
+            for (int i = 0; i < d_fft_size; i++)
                 {
-                    // PILOT CODE B: First replica is inverted (0,1,1)
-                    volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
-                        &codeQ[0], gr_complex(-1, 0),
-                        d_samples_per_code);
-                    d_fft_if->execute();  // We need the FFT of local code
-
-                    // Conjugate the local code
-                    volk_32fc_conjugate_32fc(d_fft_code_Q_B.data(), d_fft_if->get_outbuf(), d_fft_size);
+                    fft_in[i] = gr_complex(codeI[i].real(), codeQ[i].real());
                 }
+            volk_32fc_s32fc_multiply_32fc(fft_in, fft_in, gr_complex(-1, 0), inverted_samples);
+            d_fft_if->execute();
+            split_conjugate_spectra(d_fft_if->get_outbuf(), fft_code_I, fft_code_Q, d_fft_size);
+            return;
+        }
+
+    memcpy(fft_in, codeI, sizeof(gr_complex) * d_fft_size);
+    volk_32fc_s32fc_multiply_32fc(fft_in, fft_in, gr_complex(-1, 0), inverted_samples);
+    d_fft_if->execute();  // We need the FFT of local code
+
+    // Conjugate the local code
+    volk_32fc_conjugate_32fc(fft_code_I, d_fft_if->get_outbuf(), d_fft_size);
+
+    // SAME FOR PILOT SIGNAL
+    if (fft_code_Q != nullptr)
+        {
+            memcpy(fft_in, codeQ, sizeof(gr_complex) * d_fft_size);
+            volk_32fc_s32fc_multiply_32fc(fft_in, fft_in, gr_complex(-1, 0), inverted_samples);
+            d_fft_if->execute();
+            volk_32fc_conjugate_32fc(fft_code_Q, d_fft_if->get_outbuf(), d_fft_size);
         }
 }
 
@@ -250,6 +276,26 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::init()
                 {
                     d_CAF_vector_Q = std::vector<float>(d_num_doppler_bins);
                 }
+
+            // Triangular window, and inverse of the sum of its weights inside
+            // the grid, which is smaller at both ends
+            const int CAF_bins_half = std::min(d_CAF_window_hz / (2 * d_doppler_step), d_num_doppler_bins - 1);
+            const float weighting_factor = CAF_bins_half > 0 ? 0.5F / static_cast<float>(CAF_bins_half) : 0.0F;
+            d_CAF_taps = std::vector<float>(2 * CAF_bins_half + 1);
+            for (int k = -CAF_bins_half; k <= CAF_bins_half; k++)
+                {
+                    d_CAF_taps[k + CAF_bins_half] = 1.0F - weighting_factor * static_cast<float>(std::abs(k));
+                }
+            d_CAF_normalization = std::vector<float>(d_num_doppler_bins);
+            for (int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                {
+                    float weights = 0.0F;
+                    for (int i = std::max(0, doppler_index - CAF_bins_half); i <= std::min(d_num_doppler_bins - 1, doppler_index + CAF_bins_half); i++)
+                        {
+                            weights += d_CAF_taps[i - doppler_index + CAF_bins_half];
+                        }
+                    d_CAF_normalization[doppler_index] = 1.0F / weights;
+                }
         }
 }
 
@@ -278,6 +324,25 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_state(int state)
 }
 
 
+void galileo_e5a_noncoherentIQ_acquisition_caf_cc::filter_CAF()
+{
+    // The filter is linear, so the data and pilot peaks are filtered together
+    if (d_both_signal_components)
+        {
+            volk_32f_x2_add_32f(d_CAF_vector_I.data(), d_CAF_vector_I.data(), d_CAF_vector_Q.data(), d_num_doppler_bins);
+        }
+    const int CAF_bins_half = static_cast<int>(d_CAF_taps.size() / 2);
+    for (int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            const int first = std::max(0, doppler_index - CAF_bins_half);
+            const int last = std::min(d_num_doppler_bins - 1, doppler_index + CAF_bins_half);
+            volk_32f_x2_dot_prod_32f(&d_CAF_vector[doppler_index], &d_CAF_vector_I[first],
+                &d_CAF_taps[first - doppler_index + CAF_bins_half], last - first + 1);
+        }
+    volk_32f_x2_multiply_32f(d_CAF_vector.data(), d_CAF_vector.data(), d_CAF_normalization.data(), d_num_doppler_bins);
+}
+
+
 int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
@@ -441,7 +506,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                         d_ifft->execute();
                                         volk_32fc_magnitude_squared_32f(d_magnitudeQB.data(), d_ifft->get_outbuf(), d_fft_size);
                                         volk_gnsssdr_32f_index_max_32u(&indext_QB, d_magnitudeQB.data(), d_fft_size);
-                                        magt_QB = d_magnitudeIB[indext_QB] / (fft_normalization_factor * fft_normalization_factor);
+                                        magt_QB = d_magnitudeQB[indext_QB] / (fft_normalization_factor * fft_normalization_factor);
                                     }
                             }
 
@@ -466,10 +531,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                                             }
-                                                        for (int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIA.data(), d_magnitudeIA.data(), d_magnitudeQA.data(), d_fft_size);
                                                     }
                                                 else
                                                     {
@@ -477,10 +539,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
                                                             }
-                                                        for (int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQB[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIA.data(), d_magnitudeIA.data(), d_magnitudeQB.data(), d_fft_size);
                                                     }
                                             }
                                         volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA.data(), d_fft_size);
@@ -501,10 +560,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                                             }
-                                                        for (int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQA[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIB.data(), d_magnitudeIB.data(), d_magnitudeQA.data(), d_fft_size);
                                                     }
                                                 else
                                                     {
@@ -512,10 +568,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
                                                             }
-                                                        for (int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQB[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIB.data(), d_magnitudeIB.data(), d_magnitudeQB.data(), d_fft_size);
                                                     }
                                             }
                                         volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIB.data(), d_fft_size);
@@ -535,10 +588,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                             }
                                         // NON-Coherent integration of only 1 code
-                                        for (int i = 0; i < d_fft_size; i++)
-                                            {
-                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                            }
+                                        volk_32f_x2_add_32f(d_magnitudeIA.data(), d_magnitudeIA.data(), d_magnitudeQA.data(), d_fft_size);
                                     }
                                 volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA.data(), d_fft_size);
                                 magt = d_magnitudeIA[indext] / (fft_normalization_factor * fft_normalization_factor);
@@ -597,73 +647,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                 // 6 OPTIONAL: CAF filter to avoid Doppler ambiguity in bit transition.
                 if (d_CAF_window_hz > 0)
                     {
-                        int CAF_bins_half;
-                        std::array<float, 1> accum{};
-                        CAF_bins_half = d_CAF_window_hz / (2 * d_doppler_step);
-                        float weighting_factor;
-                        weighting_factor = 0.5F / static_cast<float>(CAF_bins_half);
-                        // weighting_factor = 0;
-                        // std::cout << "weighting_factor " << weighting_factor << '\n';
-                        // Initialize first iterations
-                        for (int doppler_index = 0; doppler_index < CAF_bins_half; doppler_index++)
-                            {
-                                d_CAF_vector[doppler_index] = 0;
-                                for (int i = 0; i < CAF_bins_half + doppler_index + 1; i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1.0F - weighting_factor * static_cast<float>((doppler_index - i)));
-                                    }
-                                d_CAF_vector[doppler_index] /= static_cast<float>(1.0F + static_cast<float>(CAF_bins_half + doppler_index) - weighting_factor * static_cast<float>(CAF_bins_half) * ((static_cast<float>(CAF_bins_half) + 1.0F) / 2.0F) - weighting_factor * static_cast<float>(doppler_index) * (static_cast<float>(doppler_index) + 1.0F) / 2.0F);  // triangles = [n*(n+1)/2]
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        for (int i = 0; i < CAF_bins_half + doppler_index + 1; i++)
-                                            {
-                                                accum[0] += static_cast<float>(d_CAF_vector_Q[i] * (1.0F - weighting_factor * static_cast<float>(abs(doppler_index - i))));
-                                            }
-                                        accum[0] /= static_cast<float>(1.0F + static_cast<float>(CAF_bins_half + doppler_index) - weighting_factor * static_cast<float>(CAF_bins_half) * static_cast<float>(CAF_bins_half + 1) / 2.0F - weighting_factor * static_cast<float>(doppler_index) * static_cast<float>(doppler_index + 1) / 2.0F);  // triangles = [n*(n+1)/2]
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
-                            }
-                        // Body loop
-                        for (int doppler_index = CAF_bins_half; doppler_index < d_num_doppler_bins - CAF_bins_half; doppler_index++)
-                            {
-                                d_CAF_vector[doppler_index] = 0;
-                                for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(doppler_index + CAF_bins_half + 1); i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1.0F - weighting_factor * static_cast<float>((doppler_index - i)));
-                                    }
-                                d_CAF_vector[doppler_index] /= static_cast<float>(1.0F + 2.0F * static_cast<float>(CAF_bins_half) - 2.0F * weighting_factor * static_cast<float>(CAF_bins_half) * static_cast<float>(CAF_bins_half + 1) / 2.0F);
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(doppler_index + CAF_bins_half + 1); i++)
-                                            {
-                                                accum[0] += static_cast<float>(d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<float>((doppler_index - i))));
-                                            }
-                                        accum[0] /= static_cast<float>(1.0F + 2.0F * static_cast<float>(CAF_bins_half) - 2.0F * weighting_factor * static_cast<float>(CAF_bins_half) * static_cast<float>(CAF_bins_half + 1) / 2.0F);
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
-                            }
-                        // Final iterations
-                        for (int doppler_index = d_num_doppler_bins - CAF_bins_half; doppler_index < static_cast<int>(d_num_doppler_bins); doppler_index++)
-                            {
-                                d_CAF_vector[doppler_index] = 0;
-                                for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(d_num_doppler_bins); i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1.0F - weighting_factor * static_cast<float>(abs(doppler_index - i)));
-                                    }
-                                d_CAF_vector[doppler_index] /= static_cast<float>(1.0F + static_cast<float>(CAF_bins_half) + static_cast<float>(d_num_doppler_bins - doppler_index - 1) - weighting_factor * static_cast<float>(CAF_bins_half) * (static_cast<float>(CAF_bins_half) + 1.0F) / 2.0F - weighting_factor * static_cast<float>(d_num_doppler_bins - doppler_index - 1) * static_cast<float>(d_num_doppler_bins - doppler_index) / 2.0F);
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(d_num_doppler_bins); i++)
-                                            {
-                                                accum[0] += static_cast<float>(d_CAF_vector_Q[i] * (1.0F - weighting_factor * static_cast<float>(abs(doppler_index - i))));
-                                            }
-                                        accum[0] /= static_cast<float>(1.0F + static_cast<float>(CAF_bins_half) + static_cast<float>(d_num_doppler_bins - doppler_index - 1) - weighting_factor * static_cast<float>(CAF_bins_half) * static_cast<float>(CAF_bins_half + 1.0) / 2.0 - weighting_factor * static_cast<float>(d_num_doppler_bins - doppler_index - 1) * static_cast<float>(d_num_doppler_bins - doppler_index) / 2.0);
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
-                            }
+                        filter_CAF();
 
                         // Recompute the maximum doppler peak
                         volk_gnsssdr_32f_index_max_32u(&indext, d_CAF_vector.data(), d_num_doppler_bins);
@@ -201,6 +201,11 @@ private:
     void calculate_magnitudes(gr_complex* fft_begin, int doppler_shift,
         int doppler_offset);
 
+    void code_spectra(const gr_complex* codeI, const gr_complex* codeQ,
+        int inverted_samples, gr_complex* fft_code_I, gr_complex* fft_code_Q);
+
+    void filter_CAF();
+
     float estimate_input_power(gr_complex* in);
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
@@ -220,6 +225,8 @@ private:
     std::vector<float> d_CAF_vector;
     std::vector<float> d_CAF_vector_I;
     std::vector<float> d_CAF_vector_Q;
+    std::vector<float> d_CAF_taps;           // triangular window of the CAF filter
+    std::vector<float> d_CAF_normalization;  // inverse of the weights of the window inside the grid
 
     std::string d_satellite_str;
     std::string d_dump_filename;
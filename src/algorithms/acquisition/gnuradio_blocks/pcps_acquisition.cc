@@ -23,8 +23,14 @@
 #include "GLONASS_L1_L2_CA.h"  // for GLONASS_PRN
 #include "MATH_CONSTANTS.h"    // for TWO_PI
 #include "gnss_frequencies.h"
+#include "gnss_sdr_async_log.h"
+#include "gnss_sdr_block_stats.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_device_scheduler.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include "gnss_sdr_thread_pool.h"
+#include "gnss_sdr_trace.h"
 #include "gnss_synchro.h"
 #include <boost/math/special_functions/gamma.hpp>
 #include <gnuradio/io_signature.h>
@@ -33,14 +39,35 @@
 #include <pmt/pmt_sugar.h>  // for mp
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n, min
+#include <algorithm>  // for fill_n, min, max
 #include <array>
 #include <cmath>    // for floor, fmod, rint, ceil
+#include <cstdlib>  // for abs
 #include <cstring>  // for memcpy
 #include <iostream>
 #include <map>
 
 
+namespace
+{
+// In the fixed-point search, input samples are scaled to 8 bits and the
+// carrier wipe-off signals have an amplitude of 127, so the real and
+// imaginary parts of their product always fit in 16 bits.
+const int32_t FXP_MAX_INPUT_AMPLITUDE = 127;
+const float FXP_CARRIER_AMPLITUDE = 127.0;
+
+
+int16_t fxp_scale(int16_t value, int32_t shift)
+{
+    if (shift == 0)
+        {
+            return value;
+        }
+    return static_cast<int16_t>((static_cast<int32_t>(value) + (1 << (shift - 1))) >> shift);
+}
+}  // namespace
+
+
 pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
 {
     return pcps_acquisition_sptr(new pcps_acquisition(conf_));
@@ -56,6 +83,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_dump_filename(conf_.dump_filename),
       d_dump_number(0LL),
       d_sample_counter(0ULL),
+      d_batch_stamp(0ULL),
       d_threshold(0.0),
       d_mag(0),
       d_input_power(0.0),
@@ -65,6 +93,8 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_positive_acq(0),
       d_doppler_center(0U),
       d_doppler_bias(0),
+      d_standby_items(0),
+      d_gpu_device(0),
       d_channel(0U),
       d_samplesPerChip(conf_.samples_per_chip),
       d_doppler_step(conf_.doppler_step),
@@ -76,10 +106,20 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_buffer_count(0U),
       d_active(false),
       d_worker_active(false),
+      d_worker_queued(false),
       d_step_two(false),
       d_use_CFAR_algorithm_flag(conf_.use_CFAR_algorithm_flag),
-      d_dump(conf_.dump)
+      d_dump(conf_.dump),
+      d_batch_announced(false),
+      d_compact_grid(false),
+      d_bin_statistics_ready(false),
+      d_folding_factor(1U),
+      d_effective_fft_size(0U),
+      d_buffers_allocated(false),
+      d_dump_paused(false)
 {
+    d_work_stats = Gnss_Block_Stats_Registry::instance().make(unique_id());
+
     this->message_port_register_out(pmt::mp("events"));
 
     if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
@@ -92,6 +132,24 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
         }
     // d_fft_size = next power of two?  ////
 
+    // The folding search correlates F = folding_factor blocks of d_fft_size / F
+    // samples added together, and then solves the F-fold code phase ambiguity
+    d_folding_factor = d_acq_parameters.folding_factor;
+    if ((d_folding_factor > 1) and (d_fft_size % d_folding_factor != 0))
+        {
+            LOG(WARNING) << "The FFT size (" << d_fft_size << ") is not a multiple of the folding factor "
+                         << d_folding_factor << ". Using the full search strategy";
+            d_folding_factor = 1;
+        }
+    if (d_acq_parameters.bit_transition_flag)
+        {
+            d_effective_fft_size = d_fft_size / 2;
+        }
+    else
+        {
+            d_effective_fft_size = d_fft_size / d_folding_factor;
+        }
+
     // COD:
     // Experimenting with the overlap/save technique for handling bit trannsitions
     // The problem: Circular correlation is asynchronous with the received code.
@@ -108,11 +166,9 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     //  d_acq_parameters.max_dwells = 1;  // Activation of d_acq_parameters.bit_transition_flag invalidates the value of d_acq_parameters.max_dwells
     // }
 
-    d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
-    d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    // The work buffers, the search grid and the FFT plans are created when the
+    // first signal is assigned to the channel (see allocate_buffers()), so that
+    // channels in standby do not delay the startup of the receiver.
 
     d_grid = arma::fmat();
     d_narrow_grid = arma::fmat();
@@ -163,6 +219,63 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
                     d_dump = false;
                 }
         }
+
+    if ((d_acq_parameters.compute_backend != Gnss_Compute_Backend::CPU) and !d_acq_parameters.batch_acquisition)
+        {
+            try
+                {
+                    d_gpu_engine = Acq_Gpu_Engine::make(d_acq_parameters.compute_backend, d_gpu_device, d_fft_size, d_effective_fft_size, d_acq_parameters.bit_transition_flag ? d_effective_fft_size : 0U);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Acquisition channel " << d_channel << " cannot use the " << compute_backend_to_string(d_acq_parameters.compute_backend)
+                                 << " device, searching in the CPU: " << e.what();
+                    d_acq_parameters.compute_backend = Gnss_Compute_Backend::CPU;
+                }
+        }
+
+    // The full search grid is only required for dumping it, for accumulating
+    // non-coherent dwells, and by the batch and GPU engines. Otherwise, only the
+    // peak and noise statistics of each Doppler bin are kept.
+    d_compact_grid = !d_dump and !d_acq_parameters.batch_acquisition and (d_acq_parameters.compute_backend == Gnss_Compute_Backend::CPU) and
+                     ((d_acq_parameters.max_dwells <= 1) or d_acq_parameters.bit_transition_flag);
+}
+
+
+pcps_acquisition::~pcps_acquisition()
+{
+    // A search running in the worker pool still needs this object
+    std::unique_lock<std::mutex> lock(d_worker_mutex);
+    d_worker_cv.wait(lock, [this] { return !d_worker_queued; });
+}
+
+
+void pcps_acquisition::set_channel(uint32_t channel)
+{
+    d_channel = channel;
+    const int device = Gnss_Device_Scheduler::instance().device(static_cast<int>(channel));
+    if (device == d_gpu_device)
+        {
+            return;
+        }
+    d_gpu_device = device;
+    if (d_gpu_engine)
+        {
+            try
+                {
+                    d_gpu_engine = Acq_Gpu_Engine::make(d_acq_parameters.compute_backend, d_gpu_device, d_fft_size, d_effective_fft_size, d_acq_parameters.bit_transition_flag ? d_effective_fft_size : 0U);
+                    if (d_num_doppler_bins > 0 and d_grid_doppler_wipeoffs.size() >= d_num_doppler_bins)
+                        {
+                            d_gpu_engine->set_doppler_wipeoffs(d_grid_doppler_wipeoffs, d_num_doppler_bins);
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Acquisition channel " << d_channel << " cannot use GPU " << d_gpu_device << ", searching in the CPU: " << e.what();
+                    d_gpu_engine.reset();
+                    d_acq_parameters.compute_backend = Gnss_Compute_Backend::CPU;
+                }
+        }
 }
 
 
@@ -175,6 +288,7 @@ void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 
 void pcps_acquisition::set_local_code(std::complex<float>* code)
 {
+    allocate_buffers();
     // This will check if it's fdma, if yes will update the intermediate frequency and the doppler grid
     if (is_fdma())
         {
@@ -185,27 +299,54 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    uint32_t code_offset = 0U;
+    uint32_t code_length = d_consumed_samples;
     if (d_acq_parameters.bit_transition_flag)
         {
-            const int32_t offset = d_fft_size / 2;
-            std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
-            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
+            code_offset = d_fft_size / 2;
+            code_length = d_fft_size / 2;
         }
-    else
+    else if (d_acq_parameters.sampled_ms != d_acq_parameters.ms_per_code)
+        {
+            code_offset = d_fft_size - d_consumed_samples;
+        }
+
+    const int64_t fs = d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in;
+    // In the folding search, the spectrum is the one of the folded code
+    const uint32_t fft_size = (d_folding_factor > 1 ? d_effective_fft_size : d_fft_size);
+    if (d_folding_factor > 1)
+        {
+            memcpy(d_local_code.data(), code, sizeof(gr_complex) * d_fft_size);
+        }
+    const Acq_Fft_Code_Cache::Key key(d_gnss_synchro->Signal, d_gnss_synchro->PRN, fs, fft_size, code_offset, code, code_length);
+    Acq_Fft_Code_Cache::fft_code_sptr fft_codes = Acq_Fft_Code_Cache::instance().find(key);
+    if (!fft_codes)
         {
-            if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
+            auto fft_if = Gnss_Fft_Plan_Pool::instance().get_fwd(fft_size);
+            if (d_folding_factor > 1)
                 {
-                    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_consumed_samples);
+                    memcpy(fft_if->get_inbuf(), code, sizeof(gr_complex) * fft_size);
+                    for (uint32_t block = 1; block < d_folding_factor; block++)
+                        {
+                            volk_32f_x2_add_32f(reinterpret_cast<float*>(fft_if->get_inbuf()), reinterpret_cast<float*>(fft_if->get_inbuf()), reinterpret_cast<const float*>(code + block * fft_size), 2 * fft_size);
+                        }
                 }
             else
                 {
-                    std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
-                    memcpy(d_fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
+                    std::fill_n(fft_if->get_inbuf(), code_offset, gr_complex(0.0, 0.0));
+                    memcpy(fft_if->get_inbuf() + code_offset, code, sizeof(gr_complex) * code_length);
                 }
+            fft_if->execute();  // We need the FFT of local code
+            auto new_fft_codes = std::make_shared<volk_gnsssdr::vector<std::complex<float>>>(fft_size);
+            volk_32fc_conjugate_32fc(new_fft_codes->data(), fft_if->get_outbuf(), fft_size);
+            fft_codes = Acq_Fft_Code_Cache::instance().insert(key, new_fft_codes);
         }
-
-    d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    else
+        {
+            DLOG(INFO) << "Channel " << d_channel << " reusing the code spectrum of satellite "
+                       << d_gnss_synchro->System << " " << d_gnss_synchro->PRN;
+        }
+    d_fft_codes = std::move(fft_codes);
 }
 
 
@@ -259,10 +400,88 @@ void pcps_acquisition::init()
     d_mag = 0.0;
     d_input_power = 0.0;
 
-    d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
+    if (d_buffers_allocated)
+        {
+            allocate_doppler_grid();
+            update_grid_doppler_wipeoffs();
+        }
+    else
+        {
+            // The grid is allocated with the first signal, but its size is
+            // already needed by the threshold
+            d_num_doppler_bins = compute_num_doppler_bins();
+        }
+    d_worker_active = false;
+}
+
+
+uint32_t pcps_acquisition::compute_num_doppler_bins() const
+{
+    return static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
+}
+
+
+void pcps_acquisition::allocate_buffers()
+{
+    if (d_buffers_allocated)
+        {
+            return;
+        }
+    d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
+    if (d_acq_parameters.threads > 1)
+        {
+            d_tmp_buffers = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_acq_parameters.threads, volk_gnsssdr::vector<float>(d_fft_size));
+        }
+    if (d_acq_parameters.fixed_point)
+        {
+            d_input_signal_sc = volk_gnsssdr::vector<lv_16sc_t>(d_fft_size);
+            d_tmp_buffer_sc = volk_gnsssdr::vector<lv_16sc_t>(d_fft_size);
+            if (d_acq_parameters.threads > 1)
+                {
+                    d_tmp_buffers_sc = volk_gnsssdr::vector<volk_gnsssdr::vector<lv_16sc_t>>(d_acq_parameters.threads, volk_gnsssdr::vector<lv_16sc_t>(d_fft_size));
+                }
+        }
+    d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+    if (d_folding_factor > 1)
+        {
+            d_local_code = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+        }
+
+    // FFT plans are leased from a process-wide pool only while in use, so idle
+    // channels do not hold duplicated plans. Only the first channel of each
+    // FFT size pays for the planning.
+    Gnss_Fft_Plan_Pool::instance().get_fwd(d_fft_size);
+    Gnss_Fft_Plan_Pool::instance().get_rev(d_fft_size);
+    if (d_folding_factor > 1)
+        {
+            Gnss_Fft_Plan_Pool::instance().get_fwd(d_effective_fft_size);
+            Gnss_Fft_Plan_Pool::instance().get_rev(d_effective_fft_size);
+        }
+
+    d_buffers_allocated = true;
+    allocate_doppler_grid();
+    update_grid_doppler_wipeoffs();
+    DLOG(INFO) << "Channel " << d_channel << " acquisition buffers allocated";
+}
+
+
+void pcps_acquisition::allocate_doppler_grid()
+{
+    d_num_doppler_bins = compute_num_doppler_bins();
+
+    // Buffers are only reallocated if the grid grows. The search in step two
+    // also uses the first rows of the magnitude grid.
+    const uint32_t num_rows = std::max(d_num_doppler_bins, d_num_doppler_bins_step2);
 
     // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
+    if (d_acq_parameters.fixed_point)
+        {
+            if (d_grid_doppler_wipeoffs_sc.size() < d_num_doppler_bins)
+                {
+                    d_grid_doppler_wipeoffs_sc = volk_gnsssdr::vector<volk_gnsssdr::vector<lv_16sc_t>>(d_num_doppler_bins, volk_gnsssdr::vector<lv_16sc_t>(d_fft_size));
+                }
+        }
+    else if (d_grid_doppler_wipeoffs.size() < d_num_doppler_bins)
         {
             d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
@@ -271,34 +490,90 @@ void pcps_acquisition::init()
             d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
 
-    if (d_magnitude_grid.empty())
+    // The statistics of each bin are also kept with the full grid, where they
+    // are computed as each bin is accumulated
+    if (d_bin_statistics.size() < num_rows)
         {
-            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_num_doppler_bins, volk_gnsssdr::vector<float>(d_fft_size));
+            d_bin_statistics = std::vector<Bin_Statistics>(num_rows);
         }
-
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    if (!d_compact_grid)
         {
-            std::fill(d_magnitude_grid[doppler_index].begin(), d_magnitude_grid[doppler_index].end(), 0.0);
-        }
+            if (d_magnitude_grid.size() < num_rows)
+                {
+                    d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(num_rows, volk_gnsssdr::vector<float>(d_fft_size));
+                }
 
-    update_grid_doppler_wipeoffs();
-    d_worker_active = false;
+            for (auto& magnitude : d_magnitude_grid)
+                {
+                    std::fill(magnitude.begin(), magnitude.end(), 0.0);
+                }
+        }
 
     if (d_dump)
         {
-            const uint32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
+            const uint32_t effective_fft_size = d_effective_fft_size;
             d_grid = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
             d_narrow_grid = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
         }
 }
 
 
+void pcps_acquisition::set_doppler_max(uint32_t doppler_max)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    if (static_cast<int32_t>(doppler_max) == d_acq_parameters.doppler_max)
+        {
+            return;
+        }
+    d_acq_parameters.doppler_max = static_cast<int32_t>(doppler_max);
+    if (d_buffers_allocated)
+        {
+            // The grid is already in use (e.g., narrowed by assisted acquisition), so update it now
+            DLOG(INFO) << "Channel " << d_channel << " Doppler search range set to +/- " << doppler_max << " [Hz]";
+            allocate_doppler_grid();
+            update_grid_doppler_wipeoffs();
+            calculate_threshold();
+        }
+    else if (d_num_doppler_bins != 0U)
+        {
+            d_num_doppler_bins = compute_num_doppler_bins();
+            calculate_threshold();
+        }
+}
+
+
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    if (!d_buffers_allocated)
+        {
+            return;  // computed when the buffers are allocated
+        }
+    volk_gnsssdr::vector<std::complex<float>> carrier(d_acq_parameters.fixed_point ? d_fft_size : 0);
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            if (d_acq_parameters.fixed_point)
+                {
+                    update_local_carrier(carrier, static_cast<float>(d_doppler_bias + doppler));
+                    volk_32f_s32f_multiply_32f(reinterpret_cast<float*>(carrier.data()), reinterpret_cast<const float*>(carrier.data()), FXP_CARRIER_AMPLITUDE, 2 * d_fft_size);
+                    volk_gnsssdr_32fc_convert_16ic(d_grid_doppler_wipeoffs_sc[doppler_index].data(), carrier.data(), d_fft_size);
+                }
+            else
+                {
+                    update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+                }
+        }
+    if (d_gpu_engine)
+        {
+            try
+                {
+                    d_gpu_engine->set_doppler_wipeoffs(d_grid_doppler_wipeoffs, d_num_doppler_bins);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(ERROR) << "Acquisition channel " << d_channel << " GPU error, searching in the CPU from now on: " << e.what();
+                    d_gpu_engine.reset();
+                }
         }
 }
 
@@ -498,26 +773,34 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
 {
     float grid_maximum = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
-    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const auto effective_fft_size = static_cast<int32_t>(d_effective_fft_size);
+    std::array<float, 3> stats{};
 
-    // Find the correlation peak and the carrier frequency
+    // Find the correlation peak and the carrier frequency. The power of each
+    // bin is accumulated in the same pass, so that of the bin opposite to the
+    // peak is available without reading the grid again.
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), effective_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > grid_maximum)
+            if (!d_bin_statistics_ready)
+                {
+                    volk_gnsssdr_32f_index_max_stats_32u(&d_bin_statistics[i].peak_index, stats.data(), d_magnitude_grid[i].data(), effective_fft_size);
+                    d_bin_statistics[i].peak = stats[0];
+                    d_bin_statistics[i].power_sum = stats[1];
+                }
+            if (d_bin_statistics[i].peak > grid_maximum)
                 {
-                    grid_maximum = d_magnitude_grid[i][tmp_intex_t];
+                    grid_maximum = d_bin_statistics[i].peak;
                     index_doppler = i;
-                    index_time = tmp_intex_t;
+                    index_time = d_bin_statistics[i].peak_index;
                 }
         }
     indext = index_time;
     if (!d_step_two)
         {
             const auto index_opp = (index_doppler + d_num_doppler_bins / 2) % d_num_doppler_bins;
-            d_input_power = static_cast<float>(std::accumulate(d_magnitude_grid[index_opp].data(), d_magnitude_grid[index_opp].data() + effective_fft_size, static_cast<float>(0.0)) / effective_fft_size / 2.0 / d_num_noncoherent_integrations_counter);
+            const float power_sum = d_bin_statistics[index_opp].power_sum;
+            d_input_power = static_cast<float>(power_sum / effective_fft_size / 2.0 / d_num_noncoherent_integrations_counter);
             doppler = -static_cast<int32_t>(doppler_max) + d_doppler_center + doppler_step * static_cast<int32_t>(index_doppler);
         }
     else
@@ -543,7 +826,17 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), d_fft_size);
+            if (d_bin_statistics_ready)
+                {
+                    if (d_bin_statistics[i].peak > firstPeak)
+                        {
+                            firstPeak = d_bin_statistics[i].peak;
+                            index_doppler = i;
+                            index_time = d_bin_statistics[i].peak_index;
+                        }
+                    continue;
+                }
+            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), d_effective_fft_size);
             if (d_magnitude_grid[i][tmp_intex_t] > firstPeak)
                 {
                     firstPeak = d_magnitude_grid[i][tmp_intex_t];
@@ -562,6 +855,24 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
             doppler = static_cast<int32_t>(d_doppler_center_step_two + (static_cast<float>(index_doppler) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2);
         }
 
+    float secondPeak;
+    if (d_compact_grid)
+        {
+            secondPeak = d_bin_statistics[index_doppler].second_peak;
+        }
+    else
+        {
+            memcpy(d_tmp_buffer.data(), d_magnitude_grid[index_doppler].data(), d_effective_fft_size * sizeof(float));
+            secondPeak = second_peak(d_tmp_buffer.data(), d_effective_fft_size, index_time);
+        }
+
+    // Compute the test statistics and compare to the threshold
+    return firstPeak / secondPeak;
+}
+
+
+float pcps_acquisition::second_peak(float* magnitude, uint32_t size, uint32_t index_time) const
+{
     // Find 1 chip wide code phase exclude range around the peak
     int32_t excludeRangeIndex1 = index_time - d_samplesPerChip;
     int32_t excludeRangeIndex2 = index_time + d_samplesPerChip;
@@ -569,20 +880,19 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     // Correct code phase exclude range if the range includes array boundaries
     if (excludeRangeIndex1 < 0)
         {
-            excludeRangeIndex1 = d_fft_size + excludeRangeIndex1;
+            excludeRangeIndex1 = size + excludeRangeIndex1;
         }
-    else if (excludeRangeIndex2 >= static_cast<int32_t>(d_fft_size))
+    else if (excludeRangeIndex2 >= static_cast<int32_t>(size))
         {
-            excludeRangeIndex2 = excludeRangeIndex2 - d_fft_size;
+            excludeRangeIndex2 = excludeRangeIndex2 - size;
         }
 
     int32_t idx = excludeRangeIndex1;
-    memcpy(d_tmp_buffer.data(), d_magnitude_grid[index_doppler].data(), d_fft_size * sizeof(float));
     do
         {
-            d_tmp_buffer[idx] = 0.0;
+            magnitude[idx] = 0.0;
             idx++;
-            if (idx == static_cast<int32_t>(d_fft_size))
+            if (idx == static_cast<int32_t>(size))
                 {
                     idx = 0;
                 }
@@ -590,86 +900,358 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     while (idx != excludeRangeIndex2);
 
     // Find the second highest correlation peak in the same freq. bin ---
-    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer.data(), d_fft_size);
-    const float secondPeak = d_tmp_buffer[tmp_intex_t];
+    uint32_t tmp_intex_t = 0U;
+    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, magnitude, size);
+    return magnitude[tmp_intex_t];
+}
 
-    // Compute the test statistics and compare to the threshold
-    return firstPeak / secondPeak;
+
+void pcps_acquisition::doppler_search(const gr_complex* in, const gr_complex* fft_codes,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+    uint32_t num_doppler_bins, arma::fmat& dump_grid, bool fixed_point)
+{
+    const uint32_t num_chunks = std::min(static_cast<uint32_t>(d_tmp_buffers.size()), num_doppler_bins);
+    d_bin_statistics_ready = true;
+    if (num_chunks <= 1)
+        {
+            search_doppler_bins(in, fft_codes, grid_doppler_wipeoffs, 0, num_doppler_bins, d_tmp_buffer.data(), fixed_point ? d_tmp_buffer_sc.data() : nullptr, dump_grid);
+            return;
+        }
+
+    // Each chunk of Doppler bins is searched with its own FFT plans and
+    // scratch buffer. Bins are independent, so the results are the same
+    // as in the serial search.
+    const uint32_t bins_per_chunk = (num_doppler_bins + num_chunks - 1) / num_chunks;
+    Gnss_Thread_Pool::instance().parallel_for(num_chunks, [&](size_t chunk) {
+        const uint32_t first_bin = static_cast<uint32_t>(chunk) * bins_per_chunk;
+        const uint32_t last_bin = std::min(first_bin + bins_per_chunk, num_doppler_bins);
+        search_doppler_bins(in, fft_codes, grid_doppler_wipeoffs, first_bin, last_bin, d_tmp_buffers[chunk].data(), fixed_point ? d_tmp_buffers_sc[chunk].data() : nullptr, dump_grid);
+    });
+}
+
+
+bool pcps_acquisition::gpu_search(const gr_complex* in, const gr_complex* fft_codes)
+{
+    if (!d_gpu_engine)
+        {
+            return false;
+        }
+    Acq_Gpu_Engine::Job job;
+    job.fft_code = fft_codes;
+    job.magnitude_grid = &d_magnitude_grid;
+    job.accumulate = (d_num_noncoherent_integrations_counter > 1);
+    try
+        {
+            d_gpu_engine->search(in, std::vector<Acq_Gpu_Engine::Job>(1, job));
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Acquisition channel " << d_channel << " GPU error, searching in the CPU from now on: " << e.what();
+            d_gpu_engine.reset();
+            return false;
+        }
+    if (d_dump and d_channel == d_dump_channel)
+        {
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                {
+                    memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * d_effective_fft_size);
+                }
+        }
+    return true;
+}
+
+
+void pcps_acquisition::search_doppler_bins(const gr_complex* in, const gr_complex* fft_codes,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+    uint32_t first_bin, uint32_t last_bin, float* tmp_buffer, lv_16sc_t* tmp_buffer_sc,
+    arma::fmat& dump_grid)
+{
+    const auto effective_fft_size = static_cast<int32_t>(d_effective_fft_size);
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    const uint32_t fft_size = (d_folding_factor > 1 ? d_effective_fft_size : d_fft_size);
+    auto fft_if = Gnss_Fft_Plan_Pool::instance().get_fwd(fft_size);
+    auto ifft = Gnss_Fft_Plan_Pool::instance().get_rev(fft_size);
+
+    for (uint32_t doppler_index = first_bin; doppler_index < last_bin; doppler_index++)
+        {
+            if (d_folding_factor > 1)
+                {
+                    // Remove Doppler and fold the signal. The inverse FFT input is free
+                    // at this point, so it is used to hold each wiped-off block.
+                    std::fill_n(fft_if->get_inbuf(), fft_size, gr_complex(0.0, 0.0));
+                    for (uint32_t block = 0; block < d_folding_factor; block++)
+                        {
+                            volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), in + block * fft_size, grid_doppler_wipeoffs[doppler_index].data() + block * fft_size, fft_size);
+                            volk_32f_x2_add_32f(reinterpret_cast<float*>(fft_if->get_inbuf()), reinterpret_cast<float*>(fft_if->get_inbuf()), reinterpret_cast<float*>(ifft->get_inbuf()), 2 * fft_size);
+                        }
+                }
+            else if (tmp_buffer_sc != nullptr)
+                {
+                    // Remove Doppler in fixed point, then convert to floating point for the FFT
+                    volk_gnsssdr_16ic_x2_multiply_16ic(tmp_buffer_sc, d_input_signal_sc.data(), d_grid_doppler_wipeoffs_sc[doppler_index].data(), d_fft_size);
+                    volk_gnsssdr_16ic_convert_32fc(fft_if->get_inbuf(), tmp_buffer_sc, d_fft_size);
+                }
+            else
+                {
+                    // Remove Doppler
+                    volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+                }
+
+            // Perform the FFT-based convolution  (parallel time search)
+            // Compute the FFT of the carrier wiped--off incoming signal
+            fft_if->execute();
+
+            // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+            volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), fft_codes, fft_size);
+
+            // Compute the inverse FFT
+            ifft->execute();
+
+            // Compute squared magnitude (and accumulate in case of non-coherent integration)
+            if (d_compact_grid)
+                {
+                    // Keep only the statistics of this bin
+                    volk_32fc_magnitude_squared_32f(tmp_buffer, ifft->get_outbuf() + offset, effective_fft_size);
+                    update_bin_statistics(d_bin_statistics[doppler_index], tmp_buffer, effective_fft_size);
+                }
+            else
+                {
+                    float* magnitude = d_magnitude_grid[doppler_index].data();
+                    if (d_num_noncoherent_integrations_counter == 1)
+                        {
+                            volk_32fc_magnitude_squared_32f(magnitude, ifft->get_outbuf() + offset, effective_fft_size);
+                        }
+                    else
+                        {
+                            // Accumulate in place
+                            volk_32fc_magnitude_squared_32f(tmp_buffer, ifft->get_outbuf() + offset, effective_fft_size);
+                            volk_32f_x2_add_32f(magnitude, magnitude, tmp_buffer, effective_fft_size);
+                        }
+                    // Take the statistics of the accumulated bin while it is still
+                    // in cache, instead of reading the whole grid again after the search
+                    update_peak_statistics(d_bin_statistics[doppler_index], magnitude, effective_fft_size);
+                }
+            // Record results to file if required
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy(dump_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                }
+        }
+}
+
+
+void pcps_acquisition::update_bin_statistics(Bin_Statistics& statistics, float* magnitude, uint32_t size) const
+{
+    if (d_use_CFAR_algorithm_flag)
+        {
+            std::array<float, 3> stats{};
+            volk_gnsssdr_32f_index_max_stats_32u(&statistics.peak_index, stats.data(), magnitude, size);
+            statistics.peak = stats[0];
+            statistics.power_sum = stats[1];
+        }
+    else
+        {
+            volk_gnsssdr_32f_index_max_32u(&statistics.peak_index, magnitude, size);
+            statistics.peak = magnitude[statistics.peak_index];
+            statistics.second_peak = second_peak(magnitude, size, statistics.peak_index);
+        }
+}
+
+
+void pcps_acquisition::update_peak_statistics(Bin_Statistics& statistics, const float* magnitude, uint32_t size) const
+{
+    // The second peak of a full grid is only searched in the bin of the peak,
+    // in a copy of it, by first_vs_second_peak_statistic()
+    if (d_use_CFAR_algorithm_flag)
+        {
+            std::array<float, 3> stats{};
+            volk_gnsssdr_32f_index_max_stats_32u(&statistics.peak_index, stats.data(), magnitude, size);
+            statistics.peak = stats[0];
+            statistics.power_sum = stats[1];
+        }
+    else
+        {
+            volk_gnsssdr_32f_index_max_32u(&statistics.peak_index, magnitude, size);
+            statistics.peak = magnitude[statistics.peak_index];
+        }
+}
+
+
+void pcps_acquisition::scale_input_fixed_point()
+{
+    // Only ratios between grid values are used by the test statistics,
+    // so there is no need to undo this scaling afterwards
+    int32_t max_amplitude = 0;
+    for (uint32_t i = 0; i < d_consumed_samples; i++)
+        {
+            max_amplitude = std::max(max_amplitude, std::abs(static_cast<int32_t>(d_data_buffer_sc[i].real())));
+            max_amplitude = std::max(max_amplitude, std::abs(static_cast<int32_t>(d_data_buffer_sc[i].imag())));
+        }
+    int32_t shift = 0;
+    while ((max_amplitude >> shift) > FXP_MAX_INPUT_AMPLITUDE)
+        {
+            shift++;
+        }
+    for (uint32_t i = 0; i < d_consumed_samples; i++)
+        {
+            d_input_signal_sc[i] = lv_16sc_t(fxp_scale(d_data_buffer_sc[i].real(), shift), fxp_scale(d_data_buffer_sc[i].imag(), shift));
+        }
+    std::fill(d_input_signal_sc.begin() + d_consumed_samples, d_input_signal_sc.end(), lv_16sc_t(0, 0));
+}
+
+
+uint32_t pcps_acquisition::resolve_folded_code_phase(const gr_complex* in, float carrier_freq, uint32_t folded_index) const
+{
+    // Correlate the wiped-off input with the local code at each of the
+    // candidate code phases, and keep the strongest one
+    volk_gnsssdr::vector<std::complex<float>> wiped_off(d_fft_size);
+    update_local_carrier(wiped_off, carrier_freq);
+    volk_32fc_x2_multiply_32fc(wiped_off.data(), in, wiped_off.data(), d_fft_size);
+
+    float max_power = -1.0;
+    uint32_t code_phase = folded_index;
+    for (uint32_t block = 0; block < d_folding_factor; block++)
+        {
+            const uint32_t delay = folded_index + block * d_effective_fft_size;
+            lv_32fc_t corr_head = lv_cmake(0.0F, 0.0F);
+            lv_32fc_t corr_tail = lv_cmake(0.0F, 0.0F);
+            volk_32fc_x2_conjugate_dot_prod_32fc(&corr_head, wiped_off.data() + delay, d_local_code.data(), d_fft_size - delay);
+            if (delay > 0)
+                {
+                    volk_32fc_x2_conjugate_dot_prod_32fc(&corr_tail, wiped_off.data(), d_local_code.data() + d_fft_size - delay, delay);
+                }
+            const float power = std::norm(corr_head + corr_tail);
+            if (power > max_power)
+                {
+                    max_power = power;
+                    code_phase = delay;
+                }
+        }
+    return code_phase;
+}
+
+
+void pcps_acquisition::restart_lost_snapshot(uint64_t stamp)
+{
+    // Called with d_setlock held. The dwells accumulated so far are dropped,
+    // and the search starts again from a new snapshot.
+    LOG(WARNING) << "Channel " << d_channel << ": acquisition snapshot at sample stamp " << stamp
+                 << " is no longer in the shared ring, restarting the search";
+    if (d_batch_announced)
+        {
+            d_batch_engine->withdraw(d_batch_stamp);
+            d_batch_announced = false;
+        }
+    d_num_noncoherent_integrations_counter = 0U;
+    d_positive_acq = 0;
+    d_buffer_count = 0U;
+    d_state = 0;
+    d_worker_active = false;
 }
 
 
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
 {
+    GNSS_SDR_TRACE_ZONE("acquisition_core");
     gr::thread::scoped_lock lk(d_setlock);
 
     // Initialize acquisition algorithm
     int32_t doppler = 0;
     uint32_t indext = 0U;
-    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
-    if (d_cshort)
+    const auto effective_fft_size = static_cast<int32_t>(d_effective_fft_size);
+    // The wide grid search can run in fixed point. The step two grid is small
+    // and stays in floating point.
+    const bool fixed_point = d_acq_parameters.fixed_point and !d_step_two;
+    if (fixed_point)
         {
-            volk_gnsssdr_16ic_convert_32fc(d_data_buffer.data(), d_data_buffer_sc.data(), d_consumed_samples);
+            scale_input_fixed_point();
         }
-    memcpy(d_input_signal.data(), d_data_buffer.data(), d_consumed_samples * sizeof(gr_complex));
-    if (d_fft_size > d_consumed_samples)
+    const gr_complex* in = d_input_signal.data();  // Get the input samples pointer
+    const uint64_t snapshot_stamp = samp_count - d_consumed_samples;
+    if (!fixed_point)
         {
-            for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+            const gr_complex* snapshot = d_data_buffer.data();
+            if (d_sample_ring != nullptr)
                 {
-                    d_input_signal[i] = gr_complex(0.0, 0.0);
+                    snapshot = d_sample_ring->snapshot(snapshot_stamp, d_consumed_samples);
+                    if (snapshot == nullptr)
+                        {
+                            restart_lost_snapshot(snapshot_stamp);
+                            return;
+                        }
+                }
+            if (d_cshort)
+                {
+                    volk_gnsssdr_16ic_convert_32fc(d_data_buffer.data(), d_data_buffer_sc.data(), d_consumed_samples);
+                }
+            if (d_sample_ring != nullptr and d_fft_size == d_consumed_samples)
+                {
+                    // searched in place, with no copy
+                    in = snapshot;
+                }
+            else
+                {
+                    memcpy(d_input_signal.data(), snapshot, d_consumed_samples * sizeof(gr_complex));
+                    if (d_fft_size > d_consumed_samples)
+                        {
+                            for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+                                {
+                                    d_input_signal[i] = gr_complex(0.0, 0.0);
+                                }
+                        }
                 }
         }
-    const gr_complex* in = d_input_signal.data();  // Get the input samples pointer
+    const Acq_Fft_Code_Cache::fft_code_sptr fft_codes = d_fft_codes;
 
     d_mag = 0.0;
     d_num_noncoherent_integrations_counter++;
 
-    DLOG(INFO) << "Channel: " << d_channel
-               << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
-               << " ,sample stamp: " << samp_count << ", threshold: "
-               << d_threshold << ", doppler_max: " << d_acq_parameters.doppler_max
-               << ", doppler_step: " << d_doppler_step
-               << ", use_CFAR_algorithm_flag: " << (d_use_CFAR_algorithm_flag ? "true" : "false");
+    GNSS_SDR_DLOG_EVERY_MS(INFO, 1000) << "Channel: " << d_channel
+                                       << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+                                       << " ,sample stamp: " << samp_count << ", threshold: "
+                                       << d_threshold << ", doppler_max: " << d_acq_parameters.doppler_max
+                                       << ", doppler_step: " << d_doppler_step
+                                       << ", use_CFAR_algorithm_flag: " << (d_use_CFAR_algorithm_flag ? "true" : "false");
 
     if (d_acq_parameters.blocking)
         {
             lk.unlock();
         }
 
-    // Doppler frequency grid loop
+    // Doppler frequency grid loop. The batch and GPU engines leave the
+    // statistics of the bins to the peak search.
+    d_bin_statistics_ready = false;
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            if (d_batch_announced and (d_batch_stamp == samp_count) and (batch_grid_id() == d_batch_grid_id))
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // Compute the inverse FFT
-                    d_ifft->execute();
-
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
+                    // Share the Doppler wipe-off and forward FFTs with the rest of channels searching this snapshot
+                    Acq_Batch_Engine::Job job;
+                    job.input = in;
+                    job.fft_code = fft_codes->data();
+                    job.magnitude_grid = &d_magnitude_grid;
+                    job.accumulate = (d_num_noncoherent_integrations_counter > 1);
+                    d_batch_engine->process(samp_count, job, d_grid_doppler_wipeoffs);
+                    if (d_dump and d_channel == d_dump_channel)
                         {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                                {
+                                    memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                                }
                         }
-                    else
+                }
+            else
+                {
+                    if (d_batch_announced)
                         {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                            d_batch_engine->withdraw(d_batch_stamp);
                         }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                    if (!gpu_search(in, fft_codes->data()))
                         {
-                            memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                            doppler_search(in, fft_codes->data(), d_grid_doppler_wipeoffs, d_num_doppler_bins, d_grid, fixed_point);
                         }
                 }
+            d_batch_announced = false;
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
@@ -680,6 +1262,10 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 {
                     d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
                 }
+            if (d_folding_factor > 1)
+                {
+                    indext = resolve_folded_code_phase(in, static_cast<float>(d_doppler_bias + doppler), indext);
+                }
             if (d_acq_parameters.use_automatic_resampler)
                 {
                     // take into account the acquisition resampler ratio
@@ -697,37 +1283,8 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+            doppler_search(in, fft_codes->data(), d_grid_doppler_wipeoffs_step_two, d_num_doppler_bins_step2, d_narrow_grid);
 
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(d_narrow_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
-                        }
-                }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
@@ -737,6 +1294,10 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 {
                     d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
                 }
+            if (d_folding_factor > 1)
+                {
+                    indext = resolve_folded_code_phase(in, static_cast<float>(doppler), indext);
+                }
 
             if (d_acq_parameters.use_automatic_resampler)
                 {
@@ -761,6 +1322,13 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
             lk.lock();
         }
 
+    if (d_sample_ring != nullptr and !d_sample_ring->intact(snapshot_stamp))
+        {
+            // the writer went over the snapshot while it was being searched
+            restart_lost_snapshot(snapshot_stamp);
+            return;
+        }
+
     if (!d_acq_parameters.bit_transition_flag)
         {
             if (d_test_statistics > d_threshold)
@@ -855,7 +1423,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or (d_positive_acq == 1) or (d_acq_parameters.bit_transition_flag))
         {
             // Record results to file if required
-            if (d_dump and d_channel == d_dump_channel)
+            if (d_dump and d_channel == d_dump_channel and !d_dump_paused)
                 {
                     pcps_acquisition::dump_results(effective_fft_size);
                 }
@@ -865,6 +1433,43 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
 }
 
 
+std::string pcps_acquisition::batch_grid_id() const
+{
+    const int64_t fs = d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in;
+    return std::string(d_gnss_synchro->Signal) + "_" + std::to_string(fs) + "_" +
+           std::to_string(d_fft_size) + "_" +
+           std::to_string(d_acq_parameters.bit_transition_flag ? 1 : 0) + "_" +
+           std::to_string(d_acq_parameters.doppler_max) + "_" +
+           std::to_string(d_doppler_step) + "_" +
+           std::to_string(d_doppler_center) + "_" +
+           std::to_string(d_doppler_bias) + "_" +
+           std::to_string(d_num_doppler_bins) +
+           (d_acq_parameters.compute_backend != Gnss_Compute_Backend::CPU ? "_gpu" + std::to_string(d_gpu_device) : std::string());
+}
+
+
+bool pcps_acquisition::align_batch_snapshot(int32_t ninput_items)
+{
+    // Start the snapshot at a multiple of its length, so all the channels
+    // in batch mode search exactly the same samples
+    const auto misalignment = static_cast<uint32_t>(d_sample_counter % d_consumed_samples);
+    if (misalignment != 0U)
+        {
+            const uint32_t skip = std::min(static_cast<uint32_t>(ninput_items), d_consumed_samples - misalignment);
+            d_sample_counter += static_cast<uint64_t>(skip);
+            consume_each(skip);
+            return false;
+        }
+    const uint32_t effective_fft_size = d_effective_fft_size;
+    d_batch_grid_id = batch_grid_id();
+    d_batch_engine = Acq_Batch_Engine::get(d_batch_grid_id, d_fft_size, effective_fft_size, d_acq_parameters.bit_transition_flag ? effective_fft_size : 0U, d_acq_parameters.compute_backend, d_gpu_device);
+    d_batch_stamp = d_sample_counter + d_consumed_samples;
+    d_batch_engine->announce(d_batch_stamp);
+    d_batch_announced = true;
+    return true;
+}
+
+
 // Called by gnuradio to enable drivers, etc for i/o devices.
 bool pcps_acquisition::start()
 {
@@ -883,7 +1488,7 @@ void pcps_acquisition::calculate_threshold()
             return;
         }
 
-    const auto effective_fft_size = static_cast<int>(d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
+    const auto effective_fft_size = static_cast<int>(d_effective_fft_size);
     const int num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
 
     const int num_bins = effective_fft_size * num_doppler_bins;
@@ -892,11 +1497,69 @@ void pcps_acquisition::calculate_threshold()
 }
 
 
+bool pcps_acquisition::set_dump_enabled(bool enabled)
+{
+    d_dump_paused = !enabled;
+    return d_dump;
+}
+
+
+void pcps_acquisition::set_sample_ring(std::shared_ptr<Acq_Sample_Ring> ring)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    if (ring != nullptr)
+        {
+            if (d_cshort or d_acq_parameters.fixed_point)
+                {
+                    LOG(WARNING) << "Channel " << d_channel << ": the shared acquisition ring is only used with gr_complex inputs";
+                    return;
+                }
+            // room for the snapshot being searched and for the input buffer the ring writer can be ahead
+            if (ring->capacity() < 4 * static_cast<size_t>(d_consumed_samples))
+                {
+                    LOG(WARNING) << "Channel " << d_channel << ": the shared acquisition ring of " << ring->capacity()
+                                 << " samples is too short for snapshots of " << d_consumed_samples << " samples";
+                    return;
+                }
+            d_data_buffer = volk_gnsssdr::vector<std::complex<float>>();
+        }
+    else if (d_sample_ring != nullptr)
+        {
+            d_data_buffer = volk_gnsssdr::vector<std::complex<float>>(d_consumed_samples);
+        }
+    d_sample_ring = std::move(ring);
+    d_buffer_count = 0U;
+    if (d_state == 2)
+        {
+            d_state = 1;
+        }
+}
+
+
+void pcps_acquisition::forecast(int noutput_items, gr_vector_int& ninput_items_required)
+{
+    gr::block::forecast(noutput_items, ninput_items_required);
+    if (!d_acq_parameters.detach_on_standby or d_acq_parameters.blocking_on_standby)
+        {
+            return;
+        }
+    gr::thread::scoped_lock lk(d_setlock);
+    if (!d_active and !d_step_two)
+        {
+            // The samples are counted when they are consumed, so the sample
+            // stamps stay right however many of them are discarded at once
+            ninput_items_required[0] = std::max(ninput_items_required[0], d_standby_items);
+        }
+}
+
+
 int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int& ninput_items,
     gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items)
 {
+    const Gnss_Block_Work_Timer work_timer(d_work_stats.get());
+
     /*
      * By J.Arribas, L.Esteve and M.Molina
      * Acquisition strategy (Kay Borre book + CFAR threshold):
@@ -910,10 +1573,22 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
     gr::thread::scoped_lock lk(d_setlock);
     if (!d_active or d_worker_active)
         {
+            if (d_batch_announced and !d_worker_active)
+                {
+                    // The search was stopped before completing the snapshot
+                    d_batch_engine->withdraw(d_batch_stamp);
+                    d_batch_announced = false;
+                }
             if (!d_acq_parameters.blocking_on_standby)
                 {
                     d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
                     consume_each(ninput_items[0]);
+                    if (d_acq_parameters.detach_on_standby and !d_active)
+                        {
+                            // Half of the largest backlog seen never exceeds
+                            // the input buffer, whatever its size
+                            d_standby_items = std::max(d_standby_items, ninput_items[0] / 2);
+                        }
                 }
             if (d_step_two)
                 {
@@ -946,6 +1621,13 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
             }
         case 1:
             {
+                if (d_acq_parameters.batch_acquisition and !d_step_two and (d_buffer_count == 0U) and !d_batch_announced)
+                    {
+                        if (!align_batch_snapshot(ninput_items[0]))
+                            {
+                                break;
+                            }
+                    }
                 uint32_t buff_increment;
                 if (d_cshort)
                     {
@@ -971,7 +1653,10 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                             {
                                 buff_increment = d_consumed_samples - d_buffer_count;
                             }
-                        memcpy(&d_data_buffer[d_buffer_count], in, sizeof(gr_complex) * buff_increment);
+                        if (d_sample_ring == nullptr)
+                            {
+                                memcpy(&d_data_buffer[d_buffer_count], in, sizeof(gr_complex) * buff_increment);
+                            }
                     }
 
                 // If buffer will be full in next iteration
@@ -986,6 +1671,12 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
             }
         case 2:
             {
+                if (d_sample_ring != nullptr and d_sample_ring->written() < d_sample_counter)
+                    {
+                        // the ring writer has not reached the end of the snapshot yet
+                        consume_each(0);
+                        break;
+                    }
                 // Copy the data to the core and let it know that new data is available
                 if (d_acq_parameters.blocking)
                     {
@@ -994,8 +1685,22 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                     }
                 else
                     {
-                        gr::thread::thread d_worker(&pcps_acquisition::acquisition_core, this, d_sample_counter);
+                        // Run the search in the shared worker pool. Verification and
+                        // non-coherent dwells of an ongoing search go first.
                         d_worker_active = true;
+                        {
+                            std::lock_guard<std::mutex> worker_lock(d_worker_mutex);
+                            d_worker_queued = true;
+                        }
+                        const int priority = d_step_two ? 2 : (d_num_noncoherent_integrations_counter > 0 ? 1 : 0);
+                        const uint64_t sample_counter = d_sample_counter;
+                        auto search = [this, sample_counter]() {
+                            acquisition_core(sample_counter);
+                            std::lock_guard<std::mutex> worker_lock(d_worker_mutex);
+                            d_worker_queued = false;
+                            d_worker_cv.notify_all();
+                        };
+                        Gnss_Thread_Pool::instance().submit(search, priority);
                     }
                 consume_each(0);
                 d_buffer_count = 0U;
@@ -42,9 +42,13 @@
 #define ARMA_NO_DEBUG 1
 #endif
 
+#include "acq_batch_engine.h"
 #include "acq_conf.h"
+#include "acq_fft_code_cache.h"
+#include "acq_sample_ring.h"
 #include "channel_fsm.h"
-#include "gnss_sdr_fft.h"
+#include "gnss_sdr_fft_pool.h"
+#include "acq_gpu_engine.h"
 #include <armadillo>
 #include <glog/logging.h>
 #include <gnuradio/block.h>
@@ -54,11 +58,15 @@
 #include <volk/volk_complex.h>                // for lv_16sc_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <complex>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -76,6 +84,7 @@ namespace own = gsl;
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
 class pcps_acquisition;
 
@@ -92,7 +101,10 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
 class pcps_acquisition : public gr::block
 {
 public:
-    ~pcps_acquisition() override = default;
+    /*!
+     * \brief Waits for any pending search in the worker pool to finish.
+     */
+    ~pcps_acquisition() override;
 
     /*!
      * \brief Initializes acquisition algorithm and reserves memory.
@@ -111,7 +123,9 @@ public:
     }
 
     /*!
-     * \brief Sets local code for PCPS acquisition algorithm.
+     * \brief Sets local code for PCPS acquisition algorithm. The spectrum
+     * of the code is shared with any other channel searching for the same
+     * signal and PRN, so it is computed only once.
      * \param code - Pointer to the PRN code.
      */
     void set_local_code(std::complex<float>* code);
@@ -147,11 +161,9 @@ public:
     /*!
      * \brief Set acquisition channel unique ID
      * \param channel - receiver channel.
+     * The GPU engine, if any, is moved to the device of the channel.
      */
-    inline void set_channel(uint32_t channel)
-    {
-        d_channel = channel;
-    }
+    void set_channel(uint32_t channel);
 
     /*!
      * \brief Set channel fsm associated to this acquisition instance
@@ -173,14 +185,11 @@ public:
     }
 
     /*!
-     * \brief Set maximum Doppler grid search
+     * \brief Set maximum Doppler grid search. If called after init(), the
+     * search grid is updated right away.
      * \param doppler_max - Maximum Doppler shift considered in the grid search [Hz].
      */
-    inline void set_doppler_max(uint32_t doppler_max)
-    {
-        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
-        d_acq_parameters.doppler_max = doppler_max;
-    }
+    void set_doppler_max(uint32_t doppler_max);
 
     /*!
      * \brief Set Doppler steps for the grid search
@@ -207,6 +216,28 @@ public:
             }
     }
 
+    /*!
+     * \brief Pauses or resumes the dumps set in the configuration. Returns
+     * false if they were not set.
+     */
+    bool set_dump_enabled(bool enabled);
+
+    /*!
+     * \brief Takes the snapshots from a ring shared with the rest of channels
+     * fed by the same stream, instead of copying the input into a buffer of
+     * its own. The input is still consumed, to keep the sample stamps, but
+     * not copied. Ignored for cshort or fixed point inputs, or if the ring
+     * is too short for the snapshots. A null ring restores the own buffer.
+     */
+    void set_sample_ring(std::shared_ptr<Acq_Sample_Ring> ring);
+
+    /*!
+     * \brief On standby, and if detach_on_standby is set, asks for half of
+     * the largest backlog of input samples seen so far, so that the scheduler does not wake up the block on
+     * every write of the signal conditioner just to discard the samples.
+     */
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+
     /*!
      * \brief Parallel Code Phase Search Acquisition signal processing.
      */
@@ -215,13 +246,45 @@ public:
         gr_vector_void_star& output_items) override;
 
 private:
+    /*!
+     * \brief Statistics of one Doppler bin, kept instead of the full row of
+     * the search grid when it is not needed.
+     */
+    class Bin_Statistics
+    {
+    public:
+        float peak{0.0};
+        float second_peak{0.0};  // highest value more than one chip away from the peak
+        float power_sum{0.0};
+        uint32_t peak_index{0U};
+    };
+
     friend pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
     explicit pcps_acquisition(const Acq_Conf& conf_);
 
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
+    void allocate_buffers();  // Allocates the work buffers and the search grid on the first use
+    void allocate_doppler_grid();
+    uint32_t compute_num_doppler_bins() const;
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
     void acquisition_core(uint64_t samp_count);
+    void doppler_search(const gr_complex* in, const gr_complex* fft_codes,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t num_doppler_bins, arma::fmat& dump_grid, bool fixed_point = false);
+    void search_doppler_bins(const gr_complex* in, const gr_complex* fft_codes,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t first_bin, uint32_t last_bin, float* tmp_buffer, lv_16sc_t* tmp_buffer_sc,
+        arma::fmat& dump_grid);
+    void scale_input_fixed_point();
+    void restart_lost_snapshot(uint64_t stamp);
+    bool gpu_search(const gr_complex* in, const gr_complex* fft_codes);
+    uint32_t resolve_folded_code_phase(const gr_complex* in, float carrier_freq, uint32_t folded_index) const;
+    void update_bin_statistics(Bin_Statistics& statistics, float* magnitude, uint32_t size) const;
+    void update_peak_statistics(Bin_Statistics& statistics, const float* magnitude, uint32_t size) const;
+    float second_peak(float* magnitude, uint32_t size, uint32_t index_time) const;
+    bool align_batch_snapshot(int32_t ninput_items);
+    std::string batch_grid_id() const;
     void send_negative_acquisition();
     void send_positive_acquisition();
     void dump_results(int32_t effective_fft_size);
@@ -232,16 +295,25 @@ private:
     float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
 
     volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_magnitude_grid;
+    std::vector<Bin_Statistics> d_bin_statistics;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_tmp_buffers;
     volk_gnsssdr::vector<float> d_tmp_buffer;
     volk_gnsssdr::vector<std::complex<float>> d_input_signal;
+    volk_gnsssdr::vector<std::complex<float>> d_local_code;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
-    volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
     volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
     volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
-
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<lv_16sc_t>> d_grid_doppler_wipeoffs_sc;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<lv_16sc_t>> d_tmp_buffers_sc;
+    volk_gnsssdr::vector<lv_16sc_t> d_tmp_buffer_sc;
+    volk_gnsssdr::vector<lv_16sc_t> d_input_signal_sc;
+
+    Acq_Fft_Code_Cache::fft_code_sptr d_fft_codes;
+    std::shared_ptr<Acq_Batch_Engine> d_batch_engine;
+    std::shared_ptr<Acq_Sample_Ring> d_sample_ring;
+    std::shared_ptr<Gnss_Block_Stats> d_work_stats;
+    std::unique_ptr<Acq_Gpu_Engine> d_gpu_engine;
     std::weak_ptr<ChannelFsm> d_channel_fsm;
 
     Acq_Conf d_acq_parameters;
@@ -250,10 +322,14 @@ private:
     arma::fmat d_narrow_grid;
 
     std::queue<Gnss_Synchro> d_monitor_queue;
+    std::mutex d_worker_mutex;
+    std::condition_variable d_worker_cv;
     std::string d_dump_filename;
+    std::string d_batch_grid_id;
 
     int64_t d_dump_number;
     uint64_t d_sample_counter;
+    uint64_t d_batch_stamp;
 
     float d_threshold;
     float d_mag;
@@ -265,6 +341,8 @@ private:
     int32_t d_positive_acq;
     int32_t d_doppler_center;
     int32_t d_doppler_bias;
+    int32_t d_standby_items;
+    int32_t d_gpu_device;
     uint32_t d_channel;
     uint32_t d_samplesPerChip;
     uint32_t d_doppler_step;
@@ -275,13 +353,21 @@ private:
     uint32_t d_num_doppler_bins_step2;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
+    uint32_t d_folding_factor;
+    uint32_t d_effective_fft_size;
 
     bool d_active;
     bool d_worker_active;
+    bool d_worker_queued;
     bool d_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
     bool d_dump;
+    bool d_batch_announced;
+    bool d_compact_grid;
+    bool d_bin_statistics_ready;  // the search has filled d_bin_statistics (except the second peaks of a full grid)
+    bool d_buffers_allocated;
+    std::atomic<bool> d_dump_paused;
 };
 
 
@@ -56,10 +56,12 @@ typedef struct
     uint32_t excludelimit;
     uint32_t num_doppler_bins_step2;
     uint32_t max_num_acqs;
+    uint32_t code_banks;
     int32_t samples_per_code;
     int32_t code_length;
     bool make_2_steps;
     bool repeat_satellite;
+    bool pipelined;
 } pcpsconf_fpga_t;
 
 class pcps_acquisition_fpga;
@@ -0,0 +1,241 @@
+/*!
+ * \file acq_batch_engine.cc
+ * \brief Engine that searches several PRNs on the same input snapshot,
+ * sharing the Doppler wipe-off and forward FFT among them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_batch_engine.h"
+#include "gnss_sdr_fft_pool.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <chrono>
+#include <cstddef>  // for ptrdiff_t
+#include <cstring>  // for memcmp
+#include <exception>
+#include <utility>
+
+
+namespace
+{
+const std::chrono::milliseconds BATCH_MAX_WAIT{50};
+}  // namespace
+
+
+std::shared_ptr<Acq_Batch_Engine> Acq_Batch_Engine::get(const std::string& grid_id,
+    uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset, Gnss_Compute_Backend backend, int device)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Acq_Batch_Engine>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& entry = registry[grid_id];
+    std::shared_ptr<Acq_Batch_Engine> engine = entry.lock();
+    if (!engine)
+        {
+            engine = std::make_shared<Acq_Batch_Engine>(fft_size, effective_fft_size, output_offset, backend, device);
+            entry = engine;
+        }
+    return engine;
+}
+
+
+Acq_Batch_Engine::Acq_Batch_Engine(uint32_t fft_size,
+    uint32_t effective_fft_size,
+    uint32_t output_offset,
+    Gnss_Compute_Backend backend,
+    int device) : d_fft_size(fft_size),
+                  d_effective_fft_size(effective_fft_size),
+                  d_output_offset(output_offset)
+{
+    if (backend != Gnss_Compute_Backend::CPU)
+        {
+            try
+                {
+                    d_gpu_engine = Acq_Gpu_Engine::make(backend, device, fft_size, effective_fft_size, output_offset);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Batched acquisition cannot use the " << compute_backend_to_string(backend) << " device, searching in the CPU: " << e.what();
+                }
+        }
+}
+
+
+void Acq_Batch_Engine::announce(uint64_t sample_stamp)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_pending[sample_stamp].announced++;
+}
+
+
+void Acq_Batch_Engine::withdraw(uint64_t sample_stamp)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto it = d_pending.find(sample_stamp);
+    if (it != d_pending.end())
+        {
+            if (it->second.announced > 0)
+                {
+                    it->second.announced--;
+                }
+            if (it->second.jobs.empty() && it->second.announced == 0)
+                {
+                    d_pending.erase(it);
+                }
+        }
+    d_cv.notify_all();
+}
+
+
+void Acq_Batch_Engine::process(uint64_t sample_stamp, Job& job,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    job.done = false;
+    Batch& batch = d_pending[sample_stamp];
+    batch.jobs.push_back(&job);
+    if (batch.jobs.size() > 1)
+        {
+            // Somebody else is leading this batch
+            d_cv.notify_all();
+            d_cv.wait(lock, [&job] { return job.done; });
+            return;
+        }
+
+    d_cv.wait_for(lock, BATCH_MAX_WAIT, [&batch] { return batch.jobs.size() >= batch.announced; });
+    const std::vector<Job*> jobs = std::move(batch.jobs);
+    // Jobs arriving from now on will start a new batch
+    d_pending.erase(sample_stamp);
+    lock.unlock();
+
+    DLOG(INFO) << "Batched acquisition of " << jobs.size() << " PRNs at sample stamp " << sample_stamp;
+    compute(jobs, grid_doppler_wipeoffs);
+
+    lock.lock();
+    for (auto* j : jobs)
+        {
+            j->done = true;
+        }
+    d_cv.notify_all();
+}
+
+
+void Acq_Batch_Engine::search(const std::vector<Job*>& jobs,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs)
+{
+    compute(jobs, grid_doppler_wipeoffs);
+    for (auto* job : jobs)
+        {
+            job->done = true;
+        }
+}
+
+
+void Acq_Batch_Engine::compute(const std::vector<Job*>& jobs,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs)
+{
+    // Group the jobs that share the very same input samples
+    std::vector<std::vector<Job*>> groups;
+    for (auto* job : jobs)
+        {
+            bool found = false;
+            for (auto& group : groups)
+                {
+                    if (group[0]->input == job->input ||
+                        memcmp(group[0]->input, job->input, sizeof(std::complex<float>) * d_fft_size) == 0)
+                        {
+                            group.push_back(job);
+                            found = true;
+                            break;
+                        }
+                }
+            if (!found)
+                {
+                    groups.emplace_back(1, job);
+                }
+        }
+
+    if (compute_gpu(groups, grid_doppler_wipeoffs))
+        {
+            return;
+        }
+
+    auto fft_if = Gnss_Fft_Plan_Pool::instance().get_fwd(d_fft_size);
+    auto ifft = Gnss_Fft_Plan_Pool::instance().get_rev(d_fft_size);
+    volk_gnsssdr::vector<float> tmp_buffer(d_effective_fft_size);
+
+    for (size_t doppler_index = 0; doppler_index < grid_doppler_wipeoffs.size(); doppler_index++)
+        {
+            for (const auto& group : groups)
+                {
+                    // Remove Doppler and compute the FFT of the carrier wiped-off incoming signal, once for all PRNs
+                    volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), group[0]->input, grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+                    fft_if->execute();
+
+                    for (auto* job : group)
+                        {
+                            volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), job->fft_code, d_fft_size);
+                            ifft->execute();
+                            auto& magnitude = (*job->magnitude_grid)[doppler_index];
+                            if (!job->accumulate)
+                                {
+                                    volk_32fc_magnitude_squared_32f(magnitude.data(), ifft->get_outbuf() + d_output_offset, d_effective_fft_size);
+                                }
+                            else
+                                {
+                                    volk_32fc_magnitude_squared_32f(tmp_buffer.data(), ifft->get_outbuf() + d_output_offset, d_effective_fft_size);
+                                    volk_32f_x2_add_32f(magnitude.data(), magnitude.data(), tmp_buffer.data(), d_effective_fft_size);
+                                }
+                        }
+                }
+        }
+}
+
+
+bool Acq_Batch_Engine::compute_gpu(std::vector<std::vector<Job*>>& groups,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs)
+{
+    // Batches of different sample stamps can be led by different threads
+    std::lock_guard<std::mutex> lock(d_gpu_mutex);
+    if (!d_gpu_engine)
+        {
+            return false;
+        }
+    size_t done = 0;
+    try
+        {
+            d_gpu_engine->set_doppler_wipeoffs(grid_doppler_wipeoffs, static_cast<uint32_t>(grid_doppler_wipeoffs.size()));
+            for (const auto& group : groups)
+                {
+                    std::vector<Acq_Gpu_Engine::Job> gpu_jobs(group.size());
+                    for (size_t i = 0; i < group.size(); i++)
+                        {
+                            gpu_jobs[i].fft_code = group[i]->fft_code;
+                            gpu_jobs[i].magnitude_grid = group[i]->magnitude_grid;
+                            gpu_jobs[i].accumulate = group[i]->accumulate;
+                        }
+                    d_gpu_engine->search(group[0]->input, gpu_jobs);
+                    done++;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Batched acquisition GPU error, searching in the CPU from now on: " << e.what();
+            d_gpu_engine.reset();
+            // Leave only the groups still to be searched
+            groups.erase(groups.begin(), groups.begin() + static_cast<std::ptrdiff_t>(done));
+            return false;
+        }
+    return true;
+}
@@ -0,0 +1,132 @@
+/*!
+ * \file acq_batch_engine.h
+ * \brief Engine that searches several PRNs on the same input snapshot,
+ * sharing the Doppler wipe-off and forward FFT among them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_BATCH_ENGINE_H
+#define GNSS_SDR_ACQ_BATCH_ENGINE_H
+
+#include "acq_gpu_engine.h"
+#include "gnss_sdr_compute_backend.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Batched PCPS acquisition engine.
+ *
+ * All the acquisition channels sharing the same search grid (signal,
+ * sampling rate, FFT length and Doppler bins) get the same instance.
+ * Channels announce the sample stamp of the snapshot they are going
+ * to search, and then submit a job when the snapshot is complete. The first
+ * channel submitting a job for a given stamp waits (at most 50 ms) for
+ * the rest of announced channels, and then computes the whole batch: for each
+ * Doppler bin, the carrier wipe-off and forward FFT of the input are done once,
+ * followed by one multiplication and inverse FFT per PRN code. Results are
+ * bit-exact with the per-channel search. If the backend is not the CPU, the
+ * whole batch is searched in that device instead.
+ */
+class Acq_Batch_Engine
+{
+public:
+    /*!
+     * \brief Search of one PRN on a snapshot
+     */
+    class Job
+    {
+    public:
+        const std::complex<float>* input{nullptr};     // fft_size samples
+        const std::complex<float>* fft_code{nullptr};  // conjugated code spectrum, fft_size samples
+        volk_gnsssdr::vector<volk_gnsssdr::vector<float>>* magnitude_grid{nullptr};
+        bool accumulate{false};  // add to the grid (non-coherent integration) instead of overwriting it
+        bool done{false};
+    };
+
+    /*!
+     * \brief Returns the engine shared by all channels with the same grid_id,
+     * creating it if required. Channels on different devices must use
+     * different grid_ids.
+     */
+    static std::shared_ptr<Acq_Batch_Engine> get(const std::string& grid_id,
+        uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset,
+        Gnss_Compute_Backend backend = Gnss_Compute_Backend::CPU, int device = 0);
+
+    Acq_Batch_Engine(uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset,
+        Gnss_Compute_Backend backend = Gnss_Compute_Backend::CPU, int device = 0);
+
+    /*!
+     * \brief Tells the engine that a job for sample_stamp will be submitted.
+     */
+    void announce(uint64_t sample_stamp);
+
+    /*!
+     * \brief Cancels a previous announcement.
+     */
+    void withdraw(uint64_t sample_stamp);
+
+    /*!
+     * \brief Submits a job and returns when it has been computed. The Doppler
+     * wipe-off signals are the ones of the calling channel, and are used in
+     * case it leads the batch.
+     */
+    void process(uint64_t sample_stamp, Job& job,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs);
+
+    /*!
+     * \brief Computes jobs as a single batch, from the calling thread and
+     * without waiting for any announced job. For callers that search all the
+     * PRNs themselves.
+     */
+    void search(const std::vector<Job*>& jobs,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs);
+
+private:
+    class Batch
+    {
+    public:
+        std::vector<Job*> jobs;
+        uint32_t announced{0U};
+    };
+
+    void compute(const std::vector<Job*>& jobs,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs);
+    bool compute_gpu(std::vector<std::vector<Job*>>& groups,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs);
+
+    std::map<uint64_t, Batch> d_pending;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::unique_ptr<Acq_Gpu_Engine> d_gpu_engine;
+    std::mutex d_gpu_mutex;
+    uint32_t d_fft_size;
+    uint32_t d_effective_fft_size;
+    uint32_t d_output_offset;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_BATCH_ENGINE_H
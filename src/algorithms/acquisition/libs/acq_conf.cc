@@ -16,6 +16,7 @@
  */
 
 #include "acq_conf.h"
+#include "gnss_sdr_resampling_ratio.h"
 #include "item_type_helpers.h"
 #include <glog/logging.h>
 #include <cmath>
@@ -44,6 +45,7 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
 
     use_automatic_resampler = configuration->property("GNSS-SDR.use_acquisition_resampler", use_automatic_resampler);
+    resampler_max_interpolation = configuration->property("GNSS-SDR.acquisition_resampler_max_interpolation", resampler_max_interpolation);
 
     if ((sampled_ms % ms_per_code) != 0)
         {
@@ -76,6 +78,56 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    detach_on_standby = configuration->property("GNSS-SDR.detach_idle_signal_paths", detach_on_standby);
+    detach_on_standby = configuration->property(role + ".detach_on_standby", detach_on_standby);
+    batch_acquisition = configuration->property(role + ".batch_acquisition", batch_acquisition);
+    threads = configuration->property(role + ".threads", threads);
+    if (threads == 0)
+        {
+            threads = 1;
+        }
+    fixed_point = configuration->property(role + ".fixed_point", fixed_point);
+    if (fixed_point and (item_type != "cshort"))
+        {
+            LOG(WARNING) << "Parameter fixed_point requires item_type=cshort. Setting it to false";
+            fixed_point = false;
+        }
+    if (fixed_point and batch_acquisition)
+        {
+            LOG(WARNING) << "Parameter fixed_point is not available in batch acquisition. Setting it to false";
+            fixed_point = false;
+        }
+    const std::string search_strategy = configuration->property(role + ".search_strategy", std::string("full"));
+    if (search_strategy == "folding")
+        {
+            folding_factor = configuration->property(role + ".folding_factor", 2U);
+            if (folding_factor < 2)
+                {
+                    LOG(WARNING) << "Parameter folding_factor should be at least 2. Setting it to 2";
+                    folding_factor = 2;
+                }
+        }
+    else if (search_strategy != "full")
+        {
+            LOG(WARNING) << "Unknown search_strategy " << search_strategy << ". Using the full search";
+        }
+    if ((folding_factor > 1) and (bit_transition_flag or (sampled_ms != ms_per_code) or batch_acquisition))
+        {
+            LOG(WARNING) << "The folding search is only available for single-code snapshots, without bit_transition_flag nor batch acquisition. Using the full search";
+            folding_factor = 1;
+        }
+    if ((folding_factor > 1) and fixed_point)
+        {
+            LOG(WARNING) << "Parameter fixed_point is not available in the folding search. Setting it to false";
+            fixed_point = false;
+        }
+    compute_backend = compute_backend_from_config(configuration, role);
+    if ((compute_backend != Gnss_Compute_Backend::CPU) and (fixed_point or (folding_factor > 1)))
+        {
+            LOG(WARNING) << "The fixed_point and folding searches are not available in the GPU. Using the full floating-point search";
+            fixed_point = false;
+            folding_factor = 1;
+        }
 
     if (pfa <= 0.0)
         {
@@ -93,17 +145,10 @@ void Acq_Conf::ConfigureAutomaticResampler(double opt_freq)
 {
     if (use_automatic_resampler)
         {
-            if (fs_in > opt_freq)
-                {
-                    resampler_ratio = floor(static_cast<float>(fs_in) / opt_freq);
-                    uint32_t decimation = fs_in / opt_freq;
-                    while (fs_in % decimation > 0)
-                        {
-                            decimation--;
-                        };
-                    resampler_ratio = decimation;
-                    resampled_fs = fs_in / static_cast<int>(resampler_ratio);
-                }
+            // same choice as the resampler created by the flowgraph
+            const Resampling_Ratio ratio = acquisition_resampling_ratio(fs_in, opt_freq, resampler_max_interpolation);
+            resampler_ratio = static_cast<float>(ratio.decimation) / static_cast<float>(ratio.interpolation);
+            resampled_fs = fs_in * static_cast<int64_t>(ratio.interpolation) / static_cast<int64_t>(ratio.decimation);
             // --- Find number of samples per spreading code -------------------
             SetDerivedParams();
         }
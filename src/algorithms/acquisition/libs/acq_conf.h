@@ -19,6 +19,7 @@
 #define GNSS_SDR_ACQ_CONF_H
 
 #include "configuration_interface.h"
+#include "gnss_sdr_compute_backend.h"
 #include <gnuradio/gr_complex.h>
 #include <cstdint>
 #include <string>
@@ -61,7 +62,10 @@ public:
     uint32_t max_dwells{1U};
     uint32_t num_doppler_bins_step2{4U};
     uint32_t resampler_latency_samples{0U};
+    uint32_t resampler_max_interpolation{1U};  // 1: integer decimation only
     uint32_t dump_channel{0U};
+    uint32_t threads{1U};
+    uint32_t folding_factor{1U};
     int32_t doppler_max{5000};
     int32_t doppler_min{-5000};
 
@@ -70,9 +74,13 @@ public:
     bool dump{false};
     bool blocking{true};
     bool blocking_on_standby{false};  // enable it only for unit testing to avoid sample consume on idle status
+    bool detach_on_standby{false};    // on idle status, wake up once per half input buffer instead of on every write
     bool make_2_steps{false};
     bool use_automatic_resampler{false};
     bool enable_monitor_output{false};
+    bool batch_acquisition{false};
+    bool fixed_point{false};
+    Gnss_Compute_Backend compute_backend{Gnss_Compute_Backend::CPU};
 
 private:
     void SetDerivedParams();
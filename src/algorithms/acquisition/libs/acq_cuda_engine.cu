@@ -0,0 +1,278 @@
+/*!
+ * \file acq_cuda_engine.cu
+ * \brief PCPS acquisition search computed in a CUDA GPU, with FFTs batched
+ * over the Doppler bins and the searched PRNs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_cuda_engine.h"
+#include "gnss_sdr_cuda_pinned.h"
+#include <cuComplex.h>
+#include <cuda_runtime.h>
+#include <cufft.h>
+#include <algorithm>  // for std::min
+#include <cstring>    // for memcpy
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+const uint32_t THREADS_PER_BLOCK = 256;
+const uint32_t MAX_BLOCKS = 65535;
+
+
+void check_cuda(cudaError_t code, const char* what)
+{
+    if (code != cudaSuccess)
+        {
+            throw std::runtime_error(std::string("CUDA error in ") + what + ": " + cudaGetErrorString(code));
+        }
+}
+
+
+void check_cufft(cufftResult code, const char* what)
+{
+    if (code != CUFFT_SUCCESS)
+        {
+            throw std::runtime_error(std::string("cuFFT error ") + std::to_string(static_cast<int>(code)) + " in " + what);
+        }
+}
+
+
+uint32_t num_blocks(uint32_t total)
+{
+    return std::min((total + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK, MAX_BLOCKS);
+}
+
+
+// out[bin][k] = in[k] * wipeoffs[bin][k]
+__global__ void doppler_wipeoff_kernel(cuFloatComplex* out, const cuFloatComplex* in,
+    const cuFloatComplex* wipeoffs, uint32_t fft_size, uint32_t total)
+{
+    for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < total; i += blockDim.x * gridDim.x)
+        {
+            out[i] = cuCmulf(in[i % fft_size], wipeoffs[i]);
+        }
+}
+
+
+// out[code][bin][k] = signal_fft[bin][k] * codes[code][k]
+__global__ void code_multiply_kernel(cuFloatComplex* out, const cuFloatComplex* signal_fft,
+    const cuFloatComplex* codes, uint32_t fft_size, uint32_t grid_size, uint32_t total)
+{
+    for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < total; i += blockDim.x * gridDim.x)
+        {
+            const uint32_t code = i / grid_size;
+            const uint32_t j = i % grid_size;
+            out[i] = cuCmulf(signal_fft[j], codes[code * fft_size + j % fft_size]);
+        }
+}
+
+
+// out[row][k] = |correlation[row][offset + k]|^2, with effective_fft_size values per row
+__global__ void magnitude_squared_kernel(float* out, const cuFloatComplex* correlation,
+    uint32_t fft_size, uint32_t effective_fft_size, uint32_t offset, uint32_t total)
+{
+    for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < total; i += blockDim.x * gridDim.x)
+        {
+            const uint32_t row = i / effective_fft_size;
+            const cuFloatComplex c = correlation[row * fft_size + offset + i % effective_fft_size];
+            out[i] = c.x * c.x + c.y * c.y;
+        }
+}
+}  // namespace
+
+
+bool Acq_Cuda_Engine::is_available()
+{
+    int num_devices = 0;
+    return (cudaGetDeviceCount(&num_devices) == cudaSuccess) and (num_devices > 0);
+}
+
+
+Acq_Cuda_Engine::Acq_Cuda_Engine(uint32_t fft_size,
+    uint32_t effective_fft_size,
+    uint32_t output_offset,
+    uint32_t max_codes,
+    int device) : d_device(device),
+                  d_fft_size(fft_size),
+                  d_effective_fft_size(effective_fft_size),
+                  d_output_offset(output_offset),
+                  d_max_codes(std::max(max_codes, 1U))
+{
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");
+    d_numa_node = cuda_device_numa_node(d_device);
+    cudaStream_t stream;
+    check_cuda(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking), "cudaStreamCreate");
+    d_stream = stream;
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_input), sizeof(std::complex<float>) * d_fft_size), "cudaMalloc");
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_codes), sizeof(std::complex<float>) * d_fft_size * d_max_codes), "cudaMalloc");
+    check_cuda(cuda_numa_host_alloc(reinterpret_cast<void**>(&d_host_input), sizeof(std::complex<float>) * d_fft_size, d_numa_node, cudaHostRegisterDefault), "cudaHostRegister");
+    check_cuda(cuda_numa_host_alloc(reinterpret_cast<void**>(&d_host_codes), sizeof(std::complex<float>) * d_fft_size * d_max_codes, d_numa_node, cudaHostRegisterDefault), "cudaHostRegister");
+}
+
+
+Acq_Cuda_Engine::~Acq_Cuda_Engine()
+{
+    cudaSetDevice(d_device);
+    free_grid_buffers();
+    for (auto& plan : d_plans)
+        {
+            cufftDestroy(plan.second);
+        }
+    cudaFree(d_gpu_input);
+    cudaFree(d_gpu_codes);
+    cuda_numa_host_free(d_host_input);
+    cuda_numa_host_free(d_host_codes);
+    cudaStreamDestroy(d_stream);
+}
+
+
+void Acq_Cuda_Engine::free_grid_buffers()
+{
+    cudaFree(d_gpu_wipeoffs);
+    cudaFree(d_gpu_signal_fft);
+    cudaFree(d_gpu_correlation);
+    cudaFree(d_gpu_magnitudes);
+    cuda_numa_host_free(d_host_magnitudes);
+    d_gpu_wipeoffs = nullptr;
+    d_gpu_signal_fft = nullptr;
+    d_gpu_correlation = nullptr;
+    d_gpu_magnitudes = nullptr;
+    d_host_magnitudes = nullptr;
+    d_allocated_doppler_bins = 0U;
+}
+
+
+void Acq_Cuda_Engine::allocate_grid_buffers(uint32_t num_doppler_bins)
+{
+    // Buffers only grow, so narrowing and restoring the Doppler range does not reallocate
+    if (num_doppler_bins <= d_allocated_doppler_bins)
+        {
+            return;
+        }
+    free_grid_buffers();
+    const size_t grid_size = static_cast<size_t>(num_doppler_bins) * d_fft_size;
+    const size_t magnitudes_size = static_cast<size_t>(num_doppler_bins) * d_effective_fft_size * d_max_codes;
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_wipeoffs), sizeof(std::complex<float>) * grid_size), "cudaMalloc");
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_signal_fft), sizeof(std::complex<float>) * grid_size), "cudaMalloc");
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_correlation), sizeof(std::complex<float>) * grid_size * d_max_codes), "cudaMalloc");
+    check_cuda(cudaMalloc(reinterpret_cast<void**>(&d_gpu_magnitudes), sizeof(float) * magnitudes_size), "cudaMalloc");
+    check_cuda(cuda_numa_host_alloc(reinterpret_cast<void**>(&d_host_magnitudes), sizeof(float) * magnitudes_size, d_numa_node, cudaHostRegisterDefault), "cudaHostRegister");
+    d_allocated_doppler_bins = num_doppler_bins;
+}
+
+
+int Acq_Cuda_Engine::get_plan(uint32_t batch)
+{
+    auto it = d_plans.find(batch);
+    if (it != d_plans.end())
+        {
+            return it->second;
+        }
+    cufftHandle plan;
+    int n = static_cast<int>(d_fft_size);
+    check_cufft(cufftPlanMany(&plan, 1, &n, nullptr, 1, n, nullptr, 1, n, CUFFT_C2C, static_cast<int>(batch)), "cufftPlanMany");
+    check_cufft(cufftSetStream(plan, d_stream), "cufftSetStream");
+    d_plans[batch] = plan;
+    return plan;
+}
+
+
+void Acq_Cuda_Engine::set_doppler_wipeoffs(const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+    uint32_t num_doppler_bins)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");
+    allocate_grid_buffers(num_doppler_bins);
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            check_cuda(cudaMemcpyAsync(d_gpu_wipeoffs + static_cast<size_t>(doppler_index) * d_fft_size, grid_doppler_wipeoffs[doppler_index].data(),
+                           sizeof(std::complex<float>) * d_fft_size, cudaMemcpyHostToDevice, d_stream),
+                "cudaMemcpyAsync");
+        }
+    check_cuda(cudaStreamSynchronize(d_stream), "cudaStreamSynchronize");
+    d_num_doppler_bins = num_doppler_bins;
+}
+
+
+void Acq_Cuda_Engine::search(const std::complex<float>* input, const std::vector<Job>& jobs)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (jobs.empty() or d_num_doppler_bins == 0)
+        {
+            return;
+        }
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");  // searches run in the thread of any channel
+    const uint32_t grid_size = d_num_doppler_bins * d_fft_size;
+
+    // Doppler wipe-off and forward FFT of all the bins, once for all PRNs
+    memcpy(d_host_input, input, sizeof(std::complex<float>) * d_fft_size);
+    check_cuda(cudaMemcpyAsync(d_gpu_input, d_host_input, sizeof(std::complex<float>) * d_fft_size, cudaMemcpyHostToDevice, d_stream), "cudaMemcpyAsync");
+    doppler_wipeoff_kernel<<<num_blocks(grid_size), THREADS_PER_BLOCK, 0, d_stream>>>(
+        reinterpret_cast<cuFloatComplex*>(d_gpu_signal_fft), reinterpret_cast<const cuFloatComplex*>(d_gpu_input),
+        reinterpret_cast<const cuFloatComplex*>(d_gpu_wipeoffs), d_fft_size, grid_size);
+    check_cuda(cudaGetLastError(), "doppler_wipeoff_kernel");
+    check_cufft(cufftExecC2C(get_plan(d_num_doppler_bins), reinterpret_cast<cufftComplex*>(d_gpu_signal_fft),
+                    reinterpret_cast<cufftComplex*>(d_gpu_signal_fft), CUFFT_FORWARD),
+        "cufftExecC2C");
+
+    for (size_t first_job = 0; first_job < jobs.size(); first_job += d_max_codes)
+        {
+            const auto num_codes = static_cast<uint32_t>(std::min(static_cast<size_t>(d_max_codes), jobs.size() - first_job));
+            for (uint32_t code = 0; code < num_codes; code++)
+                {
+                    memcpy(d_host_codes + static_cast<size_t>(code) * d_fft_size, jobs[first_job + code].fft_code, sizeof(std::complex<float>) * d_fft_size);
+                }
+            check_cuda(cudaMemcpyAsync(d_gpu_codes, d_host_codes, sizeof(std::complex<float>) * d_fft_size * num_codes, cudaMemcpyHostToDevice, d_stream), "cudaMemcpyAsync");
+
+            // Multiplication by the code spectra and inverse FFT of all the bins of all the codes
+            const uint32_t total = num_codes * grid_size;
+            code_multiply_kernel<<<num_blocks(total), THREADS_PER_BLOCK, 0, d_stream>>>(
+                reinterpret_cast<cuFloatComplex*>(d_gpu_correlation), reinterpret_cast<const cuFloatComplex*>(d_gpu_signal_fft),
+                reinterpret_cast<const cuFloatComplex*>(d_gpu_codes), d_fft_size, grid_size, total);
+            check_cuda(cudaGetLastError(), "code_multiply_kernel");
+            check_cufft(cufftExecC2C(get_plan(num_codes * d_num_doppler_bins), reinterpret_cast<cufftComplex*>(d_gpu_correlation),
+                            reinterpret_cast<cufftComplex*>(d_gpu_correlation), CUFFT_INVERSE),
+                "cufftExecC2C");
+
+            const uint32_t num_magnitudes = num_codes * d_num_doppler_bins * d_effective_fft_size;
+            magnitude_squared_kernel<<<num_blocks(num_magnitudes), THREADS_PER_BLOCK, 0, d_stream>>>(
+                d_gpu_magnitudes, reinterpret_cast<const cuFloatComplex*>(d_gpu_correlation),
+                d_fft_size, d_effective_fft_size, d_output_offset, num_magnitudes);
+            check_cuda(cudaGetLastError(), "magnitude_squared_kernel");
+            check_cuda(cudaMemcpyAsync(d_host_magnitudes, d_gpu_magnitudes, sizeof(float) * num_magnitudes, cudaMemcpyDeviceToHost, d_stream), "cudaMemcpyAsync");
+            check_cuda(cudaStreamSynchronize(d_stream), "cudaStreamSynchronize");
+
+            for (uint32_t code = 0; code < num_codes; code++)
+                {
+                    const Job& job = jobs[first_job + code];
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                        {
+                            const float* magnitudes = d_host_magnitudes + (static_cast<size_t>(code) * d_num_doppler_bins + doppler_index) * d_effective_fft_size;
+                            float* row = (*job.magnitude_grid)[doppler_index].data();
+                            if (!job.accumulate)
+                                {
+                                    memcpy(row, magnitudes, sizeof(float) * d_effective_fft_size);
+                                }
+                            else
+                                {
+                                    for (uint32_t i = 0; i < d_effective_fft_size; i++)
+                                        {
+                                            row[i] += magnitudes[i];
+                                        }
+                                }
+                        }
+                }
+        }
+}
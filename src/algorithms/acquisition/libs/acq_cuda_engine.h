@@ -0,0 +1,114 @@
+/*!
+ * \file acq_cuda_engine.h
+ * \brief PCPS acquisition search computed in a CUDA GPU, with FFTs batched
+ * over the Doppler bins and the searched PRNs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_CUDA_ENGINE_H
+#define GNSS_SDR_ACQ_CUDA_ENGINE_H
+
+#include "acq_gpu_engine.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+struct CUstream_st;  // cudaStream_t is a pointer to it
+
+
+/*!
+ * \brief Computes the PCPS search grid of one or several PRNs in a GPU.
+ *
+ * The Doppler wipe-off signals are uploaded once and kept in the device.
+ * Each search uploads the input snapshot, computes the wipe-off and forward
+ * FFT of all the Doppler bins in one batched transform, and then the inverse
+ * FFTs of all the bins of up to max_codes PRNs in another one. Transfers use
+ * pinned host buffers, and all the work is queued in a stream owned by the
+ * engine, so several engines (one per channel or per batch) share the GPU
+ * concurrently. Methods throw std::runtime_error on CUDA errors.
+ */
+class Acq_Cuda_Engine : public Acq_Gpu_Engine
+{
+public:
+    /*!
+     * \brief Returns true if there is at least one CUDA device.
+     */
+    static bool is_available();
+
+    /*!
+     * \brief Creates the engine in the given CUDA device, with its pinned
+     * host buffers on the NUMA node of the device.
+     */
+    Acq_Cuda_Engine(uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset, uint32_t max_codes = 8, int device = 0);
+    ~Acq_Cuda_Engine() override;
+
+    Acq_Cuda_Engine(const Acq_Cuda_Engine&) = delete;
+    Acq_Cuda_Engine& operator=(const Acq_Cuda_Engine&) = delete;
+
+    /*!
+     * \brief Uploads the first num_doppler_bins Doppler wipe-off signals.
+     */
+    void set_doppler_wipeoffs(const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t num_doppler_bins) override;
+
+    /*!
+     * \brief Searches the input snapshot (fft_size samples) with the codes
+     * of the jobs, filling the first num_doppler_bins rows of their
+     * magnitude grids. Returns when the results are in the host.
+     */
+    void search(const std::complex<float>* input, const std::vector<Job>& jobs) override;
+
+private:
+    void allocate_grid_buffers(uint32_t num_doppler_bins);
+    void free_grid_buffers();
+    int get_plan(uint32_t batch);
+
+    std::map<uint32_t, int> d_plans;  // cufftHandle by batch size
+    std::mutex d_mutex;
+    CUstream_st* d_stream{nullptr};
+    int d_device;
+    int d_numa_node{-1};
+
+    // Device buffers
+    std::complex<float>* d_gpu_input{nullptr};
+    std::complex<float>* d_gpu_codes{nullptr};
+    std::complex<float>* d_gpu_wipeoffs{nullptr};
+    std::complex<float>* d_gpu_signal_fft{nullptr};
+    std::complex<float>* d_gpu_correlation{nullptr};
+    float* d_gpu_magnitudes{nullptr};
+
+    // Pinned host buffers
+    std::complex<float>* d_host_input{nullptr};
+    std::complex<float>* d_host_codes{nullptr};
+    float* d_host_magnitudes{nullptr};
+
+    uint32_t d_fft_size;
+    uint32_t d_effective_fft_size;
+    uint32_t d_output_offset;
+    uint32_t d_max_codes;
+    uint32_t d_num_doppler_bins{0U};
+    uint32_t d_allocated_doppler_bins{0U};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_CUDA_ENGINE_H
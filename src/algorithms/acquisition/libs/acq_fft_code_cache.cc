@@ -0,0 +1,114 @@
+/*!
+ * \file acq_fft_code_cache.cc
+ * \brief Process-wide cache of the local code spectra used by the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_fft_code_cache.h"
+#include <tuple>  // for std::tie
+
+
+namespace
+{
+// 64-bit FNV-1a hash of the time-domain replica
+uint64_t code_fingerprint(const std::complex<float>* code, uint32_t code_length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(code);
+    const size_t num_bytes = sizeof(std::complex<float>) * code_length;
+    for (size_t i = 0; i < num_bytes; i++)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 1099511628211ULL;
+        }
+    return hash;
+}
+}  // namespace
+
+
+Acq_Fft_Code_Cache::Key::Key(const char* signal_, uint32_t prn_, int64_t fs_,
+    uint32_t fft_size_, uint32_t code_offset_, const std::complex<float>* code,
+    uint32_t code_length_) : signal(signal_),
+                             fs(fs_),
+                             code_hash(code_fingerprint(code, code_length_)),
+                             prn(prn_),
+                             fft_size(fft_size_),
+                             code_offset(code_offset_),
+                             code_length(code_length_)
+{
+}
+
+
+bool Acq_Fft_Code_Cache::Key::operator<(const Key& other) const
+{
+    return std::tie(signal, prn, fs, fft_size, code_offset, code_length, code_hash) <
+           std::tie(other.signal, other.prn, other.fs, other.fft_size, other.code_offset, other.code_length, other.code_hash);
+}
+
+
+Acq_Fft_Code_Cache& Acq_Fft_Code_Cache::instance()
+{
+    static Acq_Fft_Code_Cache cache;
+    return cache;
+}
+
+
+Acq_Fft_Code_Cache::fft_code_sptr Acq_Fft_Code_Cache::find(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_codes.find(key);
+    if (it == d_codes.cend())
+        {
+            return nullptr;
+        }
+    return it->second.lock();
+}
+
+
+Acq_Fft_Code_Cache::fft_code_sptr Acq_Fft_Code_Cache::insert(const Key& key, const fft_code_sptr& fft_code)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto& entry = d_codes[key];
+    fft_code_sptr stored = entry.lock();
+    if (stored)
+        {
+            return stored;
+        }
+    entry = fft_code;
+    purge_expired();
+    return fft_code;
+}
+
+
+size_t Acq_Fft_Code_Cache::size()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    purge_expired();
+    return d_codes.size();
+}
+
+
+void Acq_Fft_Code_Cache::purge_expired()
+{
+    for (auto it = d_codes.begin(); it != d_codes.end();)
+        {
+            if (it->second.expired())
+                {
+                    it = d_codes.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+}
@@ -0,0 +1,106 @@
+/*!
+ * \file acq_fft_code_cache.h
+ * \brief Process-wide cache of the local code spectra used by the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_FFT_CODE_CACHE_H
+#define GNSS_SDR_ACQ_FFT_CODE_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Read-only, reference-counted store of conjugated FFT-domain local
+ * codes, shared by all the acquisition channels of the receiver.
+ *
+ * Entries are indexed by signal, PRN, sampling rate, FFT length and position
+ * of the code in the FFT input buffer. A hash of the time-domain replica is
+ * also part of the key, so two blocks configured with different code options
+ * (e.g., data vs. pilot components) never share a spectrum. The cache only
+ * keeps weak references: a spectrum is released as soon as no acquisition
+ * block is using it.
+ */
+class Acq_Fft_Code_Cache
+{
+public:
+    using fft_code_sptr = std::shared_ptr<const volk_gnsssdr::vector<std::complex<float>>>;
+
+    /*!
+     * \brief Index of a spectrum in the cache
+     */
+    class Key
+    {
+    public:
+        Key() = default;
+        Key(const char* signal, uint32_t prn, int64_t fs, uint32_t fft_size,
+            uint32_t code_offset, const std::complex<float>* code, uint32_t code_length);
+
+        bool operator<(const Key& other) const;
+
+        std::string signal;
+        int64_t fs{0LL};
+        uint64_t code_hash{0ULL};
+        uint32_t prn{0U};
+        uint32_t fft_size{0U};
+        uint32_t code_offset{0U};
+        uint32_t code_length{0U};
+    };
+
+    /*!
+     * \brief Returns the process-wide cache.
+     */
+    static Acq_Fft_Code_Cache& instance();
+
+    /*!
+     * \brief Returns the spectrum stored at key, or nullptr if no block
+     * is holding it.
+     */
+    fft_code_sptr find(const Key& key);
+
+    /*!
+     * \brief Stores fft_code at key. If another block already stored a
+     * spectrum for the same key, that one is returned instead.
+     */
+    fft_code_sptr insert(const Key& key, const fft_code_sptr& fft_code);
+
+    /*!
+     * \brief Number of spectra currently in use.
+     */
+    size_t size();
+
+private:
+    Acq_Fft_Code_Cache() = default;
+
+    void purge_expired();
+
+    std::map<Key, std::weak_ptr<const volk_gnsssdr::vector<std::complex<float>>>> d_codes;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_FFT_CODE_CACHE_H
@@ -0,0 +1,52 @@
+/*!
+ * \file acq_gpu_engine.cc
+ * \brief Interface of the PCPS acquisition searches computed in an
+ * accelerator (CUDA or OpenCL device).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_gpu_engine.h"
+#if CUDA_GPU_ACCEL
+#include "acq_cuda_engine.h"
+#endif
+#if OPENCL_GPU_ACCEL
+#include "acq_opencl_engine.h"
+#endif
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <stdexcept>
+
+
+std::unique_ptr<Acq_Gpu_Engine> Acq_Gpu_Engine::make(Gnss_Compute_Backend backend,
+    int device __attribute__((unused)),
+    uint32_t fft_size,
+    uint32_t effective_fft_size,
+    uint32_t output_offset,
+    uint32_t max_codes)
+{
+    switch (backend)
+        {
+#if CUDA_GPU_ACCEL
+        case Gnss_Compute_Backend::CUDA:
+            if (!Acq_Cuda_Engine::is_available())
+                {
+                    throw std::runtime_error("No CUDA device found");
+                }
+            return std::make_unique<Acq_Cuda_Engine>(fft_size, effective_fft_size, output_offset, max_codes, device);
+#endif
+#if OPENCL_GPU_ACCEL
+        case Gnss_Compute_Backend::OpenCL:
+            return std::make_unique<Acq_Opencl_Engine>(fft_size, effective_fft_size, output_offset, max_codes);
+#endif
+        default:
+            throw std::runtime_error("The " + compute_backend_to_string(backend) + " backend cannot compute acquisition searches");
+        }
+}
@@ -0,0 +1,88 @@
+/*!
+ * \file acq_gpu_engine.h
+ * \brief Interface of the PCPS acquisition searches computed in an
+ * accelerator (CUDA or OpenCL device).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_GPU_ENGINE_H
+#define GNSS_SDR_ACQ_GPU_ENGINE_H
+
+#include "gnss_sdr_compute_backend.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the PCPS search grid of one or several PRNs in an
+ * accelerator.
+ *
+ * The Doppler wipe-off signals are uploaded once and kept in the device.
+ * Each search computes the wipe-off and forward FFT of all the Doppler bins
+ * of the input snapshot once, and then the inverse FFTs of all the bins of
+ * each searched PRN. Results are the same as the ones of the CPU search, up
+ * to the rounding of the FFTs. Methods throw std::runtime_error on device
+ * errors, so the callers can fall back to the CPU.
+ */
+class Acq_Gpu_Engine
+{
+public:
+    /*!
+     * \brief Search of one PRN
+     */
+    class Job
+    {
+    public:
+        const std::complex<float>* fft_code{nullptr};  // conjugated code spectrum, fft_size samples
+        volk_gnsssdr::vector<volk_gnsssdr::vector<float>>* magnitude_grid{nullptr};
+        bool accumulate{false};  // add to the grid (non-coherent integration) instead of overwriting it
+    };
+
+    /*!
+     * \brief Returns an engine computing in the given backend. The magnitudes
+     * of the effective_fft_size correlation lags starting at output_offset
+     * are returned. device selects the CUDA device (OpenCL uses its default
+     * device). Throws std::runtime_error if the backend is the CPU, was not
+     * built in, has no device, or cannot compute transforms of fft_size
+     * samples.
+     */
+    static std::unique_ptr<Acq_Gpu_Engine> make(Gnss_Compute_Backend backend, int device,
+        uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset, uint32_t max_codes = 8);
+
+    virtual ~Acq_Gpu_Engine() = default;
+
+    /*!
+     * \brief Uploads the first num_doppler_bins Doppler wipe-off signals.
+     */
+    virtual void set_doppler_wipeoffs(const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t num_doppler_bins) = 0;
+
+    /*!
+     * \brief Searches the input snapshot (fft_size samples) with the codes
+     * of the jobs, filling the first num_doppler_bins rows of their
+     * magnitude grids. Returns when the results are in the host.
+     */
+    virtual void search(const std::complex<float>* input, const std::vector<Job>& jobs) = 0;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_GPU_ENGINE_H
@@ -0,0 +1,292 @@
+/*!
+ * \file acq_opencl_engine.cc
+ * \brief PCPS acquisition search computed in an OpenCL device, with FFTs
+ * batched over the Doppler bins and the searched PRNs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_opencl_engine.h"
+#include "clFFT.h"
+#include <algorithm>  // for std::min, std::max
+#include <cstring>    // for memcpy
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+// Same operations as the kernels of Acq_Cuda_Engine
+const char* ACQ_OPENCL_KERNELS = R"(
+__kernel void doppler_wipeoff(__global float2* out, __global const float2* in,
+    __global const float2* wipeoffs, uint fft_size, uint total)
+{
+    const uint i = get_global_id(0);
+    if (i < total)
+        {
+            const float2 a = in[i % fft_size];
+            const float2 b = wipeoffs[i];
+            out[i] = (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+        }
+}
+
+__kernel void code_multiply(__global float2* out, __global const float2* signal_fft,
+    __global const float2* codes, uint fft_size, uint grid_size, uint total)
+{
+    const uint i = get_global_id(0);
+    if (i < total)
+        {
+            const uint j = i % grid_size;
+            const float2 a = signal_fft[j];
+            const float2 b = codes[(i / grid_size) * fft_size + j % fft_size];
+            out[i] = (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+        }
+}
+
+__kernel void magnitude_squared(__global float* out, __global const float2* correlation,
+    uint fft_size, uint effective_fft_size, uint offset, uint total)
+{
+    const uint i = get_global_id(0);
+    if (i < total)
+        {
+            const float2 c = correlation[(i / effective_fft_size) * fft_size + offset + i % effective_fft_size];
+            out[i] = c.x * c.x + c.y * c.y;
+        }
+}
+)";
+
+
+cl_mem create_buffer(cl_context context, size_t size)
+{
+    cl_int err = CL_SUCCESS;
+    cl_mem buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, size, nullptr, &err);
+    check_opencl(err, "clCreateBuffer");
+    return buffer;
+}
+
+
+void release_buffer(cl_mem& buffer)
+{
+    if (buffer != nullptr)
+        {
+            clReleaseMemObject(buffer);
+            buffer = nullptr;
+        }
+}
+}  // namespace
+
+
+Acq_Opencl_Engine::Acq_Opencl_Engine(uint32_t fft_size,
+    uint32_t effective_fft_size,
+    uint32_t output_offset,
+    uint32_t max_codes) : d_fft_size(fft_size),
+                          d_effective_fft_size(effective_fft_size),
+                          d_output_offset(output_offset),
+                          d_max_codes(std::max(max_codes, 1U))
+{
+    if (fft_size == 0 or (fft_size & (fft_size - 1)) != 0)
+        {
+            throw std::runtime_error("The OpenCL FFT requires a power of two length, got " + std::to_string(fft_size));
+        }
+    d_context = Gnss_Opencl_Context::get();
+    try
+        {
+            d_queue = d_context->create_queue();
+            d_program = d_context->build_program(ACQ_OPENCL_KERNELS);
+            cl_int err = CL_SUCCESS;
+            d_wipeoff_kernel = clCreateKernel(d_program, "doppler_wipeoff", &err);
+            check_opencl(err, "clCreateKernel");
+            d_multiply_kernel = clCreateKernel(d_program, "code_multiply", &err);
+            check_opencl(err, "clCreateKernel");
+            d_magnitude_kernel = clCreateKernel(d_program, "magnitude_squared", &err);
+            check_opencl(err, "clCreateKernel");
+            const clFFT_Dim3 dim = {fft_size, 1, 1};
+            d_fft_plan = clFFT_CreatePlan(d_context->context(), dim, clFFT_1D, clFFT_InterleavedComplexFormat, &err);
+            check_opencl(err, "clFFT_CreatePlan");
+            d_cl_input = create_buffer(d_context->context(), sizeof(std::complex<float>) * d_fft_size);
+            d_cl_codes = create_buffer(d_context->context(), sizeof(std::complex<float>) * d_fft_size * d_max_codes);
+        }
+    catch (const std::runtime_error&)
+        {
+            release();
+            throw;
+        }
+}
+
+
+Acq_Opencl_Engine::~Acq_Opencl_Engine()
+{
+    release();
+}
+
+
+void Acq_Opencl_Engine::release()
+{
+    free_grid_buffers();
+    release_buffer(d_cl_input);
+    release_buffer(d_cl_codes);
+    if (d_fft_plan != nullptr)
+        {
+            clFFT_DestroyPlan(d_fft_plan);
+            d_fft_plan = nullptr;
+        }
+    for (auto* kernel : {d_wipeoff_kernel, d_multiply_kernel, d_magnitude_kernel})
+        {
+            if (kernel != nullptr)
+                {
+                    clReleaseKernel(kernel);
+                }
+        }
+    d_wipeoff_kernel = nullptr;
+    d_multiply_kernel = nullptr;
+    d_magnitude_kernel = nullptr;
+    if (d_program != nullptr)
+        {
+            clReleaseProgram(d_program);
+            d_program = nullptr;
+        }
+    if (d_queue != nullptr)
+        {
+            clReleaseCommandQueue(d_queue);
+            d_queue = nullptr;
+        }
+}
+
+
+void Acq_Opencl_Engine::free_grid_buffers()
+{
+    release_buffer(d_cl_wipeoffs);
+    release_buffer(d_cl_signal_fft);
+    release_buffer(d_cl_correlation);
+    release_buffer(d_cl_magnitudes);
+    d_allocated_doppler_bins = 0U;
+}
+
+
+void Acq_Opencl_Engine::allocate_grid_buffers(uint32_t num_doppler_bins)
+{
+    // Buffers only grow, so narrowing and restoring the Doppler range does not reallocate
+    if (num_doppler_bins <= d_allocated_doppler_bins)
+        {
+            return;
+        }
+    free_grid_buffers();
+    const size_t grid_size = static_cast<size_t>(num_doppler_bins) * d_fft_size;
+    const size_t magnitudes_size = static_cast<size_t>(num_doppler_bins) * d_effective_fft_size * d_max_codes;
+    d_cl_wipeoffs = create_buffer(d_context->context(), sizeof(std::complex<float>) * grid_size);
+    d_cl_signal_fft = create_buffer(d_context->context(), sizeof(std::complex<float>) * grid_size);
+    d_cl_correlation = create_buffer(d_context->context(), sizeof(std::complex<float>) * grid_size * d_max_codes);
+    d_cl_magnitudes = create_buffer(d_context->context(), sizeof(float) * magnitudes_size);
+    d_host_magnitudes.resize(magnitudes_size);
+    d_allocated_doppler_bins = num_doppler_bins;
+}
+
+
+void Acq_Opencl_Engine::run_kernel(cl_kernel kernel, size_t total)
+{
+    check_opencl(clEnqueueNDRangeKernel(d_queue, kernel, 1, nullptr, &total, nullptr, 0, nullptr, nullptr), "clEnqueueNDRangeKernel");
+}
+
+
+void Acq_Opencl_Engine::set_doppler_wipeoffs(const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+    uint32_t num_doppler_bins)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    allocate_grid_buffers(num_doppler_bins);
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_wipeoffs, CL_FALSE, sizeof(std::complex<float>) * doppler_index * d_fft_size,
+                             sizeof(std::complex<float>) * d_fft_size, grid_doppler_wipeoffs[doppler_index].data(), 0, nullptr, nullptr),
+                "clEnqueueWriteBuffer");
+        }
+    check_opencl(clFinish(d_queue), "clFinish");
+    d_num_doppler_bins = num_doppler_bins;
+}
+
+
+void Acq_Opencl_Engine::search(const std::complex<float>* input, const std::vector<Job>& jobs)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (jobs.empty() or d_num_doppler_bins == 0)
+        {
+            return;
+        }
+    const uint32_t grid_size = d_num_doppler_bins * d_fft_size;
+
+    // Doppler wipe-off and forward FFT of all the bins, once for all PRNs.
+    // Writes are not blocking: the sources are valid until the clFinish() below.
+    check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_input, CL_FALSE, 0, sizeof(std::complex<float>) * d_fft_size, input, 0, nullptr, nullptr), "clEnqueueWriteBuffer");
+    clSetKernelArg(d_wipeoff_kernel, 0, sizeof(cl_mem), &d_cl_signal_fft);
+    clSetKernelArg(d_wipeoff_kernel, 1, sizeof(cl_mem), &d_cl_input);
+    clSetKernelArg(d_wipeoff_kernel, 2, sizeof(cl_mem), &d_cl_wipeoffs);
+    clSetKernelArg(d_wipeoff_kernel, 3, sizeof(cl_uint), &d_fft_size);
+    clSetKernelArg(d_wipeoff_kernel, 4, sizeof(cl_uint), &grid_size);
+    run_kernel(d_wipeoff_kernel, grid_size);
+    check_opencl(clFFT_ExecuteInterleaved(d_queue, d_fft_plan, static_cast<cl_int>(d_num_doppler_bins), clFFT_Forward,
+                     d_cl_signal_fft, d_cl_signal_fft, 0, nullptr, nullptr),
+        "clFFT_ExecuteInterleaved");
+
+    for (size_t first_job = 0; first_job < jobs.size(); first_job += d_max_codes)
+        {
+            const auto num_codes = static_cast<uint32_t>(std::min(static_cast<size_t>(d_max_codes), jobs.size() - first_job));
+            for (uint32_t code = 0; code < num_codes; code++)
+                {
+                    check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_codes, CL_FALSE, sizeof(std::complex<float>) * code * d_fft_size,
+                                     sizeof(std::complex<float>) * d_fft_size, jobs[first_job + code].fft_code, 0, nullptr, nullptr),
+                        "clEnqueueWriteBuffer");
+                }
+
+            // Multiplication by the code spectra and inverse FFT of all the bins of all the codes
+            const uint32_t total = num_codes * grid_size;
+            clSetKernelArg(d_multiply_kernel, 0, sizeof(cl_mem), &d_cl_correlation);
+            clSetKernelArg(d_multiply_kernel, 1, sizeof(cl_mem), &d_cl_signal_fft);
+            clSetKernelArg(d_multiply_kernel, 2, sizeof(cl_mem), &d_cl_codes);
+            clSetKernelArg(d_multiply_kernel, 3, sizeof(cl_uint), &d_fft_size);
+            clSetKernelArg(d_multiply_kernel, 4, sizeof(cl_uint), &grid_size);
+            clSetKernelArg(d_multiply_kernel, 5, sizeof(cl_uint), &total);
+            run_kernel(d_multiply_kernel, total);
+            check_opencl(clFFT_ExecuteInterleaved(d_queue, d_fft_plan, static_cast<cl_int>(num_codes * d_num_doppler_bins), clFFT_Inverse,
+                             d_cl_correlation, d_cl_correlation, 0, nullptr, nullptr),
+                "clFFT_ExecuteInterleaved");
+
+            const uint32_t num_magnitudes = num_codes * d_num_doppler_bins * d_effective_fft_size;
+            clSetKernelArg(d_magnitude_kernel, 0, sizeof(cl_mem), &d_cl_magnitudes);
+            clSetKernelArg(d_magnitude_kernel, 1, sizeof(cl_mem), &d_cl_correlation);
+            clSetKernelArg(d_magnitude_kernel, 2, sizeof(cl_uint), &d_fft_size);
+            clSetKernelArg(d_magnitude_kernel, 3, sizeof(cl_uint), &d_effective_fft_size);
+            clSetKernelArg(d_magnitude_kernel, 4, sizeof(cl_uint), &d_output_offset);
+            clSetKernelArg(d_magnitude_kernel, 5, sizeof(cl_uint), &num_magnitudes);
+            run_kernel(d_magnitude_kernel, num_magnitudes);
+            check_opencl(clEnqueueReadBuffer(d_queue, d_cl_magnitudes, CL_TRUE, 0, sizeof(float) * num_magnitudes, d_host_magnitudes.data(), 0, nullptr, nullptr),
+                "clEnqueueReadBuffer");
+
+            for (uint32_t code = 0; code < num_codes; code++)
+                {
+                    const Job& job = jobs[first_job + code];
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                        {
+                            const float* magnitudes = d_host_magnitudes.data() + (static_cast<size_t>(code) * d_num_doppler_bins + doppler_index) * d_effective_fft_size;
+                            float* row = (*job.magnitude_grid)[doppler_index].data();
+                            if (!job.accumulate)
+                                {
+                                    memcpy(row, magnitudes, sizeof(float) * d_effective_fft_size);
+                                }
+                            else
+                                {
+                                    for (uint32_t i = 0; i < d_effective_fft_size; i++)
+                                        {
+                                            row[i] += magnitudes[i];
+                                        }
+                                }
+                        }
+                }
+        }
+}
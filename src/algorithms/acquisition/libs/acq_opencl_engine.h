@@ -0,0 +1,92 @@
+/*!
+ * \file acq_opencl_engine.h
+ * \brief PCPS acquisition search computed in an OpenCL device, with FFTs
+ * batched over the Doppler bins and the searched PRNs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_OPENCL_ENGINE_H
+#define GNSS_SDR_ACQ_OPENCL_ENGINE_H
+
+#include "acq_gpu_engine.h"
+#include "gnss_sdr_opencl.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the PCPS search grid of one or several PRNs in the OpenCL
+ * device of the receiver.
+ *
+ * Same algorithm as Acq_Cuda_Engine, for any GPU vendor. The FFTs are
+ * computed by the clFFT library bundled in libs/opencl, in batches over all
+ * the Doppler bins and up to max_codes PRNs, which requires fft_size to be a
+ * power of two: the constructor throws std::runtime_error otherwise, so
+ * searches of other lengths stay in the CPU.
+ */
+class Acq_Opencl_Engine : public Acq_Gpu_Engine
+{
+public:
+    Acq_Opencl_Engine(uint32_t fft_size, uint32_t effective_fft_size, uint32_t output_offset, uint32_t max_codes = 8);
+    ~Acq_Opencl_Engine() override;
+
+    Acq_Opencl_Engine(const Acq_Opencl_Engine&) = delete;
+    Acq_Opencl_Engine& operator=(const Acq_Opencl_Engine&) = delete;
+
+    void set_doppler_wipeoffs(const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t num_doppler_bins) override;
+
+    void search(const std::complex<float>* input, const std::vector<Job>& jobs) override;
+
+private:
+    void allocate_grid_buffers(uint32_t num_doppler_bins);
+    void free_grid_buffers();
+    void release();
+    void run_kernel(cl_kernel kernel, size_t total);
+
+    std::shared_ptr<Gnss_Opencl_Context> d_context;
+    std::mutex d_mutex;
+    cl_command_queue d_queue{nullptr};
+    cl_program d_program{nullptr};
+    cl_kernel d_wipeoff_kernel{nullptr};
+    cl_kernel d_multiply_kernel{nullptr};
+    cl_kernel d_magnitude_kernel{nullptr};
+    void* d_fft_plan{nullptr};  // clFFT_Plan
+
+    // Device buffers
+    cl_mem d_cl_input{nullptr};
+    cl_mem d_cl_codes{nullptr};
+    cl_mem d_cl_wipeoffs{nullptr};
+    cl_mem d_cl_signal_fft{nullptr};
+    cl_mem d_cl_correlation{nullptr};
+    cl_mem d_cl_magnitudes{nullptr};
+
+    std::vector<float> d_host_magnitudes;
+
+    uint32_t d_fft_size;
+    uint32_t d_effective_fft_size;
+    uint32_t d_output_offset;
+    uint32_t d_max_codes;
+    uint32_t d_num_doppler_bins{0U};
+    uint32_t d_allocated_doppler_bins{0U};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_OPENCL_ENGINE_H
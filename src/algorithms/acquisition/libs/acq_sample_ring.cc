@@ -0,0 +1,77 @@
+/*!
+ * \file acq_sample_ring.cc
+ * \brief Ring of input samples shared by all the acquisition channels of a
+ * signal, read in place at given sample stamps.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sample_ring.h"
+#include <algorithm>
+#include <cstring>
+
+
+Acq_Sample_Ring::Acq_Sample_Ring(size_t capacity)
+    : d_buffer(2 * std::max(capacity, static_cast<size_t>(1))),
+      d_capacity(std::max(capacity, static_cast<size_t>(1)))
+{
+}
+
+
+void Acq_Sample_Ring::write(const std::complex<float>* samples, size_t n)
+{
+    const uint64_t head = d_written.load(std::memory_order_relaxed);
+    const uint64_t end = head + n;
+
+    // Readers check d_reserved after reading, so it has to be visible before
+    // any of the samples it covers is modified
+    d_reserved.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // only the last d_capacity samples would survive
+    uint64_t stamp = head;
+    if (n > d_capacity)
+        {
+            samples += n - d_capacity;
+            stamp += n - d_capacity;
+            n = d_capacity;
+        }
+    while (n > 0)
+        {
+            const size_t position = stamp % d_capacity;
+            const size_t length = std::min(n, d_capacity - position);
+            memcpy(&d_buffer[position], samples, sizeof(std::complex<float>) * length);
+            memcpy(&d_buffer[position + d_capacity], samples, sizeof(std::complex<float>) * length);
+            samples += length;
+            stamp += length;
+            n -= length;
+        }
+
+    d_written.store(end, std::memory_order_release);
+}
+
+
+const std::complex<float>* Acq_Sample_Ring::snapshot(uint64_t stamp, size_t n) const
+{
+    if (n > d_capacity or stamp + n > written() or !intact(stamp))
+        {
+            return nullptr;
+        }
+    return &d_buffer[stamp % d_capacity];
+}
+
+
+bool Acq_Sample_Ring::intact(uint64_t stamp) const
+{
+    // the samples read before this call happen before the load below
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return stamp + d_capacity >= d_reserved.load(std::memory_order_relaxed);
+}
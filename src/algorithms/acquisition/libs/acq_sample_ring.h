@@ -0,0 +1,88 @@
+/*!
+ * \file acq_sample_ring.h
+ * \brief Ring of input samples shared by all the acquisition channels of a
+ * signal, read in place at given sample stamps.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SAMPLE_RING_H
+#define GNSS_SDR_ACQ_SAMPLE_RING_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Last capacity() samples of a stream, addressed by their sample stamp.
+ *
+ * There is one writer, which never waits, and any number of readers. Every
+ * sample is stored twice, capacity() positions apart, so that any window of
+ * up to capacity() samples is contiguous and can be read in place. Readers
+ * do not hold the samples: a snapshot stays valid until the writer has gone
+ * capacity() samples past its first stamp, which readers check with intact()
+ * once they are done with it.
+ */
+class Acq_Sample_Ring
+{
+public:
+    explicit Acq_Sample_Ring(size_t capacity);
+
+    /*!
+     * \brief Appends n samples, which take the next sample stamps.
+     */
+    void write(const std::complex<float>* samples, size_t n);
+
+    /*!
+     * \brief Sample stamp of the next sample to be written, that is, number of
+     * samples written so far.
+     */
+    uint64_t written() const
+    {
+        return d_written.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Returns the samples with stamps [stamp, stamp + n), or nullptr if
+     * they are not written yet or have already been overwritten.
+     */
+    const std::complex<float>* snapshot(uint64_t stamp, size_t n) const;
+
+    /*!
+     * \brief Returns true if the samples from stamp on have not started to be
+     * overwritten.
+     */
+    bool intact(uint64_t stamp) const;
+
+    size_t capacity() const
+    {
+        return d_capacity;
+    }
+
+private:
+    volk_gnsssdr::vector<std::complex<float>> d_buffer;  // 2 * d_capacity
+    std::atomic<uint64_t> d_written{0};                  // samples completely written
+    std::atomic<uint64_t> d_reserved{0};                 // samples completely or partially written
+    size_t d_capacity;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SAMPLE_RING_H
@@ -22,12 +22,18 @@
 #include "fpga_acquisition.h"
 #include "MATH_CONSTANTS.h"  // for TWO_PI
 #include <glog/logging.h>    // for LOG
+#include <algorithm>         // for max
 #include <cmath>             // for log2
-#include <fcntl.h>           // libraries used by the GIPO
-#include <iostream>          // for operator<<
-#include <sys/mman.h>        // libraries used by the GIPO
-#include <unistd.h>          // for write, close, read, ssize_t
-#include <utility>           // for move
+#include <condition_variable>
+#include <deque>       // for deque
+#include <fcntl.h>     // libraries used by the GIPO
+#include <iostream>    // for operator<<
+#include <map>         // for map
+#include <memory>      // for unique_ptr, make_unique
+#include <mutex>       // for mutex, lock_guard, unique_lock
+#include <sys/mman.h>  // libraries used by the GIPO
+#include <unistd.h>    // for write, close, read, ssize_t
+#include <utility>     // for move
 
 
 #ifndef TEMP_FAILURE_RETRY
@@ -44,6 +50,52 @@
 #endif
 
 
+namespace
+{
+// State of an acquisition module shared by all the Fpga_Acquisition objects
+// that use its code banks. In pipelined mode, the search reads one bank while
+// the code of the next queued request is written to another one.
+struct Acquisition_Module
+{
+    struct Request
+    {
+        const void *owner;
+        const uint32_t *code;  // nullptr if the request does not search a code
+        uint32_t length;
+    };
+
+    explicit Acquisition_Module(uint32_t num_banks) : banks(num_banks) {}
+
+    std::mutex mutex;
+    std::condition_variable released;
+    std::deque<Request> waiting;
+    Fpga_Code_Bank_Cache banks;
+    uint32_t search_bank{0};
+    bool busy{false};
+};
+
+
+Acquisition_Module &acquisition_module(const std::string &device_name, uint32_t num_banks)
+{
+    static std::mutex modules_mutex;
+    static std::map<std::string, std::unique_ptr<Acquisition_Module>> modules;
+    const std::lock_guard<std::mutex> lock(modules_mutex);
+    auto &module = modules[device_name];
+    if (!module)
+        {
+            module = std::make_unique<Acquisition_Module>(num_banks);
+        }
+    return *module;
+}
+
+
+uint64_t code_key(const uint32_t *code)
+{
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(code));
+}
+}  // namespace
+
+
 Fpga_Acquisition::Fpga_Acquisition(std::string device_name,
     uint32_t nsamples,
     uint32_t doppler_max,
@@ -51,19 +103,23 @@ Fpga_Acquisition::Fpga_Acquisition(std::string device_name,
     int64_t fs_in,
     uint32_t select_queue,
     uint32_t *all_fft_codes,
-    uint32_t excludelimit) : d_device_name(std::move(device_name)),
-                             d_fs_in(fs_in),
-                             d_fd(0),              // driver descriptor
-                             d_map_base(nullptr),  // driver memory map
-                             d_all_fft_codes(all_fft_codes),
-                             d_vector_length(nsamples_total),
-                             d_excludelimit(excludelimit),
-                             d_nsamples_total(nsamples_total),
-                             d_nsamples(nsamples),  // number of samples not including padding
-                             d_select_queue(select_queue),
-                             d_doppler_max(doppler_max),
-                             d_doppler_step(0),
-                             d_PRN(0)
+    uint32_t excludelimit,
+    bool pipelined,
+    uint32_t code_banks) : d_device_name(std::move(device_name)),
+                           d_fs_in(fs_in),
+                           d_fd(0),              // driver descriptor
+                           d_map_base(nullptr),  // driver memory map
+                           d_all_fft_codes(all_fft_codes),
+                           d_vector_length(nsamples_total),
+                           d_excludelimit(excludelimit),
+                           d_nsamples_total(nsamples_total),
+                           d_nsamples(nsamples),  // number of samples not including padding
+                           d_select_queue(select_queue),
+                           d_doppler_max(doppler_max),
+                           d_doppler_step(0),
+                           d_PRN(0),
+                           d_code_banks(pipelined ? std::max(code_banks, 2U) : code_banks),
+                           d_pipelined(pipelined)
 {
     Fpga_Acquisition::open_device();
     Fpga_Acquisition::reset_acquisition();
@@ -84,17 +140,100 @@ bool Fpga_Acquisition::set_local_code(uint32_t PRN)
 
 void Fpga_Acquisition::write_local_code()
 {
+    if (d_code_banks < 2)
+        {
+            d_map_base[9] = LOCAL_CODE_CLEAR_MEM;
+            // write local code
+            for (uint32_t k = 0; k < d_vector_length; k++)
+                {
+                    d_map_base[6] = d_all_fft_codes[d_nsamples_total * (d_PRN - 1) + k];
+                }
+            return;
+        }
+
+    // no search is running while this object owns the module
+    Acquisition_Module &module = acquisition_module(d_device_name, d_code_banks);
+    const uint32_t *code = local_code();
+    bool resident = false;
+    uint32_t bank;
+    {
+        const std::lock_guard<std::mutex> lock(module.mutex);
+        bank = module.banks.assign(code_key(code), resident);
+        module.search_bank = bank;
+    }
+    if (resident)
+        {
+            d_map_base[13] = bank | (bank << 8);  // search the selected bank
+        }
+    else
+        {
+            upload_local_code(code, d_vector_length, bank, bank);
+        }
+}
+
+
+const uint32_t *Fpga_Acquisition::local_code() const
+{
+    if (d_PRN == 0)
+        {
+            return nullptr;
+        }
+    return d_all_fft_codes + static_cast<size_t>(d_nsamples_total) * (d_PRN - 1);
+}
+
+
+void Fpga_Acquisition::upload_local_code(const uint32_t *code, uint32_t length, uint32_t write_bank, uint32_t search_bank)
+{
+    // bits 7:0 of register 13 select the bank read by the search, and bits 15:8 the bank written by registers 6 and 9
+    d_map_base[13] = search_bank | (write_bank << 8);
     d_map_base[9] = LOCAL_CODE_CLEAR_MEM;
-    // write local code
-    for (uint32_t k = 0; k < d_vector_length; k++)
+    for (uint32_t k = 0; k < length; k++)
         {
-            d_map_base[6] = d_all_fft_codes[d_nsamples_total * (d_PRN - 1) + k];
+            d_map_base[6] = code[k];
         }
 }
 
 
+void Fpga_Acquisition::preload_next_local_code()
+{
+    // write the code of the next queued request to another bank while the current search runs
+    Acquisition_Module &module = acquisition_module(d_device_name, d_code_banks);
+    const uint32_t *code = nullptr;
+    uint32_t length = 0;
+    uint32_t search_bank;
+    uint32_t bank;
+    {
+        const std::lock_guard<std::mutex> lock(module.mutex);
+        if (module.waiting.empty() or module.waiting.front().code == nullptr)
+            {
+                return;
+            }
+        code = module.waiting.front().code;
+        length = module.waiting.front().length;
+        search_bank = module.search_bank;
+        bool resident = false;
+        bank = module.banks.assign(code_key(code), resident, search_bank);
+        if (resident)
+            {
+                return;
+            }
+    }
+    upload_local_code(code, length, bank, search_bank);
+}
+
+
 void Fpga_Acquisition::open_device()
 {
+    if (d_pipelined)
+        {
+            Acquisition_Module &module = acquisition_module(d_device_name, d_code_banks);
+            std::unique_lock<std::mutex> lock(module.mutex);
+            module.waiting.push_back({this, local_code(), d_vector_length});
+            module.released.wait(lock, [this, &module] { return !module.busy and module.waiting.front().owner == this; });
+            module.waiting.pop_front();
+            module.busy = true;
+        }
+
     // open communication with HW accelerator
     if ((d_fd = open(d_device_name.c_str(), O_RDWR | O_SYNC)) == -1)
         {
@@ -146,6 +285,10 @@ void Fpga_Acquisition::run_acquisition()
 
     // launch the acquisition process
     d_map_base[8] = LAUNCH_ACQUISITION;  // writing a 1 to reg 8 launches the acquisition process
+    if (d_pipelined)
+        {
+            Fpga_Acquisition::preload_next_local_code();
+        }
     int32_t irq_count;
 
     // wait for interrupt
@@ -232,11 +375,23 @@ void Fpga_Acquisition::close_device()
             std::cout << "Failed to unmap memory uio\n";
         }
     close(d_fd);
+
+    if (d_pipelined)
+        {
+            Acquisition_Module &module = acquisition_module(d_device_name, d_code_banks);
+            {
+                const std::lock_guard<std::mutex> lock(module.mutex);
+                module.busy = false;
+            }
+            module.released.notify_all();
+        }
 }
 
 
 void Fpga_Acquisition::reset_acquisition()
 {
+    // the reset clears the code banks of all the FPGA modules
+    Fpga_Code_Bank_Cache::invalidate_all();
     d_map_base[8] = RESET_ACQUISITION;  // setting bit 2 of d_map_base[8] resets the acquisition. This causes a reset of all
                                         // the FPGA HW modules including the multicorrelators
 }
@@ -22,6 +22,7 @@
 #ifndef GNSS_SDR_FPGA_ACQUISITION_H
 #define GNSS_SDR_FPGA_ACQUISITION_H
 
+#include "fpga_code_bank_cache.h"
 #include <cstdint>
 #include <string>
 
@@ -48,7 +49,9 @@ public:
         int64_t fs_in,
         uint32_t select_queue,
         uint32_t *all_fft_codes,
-        uint32_t excludelimit);
+        uint32_t excludelimit,
+        bool pipelined = false,
+        uint32_t code_banks = 1);
 
     /*!
      * \brief Destructor
@@ -121,7 +124,8 @@ public:
     void set_block_exp(uint32_t total_block_exp);
 
     /*!
-     * \brief Write the PRN code in the FPGA
+     * \brief Write the PRN code in the FPGA. If the module has several code
+     * banks, the upload is skipped when the code is already in one of them.
      */
     void write_local_code(void);
 
@@ -131,7 +135,8 @@ public:
     void configure_acquisition(void);
 
     /*!
-     * \brief Open the device driver
+     * \brief Open the device driver. In pipelined mode, this waits in a FIFO
+     * queue until the other users of the acquisition module release it.
      */
     void open_device();
 
@@ -160,6 +165,9 @@ private:
     // FPGA private functions
     void fpga_acquisition_test_register(void);
     void read_result_valid(uint32_t *result_valid);
+    const uint32_t *local_code() const;
+    void upload_local_code(const uint32_t *code, uint32_t length, uint32_t write_bank, uint32_t search_bank);
+    void preload_next_local_code();
 
     std::string d_device_name;  // HW device name
 
@@ -176,6 +184,8 @@ private:
     uint32_t d_doppler_max;     // max doppler
     uint32_t d_doppler_step;    // doppler step
     uint32_t d_PRN;             // PRN
+    uint32_t d_code_banks;      // number of code banks of the module
+    bool d_pipelined;           // queued requests, code of the next one uploaded during the search
 };
 
 
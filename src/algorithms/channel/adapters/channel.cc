@@ -23,6 +23,8 @@
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::min
 #include <stdexcept>  // for std::invalid_argument
 #include <utility>    // for std::move
 
@@ -34,7 +36,7 @@ Channel::Channel(const ConfigurationInterface* configuration,
     std::shared_ptr<TelemetryDecoderInterface> nav,
     const std::string& role,
     const std::string& signal_str,
-    Concurrent_Queue<pmt::pmt_t>* queue) : acq_(std::move(acq)),
+    Control_Queue* queue) : acq_(std::move(acq)),
                                            trk_(std::move(trk)),
                                            nav_(std::move(nav)),
                                            role_(role),
@@ -80,6 +82,17 @@ Channel::Channel(const ConfigurationInterface* configuration,
 
     acq_->set_doppler_step(doppler_step);
 
+    doppler_max_ = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".doppler_max", 0);
+    if (doppler_max_ == 0)
+        {
+            doppler_max_ = configuration->property("Acquisition_" + signal_str + ".doppler_max", 5000);
+        }
+    if (FLAGS_doppler_max != 0)
+        {
+            doppler_max_ = static_cast<uint32_t>(FLAGS_doppler_max);
+        }
+    doppler_window_narrowed_ = false;
+
     float threshold = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".threshold", static_cast<float>(0.0));
     if (threshold == 0.0)
         {
@@ -123,6 +136,12 @@ void Channel::connect(gr::top_block_sptr top_block)
 
     nav_->connect(top_block);
 
+    if (trk_->get_right_block()->output_signature()->sizeof_stream_item(0) != nav_->get_left_block()->input_signature()->sizeof_stream_item(0))
+        {
+            std::string msg = trk_->implementation() + " and " + nav_->implementation() + " do not exchange the same items. GNSS-SDR.compact_tracking_records=true is only supported by the DLL_PLL_VEML tracking implementations\n";
+            throw std::invalid_argument(msg);
+        }
+
     // Synchronous ports
     top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
 
@@ -236,9 +255,76 @@ void Channel::stop_channel()
 }
 
 
+bool Channel::start_tracking_handoff(double Acq_delay_samples, double Acq_doppler_hz, uint64_t Acq_samplestamp_samples)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    if (flag_enable_fpga_)
+        {
+            return false;
+        }
+    gnss_synchro_.Acq_delay_samples = Acq_delay_samples;
+    gnss_synchro_.Acq_doppler_hz = Acq_doppler_hz;
+    gnss_synchro_.Acq_samplestamp_samples = Acq_samplestamp_samples;
+    gnss_synchro_.Acq_doppler_step = 0U;
+    gnss_synchro_.Flag_valid_acquisition = true;
+    if (!channel_fsm_->Event_start_tracking_handoff())
+        {
+            LOG(WARNING) << "Invalid channel event";
+            return false;
+        }
+    DLOG(INFO) << "Channel " << channel_ << " tracking handoff of " << gnss_signal_
+               << ": Doppler " << Acq_doppler_hz << " [Hz], code phase " << Acq_delay_samples << " [samples]";
+    return true;
+}
+
+
 void Channel::assist_acquisition_doppler(double Carrier_Doppler_hz)
 {
+    std::lock_guard<std::mutex> lk(mx_);
+    if (doppler_window_narrowed_)
+        {
+            acq_->set_doppler_max(doppler_max_);
+            doppler_window_narrowed_ = false;
+        }
+    acq_->set_doppler_center(static_cast<int>(Carrier_Doppler_hz));
+}
+
+
+void Channel::assist_acquisition_doppler_window(double Carrier_Doppler_hz, uint32_t Doppler_window_hz)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    const uint32_t doppler_max = std::min(Doppler_window_hz, doppler_max_);
+    acq_->set_doppler_max(doppler_max);
+    doppler_window_narrowed_ = (doppler_max != doppler_max_);
     acq_->set_doppler_center(static_cast<int>(Carrier_Doppler_hz));
+    DLOG(INFO) << "Channel " << channel_ << " assisted acquisition of " << gnss_signal_
+               << ": Doppler " << Carrier_Doppler_hz << " +/- " << doppler_max << " [Hz]";
+}
+
+
+void Channel::set_acquisition_threshold(float threshold)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    acq_->set_threshold(threshold);
+    DLOG(INFO) << "Channel " << channel_ << " acquisition threshold set to " << threshold;
+}
+
+
+void Channel::set_acquisition_record(std::shared_ptr<Gnss_Sdr_Acquisition_Record> record)
+{
+    channel_fsm_->set_acquisition_record(std::move(record), &gnss_synchro_);
+}
+
+
+void Channel::set_acquisition_doppler_max(uint32_t doppler_max)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    doppler_max_ = doppler_max;
+    if (!doppler_window_narrowed_)
+        {
+            acq_->set_doppler_max(doppler_max_);
+        }
+    DLOG(INFO) << "Channel " << channel_ << " acquisition Doppler range set to +/- " << doppler_max << " [Hz]";
 }
 
 
@@ -24,7 +24,7 @@
 #include "channel_fsm.h"
 #include "channel_interface.h"
 #include "channel_msg_receiver_cc.h"
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_signal.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
@@ -68,7 +68,7 @@ public:
         std::shared_ptr<TelemetryDecoderInterface> nav,
         const std::string& role,
         const std::string& signal_str,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~Channel() = default;  //!< Destructor
 
@@ -91,6 +91,38 @@ public:
 
     void assist_acquisition_doppler(double Carrier_Doppler_hz) override;
 
+    /*!
+     * \brief Centers the next acquisition search at Carrier_Doppler_hz and
+     * narrows it to +/- Doppler_window_hz (never wider than the configured
+     * doppler_max). The full range is restored by assist_acquisition_doppler().
+     */
+    void assist_acquisition_doppler_window(double Carrier_Doppler_hz, uint32_t Doppler_window_hz) override;
+
+    /*!
+     * \brief Starts the tracking without an acquisition, as if it had found
+     * a code period starting Acq_delay_samples after the sample
+     * Acq_samplestamp_samples, at Acq_doppler_hz. Returns false if the
+     * channel is not waiting for a satellite, or with FPGA acceleration.
+     */
+    bool start_tracking_handoff(double Acq_delay_samples, double Acq_doppler_hz, uint64_t Acq_samplestamp_samples);
+
+    /*!
+     * \brief Changes the acquisition threshold while the receiver runs
+     */
+    void set_acquisition_threshold(float threshold);
+
+    /*!
+     * \brief Changes the Doppler range of the acquisition while the receiver
+     * runs. A window narrowed by the assistance is kept until the next search.
+     */
+    void set_acquisition_doppler_max(uint32_t doppler_max);
+
+    /*!
+     * \brief Records the acquisition results of this channel each time that
+     * they start the tracking. Set before the first acquisition.
+     */
+    void set_acquisition_record(std::shared_ptr<Gnss_Sdr_Acquisition_Record> record);
+
     inline std::shared_ptr<AcquisitionInterface> acquisition() const { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() const { return trk_; }
     inline std::shared_ptr<TelemetryDecoderInterface> telemetry() const { return nav_; }
@@ -106,7 +138,9 @@ private:
     std::string role_;
     std::mutex mx_;
     uint32_t channel_;
+    uint32_t doppler_max_;
     bool connected_;
+    bool doppler_window_narrowed_;
     bool repeat_;
     bool flag_enable_fpga_;
 };
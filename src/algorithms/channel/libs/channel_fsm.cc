@@ -17,48 +17,67 @@
  */
 
 #include "channel_fsm.h"
-#include "channel_event.h"
+#include "control_queue.h"
+#include "gnss_sdr_acquisition_record.h"
 #include <glog/logging.h>
+#include <thread>
 #include <utility>
 
+
+namespace
+{
+constexpr uint32_t fsm_state(uint64_t word)
+{
+    return static_cast<uint32_t>(word);
+}
+
+
+constexpr uint32_t fsm_transitions(uint64_t word)
+{
+    return static_cast<uint32_t>(word >> 32U);
+}
+
+
+constexpr uint64_t fsm_word(uint32_t transitions, uint32_t state)
+{
+    return (static_cast<uint64_t>(transitions) << 32U) | state;
+}
+}  // namespace
+
+
 ChannelFsm::ChannelFsm()
     : queue_(nullptr),
-      channel_(0U),
-      state_(0U)
+      channel_(0U)
 {
     acq_ = nullptr;
     trk_ = nullptr;
+    for (uint32_t i = 0; i < ACTION_SLOTS; i++)
+        {
+            actions_[i].sequence.store(i, std::memory_order_relaxed);
+        }
 }
 
 
 ChannelFsm::ChannelFsm(std::shared_ptr<AcquisitionInterface> acquisition)
     : acq_(std::move(acquisition)),
       queue_(nullptr),
-      channel_(0U),
-      state_(0U)
+      channel_(0U)
 {
     trk_ = nullptr;
+    for (uint32_t i = 0; i < ACTION_SLOTS; i++)
+        {
+            actions_[i].sequence.store(i, std::memory_order_relaxed);
+        }
 }
 
 
 bool ChannelFsm::Event_stop_channel()
 {
-    std::lock_guard<std::mutex> lk(mx_);
     DLOG(INFO) << "CH = " << channel_ << ". Ev stop channel";
-    switch (state_)
+    // already in standby or waiting for a satellite otherwise
+    if (!transition(1, 0, action_stop_acquisition))
         {
-        case 0:  // already in stanby
-            break;
-        case 1:  // acquisition
-            state_ = 0;
-            stop_acquisition();
-            break;
-        case 2:  // tracking
-            state_ = 0;
-            stop_tracking();
-            break;
-        default:
-            break;
+            transition(2, 0, action_stop_tracking);
         }
     return true;
 }
@@ -66,12 +85,10 @@ bool ChannelFsm::Event_stop_channel()
 
 bool ChannelFsm::Event_start_acquisition_fpga()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if ((state_ == 1) || (state_ == 2))
+    if (!transition(0, 1, action_none) && !transition(3, 1, action_none))
         {
             return false;
         }
-    state_ = 1;
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition FPGA";
     return true;
 }
@@ -79,13 +96,10 @@ bool ChannelFsm::Event_start_acquisition_fpga()
 
 bool ChannelFsm::Event_start_acquisition()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if ((state_ == 1) || (state_ == 2))
+    if (!transition(0, 1, action_start_acquisition) && !transition(3, 1, action_start_acquisition))
         {
             return false;
         }
-    state_ = 1;
-    start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition";
     return true;
 }
@@ -93,13 +107,10 @@ bool ChannelFsm::Event_start_acquisition()
 
 bool ChannelFsm::Event_valid_acquisition()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(1, 2, action_start_tracking))
         {
             return false;
         }
-    state_ = 2;
-    start_tracking();
     DLOG(INFO) << "CH = " << channel_ << ". Ev valid acquisition";
     return true;
 }
@@ -107,13 +118,10 @@ bool ChannelFsm::Event_valid_acquisition()
 
 bool ChannelFsm::Event_failed_acquisition_repeat()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(1, 1, action_start_acquisition))
         {
             return false;
         }
-    state_ = 1;
-    start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition repeat";
     return true;
 }
@@ -121,13 +129,10 @@ bool ChannelFsm::Event_failed_acquisition_repeat()
 
 bool ChannelFsm::Event_failed_acquisition_no_repeat()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(1, 3, action_request_satellite))
         {
             return false;
         }
-    state_ = 3;
-    request_satellite();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition no repeat";
     return true;
 }
@@ -135,49 +140,153 @@ bool ChannelFsm::Event_failed_acquisition_no_repeat()
 
 bool ChannelFsm::Event_failed_tracking_standby()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 2)
+    if (!transition(2, 0, action_notify_stop_tracking))
         {
             return false;
         }
-    state_ = 0U;
-    notify_stop_tracking();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed tracking standby";
     return true;
 }
 
 
+bool ChannelFsm::Event_start_tracking_handoff()
+{
+    if (!transition(0, 2, action_start_tracking_handoff) && !transition(3, 2, action_start_tracking_handoff))
+        {
+            return false;
+        }
+    DLOG(INFO) << "CH = " << channel_ << ". Ev start tracking handoff";
+    return true;
+}
+
+
+bool ChannelFsm::transition(uint32_t from, uint32_t to, Action action)
+{
+    uint64_t word = state_.load(std::memory_order_acquire);
+    do
+        {
+            if (fsm_state(word) != from)
+                {
+                    return false;
+                }
+        }
+    while (!state_.compare_exchange_weak(word, fsm_word(fsm_transitions(word) + 1U, to), std::memory_order_acq_rel, std::memory_order_acquire));
+
+    // The number of transitions before this one is the position of its
+    // action in the ring, so the actions run in the order of the transitions
+    post_action(fsm_transitions(word), action);
+    run_pending_actions();
+    return true;
+}
+
+
+void ChannelFsm::post_action(uint32_t sequence, Action action)
+{
+    Action_Slot& slot = actions_[sequence & (ACTION_SLOTS - 1)];
+    // The slot is still used by an action posted ACTION_SLOTS transitions ago
+    while (slot.sequence.load(std::memory_order_acquire) != sequence)
+        {
+            run_pending_actions();
+            std::this_thread::yield();
+        }
+    slot.action = action;
+    slot.sequence.store(sequence + 1U, std::memory_order_seq_cst);
+}
+
+
+void ChannelFsm::run_pending_actions()
+{
+    while (!running_actions_.exchange(true, std::memory_order_seq_cst))
+        {
+            while (true)
+                {
+                    Action_Slot& slot = actions_[next_action_ & (ACTION_SLOTS - 1)];
+                    if (slot.sequence.load(std::memory_order_acquire) != next_action_ + 1U)
+                        {
+                            // not posted yet: the thread posting it will run it
+                            break;
+                        }
+                    const Action action = slot.action;
+                    slot.sequence.store(next_action_ + ACTION_SLOTS, std::memory_order_release);
+                    next_action_++;
+                    run_action(action);
+                }
+            const uint32_t next_action = next_action_;
+            running_actions_.store(false, std::memory_order_seq_cst);
+            // An action posted after the last check would otherwise wait for the next event
+            if (actions_[next_action & (ACTION_SLOTS - 1)].sequence.load(std::memory_order_seq_cst) != next_action + 1U)
+                {
+                    return;
+                }
+        }
+}
+
+
+void ChannelFsm::run_action(Action action)
+{
+    switch (action)
+        {
+        case action_start_acquisition:
+            start_acquisition();
+            break;
+        case action_start_tracking:
+            start_tracking();
+            break;
+        case action_stop_acquisition:
+            stop_acquisition();
+            break;
+        case action_stop_tracking:
+            stop_tracking();
+            break;
+        case action_request_satellite:
+            request_satellite();
+            break;
+        case action_notify_stop_tracking:
+            notify_stop_tracking();
+            break;
+        case action_start_tracking_handoff:
+            start_tracking_handoff();
+            break;
+        case action_none:
+        default:
+            break;
+        }
+}
+
+
 void ChannelFsm::set_acquisition(std::shared_ptr<AcquisitionInterface> acquisition)
 {
-    std::lock_guard<std::mutex> lk(mx_);
     acq_ = std::move(acquisition);
 }
 
 
 void ChannelFsm::set_tracking(std::shared_ptr<TrackingInterface> tracking)
 {
-    std::lock_guard<std::mutex> lk(mx_);
     trk_ = std::move(tracking);
 }
 
 
 void ChannelFsm::set_telemetry(std::shared_ptr<TelemetryDecoderInterface> telemetry)
 {
-    std::lock_guard<std::mutex> lk(mx_);
     nav_ = std::move(telemetry);
 }
 
 
-void ChannelFsm::set_queue(Concurrent_Queue<pmt::pmt_t>* queue)
+void ChannelFsm::set_queue(Control_Queue* queue)
 {
-    std::lock_guard<std::mutex> lk(mx_);
     queue_ = queue;
 }
 
 
+void ChannelFsm::set_acquisition_record(std::shared_ptr<Gnss_Sdr_Acquisition_Record> record, const Gnss_Synchro* gnss_synchro)
+{
+    acq_record_ = std::move(record);
+    gnss_synchro_ = gnss_synchro;
+}
+
+
 void ChannelFsm::set_channel(uint32_t channel)
 {
-    std::lock_guard<std::mutex> lk(mx_);
     channel_ = channel;
 }
 
@@ -203,18 +312,31 @@ void ChannelFsm::start_acquisition()
 
 void ChannelFsm::start_tracking()
 {
+    if (acq_record_ != nullptr and gnss_synchro_ != nullptr)
+        {
+            acq_record_->add(*gnss_synchro_);
+        }
+    trk_->start_tracking();
+    queue_->push(channel_event_make(channel_, 1));
+}
+
+
+void ChannelFsm::start_tracking_handoff()
+{
+    // no acquisition: not recorded, and notified as a successful one
+    nav_->reset();
     trk_->start_tracking();
-    queue_->push(pmt::make_any(channel_event_make(channel_, 1)));
+    queue_->push(channel_event_make(channel_, 1));
 }
 
 
 void ChannelFsm::request_satellite()
 {
-    queue_->push(pmt::make_any(channel_event_make(channel_, 0)));
+    queue_->push(channel_event_make(channel_, 0));
 }
 
 
 void ChannelFsm::notify_stop_tracking()
 {
-    queue_->push(pmt::make_any(channel_event_make(channel_, 2)));
+    queue_->push(channel_event_make(channel_, 2));
 }
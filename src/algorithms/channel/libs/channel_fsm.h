@@ -20,13 +20,17 @@
 #define GNSS_SDR_CHANNEL_FSM_H
 
 #include "acquisition_interface.h"
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <pmt/pmt.h>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
-#include <mutex>
+
+class Gnss_Sdr_Acquisition_Record;
+class Gnss_Synchro;
 
 /** \addtogroup Channel
  * \{ */
@@ -37,6 +41,18 @@
 
 /*!
  * \brief This class implements a State Machine for channel
+ *
+ * States: 0 standby, 1 acquisition, 2 tracking, 3 waiting for a new
+ * satellite. The state is an atomic word, and each event is a single compare
+ * and swap on it, so the acquisition, tracking and control threads never wait
+ * for each other to change the state of a channel.
+ *
+ * The action that goes with each transition (starting the tracking, stopping
+ * the acquisition, notifying the control thread...) is not run under a lock.
+ * It is posted to a small ring, in the order of the transitions, and run by
+ * the thread that posted it, unless another thread is already running the
+ * actions of this channel: that one runs it next, and the event returns
+ * immediately.
  */
 class ChannelFsm
 {
@@ -45,24 +61,59 @@ public:
     virtual ~ChannelFsm() = default;
     explicit ChannelFsm(std::shared_ptr<AcquisitionInterface> acquisition);
 
+    // Setup, before the first event
     void set_acquisition(std::shared_ptr<AcquisitionInterface> acquisition);
     void set_tracking(std::shared_ptr<TrackingInterface> tracking);
     void set_telemetry(std::shared_ptr<TelemetryDecoderInterface> telemetry);
-    void set_queue(Concurrent_Queue<pmt::pmt_t>* queue);
+    void set_queue(Control_Queue* queue);
     void set_channel(uint32_t channel);
     void start_acquisition();
 
+    /*!
+     * \brief Adds a copy of *gnss_synchro to record each time that a
+     * positive acquisition starts the tracking
+     */
+    void set_acquisition_record(std::shared_ptr<Gnss_Sdr_Acquisition_Record> record, const Gnss_Synchro* gnss_synchro);
+
     // FSM EVENTS
     bool Event_start_acquisition();
     bool Event_start_acquisition_fpga();
     bool Event_stop_channel();
     bool Event_failed_tracking_standby();
+    bool Event_start_tracking_handoff();
     virtual bool Event_valid_acquisition();
     virtual bool Event_failed_acquisition_repeat();
     virtual bool Event_failed_acquisition_no_repeat();
 
 private:
+    enum Action : uint32_t
+    {
+        action_none,
+        action_start_acquisition,
+        action_start_tracking,
+        action_stop_acquisition,
+        action_stop_tracking,
+        action_request_satellite,
+        action_notify_stop_tracking,
+        action_start_tracking_handoff
+    };
+
+    class Action_Slot
+    {
+    public:
+        std::atomic<uint32_t> sequence{0U};  // position in the ring this slot is ready for
+        Action action{action_none};
+    };
+
+    static constexpr uint32_t ACTION_SLOTS = 8;  // power of two
+
+    bool transition(uint32_t from, uint32_t to, Action action);
+    void post_action(uint32_t sequence, Action action);
+    void run_pending_actions();
+    void run_action(Action action);
+
     void start_tracking();
+    void start_tracking_handoff();
     void stop_acquisition();
     void stop_tracking();
     void request_satellite();
@@ -72,12 +123,19 @@ private:
     std::shared_ptr<TrackingInterface> trk_;
     std::shared_ptr<TelemetryDecoderInterface> nav_;
 
-    std::mutex mx_;
+    std::shared_ptr<Gnss_Sdr_Acquisition_Record> acq_record_;
+    const Gnss_Synchro* gnss_synchro_{nullptr};
 
-    Concurrent_Queue<pmt::pmt_t>* queue_;
+    Control_Queue* queue_;
 
     uint32_t channel_;
-    uint32_t state_;
+
+    // state in the low 32 bits, number of transitions in the high 32 bits
+    std::atomic<uint64_t> state_{0ULL};
+
+    std::array<Action_Slot, ACTION_SLOTS> actions_;
+    std::atomic<bool> running_actions_{false};
+    uint32_t next_action_{0U};  // only accessed by the thread running the actions
 };
 
 
@@ -31,6 +31,58 @@ SignalConditioner::SignalConditioner(std::shared_ptr<GNSSBlockInterface> data_ty
                         role_(std::move(role)),
                         connected_(false)
 {
+    stages_ = {data_type_adapt_, in_filt_, res_};
+    fuse_stages();
+}
+
+
+void SignalConditioner::fuse_stages()
+{
+    // look for the longest run of adjacent stages that can work in place on
+    // items of the same size
+    int run_first = 0;
+    for (int stage = 0; stage < 3; stage++)
+        {
+            const auto &block = stages_[stage];
+            const bool in_place = block != nullptr and block->in_place_kernel() != nullptr and block->get_left_block() == block->get_right_block();
+            const bool same_size = stage > run_first and block != nullptr and stages_[stage - 1] != nullptr and block->item_size() == stages_[stage - 1]->item_size();
+            if (!in_place)
+                {
+                    run_first = stage + 1;
+                    continue;
+                }
+            if (stage > run_first and !same_size)
+                {
+                    run_first = stage;
+                }
+            if (stage - run_first > fused_last_ - fused_first_)
+                {
+                    fused_first_ = run_first;
+                    fused_last_ = stage;
+                }
+        }
+    if (fused_last_ - fused_first_ < 1)
+        {
+            // a single stage is already one copy
+            fused_first_ = -1;
+            fused_last_ = -1;
+            return;
+        }
+
+    std::vector<in_place_kernel> kernels;
+    for (int stage = fused_first_; stage <= fused_last_; stage++)
+        {
+            kernels.push_back(stages_[stage]->in_place_kernel());
+        }
+    fused_ = make_in_place_chain(stages_[fused_last_]->item_size(), kernels);
+
+    // keep the output buffer limit of the last fused stage, if any
+    auto *last_block = dynamic_cast<gr::block *>(stages_[fused_last_]->get_right_block().get());
+    if (last_block != nullptr and last_block->max_output_buffer(0) > 0)
+        {
+            fused_->set_max_output_buffer(last_block->max_output_buffer(0));
+        }
+    LOG(INFO) << role_ << ": running " << kernels.size() << " conditioner stages in place in a single block";
 }
 
 
@@ -53,9 +105,13 @@ void SignalConditioner::connect(gr::top_block_sptr top_block)
         {
             throw std::invalid_argument("Resampler implementation not defined");
         }
-    data_type_adapt_->connect(top_block);
-    in_filt_->connect(top_block);
-    res_->connect(top_block);
+    for (int stage = 0; stage < 3; stage++)
+        {
+            if (!fused(stage))
+                {
+                    stages_[stage]->connect(top_block);
+                }
+        }
 
     if (in_filt_->item_size() == 0)
         {
@@ -77,11 +133,30 @@ void SignalConditioner::connect(gr::top_block_sptr top_block)
             throw std::invalid_argument("itemsize mismatch: Invalid input/ouput data type configuration for the Input Filter/Resampler connection");
         }
 
-    top_block->connect(data_type_adapt_->get_right_block(), 0, in_filt_->get_left_block(), 0);
-    DLOG(INFO) << "data_type_adapter -> input_filter";
-
-    top_block->connect(in_filt_->get_right_block(), 0, res_->get_left_block(), 0);
-    DLOG(INFO) << "input_filter -> resampler";
+    // data_type_adapter -> input_filter -> resampler, with the fused stages as one block
+    connections_.clear();
+    gr::basic_block_sptr previous;
+    for (int stage = 0; stage < 3; stage++)
+        {
+            gr::basic_block_sptr left = stages_[stage]->get_left_block();
+            gr::basic_block_sptr right = stages_[stage]->get_right_block();
+            if (fused(stage))
+                {
+                    if (stage != fused_first_)
+                        {
+                            continue;
+                        }
+                    left = fused_;
+                    right = fused_;
+                }
+            if (previous != nullptr)
+                {
+                    top_block->connect(previous, 0, left, 0);
+                    connections_.emplace_back(previous, left);
+                }
+            previous = right;
+        }
+    DLOG(INFO) << "data_type_adapter -> input_filter -> resampler connected with " << connections_.size() << " buffers";
     connected_ = true;
 }
 
@@ -94,14 +169,19 @@ void SignalConditioner::disconnect(gr::top_block_sptr top_block)
             return;
         }
 
-    top_block->disconnect(data_type_adapt_->get_right_block(), 0,
-        in_filt_->get_left_block(), 0);
-    top_block->disconnect(in_filt_->get_right_block(), 0,
-        res_->get_left_block(), 0);
+    for (const auto &connection : connections_)
+        {
+            top_block->disconnect(connection.first, 0, connection.second, 0);
+        }
+    connections_.clear();
 
-    data_type_adapt_->disconnect(top_block);
-    in_filt_->disconnect(top_block);
-    res_->disconnect(top_block);
+    for (int stage = 0; stage < 3; stage++)
+        {
+            if (!fused(stage))
+                {
+                    stages_[stage]->disconnect(top_block);
+                }
+        }
 
     connected_ = false;
 }
@@ -109,11 +189,19 @@ void SignalConditioner::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr SignalConditioner::get_left_block()
 {
+    if (fused(0))
+        {
+            return fused_;
+        }
     return data_type_adapt_->get_left_block();
 }
 
 
 gr::basic_block_sptr SignalConditioner::get_right_block()
 {
+    if (fused(2))
+        {
+            return fused_;
+        }
     return res_->get_right_block();
 }
@@ -19,10 +19,14 @@
 #define GNSS_SDR_SIGNAL_CONDITIONER_H
 
 #include "gnss_block_interface.h"
+#include "in_place_chain.h"
 #include <gnuradio/block.h>
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /** \addtogroup Signal_Conditioner Signal Conditioner
  * Signal Conditioner wrapper block
@@ -35,6 +39,11 @@
 /*!
  * \brief This class wraps blocks to change data_type_adapter, input_filter and resampler
  * to be applied to the input flow of sampled signal.
+ *
+ * Adjacent stages that can work in place (see
+ * GNSSBlockInterface::in_place_kernel()) are fused into one in_place_chain
+ * block, so the samples are copied once for all of them instead of once per
+ * stage.
  */
 class SignalConditioner : public GNSSBlockInterface
 {
@@ -63,11 +72,22 @@ public:
     inline std::shared_ptr<GNSSBlockInterface> input_filter() { return in_filt_; }
     inline std::shared_ptr<GNSSBlockInterface> resampler() { return res_; }
 
+    //! Returns the block running the fused stages, or nullptr if no stages are fused
+    inline in_place_chain_sptr fused_block() { return fused_; }
+
 private:
+    void fuse_stages();
+    bool fused(int stage) const { return fused_ != nullptr and stage >= fused_first_ and stage <= fused_last_; }
+
     std::shared_ptr<GNSSBlockInterface> data_type_adapt_;
     std::shared_ptr<GNSSBlockInterface> in_filt_;
     std::shared_ptr<GNSSBlockInterface> res_;
+    std::array<std::shared_ptr<GNSSBlockInterface>, 3> stages_;
+    std::vector<std::pair<gr::basic_block_sptr, gr::basic_block_sptr>> connections_;
+    in_place_chain_sptr fused_;
     std::string role_;
+    int fused_first_{-1};
+    int fused_last_{-1};
     bool connected_;
 };
 
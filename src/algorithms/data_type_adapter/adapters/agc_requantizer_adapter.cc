@@ -0,0 +1,123 @@
+/*!
+ * \file agc_requantizer_adapter.cc
+ * \brief Requantizes the input to a few bits per component with automatic
+ * gain control, into a std::complex<short> stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "agc_requantizer_adapter.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+
+
+AgcRequantizerAdapter::AgcRequantizerAdapter(const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    const std::string default_input_item_type("gr_complex");
+    const std::string default_dump_filename("../data/data_type_adapter.dat");
+
+    DLOG(INFO) << "role " << role_;
+
+    input_item_type_ = configuration->property(role_ + ".input_item_type", default_input_item_type);
+    const int bits = configuration->property(role_ + ".bits", 4);
+    const int agc_window = configuration->property(role_ + ".agc_window", 100000);
+
+    dump_ = configuration->property(role_ + ".dump", false);
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
+    dump_packed_ = configuration->property(role_ + ".dump_packed", false);
+
+    if (input_item_type_ != "gr_complex" and input_item_type_ != "cshort")
+        {
+            LOG(WARNING) << input_item_type_ << " unrecognized input item type for " << role_ << ", using gr_complex";
+            input_item_type_ = default_input_item_type;
+        }
+    requantizer_ = make_agc_requantizer(bits, input_item_type_ == "cshort", agc_window);
+    DLOG(INFO) << "data_type_adapter_(" << requantizer_->unique_id() << ") requantizing to " << requantizer_->bits() << " bits";
+
+    if (dump_packed_ and requantizer_->bits() != 2)
+        {
+            LOG(WARNING) << "Packed dumps are only available with 2 bits, dumping std::complex<short> samples instead";
+            dump_packed_ = false;
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            if (dump_packed_)
+                {
+                    packer_ = make_pack_2bit_samples();
+                    file_sink_ = gr::blocks::file_sink::make(sizeof(int8_t), dump_filename_.c_str());
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(sizeof(lv_16sc_t), dump_filename_.c_str());
+                }
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void AgcRequantizerAdapter::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            if (dump_packed_)
+                {
+                    top_block->connect(requantizer_, 0, packer_, 0);
+                    top_block->connect(packer_, 0, file_sink_, 0);
+                }
+            else
+                {
+                    top_block->connect(requantizer_, 0, file_sink_, 0);
+                }
+        }
+    else
+        {
+            DLOG(INFO) << "Nothing to connect internally";
+        }
+}
+
+
+void AgcRequantizerAdapter::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            if (dump_packed_)
+                {
+                    top_block->disconnect(requantizer_, 0, packer_, 0);
+                    top_block->disconnect(packer_, 0, file_sink_, 0);
+                }
+            else
+                {
+                    top_block->disconnect(requantizer_, 0, file_sink_, 0);
+                }
+        }
+}
+
+
+gr::basic_block_sptr AgcRequantizerAdapter::get_left_block()
+{
+    return requantizer_;
+}
+
+
+gr::basic_block_sptr AgcRequantizerAdapter::get_right_block()
+{
+    return requantizer_;
+}
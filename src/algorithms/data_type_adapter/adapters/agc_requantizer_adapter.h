@@ -0,0 +1,90 @@
+/*!
+ * \file agc_requantizer_adapter.h
+ * \brief Requantizes the input to a few bits per component with automatic
+ * gain control, into a std::complex<short> stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_AGC_REQUANTIZER_ADAPTER_H
+#define GNSS_SDR_AGC_REQUANTIZER_ADAPTER_H
+
+#include "agc_requantizer.h"
+#include "gnss_block_interface.h"
+#include "pack_2bit_samples.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup Data_type_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Adapts a gr_complex or std::complex<short> stream into a
+ * std::complex<short> stream of 2 to 8 bits per component, for the
+ * fixed-point (cshort) acquisition and tracking blocks.
+ *
+ * With bits=2 and dump_packed=true, the dump file holds two complex samples
+ * per byte and can be replayed with Two_Bit_Packed_File_Signal_Source
+ * (sample_type=iq, big_endian_bytes=false).
+ */
+class AgcRequantizerAdapter : public GNSSBlockInterface
+{
+public:
+    AgcRequantizerAdapter(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~AgcRequantizerAdapter() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "Agc_Requantizer"
+    inline std::string implementation() override
+    {
+        return "Agc_Requantizer";
+    }
+
+    inline size_t item_size() override
+    {
+        return 2 * sizeof(int16_t);
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    agc_requantizer_sptr requantizer_;
+    pack_2bit_samples_sptr packer_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    std::string input_item_type_;
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+    bool dump_packed_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_AGC_REQUANTIZER_ADAPTER_H
@@ -38,7 +38,7 @@ IbyteToCbyte::IbyteToCbyte(const ConfigurationInterface* configuration, const st
 
     const size_t item_size = sizeof(lv_8sc_t);
 
-    ibyte_to_cbyte_ = make_interleaved_byte_to_complex_byte();
+    ibyte_to_cbyte_ = make_interleaved_byte_to_complex_byte(inverted_spectrum);
 
     DLOG(INFO) << "data_type_adapter_(" << ibyte_to_cbyte_->unique_id() << ")";
 
@@ -47,10 +47,6 @@ IbyteToCbyte::IbyteToCbyte(const ConfigurationInterface* configuration, const st
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
             file_sink_ = gr::blocks::file_sink::make(item_size, dump_filename_.c_str());
         }
-    if (inverted_spectrum)
-        {
-            conjugate_ic_ = make_conjugate_ic();
-        }
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -66,26 +62,11 @@ void IbyteToCbyte::connect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
-                {
-                    top_block->connect(ibyte_to_cbyte_, 0, conjugate_ic_, 0);
-                    top_block->connect(conjugate_ic_, 0, file_sink_, 0);
-                }
-            else
-                {
-                    top_block->connect(ibyte_to_cbyte_, 0, file_sink_, 0);
-                }
+            top_block->connect(ibyte_to_cbyte_, 0, file_sink_, 0);
         }
     else
         {
-            if (inverted_spectrum)
-                {
-                    top_block->connect(ibyte_to_cbyte_, 0, conjugate_ic_, 0);
-                }
-            else
-                {
-                    DLOG(INFO) << "Nothing to connect internally";
-                }
+            DLOG(INFO) << "Nothing to connect internally";
         }
 }
 
@@ -94,22 +75,7 @@ void IbyteToCbyte::disconnect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
-                {
-                    top_block->disconnect(ibyte_to_cbyte_, 0, conjugate_ic_, 0);
-                    top_block->disconnect(conjugate_ic_, 0, file_sink_, 0);
-                }
-            else
-                {
-                    top_block->disconnect(ibyte_to_cbyte_, 0, file_sink_, 0);
-                }
-        }
-    else
-        {
-            if (inverted_spectrum)
-                {
-                    top_block->disconnect(ibyte_to_cbyte_, 0, conjugate_ic_, 0);
-                }
+            top_block->disconnect(ibyte_to_cbyte_, 0, file_sink_, 0);
         }
 }
 
@@ -122,9 +88,5 @@ gr::basic_block_sptr IbyteToCbyte::get_left_block()
 
 gr::basic_block_sptr IbyteToCbyte::get_right_block()
 {
-    if (inverted_spectrum)
-        {
-            return conjugate_ic_;
-        }
     return ibyte_to_cbyte_;
 }
@@ -18,7 +18,6 @@
 #ifndef GNSS_SDR_IBYTE_TO_CBYTE_H
 #define GNSS_SDR_IBYTE_TO_CBYTE_H
 
-#include "conjugate_ic.h"
 #include "gnss_block_interface.h"
 #include "interleaved_byte_to_complex_byte.h"
 #include <gnuradio/blocks/file_sink.h>
@@ -69,7 +68,6 @@ public:
 
 private:
     interleaved_byte_to_complex_byte_sptr ibyte_to_cbyte_;
-    conjugate_ic_sptr conjugate_ic_;
     gr::blocks::file_sink::sptr file_sink_;
     std::string dump_filename_;
     std::string input_item_type_;
@@ -38,7 +38,7 @@ IshortToCshort::IshortToCshort(const ConfigurationInterface* configuration, cons
 
     const size_t item_size = sizeof(lv_16sc_t);
 
-    interleaved_short_to_complex_short_ = make_interleaved_short_to_complex_short();
+    interleaved_short_to_complex_short_ = make_interleaved_short_to_complex_short(inverted_spectrum);
 
     DLOG(INFO) << "data_type_adapter_(" << interleaved_short_to_complex_short_->unique_id() << ")";
 
@@ -47,10 +47,6 @@ IshortToCshort::IshortToCshort(const ConfigurationInterface* configuration, cons
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
             file_sink_ = gr::blocks::file_sink::make(item_size, dump_filename_.c_str());
         }
-    if (inverted_spectrum)
-        {
-            conjugate_sc_ = make_conjugate_sc();
-        }
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -66,26 +62,11 @@ void IshortToCshort::connect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
-                {
-                    top_block->connect(interleaved_short_to_complex_short_, 0, conjugate_sc_, 0);
-                    top_block->connect(conjugate_sc_, 0, file_sink_, 0);
-                }
-            else
-                {
-                    top_block->connect(interleaved_short_to_complex_short_, 0, file_sink_, 0);
-                }
+            top_block->connect(interleaved_short_to_complex_short_, 0, file_sink_, 0);
         }
     else
         {
-            if (inverted_spectrum)
-                {
-                    top_block->connect(interleaved_short_to_complex_short_, 0, conjugate_sc_, 0);
-                }
-            else
-                {
-                    DLOG(INFO) << "Nothing to connect internally";
-                }
+            DLOG(INFO) << "Nothing to connect internally";
         }
 }
 
@@ -94,22 +75,7 @@ void IshortToCshort::disconnect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
-                {
-                    top_block->disconnect(interleaved_short_to_complex_short_, 0, conjugate_sc_, 0);
-                    top_block->disconnect(conjugate_sc_, 0, file_sink_, 0);
-                }
-            else
-                {
-                    top_block->disconnect(interleaved_short_to_complex_short_, 0, file_sink_, 0);
-                }
-        }
-    else
-        {
-            if (inverted_spectrum)
-                {
-                    top_block->disconnect(interleaved_short_to_complex_short_, 0, conjugate_sc_, 0);
-                }
+            top_block->disconnect(interleaved_short_to_complex_short_, 0, file_sink_, 0);
         }
 }
 
@@ -122,9 +88,5 @@ gr::basic_block_sptr IshortToCshort::get_left_block()
 
 gr::basic_block_sptr IshortToCshort::get_right_block()
 {
-    if (inverted_spectrum)
-        {
-            return conjugate_sc_;
-        }
     return interleaved_short_to_complex_short_;
 }
@@ -17,7 +17,6 @@
 #ifndef GNSS_SDR_ISHORT_TO_CSHORT_H
 #define GNSS_SDR_ISHORT_TO_CSHORT_H
 
-#include "conjugate_sc.h"
 #include "gnss_block_interface.h"
 #include "interleaved_short_to_complex_short.h"
 #include <gnuradio/blocks/file_sink.h>
@@ -68,7 +67,6 @@ public:
 
 private:
     interleaved_short_to_complex_short_sptr interleaved_short_to_complex_short_;
-    conjugate_sc_sptr conjugate_sc_;
     gr::blocks::file_sink::sptr file_sink_;
     std::string dump_filename_;
     std::string input_item_type_;
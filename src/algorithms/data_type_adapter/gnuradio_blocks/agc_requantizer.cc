@@ -0,0 +1,97 @@
+/*!
+ * \file agc_requantizer.cc
+ * \brief Requantizes a complex sample stream to a few bits, with automatic
+ * gain control, into a std::complex<short> stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "agc_requantizer.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+
+namespace
+{
+// step of the optimum uniform quantizer of a unit variance Gaussian
+// variable (Max, 1960), for 2 to 8 bits
+const std::array<float, 7> OPTIMUM_STEP = {0.9957, 0.5860, 0.3352, 0.1881, 0.1041, 0.0569, 0.0308};
+}  // namespace
+
+
+agc_requantizer_sptr make_agc_requantizer(int bits, bool cshort_input, int agc_window)
+{
+    return agc_requantizer_sptr(new agc_requantizer(bits, cshort_input, agc_window));
+}
+
+
+agc_requantizer::agc_requantizer(int bits, bool cshort_input, int agc_window)
+    : gr::sync_block("agc_requantizer",
+          gr::io_signature::make(1, 1, cshort_input ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(lv_16sc_t))),
+      d_bits(std::min(8, std::max(2, bits))),
+      d_agc_window(std::max(1, agc_window)),
+      d_cshort_input(cshort_input)
+{
+    d_step = OPTIMUM_STEP[d_bits - 2];
+    d_half_levels = 1 << (d_bits - 1);
+}
+
+
+int agc_requantizer::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<int16_t *>(output_items[0]);
+    if (d_cshort_input)
+        {
+            if (d_converted.size() < static_cast<size_t>(noutput_items))
+                {
+                    d_converted.resize(noutput_items);
+                }
+            volk_16ic_convert_32fc(d_converted.data(), reinterpret_cast<const lv_16sc_t *>(input_items[0]), noutput_items);
+            in = d_converted.data();
+        }
+    const auto *in_float = reinterpret_cast<const float *>(in);
+    const int ncomponents = 2 * noutput_items;
+
+    // the gain follows the power measured over about agc_window samples
+    float energy = 0.0;
+    volk_32f_x2_dot_prod_32f(&energy, in_float, in_float, ncomponents);
+    const double power = static_cast<double>(energy) / static_cast<double>(noutput_items);
+    if (d_gain == 0.0)
+        {
+            d_power = power;
+        }
+    else
+        {
+            d_power += std::min(1.0, static_cast<double>(noutput_items) / static_cast<double>(d_agc_window)) * (power - d_power);
+        }
+    if (d_power > 0.0)
+        {
+            // each component carries half of the power
+            d_gain = static_cast<float>(1.0 / (static_cast<double>(d_step) * std::sqrt(d_power / 2.0)));
+        }
+
+    const auto lowest = static_cast<float>(-d_half_levels);
+    const auto highest = static_cast<float>(d_half_levels - 1);
+    for (int n = 0; n < ncomponents; n++)
+        {
+            const float step = std::min(highest, std::max(lowest, std::floor(in_float[n] * d_gain)));
+            out[n] = static_cast<int16_t>(2 * static_cast<int>(step) + 1);
+        }
+    return noutput_items;
+}
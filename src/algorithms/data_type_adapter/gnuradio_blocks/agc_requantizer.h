@@ -0,0 +1,84 @@
+/*!
+ * \file agc_requantizer.h
+ * \brief Requantizes a complex sample stream to a few bits, with automatic
+ * gain control, into a std::complex<short> stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_AGC_REQUANTIZER_H
+#define GNSS_SDR_AGC_REQUANTIZER_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstdint>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class agc_requantizer;
+
+using agc_requantizer_sptr = gnss_shared_ptr<agc_requantizer>;
+
+/*!
+ * \brief Returns a requantizer to bits bits (2 to 8) per component. The input
+ * is std::complex<float> or, with cshort_input set, std::complex<short>.
+ * agc_window is the number of samples over which the input power is averaged.
+ */
+agc_requantizer_sptr make_agc_requantizer(int bits, bool cshort_input = false, int agc_window = 100000);
+
+/*!
+ * \brief Uniform mid-rise quantizer of each component of the input, whose
+ * step is kept at the optimum for Gaussian noise of the measured power.
+ *
+ * GNSS signals are well below the noise at this point, so the input is
+ * essentially Gaussian and a few bits lose very little (about 0.55 dB with
+ * 2 bits). The output levels are the odd integers from -(2^bits - 1) to
+ * 2^bits - 1, the same values the 2-bit packed file sources produce, so the
+ * fixed-point acquisition and tracking blocks can take them directly.
+ */
+class agc_requantizer : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    int bits() const { return d_bits; }
+
+    /*!
+     * \brief Gain currently applied before rounding to the quantizer steps.
+     */
+    float gain() const { return d_gain; }
+
+private:
+    friend agc_requantizer_sptr make_agc_requantizer(int bits, bool cshort_input, int agc_window);
+    agc_requantizer(int bits, bool cshort_input, int agc_window);
+
+    volk_gnsssdr::vector<std::complex<float>> d_converted;  // cshort input as floats
+    double d_power{0.0};                                    // averaged power per complex sample
+    float d_step;                                           // optimum step, relative to the standard deviation
+    float d_gain{0.0};
+    int d_bits;
+    int d_half_levels;
+    int d_agc_window;
+    bool d_cshort_input;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_AGC_REQUANTIZER_H
@@ -17,23 +17,24 @@
 
 #include "interleaved_byte_to_complex_byte.h"
 #include <gnuradio/io_signature.h>
-#include <volk/volk.h>
-#include <algorithm>  // for max
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for max, copy
 
 
-interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte()
+interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte(bool conjugate)
 {
-    return interleaved_byte_to_complex_byte_sptr(new interleaved_byte_to_complex_byte());
+    return interleaved_byte_to_complex_byte_sptr(new interleaved_byte_to_complex_byte(conjugate));
 }
 
 
-interleaved_byte_to_complex_byte::interleaved_byte_to_complex_byte()
+interleaved_byte_to_complex_byte::interleaved_byte_to_complex_byte(bool conjugate)
     : sync_decimator("interleaved_byte_to_complex_byte",
           gr::io_signature::make(1, 1, sizeof(int8_t)),
           gr::io_signature::make(1, 1, sizeof(lv_8sc_t)),  // lv_8sc_t is a Volk's typedef for std::complex<signed char>
-          2)
+          2),
+      d_conjugate(conjugate)
 {
-    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(lv_8sc_t));
+    const auto alignment_multiple = static_cast<int>(volk_gnsssdr_get_alignment() / sizeof(lv_8sc_t));
     set_alignment(std::max(1, alignment_multiple));
 }
 
@@ -44,15 +45,14 @@ int interleaved_byte_to_complex_byte::work(int noutput_items,
 {
     const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
     auto *out = reinterpret_cast<lv_8sc_t *>(output_items[0]);
-    // This could be put into a Volk kernel
-    int8_t real_part;
-    int8_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
+    // std::complex<signed char> has the layout of two interleaved bytes
+    if (d_conjugate)
         {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in++;
-            imag_part = *in++;
-            *out++ = lv_cmake(real_part, imag_part);
+            volk_gnsssdr_8ic_conjugate_8ic(out, reinterpret_cast<const lv_8sc_t *>(in), noutput_items);
+        }
+    else
+        {
+            std::copy(in, in + 2 * noutput_items, reinterpret_cast<int8_t *>(out));
         }
     return noutput_items;
 }
@@ -31,11 +31,12 @@ class interleaved_byte_to_complex_byte;
 
 using interleaved_byte_to_complex_byte_sptr = gnss_shared_ptr<interleaved_byte_to_complex_byte>;
 
-interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte();
+interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte(bool conjugate = false);
 
 /*!
  * \brief This class adapts an 8-bits interleaved sample stream
  * into a 16-bits complex stream (std::complex<unsigned char>)
+ * and optionally conjugates it, for inputs with inverted spectrum
  */
 class interleaved_byte_to_complex_byte : public gr::sync_decimator
 {
@@ -45,8 +46,10 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    friend interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte();
-    interleaved_byte_to_complex_byte();
+    friend interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte(bool conjugate);
+    explicit interleaved_byte_to_complex_byte(bool conjugate);
+
+    bool d_conjugate;
 };
 
 
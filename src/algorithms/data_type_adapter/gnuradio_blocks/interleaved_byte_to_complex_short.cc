@@ -17,23 +17,24 @@
 
 #include "interleaved_byte_to_complex_short.h"
 #include <gnuradio/io_signature.h>
-#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>  // for max
 
 
-interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short()
+interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short(bool conjugate)
 {
-    return interleaved_byte_to_complex_short_sptr(new interleaved_byte_to_complex_short());
+    return interleaved_byte_to_complex_short_sptr(new interleaved_byte_to_complex_short(conjugate));
 }
 
 
-interleaved_byte_to_complex_short::interleaved_byte_to_complex_short()
+interleaved_byte_to_complex_short::interleaved_byte_to_complex_short(bool conjugate)
     : sync_decimator("interleaved_byte_to_complex_short",
           gr::io_signature::make(1, 1, sizeof(int8_t)),
           gr::io_signature::make(1, 1, sizeof(lv_16sc_t)),  // lv_16sc_t is a Volk's typedef for std::complex<short int>
-          2)
+          2),
+      d_conjugate(conjugate)
 {
-    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(lv_16sc_t));
+    const auto alignment_multiple = static_cast<int>(volk_gnsssdr_get_alignment() / sizeof(lv_16sc_t));
     set_alignment(std::max(1, alignment_multiple));
 }
 
@@ -44,15 +45,11 @@ int interleaved_byte_to_complex_short::work(int noutput_items,
 {
     const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
     auto *out = reinterpret_cast<lv_16sc_t *>(output_items[0]);
-    // This could be put into a Volk kernel
-    int8_t real_part;
-    int8_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
+    volk_gnsssdr_8ic_convert_16ic(out, reinterpret_cast<const lv_8sc_t *>(in), noutput_items);
+    if (d_conjugate)
         {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in++;
-            imag_part = *in++;
-            *out++ = lv_cmake(static_cast<int16_t>(real_part), static_cast<int16_t>(imag_part));
+            // in place, while the output is still in cache
+            volk_gnsssdr_16ic_conjugate_16ic(out, out, noutput_items);
         }
     return noutput_items;
 }
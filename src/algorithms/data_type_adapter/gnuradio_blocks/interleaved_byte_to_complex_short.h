@@ -31,11 +31,12 @@ class interleaved_byte_to_complex_short;
 
 using interleaved_byte_to_complex_short_sptr = gnss_shared_ptr<interleaved_byte_to_complex_short>;
 
-interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short();
+interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short(bool conjugate = false);
 
 /*!
  * \brief This class adapts a short (16-bits) interleaved sample stream
  * into a std::complex<short> stream
+ * and optionally conjugates it, for inputs with inverted spectrum
  */
 class interleaved_byte_to_complex_short : public gr::sync_decimator
 {
@@ -45,8 +46,10 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    friend interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short();
-    interleaved_byte_to_complex_short();
+    friend interleaved_byte_to_complex_short_sptr make_interleaved_byte_to_complex_short(bool conjugate);
+    explicit interleaved_byte_to_complex_short(bool conjugate);
+
+    bool d_conjugate;
 };
 
 
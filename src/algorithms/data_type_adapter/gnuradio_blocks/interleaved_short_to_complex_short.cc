@@ -17,23 +17,24 @@
 
 #include "interleaved_short_to_complex_short.h"
 #include <gnuradio/io_signature.h>
-#include <volk/volk.h>
-#include <algorithm>  // for max
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for max, copy
 
 
-interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short()
+interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short(bool conjugate)
 {
-    return interleaved_short_to_complex_short_sptr(new interleaved_short_to_complex_short());
+    return interleaved_short_to_complex_short_sptr(new interleaved_short_to_complex_short(conjugate));
 }
 
 
-interleaved_short_to_complex_short::interleaved_short_to_complex_short()
+interleaved_short_to_complex_short::interleaved_short_to_complex_short(bool conjugate)
     : sync_decimator("interleaved_short_to_complex_short",
           gr::io_signature::make(1, 1, sizeof(int16_t)),
           gr::io_signature::make(1, 1, sizeof(lv_16sc_t)),  // lv_16sc_t is a Volk's typedef for std::complex<short int>
-          2)
+          2),
+      d_conjugate(conjugate)
 {
-    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(lv_16sc_t));
+    const auto alignment_multiple = static_cast<int>(volk_gnsssdr_get_alignment() / sizeof(lv_16sc_t));
     set_alignment(std::max(1, alignment_multiple));
 }
 
@@ -44,15 +45,14 @@ int interleaved_short_to_complex_short::work(int noutput_items,
 {
     const auto *in = reinterpret_cast<const int16_t *>(input_items[0]);
     auto *out = reinterpret_cast<lv_16sc_t *>(output_items[0]);
-    // This could be put into a Volk kernel
-    int16_t real_part;
-    int16_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
+    // std::complex<short> has the layout of two interleaved shorts
+    if (d_conjugate)
         {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in++;
-            imag_part = *in++;
-            *out++ = lv_cmake(real_part, imag_part);
+            volk_gnsssdr_16ic_conjugate_16ic(out, reinterpret_cast<const lv_16sc_t *>(in), noutput_items);
+        }
+    else
+        {
+            std::copy(in, in + 2 * noutput_items, reinterpret_cast<int16_t *>(out));
         }
     return noutput_items;
 }
@@ -30,11 +30,12 @@ class interleaved_short_to_complex_short;
 
 using interleaved_short_to_complex_short_sptr = gnss_shared_ptr<interleaved_short_to_complex_short>;
 
-interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short();
+interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short(bool conjugate = false);
 
 /*!
  * \brief This class adapts a short (16-bits) interleaved sample stream
  * into a std::complex<short> stream
+ * and optionally conjugates it, for inputs with inverted spectrum
  */
 class interleaved_short_to_complex_short : public gr::sync_decimator
 {
@@ -44,8 +45,10 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    friend interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short();
-    interleaved_short_to_complex_short();
+    friend interleaved_short_to_complex_short_sptr make_interleaved_short_to_complex_short(bool conjugate);
+    explicit interleaved_short_to_complex_short(bool conjugate);
+
+    bool d_conjugate;
 };
 
 
@@ -0,0 +1,55 @@
+/*!
+ * \file pack_2bit_samples.cc
+ * \brief Packs a 2-bit std::complex<short> stream into bytes of two complex
+ * samples, in the format read by Two_Bit_Packed_File_Signal_Source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pack_2bit_samples.h"
+#include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <cstdint>
+
+
+pack_2bit_samples_sptr make_pack_2bit_samples()
+{
+    return pack_2bit_samples_sptr(new pack_2bit_samples());
+}
+
+
+pack_2bit_samples::pack_2bit_samples()
+    : sync_decimator("pack_2bit_samples",
+          gr::io_signature::make(1, 1, sizeof(lv_16sc_t)),
+          gr::io_signature::make(1, 1, sizeof(int8_t)),
+          2)
+{
+}
+
+
+int pack_2bit_samples::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const int16_t *>(input_items[0]);
+    auto *out = reinterpret_cast<uint8_t *>(output_items[0]);
+    for (int n = 0; n < noutput_items; n++)
+        {
+            uint8_t byte = 0;
+            for (int k = 0; k < 4; k++)
+                {
+                    // 1, 3, -3 and -1 are the codes 0, 1, 2 and 3
+                    byte |= static_cast<uint8_t>(((in[4 * n + k] - 1) / 2) & 3) << (2 * k);
+                }
+            out[n] = byte;
+        }
+    return noutput_items;
+}
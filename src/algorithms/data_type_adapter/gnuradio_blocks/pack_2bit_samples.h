@@ -0,0 +1,56 @@
+/*!
+ * \file pack_2bit_samples.h
+ * \brief Packs a 2-bit std::complex<short> stream into bytes of two complex
+ * samples, in the format read by Two_Bit_Packed_File_Signal_Source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PACK_2BIT_SAMPLES_H
+#define GNSS_SDR_PACK_2BIT_SAMPLES_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_decimator.h>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class pack_2bit_samples;
+
+using pack_2bit_samples_sptr = gnss_shared_ptr<pack_2bit_samples>;
+
+pack_2bit_samples_sptr make_pack_2bit_samples();
+
+/*!
+ * \brief Maps the levels -3, -1, 1 and 3 of each component to their 2-bit
+ * codes and packs I0, Q0, I1 and Q1 from the least significant bits of each
+ * byte on. The file is read back by Two_Bit_Packed_File_Signal_Source with
+ * sample_type=iq and big_endian_bytes=false.
+ */
+class pack_2bit_samples : public gr::sync_decimator
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend pack_2bit_samples_sptr make_pack_2bit_samples();
+    pack_2bit_samples();
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PACK_2BIT_SAMPLES_H
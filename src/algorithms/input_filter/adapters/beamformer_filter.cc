@@ -19,6 +19,8 @@
 #include "configuration_interface.h"
 #include <glog/logging.h>
 #include <gnuradio/blocks/file_sink.h>
+#include <string>
+#include <vector>
 
 
 BeamformerFilter::BeamformerFilter(
@@ -33,11 +35,35 @@ BeamformerFilter::BeamformerFilter(
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    const int elements = configuration->property(role + ".elements", GNSS_SDR_BEAMFORMER_CHANNELS);
+    const std::string default_adaptive("none");
+    const std::string adaptive = configuration->property(role + ".adaptive", default_adaptive);
+    const int snapshots = configuration->property(role + ".snapshots", 4096);
+    const int update_period = configuration->property(role + ".update_period", 1000000);
+    const float diagonal_loading = configuration->property(role + ".diagonal_loading", static_cast<float>(0.001));
+    // Static weights, or MVDR steering vector: .weightN_re and .weightN_im, N = 0, ..., elements - 1
+    std::vector<gr_complex> steering_vector;
+    if (!configuration->property(role + ".weight0_re", std::string()).empty() or adaptive == "mvdr")
+        {
+            for (int e = 0; e < elements; e++)
+                {
+                    steering_vector.emplace_back(configuration->property(role + ".weight" + std::to_string(e) + "_re", static_cast<float>(1.0)),
+                        configuration->property(role + ".weight" + std::to_string(e) + "_im", static_cast<float>(0.0)));
+                }
+        }
+    if (adaptive != "none" and adaptive != "mvdr" and adaptive != "power_inversion")
+        {
+            LOG(WARNING) << role << ".adaptive=" << adaptive << " not recognized, using static weights";
+        }
+    if (adaptive == "power_inversion")
+        {
+            steering_vector.clear();
+        }
     DLOG(INFO) << "role " << role_;
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            beamformer_ = make_beamformer_sptr();
+            beamformer_ = make_beamformer_sptr(elements, steering_vector, adaptive == "mvdr" or adaptive == "power_inversion", snapshots, update_period, diagonal_loading);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "resampler(" << beamformer_->unique_id() << ")";
         }
@@ -53,9 +79,9 @@ BeamformerFilter::BeamformerFilter(
             file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
-    if (in_stream_ > 8)
+    if (in_stream_ > 1 and static_cast<int>(in_stream_) != elements)
         {
-            LOG(ERROR) << "This implementation only supports eight input streams";
+            LOG(ERROR) << role << ".elements is " << elements << ", but the beamformer has " << in_stream_ << " input streams";
         }
     if (out_stream_ > 1)
         {
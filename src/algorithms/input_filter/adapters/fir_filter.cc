@@ -31,15 +31,24 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration,
       role_(std::move(role)),
       item_size_(0),
       in_streams_(in_streams),
-      out_streams_(out_streams)
+      out_streams_(out_streams),
+      use_fft_(false)
 {
     (*this).init();
     DLOG(INFO) << "role " << role_;
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
             item_size_ = sizeof(gr_complex);
-            fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
-            DLOG(INFO) << "input_filter(" << fir_filter_ccf_->unique_id() << ")";
+            if (use_fft_)
+                {
+                    fft_fir_filter_cc_ = make_fft_fir_filter_cc(taps_);
+                    DLOG(INFO) << "input_filter(" << fft_fir_filter_cc_->unique_id() << ")";
+                }
+            else
+                {
+                    fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(1, taps_);
+                    DLOG(INFO) << "input_filter(" << fir_filter_ccf_->unique_id() << ")";
+                }
             if (dump_)
                 {
                     DLOG(INFO) << "Dumping output into file " << dump_filename_;
@@ -50,10 +59,7 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration,
         {
             item_size_ = sizeof(lv_16sc_t);
             cshort_to_float_x2_ = make_cshort_to_float_x2();
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
-            DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
-            DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
+            make_iq_filters();
             float_to_short_1_ = gr::blocks::float_to_short::make();
             float_to_short_2_ = gr::blocks::float_to_short::make();
             short_x2_to_cshort_ = make_short_x2_to_cshort();
@@ -67,10 +73,7 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration,
         {
             item_size_ = sizeof(gr_complex);
             cshort_to_float_x2_ = make_cshort_to_float_x2();
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
-            DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
-            DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
+            make_iq_filters();
             float_to_complex_ = gr::blocks::float_to_complex::make();
             if (dump_)
                 {
@@ -84,10 +87,7 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration,
             item_size_ = sizeof(gr_complex);
             cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
 
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
-            DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
-            DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
+            make_iq_filters();
 
             float_to_complex_ = gr::blocks::float_to_complex::make();
 
@@ -102,10 +102,7 @@ FirFilter::FirFilter(const ConfigurationInterface* configuration,
             item_size_ = sizeof(lv_8sc_t);
             cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
 
-            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
-            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
-            DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
-            DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
+            make_iq_filters();
 
             float_to_char_1_ = gr::blocks::float_to_char::make();
             float_to_char_2_ = gr::blocks::float_to_char::make();
@@ -146,6 +143,7 @@ void FirFilter::init()
     const int default_grid_density = 16;
     const int default_number_of_taps = 6;
     const unsigned int default_number_of_bands = 2;
+    const int default_fft_min_taps = 64;
 
     const int number_of_taps = config_->property(role_ + ".number_of_taps", default_number_of_taps);
     const unsigned int number_of_bands = config_->property(role_ + ".number_of_bands", default_number_of_bands);
@@ -192,6 +190,89 @@ void FirFilter::init()
     // those bands, and the weight given to the error in those bands.
     const std::vector<double> taps_d = gr::filter::pm_remez(number_of_taps - 1, bands, ampl, error_w, filter_type, grid_density);
     taps_ = std::vector<float>(taps_d.begin(), taps_d.end());
+
+    // Above this length, the filter is computed by FFT fast convolution,
+    // whose cost per sample grows with log(ntaps) instead of ntaps
+    const int fft_min_taps = config_->property(role_ + ".fft_min_taps", default_fft_min_taps);
+    use_fft_ = fft_min_taps > 0 and static_cast<int>(taps_.size()) >= fft_min_taps;
+    if (use_fft_)
+        {
+            LOG(INFO) << role_ << ": filtering " << taps_.size() << " taps by FFT overlap-save convolution";
+        }
+}
+
+
+void FirFilter::make_iq_filters()
+{
+    if (use_fft_)
+        {
+            // one complex filter for both components, since the taps are real
+            iq_to_complex_ = gr::blocks::float_to_complex::make();
+            fft_fir_filter_cc_ = make_fft_fir_filter_cc(taps_);
+            complex_to_iq_ = gr::blocks::complex_to_float::make();
+            DLOG(INFO) << "I/Q input_filter(" << fft_fir_filter_cc_->unique_id() << ")";
+        }
+    else
+        {
+            fir_filter_fff_1_ = gr::filter::fir_filter_fff::make(1, taps_);
+            fir_filter_fff_2_ = gr::filter::fir_filter_fff::make(1, taps_);
+            DLOG(INFO) << "I input_filter(" << fir_filter_fff_1_->unique_id() << ")";
+            DLOG(INFO) << "Q input_filter(" << fir_filter_fff_2_->unique_id() << ")";
+        }
+}
+
+
+void FirFilter::connect_iq_filters(const gr::top_block_sptr& top_block, const gr::basic_block_sptr& src,
+    const gr::basic_block_sptr& dst_i, int port_i, const gr::basic_block_sptr& dst_q, int port_q)
+{
+    if (use_fft_)
+        {
+            top_block->connect(src, 0, iq_to_complex_, 0);
+            top_block->connect(src, 1, iq_to_complex_, 1);
+            top_block->connect(iq_to_complex_, 0, fft_fir_filter_cc_, 0);
+            top_block->connect(fft_fir_filter_cc_, 0, complex_to_iq_, 0);
+            top_block->connect(complex_to_iq_, 0, dst_i, port_i);
+            top_block->connect(complex_to_iq_, 1, dst_q, port_q);
+        }
+    else
+        {
+            top_block->connect(src, 0, fir_filter_fff_1_, 0);
+            top_block->connect(src, 1, fir_filter_fff_2_, 0);
+            top_block->connect(fir_filter_fff_1_, 0, dst_i, port_i);
+            top_block->connect(fir_filter_fff_2_, 0, dst_q, port_q);
+        }
+}
+
+
+void FirFilter::disconnect_iq_filters(const gr::top_block_sptr& top_block, const gr::basic_block_sptr& src,
+    const gr::basic_block_sptr& dst_i, int port_i, const gr::basic_block_sptr& dst_q, int port_q)
+{
+    if (use_fft_)
+        {
+            top_block->disconnect(complex_to_iq_, 1, dst_q, port_q);
+            top_block->disconnect(complex_to_iq_, 0, dst_i, port_i);
+            top_block->disconnect(fft_fir_filter_cc_, 0, complex_to_iq_, 0);
+            top_block->disconnect(iq_to_complex_, 0, fft_fir_filter_cc_, 0);
+            top_block->disconnect(src, 1, iq_to_complex_, 1);
+            top_block->disconnect(src, 0, iq_to_complex_, 0);
+        }
+    else
+        {
+            top_block->disconnect(fir_filter_fff_2_, 0, dst_q, port_q);
+            top_block->disconnect(fir_filter_fff_1_, 0, dst_i, port_i);
+            top_block->disconnect(src, 1, fir_filter_fff_2_, 0);
+            top_block->disconnect(src, 0, fir_filter_fff_1_, 0);
+        }
+}
+
+
+gr::basic_block_sptr FirFilter::complex_filter() const
+{
+    if (use_fft_)
+        {
+            return fft_fir_filter_cc_;
+        }
+    return fir_filter_ccf_;
 }
 
 
@@ -201,7 +282,7 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(fir_filter_ccf_, 0, file_sink_, 0);
+                    top_block->connect(complex_filter(), 0, file_sink_, 0);
                 }
             else
                 {
@@ -210,10 +291,7 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
         {
-            top_block->connect(cshort_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->connect(cshort_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->connect(fir_filter_fff_1_, 0, float_to_short_1_, 0);
-            top_block->connect(fir_filter_fff_2_, 0, float_to_short_2_, 0);
+            connect_iq_filters(top_block, cshort_to_float_x2_, float_to_short_1_, 0, float_to_short_2_, 0);
             top_block->connect(float_to_short_1_, 0, short_x2_to_cshort_, 0);
             top_block->connect(float_to_short_2_, 0, short_x2_to_cshort_, 1);
             if (dump_)
@@ -223,10 +301,7 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cbyte") && (output_item_type_ == "gr_complex"))
         {
-            top_block->connect(cbyte_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->connect(fir_filter_fff_1_, 0, float_to_complex_, 0);
-            top_block->connect(fir_filter_fff_2_, 0, float_to_complex_, 1);
+            connect_iq_filters(top_block, cbyte_to_float_x2_, float_to_complex_, 0, float_to_complex_, 1);
             if (dump_)
                 {
                     top_block->connect(float_to_complex_, 0, file_sink_, 0);
@@ -234,10 +309,7 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cbyte") && (output_item_type_ == "cbyte"))
         {
-            top_block->connect(cbyte_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->connect(fir_filter_fff_1_, 0, float_to_char_1_, 0);
-            top_block->connect(fir_filter_fff_2_, 0, float_to_char_2_, 0);
+            connect_iq_filters(top_block, cbyte_to_float_x2_, float_to_char_1_, 0, float_to_char_2_, 0);
             top_block->connect(float_to_char_1_, 0, char_x2_cbyte_, 0);
             top_block->connect(float_to_char_2_, 0, char_x2_cbyte_, 1);
             if (dump_)
@@ -247,10 +319,7 @@ void FirFilter::connect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "gr_complex"))
         {
-            top_block->connect(cshort_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->connect(cshort_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->connect(fir_filter_fff_1_, 0, float_to_complex_, 0);
-            top_block->connect(fir_filter_fff_2_, 0, float_to_complex_, 1);
+            connect_iq_filters(top_block, cshort_to_float_x2_, float_to_complex_, 0, float_to_complex_, 1);
             if (dump_)
                 {
                     top_block->connect(float_to_complex_, 0, file_sink_, 0);
@@ -269,15 +338,12 @@ void FirFilter::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(fir_filter_ccf_, 0, file_sink_, 0);
+                    top_block->disconnect(complex_filter(), 0, file_sink_, 0);
                 }
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cbyte") && (output_item_type_ == "gr_complex"))
         {
-            top_block->disconnect(fir_filter_fff_2_, 0, float_to_complex_, 1);
-            top_block->disconnect(fir_filter_fff_1_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 0, fir_filter_fff_1_, 0);
+            disconnect_iq_filters(top_block, cbyte_to_float_x2_, float_to_complex_, 0, float_to_complex_, 1);
             if (dump_)
                 {
                     top_block->disconnect(float_to_complex_, 0, file_sink_, 0);
@@ -285,10 +351,7 @@ void FirFilter::disconnect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
         {
-            top_block->disconnect(cshort_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->disconnect(cshort_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->disconnect(fir_filter_fff_1_, 0, float_to_short_1_, 0);
-            top_block->disconnect(fir_filter_fff_2_, 0, float_to_short_2_, 0);
+            disconnect_iq_filters(top_block, cshort_to_float_x2_, float_to_short_1_, 0, float_to_short_2_, 0);
             top_block->disconnect(float_to_short_1_, 0, short_x2_to_cshort_, 0);
             top_block->disconnect(float_to_short_2_, 0, short_x2_to_cshort_, 1);
             if (dump_)
@@ -300,10 +363,7 @@ void FirFilter::disconnect(gr::top_block_sptr top_block)
         {
             top_block->disconnect(float_to_char_2_, 0, char_x2_cbyte_, 1);
             top_block->disconnect(float_to_char_1_, 0, char_x2_cbyte_, 0);
-            top_block->disconnect(fir_filter_fff_2_, 0, float_to_char_2_, 0);
-            top_block->disconnect(fir_filter_fff_1_, 0, float_to_char_1_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, fir_filter_fff_2_, 0);
+            disconnect_iq_filters(top_block, cbyte_to_float_x2_, float_to_char_1_, 0, float_to_char_2_, 0);
             if (dump_)
                 {
                     top_block->disconnect(char_x2_cbyte_, 0, file_sink_, 0);
@@ -311,10 +371,7 @@ void FirFilter::disconnect(gr::top_block_sptr top_block)
         }
     else if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "gr_complex"))
         {
-            top_block->disconnect(cshort_to_float_x2_, 0, fir_filter_fff_1_, 0);
-            top_block->disconnect(cshort_to_float_x2_, 1, fir_filter_fff_2_, 0);
-            top_block->disconnect(fir_filter_fff_1_, 0, float_to_complex_, 0);
-            top_block->disconnect(fir_filter_fff_2_, 0, float_to_complex_, 1);
+            disconnect_iq_filters(top_block, cshort_to_float_x2_, float_to_complex_, 0, float_to_complex_, 1);
             if (dump_)
                 {
                     top_block->disconnect(float_to_complex_, 0, file_sink_, 0);
@@ -331,7 +388,7 @@ gr::basic_block_sptr FirFilter::get_left_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
-            return fir_filter_ccf_;
+            return complex_filter();
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
         {
@@ -358,7 +415,7 @@ gr::basic_block_sptr FirFilter::get_right_block()
 {
     if ((taps_item_type_ == "float") && (input_item_type_ == "gr_complex") && (output_item_type_ == "gr_complex"))
         {
-            return fir_filter_ccf_;
+            return complex_filter();
         }
     if ((taps_item_type_ == "float") && (input_item_type_ == "cshort") && (output_item_type_ == "cshort"))
         {
@@ -21,8 +21,10 @@
 #include "byte_x2_to_complex_byte.h"
 #include "complex_byte_to_float_x2.h"
 #include "cshort_to_float_x2.h"
+#include "fft_fir_filter_cc.h"
 #include "gnss_block_interface.h"
 #include "short_x2_to_cshort.h"
+#include <gnuradio/blocks/complex_to_float.h>
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/float_to_char.h>
 #include <gnuradio/blocks/float_to_complex.h>
@@ -55,6 +57,9 @@ class ConfigurationInterface;
  * Calculates the optimal (in the Chebyshev/minimax sense) FIR filter impulse response
  * given a set of band edges, the desired response on those bands, and the weight given
  * to the error in those bands.
+ *
+ * Filters of fft_min_taps taps or more are computed by FFT fast convolution
+ * (see fft_fir_filter_cc), with the same output.
  */
 class FirFilter : public GNSSBlockInterface
 {
@@ -91,10 +96,19 @@ public:
 
 private:
     void init();
+    void make_iq_filters();
+    void connect_iq_filters(const gr::top_block_sptr& top_block, const gr::basic_block_sptr& src,
+        const gr::basic_block_sptr& dst_i, int port_i, const gr::basic_block_sptr& dst_q, int port_q);
+    void disconnect_iq_filters(const gr::top_block_sptr& top_block, const gr::basic_block_sptr& src,
+        const gr::basic_block_sptr& dst_i, int port_i, const gr::basic_block_sptr& dst_q, int port_q);
+    gr::basic_block_sptr complex_filter() const;
 
     gr::filter::fir_filter_ccf::sptr fir_filter_ccf_;
     gr::filter::fir_filter_fff::sptr fir_filter_fff_1_;
     gr::filter::fir_filter_fff::sptr fir_filter_fff_2_;
+    fft_fir_filter_cc_sptr fft_fir_filter_cc_;
+    gr::blocks::float_to_complex::sptr iq_to_complex_;
+    gr::blocks::complex_to_float::sptr complex_to_iq_;
     gr::blocks::float_to_complex::sptr float_to_complex_;
     gr::blocks::float_to_short::sptr float_to_short_1_;
     gr::blocks::float_to_short::sptr float_to_short_2_;
@@ -116,6 +130,7 @@ private:
     unsigned int in_streams_;
     unsigned int out_streams_;
     bool dump_;
+    bool use_fft_;
 };
 
 
@@ -20,6 +20,7 @@
 #include "notch_cc.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 
 
 NotchFilter::NotchFilter(const ConfigurationInterface* configuration,
@@ -49,10 +50,11 @@ NotchFilter::NotchFilter(const ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
 
     DLOG(INFO) << "role " << role_;
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
-            item_size_ = sizeof(gr_complex);
-            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset);
+            const bool cshort_items = item_type_ == "cshort";
+            item_size_ = cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex);
+            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset, cshort_items);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_->unique_id() << ")";
         }
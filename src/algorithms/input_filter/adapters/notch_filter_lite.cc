@@ -20,6 +20,7 @@
 #include "notch_lite_cc.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <algorithm>  // for max
 
 
@@ -56,10 +57,11 @@ NotchFilterLite::NotchFilterLite(const ConfigurationInterface* configuration,
     int n_segments_coeff = static_cast<int>((samp_freq / coeff_rate) / static_cast<float>(length_));
     n_segments_coeff = std::max(1, n_segments_coeff);
     DLOG(INFO) << "role " << role_;
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
-            item_size_ = sizeof(gr_complex);
-            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff);
+            const bool cshort_items = item_type_ == "cshort";
+            item_size_ = cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex);
+            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff, cshort_items);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_lite_->unique_id() << ")";
         }
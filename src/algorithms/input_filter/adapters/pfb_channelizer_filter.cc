@@ -0,0 +1,154 @@
+/*!
+ * \file pfb_channelizer_filter.cc
+ * \brief Splits a wideband input into several narrowband streams, one per
+ * GNSS band, with a polyphase filterbank channelizer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pfb_channelizer_filter.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/filter/firdes.h>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+
+PfbChannelizerFilter::PfbChannelizerFilter(const ConfigurationInterface* configuration,
+    std::string role,
+    unsigned int in_streams,
+    unsigned int out_streams)
+    : role_(std::move(role)),
+      in_streams_(in_streams),
+      out_streams_(out_streams)
+{
+    const std::string default_item_type("gr_complex");
+    const std::string default_dump_filename("../data/channelizer.dat");
+    const double default_sampling_freq = 4000000.0;
+    const unsigned int default_number_of_channels = 1;
+    const float default_oversample_rate = 1.0;
+
+    const std::string input_item_type = configuration->property(role_ + ".input_item_type", default_item_type);
+    const std::string output_item_type = configuration->property(role_ + ".output_item_type", default_item_type);
+    const float oversample_rate = configuration->property(role_ + ".oversample_rate", default_oversample_rate);
+    sampling_freq_ = configuration->property(role_ + ".sampling_frequency", default_sampling_freq);
+    number_of_channels_ = configuration->property(role_ + ".number_of_channels", default_number_of_channels);
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
+    dump_ = configuration->property(role_ + ".dump", false);
+
+    if (number_of_channels_ == 0)
+        {
+            LOG(ERROR) << role_ << ".number_of_channels must be greater than zero";
+            number_of_channels_ = 1;
+        }
+    if (input_item_type != "gr_complex" or output_item_type != "gr_complex")
+        {
+            LOG(ERROR) << "This implementation only supports gr_complex input and output items";
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+
+    // Prototype low-pass filter, designed at the input rate. Its cutoff is
+    // half the channel spacing, so that each channel holds one band.
+    channel_freq_ = sampling_freq_ / static_cast<double>(number_of_channels_);
+    const double default_bw = channel_freq_ / 2.0;
+    const double bw = configuration->property(role_ + ".bw", default_bw);
+    const double default_tw = bw / 5.0;
+    const double tw = configuration->property(role_ + ".tw", default_tw);
+    taps_ = gr::filter::firdes::low_pass(1.0, sampling_freq_, bw, tw);
+
+    const double output_freq = channel_freq_ * static_cast<double>(oversample_rate);
+    for (unsigned int band = 0; band < out_streams_; band++)
+        {
+            // Channel i is centered at i * channel_freq_, the upper half of them at negative frequencies
+            const double intermediate_freq = configuration->property(role_ + ".band" + std::to_string(band + 1) + "_IF", 0.0);
+            const auto nearest = static_cast<int>(std::round(intermediate_freq / channel_freq_));
+            const int channel = ((nearest % static_cast<int>(number_of_channels_)) + static_cast<int>(number_of_channels_)) % static_cast<int>(number_of_channels_);
+            const double residual_freq = intermediate_freq - static_cast<double>(nearest) * channel_freq_;
+            channel_map_.push_back(channel);
+            band_shifters_.push_back(gr::filter::freq_xlating_fir_filter_ccf::make(1, std::vector<float>{1.0}, residual_freq, output_freq));
+            LOG(INFO) << role_ << " band " << band + 1 << " (IF " << intermediate_freq << " Hz) taken from channel " << channel
+                      << ", with a residual offset of " << residual_freq << " Hz, at " << output_freq << " sps";
+            if (dump_)
+                {
+                    const std::string filename = dump_filename_ + "_band" + std::to_string(band + 1);
+                    std::cout << "Dumping output into file " << filename << '\n';
+                    file_sinks_.push_back(gr::blocks::file_sink::make(sizeof(gr_complex), filename.c_str()));
+                }
+        }
+
+    stream_to_streams_ = gr::blocks::stream_to_streams::make(sizeof(gr_complex), number_of_channels_);
+    channelizer_ = gr::filter::pfb_channelizer_ccf::make(number_of_channels_, taps_, oversample_rate);
+    // only the channels of the configured bands are computed and sent out
+    channelizer_->set_channel_map(channel_map_);
+    LOG(INFO) << "Created pfb_channelizer with " << number_of_channels_ << " channels and " << taps_.size() << " taps";
+}
+
+
+void PfbChannelizerFilter::connect(gr::top_block_sptr top_block)
+{
+    for (unsigned int i = 0; i < number_of_channels_; i++)
+        {
+            top_block->connect(stream_to_streams_, i, channelizer_, i);
+        }
+    for (unsigned int band = 0; band < band_shifters_.size(); band++)
+        {
+            top_block->connect(channelizer_, band, band_shifters_[band], 0);
+            if (dump_)
+                {
+                    top_block->connect(band_shifters_[band], 0, file_sinks_[band], 0);
+                }
+        }
+    DLOG(INFO) << "pfb_channelizer connected";
+}
+
+
+void PfbChannelizerFilter::disconnect(gr::top_block_sptr top_block)
+{
+    for (unsigned int band = 0; band < band_shifters_.size(); band++)
+        {
+            if (dump_)
+                {
+                    top_block->disconnect(band_shifters_[band], 0, file_sinks_[band], 0);
+                }
+            top_block->disconnect(channelizer_, band, band_shifters_[band], 0);
+        }
+    for (unsigned int i = 0; i < number_of_channels_; i++)
+        {
+            top_block->disconnect(stream_to_streams_, i, channelizer_, i);
+        }
+}
+
+
+gr::basic_block_sptr PfbChannelizerFilter::get_left_block()
+{
+    return stream_to_streams_;
+}
+
+
+gr::basic_block_sptr PfbChannelizerFilter::get_right_block()
+{
+    return get_right_block(0);
+}
+
+
+gr::basic_block_sptr PfbChannelizerFilter::get_right_block(int RF_channel)
+{
+    if (RF_channel < 0 or RF_channel >= static_cast<int>(band_shifters_.size()))
+        {
+            LOG(ERROR) << role_ << " has no band " << RF_channel;
+            return nullptr;
+        }
+    return band_shifters_[RF_channel];
+}
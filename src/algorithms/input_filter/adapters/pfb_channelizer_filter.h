@@ -0,0 +1,103 @@
+/*!
+ * \file pfb_channelizer_filter.h
+ * \brief Splits a wideband input into several narrowband streams, one per
+ * GNSS band, with a polyphase filterbank channelizer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PFB_CHANNELIZER_FILTER_H
+#define GNSS_SDR_PFB_CHANNELIZER_FILTER_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/stream_to_streams.h>
+#include <gnuradio/filter/pfb_channelizer_ccf.h>
+#ifdef GR_GREATER_38
+#include <gnuradio/filter/freq_xlating_fir_filter.h>
+#else
+#include <gnuradio/filter/freq_xlating_fir_filter_ccf.h>
+#endif
+#include <string>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Extracts all the configured bands of a wideband input in one pass.
+ *
+ * The input, sampled at sampling_freq_, is split into number_of_channels_
+ * channels spaced sampling_freq_ / number_of_channels_ apart and decimated
+ * by the same factor (divided by the oversampling rate) with a polyphase
+ * filterbank, so that the filtering and decimation is shared by all the
+ * bands instead of being done once per band over the full-rate input. Each
+ * band takes the channel closest to its intermediate frequency, and the
+ * remaining offset is removed at the channel rate. Output k, available with
+ * get_right_block(k), feeds the signal conditioner of band k.
+ */
+class PfbChannelizerFilter : public GNSSBlockInterface
+{
+public:
+    PfbChannelizerFilter(const ConfigurationInterface* configuration,
+        std::string role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~PfbChannelizerFilter() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "Pfb_Channelizer_Filter"
+    inline std::string implementation() override
+    {
+        return "Pfb_Channelizer_Filter";
+    }
+
+    inline size_t item_size() override
+    {
+        return sizeof(gr_complex);
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+    gr::basic_block_sptr get_right_block(int RF_channel) override;
+
+private:
+    gr::blocks::stream_to_streams::sptr stream_to_streams_;
+    gr::filter::pfb_channelizer_ccf::sptr channelizer_;
+    std::vector<gr::filter::freq_xlating_fir_filter_ccf::sptr> band_shifters_;
+    std::vector<gr::blocks::file_sink::sptr> file_sinks_;
+    std::vector<float> taps_;
+    std::vector<int> channel_map_;
+    std::string dump_filename_;
+    std::string role_;
+    double sampling_freq_;
+    double channel_freq_;
+    unsigned int number_of_channels_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PFB_CHANNELIZER_FILTER_H
@@ -21,6 +21,7 @@
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/filter/firdes.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -60,13 +61,24 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
             input_size_ = sizeof(gr_complex);  // input
             pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset);
         }
+    else if (item_type_ == "cshort")
+        {
+            item_size = sizeof(lv_16sc_t);    // output
+            input_size_ = sizeof(lv_16sc_t);  // input
+            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, true);
+        }
     else
         {
             LOG(ERROR) << "Unknown input filter item_types conversion";
             item_size = sizeof(gr_complex);  // avoids uninitialization
             input_size_ = 0;                 // notify wrong configuration
         }
-    if (std::abs(if_) > 1.0)
+    if (std::abs(if_) > 1.0 and item_type_ == "cshort")
+        {
+            LOG(WARNING) << role_ << ".IF is not supported with cshort items, and it will be ignored";
+            xlat_ = false;
+        }
+    else if (std::abs(if_) > 1.0)
         {
             xlat_ = true;
             const double default_sampling_freq = 4000000.0;
@@ -101,7 +113,7 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
 
 void PulseBlankingFilter::connect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
             if (dump_)
                 {
@@ -122,7 +134,7 @@ void PulseBlankingFilter::connect(gr::top_block_sptr top_block)
 
 void PulseBlankingFilter::disconnect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
             if (dump_)
                 {
@@ -142,7 +154,7 @@ void PulseBlankingFilter::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr PulseBlankingFilter::get_left_block()
 {
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
             if (xlat_)
                 {
@@ -157,7 +169,7 @@ gr::basic_block_sptr PulseBlankingFilter::get_left_block()
 
 gr::basic_block_sptr PulseBlankingFilter::get_right_block()
 {
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
             return pulse_blanking_cc_;
         }
@@ -1,36 +1,218 @@
 /*!
  * \file beamformer.cc
  *
- * \brief Unpacks byte samples to NSR 2 bits samples
+ * \brief Spatial filter of the streams of an antenna array, with static or
+ * adaptive (MVDR / power inversion) beamforming coefficients
  * \author Javier Arribas jarribas (at) cttc.es
+ *
  * -----------------------------------------------------------------------------
  *
  * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
  * This file is part of GNSS-SDR.
  *
- * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
  * SPDX-License-Identifier: GPL-3.0-or-later
  *
  * -----------------------------------------------------------------------------
  */
 
-
 #include "beamformer.h"
+#include "gnss_sdr_thread_pool.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <chrono>
+#include <complex>
 #include <cstddef>
+#include <cstring>
+
+namespace
+{
+// samples per pass over the elements, so that the output and the scratch
+// block stay in cache while all the elements are accumulated
+const int BEAMFORMER_BLOCK_ITEMS = 2048;
 
+// shorter buffers are not worth splitting among workers
+const int BEAMFORMER_MIN_ITEMS_PER_WORKER = 16384;
+}  // namespace
 
-beamformer_sptr make_beamformer_sptr()
+
+beamformer_sptr make_beamformer_sptr(int num_elements,
+    const std::vector<gr_complex> &steering_vector,
+    bool adaptive,
+    int snapshots,
+    int update_period,
+    float diagonal_loading)
 {
-    return beamformer_sptr(new beamformer());
+    return beamformer_sptr(new beamformer(num_elements, steering_vector, adaptive, snapshots, update_period, diagonal_loading));
 }
 
 
-beamformer::beamformer()
+beamformer::beamformer(int num_elements,
+    const std::vector<gr_complex> &steering_vector,
+    bool adaptive,
+    int snapshots,
+    int update_period,
+    float diagonal_loading)
     : gr::sync_block("beamformer",
-          gr::io_signature::make(GNSS_SDR_BEAMFORMER_CHANNELS, GNSS_SDR_BEAMFORMER_CHANNELS, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex)))
+          gr::io_signature::make(std::max(1, num_elements), std::max(1, num_elements), sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_diagonal_loading(diagonal_loading),
+      d_num_elements(std::max(1, num_elements)),
+      d_num_snapshots(std::max(d_num_elements, snapshots)),
+      d_update_period(std::max(0, update_period)),
+      d_adaptive(adaptive)
+{
+    std::vector<gr_complex> steering(steering_vector);
+    if (!steering.empty() and static_cast<int>(steering.size()) != d_num_elements)
+        {
+            LOG(WARNING) << "The beamformer steering vector has " << steering.size()
+                         << " elements, but the array has " << d_num_elements << ". Using the default one.";
+            steering.clear();
+        }
+
+    std::vector<gr_complex> initial_weights;
+    if (d_adaptive)
+        {
+            if (steering.empty())
+                {
+                    // power inversion: distortionless response of the reference element
+                    steering = std::vector<gr_complex>(d_num_elements, gr_complex(0.0, 0.0));
+                    steering[0] = gr_complex(1.0, 0.0);
+                }
+            d_steering_vector = arma::cx_fvec(steering);
+            d_snapshots = arma::cx_fmat(d_num_snapshots, d_num_elements);
+
+            // conventional beamformer until the first estimation is available
+            const float norm = arma::norm(d_steering_vector);
+            for (const auto &a : steering)
+                {
+                    initial_weights.push_back(std::conj(a) / (norm * norm));
+                }
+        }
+    else
+        {
+            initial_weights = steering.empty() ? std::vector<gr_complex>(d_num_elements, gr_complex(1.0, 0.0)) : steering;
+        }
+    for (auto &slot : d_weights)
+        {
+            slot = initial_weights;
+        }
+    d_last_weights = initial_weights;
+
+    const size_t workers = std::max(static_cast<size_t>(1), Gnss_Thread_Pool::instance().size());
+    d_scratch = std::vector<volk_gnsssdr::vector<gr_complex>>(workers, volk_gnsssdr::vector<gr_complex>(BEAMFORMER_BLOCK_ITEMS));
+}
+
+
+beamformer::~beamformer()
+{
+    d_stop.store(true);
+    d_adaptation_cv.notify_one();
+    if (d_adaptation_thread.joinable())
+        {
+            d_adaptation_thread.join();
+        }
+}
+
+
+bool beamformer::start()
+{
+    if (d_adaptive and !d_adaptation_thread.joinable())
+        {
+            d_stop.store(false);
+            d_adaptation_thread = std::thread(&beamformer::adaptation_loop, this);
+        }
+    return gr::sync_block::start();
+}
+
+
+bool beamformer::stop()
+{
+    d_stop.store(true);
+    d_adaptation_cv.notify_one();
+    if (d_adaptation_thread.joinable())
+        {
+            d_adaptation_thread.join();
+        }
+    return gr::sync_block::stop();
+}
+
+
+void beamformer::set_weights(const std::vector<gr_complex> &weights)
+{
+    if (static_cast<int>(weights.size()) != d_num_elements)
+        {
+            LOG(WARNING) << "Ignoring " << weights.size() << " beamformer weights for an array of " << d_num_elements << " elements";
+            return;
+        }
+    publish_weights(weights);
+}
+
+
+std::vector<gr_complex> beamformer::get_weights() const
+{
+    std::lock_guard<std::mutex> lock(d_writer_mutex);
+    return d_last_weights;
+}
+
+
+void beamformer::publish_weights(const std::vector<gr_complex> &weights)
+{
+    std::lock_guard<std::mutex> lock(d_writer_mutex);
+    d_weights[d_back] = weights;
+    d_back = d_middle.exchange(d_back | NEW_WEIGHTS, std::memory_order_acq_rel) & ~NEW_WEIGHTS;
+    d_last_weights = weights;
+}
+
+
+void beamformer::take_new_weights()
 {
+    if (d_middle.load(std::memory_order_relaxed) & NEW_WEIGHTS)
+        {
+            d_front = d_middle.exchange(d_front, std::memory_order_acq_rel) & ~NEW_WEIGHTS;
+        }
+}
+
+
+void beamformer::take_snapshots(int noutput_items, const gr_vector_const_void_star &input_items)
+{
+    d_samples_since_update += noutput_items;
+    if (d_samples_since_update < static_cast<uint64_t>(d_update_period) or !d_snapshots_wanted.load(std::memory_order_acquire))
+        {
+            return;
+        }
+    const int n = std::min(noutput_items, d_num_snapshots - d_snapshot_count);
+    for (int e = 0; e < d_num_elements; e++)
+        {
+            memcpy(d_snapshots.colptr(e) + d_snapshot_count, input_items[e], sizeof(gr_complex) * n);
+        }
+    d_snapshot_count += n;
+    if (d_snapshot_count == d_num_snapshots)
+        {
+            d_snapshot_count = 0;
+            d_samples_since_update = 0;
+            d_snapshots_wanted.store(false, std::memory_order_relaxed);
+            d_snapshots_ready.store(true, std::memory_order_release);
+            d_adaptation_cv.notify_one();
+        }
+}
+
+
+void beamformer::beamform(int first, int last, const gr_vector_const_void_star &input_items, gr_complex *out, gr_complex *scratch) const
+{
+    const std::vector<gr_complex> &weights = d_weights[d_front];
+    for (int n = first; n < last; n += BEAMFORMER_BLOCK_ITEMS)
+        {
+            const auto length = static_cast<unsigned int>(std::min(BEAMFORMER_BLOCK_ITEMS, last - n));
+            volk_32fc_s32fc_multiply_32fc(out + n, reinterpret_cast<const gr_complex *>(input_items[0]) + n, weights[0], length);
+            for (int e = 1; e < d_num_elements; e++)
+                {
+                    volk_32fc_s32fc_multiply_32fc(scratch, reinterpret_cast<const gr_complex *>(input_items[e]) + n, weights[e], length);
+                    volk_32f_x2_add_32f(reinterpret_cast<float *>(out + n), reinterpret_cast<const float *>(out + n), reinterpret_cast<const float *>(scratch), 2 * length);
+                }
+        }
 }
 
 
@@ -38,28 +220,85 @@ int beamformer::work(int noutput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    // channel output buffers
-    //  gr_complex *ch1 = (gr_complex *) input_items[0];
-    //  gr_complex *ch2 = (gr_complex *) input_items[1];
-    //  gr_complex *ch3 = (gr_complex *) input_items[2];
-    //  gr_complex *ch4 = (gr_complex *) input_items[3];
-    //  gr_complex *ch5 = (gr_complex *) input_items[4];
-    //  gr_complex *ch6 = (gr_complex *) input_items[5];
-    //  gr_complex *ch7 = (gr_complex *) input_items[6];
-    //  gr_complex *ch8 = (gr_complex *) input_items[7];
-
-    // NON-VOLK beamforming operation
-    // TODO: Implement VOLK SIMD-accelerated beamformer!
-    gr_complex sum;
-    for (int n = 0; n < noutput_items; n++)
-        {
-            sum = gr_complex(0, 0);
-            for (size_t i = 0; i < weight_vector.size(); i++)
+
+    take_new_weights();
+    if (d_adaptive)
+        {
+            take_snapshots(noutput_items, input_items);
+        }
+
+    const int chunks = std::min(static_cast<int>(d_scratch.size()), noutput_items / BEAMFORMER_MIN_ITEMS_PER_WORKER);
+    if (chunks <= 1)
+        {
+            beamform(0, noutput_items, input_items, out, d_scratch[0].data());
+        }
+    else
+        {
+            Gnss_Thread_Pool::instance().parallel_for(chunks, [&](size_t chunk) {
+                const auto first = static_cast<int>((static_cast<int64_t>(noutput_items) * chunk) / chunks);
+                const auto last = static_cast<int>((static_cast<int64_t>(noutput_items) * (chunk + 1)) / chunks);
+                beamform(first, last, input_items, out, d_scratch[chunk].data());
+            });
+        }
+
+    return noutput_items;
+}
+
+
+void beamformer::adaptation_loop()
+{
+    std::vector<gr_complex> weights;
+    while (!d_stop.load())
+        {
+            d_snapshots_wanted.store(true, std::memory_order_release);
+            {
+                std::unique_lock<std::mutex> lock(d_adaptation_mutex);
+                // work() does not take the mutex to notify, so the wait is bounded
+                while (!d_snapshots_ready.load(std::memory_order_acquire) and !d_stop.load())
+                    {
+                        d_adaptation_cv.wait_for(lock, std::chrono::milliseconds(100));
+                    }
+            }
+            if (d_stop.load())
+                {
+                    break;
+                }
+            d_snapshots_ready.store(false, std::memory_order_relaxed);
+            if (compute_adaptive_weights(weights))
                 {
-                    sum = sum + (reinterpret_cast<const gr_complex *>(input_items[i]))[n] * weight_vector[i];
+                    publish_weights(weights);
                 }
-            out[n] = sum;
         }
+}
 
-    return noutput_items;
+
+bool beamformer::compute_adaptive_weights(std::vector<gr_complex> &weights) const
+{
+    // sample covariance matrix, R(i, j) = E{x_i conj(x_j)}
+    arma::cx_fmat R = d_snapshots.st() * arma::conj(d_snapshots) / static_cast<float>(d_num_snapshots);
+    const float power = std::real(arma::trace(R)) / static_cast<float>(d_num_elements);
+    if (!(power > 0.0))
+        {
+            return false;
+        }
+    R.diag() += gr_complex(d_diagonal_loading * power, 0.0);
+
+    // w = R^-1 a / (a^H R^-1 a), applied as y = w^H x
+    arma::cx_fvec u;
+    if (!arma::solve(u, R, d_steering_vector))
+        {
+            LOG(WARNING) << "Singular beamformer covariance matrix, keeping the previous weights";
+            return false;
+        }
+    const gr_complex gain = arma::cdot(d_steering_vector, u);
+    if (std::abs(gain) == 0.0)
+        {
+            return false;
+        }
+    weights.resize(d_num_elements);
+    for (int e = 0; e < d_num_elements; e++)
+        {
+            weights[e] = std::conj(u(e) / gain);
+        }
+    return true;
 }
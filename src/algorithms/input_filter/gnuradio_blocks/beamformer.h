@@ -1,7 +1,8 @@
 /*!
  * \file beamformer.h
  *
- * \brief Simple spatial filter using RAW array input and beamforming coefficients
+ * \brief Spatial filter of the streams of an antenna array, with static or
+ * adaptive (MVDR / power inversion) beamforming coefficients
  * \author Javier Arribas jarribas (at) cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -9,7 +10,7 @@
  * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
  * This file is part of GNSS-SDR.
  *
- * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
  * SPDX-License-Identifier: GPL-3.0-or-later
  *
  * -----------------------------------------------------------------------------
@@ -19,7 +20,15 @@
 #define GNSS_SDR_BEAMFORMER_H
 
 #include "gnss_block_interface.h"
+#include <gnuradio/gr_complex.h>
 #include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <armadillo>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 /** \addtogroup Input_Filter
@@ -32,24 +41,109 @@ class beamformer;
 
 using beamformer_sptr = gnss_shared_ptr<beamformer>;
 
-beamformer_sptr make_beamformer_sptr();
-
 const int GNSS_SDR_BEAMFORMER_CHANNELS = 8;
 
 /*!
- * \brief This class implements a real-time software-defined spatial filter using the CTTC GNSS experimental antenna array input and a set of dynamically reloadable weights
+ * \brief Returns a beamformer of num_elements input streams.
+ *
+ * With adaptive set to false, the output is the sum of the inputs weighted by
+ * steering_vector (all ones if empty). With adaptive set to true, the weights
+ * are the MVDR solution for steering_vector, recomputed from a batch of
+ * snapshots samples taken every update_period samples. An empty steering_vector selects
+ * power inversion (unit gain on the first element, which minimizes the output
+ * power), the usual choice when the direction of the satellites is unknown.
+ * diagonal_loading is relative to the average power of the elements.
+ */
+beamformer_sptr make_beamformer_sptr(int num_elements = GNSS_SDR_BEAMFORMER_CHANNELS,
+    const std::vector<gr_complex> &steering_vector = std::vector<gr_complex>(),
+    bool adaptive = false,
+    int snapshots = 4096,
+    int update_period = 1000000,
+    float diagonal_loading = 0.001);
+
+/*!
+ * \brief This class implements a real-time software-defined spatial filter for
+ * antenna arrays with any number of elements.
+ *
+ * The weighted sum is computed with VOLK kernels over cache-sized blocks of
+ * samples, and long buffers are split among the workers of Gnss_Thread_Pool.
+ * The adaptive weights are computed in a background thread: the sample path
+ * only copies a batch of snapshots when that thread asks for one, and picks
+ * up new weights through a lock-free triple buffer, so work() never waits
+ * for the estimation nor for set_weights().
  */
 class beamformer : public gr::sync_block
 {
 public:
-    ~beamformer() = default;
+    ~beamformer();
+
+    bool start() override;
+    bool stop() override;
+
     int work(int noutput_items, gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
+    /*!
+     * \brief Replaces the weights applied to the elements (output = sum of
+     * weights[i] * input[i]). They are taken at the next call to work().
+     */
+    void set_weights(const std::vector<gr_complex> &weights);
+
+    std::vector<gr_complex> get_weights() const;
+
+    int num_elements() const { return d_num_elements; }
+
 private:
-    friend beamformer_sptr make_beamformer_sptr();
-    beamformer();
-    std::vector<gr_complex> weight_vector = std::vector<gr_complex>(GNSS_SDR_BEAMFORMER_CHANNELS, gr_complex(1.0, 0.0));
+    friend beamformer_sptr make_beamformer_sptr(int num_elements,
+        const std::vector<gr_complex> &steering_vector,
+        bool adaptive,
+        int snapshots,
+        int update_period,
+        float diagonal_loading);
+
+    beamformer(int num_elements,
+        const std::vector<gr_complex> &steering_vector,
+        bool adaptive,
+        int snapshots,
+        int update_period,
+        float diagonal_loading);
+
+    void publish_weights(const std::vector<gr_complex> &weights);
+    void take_new_weights();
+    void take_snapshots(int noutput_items, const gr_vector_const_void_star &input_items);
+    void beamform(int first, int last, const gr_vector_const_void_star &input_items, gr_complex *out, gr_complex *scratch) const;
+    void adaptation_loop();
+    bool compute_adaptive_weights(std::vector<gr_complex> &weights) const;
+
+    // Triple buffer of weights: the writers fill d_weights[d_back], which is
+    // exchanged with the published middle slot; work() exchanges its d_front
+    // slot with the middle one when it is flagged as new.
+    static constexpr int NEW_WEIGHTS = 4;
+    std::vector<gr_complex> d_weights[3];
+    std::atomic<int> d_middle{1};
+    int d_front{0};
+    int d_back{2};
+    std::vector<gr_complex> d_last_weights;  // copy of the last published weights, for get_weights()
+    mutable std::mutex d_writer_mutex;       // serializes the writers, never taken by work()
+
+    std::vector<volk_gnsssdr::vector<gr_complex>> d_scratch;  // one block per worker
+
+    // adaptation
+    arma::cx_fmat d_snapshots;  // one column per element
+    arma::cx_fvec d_steering_vector;
+    std::thread d_adaptation_thread;
+    std::mutex d_adaptation_mutex;
+    std::condition_variable d_adaptation_cv;
+    std::atomic<bool> d_snapshots_wanted{false};
+    std::atomic<bool> d_snapshots_ready{false};
+    std::atomic<bool> d_stop{false};
+    uint64_t d_samples_since_update{0};
+    float d_diagonal_loading;
+    int d_num_elements;
+    int d_num_snapshots;
+    int d_snapshot_count{0};
+    int d_update_period;
+    bool d_adaptive;
 };
 
 
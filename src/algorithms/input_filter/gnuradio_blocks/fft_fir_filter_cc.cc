@@ -0,0 +1,79 @@
+/*!
+ * \file fft_fir_filter_cc.cc
+ * \brief FIR filter of complex samples with real taps, computed by FFT fast
+ * convolution (overlap-save)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fft_fir_filter_cc.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cstring>
+
+
+fft_fir_filter_cc_sptr make_fft_fir_filter_cc(const std::vector<float>& taps)
+{
+    return fft_fir_filter_cc_sptr(new fft_fir_filter_cc(taps));
+}
+
+
+fft_fir_filter_cc::fft_fir_filter_cc(const std::vector<float>& taps)
+    : gr::sync_block("fft_fir_filter_cc",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_ntaps(std::max(1, static_cast<int>(taps.size()))),
+      d_fft_size(2)
+{
+    // A transform of about four times the number of taps wastes a quarter
+    // of each block in the overlap, and keeps the transforms short
+    while (d_fft_size < 4 * d_ntaps)
+        {
+            d_fft_size *= 2;
+        }
+    d_block_size = d_fft_size - d_ntaps + 1;
+
+    d_fft = gnss_fft_fwd_make_unique(d_fft_size);
+    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+
+    // the inverse transforms are not normalized, so the scaling goes in the taps
+    std::fill_n(d_fft->get_inbuf(), d_fft_size, gr_complex(0.0, 0.0));
+    for (size_t i = 0; i < taps.size(); i++)
+        {
+            d_fft->get_inbuf()[i] = gr_complex(taps[i] / static_cast<float>(d_fft_size), 0.0);
+        }
+    d_fft->execute();
+    d_taps_fft = volk_gnsssdr::vector<gr_complex>(d_fft->get_outbuf(), d_fft->get_outbuf() + d_fft_size);
+
+    // the first ntaps - 1 input samples of each call are the end of the previous one
+    set_history(d_ntaps);
+    set_output_multiple(d_block_size);
+}
+
+
+int fft_fir_filter_cc::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);
+    auto* out = reinterpret_cast<gr_complex*>(output_items[0]);
+
+    for (int n = 0; n + d_block_size <= noutput_items; n += d_block_size)
+        {
+            memcpy(d_fft->get_inbuf(), in + n, sizeof(gr_complex) * d_fft_size);
+            d_fft->execute();
+            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft->get_outbuf(), d_taps_fft.data(), d_fft_size);
+            d_ifft->execute();
+            memcpy(out + n, d_ifft->get_outbuf() + d_ntaps - 1, sizeof(gr_complex) * d_block_size);
+        }
+    return noutput_items;
+}
@@ -0,0 +1,77 @@
+/*!
+ * \file fft_fir_filter_cc.h
+ * \brief FIR filter of complex samples with real taps, computed by FFT fast
+ * convolution (overlap-save)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FFT_FIR_FILTER_CC_H
+#define GNSS_SDR_FFT_FIR_FILTER_CC_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class fft_fir_filter_cc;
+
+using fft_fir_filter_cc_sptr = gnss_shared_ptr<fft_fir_filter_cc>;
+
+fft_fir_filter_cc_sptr make_fft_fir_filter_cc(const std::vector<float>& taps);
+
+/*!
+ * \brief Same output as gr::filter::fir_filter_ccf with decimation 1, but
+ * computed in the frequency domain.
+ *
+ * The input is split in blocks of fft_size - ntaps + 1 samples. Each block,
+ * together with the last ntaps - 1 samples of the previous one, is
+ * transformed, multiplied by the transform of the taps and transformed back,
+ * discarding the first ntaps - 1 (circularly aliased) outputs. The cost per
+ * sample grows with log(ntaps) instead of ntaps.
+ */
+class fft_fir_filter_cc : public gr::sync_block
+{
+public:
+    ~fft_fir_filter_cc() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    int fft_size() const { return d_fft_size; }
+
+private:
+    friend fft_fir_filter_cc_sptr make_fft_fir_filter_cc(const std::vector<float>& taps);
+    explicit fft_fir_filter_cc(const std::vector<float>& taps);
+
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft;
+    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    volk_gnsssdr::vector<gr_complex> d_taps_fft;  // transform of the taps, scaled by 1 / fft_size
+    int d_ntaps;
+    int d_fft_size;
+    int d_block_size;  // new input samples (and outputs) per transform
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FFT_FIR_FILTER_CC_H
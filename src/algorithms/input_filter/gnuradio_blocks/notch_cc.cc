@@ -18,15 +18,16 @@
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
 #include <cmath>
 #include <cstring>
 
 
 notch_sptr make_notch_filter(float pfa, float p_c_factor,
-    int32_t length, int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t length, int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items)
 {
-    return notch_sptr(new Notch(pfa, p_c_factor, length, n_segments_est, n_segments_reset));
+    return notch_sptr(new Notch(pfa, p_c_factor, length, n_segments_est, n_segments_reset, cshort_items));
 }
 
 
@@ -34,12 +35,12 @@ Notch::Notch(float pfa,
     float p_c_factor,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset)
+    int32_t n_segments_reset,
+    bool cshort_items)
     : gr::block("Notch",
-          gr::io_signature::make(1, 1, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
       last_out_(gr_complex(0.0, 0.0)),
-      z_0_(gr_complex(0.0, 0.0)),
       p_c_factor_(gr_complex(p_c_factor, 0.0)),
       pfa_(pfa),
       noise_pow_est_(0.0),
@@ -48,13 +49,15 @@ Notch::Notch(float pfa,
       n_segments_(0),
       n_segments_est_(n_segments_est),      // Set the number of segments for noise power estimation
       n_segments_reset_(n_segments_reset),  // Set the period (in segments) when the noise power is estimated
-      filter_state_(false)
+      filter_state_(false),
+      cshort_items_(cshort_items)
 {
-    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    const int32_t alignment_multiple = volk_get_alignment() / (cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex));
     set_alignment(std::max(1, alignment_multiple));
     boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
     c_samples_ = volk_gnsssdr::vector<gr_complex>(length_);
+    z_ = volk_gnsssdr::vector<gr_complex>(length_);
     angle_ = volk_gnsssdr::vector<float>(length_);
     power_spect_ = volk_gnsssdr::vector<float>(length_);
     d_fft_ = gnss_fft_fwd_make_unique(length_);
@@ -63,14 +66,35 @@ Notch::Notch(float pfa,
 
 int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    int32_t index_out = 0;
+    if (cshort_items_)
+        {
+            // the filter works on gr_complex; the buffers only grow, so there are no allocations in the steady state
+            if (converted_in_.size() < static_cast<size_t>(noutput_items))
+                {
+                    converted_in_.resize(noutput_items);
+                    converted_out_.resize(noutput_items);
+                }
+            volk_gnsssdr_16ic_convert_32fc(converted_in_.data(), reinterpret_cast<const lv_16sc_t *>(input_items[0]), noutput_items);
+            index_out = filter(converted_in_.data() + 1, converted_out_.data(), noutput_items);
+            volk_gnsssdr_32fc_convert_16ic(reinterpret_cast<lv_16sc_t *>(output_items[0]), converted_out_.data(), index_out);
+        }
+    else
+        {
+            index_out = filter(reinterpret_cast<const gr_complex *>(input_items[0]) + 1, reinterpret_cast<gr_complex *>(output_items[0]), noutput_items);
+        }
+    consume_each(index_out);
+    return index_out;
+}
+
+
+int32_t Notch::filter(const gr_complex *in, gr_complex *out, int noutput_items)
 {
     int32_t index_out = 0;
     float sig2dB = 0.0;
     float sig2lin = 0.0;
     lv_32fc_t dot_prod_;
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    in++;
     while ((index_out + length_) < noutput_items)
         {
             if ((n_segments_ < n_segments_est_) && (filter_state_ == false))
@@ -93,12 +117,16 @@ int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribu
                                     filter_state_ = true;
                                     last_out_ = gr_complex(0.0, 0.0);
                                 }
+                            // notch of each sample, z = exp(j * arg(in[n] * conj(in[n - 1])))
                             volk_32fc_x2_multiply_conjugate_32fc(c_samples_.data(), in, (in - 1), length_);
                             volk_32fc_s32f_atan2_32f(angle_.data(), c_samples_.data(), static_cast<float>(1.0), length_);
+                            volk_gnsssdr_32f_sincos_32fc(z_.data(), angle_.data(), length_);
+                            // non-recursive part, out[n] = in[n] - z[n] * in[n - 1]
+                            volk_32fc_x2_multiply_32fc(c_samples_.data(), z_.data(), (in - 1), length_);
+                            volk_32f_x2_subtract_32f(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), reinterpret_cast<const float *>(c_samples_.data()), 2 * length_);
                             for (int32_t aux = 0; aux < length_; aux++)
                                 {
-                                    z_0_ = std::exp(gr_complex(0.0, 1.0) * (*(angle_.data() + aux)));
-                                    *(out + aux) = *(in + aux) - z_0_ * (*(in + aux - 1)) + p_c_factor_ * z_0_ * last_out_;
+                                    *(out + aux) += p_c_factor_ * z_[aux] * last_out_;
                                     last_out_ = *(out + aux);
                                 }
                         }
@@ -117,6 +145,5 @@ int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribu
             in += length_;
             out += length_;
         }
-    consume_each(index_out);
     return index_out;
 }
@@ -35,15 +35,24 @@ class Notch;
 
 using notch_sptr = gnss_shared_ptr<Notch>;
 
+/*!
+ * \brief If cshort_items is true, the input and output items are lv_16sc_t
+ * instead of gr_complex.
+ */
 notch_sptr make_notch_filter(
     float pfa,
     float p_c_factor,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    bool cshort_items = false);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter
+ *
+ * The notch of each sample and the non-recursive part of the filter are
+ * computed for the whole segment with the VOLK kernels, so that only the
+ * single-pole recursion is left to a scalar loop.
  */
 class Notch : public gr::block
 {
@@ -55,15 +64,19 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    friend notch_sptr make_notch_filter(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    Notch(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
+    friend notch_sptr make_notch_filter(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items);
+    Notch(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items);
+
+    int32_t filter(const gr_complex *in, gr_complex *out, int noutput_items);
 
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_;
     volk_gnsssdr::vector<gr_complex> c_samples_;
+    volk_gnsssdr::vector<gr_complex> z_;
     volk_gnsssdr::vector<float> angle_;
+    volk_gnsssdr::vector<gr_complex> converted_in_;  // cshort items, converted to gr_complex
+    volk_gnsssdr::vector<gr_complex> converted_out_;
     volk_gnsssdr::vector<float> power_spect_;
     gr_complex last_out_;
-    gr_complex z_0_;
     gr_complex p_c_factor_;
     float pfa_;
     float noise_pow_est_;
@@ -74,6 +87,7 @@ private:
     uint32_t n_segments_est_;
     uint32_t n_segments_reset_;
     bool filter_state_;
+    bool cshort_items_;
 };
 
 
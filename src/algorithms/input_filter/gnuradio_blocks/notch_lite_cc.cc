@@ -19,14 +19,15 @@
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
 #include <cmath>
 #include <cstring>
 
 
-notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff)
+notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, bool cshort_items)
 {
-    return notch_lite_sptr(new NotchLite(p_c_factor, pfa, length, n_segments_est, n_segments_reset, n_segments_coeff));
+    return notch_lite_sptr(new NotchLite(p_c_factor, pfa, length, n_segments_est, n_segments_reset, n_segments_coeff, cshort_items));
 }
 
 
@@ -35,10 +36,11 @@ NotchLite::NotchLite(float p_c_factor,
     int32_t length,
     int32_t n_segments_est,
     int32_t n_segments_reset,
-    int32_t n_segments_coeff)
+    int32_t n_segments_coeff,
+    bool cshort_items)
     : gr::block("NotchLite",
-          gr::io_signature::make(1, 1, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
       last_out_(gr_complex(0.0, 0.0)),
       z_0_(gr_complex(0.0, 0.0)),
       p_c_factor_(gr_complex(p_c_factor, 0.0)),
@@ -55,9 +57,10 @@ NotchLite::NotchLite(float p_c_factor,
       n_segments_coeff_reset_(n_segments_coeff),
       n_segments_coeff_(0),
       n_deg_fred_(2 * length),
-      filter_state_(false)
+      filter_state_(false),
+      cshort_items_(cshort_items)
 {
-    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    const int32_t alignment_multiple = volk_get_alignment() / (cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex));
     set_alignment(std::max(1, alignment_multiple));
     set_history(2);
 
@@ -65,20 +68,42 @@ NotchLite::NotchLite(float p_c_factor,
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
 
     power_spect_ = volk_gnsssdr::vector<float>(length_);
+    delayed_ = volk_gnsssdr::vector<gr_complex>(length_);
     d_fft_ = gnss_fft_fwd_make_unique(length_);
 }
 
 
 int NotchLite::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    int32_t index_out = 0;
+    if (cshort_items_)
+        {
+            // the filter works on gr_complex; the buffers only grow, so there are no allocations in the steady state
+            if (converted_in_.size() < static_cast<size_t>(noutput_items) + 1)
+                {
+                    converted_in_.resize(noutput_items + 1);
+                    converted_out_.resize(noutput_items);
+                }
+            volk_gnsssdr_16ic_convert_32fc(converted_in_.data(), reinterpret_cast<const lv_16sc_t *>(input_items[0]), noutput_items + 1);
+            index_out = filter(converted_in_.data() + 1, converted_out_.data(), noutput_items);
+            volk_gnsssdr_32fc_convert_16ic(reinterpret_cast<lv_16sc_t *>(output_items[0]), converted_out_.data(), index_out);
+        }
+    else
+        {
+            index_out = filter(reinterpret_cast<const gr_complex *>(input_items[0]) + 1, reinterpret_cast<gr_complex *>(output_items[0]), noutput_items);
+        }
+    consume_each(index_out);
+    return index_out;
+}
+
+
+int32_t NotchLite::filter(const gr_complex *in, gr_complex *out, int noutput_items)
 {
     int32_t index_out = 0;
     float sig2dB = 0.0;
     float sig2lin = 0.0;
     lv_32fc_t dot_prod_;
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    in++;
     while ((index_out + length_) < noutput_items)
         {
             if ((n_segments_ < n_segments_est_) && (filter_state_ == false))
@@ -111,9 +136,13 @@ int NotchLite::general_work(int noutput_items, gr_vector_int &ninput_items __att
                                     float angle_ = (angle1_ + angle2_) / 2.0F;
                                     z_0_ = std::exp(gr_complex(0, 1) * angle_);
                                 }
+                            // non-recursive part, out[n] = in[n] - z_0_ * in[n - 1]
+                            volk_32fc_s32fc_multiply_32fc(delayed_.data(), (in - 1), z_0_, length_);
+                            volk_32f_x2_subtract_32f(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), reinterpret_cast<const float *>(delayed_.data()), 2 * length_);
+                            const gr_complex pole = p_c_factor_ * z_0_;
                             for (int32_t aux = 0; aux < length_; aux++)
                                 {
-                                    *(out + aux) = *(in + aux) - z_0_ * (*(in + aux - 1)) + p_c_factor_ * z_0_ * last_out_;
+                                    *(out + aux) += pole * last_out_;
                                     last_out_ = *(out + aux);
                                 }
                             n_segments_coeff_++;
@@ -134,6 +163,5 @@ int NotchLite::general_work(int noutput_items, gr_vector_int &ninput_items __att
             in += length_;
             out += length_;
         }
-    consume_each(index_out);
     return index_out;
 }
@@ -35,16 +35,25 @@ class NotchLite;
 
 using notch_lite_sptr = gnss_shared_ptr<NotchLite>;
 
+/*!
+ * \brief If cshort_items is true, the input and output items are lv_16sc_t
+ * instead of gr_complex.
+ */
 notch_lite_sptr make_notch_filter_lite(
     float p_c_factor,
     float pfa,
     int32_t length,
     int32_t n_segments_est,
     int32_t n_segments_reset,
-    int32_t n_segments_coeff);
+    int32_t n_segments_coeff,
+    bool cshort_items = false);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter light version
+ *
+ * The non-recursive part of the filter is computed for the whole segment
+ * with the VOLK kernels, so that only the single-pole recursion is left to a
+ * scalar loop.
  */
 class NotchLite : public gr::block
 {
@@ -56,11 +65,16 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    friend notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
-    NotchLite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+    friend notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, bool cshort_items);
+    NotchLite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, bool cshort_items);
+
+    int32_t filter(const gr_complex *in, gr_complex *out, int noutput_items);
 
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_;
     volk_gnsssdr::vector<float> power_spect_;
+    volk_gnsssdr::vector<gr_complex> delayed_;        // z_0_ * in[n - 1]
+    volk_gnsssdr::vector<gr_complex> converted_in_;   // cshort items, converted to gr_complex
+    volk_gnsssdr::vector<gr_complex> converted_out_;
     gr_complex last_out_;
     gr_complex z_0_;
     gr_complex p_c_factor_;
@@ -79,6 +93,7 @@ private:
     int32_t n_segments_coeff_;
     int32_t n_deg_fred_;
     bool filter_state_;
+    bool cshort_items_;
 };
 
 
@@ -20,23 +20,27 @@
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
+#include <cstring>
 
 
 pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length,
-    int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items)
 {
-    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset));
+    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset, cshort_items));
 }
 
 
 pulse_blanking_cc::pulse_blanking_cc(float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset)
+    int32_t n_segments_reset,
+    bool cshort_items)
     : gr::block("pulse_blanking_cc",
-          gr::io_signature::make(1, 1, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
+      item_size_(cshort_items ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
       noise_power_estimation_(0.0),
       pfa_(pfa),
       length_(length),
@@ -44,43 +48,60 @@ pulse_blanking_cc::pulse_blanking_cc(float pfa,
       n_segments_est_(n_segments_est),
       n_segments_reset_(n_segments_reset),
       n_deg_fred_(2 * length),
-      last_filtered_(false)
+      last_filtered_(false),
+      cshort_items_(cshort_items)
 {
-    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    const int32_t alignment_multiple = volk_get_alignment() / item_size_;
     set_alignment(std::max(1, alignment_multiple));
     boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
-    zeros_ = volk_gnsssdr::vector<gr_complex>(length_);
 }
 
 
 int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    auto magnitude = volk_gnsssdr::vector<float>(noutput_items);
-    volk_32fc_magnitude_squared_32f(magnitude.data(), in, noutput_items);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
+    auto *out = reinterpret_cast<uint8_t *>(output_items[0]);
+    // the buffers only grow, so there are no allocations in the steady state
+    if (magnitude_.size() < static_cast<size_t>(noutput_items))
+        {
+            magnitude_.resize(noutput_items);
+        }
+    if (cshort_items_)
+        {
+            if (converted_.size() < static_cast<size_t>(noutput_items))
+                {
+                    converted_.resize(noutput_items);
+                }
+            volk_gnsssdr_16ic_convert_32fc(converted_.data(), reinterpret_cast<const lv_16sc_t *>(in), noutput_items);
+            volk_32fc_magnitude_squared_32f(magnitude_.data(), converted_.data(), noutput_items);
+        }
+    else
+        {
+            volk_32fc_magnitude_squared_32f(magnitude_.data(), reinterpret_cast<const gr_complex *>(in), noutput_items);
+        }
+    const size_t segment_bytes = item_size_ * length_;
     int32_t sample_index = 0;
     float segment_energy;
     while ((sample_index + length_) < noutput_items)
         {
-            volk_32f_accumulator_s32f(&segment_energy, (magnitude.data() + sample_index), length_);
+            volk_32f_accumulator_s32f(&segment_energy, (magnitude_.data() + sample_index), length_);
             if ((n_segments_ < n_segments_est_) && (last_filtered_ == false))
                 {
                     noise_power_estimation_ = (static_cast<float>(n_segments_) * noise_power_estimation_ + segment_energy / static_cast<float>(n_deg_fred_)) / static_cast<float>(n_segments_ + 1);
-                    memcpy(out, in, sizeof(gr_complex) * length_);
+                    memcpy(out, in, segment_bytes);
                 }
             else
                 {
                     if ((segment_energy / noise_power_estimation_) > thres_)
                         {
-                            memcpy(out, zeros_.data(), sizeof(gr_complex) * length_);
+                            memset(out, 0, segment_bytes);
                             last_filtered_ = true;
                         }
                     else
                         {
-                            memcpy(out, in, sizeof(gr_complex) * length_);
+                            memcpy(out, in, segment_bytes);
                             last_filtered_ = false;
                             if (n_segments_ > n_segments_reset_)
                                 {
@@ -88,8 +109,8 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
                                 }
                         }
                 }
-            in += length_;
-            out += length_;
+            in += segment_bytes;
+            out += segment_bytes;
             sample_index += length_;
             n_segments_++;
         }
@@ -35,12 +35,24 @@ class pulse_blanking_cc;
 
 using pulse_blanking_cc_sptr = gnss_shared_ptr<pulse_blanking_cc>;
 
+/*!
+ * \brief If cshort_items is true, the input and output items are lv_16sc_t
+ * instead of gr_complex.
+ */
 pulse_blanking_cc_sptr make_pulse_blanking_cc(
     float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    bool cshort_items = false);
 
+/*!
+ * \brief Blanks the segments of length samples whose energy exceeds the
+ * noise floor, estimated over the first n_segments_est segments, by the
+ * threshold given by pfa. The segment energies are computed with the VOLK
+ * kernels over the whole buffer, and the samples are copied unchanged
+ * (also in cshort) when they pass.
+ */
 class pulse_blanking_cc : public gr::block
 {
 public:
@@ -50,9 +62,11 @@ public:
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
 private:
-    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    volk_gnsssdr::vector<gr_complex> zeros_;
+    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items);
+    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, bool cshort_items);
+    volk_gnsssdr::vector<gr_complex> converted_;  // cshort input, converted to gr_complex
+    volk_gnsssdr::vector<float> magnitude_;
+    size_t item_size_;
     float noise_power_estimation_;
     float thres_;
     float pfa_;
@@ -62,6 +76,7 @@ private:
     int32_t n_segments_reset_;
     int32_t n_deg_fred_;
     bool last_filtered_;
+    bool cshort_items_;
 };
 
 
@@ -0,0 +1,131 @@
+/*!
+ * \file allocation_counter.cc
+ * \brief Counter of the heap allocations made by each thread, to check that
+ * the signal processing paths do not allocate memory.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "allocation_counter.h"
+
+#if GNSS_SDR_COUNT_ALLOCATIONS
+#include <cstdlib>  // for malloc, free
+#include <new>      // for bad_alloc, get_new_handler, nothrow_t
+
+namespace
+{
+thread_local uint64_t thread_allocations = 0ULL;
+
+
+void* counted_malloc(std::size_t size)
+{
+    thread_allocations++;
+    if (size == 0)
+        {
+            size = 1;
+        }
+    void* p = std::malloc(size);
+    while (p == nullptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+            handler();
+            p = std::malloc(size);
+        }
+    return p;
+}
+}  // namespace
+
+
+void* operator new(std::size_t size)
+{
+    return counted_malloc(size);
+}
+
+
+void* operator new[](std::size_t size)
+{
+    return counted_malloc(size);
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    try
+        {
+            return counted_malloc(size);
+        }
+    catch (const std::bad_alloc&)
+        {
+            return nullptr;
+        }
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t /*size*/) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete[](void* p, std::size_t /*size*/) noexcept
+{
+    std::free(p);
+}
+
+
+bool Allocation_Counter::enabled()
+{
+    return true;
+}
+
+
+uint64_t Allocation_Counter::count()
+{
+    return thread_allocations;
+}
+
+#else
+
+
+bool Allocation_Counter::enabled()
+{
+    return false;
+}
+
+
+uint64_t Allocation_Counter::count()
+{
+    return 0ULL;
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+ * \file allocation_counter.h
+ * \brief Counter of the heap allocations made by each thread, to check that
+ * the signal processing paths do not allocate memory.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_ALLOCATION_COUNTER_H
+#define GNSS_SDR_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Number of calls to the global operator new made by the calling
+ * thread.
+ *
+ * The counter is only active if GNSS_SDR_COUNT_ALLOCATIONS is defined, which
+ * is the case in Debug builds. The global operator new is then replaced by
+ * one that counts the allocations before calling malloc. Otherwise count()
+ * always returns 0.
+ */
+class Allocation_Counter
+{
+public:
+    static bool enabled();
+    static uint64_t count();
+};
+
+
+/*!
+ * \brief Adds to *total, if not null, the allocations made by the calling
+ * thread during the lifetime of the object.
+ */
+class Allocation_Scope
+{
+public:
+    explicit Allocation_Scope(uint64_t* total) : d_total(total), d_start(Allocation_Counter::count()) {}
+    ~Allocation_Scope()
+    {
+        if (d_total != nullptr)
+            {
+                *d_total += Allocation_Counter::count() - d_start;
+            }
+    }
+
+    Allocation_Scope(const Allocation_Scope&) = delete;
+    Allocation_Scope& operator=(const Allocation_Scope&) = delete;
+
+private:
+    uint64_t* d_total;
+    uint64_t d_start;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ALLOCATION_COUNTER_H
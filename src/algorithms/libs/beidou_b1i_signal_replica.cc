@@ -17,83 +17,25 @@
  */
 
 #include "beidou_b1i_signal_replica.h"
+#include "gnss_code_table.h"
 #include <array>
-#include <bitset>
-#include <string>
 
 const auto AUX_CEIL = [](float x) { return static_cast<int32_t>(static_cast<int64_t>((x) + 1)); };
 
 void beidou_b1i_code_gen_int(own::span<int32_t> dest, int32_t prn, uint32_t chip_shift)
 {
     constexpr uint32_t code_length = 2046;
-    const std::array<int32_t, 33> delays = {712 /*PRN1*/, 1581, 1414, 1550, 581, 771, 1311, 1043, 1549, 359, 710, 1579, 1548, 1103, 579, 769, 358, 709, 1411, 1547,
-        1102, 578, 357, 1577, 1410, 1546, 1101, 707, 1576, 1409, 1545, 354 /*PRN32*/,
-        705};
-    const std::array<int32_t, 37> phase1 = {1, 1, 1, 1, 1, 1, 1, 1, 2, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 8, 8, 8, 9, 9, 10};
-    const std::array<int32_t, 37> phase2 = {3, 4, 5, 6, 8, 9, 10, 11, 7, 4, 5, 6, 8, 9, 10, 11, 5, 6, 8, 9, 10, 11, 6, 8, 9, 10, 11, 8, 9, 10, 11, 9, 10, 11, 10, 11, 11};
-
-    std::bitset<code_length> G1{};
-    std::bitset<code_length> G2{};
-
-    std::bitset<11> G1_register(std::string("01010101010"));
-    std::bitset<11> G2_register(std::string("01010101010"));
-
-    bool feedback1;
-    bool feedback2;
-    bool aux;
-    uint32_t lcv;
-    uint32_t lcv2;
-    uint32_t delay;
-    int32_t prn_idx;
-
-    // compute delay array index for given PRN number
-    prn_idx = prn - 1;
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::BEIDOU_B1I, static_cast<uint32_t>(prn));
 
     // A simple error check
-    if ((prn_idx < 0) || (prn_idx > 32))
+    if (code == nullptr)
         {
             return;
         }
 
-    // Generate G1 & G2 Register
-    for (lcv = 0; lcv < code_length; lcv++)
+    for (uint32_t lcv = 0; lcv < code_length; lcv++)
         {
-            G1[lcv] = G1_register[0];
-            G2[lcv] = G2_register[-(phase1[prn_idx] - 11)] xor G2_register[-(phase2[prn_idx] - 11)];
-
-            feedback1 = G1_register[0] xor G1_register[1] xor G1_register[2] xor G1_register[3] xor G1_register[4] xor G1_register[10];
-            feedback2 = G2_register[0] xor G2_register[2] xor G2_register[3] xor G2_register[6] xor G2_register[7] xor G2_register[8] xor G2_register[9] xor G2_register[10];
-
-            for (lcv2 = 0; lcv2 < 10; lcv2++)
-                {
-                    G1_register[lcv2] = G1_register[lcv2 + 1];
-                    G2_register[lcv2] = G2_register[lcv2 + 1];
-                }
-
-            G1_register[10] = feedback1;
-            G2_register[10] = feedback2;
-        }
-
-    // Set the delay
-    delay = code_length - delays[prn_idx] * 0;  //**********************************
-    delay += chip_shift;
-    delay %= code_length;
-
-    // Generate PRN from G1 and G2 Registers
-    for (lcv = 0; lcv < code_length; lcv++)
-        {
-            aux = G1[(lcv + chip_shift) % code_length] xor G2[delay];
-            if (aux == true)
-                {
-                    dest[lcv] = 1;
-                }
-            else
-                {
-                    dest[lcv] = -1;
-                }
-
-            delay++;
-            delay %= code_length;
+            dest[lcv] = code->value((lcv + chip_shift) % code_length);
         }
 }
 
@@ -0,0 +1,100 @@
+/*!
+ * \file fpga_code_bank_cache.cc
+ * \brief Bookkeeping of the local codes resident in the code banks of an
+ * FPGA acquisition or tracking module
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fpga_code_bank_cache.h"
+#include <algorithm>
+
+std::atomic<uint64_t> Fpga_Code_Bank_Cache::s_generation{0};
+
+
+Fpga_Code_Bank_Cache::Fpga_Code_Bank_Cache(uint32_t num_banks)
+    : d_banks(std::max(num_banks, 1U)),
+      d_generation(s_generation.load())
+{
+}
+
+
+uint32_t Fpga_Code_Bank_Cache::assign(uint64_t key, bool& resident, uint32_t busy_bank)
+{
+    check_generation();
+    d_use_counter++;
+    for (uint32_t bank = 0; bank < num_banks(); bank++)
+        {
+            if (d_banks[bank].valid and d_banks[bank].key == key)
+                {
+                    d_banks[bank].last_use = d_use_counter;
+                    resident = true;
+                    return bank;
+                }
+        }
+
+    // an empty bank, or else the least recently used one
+    uint32_t victim = no_bank;
+    for (uint32_t bank = 0; bank < num_banks(); bank++)
+        {
+            if (bank == busy_bank and num_banks() > 1)
+                {
+                    continue;
+                }
+            if (victim == no_bank or !d_banks[bank].valid or
+                (d_banks[victim].valid and d_banks[bank].last_use < d_banks[victim].last_use))
+                {
+                    victim = bank;
+                    if (!d_banks[bank].valid)
+                        {
+                            break;
+                        }
+                }
+        }
+    d_banks[victim].key = key;
+    d_banks[victim].last_use = d_use_counter;
+    d_banks[victim].valid = true;
+    resident = false;
+    return victim;
+}
+
+
+bool Fpga_Code_Bank_Cache::contains(uint64_t key)
+{
+    check_generation();
+    return std::any_of(d_banks.cbegin(), d_banks.cend(), [key](const Bank& bank) { return bank.valid and bank.key == key; });
+}
+
+
+void Fpga_Code_Bank_Cache::clear()
+{
+    for (auto& bank : d_banks)
+        {
+            bank.valid = false;
+        }
+}
+
+
+void Fpga_Code_Bank_Cache::invalidate_all()
+{
+    s_generation++;
+}
+
+
+void Fpga_Code_Bank_Cache::check_generation()
+{
+    const uint64_t generation = s_generation.load();
+    if (generation != d_generation)
+        {
+            clear();
+            d_generation = generation;
+        }
+}
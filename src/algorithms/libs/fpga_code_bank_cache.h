@@ -0,0 +1,90 @@
+/*!
+ * \file fpga_code_bank_cache.h
+ * \brief Bookkeeping of the local codes resident in the code banks of an
+ * FPGA acquisition or tracking module
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FPGA_CODE_BANK_CACHE_H
+#define GNSS_SDR_FPGA_CODE_BANK_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps track of which local code (identified by a key, such as the
+ * PRN) is stored in each code bank of an FPGA module, so that assigning a
+ * resident code only needs selecting its bank. When the code is not
+ * resident, the least recently used bank is reused and the caller uploads
+ * the code to it.
+ *
+ * Not thread-safe: the owners of a shared module must serialize the calls.
+ */
+class Fpga_Code_Bank_Cache
+{
+public:
+    static const uint32_t no_bank = 0xFFFFFFFF;
+
+    explicit Fpga_Code_Bank_Cache(uint32_t num_banks);
+
+    uint32_t num_banks() const { return static_cast<uint32_t>(d_banks.size()); }
+
+    /*!
+     * \brief Returns the bank that holds key. If the key is not resident, it
+     * is assigned the least recently used bank other than busy_bank, and
+     * resident is set to false; the caller must then write the code there.
+     */
+    uint32_t assign(uint64_t key, bool& resident, uint32_t busy_bank = no_bank);
+
+    /*!
+     * \brief Returns true if the code with this key is in a bank.
+     */
+    bool contains(uint64_t key);
+
+    /*!
+     * \brief Forgets the content of all the banks.
+     */
+    void clear();
+
+    /*!
+     * \brief Forgets the content of the banks of all the caches, after a
+     * reset of the FPGA.
+     */
+    static void invalidate_all();
+
+private:
+    struct Bank
+    {
+        uint64_t key{0};
+        uint64_t last_use{0};
+        bool valid{false};
+    };
+
+    void check_generation();
+
+    std::vector<Bank> d_banks;
+    uint64_t d_use_counter{0};
+    uint64_t d_generation;
+    static std::atomic<uint64_t> s_generation;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FPGA_CODE_BANK_CACHE_H
@@ -18,6 +18,7 @@
 
 #include "galileo_e1_signal_replica.h"
 #include "Galileo_E1.h"
+#include "gnss_code_table.h"
 #include "gnss_signal_replica.h"
 #include <cmath>
 #include <cstddef>  // for size_t
@@ -27,33 +28,38 @@
 #include <vector>
 
 
-void galileo_e1_code_gen_int(own::span<int> dest, const std::array<char, 3>& signal_id, int32_t prn)
+namespace
+{
+// Primary code of the E1-B or E1-C component named in signal_id, or nullptr
+const Gnss_Packed_Code* galileo_e1_primary_code(const std::array<char, 3>& signal_id, uint32_t prn)
 {
     const std::string galileo_signal = signal_id.data();
-    const int32_t prn_ = prn - 1;
-    int32_t index = 0;
+    if (galileo_signal.rfind("1B") != std::string::npos && galileo_signal.length() >= 2)
+        {
+            return gnss_primary_code(Gnss_Code_Id::GALILEO_E1_B, prn);
+        }
+    if (galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2)
+        {
+            return gnss_primary_code(Gnss_Code_Id::GALILEO_E1_C, prn);
+        }
+    return nullptr;
+}
+}  // namespace
+
+
+void galileo_e1_code_gen_int(own::span<int> dest, const std::array<char, 3>& signal_id, int32_t prn)
+{
+    const Gnss_Packed_Code* code = galileo_e1_primary_code(signal_id, static_cast<uint32_t>(prn));
 
     // A simple error check
-    if ((prn < 1) || (prn > 50))
+    if (code == nullptr)
         {
             return;
         }
 
-    if (galileo_signal.rfind("1B") != std::string::npos && galileo_signal.length() >= 2)
-        {
-            for (size_t i = 0; i < GALILEO_E1_B_PRIMARY_CODE_STR_LENGTH; i++)
-                {
-                    hex_to_binary_converter(dest.subspan(index, 4), GALILEO_E1_B_PRIMARY_CODE[prn_][i]);
-                    index += 4;
-                }
-        }
-    else if (galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2)
+    for (uint32_t i = 0; i < code->size(); i++)
         {
-            for (size_t i = 0; i < GALILEO_E1_C_PRIMARY_CODE_STR_LENGTH; i++)
-                {
-                    hex_to_binary_converter(dest.subspan(index, 4), GALILEO_E1_C_PRIMARY_CODE[prn_][i]);
-                    index += 4;
-                }
+            dest[i] = code->value(i);
         }
 }
 
@@ -98,11 +104,11 @@ void galileo_e1_sinboc_61_gen_int(own::span<int> dest, own::span<const int> prn)
 void galileo_e1_code_gen_sinboc11_float(own::span<float> dest, const std::array<char, 3>& signal_id, uint32_t prn)
 {
     const auto codeLength = static_cast<uint32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS);
-    std::array<int32_t, 4092> primary_code_E1_chips{};
-    galileo_e1_code_gen_int(primary_code_E1_chips, signal_id, prn);  // generate Galileo E1 code, 1 sample per chip
+    const Gnss_Packed_Code* code = galileo_e1_primary_code(signal_id, prn);
     for (uint32_t i = 0; i < codeLength; i++)
         {
-            dest[2 * i] = static_cast<float>(primary_code_E1_chips[i]);
+            // sinboc(1,1), 2 samples per chip (all zeros for unknown PRNs)
+            dest[2 * i] = code == nullptr ? 0.0F : static_cast<float>(code->value(i));
             dest[2 * i + 1] = -dest[2 * i];
         }
 }
@@ -21,6 +21,7 @@
 #include "galileo_e5_signal_replica.h"
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
+#include "gnss_code_table.h"
 #include "gnss_signal_replica.h"
 #include <gnuradio/gr_complex.h>
 #include <memory>
@@ -28,67 +29,66 @@
 #include <vector>
 
 
+namespace
+{
+// Chips of the real code in the real part and of the imaginary code, if
+// any, in the imaginary part
+void galileo_e5_primary_from_table(own::span<std::complex<float>> dest,
+    const Gnss_Packed_Code* real_code,
+    const Gnss_Packed_Code* imag_code)
+{
+    if (real_code == nullptr)
+        {
+            return;
+        }
+    for (uint32_t i = 0; i < real_code->size(); i++)
+        {
+            dest[i] = std::complex<float>(static_cast<float>(real_code->value(i)),
+                imag_code == nullptr ? 0.0F : static_cast<float>(imag_code->value(i)));
+        }
+}
+
+
+// Single-signal AltBOC subcarrier scS over the eight segments of a
+// subcarrier period (Galileo OS SIS ICD, Table 9). The complex subcarrier
+// of the lower sideband is scS(t) - j scS(t - Ts/4), and that of the upper
+// sideband scS(t) + j scS(t - Ts/4), where Ts/4 is two segments.
+constexpr std::array<float, 8> GALILEO_E5_ALTBOC_SCS = {
+    1.2071068F, 0.5F, -0.5F, -1.2071068F, -1.2071068F, -0.5F, 0.5F, 1.2071068F};
+
+std::array<std::complex<float>, 8> galileo_e5_altboc_subcarrier_lut(bool upper_sideband)
+{
+    std::array<std::complex<float>, 8> lut{};
+    const float sign = upper_sideband ? 1.0F : -1.0F;
+    for (uint32_t k = 0; k < 8; k++)
+        {
+            lut[k] = std::complex<float>(GALILEO_E5_ALTBOC_SCS[k], sign * GALILEO_E5_ALTBOC_SCS[(k + 6) % 8]);
+        }
+    return lut;
+}
+}  // namespace
+
+
 void galileo_e5_a_code_gen_complex_primary(own::span<std::complex<float>> dest,
     int32_t prn,
     const std::array<char, 3>& signal_id)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
+    const auto prn_ = static_cast<uint32_t>(prn);
     if (signal_id[0] == '5' && signal_id[1] == 'Q')
         {
-            for (size_t i = 0; i < GALILEO_E5A_Q_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5A_Q_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5A_Q_PRIMARY_CODE[prn_][GALILEO_E5A_Q_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5A_Q, prn_), nullptr);
         }
     else if (signal_id[0] == '5' && signal_id[1] == 'I')
         {
-            for (size_t i = 0; i < GALILEO_E5A_I_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5A_I_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5A_I_PRIMARY_CODE[prn_][GALILEO_E5A_I_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5A_I, prn_), nullptr);
         }
     else if (signal_id[0] == '5' && signal_id[1] == 'X')
         {
-            std::array<int32_t, 4> b{};
-            for (size_t i = 0; i < GALILEO_E5A_I_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5A_I_PRIMARY_CODE[prn_][i]);
-                    hex_to_binary_converter(b, GALILEO_E5A_Q_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), static_cast<float>(b[0]));
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), static_cast<float>(b[1]));
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), static_cast<float>(b[2]));
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), static_cast<float>(b[3]));
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5A_I_PRIMARY_CODE[prn_][GALILEO_E5A_I_PRIMARY_CODE_STR_LENGTH - 1]);
-            hex_to_binary_converter(b, GALILEO_E5A_Q_PRIMARY_CODE[prn_][GALILEO_E5A_Q_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), static_cast<float>(b[0]));
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), static_cast<float>(b[1]));
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5A_I, prn_), gnss_primary_code(Gnss_Code_Id::GALILEO_E5A_Q, prn_));
         }
 }
 
@@ -126,63 +126,22 @@ void galileo_e5_b_code_gen_complex_primary(own::span<std::complex<float>> dest,
     int32_t prn,
     const std::array<char, 3>& signal_id)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
+    const auto prn_ = static_cast<uint32_t>(prn);
     if (signal_id[0] == '7' && signal_id[1] == 'Q')
         {
-            for (size_t i = 0; i < GALILEO_E5B_Q_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5B_Q_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5B_Q_PRIMARY_CODE[prn_][GALILEO_E5B_Q_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5B_Q, prn_), nullptr);
         }
     else if (signal_id[0] == '7' && signal_id[1] == 'I')
         {
-            for (size_t i = 0; i < GALILEO_E5B_I_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5B_I_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5B_I_PRIMARY_CODE[prn_][GALILEO_E5B_I_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5B_I, prn_), nullptr);
         }
     else if (signal_id[0] == '7' && signal_id[1] == 'X')
         {
-            std::array<int32_t, 4> b{};
-            for (size_t i = 0; i < GALILEO_E5B_I_PRIMARY_CODE_STR_LENGTH - 1; i++)
-                {
-                    hex_to_binary_converter(a, GALILEO_E5B_I_PRIMARY_CODE[prn_][i]);
-                    hex_to_binary_converter(b, GALILEO_E5B_Q_PRIMARY_CODE[prn_][i]);
-                    dest[index] = std::complex<float>(static_cast<float>(a[0]), static_cast<float>(b[0]));
-                    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), static_cast<float>(b[1]));
-                    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), static_cast<float>(b[2]));
-                    dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), static_cast<float>(b[3]));
-                    index = index + 4;
-                }
-            // last 2 bits are filled up zeros
-            hex_to_binary_converter(a, GALILEO_E5B_I_PRIMARY_CODE[prn_][GALILEO_E5B_I_PRIMARY_CODE_STR_LENGTH - 1]);
-            hex_to_binary_converter(b, GALILEO_E5B_Q_PRIMARY_CODE[prn_][GALILEO_E5B_Q_PRIMARY_CODE_STR_LENGTH - 1]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), static_cast<float>(b[0]));
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), static_cast<float>(b[1]));
+            galileo_e5_primary_from_table(dest, gnss_primary_code(Gnss_Code_Id::GALILEO_E5B_I, prn_), gnss_primary_code(Gnss_Code_Id::GALILEO_E5B_Q, prn_));
         }
 }
 
@@ -214,3 +173,32 @@ void galileo_e5_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
             dest[(i + delay) % samplesPerCode] = code_aux[i];
         }
 }
+
+
+void galileo_e5_altboc_sideband_code_gen_complex(own::span<std::complex<float>> dest,
+    int32_t prn,
+    const std::array<char, 3>& signal_id)
+{
+    const bool upper_sideband = signal_id[0] == '7';
+    std::vector<std::complex<float>> code(GALILEO_E5A_CODE_LENGTH_CHIPS);
+    if (upper_sideband)
+        {
+            galileo_e5_b_code_gen_complex_primary(code, prn, signal_id);
+        }
+    else
+        {
+            galileo_e5_a_code_gen_complex_primary(code, prn, signal_id);
+        }
+
+    const std::array<std::complex<float>, 8> lut = galileo_e5_altboc_subcarrier_lut(upper_sideband);
+    constexpr uint32_t samples_per_chip = GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP;
+    for (uint32_t i = 0; i < code.size(); i++)
+        {
+            for (uint32_t k = 0; k < samples_per_chip; k++)
+                {
+                    // One chip spans one and a half subcarrier periods
+                    const uint32_t n = i * samples_per_chip + k;
+                    dest[n] = std::conj(code[i] * lut[n % 8]);
+                }
+        }
+}
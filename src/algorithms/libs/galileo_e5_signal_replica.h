@@ -76,6 +76,23 @@ void galileo_e5_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
     uint32_t chip_shift);
 
 
+/*!
+ * \brief Generates one sideband of the Galileo E5 AltBOC(15,10) signal at
+ * GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP samples/chip, for full-band tracking
+ * with the carrier at the E5 centre frequency. signal_id selects the
+ * sideband and component as in the E5a ("5I", "5Q", "5X") and E5b ("7I",
+ * "7Q", "7X") generators. The complex subcarrier of the sideband is read
+ * from a table of its eight values per subcarrier period instead of being
+ * computed per sample. The samples are conjugated, so that the multiply
+ * and accumulate of the correlators yields the correlation with the
+ * sideband. dest must hold GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP *
+ * GALILEO_E5A_CODE_LENGTH_CHIPS samples.
+ */
+void galileo_e5_altboc_sideband_code_gen_complex(own::span<std::complex<float>> dest,
+    int32_t prn,
+    const std::array<char, 3>& signal_id);
+
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_GALILEO_E5_SIGNAL_REPLICA_H
@@ -19,6 +19,7 @@
 
 #include "galileo_e6_signal_replica.h"
 #include "Galileo_E6.h"
+#include "gnss_code_table.h"
 #include "gnss_signal_replica.h"
 #include <utility>
 #include <vector>
@@ -26,55 +27,29 @@
 void galileo_e6_b_code_gen_complex_primary(own::span<std::complex<float>> dest,
     int32_t prn)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
-
-    for (size_t i = 0; i < GALILEO_E6_B_PRIMARY_CODE_STR_LENGTH - 1; i++)
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GALILEO_E6_B, static_cast<uint32_t>(prn));
+    for (uint32_t i = 0; i < code->size(); i++)
         {
-            hex_to_binary_converter(a, GALILEO_E6_B_PRIMARY_CODE[prn_][i]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-            dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-            dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-            index = index + 4;
+            dest[i] = std::complex<float>(static_cast<float>(code->value(i)), 0.0);
         }
-    // last bit is filled up with a zero
-    hex_to_binary_converter(a, GALILEO_E6_B_PRIMARY_CODE[prn_][GALILEO_E6_B_PRIMARY_CODE_STR_LENGTH - 1]);
-    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
 }
 
 
 void galileo_e6_b_code_gen_float_primary(own::span<float> dest, int32_t prn)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
-
-    for (size_t i = 0; i < GALILEO_E6_B_PRIMARY_CODE_STR_LENGTH - 1; i++)
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GALILEO_E6_B, static_cast<uint32_t>(prn));
+    for (uint32_t i = 0; i < code->size(); i++)
         {
-            hex_to_binary_converter(a, GALILEO_E6_B_PRIMARY_CODE[prn_][i]);
-            dest[index] = static_cast<float>(a[0]);
-            dest[index + 1] = static_cast<float>(a[1]);
-            dest[index + 2] = static_cast<float>(a[2]);
-            dest[index + 3] = static_cast<float>(a[3]);
-            index = index + 4;
+            dest[i] = static_cast<float>(code->value(i));
         }
-    // last bit is filled up with a zero
-    hex_to_binary_converter(a, GALILEO_E6_B_PRIMARY_CODE[prn_][GALILEO_E6_B_PRIMARY_CODE_STR_LENGTH - 1]);
-    dest[index] = static_cast<float>(a[0]);
-    dest[index + 1] = static_cast<float>(a[1]);
-    dest[index + 2] = static_cast<float>(a[2]);
 }
 
 
@@ -109,53 +84,29 @@ void galileo_e6_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 void galileo_e6_c_code_gen_complex_primary(own::span<std::complex<float>> dest,
     int32_t prn)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
-    for (size_t i = 0; i < GALILEO_E6_C_PRIMARY_CODE_STR_LENGTH - 1; i++)
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GALILEO_E6_C, static_cast<uint32_t>(prn));
+    for (uint32_t i = 0; i < code->size(); i++)
         {
-            hex_to_binary_converter(a, GALILEO_E6_C_PRIMARY_CODE[prn_][i]);
-            dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-            dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-            dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
-            dest[index + 3] = std::complex<float>(static_cast<float>(a[3]), 0.0);
-            index = index + 4;
+            dest[i] = std::complex<float>(static_cast<float>(code->value(i)), 0.0);
         }
-    // last bit is filled up with a zero
-    hex_to_binary_converter(a, GALILEO_E6_C_PRIMARY_CODE[prn_][GALILEO_E6_C_PRIMARY_CODE_STR_LENGTH - 1]);
-    dest[index] = std::complex<float>(static_cast<float>(a[0]), 0.0);
-    dest[index + 1] = std::complex<float>(static_cast<float>(a[1]), 0.0);
-    dest[index + 2] = std::complex<float>(static_cast<float>(a[2]), 0.0);
 }
 
 
 void galileo_e6_c_code_gen_float_primary(own::span<float> dest, int32_t prn)
 {
-    const uint32_t prn_ = prn - 1;
-    uint32_t index = 0;
-    std::array<int32_t, 4> a{};
     if ((prn < 1) || (prn > 50))
         {
             return;
         }
-    for (size_t i = 0; i < GALILEO_E6_C_PRIMARY_CODE_STR_LENGTH - 1; i++)
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GALILEO_E6_C, static_cast<uint32_t>(prn));
+    for (uint32_t i = 0; i < code->size(); i++)
         {
-            hex_to_binary_converter(a, GALILEO_E6_C_PRIMARY_CODE[prn_][i]);
-            dest[index] = static_cast<float>(a[0]);
-            dest[index + 1] = static_cast<float>(a[1]);
-            dest[index + 2] = static_cast<float>(a[2]);
-            dest[index + 3] = static_cast<float>(a[3]);
-            index = index + 4;
+            dest[i] = static_cast<float>(code->value(i));
         }
-    // last bit is filled up with a zero
-    hex_to_binary_converter(a, GALILEO_E6_C_PRIMARY_CODE[prn_][GALILEO_E6_C_PRIMARY_CODE_STR_LENGTH - 1]);
-    dest[index] = static_cast<float>(a[0]);
-    dest[index + 1] = static_cast<float>(a[1]);
-    dest[index + 2] = static_cast<float>(a[2]);
 }
 
 
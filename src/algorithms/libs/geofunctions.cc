@@ -62,7 +62,18 @@ double WGS84_geocentric_radius(double Lat_geodetic_rad)
 }
 
 
-int topocent(double *Az, double *El, double *D, const arma::vec &x, const arma::vec &dx)
+namespace
+{
+// Rows of the rotation from ECEF to East-North-Up at the origin x
+struct Enu_Rotation
+{
+    std::array<double, 3> e;
+    std::array<double, 3> n;
+    std::array<double, 3> u;
+};
+
+
+Enu_Rotation enu_rotation(const std::array<double, 3> &x)
 {
     double lambda;
     double phi;
@@ -72,27 +83,36 @@ int topocent(double *Az, double *El, double *D, const arma::vec &x, const arma::
     const double finv = 298.257223563;  // inverse of flattening of the reference ellipsoid WGS-84
 
     // Transform x into geodetic coordinates
-    togeod(&phi, &lambda, &h, a, finv, x(0), x(1), x(2));
+    togeod(&phi, &lambda, &h, a, finv, x[0], x[1], x[2]);
 
-    double cl = cos(lambda * dtr);
-    double sl = sin(lambda * dtr);
-    double cb = cos(phi * dtr);
-    double sb = sin(phi * dtr);
+    const double cl = cos(lambda * dtr);
+    const double sl = sin(lambda * dtr);
+    const double cb = cos(phi * dtr);
+    const double sb = sin(phi * dtr);
 
-    arma::mat F = {{-sl, -sb * cl, cb * cl},
-        {cl, -sb * sl, cb * sl},
-        {0.0, cb, sb}};
+    return Enu_Rotation{{-sl, cl, 0.0},
+        {-sb * cl, -sb * sl, cb},
+        {cb * cl, cb * sl, sb}};
+}
+}  // namespace
 
-    arma::vec local_vector;
 
-    local_vector = arma::htrans(F) * dx;
+int topocent(double *Az, double *El, double *D, const arma::vec &x, const arma::vec &dx)
+{
+    return topocent(Az, El, D, std::array<double, 3>{x(0), x(1), x(2)}, std::array<double, 3>{dx(0), dx(1), dx(2)});
+}
 
-    double E = local_vector(0);
-    double N = local_vector(1);
-    double U = local_vector(2);
 
-    double hor_dis;
-    hor_dis = sqrt(E * E + N * N);
+int topocent(double *Az, double *El, double *D, const std::array<double, 3> &x, const std::array<double, 3> &dx)
+{
+    const double dtr = STRP_PI / 180.0;
+    const Enu_Rotation F = enu_rotation(x);
+
+    const double E = F.e[0] * dx[0] + F.e[1] * dx[1] + F.e[2] * dx[2];
+    const double N = F.n[0] * dx[0] + F.n[1] * dx[1] + F.n[2] * dx[2];
+    const double U = F.u[0] * dx[0] + F.u[1] * dx[1] + F.u[2] * dx[2];
+
+    const double hor_dis = sqrt(E * E + N * N);
 
     if (hor_dis < 1.0E-20)
         {
@@ -110,11 +130,31 @@ int topocent(double *Az, double *El, double *D, const arma::vec &x, const arma::
             *Az = *Az + 360.0;
         }
 
-    *D = sqrt(dx(0) * dx(0) + dx(1) * dx(1) + dx(2) * dx(2));
+    *D = sqrt(dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2]);
     return 0;
 }
 
 
+void topocent(const std::array<double, 3> &x, const double *dX, const double *dY, const double *dZ, size_t n, double *Az, double *El, double *D)
+{
+    const double dtr = STRP_PI / 180.0;
+    const Enu_Rotation F = enu_rotation(x);
+
+    for (size_t i = 0; i < n; i++)
+        {
+            const double E = F.e[0] * dX[i] + F.e[1] * dY[i] + F.e[2] * dZ[i];
+            const double N = F.n[0] * dX[i] + F.n[1] * dY[i] + F.n[2] * dZ[i];
+            const double U = F.u[0] * dX[i] + F.u[1] * dY[i] + F.u[2] * dZ[i];
+            const double hor_dis = sqrt(E * E + N * N);
+            const bool zenith = hor_dis < 1.0E-20;
+            const double az = atan2(E, N) / dtr;
+            Az[i] = zenith ? 0.0 : (az < 0.0 ? az + 360.0 : az);
+            El[i] = zenith ? 90.0 : atan2(U, hor_dis) / dtr;
+            D[i] = sqrt(dX[i] * dX[i] + dY[i] * dY[i] + dZ[i] * dZ[i]);
+        }
+}
+
+
 int togeod(double *dphi, double *dlambda, double *h, double a, double finv, double X, double Y, double Z)
 {
     *h = 0.0;
@@ -364,6 +404,46 @@ arma::vec cart2geo(const arma::vec &XYZ, int elipsoid_selection)
 }
 
 
+void cart2geo(const double *X, const double *Y, const double *Z, size_t n, int elipsoid_selection, double *lat, double *lon, double *h)
+{
+    const std::array<double, 5> a{6378388.0, 6378160.0, 6378135.0, 6378137.0, 6378137.0};
+    const std::array<double, 5> f{1.0 / 297.0, 1.0 / 298.247, 1.0 / 298.26, 1.0 / 298.257222101, 1.0 / 298.257223563};
+    const double fs = f[elipsoid_selection];
+    const double ex2 = (2.0 - fs) * fs / ((1.0 - fs) * (1.0 - fs));
+    const double c = a[elipsoid_selection] * sqrt(1.0 + ex2);
+
+    for (size_t i = 0; i < n; i++)
+        {
+            const double P = sqrt(X[i] * X[i] + Y[i] * Y[i]);
+            lon[i] = atan2(Y[i], X[i]);
+            lat[i] = atan(Z[i] / ((P * (1.0 - (2.0 - fs)) * fs)));
+            h[i] = 0.1;
+        }
+
+    // the points that already converged stay at their fixed point
+    for (int iterations = 0; iterations <= 100; iterations++)
+        {
+            double max_change = 0.0;
+            for (size_t i = 0; i < n; i++)
+                {
+                    const double P = sqrt(X[i] * X[i] + Y[i] * Y[i]);
+                    const double cos_lat = cos(lat[i]);
+                    const double N = c / sqrt(1.0 + ex2 * (cos_lat * cos_lat));
+                    const double phi = atan(Z[i] / ((P * (1.0 - (2.0 - fs) * fs * N / (N + h[i])))));
+                    const double new_h = P / cos(phi) - N;
+                    const double change = std::fabs(new_h - h[i]);
+                    max_change = change > max_change ? change : max_change;
+                    lat[i] = phi;
+                    h[i] = new_h;
+                }
+            if (max_change <= 1.0e-12)
+                {
+                    break;
+                }
+        }
+}
+
+
 void ECEF_to_Geo(const arma::vec &r_eb_e, const arma::vec &v_eb_e, const arma::mat &C_b_e, arma::vec &LLH, arma::vec &v_eb_n, arma::mat &C_b_n)
 {
     // Compute the Latitude of the ECEF position
@@ -24,6 +24,8 @@
 #endif
 
 #include <armadillo>
+#include <array>
+#include <cstddef>
 
 /** \addtogroup Algorithms_Library
  * \{ */
@@ -53,6 +55,20 @@ double WGS84_geocentric_radius(double Lat_geodetic_rad);
  */
 int topocent(double *Az, double *El, double *D, const arma::vec &x, const arma::vec &dx);
 
+/*!
+ * \brief Same as above, without heap allocations, for the per-satellite
+ * azimuth and elevation.
+ */
+int topocent(double *Az, double *El, double *D, const std::array<double, 3> &x, const std::array<double, 3> &dx);
+
+/*!
+ * \brief Azimuth, elevation (degrees) and length of the n vectors
+ * (dX[i], dY[i], dZ[i]) seen from the same origin x. The geodetic coordinates
+ * of x are computed once, and the loop over the vectors has no branches so
+ * that the compiler can vectorize it.
+ */
+void topocent(const std::array<double, 3> &x, const double *dX, const double *dY, const double *dZ, size_t n, double *Az, double *El, double *D);
+
 /*!
  * \brief Subroutine to calculate geodetic coordinates latitude, longitude,
  *   height given Cartesian coordinates X,Y,Z, and reference ellipsoid
@@ -91,6 +107,14 @@ arma::vec Gravity_ECEF(const arma::vec &r_eb_e);  //!< Calculates acceleration d
  */
 arma::vec cart2geo(const arma::vec &XYZ, int elipsoid_selection);
 
+/*!
+ * \brief Conversion of the n points (X[i], Y[i], Z[i]) to geographical
+ * coordinates (latitude and longitude in radians, h in meters), as cart2geo
+ * above. The iterations run over the whole arrays until all the points
+ * converge, so the inner loops have no branches and can be vectorized.
+ */
+void cart2geo(const double *X, const double *Y, const double *Z, size_t n, int elipsoid_selection, double *lat, double *lon, double *h);
+
 arma::vec LLH_to_deg(const arma::vec &LLH);
 
 double degtorad(double angleInDegrees);
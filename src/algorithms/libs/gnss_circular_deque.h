@@ -18,7 +18,8 @@
 #ifndef GNSS_SDR_CIRCULAR_DEQUE_H
 #define GNSS_SDR_CIRCULAR_DEQUE_H
 
-#include <boost/circular_buffer.hpp>
+#include <cstddef>
+#include <stdexcept>
 #include <vector>
 
 /** \addtogroup Algorithms_Library
@@ -27,6 +28,17 @@
  * \{ */
 
 
+/*!
+ * \brief Circular deques of a fixed capacity, one per channel. Pushing to a
+ * full deque drops its first element.
+ *
+ * The elements of all the channels are stored in a single contiguous
+ * allocation, in a slot of a power-of-two size per channel, so that an
+ * element is found by masking instead of by a modulo. index() returns the
+ * position of an element in that storage, and push_back() that of the new
+ * element, so that some fields of the elements can also be kept in parallel
+ * arrays of storage_size() elements (a structure of arrays) by the callers.
+ */
 template <class T>
 class Gnss_circular_deque
 {
@@ -38,14 +50,26 @@ public:
     const T& get(unsigned int ch, unsigned int pos) const;            //!< Returns a const reference to an element without bound checking
     T& front(unsigned int ch);                                        //!< Returns a reference to the first element in the deque
     T& back(unsigned int ch);                                         //!< Returns a reference to the last element in the deque
-    void push_back(unsigned int ch, const T& new_data);               //!< Inserts an element at the end of the deque
+    unsigned int push_back(unsigned int ch, const T& new_data);       //!< Inserts an element at the end of the deque. Returns its index in the storage
     void pop_front(unsigned int ch);                                  //!< Removes the first element of the deque
     void clear(unsigned int ch);                                      //!< Removes all the elements of the deque (Sets size to 0). Capacity is not modified
     void reset(unsigned int max_size, unsigned int nchann);           //!< Removes all the elements in all the channels. Re-sets the number of channels and their capacity
     void reset();                                                     //!< Removes all the channels (Sets nchann to 0)
+    unsigned int index(unsigned int ch, unsigned int pos) const;      //!< Returns the index of an element in the storage shared by all the channels
+    unsigned int storage_size() const;                                //!< Returns the number of elements of that storage
 
 private:
-    std::vector<boost::circular_buffer<T>> d_data;
+    struct Ring
+    {
+        unsigned int head{0};  // storage index of the first element, within the slot of the channel
+        unsigned int size{0};
+    };
+
+    std::vector<T> d_data;
+    std::vector<Ring> d_rings;
+    unsigned int d_max_size{0};
+    unsigned int d_shift{0};  // log2 of the slot size
+    unsigned int d_mask{0};
 };
 
 
@@ -66,55 +90,77 @@ Gnss_circular_deque<T>::Gnss_circular_deque(unsigned int max_size, unsigned int
 template <class T>
 unsigned int Gnss_circular_deque<T>::size(unsigned int ch) const
 {
-    return d_data[ch].size();
+    return d_rings[ch].size;
+}
+
+
+template <class T>
+unsigned int Gnss_circular_deque<T>::index(unsigned int ch, unsigned int pos) const
+{
+    return (ch << d_shift) | ((d_rings[ch].head + pos) & d_mask);
+}
+
+
+template <class T>
+unsigned int Gnss_circular_deque<T>::storage_size() const
+{
+    return static_cast<unsigned int>(d_data.size());
 }
 
 
 template <class T>
 T& Gnss_circular_deque<T>::back(unsigned int ch)
 {
-    return d_data[ch].back();
+    return d_data[index(ch, d_rings[ch].size - 1)];
 }
 
 
 template <class T>
 T& Gnss_circular_deque<T>::front(unsigned int ch)
 {
-    return d_data[ch].front();
+    return d_data[index(ch, 0)];
 }
 
 
 template <class T>
 T& Gnss_circular_deque<T>::at(unsigned int ch, unsigned int pos)
 {
-    return d_data.at(ch).at(pos);
+    if (ch >= d_rings.size() or pos >= d_rings[ch].size)
+        {
+            throw std::out_of_range("Gnss_circular_deque::at");
+        }
+    return d_data[index(ch, pos)];
 }
 
 
 template <class T>
 const T& Gnss_circular_deque<T>::get(unsigned int ch, unsigned int pos) const
 {
-    return d_data[ch][pos];
+    return d_data[index(ch, pos)];
 }
 
 
 template <class T>
 void Gnss_circular_deque<T>::clear(unsigned int ch)
 {
-    d_data[ch].clear();
+    d_rings[ch] = Ring();
 }
 
 
 template <class T>
 void Gnss_circular_deque<T>::reset(unsigned int max_size, unsigned int nchann)
 {
-    d_data.clear();
+    reset();
     if (max_size > 0 and nchann > 0)
         {
-            for (unsigned int i = 0; i < nchann; i++)
+            d_max_size = max_size;
+            while ((1U << d_shift) < max_size)
                 {
-                    d_data.push_back(boost::circular_buffer<T>(max_size));
+                    d_shift++;
                 }
+            d_mask = (1U << d_shift) - 1;
+            d_data = std::vector<T>(static_cast<size_t>(nchann) << d_shift);
+            d_rings = std::vector<Ring>(nchann);
         }
 }
 
@@ -123,20 +169,37 @@ template <class T>
 void Gnss_circular_deque<T>::reset()
 {
     d_data.clear();
+    d_data.shrink_to_fit();
+    d_rings.clear();
+    d_max_size = 0;
+    d_shift = 0;
+    d_mask = 0;
 }
 
 
 template <class T>
 void Gnss_circular_deque<T>::pop_front(unsigned int ch)
 {
-    d_data[ch].pop_front();
+    Ring& ring = d_rings[ch];
+    ring.head = (ring.head + 1) & d_mask;
+    ring.size--;
 }
 
 
 template <class T>
-void Gnss_circular_deque<T>::push_back(unsigned int ch, const T& new_data)
+unsigned int Gnss_circular_deque<T>::push_back(unsigned int ch, const T& new_data)
 {
-    d_data[ch].push_back(new_data);
+    Ring& ring = d_rings[ch];
+    if (ring.size == d_max_size)
+        {
+            // full, overwrite the first one
+            ring.head = (ring.head + 1) & d_mask;
+            ring.size--;
+        }
+    const unsigned int i = index(ch, ring.size);
+    d_data[i] = new_data;
+    ring.size++;
+    return i;
 }
 
 
@@ -0,0 +1,274 @@
+/*!
+ * \file gnss_code_table.cc
+ * \brief Bit-packed primary spreading codes of all the PRNs of a signal,
+ * generated once and shared by all the channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_code_table.h"
+#include "GPS_L5.h"
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "Galileo_E5b.h"
+#include "Galileo_E6.h"
+#include <array>
+#include <cstddef>  // for size_t
+#include <mutex>
+
+
+Gnss_Packed_Code::Gnss_Packed_Code(uint32_t length)
+    : d_words((length + 63U) / 64U, 0U),
+      d_length(length)
+{
+}
+
+
+void Gnss_Packed_Code::set_bit(uint32_t chip, bool bit)
+{
+    const uint64_t mask = uint64_t(1) << (chip & 63U);
+    if (bit)
+        {
+            d_words[chip >> 6U] |= mask;
+        }
+    else
+        {
+            d_words[chip >> 6U] &= ~mask;
+        }
+}
+
+
+namespace
+{
+constexpr size_t NUM_CODE_IDS = static_cast<size_t>(Gnss_Code_Id::GALILEO_E6_C) + 1;
+
+
+std::vector<Gnss_Packed_Code> make_gps_l1_ca_codes()
+{
+    constexpr uint32_t code_length = 1023;
+    // G2 delays as defined in IS-GPS-200, for PRN 1 to 32 and SBAS PRN 120 to 138
+    const std::array<uint32_t, 51> delays = {5 /*PRN1*/, 6, 7, 8, 17, 18, 139, 140, 141, 251, 252, 254, 255, 256, 257, 258, 469, 470, 471, 472,
+        473, 474, 509, 512, 513, 514, 515, 516, 859, 860, 861, 862 /*PRN32*/,
+        145 /*PRN120*/, 175, 52, 21, 237, 235, 886, 657, 634, 762,
+        355, 1012, 176, 603, 130, 359, 595, 68, 386 /*PRN138*/};
+
+    // One period of the G1 and G2 sequences. Bit k of a register is stage k + 1
+    std::vector<bool> g1(code_length);
+    std::vector<bool> g2(code_length);
+    uint32_t g1_register = 0x3FF;
+    uint32_t g2_register = 0x3FF;
+    for (uint32_t n = 0; n < code_length; n++)
+        {
+            g1[n] = (g1_register & 1U) != 0U;
+            g2[n] = (g2_register & 1U) != 0U;
+            const uint32_t feedback1 = (g1_register >> 7U) ^ g1_register;
+            const uint32_t feedback2 = (g2_register >> 8U) ^ (g2_register >> 7U) ^ (g2_register >> 4U) ^ (g2_register >> 2U) ^ (g2_register >> 1U) ^ g2_register;
+            g1_register = (g1_register >> 1U) | ((feedback1 & 1U) << 9U);
+            g2_register = (g2_register >> 1U) | ((feedback2 & 1U) << 9U);
+        }
+
+    std::vector<Gnss_Packed_Code> codes(delays.size(), Gnss_Packed_Code(code_length));
+    for (size_t idx = 0; idx < delays.size(); idx++)
+        {
+            const uint32_t delay = code_length - delays[idx];
+            for (uint32_t n = 0; n < code_length; n++)
+                {
+                    // G1 xor G2 = 1 is the chip value +1 in the replicas of this receiver
+                    codes[idx].set_bit(n, g1[n] == g2[(n + delay) % code_length]);
+                }
+        }
+    return codes;
+}
+
+
+std::vector<Gnss_Packed_Code> make_beidou_b1i_codes()
+{
+    constexpr uint32_t code_length = 2046;
+    constexpr uint32_t num_prns = 33;
+    const std::array<uint32_t, num_prns> phase1 = {1, 1, 1, 1, 1, 1, 1, 1, 2, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 8, 8};
+    const std::array<uint32_t, num_prns> phase2 = {3, 4, 5, 6, 8, 9, 10, 11, 7, 4, 5, 6, 8, 9, 10, 11, 5, 6, 8, 9, 10, 11, 6, 8, 9, 10, 11, 8, 9, 10, 11, 9, 10};
+
+    std::vector<Gnss_Packed_Code> codes(num_prns, Gnss_Packed_Code(code_length));
+    for (uint32_t idx = 0; idx < num_prns; idx++)
+        {
+            // Bit k of a register is stage 11 - k, initial phase 01010101010
+            uint32_t g1_register = 0x2AA;
+            uint32_t g2_register = 0x2AA;
+            for (uint32_t n = 0; n < code_length; n++)
+                {
+                    const uint32_t g1 = g1_register & 1U;
+                    const uint32_t g2 = ((g2_register >> (11U - phase1[idx])) ^ (g2_register >> (11U - phase2[idx]))) & 1U;
+                    codes[idx].set_bit(n, g1 == g2);
+                    const uint32_t feedback1 = g1_register ^ (g1_register >> 1U) ^ (g1_register >> 2U) ^ (g1_register >> 3U) ^ (g1_register >> 4U) ^ (g1_register >> 10U);
+                    const uint32_t feedback2 = g2_register ^ (g2_register >> 2U) ^ (g2_register >> 3U) ^ (g2_register >> 6U) ^ (g2_register >> 7U) ^ (g2_register >> 8U) ^ (g2_register >> 9U) ^ (g2_register >> 10U);
+                    g1_register = (g1_register >> 1U) | ((feedback1 & 1U) << 10U);
+                    g2_register = (g2_register >> 1U) | ((feedback2 & 1U) << 10U);
+                }
+        }
+    return codes;
+}
+
+
+// GPS-IS-705E Figures 3-4 and 3-5. Bit k of a register is stage k + 1, and
+// both the I5 and Q5 codes use the same XA and XB sequences.
+std::vector<Gnss_Packed_Code> make_gps_l5_codes(const int32_t* xb_advance)
+{
+    constexpr uint32_t code_length = GPS_L5I_CODE_LENGTH_CHIPS;
+    constexpr uint32_t num_prns = 50;
+    constexpr uint32_t all_ones = 0x1FFF;
+    constexpr uint32_t xa_reset_state = 0x17FF;  // 1111111111101, the XA register is reset to all ones after it
+
+    std::vector<bool> xa(code_length);
+    std::vector<bool> xb(code_length);
+    uint32_t xa_register = all_ones;
+    uint32_t xb_register = all_ones;
+    for (uint32_t n = 0; n < code_length; n++)
+        {
+            xa[n] = ((xa_register >> 12U) & 1U) != 0U;
+            xb[n] = ((xb_register >> 12U) & 1U) != 0U;
+            if (xa_register == xa_reset_state)
+                {
+                    xa_register = all_ones;
+                }
+            else
+                {
+                    const uint32_t feedback = (xa_register >> 12U) ^ (xa_register >> 11U) ^ (xa_register >> 9U) ^ (xa_register >> 8U);
+                    xa_register = ((xa_register << 1U) & all_ones) | (feedback & 1U);
+                }
+            const uint32_t feedback = (xb_register >> 12U) ^ (xb_register >> 11U) ^ (xb_register >> 7U) ^ (xb_register >> 6U) ^
+                                      (xb_register >> 5U) ^ (xb_register >> 3U) ^ (xb_register >> 2U) ^ xb_register;
+            xb_register = ((xb_register << 1U) & all_ones) | (feedback & 1U);
+        }
+
+    std::vector<Gnss_Packed_Code> codes(num_prns, Gnss_Packed_Code(code_length));
+    for (uint32_t idx = 0; idx < num_prns; idx++)
+        {
+            const auto advance = static_cast<uint32_t>(xb_advance[idx]);
+            for (uint32_t n = 0; n < code_length; n++)
+                {
+                    codes[idx].set_bit(n, xa[n] != xb[(advance + n) % code_length]);
+                }
+        }
+    return codes;
+}
+
+
+// Memory codes, as hexadecimal strings with the first chip in the most
+// significant bit of the first character. The last character may be padded.
+template <size_t N, size_t M>
+std::vector<Gnss_Packed_Code> make_memory_codes(const char (&hex_codes)[N][M], uint32_t code_length)
+{
+    std::vector<Gnss_Packed_Code> codes(N, Gnss_Packed_Code(code_length));
+    for (size_t idx = 0; idx < N; idx++)
+        {
+            for (uint32_t n = 0; n < code_length; n++)
+                {
+                    const char c = hex_codes[idx][n / 4];
+                    uint32_t nibble = 0;
+                    if (c >= '0' and c <= '9')
+                        {
+                            nibble = static_cast<uint32_t>(c - '0');
+                        }
+                    else if (c >= 'A' and c <= 'F')
+                        {
+                            nibble = static_cast<uint32_t>(c - 'A' + 10);
+                        }
+                    else if (c >= 'a' and c <= 'f')
+                        {
+                            nibble = static_cast<uint32_t>(c - 'a' + 10);
+                        }
+                    codes[idx].set_bit(n, ((nibble >> (3U - n % 4U)) & 1U) != 0U);
+                }
+        }
+    return codes;
+}
+
+
+std::vector<Gnss_Packed_Code> make_codes(Gnss_Code_Id code)
+{
+    switch (code)
+        {
+        case Gnss_Code_Id::GPS_L1_CA:
+            return make_gps_l1_ca_codes();
+        case Gnss_Code_Id::GPS_L5_I:
+            return make_gps_l5_codes(GPS_L5I_INIT_REG);
+        case Gnss_Code_Id::GPS_L5_Q:
+            return make_gps_l5_codes(GPS_L5Q_INIT_REG);
+        case Gnss_Code_Id::BEIDOU_B1I:
+            return make_beidou_b1i_codes();
+        case Gnss_Code_Id::GALILEO_E1_B:
+            return make_memory_codes(GALILEO_E1_B_PRIMARY_CODE, static_cast<uint32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
+        case Gnss_Code_Id::GALILEO_E1_C:
+            return make_memory_codes(GALILEO_E1_C_PRIMARY_CODE, static_cast<uint32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
+        case Gnss_Code_Id::GALILEO_E5A_I:
+            return make_memory_codes(GALILEO_E5A_I_PRIMARY_CODE, GALILEO_E5A_CODE_LENGTH_CHIPS);
+        case Gnss_Code_Id::GALILEO_E5A_Q:
+            return make_memory_codes(GALILEO_E5A_Q_PRIMARY_CODE, GALILEO_E5A_CODE_LENGTH_CHIPS);
+        case Gnss_Code_Id::GALILEO_E5B_I:
+            return make_memory_codes(GALILEO_E5B_I_PRIMARY_CODE, GALILEO_E5B_CODE_LENGTH_CHIPS);
+        case Gnss_Code_Id::GALILEO_E5B_Q:
+            return make_memory_codes(GALILEO_E5B_Q_PRIMARY_CODE, GALILEO_E5B_CODE_LENGTH_CHIPS);
+        case Gnss_Code_Id::GALILEO_E6_B:
+            return make_memory_codes(GALILEO_E6_B_PRIMARY_CODE, static_cast<uint32_t>(GALILEO_E6_B_CODE_LENGTH_CHIPS));
+        case Gnss_Code_Id::GALILEO_E6_C:
+            return make_memory_codes(GALILEO_E6_C_PRIMARY_CODE, static_cast<uint32_t>(GALILEO_E6_C_CODE_LENGTH_CHIPS));
+        default:
+            return {};
+        }
+}
+
+
+// Position of a PRN in the table of its signal, or -1
+int32_t code_index(Gnss_Code_Id code, uint32_t prn)
+{
+    if (prn < 1)
+        {
+            return -1;
+        }
+    switch (code)
+        {
+        case Gnss_Code_Id::GPS_L1_CA:
+            if (prn <= 32)
+                {
+                    return static_cast<int32_t>(prn) - 1;
+                }
+            if (prn >= 120 and prn <= 138)
+                {
+                    return static_cast<int32_t>(prn) - 88;  // SBAS PRNs follow PRN 32
+                }
+            return -1;
+        case Gnss_Code_Id::BEIDOU_B1I:
+            return prn <= 33 ? static_cast<int32_t>(prn) - 1 : -1;
+        default:
+            return prn <= 50 ? static_cast<int32_t>(prn) - 1 : -1;
+        }
+}
+}  // namespace
+
+
+const Gnss_Packed_Code* gnss_primary_code(Gnss_Code_Id code, uint32_t prn)
+{
+    static std::array<std::once_flag, NUM_CODE_IDS> built;
+    static std::array<std::vector<Gnss_Packed_Code>, NUM_CODE_IDS> tables;
+
+    const int32_t idx = code_index(code, prn);
+    if (idx < 0)
+        {
+            return nullptr;
+        }
+    const auto table = static_cast<size_t>(code);
+    std::call_once(built[table], [code, table]() { tables[table] = make_codes(code); });
+    if (static_cast<size_t>(idx) >= tables[table].size())
+        {
+            return nullptr;
+        }
+    return &tables[table][idx];
+}
@@ -0,0 +1,95 @@
+/*!
+ * \file gnss_code_table.h
+ * \brief Bit-packed primary spreading codes of all the PRNs of a signal,
+ * generated once and shared by all the channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CODE_TABLE_H
+#define GNSS_SDR_GNSS_CODE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief A spreading code stored with one bit per chip. Bit 1 is the chip
+ * value -1 and bit 0 the chip value +1.
+ */
+class Gnss_Packed_Code
+{
+public:
+    Gnss_Packed_Code() = default;
+    explicit Gnss_Packed_Code(uint32_t length);
+
+    inline uint32_t size() const { return d_length; }
+
+    inline bool bit(uint32_t chip) const
+    {
+        return ((d_words[chip >> 6U] >> (chip & 63U)) & 1U) != 0U;
+    }
+
+    //! Chip value, +1 or -1
+    inline int32_t value(uint32_t chip) const
+    {
+        return bit(chip) ? -1 : 1;
+    }
+
+    void set_bit(uint32_t chip, bool bit);
+
+private:
+    std::vector<uint64_t> d_words;
+    uint32_t d_length{0};
+};
+
+
+/*!
+ * \brief Signal components with a table of primary codes
+ */
+enum class Gnss_Code_Id
+{
+    GPS_L1_CA,
+    GPS_L5_I,
+    GPS_L5_Q,
+    BEIDOU_B1I,
+    GALILEO_E1_B,
+    GALILEO_E1_C,
+    GALILEO_E5A_I,
+    GALILEO_E5A_Q,
+    GALILEO_E5B_I,
+    GALILEO_E5B_Q,
+    GALILEO_E6_B,
+    GALILEO_E6_C
+};
+
+
+/*!
+ * \brief Returns the primary code of a PRN, or nullptr if the signal has no
+ * such PRN.
+ *
+ * The codes of all the PRNs of a signal are generated (LFSR codes) or
+ * unpacked from their hexadecimal definition (memory codes) on the first
+ * request for that signal, and are then kept for the lifetime of the
+ * process, so the code generators of each channel only expand chips from
+ * this table into their sampling, BOC or complex form. Thread-safe.
+ */
+const Gnss_Packed_Code* gnss_primary_code(Gnss_Code_Id code, uint32_t prn);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_CODE_TABLE_H
@@ -0,0 +1,240 @@
+/*!
+ * \file gnss_sdr_async_log.cc
+ * \brief Asynchronous writing of the glog log files, and rate limited
+ * logging of the processing loops
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_async_log.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <algorithm>
+
+
+std::unique_ptr<Gnss_Sdr_Async_Logger> Gnss_Sdr_Async_Logger::install(size_t queue_size)
+{
+    std::vector<google::base::Logger*> loggers(NUM_SEVERITIES);
+    for (int32_t severity = 0; severity < NUM_SEVERITIES; severity++)
+        {
+            loggers[severity] = google::base::GetLogger(severity);
+        }
+    auto async_logger = std::make_unique<Gnss_Sdr_Async_Logger>(loggers, queue_size);
+    for (int32_t severity = 0; severity < NUM_SEVERITIES; severity++)
+        {
+            google::base::SetLogger(severity, async_logger->front_end(severity));
+        }
+    async_logger->d_installed = true;
+    return async_logger;
+}
+
+
+Gnss_Sdr_Async_Logger::Gnss_Sdr_Async_Logger(const std::vector<google::base::Logger*>& loggers, size_t queue_size)
+    : d_loggers(loggers)
+{
+    size_t capacity = 2;
+    while (capacity < queue_size)
+        {
+            capacity <<= 1U;
+        }
+    d_cells = std::unique_ptr<Cell[]>(new Cell[capacity]);
+    for (size_t i = 0; i < capacity; i++)
+        {
+            d_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    d_mask = capacity - 1;
+    for (size_t severity = 0; severity < d_loggers.size(); severity++)
+        {
+            d_front_ends.push_back(std::make_unique<Front_End>(this, static_cast<int32_t>(severity)));
+        }
+    d_writer = std::thread(&Gnss_Sdr_Async_Logger::run, this);
+}
+
+
+Gnss_Sdr_Async_Logger::~Gnss_Sdr_Async_Logger()
+{
+    if (d_installed)
+        {
+            // glog holds its mutex while it writes to the loggers, so no
+            // front end is in use once they are restored
+            for (size_t severity = 0; severity < d_loggers.size(); severity++)
+                {
+                    google::base::SetLogger(static_cast<int32_t>(severity), d_loggers[severity]);
+                }
+        }
+    {
+        const std::lock_guard<std::mutex> lock(d_wait_mutex);
+        d_running = false;
+    }
+    d_wake_up.notify_one();
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    flush();
+}
+
+
+google::base::Logger* Gnss_Sdr_Async_Logger::front_end(int32_t severity)
+{
+    return d_front_ends.at(severity).get();
+}
+
+
+void Gnss_Sdr_Async_Logger::flush()
+{
+    const std::lock_guard<std::mutex> lock(d_write_mutex);
+    drain();
+    flush_loggers();
+}
+
+
+void Gnss_Sdr_Async_Logger::push(int32_t severity, bool force_flush, time_t timestamp, const char* message, int message_len)
+{
+    size_t index = d_enqueue_index.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+        {
+            cell = &d_cells[index & d_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            if (sequence == index)
+                {
+                    if (d_enqueue_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                }
+            else if (sequence < index)
+                {
+                    // the cell still holds the message of the previous lap
+                    d_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            else
+                {
+                    index = d_enqueue_index.load(std::memory_order_relaxed);
+                }
+        }
+    cell->message.assign(message, static_cast<size_t>(std::max(message_len, 0)));
+    cell->timestamp = timestamp;
+    cell->severity = severity;
+    cell->force_flush = force_flush;
+    cell->sequence.store(index + 1, std::memory_order_release);
+    if (d_writer_waiting.load())
+        {
+            d_wake_pending = true;
+            d_wake_up.notify_one();
+        }
+}
+
+
+void Gnss_Sdr_Async_Logger::write_fatal(int32_t severity, bool force_flush, time_t timestamp, const char* message, int message_len)
+{
+    d_synchronous = true;
+    const std::lock_guard<std::mutex> lock(d_write_mutex);
+    drain();
+    d_loggers[severity]->Write(force_flush, timestamp, message, message_len);
+}
+
+
+bool Gnss_Sdr_Async_Logger::drain()
+{
+    bool wrote = false;
+    while (true)
+        {
+            Cell& cell = d_cells[d_dequeue_index & d_mask];
+            if (cell.sequence.load(std::memory_order_acquire) != d_dequeue_index + 1)
+                {
+                    break;
+                }
+            d_loggers[cell.severity]->Write(cell.force_flush, cell.timestamp, cell.message.data(), static_cast<int>(cell.message.size()));
+            cell.sequence.store(d_dequeue_index + d_mask + 1, std::memory_order_release);
+            d_dequeue_index++;
+            wrote = true;
+        }
+    const uint64_t dropped = d_dropped.load(std::memory_order_relaxed);
+    if (dropped != d_dropped_reported and !d_loggers.empty())
+        {
+            const std::string note = "Gnss_Sdr_Async_Logger: " + std::to_string(dropped - d_dropped_reported) + " log messages dropped, the queue was full\n";
+            d_loggers[0]->Write(false, std::time(nullptr), note.data(), static_cast<int>(note.size()));
+            d_dropped_reported = dropped;
+        }
+    return wrote;
+}
+
+
+void Gnss_Sdr_Async_Logger::flush_loggers()
+{
+    for (size_t severity = 0; severity < d_loggers.size(); severity++)
+        {
+            d_loggers[severity]->Flush();
+        }
+}
+
+
+void Gnss_Sdr_Async_Logger::run()
+{
+    while (true)
+        {
+            const bool stopping = !d_running.load();
+            bool wrote;
+            {
+                const std::lock_guard<std::mutex> lock(d_write_mutex);
+                wrote = drain();
+                if (d_flush_requested.exchange(false))
+                    {
+                        flush_loggers();
+                    }
+            }
+            if (stopping)
+                {
+                    return;
+                }
+            if (!wrote)
+                {
+                    // a message pushed between the drain and the wait is
+                    // written when the wait times out
+                    std::unique_lock<std::mutex> lock(d_wait_mutex);
+                    d_writer_waiting = true;
+                    d_wake_up.wait_for(lock, std::chrono::milliseconds(10), [this]() { return !d_running.load() or d_wake_pending.exchange(false); });
+                    d_writer_waiting = false;
+                }
+        }
+}
+
+
+void Gnss_Sdr_Async_Logger::Front_End::Write(bool force_flush, time_t timestamp, const char* message, int message_len)
+{
+    if (d_severity == GLOG_FATAL or d_owner->d_synchronous.load(std::memory_order_relaxed))
+        {
+            d_owner->write_fatal(d_severity, force_flush, timestamp, message, message_len);
+        }
+    else
+        {
+            d_owner->push(d_severity, force_flush, timestamp, message, message_len);
+        }
+}
+
+
+void Gnss_Sdr_Async_Logger::Front_End::Flush()
+{
+    d_owner->d_flush_requested = true;
+    if (d_owner->d_writer_waiting.load())
+        {
+            d_owner->d_wake_pending = true;
+            d_owner->d_wake_up.notify_one();
+        }
+}
+
+
+google::uint32 Gnss_Sdr_Async_Logger::Front_End::LogSize()
+{
+    return d_owner->d_loggers[d_severity]->LogSize();
+}
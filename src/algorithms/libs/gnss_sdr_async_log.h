@@ -0,0 +1,176 @@
+/*!
+ * \file gnss_sdr_async_log.h
+ * \brief Asynchronous writing of the glog log files, and rate limited
+ * logging of the processing loops
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_ASYNC_LOG_H
+#define GNSS_SDR_GNSS_SDR_ASYNC_LOG_H
+
+#include <glog/logging.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes the messages of the glog loggers (the objects that write the
+ * log file of each severity) from a thread of its own.
+ *
+ * glog formats a message in the calling thread and then, holding its global
+ * mutex, writes it to the file of its severity and of each lower severity.
+ * The front ends that replace the loggers only copy the message into a
+ * bounded lock-free queue, so the processing threads no longer wait for the
+ * file writes of each other. A message that finds the queue full is dropped
+ * and counted, and the count is written to the lowest severity file.
+ *
+ * A message written to the FATAL front end is written synchronously, after
+ * the queued ones, and so are all the following ones, since glog aborts the
+ * process right after.
+ */
+class Gnss_Sdr_Async_Logger
+{
+public:
+    /*!
+     * \brief Replaces the glog loggers of all severities by front ends of a
+     * new Gnss_Sdr_Async_Logger, whose destructor restores them.
+     */
+    static std::unique_ptr<Gnss_Sdr_Async_Logger> install(size_t queue_size);
+
+    /*!
+     * \brief Writes into loggers, indexed by severity, through a queue of
+     * queue_size messages rounded up to a power of two.
+     */
+    Gnss_Sdr_Async_Logger(const std::vector<google::base::Logger*>& loggers, size_t queue_size);
+    ~Gnss_Sdr_Async_Logger();
+
+    Gnss_Sdr_Async_Logger(const Gnss_Sdr_Async_Logger&) = delete;
+    Gnss_Sdr_Async_Logger& operator=(const Gnss_Sdr_Async_Logger&) = delete;
+
+    //! Logger that queues the messages of logger severity
+    google::base::Logger* front_end(int32_t severity);
+
+    /*!
+     * \brief Writes the queued messages and flushes the loggers, from the
+     * calling thread
+     */
+    void flush();
+
+    //! Messages dropped because the queue was full
+    uint64_t dropped() const { return d_dropped.load(std::memory_order_relaxed); }
+
+private:
+    class Front_End : public google::base::Logger
+    {
+    public:
+        Front_End(Gnss_Sdr_Async_Logger* owner, int32_t severity) : d_owner(owner), d_severity(severity) {}
+        void Write(bool force_flush, time_t timestamp, const char* message, int message_len) override;
+        void Flush() override;
+        google::uint32 LogSize() override;
+
+    private:
+        Gnss_Sdr_Async_Logger* d_owner;
+        int32_t d_severity;
+    };
+
+    // Cell of the queue, whose sequence number tells whether it is free for
+    // the producer of index sequence or holds the message of index sequence - 1
+    class Cell
+    {
+    public:
+        std::atomic<size_t> sequence{0};
+        std::string message;  // keeps its capacity, so it is not reallocated
+        time_t timestamp{0};
+        int32_t severity{0};
+        bool force_flush{false};
+    };
+
+    void push(int32_t severity, bool force_flush, time_t timestamp, const char* message, int message_len);
+    void write_fatal(int32_t severity, bool force_flush, time_t timestamp, const char* message, int message_len);
+    bool drain();          // requires d_write_mutex
+    void flush_loggers();  // requires d_write_mutex
+    void run();
+
+    std::vector<google::base::Logger*> d_loggers;
+    std::vector<std::unique_ptr<Front_End>> d_front_ends;
+    std::unique_ptr<Cell[]> d_cells;
+    size_t d_mask;
+    alignas(64) std::atomic<size_t> d_enqueue_index{0};
+    alignas(64) size_t d_dequeue_index{0};
+    std::atomic<uint64_t> d_dropped{0};
+    uint64_t d_dropped_reported{0};
+    std::mutex d_write_mutex;  // the consumer side: writer thread, flush() and fatal messages
+    std::mutex d_wait_mutex;
+    std::condition_variable d_wake_up;
+    std::atomic<bool> d_writer_waiting{false};
+    std::atomic<bool> d_wake_pending{false};
+    std::atomic<bool> d_flush_requested{false};
+    std::atomic<bool> d_synchronous{false};
+    std::atomic<bool> d_running{true};
+    bool d_installed{false};
+    std::thread d_writer;
+};
+
+
+/*!
+ * \brief Lets a message through at most once every period, for all the
+ * threads that reach its call site
+ */
+class Gnss_Sdr_Log_Rate_Limit
+{
+public:
+    bool pass(int64_t period_ms)
+    {
+        const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t next_ms = d_next_ms.load(std::memory_order_relaxed);
+        return now_ms >= next_ms and d_next_ms.compare_exchange_strong(next_ms, now_ms + period_ms, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> d_next_ms{INT64_MIN};
+};
+
+
+// Each expansion defines a lambda of its own, whose static limit is shared
+// by all the calls of that site
+#define GNSS_SDR_LOG_RATE_LIMIT_SITE() ([]() -> Gnss_Sdr_Log_Rate_Limit& { static Gnss_Sdr_Log_Rate_Limit limit; return limit; }())
+
+/*!
+ * \brief LOG(severity), written at most once every period_ms milliseconds
+ * from this call site (the messages in between are not formatted)
+ */
+#define GNSS_SDR_LOG_EVERY_MS(severity, period_ms) LOG_IF(severity, GNSS_SDR_LOG_RATE_LIMIT_SITE().pass(period_ms))
+
+/*!
+ * \brief DLOG(severity), written at most once every period_ms milliseconds
+ * from this call site
+ */
+#define GNSS_SDR_DLOG_EVERY_MS(severity, period_ms) DLOG_IF(severity, GNSS_SDR_LOG_RATE_LIMIT_SITE().pass(period_ms))
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_ASYNC_LOG_H
@@ -0,0 +1,116 @@
+/*!
+ * \file gnss_sdr_block_stats.cc
+ * \brief Work time histograms of the signal processing blocks, enabled at
+ * run time
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_block_stats.h"
+#include <cmath>
+#include <limits>
+
+
+std::atomic<bool> Gnss_Block_Stats::d_enabled{false};
+
+
+double Gnss_Block_Stats::bucket_upper_bound_s(size_t b)
+{
+    if (b + 1 >= BUCKETS)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+    return std::ldexp(1e-6, static_cast<int>(b));
+}
+
+
+void Gnss_Block_Stats::record(uint64_t elapsed_ns)
+{
+    // bucket of the number of bits of the time in us: 0 for < 1 us
+    uint64_t us = elapsed_ns / 1000;
+    size_t b = 0;
+    while (us != 0 and b + 1 < BUCKETS)
+        {
+            us >>= 1;
+            b++;
+        }
+    d_buckets[b].fetch_add(1, std::memory_order_relaxed);
+    d_calls.fetch_add(1, std::memory_order_relaxed);
+    d_total_ns.fetch_add(elapsed_ns, std::memory_order_relaxed);
+    // only the block thread writes the maximum
+    if (elapsed_ns > d_max_ns.load(std::memory_order_relaxed))
+        {
+            d_max_ns.store(elapsed_ns, std::memory_order_relaxed);
+        }
+}
+
+
+Gnss_Block_Stats::Snapshot Gnss_Block_Stats::snapshot() const
+{
+    Snapshot s;
+    for (size_t b = 0; b < BUCKETS; b++)
+        {
+            s.buckets[b] = d_buckets[b].load(std::memory_order_relaxed);
+            s.calls += s.buckets[b];
+        }
+    s.total_ns = d_total_ns.load(std::memory_order_relaxed);
+    s.max_ns = d_max_ns.load(std::memory_order_relaxed);
+    return s;
+}
+
+
+double Gnss_Block_Stats::Snapshot::quantile_s(double q) const
+{
+    if (calls == 0)
+        {
+            return 0.0;
+        }
+    const auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(calls)));
+    uint64_t count = 0;
+    for (size_t b = 0; b < BUCKETS; b++)
+        {
+            count += buckets[b];
+            if (count >= rank and count > 0)
+                {
+                    // the last bucket has no upper bound: use the maximum
+                    return b + 1 < BUCKETS ? bucket_upper_bound_s(b) : static_cast<double>(max_ns) * 1e-9;
+                }
+        }
+    return static_cast<double>(max_ns) * 1e-9;
+}
+
+
+Gnss_Block_Stats_Registry& Gnss_Block_Stats_Registry::instance()
+{
+    static Gnss_Block_Stats_Registry registry;
+    return registry;
+}
+
+
+std::shared_ptr<Gnss_Block_Stats> Gnss_Block_Stats_Registry::make(long block_id)
+{
+    auto stats = std::make_shared<Gnss_Block_Stats>();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (auto it = d_stats.begin(); it != d_stats.end();)
+        {
+            it = it->second.expired() ? d_stats.erase(it) : std::next(it);
+        }
+    d_stats[block_id] = stats;
+    return stats;
+}
+
+
+std::shared_ptr<Gnss_Block_Stats> Gnss_Block_Stats_Registry::find(long block_id) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_stats.find(block_id);
+    return it == d_stats.end() ? nullptr : it->second.lock();
+}
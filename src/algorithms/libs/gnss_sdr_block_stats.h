@@ -0,0 +1,152 @@
+/*!
+ * \file gnss_sdr_block_stats.h
+ * \brief Work time histograms of the signal processing blocks, enabled at
+ * run time
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_BLOCK_STATS_H
+#define GNSS_SDR_GNSS_SDR_BLOCK_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Counters of the calls to the work function of a block, with a
+ * histogram of their durations.
+ *
+ * Bucket 0 counts the calls shorter than 1 us, bucket b the calls of
+ * [2^(b-1), 2^b) us, and the last bucket the longer ones. The counters are
+ * relaxed atomics, written by the block thread and read by any other.
+ */
+class Gnss_Block_Stats
+{
+public:
+    static constexpr size_t BUCKETS = 24;
+
+    class Snapshot
+    {
+    public:
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t calls{0};
+        uint64_t total_ns{0};
+        uint64_t max_ns{0};
+
+        /*!
+         * \brief Upper bound of the bucket of the given quantile (0 to 1)
+         * of the work times, in seconds.
+         */
+        double quantile_s(double q) const;
+    };
+
+    /*!
+     * \brief Upper bound of bucket b, in seconds (infinity for the last one)
+     */
+    static double bucket_upper_bound_s(size_t b);
+
+    /*!
+     * \brief The work timers only read the clock while this is true. False
+     * by default.
+     */
+    static bool enabled() { return d_enabled.load(std::memory_order_relaxed); }
+
+    static void set_enabled(bool enable) { d_enabled.store(enable, std::memory_order_relaxed); }
+
+    void record(uint64_t elapsed_ns);
+
+    Snapshot snapshot() const;
+
+private:
+    static std::atomic<bool> d_enabled;
+    std::array<std::atomic<uint64_t>, BUCKETS> d_buckets{};
+    std::atomic<uint64_t> d_calls{0};
+    std::atomic<uint64_t> d_total_ns{0};
+    std::atomic<uint64_t> d_max_ns{0};
+};
+
+
+/*!
+ * \brief Process-wide map from the unique_id() of the GNU Radio blocks to
+ * their Gnss_Block_Stats, so that the receiver can report them without
+ * knowing the type of each block.
+ */
+class Gnss_Block_Stats_Registry
+{
+public:
+    static Gnss_Block_Stats_Registry& instance();
+
+    /*!
+     * \brief Returns new stats for the block, owned by the block: the
+     * registry only keeps a weak reference.
+     */
+    std::shared_ptr<Gnss_Block_Stats> make(long block_id);
+
+    /*!
+     * \brief Returns the stats of the block, or nullptr if it has none.
+     */
+    std::shared_ptr<Gnss_Block_Stats> find(long block_id) const;
+
+private:
+    Gnss_Block_Stats_Registry() = default;
+    std::map<long, std::weak_ptr<Gnss_Block_Stats>> d_stats;
+    mutable std::mutex d_mutex;
+};
+
+
+/*!
+ * \brief Scoped timer of a call to a work function. When the stats are
+ * disabled it costs a relaxed load and a branch.
+ */
+class Gnss_Block_Work_Timer
+{
+public:
+    explicit Gnss_Block_Work_Timer(Gnss_Block_Stats* stats)
+        : d_stats(Gnss_Block_Stats::enabled() ? stats : nullptr)
+    {
+        if (d_stats != nullptr)
+            {
+                d_start = std::chrono::steady_clock::now();
+            }
+    }
+
+    ~Gnss_Block_Work_Timer()
+    {
+        if (d_stats != nullptr)
+            {
+                d_stats->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - d_start).count()));
+            }
+    }
+
+    Gnss_Block_Work_Timer(const Gnss_Block_Work_Timer&) = delete;
+    Gnss_Block_Work_Timer& operator=(const Gnss_Block_Work_Timer&) = delete;
+
+private:
+    Gnss_Block_Stats* d_stats;
+    std::chrono::steady_clock::time_point d_start;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_BLOCK_STATS_H
@@ -0,0 +1,102 @@
+/*!
+ * \file gnss_sdr_compute_backend.cc
+ * \brief Selection of the device (CPU, CUDA or OpenCL) that computes the
+ * acquisition searches and the tracking correlations
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_compute_backend.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::transform
+#include <cctype>     // for std::tolower
+#include <stdexcept>  // for std::invalid_argument
+
+
+Gnss_Compute_Backend compute_backend_from_string(const std::string& name)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "cpu")
+        {
+            return Gnss_Compute_Backend::CPU;
+        }
+    if (lower == "cuda")
+        {
+            return Gnss_Compute_Backend::CUDA;
+        }
+    if (lower == "opencl")
+        {
+            return Gnss_Compute_Backend::OpenCL;
+        }
+    throw std::invalid_argument("Unknown compute backend " + name);
+}
+
+
+std::string compute_backend_to_string(Gnss_Compute_Backend backend)
+{
+    switch (backend)
+        {
+        case Gnss_Compute_Backend::CUDA:
+            return "CUDA";
+        case Gnss_Compute_Backend::OpenCL:
+            return "OpenCL";
+        default:
+            return "CPU";
+        }
+}
+
+
+bool compute_backend_is_built(Gnss_Compute_Backend backend)
+{
+    switch (backend)
+        {
+        case Gnss_Compute_Backend::CUDA:
+#if CUDA_GPU_ACCEL
+            return true;
+#else
+            return false;
+#endif
+        case Gnss_Compute_Backend::OpenCL:
+#if OPENCL_GPU_ACCEL
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+        }
+}
+
+
+Gnss_Compute_Backend compute_backend_from_config(const ConfigurationInterface* configuration, const std::string& role)
+{
+    const bool use_cuda = configuration->property(role + ".use_cuda", false);
+    const std::string name = configuration->property(role + ".compute_backend", std::string(use_cuda ? "CUDA" : "CPU"));
+    Gnss_Compute_Backend backend = Gnss_Compute_Backend::CPU;
+    try
+        {
+            backend = compute_backend_from_string(name);
+        }
+    catch (const std::invalid_argument& e)
+        {
+            LOG(WARNING) << e.what() << " in " << role << ".compute_backend. Using the CPU";
+            return Gnss_Compute_Backend::CPU;
+        }
+    if (!compute_backend_is_built(backend))
+        {
+            LOG(WARNING) << role << ".compute_backend=" << name << " requires building GNSS-SDR with -DENABLE_"
+                         << (backend == Gnss_Compute_Backend::CUDA ? "CUDA" : "OPENCL") << "=ON. Using the CPU";
+            return Gnss_Compute_Backend::CPU;
+        }
+    return backend;
+}
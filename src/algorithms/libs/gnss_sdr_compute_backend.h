@@ -0,0 +1,60 @@
+/*!
+ * \file gnss_sdr_compute_backend.h
+ * \brief Selection of the device (CPU, CUDA or OpenCL) that computes the
+ * acquisition searches and the tracking correlations
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_COMPUTE_BACKEND_H
+#define GNSS_SDR_GNSS_SDR_COMPUTE_BACKEND_H
+
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class ConfigurationInterface;
+
+enum class Gnss_Compute_Backend
+{
+    CPU,
+    CUDA,
+    OpenCL
+};
+
+/*!
+ * \brief Returns the backend named "CPU", "CUDA" or "OpenCL" (case
+ * insensitive). Throws std::invalid_argument for other names.
+ */
+Gnss_Compute_Backend compute_backend_from_string(const std::string& name);
+
+std::string compute_backend_to_string(Gnss_Compute_Backend backend);
+
+/*!
+ * \brief Returns true if GNSS-SDR was built with support for the backend.
+ */
+bool compute_backend_is_built(Gnss_Compute_Backend backend);
+
+/*!
+ * \brief Reads the backend of a block from role.compute_backend. The former
+ * role.use_cuda=true is still accepted as compute_backend=CUDA. Unknown
+ * backends, and backends not built in, fall back to the CPU with a warning.
+ */
+Gnss_Compute_Backend compute_backend_from_config(const ConfigurationInterface* configuration, const std::string& role);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_COMPUTE_BACKEND_H
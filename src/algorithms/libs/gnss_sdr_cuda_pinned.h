@@ -0,0 +1,81 @@
+/*!
+ * \file gnss_sdr_cuda_pinned.h
+ * \brief Pinned host buffers of a CUDA device, allocated on the NUMA node
+ * the device is attached to. Only for CUDA sources.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_CUDA_PINNED_H
+#define GNSS_SDR_GNSS_SDR_CUDA_PINNED_H
+
+#include "gnss_sdr_numa.h"
+#include <cuda_runtime.h>
+#include <cstddef>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Returns the NUMA node of a CUDA device, or -1 if it is not known.
+ */
+inline int cuda_device_numa_node(int device)
+{
+    char bus_id[32] = {0};  // "0000:00:00.0"
+    if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) != cudaSuccess)
+        {
+            return -1;
+        }
+    return pci_device_numa_node(bus_id);
+}
+
+
+/*!
+ * \brief Replacement of cudaHostAlloc() with the pages on NUMA node node, so
+ * that the DMA transfers and the zero-copy accesses of a device do not cross
+ * the inter-socket link. flags are cudaHostRegister flags.
+ */
+inline cudaError_t cuda_numa_host_alloc(void** ptr, size_t bytes, int node, unsigned int flags)
+{
+    *ptr = numa_node_alloc(bytes, node);
+    if (*ptr == nullptr)
+        {
+            return cudaErrorMemoryAllocation;
+        }
+    const cudaError_t err = cudaHostRegister(*ptr, bytes, flags | cudaHostRegisterPortable);
+    if (err != cudaSuccess)
+        {
+            numa_node_free(*ptr);
+            *ptr = nullptr;
+        }
+    return err;
+}
+
+
+/*!
+ * \brief Releases a buffer returned by cuda_numa_host_alloc().
+ */
+inline void cuda_numa_host_free(void* ptr)
+{
+    if (ptr != nullptr)
+        {
+            cudaHostUnregister(ptr);
+            numa_node_free(ptr);
+        }
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_CUDA_PINNED_H
@@ -0,0 +1,86 @@
+/*!
+ * \file gnss_sdr_device_scheduler.cc
+ * \brief Distribution of the channels among the GPUs of the machine, by
+ * channel groups
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_device_scheduler.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::find, std::max
+#include <exception>
+#include <sstream>
+#include <string>
+
+
+Gnss_Device_Scheduler& Gnss_Device_Scheduler::instance()
+{
+    static Gnss_Device_Scheduler scheduler;
+    return scheduler;
+}
+
+
+void Gnss_Device_Scheduler::configure(const ConfigurationInterface* configuration, int total_channels)
+{
+    std::vector<int> devices;
+    std::stringstream list(configuration->property("GNSS-SDR.gpu_devices", std::string("0")));
+    std::string item;
+    while (std::getline(list, item, ','))
+        {
+            try
+                {
+                    const int device = std::stoi(item);
+                    if (device >= 0 and std::find(devices.begin(), devices.end(), device) == devices.end())
+                        {
+                            devices.push_back(device);
+                        }
+                }
+            catch (const std::exception&)
+                {
+                    LOG(WARNING) << "Invalid device " << item << " in GNSS-SDR.gpu_devices";
+                }
+        }
+    if (devices.empty())
+        {
+            devices.push_back(0);
+        }
+    const int num_devices = static_cast<int>(devices.size());
+    int channels_per_group = configuration->property("GNSS-SDR.gpu_channels_per_group", 0);
+    if (channels_per_group <= 0)
+        {
+            channels_per_group = std::max((total_channels + num_devices - 1) / num_devices, 1);
+        }
+
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    d_devices = devices;
+    d_channels_per_group = channels_per_group;
+    if (num_devices > 1)
+        {
+            LOG(INFO) << total_channels << " channels spread over " << num_devices << " GPUs in groups of " << channels_per_group << " channels";
+        }
+}
+
+
+int Gnss_Device_Scheduler::device(int channel) const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    const int group = std::max(channel, 0) / d_channels_per_group;
+    return d_devices[group % d_devices.size()];
+}
+
+
+std::vector<int> Gnss_Device_Scheduler::devices() const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    return d_devices;
+}
@@ -0,0 +1,77 @@
+/*!
+ * \file gnss_sdr_device_scheduler.h
+ * \brief Distribution of the channels among the GPUs of the machine, by
+ * channel groups
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_DEVICE_SCHEDULER_H
+#define GNSS_SDR_GNSS_SDR_DEVICE_SCHEDULER_H
+
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Assigns each channel to one of the GPUs listed in
+ * GNSS-SDR.gpu_devices (e.g. "0,1,2,3", only device 0 by default).
+ *
+ * Channels are assigned by groups of GNSS-SDR.gpu_channels_per_group
+ * consecutive channels, by default an even split of all the channels, so the
+ * channels of the same signal, which are numbered consecutively and read the
+ * same input, tend to share a device. The acquisition and tracking blocks
+ * query it when they learn their channel number, and batch their work with
+ * the other channels of their device. GNSSBlockFactory configures it when
+ * creating the channels.
+ */
+class Gnss_Device_Scheduler
+{
+public:
+    /*!
+     * \brief Returns the process-wide scheduler.
+     */
+    static Gnss_Device_Scheduler& instance();
+
+    /*!
+     * \brief Reads the device list and the group size for total_channels.
+     */
+    void configure(const ConfigurationInterface* configuration, int total_channels);
+
+    /*!
+     * \brief Returns the device of a channel.
+     */
+    int device(int channel) const;
+
+    /*!
+     * \brief Returns the devices in use.
+     */
+    std::vector<int> devices() const;
+
+private:
+    Gnss_Device_Scheduler() = default;
+
+    mutable std::mutex d_mutex;
+    std::vector<int> d_devices{0};
+    int d_channels_per_group{1};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_DEVICE_SCHEDULER_H
@@ -0,0 +1,223 @@
+/*!
+ * \file gnss_sdr_dump_writer.cc
+ * \brief Dump files of the processing blocks, written by a thread of their own
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_dump_writer.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+
+Gnss_Sdr_Dump_Stream::Gnss_Sdr_Dump_Stream(std::FILE* file, std::string file_name, size_t record_size, size_t capacity, Gnss_Sdr_Dump_Writer* writer)
+    : d_file_name(std::move(file_name)),
+      d_record_size(record_size),
+      d_mask(capacity - 1),
+      d_writer(writer),
+      d_file(file)
+{
+    d_ring = std::unique_ptr<char[]>(new char[capacity * record_size]);
+}
+
+
+Gnss_Sdr_Dump_Stream::~Gnss_Sdr_Dump_Stream()
+{
+    close();
+}
+
+
+void Gnss_Sdr_Dump_Stream::append(const void* record)
+{
+    const size_t head = d_head.load(std::memory_order_relaxed);
+    const size_t capacity = d_mask + 1;
+    if (head - d_tail.load(std::memory_order_acquire) == capacity)
+        {
+            d_stalls++;
+            while (head - d_tail.load(std::memory_order_acquire) == capacity)
+                {
+                    d_writer->wake_up();
+                    std::this_thread::yield();
+                }
+        }
+    std::memcpy(&d_ring[(head & d_mask) * d_record_size], record, d_record_size);
+    d_head.store(head + 1, std::memory_order_release);
+    if (head + 1 - d_tail.load(std::memory_order_relaxed) == capacity / 2)
+        {
+            d_writer->wake_up();
+        }
+}
+
+
+size_t Gnss_Sdr_Dump_Stream::drain()
+{
+    if (d_file == nullptr)
+        {
+            return 0;
+        }
+    const size_t tail = d_tail.load(std::memory_order_relaxed);
+    const size_t head = d_head.load(std::memory_order_acquire);
+    size_t index = tail;
+    while (index != head)
+        {
+            // up to the end of the ring, then from its start
+            const size_t first = index & d_mask;
+            const size_t count = std::min(head - index, d_mask + 1 - first);
+            const size_t written = std::fwrite(&d_ring[first * d_record_size], d_record_size, count, d_file);
+            d_bytes_written += written * d_record_size;
+            if (written != count)
+                {
+                    LOG(WARNING) << "Error writing the dump file " << d_file_name;
+                    index = head;  // the records are lost, but the block goes on
+                    break;
+                }
+            index += count;
+        }
+    d_tail.store(index, std::memory_order_release);
+    return index - tail;
+}
+
+
+uint64_t Gnss_Sdr_Dump_Stream::close()
+{
+    std::lock_guard<std::mutex> lock(d_file_mutex);
+    if (d_file != nullptr)
+        {
+            drain();
+            std::fclose(d_file);
+            d_file = nullptr;
+            d_writer->add_to_index(*this, d_bytes_written);
+            if (d_stalls != 0)
+                {
+                    LOG(INFO) << "The dump of " << d_file_name << " waited " << d_stalls << " times for the writer";
+                }
+        }
+    return d_bytes_written;
+}
+
+
+Gnss_Sdr_Dump_Writer& Gnss_Sdr_Dump_Writer::instance()
+{
+    static Gnss_Sdr_Dump_Writer writer;
+    return writer;
+}
+
+
+Gnss_Sdr_Dump_Writer::Gnss_Sdr_Dump_Writer()
+{
+    d_thread = std::thread(&Gnss_Sdr_Dump_Writer::run, this);
+}
+
+
+Gnss_Sdr_Dump_Writer::~Gnss_Sdr_Dump_Writer()
+{
+    d_running.store(false);
+    wake_up();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    flush();
+}
+
+
+std::shared_ptr<Gnss_Sdr_Dump_Stream> Gnss_Sdr_Dump_Writer::open(const std::string& file_name, size_t record_size, size_t ring_bytes)
+{
+    std::FILE* file = std::fopen(file_name.c_str(), "wb");
+    if (file == nullptr or record_size == 0)
+        {
+            if (file != nullptr)
+                {
+                    std::fclose(file);
+                }
+            return nullptr;
+        }
+    size_t capacity = 64;
+    while (capacity * record_size < ring_bytes)
+        {
+            capacity <<= 1U;
+        }
+    auto stream = std::make_shared<Gnss_Sdr_Dump_Stream>(file, file_name, record_size, capacity, this);
+    std::lock_guard<std::mutex> lock(d_streams_mutex);
+    d_streams.push_back(stream);
+    return stream;
+}
+
+
+void Gnss_Sdr_Dump_Writer::flush()
+{
+    std::vector<std::shared_ptr<Gnss_Sdr_Dump_Stream>> streams;
+    {
+        std::lock_guard<std::mutex> lock(d_streams_mutex);
+        for (auto it = d_streams.begin(); it != d_streams.end();)
+            {
+                auto stream = it->lock();
+                if (stream)
+                    {
+                        streams.push_back(std::move(stream));
+                        ++it;
+                    }
+                else
+                    {
+                        it = d_streams.erase(it);
+                    }
+            }
+    }
+    for (auto& stream : streams)
+        {
+            std::lock_guard<std::mutex> lock(stream->d_file_mutex);
+            stream->drain();
+        }
+}
+
+
+void Gnss_Sdr_Dump_Writer::wake_up()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_wait_mutex);
+        d_wake_pending = true;
+    }
+    d_wake_up.notify_one();
+}
+
+
+void Gnss_Sdr_Dump_Writer::add_to_index(const Gnss_Sdr_Dump_Stream& stream, uint64_t bytes)
+{
+    const std::string& file_name = stream.file_name();
+    const size_t separator = file_name.find_last_of('/');
+    const std::string index_name = (separator == std::string::npos ? std::string() : file_name.substr(0, separator + 1)) + "gnss_sdr_dump_index.csv";
+
+    std::lock_guard<std::mutex> lock(d_index_mutex);
+    std::FILE* index = std::fopen(index_name.c_str(), "a");
+    if (index == nullptr)
+        {
+            return;
+        }
+    std::fprintf(index, "%s,%zu,%llu\n", file_name.c_str(), stream.record_size(),
+        static_cast<unsigned long long>(bytes / stream.record_size()));
+    std::fclose(index);
+}
+
+
+void Gnss_Sdr_Dump_Writer::run()
+{
+    while (d_running.load())
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_wait_mutex);
+                d_wake_up.wait_for(lock, std::chrono::milliseconds(20), [this] { return d_wake_pending; });
+                d_wake_pending = false;
+            }
+            flush();
+        }
+}
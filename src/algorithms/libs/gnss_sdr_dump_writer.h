@@ -0,0 +1,165 @@
+/*!
+ * \file gnss_sdr_dump_writer.h
+ * \brief Dump files of the processing blocks, written by a thread of their own
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_DUMP_WRITER_H
+#define GNSS_SDR_GNSS_SDR_DUMP_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class Gnss_Sdr_Dump_Writer;
+
+
+/*!
+ * \brief Dump file of fixed size records, appended by a single block.
+ *
+ * append() only copies the record into a lock-free ring shared with the
+ * writer thread, which writes the records to the file. If the ring is full,
+ * append() waits for the writer, so that the dump is always complete.
+ */
+class Gnss_Sdr_Dump_Stream
+{
+public:
+    Gnss_Sdr_Dump_Stream(std::FILE* file, std::string file_name, size_t record_size, size_t capacity, Gnss_Sdr_Dump_Writer* writer);
+    ~Gnss_Sdr_Dump_Stream();
+
+    Gnss_Sdr_Dump_Stream(const Gnss_Sdr_Dump_Stream&) = delete;
+    Gnss_Sdr_Dump_Stream& operator=(const Gnss_Sdr_Dump_Stream&) = delete;
+
+    //! Queues record_size() bytes from record
+    void append(const void* record);
+
+    /*!
+     * \brief Writes the queued records from the calling thread and closes
+     * the file. Returns the size of the file in bytes.
+     */
+    uint64_t close();
+
+    const std::string& file_name() const { return d_file_name; }
+    size_t record_size() const { return d_record_size; }
+
+    //! Times that append() had to wait for the writer
+    uint64_t stalls() const { return d_stalls; }
+
+private:
+    friend class Gnss_Sdr_Dump_Writer;
+
+    size_t drain();  // requires d_file_mutex, returns the records written
+
+    std::unique_ptr<char[]> d_ring;
+    std::string d_file_name;
+    size_t d_record_size;
+    size_t d_mask;
+    Gnss_Sdr_Dump_Writer* d_writer;
+    alignas(64) std::atomic<size_t> d_head{0};  // written by the block
+    alignas(64) std::atomic<size_t> d_tail{0};  // written by the writer thread
+    std::mutex d_file_mutex;
+    std::FILE* d_file;  // nullptr once closed
+    uint64_t d_bytes_written{0};
+    uint64_t d_stalls{0};
+};
+
+
+/*!
+ * \brief Fixed size record, filled in order with the fields to dump
+ */
+template <size_t Size>
+class Gnss_Sdr_Dump_Record
+{
+public:
+    template <typename T>
+    Gnss_Sdr_Dump_Record& put(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are dumped");
+        std::memcpy(&d_data[d_size], &value, sizeof(T));
+        d_size += sizeof(T);
+        return *this;
+    }
+
+    const char* data() const { return d_data; }
+    size_t size() const { return d_size; }
+
+private:
+    char d_data[Size]{};
+    size_t d_size{0};
+};
+
+
+/*!
+ * \brief Writes the dump files of all the blocks from a single thread.
+ *
+ * The thread wakes up periodically, or when a ring is half full, and writes
+ * the queued records of each stream in large writes. Each closed stream is
+ * listed in the index file gnss_sdr_dump_index.csv of its directory, with its
+ * record size and number of records.
+ */
+class Gnss_Sdr_Dump_Writer
+{
+public:
+    //! Writer shared by all the blocks, started on first use
+    static Gnss_Sdr_Dump_Writer& instance();
+
+    Gnss_Sdr_Dump_Writer();
+    ~Gnss_Sdr_Dump_Writer();
+
+    Gnss_Sdr_Dump_Writer(const Gnss_Sdr_Dump_Writer&) = delete;
+    Gnss_Sdr_Dump_Writer& operator=(const Gnss_Sdr_Dump_Writer&) = delete;
+
+    /*!
+     * \brief Creates file_name for records of record_size bytes, with a ring
+     * of at least ring_bytes. Returns nullptr if the file cannot be created.
+     */
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> open(const std::string& file_name, size_t record_size, size_t ring_bytes = 1U << 20U);
+
+    //! Writes the queued records of all the streams, from the calling thread
+    void flush();
+
+private:
+    friend class Gnss_Sdr_Dump_Stream;
+
+    void wake_up();
+    void add_to_index(const Gnss_Sdr_Dump_Stream& stream, uint64_t bytes);
+    void run();
+
+    std::mutex d_streams_mutex;
+    std::vector<std::weak_ptr<Gnss_Sdr_Dump_Stream>> d_streams;
+    std::mutex d_index_mutex;
+    std::mutex d_wait_mutex;
+    std::condition_variable d_wake_up;
+    bool d_wake_pending{false};
+    std::atomic<bool> d_running{true};
+    std::thread d_thread;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_DUMP_WRITER_H
@@ -0,0 +1,115 @@
+/*!
+ * \file gnss_sdr_fft_pool.cc
+ * \brief Process-wide pool of FFT plans shared by all the processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft_pool.h"
+
+
+void Gnss_Fft_Plan_Pool::Fwd_Plan_Releaser::operator()(gnss_fft_complex_fwd* plan) const
+{
+    if (plan != nullptr)
+        {
+            Gnss_Fft_Plan_Pool::instance().give_back_fwd(d_fft_size, plan);
+        }
+}
+
+
+void Gnss_Fft_Plan_Pool::Rev_Plan_Releaser::operator()(gnss_fft_complex_rev* plan) const
+{
+    if (plan != nullptr)
+        {
+            Gnss_Fft_Plan_Pool::instance().give_back_rev(d_fft_size, plan);
+        }
+}
+
+
+Gnss_Fft_Plan_Pool& Gnss_Fft_Plan_Pool::instance()
+{
+    static Gnss_Fft_Plan_Pool pool;
+    return pool;
+}
+
+
+Gnss_Fft_Plan_Pool::fwd_lease Gnss_Fft_Plan_Pool::get_fwd(int fft_size)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto& idle = d_idle_fwd_plans[fft_size];
+        if (!idle.empty())
+            {
+                gnss_fft_complex_fwd* plan = idle.back().release();
+                idle.pop_back();
+                return fwd_lease(plan, Fwd_Plan_Releaser(fft_size));
+            }
+        d_created_plans++;
+    }
+    // Plan creation is slow, do it without holding the pool lock
+    auto plan = gnss_fft_fwd_make_unique(fft_size);
+    return fwd_lease(plan.release(), Fwd_Plan_Releaser(fft_size));
+}
+
+
+Gnss_Fft_Plan_Pool::rev_lease Gnss_Fft_Plan_Pool::get_rev(int fft_size)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto& idle = d_idle_rev_plans[fft_size];
+        if (!idle.empty())
+            {
+                gnss_fft_complex_rev* plan = idle.back().release();
+                idle.pop_back();
+                return rev_lease(plan, Rev_Plan_Releaser(fft_size));
+            }
+        d_created_plans++;
+    }
+    auto plan = gnss_fft_rev_make_unique(fft_size);
+    return rev_lease(plan.release(), Rev_Plan_Releaser(fft_size));
+}
+
+
+size_t Gnss_Fft_Plan_Pool::created_plans() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_created_plans;
+}
+
+
+void Gnss_Fft_Plan_Pool::release_idle_plans()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (const auto& idle : d_idle_fwd_plans)
+        {
+            d_created_plans -= idle.second.size();
+        }
+    for (const auto& idle : d_idle_rev_plans)
+        {
+            d_created_plans -= idle.second.size();
+        }
+    d_idle_fwd_plans.clear();
+    d_idle_rev_plans.clear();
+}
+
+
+void Gnss_Fft_Plan_Pool::give_back_fwd(int fft_size, gnss_fft_complex_fwd* plan)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_idle_fwd_plans[fft_size].emplace_back(plan);
+}
+
+
+void Gnss_Fft_Plan_Pool::give_back_rev(int fft_size, gnss_fft_complex_rev* plan)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_idle_rev_plans[fft_size].emplace_back(plan);
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file gnss_sdr_fft_pool.h
+ * \brief Process-wide pool of FFT plans shared by all the processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SDR_FFT_POOL_H
+#define GNSS_SDR_GNSS_SDR_FFT_POOL_H
+
+#include "gnss_sdr_fft.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Registry of FFT plans (and their input/output buffers) indexed by
+ * length.
+ *
+ * Plans are handed out as leases. While a lease is alive, the plan is for the
+ * exclusive use of its holder. When the lease goes out of scope, the plan goes
+ * back to the pool and can be reused by any other block asking for a transform
+ * of the same length. Hence, the number of plans held in memory is bounded by
+ * the number of transforms being computed concurrently, and not by the number
+ * of receiver channels.
+ */
+class Gnss_Fft_Plan_Pool
+{
+public:
+    class Fwd_Plan_Releaser
+    {
+    public:
+        explicit Fwd_Plan_Releaser(int fft_size = 0) : d_fft_size(fft_size) {}
+        void operator()(gnss_fft_complex_fwd* plan) const;
+
+    private:
+        int d_fft_size;
+    };
+
+    class Rev_Plan_Releaser
+    {
+    public:
+        explicit Rev_Plan_Releaser(int fft_size = 0) : d_fft_size(fft_size) {}
+        void operator()(gnss_fft_complex_rev* plan) const;
+
+    private:
+        int d_fft_size;
+    };
+
+    using fwd_lease = std::unique_ptr<gnss_fft_complex_fwd, Fwd_Plan_Releaser>;
+    using rev_lease = std::unique_ptr<gnss_fft_complex_rev, Rev_Plan_Releaser>;
+
+    /*!
+     * \brief Returns the process-wide pool.
+     */
+    static Gnss_Fft_Plan_Pool& instance();
+
+    /*!
+     * \brief Leases a forward FFT plan of length fft_size. A new plan is
+     * created only if all the existing plans of that length are in use.
+     */
+    fwd_lease get_fwd(int fft_size);
+
+    /*!
+     * \brief Leases a reverse FFT plan of length fft_size. A new plan is
+     * created only if all the existing plans of that length are in use.
+     */
+    rev_lease get_rev(int fft_size);
+
+    /*!
+     * \brief Number of plans created so far (leased or idle).
+     */
+    size_t created_plans() const;
+
+    /*!
+     * \brief Destroys all the idle plans.
+     */
+    void release_idle_plans();
+
+private:
+    Gnss_Fft_Plan_Pool() = default;
+
+    void give_back_fwd(int fft_size, gnss_fft_complex_fwd* plan);
+    void give_back_rev(int fft_size, gnss_fft_complex_rev* plan);
+
+    std::map<int, std::vector<std::unique_ptr<gnss_fft_complex_fwd>>> d_idle_fwd_plans;
+    std::map<int, std::vector<std::unique_ptr<gnss_fft_complex_rev>>> d_idle_rev_plans;
+    mutable std::mutex d_mutex;
+    size_t d_created_plans{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_FFT_POOL_H
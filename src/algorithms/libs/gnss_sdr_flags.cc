@@ -27,6 +27,12 @@ DEFINE_string(c, "-", "Path to the configuration file (if set, overrides --confi
 DEFINE_string(config_file, std::string(GNSSSDR_INSTALL_DIR "/share/gnss-sdr/conf/default.conf"),
     "Path to the configuration file.");
 
+DEFINE_string(config_cache, "",
+    "If defined, path to a binary cache of the parsed configuration file. It is read instead of the configuration file while the latter does not change, and rewritten otherwise.");
+
+DEFINE_string(config_files, "",
+    "If defined, comma-separated list of configuration files. The process hosts one receiver per file, sharing the FFT plans, code replicas, thread pools and navigation data among them.");
+
 DEFINE_string(s, "-",
     "If defined, path to the file containing the signal samples (overrides the configuration file and --signal_source).");
 
@@ -65,6 +71,10 @@ DEFINE_string(RINEX_name, "-", "If defined, specifies the RINEX files base name"
 
 DEFINE_bool(keyboard, true, "If set to false, it disables the keyboard listener (so the receiver cannot be stopped with q+[Enter])");
 
+DEFINE_bool(log_async, false, "If set to true, the log files are written by a thread of their own, so the processing threads do not wait for the file writes. Messages are dropped (and counted in the log) if more than --log_async_queue_size are pending.");
+
+DEFINE_int32(log_async_queue_size, 65536, "Maximum number of log messages waiting to be written when --log_async is set.");
+
 #if GFLAGS_GREATER_2_0
 
 static bool ValidateC(const char* flagname, const std::string& value)
@@ -219,6 +229,18 @@ static bool ValidateCarrierSmoothingFactor(const char* flagname, int32_t value)
     return false;
 }
 
+static bool ValidateLogAsyncQueueSize(const char* flagname, int32_t value)
+{
+    const int32_t min_value = 1;
+    if (value >= min_value)
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ": " << value << ". Allowed range is 1 <= " << flagname << ".\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
 
 DEFINE_validator(c, &ValidateC);
 DEFINE_validator(config_file, &ValidateConfigFile);
@@ -233,5 +255,6 @@ DEFINE_validator(carrier_lock_th, &ValidateCarrierLockTh);
 DEFINE_validator(dll_bw_hz, &ValidateDllBw);
 DEFINE_validator(pll_bw_hz, &ValidatePllBw);
 DEFINE_validator(carrier_smoothing_factor, &ValidateCarrierSmoothingFactor);
+DEFINE_validator(log_async_queue_size, &ValidateLogAsyncQueueSize);
 
 #endif
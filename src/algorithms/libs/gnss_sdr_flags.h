@@ -29,10 +29,14 @@
  * \{ */
 
 
-DECLARE_string(c);            //!< Path to the configuration file.
-DECLARE_string(config_file);  //!< Path to the configuration file.
+DECLARE_string(c);             //!< Path to the configuration file.
+DECLARE_string(config_file);   //!< Path to the configuration file.
+DECLARE_string(config_cache);  //!< If defined, path to the binary cache of the parsed configuration file.
+DECLARE_string(config_files);  //!< If defined, comma-separated list of configuration files, one per receiver hosted in the process.
 
-DECLARE_string(log_dir);  //!< Path to the folder in which logging will be stored.
+DECLARE_string(log_dir);              //!< Path to the folder in which logging will be stored.
+DECLARE_bool(log_async);              //!< If set, the log files are written by a thread of their own.
+DECLARE_int32(log_async_queue_size);  //!< Messages queued for the log writer thread.
 
 // Declare flags for signal sources
 DECLARE_string(s);                 //!< Path to the file containing the signal samples.
@@ -0,0 +1,123 @@
+/*!
+ * \file gnss_sdr_memory_accounting.cc
+ * \brief Accounting of the memory held by each subsystem of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_memory_accounting.h"
+#include <array>
+#include <atomic>
+
+namespace
+{
+constexpr auto num_subsystems = static_cast<size_t>(Gnss_Memory_Subsystem::COUNT);
+
+static_assert(num_subsystems <= volk_gnsssdr::alloc_accounting::max_tags, "Not enough allocation tags for the subsystems");
+
+std::array<std::atomic<int64_t>, num_subsystems>& gauges()
+{
+    static std::array<std::atomic<int64_t>, num_subsystems> g{};
+    return g;
+}
+
+
+bool starts_with(const std::string& role, const char* prefix)
+{
+    return role.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+}  // namespace
+
+
+Gnss_Memory_Accounting::Snapshot Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem subsystem)
+{
+    const auto tag = static_cast<unsigned char>(subsystem);
+    Snapshot s;
+    s.volk_bytes = volk_gnsssdr::alloc_accounting::bytes(tag);
+    s.volk_peak_bytes = volk_gnsssdr::alloc_accounting::peak_bytes(tag);
+    s.volk_blocks = volk_gnsssdr::alloc_accounting::blocks(tag);
+    if (tag < num_subsystems)
+        {
+            s.gauge_bytes = gauges()[tag].load(std::memory_order_relaxed);
+        }
+    return s;
+}
+
+
+const char* Gnss_Memory_Accounting::name(Gnss_Memory_Subsystem subsystem)
+{
+    switch (subsystem)
+        {
+        case Gnss_Memory_Subsystem::Signal_Source:
+            return "SignalSource";
+        case Gnss_Memory_Subsystem::Signal_Conditioner:
+            return "SignalConditioner";
+        case Gnss_Memory_Subsystem::Acquisition:
+            return "Acquisition";
+        case Gnss_Memory_Subsystem::Tracking:
+            return "Tracking";
+        case Gnss_Memory_Subsystem::Telemetry_Decoder:
+            return "TelemetryDecoder";
+        case Gnss_Memory_Subsystem::Observables:
+            return "Observables";
+        case Gnss_Memory_Subsystem::PVT:
+            return "PVT";
+        case Gnss_Memory_Subsystem::Printers:
+            return "Printers";
+        default:
+            return "Other";
+        }
+}
+
+
+Gnss_Memory_Subsystem Gnss_Memory_Accounting::subsystem_of_role(const std::string& role)
+{
+    if (starts_with(role, "SignalSource"))
+        {
+            return Gnss_Memory_Subsystem::Signal_Source;
+        }
+    if (starts_with(role, "SignalConditioner") or starts_with(role, "DataTypeAdapter") or
+        starts_with(role, "InputFilter") or starts_with(role, "Resampler"))
+        {
+            return Gnss_Memory_Subsystem::Signal_Conditioner;
+        }
+    if (starts_with(role, "Acquisition"))
+        {
+            return Gnss_Memory_Subsystem::Acquisition;
+        }
+    if (starts_with(role, "Tracking"))
+        {
+            return Gnss_Memory_Subsystem::Tracking;
+        }
+    if (starts_with(role, "TelemetryDecoder"))
+        {
+            return Gnss_Memory_Subsystem::Telemetry_Decoder;
+        }
+    if (starts_with(role, "Observables"))
+        {
+            return Gnss_Memory_Subsystem::Observables;
+        }
+    if (starts_with(role, "PVT"))
+        {
+            return Gnss_Memory_Subsystem::PVT;
+        }
+    return Gnss_Memory_Subsystem::Other;
+}
+
+
+void Gnss_Memory_Accounting::add_gauge_bytes(Gnss_Memory_Subsystem subsystem, int64_t bytes)
+{
+    const auto tag = static_cast<size_t>(subsystem);
+    if (tag < num_subsystems and bytes != 0)
+        {
+            gauges()[tag].fetch_add(bytes, std::memory_order_relaxed);
+        }
+}
@@ -0,0 +1,126 @@
+/*!
+ * \file gnss_sdr_memory_accounting.h
+ * \brief Accounting of the memory held by each subsystem of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_MEMORY_ACCOUNTING_H
+#define GNSS_SDR_GNSS_SDR_MEMORY_ACCOUNTING_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Subsystems to which the memory is charged. The values are the
+ * allocation tags of volk_gnsssdr::alloc.
+ */
+enum class Gnss_Memory_Subsystem : unsigned char
+{
+    Other = 0,
+    Signal_Source,
+    Signal_Conditioner,
+    Acquisition,
+    Tracking,
+    Telemetry_Decoder,
+    Observables,
+    PVT,
+    Printers,
+    COUNT
+};
+
+
+/*!
+ * \brief Memory held by each subsystem.
+ *
+ * Two sources are added up: the volk_gnsssdr::vector buffers, charged to
+ * the subsystem set on the allocating thread with Gnss_Memory_Tag_Scope,
+ * and the gauges of the containers that do not use volk_gnsssdr::alloc,
+ * which their owners keep up to date with Gnss_Memory_Gauge.
+ */
+class Gnss_Memory_Accounting
+{
+public:
+    class Snapshot
+    {
+    public:
+        int64_t volk_bytes{0};
+        int64_t volk_peak_bytes{0};
+        int64_t volk_blocks{0};
+        int64_t gauge_bytes{0};
+
+        int64_t bytes() const { return volk_bytes + gauge_bytes; }
+    };
+
+    static Snapshot snapshot(Gnss_Memory_Subsystem subsystem);
+    static const char* name(Gnss_Memory_Subsystem subsystem);
+
+    /*!
+     * \brief Subsystem of the block with the given configuration role,
+     * such as Acquisition_1C or SignalSource1
+     */
+    static Gnss_Memory_Subsystem subsystem_of_role(const std::string& role);
+
+    static void add_gauge_bytes(Gnss_Memory_Subsystem subsystem, int64_t bytes);
+};
+
+
+/*!
+ * \brief Charges the volk_gnsssdr::vector buffers allocated by the calling
+ * thread during its lifetime to the given subsystem
+ */
+class Gnss_Memory_Tag_Scope
+{
+public:
+    explicit Gnss_Memory_Tag_Scope(Gnss_Memory_Subsystem subsystem) : scope_(static_cast<unsigned char>(subsystem)) {}
+
+private:
+    volk_gnsssdr::alloc_tag_scope scope_;
+};
+
+
+/*!
+ * \brief Bytes held by a container of a subsystem that is not allocated by
+ * volk_gnsssdr::alloc. A copy starts at zero bytes.
+ */
+class Gnss_Memory_Gauge
+{
+public:
+    explicit Gnss_Memory_Gauge(Gnss_Memory_Subsystem subsystem) : subsystem_(subsystem) {}
+    ~Gnss_Memory_Gauge() { set(0); }
+
+    Gnss_Memory_Gauge(const Gnss_Memory_Gauge& other) : subsystem_(other.subsystem_) {}
+    Gnss_Memory_Gauge& operator=(const Gnss_Memory_Gauge&) { return *this; }
+
+    void set(size_t bytes)
+    {
+        const auto value = static_cast<int64_t>(bytes);
+        Gnss_Memory_Accounting::add_gauge_bytes(subsystem_, value - bytes_);
+        bytes_ = value;
+    }
+
+private:
+    Gnss_Memory_Subsystem subsystem_;
+    int64_t bytes_{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_MEMORY_ACCOUNTING_H
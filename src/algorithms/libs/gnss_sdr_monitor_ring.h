@@ -0,0 +1,362 @@
+/*!
+ * \file gnss_sdr_monitor_ring.h
+ * \brief Publish/subscribe ring of fixed-size monitoring records in POSIX
+ * shared memory, with a minimal C API for local consumers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*
+ * This header is self-contained and valid C99 and C++. The receiver publishes
+ * the records of a monitor (Monitor, AcquisitionMonitor, TrackingMonitor,
+ * NavDataMonitor or the PVT monitor configured with transport=shm) into a
+ * ring, and any number of processes on the same host read them without
+ * serialization and without a system call per record:
+ *
+ *   gnss_sdr_monitor_reader reader;
+ *   Gnss_Synchro record;
+ *   while (gnss_sdr_monitor_ring_attach(&reader, "/gnss-sdr-monitor",
+ *              GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(record)) != 0)
+ *       sleep(1);  // the receiver creates the ring when it starts
+ *   for (;;)
+ *       {
+ *           const int status = gnss_sdr_monitor_ring_read(&reader, &record);
+ *           if (status > 0)
+ *               use(&record);
+ *           else if (status == 0)
+ *               gnss_sdr_monitor_ring_wait(&reader, 100);
+ *           else
+ *               break;  // the receiver has stopped: close and attach again
+ *       }
+ *   gnss_sdr_monitor_ring_close(&reader.ring);
+ *
+ * The records are the same objects that the UDP monitors serialize: a
+ * Gnss_Synchro (src/core/system_parameters/gnss_synchro.h), a Channel_Stats
+ * (src/core/monitor/channel_stats.h), a Monitor_Pvt
+ * (src/algorithms/PVT/libs/monitor_pvt.h) or the gnss_sdr_nav_message_record
+ * below, copied byte by byte. Their layout is checked with the record size,
+ * so readers must be built for the same platform as the receiver.
+ *
+ * The receiver never waits for the readers. Each reader keeps its own
+ * position, starting with the records published after it attaches; if it
+ * falls more than the capacity of the ring behind, the records it missed are
+ * counted in its lost counter. Each slot has a sequence number that is odd
+ * while the receiver writes it, so a reader detects and skips a record that
+ * was overwritten while it was being copied.
+ */
+
+#ifndef GNSS_SDR_MONITOR_RING_H
+#define GNSS_SDR_MONITOR_RING_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+#define GNSS_SDR_MONITOR_RING_MAGIC 0x524D4E47u /* "GNMR" */
+#define GNSS_SDR_MONITOR_RING_VERSION 1u
+
+/* Types of record */
+#define GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO 1u
+#define GNSS_SDR_MONITOR_RECORD_MONITOR_PVT 2u
+#define GNSS_SDR_MONITOR_RECORD_NAV_MESSAGE 3u
+#define GNSS_SDR_MONITOR_RECORD_CHANNEL_STATS 4u
+
+#define GNSS_SDR_NAV_MESSAGE_RECORD_MAX_LENGTH 1024
+
+
+/*! Fixed-layout copy of a Nav_Message_Packet */
+typedef struct gnss_sdr_nav_message_record
+{
+    char system;    /* "G", "R", "S", "E" or "C" */
+    char signal[3]; /* "1C", "1B", ..., null-terminated */
+    int32_t prn;
+    int32_t tow_at_current_symbol_ms;
+    uint32_t length; /* characters of nav_message, truncated to the maximum */
+    char nav_message[GNSS_SDR_NAV_MESSAGE_RECORD_MAX_LENGTH];
+} gnss_sdr_nav_message_record;
+
+
+/*! Control block at the beginning of the shared memory segment */
+typedef struct gnss_sdr_monitor_ring_header
+{
+    /* written once by the receiver when it creates the ring */
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_type;
+    uint32_t record_size;
+    uint32_t slot_size; /* sequence number and record, a multiple of 64 bytes */
+    uint32_t capacity;  /* slots, a power of two */
+    uint32_t closed;    /* set when the receiver stops publishing */
+    uint8_t pad0[36];
+
+    /* written by the receiver on every record */
+    uint64_t write_index;      /* records published */
+    uint32_t write_seq;        /* futex word, changes on every record */
+    uint32_t readers_waiting;  /* incremented by each sleeping reader */
+    uint8_t pad1[48];
+} gnss_sdr_monitor_ring_header;
+
+
+/*! The ring, as mapped by the calling process */
+typedef struct gnss_sdr_monitor_ring
+{
+    gnss_sdr_monitor_ring_header *header;
+    uint8_t *slots;
+    size_t map_size;
+    int fd;
+} gnss_sdr_monitor_ring;
+
+
+/*! A reader of the ring, with its own position */
+typedef struct gnss_sdr_monitor_reader
+{
+    gnss_sdr_monitor_ring ring;
+    uint64_t next; /* index of the next record to read */
+    uint64_t lost; /* records overwritten before this reader could read them */
+} gnss_sdr_monitor_reader;
+
+
+/*!
+ * Creates (or recreates) the ring. Used by the receiver. The capacity, in
+ * records, is rounded up to a power of two. Returns 0 on success, -1 on
+ * error (see errno).
+ */
+static inline int gnss_sdr_monitor_ring_create(gnss_sdr_monitor_ring *ring, const char *name,
+    uint32_t record_type, uint32_t record_size, uint32_t capacity)
+{
+    const uint32_t slot_size = (uint32_t)((sizeof(uint64_t) + record_size + 63u) & ~(size_t)63u);
+    uint32_t slots = 1;
+    void *base;
+    int fd;
+    while (slots < capacity)
+        {
+            slots <<= 1;
+        }
+    ring->map_size = sizeof(gnss_sdr_monitor_ring_header) + (size_t)slots * slot_size;
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        {
+            return -1;
+        }
+    if (ftruncate(fd, (off_t)ring->map_size) != 0)
+        {
+            close(fd);
+            shm_unlink(name);
+            return -1;
+        }
+    base = mmap(NULL, ring->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+        {
+            close(fd);
+            shm_unlink(name);
+            return -1;
+        }
+    ring->header = (gnss_sdr_monitor_ring_header *)base;
+    ring->slots = (uint8_t *)base + sizeof(gnss_sdr_monitor_ring_header);
+    ring->fd = fd;
+    memset(base, 0, ring->map_size);
+    ring->header->version = GNSS_SDR_MONITOR_RING_VERSION;
+    ring->header->record_type = record_type;
+    ring->header->record_size = record_size;
+    ring->header->slot_size = slot_size;
+    ring->header->capacity = slots;
+    /* readers only attach once they see the magic */
+    __atomic_store_n(&ring->header->magic, GNSS_SDR_MONITOR_RING_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+
+/*! Receiver: copies a record into the next slot and wakes up the sleeping readers */
+static inline void gnss_sdr_monitor_ring_publish(gnss_sdr_monitor_ring *ring, const void *record)
+{
+    gnss_sdr_monitor_ring_header *header = ring->header;
+    const uint64_t index = header->write_index;
+    uint8_t *slot = ring->slots + (size_t)(index & (header->capacity - 1)) * header->slot_size;
+    uint64_t *sequence = (uint64_t *)slot;
+    __atomic_store_n(sequence, 2 * index + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(slot + sizeof(uint64_t), record, header->record_size);
+    __atomic_store_n(sequence, 2 * index + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->write_index, index + 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&header->write_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&header->readers_waiting, __ATOMIC_SEQ_CST) != 0)
+        {
+#if defined(__linux__)
+            syscall(SYS_futex, &header->write_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+        }
+}
+
+
+/*! Receiver: tells the readers that no more records will be published */
+static inline void gnss_sdr_monitor_ring_shutdown(gnss_sdr_monitor_ring *ring)
+{
+    __atomic_store_n(&ring->header->closed, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&ring->header->write_seq, 1, __ATOMIC_SEQ_CST);
+#if defined(__linux__)
+    syscall(SYS_futex, &ring->header->write_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+
+/*!
+ * Attaches to a ring created by the receiver. Used by readers. Returns 0 on
+ * success, -1 if the ring does not exist (yet), or if it does not hold
+ * records of the given type and size.
+ */
+static inline int gnss_sdr_monitor_ring_attach(gnss_sdr_monitor_reader *reader, const char *name,
+    uint32_t record_type, uint32_t record_size)
+{
+    gnss_sdr_monitor_ring_header *header;
+    struct stat status;
+    size_t map_size;
+    void *base;
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        {
+            return -1;
+        }
+    if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(gnss_sdr_monitor_ring_header))
+        {
+            close(fd);
+            errno = EAGAIN;
+            return -1;
+        }
+    map_size = (size_t)status.st_size;
+    base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+        {
+            close(fd);
+            return -1;
+        }
+    header = (gnss_sdr_monitor_ring_header *)base;
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != GNSS_SDR_MONITOR_RING_MAGIC ||
+        header->version != GNSS_SDR_MONITOR_RING_VERSION || header->record_type != record_type ||
+        header->record_size != record_size ||
+        map_size < sizeof(gnss_sdr_monitor_ring_header) + (size_t)header->capacity * header->slot_size)
+        {
+            munmap(base, map_size);
+            close(fd);
+            errno = EINVAL;
+            return -1;
+        }
+    reader->ring.header = header;
+    reader->ring.slots = (uint8_t *)base + sizeof(gnss_sdr_monitor_ring_header);
+    reader->ring.map_size = map_size;
+    reader->ring.fd = fd;
+    reader->next = __atomic_load_n(&header->write_index, __ATOMIC_ACQUIRE);
+    reader->lost = 0;
+    return 0;
+}
+
+
+/*! Unmaps the ring. The receiver also removes it with shm_unlink() */
+static inline void gnss_sdr_monitor_ring_close(gnss_sdr_monitor_ring *ring)
+{
+    if (ring->header != NULL)
+        {
+            munmap(ring->header, ring->map_size);
+            close(ring->fd);
+            ring->header = NULL;
+            ring->slots = NULL;
+        }
+}
+
+
+/*!
+ * Reader: copies the next record. Returns 1 if there was one, 0 if there is
+ * nothing new, -1 if the receiver has stopped publishing into this ring.
+ */
+static inline int gnss_sdr_monitor_ring_read(gnss_sdr_monitor_reader *reader, void *record)
+{
+    const gnss_sdr_monitor_ring_header *header = reader->ring.header;
+    for (;;)
+        {
+            const uint64_t written = __atomic_load_n(&header->write_index, __ATOMIC_ACQUIRE);
+            const uint8_t *slot;
+            uint64_t before;
+            uint64_t after;
+            if (reader->next == written)
+                {
+                    return __atomic_load_n(&header->closed, __ATOMIC_ACQUIRE) != 0 ? -1 : 0;
+                }
+            if (written - reader->next > header->capacity)
+                {
+                    reader->lost += written - reader->next - header->capacity;
+                    reader->next = written - header->capacity;
+                }
+            slot = reader->ring.slots + (size_t)(reader->next & (header->capacity - 1)) * header->slot_size;
+            before = __atomic_load_n((const uint64_t *)slot, __ATOMIC_ACQUIRE);
+            if (before == 2 * reader->next + 2)
+                {
+                    memcpy(record, slot + sizeof(uint64_t), header->record_size);
+                    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                    after = __atomic_load_n((const uint64_t *)slot, __ATOMIC_RELAXED);
+                    if (after == before)
+                        {
+                            reader->next++;
+                            return 1;
+                        }
+                }
+            /* overwritten by a newer record */
+            reader->lost++;
+            reader->next++;
+        }
+}
+
+
+/*! Reader: sleeps until there is a new record, or the timeout expires */
+static inline void gnss_sdr_monitor_ring_wait(gnss_sdr_monitor_reader *reader, int timeout_ms)
+{
+    gnss_sdr_monitor_ring_header *header = reader->ring.header;
+    struct timespec timeout;
+    uint32_t seq;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+    __atomic_add_fetch(&header->readers_waiting, 1, __ATOMIC_SEQ_CST);
+    seq = __atomic_load_n(&header->write_seq, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&header->write_index, __ATOMIC_ACQUIRE) == reader->next &&
+        __atomic_load_n(&header->closed, __ATOMIC_ACQUIRE) == 0)
+        {
+#if defined(__linux__)
+            syscall(SYS_futex, &header->write_seq, FUTEX_WAIT, seq, &timeout, NULL, 0);
+#else
+            (void)seq;
+            timeout.tv_sec = 0;
+            timeout.tv_nsec = 1000000L; /* no futex: poll every millisecond */
+            nanosleep(&timeout, NULL);
+#endif
+        }
+    __atomic_sub_fetch(&header->readers_waiting, 1, __ATOMIC_SEQ_CST);
+}
+
+
+/** \} */
+/** \} */
+#endif /* GNSS_SDR_MONITOR_RING_H */
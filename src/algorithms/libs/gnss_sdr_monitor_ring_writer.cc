@@ -0,0 +1,46 @@
+/*!
+ * \file gnss_sdr_monitor_ring_writer.cc
+ * \brief Owner of a shared memory ring of monitoring records, as created by
+ * the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_monitor_ring_writer.h"
+#include <glog/logging.h>
+#include <cerrno>   // for errno
+#include <cstring>  // for strerror
+
+
+Gnss_Monitor_Ring_Writer::Gnss_Monitor_Ring_Writer(const std::string& name,
+    uint32_t record_type,
+    uint32_t record_size,
+    uint32_t capacity) : d_name(name)
+{
+    if (gnss_sdr_monitor_ring_create(&d_ring, name.c_str(), record_type, record_size, capacity) != 0)
+        {
+            LOG(WARNING) << "Cannot create the shared memory " << name << " for the monitor: " << std::strerror(errno);
+            d_ring.header = nullptr;
+            return;
+        }
+    LOG(INFO) << "Publishing monitoring records in the shared memory " << name << " (" << d_ring.header->capacity << " records)";
+}
+
+
+Gnss_Monitor_Ring_Writer::~Gnss_Monitor_Ring_Writer()
+{
+    if (d_ring.header != nullptr)
+        {
+            gnss_sdr_monitor_ring_shutdown(&d_ring);
+            gnss_sdr_monitor_ring_close(&d_ring);
+            shm_unlink(d_name.c_str());
+        }
+}
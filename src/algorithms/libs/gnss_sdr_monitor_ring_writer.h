@@ -0,0 +1,68 @@
+/*!
+ * \file gnss_sdr_monitor_ring_writer.h
+ * \brief Owner of a shared memory ring of monitoring records, as created by
+ * the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SDR_MONITOR_RING_WRITER_H
+#define GNSS_SDR_GNSS_SDR_MONITOR_RING_WRITER_H
+
+#include "gnss_sdr_monitor_ring.h"
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Creates the ring of a monitor in shared memory (see
+ * gnss_sdr_monitor_ring.h), publishes records into it, and removes it when
+ * destroyed. If the ring cannot be created, a warning is logged and the
+ * records are discarded.
+ */
+class Gnss_Monitor_Ring_Writer
+{
+public:
+    Gnss_Monitor_Ring_Writer(const std::string& name, uint32_t record_type, uint32_t record_size, uint32_t capacity = 4096);
+    ~Gnss_Monitor_Ring_Writer();
+
+    Gnss_Monitor_Ring_Writer(const Gnss_Monitor_Ring_Writer&) = delete;
+    Gnss_Monitor_Ring_Writer& operator=(const Gnss_Monitor_Ring_Writer&) = delete;
+
+    bool is_open() const { return d_ring.header != nullptr; }
+
+    /*!
+     * \brief Copies the record_size bytes at record into the ring. Never
+     * blocks and never makes a system call unless a reader is sleeping.
+     */
+    void publish(const void* record)
+    {
+        if (d_ring.header != nullptr)
+            {
+                gnss_sdr_monitor_ring_publish(&d_ring, record);
+            }
+    }
+
+private:
+    gnss_sdr_monitor_ring d_ring{};
+    std::string d_name;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_MONITOR_RING_WRITER_H
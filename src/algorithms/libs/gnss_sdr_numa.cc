@@ -0,0 +1,119 @@
+/*!
+ * \file gnss_sdr_numa.cc
+ * \brief Host memory allocated on a given NUMA node, for the buffers that an
+ * accelerator reads or writes over the bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_numa.h"
+#include <sys/mman.h>
+#include <algorithm>  // for std::transform
+#include <cctype>     // for std::tolower
+#include <cstring>    // for memset
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <vector>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+std::mutex& allocations_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+std::map<void*, size_t>& allocations()
+{
+    static std::map<void*, size_t> sizes;
+    return sizes;
+}
+
+#if defined(__linux__)
+// Sets a preferred node for the pages of a range, without requiring libnuma
+void prefer_node(void* ptr, size_t bytes, int node)
+{
+    const int MPOL_PREFERRED_MODE = 1;  // MPOL_PREFERRED in <numaif.h>
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / bits_per_word + 1, 0UL);
+    mask[node / bits_per_word] = 1UL << (node % bits_per_word);
+    // Failures (e.g. kernels without NUMA) leave the default policy
+    syscall(SYS_mbind, ptr, bytes, MPOL_PREFERRED_MODE, mask.data(), mask.size() * bits_per_word + 1, 0);
+}
+#endif
+}  // namespace
+
+
+int pci_device_numa_node(const std::string& pci_bus_id)
+{
+    std::string id(pci_bus_id);
+    std::transform(id.begin(), id.end(), id.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    std::ifstream numa_node_file("/sys/bus/pci/devices/" + id + "/numa_node");
+    int node = -1;
+    if (!numa_node_file.is_open() or !(numa_node_file >> node))
+        {
+            return -1;
+        }
+    return node;  // -1 in machines with a single node
+}
+
+
+void* numa_node_alloc(size_t bytes, int node)
+{
+    if (bytes == 0)
+        {
+            return nullptr;
+        }
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        {
+            return nullptr;
+        }
+#if defined(__linux__)
+    if (node >= 0)
+        {
+            prefer_node(ptr, bytes, node);
+        }
+#else
+    (void)node;
+#endif
+    std::memset(ptr, 0, bytes);  // first touch, under the policy above
+    const std::lock_guard<std::mutex> lock(allocations_mutex());
+    allocations()[ptr] = bytes;
+    return ptr;
+}
+
+
+void numa_node_free(void* ptr)
+{
+    if (ptr == nullptr)
+        {
+            return;
+        }
+    size_t bytes = 0;
+    {
+        const std::lock_guard<std::mutex> lock(allocations_mutex());
+        auto it = allocations().find(ptr);
+        if (it == allocations().end())
+            {
+                return;
+            }
+        bytes = it->second;
+        allocations().erase(it);
+    }
+    munmap(ptr, bytes);
+}
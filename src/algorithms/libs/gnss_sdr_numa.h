@@ -0,0 +1,52 @@
+/*!
+ * \file gnss_sdr_numa.h
+ * \brief Host memory allocated on a given NUMA node, for the buffers that an
+ * accelerator reads or writes over the bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_NUMA_H
+#define GNSS_SDR_GNSS_SDR_NUMA_H
+
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Returns the NUMA node of a PCI device given its bus id (e.g.
+ * "0000:3b:00.0", as returned by cudaDeviceGetPCIBusId()), or -1 if it is
+ * not known.
+ */
+int pci_device_numa_node(const std::string& pci_bus_id);
+
+/*!
+ * \brief Allocates page-aligned memory whose pages are placed on NUMA node
+ * node (preferred, not enforced), or anywhere if node < 0 or on systems
+ * without NUMA support. The pages are touched before returning, so they can
+ * be pinned right away. Returns nullptr on failure.
+ */
+void* numa_node_alloc(size_t bytes, int node);
+
+/*!
+ * \brief Releases memory returned by numa_node_alloc().
+ */
+void numa_node_free(void* ptr);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_NUMA_H
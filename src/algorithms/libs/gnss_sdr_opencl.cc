@@ -0,0 +1,145 @@
+/*!
+ * \file gnss_sdr_opencl.cc
+ * \brief OpenCL device, context and program building shared by the OpenCL
+ * acquisition and tracking engines
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_opencl.h"
+#include <glog/logging.h>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+std::vector<cl_device_id> get_devices(cl_device_type type)
+{
+    std::vector<cl_device_id> devices;
+    cl_uint num_platforms = 0;
+    if (clGetPlatformIDs(0, nullptr, &num_platforms) != CL_SUCCESS or num_platforms == 0)
+        {
+            return devices;
+        }
+    std::vector<cl_platform_id> platforms(num_platforms);
+    clGetPlatformIDs(num_platforms, platforms.data(), nullptr);
+    for (auto* platform : platforms)
+        {
+            cl_uint num_devices = 0;
+            if (clGetDeviceIDs(platform, type, 0, nullptr, &num_devices) != CL_SUCCESS or num_devices == 0)
+                {
+                    continue;
+                }
+            std::vector<cl_device_id> platform_devices(num_devices);
+            clGetDeviceIDs(platform, type, num_devices, platform_devices.data(), nullptr);
+            devices.insert(devices.end(), platform_devices.begin(), platform_devices.end());
+        }
+    return devices;
+}
+}  // namespace
+
+
+void check_opencl(cl_int code, const char* what)
+{
+    if (code != CL_SUCCESS)
+        {
+            throw std::runtime_error(std::string("OpenCL error ") + std::to_string(code) + " in " + what);
+        }
+}
+
+
+std::shared_ptr<Gnss_Opencl_Context> Gnss_Opencl_Context::get()
+{
+    static std::mutex context_mutex;
+    static std::weak_ptr<Gnss_Opencl_Context> shared_context;
+
+    const std::lock_guard<std::mutex> lock(context_mutex);
+    std::shared_ptr<Gnss_Opencl_Context> context = shared_context.lock();
+    if (!context)
+        {
+            context = std::shared_ptr<Gnss_Opencl_Context>(new Gnss_Opencl_Context());
+            shared_context = context;
+        }
+    return context;
+}
+
+
+bool Gnss_Opencl_Context::is_available()
+{
+    return !get_devices(CL_DEVICE_TYPE_ALL).empty();
+}
+
+
+Gnss_Opencl_Context::Gnss_Opencl_Context()
+{
+    std::vector<cl_device_id> devices = get_devices(CL_DEVICE_TYPE_GPU);
+    if (devices.empty())
+        {
+            devices = get_devices(CL_DEVICE_TYPE_ALL);
+        }
+    if (devices.empty())
+        {
+            throw std::runtime_error("No OpenCL device found");
+        }
+    d_device = devices[0];
+
+    size_t name_size = 0;
+    clGetDeviceInfo(d_device, CL_DEVICE_NAME, 0, nullptr, &name_size);
+    std::vector<char> name(name_size + 1, '\0');
+    clGetDeviceInfo(d_device, CL_DEVICE_NAME, name_size, name.data(), nullptr);
+    d_device_name = name.data();
+
+    cl_int err = CL_SUCCESS;
+    d_context = clCreateContext(nullptr, 1, &d_device, nullptr, nullptr, &err);
+    check_opencl(err, "clCreateContext");
+    LOG(INFO) << "Using the OpenCL device " << d_device_name;
+}
+
+
+Gnss_Opencl_Context::~Gnss_Opencl_Context()
+{
+    if (d_context != nullptr)
+        {
+            clReleaseContext(d_context);
+        }
+}
+
+
+cl_command_queue Gnss_Opencl_Context::create_queue() const
+{
+    cl_int err = CL_SUCCESS;
+    cl_command_queue queue = clCreateCommandQueue(d_context, d_device, 0, &err);
+    check_opencl(err, "clCreateCommandQueue");
+    return queue;
+}
+
+
+cl_program Gnss_Opencl_Context::build_program(const std::string& source) const
+{
+    cl_int err = CL_SUCCESS;
+    const char* text = source.c_str();
+    const size_t length = source.size();
+    cl_program program = clCreateProgramWithSource(d_context, 1, &text, &length, &err);
+    check_opencl(err, "clCreateProgramWithSource");
+    err = clBuildProgram(program, 1, &d_device, nullptr, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+        {
+            size_t log_size = 0;
+            clGetProgramBuildInfo(program, d_device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+            std::vector<char> log(log_size + 1, '\0');
+            clGetProgramBuildInfo(program, d_device, CL_PROGRAM_BUILD_LOG, log_size, log.data(), nullptr);
+            clReleaseProgram(program);
+            throw std::runtime_error(std::string("OpenCL program build failed: ") + log.data());
+        }
+    return program;
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file gnss_sdr_opencl.h
+ * \brief OpenCL device, context and program building shared by the OpenCL
+ * acquisition and tracking engines
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_OPENCL_H
+#define GNSS_SDR_GNSS_SDR_OPENCL_H
+
+#ifndef CL_TARGET_OPENCL_VERSION
+#define CL_TARGET_OPENCL_VERSION 120
+#endif
+#ifdef __APPLE__
+#define CL_SILENCE_DEPRECATION
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+#include <memory>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Throws std::runtime_error if code is not CL_SUCCESS.
+ */
+void check_opencl(cl_int code, const char* what);
+
+
+/*!
+ * \brief OpenCL device and context of the receiver.
+ *
+ * The first GPU found in any platform is used, or else the first device of
+ * any type, so the same engines run on Intel, AMD and NVIDIA GPUs, and on
+ * CPUs and FPGAs with an OpenCL 1.2 driver. All the engines share the
+ * context, each one with its own command queues.
+ */
+class Gnss_Opencl_Context
+{
+public:
+    /*!
+     * \brief Returns the context of the receiver, creating it if required.
+     * Throws std::runtime_error if there is no OpenCL device.
+     */
+    static std::shared_ptr<Gnss_Opencl_Context> get();
+
+    /*!
+     * \brief Returns true if there is at least one OpenCL device.
+     */
+    static bool is_available();
+
+    ~Gnss_Opencl_Context();
+
+    Gnss_Opencl_Context(const Gnss_Opencl_Context&) = delete;
+    Gnss_Opencl_Context& operator=(const Gnss_Opencl_Context&) = delete;
+
+    cl_context context() const { return d_context; }
+    cl_device_id device() const { return d_device; }
+    const std::string& device_name() const { return d_device_name; }
+
+    /*!
+     * \brief Returns a new in-order command queue, to be released by the caller.
+     */
+    cl_command_queue create_queue() const;
+
+    /*!
+     * \brief Compiles the source for the device and returns the program, to be
+     * released by the caller. On errors, the exception carries the build log.
+     */
+    cl_program build_program(const std::string& source) const;
+
+private:
+    Gnss_Opencl_Context();
+
+    cl_context d_context{nullptr};
+    cl_device_id d_device{nullptr};
+    std::string d_device_name;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_OPENCL_H
@@ -0,0 +1,111 @@
+/*!
+ * \file gnss_sdr_resampling_ratio.cc
+ * \brief Choice of the interpolation and decimation factors of a rational
+ * resampler
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_resampling_ratio.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+uint64_t gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+        {
+            const uint64_t r = a % b;
+            a = b;
+            b = r;
+        }
+    return a;
+}
+}  // namespace
+
+
+Resampling_Ratio resampling_ratio(double fs_in, double fs_out, uint32_t max_interpolation)
+{
+    Resampling_Ratio ratio;
+    if (!(fs_in > 0.0) or !(fs_out > 0.0))
+        {
+            return ratio;
+        }
+    max_interpolation = std::max(max_interpolation, 1U);
+
+    // exact ratio of integer rates
+    if (std::floor(fs_in) == fs_in and std::floor(fs_out) == fs_out)
+        {
+            const auto in = static_cast<uint64_t>(fs_in);
+            const auto out = static_cast<uint64_t>(fs_out);
+            const uint64_t g = gcd(in, out);
+            if (out / g <= max_interpolation and in / g <= UINT32_MAX)
+                {
+                    ratio.interpolation = static_cast<uint32_t>(out / g);
+                    ratio.decimation = static_cast<uint32_t>(in / g);
+                    return ratio;
+                }
+        }
+
+    // closest approximation
+    double best_error = -1.0;
+    for (uint32_t l = 1; l <= max_interpolation; l++)
+        {
+            const double m = std::max(1.0, std::round(static_cast<double>(l) * fs_in / fs_out));
+            const double error = std::fabs(static_cast<double>(l) / m - fs_out / fs_in);
+            if (best_error < 0.0 or error < best_error)
+                {
+                    best_error = error;
+                    ratio.interpolation = l;
+                    ratio.decimation = static_cast<uint32_t>(m);
+                }
+        }
+    const auto g = static_cast<uint32_t>(gcd(ratio.interpolation, ratio.decimation));
+    ratio.interpolation /= g;
+    ratio.decimation /= g;
+    return ratio;
+}
+
+
+Resampling_Ratio acquisition_resampling_ratio(int64_t fs_in, double min_fs_out, uint32_t max_interpolation)
+{
+    Resampling_Ratio ratio;
+    if (fs_in <= 0 or !(min_fs_out > 0.0) or static_cast<double>(fs_in) <= min_fs_out)
+        {
+            return ratio;
+        }
+    max_interpolation = std::max(max_interpolation, 1U);
+
+    auto best_rate = static_cast<uint64_t>(fs_in);
+    for (uint64_t l = 1; l <= max_interpolation; l++)
+        {
+            const uint64_t upsampled = static_cast<uint64_t>(fs_in) * l;
+            // largest decimation that keeps the rate over min_fs_out, reduced
+            // until the output rate is an integer
+            for (auto m = static_cast<uint64_t>(std::floor(static_cast<double>(upsampled) / min_fs_out)); m > l; m--)
+                {
+                    if (upsampled % m == 0)
+                        {
+                            // ties are kept by the smallest interpolation factor
+                            if (upsampled / m < best_rate)
+                                {
+                                    best_rate = upsampled / m;
+                                    const uint64_t g = gcd(l, m);
+                                    ratio.interpolation = static_cast<uint32_t>(l / g);
+                                    ratio.decimation = static_cast<uint32_t>(m / g);
+                                }
+                            break;
+                        }
+                }
+        }
+    return ratio;
+}
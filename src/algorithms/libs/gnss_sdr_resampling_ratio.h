@@ -0,0 +1,62 @@
+/*!
+ * \file gnss_sdr_resampling_ratio.h
+ * \brief Choice of the interpolation and decimation factors of a rational
+ * resampler
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_RESAMPLING_RATIO_H
+#define GNSS_SDR_GNSS_SDR_RESAMPLING_RATIO_H
+
+#include <cstdint>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Output rate = input rate * interpolation / decimation, with both
+ * factors coprime.
+ */
+class Resampling_Ratio
+{
+public:
+    double output_rate(double fs_in) const
+    {
+        return fs_in * static_cast<double>(interpolation) / static_cast<double>(decimation);
+    }
+
+    uint32_t interpolation{1};
+    uint32_t decimation{1};
+};
+
+/*!
+ * \brief Returns the ratio fs_out / fs_in, or its closest approximation with
+ * an interpolation factor not greater than max_interpolation.
+ */
+Resampling_Ratio resampling_ratio(double fs_in, double fs_out, uint32_t max_interpolation);
+
+/*!
+ * \brief Returns the ratio that gives the lowest output rate, in an integer
+ * number of samples per second, not lower than min_fs_out, with an
+ * interpolation factor not greater than max_interpolation. With
+ * max_interpolation = 1 this is a decimation by the largest divisor of fs_in
+ * that fits. Returns 1 / 1 if there is no such rate below fs_in.
+ */
+Resampling_Ratio acquisition_resampling_ratio(int64_t fs_in, double min_fs_out, uint32_t max_interpolation);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_RESAMPLING_RATIO_H
@@ -0,0 +1,77 @@
+/*!
+ * \file gnss_sdr_sample_gap.h
+ * \brief Stream tags that mark the samples lost by a signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_GAP_H
+#define GNSS_SDR_GNSS_SDR_SAMPLE_GAP_H
+
+#include <gnuradio/tags.h>
+#include <pmt/pmt.h>
+#include <pmt/pmt_sugar.h>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*
+ * When a signal source loses samples (a device overflow, missing UDP
+ * packets...), it tags the first sample after the gap with the key
+ * "sample_gap" and, as value, the number of samples missing before it
+ * (a pmt uint64). The count is in samples of the tagged stream, so blocks
+ * that change the sample rate between the source and the channels must scale
+ * it.
+ *
+ * The sample counter and the tracking blocks add the missing samples to the
+ * Tracking_sample_counter of their outputs, so that it keeps counting the
+ * receiver time across the gap, and tracking advances its local replica over
+ * the gap instead of losing lock.
+ */
+
+//! Key of the stream tags that mark missing samples
+inline const pmt::pmt_t& sample_gap_key()
+{
+    static const pmt::pmt_t key = pmt::mp("sample_gap");
+    return key;
+}
+
+
+//! Value of a sample_gap tag
+inline pmt::pmt_t make_sample_gap(uint64_t missing_samples)
+{
+    return pmt::from_uint64(missing_samples);
+}
+
+
+//! Adds up the samples missing in a set of tags (only the sample_gap ones)
+inline uint64_t sample_gap_total(const std::vector<gr::tag_t>& tags)
+{
+    uint64_t missing_samples = 0;
+    for (const auto& tag : tags)
+        {
+            if (pmt::eqv(tag.key, sample_gap_key()) && pmt::is_uint64(tag.value))
+                {
+                    missing_samples += pmt::to_uint64(tag.value);
+                }
+        }
+    return missing_samples;
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_SAMPLE_GAP_H
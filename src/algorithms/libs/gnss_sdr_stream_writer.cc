@@ -0,0 +1,279 @@
+/*!
+ * \file gnss_sdr_stream_writer.cc
+ * \brief Non-blocking writes to serial ports and other byte streams, from a
+ * single thread shared by all the outputs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_stream_writer.h"
+#include <glog/logging.h>
+#include <fcntl.h>   // for fcntl, O_NONBLOCK
+#include <poll.h>    // for poll
+#include <unistd.h>  // for pipe, read, write, close
+#include <cerrno>    // for errno
+#include <chrono>
+#include <cstring>  // for strerror
+#include <vector>
+
+
+Gnss_Stream_Writer::Gnss_Stream_Writer()
+{
+    if (pipe(d_wake_pipe) == -1)
+        {
+            LOG(ERROR) << "Cannot create the pipe of the stream writer: " << std::strerror(errno);
+            d_wake_pipe[0] = -1;
+            d_wake_pipe[1] = -1;
+            return;
+        }
+    for (const int fd : d_wake_pipe)
+        {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    d_thread = std::thread(&Gnss_Stream_Writer::run, this);
+}
+
+
+Gnss_Stream_Writer::~Gnss_Stream_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    wake();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    for (const int fd : d_wake_pipe)
+        {
+            if (fd != -1)
+                {
+                    close(fd);
+                }
+        }
+}
+
+
+Gnss_Stream_Writer& Gnss_Stream_Writer::instance()
+{
+    static Gnss_Stream_Writer writer;
+    return writer;
+}
+
+
+bool Gnss_Stream_Writer::add(int fd, const std::string& name, size_t capacity, Drop_Policy policy)
+{
+    if (fd < 0 || !d_thread.joinable())
+        {
+            return false;
+        }
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+        {
+            LOG(WARNING) << "Cannot switch " << name << " to non-blocking writes: " << std::strerror(errno);
+            return false;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto inserted = d_streams.emplace(fd, Stream());
+    if (!inserted.second)
+        {
+            return false;
+        }
+    Stream& stream = inserted.first->second;
+    stream.name = name;
+    stream.capacity = capacity;
+    stream.policy = policy;
+    return true;
+}
+
+
+void Gnss_Stream_Writer::remove(int fd, int timeout_ms)
+{
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        if (d_streams.find(fd) == d_streams.end())
+            {
+                return;
+            }
+        d_drained.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this, fd] {
+            const auto it = d_streams.find(fd);
+            return it == d_streams.end() || it->second.messages.empty();
+        });
+        const auto it = d_streams.find(fd);
+        if (it == d_streams.end())
+            {
+                return;
+            }
+        if (!it->second.messages.empty())
+            {
+                LOG(WARNING) << it->second.name << ": " << it->second.pending << " bytes could not be written before closing";
+            }
+        d_streams.erase(it);
+    }
+    wake();  // stop polling fd before the caller closes it
+}
+
+
+bool Gnss_Stream_Writer::write(int fd, const void* data, size_t size)
+{
+    bool was_empty = false;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        const auto it = d_streams.find(fd);
+        if (it == d_streams.end())
+            {
+                return false;
+            }
+        Stream& stream = it->second;
+        if (stream.pending + size > stream.capacity && stream.policy == Drop_Policy::Oldest)
+            {
+                // the first message may be partially written, and must be completed
+                const size_t first = stream.offset > 0 ? 1 : 0;
+                uint64_t discarded = 0;
+                while (stream.pending + size > stream.capacity && stream.messages.size() > first)
+                    {
+                        stream.pending -= stream.messages[first].size();
+                        stream.messages.erase(stream.messages.begin() + static_cast<std::ptrdiff_t>(first));
+                        discarded++;
+                    }
+                if (discarded > 0)
+                    {
+                        count_drop(stream, discarded);
+                    }
+            }
+        if (stream.pending + size > stream.capacity)
+            {
+                count_drop(stream, 1);
+                return false;
+            }
+        was_empty = stream.messages.empty();
+        stream.messages.emplace_back(static_cast<const char*>(data), size);
+        stream.pending += size;
+    }
+    if (was_empty)
+        {
+            wake();
+        }
+    return true;
+}
+
+
+uint64_t Gnss_Stream_Writer::dropped(int fd) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_streams.find(fd);
+    return it == d_streams.end() ? 0 : it->second.dropped;
+}
+
+
+void Gnss_Stream_Writer::run()
+{
+    std::vector<pollfd> fds;
+    while (true)
+        {
+            fds.clear();
+            fds.push_back(pollfd{d_wake_pipe[0], POLLIN, 0});
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (d_stop)
+                    {
+                        return;
+                    }
+                for (const auto& stream : d_streams)
+                    {
+                        if (!stream.second.messages.empty())
+                            {
+                                fds.push_back(pollfd{stream.first, POLLOUT, 0});
+                            }
+                    }
+            }
+            if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0)
+                {
+                    if (errno != EINTR)
+                        {
+                            LOG(WARNING) << "Error waiting for the output streams: " << std::strerror(errno);
+                        }
+                    continue;
+                }
+            if (fds[0].revents & POLLIN)
+                {
+                    char buffer[64];
+                    while (read(d_wake_pipe[0], buffer, sizeof(buffer)) > 0)
+                        {
+                        }
+                }
+            std::lock_guard<std::mutex> lock(d_mutex);
+            for (size_t i = 1; i < fds.size(); i++)
+                {
+                    const auto it = d_streams.find(fds[i].fd);
+                    if (fds[i].revents != 0 && it != d_streams.end())
+                        {
+                            flush(it->first, it->second);
+                        }
+                }
+            d_drained.notify_all();
+        }
+}
+
+
+void Gnss_Stream_Writer::wake() const
+{
+    const char byte = 0;
+    if (d_wake_pipe[1] != -1 && ::write(d_wake_pipe[1], &byte, 1) == -1 && errno != EAGAIN)
+        {
+            LOG(WARNING) << "Cannot wake up the stream writer: " << std::strerror(errno);
+        }
+}
+
+
+void Gnss_Stream_Writer::flush(int fd, Stream& stream)
+{
+    while (!stream.messages.empty())
+        {
+            const std::string& message = stream.messages.front();
+            const ssize_t written = ::write(fd, message.data() + stream.offset, message.size() - stream.offset);
+            if (written < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                        {
+                            LOG(WARNING) << "Error writing to " << stream.name << ": " << std::strerror(errno);
+                            count_drop(stream, stream.messages.size());
+                            stream.messages.clear();
+                            stream.offset = 0;
+                            stream.pending = 0;
+                        }
+                    return;
+                }
+            stream.offset += static_cast<size_t>(written);
+            if (stream.offset == message.size())
+                {
+                    stream.pending -= message.size();
+                    stream.messages.pop_front();
+                    stream.offset = 0;
+                }
+        }
+}
+
+
+void Gnss_Stream_Writer::count_drop(Stream& stream, uint64_t messages)
+{
+    if (stream.dropped == 0 || stream.dropped / 1000 != (stream.dropped + messages) / 1000)
+        {
+            LOG(WARNING) << stream.name << " cannot keep up, " << stream.dropped + messages << " messages dropped so far";
+        }
+    stream.dropped += messages;
+}
@@ -0,0 +1,121 @@
+/*!
+ * \file gnss_sdr_stream_writer.h
+ * \brief Non-blocking writes to serial ports and other byte streams, from a
+ * single thread shared by all the outputs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SDR_STREAM_WRITER_H
+#define GNSS_SDR_GNSS_SDR_STREAM_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes messages to file descriptors (serial ports, pipes, sockets)
+ * without ever blocking the caller.
+ *
+ * Each registered descriptor is switched to non-blocking mode and gets a
+ * queue of at most capacity bytes. A single thread waits with poll() on all
+ * the descriptors with pending bytes and writes as much as each one accepts,
+ * so a slow or stalled consumer only fills its own queue. Messages are
+ * queued and dropped whole, so that a consumer never receives a truncated
+ * NMEA sentence or RTCM frame: when a queue is full, either the oldest
+ * pending messages or the new one are dropped, depending on the drop policy
+ * of the stream.
+ */
+class Gnss_Stream_Writer
+{
+public:
+    enum class Drop_Policy
+    {
+        Oldest,  //!< keeps the most recent data (positions, corrections)
+        Newest   //!< keeps the data in order up to the first loss
+    };
+
+    Gnss_Stream_Writer();
+
+    /*!
+     * \brief Joins the thread. The bytes still pending are discarded.
+     */
+    ~Gnss_Stream_Writer();
+
+    Gnss_Stream_Writer(const Gnss_Stream_Writer&) = delete;
+    Gnss_Stream_Writer& operator=(const Gnss_Stream_Writer&) = delete;
+
+    /*!
+     * \brief Returns the process-wide writer, shared by the PVT outputs.
+     */
+    static Gnss_Stream_Writer& instance();
+
+    /*!
+     * \brief Registers an open descriptor, named in the log messages.
+     * Returns false if it is already registered or is not valid.
+     */
+    bool add(int fd, const std::string& name, size_t capacity = 65536, Drop_Policy policy = Drop_Policy::Oldest);
+
+    /*!
+     * \brief Waits up to timeout_ms milliseconds for the pending bytes of fd
+     * to be written, then unregisters it. The descriptor is not closed.
+     */
+    void remove(int fd, int timeout_ms = 1000);
+
+    /*!
+     * \brief Queues a message for fd. Returns false if fd is not registered
+     * or the message has been dropped.
+     */
+    bool write(int fd, const void* data, size_t size);
+
+    uint64_t dropped(int fd) const;  //!< Messages of fd discarded so far
+
+private:
+    struct Stream
+    {
+        std::string name;
+        std::deque<std::string> messages;
+        size_t offset{0};  // bytes of the first message already written
+        size_t pending{0};
+        size_t capacity{0};
+        uint64_t dropped{0};
+        Drop_Policy policy{Drop_Policy::Oldest};
+    };
+
+    void run();
+    void wake() const;
+    void flush(int fd, Stream& stream);
+    static void count_drop(Stream& stream, uint64_t messages);
+
+    std::map<int, Stream> d_streams;
+    std::thread d_thread;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_drained;
+    int d_wake_pipe[2]{-1, -1};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_STREAM_WRITER_H
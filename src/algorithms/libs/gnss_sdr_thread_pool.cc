@@ -0,0 +1,156 @@
+/*!
+ * \file gnss_sdr_thread_pool.cc
+ * \brief Persistent pool of worker threads shared by the processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_thread_pool.h"
+#include <algorithm>  // for std::max, std::min, std::push_heap, std::pop_heap
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+
+
+Gnss_Thread_Pool::Gnss_Thread_Pool(size_t num_threads)
+{
+    const size_t n = std::max(num_threads, static_cast<size_t>(1));
+    d_workers.reserve(n);
+    for (size_t i = 0; i < n; i++)
+        {
+            d_workers.emplace_back(&Gnss_Thread_Pool::worker_loop, this);
+        }
+}
+
+
+Gnss_Thread_Pool::~Gnss_Thread_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv.notify_all();
+    for (auto& worker : d_workers)
+        {
+            if (worker.joinable())
+                {
+                    worker.join();
+                }
+        }
+}
+
+
+Gnss_Thread_Pool& Gnss_Thread_Pool::instance()
+{
+    static Gnss_Thread_Pool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+
+void Gnss_Thread_Pool::submit(std::function<void()> task, int priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_tasks.push_back(Task{std::move(task), priority, d_sequence++});
+        std::push_heap(d_tasks.begin(), d_tasks.end(), &Gnss_Thread_Pool::lower_priority);
+    }
+    d_cv.notify_one();
+}
+
+
+size_t Gnss_Thread_Pool::pending() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_tasks.size();
+}
+
+
+bool Gnss_Thread_Pool::lower_priority(const Task& a, const Task& b)
+{
+    if (a.priority != b.priority)
+        {
+            return a.priority < b.priority;
+        }
+    return a.sequence > b.sequence;
+}
+
+
+void Gnss_Thread_Pool::parallel_for(size_t num_chunks, const std::function<void(size_t)>& chunk)
+{
+    if (num_chunks == 0)
+        {
+            return;
+        }
+    if (num_chunks == 1)
+        {
+            chunk(0);
+            return;
+        }
+
+    class Shared_State
+    {
+    public:
+        std::atomic<size_t> next{0};
+        size_t completed{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<Shared_State>();
+
+    // Helpers and caller pick chunks from a common counter, so the caller never
+    // waits for a chunk that has not been started yet.
+    const std::function<void(size_t)>* chunk_ptr = &chunk;
+    auto drain = [state, chunk_ptr, num_chunks]() {
+        size_t i;
+        while ((i = state->next.fetch_add(1)) < num_chunks)
+            {
+                (*chunk_ptr)(i);
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (++state->completed == num_chunks)
+                    {
+                        state->cv.notify_all();
+                    }
+            }
+    };
+
+    // The caller is already running, so helpers jump ahead of queued work
+    const size_t num_helpers = std::min(num_chunks - 1, d_workers.size());
+    for (size_t h = 0; h < num_helpers; h++)
+        {
+            submit(drain, std::numeric_limits<int>::max());
+        }
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state, num_chunks] { return state->completed == num_chunks; });
+}
+
+
+void Gnss_Thread_Pool::worker_loop()
+{
+    while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cv.wait(lock, [this] { return d_stop || !d_tasks.empty(); });
+                if (d_tasks.empty())
+                    {
+                        return;  // d_stop is set and there is nothing left to do
+                    }
+                std::pop_heap(d_tasks.begin(), d_tasks.end(), &Gnss_Thread_Pool::lower_priority);
+                task = std::move(d_tasks.back().function);
+                d_tasks.pop_back();
+            }
+            task();
+        }
+}
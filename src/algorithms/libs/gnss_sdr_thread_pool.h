@@ -0,0 +1,113 @@
+/*!
+ * \file gnss_sdr_thread_pool.h
+ * \brief Persistent pool of worker threads shared by the processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SDR_THREAD_POOL_H
+#define GNSS_SDR_GNSS_SDR_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed-size pool of worker threads.
+ *
+ * Threads are created once and wait for tasks, so no thread is spawned in
+ * the signal processing path. Pending tasks are served by priority, and in
+ * order of submission among tasks with the same priority.
+ */
+class Gnss_Thread_Pool
+{
+public:
+    /*!
+     * \brief Creates a pool with num_threads workers (at least one).
+     */
+    explicit Gnss_Thread_Pool(size_t num_threads);
+
+    /*!
+     * \brief Waits for the queued tasks to finish and joins the workers.
+     */
+    ~Gnss_Thread_Pool();
+
+    Gnss_Thread_Pool(const Gnss_Thread_Pool&) = delete;
+    Gnss_Thread_Pool& operator=(const Gnss_Thread_Pool&) = delete;
+
+    /*!
+     * \brief Returns the process-wide pool, with as many workers as
+     * hardware threads.
+     */
+    static Gnss_Thread_Pool& instance();
+
+    /*!
+     * \brief Queues a task for execution in one of the workers. Tasks with
+     * higher priority values are served first.
+     */
+    void submit(std::function<void()> task, int priority = 0);
+
+    /*!
+     * \brief Number of tasks waiting for a free worker.
+     */
+    size_t pending() const;
+
+    /*!
+     * \brief Runs chunk(0), ..., chunk(num_chunks - 1) in parallel and returns
+     * when all of them are done. The calling thread also executes chunks, so
+     * this can be safely called from within a task running in the pool.
+     */
+    void parallel_for(size_t num_chunks, const std::function<void(size_t)>& chunk);
+
+    /*!
+     * \brief Number of worker threads.
+     */
+    size_t size() const
+    {
+        return d_workers.size();
+    }
+
+private:
+    class Task
+    {
+    public:
+        std::function<void()> function;
+        int priority;
+        uint64_t sequence;
+    };
+
+    static bool lower_priority(const Task& a, const Task& b);
+
+    void worker_loop();
+
+    std::vector<std::thread> d_workers;
+    std::vector<Task> d_tasks;  // heap ordered by lower_priority()
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cv;
+    uint64_t d_sequence{0};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_THREAD_POOL_H
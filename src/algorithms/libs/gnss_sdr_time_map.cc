@@ -0,0 +1,84 @@
+/*!
+ * \file gnss_sdr_time_map.cc
+ * \brief Mapping from sample counts to the time of the signal source, shared
+ * by the blocks of a receiver instead of propagating time tags
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_time_map.h"
+#include <algorithm>
+#include <cmath>
+
+
+Gnss_Time_Map::Gnss_Time_Map(size_t capacity)
+    : d_segments(std::max<size_t>(capacity, 1))
+{
+}
+
+
+void Gnss_Time_Map::publish(const Segment& segment)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_count > 0)
+        {
+            const size_t newest = (d_next + d_segments.size() - 1) % d_segments.size();
+            if (segment.first_sample <= d_segments[newest].first_sample)
+                {
+                    d_count = 0;
+                }
+        }
+    const uint64_t version = d_version.load(std::memory_order_relaxed) + 1;
+    d_segments[d_next] = segment;
+    d_segments[d_next].version = version;
+    d_next = (d_next + 1) % d_segments.size();
+    d_count = std::min(d_count + 1, d_segments.size());
+    d_version.store(version, std::memory_order_release);
+}
+
+
+bool Gnss_Time_Map::segment_before(uint64_t end_sample, Segment& segment) const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    for (size_t i = 1; i <= d_count; i++)
+        {
+            const Segment& candidate = d_segments[(d_next + d_segments.size() - i) % d_segments.size()];
+            if (candidate.first_sample < end_sample)
+                {
+                    segment = candidate;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+bool Gnss_Time_Map::time_at(uint64_t sample, GnssTime& time) const
+{
+    Segment segment;
+    if (!segment_before(sample + 1, segment))
+        {
+            return false;
+        }
+    constexpr double ms_per_week = 604800000.0;
+    double tow_ms = segment.tow_ms + static_cast<double>(sample - segment.first_sample) * segment.ms_per_sample;
+    int32_t week = segment.week;
+    while (tow_ms >= ms_per_week)
+        {
+            tow_ms -= ms_per_week;
+            week++;
+        }
+    time.rx_time = 0.0;
+    time.week = week;
+    time.tow_ms = static_cast<int>(std::floor(tow_ms));
+    time.tow_ms_fraction = tow_ms - static_cast<double>(time.tow_ms);
+    return true;
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file gnss_sdr_time_map.h
+ * \brief Mapping from sample counts to the time of the signal source, shared
+ * by the blocks of a receiver instead of propagating time tags
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_TIME_MAP_H
+#define GNSS_SDR_GNSS_SDR_TIME_MAP_H
+
+#include "gnss_time.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Time of the signal source (GPS week and time of week) as a function
+ * of the sample number in the stream of the channels, made of linear
+ * segments that start at the time tags of the source.
+ *
+ * A single block publishes the segments, in increasing order of their first
+ * sample; a segment that starts before the last one restarts the map (the
+ * stream was restarted). Any number of blocks read it: version() is a single
+ * atomic load, so a block learns whether there is a new segment without
+ * searching the tags of its input, and only then looks it up.
+ */
+class Gnss_Time_Map
+{
+public:
+    class Segment
+    {
+    public:
+        uint64_t first_sample{0};  // sample number of the time tag
+        double tow_ms{0.0};        // time of week of first_sample [ms]
+        double ms_per_sample{0.0};
+        int32_t week{0};
+        uint64_t version{0};  // number of segments published up to this one
+    };
+
+    /*!
+     * \brief Keeps the last capacity segments
+     */
+    explicit Gnss_Time_Map(size_t capacity = 64);
+
+    /*!
+     * \brief Adds a segment from first_sample on. Its version is set by the map.
+     */
+    void publish(const Segment& segment);
+
+    /*!
+     * \brief Number of segments published so far. Safe to call from any
+     * thread, and lock-free.
+     */
+    inline uint64_t version() const { return d_version.load(std::memory_order_acquire); }
+
+    /*!
+     * \brief Copies in segment the newest segment starting before
+     * end_sample. Returns false if there is none.
+     */
+    bool segment_before(uint64_t end_sample, Segment& segment) const;
+
+    /*!
+     * \brief Time of sample, interpolated in the segment that contains it,
+     * with rx_time set to zero. Returns false if no segment contains it.
+     */
+    bool time_at(uint64_t sample, GnssTime& time) const;
+
+private:
+    mutable std::mutex d_mutex;
+    std::vector<Segment> d_segments;  // ring of the last segments
+    size_t d_count{0};                // segments in the ring, ending at d_next
+    size_t d_next{0};
+    std::atomic<uint64_t> d_version{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_TIME_MAP_H
@@ -0,0 +1,196 @@
+/*!
+ * \file gnss_sdr_trace.cc
+ * \brief Recording of execution zones of the processing threads, written as
+ * a Chrome / Perfetto trace
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+
+std::atomic<bool> Gnss_Sdr_Tracer::enabled_{false};
+
+
+namespace
+{
+void write_json_string(std::ostream& out, const std::string& s)
+{
+    out << '"';
+    for (char c : s)
+        {
+            if (c == '"' or c == '\\')
+                {
+                    out << '\\' << c;
+                }
+            else if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    out << c;
+                }
+        }
+    out << '"';
+}
+}  // namespace
+
+
+Gnss_Sdr_Tracer& Gnss_Sdr_Tracer::instance()
+{
+    static Gnss_Sdr_Tracer tracer;
+    return tracer;
+}
+
+
+void Gnss_Sdr_Tracer::start(size_t max_events_per_thread)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = false;
+    for (auto& buffer : buffers_)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    max_events_per_thread_ = max_events_per_thread;
+    start_ns_ = now_ns();
+    enabled_ = true;
+}
+
+
+void Gnss_Sdr_Tracer::stop()
+{
+    enabled_ = false;
+}
+
+
+Gnss_Sdr_Tracer::Thread_Buffer* Gnss_Sdr_Tracer::thread_buffer()
+{
+    thread_local Thread_Buffer* buffer = nullptr;
+    if (buffer == nullptr)
+        {
+            std::unique_ptr<Thread_Buffer> new_buffer(new Thread_Buffer());
+#if defined(__linux__) || defined(__APPLE__)
+            // the GNU Radio schedulers name their threads after the block
+            char name[64] = {0};
+            if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0)
+                {
+                    new_buffer->thread_name = name;
+                }
+#endif
+            std::lock_guard<std::mutex> lock(mutex_);
+            new_buffer->tid = static_cast<uint32_t>(buffers_.size() + 1);
+            if (new_buffer->thread_name.empty())
+                {
+                    new_buffer->thread_name = "thread " + std::to_string(new_buffer->tid);
+                }
+            buffer = new_buffer.get();
+            buffers_.push_back(std::move(new_buffer));
+        }
+    return buffer;
+}
+
+
+void Gnss_Sdr_Tracer::record(const char* name, int64_t begin_ns, int64_t end_ns)
+{
+    Thread_Buffer* buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if (buffer->events.size() < max_events_per_thread_.load(std::memory_order_relaxed))
+        {
+            if (buffer->events.capacity() == buffer->events.size())
+                {
+                    buffer->events.reserve(std::min(max_events_per_thread_.load(std::memory_order_relaxed),
+                        std::max(static_cast<size_t>(1024), 2 * buffer->events.size())));
+                }
+            buffer->events.push_back({name, begin_ns, end_ns});
+        }
+    else
+        {
+            buffer->dropped++;
+        }
+}
+
+
+void Gnss_Sdr_Tracer::write(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t start_ns = start_ns_;
+    const auto flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& buffer : buffers_)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (buffer->events.empty() and buffer->dropped == 0)
+                {
+                    continue;
+                }
+            out << (first ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid << R"(,"args":{"name":)";
+            write_json_string(out, buffer->thread_name);
+            out << "}}";
+            first = false;
+            for (const auto& event : buffer->events)
+                {
+                    // timestamps and durations in microseconds
+                    out << ",\n{\"name\":";
+                    write_json_string(out, event.name);
+                    out << R"(,"ph":"X","pid":1,"tid":)" << buffer->tid
+                        << ",\"ts\":" << static_cast<double>(event.begin_ns - start_ns) * 1e-3
+                        << ",\"dur\":" << static_cast<double>(event.end_ns - event.begin_ns) * 1e-3 << '}';
+                }
+        }
+    out << "\n]}\n";
+    out.flags(flags);
+}
+
+
+bool Gnss_Sdr_Tracer::save(const std::string& filename)
+{
+    stop();
+    std::ofstream out(filename);
+    if (!out.is_open())
+        {
+            return false;
+        }
+    write(out);
+    return out.good();
+}
+
+
+size_t Gnss_Sdr_Tracer::events() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (const auto& buffer : buffers_)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            n += buffer->events.size();
+        }
+    return n;
+}
+
+
+uint64_t Gnss_Sdr_Tracer::dropped() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t n = 0;
+    for (const auto& buffer : buffers_)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            n += buffer->dropped;
+        }
+    return n;
+}
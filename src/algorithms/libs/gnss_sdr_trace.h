@@ -0,0 +1,163 @@
+/*!
+ * \file gnss_sdr_trace.h
+ * \brief Recording of execution zones of the processing threads, written as
+ * a Chrome / Perfetto trace
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_TRACE_H
+#define GNSS_SDR_GNSS_SDR_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Collects the zones (name, thread, begin and end) recorded by
+ * GNSS_SDR_TRACE_ZONE while it is started.
+ *
+ * Each thread appends to its own buffer, so the threads only share the
+ * buffer lock with the writer. A buffer holds at most max_events_per_thread
+ * zones, and the next ones are counted as dropped, so a long run keeps its
+ * beginning. The zones are written in the Trace Event Format of Chrome,
+ * which chrome://tracing, https://ui.perfetto.dev and the flame graph
+ * converters read.
+ */
+class Gnss_Sdr_Tracer
+{
+public:
+    static Gnss_Sdr_Tracer& instance();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    static int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /*!
+     * \brief Discards the zones recorded so far and starts recording
+     */
+    void start(size_t max_events_per_thread = 1000000);
+
+    /*!
+     * \brief Stops recording. The zones are kept until the next start().
+     */
+    void stop();
+
+    void record(const char* name, int64_t begin_ns, int64_t end_ns);
+
+    /*!
+     * \brief Writes the recorded zones as a JSON trace
+     */
+    void write(std::ostream& out) const;
+
+    /*!
+     * \brief Stops recording and writes the zones to filename. Returns false
+     * if the file cannot be written.
+     */
+    bool save(const std::string& filename);
+
+    size_t events() const;
+    uint64_t dropped() const;
+
+private:
+    class Event
+    {
+    public:
+        const char* name;
+        int64_t begin_ns;
+        int64_t end_ns;
+    };
+
+    class Thread_Buffer
+    {
+    public:
+        mutable std::mutex mutex;
+        std::vector<Event> events;
+        std::string thread_name;
+        uint64_t dropped{0};
+        uint32_t tid{0};
+    };
+
+    Gnss_Sdr_Tracer() = default;
+    Thread_Buffer* thread_buffer();
+
+    static std::atomic<bool> enabled_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Thread_Buffer>> buffers_;  // never released, the threads keep a pointer
+    std::atomic<size_t> max_events_per_thread_{0};
+    std::atomic<int64_t> start_ns_{0};
+};
+
+
+/*!
+ * \brief Records a zone from its construction to its destruction, if the
+ * tracer is started
+ */
+class Gnss_Sdr_Trace_Zone
+{
+public:
+    explicit Gnss_Sdr_Trace_Zone(const char* name)
+        : name_(name),
+          begin_ns_(Gnss_Sdr_Tracer::enabled() ? Gnss_Sdr_Tracer::now_ns() : -1)
+    {
+    }
+
+    ~Gnss_Sdr_Trace_Zone()
+    {
+        if (begin_ns_ >= 0 and Gnss_Sdr_Tracer::enabled())
+            {
+                Gnss_Sdr_Tracer::instance().record(name_, begin_ns_, Gnss_Sdr_Tracer::now_ns());
+            }
+    }
+
+    Gnss_Sdr_Trace_Zone(const Gnss_Sdr_Trace_Zone&) = delete;
+    Gnss_Sdr_Trace_Zone& operator=(const Gnss_Sdr_Trace_Zone&) = delete;
+
+private:
+    const char* name_;
+    int64_t begin_ns_;
+};
+
+
+#define GNSS_SDR_TRACE_CONCAT_(a, b) a##b
+#define GNSS_SDR_TRACE_CONCAT(a, b) GNSS_SDR_TRACE_CONCAT_(a, b)
+
+/*!
+ * \brief Records the rest of the enclosing scope as a zone named name, which
+ * must be a string literal. It compiles to nothing unless the build defines
+ * GNSS_SDR_ENABLE_TRACING (cmake -DENABLE_TRACING=ON). At most one per line.
+ */
+#if GNSS_SDR_ENABLE_TRACING
+#define GNSS_SDR_TRACE_ZONE(name) const Gnss_Sdr_Trace_Zone GNSS_SDR_TRACE_CONCAT(gnss_sdr_trace_zone_, __LINE__)(name)
+#else
+#define GNSS_SDR_TRACE_ZONE(name) static_cast<void>(0)
+#endif
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_TRACE_H
@@ -0,0 +1,235 @@
+/*!
+ * \file gnss_sdr_udp_sender.cc
+ * \brief Sends datagrams to a set of UDP endpoints from its own thread, in
+ * batches
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_udp_sender.h"
+#include <glog/logging.h>
+#include <sys/socket.h>  // for socket, sendto, sendmmsg
+#include <sys/uio.h>     // for iovec
+#include <unistd.h>      // for close
+#include <algorithm>     // for std::find
+#include <array>
+#include <cerrno>   // for errno
+#include <cstring>  // for strerror
+#include <utility>
+
+
+namespace
+{
+constexpr size_t MAX_BATCH_MESSAGES = 64;
+}  // namespace
+
+
+Gnss_Udp_Sender::Gnss_Udp_Sender(std::vector<boost::asio::ip::udp::endpoint> endpoints,
+    size_t capacity) : d_endpoints(std::move(endpoints)),
+                       d_capacity(std::max<size_t>(capacity, 1))
+{
+    int socket_v4 = -1;
+    int socket_v6 = -1;
+    for (const auto& endpoint : d_endpoints)
+        {
+            int& fd = endpoint.address().is_v6() ? socket_v6 : socket_v4;
+            if (fd == -1)
+                {
+                    fd = ::socket(endpoint.address().is_v6() ? AF_INET6 : AF_INET, SOCK_DGRAM, 0);
+                    if (fd == -1)
+                        {
+                            LOG(WARNING) << "Cannot create a UDP socket: " << std::strerror(errno);
+                            fd = -2;  // do not try again
+                        }
+                }
+            d_sockets.push_back(fd);
+        }
+    d_thread = std::thread(&Gnss_Udp_Sender::run, this);
+}
+
+
+Gnss_Udp_Sender::~Gnss_Udp_Sender()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_one();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    std::vector<int> closed;
+    for (const int fd : d_sockets)
+        {
+            if (fd >= 0 && std::find(closed.cbegin(), closed.cend(), fd) == closed.cend())
+                {
+                    ::close(fd);
+                    closed.push_back(fd);
+                }
+        }
+}
+
+
+std::string Gnss_Udp_Sender::get_buffer()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_free.empty())
+        {
+            return std::string();
+        }
+    std::string buffer = std::move(d_free.back());
+    d_free.pop_back();
+    return buffer;
+}
+
+
+void Gnss_Udp_Sender::send(std::string datagram)
+{
+    if (d_endpoints.empty())
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_queue.size() >= d_capacity)
+            {
+                d_queue.pop_front();
+                if (d_dropped++ % 1000 == 0)
+                    {
+                        LOG(WARNING) << "UDP monitor output cannot keep up, " << d_dropped << " messages dropped so far";
+                    }
+            }
+        d_queue.push_back(std::move(datagram));
+    }
+    d_cond.notify_one();
+}
+
+
+uint64_t Gnss_Udp_Sender::dropped() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped;
+}
+
+
+void Gnss_Udp_Sender::run()
+{
+    std::vector<std::string> batch;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop || !d_queue.empty(); });
+                if (d_queue.empty())
+                    {
+                        return;  // stopped, and nothing left to send
+                    }
+                while (!d_queue.empty())
+                    {
+                        batch.push_back(std::move(d_queue.front()));
+                        d_queue.pop_front();
+                    }
+            }
+            send_batch(batch);
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                for (auto& datagram : batch)
+                    {
+                        if (d_free.size() < d_capacity)
+                            {
+                                datagram.clear();
+                                d_free.push_back(std::move(datagram));
+                            }
+                    }
+            }
+            batch.clear();
+        }
+}
+
+
+void Gnss_Udp_Sender::send_batch(const std::vector<std::string>& batch)
+{
+    std::vector<int> done;
+    for (const int fd : d_sockets)
+        {
+            if (fd < 0 || std::find(done.cbegin(), done.cend(), fd) != done.cend())
+                {
+                    continue;
+                }
+            done.push_back(fd);
+#if defined(__linux__)
+            std::array<mmsghdr, MAX_BATCH_MESSAGES> messages{};
+            std::array<iovec, MAX_BATCH_MESSAGES> iovecs{};
+            size_t n = 0;
+            const auto flush = [&]() {
+                size_t offset = 0;
+                while (offset < n)
+                    {
+                        const int sent = sendmmsg(fd, messages.data() + offset, static_cast<unsigned int>(n - offset), 0);
+                        if (sent < 0)
+                            {
+                                report_error(errno);
+                                offset++;  // skip the datagram that failed
+                            }
+                        else
+                            {
+                                offset += static_cast<size_t>(sent);
+                            }
+                    }
+                n = 0;
+            };
+            for (const auto& datagram : batch)
+                {
+                    for (size_t e = 0; e < d_endpoints.size(); e++)
+                        {
+                            if (d_sockets[e] != fd)
+                                {
+                                    continue;
+                                }
+                            iovecs[n].iov_base = const_cast<char*>(datagram.data());
+                            iovecs[n].iov_len = datagram.size();
+                            messages[n].msg_hdr = msghdr{};
+                            messages[n].msg_hdr.msg_name = d_endpoints[e].data();
+                            messages[n].msg_hdr.msg_namelen = static_cast<socklen_t>(d_endpoints[e].size());
+                            messages[n].msg_hdr.msg_iov = &iovecs[n];
+                            messages[n].msg_hdr.msg_iovlen = 1;
+                            if (++n == MAX_BATCH_MESSAGES)
+                                {
+                                    flush();
+                                }
+                        }
+                }
+            flush();
+#else
+            for (const auto& datagram : batch)
+                {
+                    for (size_t e = 0; e < d_endpoints.size(); e++)
+                        {
+                            if (d_sockets[e] == fd &&
+                                ::sendto(fd, datagram.data(), datagram.size(), 0, d_endpoints[e].data(), static_cast<socklen_t>(d_endpoints[e].size())) < 0)
+                                {
+                                    report_error(errno);
+                                }
+                        }
+                }
+#endif
+        }
+}
+
+
+void Gnss_Udp_Sender::report_error(int error)
+{
+    if (d_errors++ % 1000 == 0)
+        {
+            LOG(WARNING) << "Error sending a UDP monitor message: " << std::strerror(error);
+        }
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file gnss_sdr_udp_sender.h
+ * \brief Sends datagrams to a set of UDP endpoints from its own thread, in
+ * batches
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SDR_UDP_SENDER_H
+#define GNSS_SDR_GNSS_SDR_UDP_SENDER_H
+
+#include <boost/asio/ip/udp.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Sends each queued datagram to every endpoint.
+ *
+ * The caller only queues the datagram; a thread of the sender drains the
+ * queue and sends everything pending in as few system calls as possible
+ * (one sendmmsg call per batch of up to 64 datagrams on Linux). At most
+ * capacity datagrams wait; when the queue is full, the oldest one is
+ * dropped, since monitoring data that arrives late is of no use.
+ *
+ * The strings of the sent datagrams are given back by get_buffer(), so that
+ * in steady state the serialization of the messages does not allocate.
+ */
+class Gnss_Udp_Sender
+{
+public:
+    Gnss_Udp_Sender(std::vector<boost::asio::ip::udp::endpoint> endpoints, size_t capacity = 1024);
+
+    /*!
+     * \brief Sends the pending datagrams and joins the thread.
+     */
+    ~Gnss_Udp_Sender();
+
+    Gnss_Udp_Sender(const Gnss_Udp_Sender&) = delete;
+    Gnss_Udp_Sender& operator=(const Gnss_Udp_Sender&) = delete;
+
+    /*!
+     * \brief An empty string, with the capacity of a previously sent
+     * datagram if one is available.
+     */
+    std::string get_buffer();
+
+    /*!
+     * \brief Queues a datagram for all the endpoints. Never blocks on the
+     * network.
+     */
+    void send(std::string datagram);
+
+    uint64_t dropped() const;  //!< Number of datagrams discarded so far
+
+private:
+    void run();
+    void send_batch(const std::vector<std::string>& batch);
+    void report_error(int error);
+
+    std::vector<boost::asio::ip::udp::endpoint> d_endpoints;
+    std::vector<int> d_sockets;  // one per endpoint, shared by endpoints of the same family
+    std::deque<std::string> d_queue;
+    std::vector<std::string> d_free;
+    std::thread d_thread;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    size_t d_capacity;
+    uint64_t d_dropped{0};
+    uint64_t d_errors{0};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_UDP_SENDER_H
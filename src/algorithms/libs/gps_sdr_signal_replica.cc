@@ -17,86 +17,25 @@
  */
 
 #include "gps_sdr_signal_replica.h"
+#include "gnss_code_table.h"
 #include <array>
-#include <bitset>
 
 const auto AUX_CEIL = [](float x) { return static_cast<int32_t>(static_cast<int64_t>((x) + 1)); };
 
 void gps_l1_ca_code_gen_int(own::span<int32_t> dest, int32_t prn, uint32_t chip_shift)
 {
     constexpr uint32_t code_length = 1023;
-    std::bitset<code_length> G1{};
-    std::bitset<code_length> G2{};
-    auto G1_register = std::bitset<10>{}.set();  // All true
-    auto G2_register = std::bitset<10>{}.set();  // All true
-    uint32_t lcv;
-    uint32_t lcv2;
-    uint32_t delay;
-    int32_t prn_idx;
-    bool feedback1;
-    bool feedback2;
-    bool aux;
-
-    // G2 Delays as defined in GPS-ISD-200D
-    const std::array<int32_t, 51> delays = {5 /*PRN1*/, 6, 7, 8, 17, 18, 139, 140, 141, 251, 252, 254, 255, 256, 257, 258, 469, 470, 471, 472,
-        473, 474, 509, 512, 513, 514, 515, 516, 859, 860, 861, 862 /*PRN32*/,
-        145 /*PRN120*/, 175, 52, 21, 237, 235, 886, 657, 634, 762,
-        355, 1012, 176, 603, 130, 359, 595, 68, 386 /*PRN138*/};
-
-    // compute delay array index for given PRN number
-    if (120 <= prn && prn <= 138)
-        {
-            prn_idx = prn - 88;  // SBAS PRNs are at array indices 31 to 50 (offset: -120+33-1 =-88)
-        }
-    else
-        {
-            prn_idx = prn - 1;
-        }
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, static_cast<uint32_t>(prn));
 
     // A simple error check
-    if ((prn_idx < 0) || (prn_idx > 51))
+    if (code == nullptr)
         {
             return;
         }
 
-    // Generate G1 & G2 Register
-    for (lcv = 0; lcv < code_length; lcv++)
-        {
-            G1[lcv] = G1_register[0];
-            G2[lcv] = G2_register[0];
-
-            feedback1 = G1_register[7] xor G1_register[0];
-            feedback2 = G2_register[8] xor G2_register[7] xor G2_register[4] xor G2_register[2] xor G2_register[1] xor G2_register[0];
-
-            for (lcv2 = 0; lcv2 < 9; lcv2++)
-                {
-                    G1_register[lcv2] = G1_register[lcv2 + 1];
-                    G2_register[lcv2] = G2_register[lcv2 + 1];
-                }
-
-            G1_register[9] = feedback1;
-            G2_register[9] = feedback2;
-        }
-
-    // Set the delay
-    delay = code_length - delays[prn_idx];
-    delay += chip_shift;
-    delay %= code_length;
-
-    // Generate PRN from G1 and G2 Registers
-    for (lcv = 0; lcv < code_length; lcv++)
+    for (uint32_t lcv = 0; lcv < code_length; lcv++)
         {
-            aux = G1[(lcv + chip_shift) % code_length] xor G2[delay];
-            if (aux == true)
-                {
-                    dest[lcv] = 1;
-                }
-            else
-                {
-                    dest[lcv] = -1;
-                }
-            delay++;
-            delay %= code_length;
+            dest[lcv] = code->value((lcv + chip_shift) % code_length);
         }
 }
 
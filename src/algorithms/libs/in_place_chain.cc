@@ -0,0 +1,52 @@
+/*!
+ * \file in_place_chain.cc
+ * \brief Runs several signal processing stages back to back on a single
+ * buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "in_place_chain.h"
+#include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cstring>
+
+
+in_place_chain_sptr make_in_place_chain(size_t item_size, const std::vector<in_place_kernel> &kernels)
+{
+    return in_place_chain_sptr(new in_place_chain(item_size, kernels));
+}
+
+
+in_place_chain::in_place_chain(size_t item_size,
+    const std::vector<in_place_kernel> &kernels) : gr::sync_block("in_place_chain",
+                                                       gr::io_signature::make(1, 1, item_size),
+                                                       gr::io_signature::make(1, 1, item_size)),
+                                                   d_kernels(kernels),
+                                                   d_item_size(item_size)
+{
+    const auto alignment_multiple = static_cast<int>(volk_gnsssdr_get_alignment() / item_size);
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+int in_place_chain::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    std::memcpy(output_items[0], input_items[0], noutput_items * d_item_size);
+    for (const auto &kernel : d_kernels)
+        {
+            kernel(output_items[0], noutput_items);
+        }
+    return noutput_items;
+}
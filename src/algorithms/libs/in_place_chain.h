@@ -0,0 +1,65 @@
+/*!
+ * \file in_place_chain.h
+ * \brief Runs several signal processing stages back to back on a single
+ * buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_IN_PLACE_CHAIN_H
+#define GNSS_SDR_IN_PLACE_CHAIN_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class in_place_chain;
+
+using in_place_chain_sptr = gnss_shared_ptr<in_place_chain>;
+
+using in_place_kernel = std::function<void(void *items, int nitems)>;
+
+in_place_chain_sptr make_in_place_chain(size_t item_size, const std::vector<in_place_kernel> &kernels);
+
+/*!
+ * \brief Copies its input to its output buffer once and applies each kernel
+ * to it in turn, taking the place of a chain of blocks that would each copy
+ * the samples into a buffer of their own.
+ */
+class in_place_chain : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    size_t num_kernels() const { return d_kernels.size(); }
+
+private:
+    friend in_place_chain_sptr make_in_place_chain(size_t item_size, const std::vector<in_place_kernel> &kernels);
+    in_place_chain(size_t item_size, const std::vector<in_place_kernel> &kernels);
+
+    std::vector<in_place_kernel> d_kernels;
+    size_t d_item_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_IN_PLACE_CHAIN_H
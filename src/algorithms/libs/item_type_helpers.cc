@@ -20,7 +20,8 @@
 #include "item_type_helpers.h"
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <cstring>  // memcpy
+#include <cstring>    // memcpy
+#include <stdexcept>  // runtime_error
 
 bool item_type_valid(const std::string &item_type)
 {
@@ -74,94 +75,80 @@ bool item_type_is_complex(const std::string &item_type)
 }
 
 
-void copy_converter(void *dest, const void *src, uint32_t num_items, size_t item_size)
+template <>
+void convert_items<int8_t, int16_t>(int16_t *dest, const int8_t *src, uint32_t num_items)
 {
-    std::memcpy(dest, src, num_items * item_size);
+    volk_8i_convert_16i(dest, src, num_items);
 }
 
 
-void convert_8i_16i(void *dest, const void *src, uint32_t num_items)
+template <>
+void convert_items<int8_t, float>(float *dest, const int8_t *src, uint32_t num_items)
 {
-    volk_8i_convert_16i(reinterpret_cast<int16_t *>(dest),
-        reinterpret_cast<const int8_t *>(src), num_items);
+    volk_8i_s32f_convert_32f(dest, src, 1.0F, num_items);
 }
 
 
-void convert_8i_32f(void *dest, const void *src, uint32_t num_items)
+template <>
+void convert_items<int16_t, int8_t>(int8_t *dest, const int16_t *src, uint32_t num_items)
 {
-    volk_8i_s32f_convert_32f(reinterpret_cast<float *>(dest),
-        reinterpret_cast<const int8_t *>(src), 1.0F, num_items);
+    volk_16i_convert_8i(dest, src, num_items);
 }
 
 
-void convert_8ic_16ic(void *dest, const void *src, uint32_t num_items)
+template <>
+void convert_items<int16_t, float>(float *dest, const int16_t *src, uint32_t num_items)
 {
-    volk_8i_convert_16i(reinterpret_cast<int16_t *>(dest),
-        reinterpret_cast<const int8_t *>(src), 2 * num_items);
+    volk_16i_s32f_convert_32f(dest, src, 1.0F, num_items);
 }
 
 
-void convert_8ic_32fc(void *dest, const void *src, uint32_t num_items)
+template <>
+void convert_items<float, int8_t>(int8_t *dest, const float *src, uint32_t num_items)
 {
-    volk_8i_s32f_convert_32f(reinterpret_cast<float *>(dest),
-        reinterpret_cast<const int8_t *>(src), 1.0F, 2 * num_items);
+    volk_32f_s32f_convert_8i(dest, src, 1.0F, num_items);
 }
 
 
-void convert_16i_8i(void *dest, const void *src, uint32_t num_items)
+template <>
+void convert_items<float, int16_t>(int16_t *dest, const float *src, uint32_t num_items)
 {
-    volk_16i_convert_8i(reinterpret_cast<int8_t *>(dest),
-        reinterpret_cast<const int16_t *>(src), num_items);
+    volk_32f_s32f_convert_16i(dest, src, 1.0F, num_items);
 }
 
 
-void convert_16i_32f(void *dest, const void *src, uint32_t num_items)
+namespace
 {
-    volk_16i_s32f_convert_32f(reinterpret_cast<float *>(dest),
-        reinterpret_cast<const int16_t *>(src), 1.0F, num_items);
-}
-
-
-void convert_16ic_8ic(void *dest, const void *src, uint32_t num_items)
+template <size_t ItemSize>
+void copy_converter(void *dest, const void *src, uint32_t num_items)
 {
-    volk_16i_convert_8i(reinterpret_cast<int8_t *>(dest),
-        reinterpret_cast<const int16_t *>(src), 2 * num_items);
+    std::memcpy(dest, src, num_items * ItemSize);
 }
 
 
-void convert_16ic_32fc(void *dest, const void *src, uint32_t num_items)
+// Components is 2 for complex items
+template <typename InputType, typename OutputType, uint32_t Components>
+void vector_converter(void *dest, const void *src, uint32_t num_items)
 {
-    volk_16i_s32f_convert_32f(reinterpret_cast<float *>(dest),
-        reinterpret_cast<const int16_t *>(src), 1.0F, 2 * num_items);
+    convert_items(static_cast<OutputType *>(dest), static_cast<const InputType *>(src), Components * num_items);
 }
 
 
-void convert_32f_8i(void *dest, const void *src, uint32_t num_items)
+item_type_converter_t make_copy_converter(const std::string &item_type)
 {
-    volk_32f_s32f_convert_8i(reinterpret_cast<int8_t *>(dest),
-        reinterpret_cast<const float *>(src), 1.0F, num_items);
-}
-
-
-void convert_32f_16i(void *dest, const void *src, uint32_t num_items)
-{
-    volk_32f_s32f_convert_16i(reinterpret_cast<int16_t *>(dest),
-        reinterpret_cast<const float *>(src), 1.0F, num_items);
-}
-
-
-void convert_32fc_8ic(void *dest, const void *src, uint32_t num_items)
-{
-    volk_32f_s32f_convert_8i(reinterpret_cast<int8_t *>(dest),
-        reinterpret_cast<const float *>(src), 1.0F, 2 * num_items);
-}
-
-
-void convert_32fc_16ic(void *dest, const void *src, uint32_t num_items)
-{
-    volk_32f_s32f_convert_16i(reinterpret_cast<int16_t *>(dest),
-        reinterpret_cast<const float *>(src), 1.0F, 2 * num_items);
+    switch (item_type_size(item_type))
+        {
+        case 1:
+            return copy_converter<1>;
+        case 2:
+            return copy_converter<2>;
+        case 4:
+            return copy_converter<4>;
+        default:
+            return copy_converter<8>;
+        }
 }
+}  // namespace
 
 
 item_type_converter_t make_vector_converter(const std::string &input_type,
@@ -174,200 +161,111 @@ item_type_converter_t make_vector_converter(const std::string &input_type,
 
     if (input_type == output_type)
         {
-            size_t input_size = item_type_size(input_type);
-#ifdef DO_NOT_USE_LAMBDAS
-            return std::bind(copy_converter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, input_size);  // NOLINT(modernize-avoid-bind)
-#else
-            return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return copy_converter(arg1, arg2, arg3, input_size); };
-#endif
+            return make_copy_converter(input_type);
         }
 
     if (input_type == "byte")
         {
             if (output_type == "short")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8i_16i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8i_16i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, int16_t, 1>;
                 }
             else if (output_type == "float")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8i_32f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8i_32f(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, float, 1>;
                 }
         }
     else if (input_type == "cbyte")
         {
             if (output_type == "ibyte")
                 {
-                    size_t input_size = item_type_size(input_type);
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(copy_converter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, input_size);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return copy_converter(arg1, arg2, arg3, input_size); };
-#endif
+                    return make_copy_converter(input_type);
                 }
             if (output_type == "cshort" or output_type == "ishort")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8ic_16ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8ic_16ic(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, int16_t, 2>;
                 }
             else if (output_type == "gr_complex")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8ic_32fc, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8ic_32fc(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, float, 2>;
                 }
         }
     else if (input_type == "ibyte")
         {
             if (output_type == "cbyte")
                 {
-                    size_t input_size = item_type_size(input_type);
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(copy_converter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, input_size);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return copy_converter(arg1, arg2, arg3, input_size); };
-#endif
+                    return make_copy_converter(input_type);
                 }
             else if (output_type == "cshort" or output_type == "ishort")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8i_16i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8i_16i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, int16_t, 1>;
                 }
             else if (output_type == "gr_complex")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_8i_32f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_8i_32f(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int8_t, float, 1>;
                 }
         }
     else if (input_type == "short")
         {
             if (output_type == "byte")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16i_8i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16i_8i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, int8_t, 1>;
                 }
             else if (output_type == "float")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16i_32f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16i_32f(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, float, 1>;
                 }
         }
     else if (input_type == "cshort")
         {
             if (output_type == "cbyte" or output_type == "ibyte")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16ic_8ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16ic_8ic(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, int8_t, 2>;
                 }
             if (output_type == "ishort")
                 {
-                    size_t input_size = item_type_size(input_type);
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(copy_converter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, input_size);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return copy_converter(arg1, arg2, arg3, input_size); };
-#endif
+                    return make_copy_converter(input_type);
                 }
             else if (output_type == "gr_complex")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16ic_32fc, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16ic_32fc(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, float, 2>;
                 }
         }
     else if (input_type == "ishort")
         {
             if (output_type == "cbyte" or output_type == "ibyte")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16i_8i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16i_8i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, int8_t, 1>;
                 }
             if (output_type == "cshort")
                 {
-                    size_t input_size = item_type_size(input_type);
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(copy_converter, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, input_size);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return copy_converter(arg1, arg2, arg3, input_size); };
-#endif
+                    return make_copy_converter(input_type);
                 }
             else if (output_type == "gr_complex")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_16i_32f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_16i_32f(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<int16_t, float, 1>;
                 }
         }
     else if (input_type == "float")
         {
             if (output_type == "byte")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_32f_8i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_32f_8i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<float, int8_t, 1>;
                 }
             else if (output_type == "short")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_32f_16i, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_32f_16i(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<float, int16_t, 1>;
                 }
         }
     else if (input_type == "gr_complex")
         {
             if (output_type == "cbyte" or output_type == "ibyte")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_32fc_8ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_32fc_8ic(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<float, int8_t, 2>;
                 }
             else if (output_type == "cshort" or output_type == "ishort")
                 {
-#ifdef DO_NOT_USE_LAMBDAS
-                    return std::bind(convert_32fc_16ic, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);  // NOLINT(modernize-avoid-bind)
-#else
-                    return [=](auto &&arg1, auto &&arg2, auto &&arg3) { return convert_32fc_16ic(arg1, arg2, arg3); };
-#endif
+                    return vector_converter<float, int16_t, 2>;
                 }
         }
 
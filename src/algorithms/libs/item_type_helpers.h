@@ -21,8 +21,8 @@
 #define GNSS_SDR_ITEM_TYPE_HELPERS_H
 
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <string>
 
 /** \addtogroup Algorithms_Library
@@ -31,7 +31,11 @@
  * \{ */
 
 
-using item_type_converter_t = std::function<void(void *, const void *, uint32_t)>;
+/*!
+ * \brief Converter between two item types, selected once by
+ * make_vector_converter and then called without type erasure.
+ */
+using item_type_converter_t = void (*)(void *, const void *, uint32_t);
 
 /*!
  * \brief Check if a string is a valid item type
@@ -72,14 +76,52 @@ bool item_type_is_complex(const std::string &item_type);
  *  7. "float" for 32 bit floating point values
  *  8. "gr_complex" for complex (interleaved) 32 bit floating point values
  *
- * \returns A function object with the following prototype:
- *  void convert_fun( void *dest, void *src, int num_items );
+ * \returns A pointer to a function with the following prototype:
+ *  void convert_fun( void *dest, const void *src, uint32_t num_items );
  *
  */
 item_type_converter_t make_vector_converter(const std::string &input_type,
     const std::string &output_type);
 
 
+/*!
+ * \brief Converts num_items values of InputType to OutputType, for blocks
+ * that know their item types at compile time.
+ *
+ * \description The conversions between int8_t, int16_t and float are
+ * specialized to the VOLK kernels used by make_vector_converter (note that
+ * they scale the 8-bit values by 256 in 16-bit words). Other types are
+ * converted with static_cast in a loop that the compiler vectorizes.
+ * Complex items are converted as two values each.
+ */
+template <typename InputType, typename OutputType>
+void convert_items(OutputType *dest, const InputType *src, uint32_t num_items)
+{
+    for (uint32_t i = 0; i < num_items; i++)
+        {
+            dest[i] = static_cast<OutputType>(src[i]);
+        }
+}
+
+template <>
+void convert_items<int8_t, int16_t>(int16_t *dest, const int8_t *src, uint32_t num_items);
+
+template <>
+void convert_items<int8_t, float>(float *dest, const int8_t *src, uint32_t num_items);
+
+template <>
+void convert_items<int16_t, int8_t>(int8_t *dest, const int16_t *src, uint32_t num_items);
+
+template <>
+void convert_items<int16_t, float>(float *dest, const int16_t *src, uint32_t num_items);
+
+template <>
+void convert_items<float, int8_t>(int8_t *dest, const float *src, uint32_t num_items);
+
+template <>
+void convert_items<float, int16_t>(int16_t *dest, const float *src, uint32_t num_items);
+
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_ITEM_TYPE_HELPERS_H
@@ -20,7 +20,8 @@
 #include "configuration_interface.h"
 #include <glog/logging.h>
 #include <gnuradio/gr_complex.h>
-#include <volk/volk_complex.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cstdint>  // for int8_t
 #include <ostream>  // for operator<<
 
@@ -160,3 +161,33 @@ gr::basic_block_sptr Pass_Through::get_right_block()
 
     return kludge_copy_;
 }
+
+
+std::function<void(void* items, int nitems)> Pass_Through::in_place_kernel()
+{
+    if (inverted_spectrum)
+        {
+            if (item_type_ == "gr_complex")
+                {
+                    return [](void* items, int nitems) {
+                        auto* samples = reinterpret_cast<gr_complex*>(items);
+                        volk_32fc_conjugate_32fc(samples, samples, nitems);
+                    };
+                }
+            if (item_type_ == "cshort")
+                {
+                    return [](void* items, int nitems) {
+                        auto* samples = reinterpret_cast<lv_16sc_t*>(items);
+                        volk_gnsssdr_16ic_conjugate_16ic(samples, samples, nitems);
+                    };
+                }
+            if (item_type_ == "cbyte")
+                {
+                    return [](void* items, int nitems) {
+                        auto* samples = reinterpret_cast<lv_8sc_t*>(items);
+                        volk_gnsssdr_8ic_conjugate_8ic(samples, samples, nitems);
+                    };
+                }
+        }
+    return [](void* items __attribute__((unused)), int nitems __attribute__((unused))) {};
+}
@@ -26,6 +26,7 @@
 #include <gnuradio/blocks/copy.h>
 #include <gnuradio/runtime_types.h>
 #include <cstddef>
+#include <functional>
 #include <string>
 
 /** \addtogroup Algorithms_Library
@@ -75,6 +76,11 @@ public:
     gr::basic_block_sptr get_left_block() override;
     gr::basic_block_sptr get_right_block() override;
 
+    /*!
+     * \brief Nothing to do, or the conjugation with inverted_spectrum set.
+     */
+    std::function<void(void *items, int nitems)> in_place_kernel() override;
+
 private:
     gr::blocks::copy::sptr kludge_copy_;
     conjugate_cc_sptr conjugate_cc_;
@@ -359,6 +359,15 @@ typedef struct
 } gtime_t;
 
 
+typedef struct
+{                 /* time context of an epoch, see epoch_time() */
+    gtime_t gpst; /* gps time */
+    int week;     /* gps week */
+    double tow;   /* gps time of week (s) */
+    gtime_t utc;  /* utc */
+} epoch_time_t;
+
+
 typedef struct
 {                                       /* observation data record */
     gtime_t time;                       /* receiver sampling time (GPST) */
@@ -785,6 +794,7 @@ typedef struct
     pcv_t pcvs[MAXSAT];           /* satellite antenna pcv */
     sbssat_t sbssat;              /* SBAS satellite corrections */
     sbsion_t sbsion[MAXBAND + 1]; /* SBAS ionosphere corrections */
+    unsigned int sbsrev;          /* revision of the SBAS corrections (0: not set by sbsupdatecorr) */
     dgps_t dgps[MAXSAT];          /* DGPS corrections */
     ssr_t ssr[MAXSAT];            /* SSR corrections */
     lexeph_t lexeph[MAXSAT];      /* LEX ephemeris */
@@ -995,6 +1005,7 @@ typedef struct
     exterr_t exterr;              /* extended receiver error model */
     int freqopt;                  /* disable L2-AR */
     char pppopt[256];             /* ppp option */
+    int raimthreads;              /* threads of the raim fde (0,1:calling thread only) */
 } prcopt_t;
 
 
@@ -1102,9 +1113,10 @@ typedef struct
 
 
 typedef struct
-{              /* serial control type */
-    dev_t dev; /* serial device */
-    int error; /* error state */
+{                /* serial control type */
+    dev_t dev;   /* serial device */
+    int error;   /* error state */
+    int queued;  /* writes queued in the shared stream writer */
 } serial_t;
 
 
@@ -471,3 +471,123 @@ alm_t alm_to_rtklib(const Galileo_Almanac& gal_alm)
 
     return rtklib_alm;
 }
+
+
+namespace
+{
+enum Rtklib_Ephemeris_Source
+{
+    SOURCE_GPS_LNAV = 1,
+    SOURCE_GPS_LNAV_PRE_2009,
+    SOURCE_GPS_CNAV,
+    SOURCE_GALILEO,
+    SOURCE_BEIDOU,
+    SOURCE_GLONASS
+};
+}  // namespace
+
+
+Rtklib_Ephemeris_Cache::Rtklib_Ephemeris_Cache()
+    : d_eph(MAXSAT + 1),
+      d_geph(MAXSAT + 1)
+{
+}
+
+
+void Rtklib_Ephemeris_Cache::clear()
+{
+    for (auto& slot : d_eph)
+        {
+            slot.valid = false;
+        }
+    for (auto& slot : d_geph)
+        {
+            slot.valid = false;
+        }
+}
+
+
+size_t Rtklib_Ephemeris_Cache::memory_bytes() const
+{
+    return d_eph.capacity() * sizeof(Eph_Slot) + d_geph.capacity() * sizeof(Geph_Slot);
+}
+
+
+template <typename Ephemeris, typename Converter>
+const eph_t& Rtklib_Ephemeris_Cache::lookup(int sat, const Issue& issue, const Ephemeris& eph, Converter converter)
+{
+    if (sat <= 0 or sat > MAXSAT)
+        {
+            d_conversions++;
+            d_uncached_eph = converter(eph);
+            return d_uncached_eph;
+        }
+    Eph_Slot& slot = d_eph[sat];
+    if (!slot.valid or slot.issue != issue)
+        {
+            d_conversions++;
+            slot.eph = converter(eph);
+            slot.issue = issue;
+            slot.valid = true;
+        }
+    return slot.eph;
+}
+
+
+const eph_t& Rtklib_Ephemeris_Cache::convert(const Galileo_Ephemeris& gal_eph)
+{
+    const Issue issue = {SOURCE_GALILEO, static_cast<double>(gal_eph.IOD_ephemeris), static_cast<double>(gal_eph.WN),
+        static_cast<double>(gal_eph.toe), static_cast<double>(gal_eph.toc), static_cast<double>(gal_eph.tow), gal_eph.M_0, gal_eph.af0};
+    return lookup(static_cast<int>(gal_eph.PRN) + NSATGPS + NSATGLO, issue, gal_eph,
+        [](const Galileo_Ephemeris& e) { return eph_to_rtklib(e); });
+}
+
+
+const eph_t& Rtklib_Ephemeris_Cache::convert(const Gps_Ephemeris& gps_eph, bool pre_2009_file)
+{
+    const Issue issue = {static_cast<double>(pre_2009_file ? SOURCE_GPS_LNAV_PRE_2009 : SOURCE_GPS_LNAV), static_cast<double>(gps_eph.IODE_SF2), static_cast<double>(gps_eph.WN),
+        static_cast<double>(gps_eph.toe), static_cast<double>(gps_eph.toc), static_cast<double>(gps_eph.tow), gps_eph.M_0, gps_eph.af0};
+    return lookup(static_cast<int>(gps_eph.PRN), issue, gps_eph,
+        [pre_2009_file](const Gps_Ephemeris& e) { return eph_to_rtklib(e, pre_2009_file); });
+}
+
+
+const eph_t& Rtklib_Ephemeris_Cache::convert(const Gps_CNAV_Ephemeris& gps_cnav_eph)
+{
+    const Issue issue = {SOURCE_GPS_CNAV, static_cast<double>(gps_cnav_eph.toe2), static_cast<double>(gps_cnav_eph.WN),
+        static_cast<double>(gps_cnav_eph.toe1), static_cast<double>(gps_cnav_eph.toc), static_cast<double>(gps_cnav_eph.tow), gps_cnav_eph.M_0, gps_cnav_eph.af0};
+    return lookup(static_cast<int>(gps_cnav_eph.PRN), issue, gps_cnav_eph,
+        [](const Gps_CNAV_Ephemeris& e) { return eph_to_rtklib(e); });
+}
+
+
+const eph_t& Rtklib_Ephemeris_Cache::convert(const Beidou_Dnav_Ephemeris& bei_eph)
+{
+    const Issue issue = {SOURCE_BEIDOU, bei_eph.AODE, static_cast<double>(bei_eph.WN),
+        static_cast<double>(bei_eph.toe), static_cast<double>(bei_eph.toc), static_cast<double>(bei_eph.tow), bei_eph.M_0, bei_eph.af0};
+    return lookup(static_cast<int>(bei_eph.PRN) + NSATGPS + NSATGLO + NSATGAL + NSATQZS, issue, bei_eph,
+        [](const Beidou_Dnav_Ephemeris& e) { return eph_to_rtklib(e); });
+}
+
+
+const geph_t& Rtklib_Ephemeris_Cache::convert(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& gnav_clock_model)
+{
+    const Issue issue = {SOURCE_GLONASS, glonass_gnav_eph.d_t_b, glonass_gnav_eph.d_t_k, glonass_gnav_eph.d_Xn,
+        glonass_gnav_eph.d_tau_n, static_cast<double>(glonass_gnav_eph.i_satellite_freq_channel), gnav_clock_model.d_tau_c, gnav_clock_model.d_tau_gps};
+    const int sat = static_cast<int>(glonass_gnav_eph.i_satellite_slot_number) + NSATGPS;
+    if (sat <= 0 or sat > MAXSAT)
+        {
+            d_conversions++;
+            d_uncached_geph = eph_to_rtklib(glonass_gnav_eph, gnav_clock_model);
+            return d_uncached_geph;
+        }
+    Geph_Slot& slot = d_geph[sat];
+    if (!slot.valid or slot.issue != issue)
+        {
+            d_conversions++;
+            slot.geph = eph_to_rtklib(glonass_gnav_eph, gnav_clock_model);
+            slot.issue = issue;
+            slot.valid = true;
+        }
+    return slot.geph;
+}
@@ -18,6 +18,10 @@
 #define GNSS_SDR_RTKLIB_CONVERSIONS_H
 
 #include "rtklib.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -53,6 +57,62 @@ geph_t eph_to_rtklib(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glona
 obsd_t insert_obs_to_rtklib(obsd_t& rtklib_obs, const Gnss_Synchro& gnss_synchro, int week, int band, bool pre_2009_file = false);
 
 
+/*!
+ * \brief Ephemerides already converted to their RTKLIB counterparts, in one
+ * slot per RTKLIB satellite number. A slot is converted again only when the
+ * source ephemeris of that satellite changes (new issue of data, reference
+ * times or week), so the PVT solver does not repeat the conversion of every
+ * satellite at every epoch.
+ */
+class Rtklib_Ephemeris_Cache
+{
+public:
+    Rtklib_Ephemeris_Cache();
+
+    const eph_t& convert(const Galileo_Ephemeris& gal_eph);
+    const eph_t& convert(const Gps_Ephemeris& gps_eph, bool pre_2009_file);
+    const eph_t& convert(const Gps_CNAV_Ephemeris& gps_cnav_eph);
+    const eph_t& convert(const Beidou_Dnav_Ephemeris& bei_eph);
+    const geph_t& convert(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& gnav_clock_model);
+
+    //! Forgets all the converted ephemerides
+    void clear();
+
+    //! Number of conversions actually performed
+    inline uint64_t conversions() const { return d_conversions; }
+
+    //! Heap memory held by the slots
+    size_t memory_bytes() const;
+
+private:
+    // Source message type and the fields that identify a set of ephemeris
+    using Issue = std::array<double, 8>;
+
+    struct Eph_Slot
+    {
+        Issue issue{};
+        bool valid{false};
+        eph_t eph{};
+    };
+
+    struct Geph_Slot
+    {
+        Issue issue{};
+        bool valid{false};
+        geph_t geph{};
+    };
+
+    template <typename Ephemeris, typename Converter>
+    const eph_t& lookup(int sat, const Issue& issue, const Ephemeris& eph, Converter converter);
+
+    std::vector<Eph_Slot> d_eph;
+    std::vector<Geph_Slot> d_geph;
+    eph_t d_uncached_eph{};
+    geph_t d_uncached_geph{};
+    uint64_t d_conversions{0};
+};
+
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_RTKLIB_CONVERSIONS_H
@@ -34,6 +34,7 @@
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
+#include <vector>
 
 /* constants -----------------------------------------------------------------*/
 
@@ -61,6 +62,8 @@ const double MAXCCORSSR = 1e-6 * SPEED_OF_LIGHT_M_S; /* max clock correction of
 const double MAXAGESSR = 90.0;                       /* max age of ssr orbit and clock (s) */
 const double MAXAGESSR_HRCLK = 10.0;                 /* max age of ssr high-rate clock (s) */
 const double STD_BRDCCLK = 30.0;                     /* error of broadcast clock (m) */
+const int EPHCACHE_STEP = 60;                        /* interval of the nodes of the broadcast state interpolation (s) */
+const double EPHCACHE_DT = 1e-3;                     /* half interval of the node velocities by central difference (s) */
 
 const int MAX_ITER_KEPLER = 30; /* max number of iteration of Kelpler */
 
@@ -764,6 +767,168 @@ int ephpos(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
 }
 
 
+/* broadcast satellite state at a node of the interpolation -----------------*/
+void ephnode(gtime_t time, const eph_t *eph, const geph_t *geph, double *rs,
+    double *dts, double *var)
+{
+    double rs1[3];
+    double rs2[3];
+    double dts1;
+    double dts2;
+    int i;
+
+    /* position and clock by the mean, velocity and drift by central difference */
+    if (eph)
+        {
+            eph2pos(timeadd(time, -EPHCACHE_DT), eph, rs1, &dts1, var);
+            eph2pos(timeadd(time, EPHCACHE_DT), eph, rs2, &dts2, var);
+        }
+    else
+        {
+            geph2pos(timeadd(time, -EPHCACHE_DT), geph, rs1, &dts1, var);
+            geph2pos(timeadd(time, EPHCACHE_DT), geph, rs2, &dts2, var);
+        }
+    for (i = 0; i < 3; i++)
+        {
+            rs[i] = 0.5 * (rs1[i] + rs2[i]);
+            rs[i + 3] = (rs2[i] - rs1[i]) / (2.0 * EPHCACHE_DT);
+        }
+    dts[0] = 0.5 * (dts1 + dts2);
+    dts[1] = (dts2 - dts1) / (2.0 * EPHCACHE_DT);
+}
+
+
+/* satellite position and clock by interpolated broadcast ephemeris ------------
+ * same as ephpos() with iode=-1 for gps, galileo, qzss, beidou and glonass,
+ * but the states of each satellite are computed every EPHCACHE_STEP s, and
+ * interpolated in between with cubic hermite polynomials of the positions and
+ * velocities (and clock biases and drifts). The nodes are kept, per thread,
+ * as long as the selected ephemeris does not change, so in most epochs a state
+ * costs a polynomial evaluation instead of the kepler equation (or the
+ * numerical integration of glonass orbits). The interpolation error is below
+ * 1 mm. Other systems use ephpos().
+ *-----------------------------------------------------------------------------*/
+int ephpos_interp(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
+    double *rs, double *dts, double *var, int *svh)
+{
+    struct ephcache_t
+    {
+        const void *eph;  /* selected ephemeris */
+        double key[4];    /* and some of its parameters, in case it is overwritten */
+        gtime_t t0;       /* time of the first node */
+        double rs[2][6];  /* position and velocity at the nodes */
+        double dts[2][2]; /* clock bias and drift at the nodes */
+        double var;       /* position and clock variance */
+        int n;            /* number of nodes (0: empty) */
+    };
+    thread_local std::vector<ephcache_t> cache;
+    const eph_t *eph = nullptr;
+    const geph_t *geph = nullptr;
+    double key[4];
+    double s;
+    double h;
+    double dt;
+    int i;
+    int j;
+    int sys;
+
+    sys = satsys(sat, nullptr);
+
+    if (sys == SYS_GPS || sys == SYS_GAL || sys == SYS_QZS || sys == SYS_BDS)
+        {
+            if (!(eph = seleph(teph, sat, -1, nav)))
+                {
+                    *svh = -1;
+                    return 0;
+                }
+            key[0] = static_cast<double>(eph->toe.time) + eph->toe.sec;
+            key[1] = eph->iode;
+            key[2] = eph->f0;
+            key[3] = eph->M0;
+            *svh = eph->svh;
+        }
+    else if (sys == SYS_GLO)
+        {
+            if (!(geph = selgeph(teph, sat, -1, nav)))
+                {
+                    *svh = -1;
+                    return 0;
+                }
+            key[0] = static_cast<double>(geph->toe.time) + geph->toe.sec;
+            key[1] = geph->iode;
+            key[2] = geph->taun;
+            key[3] = geph->pos[0];
+            *svh = geph->svh;
+        }
+    else
+        {
+            return ephpos(time, teph, sat, nav, -1, rs, dts, var, svh);
+        }
+    if (cache.empty())
+        {
+            cache.resize(MAXSAT);
+            for (auto &c : cache)
+                {
+                    c.n = 0;
+                }
+        }
+    ephcache_t &c = cache[sat - 1];
+    const void *sel = eph ? static_cast<const void *>(eph) : static_cast<const void *>(geph);
+    if (c.n > 0 && (c.eph != sel || c.key[0] != key[0] || c.key[1] != key[1] || c.key[2] != key[2] || c.key[3] != key[3]))
+        {
+            c.n = 0;
+        }
+    c.eph = sel;
+    for (i = 0; i < 4; i++)
+        {
+            c.key[i] = key[i];
+        }
+
+    /* nodes around the time */
+    gtime_t t0 = time;
+    t0.time -= t0.time % EPHCACHE_STEP;
+    t0.sec = 0.0;
+    if (c.n > 0 && timediff(t0, c.t0) == EPHCACHE_STEP)
+        {
+            /* next interval */
+            matcpy(c.rs[0], c.rs[1], 6, 1);
+            matcpy(c.dts[0], c.dts[1], 2, 1);
+            c.t0 = t0;
+            ephnode(timeadd(t0, EPHCACHE_STEP), eph, geph, c.rs[1], c.dts[1], &c.var);
+        }
+    else if (c.n == 0 || timediff(t0, c.t0) != 0.0)
+        {
+            c.t0 = t0;
+            ephnode(t0, eph, geph, c.rs[0], c.dts[0], &c.var);
+            ephnode(timeadd(t0, EPHCACHE_STEP), eph, geph, c.rs[1], c.dts[1], &c.var);
+            c.n = 2;
+        }
+
+    /* cubic hermite interpolation and its derivative */
+    h = EPHCACHE_STEP;
+    dt = timediff(time, c.t0);
+    s = dt / h;
+    const double h00 = (2.0 * s - 3.0) * s * s + 1.0;
+    const double h10 = ((s - 2.0) * s + 1.0) * s * h;
+    const double h01 = (3.0 - 2.0 * s) * s * s;
+    const double h11 = (s - 1.0) * s * s * h;
+    const double d00 = (6.0 * s - 6.0) * s / h;
+    const double d10 = (3.0 * s - 4.0) * s + 1.0;
+    const double d01 = (6.0 - 6.0 * s) * s / h;
+    const double d11 = (3.0 * s - 2.0) * s;
+    for (j = 0; j < 3; j++)
+        {
+            rs[j] = h00 * c.rs[0][j] + h10 * c.rs[0][j + 3] + h01 * c.rs[1][j] + h11 * c.rs[1][j + 3];
+            rs[j + 3] = d00 * c.rs[0][j] + d10 * c.rs[0][j + 3] + d01 * c.rs[1][j] + d11 * c.rs[1][j + 3];
+        }
+    dts[0] = h00 * c.dts[0][0] + h10 * c.dts[0][1] + h01 * c.dts[1][0] + h11 * c.dts[1][1];
+    dts[1] = d00 * c.dts[0][0] + d10 * c.dts[0][1] + d01 * c.dts[1][0] + d11 * c.dts[1][1];
+    *var = c.var;
+
+    return 1;
+}
+
+
 /* satellite position and clock with sbas correction -------------------------*/
 int satpos_sbas(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
     double *rs, double *dts, double *var, int *svh)
@@ -971,7 +1136,7 @@ int satpos(gtime_t time, gtime_t teph, int sat, int ephopt,
     switch (ephopt)
         {
         case EPHOPT_BRDC:
-            return ephpos(time, teph, sat, nav, -1, rs, dts, var, svh);
+            return ephpos_interp(time, teph, sat, nav, rs, dts, var, svh);
         case EPHOPT_SBAS:
             return satpos_sbas(time, teph, sat, nav, rs, dts, var, svh);
         case EPHOPT_SSRAPC:
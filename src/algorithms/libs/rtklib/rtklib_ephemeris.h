@@ -60,6 +60,11 @@ int ephclk(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
 // satellite position and clock by broadcast ephemeris
 int ephpos(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
     int iode, double *rs, double *dts, double *var, int *svh);
+// same by interpolation of the states of the selected ephemeris
+void ephnode(gtime_t time, const eph_t *eph, const geph_t *geph, double *rs,
+    double *dts, double *var);
+int ephpos_interp(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
+    double *rs, double *dts, double *var, int *svh);
 int satpos_sbas(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
     double *rs, double *dts, double *var, int *svh);
 int satpos_ssr(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
@@ -38,6 +38,7 @@
 
 #include "rtklib_ionex.h"
 #include "rtklib_rtkcmn.h"
+#include <algorithm>  // for std::upper_bound
 #include <cstring>
 
 /* get index -----------------------------------------------------------------*/
@@ -645,6 +646,76 @@ int iondelay(gtime_t time, const tec_t *tec, const double *pos,
 }
 
 
+/* ionosphere delay by two consecutive tec grids --------------------------------
+ * iondelay() of tec[0] and tec[1], which have the same layers, computing the
+ * pierce point and the mapping function of each layer once for both grids
+ * args   : (see iondelay())
+ *          double *delay    O   ionospheric delays of tec[0] and tec[1] (m)
+ *          double *var      O   variances of the delays (m^2)
+ *          int    *stat     O   status of each grid (1:ok,0:error)
+ * return : none
+ *-----------------------------------------------------------------------------*/
+void iondelay2(gtime_t time, const tec_t *tec, const double *pos,
+    const double *azel, int opt, double *delay, double *var, int *stat)
+{
+    const double fact = 40.30E16 / FREQ1 / FREQ1; /* tecu->L1 iono (m) */
+    double fs;
+    double posp[3] = {0};
+    double posp_m[3];
+    double vtec;
+    double rms;
+    double hion;
+    double rp;
+    double rot[2];
+    int i;
+    int m;
+
+    trace(3, "iondelay2: time=%s pos=%.1f %.1f azel=%.1f %.1f\n", time_str(time, 0),
+        pos[0] * R2D, pos[1] * R2D, azel[0] * R2D, azel[1] * R2D);
+
+    for (m = 0; m < 2; m++)
+        {
+            delay[m] = var[m] = 0.0;
+            stat[m] = 1;
+            /* earth rotation correction (sun-fixed coordinate) */
+            rot[m] = (opt & 1) ? 2.0 * GNSS_PI * timediff(time, tec[m].time) / 86400.0 : 0.0;
+        }
+    for (i = 0; i < tec->ndata[2] && (stat[0] || stat[1]); i++)
+        { /* for a layer */
+            hion = tec->hgts[0] + tec->hgts[2] * i;
+
+            /* ionospheric pierce point position */
+            fs = ionppp(pos, azel, tec->rb, hion, posp);
+
+            if (opt & 2)
+                {
+                    /* modified single layer mapping function (M-SLM) ref [2] */
+                    rp = tec->rb / (tec->rb + hion) * sin(0.9782 * (GNSS_PI / 2.0 - azel[1]));
+                    fs = 1.0 / sqrt(1.0 - rp * rp);
+                }
+            for (m = 0; m < 2; m++)
+                {
+                    if (!stat[m])
+                        {
+                            continue;
+                        }
+                    posp_m[0] = posp[0];
+                    posp_m[1] = posp[1] + rot[m];
+                    posp_m[2] = posp[2];
+
+                    /* interpolate tec grid data */
+                    if (!interptec(tec + m, i, posp_m, &vtec, &rms))
+                        {
+                            stat[m] = 0;
+                            continue;
+                        }
+                    delay[m] += fact * fs * vtec;
+                    var[m] += fact * fact * fs * fs * rms * rms;
+                }
+        }
+}
+
+
 /* ionosphere model by tec grid data -------------------------------------------
  * compute ionospheric delay by tec grid data
  * args   : gtime_t time     I   time (gpst)
@@ -679,13 +750,10 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
             *var = VAR_NOTEC;
             return 1;
         }
-    for (i = 0; i < nav->nt; i++)
-        {
-            if (timediff(nav->tec[i].time, time) > 0.0)
-                {
-                    break;
-                }
-        }
+    /* first grid after time (sorted by combtec()) */
+    i = static_cast<int>(std::upper_bound(nav->tec, nav->tec + nav->nt, time,
+                             [](gtime_t t, const tec_t &tec) { return timediff(tec.time, t) > 0.0; }) -
+                         nav->tec);
     if (i == 0 || i >= nav->nt)
         {
             trace(2, "%s: tec grid out of period\n", time_str(time, 0));
@@ -697,8 +765,17 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
             return 0;
         }
     /* ionospheric delay by tec grid data */
-    stat[0] = iondelay(time, nav->tec + i - 1, pos, azel, opt, dels, vars);
-    stat[1] = iondelay(time, nav->tec + i, pos, azel, opt, dels + 1, vars + 1);
+    const tec_t *tec = nav->tec + i - 1;
+    if (tec[0].ndata[2] == tec[1].ndata[2] && tec[0].rb == tec[1].rb &&
+        tec[0].hgts[0] == tec[1].hgts[0] && tec[0].hgts[2] == tec[1].hgts[2])
+        {
+            iondelay2(time, tec, pos, azel, opt, dels, vars, stat);
+        }
+    else
+        {
+            stat[0] = iondelay(time, tec, pos, azel, opt, dels, vars);
+            stat[1] = iondelay(time, tec + 1, pos, azel, opt, dels + 1, vars + 1);
+        }
 
     if (!stat[0] && !stat[1])
         {
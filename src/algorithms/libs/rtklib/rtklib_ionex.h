@@ -64,6 +64,8 @@ int interptec(const tec_t *tec, int k, const double *posp, double *value,
 
 int iondelay(gtime_t time, const tec_t *tec, const double *pos,
     const double *azel, int opt, double *delay, double *var);
+void iondelay2(gtime_t time, const tec_t *tec, const double *pos,
+    const double *azel, int opt, double *delay, double *var, int *stat);
 int iontec(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, int opt, double *delay, double *var);
 
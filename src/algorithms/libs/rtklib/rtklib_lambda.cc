@@ -303,11 +303,50 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
     double *s)
 {
     int info;
+    double *Z;
+
+    if (n <= 0 || m <= 0)
+        {
+            return -1;
+        }
+    Z = mat(n, n);
+    info = lambda_reuse(n, m, a, Q, F, s, Z, 0);
+    free(Z);
+    return info;
+}
+
+
+/* lambda/mlambda integer least-square estimation with a previous reduction ----
+ * same as lambda(), but the reduction matrix Z is also an input: if reuse is
+ * not 0, the lambda reduction starts from Qz=Z'*Q*Z instead of Q, so when Q
+ * is close to the one Z was computed for (the same ambiguities in the next
+ * epoch), Qz is already decorrelated and the reduction only needs a few
+ * integer gauss transformations and permutations. Any Z is valid, since it is
+ * unimodular, so the result does not depend on it (but for the search loop
+ * count). If the LD factorization of Qz fails, the reduction starts from Q.
+ * args   : int    n      I  number of float parameters
+ *          int    m      I  number of fixed solutions
+ *          double *a     I  float parameters (n x 1)
+ *          double *Q     I  covariance matrix of float parameters (n x n)
+ *          double *F     O  fixed solutions (n x m)
+ *          double *s     O  sum of squared residulas of fixed solutions (1 x m)
+ *          double *Z     IO lambda reduction matrix (n x n)
+ *          int    reuse  I  start the reduction from Z (0:from identity)
+ * return : status (0:ok,other:error)
+ * notes  : matrix stored by column-major order (fortran convention)
+ *-----------------------------------------------------------------------------*/
+int lambda_reuse(int n, int m, const double *a, const double *Q, double *F,
+    double *s, double *Z, int reuse)
+{
+    int i;
+    int j;
+    int info = -1;
     double *L;
     double *D;
-    double *Z;
     double *z;
     double *E;
+    double *QZ;
+    double *Qz;
 
     if (n <= 0 || m <= 0)
         {
@@ -315,12 +354,32 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
         }
     L = zeros(n, n);
     D = mat(n, 1);
-    Z = eye(n);
     z = mat(n, 1);
     E = mat(n, m);
 
-    /* LD factorization */
-    if (!(info = LD(n, Q, L, D)))
+    /* LD factorization of the previously reduced covariance */
+    if (reuse)
+        {
+            QZ = mat(n, n);
+            Qz = mat(n, n);
+            matmul("NN", n, n, n, 1.0, Q, Z, 0.0, QZ);
+            matmul("TN", n, n, n, 1.0, Z, QZ, 0.0, Qz); /* Qz=Z'*Q*Z */
+            info = LD(n, Qz, L, D);
+            free(QZ);
+            free(Qz);
+        }
+    if (info)
+        {
+            for (i = 0; i < n; i++)
+                {
+                    for (j = 0; j < n; j++)
+                        {
+                            Z[i + j * n] = i == j ? 1.0 : 0.0;
+                        }
+                }
+            info = LD(n, Q, L, D);
+        }
+    if (!info)
         {
             /* lambda reduction */
             reduction(n, L, D, Z);
@@ -334,7 +393,6 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
         }
     free(L);
     free(D);
-    free(Z);
     free(z);
     free(E);
     return info;
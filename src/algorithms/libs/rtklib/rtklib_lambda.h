@@ -66,6 +66,9 @@ int search(int n, int m, const double *L, const double *D,
 
 int lambda(int n, int m, const double *a, const double *Q, double *F, double *s);
 
+int lambda_reuse(int n, int m, const double *a, const double *Q, double *F,
+    double *s, double *Z, int reuse);
+
 int lambda_reduction(int n, const double *Q, double *Z);
 
 int lambda_search(int n, int m, const double *a, const double *Q,
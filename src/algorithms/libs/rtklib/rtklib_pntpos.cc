@@ -32,8 +32,20 @@
 #include "rtklib_pntpos.h"
 #include "rtklib_ephemeris.h"
 #include "rtklib_ionex.h"
+#include "rtklib_pool.h"
 #include "rtklib_sbas.h"
+#include <algorithm>  // for std::fill
 #include <cstring>
+#include <memory>
+#include <vector>
+
+pntpos_scratch_t *pntpos_scratch()
+{
+    /* allocated on first use, only by the threads that run the positioning */
+    thread_local std::unique_ptr<pntpos_scratch_t> scratch(new pntpos_scratch_t());
+    return scratch.get();
+}
+
 
 /* pseudorange measurement error variance ------------------------------------*/
 double varerr(const prcopt_t *opt, double el, int sys)
@@ -397,6 +409,49 @@ int tropcorr(gtime_t time, const nav_t *nav __attribute__((unused)), const doubl
 }
 
 
+/* ionospheric and tropospheric corrections, memoized per satellite ----------*/
+int atmoscorr(gtime_t time, const nav_t *nav, int sat, const double *pos,
+    const double *azel, int ionoopt, int tropopt, double *dion, double *vion,
+    double *dtrp, double *vtrp)
+{
+    atmos_memo_t *memo = pntpos_scratch()->atmos + sat - 1;
+
+    if (memo->nav != nav || memo->ionoopt != ionoopt || memo->tropopt != tropopt ||
+        timediff(memo->time, time) != 0.0 ||
+        fabs(memo->pos[0] - pos[0]) * RE_WGS84 > ATMOS_MEMO_DPOS ||
+        fabs(memo->pos[1] - pos[1]) * RE_WGS84 > ATMOS_MEMO_DPOS ||
+        fabs(memo->pos[2] - pos[2]) > ATMOS_MEMO_DPOS ||
+        fabs(memo->azel[0] - azel[0]) > ATMOS_MEMO_DANG ||
+        fabs(memo->azel[1] - azel[1]) > ATMOS_MEMO_DANG)
+        {
+            memo->nav = nav;
+            memo->time = time;
+            memo->ionoopt = ionoopt;
+            memo->tropopt = tropopt;
+            matcpy(memo->pos, pos, 3, 1);
+            matcpy(memo->azel, azel, 2, 1);
+            memo->dtrp = memo->vtrp = 0.0;
+            if (!ionocorr(time, nav, sat, pos, azel, ionoopt, &memo->dion, &memo->vion))
+                {
+                    memo->stat = 0;
+                }
+            else if (!tropcorr(time, nav, pos, azel, tropopt, &memo->dtrp, &memo->vtrp))
+                {
+                    memo->stat = -1;
+                }
+            else
+                {
+                    memo->stat = 1;
+                }
+        }
+    *dion = memo->dion;
+    *vion = memo->vion;
+    *dtrp = memo->dtrp;
+    *vtrp = memo->vtrp;
+    return memo->stat;
+}
+
+
 /* pseudorange residuals -----------------------------------------------------*/
 int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
@@ -420,6 +475,7 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     int j;
     int nv = 0;
     int sys;
+    int stat;
     int mask[4] = {0};
 
     trace(3, "resprng : n=%d\n", n);
@@ -476,11 +532,12 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                     continue;
                 }
 
-            /* ionospheric corrections */
-            if (!ionocorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
-                    iter > 0 ? opt->ionoopt : IONOOPT_BRDC, &dion, &vion))
+            /* ionospheric and tropospheric corrections */
+            if ((stat = atmoscorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
+                     iter > 0 ? opt->ionoopt : IONOOPT_BRDC,
+                     iter > 0 ? opt->tropopt : TROPOPT_SAAS, &dion, &vion, &dtrp, &vtrp)) <= 0)
                 {
-                    trace(4, "ionocorr error\n");
+                    trace(4, "%s error\n", stat == 0 ? "ionocorr" : "tropocorr");
                     continue;
                 }
 
@@ -489,13 +546,6 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                 {
                     dion *= std::pow(lam_L1 / LAM_CARR[0], 2.0);
                 }
-            /* tropospheric corrections */
-            if (!tropcorr(obs[i].time, nav, pos, azel + i * 2,
-                    iter > 0 ? opt->tropopt : TROPOPT_SAAS, &dtrp, &vtrp))
-                {
-                    trace(4, "tropocorr error\n");
-                    continue;
-                }
             /* pseudorange residual */
             v[nv] = P - (r + dtr - SPEED_OF_LIGHT_M_S * dts[i * 2] + dion + dtrp);
 
@@ -622,9 +672,10 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
 
     trace(3, "estpos  : n=%d\n", n);
 
-    v = mat(n + 4, 1);
-    H = mat(NX, n + 4);
-    var = mat(n + 4, 1);
+    pntpos_scratch_t *scratch = pntpos_scratch();
+    v = scratch->est_v;
+    H = scratch->est_H;
+    var = scratch->est_var;
 
     for (i = 0; i < 3; i++)
         {
@@ -689,9 +740,6 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
                         {
                             sol->stat = opt->sateph == EPHOPT_SBAS ? SOLQ_SBAS : SOLQ_SINGLE;
                         }
-                    free(v);
-                    free(H);
-                    free(var);
                     msg = msg_aux;
                     return stat;
                 }
@@ -701,31 +749,44 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
             std::snprintf(msg_aux, sizeof(msg_aux), "iteration divergent i=%d", i);
         }
 
-    free(v);
-    free(H);
-    free(var);
     msg = msg_aux;
 
     return 0;
 }
 
 
+namespace
+{
+/* result of the raim fde without a satellite --------------------------------*/
+struct raim_hypothesis_t
+{
+    sol_t sol;
+    double azel[2 * MAXOBS];
+    double resp[MAXOBS];
+    int vsat[MAXOBS];
+    int stat;
+    char msg[128];
+};
+
+
+/* pool shared by the solvers, started on first use with the given threads --*/
+Rtklib_Pool *raim_pool(int threads)
+{
+    static Rtklib_Pool pool(threads);
+    return &pool;
+}
+}  // namespace
+
+
 /* raim fde (failure detection and exclution) -------------------------------*/
 int raim_fde(const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
     const nav_t *nav, const prcopt_t *opt, sol_t *sol,
     double *azel, int *vsat, double *resp, char *msg)
 {
-    obsd_t *obs_e;
-    sol_t sol_e = {{0, 0}, {}, {}, {}, '0', '0', '0', 0.0, 0.0, 0.0};
+    thread_local std::vector<raim_hypothesis_t> hypotheses;
     char tstr[32];
     char name[16];
-    char msg_e[128];
-    double *rs_e;
-    double *dts_e;
-    double *vare_e;
-    double *azel_e;
-    double *resp_e;
     double rms_e;
     double rms = 100.0;
     int i;
@@ -733,53 +794,71 @@ int raim_fde(const obsd_t *obs, int n, const double *rs,
     int k;
     int nvsat;
     int stat = 0;
-    int *svh_e;
-    int *vsat_e;
     int sat = 0;
 
     trace(3, "raim_fde: %s n=%2d\n", time_str(obs[0].time, 0), n);
 
-    if (!(obs_e = static_cast<obsd_t *>(malloc(sizeof(obsd_t) * n))))
+    if (static_cast<int>(hypotheses.size()) < n)
         {
-            return 0;
+            hypotheses.resize(n);
         }
-    rs_e = mat(6, n);
-    dts_e = mat(2, n);
-    vare_e = mat(1, n);
-    azel_e = zeros(2, n);
-    svh_e = imat(1, n);
-    vsat_e = imat(1, n);
-    resp_e = mat(1, n);
-
-    for (i = 0; i < n; i++)
+    raim_hypothesis_t *results = hypotheses.data();  // thread_local, not captured by the lambda
+
+    /* estimate receiver position without each satellite. All the hypotheses
+       start from the same position, so they can be solved in any order */
+    const auto exclude = [&](int i_e) {
+        pntpos_scratch_t *scratch = pntpos_scratch();
+        raim_hypothesis_t &h = results[i_e];
+        int k_e = 0;
+        for (int j_e = 0; j_e < n; j_e++)
+            {
+                if (j_e == i_e)
+                    {
+                        continue;
+                    }
+                scratch->obs_e[k_e] = obs[j_e];
+                matcpy(scratch->rs_e + 6 * k_e, rs + 6 * j_e, 6, 1);
+                matcpy(scratch->dts_e + 2 * k_e, dts + 2 * j_e, 2, 1);
+                scratch->vare_e[k_e] = vare[j_e];
+                scratch->svh_e[k_e++] = svh[j_e];
+            }
+        h.sol = sol_t{{0, 0}, {}, {}, {}, '0', '0', '0', 0.0, 0.0, 0.0};
+        for (int j_e = 0; j_e < 3; j_e++)
+            {
+                h.sol.rr[j_e] = sol->rr[j_e];
+            }
+        std::fill(h.azel, h.azel + 2 * (n - 1), 0.0);
+        h.stat = estpos(scratch->obs_e, n - 1, scratch->rs_e, scratch->dts_e, scratch->vare_e, scratch->svh_e, nav, opt, &h.sol, h.azel,
+            h.vsat, h.resp, h.msg);
+    };
+    if (opt->raimthreads > 1)
         {
-            /* satellite exclution */
-            for (j = k = 0; j < n; j++)
+            raim_pool(opt->raimthreads)->run(n, exclude);
+        }
+    else
+        {
+            for (i = 0; i < n; i++)
                 {
-                    if (j == i)
-                        {
-                            continue;
-                        }
-                    obs_e[k] = obs[j];
-                    matcpy(rs_e + 6 * k, rs + 6 * j, 6, 1);
-                    matcpy(dts_e + 2 * k, dts + 2 * j, 2, 1);
-                    vare_e[k] = vare[j];
-                    svh_e[k++] = svh[j];
+                    exclude(i);
                 }
-            /* estimate receiver position without a satellite */
-            if (!estpos(obs_e, n - 1, rs_e, dts_e, vare_e, svh_e, nav, opt, &sol_e, azel_e,
-                    vsat_e, resp_e, msg_e))
+        }
+
+    /* select the hypothesis with the lowest residuals */
+    for (i = 0; i < n; i++)
+        {
+            const raim_hypothesis_t &h = results[i];
+            if (!h.stat)
                 {
                     trace(3, "raim_fde: exsat=%2d (%s)\n", obs[i].sat, msg);
                     continue;
                 }
             for (j = nvsat = 0, rms_e = 0.0; j < n - 1; j++)
                 {
-                    if (!vsat_e[j])
+                    if (!h.vsat[j])
                         {
                             continue;
                         }
-                    rms_e += std::pow(resp_e[j], 2.0);
+                    rms_e += std::pow(h.resp[j], 2.0);
                     nvsat++;
                 }
             if (nvsat < 5)
@@ -804,16 +883,16 @@ int raim_fde(const obsd_t *obs, int n, const double *rs,
                         {
                             continue;
                         }
-                    matcpy(azel + 2 * j, azel_e + 2 * k, 2, 1);
-                    vsat[j] = vsat_e[k];
-                    resp[j] = resp_e[k++];
+                    matcpy(azel + 2 * j, h.azel + 2 * k, 2, 1);
+                    vsat[j] = h.vsat[k];
+                    resp[j] = h.resp[k++];
                 }
             stat = 1;
-            *sol = sol_e;
+            *sol = h.sol;
             sat = obs[i].sat;
             rms = rms_e;
             vsat[i] = 0;
-            std::strncpy(msg, msg_e, 128);
+            std::strncpy(msg, h.msg, 128);
         }
     if (stat)
         {
@@ -821,14 +900,6 @@ int raim_fde(const obsd_t *obs, int n, const double *rs,
             satno2id(sat, name);
             trace(2, "%s: %s excluded by raim\n", tstr + 11, name);
         }
-    free(obs_e);
-    free(rs_e);
-    free(dts_e);
-    free(vare_e);
-    free(azel_e);
-    free(svh_e);
-    free(vsat_e);
-    free(resp_e);
 
     return stat;
 }
@@ -924,8 +995,8 @@ void estvel(const obsd_t *obs, int n, const double *rs, const double *dts,
 
     trace(3, "estvel  : n=%d\n", n);
 
-    v = mat(n, 1);
-    H = mat(4, n);
+    v = pntpos_scratch()->vel_v;
+    H = pntpos_scratch()->vel_H;
 
     for (i = 0; i < MAXITR; i++)
         {
@@ -955,8 +1026,6 @@ void estvel(const obsd_t *obs, int n, const double *rs, const double *dts,
                     break;
                 }
         }
-    free(v);
-    free(H);
 }
 
 
@@ -999,16 +1068,25 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
             return 0;
         }
 
+    if (n > MAXOBS)
+        {
+            /* as many as the work arrays, vsat and svh can hold */
+            trace(2, "pntpos  : n=%d observations, only %d used\n", n, MAXOBS);
+            n = MAXOBS;
+        }
+
     trace(3, "pntpos  : tobs=%s n=%d\n", time_str(obs[0].time, 3), n);
 
     sol->time = obs[0].time;
     msg[0] = '\0';
 
-    rs = mat(6, n);
-    dts = mat(2, n);
-    var = mat(1, n);
-    azel_ = zeros(2, n);
-    resp = mat(1, n);
+    pntpos_scratch_t *scratch = pntpos_scratch();
+    rs = scratch->rs;
+    dts = scratch->dts;
+    var = scratch->var;
+    azel_ = scratch->azel;
+    resp = scratch->resp;
+    std::fill(azel_, azel_ + 2 * n, 0.0);
 
     if (opt_.mode != PMODE_SINGLE)
         { /* for precise positioning */
@@ -1064,10 +1142,5 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
                     ssat[obs[i].sat - 1].resp[0] = resp[i];
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel_);
-    free(resp);
     return stat;
 }
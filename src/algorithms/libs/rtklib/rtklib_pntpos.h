@@ -41,6 +41,62 @@ const int NX = 4 + 3;         //!< # of estimated parameters
 const int MAXITR = 10;        //!< max number of iteration for point pos
 const double ERR_ION = 5.0;   //!< ionospheric delay std (m)
 const double ERR_TROP = 3.0;  //!< tropspheric delay std (m)
+const double ATMOS_MEMO_DPOS = 0.1;   //!< max change of receiver lat/lon (as m on the surface) and height to reuse the corrections
+const double ATMOS_MEMO_DANG = 1e-7;  //!< max change of azimuth/elevation to reuse the corrections (rad)
+
+
+/* atmospheric corrections of a satellite, as last computed by atmoscorr() --*/
+typedef struct
+{
+    const nav_t *nav; /* navigation data (nullptr: empty) */
+    gtime_t time;     /* time of the observation */
+    double pos[3];    /* receiver position {lat,lon,h} (rad|m) */
+    double azel[2];   /* azimuth/elevation angle {az,el} (rad) */
+    int ionoopt;      /* ionospheric correction option */
+    int tropopt;      /* tropospheric correction option */
+    int stat;         /* status (1:ok,0:error) */
+    double dion;      /* ionospheric delay (L1) (m) */
+    double vion;      /* ionospheric delay (L1) variance (m^2) */
+    double dtrp;      /* tropospheric delay (m) */
+    double vtrp;      /* tropospheric delay variance (m^2) */
+} atmos_memo_t;
+
+/* scratch memory of the single point positioning ------------------------------
+ * work arrays of pntpos(), estpos(), raim_fde() and estvel(), sized for MAXOBS
+ * observations. One is kept per thread and reused in every epoch, so that a
+ * fix (including the raim fde, which redoes estpos() for each excluded
+ * satellite) does not touch the heap.
+ *-----------------------------------------------------------------------------*/
+typedef struct
+{
+    /* pntpos */
+    double rs[6 * MAXOBS];
+    double dts[2 * MAXOBS];
+    double var[MAXOBS];
+    double azel[2 * MAXOBS];
+    double resp[MAXOBS];
+    /* estpos (the residuals may include up to 4 constraints) */
+    double est_v[MAXOBS + 4];
+    double est_H[NX * (MAXOBS + 4)];
+    double est_var[MAXOBS + 4];
+    /* raim_fde */
+    obsd_t obs_e[MAXOBS];
+    double rs_e[6 * MAXOBS];
+    double dts_e[2 * MAXOBS];
+    double vare_e[MAXOBS];
+    double azel_e[2 * MAXOBS];
+    double resp_e[MAXOBS];
+    int svh_e[MAXOBS];
+    int vsat_e[MAXOBS];
+    /* estvel */
+    double vel_v[MAXOBS];
+    double vel_H[4 * MAXOBS];
+    /* atmoscorr, by satellite number */
+    atmos_memo_t atmos[MAXSAT];
+} pntpos_scratch_t;
+
+/* scratch memory of the calling thread --------------------------------------*/
+pntpos_scratch_t *pntpos_scratch();
 
 
 /* pseudorange measurement error variance ------------------------------------*/
@@ -87,6 +143,20 @@ int ionocorr(gtime_t time, const nav_t *nav, int sat, const double *pos,
 int tropcorr(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, int tropopt, double *trp, double *var);
 
+/* ionospheric and tropospheric corrections ------------------------------------
+ * ionocorr() and tropcorr() of a satellite, reused from the previous call for
+ * that satellite at the same epoch while the receiver position and the
+ * azimuth/elevation angle stay within ATMOS_MEMO_DPOS/ATMOS_MEMO_DANG of the
+ * previous ones (the corrections then change by less than 0.5 mm). That is the
+ * case in the last iterations of estpos() and in the estpos() runs of
+ * raim_fde().
+ * args   : same as ionocorr() and tropcorr()
+ * return : status(1:ok,0:ionospheric correction error,-1:tropospheric error)
+ *-----------------------------------------------------------------------------*/
+int atmoscorr(gtime_t time, const nav_t *nav, int sat, const double *pos,
+    const double *azel, int ionoopt, int tropopt, double *dion, double *vion,
+    double *dtrp, double *vtrp);
+
 /* pseudorange residuals -----------------------------------------------------*/
 int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
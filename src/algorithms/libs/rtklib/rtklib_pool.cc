@@ -0,0 +1,95 @@
+/*!
+ * \file rtklib_pool.cc
+ * \brief Fork-join thread pool of the RTKLIB positioning
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_pool.h"
+
+
+Rtklib_Pool::Rtklib_Pool(int threads)
+{
+    for (int i = 1; i < threads; i++)
+        {
+            d_threads.emplace_back(&Rtklib_Pool::worker, this);
+        }
+}
+
+
+Rtklib_Pool::~Rtklib_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_start_cond.notify_all();
+    for (auto &thread : d_threads)
+        {
+            thread.join();
+        }
+}
+
+
+void Rtklib_Pool::run(int n, const std::function<void(int)> &job)
+{
+    std::lock_guard<std::mutex> run_lock(d_run_mutex);  // one caller at a time
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_job = &job;
+        d_jobs = n;
+        d_next = 0;
+        d_done = 0;
+        d_generation++;
+    }
+    d_start_cond.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_done_cond.wait(lock, [this] { return d_done == d_jobs; });
+    d_job = nullptr;
+}
+
+
+void Rtklib_Pool::work()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (d_job != nullptr && d_next < d_jobs)
+        {
+            const int i = d_next++;
+            const auto *job = d_job;
+            lock.unlock();
+            (*job)(i);
+            lock.lock();
+            if (++d_done == d_jobs)
+                {
+                    d_done_cond.notify_all();
+                }
+        }
+}
+
+
+void Rtklib_Pool::worker()
+{
+    uint64_t generation = 0;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_start_cond.wait(lock, [this, generation] { return d_stop || d_generation != generation; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                generation = d_generation;
+            }
+            work();
+        }
+}
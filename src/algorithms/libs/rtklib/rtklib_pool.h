@@ -0,0 +1,70 @@
+/*!
+ * \file rtklib_pool.h
+ * \brief Fork-join thread pool of the RTKLIB positioning
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_POOL_H
+#define GNSS_SDR_RTKLIB_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup RTKLIB_Library
+ * \{ */
+
+
+/*!
+ * \brief run(n, job) runs job(0) ... job(n-1) in the calling thread and in
+ * threads-1 worker threads, and returns when all of them are done.
+ *
+ * Calls to run() from different threads are serialized. A job may call run()
+ * of another pool, but not of its own.
+ */
+class Rtklib_Pool
+{
+public:
+    explicit Rtklib_Pool(int threads);
+    ~Rtklib_Pool();
+
+    Rtklib_Pool(const Rtklib_Pool &) = delete;
+    Rtklib_Pool &operator=(const Rtklib_Pool &) = delete;
+
+    void run(int n, const std::function<void(int)> &job);
+
+private:
+    void work();
+    void worker();
+
+    std::vector<std::thread> d_threads;
+    std::mutex d_run_mutex;
+    std::mutex d_mutex;
+    std::condition_variable d_start_cond;
+    std::condition_variable d_done_cond;
+    const std::function<void(int)> *d_job{nullptr};
+    uint64_t d_generation{0};
+    int d_jobs{0};
+    int d_next{0};
+    int d_done{0};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTKLIB_POOL_H
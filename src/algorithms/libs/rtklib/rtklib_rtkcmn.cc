@@ -46,6 +46,12 @@ const double GPST0[] = {1980, 1, 6, 0, 0, 0}; /* gps time reference */
 const double GST0[] = {1999, 8, 22, 0, 0, 0}; /* galileo system time reference */
 const double BDT0[] = {2006, 1, 1, 0, 0, 0};  /* beidou time reference */
 
+/* time references above as time_t, so that the week/tow conversions do not
+ * go through the calendar at every call */
+const time_t GPST0_TIME = 315964800;  /* epoch2time(GPST0) */
+const time_t GST0_TIME = 935280000;   /* epoch2time(GST0) */
+const time_t BDT0_TIME = 1136073600;  /* epoch2time(BDT0) */
+
 static double timeoffset_ = 0.0;
 
 double leaps[MAXLEAPS + 1][7] = {/* leap seconds (y,m,d,h,m,s,utc-gpst) */
@@ -212,6 +218,9 @@ extern "C"
     extern void dgetrs_(char *, int *, int *, double *, int *, int *, double *, int *, int *);
 }
 
+/* max order of the matrices inverted with work arrays on the stack ----------*/
+const int SMALL_MATRIX_ORDER = 16;
+
 
 /* function prototypes -------------------------------------------------------*/
 
@@ -1129,6 +1138,133 @@ void matcpy(double *A, const double *B, int n, int m)
 /* matrix routines -----------------------------------------------------------*/
 
 
+namespace
+{
+/* inverse of matrix of order N ------------------------------------------------
+ * gauss-jordan elimination with partial pivoting, in place. N is known at
+ * compile time, so the loops are unrolled, and there are no lapack calls for
+ * the small matrices (N<=10) of the single point positioning and the kalman
+ * filter updates with few measurements.
+ * return : status (0:ok,>0:the pivot of that column is zero, as dgetrf)
+ *-----------------------------------------------------------------------------*/
+template <int N>
+int matinv_fixed(double *A)
+{
+    int perm[N];
+    int i;
+    int j;
+    int k;
+    int r;
+    double amax;
+    double piv;
+    double f;
+
+    for (k = 0; k < N; k++)
+        {
+            for (i = r = k, amax = 0.0; i < N; i++)
+                {
+                    if (fabs(A[i + k * N]) > amax)
+                        {
+                            amax = fabs(A[i + k * N]);
+                            r = i;
+                        }
+                }
+            if (amax == 0.0)
+                {
+                    return k + 1;
+                }
+            perm[k] = r;
+            if (r != k)
+                {
+                    for (j = 0; j < N; j++)
+                        {
+                            f = A[k + j * N];
+                            A[k + j * N] = A[r + j * N];
+                            A[r + j * N] = f;
+                        }
+                }
+            piv = 1.0 / A[k + k * N];
+            A[k + k * N] = 1.0;
+            for (j = 0; j < N; j++)
+                {
+                    A[k + j * N] *= piv;
+                }
+            for (i = 0; i < N; i++)
+                {
+                    if (i == k)
+                        {
+                            continue;
+                        }
+                    f = A[i + k * N];
+                    A[i + k * N] = 0.0;
+                    for (j = 0; j < N; j++)
+                        {
+                            A[i + j * N] -= f * A[k + j * N];
+                        }
+                }
+        }
+    /* undo the row permutations by swapping columns in the reverse order */
+    for (k = N - 1; k >= 0; k--)
+        {
+            if (perm[k] != k)
+                {
+                    for (i = 0; i < N; i++)
+                        {
+                            f = A[i + k * N];
+                            A[i + k * N] = A[i + perm[k] * N];
+                            A[i + perm[k] * N] = f;
+                        }
+                }
+        }
+    return 0;
+}
+
+
+/* least square estimation with N parameters -----------------------------------
+ * same as lsq(), for a number of parameters known at compile time
+ *-----------------------------------------------------------------------------*/
+template <int N>
+int lsq_fixed(const double *A, const double *y, int m, double *x, double *Q)
+{
+    double Ay[N];
+    double sum;
+    int i;
+    int j;
+    int k;
+    int info;
+
+    for (i = 0; i < N; i++)
+        {
+            for (j = 0, sum = 0.0; j < m; j++)
+                {
+                    sum += A[i + j * N] * y[j];
+                }
+            Ay[i] = sum; /* Ay=A*y */
+            for (k = 0; k <= i; k++)
+                {
+                    for (j = 0, sum = 0.0; j < m; j++)
+                        {
+                            sum += A[i + j * N] * A[k + j * N];
+                        }
+                    Q[i + k * N] = Q[k + i * N] = sum; /* Q=A*A' */
+                }
+        }
+    if (!(info = matinv_fixed<N>(Q)))
+        {
+            for (i = 0; i < N; i++)
+                {
+                    for (k = 0, sum = 0.0; k < N; k++)
+                        {
+                            sum += Q[i + k * N] * Ay[k];
+                        }
+                    x[i] = sum; /* x=Q^-1*Ay */
+                }
+        }
+    return info;
+}
+}  // namespace
+
+
 /* multiply matrix (wrapper of blas dgemm) -------------------------------------
  * multiply matrix by matrix (C=alpha*A*B+beta*C)
  * args   : char   *tr       I  transpose flags ("N":normal,"T":transpose)
@@ -1161,6 +1297,43 @@ int matinv(double *A, int n)
     double *work;
     int info;
     int lwork = n * 16;
+    switch (n)
+        {
+        case 1:
+            return matinv_fixed<1>(A);
+        case 2:
+            return matinv_fixed<2>(A);
+        case 3:
+            return matinv_fixed<3>(A);
+        case 4:
+            return matinv_fixed<4>(A);
+        case 5:
+            return matinv_fixed<5>(A);
+        case 6:
+            return matinv_fixed<6>(A);
+        case 7:
+            return matinv_fixed<7>(A);
+        case 8:
+            return matinv_fixed<8>(A);
+        case 9:
+            return matinv_fixed<9>(A);
+        case 10:
+            return matinv_fixed<10>(A);
+        default:
+            break;
+        }
+    if (n <= SMALL_MATRIX_ORDER)
+        {
+            /* other small matrices are inverted without heap */
+            int ipiv_small[SMALL_MATRIX_ORDER];
+            double work_small[SMALL_MATRIX_ORDER * 16];
+            dgetrf_(&n, &n, A, &n, ipiv_small, &info);
+            if (!info)
+                {
+                    dgetri_(&n, A, &n, ipiv_small, work_small, &lwork, &info);
+                }
+            return info;
+        }
     int *ipiv = imat(n, 1);
 
     work = mat(lwork, 1);
@@ -1222,6 +1395,7 @@ int solve(const char *tr, const double *A, const double *Y, int n,
 int lsq(const double *A, const double *y, int n, int m, double *x,
     double *Q)
 {
+    double Ay_small[SMALL_MATRIX_ORDER];
     double *Ay;
     int info;
 
@@ -1229,14 +1403,38 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
         {
             return -1;
         }
-    Ay = mat(n, 1);
+    switch (n)
+        {
+        case 3:
+            return lsq_fixed<3>(A, y, m, x, Q);
+        case 4:
+            return lsq_fixed<4>(A, y, m, x, Q); /* velocity */
+        case 5:
+            return lsq_fixed<5>(A, y, m, x, Q);
+        case 6:
+            return lsq_fixed<6>(A, y, m, x, Q);
+        case 7:
+            return lsq_fixed<7>(A, y, m, x, Q); /* position and clocks */
+        case 8:
+            return lsq_fixed<8>(A, y, m, x, Q);
+        case 9:
+            return lsq_fixed<9>(A, y, m, x, Q);
+        case 10:
+            return lsq_fixed<10>(A, y, m, x, Q);
+        default:
+            break;
+        }
+    Ay = n <= SMALL_MATRIX_ORDER ? Ay_small : mat(n, 1);
     matmul("NN", n, 1, m, 1.0, A, y, 0.0, Ay); /* Ay=A*y */
     matmul("NT", n, n, m, 1.0, A, A, 0.0, Q);  /* Q=A*A' */
     if (!(info = matinv(Q, n)))
         {
             matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
         }
-    free(Ay);
+    if (Ay != Ay_small)
+        {
+            free(Ay);
+        }
     return info;
 }
 
@@ -1257,6 +1455,8 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
  * return : status (0:ok,<0:error)
  * notes  : matirix stored by column-major order (fortran convention)
  *          if state x[i]==0.0, not updates state x[i]/P[i+i*n]
+ *          P is symmetric, so Pp=P-K*(P*H)', which costs O(n^2*m) instead of
+ *          O(n^3), and only the nonzero elements of H are used in P*H
  *-----------------------------------------------------------------------------*/
 int filter_(const double *x, const double *P, const double *H,
     const double *v, const double *R, int n, int m,
@@ -1265,24 +1465,69 @@ int filter_(const double *x, const double *P, const double *H,
     double *F = mat(n, m);
     double *Q = mat(m, m);
     double *K = mat(n, m);
-    double *I = eye(n);
+    int *nz = imat(n, m);
+    int *nnz = imat(m, 1);
+    double h;
+    double sum;
+    int i;
+    int j;
+    int k;
+    int l;
     int info;
 
-    matcpy(Q, R, m, m);
+    /* states of each measurement (few of them: position, clocks, tropos and
+       those of a satellite), so that P*H costs O(n) per measurement */
+    for (j = 0; j < m; j++)
+        {
+            for (i = nnz[j] = 0; i < n; i++)
+                {
+                    if (H[i + j * n] != 0.0)
+                        {
+                            nz[nnz[j]++ + j * n] = i;
+                        }
+                }
+        }
     matcpy(xp, x, n, 1);
-    matmul("NN", n, m, n, 1.0, P, H, 0.0, F); /* Q=H'*P*H+R */
-    matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
+    for (j = 0; j < m; j++)
+        { /* F=P*H */
+            for (i = 0; i < n; i++)
+                {
+                    F[i + j * n] = 0.0;
+                }
+            for (l = 0; l < nnz[j]; l++)
+                {
+                    k = nz[l + j * n];
+                    h = H[k + j * n];
+                    for (i = 0; i < n; i++)
+                        {
+                            F[i + j * n] += P[i + k * n] * h;
+                        }
+                }
+        }
+    for (j = 0; j < m; j++)
+        { /* Q=H'*P*H+R */
+            for (i = 0; i < m; i++)
+                {
+                    for (l = 0, sum = 0.0; l < nnz[i]; l++)
+                        {
+                            k = nz[l + i * n];
+                            sum += H[k + i * n] * F[k + j * n];
+                        }
+                    Q[i + j * m] = R[i + j * m] + sum;
+                }
+        }
     if (!(info = matinv(Q, m)))
         {
             matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
             matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
-            matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
-            matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
+            matcpy(Pp, P, n, n);                        /* Pp=(I-K*H')*P=P-K*F' */
+            matmul("NT", n, n, m, -1.0, K, F, 1.0, Pp);
         }
     free(F);
     free(Q);
     free(K);
-    free(I);
+    free(nz);
+    free(nnz);
     return info;
 }
 
@@ -1587,7 +1832,7 @@ void time2epoch(gtime_t t, double *ep)
  *-----------------------------------------------------------------------------*/
 gtime_t gpst2time(int week, double sec)
 {
-    gtime_t t = epoch2time(GPST0);
+    gtime_t t = {GPST0_TIME, 0.0};
 
     if (sec < -1e9 || 1e9 < sec)
         {
@@ -1607,8 +1852,7 @@ gtime_t gpst2time(int week, double sec)
  *-----------------------------------------------------------------------------*/
 double time2gpst(gtime_t t, int *week)
 {
-    gtime_t t0 = epoch2time(GPST0);
-    time_t sec = t.time - t0.time;
+    time_t sec = t.time - GPST0_TIME;
     int w = static_cast<int>(sec / 604800);
 
     if (week)
@@ -1627,7 +1871,7 @@ double time2gpst(gtime_t t, int *week)
  *-----------------------------------------------------------------------------*/
 gtime_t gst2time(int week, double sec)
 {
-    gtime_t t = epoch2time(GST0);
+    gtime_t t = {GST0_TIME, 0.0};
 
     if (sec < -1e9 || 1e9 < sec)
         {
@@ -1647,8 +1891,7 @@ gtime_t gst2time(int week, double sec)
  *-----------------------------------------------------------------------------*/
 double time2gst(gtime_t t, int *week)
 {
-    gtime_t t0 = epoch2time(GST0);
-    time_t sec = t.time - t0.time;
+    time_t sec = t.time - GST0_TIME;
     int w = static_cast<int>(sec / (86400 * 7));
 
     if (week)
@@ -1667,7 +1910,7 @@ double time2gst(gtime_t t, int *week)
  *-----------------------------------------------------------------------------*/
 gtime_t bdt2time(int week, double sec)
 {
-    gtime_t t = epoch2time(BDT0);
+    gtime_t t = {BDT0_TIME, 0.0};
 
     if (sec < -1e9 || 1e9 < sec)
         {
@@ -1687,8 +1930,7 @@ gtime_t bdt2time(int week, double sec)
  *-----------------------------------------------------------------------------*/
 double time2bdt(gtime_t t, int *week)
 {
-    gtime_t t0 = epoch2time(BDT0);
-    time_t sec = t.time - t0.time;
+    time_t sec = t.time - BDT0_TIME;
     int w = static_cast<int>(sec / (86400 * 7));
 
     if (week)
@@ -1794,6 +2036,39 @@ void timeset(gtime_t t)
     timeoffset_ += timediff(t, timeget());
 }
 
+/* leap seconds table as gtime_t -----------------------------------------------
+ * start times of the entries of leaps[] converted once, so that gpst2utc() and
+ * utc2gpst() do not go through the calendar at every call. The entries are in
+ * descending order, so times after the last leap second are resolved with the
+ * first comparison. Rebuilt by read_leaps().
+ *-----------------------------------------------------------------------------*/
+typedef struct
+{
+    gtime_t start[MAXLEAPS];   /* start of the entry (utc) */
+    double utc_gpst[MAXLEAPS]; /* utc-gpst (s) */
+    int n;                     /* number of entries */
+} leap_table_t;
+
+
+static leap_table_t make_leap_table()
+{
+    leap_table_t table{};
+    for (table.n = 0; table.n < MAXLEAPS && leaps[table.n][0] > 0; table.n++)
+        {
+            table.start[table.n] = epoch2time(leaps[table.n]);
+            table.utc_gpst[table.n] = leaps[table.n][6];
+        }
+    return table;
+}
+
+
+static leap_table_t &leap_table()
+{
+    static leap_table_t table = make_leap_table();
+    return table;
+}
+
+
 /* read leap seconds table by text -------------------------------------------*/
 int read_leaps_text(FILE *fp)
 {
@@ -1916,6 +2191,7 @@ int read_leaps(const char *file)
         {
             leaps[n][i] = 0.0;
         }
+    leap_table() = make_leap_table();
     fclose(fp);
     return 1;
 }
@@ -1929,13 +2205,14 @@ int read_leaps(const char *file)
  *-----------------------------------------------------------------------------*/
 gtime_t gpst2utc(gtime_t t)
 {
+    const leap_table_t &table = leap_table();
     gtime_t tu;
     int i;
 
-    for (i = 0; leaps[i][0] > 0; i++)
+    for (i = 0; i < table.n; i++)
         {
-            tu = timeadd(t, leaps[i][6]);
-            if (timediff(tu, epoch2time(leaps[i])) >= 0.0)
+            tu = timeadd(t, table.utc_gpst[i]);
+            if (timediff(tu, table.start[i]) >= 0.0)
                 {
                     return tu;
                 }
@@ -1952,13 +2229,14 @@ gtime_t gpst2utc(gtime_t t)
  *-----------------------------------------------------------------------------*/
 gtime_t utc2gpst(gtime_t t)
 {
+    const leap_table_t &table = leap_table();
     int i;
 
-    for (i = 0; leaps[i][0] > 0; i++)
+    for (i = 0; i < table.n; i++)
         {
-            if (timediff(t, epoch2time(leaps[i])) >= 0.0)
+            if (timediff(t, table.start[i]) >= 0.0)
                 {
-                    return timeadd(t, -leaps[i][6]);
+                    return timeadd(t, -table.utc_gpst[i]);
                 }
         }
     return t;
@@ -2069,11 +2347,11 @@ void time2str(gtime_t t, char *s, int n)
  * args   : gtime_t t        I   gtime_t struct
  *          int    n         I   number of decimals
  * return : time string
- * notes  : not reentrant, do not use multiple in a function
+ * notes  : not reentrant, do not use multiple in a function (but thread-safe)
  *-----------------------------------------------------------------------------*/
 char *time_str(gtime_t t, int n)
 {
-    static char buff[64];
+    thread_local char buff[64];
     time2str(t, buff, n);
     return buff;
 }
@@ -2095,6 +2373,21 @@ double time2doy(gtime_t t)
 }
 
 
+/* time context of an epoch -----------------------------------------------------
+ * convert the gps time of an epoch once to the representations that are used
+ * several times while processing it
+ * args   : gtime_t t        I   time expressed in gpstime
+ *          epoch_time_t *et O   time context of the epoch
+ * return : none
+ *-----------------------------------------------------------------------------*/
+void epoch_time(gtime_t t, epoch_time_t *et)
+{
+    et->gpst = t;
+    et->tow = time2gpst(t, &et->week);
+    et->utc = gpst2utc(t);
+}
+
+
 /* adjust gps week number ------------------------------------------------------
  * adjust gps week number using cpu time
  * args   : int   week       I   not-adjusted gps week number
@@ -2548,14 +2841,13 @@ void nut_iau1980(double t, const double *f, double *dpsi, double *deps)
  *                               (NULL: no output)
  * return : none
  * note   : see ref [3] chap 5
- *          not thread-safe
  *-----------------------------------------------------------------------------*/
 void eci2ecef(gtime_t tutc, const double *erpv, double *U, double *gmst)
 {
     const double ep2000[] = {2000, 1, 1, 12, 0, 0};
-    static gtime_t tutc_;
-    static double U_[9];
-    static double gmst_;
+    thread_local gtime_t tutc_;
+    thread_local double U_[9];
+    thread_local double gmst_;
     gtime_t tgps;
     double eps;
     double ze;
@@ -170,6 +170,7 @@ double utc2gmst(gtime_t t, double ut1_utc);
 void time2str(gtime_t t, char *s, int n);
 char *time_str(gtime_t t, int n);
 double time2doy(gtime_t t);
+void epoch_time(gtime_t t, epoch_time_t *et);
 int adjgpsweek(int week, bool pre_2009_file = false);
 unsigned int tickget();
 void sleepms(int ms);
@@ -35,8 +35,10 @@
 #include "rtklib_pntpos.h"
 #include "rtklib_ppp.h"
 #include "rtklib_tides.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 static int resamb_WLNL(rtk_t *rtk __attribute((unused)), const obsd_t *obs __attribute((unused)), const int *sat __attribute((unused)),
     const int *iu __attribute((unused)), const int *ir __attribute((unused)), int ns __attribute__((unused)), const nav_t *nav __attribute((unused)),
@@ -1870,15 +1872,15 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
 double intpres(gtime_t time, const obsd_t *obs, int n, const nav_t *nav,
     rtk_t *rtk, double *y)
 {
-    static obsd_t obsb[MAXOBS];
-    static double yb[MAXOBS * NFREQ * 2];
-    static double rs[MAXOBS * 6];
-    static double dts[MAXOBS * 2];
-    static double var[MAXOBS];
-    static double e[MAXOBS * 3];
-    static double azel[MAXOBS * 2];
-    static int nb = 0;
-    static int svh[MAXOBS * 2];
+    thread_local obsd_t obsb[MAXOBS];
+    thread_local double yb[MAXOBS * NFREQ * 2];
+    thread_local double rs[MAXOBS * 6];
+    thread_local double dts[MAXOBS * 2];
+    thread_local double var[MAXOBS];
+    thread_local double e[MAXOBS * 3];
+    thread_local double azel[MAXOBS * 2];
+    thread_local int nb = 0;
+    thread_local int svh[MAXOBS * 2];
     prcopt_t *opt = &rtk->opt;
     double tt = timediff(time, obs[0].time);
     double ttb;
@@ -2138,17 +2140,34 @@ void holdamb(rtk_t *rtk, const double *xa)
 }
 
 
-/* resolve integer ambiguity by LAMBDA ---------------------------------------*/
+/* resolve integer ambiguity by LAMBDA -----------------------------------------
+ * the reduction of the previous epoch is reused if the double-differenced
+ * ambiguities are the same. If the ratio-test fails (or the search loop count
+ * overflows), up to opt->armaxiter-1 more attempts are made with partial sets,
+ * each without the ambiguity of the lowest satellite left, down to MIN_AMB_PAR
+ * ambiguities. The ambiguities left out of the accepted set stay float.
+ *-----------------------------------------------------------------------------*/
 int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
 {
+    thread_local std::vector<int> cache_dd; /* double-differences of the cached reduction */
+    thread_local std::vector<double> cache_Z;
     prcopt_t *opt = &rtk->opt;
     int i;
     int j;
+    int k;
     int ny;
     int nb;
-    int info;
+    int ns = 0;
+    int iter;
+    int maxiter;
+    int info = -1;
+    int fixed = 0;
     int nx = rtk->nx;
     int na = rtk->na;
+    int *dd;
+    int *order;
+    int *excl;
+    int *idx;
     double *D;
     double *DP;
     double *y;
@@ -2158,6 +2177,8 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     double *Qb;
     double *Qab;
     double *QQ;
+    double *ys;
+    double *Qs;
     double s[2];
 
     trace(3, "resamb_LAMBDA : nx=%d\n", nx);
@@ -2186,6 +2207,12 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     Qb = mat(nb, nb);
     Qab = mat(na, nb);
     QQ = mat(na, nb);
+    ys = mat(nb, 1);
+    Qs = mat(nb, nb);
+    dd = imat(2 * nb, 1);
+    order = imat(nb, 1);
+    excl = imat(nb, 1);
+    idx = imat(nb, 1);
 
     /* transform single to double-differenced phase-bias (y=D'*x, Qy=D'*P*D) */
     matmul("TN", ny, 1, nx, 1.0, D, rtk->x, 0.0, y);
@@ -2208,16 +2235,89 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
                 }
         }
 
+    /* reference and other phase-bias of each double-difference */
+    for (j = 0; j < nb; j++)
+        {
+            for (i = na; i < nx; i++)
+                {
+                    if (D[i + (na + j) * nx] > 0.0)
+                        {
+                            dd[2 * j] = i;
+                        }
+                    else if (D[i + (na + j) * nx] < 0.0)
+                        {
+                            dd[2 * j + 1] = i;
+                        }
+                }
+        }
+    /* double-differences by elevation of the other satellite (lowest first) */
+    for (j = 0; j < nb; j++)
+        {
+            for (k = j; k > 0 && rtk->ssat[(dd[2 * order[k - 1] + 1] - na) % MAXSAT].azel[1] >
+                                     rtk->ssat[(dd[2 * j + 1] - na) % MAXSAT].azel[1];
+                 k--)
+                {
+                    order[k] = order[k - 1];
+                }
+            order[k] = j;
+            excl[j] = 0;
+        }
+
     trace(4, "N(0)=");
     tracemat(4, y + na, 1, nb, 10, 3);
 
-    /* lambda/mlambda integer least-square estimation */
-    if (!(info = lambda(nb, 2, y + na, Qb, b, s)))
+    maxiter = opt->armaxiter > 1 ? opt->armaxiter : 1;
+    for (iter = 0; iter < maxiter; iter++)
         {
+            if (iter > 0)
+                {
+                    if (nb - iter < MIN_AMB_PAR)
+                        {
+                            break;
+                        }
+                    excl[order[iter - 1]] = 1;
+                }
+            for (i = ns = 0; i < nb; i++)
+                {
+                    if (!excl[i])
+                        {
+                            idx[ns++] = i;
+                        }
+                }
+            for (i = 0; i < ns; i++)
+                {
+                    ys[i] = y[na + idx[i]];
+                    for (j = 0; j < ns; j++)
+                        {
+                            Qs[i + j * ns] = Qb[idx[i] + idx[j] * nb];
+                        }
+                }
+
+            /* lambda/mlambda integer least-square estimation */
+            if (iter == 0)
+                {
+                    const bool reuse = cache_dd.size() == static_cast<size_t>(2 * nb) &&
+                                       std::equal(cache_dd.begin(), cache_dd.end(), dd);
+                    cache_dd.assign(dd, dd + 2 * nb);
+                    cache_Z.resize(static_cast<size_t>(nb) * nb);
+                    if ((info = lambda_reuse(ns, 2, ys, Qs, b, s, cache_Z.data(), reuse)))
+                        {
+                            cache_dd.clear();
+                        }
+                }
+            else
+                {
+                    info = lambda(ns, 2, ys, Qs, b, s);
+                }
+            if (info)
+                {
+                    errmsg(rtk, "lambda error (nb=%d info=%d)\n", ns, info);
+                    continue;
+                }
             trace(4, "N(1)=");
-            tracemat(4, b, 1, nb, 10, 3);
+            tracemat(4, b, 1, ns, 10, 3);
             trace(4, "N(2)=");
-            tracemat(4, b + nb, 1, nb, 10, 3);
+            tracemat(4, b + ns, 1, ns, 10, 3);
 
             rtk->sol.ratio = s[0] > 0 ? static_cast<float>(s[1] / s[0]) : 0.0F;
             if (rtk->sol.ratio > 999.9)
@@ -2228,50 +2328,69 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
             /* validation by popular ratio-test */
             if (s[0] <= 0.0 || s[1] / s[0] >= opt->thresar[0])
                 {
-                    /* transform float to fixed solution (xa=xa-Qab*Qb\(b0-b)) */
-                    for (i = 0; i < na; i++)
+                    fixed = 1;
+                    break;
+                }
+            errmsg(rtk, "ambiguity validation failed (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
+                ns, s[1] / s[0], s[0], s[1]);
+        }
+
+    if (fixed)
+        {
+            /* transform float to fixed solution (xa=xa-Qab*Qb\(b0-b)) */
+            for (i = 0; i < na; i++)
+                {
+                    rtk->xa[i] = rtk->x[i];
+                    for (j = 0; j < na; j++)
                         {
-                            rtk->xa[i] = rtk->x[i];
-                            for (j = 0; j < na; j++)
-                                {
-                                    rtk->Pa[i + j * na] = rtk->P[i + j * nx];
-                                }
+                            rtk->Pa[i + j * na] = rtk->P[i + j * nx];
                         }
-                    for (i = 0; i < nb; i++)
+                }
+            for (i = 0; i < nb; i++)
+                {
+                    bias[i] = y[na + i]; /* left float */
+                }
+            for (i = 0; i < ns; i++)
+                {
+                    bias[idx[i]] = b[i];
+                    ys[i] -= b[i];
+                    for (j = 0; j < na; j++)
                         {
-                            bias[i] = b[i];
-                            y[na + i] -= b[i];
+                            Qab[j + i * na] = Qy[j + (na + idx[i]) * ny];
                         }
-                    if (!matinv(Qb, nb))
-                        {
-                            matmul("NN", nb, 1, nb, 1.0, Qb, y + na, 0.0, db);
-                            matmul("NN", na, 1, nb, -1.0, Qab, db, 1.0, rtk->xa);
+                }
+            if (!matinv(Qs, ns))
+                {
+                    matmul("NN", ns, 1, ns, 1.0, Qs, ys, 0.0, db);
+                    matmul("NN", na, 1, ns, -1.0, Qab, db, 1.0, rtk->xa);
 
-                            /* covariance of fixed solution (Qa=Qa-Qab*Qb^-1*Qab') */
-                            matmul("NN", na, nb, nb, 1.0, Qab, Qb, 0.0, QQ);
-                            matmul("NT", na, na, nb, -1.0, QQ, Qab, 1.0, rtk->Pa);
+                    /* covariance of fixed solution (Qa=Qa-Qab*Qb^-1*Qab') */
+                    matmul("NN", na, ns, ns, 1.0, Qab, Qs, 0.0, QQ);
+                    matmul("NT", na, na, ns, -1.0, QQ, Qab, 1.0, rtk->Pa);
 
-                            trace(3, "resamb : validation ok (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
-                                nb, s[0] == 0.0 ? 0.0 : s[1] / s[0], s[0], s[1]);
+                    trace(3, "resamb : validation ok (nb=%d/%d ratio=%.2f s=%.2f/%.2f)\n",
+                        ns, nb, s[0] == 0.0 ? 0.0 : s[1] / s[0], s[0], s[1]);
 
-                            /* restore single-differenced ambiguity */
-                            restamb(rtk, bias, nb, xa);
-                        }
-                    else
+                    /* restore single-differenced ambiguity */
+                    restamb(rtk, bias, nb, xa);
+
+                    for (i = 0; i < nb; i++)
                         {
-                            nb = 0;
+                            if (excl[i])
+                                {
+                                    k = dd[2 * i + 1] - na;
+                                    rtk->ssat[k % MAXSAT].fix[k / MAXSAT] = 1;
+                                }
                         }
                 }
             else
-                { /* validation failed */
-                    errmsg(rtk, "ambiguity validation failed (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
-                        nb, s[1] / s[0], s[0], s[1]);
-                    nb = 0;
+                {
+                    ns = 0;
                 }
         }
     else
         {
-            errmsg(rtk, "lambda error (info=%d)\n", info);
+            ns = 0;
         }
     free(D);
     free(y);
@@ -2282,8 +2401,14 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     free(Qb);
     free(Qab);
     free(QQ);
-
-    return nb; /* number of ambiguities */
+    free(ys);
+    free(Qs);
+    free(dd);
+    free(order);
+    free(excl);
+    free(idx);
+
+    return ns; /* number of fixed ambiguities */
 }
 
 
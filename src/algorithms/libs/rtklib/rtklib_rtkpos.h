@@ -53,6 +53,7 @@ const double PRN_HWBIA = 1E-6; /* process noise of h/w bias (m/MHz/sqrt(s)) */
 const double MAXAC = 30.0;     /* max accel for doppler slip detection (m/s^2) */
 
 const double VAR_HOLDAMB = 0.001; /* constraint to hold ambiguity (cycle^2) */
+const int MIN_AMB_PAR = 4;        /* min number of ambiguities of a partial fix */
 
 const double TTOL_MOVEB = (1.0 + 2 * DTTOL);
 /* time sync tolerance for moving-baseline (s) */
@@ -30,6 +30,7 @@
  */
 
 #include "rtklib_rtksvr.h"
+#include "rtklib_pool.h"
 #include "rtklib_preceph.h"
 #include "rtklib_rtcm.h"
 #include "rtklib_rtkcmn.h"
@@ -37,7 +38,9 @@
 #include "rtklib_sbas.h"
 #include "rtklib_solution.h"
 #include "rtklib_stream.h"
+#include <atomic>
 #include <cstring>
+#include <vector>
 
 /* write solution header to output stream ------------------------------------*/
 void writesolhead(stream_t *stream, const solopt_t *solopt)
@@ -669,6 +672,71 @@ void *rtksvrthread(void *arg)
 }
 
 
+/* pool of the rovers, started on first use with the given threads ----------*/
+namespace
+{
+Rtklib_Pool *rovers_pool(int threads)
+{
+    static Rtklib_Pool pool(threads);
+    return &pool;
+}
+}  // namespace
+
+
+/* rtk positioning of rovers with the same base station ------------------------
+ * rtk positioning of many rovers against the observation data of one base
+ * station, decoded once (e.g. from the base stream of the rtk server), and the
+ * same navigation data. The rovers run in parallel: they only read base and nav,
+ * and each rover has its own rtk control, so the solutions are the same as
+ * those of one rtkpos() call per rover.
+ * args   : rtk_t  *rtk      IO rtk control/result of each rover (nrov)
+ *          int    nrov      I  number of rovers
+ *          obs_t  *rov      I  observation data of the epoch of each rover (nrov)
+ *          obs_t  *base     I  observation data of the base station
+ *          nav_t  *nav      I  navigation data
+ *          int    threads   I  number of threads (0,1: calling thread only)
+ * return : number of rovers with solution
+ *-----------------------------------------------------------------------------*/
+int rtkposrovers(rtk_t *rtk, int nrov, const obs_t *rov, const obs_t *base,
+    const nav_t *nav, int threads)
+{
+    std::atomic<int> nsol(0);
+    int i;
+
+    tracet(3, "rtkposrovers: nrov=%d nb=%d\n", nrov, base->n);
+
+    const auto position = [&](int i_r) {
+        thread_local std::vector<obsd_t> data(MAXOBS * 2);
+        int n = 0;
+        for (int j = 0; j < rov[i_r].n && n < MAXOBS * 2; j++)
+            {
+                data[n++] = rov[i_r].data[j];
+            }
+        for (int j = 0; j < base->n && n < MAXOBS * 2; j++)
+            {
+                data[n++] = base->data[j];
+            }
+        rtkpos(rtk + i_r, data.data(), n, nav);
+        if (rtk[i_r].sol.stat != SOLQ_NONE)
+            {
+                nsol++;
+            }
+    };
+    if (threads > 1)
+        {
+            rovers_pool(threads)->run(nrov, position);
+        }
+    else
+        {
+            for (i = 0; i < nrov; i++)
+                {
+                    position(i);
+                }
+        }
+    return nsol;
+}
+
+
 /* initialize rtk server -------------------------------------------------------
  * initialize rtk server
  * args   : rtksvr_t *svr    IO rtk server
@@ -87,6 +87,9 @@ void decodefile(rtksvr_t *svr, int index);
 
 void *rtksvrthread(void *arg);
 
+int rtkposrovers(rtk_t *rtk, int nrov, const obs_t *rov, const obs_t *base,
+    const nav_t *nav, int threads);
+
 int rtksvrinit(rtksvr_t *svr);
 
 void rtksvrfree(rtksvr_t *svr);
@@ -41,8 +41,10 @@
 
 #include "rtklib_sbas.h"
 #include "rtklib_rtkcmn.h"
+#include <atomic>
 #include <cmath>  // for lround
 #include <cstring>
+#include <vector>
 
 /* extract field from line ---------------------------------------------------*/
 char *getfield(char *p, int pos)
@@ -541,6 +543,7 @@ int decode_sbstype26(const sbsmsg_t *msg, sbsion_t *sbsion)
  *-----------------------------------------------------------------------------*/
 int sbsupdatecorr(const sbsmsg_t *msg, nav_t *nav)
 {
+    static std::atomic<unsigned int> revision(0);
     int type = getbitu(msg->msg, 8, 6);
     int stat = -1;
 
@@ -591,6 +594,16 @@ int sbsupdatecorr(const sbsmsg_t *msg, nav_t *nav)
 
             /*default: trace(2, "unsupported sbas message: type=%d\n", type); break;*/
         }
+    if (type != 63)
+        {
+            /* a new revision, unique among all the navigation data, invalidates
+               the cached corrections of sbssatcorr() and sbsioncorr() */
+            do
+                {
+                    nav->sbsrev = ++revision;
+                }
+            while (nav->sbsrev == 0);
+        }
     return stat ? type : -1;
 }
 
@@ -836,18 +849,14 @@ void sbsoutmsg(FILE *fp, sbsmsg_t *sbsmsg)
 }
 
 
-/* search igps ---------------------------------------------------------------*/
-void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sbsion_t *ion,
-    const sbsigp_t **igp, double *x, double *y)
+/* cell of the ionospheric grid around a pierce point -------------------------
+ * igps {ws,wn,es,en} of the cell of pos (rad), and the position of pos in it
+ *-----------------------------------------------------------------------------*/
+void igpcell(const double *pos, int *latp, int *lonp, double *x, double *y)
 {
     int i;
-    int latp[2];
-    int lonp[4];
     double lat = pos[0] * R2D;
     double lon = pos[1] * R2D;
-    const sbsigp_t *p;
-
-    trace(4, "searchigp: pos=%.3f %.3f\n", pos[0] * R2D, pos[1] * R2D);
 
     if (lon >= 180.0)
         {
@@ -902,6 +911,16 @@ void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sb
                     lonp[i] = -180;
                 }
         }
+}
+
+
+/* find the igps of a cell of the ionospheric grid ---------------------------*/
+void findigps(const sbsion_t *ion, const int *latp, const int *lonp,
+    const sbsigp_t **igp)
+{
+    int i;
+    const sbsigp_t *p;
+
     for (i = 0; i <= MAXBAND; i++)
         {
             for (p = ion[i].igp; p < ion[i].igp + ion[i].nigp; p++)
@@ -935,6 +954,81 @@ void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sb
 }
 
 
+/* search igps ---------------------------------------------------------------*/
+void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sbsion_t *ion,
+    const sbsigp_t **igp, double *x, double *y)
+{
+    int latp[2];
+    int lonp[4];
+
+    trace(4, "searchigp: pos=%.3f %.3f\n", pos[0] * R2D, pos[1] * R2D);
+
+    igpcell(pos, latp, lonp, x, y);
+    findigps(ion, latp, lonp, igp);
+}
+
+
+/* search igps, with the igps of the last cells cached per thread --------------
+ * the grid only changes with sbas messages, which give nav a new revision, so
+ * the igps of a cell are searched again only after a message of the igp mask or
+ * of the vertical delays arrives (or the pierce point enters another cell)
+ *-----------------------------------------------------------------------------*/
+void searchigp_cached(const nav_t *nav, const double *pos,
+    const sbsigp_t **igp, double *x, double *y)
+{
+    struct igpcache_t
+    {
+        const nav_t *nav;       /* navigation data (nullptr: empty) */
+        unsigned int rev;       /* and its revision */
+        int latp[2];            /* cell */
+        int lonp[4];
+        const sbsigp_t *igp[4]; /* igps of the cell {ws,wn,es,en} */
+    };
+    thread_local std::vector<igpcache_t> cache;
+    int latp[2];
+    int lonp[4];
+    int i;
+
+    igpcell(pos, latp, lonp, x, y);
+
+    if (nav->sbsrev == 0)
+        {
+            /* not set by sbsupdatecorr(), the grid may change at any time */
+            findigps(nav->sbsion, latp, lonp, igp);
+            return;
+        }
+    if (cache.empty())
+        {
+            cache.resize(SBSIGPCACHE);
+            for (auto &c : cache)
+                {
+                    c.nav = nullptr;
+                }
+        }
+    igpcache_t *c = &cache[static_cast<unsigned int>((latp[0] + 90) * 37 + (lonp[0] + 180)) % SBSIGPCACHE];
+    if (c->nav != nav || c->rev != nav->sbsrev || c->latp[0] != latp[0] || c->latp[1] != latp[1] ||
+        c->lonp[0] != lonp[0] || c->lonp[1] != lonp[1] || c->lonp[2] != lonp[2] || c->lonp[3] != lonp[3])
+        {
+            c->nav = nav;
+            c->rev = nav->sbsrev;
+            for (i = 0; i < 2; i++)
+                {
+                    c->latp[i] = latp[i];
+                }
+            for (i = 0; i < 4; i++)
+                {
+                    c->lonp[i] = lonp[i];
+                    c->igp[i] = nullptr;
+                }
+            findigps(nav->sbsion, latp, lonp, c->igp);
+        }
+    for (i = 0; i < 4; i++)
+        {
+            igp[i] = c->igp[i];
+        }
+}
+
+
 /* sbas ionospheric delay correction -------------------------------------------
  * compute sbas ionosphric delay correction
  * args   : gtime_t  time    I   time
@@ -947,6 +1041,8 @@ void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sb
  * notes  : before calling the function, sbas ionosphere correction parameters
  *          in navigation data (nav->sbsion) must be set by calling
  *          sbsupdatecorr()
+ *          the igps around the pierce points are cached per thread until
+ *          sbsupdatecorr() changes nav->sbsrev
  *-----------------------------------------------------------------------------*/
 int sbsioncorr(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, double *delay, double *var)
@@ -976,7 +1072,7 @@ int sbsioncorr(gtime_t time, const nav_t *nav, const double *pos,
     fp = ionppp(pos, azel, re, hion, posp);
 
     /* search igps around ipp */
-    searchigp(time, posp, nav->sbsion, igp, &x, &y);
+    searchigp_cached(nav, posp, igp, &x, &y);
 
     /* weight of igps */
     if (igp[0] && igp[1] && igp[2] && igp[3])
@@ -1106,9 +1202,9 @@ double sbstropcorr(gtime_t time, const double *pos, const double *azel,
     const double rd = 287.054;
     const double gm = 9.784;
     const double g = 9.80665;
-    static double pos_[3] = {};
-    static double zh = 0.0;
-    static double zw = 0.0;
+    thread_local double pos_[3] = {};
+    thread_local double zh = 0.0;
+    thread_local double zw = 0.0;
     int i;
     double c;
     double met[10];
@@ -1253,36 +1349,75 @@ int sbsfastcorr(gtime_t time, int sat, const sbssat_t *sbssat,
  *          correction.
  *          sbas clock correction is usually based on L1C/A code. TGD or DCB has
  *          to be considered for other codes
+ *          the corrections of each satellite are cached per thread, and reused
+ *          at the same time until sbsupdatecorr() changes nav->sbsrev
  *-----------------------------------------------------------------------------*/
 int sbssatcorr(gtime_t time, int sat, const nav_t *nav, double *rs,
     double *dts, double *var)
 {
-    double drs[3] = {};
-    double dclk = 0.0;
-    double prc = 0.0;
+    struct satcorr_memo_t
+    {
+        const nav_t *nav; /* navigation data (nullptr: empty) */
+        unsigned int rev; /* and its revision */
+        gtime_t time;     /* reception time */
+        int stat;         /* status (1:ok,0:no correction) */
+        double drs[3];    /* position correction (m) */
+        double dclk;      /* long term clock correction (s) */
+        double prc;       /* fast correction (m) */
+        double var;       /* variance (m^2) */
+    };
+    thread_local std::vector<satcorr_memo_t> memo;
+    satcorr_memo_t corr = {};
     int i;
 
     trace(3, "sbssatcorr : sat=%2d\n", sat);
 
-    /* sbas long term corrections */
-    if (!sbslongcorr(time, sat, &nav->sbssat, drs, &dclk))
+    if (sat <= 0 || sat > MAXSAT)
         {
             return 0;
         }
-    /* sbas fast corrections */
-    if (!sbsfastcorr(time, sat, &nav->sbssat, &prc, var))
+    if (memo.empty())
+        {
+            memo.resize(MAXSAT);
+            for (auto &m : memo)
+                {
+                    m.nav = nullptr;
+                }
+        }
+    satcorr_memo_t *m = &memo[sat - 1];
+
+    /* corrections of the same epoch are reused until a new message arrives */
+    if (nav->sbsrev != 0 && m->nav == nav && m->rev == nav->sbsrev && timediff(time, m->time) == 0.0)
+        {
+            corr = *m;
+        }
+    else
+        {
+            corr.nav = nav;
+            corr.rev = nav->sbsrev;
+            corr.time = time;
+            /* sbas long term and fast corrections */
+            corr.stat = sbslongcorr(time, sat, &nav->sbssat, corr.drs, &corr.dclk) &&
+                        sbsfastcorr(time, sat, &nav->sbssat, &corr.prc, &corr.var);
+            if (nav->sbsrev != 0)
+                {
+                    *m = corr;
+                }
+        }
+    if (!corr.stat)
         {
             return 0;
         }
     for (i = 0; i < 3; i++)
         {
-            rs[i] += drs[i];
+            rs[i] += corr.drs[i];
         }
 
-    dts[0] += dclk + prc / SPEED_OF_LIGHT_M_S;
+    dts[0] += corr.dclk + corr.prc / SPEED_OF_LIGHT_M_S;
+    *var = corr.var;
 
     trace(5, "sbssatcorr: sat=%2d drs=%6.3f %6.3f %6.3f dclk=%.3f %.3f var=%.3f\n",
-        sat, drs[0], drs[1], drs[2], dclk, prc / SPEED_OF_LIGHT_M_S, *var);
+        sat, corr.drs[0], corr.drs[1], corr.drs[2], corr.dclk, corr.prc / SPEED_OF_LIGHT_M_S, *var);
 
     return 1;
 }
@@ -47,6 +47,7 @@
 /* constants -----------------------------------------------------------------*/
 
 const int WEEKOFFSET = 1024; /* gps week offset for NovAtel OEM-3 */
+const int SBSIGPCACHE = 64;  /* cells of the ionospheric grid cached per thread */
 
 /* sbas igp definition -------------------------------------------------------*/
 static const short
@@ -121,8 +122,13 @@ int sbsreadmsgt(const char *file, int sel, gtime_t ts, gtime_t te,
     sbs_t *sbs);
 int sbsreadmsg(const char *file, int sel, sbs_t *sbs);
 void sbsoutmsg(FILE *fp, sbsmsg_t *sbsmsg);
+void igpcell(const double *pos, int *latp, int *lonp, double *x, double *y);
+void findigps(const sbsion_t *ion, const int *latp, const int *lonp,
+    const sbsigp_t **igp);
 void searchigp(gtime_t time, const double *pos, const sbsion_t *ion,
     const sbsigp_t **igp, double *x, double *y);
+void searchigp_cached(const nav_t *nav, const double *pos,
+    const sbsigp_t **igp, double *x, double *y);
 int sbsioncorr(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, double *delay, double *var);
 
@@ -31,6 +31,7 @@
  */
 
 #include "rtklib_stream.h"
+#include "gnss_sdr_stream_writer.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_solution.h"
 #include <arpa/inet.h>
@@ -164,6 +165,9 @@ serial_t *openserial(const char *path, int mode, char *msg)
     ios.c_cflag |= !strcmp(fctr, "rts") ? CRTSCTS : 0;
     tcsetattr(serial->dev, TCSANOW, &ios);
     tcflush(serial->dev, TCIOFLUSH);
+    serial->error = 0;
+    /* the bytes that do not fit in the queue are lost, as with direct writes */
+    serial->queued = (mode & STR_MODE_W) && Gnss_Stream_Writer::instance().add(static_cast<int>(serial->dev), std::string("serial stream ") + dev, 65536, Gnss_Stream_Writer::Drop_Policy::Newest);
     return serial;
 }
 
@@ -176,6 +180,10 @@ void closeserial(serial_t *serial)
             return;
         }
     tracet(3, "closeserial: dev=%d\n", serial->dev);
+    if (serial->queued)
+        {
+            Gnss_Stream_Writer::instance().remove(static_cast<int>(serial->dev));
+        }
     close(serial->dev);
     free(serial);
 }
@@ -208,6 +216,10 @@ int writeserial(serial_t *serial, unsigned char *buff, int n, char *msg __attrib
             return 0;
         }
     tracet(3, "writeserial: dev=%d n=%d\n", serial->dev, n);
+    if (serial->queued)
+        {
+            return Gnss_Stream_Writer::instance().write(static_cast<int>(serial->dev), buff, n) ? n : 0;
+        }
     if ((ns = write(serial->dev, buff, n)) < 0)
         {
             return 0;
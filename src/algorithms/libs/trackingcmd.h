@@ -19,6 +19,7 @@
 #define GNSS_SDR_TRACKINGCMD_H_
 
 #include <cstdint>
+#include <map>
 
 /** \addtogroup Algorithms_Library
  * \{ */
@@ -28,16 +29,26 @@
 class TrackingCmd
 {
 public:
-    TrackingCmd();
+    TrackingCmd() = default;
 
     bool enable_carrier_nco_cmd = false;
     bool enable_code_nco_cmd = false;
     double code_freq_chips = 0.0;
     double carrier_freq_hz = 0.0;
     double carrier_freq_rate_hz_s = 0.0;
+    double range_rate_m_s = 0.0;  // pseudorange rate predicted by the PVT, including the receiver clock drift
     uint64_t sample_counter = 0UL;
+    uint32_t channel_id = 0U;  // channel the command is addressed to
+    uint32_t PRN = 0U;
 };
 
+
+/*!
+ * \brief Commands for all the tracking channels, by channel_id, so that a
+ * single message reaches all of them.
+ */
+using TrackingCmdMap = std::map<uint32_t, TrackingCmd>;
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_TRACKINGCMD_H_
@@ -12,6 +12,7 @@
 
 #include "volk_gnsssdr/volk_gnsssdr.h"    // for volk_gnsssdr_get_alignment, volk_gnsssdr_get_machine
 #include "volk_gnsssdr_option_helpers.h"  // for option_list, option_t
+#include <volk_gnsssdr/volk_gnsssdr_cpu.h>  // for volk_gnsssdr_get_sve_vector_length
 #include <volk_gnsssdr/constants.h>       // for volk_gnsssdr_available_machines, volk_gnsssdr_c_compiler ...
 #include <iostream>                       // for operator<<, cout, ostream
 #include <string>                         // for string
@@ -22,6 +23,20 @@ void print_alignment()
 }
 
 
+void print_sve_vector_length()
+{
+    const unsigned int vl = volk_gnsssdr_get_sve_vector_length();
+    if (vl == 0)
+        {
+            std::cout << "SVE not available\n";
+        }
+    else
+        {
+            std::cout << "SVE vector length in bits: " << vl * 8 << '\n';
+        }
+}
+
+
 void print_malloc()
 {
     // You don't want to change the volk_malloc code, so just copy the if/else
@@ -51,6 +66,7 @@ int main(int argc, char **argv)
     our_options.add(option_t("machine", "", "print the current VOLK_GNSSSDR machine that will be used",
         volk_gnsssdr_get_machine()));
     our_options.add(option_t("alignment", "", "print the memory alignment", print_alignment));
+    our_options.add(option_t("sve-vector-length", "", "print the SVE vector length of the current CPU", print_sve_vector_length));
     our_options.add(option_t("malloc", "", "print the malloc implementation used in volk_gnsssdr_malloc",
         print_malloc));
     our_options.add(option_t("version", "v", "print the VOLK_GNSSSDR version", volk_gnsssdr_version()));
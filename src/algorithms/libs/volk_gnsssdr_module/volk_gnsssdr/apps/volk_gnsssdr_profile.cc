@@ -23,11 +23,17 @@
 #include <boost/filesystem/path.hpp>         // for path, operator<<
 #include <boost/filesystem/path_traits.hpp>  // for filesystem
 #endif
+#include <algorithm>   // for sort, unique, max
 #include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <cstdlib>     // for atoi, atof
 #include <fstream>     // IWYU pragma: keep
+#include <iomanip>     // for setprecision
 #include <iostream>    // for operator<<, basic_ostream
 #include <map>         // for map, map<>::iterator
+#include <sstream>     // for stringstream
 #include <sys/stat.h>  // for stat
+#include <string>      // for string, getline, to_string
 #include <utility>     // for pair
 #include <vector>      // for vector, vector<>::const_..
 
@@ -56,6 +62,87 @@ std::string json_filename("");
 void set_json(std::string val) { json_filename = val; }
 std::string volk_config_path("");
 void set_volk_config(std::string val) { volk_config_path = val; }
+std::vector<unsigned int> length_buckets;
+void set_length_buckets(std::string val)
+{
+    // comma-separated list of vector lengths, e.g. 2048,8192,32768
+    std::stringstream list(val);
+    std::string token;
+    while (std::getline(list, token, ','))
+        {
+            const int length = std::atoi(token.c_str());
+            if (length > 0)
+                {
+                    length_buckets.push_back(static_cast<unsigned int>(length));
+                }
+        }
+    std::sort(length_buckets.begin(), length_buckets.end());
+    length_buckets.erase(std::unique(length_buckets.begin(), length_buckets.end()), length_buckets.end());
+}
+bool workload_mode = false;
+void set_workload(bool val) { workload_mode = val; }
+std::string baseline_filename("");
+void set_baseline(std::string val) { baseline_filename = val; }
+float regression_threshold = 10.0;
+void set_regression_threshold(float val) { regression_threshold = val; }
+
+// Lengths of the calls made by the receiver: the correlations over one
+// code period of GPS L1 C/A at 2.046, 4, 6.25 and 12.5 Msps and of Galileo
+// E1 at 5 Msps, and the FFT sizes of their acquisition
+const std::vector<unsigned int> workload_lengths = {2046, 4000, 6250, 8192, 12500, 16384, 20000, 32768, 65536};
+
+
+void run_test_cases(const std::vector<volk_gnsssdr_test_case_t> &test_cases, const std::string &substr_to_match,
+    const std::string &config_suffix, std::vector<volk_gnsssdr_test_results_t> *results)
+{
+    // Iterate through list of tests running each one
+    for (unsigned int ii = 0; ii < test_cases.size(); ++ii)
+        {
+            bool regex_match = true;
+
+            volk_gnsssdr_test_case_t test_case = test_cases[ii];
+            // if the kernel name matches regex then do the test
+            std::string test_case_name = test_case.name();
+            if (test_case_name.find(substr_to_match) == std::string::npos)
+                {
+                    regex_match = false;
+                }
+
+            // if we are in update mode check if we've already got results
+            // if we have any, then no need to test that kernel
+            bool update = true;
+            if (update_mode)
+                {
+                    for (unsigned int jj = 0; jj < results->size(); ++jj)
+                        {
+                            if ((*results)[jj].name == test_case.name() + config_suffix ||
+                                (*results)[jj].name == test_case.puppet_master_name() + config_suffix)
+                                {
+                                    update = false;
+                                    break;
+                                }
+                        }
+                }
+
+            if (regex_match && update)
+                {
+                    const size_t first_result = results->size();
+                    try
+                        {
+                            run_volk_gnsssdr_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
+                                test_case.test_parameters(), results, test_case.puppet_master_name());
+                        }
+                    catch (std::string &error)
+                        {
+                            std::cerr << "Caught Exception in 'run_volk_gnsssdr_tests': " << error << '\n';
+                        }
+                    for (size_t jj = first_result; jj < results->size(); ++jj)
+                        {
+                            (*results)[jj].config_name += config_suffix;
+                        }
+                }
+        }
+}
 
 int main(int argc, char *argv[])
 {
@@ -69,6 +156,10 @@ int main(int argc, char *argv[])
     profile_options.add((option_t("dry-run", "n", "Dry run. Respect other options, but don't write to file", set_dryrun)));
     profile_options.add((option_t("json", "j", "Write results to JSON file named as argument value", set_json)));
     profile_options.add((option_t("path", "p", "Specify the volk_config path", set_volk_config)));
+    profile_options.add((option_t("length-buckets", "l", "Also profile each kernel at these comma-separated vector lengths, and dispatch calls up to each length to its fastest implementation", set_length_buckets)));
+    profile_options.add((option_t("workload", "w", "Also benchmark each kernel at the vector lengths used by the receiver in tracking and acquisition. These results only go to the JSON file and to the baseline comparison", set_workload)));
+    profile_options.add((option_t("baseline", "B", "Compare the results with those of a JSON file written by a previous run with --json, and exit with status 2 if any protokernel is slower", set_baseline)));
+    profile_options.add((option_t("regression-threshold", "T", "Slowdown, in percent of the baseline time per call, flagged as a regression (default 10)", set_regression_threshold)));
 
     try
         {
@@ -114,58 +205,51 @@ int main(int argc, char *argv[])
     // Initialize the list of tests
     std::vector<volk_gnsssdr_test_case_t> test_cases = init_test_list(test_params);
 
-    // Iterate through list of tests running each one
     std::string substr_to_match(test_params.kernel_regex());
-    for (unsigned int ii = 0; ii < test_cases.size(); ++ii)
-        {
-            bool regex_match = true;
-
-            volk_gnsssdr_test_case_t test_case = test_cases[ii];
-            // if the kernel name matches regex then do the test
-            std::string test_case_name = test_case.name();
-            if (test_case_name.find(substr_to_match) == std::string::npos)
-                {
-                    regex_match = false;
-                }
+    run_test_cases(test_cases, substr_to_match, "", &results);
 
-            // if we are in update mode check if we've already got results
-            // if we have any, then no need to test that kernel
-            bool update = true;
-            if (update_mode)
-                {
-                    for (unsigned int jj = 0; jj < results.size(); ++jj)
-                        {
-                            if (results[jj].name == test_case.name() ||
-                                results[jj].name == test_case.puppet_master_name())
-                                {
-                                    update = false;
-                                    break;
-                                }
-                        }
-                }
+    // Profile again at each requested length. Results are stored as
+    // kernel_name:length, and used at runtime for calls up to that length
+    for (unsigned int length : length_buckets)
+        {
+            volk_gnsssdr_test_params_t bucket_params = test_params;
+            bucket_params.set_vlen(length);
+            run_test_cases(init_test_list(bucket_params), substr_to_match, ":" + std::to_string(length), &results);
+        }
 
-            if (regex_match && update)
+    // Benchmark the receiver workloads. The number of iterations is scaled
+    // so that every length processes about the same number of samples
+    std::vector<volk_gnsssdr_test_results_t> workload_results;
+    if (workload_mode)
+        {
+            for (unsigned int length : workload_lengths)
                 {
-                    try
-                        {
-                            run_volk_gnsssdr_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
-                                test_case.test_parameters(), &results, test_case.puppet_master_name());
-                        }
-                    catch (std::string &error)
-                        {
-                            std::cerr << "Caught Exception in 'run_volk_gnsssdr_tests': " << error << '\n';
-                        }
+                    volk_gnsssdr_test_params_t workload_params = test_params;
+                    workload_params.set_vlen(length);
+                    workload_params.set_iter(std::max(10U, static_cast<unsigned int>((static_cast<uint64_t>(test_params.iter()) * test_params.vlen()) / length)));
+                    run_test_cases(init_test_list(workload_params), substr_to_match, "", &workload_results);
                 }
         }
 
-
     // Output results according to provided options
+    std::vector<volk_gnsssdr_test_results_t> all_results(results);
+    all_results.insert(all_results.end(), workload_results.begin(), workload_results.end());
     if (json_filename != "")
         {
-            write_json(json_file, results);
+            write_json(json_file, all_results);
             json_file.close();
         }
 
+    int regressions = 0;
+    if (baseline_filename != "")
+        {
+            regressions = compare_with_baseline(all_results, baseline_filename, regression_threshold);
+            if (regressions < 0)
+                {
+                    return 1;
+                }
+        }
+
     if (!dry_run)
         {
             if (config_file != "")
@@ -178,7 +262,7 @@ int main(int argc, char *argv[])
             std::cout << "Warning: this was a dry-run. Config not generated\n";
         }
 
-    return 0;
+    return regressions > 0 ? 2 : 0;
 }
 
 
@@ -302,6 +386,7 @@ void write_results(const std::vector<volk_gnsssdr_test_results_t> *results, bool
             config << "\
 #this file is generated by volk_gnsssdr_profile.\n\
 #the function name is followed by the preferred architecture.\n\
+#a function name suffixed with :N applies to calls of up to N points.\n\
 ";
         }
 
@@ -318,6 +403,7 @@ void write_results(const std::vector<volk_gnsssdr_test_results_t> *results, bool
 void write_json(std::ofstream &json_file, std::vector<volk_gnsssdr_test_results_t> results)
 {
     json_file << "{\n";
+    json_file << " \"machine\": \"" << volk_gnsssdr_get_machine() << "\",\n";
     json_file << " \"volk_gnsssdr_tests\": [\n";
     size_t len = results.size();
     size_t i = 0;
@@ -343,6 +429,7 @@ void write_json(std::ofstream &json_file, std::vector<volk_gnsssdr_test_results_
                     json_file << "    \"" << time.name << "\": {\n";
                     json_file << "     \"name\": \"" << time.name << "\",\n";
                     json_file << "     \"time\": " << time.time << ",\n";
+                    json_file << "     \"pass\": " << (time.pass ? "true" : "false") << ",\n";
                     json_file << "     \"units\": \"" << time.units << "\"\n";
                     json_file << "    }";
                     if (ri + 1 != results_len)
@@ -364,3 +451,155 @@ void write_json(std::ofstream &json_file, std::vector<volk_gnsssdr_test_results_
     json_file << " ]\n";
     json_file << "}\n";
 }
+
+
+namespace
+{
+// Value of a "key": value line of the JSON file written by write_json()
+std::string json_value(const std::string &line)
+{
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos)
+        {
+            return std::string();
+        }
+    std::string value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(" \t\""));
+    const size_t end = value.find_last_not_of(" \t\",");
+    value.erase(end == std::string::npos ? 0 : end + 1);
+    return value;
+}
+
+std::string json_key(const std::string &line)
+{
+    const size_t first = line.find('"');
+    const size_t last = first == std::string::npos ? std::string::npos : line.find('"', first + 1);
+    return last == std::string::npos ? std::string() : line.substr(first + 1, last - first - 1);
+}
+
+std::string result_key(const std::string &name, unsigned int vlen)
+{
+    return name + "(" + std::to_string(vlen) + ")";
+}
+}  // namespace
+
+
+bool read_json(std::map<std::string, std::map<std::string, std::pair<double, bool>>> &baseline, const std::string &path)
+{
+    // Line by line reader of the format written by write_json(): the brace
+    // depth tells a kernel from one of its protokernels
+    std::ifstream json(path.c_str());
+    if (!json.is_open())
+        {
+            return false;
+        }
+    std::string line;
+    std::string kernel;
+    std::string arch;
+    unsigned int vlen = 0;
+    unsigned int iter = 1;
+    double time = 0.0;
+    int depth = 0;
+    while (std::getline(json, line))
+        {
+            const std::string key = json_key(line);
+            if (depth == 2 and key == "name")
+                {
+                    kernel = json_value(line);
+                }
+            else if (depth == 2 and key == "vlen")
+                {
+                    vlen = static_cast<unsigned int>(std::atoi(json_value(line).c_str()));
+                }
+            else if (depth == 2 and key == "iter")
+                {
+                    iter = std::max(1, std::atoi(json_value(line).c_str()));
+                }
+            else if (depth == 4 and key == "name")
+                {
+                    arch = json_value(line);
+                }
+            else if (depth == 4 and key == "time")
+                {
+                    time = std::atof(json_value(line).c_str()) / iter;
+                    baseline[result_key(kernel, vlen)][arch] = std::make_pair(time, true);
+                }
+            else if (depth == 4 and key == "pass")
+                {
+                    baseline[result_key(kernel, vlen)][arch].second = json_value(line) == "true";
+                }
+            for (char c : line)
+                {
+                    depth += (c == '{') - (c == '}');
+                }
+        }
+    return true;
+}
+
+
+int compare_with_baseline(const std::vector<volk_gnsssdr_test_results_t> &results, const std::string &path, float threshold_percent)
+{
+    std::map<std::string, std::map<std::string, std::pair<double, bool>>> baseline;
+    if (!read_json(baseline, path))
+        {
+            std::cerr << "ERROR: Could not read the baseline " << path << '\n';
+            return -1;
+        }
+    const double threshold = 1.0 + threshold_percent / 100.0;
+    int compared = 0;
+    int regressions = 0;
+    int improvements = 0;
+    std::cout << "Comparing with the baseline " << path << " (threshold " << threshold_percent << " %)\n";
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto &result : results)
+        {
+            const std::string key = result_key(result.name, result.vlen);
+            const auto base = baseline.find(key);
+            if (base == baseline.end())
+                {
+                    std::cout << "  new kernel " << key << '\n';
+                    continue;
+                }
+            for (const auto &kernel_time : result.results)
+                {
+                    const auto base_arch = base->second.find(kernel_time.first);
+                    if (base_arch == base->second.end())
+                        {
+                            std::cout << "  new protokernel " << key << " " << kernel_time.first << '\n';
+                            continue;
+                        }
+                    if (!kernel_time.second.pass or !base_arch->second.second)
+                        {
+                            if (!kernel_time.second.pass)
+                                {
+                                    std::cout << "  FAILED " << key << " " << kernel_time.first << '\n';
+                                }
+                            continue;  // the times of wrong results are meaningless
+                        }
+                    const double now_ms = kernel_time.second.time / std::max(1U, result.iter);
+                    const double base_ms = base_arch->second.first;
+                    compared++;
+                    if (base_ms <= 0.0)
+                        {
+                            continue;
+                        }
+                    const double ratio = now_ms / base_ms;
+                    if (ratio > threshold)
+                        {
+                            regressions++;
+                            std::cout << "  REGRESSION " << key << " " << kernel_time.first << ": "
+                                      << base_ms * 1e3 << " -> " << now_ms * 1e3 << " us/call (+"
+                                      << (ratio - 1.0) * 100.0 << " %)\n";
+                        }
+                    else if (ratio < 1.0 / threshold)
+                        {
+                            improvements++;
+                            std::cout << "  improvement " << key << " " << kernel_time.first << ": "
+                                      << base_ms * 1e3 << " -> " << now_ms * 1e3 << " us/call ("
+                                      << (ratio - 1.0) * 100.0 << " %)\n";
+                        }
+                }
+        }
+    std::cout << compared << " protokernels compared, " << regressions << " regressions, " << improvements << " improvements\n";
+    return regressions;
+}
@@ -13,9 +13,11 @@
  * -----------------------------------------------------------------------------
  */
 
-#include <iosfwd>  // for ofstream
-#include <string>  // for string
-#include <vector>  // for vector
+#include <iosfwd>   // for ofstream
+#include <map>      // for map
+#include <string>   // for string
+#include <utility>  // for pair
+#include <vector>   // for vector
 
 class volk_gnsssdr_test_results_t;
 
@@ -25,3 +27,17 @@ void read_results(std::vector<volk_gnsssdr_test_results_t> *results, std::string
 void write_results(const std::vector<volk_gnsssdr_test_results_t> *results, bool update_result);
 void write_results(const std::vector<volk_gnsssdr_test_results_t> *results, bool update_result, const std::string path);
 void write_json(std::ofstream &json_file, std::vector<volk_gnsssdr_test_results_t> results);
+
+/*!
+ * \brief Reads a JSON file written by write_json() into a map from
+ * "kernel(vlen)" to the time per call [ms] and the test result of each
+ * protokernel
+ */
+bool read_json(std::map<std::string, std::map<std::string, std::pair<double, bool>>> &baseline, const std::string &path);
+
+/*!
+ * \brief Prints the protokernels whose time per call is more than
+ * threshold_percent over the baseline (or under it). Returns the number of
+ * regressions, or -1 if the baseline cannot be read.
+ */
+int compare_with_baseline(const std::vector<volk_gnsssdr_test_results_t> &results, const std::string &path, float threshold_percent);
@@ -174,6 +174,11 @@ class kernel_class(object):
         self.arglist_types = ', '.join([a[0] for a in self.args])
         self.arglist_full = ', '.join(['%s %s'%a for a in self.args])
         self.arglist_names = ', '.join([a[1] for a in self.args])
+        # vector length argument, used to dispatch on profiled length buckets
+        self.length_arg = None
+        for arg_type, arg_name in self.args:
+            if arg_name in ('num_points', 'num_output_samples') and '*' not in arg_type:
+                self.length_arg = arg_name
 
     def get_impls(self, archs):
         archs = set(archs)
@@ -15,6 +15,10 @@
 #define INCLUDED_VOLK_GNSSSDR_ALLOC_H
 
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <new>
@@ -23,7 +27,86 @@
 namespace volk_gnsssdr
 {
 /*!
- * \brief C++11 allocator using volk_gnsssdr_malloc and volk_gnsssdr_free
+ * \brief Bytes held by volk_gnsssdr::alloc, per allocation tag
+ *
+ * \details
+ *   Each allocation is charged to the tag of the calling thread (0 unless
+ *   changed with alloc_tag_scope), and released from that same tag by any
+ *   thread, so that the users of the library can tell which part of the
+ *   program holds the memory. The tag is kept in front of the block.
+ */
+class alloc_accounting
+{
+public:
+    static constexpr std::size_t max_tags = 16;
+
+    static std::int64_t bytes(unsigned char tag) { return counters().bytes[tag % max_tags].load(std::memory_order_relaxed); }
+    static std::int64_t peak_bytes(unsigned char tag) { return counters().peak_bytes[tag % max_tags].load(std::memory_order_relaxed); }
+    static std::int64_t blocks(unsigned char tag) { return counters().blocks[tag % max_tags].load(std::memory_order_relaxed); }
+
+    static unsigned char& thread_tag()
+    {
+        thread_local unsigned char tag = 0;
+        return tag;
+    }
+
+    static void charge(unsigned char tag, std::int64_t bytes)
+    {
+        auto& c = counters();
+        const std::int64_t held = c.bytes[tag].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        c.blocks[tag].fetch_add(bytes > 0 ? 1 : -1, std::memory_order_relaxed);
+        std::int64_t peak = c.peak_bytes[tag].load(std::memory_order_relaxed);
+        while (held > peak and !c.peak_bytes[tag].compare_exchange_weak(peak, held, std::memory_order_relaxed))
+            {
+            }
+    }
+
+    /*!
+     * \brief Bytes in front of each block, keeping the alignment
+     */
+    static std::size_t header_size()
+    {
+        return std::max(volk_gnsssdr_get_alignment(), alignof(std::max_align_t));
+    }
+
+private:
+    struct tag_counters
+    {
+        std::atomic<std::int64_t> bytes[max_tags];
+        std::atomic<std::int64_t> peak_bytes[max_tags];
+        std::atomic<std::int64_t> blocks[max_tags];
+    };
+
+    static tag_counters& counters()
+    {
+        static tag_counters c{};
+        return c;
+    }
+};
+
+
+/*!
+ * \brief Sets the allocation tag of the calling thread for its lifetime
+ */
+class alloc_tag_scope
+{
+public:
+    explicit alloc_tag_scope(unsigned char tag) : previous_(alloc_accounting::thread_tag())
+    {
+        alloc_accounting::thread_tag() = static_cast<unsigned char>(tag % alloc_accounting::max_tags);
+    }
+    ~alloc_tag_scope() { alloc_accounting::thread_tag() = previous_; }
+    alloc_tag_scope(const alloc_tag_scope&) = delete;
+    alloc_tag_scope& operator=(const alloc_tag_scope&) = delete;
+
+private:
+    unsigned char previous_;
+};
+
+
+/*!
+ * \brief C++11 allocator using volk_gnsssdr_malloc and volk_gnsssdr_free,
+ * accounted in alloc_accounting
  *
  * \details
  *   adapted from https://en.cppreference.com/w/cpp/named_req/Alloc
@@ -40,15 +123,27 @@ struct alloc
 
     T* allocate(std::size_t n)
     {
-        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        const std::size_t header = alloc_accounting::header_size();
+        if (n > (std::numeric_limits<std::size_t>::max() - header) / sizeof(T)) throw std::bad_alloc();
 
-        if (auto p = static_cast<T*>(volk_gnsssdr_malloc(n * sizeof(T), volk_gnsssdr_get_alignment())))
-            return p;
+        if (auto p = static_cast<unsigned char*>(volk_gnsssdr_malloc(header + n * sizeof(T), volk_gnsssdr_get_alignment())))
+            {
+                const unsigned char tag = alloc_accounting::thread_tag();
+                p[header - 1] = tag;
+                alloc_accounting::charge(tag, static_cast<std::int64_t>(n * sizeof(T)));
+                return reinterpret_cast<T*>(p + header);
+            }
 
         throw std::bad_alloc();
     }
 
-    void deallocate(T* p, std::size_t) noexcept { volk_gnsssdr_free(p); }
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (p == nullptr) return;
+        auto block = reinterpret_cast<unsigned char*>(p) - alloc_accounting::header_size();
+        alloc_accounting::charge(block[alloc_accounting::header_size() - 1], -static_cast<std::int64_t>(n * sizeof(T)));
+        volk_gnsssdr_free(block);
+    }
 };
 
 template <class T, class U>
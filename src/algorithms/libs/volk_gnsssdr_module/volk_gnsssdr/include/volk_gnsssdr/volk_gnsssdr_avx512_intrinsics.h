@@ -0,0 +1,37 @@
+/*!
+ * \file volk_gnsssdr_avx512_intrinsics.h
+ * \brief This file is intended to hold AVX-512 intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-paste.
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#define INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#include <immintrin.h>
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+    __m512 yl, yh, tmp2;
+    yl = _mm512_moveldup_ps(y);              // Load yl with cr,cr,dr,dr ...
+    yh = _mm512_movehdup_ps(y);              // Load yh with ci,ci,di,di ...
+    tmp2 = _mm512_permute_ps(x, 0xB1);       // Re-arrange x to be ai,ar,bi,br ...
+    tmp2 = _mm512_mul_ps(tmp2, yh);          // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+    return _mm512_fmaddsub_ps(x, yl, tmp2);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di ...
+}
+
+static inline __m512 _mm512_complexnormalise_ps(__m512 z)
+{
+    __m512 tmp1 = _mm512_mul_ps(z, z);
+    __m512 tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));  // |z|^2 in both components
+    tmp2 = _mm512_sqrt_ps(tmp2);
+    return _mm512_div_ps(z, tmp2);
+}
+
+#endif /* INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H */
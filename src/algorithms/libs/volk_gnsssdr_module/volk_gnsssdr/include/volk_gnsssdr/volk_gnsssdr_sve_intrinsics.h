@@ -0,0 +1,85 @@
+/*!
+ * \file volk_gnsssdr_sve_intrinsics.h
+ * \brief Holds SVE intrinsics of intrinsics.
+ * They can be used in VOLK_GNSSSDR kernels to avoid copy-paste
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_VOLK_GNSSSDR_SVE_INTRINSICS_H
+#define INCLUDED_VOLK_GNSSSDR_SVE_INTRINSICS_H
+
+#include <arm_sve.h>
+
+/* Cosine and sine of the active lanes of x, as {cos, sin} so they can be
+ * stored interleaved with svst2_f32. Same Cephes-based approximation as the
+ * NEON and SSE kernels. */
+static inline svfloat32x2_t _svsincos_f32(svbool_t pg, svfloat32_t x)
+{
+    const float c_minus_cephes_DP1 = -0.78515625;
+    const float c_minus_cephes_DP2 = -2.4187564849853515625e-4;
+    const float c_minus_cephes_DP3 = -3.77489497744594108e-8;
+    const float c_sincof_p0 = -1.9515295891E-4;
+    const float c_sincof_p1 = 8.3321608736E-3;
+    const float c_sincof_p2 = -1.6666654611E-1;
+    const float c_coscof_p0 = 2.443315711809948E-005;
+    const float c_coscof_p1 = -1.388731625493765E-003;
+    const float c_coscof_p2 = 4.166664568298827E-002;
+    const float c_cephes_FOPI = 1.27323954473516;
+
+    svfloat32_t y, y1, y2, ys, yc, z;
+    svuint32_t emm2;
+    svbool_t poly_mask, sign_mask_sin, keep_sign_cos;
+
+    sign_mask_sin = svcmplt_n_f32(pg, x, 0.0f);
+    x = svabs_f32_x(pg, x);
+
+    /* scale by 4/Pi */
+    y = svmul_n_f32_x(pg, x, c_cephes_FOPI);
+
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = svcvt_u32_f32_x(pg, y);
+    emm2 = svadd_n_u32_x(pg, emm2, 1);
+    emm2 = svand_n_u32_x(pg, emm2, ~1U);
+    y = svcvt_f32_u32_x(pg, emm2);
+
+    /* polynom selection mask: one polynom for 0 <= x <= Pi/4
+       and another one for Pi/4 < x <= Pi/2. Both are computed. */
+    poly_mask = svcmpne_n_u32(pg, svand_n_u32_x(pg, emm2, 2), 0);
+
+    /* The magic pass: "Extended precision modular arithmetic"
+       x = ((x - y * DP1) - y * DP2) - y * DP3; */
+    x = svmla_n_f32_x(pg, x, y, c_minus_cephes_DP1);
+    x = svmla_n_f32_x(pg, x, y, c_minus_cephes_DP2);
+    x = svmla_n_f32_x(pg, x, y, c_minus_cephes_DP3);
+
+    sign_mask_sin = sveor_b_z(pg, sign_mask_sin, svcmpne_n_u32(pg, svand_n_u32_x(pg, emm2, 4), 0));
+    keep_sign_cos = svcmpne_n_u32(pg, svand_n_u32_x(pg, svsub_n_u32_x(pg, emm2, 2), 4), 0);
+
+    /* Evaluate the first polynom  (0 <= x <= Pi/4) in y1,
+       and the second polynom      (Pi/4 <= x <= 0) in y2 */
+    z = svmul_f32_x(pg, x, x);
+
+    y1 = svmad_n_f32_x(pg, z, svdup_n_f32(c_coscof_p0), c_coscof_p1);
+    y2 = svmad_n_f32_x(pg, z, svdup_n_f32(c_sincof_p0), c_sincof_p1);
+    y1 = svmad_n_f32_x(pg, y1, z, c_coscof_p2);
+    y2 = svmad_n_f32_x(pg, y2, z, c_sincof_p2);
+    y1 = svmul_f32_x(pg, svmul_f32_x(pg, y1, z), z);
+    y2 = svmul_f32_x(pg, svmul_f32_x(pg, y2, z), x);
+    y1 = svmls_n_f32_x(pg, y1, z, 0.5f);
+    y2 = svadd_f32_x(pg, y2, x);
+    y1 = svadd_n_f32_x(pg, y1, 1.0f);
+
+    /* select the correct result from the two polynoms */
+    ys = svsel_f32(poly_mask, y1, y2);
+    yc = svsel_f32(poly_mask, y2, y1);
+    return svcreate2_f32(svsel_f32(keep_sign_cos, yc, svneg_f32_x(pg, yc)),
+        svsel_f32(sign_mask_sin, svneg_f32_x(pg, ys), ys));
+}
+
+#endif /* INCLUDED_VOLK_GNSSSDR_SVE_INTRINSICS_H */
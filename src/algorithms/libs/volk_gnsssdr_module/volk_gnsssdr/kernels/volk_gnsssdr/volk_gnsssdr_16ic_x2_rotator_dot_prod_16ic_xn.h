@@ -1286,6 +1286,294 @@ static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_a_avx2_reload(l
 #endif /* LV_HAVE_AVX2 */
 
 
+#ifdef LV_HAVE_AVX512BW
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_a_avx512bw(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_16sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 16;
+    const lv_16sc_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_16sc_t dotProductVector[16];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m512i* realcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), volk_gnsssdr_get_alignment());
+    __m512i* imagcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_setzero_si512();
+            imagcacc[n_vec] = _mm512_setzero_si512();
+        }
+
+    const __m512i mask_real = _mm512_set1_epi32(0x0000FFFF);
+    const __m512i mask_imag = _mm512_set1_epi32((int)0xFFFF0000);
+
+    // Set up the complex rotator, 16 samples at a time
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    lv_32fc_t _phase = (*phase);
+    for (n = 0; n < 16; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m512 z0 = _mm512_load_ps((float*)phase_vec);
+    __m512 z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+    for (n = 0; n < 8; n++)
+        {
+            phase_vec[n] = dz;
+        }
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    __m512 s0, s1;
+    __m512i a2, b2, c, c_sr, real, imag;
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // convert 16 samples from 16ic to 32fc, and rotate them
+            s0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_load_si256((const __m256i*)_in_common)));
+            s1 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_load_si256((const __m256i*)(_in_common + 8))));
+            s0 = _mm512_complexmul_ps(s0, z0);
+            s1 = _mm512_complexmul_ps(s1, z1);
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            // round to 32ic, and convert to 16ic with saturation
+            b2 = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(s0))), _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(s1)), 1);
+            _in_common += 16;
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 32);
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a2 = _mm512_load_si512((const void*)&(_in_a[n_vec][number * 16]));
+
+                    c = _mm512_mullo_epi16(a2, b2);
+
+                    c_sr = _mm512_bsrli_epi128(c, 2);  // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+                    real = _mm512_subs_epi16(c, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(b2, 2);
+                    c = _mm512_mullo_epi16(a2, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(a2, 2);
+                    imag = _mm512_mullo_epi16(b2, c_sr);
+
+                    imag = _mm512_adds_epi16(c, imag);
+
+                    realcacc[n_vec] = _mm512_adds_epi16(realcacc[n_vec], real);
+                    imagcacc[n_vec] = _mm512_adds_epi16(imagcacc[n_vec], imag);
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_and_si512(realcacc[n_vec], mask_real);
+            imagcacc[n_vec] = _mm512_and_si512(imagcacc[n_vec], mask_imag);
+
+            a2 = _mm512_or_si512(realcacc[n_vec], imagcacc[n_vec]);
+
+            _mm512_store_si512((void*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 16; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    (*phase) = phase_vec[0];
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+#endif /* LV_HAVE_AVX512BW */
+
+
+#ifdef LV_HAVE_AVX512BW
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_u_avx512bw(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_16sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 16;
+    const lv_16sc_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_16sc_t dotProductVector[16];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m512i* realcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), volk_gnsssdr_get_alignment());
+    __m512i* imagcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_setzero_si512();
+            imagcacc[n_vec] = _mm512_setzero_si512();
+        }
+
+    const __m512i mask_real = _mm512_set1_epi32(0x0000FFFF);
+    const __m512i mask_imag = _mm512_set1_epi32((int)0xFFFF0000);
+
+    // Set up the complex rotator, 16 samples at a time
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    lv_32fc_t _phase = (*phase);
+    for (n = 0; n < 16; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m512 z0 = _mm512_load_ps((float*)phase_vec);
+    __m512 z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+    for (n = 0; n < 8; n++)
+        {
+            phase_vec[n] = dz;
+        }
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    __m512 s0, s1;
+    __m512i a2, b2, c, c_sr, real, imag;
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // convert 16 samples from 16ic to 32fc, and rotate them
+            s0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)_in_common)));
+            s1 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)(_in_common + 8))));
+            s0 = _mm512_complexmul_ps(s0, z0);
+            s1 = _mm512_complexmul_ps(s1, z1);
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            // round to 32ic, and convert to 16ic with saturation
+            b2 = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(s0))), _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(s1)), 1);
+            _in_common += 16;
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 32);
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a2 = _mm512_loadu_si512((const void*)&(_in_a[n_vec][number * 16]));
+
+                    c = _mm512_mullo_epi16(a2, b2);
+
+                    c_sr = _mm512_bsrli_epi128(c, 2);  // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+                    real = _mm512_subs_epi16(c, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(b2, 2);
+                    c = _mm512_mullo_epi16(a2, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(a2, 2);
+                    imag = _mm512_mullo_epi16(b2, c_sr);
+
+                    imag = _mm512_adds_epi16(c, imag);
+
+                    realcacc[n_vec] = _mm512_adds_epi16(realcacc[n_vec], real);
+                    imagcacc[n_vec] = _mm512_adds_epi16(imagcacc[n_vec], imag);
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_and_si512(realcacc[n_vec], mask_real);
+            imagcacc[n_vec] = _mm512_and_si512(imagcacc[n_vec], mask_imag);
+
+            a2 = _mm512_or_si512(realcacc[n_vec], imagcacc[n_vec]);
+
+            _mm512_store_si512((void*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 16; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    (*phase) = phase_vec[0];
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+#endif /* LV_HAVE_AVX512BW */
+
+
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
 
@@ -0,0 +1,291 @@
+/*!
+ * \file volk_gnsssdr_32f_index_max_stats_32u.h
+ * \brief VOLK_GNSSSDR kernel: finds the index of the maximum value of a vector
+ * and accumulates its sum and sum of squares in the same pass.
+ *
+ * VOLK_GNSSSDR kernel that returns the index and value of the maximum of a
+ * float vector, together with the sum and the sum of squares of its elements.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_index_max_stats_32u
+ *
+ * \b Overview
+ *
+ * Finds the index of the maximum value in the given vector and, in the same
+ * pass over the data, computes the sum and the sum of squares of all its
+ * elements. If the maximum value appears more than once, the lowest index is
+ * returned, as in the generic version of volk_gnsssdr_32f_index_max_32u.
+ *
+ * The SIMD versions keep the indexes as 32-bit integers, so they are exact for
+ * any vector length, and accumulate the sums lane by lane. The sums can thus
+ * differ from those of the generic version in the last bits.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_index_max_stats_32u(uint32_t* target, float* stats, const float* src0, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li src0: The input vector of floats.
+ * \li num_points: The number of data points.
+ *
+ * \b Outputs
+ * \li target: The index of the maximum value in the input buffer.
+ * \li stats: stats[0] is the maximum value, stats[1] the sum of the elements
+ * and stats[2] the sum of their squares.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_index_max_stats_32u_H
+#define INCLUDED_volk_gnsssdr_32f_index_max_stats_32u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+
+
+// Merges the per-lane results of the SIMD versions, taking the lowest index
+// among the lanes that hold the maximum, and processes the remaining points
+static inline void volk_gnsssdr_32f_index_max_stats_32u_reduce(uint32_t* target, float* stats, const float* max_values, const uint32_t* max_indexes,
+    const float* sums, const float* sums_sq, unsigned int lanes, const float* src0, unsigned int first, unsigned int num_points)
+{
+    float max = max_values[0];
+    uint32_t index = max_indexes[0];
+    float sum = 0.0F;
+    float sum_sq = 0.0F;
+    unsigned int k;
+
+    for (k = 0; k < lanes; k++)
+        {
+            if (max_values[k] > max || (max_values[k] == max && max_indexes[k] < index))
+                {
+                    max = max_values[k];
+                    index = max_indexes[k];
+                }
+            sum += sums[k];
+            sum_sq += sums_sq[k];
+        }
+    for (k = first; k < num_points; k++)
+        {
+            if (src0[k] > max)
+                {
+                    max = src0[k];
+                    index = k;
+                }
+            sum += src0[k];
+            sum_sq += src0[k] * src0[k];
+        }
+
+    target[0] = index;
+    stats[0] = max;
+    stats[1] = sum;
+    stats[2] = sum_sq;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_index_max_stats_32u_generic(uint32_t* target, float* stats, const float* src0, unsigned int num_points)
+{
+    float max = num_points > 0 ? src0[0] : 0.0F;
+    uint32_t index = 0;
+    float sum = 0.0F;
+    float sum_sq = 0.0F;
+    unsigned int number;
+
+    for (number = 0; number < num_points; number++)
+        {
+            if (src0[number] > max)
+                {
+                    max = src0[number];
+                    index = number;
+                }
+            sum += src0[number];
+            sum_sq += src0[number] * src0[number];
+        }
+
+    target[0] = index;
+    stats[0] = max;
+    stats[1] = sum;
+    stats[2] = sum_sq;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32f_index_max_stats_32u_u_sse2(uint32_t* target, float* stats, const float* src0, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float* inputPtr = src0;
+    unsigned int number;
+
+    __VOLK_ATTR_ALIGNED(16)
+    float max_values[4];
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t max_indexes[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sums[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float sums_sq[4];
+
+    if (sse_iters == 0)
+        {
+            volk_gnsssdr_32f_index_max_stats_32u_generic(target, stats, src0, num_points);
+            return;
+        }
+
+    const __m128i index_increment = _mm_set1_epi32(4);
+    __m128i current_indexes = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i max_values_index = _mm_setzero_si128();
+    __m128 max_val = _mm_set1_ps(src0[0]);
+    __m128 sum_val = _mm_setzero_ps();
+    __m128 sum_sq_val = _mm_setzero_ps();
+    __m128 current_values, compare_results;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            current_values = _mm_loadu_ps(inputPtr);
+            compare_results = _mm_cmpgt_ps(current_values, max_val);
+            max_values_index = _mm_or_si128(_mm_and_si128(_mm_castps_si128(compare_results), current_indexes), _mm_andnot_si128(_mm_castps_si128(compare_results), max_values_index));
+            max_val = _mm_max_ps(current_values, max_val);
+            sum_val = _mm_add_ps(sum_val, current_values);
+            sum_sq_val = _mm_add_ps(sum_sq_val, _mm_mul_ps(current_values, current_values));
+            current_indexes = _mm_add_epi32(current_indexes, index_increment);
+            inputPtr += 4;
+        }
+
+    _mm_store_ps(max_values, max_val);
+    _mm_store_si128((__m128i*)max_indexes, max_values_index);
+    _mm_store_ps(sums, sum_val);
+    _mm_store_ps(sums_sq, sum_sq_val);
+    volk_gnsssdr_32f_index_max_stats_32u_reduce(target, stats, max_values, max_indexes, sums, sums_sq, 4, src0, sse_iters * 4, num_points);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_index_max_stats_32u_u_avx2(uint32_t* target, float* stats, const float* src0, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* inputPtr = src0;
+    unsigned int number;
+
+    __VOLK_ATTR_ALIGNED(32)
+    float max_values[8];
+    __VOLK_ATTR_ALIGNED(32)
+    uint32_t max_indexes[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float sums[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float sums_sq[8];
+
+    if (avx_iters == 0)
+        {
+            volk_gnsssdr_32f_index_max_stats_32u_generic(target, stats, src0, num_points);
+            return;
+        }
+
+    const __m256i index_increment = _mm256_set1_epi32(8);
+    __m256i current_indexes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i max_values_index = _mm256_setzero_si256();
+    __m256 max_val = _mm256_set1_ps(src0[0]);
+    __m256 sum_val = _mm256_setzero_ps();
+    __m256 sum_sq_val = _mm256_setzero_ps();
+    __m256 current_values, compare_results;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            current_values = _mm256_loadu_ps(inputPtr);
+            compare_results = _mm256_cmp_ps(current_values, max_val, _CMP_GT_OQ);
+            max_values_index = _mm256_blendv_epi8(max_values_index, current_indexes, _mm256_castps_si256(compare_results));
+            max_val = _mm256_max_ps(current_values, max_val);
+            sum_val = _mm256_add_ps(sum_val, current_values);
+            sum_sq_val = _mm256_add_ps(sum_sq_val, _mm256_mul_ps(current_values, current_values));
+            current_indexes = _mm256_add_epi32(current_indexes, index_increment);
+            inputPtr += 8;
+        }
+
+    _mm256_store_ps(max_values, max_val);
+    _mm256_store_si256((__m256i*)max_indexes, max_values_index);
+    _mm256_store_ps(sums, sum_val);
+    _mm256_store_ps(sums_sq, sum_sq_val);
+    volk_gnsssdr_32f_index_max_stats_32u_reduce(target, stats, max_values, max_indexes, sums, sums_sq, 8, src0, avx_iters * 8, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_index_max_stats_32u_neon(uint32_t* target, float* stats, const float* src0, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const float32_t* inputPtr = (const float32_t*)src0;
+    unsigned int number;
+
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t max_values[4];
+    __VOLK_ATTR_ALIGNED(16)
+    uint32_t max_indexes[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t sums[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t sums_sq[4];
+    __VOLK_ATTR_ALIGNED(16)
+    const uint32_t first_indexes[4] = {0, 1, 2, 3};
+
+    if (neon_iters == 0)
+        {
+            volk_gnsssdr_32f_index_max_stats_32u_generic(target, stats, src0, num_points);
+            return;
+        }
+
+    const uint32x4_t index_increment = vdupq_n_u32(4);
+    uint32x4_t current_indexes = vld1q_u32(first_indexes);
+    uint32x4_t max_values_index = vdupq_n_u32(0);
+    uint32x4_t compare_results;
+    float32x4_t max_val = vdupq_n_f32(src0[0]);
+    float32x4_t sum_val = vdupq_n_f32(0.0F);
+    float32x4_t sum_sq_val = vdupq_n_f32(0.0F);
+    float32x4_t current_values;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            current_values = vld1q_f32(inputPtr);
+            __VOLK_GNSSSDR_PREFETCH(inputPtr + 8);
+            compare_results = vcgtq_f32(current_values, max_val);
+            max_values_index = vbslq_u32(compare_results, current_indexes, max_values_index);
+            max_val = vbslq_f32(compare_results, current_values, max_val);
+            sum_val = vaddq_f32(sum_val, current_values);
+            sum_sq_val = vmlaq_f32(sum_sq_val, current_values, current_values);
+            current_indexes = vaddq_u32(current_indexes, index_increment);
+            inputPtr += 4;
+        }
+
+    vst1q_f32(max_values, max_val);
+    vst1q_u32(max_indexes, max_values_index);
+    vst1q_f32(sums, sum_val);
+    vst1q_f32(sums_sq, sum_sq_val);
+    volk_gnsssdr_32f_index_max_stats_32u_reduce(target, stats, max_values, max_indexes, sums, sums_sq, 4, src0, neon_iters * 4, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_index_max_stats_32u_H */
@@ -0,0 +1,61 @@
+/*!
+ * \file volk_gnsssdr_32f_index_max_statspuppet_32u.h
+ * \brief VOLK_GNSSSDR puppet for the fused peak search and statistics kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating volk_gnsssdr_32f_index_max_stats_32u
+ * into the test system. Only the index of the maximum is compared, since the
+ * sums are accumulated in a different order by each implementation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_index_max_statspuppet_32u_H
+#define INCLUDED_volk_gnsssdr_32f_index_max_statspuppet_32u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_index_max_stats_32u.h"
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32f_index_max_statspuppet_32u_generic(uint32_t* target, const float* src0, unsigned int num_points)
+{
+    float stats[3];
+    volk_gnsssdr_32f_index_max_stats_32u_generic(target, stats, src0, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_32f_index_max_statspuppet_32u_u_sse2(uint32_t* target, const float* src0, unsigned int num_points)
+{
+    float stats[3];
+    volk_gnsssdr_32f_index_max_stats_32u_u_sse2(target, stats, src0, num_points);
+}
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_32f_index_max_statspuppet_32u_u_avx2(uint32_t* target, const float* src0, unsigned int num_points)
+{
+    float stats[3];
+    volk_gnsssdr_32f_index_max_stats_32u_u_avx2(target, stats, src0, num_points);
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32f_index_max_statspuppet_32u_neon(uint32_t* target, const float* src0, unsigned int num_points)
+{
+    float stats[3];
+    volk_gnsssdr_32f_index_max_stats_32u_neon(target, stats, src0, num_points);
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_index_max_statspuppet_32u_H */
@@ -734,4 +734,23 @@ static inline void volk_gnsssdr_32f_sincos_32fc_neon(lv_32fc_t* out, const float
 #endif /* LV_HAVE_NEON  */
 
 
+#ifdef LV_HAVE_SVE
+#include <volk_gnsssdr/volk_gnsssdr_sve_intrinsics.h>
+
+static inline void volk_gnsssdr_32f_sincos_32fc_sve(lv_32fc_t* out, const float* in, unsigned int num_points)
+{
+    const unsigned int sve_step = (unsigned int)svcntw();
+    unsigned int number;
+    svbool_t pg;
+
+    for (number = 0; number < num_points; number += sve_step)
+        {
+            pg = svwhilelt_b32_u32(number, num_points);
+            svst2_f32(pg, (float*)(out + number), _svsincos_f32(pg, svld1_f32(pg, in + number)));
+        }
+}
+
+#endif /* LV_HAVE_SVE  */
+
+
 #endif /* INCLUDED_volk_gnsssdr_32f_sincos_32fc_H  */
@@ -0,0 +1,381 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi27_acs_8u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select steps of a Viterbi decoder
+ * for the K=7, rate 1/2 convolutional code.
+ *
+ * VOLK_GNSSSDR kernel that runs the forward pass of a soft-decision Viterbi
+ * decoder for the constraint length 7, rate 1/2 code used by Galileo I/NAV
+ * and F/NAV, SBAS and GPS CNAV, and stores the survivor decisions.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_viterbi27_acs_8u
+ *
+ * \b Overview
+ *
+ * Updates the 64 path metrics of the trellis with num_points pairs of soft
+ * symbols. The encoder state is the last six input bits, the newest one being
+ * the most significant, so each butterfly j connects states 2j and 2j+1 at
+ * time t with states j (input bit 0) and j+32 (input bit 1) at time t+1.
+ * Both polynomials must have their first and last taps set, so that the
+ * branch from 2j to j carries the complement of the symbols of the branches
+ * from 2j to j+32 and from 2j+1 to j, and the same symbols as the branch from
+ * 2j+1 to j+32.
+ *
+ * Branch metrics are correlations: a branch whose symbols are (c0, c1) adds
+ * (c0 ? r0 : -r0) + (c1 ? r1 : -r1) to the path metric, where (r0, r1) are the
+ * received soft symbols, positive for a one, and the path with the largest
+ * metric survives. After each step, the metric of state 0 is subtracted from
+ * all the metrics to keep them bounded.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_viterbi27_acs_8u(uint8_t* decisions, float* metrics, const float* symbols, const uint8_t* branch_outputs, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics:        Path metrics of the 64 states before the first step.
+ * \li symbols:        Soft symbols, two per step (2 * num_points values).
+ * \li branch_outputs: For each butterfly j (32 entries), encoder output from state 2j with input bit 0: bit 1 is the first symbol and bit 0 the second one.
+ * \li num_points:     Number of trellis steps (decoded bits).
+ *
+ * \b Outputs
+ * \li decisions:      64 bytes per step. decisions[64 * t + s] is 1 if the survivor path of state s at time t+1 comes from state 2 * (s % 32) + 1, and 0 if it comes from state 2 * (s % 32).
+ * \li metrics:        Path metrics after the last step.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi27_acs_8u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi27_acs_8u_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_viterbi27_acs_8u_generic(uint8_t* decisions, float* metrics, const float* symbols, const uint8_t* branch_outputs, unsigned int num_points)
+{
+    float new_metrics[64];
+    float mu, m0, m1, norm;
+    unsigned int t;
+    unsigned int j;
+
+    for (t = 0; t < num_points; t++)
+        {
+            for (j = 0; j < 32; j++)
+                {
+                    mu = ((branch_outputs[j] & 2) ? symbols[2 * t] : -symbols[2 * t]) + ((branch_outputs[j] & 1) ? symbols[2 * t + 1] : -symbols[2 * t + 1]);
+
+                    m0 = metrics[2 * j] + mu;
+                    m1 = metrics[2 * j + 1] - mu;
+                    decisions[j] = m1 > m0;
+                    new_metrics[j] = m1 > m0 ? m1 : m0;
+
+                    m0 = metrics[2 * j] - mu;
+                    m1 = metrics[2 * j + 1] + mu;
+                    decisions[j + 32] = m1 > m0;
+                    new_metrics[j + 32] = m1 > m0 ? m1 : m0;
+                }
+
+            norm = new_metrics[0];
+            for (j = 0; j < 64; j++)
+                {
+                    metrics[j] = new_metrics[j] - norm;
+                }
+            decisions += 64;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi27_acs_8u_u_sse2(uint8_t* decisions, float* metrics, const float* symbols, const uint8_t* branch_outputs, unsigned int num_points)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    __m128 sign0[8];
+    __m128 sign1[8];
+    __m128 even[8];
+    __m128 odd[8];
+    __m128 new_lo[8];
+    __m128 new_hi[8];
+    __m128i dec_lo[8];
+    __m128i dec_hi[8];
+    __m128 a, b, r0, r1, mu, m0, m1, norm;
+    unsigned int t;
+    unsigned int j;
+
+    // Sign masks that turn the received symbols into the metric of each butterfly
+    for (j = 0; j < 8; j++)
+        {
+            sign0[j] = _mm_castsi128_ps(_mm_setr_epi32((branch_outputs[4 * j] & 2) ? 0 : (int)0x80000000, (branch_outputs[4 * j + 1] & 2) ? 0 : (int)0x80000000,
+                (branch_outputs[4 * j + 2] & 2) ? 0 : (int)0x80000000, (branch_outputs[4 * j + 3] & 2) ? 0 : (int)0x80000000));
+            sign1[j] = _mm_castsi128_ps(_mm_setr_epi32((branch_outputs[4 * j] & 1) ? 0 : (int)0x80000000, (branch_outputs[4 * j + 1] & 1) ? 0 : (int)0x80000000,
+                (branch_outputs[4 * j + 2] & 1) ? 0 : (int)0x80000000, (branch_outputs[4 * j + 3] & 1) ? 0 : (int)0x80000000));
+        }
+
+    for (j = 0; j < 8; j++)
+        {
+            a = _mm_loadu_ps(metrics + 8 * j);
+            b = _mm_loadu_ps(metrics + 8 * j + 4);
+            even[j] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));  // metrics of states 2j
+            odd[j] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));   // metrics of states 2j+1
+        }
+
+    for (t = 0; t < num_points; t++)
+        {
+            r0 = _mm_set1_ps(symbols[2 * t]);
+            r1 = _mm_set1_ps(symbols[2 * t + 1]);
+
+            for (j = 0; j < 8; j++)
+                {
+                    mu = _mm_add_ps(_mm_xor_ps(r0, sign0[j]), _mm_xor_ps(r1, sign1[j]));
+
+                    m0 = _mm_add_ps(even[j], mu);
+                    m1 = _mm_sub_ps(odd[j], mu);
+                    dec_lo[j] = _mm_castps_si128(_mm_cmpgt_ps(m1, m0));
+                    new_lo[j] = _mm_max_ps(m0, m1);  // states 4j to 4j+3
+
+                    m0 = _mm_sub_ps(even[j], mu);
+                    m1 = _mm_add_ps(odd[j], mu);
+                    dec_hi[j] = _mm_castps_si128(_mm_cmpgt_ps(m1, m0));
+                    new_hi[j] = _mm_max_ps(m0, m1);  // states 32+4j to 32+4j+3
+                }
+
+            // Normalize and split the new metrics in even and odd states again
+            norm = _mm_shuffle_ps(new_lo[0], new_lo[0], _MM_SHUFFLE(0, 0, 0, 0));
+            for (j = 0; j < 4; j++)
+                {
+                    a = _mm_sub_ps(new_lo[2 * j], norm);
+                    b = _mm_sub_ps(new_lo[2 * j + 1], norm);
+                    even[j] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    odd[j] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                    a = _mm_sub_ps(new_hi[2 * j], norm);
+                    b = _mm_sub_ps(new_hi[2 * j + 1], norm);
+                    even[j + 4] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    odd[j + 4] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                }
+
+            for (j = 0; j < 2; j++)
+                {
+                    _mm_storeu_si128((__m128i*)(decisions + 16 * j), _mm_and_si128(one, _mm_packs_epi16(_mm_packs_epi32(dec_lo[4 * j], dec_lo[4 * j + 1]), _mm_packs_epi32(dec_lo[4 * j + 2], dec_lo[4 * j + 3]))));
+                    _mm_storeu_si128((__m128i*)(decisions + 32 + 16 * j), _mm_and_si128(one, _mm_packs_epi16(_mm_packs_epi32(dec_hi[4 * j], dec_hi[4 * j + 1]), _mm_packs_epi32(dec_hi[4 * j + 2], dec_hi[4 * j + 3]))));
+                }
+            decisions += 64;
+        }
+
+    for (j = 0; j < 8; j++)
+        {
+            _mm_storeu_ps(metrics + 8 * j, _mm_unpacklo_ps(even[j], odd[j]));
+            _mm_storeu_ps(metrics + 8 * j + 4, _mm_unpackhi_ps(even[j], odd[j]));
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi27_acs_8u_u_avx2(uint8_t* decisions, float* metrics, const float* symbols, const uint8_t* branch_outputs, unsigned int num_points)
+{
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i dec_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256 sign0[4];
+    __m256 sign1[4];
+    __m256 even[4];
+    __m256 odd[4];
+    __m256 new_lo[4];
+    __m256 new_hi[4];
+    __m256i dec_lo[4];
+    __m256i dec_hi[4];
+    __m256 a, b, r0, r1, mu, m0, m1, norm;
+    unsigned int t;
+    unsigned int j;
+    unsigned int k;
+    int32_t mask0[8];
+    int32_t mask1[8];
+
+    // Sign masks that turn the received symbols into the metric of each butterfly
+    for (j = 0; j < 4; j++)
+        {
+            for (k = 0; k < 8; k++)
+                {
+                    mask0[k] = (branch_outputs[8 * j + k] & 2) ? 0 : (int32_t)0x80000000;
+                    mask1[k] = (branch_outputs[8 * j + k] & 1) ? 0 : (int32_t)0x80000000;
+                }
+            sign0[j] = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)mask0));
+            sign1[j] = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)mask1));
+        }
+
+    // _mm256_shuffle_ps works within 128-bit lanes, the 64-bit permutation
+    // puts the states back in order
+    for (j = 0; j < 4; j++)
+        {
+            a = _mm256_loadu_ps(metrics + 16 * j);
+            b = _mm256_loadu_ps(metrics + 16 * j + 8);
+            even[j] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8));
+            odd[j] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8));
+        }
+
+    for (t = 0; t < num_points; t++)
+        {
+            r0 = _mm256_set1_ps(symbols[2 * t]);
+            r1 = _mm256_set1_ps(symbols[2 * t + 1]);
+
+            for (j = 0; j < 4; j++)
+                {
+                    mu = _mm256_add_ps(_mm256_xor_ps(r0, sign0[j]), _mm256_xor_ps(r1, sign1[j]));
+
+                    m0 = _mm256_add_ps(even[j], mu);
+                    m1 = _mm256_sub_ps(odd[j], mu);
+                    dec_lo[j] = _mm256_castps_si256(_mm256_cmp_ps(m1, m0, _CMP_GT_OQ));
+                    new_lo[j] = _mm256_max_ps(m0, m1);  // states 8j to 8j+7
+
+                    m0 = _mm256_sub_ps(even[j], mu);
+                    m1 = _mm256_add_ps(odd[j], mu);
+                    dec_hi[j] = _mm256_castps_si256(_mm256_cmp_ps(m1, m0, _CMP_GT_OQ));
+                    new_hi[j] = _mm256_max_ps(m0, m1);  // states 32+8j to 32+8j+7
+                }
+
+            // Normalize and split the new metrics in even and odd states again
+            norm = _mm256_broadcastss_ps(_mm256_castps256_ps128(new_lo[0]));
+            for (j = 0; j < 2; j++)
+                {
+                    a = _mm256_sub_ps(new_lo[2 * j], norm);
+                    b = _mm256_sub_ps(new_lo[2 * j + 1], norm);
+                    even[j] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8));
+                    odd[j] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8));
+                    a = _mm256_sub_ps(new_hi[2 * j], norm);
+                    b = _mm256_sub_ps(new_hi[2 * j + 1], norm);
+                    even[j + 2] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8));
+                    odd[j + 2] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8));
+                }
+
+            // The packs work within 128-bit lanes too, and leave groups of
+            // four decisions that the final permutation puts in order
+            _mm256_storeu_si256((__m256i*)decisions, _mm256_and_si256(one, _mm256_permutevar8x32_epi32(_mm256_packs_epi16(_mm256_packs_epi32(dec_lo[0], dec_lo[1]), _mm256_packs_epi32(dec_lo[2], dec_lo[3])), dec_order)));
+            _mm256_storeu_si256((__m256i*)(decisions + 32), _mm256_and_si256(one, _mm256_permutevar8x32_epi32(_mm256_packs_epi16(_mm256_packs_epi32(dec_hi[0], dec_hi[1]), _mm256_packs_epi32(dec_hi[2], dec_hi[3])), dec_order)));
+            decisions += 64;
+        }
+
+    for (j = 0; j < 4; j++)
+        {
+            a = _mm256_unpacklo_ps(even[j], odd[j]);  // states 16j to 16j+3 and 16j+8 to 16j+11
+            b = _mm256_unpackhi_ps(even[j], odd[j]);  // states 16j+4 to 16j+7 and 16j+12 to 16j+15
+            _mm256_storeu_ps(metrics + 16 * j, _mm256_permute2f128_ps(a, b, 0x20));
+            _mm256_storeu_ps(metrics + 16 * j + 8, _mm256_permute2f128_ps(a, b, 0x31));
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_viterbi27_acs_8u_neon(uint8_t* decisions, float* metrics, const float* symbols, const uint8_t* branch_outputs, unsigned int num_points)
+{
+    uint32x4_t sign0[8];
+    uint32x4_t sign1[8];
+    float32x4_t even[8];
+    float32x4_t odd[8];
+    float32x4_t new_lo[8];
+    float32x4_t new_hi[8];
+    uint32x4_t dec_lo[8];
+    uint32x4_t dec_hi[8];
+    float32x4x2_t split;
+    float32x4x2_t merged;
+    float32x4_t m0, m1, mu, norm;
+    uint32x4_t r0, r1;
+    const uint8x16_t one = vdupq_n_u8(1);
+    uint32_t mask0[4];
+    uint32_t mask1[4];
+    unsigned int t;
+    unsigned int j;
+    unsigned int k;
+
+    // Sign masks that turn the received symbols into the metric of each butterfly
+    for (j = 0; j < 8; j++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    mask0[k] = (branch_outputs[4 * j + k] & 2) ? 0 : 0x80000000;
+                    mask1[k] = (branch_outputs[4 * j + k] & 1) ? 0 : 0x80000000;
+                }
+            sign0[j] = vld1q_u32(mask0);
+            sign1[j] = vld1q_u32(mask1);
+        }
+
+    for (j = 0; j < 8; j++)
+        {
+            split = vld2q_f32(metrics + 8 * j);  // states 2j in val[0], states 2j+1 in val[1]
+            even[j] = split.val[0];
+            odd[j] = split.val[1];
+        }
+
+    for (t = 0; t < num_points; t++)
+        {
+            r0 = vreinterpretq_u32_f32(vdupq_n_f32(symbols[2 * t]));
+            r1 = vreinterpretq_u32_f32(vdupq_n_f32(symbols[2 * t + 1]));
+
+            for (j = 0; j < 8; j++)
+                {
+                    mu = vaddq_f32(vreinterpretq_f32_u32(veorq_u32(r0, sign0[j])), vreinterpretq_f32_u32(veorq_u32(r1, sign1[j])));
+
+                    m0 = vaddq_f32(even[j], mu);
+                    m1 = vsubq_f32(odd[j], mu);
+                    dec_lo[j] = vcgtq_f32(m1, m0);
+                    new_lo[j] = vbslq_f32(dec_lo[j], m1, m0);  // states 4j to 4j+3
+
+                    m0 = vsubq_f32(even[j], mu);
+                    m1 = vaddq_f32(odd[j], mu);
+                    dec_hi[j] = vcgtq_f32(m1, m0);
+                    new_hi[j] = vbslq_f32(dec_hi[j], m1, m0);  // states 32+4j to 32+4j+3
+                }
+
+            // Normalize and split the new metrics in even and odd states again
+            norm = vdupq_n_f32(vgetq_lane_f32(new_lo[0], 0));
+            for (j = 0; j < 4; j++)
+                {
+                    split = vuzpq_f32(vsubq_f32(new_lo[2 * j], norm), vsubq_f32(new_lo[2 * j + 1], norm));
+                    even[j] = split.val[0];
+                    odd[j] = split.val[1];
+                    split = vuzpq_f32(vsubq_f32(new_hi[2 * j], norm), vsubq_f32(new_hi[2 * j + 1], norm));
+                    even[j + 4] = split.val[0];
+                    odd[j + 4] = split.val[1];
+                }
+
+            for (j = 0; j < 2; j++)
+                {
+                    vst1q_u8(decisions + 16 * j, vandq_u8(one, vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(dec_lo[4 * j]), vmovn_u32(dec_lo[4 * j + 1]))),
+                                                                 vmovn_u16(vcombine_u16(vmovn_u32(dec_lo[4 * j + 2]), vmovn_u32(dec_lo[4 * j + 3]))))));
+                    vst1q_u8(decisions + 32 + 16 * j, vandq_u8(one, vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(dec_hi[4 * j]), vmovn_u32(dec_hi[4 * j + 1]))),
+                                                                      vmovn_u16(vcombine_u16(vmovn_u32(dec_hi[4 * j + 2]), vmovn_u32(dec_hi[4 * j + 3]))))));
+                }
+            decisions += 64;
+        }
+
+    for (j = 0; j < 8; j++)
+        {
+            merged.val[0] = even[j];
+            merged.val[1] = odd[j];
+            vst2q_f32(metrics + 8 * j, merged);
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbi27_acs_8u_H */
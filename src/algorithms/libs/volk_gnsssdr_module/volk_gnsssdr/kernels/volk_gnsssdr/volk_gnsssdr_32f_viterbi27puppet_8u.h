@@ -0,0 +1,86 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi27puppet_8u.h
+ * \brief VOLK_GNSSSDR puppet for the K=7, rate 1/2 Viterbi add-compare-select kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating volk_gnsssdr_32f_viterbi27_acs_8u into the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi27puppet_8u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi27puppet_8u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_viterbi27_acs_8u.h"
+#include <string.h>
+
+// Encoder outputs of the butterflies of the Galileo I/NAV and F/NAV code,
+// with polynomials 171 and 133 (octal)
+static const uint8_t volk_gnsssdr_32f_viterbi27puppet_branch_outputs[32] = {
+    0, 1, 0, 1, 3, 2, 3, 2, 3, 2, 3, 2, 0, 1, 0, 1,
+    2, 3, 2, 3, 1, 0, 1, 0, 1, 0, 1, 0, 2, 3, 2, 3};
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32f_viterbi27puppet_8u_generic(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    // 64 decisions per decoded bit
+    const unsigned int num_bits = num_points / 64;
+    float metrics[64];
+    memset(metrics, 0, sizeof(metrics));
+    volk_gnsssdr_32f_viterbi27_acs_8u_generic(decisions, metrics, symbols, volk_gnsssdr_32f_viterbi27puppet_branch_outputs, num_bits);
+    memset(decisions + 64 * num_bits, 0, num_points - 64 * num_bits);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_32f_viterbi27puppet_8u_u_sse2(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    // 64 decisions per decoded bit
+    const unsigned int num_bits = num_points / 64;
+    float metrics[64];
+    memset(metrics, 0, sizeof(metrics));
+    volk_gnsssdr_32f_viterbi27_acs_8u_u_sse2(decisions, metrics, symbols, volk_gnsssdr_32f_viterbi27puppet_branch_outputs, num_bits);
+    memset(decisions + 64 * num_bits, 0, num_points - 64 * num_bits);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_32f_viterbi27puppet_8u_u_avx2(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    // 64 decisions per decoded bit
+    const unsigned int num_bits = num_points / 64;
+    float metrics[64];
+    memset(metrics, 0, sizeof(metrics));
+    volk_gnsssdr_32f_viterbi27_acs_8u_u_avx2(decisions, metrics, symbols, volk_gnsssdr_32f_viterbi27puppet_branch_outputs, num_bits);
+    memset(decisions + 64 * num_bits, 0, num_points - 64 * num_bits);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32f_viterbi27puppet_8u_neon(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    // 64 decisions per decoded bit
+    const unsigned int num_bits = num_points / 64;
+    float metrics[64];
+    memset(metrics, 0, sizeof(metrics));
+    volk_gnsssdr_32f_viterbi27_acs_8u_neon(decisions, metrics, symbols, volk_gnsssdr_32f_viterbi27puppet_branch_outputs, num_bits);
+    memset(decisions + 64 * num_bits, 0, num_points - 64 * num_bits);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbi27puppet_8u_H */
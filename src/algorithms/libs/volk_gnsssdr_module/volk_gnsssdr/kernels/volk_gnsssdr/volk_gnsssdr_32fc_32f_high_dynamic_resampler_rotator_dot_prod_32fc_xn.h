@@ -0,0 +1,289 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: resamples a real local code for N taps, and
+ * multiplies them by a common vector, phase rotated with Doppler rate,
+ * accumulating the results in N float complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that fuses the high dynamics code resampler and the high
+ * dynamic rotator dot product. Code samples are generated on the fly, so no
+ * resampled code vectors are written to memory.
+ * It is optimized to perform the N tap correlation process in GNSS receivers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector at a variable rate per sample, from an
+ * initial \p phase offset, and multiplies it by \p num_a_vectors replicas of a
+ * real local code, each one resampled with a code phase step and rate and
+ * shifted by \p shifts_chips. The products are accumulated and stored in the
+ * output vector. Sample n is rotated by phase * phase_inc^n * phase_inc_rate^(n^2),
+ * and correlated with local_code[floor(code_phase_step_chips * n +
+ * code_phase_rate_step_chips * n^2 + shifts_chips[k] - rem_code_phase_chips) mod code_length_chips].
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:                  Pointer to the vector to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:                  Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase_inc_rate:             Phase increment rate = lv_cmake(cos(phase_step_rate_rad), sin(phase_step_rate_rad))
+ * \li phase:                      Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li local_code:                 Real local code, \p code_length_chips samples.
+ * \li rem_code_phase_chips:       Remnant code phase [chips].
+ * \li code_phase_step_chips:      Phase increment per sample [chips/sample].
+ * \li code_phase_rate_step_chips: Phase rate increment per sample [chips/sample^2].
+ * \li shifts_chips:               Vector of \p num_a_vectors code shifts [chips].
+ * \li code_length_chips:          Code length in chips.
+ * \li num_a_vectors:              Number of correlators.
+ * \li num_points:                 Number of samples to be correlated.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors correlations.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+#include <stdlib.h> /* abs */
+
+// The rotator is regenerated from the closed form phase every
+// ROTATOR_RELOAD samples, so rounding errors do not build up with the
+// quadratic phase
+#define VOLK_GNSSSDR_HD_ROTATOR_RELOAD 256
+
+
+/* Rotation after n samples, exp(j * (arg_inc * n + arg_rate * n^2)) */
+static inline lv_64fc_t volk_gnsssdr_hd_rotator_phase(double arg_inc, double arg_rate, unsigned int n)
+{
+    const double m = (double)n;
+    const double theta = arg_inc * m + arg_rate * m * m;
+    return lv_cmake(cos(theta), sin(theta));
+}
+
+
+/* Rotator increment from sample n to sample n + 1 */
+static inline lv_64fc_t volk_gnsssdr_hd_rotator_inc(double arg_inc, double arg_rate, unsigned int n)
+{
+    const double theta = arg_inc + arg_rate * (2.0 * (double)n + 1.0);
+    return lv_cmake(cos(theta), sin(theta));
+}
+
+
+/* Index of the local code chip at sample n */
+static inline int volk_gnsssdr_hd_code_chip_index(float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float shift_chips, unsigned int code_length_chips, unsigned int n)
+{
+    int local_code_chip_index = (int)floor(code_phase_step_chips * (float)n + code_phase_rate_step_chips * (float)n * (float)n + shift_chips - rem_code_phase_chips);
+    // Take into account that in multitap correlators, the shifts can be negative!
+    if (local_code_chip_index < 0) local_code_chip_index += (int)code_length_chips * (abs(local_code_chip_index) / code_length_chips + 1);
+    return local_code_chip_index % code_length_chips;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    const double arg_inc = atan2((double)lv_cimag(phase_inc), (double)lv_creal(phase_inc));
+    const double arg_rate = atan2((double)lv_cimag(phase_inc_rate), (double)lv_creal(phase_inc_rate));
+    const lv_64fc_t phase_inc_rate2 = lv_cmake(cos(2.0 * arg_rate), sin(2.0 * arg_rate));
+    const lv_64fc_t phase0 = lv_cmake((double)lv_creal(*phase), (double)lv_cimag(*phase));
+    lv_32fc_t tmp32_1;
+    lv_64fc_t _phase = phase0;
+    lv_64fc_t _phase_inc = lv_cmake(1.0, 0.0);
+    int n_vec;
+    unsigned int n;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0.0f, 0.0f);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            if (n % VOLK_GNSSSDR_HD_ROTATOR_RELOAD == 0)
+                {
+                    _phase = phase0 * volk_gnsssdr_hd_rotator_phase(arg_inc, arg_rate, n);
+                    _phase_inc = volk_gnsssdr_hd_rotator_inc(arg_inc, arg_rate, n);
+                }
+            tmp32_1 = in_common[n] * lv_cmake((float)lv_creal(_phase), (float)lv_cimag(_phase));
+            _phase *= _phase_inc;
+            _phase_inc *= phase_inc_rate2;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    result[n_vec] += tmp32_1 * local_code[volk_gnsssdr_hd_code_chip_index(rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, shifts_chips[n_vec], code_length_chips, n)];
+                }
+        }
+    _phase = phase0 * volk_gnsssdr_hd_rotator_phase(arg_inc, arg_rate, num_points);
+    (*phase) = lv_cmake((float)lv_creal(_phase), (float)lv_cimag(_phase));
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+#ifndef WIN32
+    const double arg_inc = atan2((double)lv_cimag(phase_inc), (double)lv_creal(phase_inc));
+    const double arg_rate = atan2((double)lv_cimag(phase_inc_rate), (double)lv_creal(phase_inc_rate));
+    const lv_64fc_t phase_inc_rate2 = lv_cmake(cos(2.0 * arg_rate), sin(2.0 * arg_rate));
+    const lv_64fc_t phase_inc_rate16 = lv_cmake(cos(16.0 * arg_rate), sin(16.0 * arg_rate));
+    const lv_64fc_t phase0 = lv_cmake((double)lv_creal(*phase), (double)lv_cimag(*phase));
+    const __m256 phase_inc_rate128_reg = _mm256_setr_ps((float)cos(128.0 * arg_rate), (float)sin(128.0 * arg_rate),
+        (float)cos(128.0 * arg_rate), (float)sin(128.0 * arg_rate),
+        (float)cos(128.0 * arg_rate), (float)sin(128.0 * arg_rate),
+        (float)cos(128.0 * arg_rate), (float)sin(128.0 * arg_rate));
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 rem_code_phase_chips_reg = _mm256_set1_ps(rem_code_phase_chips);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 code_phase_rate_step_chips_reg = _mm256_set1_ps(code_phase_rate_step_chips);
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256 n0 = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    __m256 shifts_chips_reg[num_a_vectors];
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+    int vec_ind;
+    unsigned int block;
+    unsigned int block_len;
+    unsigned int number;
+    unsigned int n;
+    unsigned int i;
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            shifts_chips_reg[vec_ind] = _mm256_set1_ps(shifts_chips[vec_ind]);
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+        }
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_inc_vec[8];
+    lv_64fc_t _phase, _phase_inc, _phase_inc8;
+    lv_32fc_t tmp32_1;
+    __m256 a0Val, a1Val, z0, z1, dz0, dz1, indexn, code_phase, aux, c, codes, codes_lo, codes_hi;
+    __m256i local_code_chip_index_reg;
+
+    for (block = 0; block < num_points; block += VOLK_GNSSSDR_HD_ROTATOR_RELOAD)
+        {
+            block_len = num_points - block < VOLK_GNSSSDR_HD_ROTATOR_RELOAD ? num_points - block : VOLK_GNSSSDR_HD_ROTATOR_RELOAD;
+
+            // Rotators of 8 consecutive samples, and their increments to the next 8
+            _phase = phase0 * volk_gnsssdr_hd_rotator_phase(arg_inc, arg_rate, block);
+            _phase_inc = volk_gnsssdr_hd_rotator_inc(arg_inc, arg_rate, block);
+            _phase_inc8 = lv_cmake(cos(8.0 * arg_inc + arg_rate * (16.0 * (double)block + 64.0)), sin(8.0 * arg_inc + arg_rate * (16.0 * (double)block + 64.0)));
+            for (i = 0; i < 8; i++)
+                {
+                    phase_vec[i] = lv_cmake((float)lv_creal(_phase), (float)lv_cimag(_phase));
+                    phase_inc_vec[i] = lv_cmake((float)lv_creal(_phase_inc8), (float)lv_cimag(_phase_inc8));
+                    _phase *= _phase_inc;
+                    _phase_inc *= phase_inc_rate2;
+                    _phase_inc8 *= phase_inc_rate16;
+                }
+            z0 = _mm256_load_ps((float*)phase_vec);
+            z1 = _mm256_load_ps((float*)(phase_vec + 4));
+            dz0 = _mm256_load_ps((float*)phase_inc_vec);
+            dz1 = _mm256_load_ps((float*)(phase_inc_vec + 4));
+            indexn = _mm256_add_ps(n0, _mm256_set1_ps((float)block));
+
+            for (number = 0; number + 8 <= block_len; number += 8)
+                {
+                    a0Val = _mm256_loadu_ps((const float*)(in_common + block + number));
+                    a1Val = _mm256_loadu_ps((const float*)(in_common + block + number + 4));
+                    a0Val = _mm256_complexmul_ps(a0Val, z0);
+                    a1Val = _mm256_complexmul_ps(a1Val, z1);
+
+                    z0 = _mm256_complexmul_ps(z0, dz0);
+                    z1 = _mm256_complexmul_ps(z1, dz1);
+                    dz0 = _mm256_complexmul_ps(dz0, phase_inc_rate128_reg);
+                    dz1 = _mm256_complexmul_ps(dz1, phase_inc_rate128_reg);
+
+                    // Code phase of the 8 samples, common to all the taps
+                    code_phase = _mm256_add_ps(_mm256_mul_ps(code_phase_step_chips_reg, indexn),
+                        _mm256_mul_ps(_mm256_mul_ps(code_phase_rate_step_chips_reg, indexn), indexn));
+                    indexn = _mm256_add_ps(indexn, eights);
+
+                    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                        {
+                            aux = _mm256_sub_ps(_mm256_add_ps(code_phase, shifts_chips_reg[vec_ind]), rem_code_phase_chips_reg);
+                            aux = _mm256_floor_ps(aux);
+                            // modulo code length, exact for integer values
+                            c = _mm256_floor_ps(_mm256_div_ps(aux, code_length_chips_reg_f));
+                            aux = _mm256_sub_ps(aux, _mm256_mul_ps(c, code_length_chips_reg_f));
+                            local_code_chip_index_reg = _mm256_cvttps_epi32(aux);
+                            codes = _mm256_i32gather_ps(local_code, local_code_chip_index_reg, 4);  // c0|c1|c2|c3|c4|c5|c6|c7
+
+                            codes_lo = _mm256_unpacklo_ps(codes, codes);  // c0|c0|c1|c1|c4|c4|c5|c5
+                            codes_hi = _mm256_unpackhi_ps(codes, codes);  // c2|c2|c3|c3|c6|c6|c7|c7
+                            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], _mm256_mul_ps(a0Val, _mm256_permute2f128_ps(codes_lo, codes_hi, 0x20)));
+                            dotProdVal1[vec_ind] = _mm256_add_ps(dotProdVal1[vec_ind], _mm256_mul_ps(a1Val, _mm256_permute2f128_ps(codes_lo, codes_hi, 0x31)));
+                        }
+                }
+
+            // Last samples of the last block
+            if (number < block_len)
+                {
+                    n = block + number;
+                    _phase = phase0 * volk_gnsssdr_hd_rotator_phase(arg_inc, arg_rate, n);
+                    _phase_inc = volk_gnsssdr_hd_rotator_inc(arg_inc, arg_rate, n);
+                    for (; n < block + block_len; n++)
+                        {
+                            tmp32_1 = in_common[n] * lv_cmake((float)lv_creal(_phase), (float)lv_cimag(_phase));
+                            _phase *= _phase_inc;
+                            _phase_inc *= phase_inc_rate2;
+                            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                                {
+                                    result[vec_ind] += tmp32_1 * local_code[volk_gnsssdr_hd_code_chip_index(rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, shifts_chips[vec_ind], code_length_chips, n)];
+                                }
+                        }
+                }
+        }
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm256_store_ps((float*)dotProductVector, _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]));
+            for (i = 0; i < 4; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+    _phase = phase0 * volk_gnsssdr_hd_rotator_phase(arg_inc, arg_rate, num_points);
+    (*phase) = lv_cmake((float)lv_creal(_phase), (float)lv_cimag(_phase));
+#else
+    volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_generic(result, in_common, phase_inc, phase_inc_rate, phase, local_code, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, shifts_chips, code_length_chips, num_a_vectors, num_points);
+#endif
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn_H */
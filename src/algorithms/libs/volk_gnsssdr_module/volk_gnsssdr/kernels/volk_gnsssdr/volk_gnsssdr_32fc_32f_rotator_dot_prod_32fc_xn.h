@@ -483,4 +483,510 @@ static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx(lv_32fc_
 
 #endif /* LV_HAVE_AVX */
 
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+#ifndef WIN32
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, xVal;
+    __m512 dotProdVal0[num_a_vectors];
+    __m512 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm512_setzero_ps();
+            dotProdVal1[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Indexes that duplicate each real value, for the real and imaginary parts of the samples
+    const __m512i lo_idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi_idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+
+    // Set up the complex rotator
+    __m512 z0, z1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    for (vec_ind = 0; vec_ind < 16; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm512_loadu_ps(aPtr);
+            a1Val = _mm512_loadu_ps(aPtr + 16);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_loadu_ps(bPtr[vec_ind]);  // t0|t1|t2|...|t15
+                    dotProdVal0[vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_permutexvar_ps(lo_idx, xVal), dotProdVal0[vec_ind]);  // t0|t0|t1|t1|...|t7|t7
+                    dotProdVal1[vec_ind] = _mm512_fmadd_ps(a1Val, _mm512_permutexvar_ps(hi_idx, xVal), dotProdVal1[vec_ind]);  // t8|t8|t9|t9|...|t15|t15
+                    bPtr[vec_ind] += 16;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+
+            _mm512_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+#else
+    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_generic_reload(result, in_common, phase_inc, phase, in_a, num_a_vectors, num_points);
+#endif
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+#ifndef WIN32
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (float*)in_common;
+    const float* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, xVal;
+    __m512 dotProdVal0[num_a_vectors];
+    __m512 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm512_setzero_ps();
+            dotProdVal1[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Indexes that duplicate each real value, for the real and imaginary parts of the samples
+    const __m512i lo_idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi_idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+
+    // Set up the complex rotator
+    __m512 z0, z1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    for (vec_ind = 0; vec_ind < 16; ++vec_ind)
+        {
+            phase_vec[vec_ind] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (vec_ind = 0; vec_ind < 8; ++vec_ind)
+        {
+            phase_vec[vec_ind] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm512_load_ps(aPtr);
+            a1Val = _mm512_load_ps(aPtr + 16);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_load_ps(bPtr[vec_ind]);  // t0|t1|t2|...|t15
+                    dotProdVal0[vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_permutexvar_ps(lo_idx, xVal), dotProdVal0[vec_ind]);  // t0|t0|t1|t1|...|t7|t7
+                    dotProdVal1[vec_ind] = _mm512_fmadd_ps(a1Val, _mm512_permutexvar_ps(hi_idx, xVal), dotProdVal1[vec_ind]);  // t8|t8|t9|t9|...|t15|t15
+                    bPtr[vec_ind] += 16;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            dotProdVal0[vec_ind] = _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]);
+
+            _mm512_store_ps((float*)dotProductVector, dotProdVal0[vec_ind]);  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+#else
+    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_generic_reload(result, in_common, phase_inc, phase, in_a, num_a_vectors, num_points);
+#endif
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_neon(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int neon_iters = num_points / 4;
+
+    const float32_t* aPtr = (float32_t*)in_common;
+    const float32_t* bPtr[num_a_vectors];
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            bPtr[vec_ind] = in_a[vec_ind];
+        }
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    float32x4x2_t a_val;
+    float32x4_t x_val, r_re, r_im, tmp_re, tmp_im, mag, inv_mag;
+    float32x4_t acc_re[num_a_vectors];
+    float32x4_t acc_im[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            acc_re[vec_ind] = vdupq_n_f32(0.0f);
+            acc_im[vec_ind] = vdupq_n_f32(0.0f);
+        }
+
+    // Set up the complex rotator, with the real and imaginary parts in separate registers
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_im[4];
+    for (i = 0; i < 4; ++i)
+        {
+            phase_re[i] = lv_creal(_phase);
+            phase_im[i] = lv_cimag(_phase);
+            _phase *= phase_inc;
+        }
+    float32x4_t z_re = vld1q_f32(phase_re);
+    float32x4_t z_im = vld1q_f32(phase_im);
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^4;
+    const float32x4_t dz_re = vdupq_n_f32(lv_creal(dz));
+    const float32x4_t dz_im = vdupq_n_f32(lv_cimag(dz));
+
+    for (; number < neon_iters; number++)
+        {
+            a_val = vld2q_f32(aPtr);  // a_val.val[0] = real parts, a_val.val[1] = imaginary parts
+            __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+            r_re = vmlsq_f32(vmulq_f32(a_val.val[0], z_re), a_val.val[1], z_im);
+            r_im = vmlaq_f32(vmulq_f32(a_val.val[0], z_im), a_val.val[1], z_re);
+
+            tmp_re = vmlsq_f32(vmulq_f32(z_re, dz_re), z_im, dz_im);
+            tmp_im = vmlaq_f32(vmulq_f32(z_re, dz_im), z_im, dz_re);
+            z_re = tmp_re;
+            z_im = tmp_im;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    x_val = vld1q_f32(bPtr[vec_ind]);
+                    acc_re[vec_ind] = vmlaq_f32(acc_re[vec_ind], r_re, x_val);
+                    acc_im[vec_ind] = vmlaq_f32(acc_im[vec_ind], r_im, x_val);
+                    bPtr[vec_ind] += 4;
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    mag = vmlaq_f32(vmulq_f32(z_re, z_re), z_im, z_im);
+                    inv_mag = vrsqrteq_f32(mag);
+                    inv_mag = vmulq_f32(vrsqrtsq_f32(vmulq_f32(mag, inv_mag), inv_mag), inv_mag);
+                    inv_mag = vmulq_f32(vrsqrtsq_f32(vmulq_f32(mag, inv_mag), inv_mag), inv_mag);
+                    z_re = vmulq_f32(z_re, inv_mag);
+                    z_im = vmulq_f32(z_im, inv_mag);
+                }
+
+            aPtr += 8;
+        }
+
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t acc_re_vector[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t acc_im_vector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            vst1q_f32(acc_re_vector, acc_re[vec_ind]);
+            vst1q_f32(acc_im_vector, acc_im[vec_ind]);
+            result[vec_ind] = lv_cmake(acc_re_vector[0] + acc_re_vector[1] + acc_re_vector[2] + acc_re_vector[3],
+                acc_im_vector[0] + acc_im_vector[1] + acc_im_vector[2] + acc_im_vector[3]);
+        }
+
+    vst1q_f32(phase_re, z_re);
+    vst1q_f32(phase_im, z_im);
+    _phase = lv_cmake(phase_re[0], phase_im[0]);
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    number = neon_iters * 4;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_NEON */
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_sve(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    // SVE registers are sizeless, so there cannot be one accumulator per
+    // vector. Instead, blocks of samples are rotated into a buffer that stays
+    // in L1, and then correlated with each vector.
+    const unsigned int ROTATOR_RELOAD = 256;
+    const unsigned int sve_step = (unsigned int)svcntw();
+    const svbool_t all = svptrue_b32();
+    unsigned int number;
+    unsigned int block;
+    unsigned int block_len;
+    unsigned int i;
+    int vec_ind;
+
+    __VOLK_ATTR_ALIGNED(16)
+    float rotated_re[256];
+    __VOLK_ATTR_ALIGNED(16)
+    float rotated_im[256];
+    // One phase per lane, for vectors of up to 2048 bits
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_re[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_im[64];
+
+    svbool_t pg;
+    svfloat32x2_t a_val;
+    svfloat32_t z_re, z_im, tmp_re, tmp_im, r_re, r_im, x_val, acc_re, acc_im;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t lane_phase;
+    lv_32fc_t dz = lv_cmake(1.0f, 0.0f);
+    lv_32fc_t block_inc = phase_inc;
+    for (i = 0; i < sve_step; ++i)
+        {
+            dz *= phase_inc;  // dz = phase_inc^sve_step;
+        }
+    for (i = 0; i < 8; ++i)
+        {
+            block_inc *= block_inc;  // block_inc = phase_inc^ROTATOR_RELOAD;
+        }
+    const svfloat32_t dz_re = svdup_n_f32(lv_creal(dz));
+    const svfloat32_t dz_im = svdup_n_f32(lv_cimag(dz));
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+        }
+
+    for (block = 0; block < num_points; block += ROTATOR_RELOAD)
+        {
+            block_len = num_points - block < ROTATOR_RELOAD ? num_points - block : ROTATOR_RELOAD;
+
+            lane_phase = _phase;
+            for (i = 0; i < sve_step; ++i)
+                {
+                    phase_re[i] = lv_creal(lane_phase);
+                    phase_im[i] = lv_cimag(lane_phase);
+                    lane_phase *= phase_inc;
+                }
+            z_re = svld1_f32(all, phase_re);
+            z_im = svld1_f32(all, phase_im);
+
+            for (number = 0; number < block_len; number += sve_step)
+                {
+                    pg = svwhilelt_b32_u32(number, block_len);
+                    a_val = svld2_f32(pg, (const float*)(in_common + block + number));
+
+                    r_re = svmls_f32_x(pg, svmul_f32_x(pg, svget2_f32(a_val, 0), z_re), svget2_f32(a_val, 1), z_im);
+                    r_im = svmla_f32_x(pg, svmul_f32_x(pg, svget2_f32(a_val, 0), z_im), svget2_f32(a_val, 1), z_re);
+                    svst1_f32(pg, rotated_re + number, r_re);
+                    svst1_f32(pg, rotated_im + number, r_im);
+
+                    tmp_re = svmls_f32_x(all, svmul_f32_x(all, z_re, dz_re), z_im, dz_im);
+                    tmp_im = svmla_f32_x(all, svmul_f32_x(all, z_re, dz_im), z_im, dz_re);
+                    z_re = tmp_re;
+                    z_im = tmp_im;
+                }
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    acc_re = svdup_n_f32(0.0f);
+                    acc_im = svdup_n_f32(0.0f);
+                    for (number = 0; number < block_len; number += sve_step)
+                        {
+                            pg = svwhilelt_b32_u32(number, block_len);
+                            x_val = svld1_f32(pg, in_a[vec_ind] + block + number);
+                            acc_re = svmla_f32_m(pg, acc_re, svld1_f32(pg, rotated_re + number), x_val);
+                            acc_im = svmla_f32_m(pg, acc_im, svld1_f32(pg, rotated_im + number), x_val);
+                        }
+                    result[vec_ind] += lv_cmake(svaddv_f32(all, acc_re), svaddv_f32(all, acc_im));
+                }
+
+            // Phase at the start of the next block, regenerated onto the unit circle
+            if (block_len == ROTATOR_RELOAD)
+                {
+                    _phase *= block_inc;
+                }
+            else
+                {
+                    for (i = 0; i < block_len; ++i)
+                        {
+                            _phase *= phase_inc;
+                        }
+                }
+#ifdef __cplusplus
+            _phase /= std::abs(_phase);
+#else
+            _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_SVE */
+
 #endif /* INCLUDED_volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_H */
@@ -0,0 +1,341 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N real vectors by a common complex
+ * (32-bit float per component) vector, phase rotated by a phase tracked in
+ * double precision, and accumulates the results in N float complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that performs the carrier wipe-off and the N tap
+ * correlation of volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, but keeps the
+ * carrier phase in double precision and reseeds the single precision rotator
+ * from it every block, so that long coherent integrations do not drift.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector by exp(j * (phase_rad + n * phase_inc_rad)),
+ * multiplies it with an arbitrary number of real vectors, accumulates the
+ * results and stores them in the output vector.
+ *
+ * The samples are processed in blocks of 256. At the start of each block the
+ * rotator is computed from the double precision phase, and inside the block it
+ * is propagated by single precision complex multiplications, so the phase error
+ * does not grow with the number of samples.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_32fc_t* in_common, const double phase_inc_rad, double* phase_rad, const float** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc_rad: Phase increment per sample, in radians.
+ * \li phase_rad:     Initial phase, in radians.
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase_rad:     Final phase, in radians, wrapped to [-pi, pi].
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a rotated, multiplied by \p in_common and accumulated.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_32fc_t* in_common, const double phase_inc_rad, double* phase_rad, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const lv_32fc_t phase_inc = lv_cmake((float)cos(phase_inc_rad), (float)sin(phase_inc_rad));
+    lv_32fc_t phase, tmp32;
+    double block_phase;
+    int n_vec;
+    unsigned int n = 0;
+    unsigned int j;
+    unsigned int block_end;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0.0f, 0.0f);
+        }
+
+    while (n < num_points)
+        {
+            // Reseed the rotator from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            phase = lv_cmake((float)cos(block_phase), (float)sin(block_phase));
+            block_end = num_points - n < ROTATOR_RELOAD ? num_points : n + ROTATOR_RELOAD;
+            for (j = n; j < block_end; j++)
+                {
+                    tmp32 = in_common[j] * phase;
+                    phase *= phase_inc;
+                    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                        {
+                            result[n_vec] += tmp32 * in_a[n_vec][j];
+                        }
+                }
+            n = block_end;
+        }
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_u_avx(lv_32fc_t* result, const lv_32fc_t* in_common, const double phase_inc_rad, double* phase_rad, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const float* aPtr = (const float*)in_common;
+    double lane_re[8];
+    double lane_im[8];
+    double block_phase, base_re, base_im;
+    int vec_ind;
+    unsigned int n = 0;
+    unsigned int number, block_iters, k;
+    lv_32fc_t phase_inc, phase, wo;
+
+    __m256 a0Val, a1Val, xVal, xloVal, xhiVal, z0, z1, dz_reg;
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+
+    __VOLK_ATTR_ALIGNED(32)
+    float phase_vec[16];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Phase offsets of the eight lanes, and rotation after each iteration
+    for (k = 0; k < 8; k++)
+        {
+            lane_re[k] = cos(phase_inc_rad * (double)k);
+            lane_im[k] = sin(phase_inc_rad * (double)k);
+        }
+    for (k = 0; k < 4; k++)
+        {
+            phase_vec[2 * k] = (float)cos(phase_inc_rad * 8.0);
+            phase_vec[2 * k + 1] = (float)sin(phase_inc_rad * 8.0);
+        }
+    dz_reg = _mm256_load_ps(phase_vec);
+
+    while (num_points - n >= 8)
+        {
+            block_iters = (num_points - n) / 8;
+            if (block_iters > ROTATOR_RELOAD / 8)
+                {
+                    block_iters = ROTATOR_RELOAD / 8;
+                }
+
+            // Reseed the rotators from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            base_re = cos(block_phase);
+            base_im = sin(block_phase);
+            for (k = 0; k < 8; k++)
+                {
+                    phase_vec[2 * k] = (float)(base_re * lane_re[k] - base_im * lane_im[k]);
+                    phase_vec[2 * k + 1] = (float)(base_re * lane_im[k] + base_im * lane_re[k]);
+                }
+            z0 = _mm256_load_ps(phase_vec);
+            z1 = _mm256_load_ps(phase_vec + 8);
+
+            for (number = 0; number < block_iters; number++)
+                {
+                    a0Val = _mm256_complexmul_ps(_mm256_loadu_ps(aPtr), z0);
+                    a1Val = _mm256_complexmul_ps(_mm256_loadu_ps(aPtr + 8), z1);
+
+                    z0 = _mm256_complexmul_ps(z0, dz_reg);
+                    z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+                    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                        {
+                            xVal = _mm256_loadu_ps(in_a[vec_ind] + n + 8 * number);  // t0|t1|t2|t3|t4|t5|t6|t7
+                            xloVal = _mm256_unpacklo_ps(xVal, xVal);                 // t0|t0|t1|t1|t4|t4|t5|t5
+                            xhiVal = _mm256_unpackhi_ps(xVal, xVal);                 // t2|t2|t3|t3|t6|t6|t7|t7
+
+                            dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], _mm256_mul_ps(a0Val, _mm256_permute2f128_ps(xloVal, xhiVal, 0x20)));
+                            dotProdVal1[vec_ind] = _mm256_add_ps(dotProdVal1[vec_ind], _mm256_mul_ps(a1Val, _mm256_permute2f128_ps(xloVal, xhiVal, 0x31)));
+                        }
+
+                    aPtr += 16;
+                }
+            n += block_iters * 8;
+        }
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm256_store_ps((float*)dotProductVector, _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]));
+            result[vec_ind] = dotProductVector[0] + dotProductVector[1] + dotProductVector[2] + dotProductVector[3];
+        }
+
+    block_phase = phase0 + phase_inc_rad * (double)n;
+    phase = lv_cmake((float)cos(block_phase), (float)sin(block_phase));
+    phase_inc = lv_cmake((float)cos(phase_inc_rad), (float)sin(phase_inc_rad));
+    for (; n < num_points; n++)
+        {
+            wo = in_common[n] * phase;
+            phase *= phase_inc;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][n];
+                }
+        }
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_neon(lv_32fc_t* result, const lv_32fc_t* in_common, const double phase_inc_rad, double* phase_rad, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const float32_t* aPtr = (const float32_t*)in_common;
+    double lane_re[4];
+    double lane_im[4];
+    double block_phase, base_re, base_im;
+    int vec_ind;
+    unsigned int n = 0;
+    unsigned int number, block_iters, k;
+    lv_32fc_t phase_inc, phase, wo;
+
+    float32x4x2_t a_val;
+    float32x4_t x_val, r_re, r_im, z_re, z_im, tmp_re, tmp_im;
+    float32x4_t acc_re[num_a_vectors];
+    float32x4_t acc_im[num_a_vectors];
+
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_im[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            acc_re[vec_ind] = vdupq_n_f32(0.0f);
+            acc_im[vec_ind] = vdupq_n_f32(0.0f);
+        }
+
+    for (k = 0; k < 4; k++)
+        {
+            lane_re[k] = cos(phase_inc_rad * (double)k);
+            lane_im[k] = sin(phase_inc_rad * (double)k);
+        }
+    const float32x4_t dz_re = vdupq_n_f32((float)cos(phase_inc_rad * 4.0));
+    const float32x4_t dz_im = vdupq_n_f32((float)sin(phase_inc_rad * 4.0));
+
+    while (num_points - n >= 4)
+        {
+            block_iters = (num_points - n) / 4;
+            if (block_iters > ROTATOR_RELOAD / 4)
+                {
+                    block_iters = ROTATOR_RELOAD / 4;
+                }
+
+            // Reseed the rotators from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            base_re = cos(block_phase);
+            base_im = sin(block_phase);
+            for (k = 0; k < 4; k++)
+                {
+                    phase_re[k] = (float32_t)(base_re * lane_re[k] - base_im * lane_im[k]);
+                    phase_im[k] = (float32_t)(base_re * lane_im[k] + base_im * lane_re[k]);
+                }
+            z_re = vld1q_f32(phase_re);
+            z_im = vld1q_f32(phase_im);
+
+            for (number = 0; number < block_iters; number++)
+                {
+                    a_val = vld2q_f32(aPtr);  // a_val.val[0] = real parts, a_val.val[1] = imaginary parts
+                    __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+                    r_re = vmlsq_f32(vmulq_f32(a_val.val[0], z_re), a_val.val[1], z_im);
+                    r_im = vmlaq_f32(vmulq_f32(a_val.val[0], z_im), a_val.val[1], z_re);
+
+                    tmp_re = vmlsq_f32(vmulq_f32(z_re, dz_re), z_im, dz_im);
+                    tmp_im = vmlaq_f32(vmulq_f32(z_re, dz_im), z_im, dz_re);
+                    z_re = tmp_re;
+                    z_im = tmp_im;
+
+                    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                        {
+                            x_val = vld1q_f32(in_a[vec_ind] + n + 4 * number);
+                            acc_re[vec_ind] = vmlaq_f32(acc_re[vec_ind], r_re, x_val);
+                            acc_im[vec_ind] = vmlaq_f32(acc_im[vec_ind], r_im, x_val);
+                        }
+
+                    aPtr += 8;
+                }
+            n += block_iters * 4;
+        }
+
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t acc_re_vector[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t acc_im_vector[4];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            vst1q_f32(acc_re_vector, acc_re[vec_ind]);
+            vst1q_f32(acc_im_vector, acc_im[vec_ind]);
+            result[vec_ind] = lv_cmake(acc_re_vector[0] + acc_re_vector[1] + acc_re_vector[2] + acc_re_vector[3],
+                acc_im_vector[0] + acc_im_vector[1] + acc_im_vector[2] + acc_im_vector[3]);
+        }
+
+    block_phase = phase0 + phase_inc_rad * (double)n;
+    phase = lv_cmake((float)cos(block_phase), (float)sin(block_phase));
+    phase_inc = lv_cmake((float)cos(phase_inc_rad), (float)sin(phase_inc_rad));
+    for (; n < num_points; n++)
+        {
+            wo = in_common[n] * phase;
+            phase *= phase_inc;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][n];
+                }
+        }
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn_H */
@@ -0,0 +1,58 @@
+/*!
+ * \file volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc.h
+ * \brief VOLK_GNSSSDR puppet for the double precision phase rotator kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating volk_gnsssdr_32fc_s64f_x2_rotator_32fc into the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_H
+
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_s64f_x2_rotator_32fc.h"
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_generic(lv_32fc_t* outVector, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    double phase_rad = 0.345;
+    const double phase_step_rad = 0.123;
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc_generic(outVector, inVector, phase_step_rad, &phase_rad, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_u_avx(lv_32fc_t* outVector, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    double phase_rad = 0.345;
+    const double phase_step_rad = 0.123;
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc_u_avx(outVector, inVector, phase_step_rad, &phase_rad, num_points);
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_neon(lv_32fc_t* outVector, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    double phase_rad = 0.345;
+    const double phase_step_rad = 0.123;
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc_neon(outVector, inVector, phase_step_rad, &phase_rad, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc_H */
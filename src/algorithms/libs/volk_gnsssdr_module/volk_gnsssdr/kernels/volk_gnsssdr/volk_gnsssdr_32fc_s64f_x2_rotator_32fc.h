@@ -0,0 +1,257 @@
+/*!
+ * \file volk_gnsssdr_32fc_s64f_x2_rotator_32fc.h
+ * \brief VOLK_GNSSSDR kernel: rotates a complex (32-bit float per component)
+ * vector by a phase tracked in double precision.
+ *
+ * VOLK_GNSSSDR kernel that multiplies a 32 bits float complex vector by a
+ * complex exponential whose phase grows at a fixed rate per sample. The phase
+ * is kept in double precision and the single precision rotator is reseeded
+ * from it every block, so the result does not drift with the number of
+ * processed samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_s64f_x2_rotator_32fc
+ *
+ * \b Overview
+ *
+ * Computes outVector[n] = inVector[n] * exp(j * (phase_rad + n * phase_inc_rad)),
+ * and advances \p phase_rad by num_points * phase_inc_rad.
+ *
+ * The samples are processed in blocks of 256. At the start of each block the
+ * rotator is computed from the double precision phase, and inside the block it
+ * is propagated by single precision complex multiplications. The rounding error
+ * of the recursion is therefore bounded by the block length, instead of growing
+ * with the integration time as in volk_gnsssdr_16ic_s32fc_x2_rotator_16ic and
+ * the other rotators that carry the phase as a float complex exponential.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_s64f_x2_rotator_32fc(lv_32fc_t* outVector, const lv_32fc_t* inVector, const double phase_inc_rad, double* phase_rad, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:      Vector to be rotated.
+ * \li phase_inc_rad: Phase increment per sample, in radians.
+ * \li phase_rad:     Initial phase, in radians.
+ * \li num_points:    Number of complex values to be rotated.
+ *
+ * \b Outputs
+ * \li outVector:     Rotated vector.
+ * \li phase_rad:     Final phase, in radians, wrapped to [-pi, pi].
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_s64f_x2_rotator_32fc_H
+#define INCLUDED_volk_gnsssdr_32fc_s64f_x2_rotator_32fc_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_s64f_x2_rotator_32fc_generic(lv_32fc_t* outVector, const lv_32fc_t* inVector, const double phase_inc_rad, double* phase_rad, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const lv_32fc_t phase_inc = lv_cmake((float)cos(phase_inc_rad), (float)sin(phase_inc_rad));
+    lv_32fc_t phase;
+    double block_phase;
+    unsigned int n = 0;
+    unsigned int j;
+    unsigned int block_len;
+
+    while (n < num_points)
+        {
+            // Reseed the rotator from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            phase = lv_cmake((float)cos(block_phase), (float)sin(block_phase));
+            block_len = num_points - n < ROTATOR_RELOAD ? num_points - n : ROTATOR_RELOAD;
+            for (j = 0; j < block_len; j++)
+                {
+                    *outVector++ = *inVector++ * phase;
+                    phase *= phase_inc;
+                }
+            n += block_len;
+        }
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_s64f_x2_rotator_32fc_u_avx(lv_32fc_t* outVector, const lv_32fc_t* inVector, const double phase_inc_rad, double* phase_rad, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const float* aPtr = (const float*)inVector;
+    float* cPtr = (float*)outVector;
+    double lane_re[8];
+    double lane_im[8];
+    double block_phase, base_re, base_im;
+    unsigned int n = 0;
+    unsigned int number, block_iters, k;
+    __m256 a0Val, a1Val, z0, z1, dz_reg;
+
+    __VOLK_ATTR_ALIGNED(32)
+    float phase_vec[16];
+
+    // Phase offsets of the eight lanes, and rotation after each iteration
+    for (k = 0; k < 8; k++)
+        {
+            lane_re[k] = cos(phase_inc_rad * (double)k);
+            lane_im[k] = sin(phase_inc_rad * (double)k);
+        }
+    for (k = 0; k < 4; k++)
+        {
+            phase_vec[2 * k] = (float)cos(phase_inc_rad * 8.0);
+            phase_vec[2 * k + 1] = (float)sin(phase_inc_rad * 8.0);
+        }
+    dz_reg = _mm256_load_ps(phase_vec);
+
+    while (num_points - n >= 8)
+        {
+            block_iters = (num_points - n) / 8;
+            if (block_iters > ROTATOR_RELOAD / 8)
+                {
+                    block_iters = ROTATOR_RELOAD / 8;
+                }
+
+            // Reseed the rotators from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            base_re = cos(block_phase);
+            base_im = sin(block_phase);
+            for (k = 0; k < 8; k++)
+                {
+                    phase_vec[2 * k] = (float)(base_re * lane_re[k] - base_im * lane_im[k]);
+                    phase_vec[2 * k + 1] = (float)(base_re * lane_im[k] + base_im * lane_re[k]);
+                }
+            z0 = _mm256_load_ps(phase_vec);
+            z1 = _mm256_load_ps(phase_vec + 8);
+
+            for (number = 0; number < block_iters; number++)
+                {
+                    a0Val = _mm256_loadu_ps(aPtr);
+                    a1Val = _mm256_loadu_ps(aPtr + 8);
+
+                    _mm256_storeu_ps(cPtr, _mm256_complexmul_ps(a0Val, z0));
+                    _mm256_storeu_ps(cPtr + 8, _mm256_complexmul_ps(a1Val, z1));
+
+                    z0 = _mm256_complexmul_ps(z0, dz_reg);
+                    z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+                    aPtr += 16;
+                    cPtr += 16;
+                }
+            n += block_iters * 8;
+        }
+
+    block_phase = phase0 + phase_inc_rad * (double)n;
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc_generic(outVector + n, inVector + n, phase_inc_rad, &block_phase, num_points - n);
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_s64f_x2_rotator_32fc_neon(lv_32fc_t* outVector, const lv_32fc_t* inVector, const double phase_inc_rad, double* phase_rad, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    const double TWO_PI = 6.283185307179586;
+    const double phase0 = *phase_rad;
+    const float32_t* aPtr = (const float32_t*)inVector;
+    float32_t* cPtr = (float32_t*)outVector;
+    double lane_re[4];
+    double lane_im[4];
+    double block_phase, base_re, base_im;
+    unsigned int n = 0;
+    unsigned int number, block_iters, k;
+    float32x4x2_t a_val, c_val;
+    float32x4_t z_re, z_im, tmp_re, tmp_im;
+
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float32_t phase_im[4];
+
+    for (k = 0; k < 4; k++)
+        {
+            lane_re[k] = cos(phase_inc_rad * (double)k);
+            lane_im[k] = sin(phase_inc_rad * (double)k);
+        }
+    const float32x4_t dz_re = vdupq_n_f32((float)cos(phase_inc_rad * 4.0));
+    const float32x4_t dz_im = vdupq_n_f32((float)sin(phase_inc_rad * 4.0));
+
+    while (num_points - n >= 4)
+        {
+            block_iters = (num_points - n) / 4;
+            if (block_iters > ROTATOR_RELOAD / 4)
+                {
+                    block_iters = ROTATOR_RELOAD / 4;
+                }
+
+            // Reseed the rotators from the double precision phase
+            block_phase = phase0 + phase_inc_rad * (double)n;
+            base_re = cos(block_phase);
+            base_im = sin(block_phase);
+            for (k = 0; k < 4; k++)
+                {
+                    phase_re[k] = (float32_t)(base_re * lane_re[k] - base_im * lane_im[k]);
+                    phase_im[k] = (float32_t)(base_re * lane_im[k] + base_im * lane_re[k]);
+                }
+            z_re = vld1q_f32(phase_re);
+            z_im = vld1q_f32(phase_im);
+
+            for (number = 0; number < block_iters; number++)
+                {
+                    a_val = vld2q_f32(aPtr);  // a_val.val[0] = real parts, a_val.val[1] = imaginary parts
+                    __VOLK_GNSSSDR_PREFETCH(aPtr + 8);
+
+                    c_val.val[0] = vmlsq_f32(vmulq_f32(a_val.val[0], z_re), a_val.val[1], z_im);
+                    c_val.val[1] = vmlaq_f32(vmulq_f32(a_val.val[0], z_im), a_val.val[1], z_re);
+                    vst2q_f32(cPtr, c_val);
+
+                    tmp_re = vmlsq_f32(vmulq_f32(z_re, dz_re), z_im, dz_im);
+                    tmp_im = vmlaq_f32(vmulq_f32(z_re, dz_im), z_im, dz_re);
+                    z_re = tmp_re;
+                    z_im = tmp_im;
+
+                    aPtr += 8;
+                    cPtr += 8;
+                }
+            n += block_iters * 4;
+        }
+
+    block_phase = phase0 + phase_inc_rad * (double)n;
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc_generic(outVector + n, inVector + n, phase_inc_rad, &block_phase, num_points - n);
+
+    *phase_rad = remainder(phase0 + phase_inc_rad * (double)num_points, TWO_PI);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_s64f_x2_rotator_32fc_H */
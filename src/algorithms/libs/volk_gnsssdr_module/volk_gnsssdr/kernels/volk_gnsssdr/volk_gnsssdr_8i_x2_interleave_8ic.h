@@ -0,0 +1,158 @@
+/*!
+ * \file volk_gnsssdr_8i_x2_interleave_8ic.h
+ * \brief VOLK_GNSSSDR kernel: interleaves two 8 bit integer vectors into an 8 bit integer complex vector.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8i_x2_interleave_8ic
+ *
+ * \b Overview
+ *
+ * Builds a complex vector of 8-bits integer each component from a vector of
+ * real parts and a vector of imaginary parts.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8i_x2_interleave_8ic(lv_8sc_t* cVector, const int8_t* aVector, const int8_t* bVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aVector: Real parts.
+ * \li bVector: Imaginary parts.
+ * \li num_points: Number of complex values to be stored into \p cVector.
+ *
+ * \b Outputs
+ * \li cVector: The vector where the result will be stored.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+#define INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_generic(lv_8sc_t* cVector, const int8_t* aVector, const int8_t* bVector, unsigned int num_points)
+{
+    int8_t* cPtr = (int8_t*)cVector;
+    unsigned int number;
+
+    for (number = 0; number < num_points; number++)
+        {
+            *cPtr++ = aVector[number];
+            *cPtr++ = bVector[number];
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_sse2(lv_8sc_t* cVector, const int8_t* aVector, const int8_t* bVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    int8_t* cPtr = (int8_t*)cVector;
+    const int8_t* aPtr = aVector;
+    const int8_t* bPtr = bVector;
+    unsigned int number;
+    __m128i aVal, bVal;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            aVal = _mm_loadu_si128((const __m128i*)aPtr);
+            bVal = _mm_loadu_si128((const __m128i*)bPtr);
+            _mm_storeu_si128((__m128i*)cPtr, _mm_unpacklo_epi8(aVal, bVal));
+            _mm_storeu_si128((__m128i*)(cPtr + 16), _mm_unpackhi_epi8(aVal, bVal));
+            aPtr += 16;
+            bPtr += 16;
+            cPtr += 32;
+        }
+
+    for (number = sse_iters * 16; number < num_points; number++)
+        {
+            *cPtr++ = *aPtr++;
+            *cPtr++ = *bPtr++;
+        }
+}
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_avx2(lv_8sc_t* cVector, const int8_t* aVector, const int8_t* bVector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 32;
+    int8_t* cPtr = (int8_t*)cVector;
+    const int8_t* aPtr = aVector;
+    const int8_t* bPtr = bVector;
+    unsigned int number;
+    __m256i aVal, bVal, lo, hi;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            aVal = _mm256_loadu_si256((const __m256i*)aPtr);
+            bVal = _mm256_loadu_si256((const __m256i*)bPtr);
+            // in-lane unpacks: lo holds samples 0-7 and 16-23, hi 8-15 and 24-31
+            lo = _mm256_unpacklo_epi8(aVal, bVal);
+            hi = _mm256_unpackhi_epi8(aVal, bVal);
+            _mm256_storeu_si256((__m256i*)cPtr, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(cPtr + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+            aPtr += 32;
+            bPtr += 32;
+            cPtr += 64;
+        }
+
+    for (number = avx_iters * 32; number < num_points; number++)
+        {
+            *cPtr++ = *aPtr++;
+            *cPtr++ = *bPtr++;
+        }
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_neon(lv_8sc_t* cVector, const int8_t* aVector, const int8_t* bVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 16;
+    int8_t* cPtr = (int8_t*)cVector;
+    const int8_t* aPtr = aVector;
+    const int8_t* bPtr = bVector;
+    unsigned int number;
+    int8x16x2_t cVal;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            cVal.val[0] = vld1q_s8(aPtr);
+            cVal.val[1] = vld1q_s8(bPtr);
+            vst2q_s8(cPtr, cVal);
+            aPtr += 16;
+            bPtr += 16;
+            cPtr += 32;
+        }
+
+    for (number = neon_iters * 16; number < num_points; number++)
+        {
+            *cPtr++ = *aPtr++;
+            *cPtr++ = *bPtr++;
+        }
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H */
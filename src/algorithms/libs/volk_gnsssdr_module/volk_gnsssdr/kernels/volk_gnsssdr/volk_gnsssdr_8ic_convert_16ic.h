@@ -0,0 +1,140 @@
+/*!
+ * \file volk_gnsssdr_8ic_convert_16ic.h
+ * \brief VOLK_GNSSSDR kernel: converts 8 bit integer complex values to 16 bit integer complex values.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_convert_16ic
+ *
+ * \b Overview
+ *
+ * Converts a complex vector of 8-bits integer each component
+ * into a complex vector of 16-bits integer each component.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_convert_16ic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inputVector:  The complex 8-bit integer input data buffer.
+ * \li num_points:   The number of data values to be converted.
+ *
+ * \b Outputs
+ * \li outputVector: pointer to a vector holding the converted vector.
+ *
+ */
+
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+#define INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_convert_16ic_generic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const int8_t* _in = (const int8_t*)inputVector;
+    int16_t* _out = (int16_t*)outputVector;
+    unsigned int i;
+    for (i = 0; i < 2 * num_points; i++)
+        {
+            _out[i] = (int16_t)_in[i];
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_sse2(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 8;
+    const int8_t* _in = (const int8_t*)inputVector;
+    int16_t* _out = (int16_t*)outputVector;
+    unsigned int i;
+    __m128i a;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            a = _mm_loadu_si128((const __m128i*)_in);  // 8 complex samples
+            // duplicate each byte into the high half of a 16-bit word and shift it back with sign extension
+            _mm_storeu_si128((__m128i*)_out, _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8));
+            _mm_storeu_si128((__m128i*)(_out + 8), _mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8));
+            _in += 16;
+            _out += 16;
+        }
+    for (i = sse_iters * 16; i < 2 * num_points; i++)
+        {
+            *_out++ = (int16_t)(*_in++);
+        }
+}
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_avx2(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 16;
+    const int8_t* _in = (const int8_t*)inputVector;
+    int16_t* _out = (int16_t*)outputVector;
+    unsigned int i;
+    __m256i a;
+
+    for (i = 0; i < avx_iters; i++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)_in);  // 16 complex samples
+            _mm256_storeu_si256((__m256i*)_out, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(a)));
+            _mm256_storeu_si256((__m256i*)(_out + 16), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(a, 1)));
+            _in += 32;
+            _out += 32;
+        }
+    for (i = avx_iters * 32; i < 2 * num_points; i++)
+        {
+            *_out++ = (int16_t)(*_in++);
+        }
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_neon(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    const int8_t* _in = (const int8_t*)inputVector;
+    int16_t* _out = (int16_t*)outputVector;
+    unsigned int i;
+    int8x16_t a;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            a = vld1q_s8(_in);
+            vst1q_s16(_out, vmovl_s8(vget_low_s8(a)));
+            vst1q_s16(_out + 8, vmovl_s8(vget_high_s8(a)));
+            _in += 16;
+            _out += 16;
+        }
+    for (i = neon_iters * 16; i < 2 * num_points; i++)
+        {
+            *_out++ = (int16_t)(*_in++);
+        }
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_convert_16ic_H */
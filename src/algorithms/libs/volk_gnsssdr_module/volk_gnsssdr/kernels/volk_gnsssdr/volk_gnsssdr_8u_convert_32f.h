@@ -0,0 +1,168 @@
+/*!
+ * \file volk_gnsssdr_8u_convert_32f.h
+ * \brief VOLK_GNSSSDR kernel: converts unsigned 8-bit samples into floats.
+ *
+ * VOLK_GNSSSDR kernel that converts unsigned 8-bit samples, as streamed by
+ * rtl_tcp and other 8-bit front-ends, into floating point values, removing
+ * their offset and scaling them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_convert_32f
+ *
+ * \b Overview
+ *
+ * Converts a stream of unsigned 8-bit samples into floats, computing
+ * result[n] = (input[n] - offset) * scale. Interleaved I/Q samples are
+ * converted by passing twice the number of complex samples.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_convert_32f(float* result, const uint8_t* input, float offset, float scale, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li input: Unsigned 8-bit input samples.
+ * \li offset: Value subtracted from each sample.
+ * \li scale: Factor applied to each sample after removing the offset.
+ * \li num_points: Number of samples.
+ *
+ * \b Outputs
+ * \li result: Converted samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_convert_32f_H
+#define INCLUDED_volk_gnsssdr_8u_convert_32f_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_convert_32f_generic(float* result, const uint8_t* input, float offset, float scale, unsigned int num_points)
+{
+    unsigned int n;
+    for (n = 0; n < num_points; n++)
+        {
+            result[n] = ((float)input[n] - offset) * scale;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8u_convert_32f_u_sse2(float* result, const uint8_t* input, float offset, float scale, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    const uint8_t* input_ptr = input;
+    float* result_ptr = result;
+    unsigned int number;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 offset_val = _mm_set1_ps(offset);
+    const __m128 scale_val = _mm_set1_ps(scale);
+    __m128i input_val, lo16, hi16;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            input_val = _mm_loadu_si128((const __m128i*)input_ptr);
+            lo16 = _mm_unpacklo_epi8(input_val, zero);
+            hi16 = _mm_unpackhi_epi8(input_val, zero);
+
+            _mm_storeu_ps(result_ptr, _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)), offset_val), scale_val));
+            _mm_storeu_ps(result_ptr + 4, _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)), offset_val), scale_val));
+            _mm_storeu_ps(result_ptr + 8, _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)), offset_val), scale_val));
+            _mm_storeu_ps(result_ptr + 12, _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)), offset_val), scale_val));
+
+            input_ptr += 16;
+            result_ptr += 16;
+        }
+
+    volk_gnsssdr_8u_convert_32f_generic(result_ptr, input_ptr, offset, scale, num_points - sse_iters * 16);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_convert_32f_u_avx2(float* result, const uint8_t* input, float offset, float scale, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 32;
+    const uint8_t* input_ptr = input;
+    float* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const __m256 offset_val = _mm256_set1_ps(offset);
+    const __m256 scale_val = _mm256_set1_ps(scale);
+    __m128i input_val;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            for (j = 0; j < 4; j++)
+                {
+                    input_val = _mm_loadl_epi64((const __m128i*)input_ptr);
+                    _mm256_storeu_ps(result_ptr, _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(input_val)), offset_val), scale_val));
+                    input_ptr += 8;
+                    result_ptr += 8;
+                }
+        }
+
+    volk_gnsssdr_8u_convert_32f_generic(result_ptr, input_ptr, offset, scale, num_points - avx_iters * 32);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_convert_32f_neon(float* result, const uint8_t* input, float offset, float scale, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 16;
+    const uint8_t* input_ptr = input;
+    float* result_ptr = result;
+    unsigned int number;
+
+    const float32x4_t offset_val = vdupq_n_f32(offset);
+    const float32x4_t scale_val = vdupq_n_f32(scale);
+    uint8x16_t input_val;
+    uint16x8_t lo16, hi16;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            input_val = vld1q_u8(input_ptr);
+            lo16 = vmovl_u8(vget_low_u8(input_val));
+            hi16 = vmovl_u8(vget_high_u8(input_val));
+
+            vst1q_f32(result_ptr, vmulq_f32(vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))), offset_val), scale_val));
+            vst1q_f32(result_ptr + 4, vmulq_f32(vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16))), offset_val), scale_val));
+            vst1q_f32(result_ptr + 8, vmulq_f32(vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))), offset_val), scale_val));
+            vst1q_f32(result_ptr + 12, vmulq_f32(vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16))), offset_val), scale_val));
+
+            input_ptr += 16;
+            result_ptr += 16;
+        }
+
+    volk_gnsssdr_8u_convert_32f_generic(result_ptr, input_ptr, offset, scale, num_points - neon_iters * 16);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_convert_32f_H */
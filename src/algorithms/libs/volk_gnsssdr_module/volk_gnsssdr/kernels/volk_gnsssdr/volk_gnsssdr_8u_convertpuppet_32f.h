@@ -0,0 +1,56 @@
+/*!
+ * \file volk_gnsssdr_8u_convertpuppet_32f.h
+ * \brief VOLK_GNSSSDR puppet for the unsigned 8-bit conversion kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the unsigned 8-bit conversion kernel
+ * into the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_convertpuppet_32f_H
+#define INCLUDED_volk_gnsssdr_8u_convertpuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_convert_32f.h"
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_convertpuppet_32f_generic(float* result, const uint8_t* input, unsigned int num_points)
+{
+    volk_gnsssdr_8u_convert_32f_generic(result, input, 127.4F, 1.0F / 128.0F, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_8u_convertpuppet_32f_u_sse2(float* result, const uint8_t* input, unsigned int num_points)
+{
+    volk_gnsssdr_8u_convert_32f_u_sse2(result, input, 127.4F, 1.0F / 128.0F, num_points);
+}
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_convertpuppet_32f_u_avx2(float* result, const uint8_t* input, unsigned int num_points)
+{
+    volk_gnsssdr_8u_convert_32f_u_avx2(result, input, 127.4F, 1.0F / 128.0F, num_points);
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_convertpuppet_32f_neon(float* result, const uint8_t* input, unsigned int num_points)
+{
+    volk_gnsssdr_8u_convert_32f_neon(result, input, 127.4F, 1.0F / 128.0F, num_points);
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_convertpuppet_32f_H */
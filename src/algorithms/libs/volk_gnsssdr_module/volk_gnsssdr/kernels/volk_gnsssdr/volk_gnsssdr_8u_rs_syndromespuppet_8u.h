@@ -0,0 +1,93 @@
+/*!
+ * \file volk_gnsssdr_8u_rs_syndromespuppet_8u.h
+ * \brief VOLK_GNSSSDR puppet for the Reed-Solomon syndromes kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating volk_gnsssdr_8u_x2_rs_syndromes_8u into the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_rs_syndromespuppet_8u_H
+#define INCLUDED_volk_gnsssdr_8u_rs_syndromespuppet_8u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_x2_rs_syndromes_8u.h"
+
+// Products beta_i * x^b of the 60 roots alpha^(195 + i) of the Galileo I/NAV
+// code, in GF(2^8) with field generator polynomial x^8 + x^4 + x^3 + x^2 + 1
+static inline unsigned int volk_gnsssdr_8u_rs_syndromespuppet_products(uint8_t* root_products, unsigned int num_points)
+{
+    const unsigned int num_roots = num_points < 60 ? num_points : 60;
+    unsigned int i;
+    unsigned int k;
+    unsigned int b;
+    uint8_t beta;
+
+    for (i = 0; i < num_roots; i++)
+        {
+            beta = 1;
+            for (k = 0; k < (195 + i) % 255; k++)
+                {
+                    beta = (uint8_t)((beta << 1) ^ ((beta & 0x80) ? 0x1D : 0));
+                }
+            for (b = 0; b < 8; b++)
+                {
+                    root_products[b * num_roots + i] = beta;
+                    beta = (uint8_t)((beta << 1) ^ ((beta & 0x80) ? 0x1D : 0));
+                }
+        }
+    return num_roots;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_rs_syndromespuppet_8u_generic(uint8_t* syndromes, const uint8_t* data, unsigned int num_points)
+{
+    uint8_t root_products[8 * 60];
+    const unsigned int num_roots = volk_gnsssdr_8u_rs_syndromespuppet_products(root_products, num_points);
+    volk_gnsssdr_8u_x2_rs_syndromes_8u_generic(syndromes, data, root_products, num_roots, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_8u_rs_syndromespuppet_8u_u_sse2(uint8_t* syndromes, const uint8_t* data, unsigned int num_points)
+{
+    uint8_t root_products[8 * 60];
+    const unsigned int num_roots = volk_gnsssdr_8u_rs_syndromespuppet_products(root_products, num_points);
+    volk_gnsssdr_8u_x2_rs_syndromes_8u_u_sse2(syndromes, data, root_products, num_roots, num_points);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_rs_syndromespuppet_8u_u_avx2(uint8_t* syndromes, const uint8_t* data, unsigned int num_points)
+{
+    uint8_t root_products[8 * 60];
+    const unsigned int num_roots = volk_gnsssdr_8u_rs_syndromespuppet_products(root_products, num_points);
+    volk_gnsssdr_8u_x2_rs_syndromes_8u_u_avx2(syndromes, data, root_products, num_roots, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_rs_syndromespuppet_8u_neon(uint8_t* syndromes, const uint8_t* data, unsigned int num_points)
+{
+    uint8_t root_products[8 * 60];
+    const unsigned int num_roots = volk_gnsssdr_8u_rs_syndromespuppet_products(root_products, num_points);
+    volk_gnsssdr_8u_x2_rs_syndromes_8u_neon(syndromes, data, root_products, num_roots, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_rs_syndromespuppet_8u_H */
@@ -0,0 +1,227 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack2bit_16i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples into 16-bit integers.
+ *
+ * VOLK_GNSSSDR kernel that unpacks the four 2-bit samples held in each input
+ * byte, mapping them to 16-bit integers through a lookup table.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack2bit_16i
+ *
+ * \b Overview
+ *
+ * Unpacks a stream of 2-bit samples, four per byte. The j-th output of each
+ * byte is taken from its bits 2 * order[j] and 2 * order[j] + 1, and the
+ * resulting 2-bit code is mapped to its value by \p lut. The SIMD versions map
+ * sixteen (or thirty-two) codes at once with a byte shuffle.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack2bit_16i(int16_t* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Packed input samples, num_points / 4 bytes (rounded up).
+ * \li lut: Output value of each 2-bit code, 4 entries.
+ * \li order: Position (0 to 3, from the least significant bits) in the byte of each of its four output samples.
+ * \li num_points: Number of output samples.
+ *
+ * \b Outputs
+ * \li result: Unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack2bit_16i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack2bit_16i_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack2bit_16i_generic(int16_t* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    unsigned int n;
+    for (n = 0; n < num_points; n++)
+        {
+            result[n] = lut[(packed[n / 4] >> (2 * (order[n % 4] & 3))) & 3];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_16i_u_ssse3(int16_t* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 64;
+    const uint8_t* packed_ptr = packed;
+    int16_t* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const __m128i mask = _mm_set1_epi8(3);
+    const __m128i lut_val = _mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i shift0 = _mm_cvtsi32_si128(2 * (order[0] & 3));
+    const __m128i shift1 = _mm_cvtsi32_si128(2 * (order[1] & 3));
+    const __m128i shift2 = _mm_cvtsi32_si128(2 * (order[2] & 3));
+    const __m128i shift3 = _mm_cvtsi32_si128(2 * (order[3] & 3));
+    __m128i packed_val, s0, s1, s2, s3, lo01, hi01, lo23, hi23;
+    __m128i out[4];
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            packed_val = _mm_loadu_si128((const __m128i*)packed_ptr);
+
+            s0 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift0), mask));
+            s1 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift1), mask));
+            s2 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift2), mask));
+            s3 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift3), mask));
+
+            lo01 = _mm_unpacklo_epi8(s0, s1);
+            hi01 = _mm_unpackhi_epi8(s0, s1);
+            lo23 = _mm_unpacklo_epi8(s2, s3);
+            hi23 = _mm_unpackhi_epi8(s2, s3);
+            out[0] = _mm_unpacklo_epi16(lo01, lo23);
+            out[1] = _mm_unpackhi_epi16(lo01, lo23);
+            out[2] = _mm_unpacklo_epi16(hi01, hi23);
+            out[3] = _mm_unpackhi_epi16(hi01, hi23);
+
+            // sign extension to 16 bits
+            for (j = 0; j < 4; j++)
+                {
+                    _mm_storeu_si128((__m128i*)result_ptr, _mm_srai_epi16(_mm_unpacklo_epi8(out[j], out[j]), 8));
+                    _mm_storeu_si128((__m128i*)(result_ptr + 8), _mm_srai_epi16(_mm_unpackhi_epi8(out[j], out[j]), 8));
+                    result_ptr += 16;
+                }
+
+            packed_ptr += 16;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_16i_generic(result_ptr, packed_ptr, lut, order, num_points - sse_iters * 64);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_16i_u_avx2(int16_t* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 128;
+    const uint8_t* packed_ptr = packed;
+    int16_t* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const __m256i mask = _mm256_set1_epi8(3);
+    const __m256i lut_val = _mm256_broadcastsi128_si256(_mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m128i shift0 = _mm_cvtsi32_si128(2 * (order[0] & 3));
+    const __m128i shift1 = _mm_cvtsi32_si128(2 * (order[1] & 3));
+    const __m128i shift2 = _mm_cvtsi32_si128(2 * (order[2] & 3));
+    const __m128i shift3 = _mm_cvtsi32_si128(2 * (order[3] & 3));
+    __m256i packed_val, s0, s1, s2, s3, lo01, hi01, lo23, hi23, out0, out1, out2, out3;
+    __m256i out[4];
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            packed_val = _mm256_loadu_si256((const __m256i*)packed_ptr);
+
+            s0 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift0), mask));
+            s1 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift1), mask));
+            s2 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift2), mask));
+            s3 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift3), mask));
+
+            lo01 = _mm256_unpacklo_epi8(s0, s1);
+            hi01 = _mm256_unpackhi_epi8(s0, s1);
+            lo23 = _mm256_unpacklo_epi8(s2, s3);
+            hi23 = _mm256_unpackhi_epi8(s2, s3);
+            out0 = _mm256_unpacklo_epi16(lo01, lo23);
+            out1 = _mm256_unpackhi_epi16(lo01, lo23);
+            out2 = _mm256_unpacklo_epi16(hi01, hi23);
+            out3 = _mm256_unpackhi_epi16(hi01, hi23);
+            out[0] = _mm256_permute2x128_si256(out0, out1, 0x20);
+            out[1] = _mm256_permute2x128_si256(out2, out3, 0x20);
+            out[2] = _mm256_permute2x128_si256(out0, out1, 0x31);
+            out[3] = _mm256_permute2x128_si256(out2, out3, 0x31);
+
+            for (j = 0; j < 4; j++)
+                {
+                    _mm256_storeu_si256((__m256i*)result_ptr, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(out[j])));
+                    _mm256_storeu_si256((__m256i*)(result_ptr + 16), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(out[j], 1)));
+                    result_ptr += 32;
+                }
+
+            packed_ptr += 32;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_16i_generic(result_ptr, packed_ptr, lut, order, num_points - avx_iters * 128);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_16i_neon(int16_t* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 64;
+    const uint8_t* packed_ptr = packed;
+    int16_t* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const int8_t lut_array[8] = {lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0};
+    const int8x8_t lut_val = vld1_s8(lut_array);
+    const uint8x16_t mask = vdupq_n_u8(3);
+    int8x16_t shift[4];
+    uint8x16_t packed_val, code;
+    int8x16_t samples;
+    int16x8x4_t samples_lo, samples_hi;
+
+    for (j = 0; j < 4; j++)
+        {
+            shift[j] = vdupq_n_s8(-2 * (int8_t)(order[j] & 3));
+        }
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            packed_val = vld1q_u8(packed_ptr);
+
+            for (j = 0; j < 4; j++)
+                {
+                    code = vandq_u8(vshlq_u8(packed_val, shift[j]), mask);
+                    samples = vcombine_s8(vtbl1_s8(lut_val, vreinterpret_s8_u8(vget_low_u8(code))), vtbl1_s8(lut_val, vreinterpret_s8_u8(vget_high_u8(code))));
+                    samples_lo.val[j] = vmovl_s8(vget_low_s8(samples));
+                    samples_hi.val[j] = vmovl_s8(vget_high_s8(samples));
+                }
+
+            // interleaving stores, four outputs per input byte
+            vst4q_s16(result_ptr, samples_lo);
+            vst4q_s16(result_ptr + 32, samples_hi);
+
+            packed_ptr += 16;
+            result_ptr += 64;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_16i_generic(result_ptr, packed_ptr, lut, order, num_points - neon_iters * 64);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack2bit_16i_H */
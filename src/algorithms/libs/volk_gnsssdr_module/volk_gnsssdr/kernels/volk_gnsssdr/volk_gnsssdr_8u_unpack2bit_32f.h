@@ -0,0 +1,246 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack2bit_32f.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples into floats.
+ *
+ * VOLK_GNSSSDR kernel that unpacks the four 2-bit samples held in each input
+ * byte, mapping them to floating point values through a lookup table.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack2bit_32f
+ *
+ * \b Overview
+ *
+ * Unpacks a stream of 2-bit samples, four per byte. The j-th output of each
+ * byte is taken from its bits 2 * order[j] and 2 * order[j] + 1, and the
+ * resulting 2-bit code is mapped to its value by \p lut. The SIMD versions map
+ * sixteen (or thirty-two) codes at once with a byte shuffle.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack2bit_32f(float* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Packed input samples, num_points / 4 bytes (rounded up).
+ * \li lut: Output value of each 2-bit code, 4 entries.
+ * \li order: Position (0 to 3, from the least significant bits) in the byte of each of its four output samples.
+ * \li num_points: Number of output samples.
+ *
+ * \b Outputs
+ * \li result: Unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack2bit_32f_H
+#define INCLUDED_volk_gnsssdr_8u_unpack2bit_32f_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack2bit_32f_generic(float* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    unsigned int n;
+    for (n = 0; n < num_points; n++)
+        {
+            result[n] = (float)lut[(packed[n / 4] >> (2 * (order[n % 4] & 3))) & 3];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_32f_u_ssse3(float* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 64;
+    const uint8_t* packed_ptr = packed;
+    float* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const __m128i mask = _mm_set1_epi8(3);
+    const __m128i lut_val = _mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i shift0 = _mm_cvtsi32_si128(2 * (order[0] & 3));
+    const __m128i shift1 = _mm_cvtsi32_si128(2 * (order[1] & 3));
+    const __m128i shift2 = _mm_cvtsi32_si128(2 * (order[2] & 3));
+    const __m128i shift3 = _mm_cvtsi32_si128(2 * (order[3] & 3));
+    __m128i packed_val, s0, s1, s2, s3, lo01, hi01, lo23, hi23, lo16, hi16;
+    __m128i out[4];
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            packed_val = _mm_loadu_si128((const __m128i*)packed_ptr);
+
+            s0 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift0), mask));
+            s1 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift1), mask));
+            s2 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift2), mask));
+            s3 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srl_epi16(packed_val, shift3), mask));
+
+            lo01 = _mm_unpacklo_epi8(s0, s1);
+            hi01 = _mm_unpackhi_epi8(s0, s1);
+            lo23 = _mm_unpacklo_epi8(s2, s3);
+            hi23 = _mm_unpackhi_epi8(s2, s3);
+            out[0] = _mm_unpacklo_epi16(lo01, lo23);
+            out[1] = _mm_unpackhi_epi16(lo01, lo23);
+            out[2] = _mm_unpacklo_epi16(hi01, hi23);
+            out[3] = _mm_unpackhi_epi16(hi01, hi23);
+
+            // sign extension to 32 bits and conversion
+            for (j = 0; j < 4; j++)
+                {
+                    lo16 = _mm_unpacklo_epi8(out[j], out[j]);
+                    hi16 = _mm_unpackhi_epi8(out[j], out[j]);
+                    _mm_storeu_ps(result_ptr, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo16, lo16), 24)));
+                    _mm_storeu_ps(result_ptr + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo16, lo16), 24)));
+                    _mm_storeu_ps(result_ptr + 8, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi16, hi16), 24)));
+                    _mm_storeu_ps(result_ptr + 12, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi16, hi16), 24)));
+                    result_ptr += 16;
+                }
+
+            packed_ptr += 16;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_32f_generic(result_ptr, packed_ptr, lut, order, num_points - sse_iters * 64);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_32f_u_avx2(float* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 128;
+    const uint8_t* packed_ptr = packed;
+    float* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+
+    const __m256i mask = _mm256_set1_epi8(3);
+    const __m256i lut_val = _mm256_broadcastsi128_si256(_mm_setr_epi8(lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m128i shift0 = _mm_cvtsi32_si128(2 * (order[0] & 3));
+    const __m128i shift1 = _mm_cvtsi32_si128(2 * (order[1] & 3));
+    const __m128i shift2 = _mm_cvtsi32_si128(2 * (order[2] & 3));
+    const __m128i shift3 = _mm_cvtsi32_si128(2 * (order[3] & 3));
+    __m256i packed_val, s0, s1, s2, s3, lo01, hi01, lo23, hi23, out0, out1, out2, out3;
+    __m128i half;
+    __m256i out[4];
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            packed_val = _mm256_loadu_si256((const __m256i*)packed_ptr);
+
+            s0 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift0), mask));
+            s1 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift1), mask));
+            s2 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift2), mask));
+            s3 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srl_epi16(packed_val, shift3), mask));
+
+            lo01 = _mm256_unpacklo_epi8(s0, s1);
+            hi01 = _mm256_unpackhi_epi8(s0, s1);
+            lo23 = _mm256_unpacklo_epi8(s2, s3);
+            hi23 = _mm256_unpackhi_epi8(s2, s3);
+            out0 = _mm256_unpacklo_epi16(lo01, lo23);
+            out1 = _mm256_unpackhi_epi16(lo01, lo23);
+            out2 = _mm256_unpacklo_epi16(hi01, hi23);
+            out3 = _mm256_unpackhi_epi16(hi01, hi23);
+            out[0] = _mm256_permute2x128_si256(out0, out1, 0x20);
+            out[1] = _mm256_permute2x128_si256(out2, out3, 0x20);
+            out[2] = _mm256_permute2x128_si256(out0, out1, 0x31);
+            out[3] = _mm256_permute2x128_si256(out2, out3, 0x31);
+
+            for (j = 0; j < 4; j++)
+                {
+                    half = _mm256_castsi256_si128(out[j]);
+                    _mm256_storeu_ps(result_ptr, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(half)));
+                    _mm256_storeu_ps(result_ptr + 8, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(half, 8))));
+                    half = _mm256_extracti128_si256(out[j], 1);
+                    _mm256_storeu_ps(result_ptr + 16, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(half)));
+                    _mm256_storeu_ps(result_ptr + 24, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(half, 8))));
+                    result_ptr += 32;
+                }
+
+            packed_ptr += 32;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_32f_generic(result_ptr, packed_ptr, lut, order, num_points - avx_iters * 128);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack2bit_32f_neon(float* result, const uint8_t* packed, const int8_t* lut, const uint8_t* order, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 64;
+    const uint8_t* packed_ptr = packed;
+    float* result_ptr = result;
+    unsigned int number;
+    unsigned int j;
+    unsigned int k;
+
+    const int8_t lut_array[8] = {lut[0], lut[1], lut[2], lut[3], 0, 0, 0, 0};
+    const int8x8_t lut_val = vld1_s8(lut_array);
+    const uint8x16_t mask = vdupq_n_u8(3);
+    int8x16_t shift[4];
+    uint8x16_t packed_val, code;
+    int8x16_t samples;
+    int16x8_t samples_lo[4], samples_hi[4];
+    float32x4x4_t samples_f;
+
+    for (j = 0; j < 4; j++)
+        {
+            shift[j] = vdupq_n_s8(-2 * (int8_t)(order[j] & 3));
+        }
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            packed_val = vld1q_u8(packed_ptr);
+
+            for (j = 0; j < 4; j++)
+                {
+                    code = vandq_u8(vshlq_u8(packed_val, shift[j]), mask);
+                    samples = vcombine_s8(vtbl1_s8(lut_val, vreinterpret_s8_u8(vget_low_u8(code))), vtbl1_s8(lut_val, vreinterpret_s8_u8(vget_high_u8(code))));
+                    samples_lo[j] = vmovl_s8(vget_low_s8(samples));
+                    samples_hi[j] = vmovl_s8(vget_high_s8(samples));
+                }
+
+            // interleaving stores, four outputs per input byte, four bytes each
+            for (k = 0; k < 4; k++)
+                {
+                    for (j = 0; j < 4; j++)
+                        {
+                            const int16x8_t s16 = k < 2 ? samples_lo[j] : samples_hi[j];
+                            const int16x4_t s16_half = (k & 1) ? vget_high_s16(s16) : vget_low_s16(s16);
+                            samples_f.val[j] = vcvtq_f32_s32(vmovl_s16(s16_half));
+                        }
+                    vst4q_f32(result_ptr, samples_f);
+                    result_ptr += 16;
+                }
+
+            packed_ptr += 16;
+        }
+
+    volk_gnsssdr_8u_unpack2bit_32f_generic(result_ptr, packed_ptr, lut, order, num_points - neon_iters * 64);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack2bit_32f_H */
@@ -0,0 +1,64 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack2bitpuppet_32f.h
+ * \brief VOLK_GNSSSDR puppet for the 2-bit unpacking kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the 2-bit unpacking kernel into the
+ * test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_32f_H
+#define INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack2bit_32f.h"
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_32f_generic(float* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    volk_gnsssdr_8u_unpack2bit_32f_generic(result, packed, lut, order, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_32f_u_ssse3(float* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    volk_gnsssdr_8u_unpack2bit_32f_u_ssse3(result, packed, lut, order, num_points);
+}
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_32f_u_avx2(float* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    volk_gnsssdr_8u_unpack2bit_32f_u_avx2(result, packed, lut, order, num_points);
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_unpack2bitpuppet_32f_neon(float* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[4] = {1, 3, -3, -1};
+    const uint8_t order[4] = {2, 3, 0, 1};
+    volk_gnsssdr_8u_unpack2bit_32f_neon(result, packed, lut, order, num_points);
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack2bitpuppet_32f_H */
@@ -0,0 +1,173 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack4bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 4-bit samples into 8-bit integers.
+ *
+ * VOLK_GNSSSDR kernel that unpacks the two 4-bit samples held in each input
+ * byte, mapping them to 8-bit integers through a lookup table.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack4bit_8i
+ *
+ * \b Overview
+ *
+ * Unpacks a stream of 4-bit samples, two per byte, the least significant
+ * nibble first, and maps each 4-bit code to its value by \p lut. The SIMD
+ * versions map sixteen (or thirty-two) codes at once with a byte shuffle.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack4bit_8i(int8_t* result, const uint8_t* packed, const int8_t* lut, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Packed input samples, num_points / 2 bytes (rounded up).
+ * \li lut: Output value of each 4-bit code, 16 entries.
+ * \li num_points: Number of output samples.
+ *
+ * \b Outputs
+ * \li result: Unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack4bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack4bit_8i_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack4bit_8i_generic(int8_t* result, const uint8_t* packed, const int8_t* lut, unsigned int num_points)
+{
+    unsigned int n;
+    for (n = 0; n < num_points; n++)
+        {
+            result[n] = lut[(packed[n / 2] >> (4 * (n % 2))) & 15];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack4bit_8i_u_ssse3(int8_t* result, const uint8_t* packed, const int8_t* lut, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 32;
+    const uint8_t* packed_ptr = packed;
+    int8_t* result_ptr = result;
+    unsigned int number;
+
+    const __m128i mask = _mm_set1_epi8(15);
+    const __m128i lut_val = _mm_loadu_si128((const __m128i*)lut);
+    __m128i packed_val, s0, s1;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            packed_val = _mm_loadu_si128((const __m128i*)packed_ptr);
+
+            s0 = _mm_shuffle_epi8(lut_val, _mm_and_si128(packed_val, mask));
+            s1 = _mm_shuffle_epi8(lut_val, _mm_and_si128(_mm_srli_epi16(packed_val, 4), mask));
+
+            _mm_storeu_si128((__m128i*)result_ptr, _mm_unpacklo_epi8(s0, s1));
+            _mm_storeu_si128((__m128i*)(result_ptr + 16), _mm_unpackhi_epi8(s0, s1));
+
+            packed_ptr += 16;
+            result_ptr += 32;
+        }
+
+    volk_gnsssdr_8u_unpack4bit_8i_generic(result_ptr, packed_ptr, lut, num_points - sse_iters * 32);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack4bit_8i_u_avx2(int8_t* result, const uint8_t* packed, const int8_t* lut, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 64;
+    const uint8_t* packed_ptr = packed;
+    int8_t* result_ptr = result;
+    unsigned int number;
+
+    const __m256i mask = _mm256_set1_epi8(15);
+    const __m256i lut_val = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lut));
+    __m256i packed_val, s0, s1, lo, hi;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            packed_val = _mm256_loadu_si256((const __m256i*)packed_ptr);
+
+            s0 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(packed_val, mask));
+            s1 = _mm256_shuffle_epi8(lut_val, _mm256_and_si256(_mm256_srli_epi16(packed_val, 4), mask));
+
+            // in-lane unpacks, lo holds the samples of bytes 0-7 and 16-23
+            lo = _mm256_unpacklo_epi8(s0, s1);
+            hi = _mm256_unpackhi_epi8(s0, s1);
+            _mm256_storeu_si256((__m256i*)result_ptr, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(result_ptr + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+
+            packed_ptr += 32;
+            result_ptr += 64;
+        }
+
+    volk_gnsssdr_8u_unpack4bit_8i_generic(result_ptr, packed_ptr, lut, num_points - avx_iters * 64);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack4bit_8i_neon(int8_t* result, const uint8_t* packed, const int8_t* lut, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 32;
+    const uint8_t* packed_ptr = packed;
+    int8_t* result_ptr = result;
+    unsigned int number;
+
+    int8x8x2_t lut_val;
+    const uint8x16_t mask = vdupq_n_u8(15);
+    uint8x16_t packed_val, code;
+    int8x16x2_t samples;
+
+    lut_val.val[0] = vld1_s8(lut);
+    lut_val.val[1] = vld1_s8(lut + 8);
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            packed_val = vld1q_u8(packed_ptr);
+
+            code = vandq_u8(packed_val, mask);
+            samples.val[0] = vcombine_s8(vtbl2_s8(lut_val, vreinterpret_s8_u8(vget_low_u8(code))), vtbl2_s8(lut_val, vreinterpret_s8_u8(vget_high_u8(code))));
+            code = vshrq_n_u8(packed_val, 4);
+            samples.val[1] = vcombine_s8(vtbl2_s8(lut_val, vreinterpret_s8_u8(vget_low_u8(code))), vtbl2_s8(lut_val, vreinterpret_s8_u8(vget_high_u8(code))));
+
+            // interleaving store, two outputs per input byte
+            vst2q_s8(result_ptr, samples);
+
+            packed_ptr += 16;
+            result_ptr += 32;
+        }
+
+    volk_gnsssdr_8u_unpack4bit_8i_generic(result_ptr, packed_ptr, lut, num_points - neon_iters * 32);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack4bit_8i_H */
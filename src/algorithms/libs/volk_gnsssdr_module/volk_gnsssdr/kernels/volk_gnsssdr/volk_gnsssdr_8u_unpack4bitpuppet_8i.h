@@ -0,0 +1,60 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack4bitpuppet_8i.h
+ * \brief VOLK_GNSSSDR puppet for the 4-bit unpacking kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the 4-bit unpacking kernel into the
+ * test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack4bit_8i.h"
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_generic(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    volk_gnsssdr_8u_unpack4bit_8i_generic(result, packed, lut, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_u_ssse3(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    volk_gnsssdr_8u_unpack4bit_8i_u_ssse3(result, packed, lut, num_points);
+}
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_u_avx2(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    volk_gnsssdr_8u_unpack4bit_8i_u_avx2(result, packed, lut, num_points);
+}
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_neon(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    const int8_t lut[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    volk_gnsssdr_8u_unpack4bit_8i_neon(result, packed, lut, num_points);
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H */
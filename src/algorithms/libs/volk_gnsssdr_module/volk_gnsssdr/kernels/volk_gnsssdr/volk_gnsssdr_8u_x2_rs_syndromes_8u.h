@@ -0,0 +1,268 @@
+/*!
+ * \file volk_gnsssdr_8u_x2_rs_syndromes_8u.h
+ * \brief VOLK_GNSSSDR kernel: computes the syndromes of a Reed-Solomon code word.
+ *
+ * VOLK_GNSSSDR kernel that evaluates a code word over GF(2^8) at the roots of
+ * the generator polynomial of a Reed-Solomon code, as used in the decoding of
+ * the Galileo I/NAV and E6 HAS messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_x2_rs_syndromes_8u
+ *
+ * \b Overview
+ *
+ * Computes syndromes[i] = data(beta_i), where data(x) is the polynomial whose
+ * coefficients are the num_points input symbols, highest degree first, and
+ * beta_i are the num_roots roots of the code generator, by Horner's rule:
+ * s_i = s_i * beta_i + data[n].
+ *
+ * The field multiplications are bit-sliced: since multiplying by a constant is
+ * linear over GF(2), s * beta_i is the XOR of the products beta_i * x^b
+ * selected by the bits b of s. Those products are given by the caller in
+ * \p root_products, so the kernel does not depend on the field generator
+ * polynomial. The SIMD versions update 16 (or 32) syndromes at once with byte
+ * compares, ANDs and XORs, and the generic one combines the products into two
+ * 16-entry tables per root, indexed by the nibbles of s.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_x2_rs_syndromes_8u(uint8_t* syndromes, const uint8_t* data, const uint8_t* root_products, unsigned int num_roots, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li data:          Received code word, num_points symbols.
+ * \li root_products: Products beta_i * x^b, stored as root_products[b * num_roots + i] for b = 0..7.
+ * \li num_roots:     Number of roots (parity symbols) of the code.
+ * \li num_points:    Number of symbols of the code word.
+ *
+ * \b Outputs
+ * \li syndromes:     num_roots syndromes, in polynomial form.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x2_rs_syndromes_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x2_rs_syndromes_8u_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_x2_rs_syndromes_8u_generic(uint8_t* syndromes, const uint8_t* data, const uint8_t* root_products, unsigned int num_roots, unsigned int num_points)
+{
+    // s * beta_i for each value of the low and high nibbles of s, for up to 64 roots at a time
+    uint8_t lo[64][16];
+    uint8_t hi[64][16];
+    unsigned int first_root;
+    unsigned int block_roots;
+    unsigned int i;
+    unsigned int k;
+    unsigned int b;
+    unsigned int n;
+    uint8_t s;
+
+    for (first_root = 0; first_root < num_roots; first_root += 64)
+        {
+            block_roots = num_roots - first_root < 64 ? num_roots - first_root : 64;
+            for (i = 0; i < block_roots; i++)
+                {
+                    for (k = 0; k < 16; k++)
+                        {
+                            lo[i][k] = 0;
+                            hi[i][k] = 0;
+                            for (b = 0; b < 4; b++)
+                                {
+                                    if ((k >> b) & 1)
+                                        {
+                                            lo[i][k] ^= root_products[b * num_roots + first_root + i];
+                                            hi[i][k] ^= root_products[(b + 4) * num_roots + first_root + i];
+                                        }
+                                }
+                        }
+                }
+
+            // roots in the inner loop, so that their recursions overlap
+            for (i = 0; i < block_roots; i++)
+                {
+                    syndromes[first_root + i] = 0;
+                }
+            for (n = 0; n < num_points; n++)
+                {
+                    for (i = 0; i < block_roots; i++)
+                        {
+                            s = syndromes[first_root + i];
+                            syndromes[first_root + i] = data[n] ^ lo[i][s & 15] ^ hi[i][s >> 4];
+                        }
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_rs_syndromes_8u_u_sse2(uint8_t* syndromes, const uint8_t* data, const uint8_t* root_products, unsigned int num_roots, unsigned int num_points)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i products[8];
+    __m128i s_val, t_val, acc;
+    unsigned int first_root = 0;
+    unsigned int n;
+    unsigned int b;
+
+    if (num_roots < 16)
+        {
+            volk_gnsssdr_8u_x2_rs_syndromes_8u_generic(syndromes, data, root_products, num_roots, num_points);
+            return;
+        }
+
+    while (first_root < num_roots)
+        {
+            // The last block overlaps the previous one instead of leaving a tail
+            if (first_root + 16 > num_roots)
+                {
+                    first_root = num_roots - 16;
+                }
+            for (b = 0; b < 8; b++)
+                {
+                    products[b] = _mm_loadu_si128((const __m128i*)(root_products + b * num_roots + first_root));
+                }
+
+            s_val = zero;
+            for (n = 0; n < num_points; n++)
+                {
+                    acc = _mm_set1_epi8((char)data[n]);
+                    t_val = s_val;
+                    for (b = 8; b-- > 0;)
+                        {
+                            // bit b of each syndrome is now in its sign bit
+                            acc = _mm_xor_si128(acc, _mm_and_si128(_mm_cmplt_epi8(t_val, zero), products[b]));
+                            t_val = _mm_add_epi8(t_val, t_val);
+                        }
+                    s_val = acc;
+                }
+            _mm_storeu_si128((__m128i*)(syndromes + first_root), s_val);
+            first_root += 16;
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_rs_syndromes_8u_u_avx2(uint8_t* syndromes, const uint8_t* data, const uint8_t* root_products, unsigned int num_roots, unsigned int num_points)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i products[8];
+    __m256i s_val, t_val, acc;
+    unsigned int first_root = 0;
+    unsigned int n;
+    unsigned int b;
+
+    if (num_roots < 32)
+        {
+            volk_gnsssdr_8u_x2_rs_syndromes_8u_generic(syndromes, data, root_products, num_roots, num_points);
+            return;
+        }
+
+    while (first_root < num_roots)
+        {
+            // The last block overlaps the previous one instead of leaving a tail
+            if (first_root + 32 > num_roots)
+                {
+                    first_root = num_roots - 32;
+                }
+            for (b = 0; b < 8; b++)
+                {
+                    products[b] = _mm256_loadu_si256((const __m256i*)(root_products + b * num_roots + first_root));
+                }
+
+            s_val = zero;
+            for (n = 0; n < num_points; n++)
+                {
+                    acc = _mm256_set1_epi8((char)data[n]);
+                    t_val = s_val;
+                    for (b = 8; b-- > 0;)
+                        {
+                            // bit b of each syndrome is now in its sign bit
+                            acc = _mm256_xor_si256(acc, _mm256_and_si256(_mm256_cmpgt_epi8(zero, t_val), products[b]));
+                            t_val = _mm256_add_epi8(t_val, t_val);
+                        }
+                    s_val = acc;
+                }
+            _mm256_storeu_si256((__m256i*)(syndromes + first_root), s_val);
+            first_root += 32;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_x2_rs_syndromes_8u_neon(uint8_t* syndromes, const uint8_t* data, const uint8_t* root_products, unsigned int num_roots, unsigned int num_points)
+{
+    uint8x16_t products[8];
+    uint8x16_t bits[8];
+    uint8x16_t s_val, acc;
+    unsigned int first_root = 0;
+    unsigned int n;
+    unsigned int b;
+
+    if (num_roots < 16)
+        {
+            volk_gnsssdr_8u_x2_rs_syndromes_8u_generic(syndromes, data, root_products, num_roots, num_points);
+            return;
+        }
+
+    for (b = 0; b < 8; b++)
+        {
+            bits[b] = vdupq_n_u8((uint8_t)(1 << b));
+        }
+
+    while (first_root < num_roots)
+        {
+            // The last block overlaps the previous one instead of leaving a tail
+            if (first_root + 16 > num_roots)
+                {
+                    first_root = num_roots - 16;
+                }
+            for (b = 0; b < 8; b++)
+                {
+                    products[b] = vld1q_u8(root_products + b * num_roots + first_root);
+                }
+
+            s_val = vdupq_n_u8(0);
+            for (n = 0; n < num_points; n++)
+                {
+                    acc = vdupq_n_u8(data[n]);
+                    for (b = 0; b < 8; b++)
+                        {
+                            acc = veorq_u8(acc, vandq_u8(vtstq_u8(s_val, bits[b]), products[b]));
+                        }
+                    s_val = acc;
+                }
+            vst1q_u8(syndromes + first_root, s_val);
+            first_root += 16;
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_x2_rs_syndromes_8u_H */
@@ -932,4 +932,30 @@ static inline void volk_gnsssdr_s32f_sincos_32fc_neon(lv_32fc_t *out, const floa
 
 #endif /* LV_HAVE_NEON  */
 
+#ifdef LV_HAVE_SVE
+#include <volk_gnsssdr/volk_gnsssdr_sve_intrinsics.h>
+
+static inline void volk_gnsssdr_s32f_sincos_32fc_sve(lv_32fc_t *out, const float phase_inc, float *phase, unsigned int num_points)
+{
+    const unsigned int sve_step = (unsigned int)svcntw();
+    const float _phase = (*phase);
+    unsigned int number;
+    svbool_t pg;
+    svfloat32_t x;
+
+    // Phases are computed from the sample index instead of accumulated, so
+    // rounding errors do not grow along the vector
+    for (number = 0; number < num_points; number += sve_step)
+        {
+            pg = svwhilelt_b32_u32(number, num_points);
+            x = svcvt_f32_u32_x(pg, svindex_u32(number, 1));
+            x = svmad_n_f32_x(pg, x, svdup_n_f32(phase_inc), _phase);
+            svst2_f32(pg, (float *)(out + number), _svsincos_f32(pg, x));
+        }
+
+    (*phase) = _phase + phase_inc * (float)num_points;
+}
+
+#endif /* LV_HAVE_SVE  */
+
 #endif /* INCLUDED_volk_gnsssdr_s32f_sincos_32fc_H */
@@ -63,17 +63,22 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_multiply_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_s8ic_multiply_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8u_x2_multiply_8u, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8u_crc24q_32u, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_64f_accumulator_64f, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_sincos_32fc, test_params_inacc))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_index_max_32u, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_convert_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8i_x2_interleave_8ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_dot_prod_16ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_multiply_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_convert_32fc, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_conjugate_16ic, test_params_more_iters))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_s32f_sincospuppet_32fc, volk_gnsssdr_s32f_sincos_32fc, test_params_inacc2))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_rotatorpuppet_16ic, volk_gnsssdr_16ic_s32fc_x2_rotator_16ic, test_params_int1))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_s64f_rotatorpuppet_32fc, volk_gnsssdr_32fc_s64f_x2_rotator_32fc, test_params_inacc))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_viterbi27puppet_8u, volk_gnsssdr_32f_viterbi27_acs_8u, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastpuppet_16ic, volk_gnsssdr_16ic_resampler_fast_16ic, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastxnpuppet_16ic, volk_gnsssdr_16ic_xn_resampler_fast_16ic_xn, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerxnpuppet_16ic, volk_gnsssdr_16ic_xn_resampler_16ic_xn, test_params))
@@ -86,7 +91,16 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_16i_rotator_dotprodxnpuppet_16ic, volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn, test_params_int16))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_x2_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_s64f_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn, test_params_inacc));
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_high_dynamic_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_convertpuppet_32f, volk_gnsssdr_8u_convert_32f, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_8i, volk_gnsssdr_8u_unpack2bit_8i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_16i, volk_gnsssdr_8u_unpack2bit_16i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_32f, volk_gnsssdr_8u_unpack2bit_32f, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack4bitpuppet_8i, volk_gnsssdr_8u_unpack4bit_8i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_rs_syndromespuppet_8u, volk_gnsssdr_8u_x2_rs_syndromes_8u, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_index_max_statspuppet_32u, volk_gnsssdr_32f_index_max_stats_32u, test_params))
 
     return test_cases;
 }
@@ -36,6 +36,21 @@ int volk_gnsssdr_get_index(
 }
 
 
+static size_t volk_gnsssdr_get_arch_prefs(volk_gnsssdr_arch_pref_t **prefs)
+{
+    static volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
+    static size_t n_arch_prefs = 0;
+    static int prefs_loaded = 0;
+    if (!prefs_loaded)
+        {
+            n_arch_prefs = volk_gnsssdr_load_preferences(&volk_gnsssdr_arch_prefs);
+            prefs_loaded = 1;
+        }
+    *prefs = volk_gnsssdr_arch_prefs;
+    return n_arch_prefs;
+}
+
+
 int volk_gnsssdr_rank_archs(
     const char *kern_name,     // name of the kernel to rank
     const char *impl_names[],  // list of implementations by name
@@ -46,14 +61,8 @@ int volk_gnsssdr_rank_archs(
 )
 {
     size_t i;
-    static volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
-    static size_t n_arch_prefs = 0;
-    static int prefs_loaded = 0;
-    if (!prefs_loaded)
-        {
-            n_arch_prefs = volk_gnsssdr_load_preferences(&volk_gnsssdr_arch_prefs);
-            prefs_loaded = 1;
-        }
+    volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
+    const size_t n_arch_prefs = volk_gnsssdr_get_arch_prefs(&volk_gnsssdr_arch_prefs);
 
     // If we've defined VOLK_GENERIC to be anything, always return the
     // 'generic' kernel. Used in GR's QA code.
@@ -99,3 +108,59 @@ int volk_gnsssdr_rank_archs(
     // otherwise return the best unaligned
     return best_index_u;
 }
+
+
+size_t volk_gnsssdr_rank_archs_buckets(
+    const char *kern_name,     // name of the kernel to rank
+    const char *impl_names[],  // list of implementations by name
+    size_t n_impls,            // number of implementations available
+    unsigned int *max_points,  // upper vector length of each bucket, ascending
+    int *index_a,              // best aligned implementation of each bucket
+    int *index_u,              // best unaligned implementation of each bucket
+    size_t max_buckets         // capacity of the three arrays above
+)
+{
+    size_t i;
+    size_t j;
+    size_t n_buckets = 0;
+    const size_t name_len = strlen(kern_name);
+    volk_gnsssdr_arch_pref_t *volk_gnsssdr_arch_prefs;
+    const size_t n_arch_prefs = volk_gnsssdr_get_arch_prefs(&volk_gnsssdr_arch_prefs);
+
+    // VOLK_GENERIC overrides any profiling, buckets included
+    if (getenv("VOLK_GENERIC"))
+        {
+            return 0;
+        }
+
+    // bucket entries are named kernel_name:max_points
+    for (i = 0; i < n_arch_prefs && n_buckets < max_buckets; i++)
+        {
+            const char *pref_name = volk_gnsssdr_arch_prefs[i].name;
+            char *end = NULL;
+            unsigned long points;
+            if (strncmp(kern_name, pref_name, name_len) || pref_name[name_len] != ':')
+                {
+                    continue;
+                }
+            points = strtoul(pref_name + name_len + 1, &end, 10);
+            if (end == pref_name + name_len + 1 || *end != '\0' || points == 0)
+                {
+                    fprintf(stderr, "VOLK_GNSSSDR warning: ignoring malformed length bucket %s\n", pref_name);
+                    continue;
+                }
+
+            // insertion sort, the list is a handful of entries long
+            for (j = n_buckets; j > 0 && max_points[j - 1] > points; j--)
+                {
+                    max_points[j] = max_points[j - 1];
+                    index_a[j] = index_a[j - 1];
+                    index_u[j] = index_u[j - 1];
+                }
+            max_points[j] = (unsigned int)points;
+            index_a[j] = volk_gnsssdr_get_index(impl_names, n_impls, volk_gnsssdr_arch_prefs[i].impl_a);
+            index_u[j] = volk_gnsssdr_get_index(impl_names, n_impls, volk_gnsssdr_arch_prefs[i].impl_u);
+            n_buckets++;
+        }
+    return n_buckets;
+}
@@ -33,6 +33,23 @@ extern "C"
         const bool align           // if false, filter aligned implementations
     );
 
+    // Maximum number of vector length buckets per kernel
+#define VOLK_GNSSSDR_MAX_LENGTH_BUCKETS 8
+
+    // Fills the length buckets profiled for a kernel, sorted by ascending
+    // max_points, and returns how many were found. A call with num_points
+    // up to max_points[i] (and above max_points[i - 1]) is best served by
+    // index_a[i] / index_u[i]; longer calls use volk_gnsssdr_rank_archs.
+    size_t volk_gnsssdr_rank_archs_buckets(
+        const char *kern_name,     // name of the kernel to rank
+        const char *impl_names[],  // list of implementations by name
+        size_t n_impls,            // number of implementations available
+        unsigned int *max_points,  // upper vector length of each bucket, ascending
+        int *index_a,              // best aligned implementation of each bucket
+        int *index_u,              // best unaligned implementation of each bucket
+        size_t max_buckets         // capacity of the three arrays above
+    );
+
 #ifdef __cplusplus
 }
 #endif
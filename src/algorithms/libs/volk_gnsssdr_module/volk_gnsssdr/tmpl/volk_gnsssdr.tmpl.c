@@ -121,6 +121,13 @@ bool volk_gnsssdr_is_aligned(const void *ptr)
 #include <volk_gnsssdr/${kern.name}.h> //pulls in the dispatcher
 %endif
 
+%if kern.length_arg and not kern.has_dispatcher:
+static unsigned int ${kern.name}_bucket_points[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+static ${kern.pname} ${kern.name}_bucket_a[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+static ${kern.pname} ${kern.name}_bucket_u[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+static size_t ${kern.name}_n_buckets = 0;
+%endif
+
 static inline void __${kern.name}_d(${kern.arglist_full})
 {
     %if kern.has_dispatcher:
@@ -128,14 +135,29 @@ static inline void __${kern.name}_d(${kern.arglist_full})
     return;
     %endif
 
-    if (volk_gnsssdr_is_aligned(<% num_open_parens = 0 %>
+    const bool aligned = volk_gnsssdr_is_aligned(<% num_open_parens = 0 %>
     %for arg_type, arg_name in kern.args:
         %if '*' in arg_type:
         VOLK_OR_PTR(${arg_name},<% num_open_parens += 1 %>
         %endif
     %endfor
         0<% end_open_parens = ')'*num_open_parens %>${end_open_parens}
-    )){
+    );
+    %if kern.length_arg and not kern.has_dispatcher:
+    size_t bucket;
+    for (bucket = 0; bucket < ${kern.name}_n_buckets; bucket++)
+        {
+            if (${kern.length_arg} <= ${kern.name}_bucket_points[bucket])
+                {
+                    if (aligned)
+                        ${kern.name}_bucket_a[bucket](${kern.arglist_names});
+                    else
+                        ${kern.name}_bucket_u[bucket](${kern.arglist_names});
+                    return;
+                }
+        }
+    %endif
+    if (aligned){
         ${kern.name}_a(${kern.arglist_names});
     }
     else{
@@ -157,6 +179,22 @@ static inline void __init_${kern.name}(void)
 
     assert(${kern.name}_a);
     assert(${kern.name}_u);
+    %if kern.length_arg and not kern.has_dispatcher:
+
+    unsigned int bucket_points[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+    int bucket_index_a[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+    int bucket_index_u[VOLK_GNSSSDR_MAX_LENGTH_BUCKETS];
+    const size_t n_buckets = volk_gnsssdr_rank_archs_buckets(name, impl_names, n_impls,
+        bucket_points, bucket_index_a, bucket_index_u, VOLK_GNSSSDR_MAX_LENGTH_BUCKETS);
+    size_t bucket;
+    for (bucket = 0; bucket < n_buckets; bucket++)
+        {
+            ${kern.name}_bucket_points[bucket] = bucket_points[bucket];
+            ${kern.name}_bucket_a[bucket] = get_machine()->${kern.name}_impls[bucket_index_a[bucket]];
+            ${kern.name}_bucket_u[bucket] = get_machine()->${kern.name}_impls[bucket_index_u[bucket]];
+        }
+    ${kern.name}_n_buckets = n_buckets;
+    %endif
 
     ${kern.name} = &__${kern.name}_d;
 }
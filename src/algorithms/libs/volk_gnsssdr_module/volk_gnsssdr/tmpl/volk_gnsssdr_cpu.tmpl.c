@@ -34,8 +34,22 @@ using namespace cpu_features;
 #endif
 #endif
 
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/prctl.h>
+#endif
+
 struct VOLK_CPU volk_gnsssdr_cpu;
 
+unsigned int volk_gnsssdr_get_sve_vector_length() {
+#if defined(__aarch64__) && defined(__linux__) && defined(PR_SVE_GET_VL)
+    const int vl = prctl(PR_SVE_GET_VL);
+    if (vl < 0){ return 0; }
+    return (unsigned int)(vl & PR_SVE_VL_LEN_MASK);
+#else
+    return 0;
+#endif
+}
+
 // clang-format off
 
 %for arch in archs:
@@ -44,6 +58,12 @@ static int i_can_has_${arch.name} (void) {
       %if "neon" in arch.name:
 #if defined(CPU_FEATURES_ARCH_ARM)
     if (GetArmInfo().features.${check} == 0){ return 0; }
+#endif
+      %elif "sve" in arch.name:
+#if defined(CPU_FEATURES_ARCH_AARCH64)
+    if (GetAarch64Info().features.${check} == 0){ return 0; }
+    // SVE kernels are only worth it if vectors are wider than NEON ones
+    if (volk_gnsssdr_get_sve_vector_length() <= 16){ return 0; }
 #endif
     %else:
 #if defined(CPU_FEATURES_ARCH_X86)
@@ -27,6 +27,9 @@ extern struct VOLK_CPU volk_gnsssdr_cpu;
 void volk_gnsssdr_cpu_init();
 unsigned int volk_gnsssdr_get_lvarch();
 
+// Returns the SVE vector length in bytes, or 0 if SVE is not available
+unsigned int volk_gnsssdr_get_sve_vector_length();
+
 __VOLK_DECL_END
 
 #endif /* INCLUDED_VOLK_GNSSSDR_CPU_H */
@@ -195,6 +195,47 @@ static int has_neonv8(void)
 #endif
 }
 
+// SVE vector length in bytes, or 0 if SVE is not available
+#if defined(VOLK_CPU_ARMV8)
+#include <sys/prctl.h>
+#endif
+
+unsigned int volk_gnsssdr_get_sve_vector_length()
+{
+#if defined(VOLK_CPU_ARMV8) && defined(PR_SVE_GET_VL)
+    const int vl = prctl(PR_SVE_GET_VL);
+    if (vl < 0) return 0;
+    return (unsigned int)(vl & PR_SVE_VL_LEN_MASK);
+#else
+    return 0;
+#endif
+}
+
+// SVE kernels are only worth it if vectors are wider than NEON ones
+static int has_sve(void)
+{
+#if defined(VOLK_CPU_ARMV8) && defined(HWCAP_SVE)
+    FILE *auxvec_f;
+    unsigned long auxvec[2];
+    unsigned int found_sve = 0;
+    auxvec_f = fopen("/proc/self/auxv", "rb");
+    if (!auxvec_f) return 0;
+
+    size_t r = 1;
+    while (!found_sve && r)
+        {
+            r = fread(auxvec, sizeof(unsigned long), 2, auxvec_f);
+            if ((auxvec[0] == AT_HWCAP) && (auxvec[1] & HWCAP_SVE))
+                found_sve = 1;
+        }
+
+    fclose(auxvec_f);
+    return found_sve && (volk_gnsssdr_get_sve_vector_length() > 16);
+#else
+    return 0;
+#endif
+}
+
 static int has_neon(void)
 {
 #if defined(VOLK_CPU_ARMV8) || defined(VOLK_CPU_ARMV7)
@@ -39,7 +39,9 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
     conf.nchannels_in = in_streams_;
     conf.nchannels_out = out_streams_;
     conf.observable_interval_ms = configuration->property("GNSS-SDR.observable_interval_ms", conf.observable_interval_ms);
+    conf.threads = configuration->property(role + ".threads", conf.threads);
     conf.enable_carrier_smoothing = configuration->property(role + ".enable_carrier_smoothing", conf.enable_carrier_smoothing);
+    conf.divergence_free_smoothing = configuration->property(role + ".divergence_free_smoothing", conf.divergence_free_smoothing);
     conf.always_output_gs = configuration->property("PVT.an_output_enabled", conf.always_output_gs) || configuration->property(role + ".always_output_gs", conf.always_output_gs);
 
     if (FLAGS_carrier_smoothing_factor == DEFAULT_CARRIER_SMOOTHING_FACTOR)
@@ -50,6 +52,10 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
     if (conf.enable_carrier_smoothing == true)
         {
             LOG(INFO) << "Observables carrier smoothing enabled with smoothing factor " << conf.smoothing_factor;
+            if (conf.divergence_free_smoothing == true)
+                {
+                    LOG(INFO) << "Observables carrier smoothing uses the divergence-free combination of the satellites tracked in two or more frequencies";
+                }
         }
     observables_ = hybrid_observables_gs_make(conf);
     DLOG(INFO) << "Observables block ID (" << observables_->unique_id() << ")";
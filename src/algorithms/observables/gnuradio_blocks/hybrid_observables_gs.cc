@@ -17,22 +17,26 @@
 
 #include "hybrid_observables_gs.h"
 #include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
-#include "gnss_circular_deque.h"
-#include "gnss_frequencies.h"
+#include "gnss_sdr_block_stats.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_trace.h"
 #include "gnss_synchro.h"
+#include "obs_carrier_smoothing.h"
+#include "obs_history.h"
+#include "obs_shard_pool.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
-#include <algorithm>  // for std::min
+#include <algorithm>  // for std::min, std::upper_bound
 #include <array>
+#include <atomic>
 #include <cmath>      // for round
-#include <cstdlib>    // for size_t, llabs
+#include <cstdlib>    // for size_t
 #include <exception>  // for exception
+#include <fstream>    // for std::ifstream
 #include <iostream>   // for cerr, cout
-#include <limits>     // for numeric_limits
 #include <utility>    // for move
 
 #if PMT_USES_BOOST_ANY
@@ -61,9 +65,10 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
           gr::io_signature::make(conf_.nchannels_out, conf_.nchannels_out, sizeof(Gnss_Synchro))),
       d_conf(conf_),
       d_dump_filename(conf_.dump_filename),
-      d_smooth_filter_M(static_cast<double>(conf_.smoothing_factor)),
       d_T_rx_step_s(static_cast<double>(conf_.observable_interval_ms) / 1000.0),
       d_last_rx_clock_round20ms_error(0.0),
+      d_rx_clock_fs(0.0),
+      d_last_rx_clock(0ULL),
       d_T_rx_TOW_ms(0U),
       d_T_rx_step_ms(conf_.observable_interval_ms),
       d_T_status_report_timer_ms(0),
@@ -74,6 +79,8 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
       d_dump(conf_.dump),
       d_dump_mat(conf_.dump_mat && d_dump)
 {
+    d_work_stats = Gnss_Block_Stats_Registry::instance().make(unique_id());
+
     // PVT input message port
     this->message_port_register_in(pmt::mp("pvt_to_observables"));
     this->set_msg_handler(pmt::mp("pvt_to_observables"),
@@ -90,30 +97,24 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
     // Send Channel status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
 
-    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro>>(1000, d_nchannels_out);
+    d_gnss_synchro_history = std::make_unique<Obs_History>(1000, d_nchannels_out);
 
     d_Rx_clock_buffer.set_capacity(std::min(std::max(200U / d_T_rx_step_ms, 3U), 10U));
     d_Rx_clock_buffer.clear();
 
-    d_channel_last_pll_lock = std::vector<bool>(d_nchannels_out, false);
-    d_channel_last_pseudorange_smooth = std::vector<double>(d_nchannels_out, 0.0);
-    d_channel_last_carrier_phase_rads = std::vector<double>(d_nchannels_out, 0.0);
+    if (d_conf.threads > 1)
+        {
+            d_shard_pool = std::make_unique<Obs_Shard_Pool>(d_conf.threads, d_nchannels_out);
+        }
+
+    if (d_conf.enable_carrier_smoothing)
+        {
+            d_carrier_smoothing = std::make_unique<Obs_Carrier_Smoothing>(d_nchannels_out, static_cast<double>(d_conf.smoothing_factor), d_conf.divergence_free_smoothing);
+        }
 
-    d_mapStringValues["1C"] = evGPS_1C;
-    d_mapStringValues["2S"] = evGPS_2S;
-    d_mapStringValues["L5"] = evGPS_L5;
-    d_mapStringValues["1B"] = evGAL_1B;
-    d_mapStringValues["5X"] = evGAL_5X;
-    d_mapStringValues["E6"] = evGAL_E6;
-    d_mapStringValues["7X"] = evGAL_7X;
-    d_mapStringValues["1G"] = evGLO_1G;
-    d_mapStringValues["2G"] = evGLO_2G;
-    d_mapStringValues["B1"] = evBDS_B1;
-    d_mapStringValues["B2"] = evBDS_B2;
-    d_mapStringValues["B3"] = evBDS_B3;
 
 
-    d_SourceTagTimestamps = std::vector<std::queue<GnssTime>>(d_nchannels_out);
+    d_TimeChannelTagTimestamps.set_capacity(1000);
 
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
 
@@ -149,16 +150,20 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
                     std::cerr << "GNSS-SDR cannot create dump file for the Observables block. Wrong permissions?\n";
                     d_dump = false;
                 }
-            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-            try
-                {
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                    LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
-                }
-            catch (const std::ifstream::failure &e)
+            if (d_dump)
                 {
-                    LOG(WARNING) << "Exception opening observables dump file " << e.what();
-                    d_dump = false;
+                    // one record per epoch, with seven values per channel
+                    d_dump_record = std::vector<double>(7 * d_nchannels_out);
+                    d_dump_stream = Gnss_Sdr_Dump_Writer::instance().open(d_dump_filename, d_dump_record.size() * sizeof(double));
+                    if (d_dump_stream)
+                        {
+                            LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename;
+                        }
+                    else
+                        {
+                            LOG(WARNING) << "Cannot open the observables dump file " << d_dump_filename;
+                            d_dump = false;
+                        }
                 }
         }
 }
@@ -167,17 +172,9 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
 hybrid_observables_gs::~hybrid_observables_gs()
 {
     DLOG(INFO) << "Observables block destructor called.";
-    if (d_dump_file.is_open())
+    if (d_dump_stream)
         {
-            const auto pos = d_dump_file.tellp();
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            const auto pos = d_dump_stream->close();
             if (pos == 0)
                 {
                     errorlib::error_code ec;
@@ -377,97 +374,28 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 }
 
 
-bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
+void hybrid_observables_gs::push_observables(const Gnss_Synchro **in, const gr_vector_int &ninput_items, uint32_t first_ch, uint32_t last_ch)
 {
-    int32_t nearest_element = -1;
-    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    for (uint32_t n = first_ch; n < last_ch; n++)
         {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
-                {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
-                }
-        }
-
-    if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
-        {
-            if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs)) < d_T_rx_step_s)
+            for (int32_t m = 0; m < ninput_items[n]; m++)
                 {
-                    int32_t neighbor_element;
-                    if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                        {
-                            neighbor_element = nearest_element + 1;
-                        }
-                    else
-                        {
-                            neighbor_element = nearest_element - 1;
-                        }
-                    if (neighbor_element < static_cast<int32_t>(d_gnss_synchro_history->size(ch)) and neighbor_element >= 0)
+                    // Push the valid tracking Gnss_Synchros to their corresponding deque
+                    if (in[n][m].Flag_valid_word)
                         {
-                            int32_t t1_idx;
-                            int32_t t2_idx;
-                            if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                                {
-                                    // std::cout << "S1= " << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter << '\n';
-                                    t1_idx = nearest_element;
-                                    t2_idx = neighbor_element;
-                                }
-                            else
-                                {
-                                    // std::cout << "inv S1= " << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter << '\n';
-                                    t1_idx = neighbor_element;
-                                    t2_idx = nearest_element;
-                                }
-
-                            // 1st: copy the nearest gnss_synchro data for that channel
-                            interpolated_obs = d_gnss_synchro_history->get(ch, nearest_element);
-
-                            // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
-                            const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
-
-                            const double time_factor = (T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time) /
-                                                       (d_gnss_synchro_history->get(ch, t2_idx).RX_time -
-                                                           d_gnss_synchro_history->get(ch, t1_idx).RX_time);
-
-                            // CARRIER PHASE INTERPOLATION
-                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads) * time_factor;
-                            // CARRIER DOPPLER INTERPOLATION
-                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_Doppler_hz - d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz) * time_factor;
-                            // TOW INTERPOLATION
-                            // check TOW rollover
-                            if ((d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms - d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) > 0)
-                                {
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                                }
-                            else
+                            if (d_gnss_synchro_history->size(n) > 0)
                                 {
-                                    // TOW rollover situation
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms + 604800000) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
+                                    // Check if the last Gnss_Synchro comes from the same satellite as the previous ones
+                                    if (d_gnss_synchro_history->front(n).PRN != in[n][m].PRN)
+                                        {
+                                            d_gnss_synchro_history->clear(n);
+                                            // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
+                                        }
                                 }
-
-                            // LOG(INFO) << "Channel " << ch << " int idx: " << t1_idx << " TOW Int: " << interpolated_obs.interp_TOW_ms
-                            //           << " TOW p1 : " << d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms
-                            //           << " TOW p2: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms
-                            //           << " t2-t1: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).RX_time - d_gnss_synchro_history->get(ch, t1_idx).RX_time
-                            //           << " trx - t1: "
-                            //           << T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time;
-                            // std::cout << "Rx samplestamp: " << T_rx_s << " Channel " << ch << " interp buff idx " << nearest_element
-                            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-                            return true;
+                            d_gnss_synchro_history->push_back(n, in[n][m], compute_T_rx_s(in[n][m]));
                         }
-                    return false;
                 }
-            // std::cout << "ALERT: Channel " << ch << " interp buff idx " << nearest_element
-            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-            // usleep(1000);
         }
-    return false;
 }
 
 
@@ -482,7 +410,7 @@ void hybrid_observables_gs::forecast(int noutput_items __attribute__((unused)),
 }
 
 
-void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data)
+void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data, uint32_t rx_clock_steps)
 {
     // 1. Set the TOW using the minimum TOW in the observables.
     //    this will be the receiver time.
@@ -513,7 +441,7 @@ void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data)
         }
     else
         {
-            d_T_rx_TOW_ms += d_T_rx_step_ms;  // the tow time step increment must match the ref time channel step
+            d_T_rx_TOW_ms += d_T_rx_step_ms * rx_clock_steps;  // the tow time step increment must match the ref time channel step
             if (d_T_rx_TOW_ms >= 604800000)
                 {
                     DLOG(INFO) << "TOW RX TIME rollover!";
@@ -554,76 +482,6 @@ void hybrid_observables_gs::compute_pranges(std::vector<Gnss_Synchro> &data) con
 }
 
 
-void hybrid_observables_gs::smooth_pseudoranges(std::vector<Gnss_Synchro> &data)
-{
-    std::vector<Gnss_Synchro>::iterator it;
-    for (it = data.begin(); it != data.end(); it++)
-        {
-            if (it->Flag_valid_pseudorange)
-                {
-                    // 0. get wavelength for the current signal
-                    double wavelength_m = 0;
-                    switch (d_mapStringValues[it->Signal])
-                        {
-                        case evGPS_1C:
-                        case evSBAS_1C:
-                        case evGAL_1B:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
-                            break;
-                        case evGPS_L5:
-                        case evGAL_5X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ5;
-                            break;
-                        case evGAL_E6:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ6;
-                            break;
-                        case evGAL_7X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ7;
-                            break;
-                        case evGPS_2S:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2;
-                            break;
-                        case evBDS_B3:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
-                            break;
-                        case evGLO_1G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
-                            break;
-                        case evGLO_2G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
-                            break;
-                        case evBDS_B1:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
-                            break;
-                        case evBDS_B2:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
-                            break;
-                        default:
-                            break;
-                        }
-
-                    // todo: propagate the PLL lock status in Gnss_Synchro
-                    // 1. check if last PLL lock status was false and initialize last d_channel_last_pseudorange_smooth
-                    if (d_channel_last_pll_lock[it->Channel_ID] == true)
-                        {
-                            // 2. Compute the smoothed pseudorange for this channel
-                            // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
-                            const double r_sm = d_channel_last_pseudorange_smooth[it->Channel_ID];
-                            const double factor = ((d_smooth_filter_M - 1.0) / d_smooth_filter_M);
-                            it->Pseudorange_m = factor * r_sm + (1.0 / d_smooth_filter_M) * it->Pseudorange_m + wavelength_m * (factor / TWO_PI) * (it->Carrier_phase_rads - d_channel_last_carrier_phase_rads[it->Channel_ID]);
-                        }
-                    d_channel_last_pseudorange_smooth[it->Channel_ID] = it->Pseudorange_m;
-                    d_channel_last_carrier_phase_rads[it->Channel_ID] = it->Carrier_phase_rads;
-                    d_channel_last_pll_lock[it->Channel_ID] = it->Flag_valid_pseudorange;
-                }
-            else
-                {
-                    d_channel_last_pll_lock[it->Channel_ID] = false;
-                }
-        }
-}
-
-
 void hybrid_observables_gs::set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro> &data, uint64_t rx_clock)
 {
     // it transforms the HW sample tag timestamp from a relative samplestamp (from receiver start)
@@ -641,18 +499,29 @@ void hybrid_observables_gs::set_tag_timestamp_in_sdr_timeframe(const std::vector
                         }
                 }
 
-            double delta_rxtime_to_tag;
+            // tags older than 0.1 s are dropped, and the next one is used if
+            // it is not in the future. Tags are sorted by rx_time, so the
+            // first recent tag is found by a binary search.
+            const double rx_time_s = static_cast<double>(rx_clock) / fs;
+            const auto first_recent = std::upper_bound(d_TimeChannelTagTimestamps.begin(), d_TimeChannelTagTimestamps.end(), rx_time_s - 0.1,
+                [](double t, const GnssTime &tag) { return t < tag.rx_time; });
+            const auto n_old = static_cast<size_t>(first_recent - d_TimeChannelTagTimestamps.begin());
             GnssTime current_tag;
-            do
+            if (n_old < d_TimeChannelTagTimestamps.size())
                 {
-                    current_tag = d_TimeChannelTagTimestamps.front();
-                    delta_rxtime_to_tag = (static_cast<double>(rx_clock) / fs) - current_tag.rx_time;  // delta time relative to receiver's start time
-                    if (delta_rxtime_to_tag >= 0)
+                    current_tag = *first_recent;
+                    d_TimeChannelTagTimestamps.erase_begin(n_old);
+                    if (rx_time_s - current_tag.rx_time >= 0)
                         {
-                            d_TimeChannelTagTimestamps.pop();
+                            d_TimeChannelTagTimestamps.pop_front();
                         }
                 }
-            while (delta_rxtime_to_tag >= 0.1 and !d_TimeChannelTagTimestamps.empty());
+            else
+                {
+                    current_tag = d_TimeChannelTagTimestamps.back();
+                    d_TimeChannelTagTimestamps.clear();
+                }
+            const double delta_rxtime_to_tag = rx_time_s - current_tag.rx_time;  // delta time relative to receiver's start time
 
             if (delta_rxtime_to_tag >= 0 and delta_rxtime_to_tag <= 0.1)
                 {
@@ -677,6 +546,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
+    const Gnss_Block_Work_Timer work_timer(d_work_stats.get());
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
 
@@ -685,6 +555,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
     if (ninput_items[d_nchannels_in - 1] > 0)
         {
             d_Rx_clock_buffer.push_back(in[d_nchannels_in - 1][0].Tracking_sample_counter);
+            d_rx_clock_fs = static_cast<double>(in[d_nchannels_in - 1][0].fs);
 
             // time tags
             std::vector<gr::tag_t> tags_vec;
@@ -697,7 +568,12 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                                 {
                                     const auto timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
                                     // std::cout << "[Time ch ] timetag: " << timetag->rx_time << "\n";
-                                    d_TimeChannelTagTimestamps.push(*timetag);
+                                    if (!d_TimeChannelTagTimestamps.empty() && timetag->rx_time < d_TimeChannelTagTimestamps.back().rx_time)
+                                        {
+                                            // the time source went back, the older tags are no longer valid
+                                            d_TimeChannelTagTimestamps.clear();
+                                        }
+                                    d_TimeChannelTagTimestamps.push_back(*timetag);
                                 }
                             else
                                 {
@@ -715,6 +591,14 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
         }
 
     // Push the tracking observables into buffers to allow the observable interpolation at the desired Rx clock
+    if (d_shard_pool)
+        {
+            d_shard_pool->run([&](uint32_t first_ch, uint32_t last_ch) { push_observables(in, ninput_items, first_ch, last_ch); });
+        }
+    else
+        {
+            push_observables(in, ninput_items, 0, d_nchannels_out);
+        }
     for (uint32_t n = 0; n < d_nchannels_out; n++)
         {
             //**************** time tags ****************
@@ -728,7 +612,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             //                                {
             //                                    const std::shared_ptr<GnssTime> timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it->value));
             //                                    //std::cout << "[ch " << n << "] timetag: " << timetag->rx_time << "\n";
-            //                                    d_SourceTagTimestamps.at(n).push(*timetag);
+            //                                    d_TimeChannelTagTimestamps.push_back(*timetag);
             //                                }
             //                            else
             //                                {
@@ -742,24 +626,6 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             //                }
 
             //************* end time tags **************
-            for (int32_t m = 0; m < ninput_items[n]; m++)
-                {
-                    // Push the valid tracking Gnss_Synchros to their corresponding deque
-                    if (in[n][m].Flag_valid_word)
-                        {
-                            if (d_gnss_synchro_history->size(n) > 0)
-                                {
-                                    // Check if the last Gnss_Synchro comes from the same satellite as the previous ones
-                                    if (d_gnss_synchro_history->front(n).PRN != in[n][m].PRN)
-                                        {
-                                            d_gnss_synchro_history->clear(n);
-                                            // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
-                                        }
-                                }
-                            d_gnss_synchro_history->push_back(n, in[n][m]);
-                            d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
-                        }
-                }
             consume(n, ninput_items[n]);
         }
 
@@ -767,35 +633,46 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
         {
             std::vector<Gnss_Synchro> epoch_data(d_nchannels_out);
             int32_t n_valid = 0;
-            for (uint32_t n = 0; n < d_nchannels_out; n++)
-                {
-                    Gnss_Synchro interpolated_gnss_synchro{};
-                    if (!interp_trk_obs(interpolated_gnss_synchro, n, d_Rx_clock_buffer.front()))
+            {
+                GNSS_SDR_TRACE_ZONE("interp_trk_obs");
+                if (d_shard_pool)
+                    {
+                        std::atomic<int32_t> shards_valid{0};
+                        d_shard_pool->run([&](uint32_t first_ch, uint32_t last_ch) {
+                            shards_valid += d_gnss_synchro_history->interpolate(d_Rx_clock_buffer.front(), d_T_rx_step_s, epoch_data, first_ch, last_ch);
+                        });
+                        n_valid = shards_valid;
+                    }
+                else
+                    {
+                        n_valid = d_gnss_synchro_history->interpolate(d_Rx_clock_buffer.front(), d_T_rx_step_s, epoch_data);
+                    }
+            }
+
+            // The sample counter skips whole epochs over the samples lost by
+            // the signal source (sample_gap tags), so the receiver time
+            // advances by as many steps
+            uint32_t rx_clock_steps = 1;
+            const double rx_clock_step_samples = d_rx_clock_fs * d_T_rx_step_s;
+            if (d_last_rx_clock > 0 && rx_clock_step_samples > 0.0 && d_Rx_clock_buffer.front() > d_last_rx_clock)
+                {
+                    rx_clock_steps = std::max(1U, static_cast<uint32_t>(std::round(static_cast<double>(d_Rx_clock_buffer.front() - d_last_rx_clock) / rx_clock_step_samples)));
+                    if (rx_clock_steps > 1)
                         {
-                            // Produce an empty observation
-                            interpolated_gnss_synchro = Gnss_Synchro();
-                            interpolated_gnss_synchro.Flag_valid_pseudorange = false;
-                            interpolated_gnss_synchro.Flag_valid_word = false;
-                            interpolated_gnss_synchro.Flag_valid_acquisition = false;
-                            interpolated_gnss_synchro.fs = 0;
-                            interpolated_gnss_synchro.Channel_ID = n;
+                            LOG(INFO) << "Receiver clock skipped " << rx_clock_steps - 1 << " epochs over a gap in the input samples";
                         }
-                    else
-                        {
-                            n_valid++;
-                        }
-                    epoch_data[n] = interpolated_gnss_synchro;
                 }
+            d_last_rx_clock = d_Rx_clock_buffer.front();
 
             if (d_T_rx_TOW_set)
                 {
-                    update_TOW(epoch_data);
+                    update_TOW(epoch_data, rx_clock_steps);
                 }
             else
                 {
                     if (n_valid > 0)
                         {
-                            update_TOW(epoch_data);
+                            update_TOW(epoch_data, rx_clock_steps);
                         }
                 }
 
@@ -806,9 +683,9 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                 }
 
             // Carrier smoothing (optional)
-            if (d_conf.enable_carrier_smoothing == true)
+            if (d_carrier_smoothing)
                 {
-                    smooth_pseudoranges(epoch_data);
+                    d_carrier_smoothing->smooth(epoch_data);
                 }
 
             // output the observables set to the PVT block
@@ -832,32 +709,18 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             if (d_dump)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
+                    double *record = d_dump_record.data();
+                    for (uint32_t i = 0; i < d_nchannels_out; i++)
                         {
-                            double tmp_double;
-                            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                                {
-                                    tmp_double = out[i][0].RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].interp_TOW_ms / 1000.0;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_Doppler_hz;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_phase_rads / TWO_PI;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Pseudorange_m;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].PRN);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].Flag_valid_pseudorange);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                }
-                        }
-                    catch (const std::ifstream::failure &e)
-                        {
-                            LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                            d_dump = false;
+                            *record++ = out[i][0].RX_time;
+                            *record++ = out[i][0].interp_TOW_ms / 1000.0;
+                            *record++ = out[i][0].Carrier_Doppler_hz;
+                            *record++ = out[i][0].Carrier_phase_rads / TWO_PI;
+                            *record++ = out[i][0].Pseudorange_m;
+                            *record++ = static_cast<double>(out[i][0].PRN);
+                            *record++ = static_cast<double>(out[i][0].Flag_valid_pseudorange);
                         }
+                    d_dump_stream->append(d_dump_record.data());
                 }
 
             if (n_valid > 0)
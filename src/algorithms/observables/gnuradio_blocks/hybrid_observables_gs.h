@@ -21,6 +21,7 @@
 #define GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_dump_writer.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
 #include "obs_conf.h"
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
@@ -28,13 +29,10 @@
 #include <gnuradio/types.h>           // for gr_vector_int
 #include <cstddef>                    // for size_t
 #include <cstdint>                    // for int32_t
-#include <fstream>                    // for std::ofstream
-#include <map>                        // for std::map
 #include <memory>                     // for std::shared, std:unique_ptr
-#include <queue>
-#include <string>    // for std::string
-#include <typeinfo>  // for typeid
-#include <vector>    // for std::vector
+#include <string>                     // for std::string
+#include <typeinfo>                   // for typeid
+#include <vector>                     // for std::vector
 
 /** \addtogroup Observables
  * \{ */
@@ -43,12 +41,13 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
+class Obs_Carrier_Smoothing;
+class Obs_History;
+class Obs_Shard_Pool;
 class hybrid_observables_gs;
 
-template <class T>
-class Gnss_circular_deque;
-
 using hybrid_observables_gs_sptr = gnss_shared_ptr<hybrid_observables_gs>;
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf& conf_);
@@ -73,52 +72,34 @@ private:
 
     void msg_handler_pvt_to_observables(const pmt::pmt_t& msg);
     double compute_T_rx_s(const Gnss_Synchro& a) const;
-    bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock) const;
-    void update_TOW(const std::vector<Gnss_Synchro>& data);
+    void update_TOW(const std::vector<Gnss_Synchro>& data, uint32_t rx_clock_steps);
     void compute_pranges(std::vector<Gnss_Synchro>& data) const;
-    void smooth_pseudoranges(std::vector<Gnss_Synchro>& data);
+    void push_observables(const Gnss_Synchro** in, const gr_vector_int& ninput_items, uint32_t first_ch, uint32_t last_ch);
 
     void set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro>& data, uint64_t rx_clock);
     int32_t save_matfile() const;
 
     Obs_Conf d_conf;
 
-    enum StringValue_
-    {
-        evGPS_1C,
-        evGPS_2S,
-        evGPS_L5,
-        evSBAS_1C,
-        evGAL_1B,
-        evGAL_5X,
-        evGAL_E6,
-        evGAL_7X,
-        evGLO_1G,
-        evGLO_2G,
-        evBDS_B1,
-        evBDS_B2,
-        evBDS_B3
-    };
-    std::map<std::string, StringValue_> d_mapStringValues;
-
-    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro>> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Obs_History> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Obs_Carrier_Smoothing> d_carrier_smoothing;
+    std::unique_ptr<Obs_Shard_Pool> d_shard_pool;  // channel groups computed in parallel, if any
+    std::shared_ptr<Gnss_Block_Stats> d_work_stats;
 
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;  // time history
 
-    std::vector<std::queue<GnssTime>> d_SourceTagTimestamps;
-    std::queue<GnssTime> d_TimeChannelTagTimestamps;
-
-    std::vector<bool> d_channel_last_pll_lock;
-    std::vector<double> d_channel_last_pseudorange_smooth;
-    std::vector<double> d_channel_last_carrier_phase_rads;
+    boost::circular_buffer<GnssTime> d_TimeChannelTagTimestamps;  // time tags of the clock channel, sorted by rx_time
 
     std::string d_dump_filename;
 
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
+    std::vector<double> d_dump_record;
 
-    double d_smooth_filter_M;
     double d_T_rx_step_s;
     double d_last_rx_clock_round20ms_error;
+    double d_rx_clock_fs;
+
+    uint64_t d_last_rx_clock;  // receiver clock of the last epoch
 
     uint32_t d_T_rx_TOW_ms;
     uint32_t d_T_rx_step_ms;
@@ -0,0 +1,193 @@
+/*!
+ * \file obs_carrier_smoothing.cc
+ * \brief Carrier smoothing (Hatch filter) of the pseudoranges of all the
+ * channels of an epoch
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_carrier_smoothing.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
+#include "gnss_frequencies.h"
+#include <algorithm>  // for std::min
+
+
+namespace
+{
+inline uint32_t satellite_key(const Gnss_Synchro& obs)
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(obs.System)) << 24) | (obs.PRN & 0xFFFFFFU);
+}
+}  // namespace
+
+
+Obs_Carrier_Smoothing::Obs_Carrier_Smoothing(uint32_t nchannels, double smoothing_factor, bool divergence_free)
+    : d_pseudorange_m(nchannels, 0.0),
+      d_raw_phase_m(nchannels, 0.0),
+      d_phase_m(nchannels, 0.0),
+      d_keep(nchannels, 0.0),
+      d_frequency_hz(nchannels, 0.0),
+      d_partner(nchannels, -1),
+      d_valid(nchannels, 0),
+      d_last_smooth_m(nchannels, 0.0),
+      d_last_phase_m(nchannels, 0.0),
+      d_last_satellite(nchannels, 0),
+      d_last_partner(nchannels, -1),
+      d_lock(nchannels, 0),
+      d_factor((smoothing_factor - 1.0) / smoothing_factor),
+      d_weight(1.0 / smoothing_factor),
+      d_nchannels(nchannels),
+      d_divergence_free(divergence_free)
+{
+}
+
+
+double Obs_Carrier_Smoothing::carrier_frequency_hz(const Gnss_Synchro& obs)
+{
+    const char s0 = obs.Signal[0];
+    const char s1 = obs.Signal[1];
+    switch (s0)
+        {
+        case '1':
+            switch (s1)
+                {
+                case 'C':  // GPS L1 C/A, SBAS L1
+                case 'B':  // Galileo E1b
+                    return FREQ1;
+                case 'G':
+                    return FREQ1_GLO;
+                default:
+                    return 0.0;
+                }
+        case '2':
+            switch (s1)
+                {
+                case 'S':
+                    return FREQ2;
+                case 'G':
+                    return FREQ2_GLO;
+                default:
+                    return 0.0;
+                }
+        case 'L':
+            return s1 == '5' ? FREQ5 : 0.0;
+        case '5':
+            return s1 == 'X' ? FREQ5 : 0.0;
+        case 'E':
+            return s1 == '6' ? FREQ6 : 0.0;
+        case '7':
+            return s1 == 'X' ? FREQ7 : 0.0;
+        case 'B':
+            switch (s1)
+                {
+                case '1':
+                    return FREQ1_BDS;
+                case '2':
+                    return FREQ2_BDS;
+                case '3':
+                    return FREQ3_BDS;
+                default:
+                    return 0.0;
+                }
+        default:
+            return 0.0;
+        }
+}
+
+
+void Obs_Carrier_Smoothing::find_partners(const std::vector<Gnss_Synchro>& epoch, uint32_t n)
+{
+    d_satellites.clear();
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            if (d_valid[ch] && d_frequency_hz[ch] > 0.0)
+                {
+                    const auto result = d_satellites.emplace(satellite_key(epoch[ch]), Satellite{static_cast<int32_t>(ch), -1});
+                    Satellite& sat = result.first->second;
+                    if (!result.second && sat.other < 0 && d_frequency_hz[ch] != d_frequency_hz[sat.first])
+                        {
+                            sat.other = static_cast<int32_t>(ch);
+                        }
+                }
+        }
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            d_partner[ch] = -1;
+            if (d_valid[ch] && d_frequency_hz[ch] > 0.0)
+                {
+                    const Satellite& sat = d_satellites.find(satellite_key(epoch[ch]))->second;
+                    d_partner[ch] = d_frequency_hz[ch] != d_frequency_hz[sat.first] ? sat.first : sat.other;
+                }
+        }
+}
+
+
+void Obs_Carrier_Smoothing::smooth(std::vector<Gnss_Synchro>& epoch)
+{
+    const uint32_t n = std::min(static_cast<uint32_t>(epoch.size()), d_nchannels);
+
+    // 1. gather the pseudoranges and the carrier phases in meters
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            const Gnss_Synchro& obs = epoch[ch];
+            d_valid[ch] = obs.Flag_valid_pseudorange ? 1 : 0;
+            d_frequency_hz[ch] = carrier_frequency_hz(obs);
+            d_pseudorange_m[ch] = obs.Pseudorange_m;
+            d_raw_phase_m[ch] = d_frequency_hz[ch] > 0.0 ? obs.Carrier_phase_rads * (SPEED_OF_LIGHT_M_S / d_frequency_hz[ch]) / TWO_PI : 0.0;
+            d_phase_m[ch] = d_raw_phase_m[ch];
+        }
+
+    if (d_divergence_free)
+        {
+            find_partners(epoch, n);
+            for (uint32_t ch = 0; ch < n; ch++)
+                {
+                    const int32_t p = d_partner[ch];
+                    if (p >= 0)
+                        {
+                            const double fa2 = d_frequency_hz[ch] * d_frequency_hz[ch];
+                            const double fb2 = d_frequency_hz[p] * d_frequency_hz[p];
+                            const double alpha = fb2 / (fa2 - fb2);
+                            d_phase_m[ch] = d_raw_phase_m[ch] + 2.0 * alpha * (d_raw_phase_m[ch] - d_raw_phase_m[p]);
+                        }
+                }
+        }
+
+    // 2. a filter goes on only if the channel kept the same satellite and partner
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            const uint32_t sat = satellite_key(epoch[ch]);
+            d_keep[ch] = (d_valid[ch] && d_lock[ch] && sat == d_last_satellite[ch] && d_partner[ch] == d_last_partner[ch]) ? 1.0 : 0.0;
+            d_last_satellite[ch] = sat;
+            d_last_partner[ch] = d_partner[ch];
+        }
+
+    // 3. Hatch filter of all the channels
+    // (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            const double smoothed = d_factor * (d_last_smooth_m[ch] + d_phase_m[ch] - d_last_phase_m[ch]) + d_weight * d_pseudorange_m[ch];
+            const double out = d_keep[ch] != 0.0 ? smoothed : d_pseudorange_m[ch];
+            d_last_smooth_m[ch] = out;
+            d_last_phase_m[ch] = d_phase_m[ch];
+            d_lock[ch] = d_valid[ch];
+            d_pseudorange_m[ch] = out;
+        }
+
+    // 4. scatter the smoothed pseudoranges
+    for (uint32_t ch = 0; ch < n; ch++)
+        {
+            if (d_valid[ch])
+                {
+                    epoch[ch].Pseudorange_m = d_pseudorange_m[ch];
+                }
+        }
+}
@@ -0,0 +1,100 @@
+/*!
+ * \file obs_carrier_smoothing.h
+ * \brief Carrier smoothing (Hatch filter) of the pseudoranges of all the
+ * channels of an epoch
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_CARRIER_SMOOTHING_H
+#define GNSS_SDR_OBS_CARRIER_SMOOTHING_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Hatch filter of the pseudoranges of an epoch, one filter per channel:
+ *
+ *   r_sm(k) = (1/M) * PR(k) + ((M-1)/M) * (r_sm(k-1) + Phi(k) - Phi(k-1))
+ *
+ * where Phi is the carrier phase in meters. The channels are gathered into
+ * arrays and filtered in a single loop without branches. A filter restarts at
+ * the first valid pseudorange after an invalid one, or when the channel
+ * starts tracking another satellite.
+ *
+ * If divergence_free is set, a channel whose satellite is also tracked on
+ * another frequency (its partner) is smoothed with the ionosphere-divergence
+ * free phase combination Phi_a + 2 * alpha * (Phi_a - Phi_b), with
+ * alpha = f_b^2 / (f_a^2 - f_b^2), so that the smoothed pseudorange does not
+ * drift with the ionospheric delay. The filter of a channel also restarts
+ * when its partner changes.
+ */
+class Obs_Carrier_Smoothing
+{
+public:
+    Obs_Carrier_Smoothing(uint32_t nchannels, double smoothing_factor, bool divergence_free);
+
+    /*!
+     * \brief Replaces the pseudoranges of the valid observables of the epoch
+     * (indexed by channel) with the smoothed ones
+     */
+    void smooth(std::vector<Gnss_Synchro>& epoch);
+
+    /*!
+     * \brief Carrier frequency [Hz] of a signal, or 0 if it is unknown
+     */
+    static double carrier_frequency_hz(const Gnss_Synchro& obs);
+
+private:
+    void find_partners(const std::vector<Gnss_Synchro>& epoch, uint32_t n);
+
+    struct Satellite
+    {
+        int32_t first;  // first channel of the satellite
+        int32_t other;  // first channel on another frequency, or -1
+    };
+
+    std::unordered_map<uint32_t, Satellite> d_satellites;
+
+    // values of the epoch, by channel
+    std::vector<double> d_pseudorange_m;
+    std::vector<double> d_raw_phase_m;  // carrier phase of the channel
+    std::vector<double> d_phase_m;      // phase used by the filter
+    std::vector<double> d_keep;
+    std::vector<double> d_frequency_hz;
+    std::vector<int32_t> d_partner;
+    std::vector<uint8_t> d_valid;
+
+    // state of the filters, by channel
+    std::vector<double> d_last_smooth_m;
+    std::vector<double> d_last_phase_m;
+    std::vector<uint32_t> d_last_satellite;
+    std::vector<int32_t> d_last_partner;
+    std::vector<uint8_t> d_lock;
+
+    double d_factor;  // (M-1)/M
+    double d_weight;  // 1/M
+    uint32_t d_nchannels;
+    bool d_divergence_free;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_CARRIER_SMOOTHING_H
@@ -37,7 +37,9 @@ public:
     uint32_t nchannels_in{0U};
     uint32_t nchannels_out{0U};
     uint32_t observable_interval_ms{20U};
+    uint32_t threads{1U};
     bool enable_carrier_smoothing{false};
+    bool divergence_free_smoothing{false};
     bool always_output_gs{false};
     bool dump{false};
     bool dump_mat{false};
@@ -0,0 +1,220 @@
+/*!
+ * \file obs_history.cc
+ * \brief History of the tracking observables of each channel, and their
+ * interpolation at the receiver clock
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_history.h"
+#include <algorithm>  // for std::max, std::min
+
+
+Obs_History::Obs_History(uint32_t capacity, uint32_t nchannels)
+    : d_obs(std::max(capacity, 1U), nchannels),
+      d_sample_counter(d_obs.storage_size()),
+      d_rx_time_s(d_obs.storage_size()),
+      d_carrier_phase_rads(d_obs.storage_size()),
+      d_carrier_doppler_hz(d_obs.storage_size()),
+      d_tow_ms(d_obs.storage_size()),
+      d_time_factor(nchannels),
+      d_phase1(nchannels),
+      d_phase2(nchannels),
+      d_doppler1(nchannels),
+      d_doppler2(nchannels),
+      d_tow1(nchannels),
+      d_tow2(nchannels),
+      d_interp_phase(nchannels),
+      d_interp_doppler(nchannels),
+      d_interp_tow(nchannels),
+      d_nearest(nchannels),
+      d_valid(nchannels),
+      d_nchannels(nchannels)
+{
+}
+
+
+uint32_t Obs_History::size(uint32_t ch) const
+{
+    return d_obs.size(ch);
+}
+
+
+const Gnss_Synchro& Obs_History::front(uint32_t ch) const
+{
+    return d_obs.get(ch, 0);
+}
+
+
+void Obs_History::push_back(uint32_t ch, const Gnss_Synchro& obs, double rx_time_s)
+{
+    const uint32_t p = d_obs.push_back(ch, obs);
+    d_obs.back(ch).RX_time = rx_time_s;
+    d_sample_counter[p] = obs.Tracking_sample_counter;
+    d_rx_time_s[p] = rx_time_s;
+    d_carrier_phase_rads[p] = obs.Carrier_phase_rads;
+    d_carrier_doppler_hz[p] = obs.Carrier_Doppler_hz;
+    d_tow_ms[p] = obs.TOW_at_current_symbol_ms;
+}
+
+
+void Obs_History::clear(uint32_t ch)
+{
+    d_obs.clear(ch);
+}
+
+
+bool Obs_History::find_bracket(uint32_t ch, uint64_t rx_clock, double max_distance_s,
+    uint32_t& nearest, uint32_t& t1, uint32_t& t2) const
+{
+    const uint32_t size = d_obs.size(ch);
+    if (size == 0)
+        {
+            return false;
+        }
+    // first element with a sample counter not lower than rx_clock
+    uint32_t lo = 0;
+    uint32_t hi = size;
+    while (lo < hi)
+        {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (d_sample_counter[d_obs.index(ch, mid)] < rx_clock)
+                {
+                    lo = mid + 1;
+                }
+            else
+                {
+                    hi = mid;
+                }
+        }
+    // the nearest one is either that one or the previous one (the oldest on ties)
+    uint64_t distance;
+    if (lo == size)
+        {
+            nearest = lo - 1;
+            distance = rx_clock - d_sample_counter[d_obs.index(ch, nearest)];
+        }
+    else if (lo == 0)
+        {
+            nearest = 0;
+            distance = d_sample_counter[d_obs.index(ch, 0)] - rx_clock;
+        }
+    else
+        {
+            const uint64_t distance_before = rx_clock - d_sample_counter[d_obs.index(ch, lo - 1)];
+            const uint64_t distance_after = d_sample_counter[d_obs.index(ch, lo)] - rx_clock;
+            nearest = distance_after < distance_before ? lo : lo - 1;
+            distance = distance_after < distance_before ? distance_after : distance_before;
+        }
+
+    const Gnss_Synchro& nearest_obs = d_obs.get(ch, nearest);
+    if (static_cast<double>(distance) / static_cast<double>(nearest_obs.fs) >= max_distance_s)
+        {
+            return false;
+        }
+    if (rx_clock > nearest_obs.Tracking_sample_counter)
+        {
+            if (nearest + 1 >= size)
+                {
+                    return false;
+                }
+            t1 = nearest;
+            t2 = nearest + 1;
+        }
+    else
+        {
+            if (nearest == 0)
+                {
+                    return false;
+                }
+            t1 = nearest - 1;
+            t2 = nearest;
+        }
+    return true;
+}
+
+
+int32_t Obs_History::interpolate(uint64_t rx_clock, double max_distance_s, std::vector<Gnss_Synchro>& epoch)
+{
+    epoch.resize(d_nchannels);
+    return interpolate(rx_clock, max_distance_s, epoch, 0, d_nchannels);
+}
+
+
+int32_t Obs_History::interpolate(uint64_t rx_clock, double max_distance_s, std::vector<Gnss_Synchro>& epoch,
+    uint32_t first_ch, uint32_t last_ch)
+{
+    last_ch = std::min(last_ch, d_nchannels);
+
+    // 1st: look for the observables around rx_clock in each channel
+    int32_t n_valid = 0;
+    for (uint32_t ch = first_ch; ch < last_ch; ch++)
+        {
+            uint32_t nearest = 0;
+            uint32_t t1 = 0;
+            uint32_t t2 = 0;
+            d_valid[ch] = find_bracket(ch, rx_clock, max_distance_s, nearest, t1, t2);
+            if (!d_valid[ch])
+                {
+                    d_time_factor[ch] = 0.0;
+                    d_phase1[ch] = d_phase2[ch] = 0.0;
+                    d_doppler1[ch] = d_doppler2[ch] = 0.0;
+                    d_tow1[ch] = d_tow2[ch] = 0.0;
+                    continue;
+                }
+            n_valid++;
+            const uint32_t p1 = d_obs.index(ch, t1);
+            const uint32_t p2 = d_obs.index(ch, t2);
+            d_nearest[ch] = nearest;
+            const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(d_obs.get(ch, nearest).fs);
+            d_time_factor[ch] = (T_rx_s - d_rx_time_s[p1]) / (d_rx_time_s[p2] - d_rx_time_s[p1]);
+            d_phase1[ch] = d_carrier_phase_rads[p1];
+            d_phase2[ch] = d_carrier_phase_rads[p2];
+            d_doppler1[ch] = d_carrier_doppler_hz[p1];
+            d_doppler2[ch] = d_carrier_doppler_hz[p2];
+            d_tow1[ch] = static_cast<double>(d_tow_ms[p1]);
+            // check TOW rollover
+            d_tow2[ch] = static_cast<double>(d_tow_ms[p2] - d_tow_ms[p1] > 0 ? d_tow_ms[p2] : d_tow_ms[p2] + 604800000);
+        }
+
+    // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1),
+    // a loop across channels without branches, vectorized by the compiler
+    for (uint32_t ch = first_ch; ch < last_ch; ch++)
+        {
+            d_interp_phase[ch] = d_phase1[ch] + (d_phase2[ch] - d_phase1[ch]) * d_time_factor[ch];
+            d_interp_doppler[ch] = d_doppler1[ch] + (d_doppler2[ch] - d_doppler1[ch]) * d_time_factor[ch];
+            d_interp_tow[ch] = d_tow1[ch] + (d_tow2[ch] - d_tow1[ch]) * d_time_factor[ch];
+        }
+
+    // 3rd: copy the nearest gnss_synchro data of each channel, with the interpolated values
+    for (uint32_t ch = first_ch; ch < last_ch; ch++)
+        {
+            Gnss_Synchro& obs = epoch[ch];
+            if (d_valid[ch])
+                {
+                    obs = d_obs.get(ch, d_nearest[ch]);
+                    obs.Carrier_phase_rads = d_interp_phase[ch];
+                    obs.Carrier_Doppler_hz = d_interp_doppler[ch];
+                    obs.interp_TOW_ms = d_interp_tow[ch];
+                }
+            else
+                {
+                    // Produce an empty observation
+                    obs = Gnss_Synchro();
+                    obs.Flag_valid_pseudorange = false;
+                    obs.Flag_valid_word = false;
+                    obs.Flag_valid_acquisition = false;
+                    obs.fs = 0;
+                    obs.Channel_ID = static_cast<int32_t>(ch);
+                }
+        }
+    return n_valid;
+}
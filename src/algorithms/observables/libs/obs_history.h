@@ -0,0 +1,117 @@
+/*!
+ * \file obs_history.h
+ * \brief History of the tracking observables of each channel, and their
+ * interpolation at the receiver clock
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_HISTORY_H
+#define GNSS_SDR_OBS_HISTORY_H
+
+#include "gnss_circular_deque.h"
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps the last tracking observables of each channel in rings of a
+ * fixed capacity (the oldest one is dropped when a ring is full).
+ *
+ * The rings of all the channels share a single Gnss_circular_deque. The
+ * fields used to interpolate (sample counter, receiver time, carrier phase,
+ * Doppler and TOW) are also kept as separate arrays, in parallel to its
+ * storage, so that finding the observables around a receiver epoch is a
+ * binary search on the sample counters of the channel. The sample counters of a channel must not
+ * decrease, clear it when it starts tracking another satellite. Different
+ * channels share no state, so they can be pushed and interpolated from
+ * different threads.
+ */
+class Obs_History
+{
+public:
+    Obs_History(uint32_t capacity, uint32_t nchannels);
+
+    uint32_t size(uint32_t ch) const;
+
+    /*!
+     * \brief Oldest observable of a non-empty channel
+     */
+    const Gnss_Synchro& front(uint32_t ch) const;
+
+    /*!
+     * \brief Adds an observable, received at rx_time_s (also stored in its RX_time)
+     */
+    void push_back(uint32_t ch, const Gnss_Synchro& obs, double rx_time_s);
+
+    void clear(uint32_t ch);
+
+    /*!
+     * \brief Interpolates the observables of every channel at the receiver
+     * clock rx_clock [samples].
+     *
+     * A channel is interpolated between the two observables around rx_clock
+     * when the nearest one is less than max_distance_s away. The nearest one
+     * is copied to epoch[ch] and its carrier phase, Doppler and TOW
+     * (in interp_TOW_ms) are replaced by the interpolated ones. Otherwise
+     * epoch[ch] is an empty, invalid observation. Returns the number of
+     * interpolated channels.
+     */
+    int32_t interpolate(uint64_t rx_clock, double max_distance_s, std::vector<Gnss_Synchro>& epoch);
+
+    /*!
+     * \brief Same, for the channels in [first_ch, last_ch) only, and epoch
+     * must already have an element per channel. Calls on disjoint ranges of
+     * channels may run at the same time in different threads.
+     */
+    int32_t interpolate(uint64_t rx_clock, double max_distance_s, std::vector<Gnss_Synchro>& epoch,
+        uint32_t first_ch, uint32_t last_ch);
+
+private:
+    bool find_bracket(uint32_t ch, uint64_t rx_clock, double max_distance_s,
+        uint32_t& nearest, uint32_t& t1, uint32_t& t2) const;
+
+    Gnss_circular_deque<Gnss_Synchro> d_obs;
+
+    // fields of the observables, by storage index of d_obs
+    std::vector<uint64_t> d_sample_counter;
+    std::vector<double> d_rx_time_s;
+    std::vector<double> d_carrier_phase_rads;
+    std::vector<double> d_carrier_doppler_hz;
+    std::vector<uint32_t> d_tow_ms;
+
+    // values of the observables around the epoch, and the interpolated ones, by channel
+    std::vector<double> d_time_factor;
+    std::vector<double> d_phase1;
+    std::vector<double> d_phase2;
+    std::vector<double> d_doppler1;
+    std::vector<double> d_doppler2;
+    std::vector<double> d_tow1;
+    std::vector<double> d_tow2;
+    std::vector<double> d_interp_phase;
+    std::vector<double> d_interp_doppler;
+    std::vector<double> d_interp_tow;
+    std::vector<uint32_t> d_nearest;
+    std::vector<uint8_t> d_valid;
+
+    uint32_t d_nchannels;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_HISTORY_H
@@ -0,0 +1,99 @@
+/*!
+ * \file obs_shard_pool.cc
+ * \brief Worker threads that compute the observables of groups of channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_shard_pool.h"
+#include <algorithm>  // for std::max, std::min
+
+
+Obs_Shard_Pool::Obs_Shard_Pool(uint32_t threads, uint32_t nchannels)
+    : d_nchannels(nchannels)
+{
+    threads = std::max(1U, std::min(threads, std::max(nchannels, 1U)));
+    d_shard_size = std::max(1U, (nchannels + threads - 1) / threads);
+    d_shards = std::max(1U, (nchannels + d_shard_size - 1) / d_shard_size);
+    for (uint32_t i = 1; i < d_shards; i++)
+        {
+            d_threads.emplace_back(&Obs_Shard_Pool::worker, this);
+        }
+}
+
+
+Obs_Shard_Pool::~Obs_Shard_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_start_cond.notify_all();
+    for (auto &thread : d_threads)
+        {
+            thread.join();
+        }
+}
+
+
+void Obs_Shard_Pool::run(const std::function<void(uint32_t, uint32_t)> &job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_job = &job;
+        d_next = 0;
+        d_done = 0;
+        d_generation++;
+    }
+    d_start_cond.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_done_cond.wait(lock, [this] { return d_done == d_shards; });
+    d_job = nullptr;
+}
+
+
+void Obs_Shard_Pool::work()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (d_job != nullptr && d_next < d_shards)
+        {
+            const uint32_t shard = d_next++;
+            const auto *job = d_job;
+            lock.unlock();
+            const uint32_t first_ch = shard * d_shard_size;
+            (*job)(first_ch, std::min(first_ch + d_shard_size, d_nchannels));
+            lock.lock();
+            if (++d_done == d_shards)
+                {
+                    d_done_cond.notify_all();
+                }
+        }
+}
+
+
+void Obs_Shard_Pool::worker()
+{
+    uint64_t generation = 0;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_start_cond.wait(lock, [this, generation] { return d_stop || d_generation != generation; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                generation = d_generation;
+            }
+            work();
+        }
+}
@@ -0,0 +1,83 @@
+/*!
+ * \file obs_shard_pool.h
+ * \brief Worker threads that compute the observables of groups of channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_SHARD_POOL_H
+#define GNSS_SDR_OBS_SHARD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Splits the channels of the Observables block in shards (contiguous
+ * groups of channels) and runs a job on every shard, in the calling thread
+ * and in threads - 1 worker threads.
+ *
+ * run() returns when the job has been run on all the shards, so the epoch is
+ * merged at that point. Jobs of different shards must only write the state
+ * of their own channels, then the result does not depend on the number of
+ * threads. The job must not throw.
+ */
+class Obs_Shard_Pool
+{
+public:
+    Obs_Shard_Pool(uint32_t threads, uint32_t nchannels);
+    ~Obs_Shard_Pool();
+
+    Obs_Shard_Pool(const Obs_Shard_Pool &) = delete;
+    Obs_Shard_Pool &operator=(const Obs_Shard_Pool &) = delete;
+
+    /*!
+     * \brief Runs job(first_ch, last_ch) on the channels [first_ch, last_ch)
+     * of every shard, and waits for all of them
+     */
+    void run(const std::function<void(uint32_t, uint32_t)> &job);
+
+    inline uint32_t shards() const
+    {
+        return d_shards;
+    }
+
+private:
+    void work();
+    void worker();
+
+    std::vector<std::thread> d_threads;
+    std::mutex d_mutex;
+    std::condition_variable d_start_cond;
+    std::condition_variable d_done_cond;
+    const std::function<void(uint32_t, uint32_t)> *d_job{nullptr};
+    uint64_t d_generation{0};
+    uint32_t d_nchannels;
+    uint32_t d_shard_size;
+    uint32_t d_shards;
+    uint32_t d_next{0};  // next shard to be run
+    uint32_t d_done{0};  // shards run
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_SHARD_POOL_H
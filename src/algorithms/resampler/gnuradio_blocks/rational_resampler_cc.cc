@@ -0,0 +1,117 @@
+/*!
+ * \file rational_resampler_cc.cc
+ *
+ * \brief Polyphase rational resampler with gr_complex input and output, and
+ * integrated anti-aliasing filter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rational_resampler_cc.h"
+#include <gnuradio/filter/firdes.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+
+
+rational_resampler_cc_sptr make_rational_resampler_cc(
+    uint32_t interpolation,
+    uint32_t decimation,
+    const std::vector<float> &taps)
+{
+    return rational_resampler_cc_sptr(new rational_resampler_cc(interpolation, decimation, taps));
+}
+
+
+std::vector<float> rational_resampler_cc::design_taps(uint32_t interpolation, uint32_t decimation, double fractional_bw)
+{
+    // normalized to the input rate, the filter runs at interpolation
+    const double interp = std::max(interpolation, 1U);
+    const double lowest_rate = std::min(1.0, interp / static_cast<double>(std::max(decimation, 1U)));
+    return gr::filter::firdes::low_pass(interp, interp, fractional_bw * lowest_rate, (1.0 - 2.0 * fractional_bw) * lowest_rate);
+}
+
+
+rational_resampler_cc::rational_resampler_cc(
+    uint32_t interpolation,
+    uint32_t decimation,
+    const std::vector<float> &taps) : gr::block("rational_resampler_cc",
+                                          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+                                      d_interpolation(std::max(interpolation, 1U)),
+                                      d_decimation(std::max(decimation, 1U)),
+                                      d_phase(0)
+{
+    const std::vector<float> filter = taps.empty() ? design_taps(d_interpolation, d_decimation) : taps;
+    d_ntaps = std::max(filter.size(), static_cast<size_t>(1));
+    d_branch_taps = static_cast<uint32_t>((d_ntaps + d_interpolation - 1) / d_interpolation);
+
+    // Branch p holds taps p, p + interpolation, p + 2 interpolation, ...
+    // reversed, so that it runs forward over the input
+    d_branches = std::vector<volk_gnsssdr::vector<float>>(d_interpolation, volk_gnsssdr::vector<float>(d_branch_taps, 0.0));
+    for (uint32_t p = 0; p < d_interpolation; p++)
+        {
+            for (uint32_t k = 0; k < d_branch_taps; k++)
+                {
+                    const size_t index = p + static_cast<size_t>(k) * d_interpolation;
+                    if (index < filter.size())
+                        {
+                            d_branches[p][d_branch_taps - 1 - k] = filter[index];
+                        }
+                }
+        }
+
+    set_history(d_branch_taps);
+    set_relative_rate(static_cast<double>(d_interpolation) / static_cast<double>(d_decimation));
+}
+
+
+void rational_resampler_cc::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    const int nreqd = std::max(1, static_cast<int>(static_cast<double>(noutput_items + 1) * d_decimation / d_interpolation) + static_cast<int>(history()) - 1);
+    for (int &required : ninput_items_required)
+        {
+            required = nreqd;
+        }
+}
+
+
+int rational_resampler_cc::general_work(int noutput_items,
+    gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+
+    int produced = 0;
+    int consumed = 0;
+    uint32_t phase = d_phase;
+    while (produced < noutput_items and consumed < ninput_items[0])
+        {
+            // input sample that the next output starts from
+            const uint32_t next_phase = phase + d_decimation;
+            const int next_consumed = consumed + static_cast<int>(next_phase / d_interpolation);
+            if (next_consumed > ninput_items[0])
+                {
+                    break;
+                }
+            volk_32fc_32f_dot_prod_32fc(&out[produced], in + consumed, d_branches[phase].data(), d_branch_taps);
+            produced++;
+            consumed = next_consumed;
+            phase = next_phase % d_interpolation;
+        }
+
+    d_phase = phase;
+    consume_each(consumed);
+    return produced;
+}
@@ -0,0 +1,119 @@
+/*!
+ * \file rational_resampler_cc.h
+ *
+ * \brief Polyphase rational resampler with gr_complex input and output, and
+ * integrated anti-aliasing filter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RATIONAL_RESAMPLER_CC_H
+#define GNSS_SDR_RATIONAL_RESAMPLER_CC_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Resampler
+ * \{ */
+/** \addtogroup Resampler_gnuradio_blocks resampler_gr_blocks
+ * \{ */
+
+
+class rational_resampler_cc;
+
+using rational_resampler_cc_sptr = gnss_shared_ptr<rational_resampler_cc>;
+
+/*!
+ * \brief Returns a resampler by interpolation / decimation. The taps are
+ * designed at the input rate times interpolation; if empty, those of
+ * rational_resampler_cc::design_taps() are used.
+ */
+rational_resampler_cc_sptr make_rational_resampler_cc(
+    uint32_t interpolation,
+    uint32_t decimation,
+    const std::vector<float> &taps = std::vector<float>());
+
+/*!
+ * \brief This class implements a rational resampler as a polyphase filter.
+ *
+ * Conceptually, the input is upsampled by interpolation, low-pass filtered
+ * and decimated by decimation. Only the outputs that are kept are computed,
+ * each one as a single VOLK dot product of the last input samples with the
+ * branch of the filter of its phase, so the cost per output sample is
+ * ntaps / interpolation multiplications regardless of the ratio.
+ */
+class rational_resampler_cc : public gr::block
+{
+public:
+    ~rational_resampler_cc() = default;
+
+    /*!
+     * \brief Low-pass filter with unit gain at the output rate, flat up to
+     * fractional_bw times the lowest of the input and output rates and with
+     * its stopband at the Nyquist frequency of that rate.
+     */
+    static std::vector<float> design_taps(uint32_t interpolation, uint32_t decimation, double fractional_bw = 0.4);
+
+    inline uint32_t interpolation() const
+    {
+        return d_interpolation;
+    }
+
+    inline uint32_t decimation() const
+    {
+        return d_decimation;
+    }
+
+    inline size_t ntaps() const
+    {
+        return d_ntaps;
+    }
+
+    /*!
+     * \brief Group delay of the filter, in input samples.
+     */
+    inline double delay() const
+    {
+        return static_cast<double>(d_ntaps - 1) / (2.0 * static_cast<double>(d_interpolation));
+    }
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend rational_resampler_cc_sptr make_rational_resampler_cc(
+        uint32_t interpolation,
+        uint32_t decimation,
+        const std::vector<float> &taps);
+
+    rational_resampler_cc(
+        uint32_t interpolation,
+        uint32_t decimation,
+        const std::vector<float> &taps);
+
+    std::vector<volk_gnsssdr::vector<float>> d_branches;  // time-reversed taps of each phase
+    size_t d_ntaps;
+    uint32_t d_interpolation;
+    uint32_t d_decimation;
+    uint32_t d_branch_taps;
+    uint32_t d_phase;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RATIONAL_RESAMPLER_CC_H
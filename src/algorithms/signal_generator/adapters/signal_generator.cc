@@ -25,6 +25,7 @@
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
 #include "configuration_interface.h"
+#include "mmap_file_sink.h"
 #include <glog/logging.h>
 #include <cstdint>
 #include <utility>
@@ -33,7 +34,7 @@
 SignalGenerator::SignalGenerator(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_stream,
     unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue __attribute__((unused))) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
+    Control_Queue* queue __attribute__((unused))) : role_(role), in_stream_(in_stream), out_stream_(out_stream)
 {
     const std::string default_item_type("gr_complex");
     const std::string default_dump_file("./data/gen_source.dat");
@@ -43,6 +44,8 @@ SignalGenerator::SignalGenerator(const ConfigurationInterface* configuration,
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    // "mmap" writes the dump through a memory mapping of the file
+    const std::string io_backend = configuration->property(role + ".io_backend", std::string("stdio"));
 
     const unsigned int fs_in = configuration->property("SignalSource.fs_hz", static_cast<unsigned>(4e6));
     const bool data_flag = configuration->property("SignalSource.data_flag", false);
@@ -143,7 +146,14 @@ SignalGenerator::SignalGenerator(const ConfigurationInterface* configuration,
     if (dump_)
         {
             DLOG(INFO) << "Dumping output into file " << dump_filename_;
-            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            if (io_backend == "mmap")
+                {
+                    file_sink_ = make_mmap_file_sink(item_size_, dump_filename_);
+                }
+            else
+                {
+                    file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+                }
         }
     if (dump_)
         {
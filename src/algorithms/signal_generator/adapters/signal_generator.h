@@ -19,7 +19,7 @@
 #ifndef GNSS_SDR_SIGNAL_GENERATOR_H
 #define GNSS_SDR_SIGNAL_GENERATOR_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
 #include "signal_generator_c.h"
 #include <gnuradio/blocks/file_sink.h>
@@ -41,7 +41,7 @@ class SignalGenerator : public GNSSBlockInterface
 public:
     SignalGenerator(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~SignalGenerator() = default;
 
@@ -71,7 +71,7 @@ public:
 private:
     gnss_shared_ptr<gr::block> gen_source_;
     gr::blocks::vector_to_stream::sptr vector_to_stream_;
-    gr::blocks::file_sink::sptr file_sink_;
+    gr::basic_block_sptr file_sink_;  // gr::blocks::file_sink or mmap_file_sink
     std::string role_;
     std::string item_type_;
     std::string dump_filename_;
@@ -25,15 +25,29 @@
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
 #include "glonass_l1_signal_replica.h"
+#include "gnss_sdr_thread_pool.h"
 #include "gps_sdr_signal_replica.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <utility>
 
 
+namespace
+{
+// fewer samples per call (all the satellites together) are not worth splitting
+const unsigned int MIN_SAMPLES_TO_SPLIT = 1 << 20;
+
+// shortest slice of noise samples drawn by a worker
+const unsigned int NOISE_SAMPLES_PER_SLICE = 1 << 16;
+}  // namespace
+
+
 /*
  * Create a new instance of signal_generator_c and return
  * a boost shared_ptr. This is effectively the public constructor.
@@ -87,7 +101,6 @@ void signal_generator_c::init()
 {
     work_counter_ = 0;
 
-    complex_phase_ = std::vector<gr_complex>(vector_length_);
     start_phase_rad_.reserve(num_sats_);
     current_data_bit_int_.reserve(num_sats_);
     ms_counter_.reserve(num_sats_);
@@ -102,7 +115,7 @@ void signal_generator_c::init()
 
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            start_phase_rad_.push_back(0);
+            start_phase_rad_.push_back(0.0);
             current_data_bit_int_.push_back(1);
             current_data_bits_.emplace_back(1, 0);
             ms_counter_.push_back(0);
@@ -157,6 +170,18 @@ void signal_generator_c::init()
                         }
                 }
         }
+
+    satellite_segments_ = std::vector<std::vector<Segment>>(num_sats_);
+    phase_rad_ = std::vector<double>(num_sats_, 0.0);
+    phase_inc_rad_ = std::vector<double>(num_sats_, 0.0);
+
+    // one accumulator per worker, each one adding a share of the satellites
+    const size_t workers = std::min(static_cast<size_t>(num_sats_), Gnss_Thread_Pool::instance().size());
+    if (workers > 1 && vector_length_ * num_sats_ >= MIN_SAMPLES_TO_SPLIT)
+        {
+            accumulators_ = std::vector<volk_gnsssdr::vector<gr_complex>>(workers, volk_gnsssdr::vector<gr_complex>(vector_length_));
+        }
+    scratch_ = std::vector<volk_gnsssdr::vector<gr_complex>>(std::max(static_cast<size_t>(1), accumulators_.size()), volk_gnsssdr::vector<gr_complex>(vector_length_));
 }
 
 
@@ -322,6 +347,49 @@ void signal_generator_c::generate_codes()
 }
 
 
+void signal_generator_c::add_segment(unsigned int sat, unsigned int first, unsigned int last,
+    const gr_complex &gain, bool conjugate, bool pilot)
+{
+    first = std::min(first, vector_length_);
+    last = std::min(last, vector_length_);
+    if (last > first)
+        {
+            satellite_segments_[sat].push_back({first, last, gain, conjugate, pilot});
+        }
+}
+
+
+void signal_generator_c::add_satellite(unsigned int sat, gr_complex *acc, gr_complex *tmp) const
+{
+    unsigned int covered = 0;
+    for (const auto &segment : satellite_segments_[sat])
+        {
+            const unsigned int length = segment.last - segment.first;
+            gr_complex *y = tmp + segment.first;
+            const gr_complex *code = sampled_code_data_[sat].data() + segment.first;
+            if (segment.conjugate)
+                {
+                    // (re * a, -im * a) = a * conj(code)
+                    volk_32fc_conjugate_32fc(y, code, length);
+                    volk_32fc_s32fc_multiply_32fc(y, y, segment.gain, length);
+                }
+            else
+                {
+                    volk_32fc_s32fc_multiply_32fc(y, code, segment.gain, length);
+                }
+            if (segment.pilot)
+                {
+                    volk_32f_x2_subtract_32f(reinterpret_cast<float *>(y), reinterpret_cast<const float *>(y),
+                        reinterpret_cast<const float *>(sampled_code_pilot_[sat].data() + segment.first), 2 * length);
+                }
+            covered = std::max(covered, segment.last);
+        }
+    double phase = phase_rad_[sat];
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc(tmp, tmp, phase_inc_rad_[sat], &phase, covered);
+    volk_32f_x2_add_32f(reinterpret_cast<float *>(acc), reinterpret_cast<const float *>(acc), reinterpret_cast<const float *>(tmp), 2 * covered);
+}
+
+
 int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items __attribute__((unused)),
@@ -332,27 +400,21 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
     work_counter_++;
 
     std::default_random_engine e1(r());
-    std::default_random_engine e2(r());
-    unsigned int out_idx = 0;
     unsigned int i = 0;
-    unsigned int k = 0;
     // the intermediate frequency must be set by the user
     unsigned int freq = 4e6;
 
-    for (out_idx = 0; out_idx < vector_length_; out_idx++)
-        {
-            out[out_idx] = gr_complex(0.0, 0.0);
-        }
-
+    // First pass, in order: data bits, secondary codes and carrier phase of
+    // each satellite, as the segments of the vector with a constant modulation
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
-            float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
-            std::array<float, 1> _phase{};
-            _phase[0] = -start_phase_rad_[sat];
-            volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
-            start_phase_rad_[sat] += static_cast<float>(vector_length_) * phase_step_rad;
+            satellite_segments_[sat].clear();
+            double phase_step_rad = -TWO_PI * static_cast<double>(doppler_Hz_[sat]) / static_cast<double>(fs_in_);
+            phase_rad_[sat] = -start_phase_rad_[sat];
+            phase_inc_rad_[sat] = -phase_step_rad;
+            start_phase_rad_[sat] = std::remainder(start_phase_rad_[sat] + static_cast<double>(vector_length_) * phase_step_rad, TWO_PI);
 
-            out_idx = 0;
+            unsigned int out_idx = 0;
 
             if (system_[sat] == "G")
                 {
@@ -360,11 +422,8 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
 
                     for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                         {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            add_segment(sat, out_idx, out_idx + delay_samples, current_data_bits_[sat], false, false);
+                            out_idx += delay_samples;
 
                             if (ms_counter_[sat] == 0 && data_flag_)
                                 {
@@ -372,11 +431,8 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
                                     current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
                                 }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            add_segment(sat, out_idx, out_idx + samples_per_code_[sat] - delay_samples, current_data_bits_[sat], false, false);
+                            out_idx += samples_per_code_[sat] - delay_samples;
 
                             ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
                         }
@@ -384,20 +440,16 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
 
             else if (system_[sat] == "R")
                 {
-                    phase_step_rad = -static_cast<float>(TWO_PI) * (static_cast<float>(freq) + (static_cast<float>(DFRQ1_GLO) * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<float>(fs_in_);
-                    // std::cout << "sat " << PRN_[sat] << " SG - Freq = " << (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat]))) << " Doppler = " << doppler_Hz_[sat] << '\n';
-                    _phase[0] = -start_phase_rad_[sat];
-                    volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
+                    phase_step_rad = -TWO_PI * (static_cast<double>(freq) + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<double>(fs_in_);
+                    phase_rad_[sat] = -start_phase_rad_[sat];
+                    phase_inc_rad_[sat] = -phase_step_rad;
 
                     auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS);
 
                     for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                         {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            add_segment(sat, out_idx, out_idx + delay_samples, current_data_bits_[sat], false, false);
+                            out_idx += delay_samples;
 
                             if (ms_counter_[sat] == 0 && data_flag_)
                                 {
@@ -405,11 +457,8 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
                                     current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
                                 }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            add_segment(sat, out_idx, out_idx + samples_per_code_[sat] - delay_samples, current_data_bits_[sat], false, false);
+                            out_idx += samples_per_code_[sat] - delay_samples;
 
                             ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
                         }
@@ -417,80 +466,50 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
 
             else if (system_[sat] == "E")
                 {
-                    if (signal_[sat].at(0) == '5')
+                    if (signal_[sat].at(0) == '5' || signal_[sat].at(0) == '7')
                         {
                             // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS);
+                            const bool e5a = signal_[sat].at(0) == '5';
+                            const int codelen = static_cast<int>(e5a ? GALILEO_E5A_CODE_LENGTH_CHIPS : GALILEO_E5B_CODE_LENGTH_CHIPS);
                             unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+
+                            // the data (I) and pilot (Q) components are modulated by +-1 each
+                            add_segment(sat, out_idx, out_idx + delay_samples, gr_complex(static_cast<float>(data_modulation_[sat]), 0.0),
+                                data_modulation_[sat] != pilot_modulation_[sat], false);
+                            out_idx += delay_samples;
 
                             if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
                                 {
                                     // New random data bit
                                     current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
                                 }
-                            data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5A_I_SECONDARY_CODE[(ms_counter_[sat] + delay_sec_[sat]) % 20] == '0' ? 1 : -1);
-                            pilot_modulation_[sat] = (GALILEO_E5A_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
-
-                            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5A_CODE_PERIOD_S));
-
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
+                            if (e5a)
                                 {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
+                                    data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5A_I_SECONDARY_CODE[(ms_counter_[sat] + delay_sec_[sat]) % 20] == '0' ? 1 : -1);
+                                    pilot_modulation_[sat] = (GALILEO_E5A_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
+                                    ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5A_CODE_PERIOD_S));
                                 }
-                        }
-                    else if (signal_[sat].at(0) == '7')
-                        {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
+                            else
                                 {
-                                    // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
+                                    data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5B_I_SECONDARY_CODE[((ms_counter_[sat] + delay_sec_[sat]) % 4)] == '0' ? 1 : -1);
+                                    pilot_modulation_[sat] = (GALILEO_E5B_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
+                                    ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5B_CODE_PERIOD_S));
                                 }
-                            data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5B_I_SECONDARY_CODE[((ms_counter_[sat] + delay_sec_[sat]) % 4)] == '0' ? 1 : -1);
-                            pilot_modulation_[sat] = (GALILEO_E5B_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
-
-                            ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5B_CODE_PERIOD_S));
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                            add_segment(sat, out_idx, out_idx + samples_per_code_[sat] - delay_samples, gr_complex(static_cast<float>(data_modulation_[sat]), 0.0),
+                                data_modulation_[sat] != pilot_modulation_[sat], false);
                         }
-                    else if (signal_[sat].at(1) == '6')
+                    else
                         {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
+                            // E1 and E6: data component modulated by the data bits, minus the pilot component
+                            const bool e6 = signal_[sat].at(1) == '6';
+                            const int codelen = static_cast<int>(e6 ? GALILEO_E6_C_CODE_LENGTH_CHIPS : GALILEO_E1_B_CODE_LENGTH_CHIPS);
+                            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen);
+
                             for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
                                 {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
+                                    add_segment(sat, out_idx, out_idx + delay_samples, current_data_bits_[sat], false, true);
+                                    out_idx += delay_samples;
 
                                     if (ms_counter_[sat] == 0 && data_flag_)
                                         {
@@ -498,49 +517,79 @@ int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
                                             current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
                                         }
 
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-                                    ms_counter_[sat] = (ms_counter_[sat] + 1) % data_bit_duration_ms_[sat];
-                                }
-                        }
-                    else
-                        {
-                            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GALILEO_E1_B_CODE_LENGTH_CHIPS);
+                                    add_segment(sat, out_idx, out_idx + samples_per_code_[sat] - delay_samples, current_data_bits_[sat], false, true);
+                                    out_idx += samples_per_code_[sat] - delay_samples;
 
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-
-                                    if (ms_counter_[sat] == 0 && data_flag_)
+                                    if (e6)
                                         {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
+                                            ms_counter_[sat] = (ms_counter_[sat] + 1) % data_bit_duration_ms_[sat];
                                         }
-
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
+                                    else
                                         {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
+                                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
                                         }
-
-                                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
                                 }
                         }
                 }
         }
 
+    // Second pass: the sampled codes, modulated and rotated with VOLK kernels,
+    // with the satellites split among the workers of the thread pool
+    const auto chunks = static_cast<unsigned int>(accumulators_.size());
+    if (chunks <= 1)
+        {
+            std::fill_n(out, vector_length_, gr_complex(0.0, 0.0));
+            for (unsigned int sat = 0; sat < num_sats_; sat++)
+                {
+                    add_satellite(sat, out, scratch_[0].data());
+                }
+        }
+    else
+        {
+            Gnss_Thread_Pool::instance().parallel_for(chunks, [&](size_t chunk) {
+                gr_complex *acc = accumulators_[chunk].data();
+                std::fill_n(acc, vector_length_, gr_complex(0.0, 0.0));
+                for (auto sat = static_cast<unsigned int>(chunk); sat < num_sats_; sat += chunks)
+                    {
+                        add_satellite(sat, acc, scratch_[chunk].data());
+                    }
+            });
+            std::copy_n(accumulators_[0].data(), vector_length_, out);
+            for (unsigned int chunk = 1; chunk < chunks; chunk++)
+                {
+                    volk_32f_x2_add_32f(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(out),
+                        reinterpret_cast<const float *>(accumulators_[chunk].data()), 2 * vector_length_);
+                }
+        }
+
     if (noise_flag_)
         {
-            for (out_idx = 0; out_idx < vector_length_; out_idx++)
+            // each slice of the vector draws its noise from its own engines
+            const auto slices = static_cast<unsigned int>(std::max(static_cast<size_t>(1),
+                std::min(std::max(static_cast<size_t>(1), Gnss_Thread_Pool::instance().size()), static_cast<size_t>(vector_length_ / NOISE_SAMPLES_PER_SLICE))));
+            std::vector<unsigned int> seeds(2 * slices);
+            for (auto &seed : seeds)
+                {
+                    seed = r();
+                }
+            auto add_noise = [&](size_t slice) {
+                std::default_random_engine g1(seeds[2 * slice]);
+                std::default_random_engine g2(seeds[2 * slice + 1]);
+                std::normal_distribution<float> noise;
+                const auto first = static_cast<unsigned int>((static_cast<uint64_t>(vector_length_) * slice) / slices);
+                const auto last = static_cast<unsigned int>((static_cast<uint64_t>(vector_length_) * (slice + 1)) / slices);
+                for (unsigned int n = first; n < last; n++)
+                    {
+                        out[n] += gr_complex(noise(g1), noise(g2));
+                    }
+            };
+            if (slices == 1)
+                {
+                    add_noise(0);
+                }
+            else
                 {
-                    out[out_idx] += gr_complex(normal_dist(e1), normal_dist(e2));
+                    Gnss_Thread_Pool::instance().parallel_for(slices, add_noise);
                 }
         }
 
@@ -19,6 +19,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <random>
 #include <string>
 #include <vector>
@@ -53,6 +54,12 @@ signal_generator_c_sptr signal_make_generator_c(
  * \brief This class generates synthesized GNSS signal.
  * \ingroup block
  *
+ * Each call first walks the satellites in order to update their data bits,
+ * secondary codes and carrier phases, which splits the output vector into
+ * segments of constant modulation. Then the sampled codes are scaled, rotated
+ * and added with VOLK kernels, with the satellites (and the noise samples)
+ * shared among the workers of Gnss_Thread_Pool.
+ *
  * \sa gen_source for a version that subclasses gr_block.
  */
 class signal_generator_c : public gr::block
@@ -99,18 +106,38 @@ private:
 
     void generate_codes();
 
+    // samples [first, last) of a satellite are gain * code (or gain *
+    // conj(code) for the E5 signals with opposite data and pilot signs),
+    // minus the pilot code if pilot is set
+    struct Segment
+    {
+        unsigned int first;
+        unsigned int last;
+        gr_complex gain;
+        bool conjugate;
+        bool pilot;
+    };
+
+    void add_segment(unsigned int sat, unsigned int first, unsigned int last,
+        const gr_complex &gain, bool conjugate, bool pilot);
+
+    void add_satellite(unsigned int sat, gr_complex *acc, gr_complex *tmp) const;
+
     std::random_device r;
     std::uniform_int_distribution<int> uniform_dist;
-    std::normal_distribution<float> normal_dist;
     std::vector<std::string> signal_;
     std::vector<std::string> system_;
     std::vector<std::vector<gr_complex>> sampled_code_data_;
     std::vector<std::vector<gr_complex>> sampled_code_pilot_;
     std::vector<gr_complex> current_data_bits_;
-    std::vector<gr_complex> complex_phase_;
+    std::vector<std::vector<Segment>> satellite_segments_;
+    std::vector<volk_gnsssdr::vector<gr_complex>> accumulators_;  // one per worker, empty if not split
+    std::vector<volk_gnsssdr::vector<gr_complex>> scratch_;       // one per worker
     std::vector<float> CN0_dB_;
     std::vector<float> doppler_Hz_;
-    std::vector<float> start_phase_rad_;
+    std::vector<double> start_phase_rad_;
+    std::vector<double> phase_rad_;      // carrier phase of each satellite at the first sample of the vector
+    std::vector<double> phase_inc_rad_;  // and its increment per sample
     std::vector<unsigned int> PRN_;
     std::vector<unsigned int> delay_chips_;
     std::vector<unsigned int> delay_sec_;
@@ -26,14 +26,14 @@
 #include "GPS_L1_CA.h"
 #include "GPS_L5.h"
 #include "ad9361_manager.h"
-#include "command_event.h"
 #include "configuration_interface.h"
+#include "control_queue.h"
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "uio_fpga.h"
 #include <glog/logging.h>
 #include <iio.h>
-#include <algorithm>  // for std::max
+#include <algorithm>  // for std::max, std::min
 #include <chrono>     // for std::chrono
 #include <cmath>      // for std::floor
 #include <exception>  // for std::exception
@@ -41,6 +41,7 @@
 #include <fstream>    // for std::ifstream
 #include <iomanip>    // for std::setprecision
 #include <iostream>   // for std::cout
+#include <stdexcept>  // for std::runtime_error
 #include <unistd.h>   // for write
 #include <vector>     // fr std::vector
 
@@ -49,7 +50,7 @@ using namespace std::string_literals;
 
 Ad9361FpgaSignalSource::Ad9361FpgaSignalSource(const ConfigurationInterface *configuration,
     const std::string &role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t> *queue __attribute__((unused)))
+    Control_Queue *queue __attribute__((unused)))
     : SignalSourceBase(configuration, role, "Ad9361_Fpga_Signal_Source"s),
       queue_(queue),
       gain_mode_rx1_(configuration->property(role + ".gain_mode_rx1", default_gain_mode)),
@@ -76,6 +77,8 @@ Ad9361FpgaSignalSource::Ad9361FpgaSignalSource(const ConfigurationInterface *con
       item_size_(sizeof(int8_t)),
       in_stream_(in_stream),
       out_stream_(out_stream),
+      dynamic_bit_selection_min_period_ms_(configuration->property(role + ".dynamic_bit_selection_min_period_ms", Gain_control_min_period_ms)),
+      dynamic_bit_selection_max_period_ms_(configuration->property(role + ".dynamic_bit_selection_max_period_ms", Gain_control_max_period_ms)),
       switch_position_(configuration->property(role + ".switch_position", 0)),
       enable_dds_lo_(configuration->property(role + ".enable_dds_lo", false)),
       filter_auto_(configuration->property(role + ".filter_auto", false)),
@@ -443,6 +446,41 @@ Ad9361FpgaSignalSource::Ad9361FpgaSignalSource(const ConfigurationInterface *con
             thread_dynamic_bit_selection = std::thread([&] { run_dynamic_bit_selection_process(); });
         }
 
+    // samples of the FPGA data path written by DMA into host memory, for recording and monitoring
+    if (configuration->property(role + ".enable_sample_tap", false))
+        {
+            std::string device_io_name_sample_tap;
+            const std::string tap_device_name = configuration->property(role + ".sample_tap_devicename", sample_tap_device_name);
+
+            // find the uio device file corresponding to the sample tap
+            if (find_uio_dev_file_name(device_io_name_sample_tap, tap_device_name, 0) < 0)
+                {
+                    std::cerr << "Cannot find the FPGA uio device file corresponding to device name " << tap_device_name << '\n';
+                    item_size_ = 0;
+                    return;
+                }
+
+            // each item holds the 8-bit I and Q samples of all the frequency bands
+            const size_t tap_item_size = 2 * num_freq_bands_ * sizeof(int8_t);
+            try
+                {
+                    sample_tap_ = make_fpga_sample_tap_source(tap_item_size, device_io_name_sample_tap,
+                        configuration->property(role + ".sample_tap_irq_bytes", default_sample_tap_irq_bytes));
+                }
+            catch (const std::runtime_error &e)
+                {
+                    std::cerr << e.what() << '\n';
+                    item_size_ = 0;
+                    return;
+                }
+            const std::string tap_filename = configuration->property(role + ".sample_tap_filename", std::string(""));
+            if (!tap_filename.empty())
+                {
+                    DLOG(INFO) << "Recording the FPGA samples into file " << tap_filename;
+                    sample_tap_file_sink_ = gr::blocks::file_sink::make(tap_item_size, tap_filename.c_str());
+                }
+        }
+
     if (in_stream_ > 0)
         {
             LOG(ERROR) << "A signal source does not have an input stream";
@@ -525,7 +563,7 @@ void Ad9361FpgaSignalSource::start()
 }
 
 
-void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const std::string &filename1, uint64_t &samples_to_skip, size_t &item_size, int64_t &samples, bool &repeat, uint32_t &dma_buff_offset_pos, Concurrent_Queue<pmt::pmt_t> *queue)
+void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const std::string &filename1, uint64_t &samples_to_skip, size_t &item_size, int64_t &samples, bool &repeat, uint32_t &dma_buff_offset_pos, Control_Queue *queue)
 {
     std::ifstream infile1;
     infile1.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -539,7 +577,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Exception opening file " << filename0 << '\n';
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(command_event_make(200, 0));
             return;
         }
 
@@ -555,7 +593,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
                 {
                     std::cerr << "Exception opening file " << filename1 << '\n';
                     // stop the receiver
-                    queue->push(pmt::make_any(command_event_make(200, 0)));
+                    queue->push(command_event_make(200, 0));
                     return;
                 }
         }
@@ -570,7 +608,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Exception skipping initial samples file " << filename0 << '\n';
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(command_event_make(200, 0));
             return;
         }
 
@@ -584,7 +622,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
                 {
                     std::cerr << "Exception skipping initial samples file " << filename1 << '\n';
                     // stop the receiver
-                    queue->push(pmt::make_any(command_event_make(200, 0)));
+                    queue->push(command_event_make(200, 0));
                     return;
                 }
         }
@@ -603,7 +641,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Cannot open loop device\n";
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(command_event_make(200, 0));
             return;
         }
     // note: a problem was identified with the DMA: when switching from tx to rx or rx to tx mode
@@ -619,7 +657,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Cannot open loop device\n";
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(command_event_make(200, 0));
             return;
         }
 
@@ -816,19 +854,31 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         }
 
     // Stop the receiver
-    queue->push(pmt::make_any(command_event_make(200, 0)));
+    queue->push(command_event_make(200, 0));
 }
 
 
 void Ad9361FpgaSignalSource::run_dynamic_bit_selection_process()
 {
     bool dynamic_bit_selection_active = true;
+    // wake up as soon as the signal power leaves the thresholds, if the FPGA raises power events
+    const bool power_events = dynamic_bit_selection_fpga->enable_power_events();
+    uint32_t period_ms = dynamic_bit_selection_min_period_ms_;
 
     while (dynamic_bit_selection_active)
         {
             // setting the bit selection to the top bits
-            dynamic_bit_selection_fpga->bit_selection();
-            std::this_thread::sleep_for(std::chrono::milliseconds(Gain_control_period_ms));
+            const bool changed = dynamic_bit_selection_fpga->bit_selection();
+            // adaptive period: short while the bit selection converges, doubled up to the maximum when it is stable
+            period_ms = changed ? dynamic_bit_selection_min_period_ms_ : std::min(2 * period_ms, dynamic_bit_selection_max_period_ms_);
+            if (power_events)
+                {
+                    dynamic_bit_selection_fpga->wait_power_event(period_ms);
+                }
+            else
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+                }
             std::unique_lock<std::mutex> lock(dynamic_bit_selection_mutex);
             if (enable_dynamic_bit_selection_ == false)
                 {
@@ -861,18 +911,24 @@ void Ad9361FpgaSignalSource::run_buffer_monitor_process()
 
 void Ad9361FpgaSignalSource::connect(gr::top_block_sptr top_block)
 {
-    if (top_block)
-        { /* top_block is not null */
-        };
+    if (sample_tap_file_sink_)
+        {
+            top_block->connect(sample_tap_, 0, sample_tap_file_sink_, 0);
+            DLOG(INFO) << "connected the FPGA sample tap to file sink";
+            return;
+        }
     DLOG(INFO) << "AD9361 FPGA source nothing to connect";
 }
 
 
 void Ad9361FpgaSignalSource::disconnect(gr::top_block_sptr top_block)
 {
-    if (top_block)
-        { /* top_block is not null */
-        };
+    if (sample_tap_file_sink_)
+        {
+            top_block->disconnect(sample_tap_, 0, sample_tap_file_sink_, 0);
+            DLOG(INFO) << "disconnected the FPGA sample tap from file sink";
+            return;
+        }
     DLOG(INFO) << "AD9361 FPGA source nothing to disconnect";
 }
 
@@ -884,7 +940,31 @@ gr::basic_block_sptr Ad9361FpgaSignalSource::get_left_block()
 }
 
 
+std::vector<std::pair<std::string, double>> Ad9361FpgaSignalSource::metrics() const
+{
+    std::vector<std::pair<std::string, double>> result;
+    if (dynamic_bit_selection_fpga != nullptr)
+        {
+            const Fpga_dynamic_bit_selection::Stats stats = dynamic_bit_selection_fpga->stats();
+            for (size_t band = 0; band < num_freq_bands_ and band < stats.shift_out_bits.size(); band++)
+                {
+                    result.emplace_back("bit_selection_shift_band" + std::to_string(band + 1), stats.shift_out_bits[band]);
+                    result.emplace_back("bit_selection_power_band" + std::to_string(band + 1), stats.rx_signal_power[band]);
+                }
+            result.emplace_back("bit_selection_updates_total", static_cast<double>(stats.updates));
+            result.emplace_back("bit_selection_adjustments_total", static_cast<double>(stats.adjustments));
+            result.emplace_back("bit_selection_power_events_total", static_cast<double>(stats.interrupts));
+        }
+    if (sample_tap_ != nullptr)
+        {
+            result.emplace_back("sample_tap_dropped_bytes_total", static_cast<double>(sample_tap_->dropped_bytes()));
+        }
+    return result;
+}
+
+
 gr::basic_block_sptr Ad9361FpgaSignalSource::get_right_block()
 {
-    return {};
+    // null unless the sample tap is enabled
+    return sample_tap_;
 }
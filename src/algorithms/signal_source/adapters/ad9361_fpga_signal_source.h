@@ -21,18 +21,22 @@
 #ifndef GNSS_SDR_AD9361_FPGA_SIGNAL_SOURCE_H
 #define GNSS_SDR_AD9361_FPGA_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "fpga_buffer_monitor.h"
 #include "fpga_dynamic_bit_selection.h"
+#include "fpga_sample_tap_source.h"
 #include "fpga_switch.h"
 #include "gnss_block_interface.h"
 #include "signal_source_base.h"
+#include <gnuradio/blocks/file_sink.h>
 #include <pmt/pmt.h>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 
 /** \addtogroup Signal_Source
@@ -48,7 +52,7 @@ class Ad9361FpgaSignalSource : public SignalSourceBase
 public:
     Ad9361FpgaSignalSource(const ConfigurationInterface *configuration,
         const std::string &role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t> *queue);
+        unsigned int out_stream, Control_Queue *queue);
 
     ~Ad9361FpgaSignalSource();
 
@@ -64,10 +68,13 @@ public:
     gr::basic_block_sptr get_left_block() override;
     gr::basic_block_sptr get_right_block() override;
 
+    std::vector<std::pair<std::string, double>> metrics() const override;
+
 private:
     const std::string switch_device_name = std::string("AXIS_Switch_v1_0_0");          // Switch UIO device name
     const std::string dyn_bit_sel_device_name = std::string("dynamic_bits_selector");  // Switch dhnamic bit selector device name
     const std::string buffer_monitor_device_name = std::string("buffer_monitor");      // buffer monitor device name
+    const std::string sample_tap_device_name = std::string("sample_tap");              // sample tap device name
     const std::string default_dump_filename = std::string("FPGA_buffer_monitor_dump.dat");
     const std::string default_rf_port_select = std::string("A_BALANCED");
     const std::string default_gain_mode = std::string("slow_attack");
@@ -76,14 +83,17 @@ private:
     const double default_manual_gain_rx2 = 64.0;
     const uint64_t default_bandwidth = 12500000;
 
-    // perform dynamic bit selection every 500 ms by default
-    const uint32_t Gain_control_period_ms = 500;
+    // perform dynamic bit selection every 50 ms while the signal power changes, and up to every 500 ms when it is stable
+    const uint32_t Gain_control_min_period_ms = 50;
+    const uint32_t Gain_control_max_period_ms = 500;
     // check buffer overflow and perform buffer monitoring every 1s by default
     const uint32_t buffer_monitor_period_ms = 1000;
     // buffer overflow and buffer monitoring initial delay
     const uint32_t buffer_monitoring_initial_delay_ms = 2000;
     // sample block size when running in post-processing mode
     const int sample_block_size = 16384;
+    // interrupt of the sample tap every 64 KiB by default
+    const uint32_t default_sample_tap_irq_bytes = 65536;
 
     void run_DMA_process(const std::string &filename0,
         const std::string &filename1,
@@ -92,7 +102,7 @@ private:
         int64_t &samples,
         bool &repeat,
         uint32_t &dma_buff_offset_pos,
-        Concurrent_Queue<pmt::pmt_t> *queue);
+        Control_Queue *queue);
 
     void run_dynamic_bit_selection_process();
     void run_buffer_monitor_process();
@@ -105,11 +115,15 @@ private:
     std::shared_ptr<Fpga_dynamic_bit_selection> dynamic_bit_selection_fpga;
     std::shared_ptr<Fpga_buffer_monitor> buffer_monitor_fpga;
 
+    // host-side access to the samples processed by the FPGA
+    fpga_sample_tap_source_sptr sample_tap_;
+    gr::blocks::file_sink::sptr sample_tap_file_sink_;
+
     std::mutex dma_mutex;
     std::mutex dynamic_bit_selection_mutex;
     std::mutex buffer_monitor_mutex;
 
-    Concurrent_Queue<pmt::pmt_t> *queue_;
+    Control_Queue *queue_;
 
     // Front-end settings
     std::string gain_mode_rx1_;
@@ -143,6 +157,8 @@ private:
     size_t item_size_;
     uint32_t in_stream_;
     uint32_t out_stream_;
+    uint32_t dynamic_bit_selection_min_period_ms_;
+    uint32_t dynamic_bit_selection_max_period_ms_;
     int32_t switch_position_;
     bool enable_dds_lo_;
 
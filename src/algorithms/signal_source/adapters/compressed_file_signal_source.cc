@@ -0,0 +1,157 @@
+/*!
+ * \file compressed_file_signal_source.cc
+ * \brief Signal source that replays compressed captures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_string_literals.h"
+#include "gnss_sdr_valve.h"
+#include <glog/logging.h>
+#include <cmath>      // for std::floor
+#include <fstream>    // for std::ifstream
+#include <iostream>   // for std::cerr
+#include <stdexcept>  // for std::runtime_error
+
+using namespace std::string_literals;
+
+
+CompressedFileSignalSource::CompressedFileSignalSource(const ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_stream, unsigned int out_stream,
+    Control_Queue* queue)
+    : SignalSourceBase(configuration, role, "Compressed_File_Signal_Source"s),
+      filename_(configuration->property(role + ".filename"s, "../data/example_capture.zcap"s)),
+      samples_(configuration->property(role + ".samples"s, uint64_t(0))),
+      item_size_(0),
+      in_stream_(in_stream),
+      out_stream_(out_stream),
+      enable_throttle_control_(configuration->property(role + ".enable_throttle_control"s, false))
+{
+    // override value with commandline flag, if present
+    if (FLAGS_signal_source != "-")
+        {
+            filename_ = FLAGS_signal_source;
+        }
+    if (FLAGS_s != "-")
+        {
+            filename_ = FLAGS_s;
+        }
+
+    const bool repeat = configuration->property(role + ".repeat"s, false);
+    const double seconds_to_skip = repeat ? 0.0 : configuration->property(role + ".seconds_to_skip"s, 0.0);
+    const int threads = configuration->property(role + ".threads"s, 0);
+
+    // The header is read first, to convert seconds to items
+    std::ifstream file(filename_, std::ios::in | std::ios::binary);
+    CompressedCaptureHeader header;
+    if (!file.is_open() || !header.read(file))
+        {
+            std::cerr << "The receiver was configured to work with a compressed capture,\n"
+                      << "but " << filename_ << " is unreachable or it is not a compressed capture.\n"
+                      << "Please point " << role << ".filename to a valid file.\n";
+            LOG(ERROR) << "Unable to read the compressed capture " << filename_;
+            throw std::runtime_error("Unable to read the compressed capture " + filename_);
+        }
+    file.close();
+
+    int64_t sampling_frequency = header.sampling_frequency;
+    if (sampling_frequency == 0)
+        {
+            sampling_frequency = configuration->property(role + ".sampling_frequency"s, int64_t(0));
+        }
+    const auto items_to_skip = static_cast<uint64_t>(std::floor(seconds_to_skip * static_cast<double>(sampling_frequency)));
+
+    file_source_ = make_compressed_file_source(filename_, items_to_skip, repeat, threads);
+    item_type_ = header.item_type;
+    item_size_ = header.item_size;
+    DLOG(INFO) << "compressed_file_source(" << file_source_->unique_id() << ") item type " << item_type_;
+
+    if (samples_ == 0 && !repeat && header.total_items > items_to_skip)
+        {
+            samples_ = header.total_items - items_to_skip;
+        }
+    if (samples_ != 0)
+        {
+            // the valve stops the receiver when the samples have been processed
+            valve_ = gnss_sdr_make_valve(item_size_, samples_, queue);
+            DLOG(INFO) << "valve(" << valve_->unique_id() << ")";
+        }
+    else
+        {
+            LOG(WARNING) << filename_ << " does not record its length, reading it until the end";
+        }
+
+    if (enable_throttle_control_)
+        {
+            throttle_ = gr::blocks::throttle::make(item_size_, static_cast<double>(sampling_frequency));
+        }
+
+    if (in_stream_ > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_stream_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void CompressedFileSignalSource::connect(gr::top_block_sptr top_block)
+{
+    gr::basic_block_sptr output = file_source_;
+    if (throttle_)
+        {
+            top_block->connect(output, 0, throttle_, 0);
+            DLOG(INFO) << "connected compressed file source to throttle";
+            output = throttle_;
+        }
+    if (valve_)
+        {
+            top_block->connect(output, 0, valve_, 0);
+            DLOG(INFO) << "connected source to valve";
+        }
+}
+
+
+void CompressedFileSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    gr::basic_block_sptr output = file_source_;
+    if (throttle_)
+        {
+            top_block->disconnect(output, 0, throttle_, 0);
+            output = throttle_;
+        }
+    if (valve_)
+        {
+            top_block->disconnect(output, 0, valve_, 0);
+        }
+}
+
+
+gr::basic_block_sptr CompressedFileSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr CompressedFileSignalSource::get_right_block()
+{
+    // clang-format off
+    if (valve_) { return valve_; }
+    if (throttle_) { return throttle_; }
+    return file_source_;
+    // clang-format on
+}
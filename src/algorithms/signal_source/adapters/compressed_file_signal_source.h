@@ -0,0 +1,88 @@
+/*!
+ * \file compressed_file_signal_source.h
+ * \brief Signal source that replays compressed captures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
+#define GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
+
+#include "compressed_file_source.h"
+#include "control_queue.h"
+#include "gnss_block_interface.h"
+#include "signal_source_base.h"
+#include <gnuradio/blocks/throttle.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Reads a compressed capture, as recorded with the dump_compression=zstd
+ * option of the file and UHD signal sources.
+ *
+ * The item type and the sampling frequency are taken from the file header.
+ * This class supports the following properties:
+ *
+ *   .filename - the path to the input file
+ *   .samples  - number of samples to process (default 0: the whole file)
+ *   .seconds_to_skip - number of seconds of lead-in data to skip over (default 0)
+ *   .repeat   - whether to rewind and continue at end of file (default false)
+ *   .enable_throttle_control - whether to throttle to the sampling frequency (default false)
+ *   .threads  - number of decompression threads (default 0: one per CPU core)
+ */
+class CompressedFileSignalSource : public SignalSourceBase
+{
+public:
+    CompressedFileSignalSource(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_stream,
+        unsigned int out_stream, Control_Queue* queue);
+
+    ~CompressedFileSignalSource() = default;
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    compressed_file_source_sptr file_source_;
+    gr::blocks::throttle::sptr throttle_;
+    gnss_shared_ptr<gr::block> valve_;
+
+    std::string filename_;
+    std::string item_type_;
+    uint64_t samples_;
+    size_t item_size_;
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+    bool enable_throttle_control_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_SIGNAL_SOURCE_H
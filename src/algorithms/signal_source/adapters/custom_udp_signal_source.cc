@@ -26,7 +26,7 @@ using namespace std::string_literals;
 
 CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue __attribute__((unused)))
+    Control_Queue* queue __attribute__((unused)))
     : SignalSourceBase(configuration, role, "Custom_UDP_Signal_Source"s),
       item_size_(sizeof(gr_complex)),
       in_stream_(in_stream),
@@ -55,6 +55,10 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
     const std::string sample_type = configuration->property(role + ".sample_type", default_sample_type);
     item_type_ = configuration->property(role + ".item_type", default_item_type);
 
+    // "pcap" (libpcap capture thread) or "packet_mmap" (Linux TPACKET_V3 ring)
+    const std::string default_capture_backend("pcap");
+    const std::string capture_backend = configuration->property(role + ".capture_backend", default_capture_backend);
+
     udp_gnss_rx_source_ = Gr_Complex_Ip_Packet_Source::make(capture_device,
         address,
         port,
@@ -62,7 +66,8 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
         channels_in_udp_,
         sample_type,
         item_size_,
-        IQ_swap_);
+        IQ_swap_,
+        capture_backend);
 
     if (channels_in_udp_ >= RF_channels_)
         {
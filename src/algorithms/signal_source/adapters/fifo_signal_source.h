@@ -19,7 +19,7 @@
 #ifndef GNSS_SDR_FIFO_SIGNAL_SOURCE_H
 #define GNSS_SDR_FIFO_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "signal_source_base.h"
 #include <pmt/pmt.h>
 #include <cstddef>
@@ -52,7 +52,7 @@ class FifoSignalSource : public SignalSourceBase
 public:
     FifoSignalSource(const ConfigurationInterface* configuration, const std::string& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~FifoSignalSource() = default;
 
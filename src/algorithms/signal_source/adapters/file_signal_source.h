@@ -43,7 +43,7 @@ class FileSignalSource : public FileSourceBase
 public:
     FileSignalSource(ConfigurationInterface const* configuration, std::string const& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~FileSignalSource() = default;
 
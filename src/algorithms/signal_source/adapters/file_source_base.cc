@@ -29,6 +29,10 @@
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
+#include "mmap_file_source.h"
+#if ENABLE_ZSTD
+#include "compressed_file_sink.h"
+#endif
 #include <glog/logging.h>
 #include <algorithm>  // for std::max
 #include <cmath>      // for ceil, floor
@@ -39,7 +43,7 @@
 using namespace std::string_literals;
 
 FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std::string const& role, std::string impl,
-    Concurrent_Queue<pmt::pmt_t>* queue,
+    Control_Queue* queue,
     std::string default_item_type)
     : SignalSourceBase(configuration, role, std::move(impl)),
       queue_(queue),
@@ -47,16 +51,21 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
       filename_(configuration->property(role_ + ".filename"s, "../data/example_capture.dat"s)),
       dump_filename_(configuration->property(role_ + ".dump_filename"s, "../data/my_capture.dat"s)),
       item_type_(configuration->property(role_ + ".item_type"s, std::move(default_item_type))),
+      io_backend_(configuration->property(role_ + ".io_backend"s, "stdio"s)),
+      index_filename_(configuration->property(role_ + ".index_filename"s, ""s)),
+      dump_compression_(configuration->property(role_ + ".dump_compression"s, "none"s)),
       item_size_(0),
       header_size_(configuration->property(role_ + ".header_size"s, uint64_t(0))),
       samples_(configuration->property(role_ + ".samples"s, uint64_t(0))),
       sampling_frequency_(configuration->property(role_ + ".sampling_frequency"s, int64_t(0))),
+      dump_compression_level_(configuration->property(role_ + ".dump_compression_level"s, 3)),
       minimum_tail_s_(0.1),
       seconds_to_skip_(configuration->property(role_ + ".seconds_to_skip"s, 0.0)),
       is_complex_(false),
       repeat_(configuration->property(role_ + ".repeat"s, false)),
       enable_throttle_control_(configuration->property(role_ + ".enable_throttle_control"s, false)),
-      dump_(configuration->property(role_ + ".dump"s, false))
+      dump_(configuration->property(role_ + ".dump"s, false)),
+      capture_index_loaded_(false)
 {
     minimum_tail_s_ = std::max(configuration->property("Acquisition_1C.coherent_integration_time_ms", 0.0) * 0.001 * 2.0, minimum_tail_s_);
     minimum_tail_s_ = std::max(configuration->property("Acquisition_2S.coherent_integration_time_ms", 0.0) * 0.001 * 2.0, minimum_tail_s_);
@@ -102,6 +111,15 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
         {
             filename_ = FLAGS_s;
         }
+    if (index_filename_.empty())
+        {
+            index_filename_ = filename_ + ".idx";
+        }
+    if (io_backend_ != "stdio" && io_backend_ != "mmap")
+        {
+            std::cout << "Warning: " << role_ << ".io_backend=" << io_backend_ << " is not a valid option, using stdio.\n";
+            io_backend_ = "stdio";
+        }
     if (sampling_frequency_ == 0)
         {
             std::cerr << "Warning: parameter " << role_ << ".sampling_frequency is not set, this could lead to wrong results.\n"
@@ -135,6 +153,7 @@ void FileSourceBase::init()
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "I/O backend " << io_backend_;
 
     DLOG(INFO) << "Dump " << dump_;
     DLOG(INFO) << "Dump filename " << dump_filename_;
@@ -304,6 +323,83 @@ uint64_t FileSourceBase::samples() const
 }
 
 
+bool FileSourceBase::seek_to_seconds(double seconds)
+{
+    if (seconds < 0.0 || sampling_frequency_ == 0)
+        {
+            return false;
+        }
+    auto item = static_cast<uint64_t>(std::ceil(seconds * static_cast<double>(sampling_frequency_) / packetsPerSample()));
+    if (is_complex())
+        {
+            item *= 2;
+        }
+    return seek_to_item(header_size_ + item);
+}
+
+
+bool FileSourceBase::seek_to_time(int32_t week, double tow_s)
+{
+    if (!capture_index_loaded_)
+        {
+            // the index may have been written after the receiver started, so keep trying
+            capture_index_loaded_ = capture_index_.load(index_filename_);
+            if (!capture_index_loaded_)
+                {
+                    LOG(WARNING) << "Unable to read the capture index " << index_filename_;
+                    return false;
+                }
+        }
+
+    CaptureIndexRecord record{};
+    if (!capture_index_.find(week, tow_s, record))
+        {
+            LOG(WARNING) << "Week " << week << ", TOW " << tow_s << " s is before the first record of " << index_filename_;
+            return false;
+        }
+
+    // advance from the record to the requested time at the sampling rate
+    const double seconds_after_record = static_cast<double>(week) * 604800.0 + tow_s - CaptureIndex::record_time_s(record);
+    auto items_after_record = static_cast<uint64_t>(std::ceil(seconds_after_record * static_cast<double>(sampling_frequency_) / packetsPerSample()));
+    if (is_complex())
+        {
+            items_after_record *= 2;
+        }
+    return seek_to_item(record.item + items_after_record);
+}
+
+
+bool FileSourceBase::seek_to_item(uint64_t item)
+{
+    if (!file_source_)
+        {
+            return false;
+        }
+    if (item * item_size() >= fs::file_size(filename()))
+        {
+            LOG(WARNING) << "Cannot seek to item " << item << ", it is beyond the end of " << filename();
+            return false;
+        }
+
+    auto* mmap_source = dynamic_cast<mmap_file_source*>(file_source_.get());
+    if (mmap_source != nullptr)
+        {
+            mmap_source->seek(item);
+        }
+    else
+        {
+            auto* file_source = dynamic_cast<gr::blocks::file_source*>(file_source_.get());
+            if (file_source == nullptr || !file_source->seek(static_cast<int64_t>(item), SEEK_SET))
+                {
+                    LOG(WARNING) << "Error seeking to item " << item << " of " << filename();
+                    return false;
+                }
+        }
+    LOG(INFO) << "Seeking to item " << item << " of " << filename();
+    return true;
+}
+
+
 std::tuple<size_t, bool> FileSourceBase::itemTypeToSize()
 {
     auto is_interleaved = false;
@@ -455,6 +551,9 @@ size_t FileSourceBase::source_item_size() const
 
 
 bool FileSourceBase::is_complex() const { return is_complex_; }
+std::string FileSourceBase::index_filename() const { return index_filename_; }
+std::string FileSourceBase::dump_filename() const { return dump_filename_; }
+bool FileSourceBase::dump() const { return dump_; }
 
 
 // Simple accessors
@@ -465,7 +564,7 @@ gnss_shared_ptr<gr::block> FileSourceBase::throttle() const { return throttle_;
 gnss_shared_ptr<gr::block> FileSourceBase::sink() const { return sink_; }
 
 
-gr::blocks::file_source::sptr FileSourceBase::create_file_source()
+gnss_shared_ptr<gr::block> FileSourceBase::create_file_source()
 {
     auto item_tuple = itemTypeToSize();
     item_size_ = std::get<0>(item_tuple);
@@ -476,15 +575,23 @@ gr::blocks::file_source::sptr FileSourceBase::create_file_source()
             // TODO: why are we manually seeking, instead of passing the samples_to_skip to the file_source factory?
             auto samples_to_skip = samplesToSkip();
 
-            file_source_ = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
-
             if (samples_to_skip > 0)
                 {
                     LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
-                    if (!file_source_->seek(samples_to_skip, SEEK_SET))
+                }
+
+            if (io_backend_ == "mmap")
+                {
+                    file_source_ = make_mmap_file_source(item_size(), filename(), samples_to_skip, repeat());
+                }
+            else
+                {
+                    auto file_source = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
+                    if (samples_to_skip > 0 && !file_source->seek(samples_to_skip, SEEK_SET))
                         {
                             LOG(ERROR) << "Error skipping bytes!";
                         }
+                    file_source_ = file_source;
                 }
         }
     catch (const std::exception& e)
@@ -546,11 +653,25 @@ gnss_shared_ptr<gr::block> FileSourceBase::create_valve()
 }
 
 
-gr::blocks::file_sink::sptr FileSourceBase::create_sink()
+gnss_shared_ptr<gr::block> FileSourceBase::create_sink()
 {
     if (dump_)
         {
-            sink_ = gr::blocks::file_sink::make(source_item_size(), dump_filename_.c_str());
+#if ENABLE_ZSTD
+            if (dump_compression_ == "zstd")
+                {
+                    sink_ = make_compressed_file_sink(source_item_size(), dump_filename_, item_type_, sampling_frequency_,
+                        CompressedCaptureHeader::DEFAULT_CHUNK_ITEMS, dump_compression_level_, 0, "source="s + filename_ + "\n"s);
+                }
+            else
+#endif
+                {
+                    if (dump_compression_ != "none")
+                        {
+                            LOG(WARNING) << role_ << ".dump_compression=" << dump_compression_ << " is not available, dumping uncompressed samples";
+                        }
+                    sink_ = gr::blocks::file_sink::make(source_item_size(), dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << sink_->unique_id() << ")";
 
             // enable subclass hooks
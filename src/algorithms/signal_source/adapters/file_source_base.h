@@ -18,13 +18,15 @@
 #ifndef GNSS_SDR_FILE_SOURCE_BASE_H
 #define GNSS_SDR_FILE_SOURCE_BASE_H
 
-#include "concurrent_queue.h"
+#include "capture_index.h"
+#include "control_queue.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>  // for dump
 #include <gnuradio/blocks/file_source.h>
 #include <gnuradio/blocks/throttle.h>
 #include <pmt/pmt.h>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <tuple>
 
@@ -58,11 +60,22 @@ class ConfigurationInterface;
 //!
 //!   .repeat   - whether to rewind and continue at end of file (default false)
 //!
+//!   .io_backend - how the file is read (default "stdio")
+//!             - "stdio" reads it with a gr::blocks::file_source
+//!             - "mmap" maps it into memory, which is faster for very large files on fast disks
+//!
+//!   .index_filename - capture index used to seek to a GNSS time (default: the filename plus ".idx")
+//!
 //! (probably abstracted to the base class)
 //!
 //!   .dump     - whether to archive input data
 //!
 //!   .dump_filename - if dumping, path to file for output
+//!
+//!   .dump_compression - format of the dump file (default "none")
+//!             - "zstd" records a compressed capture, readable by the Compressed_File_Signal_Source
+//!
+//!   .dump_compression_level - Zstandard level of the dump file (default 3)
 class FileSourceBase : public SignalSourceBase
 {
 public:
@@ -91,6 +104,12 @@ public:
     //! The number of samples in the file
     uint64_t samples() const;
 
+    //! Moves the read position to the given time from the beginning of the file
+    bool seek_to_seconds(double seconds) override;
+
+    //! Moves the read position to the given GNSS time, found in the capture index
+    bool seek_to_time(int32_t week, double tow_s) override;
+
 protected:
     //! \brief Constructor
     //!
@@ -98,7 +117,7 @@ protected:
     //! type supported. Rather than require the item type to be specified in the config file, allow
     //! sub-classes to impose their will
     FileSourceBase(ConfigurationInterface const* configuration, std::string const& role, std::string impl,
-        Concurrent_Queue<pmt::pmt_t>* queue,
+        Control_Queue* queue,
         std::string default_item_type = "short");
 
     //! Perform post-construction initialization
@@ -126,6 +145,11 @@ protected:
     virtual size_t source_item_size() const;
     bool is_complex() const;
 
+    //! The capture index of the file, and the dump file, if enabled
+    std::string index_filename() const;
+    std::string dump_filename() const;
+    bool dump() const;
+
     // Generic access to created objects
     gnss_shared_ptr<gr::block> file_source() const;
     gnss_shared_ptr<gr::block> valve() const;
@@ -134,10 +158,10 @@ protected:
 
     // The methods create the various blocks, if enabled, and return access to them. The created
     // object is also held in this class
-    gr::blocks::file_source::sptr create_file_source();
+    gnss_shared_ptr<gr::block> create_file_source();
     gr::blocks::throttle::sptr create_throttle();
     gnss_shared_ptr<gr::block> create_valve();
-    gr::blocks::file_sink::sptr create_sink();
+    gnss_shared_ptr<gr::block> create_sink();
 
     // Subclass hooks to augment created objects, as required
     virtual void create_file_source_hook();
@@ -152,9 +176,12 @@ protected:
     virtual void post_disconnect_hook(gr::top_block_sptr top_block);
 
 private:
-    gr::blocks::file_source::sptr file_source_;
+    //! Moves the read position to the given item of the file
+    bool seek_to_item(uint64_t item);
+
+    gnss_shared_ptr<gr::block> file_source_;
     gr::blocks::throttle::sptr throttle_;
-    gr::blocks::file_sink::sptr sink_;
+    gnss_shared_ptr<gr::block> sink_;
 
     // The valve allows only the configured number of samples through, then it closes.
 
@@ -163,22 +190,29 @@ private:
     // beyond its lifetime. Fortunately, the queue is only used to create the valve, so the
     // likelihood of holding a stale pointer is mitigated
     gnss_shared_ptr<gr::block> valve_;
-    Concurrent_Queue<pmt::pmt_t>* queue_;
+    Control_Queue* queue_;
+
+    CaptureIndex capture_index_;
 
     std::string role_;
     std::string filename_;
     std::string dump_filename_;
     std::string item_type_;
+    std::string io_backend_;
+    std::string index_filename_;
+    std::string dump_compression_;
     size_t item_size_;
     size_t header_size_;  // length (in samples) of the header (if any)
     uint64_t samples_;
     int64_t sampling_frequency_;  // why is this signed
+    int dump_compression_level_;
     double minimum_tail_s_;
     double seconds_to_skip_;
     bool is_complex_;  // a misnomer; if I/Q are interleaved as integer values
     bool repeat_;
     bool enable_throttle_control_;
     bool dump_;
+    bool capture_index_loaded_;
 };
 
 /** \} */
@@ -24,10 +24,11 @@ using namespace std::string_literals;
 
 FileTimestampSignalSource::FileTimestampSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_streams, unsigned int out_streams,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
     : FileSourceBase(configuration, role, "File_Timestamp_Signal_Source"s, queue, "byte"s),
       timestamp_file_(configuration->property(role + ".timestamp_filename"s, "../data/example_capture_timestamp.dat"s)),
-      timestamp_clock_offset_ms_(configuration->property(role + ".timestamp_clock_offset_ms"s, 0.0))
+      timestamp_clock_offset_ms_(configuration->property(role + ".timestamp_clock_offset_ms"s, 0.0)),
+      write_index_(configuration->property(role + ".write_index"s, false))
 {
     if (in_streams > 0)
         {
@@ -56,6 +57,17 @@ void FileTimestampSignalSource::create_file_source_hook()
         timestamp_file_,
         timestamp_clock_offset_ms_);
     DLOG(INFO) << "timestamp_block_(" << timestamp_block_->unique_id() << ")";
+
+    if (write_index_)
+        {
+            // the stream starts after the skipped items of the input file,
+            // and at the first item of the dump file
+            timestamp_block_->add_index(index_filename(), samplesToSkip());
+            if (dump())
+                {
+                    timestamp_block_->add_index(dump_filename() + ".idx", 0);
+                }
+        }
 }
 
 void FileTimestampSignalSource::pre_connect_hook(gr::top_block_sptr top_block)
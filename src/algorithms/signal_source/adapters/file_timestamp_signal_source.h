@@ -32,13 +32,17 @@
 /*!
  * \brief Class that reads signals samples from a file
  * and adapts it to a SignalSourceInterface
+ *
+ * If role.write_index=true, each time tag is also written to the capture
+ * index of the file (see FileSourceBase), and to dump_filename + ".idx" if
+ * the samples are dumped, so that other runs can seek to a GNSS time.
  */
 class FileTimestampSignalSource : public FileSourceBase
 {
 public:
     FileTimestampSignalSource(const ConfigurationInterface* configuration, const std::string& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~FileTimestampSignalSource() = default;
 
@@ -54,6 +58,7 @@ private:
     gnss_shared_ptr<Gnss_Sdr_Timestamp> timestamp_block_;
     std::string timestamp_file_;
     double timestamp_clock_offset_ms_;
+    bool write_index_;
 };
 
 
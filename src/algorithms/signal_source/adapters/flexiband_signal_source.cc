@@ -31,7 +31,7 @@ FlexibandSignalSource::FlexibandSignalSource(const ConfigurationInterface* confi
     const std::string& role,
     unsigned int in_stream,
     unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue __attribute__((unused)))
+    Control_Queue* queue __attribute__((unused)))
     : SignalSourceBase(configuration, role, "Flexiband_Signal_Source"s), in_stream_(in_stream), out_stream_(out_stream)
 {
     const std::string default_item_type("byte");
@@ -20,7 +20,7 @@
 #ifndef GNSS_SDR_FLEXIBAND_SIGNAL_SOURCE_H
 #define GNSS_SDR_FLEXIBAND_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/char_to_float.h>
 #include <gnuradio/blocks/file_sink.h>
@@ -50,7 +50,7 @@ class FlexibandSignalSource : public SignalSourceBase
 public:
     FlexibandSignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~FlexibandSignalSource() = default;
 
@@ -34,7 +34,7 @@ using namespace std::string_literals;
 
 Fmcomms2SignalSource::Fmcomms2SignalSource(const ConfigurationInterface *configuration,
     const std::string &role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t> *queue)
+    Control_Queue *queue)
     : SignalSourceBase(configuration, role, "Fmcomms2_Signal_Source"s),
       item_type_(configuration->property(role + ".item_type", std::string("gr_complex"))),
       dump_filename_(configuration->property(role + ".dump_filename", std::string("./data/signal_source.dat"))),
@@ -52,6 +52,7 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(const ConfigurationInterface *configu
       sample_rate_(configuration->property(role + ".sampling_frequency", static_cast<uint64_t>(2600000))),
       bandwidth_(configuration->property(role + ".bandwidth", static_cast<uint64_t>(2000000))),
       buffer_size_(configuration->property(role + ".buffer_size", 0xA0000)),
+      kernel_buffers_(configuration->property(role + ".kernel_buffers", static_cast<uint32_t>(0))),
       Fpass_(configuration->property(role + ".Fpass", 0.0)),
       Fstop_(configuration->property(role + ".Fstop", 0.0)),
       in_stream_(in_stream),
@@ -70,6 +71,7 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(const ConfigurationInterface *configu
       rf_dc_(configuration->property(role + ".rf_dc", true)),
       bb_dc_(configuration->property(role + ".bb_dc", true)),
       filter_auto_(configuration->property(role + ".filter_auto", false)),
+      zero_copy_(configuration->property(role + ".zero_copy", false)),
       rf_shutdown_(configuration->property(role + ".rf_shutdown", FLAGS_rf_shutdown)),
       dump_(configuration->property(role + ".dump", false))
 {
@@ -165,7 +167,13 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(const ConfigurationInterface *configu
     std::cout << "LO frequency : " << freq_ << " Hz\n";
     std::cout << "sample rate: " << sample_rate_ << " Sps\n";
 
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "cshort")
+        {
+            // native samples are only available from the libiio buffers
+            zero_copy_ = true;
+        }
+
+    if (item_type_ == "gr_complex" or item_type_ == "cshort")
         {
             if (RF_channels_ == 1)
                 {
@@ -335,6 +343,26 @@ Fmcomms2SignalSource::Fmcomms2SignalSource(const ConfigurationInterface *configu
             LOG(FATAL) << "Configuration error: item type " << item_type_ << " not supported!";
         }
 
+    rx_source_ = fmcomms2_source_f32c_;
+    if (zero_copy_)
+        {
+            // the gr-iio block has configured the front-end, but it is not
+            // connected: the samples are read in place from the libiio buffers
+            std::vector<int> rx_channels;
+            if (rx1_en_)
+                {
+                    rx_channels.push_back(0);
+                }
+            if (rx2_en_)
+                {
+                    rx_channels.push_back(1);
+                }
+            iio_source_ = make_iio_rx_source(uri_, rx_channels, buffer_size_, kernel_buffers_, item_type_);
+            item_size_ = iio_source_->output_signature()->sizeof_stream_item(0);
+            rx_source_ = iio_source_;
+            std::cout << "streaming from the libiio buffers\n";
+        }
+
     if (samples_ != 0)
         {
             DLOG(INFO) << "Send STOP signal after " << samples_ << " samples";
@@ -387,7 +415,7 @@ void Fmcomms2SignalSource::connect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->connect(fmcomms2_source_f32c_, 0, valve_, 0);
+            top_block->connect(rx_source_, 0, valve_, 0);
             DLOG(INFO) << "connected fmcomms2 source to valve";
             if (dump_)
                 {
@@ -399,7 +427,7 @@ void Fmcomms2SignalSource::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(fmcomms2_source_f32c_, 0, file_sink_, 0);
+                    top_block->connect(rx_source_, 0, file_sink_, 0);
                     DLOG(INFO) << "connected fmcomms2 source to file sink";
                 }
         }
@@ -410,7 +438,7 @@ void Fmcomms2SignalSource::disconnect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->disconnect(fmcomms2_source_f32c_, 0, valve_, 0);
+            top_block->disconnect(rx_source_, 0, valve_, 0);
             if (dump_)
                 {
                     top_block->disconnect(valve_, 0, file_sink_, 0);
@@ -420,7 +448,7 @@ void Fmcomms2SignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(fmcomms2_source_f32c_, 0, file_sink_, 0);
+                    top_block->disconnect(rx_source_, 0, file_sink_, 0);
                 }
         }
 }
@@ -441,6 +469,6 @@ gr::basic_block_sptr Fmcomms2SignalSource::get_right_block()
         }
     else
         {
-            return (fmcomms2_source_f32c_);
+            return rx_source_;
         }
 }
@@ -27,7 +27,8 @@
 #else
 #include <iio/fmcomms2_source.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
+#include "iio_rx_source.h"
 #include <pmt/pmt.h>
 #include <cstdint>
 #include <string>
@@ -46,7 +47,7 @@ class Fmcomms2SignalSource : public SignalSourceBase
 public:
     Fmcomms2SignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~Fmcomms2SignalSource();
 
@@ -73,6 +74,8 @@ private:
 #else
     gr::iio::fmcomms2_source_f32c::sptr fmcomms2_source_f32c_;
 #endif
+    iio_rx_source_sptr iio_source_;
+    gr::basic_block_sptr rx_source_;  // the block that outputs the samples
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
 
@@ -97,6 +100,7 @@ private:
     uint64_t sample_rate_;
     uint64_t bandwidth_;
     uint64_t buffer_size_;  // reception buffer
+    unsigned int kernel_buffers_;  // 0 for the libiio default
     float Fpass_;
     float Fstop_;
     unsigned int in_stream_;
@@ -118,6 +122,7 @@ private:
     bool rf_dc_;
     bool bb_dc_;
     bool filter_auto_;
+    bool zero_copy_;  // stream from the libiio buffers instead of gr-iio
     bool rf_shutdown_;
     bool dump_;
 };
@@ -20,7 +20,7 @@
 #define GNSS_SDR_GEN_SIGNAL_SOURCE_H
 
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
 #include "signal_source_interface.h"
 #include <pmt/pmt.h>
@@ -43,7 +43,7 @@ class GenSignalSource : public SignalSourceInterface
 public:
     //! Constructor
     GenSignalSource(std::shared_ptr<GNSSBlockInterface> signal_generator, std::shared_ptr<GNSSBlockInterface> filter,
-        std::string role, Concurrent_Queue<pmt::pmt_t> *queue);
+        std::string role, Control_Queue *queue);
 
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
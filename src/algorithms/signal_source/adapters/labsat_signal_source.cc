@@ -25,7 +25,7 @@
 using namespace std::string_literals;
 
 LabsatSignalSource::LabsatSignalSource(const ConfigurationInterface* configuration,
-    const std::string& role, unsigned int in_stream, unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue)
+    const std::string& role, unsigned int in_stream, unsigned int out_stream, Control_Queue* queue)
     : SignalSourceBase(configuration, role, "Labsat_Signal_Source"s), in_stream_(in_stream), out_stream_(out_stream)
 {
     const std::string default_item_type("gr_complex");
@@ -64,10 +64,11 @@ LabsatSignalSource::LabsatSignalSource(const ConfigurationInterface* configurati
 
     const bool digital_io_enabled = configuration->property(role + ".digital_io_enabled", false);
 
-    if (item_type_ == "gr_complex")
+    if (item_type_ == "gr_complex" or item_type_ == "cshort" or item_type_ == "cbyte")
         {
-            item_size_ = sizeof(gr_complex);
-            labsat23_source_ = labsat23_make_source_sptr(filename_.c_str(), channels_selector_vec_, queue, digital_io_enabled);
+            // cshort and cbyte outputs are the quantization levels, for fixed-point processing
+            labsat23_source_ = labsat23_make_source_sptr(filename_.c_str(), channels_selector_vec_, queue, digital_io_enabled, item_type_);
+            item_size_ = labsat23_source_->output_signature()->sizeof_stream_item(0);
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "labsat23_source_(" << labsat23_source_->unique_id() << ")";
         }
@@ -18,7 +18,7 @@
 #ifndef GNSS_SDR_LABSAT_SIGNAL_SOURCE_H
 #define GNSS_SDR_LABSAT_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
@@ -46,7 +46,7 @@ class LabsatSignalSource : public SignalSourceBase
 public:
     LabsatSignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~LabsatSignalSource() = default;
 
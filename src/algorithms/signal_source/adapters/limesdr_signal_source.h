@@ -17,7 +17,7 @@
 #ifndef GNSS_SDR_LIMESDR_SIGNAL_SOURCE_H
 #define GNSS_SDR_LIMESDR_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <pmt/pmt.h>
@@ -44,7 +44,7 @@ class LimesdrSignalSource : public SignalSourceBase
 public:
     LimesdrSignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~LimesdrSignalSource() = default;
 
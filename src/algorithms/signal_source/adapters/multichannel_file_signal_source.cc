@@ -32,7 +32,7 @@ using namespace std::string_literals;
 
 MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_streams, unsigned int out_streams,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
     : SignalSourceBase(configuration, role, "Multichannel_File_Signal_Source"s), in_streams_(in_streams), out_streams_(out_streams)
 {
     const std::string default_filename("./example_capture.dat"s);
@@ -51,6 +51,7 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
 
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     repeat_ = configuration->property(role + ".repeat", false);
+    coordinated_read_ = configuration->property(role + ".coordinated_read", false);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
@@ -91,32 +92,40 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
                          << " unrecognized item type. Using gr_complex.";
             item_size_ = sizeof(gr_complex);
         }
-    try
+    if (seconds_to_skip > 0)
         {
-            for (int32_t n = 0; n < n_channels_; n++)
-                {
-                    file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
+            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
 
-                    if (seconds_to_skip > 0)
-                        {
-                            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
+            if (is_complex)
+                {
+                    samples_to_skip *= 2;
+                }
+        }
+    if (header_size > 0)
+        {
+            samples_to_skip += header_size;
+        }
 
-                            if (is_complex)
-                                {
-                                    samples_to_skip *= 2;
-                                }
-                        }
-                    if (header_size > 0)
+    try
+        {
+            if (coordinated_read_)
+                {
+                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input files";
+                    reader_ = make_multichannel_file_reader(item_size_, filename_vec_, samples_to_skip, repeat_);
+                }
+            else
+                {
+                    for (int32_t n = 0; n < n_channels_; n++)
                         {
-                            samples_to_skip += header_size;
-                        }
+                            file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
 
-                    if (samples_to_skip > 0)
-                        {
-                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
-                            if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                            if (samples_to_skip > 0)
                                 {
-                                    LOG(INFO) << "Error skipping bytes!";
+                                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
+                                    if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                                        {
+                                            LOG(INFO) << "Error skipping bytes!";
+                                        }
                                 }
                         }
                 }
@@ -214,6 +223,7 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Coordinated read " << coordinated_read_;
 
     if (in_streams_ > 0)
         {
@@ -232,7 +242,14 @@ void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->connect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                    if (coordinated_read_)
+                        {
+                            top_block->connect(reader_, n, throttle_vec_.at(n), 0);
+                        }
+                    else
+                        {
+                            top_block->connect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                        }
                     DLOG(INFO) << "connected file_source #" << n << " to throttle";
                     top_block->connect(throttle_vec_.at(n), 0, valve_, n);
                     DLOG(INFO) << "connected throttle #" << n << " to valve_";
@@ -242,7 +259,14 @@ void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->connect(file_source_vec_.at(n), 0, valve_, n);
+                    if (coordinated_read_)
+                        {
+                            top_block->connect(reader_, n, valve_, n);
+                        }
+                    else
+                        {
+                            top_block->connect(file_source_vec_.at(n), 0, valve_, n);
+                        }
                     DLOG(INFO) << "connected file_source #" << n << " to valve_";
                 }
         }
@@ -255,7 +279,14 @@ void MultichannelFileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->disconnect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                    if (coordinated_read_)
+                        {
+                            top_block->disconnect(reader_, n, throttle_vec_.at(n), 0);
+                        }
+                    else
+                        {
+                            top_block->disconnect(file_source_vec_.at(n), 0, throttle_vec_.at(n), 0);
+                        }
                     DLOG(INFO) << "disconnected file_source #" << n << " to throttle";
                     top_block->disconnect(throttle_vec_.at(n), 0, valve_, n);
                     DLOG(INFO) << "disconnected throttle #" << n << " to valve_";
@@ -265,7 +296,14 @@ void MultichannelFileSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    top_block->disconnect(file_source_vec_.at(n), 0, valve_, n);
+                    if (coordinated_read_)
+                        {
+                            top_block->disconnect(reader_, n, valve_, n);
+                        }
+                    else
+                        {
+                            top_block->disconnect(file_source_vec_.at(n), 0, valve_, n);
+                        }
                     DLOG(INFO) << "disconnected file_source #" << n << " to valve_";
                 }
         }
@@ -21,8 +21,9 @@
 #ifndef GNSS_SDR_MULTICHANNEL_FILE_SIGNAL_SOURCE_H
 #define GNSS_SDR_MULTICHANNEL_FILE_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
+#include "multichannel_file_reader.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/file_source.h>
@@ -45,13 +46,18 @@ class ConfigurationInterface;
 /*!
  * \brief Class that reads signals samples from files at different frequency bands
  * and adapts it to a SignalSourceInterface
+ *
+ * If role.coordinated_read=true, all the files are read by a single
+ * multichannel_file_reader, which keeps them aligned and reads them in large
+ * blocks, one file after the other. Otherwise, each file has its own
+ * gr::blocks::file_source.
  */
 class MultichannelFileSignalSource : public SignalSourceBase
 {
 public:
     MultichannelFileSignalSource(const ConfigurationInterface* configuration, const std::string& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~MultichannelFileSignalSource() = default;
 
@@ -92,6 +98,7 @@ public:
 
 private:
     std::vector<gr::blocks::file_source::sptr> file_source_vec_;
+    multichannel_file_reader_sptr reader_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr sink_;
     std::vector<gr::blocks::throttle::sptr> throttle_vec_;
@@ -104,6 +111,7 @@ private:
     uint32_t in_streams_;
     uint32_t out_streams_;
     bool repeat_;
+    bool coordinated_read_;
     // Throttle control
     bool enable_throttle_control_;
 };
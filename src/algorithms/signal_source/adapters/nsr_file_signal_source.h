@@ -43,7 +43,7 @@ class NsrFileSignalSource : public FileSourceBase
 public:
     NsrFileSignalSource(const ConfigurationInterface* configuration, const std::string& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~NsrFileSignalSource() = default;
 
@@ -31,7 +31,7 @@ using namespace std::string_literals;
 
 OsmosdrSignalSource::OsmosdrSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
     : SignalSourceBase(configuration, role, "Osmosdr_Signal_Source"s),
       item_type_(configuration->property(role + ".item_type", std::string("gr_complex"))),
       dump_filename_(configuration->property(role + ".dump_filename", std::string("./data/signal_source.dat"))),
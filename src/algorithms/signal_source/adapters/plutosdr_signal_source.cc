@@ -29,7 +29,7 @@ using namespace std::string_literals;
 
 PlutosdrSignalSource::PlutosdrSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
     : SignalSourceBase(configuration, role, "Plutosdr_Signal_Source"s),
       dump_filename_(configuration->property(role + ".dump_filename", std::string("./data/signal_source.dat"))),
       uri_(configuration->property(role + ".device_address", std::string("192.168.2.1"))),
@@ -44,6 +44,7 @@ PlutosdrSignalSource::PlutosdrSignalSource(const ConfigurationInterface* configu
       bandwidth_(configuration->property(role + ".bandwidth", static_cast<uint64_t>(2000000))),
       buffer_size_(configuration->property(role + ".buffer_size", 0xA0000)),
       item_size_(sizeof(gr_complex)),
+      kernel_buffers_(configuration->property(role + ".kernel_buffers", static_cast<uint32_t>(0))),
       Fpass_(configuration->property(role + ".Fpass", 0.0)),
       Fstop_(configuration->property(role + ".Fstop", 0.0)),
       in_stream_(in_stream),
@@ -52,6 +53,7 @@ PlutosdrSignalSource::PlutosdrSignalSource(const ConfigurationInterface* configu
       rf_dc_(configuration->property(role + ".rf_dc", true)),
       bb_dc_(configuration->property(role + ".bb_dc", true)),
       filter_auto_(configuration->property(role + ".filter_auto", false)),
+      zero_copy_(configuration->property(role + ".zero_copy", false)),
       dump_(configuration->property(role + ".dump", false))
 {
     if (filter_auto_)
@@ -63,10 +65,15 @@ PlutosdrSignalSource::PlutosdrSignalSource(const ConfigurationInterface* configu
             filter_source_ = configuration->property(role + ".filter_source", std::string("Off"));
         }
 
-    if (item_type_ != "gr_complex")
+    if (item_type_ == "cshort")
         {
-            std::cout << "Configuration error: item_type must be gr_complex\n";
-            LOG(FATAL) << "Configuration error: item_type must be gr_complex!";
+            // native samples are only available from the libiio buffers
+            zero_copy_ = true;
+        }
+    else if (item_type_ != "gr_complex")
+        {
+            std::cout << "Configuration error: item_type must be gr_complex or cshort\n";
+            LOG(FATAL) << "Configuration error: item_type must be gr_complex or cshort!";
         }
 
     // basic check
@@ -143,6 +150,16 @@ PlutosdrSignalSource::PlutosdrSignalSource(const ConfigurationInterface* configu
         bandwidth_, buffer_size_, quadrature_, rf_dc_, bb_dc_,
         gain_mode_.c_str(), rf_gain_, filter_file_.c_str(), filter_auto_);
 #endif
+    rx_source_ = plutosdr_source_;
+    if (zero_copy_)
+        {
+            // the gr-iio block has configured the front-end, but it is not
+            // connected: the samples are read in place from the libiio buffers
+            iio_source_ = make_iio_rx_source(uri_, {0}, buffer_size_, kernel_buffers_, item_type_);
+            item_size_ = iio_source_->output_signature()->sizeof_stream_item(0);
+            rx_source_ = iio_source_;
+            std::cout << "streaming from the libiio buffers\n";
+        }
     if (samples_ != 0)
         {
             DLOG(INFO) << "Send STOP signal after " << samples_ << " samples";
@@ -171,7 +188,7 @@ void PlutosdrSignalSource::connect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->connect(plutosdr_source_, 0, valve_, 0);
+            top_block->connect(rx_source_, 0, valve_, 0);
             DLOG(INFO) << "connected plutosdr source to valve";
             if (dump_)
                 {
@@ -183,7 +200,7 @@ void PlutosdrSignalSource::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(plutosdr_source_, 0, file_sink_, 0);
+                    top_block->connect(rx_source_, 0, file_sink_, 0);
                     DLOG(INFO) << "connected plutosdr source to file sink";
                 }
         }
@@ -194,7 +211,7 @@ void PlutosdrSignalSource::disconnect(gr::top_block_sptr top_block)
 {
     if (samples_ != 0)
         {
-            top_block->disconnect(plutosdr_source_, 0, valve_, 0);
+            top_block->disconnect(rx_source_, 0, valve_, 0);
             if (dump_)
                 {
                     top_block->disconnect(valve_, 0, file_sink_, 0);
@@ -204,7 +221,7 @@ void PlutosdrSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(plutosdr_source_, 0, file_sink_, 0);
+                    top_block->disconnect(rx_source_, 0, file_sink_, 0);
                 }
         }
 }
@@ -225,6 +242,6 @@ gr::basic_block_sptr PlutosdrSignalSource::get_right_block()
         }
     else
         {
-            return plutosdr_source_;
+            return rx_source_;
         }
 }
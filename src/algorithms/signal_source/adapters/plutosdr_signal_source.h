@@ -30,7 +30,8 @@
 #else
 #include <iio/pluto_source.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
+#include "iio_rx_source.h"
 #include <pmt/pmt.h>
 #include <cstdint>
 #include <string>
@@ -51,7 +52,7 @@ class PlutosdrSignalSource : public SignalSourceBase
 public:
     PlutosdrSignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~PlutosdrSignalSource() = default;
 
@@ -72,6 +73,8 @@ private:
 #else
     gr::iio::pluto_source::sptr plutosdr_source_;
 #endif
+    iio_rx_source_sptr iio_source_;
+    gr::basic_block_sptr rx_source_;  // the block that outputs the samples
 
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
@@ -92,6 +95,7 @@ private:
     uint64_t bandwidth_;
     uint64_t buffer_size_;  // reception buffer
     size_t item_size_;
+    unsigned int kernel_buffers_;  // 0 for the libiio default
     float Fpass_;
     float Fstop_;
     unsigned int in_stream_;
@@ -101,6 +105,7 @@ private:
     bool rf_dc_;
     bool bb_dc_;
     bool filter_auto_;
+    bool zero_copy_;  // stream from the libiio buffers instead of gr-iio
     bool dump_;
 };
 
@@ -18,7 +18,7 @@
 #ifndef GNSS_SDR_RAW_ARRAY_SIGNAL_SOURCE_H
 #define GNSS_SDR_RAW_ARRAY_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/hier_block2.h>
@@ -44,7 +44,7 @@ class RawArraySignalSource : public SignalSourceBase
 public:
     RawArraySignalSource(const ConfigurationInterface* configuration,
         std::string role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~RawArraySignalSource() = default;
 
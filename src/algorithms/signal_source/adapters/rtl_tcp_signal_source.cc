@@ -23,6 +23,7 @@
 #include "gnss_sdr_valve.h"
 #include <boost/exception/diagnostic_information.hpp>
 #include <glog/logging.h>
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <utility>
@@ -33,7 +34,7 @@ RtlTcpSignalSource::RtlTcpSignalSource(const ConfigurationInterface* configurati
     const std::string& role,
     unsigned int in_stream,
     unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
     : SignalSourceBase(configuration, role, "RtlTcp_Signal_Source"s), in_stream_(in_stream), out_stream_(out_stream)
 {
     // DUMP PARAMETERS
@@ -57,6 +58,9 @@ RtlTcpSignalSource::RtlTcpSignalSource(const ConfigurationInterface* configurati
     address_ = configuration->property(role + ".address", default_address);
     port_ = configuration->property(role + ".port", default_port);
     flip_iq_ = configuration->property(role + ".flip_iq", false);
+    // buffer between the socket and the flowgraph, in milliseconds of signal
+    buffer_size_ms_ = configuration->property(role + ".buffer_size_ms", 500);
+    jitter_buffer_ms_ = configuration->property(role + ".jitter_buffer_ms", 0);
 
     if (item_type_ == "short")
         {
@@ -134,7 +138,11 @@ void RtlTcpSignalSource::MakeBlock()
         {
             std::cout << "Connecting to " << address_ << ":" << port_ << '\n';
             LOG(INFO) << "Connecting to " << address_ << ":" << port_;
-            signal_source_ = rtl_tcp_make_signal_source_c(address_, port_, flip_iq_);
+            // two bytes per sample
+            const auto bytes_per_ms = static_cast<size_t>(sample_rate_) / 500;
+            signal_source_ = rtl_tcp_make_signal_source_c(address_, port_, flip_iq_,
+                bytes_per_ms * static_cast<size_t>(std::max(buffer_size_ms_, 1)),
+                bytes_per_ms * static_cast<size_t>(std::max(std::min(jitter_buffer_ms_, buffer_size_ms_), 0)));
         }
     catch (const boost::exception& e)
         {
@@ -18,7 +18,7 @@
 #ifndef GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_H
 #define GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "rtl_tcp_signal_source_c.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/deinterleave.h>
@@ -41,6 +41,11 @@ class ConfigurationInterface;
  * \brief This class reads from rtl_tcp, which streams interleaved
  * I/Q samples over TCP.
  * (see https://osmocom.org/projects/rtl-sdr/wiki)
+ *
+ * The samples are received in a separate thread and held in a buffer of
+ * .buffer_size_ms milliseconds (default 500). With .jitter_buffer_ms > 0, the
+ * buffer waits to hold that many milliseconds of signal before delivering
+ * samples, when it starts and whenever it runs dry.
  */
 class RtlTcpSignalSource : public SignalSourceBase
 {
@@ -49,7 +54,7 @@ public:
         const std::string& role,
         unsigned int in_stream,
         unsigned int out_stream,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~RtlTcpSignalSource() = default;
 
@@ -82,6 +87,8 @@ private:
     int freq_;
     int gain_;
     int if_gain_;
+    int buffer_size_ms_;
+    int jitter_buffer_ms_;
     double rf_gain_;
     unsigned int in_stream_;
     unsigned int out_stream_;
@@ -0,0 +1,100 @@
+/*!
+ * \file shm_signal_source.cc
+ * \brief Signal source that reads samples from a shared memory ring buffer
+ * written by an external process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "shm_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_string_literals.h"
+#include "item_type_helpers.h"
+#include "shm_ring_source.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+
+
+using namespace std::string_literals;
+
+ShmSignalSource::ShmSignalSource(ConfigurationInterface const* configuration,
+    std::string const& role, unsigned int in_streams, unsigned int out_streams,
+    [[maybe_unused]] Control_Queue* queue)
+    : SignalSourceBase(configuration, role, "Shm_Signal_Source"s),
+      item_type_(configuration->property(role + ".item_type"s, "gr_complex"s)),
+      item_size_(item_type_valid(item_type_) ? item_type_size(item_type_) : sizeof(gr_complex)),
+      shm_source_(make_shm_ring_source(item_size_,
+          configuration->property(role + ".shm_name"s, "/gnss-sdr"s),
+          configuration->property(role + ".buffer_size"s, uint64_t(268435456)))),
+      dump_(configuration->property(role + ".dump", false)),
+      dump_filename_(configuration->property(role + ".dump_filename"s, "./data/signal_source.dat"s))
+{
+    if (!item_type_valid(item_type_))
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type, using gr_complex";
+        }
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+
+    if (in_streams > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void ShmSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(shm_source_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected source to file sink";
+        }
+}
+
+
+void ShmSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(shm_source_, 0, file_sink_, 0);
+            DLOG(INFO) << "disconnected source from file sink";
+        }
+}
+
+
+size_t ShmSignalSource::item_size()
+{
+    return item_size_;
+}
+
+
+gr::basic_block_sptr ShmSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr ShmSignalSource::get_right_block()
+{
+    return shm_source_;
+}
@@ -0,0 +1,79 @@
+/*!
+ * \file shm_signal_source.h
+ * \brief Signal source that reads samples from a shared memory ring buffer
+ * written by an external process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_SIGNAL_SOURCE_H
+#define GNSS_SDR_SHM_SIGNAL_SOURCE_H
+
+#include "control_queue.h"
+#include "signal_source_base.h"
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+// forward declaration to avoid include in header
+class ConfigurationInterface;
+
+//! \brief Class that reads a sample stream from a shared memory ring buffer.
+//!
+//! Unlike the Fifo_Signal_Source, the producer writes the samples directly
+//! into memory shared with the receiver, using the C API of
+//! gnss_sdr_shm_ring.h, without any system call per write.
+//!
+//! This class supports the following properties:
+//!
+//!   .shm_name - name of the POSIX shared memory object (default "/gnss-sdr")
+//!
+//!   .buffer_size - capacity of the ring buffer, in bytes (default 268435456)
+//!
+//!   .item_type - data type of the samples written by the producer (default "gr_complex")
+//!
+//!   .dump     - whether to archive input data
+//!
+//!   .dump_filename - if dumping, path to file for output
+//!
+class ShmSignalSource : public SignalSourceBase
+{
+public:
+    ShmSignalSource(const ConfigurationInterface* configuration, const std::string& role,
+        unsigned int in_streams, unsigned int out_streams,
+        Control_Queue* queue);
+
+    ~ShmSignalSource() = default;
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    size_t item_size() override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    const std::string item_type_;
+    const size_t item_size_;
+    const gnss_shared_ptr<gr::block> shm_source_;
+
+    gnss_shared_ptr<gr::block> file_sink_;
+    const bool dump_;
+    const std::string dump_filename_;
+};
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHM_SIGNAL_SOURCE_H
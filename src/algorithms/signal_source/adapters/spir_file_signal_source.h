@@ -42,7 +42,7 @@ class SpirFileSignalSource : public FileSourceBase
 public:
     SpirFileSignalSource(const ConfigurationInterface* configuration, const std::string& role,
         unsigned int in_streams, unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~SpirFileSignalSource() = default;
 
@@ -29,7 +29,7 @@
 using namespace std::string_literals;
 
 SpirGSS6450FileSignalSource::SpirGSS6450FileSignalSource(const ConfigurationInterface* configuration,
-    const std::string& role, uint32_t in_streams, uint32_t out_streams, Concurrent_Queue<pmt::pmt_t>* queue)
+    const std::string& role, uint32_t in_streams, uint32_t out_streams, Control_Queue* queue)
     : SignalSourceBase(configuration, role, "Spir_GSS6450_File_Signal_Source"s),
       item_type_("int"),
       item_size_(sizeof(int32_t)),
@@ -21,7 +21,7 @@
 #ifndef GNSS_SDR_SPIR_GSS6450_FILE_SIGNAL_SOURCE_H
 #define GNSS_SDR_SPIR_GSS6450_FILE_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_sdr_valve.h"
 #include "signal_source_base.h"
 #include "unpack_spir_gss6450_samples.h"
@@ -54,7 +54,7 @@ class SpirGSS6450FileSignalSource : public SignalSourceBase
 {
 public:
     SpirGSS6450FileSignalSource(const ConfigurationInterface* configuration, const std::string& role,
-        uint32_t in_streams, uint32_t out_streams, Concurrent_Queue<pmt::pmt_t>* queue);
+        uint32_t in_streams, uint32_t out_streams, Control_Queue* queue);
 
     inline size_t item_size() override
     {
@@ -46,7 +46,7 @@ public:
         const std::string& role,
         unsigned int in_streams,
         unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     ~TwoBitCpxFileSignalSource() = default;
 
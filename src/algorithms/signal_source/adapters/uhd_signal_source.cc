@@ -21,6 +21,9 @@
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
+#if ENABLE_ZSTD
+#include "compressed_file_sink.h"
+#endif
 #include <glog/logging.h>
 #include <uhd/exception.hpp>
 #include <uhd/types/device_addr.hpp>
@@ -33,8 +36,13 @@ using namespace std::string_literals;
 
 UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_stream, unsigned int out_stream,
-    Concurrent_Queue<pmt::pmt_t>* queue)
-    : SignalSourceBase(configuration, role, "UHD_Signal_Source"s), in_stream_(in_stream), out_stream_(out_stream)
+    Control_Queue* queue)
+    : SignalSourceBase(configuration, role, "UHD_Signal_Source"s),
+      timestamp_clock_offset_ms_(configuration->property(role + ".timestamp_clock_offset_ms", 0.0)),
+      in_stream_(in_stream),
+      out_stream_(out_stream),
+      recv_thread_per_channel_(configuration->property(role + ".recv_thread_per_channel", false)),
+      overflow_timetags_(configuration->property(role + ".overflow_timetags", false))
 {
     // DUMP PARAMETERS
     const std::string empty;
@@ -58,11 +66,30 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
         {
             dev_addr["serial"] = device_serial;
         }
+    // transport buffering: larger and more frames absorb the scheduling
+    // jitter of the host, which otherwise shows up as overflows at high rates
+    const auto recv_frame_size = configuration->property(role + ".recv_frame_size", 0);
+    if (recv_frame_size > 0)
+        {
+            dev_addr["recv_frame_size"] = std::to_string(recv_frame_size);
+        }
+    const auto num_recv_frames = configuration->property(role + ".num_recv_frames", 0);
+    if (num_recv_frames > 0)
+        {
+            dev_addr["num_recv_frames"] = std::to_string(num_recv_frames);
+        }
+    const auto recv_buff_size = configuration->property(role + ".recv_buff_size", 0);
+    if (recv_buff_size > 0)
+        {
+            dev_addr["recv_buff_size"] = std::to_string(recv_buff_size);
+        }
     subdevice_ = configuration->property(role + ".subdevice", empty);
     clock_source_ = configuration->property(role + ".clock_source", std::string("internal"));
     RF_channels_ = configuration->property(role + ".RF_channels", 1);
     sample_rate_ = configuration->property(role + ".sampling_frequency", 4.0e6);
     item_type_ = configuration->property(role + ".item_type", default_item_type);
+    dump_compression_ = configuration->property(role + ".dump_compression", std::string("none"));
+    dump_compression_level_ = configuration->property(role + ".dump_compression_level", 3);
 
     if (RF_channels_ == 1)
         {
@@ -150,14 +177,32 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
             uhd_stream_args_ = uhd::stream_args_t("sc16");
         }
 
-    // select the number of channels and the subdevice specifications
-    for (int i = 0; i < RF_channels_; i++)
+    // 1.2 Make the UHD source objects
+    if (recv_thread_per_channel_ && RF_channels_ > 1)
         {
-            uhd_stream_args_.channels.push_back(i);
+            // one streamer per RF channel, each one received by its own
+            // thread, so that a slow channel does not hold back the others
+            for (int i = 0; i < RF_channels_; i++)
+                {
+                    uhd::stream_args_t stream_args = uhd_stream_args_;
+                    stream_args.channels.push_back(i);
+                    uhd_sources_.push_back(gr::uhd::usrp_source::make(dev_addr, stream_args));
+                }
+            LOG(INFO) << "Using one UHD streamer per RF channel";
         }
-
-    // 1.2 Make the UHD source object
-    uhd_source_ = gr::uhd::usrp_source::make(dev_addr, uhd_stream_args_);
+    else
+        {
+            // select the number of channels and the subdevice specifications
+            recv_thread_per_channel_ = false;
+            for (int i = 0; i < RF_channels_; i++)
+                {
+                    uhd_stream_args_.channels.push_back(i);
+                }
+            uhd_sources_.push_back(gr::uhd::usrp_source::make(dev_addr, uhd_stream_args_));
+        }
+    // with one streamer per channel, each source sees its channel as channel 0
+    auto source = [&](int i) { return recv_thread_per_channel_ ? uhd_sources_.at(i) : uhd_sources_.front(); };
+    auto chan = [&](int i) { return recv_thread_per_channel_ ? 0 : i; };
 
     // Set subdevice specification string for USRP family devices. It is composed of:
     // <motherboard slot name>:<daughterboard frontend name>
@@ -168,18 +213,22 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
     // Dual channel example: "A:0 B:0"
     // TODO: Add support for multiple motherboards (i.e. four channels "A:0 B:0 A:1 B1")
 
-    uhd_source_->set_subdev_spec(subdevice_, 0);
+    uhd_sources_.front()->set_subdev_spec(subdevice_, 0);
 
     // 2.1 set sampling clock reference
     // Set the clock source for the usrp device.
     // Options: internal, external, or MIMO
-    uhd_source_->set_clock_source(clock_source_);
+    uhd_sources_.front()->set_clock_source(clock_source_);
 
     // 2.2 set the sample rate for the usrp device
-    uhd_source_->set_samp_rate(sample_rate_);
+    for (auto& uhd_source : uhd_sources_)
+        {
+            uhd_source->set_samp_rate(sample_rate_);
+        }
     // the actual sample rate may differ from the rate set
-    std::cout << "Sampling Rate for the USRP device: " << uhd_source_->get_samp_rate() << " [sps]...\n";
-    LOG(INFO) << "Sampling Rate for the USRP device: " << uhd_source_->get_samp_rate() << " [sps]...";
+    const double actual_sample_rate = uhd_sources_.front()->get_samp_rate();
+    std::cout << "Sampling Rate for the USRP device: " << actual_sample_rate << " [sps]...\n";
+    LOG(INFO) << "Sampling Rate for the USRP device: " << actual_sample_rate << " [sps]...";
 
     std::vector<std::string> sensor_names;
 
@@ -187,34 +236,34 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
         {
             std::cout << "UHD RF CHANNEL #" << i << " SETTINGS\n";
             // 3. Tune the usrp device to the desired center frequency
-            uhd_source_->set_center_freq(freq_.at(i), i);
-            std::cout << "Actual USRP center freq.: " << uhd_source_->get_center_freq(i) << " [Hz]...\n";
-            LOG(INFO) << "Actual USRP center freq. set to: " << uhd_source_->get_center_freq(i) << " [Hz]...";
+            source(i)->set_center_freq(freq_.at(i), chan(i));
+            std::cout << "Actual USRP center freq.: " << source(i)->get_center_freq(chan(i)) << " [Hz]...\n";
+            LOG(INFO) << "Actual USRP center freq. set to: " << source(i)->get_center_freq(chan(i)) << " [Hz]...";
 
             // TODO: Assign the remnant IF from the PLL tune error
-            std::cout << "PLL Frequency tune error: " << uhd_source_->get_center_freq(i) - freq_.at(i) << " [Hz]...\n";
-            LOG(INFO) << "PLL Frequency tune error: " << uhd_source_->get_center_freq(i) - freq_.at(i) << " [Hz]...";
+            std::cout << "PLL Frequency tune error: " << source(i)->get_center_freq(chan(i)) - freq_.at(i) << " [Hz]...\n";
+            LOG(INFO) << "PLL Frequency tune error: " << source(i)->get_center_freq(chan(i)) - freq_.at(i) << " [Hz]...";
 
             // 4. set the gain for the daughterboard
-            uhd_source_->set_gain(gain_.at(i), i);
-            std::cout << "Actual daughterboard gain set to: " << uhd_source_->get_gain(i) << " dB...\n";
-            LOG(INFO) << "Actual daughterboard gain set to: " << uhd_source_->get_gain(i) << " dB...";
+            source(i)->set_gain(gain_.at(i), chan(i));
+            std::cout << "Actual daughterboard gain set to: " << source(i)->get_gain(chan(i)) << " dB...\n";
+            LOG(INFO) << "Actual daughterboard gain set to: " << source(i)->get_gain(chan(i)) << " dB...";
 
             // 5.  Set the bandpass filter on the RF frontend
             std::cout << "Setting RF bandpass filter bandwidth to: " << IF_bandwidth_hz_.at(i) << " [Hz]...\n";
-            uhd_source_->set_bandwidth(IF_bandwidth_hz_.at(i), i);
+            source(i)->set_bandwidth(IF_bandwidth_hz_.at(i), chan(i));
 
             // set the antenna (optional)
-            // uhd_source_->set_antenna(ant);
+            // source(i)->set_antenna(ant);
 
             // We should wait? #include <boost/thread.hpp>
             // boost::this_thread::sleep(boost::posix_time::seconds(1));
 
             // Check out the status of the lo_locked sensor (boolean for LO lock state)
-            sensor_names = uhd_source_->get_sensor_names(i);
+            sensor_names = source(i)->get_sensor_names(chan(i));
             if (std::find(sensor_names.begin(), sensor_names.end(), "lo_locked") != sensor_names.end())
                 {
-                    uhd::sensor_value_t lo_locked = uhd_source_->get_sensor("lo_locked", i);
+                    uhd::sensor_value_t lo_locked = source(i)->get_sensor("lo_locked", chan(i));
                     std::cout << "Check for front-end " << lo_locked.to_pp_string() << " is ... ";
                     if (lo_locked.to_bool() == true)
                         {
@@ -240,10 +289,29 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
             if (dump_.at(i))
                 {
                     LOG(INFO) << "RF_channel " << i << "Dumping output into file " << dump_filename_.at(i);
-                    file_sink_.push_back(gr::blocks::file_sink::make(item_size_, dump_filename_.at(i).c_str()));
+#if ENABLE_ZSTD
+                    if (dump_compression_ == "zstd")
+                        {
+                            // the recording keeps the RF settings of the channel
+                            const std::string metadata = "freq=" + std::to_string(freq_.at(i)) + "\ngain=" + std::to_string(gain_.at(i)) + "\n";
+                            file_sink_.push_back(make_compressed_file_sink(item_size_, dump_filename_.at(i), item_type_, static_cast<int64_t>(sample_rate_),
+                                CompressedCaptureHeader::DEFAULT_CHUNK_ITEMS, dump_compression_level_, 0, metadata));
+                        }
+                    else
+#endif
+                        {
+                            file_sink_.push_back(gr::blocks::file_sink::make(item_size_, dump_filename_.at(i).c_str()));
+                        }
                     DLOG(INFO) << "file_sink(" << file_sink_.at(i)->unique_id() << ")";
                 }
         }
+    if (overflow_timetags_)
+        {
+            // the rx_time tags are converted with the actual sample rate
+            timestamp_ = gnss_sdr_make_Timestamp_from_rx_time(item_size_, actual_sample_rate, timestamp_clock_offset_ms_);
+            DLOG(INFO) << "timestamp(" << timestamp_->unique_id() << ")";
+        }
+
     if (in_stream_ > 0)
         {
             LOG(ERROR) << "A signal source does not have an input stream";
@@ -255,13 +323,43 @@ UhdSignalSource::UhdSignalSource(const ConfigurationInterface* configuration,
 }
 
 
+std::pair<gr::basic_block_sptr, int> UhdSignalSource::channel_output(int RF_channel) const
+{
+    if (timestamp_)
+        {
+            return {timestamp_, RF_channel};
+        }
+    if (recv_thread_per_channel_)
+        {
+            return {uhd_sources_.at(RF_channel), 0};
+        }
+    return {uhd_sources_.front(), RF_channel};
+}
+
+
 void UhdSignalSource::connect(gr::top_block_sptr top_block)
 {
+    if (timestamp_)
+        {
+            for (int i = 0; i < RF_channels_; i++)
+                {
+                    if (recv_thread_per_channel_)
+                        {
+                            top_block->connect(uhd_sources_.at(i), 0, timestamp_, i);
+                        }
+                    else
+                        {
+                            top_block->connect(uhd_sources_.front(), i, timestamp_, i);
+                        }
+                }
+            DLOG(INFO) << "connected usrp source to timestamp";
+        }
     for (int i = 0; i < RF_channels_; i++)
         {
+            const auto output = channel_output(i);
             if (samples_.at(i) != 0ULL)
                 {
-                    top_block->connect(uhd_source_, i, valve_.at(i), 0);
+                    top_block->connect(output.first, output.second, valve_.at(i), 0);
                     DLOG(INFO) << "connected usrp source to valve RF Channel " << i;
                     if (dump_.at(i))
                         {
@@ -273,7 +371,7 @@ void UhdSignalSource::connect(gr::top_block_sptr top_block)
                 {
                     if (dump_.at(i))
                         {
-                            top_block->connect(uhd_source_, i, file_sink_.at(i), 0);
+                            top_block->connect(output.first, output.second, file_sink_.at(i), 0);
                             DLOG(INFO) << "connected usrp source to file sink RF Channel " << i;
                         }
                 }
@@ -283,12 +381,16 @@ void UhdSignalSource::connect(gr::top_block_sptr top_block)
 
 void UhdSignalSource::disconnect(gr::top_block_sptr top_block)
 {
-    uhd_source_->stop();
+    for (auto& uhd_source : uhd_sources_)
+        {
+            uhd_source->stop();
+        }
     for (int i = 0; i < RF_channels_; i++)
         {
+            const auto output = channel_output(i);
             if (samples_.at(i) != 0ULL)
                 {
-                    top_block->disconnect(uhd_source_, i, valve_.at(i), 0);
+                    top_block->disconnect(output.first, output.second, valve_.at(i), 0);
                     LOG(INFO) << "UHD source disconnected";
                     if (dump_.at(i))
                         {
@@ -299,7 +401,21 @@ void UhdSignalSource::disconnect(gr::top_block_sptr top_block)
                 {
                     if (dump_.at(i))
                         {
-                            top_block->disconnect(uhd_source_, i, file_sink_.at(i), 0);
+                            top_block->disconnect(output.first, output.second, file_sink_.at(i), 0);
+                        }
+                }
+        }
+    if (timestamp_)
+        {
+            for (int i = 0; i < RF_channels_; i++)
+                {
+                    if (recv_thread_per_channel_)
+                        {
+                            top_block->disconnect(uhd_sources_.at(i), 0, timestamp_, i);
+                        }
+                    else
+                        {
+                            top_block->disconnect(uhd_sources_.front(), i, timestamp_, i);
                         }
                 }
         }
@@ -327,5 +443,5 @@ gr::basic_block_sptr UhdSignalSource::get_right_block(int RF_channel)
         {
             return valve_.at(RF_channel);
         }
-    return uhd_source_;
+    return channel_output(RF_channel).first;
 }
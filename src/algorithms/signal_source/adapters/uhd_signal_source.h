@@ -17,7 +17,8 @@
 #ifndef GNSS_SDR_UHD_SIGNAL_SOURCE_H
 #define GNSS_SDR_UHD_SIGNAL_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
+#include "gnss_sdr_timestamp.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/hier_block2.h>
@@ -25,6 +26,7 @@
 #include <pmt/pmt.h>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -37,13 +39,23 @@ class ConfigurationInterface;
 
 /*!
  * \brief This class reads samples from a UHD device (see http://code.ettus.com/redmine/ettus/projects/uhd/wiki)
+ *
+ * Besides the RF settings, it supports the following streaming properties:
+ *
+ *   .recv_frame_size - size of the transport frames, in bytes (default 0: UHD default)
+ *   .num_recv_frames - number of transport frames buffered (default 0: UHD default)
+ *   .recv_buff_size  - size of the socket buffer of network devices, in bytes (default 0: UHD default)
+ *   .recv_thread_per_channel - one streamer, and so one receive thread, per RF channel (default false)
+ *   .overflow_timetags - convert the rx_time tags sent after each overflow
+ *       into time tags, and count the samples lost (default false)
+ *   .timestamp_clock_offset_ms - offset from the device time to GPS time (default 0)
  */
 class UhdSignalSource : public SignalSourceBase
 {
 public:
     UhdSignalSource(const ConfigurationInterface* configuration,
         const std::string& role, unsigned int in_stream,
-        unsigned int out_stream, Concurrent_Queue<pmt::pmt_t>* queue);
+        unsigned int out_stream, Control_Queue* queue);
 
     ~UhdSignalSource() = default;
 
@@ -59,10 +71,14 @@ public:
     gr::basic_block_sptr get_right_block(int RF_channel) override;
 
 private:
-    gr::uhd::usrp_source::sptr uhd_source_;
+    // block and port that deliver the samples of an RF channel
+    std::pair<gr::basic_block_sptr, int> channel_output(int RF_channel) const;
+
+    std::vector<gr::uhd::usrp_source::sptr> uhd_sources_;
+    gnss_shared_ptr<Gnss_Sdr_Timestamp> timestamp_;
 
     std::vector<gnss_shared_ptr<gr::block>> valve_;
-    std::vector<gr::blocks::file_sink::sptr> file_sink_;
+    std::vector<gnss_shared_ptr<gr::block>> file_sink_;
     std::vector<double> freq_;
     std::vector<double> gain_;
     std::vector<double> IF_bandwidth_hz_;
@@ -76,12 +92,17 @@ private:
     std::string item_type_;
     std::string subdevice_;
     std::string clock_source_;
+    std::string dump_compression_;
 
     double sample_rate_;
+    double timestamp_clock_offset_ms_;
     size_t item_size_;
     int RF_channels_;
+    int dump_compression_level_;
     unsigned int in_stream_;
     unsigned int out_stream_;
+    bool recv_thread_per_channel_;
+    bool overflow_timetags_;
 };
 
 
@@ -0,0 +1,198 @@
+/*!
+ * \file compressed_file_sink.cc
+ * \brief GNU Radio block that records a sample stream as a compressed capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::min
+#include <stdexcept>  // for std::runtime_error
+#include <utility>    // for std::move
+#include <vector>
+
+
+compressed_file_sink_sptr make_compressed_file_sink(size_t item_size,
+    const std::string &filename,
+    const std::string &item_type,
+    int64_t sampling_frequency,
+    uint32_t chunk_items,
+    int level,
+    int threads,
+    const std::string &metadata)
+{
+    return compressed_file_sink_sptr(new compressed_file_sink(item_size, filename, item_type, sampling_frequency, chunk_items, level, threads, metadata));
+}
+
+
+compressed_file_sink::compressed_file_sink(size_t item_size,
+    const std::string &filename,
+    const std::string &item_type,
+    int64_t sampling_frequency,
+    uint32_t chunk_items,
+    int level,
+    int threads,
+    const std::string &metadata) : gr::sync_block("compressed_file_sink",
+                                       gr::io_signature::make(1, 1, static_cast<int>(item_size)),
+                                       gr::io_signature::make(0, 0, 0)),
+                                   d_pool(std::make_unique<Gnss_Thread_Pool>(threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency())),
+                                   d_file(filename, std::ios::out | std::ios::binary | std::ios::trunc),
+                                   d_filename(filename),
+                                   d_items(0),
+                                   d_chunk_bytes(static_cast<size_t>(std::max<uint32_t>(chunk_items, 1)) * item_size),
+                                   d_batch(d_pool->size()),
+                                   d_level(level),
+                                   d_stop(false),
+                                   d_closed(false)
+{
+    if (!d_file.is_open())
+        {
+            throw std::runtime_error("compressed_file_sink: cannot create " + filename);
+        }
+    d_header.item_type = item_type;
+    d_header.metadata = metadata;
+    d_header.sampling_frequency = sampling_frequency;
+    d_header.item_size = static_cast<uint32_t>(item_size);
+    d_header.chunk_items = std::max<uint32_t>(chunk_items, 1);
+    if (!d_header.write(d_file))
+        {
+            throw std::runtime_error("compressed_file_sink: cannot write to " + filename);
+        }
+    d_current.raw.reserve(d_chunk_bytes);
+}
+
+
+compressed_file_sink::~compressed_file_sink()
+{
+    compressed_file_sink::stop();
+}
+
+
+bool compressed_file_sink::start()
+{
+    d_stop = false;
+    d_writer = std::thread([&] { writer_thread(); });
+    return true;
+}
+
+
+bool compressed_file_sink::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_current.raw.empty())
+            {
+                d_pending.push_back(std::move(d_current));
+                d_current = CompressedCaptureChunk();
+                d_current.first_item = d_items;
+            }
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    close();
+    return true;
+}
+
+
+void compressed_file_sink::close()
+{
+    if (d_closed)
+        {
+            return;
+        }
+    d_closed = true;
+    if (!d_pending.empty())
+        {
+            LOG(WARNING) << d_pending.size() << " chunks were not written to " << d_filename;
+        }
+    // the header has a fixed size, so it can be rewritten in place
+    d_header.total_items = d_items;
+    d_file.seekp(0);
+    if (!d_header.write(d_file))
+        {
+            LOG(WARNING) << "Unable to update the header of " << d_filename;
+        }
+    d_file.close();
+}
+
+
+void compressed_file_sink::writer_thread()
+{
+    while (true)
+        {
+            std::vector<CompressedCaptureChunk> batch;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [&] { return d_stop || !d_pending.empty(); });
+                if (d_pending.empty())
+                    {
+                        return;
+                    }
+                const size_t n = std::min(d_batch, d_pending.size());
+                for (size_t i = 0; i < n; i++)
+                    {
+                        batch.push_back(std::move(d_pending.front()));
+                        d_pending.pop_front();
+                    }
+            }
+            d_cond.notify_all();
+
+            d_pool->parallel_for(batch.size(), [&](size_t i) {
+                if (!batch[i].compress(d_level))
+                    {
+                        LOG(WARNING) << "Compression failed, storing uncompressed the chunk at item " << batch[i].first_item;
+                    }
+            });
+            for (const auto &chunk : batch)
+                {
+                    if (!chunk.write(d_file))
+                        {
+                            LOG(ERROR) << "Error writing to " << d_filename;
+                        }
+                }
+        }
+}
+
+
+int compressed_file_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    const auto *in = static_cast<const char *>(input_items[0]);
+    const size_t bytes = static_cast<size_t>(noutput_items) * d_header.item_size;
+    size_t copied = 0;
+    while (copied < bytes)
+        {
+            const size_t n = std::min(bytes - copied, d_chunk_bytes - d_current.raw.size());
+            d_current.raw.insert(d_current.raw.end(), in + copied, in + copied + n);
+            copied += n;
+            if (d_current.raw.size() == d_chunk_bytes)
+                {
+                    std::unique_lock<std::mutex> lock(d_mutex);
+                    d_cond.wait(lock, [&] { return d_stop || d_pending.size() < MAX_PENDING_BATCHES * d_batch; });
+                    const uint64_t next_item = d_current.first_item + d_header.chunk_items;
+                    d_pending.push_back(std::move(d_current));
+                    d_current = CompressedCaptureChunk();
+                    d_current.first_item = next_item;
+                    d_current.raw.reserve(d_chunk_bytes);
+                    lock.unlock();
+                    d_cond.notify_all();
+                }
+        }
+    d_items += static_cast<uint64_t>(noutput_items);
+    return noutput_items;
+}
@@ -0,0 +1,120 @@
+/*!
+ * \file compressed_file_sink.h
+ * \brief GNU Radio block that records a sample stream as a compressed capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_SINK_H
+#define GNSS_SDR_COMPRESSED_FILE_SINK_H
+
+#include "compressed_capture.h"
+#include "gnss_block_interface.h"
+#include "gnss_sdr_thread_pool.h"
+#include <gnuradio/sync_block.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class compressed_file_sink;
+
+using compressed_file_sink_sptr = gnss_shared_ptr<compressed_file_sink>;
+
+compressed_file_sink_sptr make_compressed_file_sink(size_t item_size,
+    const std::string &filename,
+    const std::string &item_type,
+    int64_t sampling_frequency,
+    uint32_t chunk_items,
+    int level,
+    int threads,
+    const std::string &metadata = std::string());
+
+/*!
+ * \brief Writes its input to a compressed capture (see
+ * CompressedCaptureHeader), readable by compressed_file_source.
+ *
+ * work() only copies the samples into the current chunk. Full chunks are
+ * compressed by a writer thread, in batches of one chunk per compression
+ * thread, and written in order. If compression cannot keep up with the
+ * stream, work() blocks once MAX_PENDING_BATCHES batches are waiting, like a
+ * file_sink on a slow disk. The total number of items is written to the
+ * header when the block is stopped.
+ * Throws std::runtime_error if the file cannot be created.
+ */
+class compressed_file_sink : public gr::sync_block
+{
+public:
+    ~compressed_file_sink();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend compressed_file_sink_sptr make_compressed_file_sink(size_t item_size,
+        const std::string &filename,
+        const std::string &item_type,
+        int64_t sampling_frequency,
+        uint32_t chunk_items,
+        int level,
+        int threads,
+        const std::string &metadata);
+
+    compressed_file_sink(size_t item_size,
+        const std::string &filename,
+        const std::string &item_type,
+        int64_t sampling_frequency,
+        uint32_t chunk_items,
+        int level,
+        int threads,
+        const std::string &metadata);
+
+    static constexpr size_t MAX_PENDING_BATCHES = 4;
+
+    void writer_thread();
+    void close();
+
+    CompressedCaptureHeader d_header;
+    CompressedCaptureChunk d_current;
+    std::unique_ptr<Gnss_Thread_Pool> d_pool;
+    std::deque<CompressedCaptureChunk> d_pending;
+    std::ofstream d_file;
+    std::string d_filename;
+    std::thread d_writer;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    uint64_t d_items;  // items received so far
+    size_t d_chunk_bytes;
+    size_t d_batch;
+    int d_level;
+    bool d_stop;
+    bool d_closed;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_SINK_H
@@ -0,0 +1,237 @@
+/*!
+ * \file compressed_file_source.cc
+ * \brief GNU Radio block that replays a compressed capture, decompressing it
+ * in background threads
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::min
+#include <cstring>    // for memcpy
+#include <stdexcept>  // for std::runtime_error
+#include <utility>    // for std::move
+#include <vector>
+
+
+compressed_file_source_sptr make_compressed_file_source(const std::string &filename, uint64_t items_to_skip, bool repeat, int threads)
+{
+    // the output signature depends on the item size stored in the file
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        {
+            throw std::runtime_error("compressed_file_source: cannot open " + filename);
+        }
+    CompressedCaptureHeader header;
+    if (!header.read(file))
+        {
+            throw std::runtime_error("compressed_file_source: " + filename + " is not a valid compressed capture");
+        }
+    return compressed_file_source_sptr(new compressed_file_source(filename, header, items_to_skip, repeat, threads));
+}
+
+
+compressed_file_source::compressed_file_source(const std::string &filename,
+    const CompressedCaptureHeader &header,
+    uint64_t items_to_skip,
+    bool repeat,
+    int threads) : gr::sync_block("compressed_file_source",
+                       gr::io_signature::make(0, 0, 0),
+                       gr::io_signature::make(1, 1, static_cast<int>(header.item_size))),
+                   d_header(header),
+                   d_pool(std::make_unique<Gnss_Thread_Pool>(threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency())),
+                   d_file(filename, std::ios::in | std::ios::binary),
+                   d_filename(filename),
+                   d_data_start(static_cast<std::streamoff>(CompressedCaptureHeader::SIZE + header.metadata.size())),
+                   d_items_to_skip(items_to_skip),
+                   d_batch(d_pool->size()),
+                   d_front_offset(0),
+                   d_drop_bytes(0),
+                   d_repeat(repeat),
+                   d_eof(false),
+                   d_stop(false)
+{
+    if (!d_file.is_open())
+        {
+            throw std::runtime_error("compressed_file_source: cannot open " + filename);
+        }
+    if (!rewind())
+        {
+            // same behavior as a failed seek of gr::blocks::file_source
+            LOG(ERROR) << "Error skipping items! " << filename << " has less than " << items_to_skip << " items";
+        }
+    DLOG(INFO) << "Replaying " << filename << " with " << d_batch << " decompression threads";
+}
+
+
+compressed_file_source::~compressed_file_source()
+{
+    compressed_file_source::stop();
+}
+
+
+bool compressed_file_source::start()
+{
+    d_stop = false;
+    d_reader = std::thread([&] { reader_thread(); });
+    return true;
+}
+
+
+bool compressed_file_source::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_reader.joinable())
+        {
+            d_reader.join();
+        }
+    return true;
+}
+
+
+bool compressed_file_source::rewind()
+{
+    d_file.clear();
+    d_file.seekg(d_data_start);
+
+    // whole chunks before the first item are skipped without reading their data
+    CompressedCaptureChunk chunk;
+    while (true)
+        {
+            const std::streampos position = d_file.tellg();
+            if (!chunk.skip(d_file))
+                {
+                    d_file.clear();
+                    return false;
+                }
+            if (chunk.first_item + chunk.raw_bytes() / d_header.item_size > d_items_to_skip)
+                {
+                    d_file.seekg(position);
+                    d_drop_bytes = d_items_to_skip > chunk.first_item ? (d_items_to_skip - chunk.first_item) * d_header.item_size : 0;
+                    return true;
+                }
+        }
+}
+
+
+void compressed_file_source::reader_thread()
+{
+    // avoids rewinding forever if there is nothing to read after skipping
+    bool rewound = true;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [&] { return d_stop || d_queue.size() < QUEUE_BATCHES * d_batch; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+            }
+
+            // Sequential reads, one chunk per decompression thread
+            std::vector<CompressedCaptureChunk> batch;
+            batch.reserve(d_batch);
+            while (batch.size() < d_batch)
+                {
+                    CompressedCaptureChunk chunk;
+                    if (!chunk.read(d_file))
+                        {
+                            break;
+                        }
+                    batch.push_back(std::move(chunk));
+                }
+
+            d_pool->parallel_for(batch.size(), [&](size_t i) {
+                if (!batch[i].decompress())
+                    {
+                        batch[i].raw.assign(batch[i].raw_bytes(), 0);
+                    }
+                batch[i].stored = std::vector<char>();
+            });
+
+            if (!batch.empty() && d_drop_bytes > 0)
+                {
+                    std::vector<char> &raw = batch.front().raw;
+                    raw.erase(raw.begin(), raw.begin() + std::min(d_drop_bytes, raw.size()));
+                    d_drop_bytes = 0;
+                }
+
+            bool last = false;
+            const bool nothing_read = batch.empty() && rewound;
+            rewound = false;
+            if (batch.size() < d_batch)
+                {
+                    if (d_repeat && !nothing_read && rewind())
+                        {
+                            rewound = true;
+                        }
+                    else
+                        {
+                            last = true;
+                        }
+                }
+
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                for (auto &chunk : batch)
+                    {
+                        d_queue.push_back(std::move(chunk));
+                    }
+                d_eof = last;
+            }
+            d_cond.notify_all();
+            if (last)
+                {
+                    return;
+                }
+        }
+}
+
+
+int compressed_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = static_cast<char *>(output_items[0]);
+    const size_t max_bytes = static_cast<size_t>(noutput_items) * d_header.item_size;
+    size_t bytes = 0;
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_cond.wait(lock, [&] { return d_stop || d_eof || !d_queue.empty(); });
+        while (bytes < max_bytes && !d_queue.empty())
+            {
+                const std::vector<char> &raw = d_queue.front().raw;
+                const size_t n = std::min(max_bytes - bytes, raw.size() - d_front_offset);
+                std::memcpy(out + bytes, raw.data() + d_front_offset, n);
+                bytes += n;
+                d_front_offset += n;
+                if (d_front_offset == raw.size())
+                    {
+                        d_queue.pop_front();
+                        d_front_offset = 0;
+                    }
+            }
+    }
+    d_cond.notify_all();
+
+    if (bytes == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(bytes / d_header.item_size);
+}
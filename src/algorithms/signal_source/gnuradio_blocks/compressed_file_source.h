@@ -0,0 +1,105 @@
+/*!
+ * \file compressed_file_source.h
+ * \brief GNU Radio block that replays a compressed capture, decompressing it
+ * in background threads
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_SOURCE_H
+#define GNSS_SDR_COMPRESSED_FILE_SOURCE_H
+
+#include "compressed_capture.h"
+#include "gnss_block_interface.h"
+#include "gnss_sdr_thread_pool.h"
+#include <gnuradio/sync_block.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class compressed_file_source;
+
+using compressed_file_source_sptr = gnss_shared_ptr<compressed_file_source>;
+
+compressed_file_source_sptr make_compressed_file_source(const std::string &filename, uint64_t items_to_skip, bool repeat, int threads);
+
+/*!
+ * \brief Outputs the samples of a compressed capture (see
+ * CompressedCaptureHeader).
+ *
+ * A reader thread reads the chunks of the file in batches of one chunk per
+ * decompression thread, decompresses the batch in parallel and queues the
+ * result, up to QUEUE_BATCHES batches ahead of work(). A chunk that fails its
+ * checksum is replaced by zeros, so the stream keeps its timing.
+ * Throws std::runtime_error if the file cannot be opened or is not a
+ * compressed capture.
+ */
+class compressed_file_source : public gr::sync_block
+{
+public:
+    ~compressed_file_source();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    inline const CompressedCaptureHeader &header() const
+    {
+        return d_header;
+    }
+
+private:
+    friend compressed_file_source_sptr make_compressed_file_source(const std::string &filename, uint64_t items_to_skip, bool repeat, int threads);
+
+    compressed_file_source(const std::string &filename, const CompressedCaptureHeader &header, uint64_t items_to_skip, bool repeat, int threads);
+
+    static constexpr size_t QUEUE_BATCHES = 2;
+
+    void reader_thread();
+    bool rewind();
+
+    CompressedCaptureHeader d_header;
+    std::unique_ptr<Gnss_Thread_Pool> d_pool;
+    std::deque<CompressedCaptureChunk> d_queue;
+    std::ifstream d_file;
+    std::string d_filename;
+    std::thread d_reader;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::streampos d_data_start;
+    uint64_t d_items_to_skip;
+    size_t d_batch;
+    size_t d_front_offset;  // bytes of the front chunk already handed out
+    size_t d_drop_bytes;    // bytes to drop at the beginning of the next chunk
+    bool d_repeat;
+    bool d_eof;
+    bool d_stop;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_SOURCE_H
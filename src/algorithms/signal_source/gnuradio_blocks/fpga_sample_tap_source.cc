@@ -0,0 +1,209 @@
+/*!
+ * \file fpga_sample_tap_source.cc
+ * \brief GNU Radio source that outputs the samples that the FPGA writes by DMA
+ * into a ring buffer in host memory, in parallel to its own signal processing.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fpga_sample_tap_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>   // for std::min
+#include <atomic>      // for std::atomic_thread_fence
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <fcntl.h>     // for open, O_RDWR, O_SYNC
+#include <poll.h>      // for poll
+#include <stdexcept>   // for std::runtime_error
+#include <sys/mman.h>  // for mmap
+#include <unistd.h>    // for read, write, close, getpagesize
+
+
+fpga_sample_tap_source_sptr make_fpga_sample_tap_source(size_t item_size, const std::string &device_io_name, uint32_t irq_bytes)
+{
+    return fpga_sample_tap_source_sptr(new fpga_sample_tap_source(item_size, device_io_name, irq_bytes));
+}
+
+
+fpga_sample_tap_source::fpga_sample_tap_source(size_t item_size,
+    const std::string &device_io_name,
+    uint32_t irq_bytes) : gr::sync_block("fpga_sample_tap_source",
+                              gr::io_signature::make(0, 0, 0),
+                              gr::io_signature::make(1, 1, static_cast<int>(item_size))),
+                          d_device_io_name(device_io_name),
+                          d_map_base(nullptr),
+                          d_ring(nullptr),
+                          d_ring_map_size(0),
+                          d_capacity(0),
+                          d_read_pos(0),
+                          d_item_size(item_size),
+                          d_irq_bytes(irq_bytes),
+                          d_reported_dropped_bytes(0),
+                          d_device_descriptor(-1)
+{
+    if ((d_device_descriptor = open(device_io_name.c_str(), O_RDWR | O_SYNC)) == -1)
+        {
+            throw std::runtime_error("fpga_sample_tap_source: cannot open " + device_io_name + ": " + std::strerror(errno));
+        }
+    void *registers = mmap(nullptr, FPGA_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, d_device_descriptor, 0);
+    if (registers == MAP_FAILED)
+        {
+            close_device();
+            throw std::runtime_error("fpga_sample_tap_source: cannot map the registers of " + device_io_name);
+        }
+    d_map_base = reinterpret_cast<volatile uint32_t *>(registers);
+
+    // sanity check: check test register
+    d_map_base[test_reg_addr] = TEST_REGISTER_WRITEVAL;
+    if (d_map_base[test_reg_addr] != TEST_REGISTER_WRITEVAL)
+        {
+            LOG(WARNING) << "Sample tap test register sanity check failed";
+        }
+
+    // reserve the address range, then map the ring (the second memory map of the UIO device) twice into it
+    d_capacity = d_map_base[capacity_reg_addr];
+    d_ring_map_size = 2 * d_capacity;
+    auto *base = reinterpret_cast<uint8_t *>(mmap(nullptr, d_ring_map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (d_capacity == 0 or base == MAP_FAILED)
+        {
+            close_device();
+            throw std::runtime_error("fpga_sample_tap_source: the ring of " + device_io_name + " cannot be mapped");
+        }
+    if (mmap(base, d_capacity, PROT_READ, MAP_SHARED | MAP_FIXED, d_device_descriptor, getpagesize()) == MAP_FAILED or
+        mmap(base + d_capacity, d_capacity, PROT_READ, MAP_SHARED | MAP_FIXED, d_device_descriptor, getpagesize()) == MAP_FAILED)
+        {
+            munmap(base, d_ring_map_size);
+            close_device();
+            throw std::runtime_error("fpga_sample_tap_source: the ring of " + device_io_name + " cannot be mapped");
+        }
+    d_ring = base;
+    LOG(INFO) << "FPGA sample tap " << device_io_name << " with a ring of " << d_capacity << " bytes";
+}
+
+
+fpga_sample_tap_source::~fpga_sample_tap_source()
+{
+    close_device();
+}
+
+
+bool fpga_sample_tap_source::start()
+{
+    // start with an empty ring
+    d_read_pos = write_position();
+    d_map_base[read_pos_lsw_reg_addr] = static_cast<uint32_t>(d_read_pos & 0xFFFFFFFF);
+    d_map_base[read_pos_msw_reg_addr] = static_cast<uint32_t>(d_read_pos >> 32);
+    d_reported_dropped_bytes = d_map_base[dropped_bytes_reg_addr];
+    d_map_base[irq_bytes_reg_addr] = d_irq_bytes;
+    d_map_base[enable_reg_addr] = 1;
+    return true;
+}
+
+
+bool fpga_sample_tap_source::stop()
+{
+    d_map_base[enable_reg_addr] = 0;
+    return true;
+}
+
+
+uint64_t fpga_sample_tap_source::dropped_bytes() const
+{
+    return d_map_base[dropped_bytes_reg_addr];
+}
+
+
+uint64_t fpga_sample_tap_source::write_position() const
+{
+    uint64_t write_pos = d_map_base[write_pos_lsw_reg_addr];
+    write_pos += static_cast<uint64_t>(d_map_base[write_pos_msw_reg_addr]) << 32;
+    // the samples up to write_pos are in memory before the position is visible
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return write_pos;
+}
+
+
+void fpga_sample_tap_source::wait_samples()
+{
+    // enable interrupts
+    int32_t reenable = 1;
+    if (write(d_device_descriptor, &reenable, sizeof(reenable)) != sizeof(reenable))
+        {
+            LOG(WARNING) << "Error enabling the sample tap interrupt";
+        }
+    if (write_position() - d_read_pos >= d_item_size)
+        {
+            return;  // the interrupt may have been raised before it was enabled
+        }
+    pollfd pfd{d_device_descriptor, POLLIN, 0};
+    if (poll(&pfd, 1, WAIT_TIMEOUT_MS) > 0)
+        {
+            int32_t irq_count;
+            if (read(d_device_descriptor, &irq_count, sizeof(irq_count)) != sizeof(irq_count))
+                {
+                    LOG(WARNING) << "Sample tap read failed to retrieve 4 bytes";
+                }
+        }
+}
+
+
+int fpga_sample_tap_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    uint64_t items = (write_position() - d_read_pos) / d_item_size;
+    if (items == 0)
+        {
+            wait_samples();
+            items = (write_position() - d_read_pos) / d_item_size;
+        }
+    items = std::min(items, static_cast<uint64_t>(noutput_items));
+
+    // the ring is mapped twice, so the items are contiguous even if they wrap around
+    std::memcpy(output_items[0], d_ring + (d_read_pos & (d_capacity - 1)), items * d_item_size);
+    d_read_pos += items * d_item_size;
+
+    // the samples have been read before the FPGA can overwrite them
+    std::atomic_thread_fence(std::memory_order_release);
+    d_map_base[read_pos_lsw_reg_addr] = static_cast<uint32_t>(d_read_pos & 0xFFFFFFFF);
+    d_map_base[read_pos_msw_reg_addr] = static_cast<uint32_t>(d_read_pos >> 32);
+
+    const auto dropped = static_cast<uint32_t>(dropped_bytes());
+    if (dropped != d_reported_dropped_bytes)
+        {
+            LOG(WARNING) << "The FPGA sample tap dropped " << static_cast<uint32_t>(dropped - d_reported_dropped_bytes)
+                         << " bytes because the receiver fell behind";
+            d_reported_dropped_bytes = dropped;
+        }
+    return static_cast<int>(items);
+}
+
+
+void fpga_sample_tap_source::close_device()
+{
+    if (d_ring != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(d_ring), d_ring_map_size);
+            d_ring = nullptr;
+        }
+    if (d_map_base != nullptr)
+        {
+            d_map_base[enable_reg_addr] = 0;
+            munmap(const_cast<uint32_t *>(d_map_base), FPGA_PAGE_SIZE);
+            d_map_base = nullptr;
+        }
+    if (d_device_descriptor != -1)
+        {
+            close(d_device_descriptor);
+            d_device_descriptor = -1;
+        }
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file fpga_sample_tap_source.h
+ * \brief GNU Radio source that outputs the samples that the FPGA writes by DMA
+ * into a ring buffer in host memory, in parallel to its own signal processing.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FPGA_SAMPLE_TAP_SOURCE_H
+#define GNSS_SDR_FPGA_SAMPLE_TAP_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class fpga_sample_tap_source;
+
+using fpga_sample_tap_source_sptr = gnss_shared_ptr<fpga_sample_tap_source>;
+
+fpga_sample_tap_source_sptr make_fpga_sample_tap_source(size_t item_size, const std::string &device_io_name, uint32_t irq_bytes);
+
+/*!
+ * \brief Outputs the samples that the FPGA sample tap writes into a DMA ring
+ * buffer, so that host-side blocks (recording, monitoring) see the same
+ * samples as the FPGA acquisition and tracking without a second capture path.
+ *
+ * The UIO device exposes the registers of the tap in its first memory map and
+ * the ring buffer in the second one. The FPGA writes the samples through a
+ * cache-coherent port and then advances its write position; the block reads
+ * the samples in place and gives the space back by advancing its read
+ * position. The FPGA never overwrites unread samples: if the block falls
+ * behind, the samples that do not fit are dropped and counted, and the drops
+ * are logged. The ring is mapped twice in a row, so work() copies any run of
+ * samples straight into the output buffer with a single memcpy. Between
+ * samples, the block sleeps on the interrupt of the tap, raised every
+ * irq_bytes bytes.
+ *
+ * Throws std::runtime_error if the device cannot be opened or mapped.
+ */
+class fpga_sample_tap_source : public gr::sync_block
+{
+public:
+    ~fpga_sample_tap_source();
+
+    bool start();
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    //! Bytes dropped by the FPGA so far because the ring was full
+    uint64_t dropped_bytes() const;
+
+private:
+    friend fpga_sample_tap_source_sptr make_fpga_sample_tap_source(size_t item_size, const std::string &device_io_name, uint32_t irq_bytes);
+
+    fpga_sample_tap_source(size_t item_size, const std::string &device_io_name, uint32_t irq_bytes);
+
+    uint64_t write_position() const;
+    void wait_samples();
+    void close_device();
+
+    static const size_t FPGA_PAGE_SIZE = 0x10000;
+    static const uint32_t TEST_REGISTER_WRITEVAL = 0x55AA;
+    static constexpr int WAIT_TIMEOUT_MS = 100;  // so that the scheduler can stop the block
+    // read-write addresses
+    static const uint32_t enable_reg_addr = 0;
+    static const uint32_t read_pos_lsw_reg_addr = 3;
+    static const uint32_t read_pos_msw_reg_addr = 4;
+    static const uint32_t irq_bytes_reg_addr = 7;
+    static const uint32_t test_reg_addr = 8;
+    // read addresses
+    static const uint32_t write_pos_lsw_reg_addr = 1;  // reading it latches the MSW
+    static const uint32_t write_pos_msw_reg_addr = 2;
+    static const uint32_t capacity_reg_addr = 5;       // bytes, a power of two multiple of the page size
+    static const uint32_t dropped_bytes_reg_addr = 6;  // modulo 2^32
+
+    std::string d_device_io_name;
+    volatile uint32_t *d_map_base;  // registers of the tap
+    const uint8_t *d_ring;          // ring buffer, mapped twice in a row
+    size_t d_ring_map_size;
+    uint64_t d_capacity;
+    uint64_t d_read_pos;
+    size_t d_item_size;
+    uint32_t d_irq_bytes;
+    uint32_t d_reported_dropped_bytes;
+    int d_device_descriptor;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FPGA_SAMPLE_TAP_SOURCE_H
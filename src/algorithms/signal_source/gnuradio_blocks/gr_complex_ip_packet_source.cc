@@ -2,7 +2,8 @@
  * \file gr_complex_ip_packet_source.cc
  *
  * \brief Receives ip frames containing samples in UDP frame encapsulation
- * using a high performance packet capture library (libpcap)
+ * using a high performance packet capture library (libpcap), or a
+ * memory-mapped TPACKET_V3 ring on GNU/Linux
  * \author Javier Arribas jarribas (at) cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -18,10 +19,20 @@
 
 
 #include "gr_complex_ip_packet_source.h"
+#include "gnss_sdr_sample_gap.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <utility>
+#if defined(__linux__)
+#include <linux/if_packet.h>
+#endif
 #if HAS_GENERIC_LAMBDA
 #else
 #include <boost/bind/bind.hpp>
@@ -29,6 +40,17 @@
 
 const int FIFO_SIZE = 1472000;
 
+// Time work() waits for packets before returning to the scheduler
+constexpr std::chrono::milliseconds FIFO_READ_TIMEOUT(10);
+
+// TPACKET_V3 ring geometry: 64 blocks of 4 MiB, each one handed to user space
+// when it is full or after RING_BLOCK_TIMEOUT_MS
+const unsigned int RING_BLOCK_SIZE = 1 << 22;
+const unsigned int RING_BLOCK_NR = 64;
+const unsigned int RING_FRAME_SIZE = 2048;
+const unsigned int RING_BLOCK_TIMEOUT_MS = 10;
+const int RING_POLL_TIMEOUT_MS = 100;
+
 
 /* 4 bytes IP address */
 typedef struct gr_ip_address
@@ -75,7 +97,8 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    const std::string &capture_backend)
 {
     return gnuradio::get_initial_sptr(new Gr_Complex_Ip_Packet_Source(std::move(src_device),
         origin_address,
@@ -84,7 +107,8 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
         n_baseband_channels,
         wire_sample_type,
         item_size,
-        IQ_swap_));
+        IQ_swap_,
+        capture_backend));
 }
 
 
@@ -98,21 +122,35 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    const std::string &capture_backend)
     : gr::sync_block("gr_complex_ip_packet_source",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 4, item_size)),  // 1 to 4 baseband complex channels
       d_pcap_thread(nullptr),
       d_src_device(std::move(src_device)),
       descr(nullptr),
-      fifo_buff(new char[FIFO_SIZE]),
-      fifo_read_ptr(0),
-      fifo_write_ptr(0),
-      fifo_items(0),
+      d_fifo(FIFO_SIZE),
       d_sock_raw(0),
       d_udp_port(udp_port),
       d_n_baseband_channels(n_baseband_channels),
-      d_IQ_swap(IQ_swap_)
+      d_IQ_swap(IQ_swap_),
+      d_ring(nullptr),
+      d_ring_size(0),
+      d_ring_packet(nullptr),
+      d_ring_block(0),
+      d_ring_packets_left(0),
+      d_ring_fd(-1),
+      d_payload_offset(0),
+      d_carry_bytes(0),
+      d_use_ring(capture_backend == "packet_mmap"),
+      d_packets_received(0),
+      d_sequence_gaps(0),
+      d_lost_packets(0),
+      d_overflows(0),
+      d_last_ip_id(0),
+      d_stream_bytes(0),
+      d_missing_bytes(0)
 {
     memset(reinterpret_cast<char *>(&si_me), 0, sizeof(si_me));
     if (wire_sample_type == "cbyte")
@@ -140,6 +178,17 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
             std::cout << "Unknown wire sample type\n";
             exit(0);
         }
+    if (!d_use_ring && capture_backend != "pcap")
+        {
+            std::cout << "Unknown capture backend " << capture_backend << ", using pcap\n";
+        }
+#if !defined(__linux__)
+    if (d_use_ring)
+        {
+            std::cout << "The packet_mmap capture backend is only available on GNU/Linux, using pcap\n";
+            d_use_ring = false;
+        }
+#endif
     std::cout << "Start Ethernet packet capture\n";
     std::cout << "Overflow events will be indicated by o's\n";
     std::cout << "d_wire_sample_type:" << d_wire_sample_type << '\n';
@@ -150,6 +199,11 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
 bool Gr_Complex_Ip_Packet_Source::start()
 {
     std::cout << "gr_complex_ip_packet_source START\n";
+    if (d_use_ring)
+        {
+            // work() reads the ring, no capture thread is needed
+            return open_ring();
+        }
     // open the ethernet device
     if (open() == true)
         {
@@ -170,12 +224,26 @@ bool Gr_Complex_Ip_Packet_Source::start()
 bool Gr_Complex_Ip_Packet_Source::stop()
 {
     std::cout << "gr_complex_ip_packet_source STOP\n";
+    if (d_use_ring)
+        {
+            update_ring_statistics();
+            close_ring();
+        }
     if (descr != nullptr)
         {
             pcap_breakloop(descr);
             d_pcap_thread->join();
+            struct pcap_stat stats
+            {
+            };
+            if (pcap_stats(descr, &stats) == 0)
+                {
+                    d_lost_packets += stats.ps_drop;
+                }
             pcap_close(descr);
+            descr = nullptr;
         }
+    print_statistics();
     return true;
 }
 
@@ -192,6 +260,12 @@ bool Gr_Complex_Ip_Packet_Source::open()
             std::cout << "Fatal Error in pcap_open_live(): " << std::string(errbuf.data()) << '\n';
             return false;
         }
+    return bind_udp_port();
+}
+
+
+bool Gr_Complex_Ip_Packet_Source::bind_udp_port()
+{
     // bind UDP port to avoid automatic reply with ICMP port unreachable packets from kernel
     d_sock_raw = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if (d_sock_raw == -1)
@@ -217,13 +291,140 @@ bool Gr_Complex_Ip_Packet_Source::open()
 }
 
 
+bool Gr_Complex_Ip_Packet_Source::open_ring()
+{
+#if defined(__linux__)
+    d_ring_fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_IP));
+    if (d_ring_fd == -1)
+        {
+            std::cout << "Error opening packet socket on " << d_src_device << ": " << strerror(errno) << '\n';
+            return false;
+        }
+
+    int version = TPACKET_V3;
+    struct tpacket_req3 req
+    {
+    };
+    req.tp_block_size = RING_BLOCK_SIZE;
+    req.tp_block_nr = RING_BLOCK_NR;
+    req.tp_frame_size = RING_FRAME_SIZE;
+    req.tp_frame_nr = (RING_BLOCK_SIZE / RING_FRAME_SIZE) * RING_BLOCK_NR;
+    req.tp_retire_blk_tov = RING_BLOCK_TIMEOUT_MS;
+    if (setsockopt(d_ring_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) == -1 ||
+        setsockopt(d_ring_fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) == -1)
+        {
+            std::cout << "Error setting up the TPACKET_V3 ring: " << strerror(errno) << '\n';
+            close_ring();
+            return false;
+        }
+
+    d_ring_size = static_cast<size_t>(RING_BLOCK_SIZE) * RING_BLOCK_NR;
+    void *ring = mmap(nullptr, d_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, d_ring_fd, 0);
+    if (ring == MAP_FAILED)
+        {
+            // locking the ring may exceed RLIMIT_MEMLOCK, it is only an optimization
+            ring = mmap(nullptr, d_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, d_ring_fd, 0);
+        }
+    if (ring == MAP_FAILED)
+        {
+            std::cout << "Error mapping the TPACKET_V3 ring: " << strerror(errno) << '\n';
+            d_ring_size = 0;
+            close_ring();
+            return false;
+        }
+    d_ring = static_cast<uint8_t *>(ring);
+
+    struct sockaddr_ll address
+    {
+    };
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_IP);
+    address.sll_ifindex = static_cast<int>(if_nametoindex(d_src_device.c_str()));
+    if (address.sll_ifindex == 0 || bind(d_ring_fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == -1)
+        {
+            std::cout << "Error opening Ethernet device " << d_src_device << ": " << strerror(errno) << '\n';
+            close_ring();
+            return false;
+        }
+
+    // same promiscuous capture as with libpcap
+    struct packet_mreq membership
+    {
+    };
+    membership.mr_ifindex = address.sll_ifindex;
+    membership.mr_type = PACKET_MR_PROMISC;
+    setsockopt(d_ring_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &membership, sizeof(membership));
+
+    d_ring_block = 0;
+    d_ring_packets_left = 0;
+    d_ring_packet = nullptr;
+    d_payload_offset = 0;
+    d_carry_bytes = 0;
+    return bind_udp_port();
+#else
+    return false;
+#endif
+}
+
+
+void Gr_Complex_Ip_Packet_Source::close_ring()
+{
+    if (d_ring != nullptr)
+        {
+            munmap(d_ring, d_ring_size);
+            d_ring = nullptr;
+            d_ring_size = 0;
+        }
+    if (d_ring_fd != -1)
+        {
+            close(d_ring_fd);
+            d_ring_fd = -1;
+        }
+}
+
+
+void Gr_Complex_Ip_Packet_Source::update_ring_statistics()
+{
+#if defined(__linux__)
+    // the kernel resets its counters on each read
+    struct tpacket_stats_v3 stats
+    {
+    };
+    socklen_t length = sizeof(stats);
+    if (d_ring_fd != -1 && getsockopt(d_ring_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &length) == 0 && stats.tp_drops > 0)
+        {
+            d_lost_packets += stats.tp_drops;
+            // notify overflow
+            std::cout << "o" << std::flush;
+        }
+#endif
+}
+
+
+void Gr_Complex_Ip_Packet_Source::print_statistics() const
+{
+    LOG(INFO) << "UDP source on " << d_src_device << ":" << d_udp_port << ": "
+              << d_packets_received << " packets received, "
+              << d_sequence_gaps << " packets missing in the IP identification sequence, "
+              << d_lost_packets << " packets dropped by the kernel, "
+              << d_overflows << " packets dropped by buffer overflows";
+    if (d_sequence_gaps > 0 || d_lost_packets > 0 || d_overflows > 0)
+        {
+            std::cout << "UDP source: " << d_packets_received << " packets received, "
+                      << d_sequence_gaps << " sequence gaps, "
+                      << d_lost_packets << " dropped by the kernel, "
+                      << d_overflows << " overflows\n";
+        }
+}
+
+
 Gr_Complex_Ip_Packet_Source::~Gr_Complex_Ip_Packet_Source()
 {
     if (d_pcap_thread != nullptr)
         {
             delete d_pcap_thread;
         }
-    delete[] fifo_buff;
+    close_ring();
     std::cout << "Stop Ethernet packet capture\n";
 }
 
@@ -241,75 +442,70 @@ void Gr_Complex_Ip_Packet_Source::pcap_callback(__attribute__((unused)) u_char *
 {
     boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
 
+    int payload_length_bytes = 0;
+    const u_char *udp_payload = this->udp_payload(packet, payload_length_bytes);
+    if (udp_payload != nullptr)
+        {
+            // insert the payload bytes into the buffer read by work()
+            if (d_fifo.write(udp_payload, payload_length_bytes, false))
+                {
+                    add_packet_to_stream(payload_length_bytes);
+                }
+            else
+                {
+                    // notify overflow
+                    d_missing_bytes += payload_length_bytes;
+                    d_overflows++;
+                    std::cout << "o" << std::flush;
+                }
+        }
+}
+
+
+const u_char *Gr_Complex_Ip_Packet_Source::udp_payload(const u_char *packet, int &payload_length_bytes)
+{
     const gr_ip_header *ih;
     const gr_udp_header *uh;
 
     // eth frame parameters
     // **** UDP RAW PACKET DECODER ****
-    if ((packet[12] == 0x08) & (packet[13] == 0x00))  // IP FRAME
-        {
-            // retrieve the position of the ip header
-            ih = reinterpret_cast<const gr_ip_header *>(packet + 14);  // length of ethernet header
-
-            // retrieve the position of the udp header
-            u_int ip_len;
-            ip_len = (ih->ver_ihl & 0xf) * 4;
-            uh = reinterpret_cast<const gr_udp_header *>(reinterpret_cast<const u_char *>(ih) + ip_len);
-
-            // convert from network byte order to host byte order
-            // u_short sport;
-            u_short dport;
-            dport = ntohs(uh->dport);
-            // sport = ntohs(uh->sport);
-            if (dport == d_udp_port)
+    if ((packet[12] != 0x08) || (packet[13] != 0x00))  // not an IP FRAME
+        {
+            return nullptr;
+        }
+
+    // retrieve the position of the ip header
+    ih = reinterpret_cast<const gr_ip_header *>(packet + 14);  // length of ethernet header
+
+    // retrieve the position of the udp header
+    u_int ip_len;
+    ip_len = (ih->ver_ihl & 0xf) * 4;
+    uh = reinterpret_cast<const gr_udp_header *>(reinterpret_cast<const u_char *>(ih) + ip_len);
+
+    // convert from network byte order to host byte order
+    if (ntohs(uh->dport) != d_udp_port)
+        {
+            return nullptr;
+        }
+
+    payload_length_bytes = ntohs(uh->len) - 8;  // total udp packet length minus the header length
+
+    // count the packets missing in the IP identification sequence
+    const auto ip_id = static_cast<uint16_t>(ntohs(ih->identification));
+    if (d_packets_received > 0)
+        {
+            const auto gap = static_cast<uint16_t>(ip_id - d_last_ip_id - 1);
+            if (gap > 0 && gap < 0x8000)
                 {
-                    // print ip addresses and udp ports
-                    //            printf("%d.%d.%d.%d.%d -> %d.%d.%d.%d.%d\n",
-                    //                   ih->saddr.byte1,
-                    //                   ih->saddr.byte2,
-                    //                   ih->saddr.byte3,
-                    //                   ih->saddr.byte4,
-                    //                   sport,
-                    //                   ih->daddr.byte1,
-                    //                   ih->daddr.byte2,
-                    //                   ih->daddr.byte3,
-                    //                   ih->daddr.byte4,
-                    //                   dport);
-                    //            std::cout<<"uh->len:"<<ntohs(uh->len)<< '\n';
-
-                    int payload_length_bytes = ntohs(uh->len) - 8;  // total udp packet length minus the header length
-                    // read the payload bytes and insert them into the shared circular buffer
-                    const u_char *udp_payload = (reinterpret_cast<const u_char *>(uh) + sizeof(gr_udp_header));
-                    if (fifo_items <= (FIFO_SIZE - payload_length_bytes))
-                        {
-                            int aligned_write_items = FIFO_SIZE - fifo_write_ptr;
-                            if (aligned_write_items >= payload_length_bytes)
-                                {
-                                    // write all in a single memcpy
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], payload_length_bytes);  // size in bytes
-                                    fifo_write_ptr += payload_length_bytes;
-                                    if (fifo_write_ptr == FIFO_SIZE)
-                                        {
-                                            fifo_write_ptr = 0;
-                                        }
-                                    fifo_items += payload_length_bytes;
-                                }
-                            else
-                                {
-                                    // two step wrap write
-                                    memcpy(&fifo_buff[fifo_write_ptr], &udp_payload[0], aligned_write_items);  // size in bytes
-                                    fifo_write_ptr = payload_length_bytes - aligned_write_items;
-                                    memcpy(&fifo_buff[0], &udp_payload[aligned_write_items], fifo_write_ptr);  // size in bytes
-                                    fifo_items += payload_length_bytes;
-                                }
-                        }
-                    else
-                        {
-                            // notify overflow
-                            std::cout << "o" << std::flush;
-                        }
+                    d_sequence_gaps += gap;
+                    // the lost packets are assumed to be as long as this one
+                    d_missing_bytes += static_cast<uint64_t>(gap) * static_cast<uint64_t>(payload_length_bytes);
                 }
         }
+    d_last_ip_id = ip_id;
+    d_packets_received++;
+
+    return reinterpret_cast<const u_char *>(uh) + sizeof(gr_udp_header);
 }
 
 
@@ -319,9 +515,9 @@ void Gr_Complex_Ip_Packet_Source::my_pcap_loop_thread(pcap_t *pcap_handle)
 }
 
 
-void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &output_items, int num_samples_readed)
+void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &output_items, const char *in, int first_sample, int num_samples) const
 {
-    for (int n = 0; n < num_samples_readed; n++)
+    for (int n = first_sample; n < first_sample + num_samples; n++)
         {
             switch (d_wire_sample_type)
                 {
@@ -330,8 +526,8 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                         {
                             int8_t real;
                             int8_t imag;
-                            real = fifo_buff[fifo_read_ptr++];
-                            imag = fifo_buff[fifo_read_ptr++];
+                            real = *in++;
+                            imag = *in++;
                             if (d_IQ_swap)
                                 {
                                     static_cast<gr_complex *>(output_item)[n] = gr_complex(real, imag);
@@ -348,7 +544,7 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                             int8_t real;
                             int8_t imag;
                             uint8_t tmp_char2;
-                            tmp_char2 = fifo_buff[fifo_read_ptr] & 0x0F;
+                            tmp_char2 = *in & 0x0F;
                             if (tmp_char2 >= 8)
                                 {
                                     real = 2 * (tmp_char2 - 16) + 1;
@@ -357,7 +553,7 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                                 {
                                     real = 2 * tmp_char2 + 1;
                                 }
-                            tmp_char2 = fifo_buff[fifo_read_ptr++] >> 4;
+                            tmp_char2 = *in++ >> 4;
                             tmp_char2 = tmp_char2 & 0x0F;
                             if (tmp_char2 >= 8)
                                 {
@@ -382,10 +578,10 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                         {
                             float real;
                             float imag;
-                            memcpy(&real, &fifo_buff[fifo_read_ptr], sizeof(real));
-                            fifo_read_ptr += 4;  // Four bytes in float
-                            memcpy(&imag, &fifo_buff[fifo_read_ptr], sizeof(imag));
-                            fifo_read_ptr += 4;  // Four bytes in float
+                            memcpy(&real, in, sizeof(real));
+                            in += 4;  // Four bytes in float
+                            memcpy(&imag, in, sizeof(imag));
+                            in += 4;  // Four bytes in float
                             if (d_IQ_swap)
                                 {
                                     static_cast<gr_complex *>(output_item)[n] = gr_complex(real, imag);
@@ -401,10 +597,10 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                         {
                             int16_t real;
                             int16_t imag;
-                            memcpy(&real, &fifo_buff[fifo_read_ptr], sizeof(real));
-                            fifo_read_ptr += 2;  // two bytes in short
-                            memcpy(&imag, &fifo_buff[fifo_read_ptr], sizeof(imag));
-                            fifo_read_ptr += 2;  // two bytes in short
+                            memcpy(&real, in, sizeof(real));
+                            in += 2;  // two bytes in short
+                            memcpy(&imag, in, sizeof(imag));
+                            in += 2;  // two bytes in short
                             if (d_IQ_swap)
                                 {
                                     static_cast<gr_complex *>(output_item)[n] = gr_complex(real, imag);
@@ -419,49 +615,187 @@ void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &outpu
                     std::cout << "Unknown wire sample type\n";
                     exit(0);
                 }
-            if (fifo_read_ptr == FIFO_SIZE)
+            // skip the channels that are not connected
+            in += d_bytes_per_sample / d_n_baseband_channels * (d_n_baseband_channels - static_cast<int>(output_items.size()));
+        }
+}
+
+
+void Gr_Complex_Ip_Packet_Source::add_packet_to_stream(int payload_length_bytes)
+{
+    if (d_missing_bytes > 0)
+        {
+            d_sample_gaps.emplace_back(d_stream_bytes / d_bytes_per_sample, d_missing_bytes / d_bytes_per_sample);
+            d_missing_bytes = 0;
+        }
+    d_stream_bytes += payload_length_bytes;
+}
+
+
+void Gr_Complex_Ip_Packet_Source::tag_sample_gaps(const gr_vector_void_star &output_items, int produced)
+{
+    const uint64_t first_sample = nitems_written(0);
+    while (!d_sample_gaps.empty() && d_sample_gaps.front().first < first_sample + produced)
+        {
+            const auto &gap = d_sample_gaps.front();
+            if (gap.second > 0)
                 {
-                    fifo_read_ptr = 0;
+                    for (size_t n = 0; n < output_items.size(); n++)
+                        {
+                            add_item_tag(static_cast<unsigned int>(n), std::max(gap.first, first_sample), sample_gap_key(), make_sample_gap(gap.second));
+                        }
                 }
+            d_sample_gaps.pop_front();
         }
 }
 
 
-int Gr_Complex_Ip_Packet_Source::work(int noutput_items,
-    __attribute__((unused)) gr_vector_const_void_star &input_items,
-    gr_vector_void_star &output_items)
+int Gr_Complex_Ip_Packet_Source::ring_work(int noutput_items, const gr_vector_void_star &output_items)
 {
-    // send samples to next GNU Radio block
-    boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
-    if (fifo_items == 0)
+    int produced = 0;
+#if defined(__linux__)
+    while (produced < noutput_items)
         {
-            return 0;
+            auto *block = reinterpret_cast<struct tpacket_block_desc *>(d_ring + static_cast<size_t>(d_ring_block) * RING_BLOCK_SIZE);
+            if (d_ring_packet == nullptr)
+                {
+                    // wait for the kernel to hand over the next block
+                    if ((block->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+                        {
+                            if (produced > 0)
+                                {
+                                    break;
+                                }
+                            struct pollfd pfd
+                            {
+                            };
+                            pfd.fd = d_ring_fd;
+                            pfd.events = POLLIN | POLLERR;
+                            poll(&pfd, 1, RING_POLL_TIMEOUT_MS);
+                            if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+                                {
+                                    break;
+                                }
+                        }
+                    d_ring_packets_left = block->hdr.bh1.num_pkts;
+                    d_ring_packet = reinterpret_cast<const uint8_t *>(block) + block->hdr.bh1.offset_to_first_pkt;
+                    d_payload_offset = 0;
+                }
+
+            if (d_ring_packets_left == 0)
+                {
+                    // give the block back to the kernel
+                    __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+                    d_ring_block = (d_ring_block + 1) % RING_BLOCK_NR;
+                    d_ring_packet = nullptr;
+                    update_ring_statistics();
+                    continue;
+                }
+
+            const auto *header = reinterpret_cast<const struct tpacket3_hdr *>(d_ring_packet);
+            int payload_length_bytes = 0;
+            const u_char *payload = nullptr;
+            if (d_payload_offset == 0)
+                {
+                    payload = udp_payload(d_ring_packet + header->tp_mac, payload_length_bytes);
+                }
+            else
+                {
+                    // the packet was already counted by udp_payload()
+                    const auto *uh = reinterpret_cast<const gr_udp_header *>(d_ring_packet + header->tp_mac + 14 + (d_ring_packet[header->tp_mac + 14] & 0xf) * 4);
+                    payload_length_bytes = ntohs(uh->len) - 8;
+                    payload = reinterpret_cast<const u_char *>(uh) + sizeof(gr_udp_header);
+                }
+            if (payload != nullptr)
+                {
+                    // bound the payload by the captured length
+                    const int captured_payload = static_cast<int>(header->tp_snaplen) - static_cast<int>(payload - (d_ring_packet + header->tp_mac));
+                    payload_length_bytes = std::min(payload_length_bytes, captured_payload);
+                    if (d_payload_offset == 0)
+                        {
+                            add_packet_to_stream(payload_length_bytes);
+                        }
+                    const auto *in = reinterpret_cast<const char *>(payload);
+                    if (d_carry_bytes > 0)
+                        {
+                            // complete the sample that started in the previous packet
+                            const int bytes = std::min(d_bytes_per_sample - d_carry_bytes, payload_length_bytes - d_payload_offset);
+                            memcpy(d_carry.data() + d_carry_bytes, in + d_payload_offset, bytes);
+                            d_carry_bytes += bytes;
+                            d_payload_offset += bytes;
+                            if (d_carry_bytes == d_bytes_per_sample)
+                                {
+                                    demux_samples(output_items, d_carry.data(), produced, 1);
+                                    produced++;
+                                    d_carry_bytes = 0;
+                                    continue;
+                                }
+                        }
+                    else
+                        {
+                            const int samples = std::min(noutput_items - produced, (payload_length_bytes - d_payload_offset) / d_bytes_per_sample);
+                            demux_samples(output_items, in + d_payload_offset, produced, samples);
+                            produced += samples;
+                            d_payload_offset += samples * d_bytes_per_sample;
+                            if (payload_length_bytes - d_payload_offset >= d_bytes_per_sample)
+                                {
+                                    // the output buffer is full, keep reading this packet in the next call
+                                    break;
+                                }
+                            // keep the incomplete sample at the end of the packet, if any
+                            d_carry_bytes = payload_length_bytes - d_payload_offset;
+                            memcpy(d_carry.data(), in + d_payload_offset, d_carry_bytes);
+                        }
+                }
+            d_ring_packet += header->tp_next_offset;
+            d_ring_packets_left--;
+            d_payload_offset = 0;
         }
+#else
+    // the ring backend is only selected on Linux
+    static_cast<void>(noutput_items);
+    static_cast<void>(output_items);
+#endif
+    return produced;
+}
+
 
+int Gr_Complex_Ip_Packet_Source::work(int noutput_items,
+    __attribute__((unused)) gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
     if (output_items.size() > static_cast<uint64_t>(d_n_baseband_channels))
         {
             std::cout << "Configuration error: more baseband channels connected than available in the UDP source\n";
             exit(0);
         }
-    int num_samples_readed;
-    int bytes_requested;
 
-    bytes_requested = noutput_items * d_bytes_per_sample;
-    if (bytes_requested < fifo_items)
+    int num_samples_readed;
+    if (d_use_ring)
         {
-            num_samples_readed = noutput_items;  // read all
+            // batch dequeue from the ring directly into the output buffers
+            num_samples_readed = ring_work(noutput_items, output_items);
+            tag_sample_gaps(output_items, num_samples_readed);
         }
     else
         {
-            num_samples_readed = fifo_items / d_bytes_per_sample;  // read what we have
+            // send samples to next GNU Radio block
+            const size_t bytes_requested = static_cast<size_t>(noutput_items) * d_bytes_per_sample;
+            if (d_fifo_samples.size() < bytes_requested)
+                {
+                    d_fifo_samples.resize(bytes_requested);
+                }
+            const size_t bytes_read = d_fifo.read(d_fifo_samples.data(), bytes_requested, d_bytes_per_sample, FIFO_READ_TIMEOUT);
+            if (bytes_read == 0)
+                {
+                    return 0;
+                }
+            num_samples_readed = static_cast<int>(bytes_read / d_bytes_per_sample);
+            demux_samples(output_items, d_fifo_samples.data(), 0, num_samples_readed);
+            boost::mutex::scoped_lock lock(d_mutex);
+            tag_sample_gaps(output_items, num_samples_readed);
         }
 
-    bytes_requested = num_samples_readed * d_bytes_per_sample;
-    // read all in a single loop
-    demux_samples(output_items, num_samples_readed);  // it also increases the fifo read pointer
-    // update fifo items
-    fifo_items = fifo_items - bytes_requested;
-
     for (uint64_t n = 0; n < output_items.size(); n++)
         {
             produce(static_cast<int>(n), num_samples_readed);
@@ -2,7 +2,8 @@
  * \file gr_complex_ip_packet_source.h
  *
  * \brief Receives ip frames containing samples in UDP frame encapsulation
- * using a high performance packet capture library (libpcap)
+ * using a high performance packet capture library (libpcap), or a
+ * memory-mapped TPACKET_V3 ring on GNU/Linux
  * \author Javier Arribas jarribas (at) cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -21,6 +22,7 @@
 #define GNSS_SDR_GR_COMPLEX_IP_PACKET_SOURCE_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_ingest_buffer.h"
 #include <boost/thread.hpp>
 #include <gnuradio/sync_block.h>
 #include <arpa/inet.h>
@@ -28,7 +30,12 @@
 #include <net/if.h>
 #include <netinet/if_ether.h>
 #include <pcap.h>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <utility>
+#include <vector>
 #include <sys/ioctl.h>
 
 /** \addtogroup Signal_Source
@@ -49,7 +56,8 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        const std::string &capture_backend);
     Gr_Complex_Ip_Packet_Source(std::string src_device,
         const std::string &origin_address,
         int udp_port,
@@ -57,7 +65,8 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        const std::string &capture_backend);
     ~Gr_Complex_Ip_Packet_Source();
 
     // Called by gnuradio to enable drivers, etc for i/o devices.
@@ -72,15 +81,39 @@ public:
         gr_vector_void_star &output_items);
 
 private:
-    void demux_samples(const gr_vector_void_star &output_items, int num_samples_readed);
+    static constexpr int MAX_BYTES_PER_SAMPLE = 32;  // 4 channels of cfloat samples
+
+    void demux_samples(const gr_vector_void_star &output_items, const char *in, int first_sample, int num_samples) const;
     void my_pcap_loop_thread(pcap_t *pcap_handle);
     void pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
     static void static_pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
+    /*
+     * Returns the UDP payload of an Ethernet frame addressed to d_udp_port, or
+     * nullptr for other frames, and updates the packet counters
+     */
+    const u_char *udp_payload(const u_char *packet, int &payload_length_bytes);
     /*
      * Opens the ethernet device using libpcap raw capture mode
      * If any of these fail, the function returns the error and exits.
      */
     bool open();
+    bool bind_udp_port();
+    /*
+     * Opens the ethernet device with a memory-mapped TPACKET_V3 ring, from
+     * which work() copies the samples directly into the output buffers
+     */
+    bool open_ring();
+    void close_ring();
+    int ring_work(int noutput_items, const gr_vector_void_star &output_items);
+    void update_ring_statistics();
+    /*
+     * Accounts for a packet entering the output stream, and records the gap
+     * left by the packets lost before it, if any
+     */
+    void add_packet_to_stream(int payload_length_bytes);
+    // Tags the gaps that fall in the samples produced by this call of work()
+    void tag_sample_gaps(const gr_vector_void_star &output_items, int produced);
+    void print_statistics() const;
 
     boost::thread *d_pcap_thread;
     boost::mutex d_mutex;
@@ -90,16 +123,39 @@ private:
     std::string d_src_device;
     std::string d_origin_address;
     pcap_t *descr;  // ethernet pcap device descriptor
-    char *fifo_buff;
-    int fifo_read_ptr;
-    int fifo_write_ptr;
-    int fifo_items;
+    Gnss_Sdr_Ingest_Buffer d_fifo;    // payloads captured by the pcap thread
+    std::vector<char> d_fifo_samples;  // samples read from d_fifo in work()
     int d_sock_raw;
     int d_udp_port;
     int d_n_baseband_channels;
     int d_wire_sample_type;
     int d_bytes_per_sample;
     bool d_IQ_swap;
+
+    // TPACKET_V3 ring and current read position in it
+    uint8_t *d_ring;
+    size_t d_ring_size;
+    const uint8_t *d_ring_packet;
+    uint32_t d_ring_block;
+    uint32_t d_ring_packets_left;
+    int d_ring_fd;
+    int d_payload_offset;  // bytes of the current packet already read
+    int d_carry_bytes;     // bytes of a sample split between two packets
+    std::array<char, MAX_BYTES_PER_SAMPLE> d_carry{};
+    bool d_use_ring;
+
+    // Packet counters. Sequence gaps are detected on the IPv4 identification
+    // field, which most streaming front-ends increase by one in each packet
+    uint64_t d_packets_received;
+    uint64_t d_sequence_gaps;
+    uint64_t d_lost_packets;
+    uint64_t d_overflows;
+    uint16_t d_last_ip_id;
+
+    // Samples lost before each packet, tagged as sample_gap in the output
+    std::deque<std::pair<uint64_t, uint64_t>> d_sample_gaps;  // (stream sample, samples lost before it)
+    uint64_t d_stream_bytes;   // payload bytes that entered the output stream
+    uint64_t d_missing_bytes;  // payload bytes lost since the last packet
 };
 
 
@@ -0,0 +1,195 @@
+/*!
+ * \file iio_rx_source.cc
+ * \brief GNU Radio source that streams the samples of an AD9361-based device
+ * (ADALM-PLUTO, FMCOMMS2/3/4) straight from the libiio buffers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "iio_rx_source.h"
+#include <glog/logging.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
+#include <iio.h>
+#include <algorithm>  // for std::min
+#include <cstring>    // for memcpy, strerror
+#include <stdexcept>  // for std::runtime_error
+
+
+namespace
+{
+iio_context *create_context(const std::string &uri)
+{
+    if (uri.empty())
+        {
+            return iio_create_default_context();
+        }
+    if (uri.find(':') == std::string::npos)
+        {
+            // a bare host name or IP address, as accepted by the adapters
+            return iio_create_network_context(uri.c_str());
+        }
+    return iio_create_context_from_uri(uri.c_str());
+}
+}  // namespace
+
+
+iio_rx_source_sptr make_iio_rx_source(const std::string &uri,
+    const std::vector<int> &rx_channels,
+    size_t buffer_size,
+    unsigned int kernel_buffers,
+    const std::string &item_type)
+{
+    return iio_rx_source_sptr(new iio_rx_source(uri, rx_channels, buffer_size, kernel_buffers, item_type));
+}
+
+
+iio_rx_source::iio_rx_source(const std::string &uri,
+    const std::vector<int> &rx_channels,
+    size_t buffer_size,
+    unsigned int kernel_buffers,
+    const std::string &item_type) : gr::sync_block("iio_rx_source",
+                                        gr::io_signature::make(0, 0, 0),
+                                        gr::io_signature::make(static_cast<int>(rx_channels.size()), static_cast<int>(rx_channels.size()),
+                                            item_type == "cshort" ? static_cast<int>(2 * sizeof(int16_t)) : static_cast<int>(sizeof(gr_complex)))),
+                                    d_uri(uri),
+                                    d_context(create_context(uri)),
+                                    d_device(nullptr),
+                                    d_buffer(nullptr),
+                                    d_first(nullptr),
+                                    d_buffer_size(buffer_size),
+                                    d_items_left(0),
+                                    d_step(0),
+                                    d_offsets(rx_channels.size(), 0),
+                                    d_cshort(item_type == "cshort")
+{
+    if (d_context == nullptr)
+        {
+            throw std::runtime_error("iio_rx_source: no IIO context at " + uri);
+        }
+    d_device = iio_context_find_device(d_context, "cf-ad9361-lpc");
+    if (d_device == nullptr)
+        {
+            iio_context_destroy(d_context);
+            throw std::runtime_error("iio_rx_source: no cf-ad9361-lpc device at " + uri);
+        }
+    for (const int rx_channel : rx_channels)
+        {
+            // I and Q of RX1 are voltage0 and voltage1, those of RX2 voltage2 and voltage3
+            iio_channel *i_channel = iio_device_find_channel(d_device, ("voltage" + std::to_string(2 * rx_channel)).c_str(), false);
+            iio_channel *q_channel = iio_device_find_channel(d_device, ("voltage" + std::to_string(2 * rx_channel + 1)).c_str(), false);
+            if (i_channel == nullptr or q_channel == nullptr)
+                {
+                    iio_context_destroy(d_context);
+                    throw std::runtime_error("iio_rx_source: RX" + std::to_string(rx_channel + 1) + " not found at " + uri);
+                }
+            iio_channel_enable(i_channel);
+            iio_channel_enable(q_channel);
+            d_channels.push_back(i_channel);
+        }
+    if (kernel_buffers > 0)
+        {
+            const int ret = iio_device_set_kernel_buffers_count(d_device, kernel_buffers);
+            if (ret < 0)
+                {
+                    LOG(WARNING) << "Unable to set " << kernel_buffers << " kernel buffers at " << uri << ": " << std::strerror(-ret);
+                }
+        }
+    LOG(INFO) << "IIO streaming from " << uri << " with buffers of " << buffer_size << " samples";
+}
+
+
+iio_rx_source::~iio_rx_source()
+{
+    iio_rx_source::stop();
+    iio_context_destroy(d_context);
+}
+
+
+bool iio_rx_source::start()
+{
+    d_buffer = iio_device_create_buffer(d_device, d_buffer_size, false);
+    if (d_buffer == nullptr)
+        {
+            LOG(ERROR) << "Unable to create an IIO buffer of " << d_buffer_size << " samples at " << d_uri;
+            return false;
+        }
+    d_items_left = 0;
+    return true;
+}
+
+
+bool iio_rx_source::stop()
+{
+    if (d_buffer != nullptr)
+        {
+            iio_buffer_cancel(d_buffer);
+            iio_buffer_destroy(d_buffer);
+            d_buffer = nullptr;
+        }
+    return true;
+}
+
+
+int iio_rx_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    if (d_items_left == 0)
+        {
+            const ssize_t ret = iio_buffer_refill(d_buffer);
+            if (ret < 0)
+                {
+                    LOG(ERROR) << "Unable to refill the IIO buffer at " << d_uri << ": " << std::strerror(static_cast<int>(-ret));
+                    return WORK_DONE;
+                }
+            d_step = static_cast<size_t>(iio_buffer_step(d_buffer));
+            d_first = static_cast<const uint8_t *>(iio_buffer_first(d_buffer, d_channels[0]));
+            for (size_t c = 0; c < d_channels.size(); c++)
+                {
+                    d_offsets[c] = static_cast<const uint8_t *>(iio_buffer_first(d_buffer, d_channels[c])) - d_first;
+                }
+            d_items_left = static_cast<size_t>(static_cast<const uint8_t *>(iio_buffer_end(d_buffer)) - d_first) / d_step;
+        }
+
+    const size_t items = std::min(d_items_left, static_cast<size_t>(noutput_items));
+    for (size_t c = 0; c < d_channels.size(); c++)
+        {
+            const uint8_t *in = d_first + d_offsets[c];
+            if (d_cshort and d_step == 2 * sizeof(int16_t))
+                {
+                    // a single channel: the buffer already holds the complex samples
+                    std::memcpy(output_items[c], in, items * d_step);
+                }
+            else if (d_cshort)
+                {
+                    auto *out = static_cast<int16_t *>(output_items[c]);
+                    for (size_t i = 0; i < items; i++)
+                        {
+                            std::memcpy(out + 2 * i, in + i * d_step, 2 * sizeof(int16_t));
+                        }
+                }
+            else
+                {
+                    auto *out = static_cast<gr_complex *>(output_items[c]);
+                    const float scale = 1.0F / 2048.0F;  // 12-bit samples
+                    for (size_t i = 0; i < items; i++)
+                        {
+                            int16_t sample[2];
+                            std::memcpy(sample, in + i * d_step, sizeof(sample));
+                            out[i] = gr_complex(static_cast<float>(sample[0]) * scale, static_cast<float>(sample[1]) * scale);
+                        }
+                }
+        }
+    d_first += items * d_step;
+    d_items_left -= items;
+    return static_cast<int>(items);
+}
@@ -0,0 +1,104 @@
+/*!
+ * \file iio_rx_source.h
+ * \brief GNU Radio source that streams the samples of an AD9361-based device
+ * (ADALM-PLUTO, FMCOMMS2/3/4) straight from the libiio buffers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_IIO_RX_SOURCE_H
+#define GNSS_SDR_IIO_RX_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+struct iio_buffer;
+struct iio_channel;
+struct iio_context;
+struct iio_device;
+
+class iio_rx_source;
+
+using iio_rx_source_sptr = gnss_shared_ptr<iio_rx_source>;
+
+iio_rx_source_sptr make_iio_rx_source(const std::string &uri,
+    const std::vector<int> &rx_channels,
+    size_t buffer_size,
+    unsigned int kernel_buffers,
+    const std::string &item_type);
+
+/*!
+ * \brief Streams the RX channels of the cf-ad9361-lpc device of uri (one
+ * output per entry of rx_channels, 0 for RX1 and 1 for RX2) as gr_complex
+ * (scaled as gr-iio does, by 1/2048) or as native cshort samples.
+ *
+ * The device is not configured: the adapters configure the RF front-end with
+ * gr-iio and stream with this block instead. Each refill brings buffer_size
+ * samples per channel, and kernel_buffers sets how many of those buffers the
+ * kernel (or iiod, for network and USB contexts) queues ahead of the block
+ * (0 keeps the libiio default). With local contexts, libiio maps the DMA
+ * blocks of the kernel into the process if the driver supports it, and the
+ * block reads the samples in place from them, writing each sample once into
+ * the output buffer: a copy for cshort, a conversion for gr_complex.
+ *
+ * Throws std::runtime_error if the device or its channels cannot be found.
+ */
+class iio_rx_source : public gr::sync_block
+{
+public:
+    ~iio_rx_source();
+
+    bool start();
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend iio_rx_source_sptr make_iio_rx_source(const std::string &uri,
+        const std::vector<int> &rx_channels,
+        size_t buffer_size,
+        unsigned int kernel_buffers,
+        const std::string &item_type);
+
+    iio_rx_source(const std::string &uri,
+        const std::vector<int> &rx_channels,
+        size_t buffer_size,
+        unsigned int kernel_buffers,
+        const std::string &item_type);
+
+    std::vector<iio_channel *> d_channels;  // I channel of each output
+    std::string d_uri;
+    iio_context *d_context;
+    iio_device *d_device;
+    iio_buffer *d_buffer;
+    const uint8_t *d_first;  // I of the next sample of the first channel
+    size_t d_buffer_size;
+    size_t d_items_left;
+    size_t d_step;  // bytes between samples of a channel
+    std::vector<ptrdiff_t> d_offsets;  // of each channel from the first one
+    bool d_cshort;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_IIO_RX_SOURCE_H
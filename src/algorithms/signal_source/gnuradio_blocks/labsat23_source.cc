@@ -19,12 +19,12 @@
 
 #include "labsat23_source.h"
 #include "INIReader.h"
-#include "command_event.h"
+#include "control_queue.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_thread_pool.h"
 #include <gnuradio/io_signature.h>
 #include <algorithm>
 #include <array>
-#include <bitset>
 #include <exception>
 #include <iomanip>
 #include <iostream>
@@ -33,28 +33,58 @@
 #include <utility>
 
 
-labsat23_source_sptr labsat23_make_source_sptr(const char *signal_file_basename, const std::vector<int> &channel_selector, Concurrent_Queue<pmt::pmt_t> *queue, bool digital_io_enabled)
+namespace
 {
-    return labsat23_source_sptr(new labsat23_source(signal_file_basename, channel_selector, queue, digital_io_enabled));
+size_t labsat_item_size(const std::string &item_type)
+{
+    if (item_type == "cshort")
+        {
+            return sizeof(std::complex<int16_t>);
+        }
+    if (item_type == "cbyte")
+        {
+            return sizeof(std::complex<int8_t>);
+        }
+    return sizeof(gr_complex);
+}
+}  // namespace
+
+
+labsat23_source_sptr labsat23_make_source_sptr(const char *signal_file_basename, const std::vector<int> &channel_selector, Control_Queue *queue, bool digital_io_enabled, const std::string &item_type)
+{
+    return labsat23_source_sptr(new labsat23_source(signal_file_basename, channel_selector, queue, digital_io_enabled, item_type));
 }
 
 
 labsat23_source::labsat23_source(const char *signal_file_basename,
     const std::vector<int> &channel_selector,
-    Concurrent_Queue<pmt::pmt_t> *queue,
-    bool digital_io_enabled) : gr::block("labsat23_source",
-                                   gr::io_signature::make(0, 0, 0),
-                                   gr::io_signature::make(1, 3, sizeof(gr_complex))),
-                               d_queue(queue),
-                               d_channel_selector_config(channel_selector),
-                               d_current_file_number(0),
-                               d_labsat_version(0),
-                               d_channel_selector(0),
-                               d_ref_clock(0),
-                               d_bits_per_sample(0),
-                               d_header_parsed(false),
-                               d_ls3w_digital_io_enabled(digital_io_enabled)
+    Control_Queue *queue,
+    bool digital_io_enabled,
+    const std::string &item_type) : gr::block("labsat23_source",
+                                        gr::io_signature::make(0, 0, 0),
+                                        gr::io_signature::make(1, 3, labsat_item_size(item_type))),
+                                    d_queue(queue),
+                                    d_channel_selector_config(channel_selector),
+                                    d_current_file_number(0),
+                                    d_labsat_version(0),
+                                    d_channel_selector(0),
+                                    d_ref_clock(0),
+                                    d_bits_per_sample(0),
+                                    d_header_parsed(false),
+                                    d_ls3w_digital_io_enabled(digital_io_enabled)
 {
+    if (item_type == "cshort")
+        {
+            d_decoder_16sc = std::make_unique<Labsat_Decoder<std::complex<int16_t>>>();
+        }
+    else if (item_type == "cbyte")
+        {
+            d_decoder_8sc = std::make_unique<Labsat_Decoder<std::complex<int8_t>>>();
+        }
+    else
+        {
+            d_decoder_32fc = std::make_unique<Labsat_Decoder<gr_complex>>();
+        }
     d_signal_file_basename = std::string(signal_file_basename);
     std::string signal_file;
     this->set_output_multiple(8);
@@ -70,6 +100,18 @@ labsat23_source::labsat23_source(const char *signal_file_basename,
                 {
                     exit(1);
                 }
+            if (d_decoder_32fc)
+                {
+                    d_decoder_32fc->set_ls3w_format(d_ls3w_QUA, d_ls3w_SFT, d_ls3w_spare_bits, d_ls3w_samples_per_register);
+                }
+            if (d_decoder_16sc)
+                {
+                    d_decoder_16sc->set_ls3w_format(d_ls3w_QUA, d_ls3w_SFT, d_ls3w_spare_bits, d_ls3w_samples_per_register);
+                }
+            if (d_decoder_8sc)
+                {
+                    d_decoder_8sc->set_ls3w_format(d_ls3w_QUA, d_ls3w_SFT, d_ls3w_spare_bits, d_ls3w_samples_per_register);
+                }
         }
 
     binary_input_file.open(signal_file.c_str(), std::ios::in | std::ios::binary);
@@ -357,81 +399,6 @@ int labsat23_source::parse_header()
 }
 
 
-void labsat23_source::decode_samples_one_channel(int16_t input_short, gr_complex *out, int type)
-{
-    std::bitset<16> bs(input_short);
-    switch (type)
-        {
-        case 2:
-            // two bits per sample, 8 samples per int16
-            for (int i = 0; i < 8; i++)
-                {
-                    out[i] = gr_complex(static_cast<float>(bs[15 - (2 * i)]),
-                        static_cast<float>(bs[14 - (2 * i)]));
-                    out[i] = out[i] * gr_complex(2, 0) - gr_complex(1, 1);
-                }
-            break;
-        case 4:
-            //  bits per sample, 4 samples per int16
-            for (int i = 0; i < 4; i++)
-                {
-                    // out[i] = gr_complex(0.0, 0.0);
-                    // In-Phase
-                    if (bs[15 - 4 * i])
-                        {
-                            if (bs[13 - 4 * i])  // 11
-                                {
-                                    out[i] = gr_complex(-1, 0);
-                                }
-                            else  // 10
-                                {
-                                    out[i] = gr_complex(-2, 0);
-                                }
-                        }
-                    else
-                        {
-                            if (bs[13 - 4 * i])  // 01
-                                {
-                                    out[i] = gr_complex(2, 0);
-                                }
-                            else
-                                {
-                                    out[i] = gr_complex(1, 0);
-                                }
-                        }
-
-                    // Quadrature
-                    if (bs[14 - 4 * i])
-                        {
-                            if (bs[12 - 4 * i])  // 11
-                                {
-                                    out[i] += gr_complex(0, -1);
-                                }
-                            else  // 10
-                                {
-                                    out[i] += gr_complex(0, -2);
-                                }
-                        }
-                    else
-                        {
-                            if (bs[12 - 4 * i])  // 01
-                                {
-                                    out[i] += gr_complex(0, 2);
-                                }
-                            else
-                                {
-                                    out[i] += gr_complex(0, 1);
-                                }
-                        }
-                    // out[i] += gr_complex(0.5, 0.5);
-                }
-            break;
-        default:
-            break;
-        }
-}
-
-
 int labsat23_source::read_ls3w_ini(const std::string &filename)
 {
     std::cout << "Reading " << filename << " file ...\n";
@@ -733,192 +700,71 @@ int labsat23_source::number_of_samples_per_ls3w_register() const
 }
 
 
-void labsat23_source::decode_ls3w_register(uint64_t input, std::vector<gr_complex *> &out, size_t output_pointer) const
+int labsat23_source::decode_words(int n_words, void *out) const
 {
-    std::bitset<64> bs(input);
-
-    // Reverse, since register are written to file as 64-bit little endian words
-    for (std::size_t i = 0; i < 32; ++i)
+    if (d_decoder_16sc)
         {
-            bool t = bs[i];
-            bs[i] = bs[64 - i - 1];
-            bs[64 - i - 1] = t;
+            return static_cast<int>(d_decoder_16sc->decode_words(d_words.data(), n_words, d_bits_per_sample, static_cast<std::complex<int16_t> *>(out)));
         }
-
-    int output_chan = 0;
-    for (auto channel_offset : d_ls3w_selected_channel_offset)
+    if (d_decoder_8sc)
         {
-            for (int i = 0; i < d_ls3w_samples_per_register; i++)
-                {
-                    float sampleI = 0.0;
-                    float sampleQ = 0.0;
+            return static_cast<int>(d_decoder_8sc->decode_words(d_words.data(), n_words, d_bits_per_sample, static_cast<std::complex<int8_t> *>(out)));
+        }
+    return static_cast<int>(d_decoder_32fc->decode_words(d_words.data(), n_words, d_bits_per_sample, static_cast<gr_complex *>(out)));
+}
 
-                    const int bit_offset = d_ls3w_spare_bits + i * d_ls3w_SFT + channel_offset;
-                    switch (d_ls3w_QUA)
-                        {
-                        case 1:
-                            sampleI = bs[bit_offset] ? -1.0 : 1.0;
-                            sampleQ = bs[bit_offset + 1] ? -1.0 : 1.0;
-                            break;
-                        case 2:
-                            if (bs[bit_offset])
-                                {
-                                    if (bs[bit_offset + 1])  // 11
-                                        {
-                                            sampleI = -0.5;
-                                        }
-                                    else  // 10
-                                        {
-                                            sampleI = -1.0;
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 1])  // 01
-                                        {
-                                            sampleI = 1.0;
-                                        }
-                                    else  // 00
-                                        {
-                                            sampleI = 0.5;
-                                        }
-                                }
-                            if (bs[bit_offset + 2])
-                                {
-                                    if (bs[bit_offset + 3])  // 11
-                                        {
-                                            sampleQ = -0.5;
-                                        }
-                                    else  // 10
-                                        {
-                                            sampleQ = -1.0;
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 3])  // 01
-                                        {
-                                            sampleQ = 1.0;
-                                        }
-                                    else  // 00
-                                        {
-                                            sampleQ = 0.5;
-                                        }
-                                }
-                            break;
 
-                        case 3:
-                            if (bs[bit_offset])
-                                {
-                                    if (bs[bit_offset + 1])
-                                        {
-                                            if (bs[bit_offset + 2])  // 111
-                                                {
-                                                    sampleI = -0.25;
-                                                }
-                                            else  // 110
-                                                {
-                                                    sampleI = -0.5;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 2])  // 101
-                                                {
-                                                    sampleI = -0.75;
-                                                }
-                                            else  // 100
-                                                {
-                                                    sampleI = -1.0;
-                                                }
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 1])
-                                        {
-                                            if (bs[bit_offset + 2])  // 011
-                                                {
-                                                    sampleI = 1;
-                                                }
-                                            else  // 010
-                                                {
-                                                    sampleI = 0.75;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 2])  // 001
-                                                {
-                                                    sampleI = 0.5;
-                                                }
-                                            else  // 000
-                                                {
-                                                    sampleI = 0.25;
-                                                }
-                                        }
-                                }
-                            if (bs[bit_offset + 3])
-                                {
-                                    if (bs[bit_offset + 4])
-                                        {
-                                            if (bs[bit_offset + 5])  // 111
-                                                {
-                                                    sampleQ = -0.25;
-                                                }
-                                            else  // 110
-                                                {
-                                                    sampleQ = -0.5;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 5])  // 101
-                                                {
-                                                    sampleQ = -0.75;
-                                                }
-                                            else  // 100
-                                                {
-                                                    sampleQ = -1.0;
-                                                }
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 4])
-                                        {
-                                            if (bs[bit_offset + 5])  // 011
-                                                {
-                                                    sampleQ = 1;
-                                                }
-                                            else  // 010
-                                                {
-                                                    sampleQ = 0.75;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 5])  // 001
-                                                {
-                                                    sampleQ = 0.5;
-                                                }
-                                            else  // 000
-                                                {
-                                                    sampleQ = 0.25;
-                                                }
-                                        }
-                                }
+template <typename T>
+void labsat23_source::decode_ls3w_registers(const Labsat_Decoder<T> &decoder, std::size_t n_registers, gr_vector_void_star &output_items) const
+{
+    const auto decode_channel = [&](std::size_t channel) {
+        decoder.decode_ls3w_registers(d_registers.data(), n_registers, d_ls3w_selected_channel_offset[channel], static_cast<T *>(output_items[channel]));
+    };
+    const std::size_t channels = std::min(d_ls3w_selected_channel_offset.size(), output_items.size());
+    if (channels > 1)
+        {
+            // one task per RF channel
+            Gnss_Thread_Pool::instance().parallel_for(channels, decode_channel);
+        }
+    else if (channels == 1)
+        {
+            decode_channel(0);
+        }
+}
 
-                            break;
 
-                        default:
-                            break;
-                        }
-                    gr_complex *aux = out[output_chan];
-                    aux[output_pointer + i] = gr_complex(sampleI, sampleQ);
+int labsat23_source::read_ls3w_registers(int n_registers, gr_vector_void_star &output_items)
+{
+    d_register_bytes.resize(static_cast<std::size_t>(n_registers) * 8);
+    binary_input_file.read(reinterpret_cast<char *>(d_register_bytes.data()), static_cast<std::streamsize>(d_register_bytes.size()));
+    const auto registers_read = static_cast<std::size_t>(binary_input_file.gcount()) / 8;
+
+    // registers are written to file as 64-bit little endian words
+    d_registers.resize(registers_read);
+    for (std::size_t r = 0; r < registers_read; r++)
+        {
+            uint64_t read_register = 0ULL;
+            for (int k = 7; k >= 0; --k)
+                {
+                    read_register <<= 8;
+                    read_register |= static_cast<uint64_t>(d_register_bytes[8 * r + k]);
                 }
-            output_chan++;
+            d_registers[r] = read_register;
         }
+
+    if (d_decoder_16sc)
+        {
+            decode_ls3w_registers(*d_decoder_16sc, registers_read, output_items);
+        }
+    else if (d_decoder_8sc)
+        {
+            decode_ls3w_registers(*d_decoder_8sc, registers_read, output_items);
+        }
+    else
+        {
+            decode_ls3w_registers(*d_decoder_32fc, registers_read, output_items);
+        }
+    return static_cast<int>(registers_read) * d_ls3w_samples_per_register;
 }
 
 
@@ -927,11 +773,6 @@ int labsat23_source::general_work(int noutput_items,
     __attribute__((unused)) gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    std::vector<gr_complex *> out;
-    for (auto &output_item : output_items)
-        {
-            out.push_back(reinterpret_cast<gr_complex *>(output_item));
-        }
     if (!d_is_ls3w)
         {
             if (d_header_parsed == false)
@@ -954,18 +795,12 @@ int labsat23_source::general_work(int noutput_items,
                             int n_int16_to_read = noutput_items / 8;
                             if (n_int16_to_read > 0)
                                 {
-                                    std::vector<int16_t> memblock(n_int16_to_read);
-                                    binary_input_file.read(reinterpret_cast<char *>(memblock.data()), n_int16_to_read * 2);
+                                    d_words.resize(n_int16_to_read);
+                                    binary_input_file.read(reinterpret_cast<char *>(d_words.data()), n_int16_to_read * 2);
                                     n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
                                     if (n_int16_to_read > 0)
                                         {
-                                            int output_pointer = 0;
-                                            for (int i = 0; i < n_int16_to_read; i++)
-                                                {
-                                                    decode_samples_one_channel(memblock[i], out[0] + output_pointer, d_bits_per_sample);
-                                                    output_pointer += 8;
-                                                }
-                                            return output_pointer;
+                                            return decode_words(n_int16_to_read, output_items[0]);
                                         }
 
                                     // trigger the read of the next file in the sequence
@@ -991,7 +826,7 @@ int labsat23_source::general_work(int noutput_items,
                                             std::cout << "End of file reached, LabSat source stop\n";
                                         }
 
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
+                                    d_queue->push(command_event_make(200, 0));
                                     return -1;
                                 }
                             else
@@ -1012,18 +847,12 @@ int labsat23_source::general_work(int noutput_items,
                             int n_int16_to_read = noutput_items / 4;
                             if (n_int16_to_read > 0)
                                 {
-                                    std::vector<int16_t> memblock(n_int16_to_read);
-                                    binary_input_file.read(reinterpret_cast<char *>(memblock.data()), n_int16_to_read * 2);
+                                    d_words.resize(n_int16_to_read);
+                                    binary_input_file.read(reinterpret_cast<char *>(d_words.data()), n_int16_to_read * 2);
                                     n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
                                     if (n_int16_to_read > 0)
                                         {
-                                            int output_pointer = 0;
-                                            for (int i = 0; i < n_int16_to_read; i++)
-                                                {
-                                                    decode_samples_one_channel(memblock[i], out[0] + output_pointer, d_bits_per_sample);
-                                                    output_pointer += 4;
-                                                }
-                                            return output_pointer;
+                                            return decode_words(n_int16_to_read, output_items[0]);
                                         }
 
                                     // trigger the read of the next file in the sequence
@@ -1048,7 +877,7 @@ int labsat23_source::general_work(int noutput_items,
                                         {
                                             std::cout << "End of file reached, LabSat source stop\n";
                                         }
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
+                                    d_queue->push(command_event_make(200, 0));
                                     return -1;
                                 }
                             else
@@ -1071,36 +900,19 @@ int labsat23_source::general_work(int noutput_items,
                         {
                             return 0;
                         }
-                    std::size_t output_pointer = 0;
-                    for (int i = 0; i < registers_to_read; i++)
+                    const int samples_read = read_ls3w_registers(registers_to_read, output_items);
+                    if (samples_read > 0)
                         {
-                            std::array<char, 8> memory_block{};
-                            binary_input_file.read(memory_block.data(), 8);
-                            uint64_t read_register = 0ULL;
-                            for (int k = 7; k >= 0; --k)
-                                {
-                                    read_register <<= 8;
-                                    read_register |= uint64_t(memory_block[k]);
-                                }
-
-                            if (binary_input_file.gcount() == 8)
-                                {
-                                    decode_ls3w_register(read_register, out, output_pointer);
-                                    output_pointer += d_ls3w_samples_per_register;
-                                }
-                            else
-                                {
-                                    std::cout << "End of file reached, LabSat source stop.\n";
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
-                                    return -1;
-                                }
+                            return samples_read;
                         }
-                    return output_pointer;
+                    std::cout << "End of file reached, LabSat source stop.\n";
+                    d_queue->push(command_event_make(200, 0));
+                    return -1;
                 }
             else
                 {
                     std::cout << "End of file reached, LabSat source stop.\n";
-                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
+                    d_queue->push(command_event_make(200, 0));
                     return -1;
                 }
         }
@@ -19,13 +19,17 @@
 #ifndef GNSS_SDR_LABSAT23_SOURCE_H
 #define GNSS_SDR_LABSAT23_SOURCE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
+#include "labsat_decoder.h"
 #include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
 #include <pmt/pmt.h>
+#include <complex>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,15 +43,20 @@ class labsat23_source;
 
 using labsat23_source_sptr = gnss_shared_ptr<labsat23_source>;
 
+/*!
+ * \brief Makes a LabSat source with gr_complex, cshort or cbyte outputs,
+ * according to item_type.
+ */
 labsat23_source_sptr labsat23_make_source_sptr(
     const char *signal_file_basename,
     const std::vector<int> &channel_selector,
-    Concurrent_Queue<pmt::pmt_t> *queue,
-    bool digital_io_enabled);
+    Control_Queue *queue,
+    bool digital_io_enabled,
+    const std::string &item_type = std::string("gr_complex"));
 
 /*!
  * \brief This class implements conversion between Labsat 2, 3 and 3 Wideband
- * formats to gr_complex
+ * formats to gr_complex, cshort or cbyte
  */
 class labsat23_source : public gr::block
 {
@@ -63,13 +72,15 @@ private:
     friend labsat23_source_sptr labsat23_make_source_sptr(
         const char *signal_file_basename,
         const std::vector<int> &channel_selector,
-        Concurrent_Queue<pmt::pmt_t> *queue,
-        bool digital_io_enabled);
+        Control_Queue *queue,
+        bool digital_io_enabled,
+        const std::string &item_type);
 
     labsat23_source(const char *signal_file_basename,
         const std::vector<int> &channel_selector,
-        Concurrent_Queue<pmt::pmt_t> *queue,
-        bool digital_io_enabled);
+        Control_Queue *queue,
+        bool digital_io_enabled,
+        const std::string &item_type);
 
     std::string generate_filename();
 
@@ -78,12 +89,23 @@ private:
     int read_ls3w_ini(const std::string &filename);
     int number_of_samples_per_ls3w_register() const;
 
-    void decode_samples_one_channel(int16_t input_short, gr_complex *out, int type);
-    void decode_ls3w_register(uint64_t input, std::vector<gr_complex *> &out, std::size_t output_pointer) const;
+    int decode_words(int n_words, void *out) const;
+    int read_ls3w_registers(int n_registers, gr_vector_void_star &output_items);
+
+    template <typename T>
+    void decode_ls3w_registers(const Labsat_Decoder<T> &decoder, std::size_t n_registers, gr_vector_void_star &output_items) const;
+
+    // only the decoder of the output item type is created
+    std::unique_ptr<Labsat_Decoder<gr_complex>> d_decoder_32fc;
+    std::unique_ptr<Labsat_Decoder<std::complex<int16_t>>> d_decoder_16sc;
+    std::unique_ptr<Labsat_Decoder<std::complex<int8_t>>> d_decoder_8sc;
+    std::vector<int16_t> d_words;
+    std::vector<uint8_t> d_register_bytes;
+    std::vector<uint64_t> d_registers;
 
     std::ifstream binary_input_file;
     std::string d_signal_file_basename;
-    Concurrent_Queue<pmt::pmt_t> *d_queue;
+    Control_Queue *d_queue;
     std::vector<int> d_channel_selector_config;
     int d_current_file_number;
     uint8_t d_labsat_version;
@@ -0,0 +1,137 @@
+/*!
+ * \file mmap_file_sink.cc
+ * \brief GNU Radio block that writes samples into a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <fcntl.h>     // for open, O_RDWR, O_CREAT, O_TRUNC
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <unistd.h>    // for close, ftruncate
+#include <algorithm>   // for std::min
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <stdexcept>   // for std::runtime_error
+
+
+mmap_file_sink_sptr make_mmap_file_sink(size_t item_size, const std::string &filename)
+{
+    return mmap_file_sink_sptr(new mmap_file_sink(item_size, filename));
+}
+
+
+mmap_file_sink::mmap_file_sink(size_t item_size,
+    const std::string &filename) : gr::sync_block("mmap_file_sink",
+                                       gr::io_signature::make(1, 1, item_size),
+                                       gr::io_signature::make(0, 0, 0)),
+                                   d_filename(filename),
+                                   d_window(nullptr),
+                                   d_window_offset(0),
+                                   d_position(0),
+                                   d_item_size(item_size),
+                                   d_fd(-1)
+{
+    d_fd = open(d_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("mmap_file_sink: cannot open " + d_filename + ": " + std::strerror(errno));
+        }
+    DLOG(INFO) << "mmap_file_sink: writing " << d_filename;
+}
+
+
+mmap_file_sink::~mmap_file_sink()
+{
+    close_file();
+}
+
+
+bool mmap_file_sink::stop()
+{
+    close_file();
+    return gr::sync_block::stop();
+}
+
+
+void mmap_file_sink::map_window(uint64_t offset)
+{
+    unmap_window();
+
+    d_window_offset = offset / WINDOW_SIZE * WINDOW_SIZE;
+    if (ftruncate(d_fd, static_cast<off_t>(d_window_offset + WINDOW_SIZE)) != 0)
+        {
+            throw std::runtime_error("mmap_file_sink: cannot extend " + d_filename + ": " + std::strerror(errno));
+        }
+    void *window = mmap(nullptr, WINDOW_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, d_fd, static_cast<off_t>(d_window_offset));
+    if (window == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap_file_sink: cannot map " + d_filename + ": " + std::strerror(errno));
+        }
+    d_window = static_cast<char *>(window);
+
+    // Only a hint: the block works the same if the kernel ignores it
+    madvise(window, WINDOW_SIZE, MADV_SEQUENTIAL);
+}
+
+
+void mmap_file_sink::unmap_window()
+{
+    if (d_window != nullptr)
+        {
+            munmap(d_window, WINDOW_SIZE);
+            d_window = nullptr;
+        }
+}
+
+
+void mmap_file_sink::close_file()
+{
+    unmap_window();
+    if (d_fd >= 0)
+        {
+            // drop the unused end of the last window
+            if (ftruncate(d_fd, static_cast<off_t>(d_position)) != 0)
+                {
+                    LOG(WARNING) << "mmap_file_sink: cannot truncate " << d_filename << ": " << std::strerror(errno);
+                }
+            close(d_fd);
+            d_fd = -1;
+        }
+}
+
+
+int mmap_file_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    if (d_fd < 0)
+        {
+            return WORK_DONE;
+        }
+    const auto *in = static_cast<const char *>(input_items[0]);
+    const uint64_t bytes_to_write = static_cast<uint64_t>(noutput_items) * d_item_size;
+    uint64_t bytes_written = 0;
+    while (bytes_written < bytes_to_write)
+        {
+            if (d_window == nullptr || d_position >= d_window_offset + WINDOW_SIZE)
+                {
+                    map_window(d_position);
+                }
+            const uint64_t bytes = std::min(bytes_to_write - bytes_written, d_window_offset + WINDOW_SIZE - d_position);
+            std::memcpy(d_window + (d_position - d_window_offset), in + bytes_written, bytes);
+            bytes_written += bytes;
+            d_position += bytes;
+        }
+    return noutput_items;
+}
@@ -0,0 +1,80 @@
+/*!
+ * \file mmap_file_sink.h
+ * \brief GNU Radio block that writes samples into a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SINK_H
+#define GNSS_SDR_MMAP_FILE_SINK_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_sink;
+
+using mmap_file_sink_sptr = gnss_shared_ptr<mmap_file_sink>;
+
+mmap_file_sink_sptr make_mmap_file_sink(size_t item_size, const std::string &filename);
+
+/*!
+ * \brief Drop-in replacement of gr::blocks::file_sink that writes through a
+ * shared memory mapping of the file instead of stdio.
+ *
+ * The file grows in windows of WINDOW_SIZE bytes, which are mapped and filled
+ * with plain copies, so writing costs no system call per buffer and the
+ * kernel writes the pages back in the background. The file is truncated to
+ * the samples actually written when the block stops. Throws
+ * std::runtime_error if the file cannot be created, extended or mapped.
+ */
+class mmap_file_sink : public gr::sync_block
+{
+public:
+    ~mmap_file_sink();
+
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend mmap_file_sink_sptr make_mmap_file_sink(size_t item_size, const std::string &filename);
+
+    mmap_file_sink(size_t item_size, const std::string &filename);
+
+    void map_window(uint64_t offset);
+    void unmap_window();
+    void close_file();
+
+    static constexpr uint64_t WINDOW_SIZE = 64 * 2 * 1024 * 1024;
+
+    std::string d_filename;
+    char *d_window;
+    uint64_t d_window_offset;
+    uint64_t d_position;  // bytes written so far
+    size_t d_item_size;
+    int d_fd;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SINK_H
@@ -0,0 +1,198 @@
+/*!
+ * \file mmap_file_source.cc
+ * \brief GNU Radio block that reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#include <algorithm>   // for std::min, std::max
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <stdexcept>   // for std::runtime_error
+
+
+mmap_file_source_sptr make_mmap_file_source(size_t item_size, const std::string &filename, uint64_t items_to_skip, bool repeat)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, items_to_skip, repeat));
+}
+
+
+mmap_file_source::mmap_file_source(size_t item_size,
+    const std::string &filename,
+    uint64_t items_to_skip,
+    bool repeat) : gr::sync_block("mmap_file_source",
+                       gr::io_signature::make(0, 0, 0),
+                       gr::io_signature::make(1, 1, item_size)),
+                   d_filename(filename),
+                   d_window(nullptr),
+                   d_window_offset(0),
+                   d_window_length(0),
+                   d_start(0),
+                   d_end(0),
+                   d_position(0),
+                   d_read_ahead(0),
+                   d_seek_request(NO_SEEK),
+                   d_item_size(item_size),
+                   d_fd(-1),
+                   d_repeat(repeat)
+{
+    d_fd = open(d_filename.c_str(), O_RDONLY);
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("mmap_file_source: cannot open " + d_filename + ": " + std::strerror(errno));
+        }
+
+    struct stat file_status
+    {
+    };
+    if (fstat(d_fd, &file_status) != 0)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: cannot stat " + d_filename + ": " + std::strerror(errno));
+        }
+    const auto file_size = static_cast<uint64_t>(file_status.st_size);
+
+    d_start = items_to_skip * d_item_size;
+    if (d_start > file_size)
+        {
+            // same behavior as a failed seek of gr::blocks::file_source
+            LOG(ERROR) << "Error skipping bytes! " << d_filename << " has only " << file_size << " bytes";
+            d_start = 0;
+        }
+    d_end = d_start + (file_size - d_start) / d_item_size * d_item_size;
+    d_position = d_start;
+    d_read_ahead = d_start;
+
+    DLOG(INFO) << "mmap_file_source: reading bytes " << d_start << " to " << d_end << " of " << d_filename;
+}
+
+
+mmap_file_source::~mmap_file_source()
+{
+    unmap_window();
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+        }
+}
+
+
+void mmap_file_source::seek(uint64_t item)
+{
+    d_seek_request = item;
+}
+
+
+void mmap_file_source::map_window(uint64_t offset)
+{
+    unmap_window();
+
+    d_window_offset = offset / WINDOW_ALIGNMENT * WINDOW_ALIGNMENT;
+    d_window_length = std::min(WINDOW_SIZE, d_end - d_window_offset);
+    void *window = mmap(nullptr, d_window_length, PROT_READ, MAP_SHARED, d_fd, static_cast<off_t>(d_window_offset));
+    if (window == MAP_FAILED)
+        {
+            d_window_length = 0;
+            throw std::runtime_error("mmap_file_source: cannot map " + d_filename + ": " + std::strerror(errno));
+        }
+    d_window = static_cast<const char *>(window);
+
+    // Only hints: the block works the same if the kernel ignores them
+    madvise(window, d_window_length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(window, d_window_length, MADV_HUGEPAGE);
+#endif
+    d_read_ahead = offset;
+    read_ahead();
+}
+
+
+void mmap_file_source::unmap_window()
+{
+    if (d_window != nullptr)
+        {
+            munmap(const_cast<char *>(d_window), d_window_length);
+            d_window = nullptr;
+            d_window_length = 0;
+        }
+}
+
+
+void mmap_file_source::read_ahead()
+{
+    // Keep about READ_AHEAD bytes requested beyond the read position, asking
+    // for them in large chunks instead of waiting for page faults
+    const uint64_t window_end = d_window_offset + d_window_length;
+    if (d_read_ahead >= window_end || d_read_ahead > d_position + READ_AHEAD / 2)
+        {
+            return;
+        }
+    const uint64_t chunk_start = std::max(d_read_ahead, d_position) / WINDOW_ALIGNMENT * WINDOW_ALIGNMENT;
+    const uint64_t chunk_end = std::min(chunk_start + READ_AHEAD, window_end);
+    madvise(const_cast<char *>(d_window) + (chunk_start - d_window_offset), chunk_end - chunk_start, MADV_WILLNEED);
+    d_read_ahead = chunk_end;
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = static_cast<char *>(output_items[0]);
+    const uint64_t bytes_requested = static_cast<uint64_t>(noutput_items) * d_item_size;
+    uint64_t bytes_copied = 0;
+
+    if (d_end == d_start)
+        {
+            return WORK_DONE;
+        }
+
+    const uint64_t seek_item = d_seek_request.exchange(NO_SEEK);
+    if (seek_item != NO_SEEK)
+        {
+            d_position = std::min(seek_item * d_item_size, d_end);
+            d_read_ahead = d_position;
+        }
+
+    while (bytes_copied < bytes_requested)
+        {
+            if (d_position >= d_end)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    d_position = d_start;
+                }
+            if (d_window == nullptr || d_position < d_window_offset || d_position >= d_window_offset + d_window_length)
+                {
+                    map_window(d_position);
+                }
+            const uint64_t bytes = std::min(bytes_requested - bytes_copied, d_window_offset + d_window_length - d_position);
+            std::memcpy(out + bytes_copied, d_window + (d_position - d_window_offset), bytes);
+            bytes_copied += bytes;
+            d_position += bytes;
+            read_ahead();
+        }
+
+    if (bytes_copied == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(bytes_copied / d_item_size);
+}
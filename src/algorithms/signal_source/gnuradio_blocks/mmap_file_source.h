@@ -0,0 +1,95 @@
+/*!
+ * \file mmap_file_source.h
+ * \brief GNU Radio block that reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H
+#define GNSS_SDR_MMAP_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_source;
+
+using mmap_file_source_sptr = gnss_shared_ptr<mmap_file_source>;
+
+mmap_file_source_sptr make_mmap_file_source(size_t item_size, const std::string &filename, uint64_t items_to_skip, bool repeat);
+
+/*!
+ * \brief Drop-in replacement of gr::blocks::file_source that maps the file
+ * into memory instead of reading it through stdio.
+ *
+ * The file is mapped in windows of WINDOW_SIZE bytes, aligned to 2 MiB so that
+ * the kernel can back them with huge pages, and the pages ahead of the read
+ * position are requested in chunks of READ_AHEAD bytes. Each window is advised
+ * as sequential, so the kernel read-ahead also works at its largest size.
+ * Throws std::runtime_error if the file cannot be opened or mapped.
+ */
+class mmap_file_source : public gr::sync_block
+{
+public:
+    ~mmap_file_source();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    /*!
+     * \brief Moves the read position to the given item of the file. It can be
+     * called while the flowgraph is running, and takes effect in the next
+     * call to work().
+     */
+    void seek(uint64_t item);
+
+private:
+    friend mmap_file_source_sptr make_mmap_file_source(size_t item_size, const std::string &filename, uint64_t items_to_skip, bool repeat);
+
+    mmap_file_source(size_t item_size, const std::string &filename, uint64_t items_to_skip, bool repeat);
+
+    void map_window(uint64_t offset);
+    void unmap_window();
+    void read_ahead();
+
+    static constexpr uint64_t WINDOW_ALIGNMENT = 2 * 1024 * 1024;
+    static constexpr uint64_t WINDOW_SIZE = 128 * WINDOW_ALIGNMENT;
+    static constexpr uint64_t READ_AHEAD = 8 * WINDOW_ALIGNMENT;
+    static constexpr uint64_t NO_SEEK = UINT64_MAX;
+
+    std::string d_filename;
+    const char *d_window;
+    uint64_t d_window_offset;
+    uint64_t d_window_length;
+    uint64_t d_start;       // first byte of the first item to read
+    uint64_t d_end;         // end of the last complete item in the file
+    uint64_t d_position;    // next byte to read
+    uint64_t d_read_ahead;  // end of the pages already requested
+    std::atomic<uint64_t> d_seek_request;
+    size_t d_item_size;
+    int d_fd;
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SOURCE_H
@@ -0,0 +1,238 @@
+/*!
+ * \file multichannel_file_reader.cc
+ * \brief GNU Radio block that reads several sample files in lockstep from a
+ * single reader thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multichannel_file_reader.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <fcntl.h>     // for open, posix_fadvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for read, lseek, close
+#include <algorithm>   // for std::min
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <stdexcept>   // for std::runtime_error
+
+
+multichannel_file_reader_sptr make_multichannel_file_reader(size_t item_size, const std::vector<std::string> &filenames, uint64_t items_to_skip, bool repeat)
+{
+    return multichannel_file_reader_sptr(new multichannel_file_reader(item_size, filenames, items_to_skip, repeat));
+}
+
+
+multichannel_file_reader::multichannel_file_reader(size_t item_size,
+    const std::vector<std::string> &filenames,
+    uint64_t items_to_skip,
+    bool repeat) : gr::sync_block("multichannel_file_reader",
+                       gr::io_signature::make(0, 0, 0),
+                       gr::io_signature::make(static_cast<int>(filenames.size()), static_cast<int>(filenames.size()), item_size)),
+                   d_filenames(filenames),
+                   d_first_byte(items_to_skip * item_size),
+                   d_block_items(std::max<uint64_t>(BLOCK_SIZE / item_size, 1)),
+                   d_item_size(item_size),
+                   d_fill_block(0),
+                   d_output_block(0),
+                   d_repeat(repeat),
+                   d_stop(false)
+{
+    for (const auto &filename : d_filenames)
+        {
+            const int fd = open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                {
+                    for (const int open_fd : d_fds)
+                        {
+                            close(open_fd);
+                        }
+                    throw std::runtime_error("multichannel_file_reader: cannot open " + filename + ": " + std::strerror(errno));
+                }
+            d_fds.push_back(fd);
+
+            struct stat file_status
+            {
+            };
+            if (fstat(fd, &file_status) == 0 && static_cast<uint64_t>(file_status.st_size) < d_first_byte)
+                {
+                    // same behavior as a failed seek of gr::blocks::file_source
+                    LOG(ERROR) << "Error skipping bytes! " << filename << " has only " << file_status.st_size << " bytes";
+                }
+#ifdef POSIX_FADV_SEQUENTIAL
+            // Only a hint: doubles the kernel read-ahead of the file
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+    rewind();
+
+    for (auto &block : d_blocks)
+        {
+            block.data.resize(d_filenames.size(), std::vector<char>(d_block_items * d_item_size));
+        }
+}
+
+
+multichannel_file_reader::~multichannel_file_reader()
+{
+    multichannel_file_reader::stop();
+    for (const int fd : d_fds)
+        {
+            close(fd);
+        }
+}
+
+
+bool multichannel_file_reader::start()
+{
+    d_stop = false;
+    d_reader = std::thread([&] { reader_thread(); });
+    return true;
+}
+
+
+bool multichannel_file_reader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_reader.joinable())
+        {
+            d_reader.join();
+        }
+    return true;
+}
+
+
+void multichannel_file_reader::rewind()
+{
+    for (size_t n = 0; n < d_fds.size(); n++)
+        {
+            if (lseek(d_fds[n], static_cast<off_t>(d_first_byte), SEEK_SET) < 0)
+                {
+                    LOG(ERROR) << "Error skipping bytes of " << d_filenames[n] << ": " << std::strerror(errno);
+                }
+        }
+}
+
+
+uint64_t multichannel_file_reader::read_file(int fd, char *buffer, uint64_t bytes) const
+{
+    uint64_t bytes_read = 0;
+    while (bytes_read < bytes)
+        {
+            const ssize_t result = read(fd, buffer + bytes_read, bytes - bytes_read);
+            if (result < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+            if (result <= 0)
+                {
+                    break;
+                }
+            bytes_read += static_cast<uint64_t>(result);
+        }
+    return bytes_read;
+}
+
+
+void multichannel_file_reader::reader_thread()
+{
+    // avoids rewinding forever if there is nothing to read after skipping
+    bool rewound = false;
+    while (true)
+        {
+            Block &block = d_blocks[d_fill_block];
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [&] { return d_stop || !block.filled; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+            }
+
+            // One large sequential read per file, the files one after the other
+            uint64_t items = d_block_items;
+            for (size_t n = 0; n < d_fds.size(); n++)
+                {
+                    const uint64_t bytes = read_file(d_fds[n], block.data[n].data(), items * d_item_size);
+                    items = std::min(items, bytes / d_item_size);
+                }
+            if (items < d_block_items && d_repeat)
+                {
+                    // The shortest file has ended. The extra items already read
+                    // from the other files are discarded, so that they stay aligned
+                    rewind();
+                    if (items == 0 && !rewound)
+                        {
+                            rewound = true;
+                            continue;
+                        }
+                }
+            rewound = false;
+
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                block.items = items;
+                block.consumed = 0;
+                block.last = items < d_block_items && (!d_repeat || items == 0);
+                block.filled = true;
+            }
+            d_cond.notify_all();
+            if (block.last)
+                {
+                    return;
+                }
+            d_fill_block = (d_fill_block + 1) % NUM_BLOCKS;
+        }
+}
+
+
+int multichannel_file_reader::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    Block &block = d_blocks[d_output_block];
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_cond.wait(lock, [&] { return d_stop || block.filled; });
+        if (!block.filled)
+            {
+                return WORK_DONE;
+            }
+    }
+
+    const uint64_t items = std::min(static_cast<uint64_t>(noutput_items), block.items - block.consumed);
+    if (items == 0 && block.last)
+        {
+            return WORK_DONE;
+        }
+    for (size_t n = 0; n < output_items.size(); n++)
+        {
+            std::memcpy(output_items[n], block.data[n].data() + block.consumed * d_item_size, items * d_item_size);
+        }
+    block.consumed += items;
+
+    if (block.consumed == block.items && !block.last)
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                block.filled = false;
+            }
+            d_cond.notify_all();
+            d_output_block = (d_output_block + 1) % NUM_BLOCKS;
+        }
+    return static_cast<int>(items);
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file multichannel_file_reader.h
+ * \brief GNU Radio block that reads several sample files in lockstep from a
+ * single reader thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTICHANNEL_FILE_READER_H
+#define GNSS_SDR_MULTICHANNEL_FILE_READER_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class multichannel_file_reader;
+
+using multichannel_file_reader_sptr = gnss_shared_ptr<multichannel_file_reader>;
+
+multichannel_file_reader_sptr make_multichannel_file_reader(size_t item_size, const std::vector<std::string> &filenames, uint64_t items_to_skip, bool repeat);
+
+/*!
+ * \brief Reads one file per output port, keeping all of them aligned.
+ *
+ * Instead of one gr::blocks::file_source per file, which issue small
+ * uncoordinated reads that make a disk shared by the files seek constantly, a
+ * single thread reads a block of BLOCK_SIZE bytes of each file in turn into
+ * one of NUM_BLOCKS buffers. work() hands out slices of the oldest filled
+ * buffer to all the output ports at the same time, so the channels stay
+ * aligned, and the reader fills the other buffers in the meantime.
+ *
+ * The output ends at the end of the shortest file. With repeat, all the files
+ * go back to their first item at the same time.
+ * Throws std::runtime_error if a file cannot be opened.
+ */
+class multichannel_file_reader : public gr::sync_block
+{
+public:
+    ~multichannel_file_reader();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend multichannel_file_reader_sptr make_multichannel_file_reader(size_t item_size, const std::vector<std::string> &filenames, uint64_t items_to_skip, bool repeat);
+
+    multichannel_file_reader(size_t item_size, const std::vector<std::string> &filenames, uint64_t items_to_skip, bool repeat);
+
+    static constexpr size_t BLOCK_SIZE = 4 * 1024 * 1024;
+    static constexpr int NUM_BLOCKS = 3;
+
+    struct Block
+    {
+        std::vector<std::vector<char>> data;  // one buffer per file
+        uint64_t items = 0;                   // items available in every buffer
+        uint64_t consumed = 0;                // items already handed out
+        bool filled = false;
+        bool last = false;  // no more data after this block
+    };
+
+    void reader_thread();
+    uint64_t read_file(int fd, char *buffer, uint64_t bytes) const;
+    void rewind();
+
+    std::array<Block, NUM_BLOCKS> d_blocks;
+    std::vector<std::string> d_filenames;
+    std::vector<int> d_fds;
+    std::thread d_reader;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    uint64_t d_first_byte;
+    uint64_t d_block_items;
+    size_t d_item_size;
+    int d_fill_block;    // next block to be filled by the reader thread
+    int d_output_block;  // next block to be handed out by work()
+    bool d_repeat;
+    bool d_stop;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MULTICHANNEL_FILE_READER_H
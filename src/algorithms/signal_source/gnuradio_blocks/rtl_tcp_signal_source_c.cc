@@ -21,52 +21,60 @@
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <utility>
 
 
 namespace ip = boost::asio::ip;
 using boost::asio::ip::tcp;
 
 // Buffer constants
-// TODO: Make these configurable
 enum
 {
-    RTL_TCP_BUFFER_SIZE = 1024 * 16,  // 16 KB
-    RTL_TCP_PAYLOAD_SIZE = 1024 * 4   //  4 KB
+    RTL_TCP_PAYLOAD_SIZE = 1024 * 16  // 16 KB
 };
 
+// Conversion of the unsigned 8-bit samples
+constexpr float RTL_TCP_OFFSET = 127.4F;
+constexpr float RTL_TCP_SCALE = 1.0F / 128.0F;
+
+// Time work() waits for samples before returning to the scheduler
+constexpr std::chrono::milliseconds RTL_TCP_READ_TIMEOUT(100);
+
 rtl_tcp_signal_source_c_sptr rtl_tcp_make_signal_source_c(
     const std::string &address,
     int16_t port,
-    bool flip_iq)
+    bool flip_iq,
+    size_t buffer_size,
+    size_t prefill)
 {
     return rtl_tcp_signal_source_c_sptr(new rtl_tcp_signal_source_c(address,
         port,
-        flip_iq));
+        flip_iq,
+        buffer_size,
+        prefill));
 }
 
 
 rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     int16_t port,
-    bool flip_iq)
+    bool flip_iq,
+    size_t buffer_size,
+    size_t prefill)
     : gr::sync_block("rtl_tcp_signal_source_c",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 1, sizeof(gr_complex))),
-      buffer_(RTL_TCP_BUFFER_SIZE),
+      buffer_(std::max(buffer_size, size_t(2 * RTL_TCP_PAYLOAD_SIZE)), prefill),
       socket_(io_context_),
       data_(RTL_TCP_PAYLOAD_SIZE),
-      unread_(0),
       flip_iq_(flip_iq)
 {
     boost::system::error_code ec;
 
-    // 1. Setup lookup table
-    for (unsigned i = 0; i < 0xff; i++)
-        {
-            lookup_[i] = (static_cast<float>(i & 0xff) - 127.4F) * (1.0F / 128.0F);
-        }
-
-    // 2. Set socket options
+    // 1. Set socket options
     ip::address addr = ip::address::from_string(address, ec);
     if (ec)
         {
@@ -95,7 +103,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set linger option";
         }
 
-    // 3. Connect socket
+    // 2. Connect socket
 
     socket_.connect(ep, ec);
     if (ec)
@@ -109,7 +117,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     std::cout << "Connected to " << addr << ":" << port << '\n';
     LOG(INFO) << "Connected to " << addr << ":" << port;
 
-    // 4. Set nodelay
+    // 3. Set nodelay
     socket_.set_option(tcp::no_delay(true), ec);
     if (ec)
         {
@@ -117,7 +125,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set no delay option";
         }
 
-    // 5. Receive dongle info
+    // 4. Receive dongle info
     ec = info_.read(socket_);
     if (ec)
         {
@@ -130,7 +138,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(INFO) << "Found " << info_.get_type_name() << " tuner.";
         }
 
-// 6. Start reading
+// 5. Start reading
 #if USE_BOOST_BIND_PLACEHOLDERS
     boost::asio::async_read(socket_, boost::asio::buffer(data_),
         boost::bind(&rtl_tcp_signal_source_c::handle_read, this, boost::placeholders::_1, boost::placeholders::_2));  // NOLINT(modernize-avoid-bind)
@@ -139,7 +147,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
         boost::bind(&rtl_tcp_signal_source_c::handle_read, this, _1, _2));  // NOLINT(modernize-avoid-bind)
 #endif
 
-    boost::thread(
+    thread_ = boost::thread(
 #if HAS_GENERIC_LAMBDA
         [ObjectPtr = &io_context_] { ObjectPtr->run(); });
 #else
@@ -148,12 +156,15 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
 }
 
 
-rtl_tcp_signal_source_c::~rtl_tcp_signal_source_c()  // NOLINT(modernize-use-equals-default)
+rtl_tcp_signal_source_c::~rtl_tcp_signal_source_c()
 {
-    mutex_.unlock();
+    // release the receive thread if it is waiting for room in the buffer
+    buffer_.close();
     io_context_.stop();
-    not_empty_.notify_one();
-    not_full_.notify_one();
+    if (thread_.joinable())
+        {
+            thread_.join();
+        }
 }
 
 
@@ -286,35 +297,18 @@ void rtl_tcp_signal_source_c::handle_read(const boost::system::error_code &ec,
         {
             std::cout << "Error during read: " << ec << '\n';
             LOG(WARNING) << "Error during read: " << ec;
-            boost::mutex::scoped_lock lock(mutex_);
+            // work() delivers the samples left in the buffer and then stops
+            buffer_.close();
             io_context_.stop();
-            not_empty_.notify_one();
         }
     else
         {
-            {
-                // Unpack read data
-                boost::mutex::scoped_lock lock(mutex_);
-                not_full_.wait(lock,
-                    boost::bind(&rtl_tcp_signal_source_c::not_full, this));  // NOLINT(modernize-avoid-bind)
-
-                for (size_t i = 0; i < bytes_transferred; i++)
-                    {
-                        while (!not_full())
-                            {
-                                // uh-oh, buffer overflow
-                                // wait until there's space for more
-                                not_empty_.notify_one();  // needed?
-                                not_full_.wait(lock,
-                                    boost::bind(&rtl_tcp_signal_source_c::not_full, this));  // NOLINT(modernize-avoid-bind)
-                            }
-
-                        buffer_.push_front(lookup_[data_[i]]);
-                        unread_++;
-                    }
-            }
-            // let woker know that more data is available
-            not_empty_.notify_one();
+            // wait for room in the buffer, if needed, which holds back the
+            // reads and lets TCP flow control slow down the server
+            if (!buffer_.write(data_.data(), bytes_transferred, true))
+                {
+                    return;
+                }
 // Read some more
 #if USE_BOOST_BIND_PLACEHOLDERS
             boost::asio::async_read(socket_,
@@ -334,31 +328,29 @@ int rtl_tcp_signal_source_c::work(int noutput_items,
     gr_vector_void_star &output_items)
 {
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    int i = 0;
-    if (io_context_.stopped())
+    if (buffer_.drained())
         {
             return -1;
         }
 
-    {
-        boost::mutex::scoped_lock lock(mutex_);
-        not_empty_.wait(lock,
-            boost::bind(&rtl_tcp_signal_source_c::not_empty, this));  // NOLINT(modernize-avoid-bind)
-
-        for (; i < noutput_items && unread_ > 1; i++)
-            {
-                float re = buffer_[--unread_];
-                float im = buffer_[--unread_];
-                if (flip_iq_)
-                    {
-                        out[i] = gr_complex(im, re);
-                    }
-                else
-                    {
-                        out[i] = gr_complex(re, im);
-                    }
-            }
-    }
-    not_full_.notify_one();
-    return i == 0 ? -1 : i;
+    const size_t max_bytes = 2 * static_cast<size_t>(noutput_items);
+    if (samples_.size() < max_bytes)
+        {
+            samples_.resize(max_bytes);
+        }
+    const size_t bytes = buffer_.read(samples_.data(), max_bytes, 2, RTL_TCP_READ_TIMEOUT);
+    if (bytes == 0)
+        {
+            return buffer_.drained() ? -1 : 0;
+        }
+
+    if (flip_iq_)
+        {
+            for (size_t i = 0; i < bytes; i += 2)
+                {
+                    std::swap(samples_[i], samples_[i + 1]);
+                }
+        }
+    volk_gnsssdr_8u_convert_32f(reinterpret_cast<float *>(out), samples_.data(), RTL_TCP_OFFSET, RTL_TCP_SCALE, static_cast<unsigned int>(bytes));
+    return static_cast<int>(bytes / 2);
 }
@@ -7,8 +7,7 @@
  * sources. The data format and command structure is taken from the
  * original Osmocom rtl_tcp_source_f (https://git.osmocom.org/gr-osmosdr).
  * The aynchronous reading code comes from the examples provides
- * by Boost.Asio and the bounded buffer producer-consumer solution is
- * taken from the Boost.CircularBuffer examples (https://www.boost.org/).
+ * by Boost.Asio (https://www.boost.org/).
  *
  * -----------------------------------------------------------------------------
  *
@@ -25,13 +24,12 @@
 #define GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_C_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_ingest_buffer.h"
 #include "rtl_tcp_dongle_info.h"
-#include <boost/array.hpp>
 #include <boost/asio.hpp>
-#include <boost/circular_buffer.hpp>
-#include <boost/thread/condition.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <gnuradio/sync_block.h>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -53,14 +51,26 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+/*
+ * buffer_size is the capacity in bytes (two per sample) of the buffer that
+ * holds the samples received and not yet processed, and prefill the bytes the
+ * buffer waits for before delivering samples, when it starts and whenever it
+ * runs dry (jitter buffer).
+ */
 rtl_tcp_signal_source_c_sptr
 rtl_tcp_make_signal_source_c(const std::string &address,
     int16_t port,
-    bool flip_iq = false);
+    bool flip_iq = false,
+    size_t buffer_size = 1024 * 1024,
+    size_t prefill = 0);
 
 /*!
  * \brief This class reads interleaved I/Q samples
  * from an rtl_tcp server and outputs complex types.
+ *
+ * The socket is read by its own thread, which only copies the received bytes
+ * into a Gnss_Sdr_Ingest_Buffer, so network jitter does not stall the
+ * flowgraph. The conversion to complex samples is done in work().
  */
 class rtl_tcp_signal_source_c : public gr::sync_block
 {
@@ -81,42 +91,31 @@ private:
     friend rtl_tcp_signal_source_c_sptr
     rtl_tcp_make_signal_source_c(const std::string &address,
         int16_t port,
-        bool flip_iq);
+        bool flip_iq,
+        size_t buffer_size,
+        size_t prefill);
 
     rtl_tcp_signal_source_c(const std::string &address,
         int16_t port,
-        bool flip_iq);
+        bool flip_iq,
+        size_t buffer_size,
+        size_t prefill);
 
     // async read callback
     void handle_read(const boost::system::error_code &ec,
         size_t bytes_transferred);
 
-    inline bool not_full() const
-    {
-        return unread_ < buffer_.capacity();
-    }
-
-    inline bool not_empty() const
-    {
-        return unread_ > 0 || io_context_.stopped();
-    }
-
-    boost::circular_buffer_space_optimized<float> buffer_;
-    // producer-consumer helpers
-    boost::mutex mutex_;
-    boost::condition not_full_;
-    boost::condition not_empty_;
-
-    // lookup for scaling data
-    boost::array<float, 0xff> lookup_{};
+    // bytes received and not yet converted
+    Gnss_Sdr_Ingest_Buffer buffer_;
+    std::vector<uint8_t> samples_;
 
     // IO members
     b_io_context io_context_;
     boost::asio::ip::tcp::socket socket_;
     std::vector<unsigned char> data_;
+    boost::thread thread_;
 
     Rtl_Tcp_Dongle_Info info_;
-    size_t unread_;
     bool flip_iq_;
 };
 
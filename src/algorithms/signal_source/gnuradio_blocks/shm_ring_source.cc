@@ -0,0 +1,87 @@
+/*!
+ * \file shm_ring_source.cc
+ * \brief GNU Radio block that reads samples written by an external process
+ * into a shared memory ring buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "shm_ring_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::min
+#include <cerrno>     // for errno
+#include <cstring>    // for memcpy, strerror
+#include <stdexcept>  // for std::runtime_error
+
+
+shm_ring_source_sptr make_shm_ring_source(size_t item_size, const std::string &shm_name, uint64_t buffer_size)
+{
+    return shm_ring_source_sptr(new shm_ring_source(item_size, shm_name, buffer_size));
+}
+
+
+shm_ring_source::shm_ring_source(size_t item_size,
+    const std::string &shm_name,
+    uint64_t buffer_size) : gr::sync_block("shm_ring_source",
+                                gr::io_signature::make(0, 0, 0),
+                                gr::io_signature::make(1, 1, static_cast<int>(item_size))),
+                            d_ring{},
+                            d_shm_name(shm_name),
+                            d_reported_overruns(0),
+                            d_item_size(item_size)
+{
+    if (gnss_sdr_shm_ring_create(&d_ring, shm_name.c_str(), buffer_size, static_cast<uint32_t>(item_size)) != 0)
+        {
+            throw std::runtime_error("shm_ring_source: cannot create the shared memory " + shm_name + ": " + std::strerror(errno));
+        }
+    LOG(INFO) << "Waiting for samples in the shared memory " << shm_name << " (" << d_ring.header->capacity << " bytes)";
+}
+
+
+shm_ring_source::~shm_ring_source()
+{
+    gnss_sdr_shm_ring_close(&d_ring);
+    shm_unlink(d_shm_name.c_str());
+}
+
+
+uint64_t shm_ring_source::overruns() const
+{
+    return __atomic_load_n(&d_ring.header->overruns, __ATOMIC_RELAXED);
+}
+
+
+int shm_ring_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    uint64_t items = gnss_sdr_shm_ring_readable(&d_ring) / d_item_size;
+    if (items == 0)
+        {
+            gnss_sdr_shm_ring_wait(&d_ring, WAIT_TIMEOUT_MS);
+            items = gnss_sdr_shm_ring_readable(&d_ring) / d_item_size;
+        }
+    items = std::min(items, static_cast<uint64_t>(noutput_items));
+
+    // the data area is mapped twice, so the items are contiguous even if they wrap around
+    std::memcpy(output_items[0], gnss_sdr_shm_ring_read_ptr(&d_ring), items * d_item_size);
+    gnss_sdr_shm_ring_release(&d_ring, items * d_item_size);
+
+    const uint64_t overruns = shm_ring_source::overruns();
+    if (overruns != d_reported_overruns)
+        {
+            LOG(WARNING) << "The producer of " << d_shm_name << " dropped " << overruns - d_reported_overruns
+                         << " writes (" << __atomic_load_n(&d_ring.header->dropped_bytes, __ATOMIC_RELAXED) << " bytes in total)";
+            d_reported_overruns = overruns;
+        }
+    return static_cast<int>(items);
+}
@@ -0,0 +1,78 @@
+/*!
+ * \file shm_ring_source.h
+ * \brief GNU Radio block that reads samples written by an external process
+ * into a shared memory ring buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SHM_RING_SOURCE_H
+#define GNSS_SDR_SHM_RING_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_shm_ring.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class shm_ring_source;
+
+using shm_ring_source_sptr = gnss_shared_ptr<shm_ring_source>;
+
+shm_ring_source_sptr make_shm_ring_source(size_t item_size, const std::string &shm_name, uint64_t buffer_size);
+
+/*!
+ * \brief Outputs the items that a producer process writes into a shared
+ * memory ring buffer (see gnss_sdr_shm_ring.h).
+ *
+ * The buffer is created by the block, so producers can attach to it as soon
+ * as the receiver is constructed, and removed when the block is destroyed.
+ * work() copies the items straight from the shared memory into the output
+ * buffer, and sleeps until the producer commits more data if there is none.
+ * Overruns of the producer are logged as they happen.
+ * Throws std::runtime_error if the shared memory cannot be created.
+ */
+class shm_ring_source : public gr::sync_block
+{
+public:
+    ~shm_ring_source();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    //! Writes dropped by the producer so far
+    uint64_t overruns() const;
+
+private:
+    friend shm_ring_source_sptr make_shm_ring_source(size_t item_size, const std::string &shm_name, uint64_t buffer_size);
+
+    shm_ring_source(size_t item_size, const std::string &shm_name, uint64_t buffer_size);
+
+    static constexpr int WAIT_TIMEOUT_MS = 100;  // so that the scheduler can stop the block
+
+    gnss_sdr_shm_ring d_ring;
+    std::string d_shm_name;
+    uint64_t d_reported_overruns;
+    size_t d_item_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SHM_RING_SOURCE_H
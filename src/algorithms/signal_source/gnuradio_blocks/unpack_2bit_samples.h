@@ -57,6 +57,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -103,6 +104,7 @@ private:
         bool reverse_interleaving);
 
     std::vector<int8_t> work_buffer_;
+    std::array<uint8_t, 4> order_{};
     size_t item_size_;
     bool big_endian_bytes_;
     bool big_endian_items_;
@@ -17,11 +17,16 @@
 
 #include "unpack_byte_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
 
-struct byte_2bit_struct
+
+namespace
 {
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
+// value of each 2-bit code, two's complement
+const std::array<int8_t, 4> TWO_BIT_VALUES = {0, 1, -2, -1};
+const std::array<uint8_t, 4> TWO_BIT_ORDER = {0, 1, 2, 3};
+}  // namespace
 
 
 unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
@@ -45,23 +50,7 @@ int unpack_byte_2bit_samples::work(int noutput_items,
     const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
-        {
-            // Read packed input sample (1 byte = 4 samples)
-            signed char c = in[i];
-            sample.two_bit_sample = c & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-        }
+    // Read packed input samples (1 byte = 4 samples), least significant bits first
+    volk_gnsssdr_8u_unpack2bit_32f(out, reinterpret_cast<const uint8_t *>(in), TWO_BIT_VALUES.data(), TWO_BIT_ORDER.data(), noutput_items);
     return noutput_items;
 }
@@ -18,6 +18,16 @@
 
 #include "unpack_byte_4bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
+
+
+namespace
+{
+// value of each 4-bit code, two's complement with an offset of half a step
+const std::array<int8_t, 16> FOUR_BIT_VALUES = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+}  // namespace
+
 
 unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples()
 {
@@ -39,29 +49,8 @@ int unpack_byte_4bit_samples::work(int noutput_items,
 {
     const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
     auto *out = reinterpret_cast<signed char *>(output_items[0]);
-    int n = 0;
-    unsigned char tmp_char2;
-    for (int i = 0; i < noutput_items / 2; i++)
-        {
-            tmp_char2 = in[i] & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-            tmp_char2 = in[i] >> 4;
-            tmp_char2 = tmp_char2 & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-        }
+
+    // Read packed input samples (1 byte = 2 samples), least significant nibble first
+    volk_gnsssdr_8u_unpack4bit_8i(out, reinterpret_cast<const uint8_t *>(in), FOUR_BIT_VALUES.data(), noutput_items);
     return noutput_items;
 }
@@ -17,6 +17,14 @@
 
 #include "unpack_intspir_1bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <array>
+
+
+namespace
+{
+// For historical reasons, values are float versions of short int limits (32767)
+const std::array<float, 2> ONE_BIT_VALUES = {-32767.0, 32767.0};
+}  // namespace
 
 
 unpack_intspir_1bit_samples_sptr make_unpack_intspir_1bit_samples()
@@ -41,28 +49,13 @@ int unpack_intspir_1bit_samples::work(int noutput_items,
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
     int n = 0;
-    int channel = 1;
+    const int channel = 1;
     for (int i = 0; i < noutput_items / 2; i++)
         {
             // Read packed input sample (1 byte = 1 complex sample)
-            // For historical reasons, values are float versions of short int limits (32767)
             signed int val = in[i];
-            if (((val >> ((channel - 1) * 2)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
-            if (((val >> (2 * channel - 1)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
+            out[n++] = ONE_BIT_VALUES[(val >> ((channel - 1) * 2)) & 1];
+            out[n++] = ONE_BIT_VALUES[(val >> (2 * channel - 1)) & 1];
         }
     return noutput_items;
 }
@@ -0,0 +1,102 @@
+/*!
+ * \file capture_index.cc
+ * \brief Sidecar index that maps GNSS time to positions in a recorded file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capture_index.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::upper_bound, std::sort
+
+
+namespace
+{
+constexpr double SECONDS_PER_WEEK = 604800.0;
+}
+
+
+double CaptureIndex::record_time_s(const CaptureIndexRecord& record)
+{
+    return static_cast<double>(record.week) * SECONDS_PER_WEEK + static_cast<double>(record.tow_ms) / 1000.0;
+}
+
+
+bool CaptureIndex::load(const std::string& filename)
+{
+    records_.clear();
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        {
+            return false;
+        }
+
+    CaptureIndexRecord record{};
+    while (file.read(reinterpret_cast<char*>(&record.item), sizeof(uint64_t)) &&
+           file.read(reinterpret_cast<char*>(&record.byte_offset), sizeof(uint64_t)) &&
+           file.read(reinterpret_cast<char*>(&record.week), sizeof(int32_t)) &&
+           file.read(reinterpret_cast<char*>(&record.tow_ms), sizeof(int32_t)))
+        {
+            records_.push_back(record);
+        }
+
+    // the records are written in stream order, but a capture may cross a week rollover
+    std::sort(records_.begin(), records_.end(), [](const CaptureIndexRecord& a, const CaptureIndexRecord& b) {
+        return record_time_s(a) < record_time_s(b);
+    });
+    DLOG(INFO) << "Read " << records_.size() << " records from the capture index " << filename;
+    return !records_.empty();
+}
+
+
+bool CaptureIndex::find(int32_t week, double tow_s, CaptureIndexRecord& record) const
+{
+    const double time_s = static_cast<double>(week) * SECONDS_PER_WEEK + tow_s;
+    const auto next = std::upper_bound(records_.cbegin(), records_.cend(), time_s, [](double t, const CaptureIndexRecord& r) {
+        return t < record_time_s(r);
+    });
+    if (next == records_.cbegin())
+        {
+            return false;
+        }
+    record = *(next - 1);
+    return true;
+}
+
+
+bool CaptureIndexWriter::open(const std::string& filename, uint64_t first_item, size_t item_size)
+{
+    file_.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    first_item_ = first_item;
+    item_size_ = item_size;
+    if (!file_.is_open())
+        {
+            LOG(WARNING) << "Unable to open the capture index file " << filename;
+            return false;
+        }
+    return true;
+}
+
+
+void CaptureIndexWriter::write(uint64_t stream_item, int32_t week, int32_t tow_ms)
+{
+    if (!file_.is_open())
+        {
+            return;
+        }
+    const uint64_t item = first_item_ + stream_item;
+    const uint64_t byte_offset = item * item_size_;
+    file_.write(reinterpret_cast<const char*>(&item), sizeof(uint64_t));
+    file_.write(reinterpret_cast<const char*>(&byte_offset), sizeof(uint64_t));
+    file_.write(reinterpret_cast<const char*>(&week), sizeof(int32_t));
+    file_.write(reinterpret_cast<const char*>(&tow_ms), sizeof(int32_t));
+    file_.flush();
+}
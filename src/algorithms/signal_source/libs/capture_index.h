@@ -0,0 +1,105 @@
+/*!
+ * \file capture_index.h
+ * \brief Sidecar index that maps GNSS time to positions in a recorded file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_CAPTURE_INDEX_H
+#define GNSS_SDR_CAPTURE_INDEX_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief One entry of a capture index: the item of the file, and its byte
+ * offset, at which a known GNSS time was recorded.
+ *
+ * On disk, each record is stored as uint64 item, uint64 byte offset, int32
+ * week and int32 TOW [ms], in host byte order, like the timestamp files read
+ * by Gnss_Sdr_Timestamp.
+ */
+struct CaptureIndexRecord
+{
+    uint64_t item;
+    uint64_t byte_offset;
+    int32_t week;
+    int32_t tow_ms;
+};
+
+
+/*!
+ * \brief Reads a capture index, and finds the record to start replaying from
+ * a given GNSS time.
+ */
+class CaptureIndex
+{
+public:
+    CaptureIndex() = default;
+
+    /*!
+     * \brief Reads all the records of the file. Returns false if it cannot be
+     * read or it has no records.
+     */
+    bool load(const std::string& filename);
+
+    /*!
+     * \brief Finds the last record at or before the given GNSS time. Returns
+     * false if the time is before the first record.
+     */
+    bool find(int32_t week, double tow_s, CaptureIndexRecord& record) const;
+
+    inline bool empty() const
+    {
+        return records_.empty();
+    }
+
+    //! Seconds since the GPS epoch of a record
+    static double record_time_s(const CaptureIndexRecord& record);
+
+private:
+    std::vector<CaptureIndexRecord> records_;
+};
+
+
+/*!
+ * \brief Appends records to a capture index.
+ */
+class CaptureIndexWriter
+{
+public:
+    CaptureIndexWriter() = default;
+
+    //! Opens (and truncates) the index file. Returns false on error
+    bool open(const std::string& filename, uint64_t first_item, size_t item_size);
+
+    //! Writes a record for the item counted from the beginning of the stream
+    void write(uint64_t stream_item, int32_t week, int32_t tow_ms);
+
+private:
+    std::ofstream file_;
+    uint64_t first_item_{0};  // item of the file at which the stream starts
+    size_t item_size_{1};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPTURE_INDEX_H
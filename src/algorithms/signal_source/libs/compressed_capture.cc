@@ -0,0 +1,219 @@
+/*!
+ * \file compressed_capture.cc
+ * \brief Chunked container for compressed sample captures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_capture.h"
+#include <boost/crc.hpp>
+#include <glog/logging.h>
+#include <zstd.h>
+#include <array>
+#include <cstring>  // for memcpy, strncpy
+
+
+namespace
+{
+constexpr std::array<char, 8> FILE_MAGIC{'G', 'N', 'S', 'S', 'Z', 'C', 'A', 'P'};
+constexpr uint32_t CHUNK_MAGIC = 0x4B435A47;  // "GZCK" in little-endian
+constexpr size_t ITEM_TYPE_SIZE = 16;
+
+
+void put_u32(char* buffer, uint32_t value)
+{
+    for (int k = 0; k < 4; k++)
+        {
+            buffer[k] = static_cast<char>((value >> (8 * k)) & 0xFF);
+        }
+}
+
+
+void put_u64(char* buffer, uint64_t value)
+{
+    for (int k = 0; k < 8; k++)
+        {
+            buffer[k] = static_cast<char>((value >> (8 * k)) & 0xFF);
+        }
+}
+
+
+uint32_t get_u32(const char* buffer)
+{
+    uint32_t value = 0;
+    for (int k = 0; k < 4; k++)
+        {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(buffer[k])) << (8 * k);
+        }
+    return value;
+}
+
+
+uint64_t get_u64(const char* buffer)
+{
+    uint64_t value = 0;
+    for (int k = 0; k < 8; k++)
+        {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(buffer[k])) << (8 * k);
+        }
+    return value;
+}
+
+
+uint32_t checksum(const std::vector<char>& data)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data.data(), data.size());
+    return crc.checksum();
+}
+}  // namespace
+
+
+bool CompressedCaptureHeader::write(std::ostream& out) const
+{
+    std::array<char, SIZE> buffer{};
+    std::memcpy(buffer.data(), FILE_MAGIC.data(), FILE_MAGIC.size());
+    put_u32(&buffer[8], version);
+    put_u32(&buffer[12], codec);
+    put_u32(&buffer[16], item_size);
+    put_u32(&buffer[20], chunk_items);
+    put_u64(&buffer[24], static_cast<uint64_t>(sampling_frequency));
+    put_u64(&buffer[TOTAL_ITEMS_OFFSET], total_items);
+    std::strncpy(&buffer[40], item_type.c_str(), ITEM_TYPE_SIZE - 1);
+    put_u32(&buffer[56], static_cast<uint32_t>(metadata.size()));
+    out.write(buffer.data(), buffer.size());
+    out.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+    return static_cast<bool>(out);
+}
+
+
+bool CompressedCaptureHeader::read(std::istream& in)
+{
+    std::array<char, SIZE> buffer{};
+    if (!in.read(buffer.data(), buffer.size()) || std::memcmp(buffer.data(), FILE_MAGIC.data(), FILE_MAGIC.size()) != 0)
+        {
+            LOG(ERROR) << "The file is not a compressed capture";
+            return false;
+        }
+    version = get_u32(&buffer[8]);
+    codec = get_u32(&buffer[12]);
+    item_size = get_u32(&buffer[16]);
+    chunk_items = get_u32(&buffer[20]);
+    sampling_frequency = static_cast<int64_t>(get_u64(&buffer[24]));
+    total_items = get_u64(&buffer[TOTAL_ITEMS_OFFSET]);
+    item_type = std::string(&buffer[40], strnlen(&buffer[40], ITEM_TYPE_SIZE));
+    metadata.resize(get_u32(&buffer[56]));
+    if (version > VERSION || item_size == 0 || chunk_items == 0)
+        {
+            LOG(ERROR) << "Unsupported compressed capture (version " << version << ")";
+            return false;
+        }
+    return static_cast<bool>(in.read(&metadata[0], static_cast<std::streamsize>(metadata.size())));
+}
+
+
+bool CompressedCaptureChunk::compress(int level)
+{
+    d_raw_bytes = static_cast<uint32_t>(raw.size());
+    d_crc = checksum(raw);
+    stored.resize(ZSTD_compressBound(raw.size()));
+    const size_t result = ZSTD_compress(stored.data(), stored.size(), raw.data(), raw.size(), level);
+    if (ZSTD_isError(result) || result >= raw.size())
+        {
+            // not worth it (or failed): keep the raw data
+            stored = raw;
+            return !ZSTD_isError(result);
+        }
+    stored.resize(result);
+    return true;
+}
+
+
+bool CompressedCaptureChunk::decompress()
+{
+    if (stored.size() == d_raw_bytes)
+        {
+            raw = stored;
+        }
+    else
+        {
+            raw.resize(d_raw_bytes);
+            const size_t result = ZSTD_decompress(raw.data(), raw.size(), stored.data(), stored.size());
+            if (ZSTD_isError(result) || result != d_raw_bytes)
+                {
+                    LOG(ERROR) << "Corrupted chunk at item " << first_item << " of the compressed capture";
+                    return false;
+                }
+        }
+    if (checksum(raw) != d_crc)
+        {
+            LOG(ERROR) << "Checksum error in the chunk at item " << first_item << " of the compressed capture";
+            return false;
+        }
+    return true;
+}
+
+
+bool CompressedCaptureChunk::write(std::ostream& out) const
+{
+    std::array<char, HEADER_SIZE> header{};
+    put_u32(&header[0], CHUNK_MAGIC);
+    put_u32(&header[4], d_raw_bytes);
+    put_u32(&header[8], static_cast<uint32_t>(stored.size()));
+    put_u32(&header[12], d_crc);
+    put_u64(&header[16], first_item);
+    out.write(header.data(), header.size());
+    out.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+    return static_cast<bool>(out);
+}
+
+
+bool CompressedCaptureChunk::read_header(std::istream& in, uint32_t& stored_bytes)
+{
+    std::array<char, HEADER_SIZE> header{};
+    if (!in.read(header.data(), header.size()))
+        {
+            return false;
+        }
+    if (get_u32(&header[0]) != CHUNK_MAGIC)
+        {
+            LOG(ERROR) << "Lost the chunk framing of the compressed capture after item " << first_item;
+            return false;
+        }
+    d_raw_bytes = get_u32(&header[4]);
+    stored_bytes = get_u32(&header[8]);
+    d_crc = get_u32(&header[12]);
+    first_item = get_u64(&header[16]);
+    return true;
+}
+
+
+bool CompressedCaptureChunk::read(std::istream& in)
+{
+    uint32_t stored_bytes = 0;
+    if (!read_header(in, stored_bytes))
+        {
+            return false;
+        }
+    stored.resize(stored_bytes);
+    return static_cast<bool>(in.read(stored.data(), stored_bytes));
+}
+
+
+bool CompressedCaptureChunk::skip(std::istream& in)
+{
+    uint32_t stored_bytes = 0;
+    if (!read_header(in, stored_bytes))
+        {
+            return false;
+        }
+    return static_cast<bool>(in.seekg(stored_bytes, std::ios::cur));
+}
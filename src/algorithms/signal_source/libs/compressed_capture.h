@@ -0,0 +1,129 @@
+/*!
+ * \file compressed_capture.h
+ * \brief Chunked container for compressed sample captures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_COMPRESSED_CAPTURE_H
+#define GNSS_SDR_COMPRESSED_CAPTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief File header of a compressed capture.
+ *
+ * A compressed capture is this header followed by a sequence of chunks
+ * (see CompressedCaptureChunk), each one holding chunk_items items of the
+ * sample stream (the last one may be shorter). On disk, the header is:
+ *
+ *   char[8]  magic "GNSSZCAP"
+ *   uint32   format version
+ *   uint32   codec (0: stored, 1: Zstandard)
+ *   uint32   item size [bytes]
+ *   uint32   items per chunk
+ *   int64    sampling frequency [Hz]
+ *   uint64   total number of items (0 if unknown, e.g. interrupted recording)
+ *   char[16] item type (e.g. "ishort"), zero padded
+ *   uint32   metadata length [bytes]
+ *   uint32   reserved
+ *   char[]   free-form metadata text, usually "key=value" lines
+ *
+ * All the numbers are little-endian.
+ */
+class CompressedCaptureHeader
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t CODEC_STORED = 0;
+    static constexpr uint32_t CODEC_ZSTD = 1;
+    static constexpr size_t SIZE = 64;                // without the metadata
+    static constexpr size_t TOTAL_ITEMS_OFFSET = 32;  // to update it when the recording ends
+    static constexpr uint32_t DEFAULT_CHUNK_ITEMS = 262144;
+
+    bool write(std::ostream& out) const;
+    bool read(std::istream& in);
+
+    std::string item_type;
+    std::string metadata;
+    int64_t sampling_frequency{0};
+    uint64_t total_items{0};
+    uint32_t version{VERSION};
+    uint32_t codec{CODEC_ZSTD};
+    uint32_t item_size{1};
+    uint32_t chunk_items{0};
+};
+
+
+/*!
+ * \brief One chunk of a compressed capture. On disk, it is:
+ *
+ *   uint32 magic "GZCK"
+ *   uint32 raw size [bytes]
+ *   uint32 stored size [bytes], equal to the raw size if stored uncompressed
+ *   uint32 CRC-32 of the raw data
+ *   uint64 first item of the chunk in the stream
+ *   char[] stored data
+ *
+ * Chunks that do not compress are stored as they are, so that random or
+ * already packed data never grows.
+ */
+class CompressedCaptureChunk
+{
+public:
+    static constexpr size_t HEADER_SIZE = 24;
+
+    //! Compresses raw into stored and computes the checksum
+    bool compress(int level);
+
+    //! Decompresses stored into raw. Returns false if the checksum fails
+    bool decompress();
+
+    bool write(std::ostream& out) const;
+
+    //! Reads the next chunk. Returns false at the end of the file or if it is not a chunk
+    bool read(std::istream& in);
+
+    //! Reads only the header of the next chunk and skips its data
+    bool skip(std::istream& in);
+
+    inline uint32_t raw_bytes() const
+    {
+        return d_raw_bytes;
+    }
+
+    std::vector<char> raw;
+    std::vector<char> stored;
+    uint64_t first_item{0};
+
+private:
+    bool read_header(std::istream& in, uint32_t& stored_bytes);
+
+    uint32_t d_raw_bytes{0};
+    uint32_t d_crc{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_CAPTURE_H
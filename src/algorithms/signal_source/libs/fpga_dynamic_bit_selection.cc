@@ -21,9 +21,12 @@
 
 #include "fpga_dynamic_bit_selection.h"
 #include <glog/logging.h>
+#include <array>       // for std::array
 #include <fcntl.h>     // for open, O_RDWR, O_SYNC
 #include <iostream>    // for cout
+#include <poll.h>      // for poll
 #include <sys/mman.h>  // for mmap
+#include <unistd.h>    // for read, write, close
 
 Fpga_dynamic_bit_selection::Fpga_dynamic_bit_selection(const std::string &device_name1, const std::string &device_name2)
 {
@@ -65,6 +68,8 @@ Fpga_dynamic_bit_selection::Fpga_dynamic_bit_selection(const std::string &device
     // init bit selection corresponding to frequency band 2
     d_map_base2[0] = shift_out_bits_band2;
 
+    d_stats.shift_out_bits = {shift_out_bits_band1, shift_out_bits_band2};
+
     DLOG(INFO) << "Dynamic bit selection FPGA class created";
 }
 
@@ -75,12 +80,15 @@ Fpga_dynamic_bit_selection::~Fpga_dynamic_bit_selection()
 }
 
 
-void Fpga_dynamic_bit_selection::bit_selection()
+bool Fpga_dynamic_bit_selection::bit_selection()
 {
     // estimated signal power corresponding to frequency band 1
-    uint32_t rx_signal_power1 = d_map_base1[1];
+    uint32_t rx_signal_power1 = d_map_base1[rx_signal_power_reg_addr];
     // estimated signal power corresponding to frequency band 2
-    uint32_t rx_signal_power2 = d_map_base2[1];
+    uint32_t rx_signal_power2 = d_map_base2[rx_signal_power_reg_addr];
+
+    const uint32_t previous_shift_out_bits_band1 = shift_out_bits_band1;
+    const uint32_t previous_shift_out_bits_band2 = shift_out_bits_band2;
 
     // dynamic bit selection corresponding to frequency band 1
     if (rx_signal_power1 > Power_Threshold_High)
@@ -115,10 +123,75 @@ void Fpga_dynamic_bit_selection::bit_selection()
         }
 
     // update bit selection corresopnding to frequency band 1
-    d_map_base1[0] = shift_out_bits_band1;
+    d_map_base1[shift_out_bits_reg_addr] = shift_out_bits_band1;
 
     // udpate bit selection corresponding to frequency band 2
-    d_map_base2[0] = shift_out_bits_band2;
+    d_map_base2[shift_out_bits_reg_addr] = shift_out_bits_band2;
+
+    const bool changed = shift_out_bits_band1 != previous_shift_out_bits_band1 or shift_out_bits_band2 != previous_shift_out_bits_band2;
+    const std::lock_guard<std::mutex> lock(d_stats_mutex);
+    d_stats.rx_signal_power = {rx_signal_power1, rx_signal_power2};
+    d_stats.shift_out_bits = {shift_out_bits_band1, shift_out_bits_band2};
+    d_stats.updates++;
+    if (changed)
+        {
+            d_stats.adjustments++;
+        }
+    return changed;
+}
+
+
+bool Fpga_dynamic_bit_selection::enable_power_events()
+{
+    // same thresholds as the bit selection, so that an event means that the selection must change
+    d_map_base1[power_event_high_reg_addr] = Power_Threshold_High;
+    d_map_base1[power_event_low_reg_addr] = Power_Threshold_Low;
+    d_map_base2[power_event_high_reg_addr] = Power_Threshold_High;
+    d_map_base2[power_event_low_reg_addr] = Power_Threshold_Low;
+    if (!reenable_interrupts())
+        {
+            LOG(INFO) << "The dynamic bit selection has no power event interrupt, using periodic updates";
+            return false;
+        }
+    return true;
+}
+
+
+bool Fpga_dynamic_bit_selection::wait_power_event(uint32_t timeout_ms)
+{
+    std::array<pollfd, 2> pfd{{{d_device_descriptor1, POLLIN, 0}, {d_device_descriptor2, POLLIN, 0}}};
+    if (poll(pfd.data(), pfd.size(), static_cast<int>(timeout_ms)) <= 0)
+        {
+            return false;
+        }
+    int32_t irq_count;
+    uint64_t events = 0;
+    for (const auto &p : pfd)
+        {
+            if ((p.revents & POLLIN) and read(p.fd, &irq_count, sizeof(irq_count)) == sizeof(irq_count))
+                {
+                    events++;
+                }
+        }
+    reenable_interrupts();
+    const std::lock_guard<std::mutex> lock(d_stats_mutex);
+    d_stats.interrupts += events;
+    return events > 0;
+}
+
+
+Fpga_dynamic_bit_selection::Stats Fpga_dynamic_bit_selection::stats() const
+{
+    const std::lock_guard<std::mutex> lock(d_stats_mutex);
+    return d_stats;
+}
+
+
+bool Fpga_dynamic_bit_selection::reenable_interrupts()
+{
+    const int32_t reenable = 1;
+    return write(d_device_descriptor1, &reenable, sizeof(reenable)) == sizeof(reenable) and
+           write(d_device_descriptor2, &reenable, sizeof(reenable)) == sizeof(reenable);
 }
 
 
@@ -22,8 +22,10 @@
 #ifndef GNSS_SDR_FPGA_DYNAMIC_BIT_SELECTION_H
 #define GNSS_SDR_FPGA_DYNAMIC_BIT_SELECTION_H
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <string>
 
 /** \addtogroup Signal_Source
@@ -39,6 +41,19 @@
 class Fpga_dynamic_bit_selection
 {
 public:
+    /*!
+     * \brief State and counters of the bit selection, for monitoring
+     */
+    class Stats
+    {
+    public:
+        std::array<uint32_t, 2> rx_signal_power{};  // last power estimate of each frequency band
+        std::array<uint32_t, 2> shift_out_bits{};   // current bit selection of each frequency band
+        uint64_t updates{0};                        // calls to bit_selection()
+        uint64_t adjustments{0};                    // updates that changed the bit selection
+        uint64_t interrupts{0};                     // power events raised by the FPGA
+    };
+
     /*!
      * \brief Constructor
      */
@@ -53,7 +68,22 @@ public:
      * \brief This function configures the switch in th eFPGA
      */
     //    void set_switch_position(int32_t switch_position);
-    void bit_selection(void);
+    bool bit_selection(void);  // returns true if the bit selection changed
+
+    /*!
+     * \brief Programs the FPGA to raise an interrupt when the power estimate
+     * of a frequency band leaves the thresholds of the bit selection, and
+     * enables it. Returns false if the devices have no interrupt.
+     */
+    bool enable_power_events(void);
+
+    /*!
+     * \brief Waits for a power event of any frequency band, for at most
+     * timeout_ms. Returns true if an event was raised.
+     */
+    bool wait_power_event(uint32_t timeout_ms);
+
+    Stats stats() const;
 
 private:
     static const size_t FPGA_PAGE_SIZE = 0x10000;
@@ -68,7 +98,17 @@ private:
     static const uint32_t Power_Threshold_High = 9000;
     static const uint32_t Power_Threshold_Low = 3000;
 
+    // register addresses
+    static const uint32_t shift_out_bits_reg_addr = 0;
+    static const uint32_t rx_signal_power_reg_addr = 1;
+    static const uint32_t power_event_high_reg_addr = 2;  // interrupt if the power is above this
+    static const uint32_t power_event_low_reg_addr = 3;   // or below this
+
     void close_devices(void);
+    bool reenable_interrupts(void);
+
+    mutable std::mutex d_stats_mutex;
+    Stats d_stats;
 
     uint32_t shift_out_bits_band1;  // number of bits to shift for frequency band 1
     uint32_t shift_out_bits_band2;  // number of bits to shift for frequency band 2
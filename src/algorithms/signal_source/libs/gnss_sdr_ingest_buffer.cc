@@ -0,0 +1,177 @@
+/*!
+ * \file gnss_sdr_ingest_buffer.cc
+ * \brief Byte ring buffer between the receive thread of a network signal
+ * source and its work() function
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_ingest_buffer.h"
+#include <algorithm>  // for std::min
+#include <cstring>    // for memcpy
+
+
+Gnss_Sdr_Ingest_Buffer::Gnss_Sdr_Ingest_Buffer(size_t capacity, size_t prefill)
+    : buffer_(std::max(capacity, size_t(1))),
+      capacity_(buffer_.size()),
+      prefill_(std::min(prefill, buffer_.size())),
+      read_pos_(0),
+      write_pos_(0),
+      used_(0),
+      overruns_(0),
+      dropped_bytes_(0),
+      filling_(prefill_ > 0),
+      closed_(false)
+{
+}
+
+
+bool Gnss_Sdr_Ingest_Buffer::write(const void* data, size_t bytes, bool blocking)
+{
+    const auto* in = static_cast<const uint8_t*>(data);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (filling_ && capacity_ - used_ < std::min(bytes, capacity_))
+        {
+            // a full buffer does not wait for the prefill level
+            filling_ = false;
+            not_empty_.notify_one();
+        }
+    if (!blocking && capacity_ - used_ < bytes)
+        {
+            overruns_++;
+            dropped_bytes_ += bytes;
+            return false;
+        }
+    while (bytes > 0)
+        {
+            // a blocking write larger than the buffer goes in several steps
+            const size_t chunk = std::min(bytes, capacity_);
+            not_full_.wait(lock, [&] { return closed_ || capacity_ - used_ >= chunk; });
+            if (closed_)
+                {
+                    return false;
+                }
+            const size_t offset = write_pos_;
+            lock.unlock();
+            copy_in(in, chunk, offset);
+            lock.lock();
+            write_pos_ = (write_pos_ + chunk) % capacity_;
+            used_ += chunk;
+            if (filling_ && used_ >= prefill_)
+                {
+                    filling_ = false;
+                }
+            if (!filling_)
+                {
+                    not_empty_.notify_one();
+                }
+            in += chunk;
+            bytes -= chunk;
+        }
+    return true;
+}
+
+
+size_t Gnss_Sdr_Ingest_Buffer::read(void* data, size_t max_bytes, size_t granularity,
+    std::chrono::milliseconds timeout)
+{
+    granularity = std::max(granularity, size_t(1));
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!closed_ && !filling_ && used_ < granularity && prefill_ > 0)
+        {
+            // the buffer ran dry, wait until it holds prefill bytes again
+            filling_ = true;
+        }
+    const auto ready = [&] { return closed_ || (!filling_ && used_ >= granularity); };
+    if (!ready() && timeout.count() > 0)
+        {
+            not_empty_.wait_for(lock, timeout, ready);
+        }
+    if (filling_ && !closed_)
+        {
+            return 0;
+        }
+    size_t bytes = std::min(max_bytes, used_);
+    bytes -= bytes % granularity;
+    if (bytes == 0)
+        {
+            return 0;
+        }
+    const size_t offset = read_pos_;
+    lock.unlock();
+    copy_out(static_cast<uint8_t*>(data), bytes, offset);
+    lock.lock();
+    read_pos_ = (read_pos_ + bytes) % capacity_;
+    used_ -= bytes;
+    not_full_.notify_one();
+    return bytes;
+}
+
+
+void Gnss_Sdr_Ingest_Buffer::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+}
+
+
+bool Gnss_Sdr_Ingest_Buffer::closed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+
+bool Gnss_Sdr_Ingest_Buffer::drained() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_ && used_ == 0;
+}
+
+
+uint64_t Gnss_Sdr_Ingest_Buffer::overruns() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overruns_;
+}
+
+
+uint64_t Gnss_Sdr_Ingest_Buffer::dropped_bytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_bytes_;
+}
+
+
+void Gnss_Sdr_Ingest_Buffer::copy_in(const uint8_t* data, size_t bytes, size_t offset)
+{
+    const size_t first = std::min(bytes, capacity_ - offset);
+    memcpy(&buffer_[offset], data, first);
+    if (first < bytes)
+        {
+            memcpy(&buffer_[0], data + first, bytes - first);
+        }
+}
+
+
+void Gnss_Sdr_Ingest_Buffer::copy_out(uint8_t* data, size_t bytes, size_t offset) const
+{
+    const size_t first = std::min(bytes, capacity_ - offset);
+    memcpy(data, &buffer_[offset], first);
+    if (first < bytes)
+        {
+            memcpy(data + first, &buffer_[0], bytes - first);
+        }
+}
@@ -0,0 +1,101 @@
+/*!
+ * \file gnss_sdr_ingest_buffer.h
+ * \brief Byte ring buffer between the receive thread of a network signal
+ * source and its work() function
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_INGEST_BUFFER_H
+#define GNSS_SDR_GNSS_SDR_INGEST_BUFFER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Single-producer single-consumer byte FIFO that decouples the thread
+ * receiving samples from the network from the flowgraph thread.
+ *
+ * The receive thread writes whole chunks (a TCP read, a UDP payload) and the
+ * source block reads them in its work(). Only the positions are protected by
+ * the mutex: the bytes are copied in and out of the buffer without holding
+ * it, so neither side waits for the other while copying.
+ *
+ * The buffer also works as a jitter buffer: after it starts, and each time it
+ * runs dry, reads wait until it holds at least prefill bytes, so that the
+ * flowgraph absorbs the network jitter instead of starving sample by sample.
+ */
+class Gnss_Sdr_Ingest_Buffer
+{
+public:
+    Gnss_Sdr_Ingest_Buffer(size_t capacity, size_t prefill = 0);
+
+    /*!
+     * \brief Copies bytes into the buffer. If there is no room for them, it
+     * waits for the reader when blocking is true (backpressure, for TCP
+     * streams), or drops the whole chunk and returns false otherwise.
+     * It also returns false when the buffer has been closed.
+     */
+    bool write(const void* data, size_t bytes, bool blocking);
+
+    /*!
+     * \brief Copies up to max_bytes, rounded down to a multiple of
+     * granularity, out of the buffer. It waits up to timeout for data, and
+     * returns the number of bytes read (0 if there was nothing to read).
+     */
+    size_t read(void* data, size_t max_bytes, size_t granularity,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /*!
+     * \brief Wakes up and releases both sides. Pending bytes can still be
+     * read, but no more can be written.
+     */
+    void close();
+
+    bool closed() const;
+    bool drained() const;  //!< true when closed and empty
+    size_t capacity() const { return capacity_; }
+    uint64_t overruns() const;       //!< chunks dropped by non-blocking writes
+    uint64_t dropped_bytes() const;  //!< bytes of those chunks
+
+private:
+    void copy_in(const uint8_t* data, size_t bytes, size_t offset);
+    void copy_out(uint8_t* data, size_t bytes, size_t offset) const;
+
+    std::vector<uint8_t> buffer_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    size_t capacity_;
+    size_t prefill_;
+    size_t read_pos_;
+    size_t write_pos_;
+    size_t used_;
+    uint64_t overruns_;
+    uint64_t dropped_bytes_;
+    bool filling_;  // waiting to reach prefill bytes
+    bool closed_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_INGEST_BUFFER_H
@@ -0,0 +1,318 @@
+/*!
+ * \file gnss_sdr_shm_ring.h
+ * \brief Single-producer single-consumer ring buffer in POSIX shared memory,
+ * with a minimal C API for external sample producers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*
+ * This header is self-contained and valid C99 and C++, so that capture
+ * programs can write samples directly into the Shm_Signal_Source of a running
+ * receiver:
+ *
+ *   gnss_sdr_shm_ring ring;
+ *   while (gnss_sdr_shm_ring_attach(&ring, "/gnss-sdr") != 0)
+ *       sleep(1);  // the receiver creates the buffer when it starts
+ *   for (;;)
+ *       {
+ *           void *buffer = gnss_sdr_shm_ring_reserve(&ring, bytes);
+ *           if (buffer != NULL)  // NULL: overrun, the samples are dropped
+ *               {
+ *                   get_samples(buffer, bytes);  // no intermediate copy
+ *                   gnss_sdr_shm_ring_commit(&ring, bytes);
+ *               }
+ *       }
+ *   gnss_sdr_shm_ring_close(&ring);
+ *
+ * or gnss_sdr_shm_ring_write() to copy from an existing buffer. Writes should
+ * be a whole number of items. The producer never blocks: if the receiver
+ * falls behind and there is no room for a write, the write is dropped and
+ * counted in the overrun counter of the buffer.
+ *
+ * The data area is mapped twice in a row, so any region of up to the
+ * capacity of the buffer is contiguous in memory, even if it wraps around.
+ * The consumer sleeps on a futex (Linux) when the buffer is empty, and the
+ * producer only makes a system call to wake it up if it is actually sleeping.
+ */
+
+#ifndef GNSS_SDR_SHM_RING_H
+#define GNSS_SDR_SHM_RING_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+#define GNSS_SDR_SHM_RING_MAGIC 0x52534D47u /* "GMSR" */
+#define GNSS_SDR_SHM_RING_VERSION 1u
+#define GNSS_SDR_SHM_RING_HEADER_SIZE 65536u /* a multiple of any page size */
+
+
+/*! Control block at the beginning of the shared memory segment */
+typedef struct gnss_sdr_shm_ring_header
+{
+    /* written once by the consumer when it creates the buffer */
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity; /* bytes of the data area, a power of two */
+    uint32_t item_size;
+    uint32_t reserved;
+    uint8_t pad0[40];
+
+    /* written by the producer */
+    uint64_t write_pos;        /* total bytes written */
+    uint64_t overruns;         /* writes dropped for lack of room */
+    uint64_t dropped_bytes;    /* bytes of those writes */
+    uint32_t write_seq;        /* futex word, changes on every commit */
+    uint32_t consumer_waiting; /* written by the consumer, set while it sleeps */
+    uint8_t pad1[32];
+
+    /* written by the consumer, in its own cache line */
+    uint64_t read_pos; /* total bytes read */
+    uint8_t pad2[56];
+} gnss_sdr_shm_ring_header;
+
+
+/*! One side of the buffer, as mapped by the calling process */
+typedef struct gnss_sdr_shm_ring
+{
+    gnss_sdr_shm_ring_header *header;
+    uint8_t *data;
+    size_t map_size;
+    int fd;
+} gnss_sdr_shm_ring;
+
+
+static inline int gnss_sdr_shm_ring_map_(gnss_sdr_shm_ring *ring, int fd, uint64_t capacity)
+{
+    const size_t header_size = GNSS_SDR_SHM_RING_HEADER_SIZE;
+    uint8_t *base;
+    ring->map_size = header_size + 2 * (size_t)capacity;
+    /* reserve the address range, then map the data area twice into it */
+    base = (uint8_t *)mmap(NULL, ring->map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (uint8_t *)MAP_FAILED)
+        {
+            return -1;
+        }
+    if (mmap(base, header_size + (size_t)capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        mmap(base + header_size + capacity, (size_t)capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, (off_t)header_size) == MAP_FAILED)
+        {
+            munmap(base, ring->map_size);
+            return -1;
+        }
+    ring->header = (gnss_sdr_shm_ring_header *)base;
+    ring->data = base + header_size;
+    ring->fd = fd;
+    return 0;
+}
+
+
+/*!
+ * Creates (or recreates) the buffer. Used by the receiver. The capacity is
+ * rounded up to a power of two of at least 64 KiB. Returns 0 on
+ * success, -1 on error (see errno).
+ */
+static inline int gnss_sdr_shm_ring_create(gnss_sdr_shm_ring *ring, const char *name, uint64_t capacity, uint32_t item_size)
+{
+    uint64_t size = GNSS_SDR_SHM_RING_HEADER_SIZE;
+    int fd;
+    while (size < capacity)
+        {
+            size <<= 1;
+        }
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        {
+            return -1;
+        }
+    if (ftruncate(fd, (off_t)(GNSS_SDR_SHM_RING_HEADER_SIZE + size)) != 0 || gnss_sdr_shm_ring_map_(ring, fd, size) != 0)
+        {
+            close(fd);
+            shm_unlink(name);
+            return -1;
+        }
+    memset(ring->header, 0, sizeof(gnss_sdr_shm_ring_header));
+    ring->header->version = GNSS_SDR_SHM_RING_VERSION;
+    ring->header->capacity = size;
+    ring->header->item_size = item_size;
+    /* producers only attach once they see the magic */
+    __atomic_store_n(&ring->header->magic, GNSS_SDR_SHM_RING_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+
+/*!
+ * Attaches to a buffer created by the receiver. Used by producers. Returns 0
+ * on success, -1 if the buffer does not exist (yet) or is not valid.
+ */
+static inline int gnss_sdr_shm_ring_attach(gnss_sdr_shm_ring *ring, const char *name)
+{
+    gnss_sdr_shm_ring_header *header;
+    uint64_t capacity = 0;
+    struct stat status;
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        {
+            return -1;
+        }
+    if (fstat(fd, &status) != 0 || (size_t)status.st_size < GNSS_SDR_SHM_RING_HEADER_SIZE)
+        {
+            close(fd);
+            errno = EAGAIN;
+            return -1;
+        }
+    header = (gnss_sdr_shm_ring_header *)mmap(NULL, GNSS_SDR_SHM_RING_HEADER_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    if (header == (gnss_sdr_shm_ring_header *)MAP_FAILED)
+        {
+            close(fd);
+            return -1;
+        }
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == GNSS_SDR_SHM_RING_MAGIC && header->version == GNSS_SDR_SHM_RING_VERSION)
+        {
+            capacity = header->capacity;
+        }
+    munmap(header, GNSS_SDR_SHM_RING_HEADER_SIZE);
+    if (capacity == 0 || (uint64_t)status.st_size < GNSS_SDR_SHM_RING_HEADER_SIZE + capacity || gnss_sdr_shm_ring_map_(ring, fd, capacity) != 0)
+        {
+            close(fd);
+            errno = EAGAIN;
+            return -1;
+        }
+    return 0;
+}
+
+
+/*! Unmaps the buffer. The receiver also removes it with shm_unlink() */
+static inline void gnss_sdr_shm_ring_close(gnss_sdr_shm_ring *ring)
+{
+    if (ring->header != NULL)
+        {
+            munmap(ring->header, ring->map_size);
+            close(ring->fd);
+            ring->header = NULL;
+            ring->data = NULL;
+        }
+}
+
+
+/*!
+ * Producer: returns where the next bytes can be written, or NULL (and counts
+ * an overrun) if there is no room for them.
+ */
+static inline void *gnss_sdr_shm_ring_reserve(gnss_sdr_shm_ring *ring, size_t bytes)
+{
+    gnss_sdr_shm_ring_header *header = ring->header;
+    const uint64_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
+    const uint64_t write_pos = header->write_pos;
+    if (write_pos - read_pos + bytes > header->capacity)
+        {
+            __atomic_store_n(&header->overruns, header->overruns + 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&header->dropped_bytes, header->dropped_bytes + bytes, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    return ring->data + (write_pos & (header->capacity - 1));
+}
+
+
+/*! Producer: publishes bytes written at the region returned by reserve() */
+static inline void gnss_sdr_shm_ring_commit(gnss_sdr_shm_ring *ring, size_t bytes)
+{
+    gnss_sdr_shm_ring_header *header = ring->header;
+    __atomic_store_n(&header->write_pos, header->write_pos + bytes, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&header->write_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&header->consumer_waiting, __ATOMIC_SEQ_CST) != 0)
+        {
+#if defined(__linux__)
+            syscall(SYS_futex, &header->write_seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+        }
+}
+
+
+/*! Producer: copies bytes into the buffer. Returns 0, or -1 on overrun */
+static inline int gnss_sdr_shm_ring_write(gnss_sdr_shm_ring *ring, const void *buffer, size_t bytes)
+{
+    void *destination = gnss_sdr_shm_ring_reserve(ring, bytes);
+    if (destination == NULL)
+        {
+            return -1;
+        }
+    memcpy(destination, buffer, bytes);
+    gnss_sdr_shm_ring_commit(ring, bytes);
+    return 0;
+}
+
+
+/*! Consumer: bytes ready to be read, contiguous at gnss_sdr_shm_ring_read_ptr() */
+static inline uint64_t gnss_sdr_shm_ring_readable(const gnss_sdr_shm_ring *ring)
+{
+    return __atomic_load_n(&ring->header->write_pos, __ATOMIC_ACQUIRE) - ring->header->read_pos;
+}
+
+
+static inline const void *gnss_sdr_shm_ring_read_ptr(const gnss_sdr_shm_ring *ring)
+{
+    return ring->data + (ring->header->read_pos & (ring->header->capacity - 1));
+}
+
+
+/*! Consumer: gives bytes already read back to the producer */
+static inline void gnss_sdr_shm_ring_release(gnss_sdr_shm_ring *ring, uint64_t bytes)
+{
+    __atomic_store_n(&ring->header->read_pos, ring->header->read_pos + bytes, __ATOMIC_RELEASE);
+}
+
+
+/*! Consumer: sleeps until there is data to read, or the timeout expires */
+static inline void gnss_sdr_shm_ring_wait(gnss_sdr_shm_ring *ring, int timeout_ms)
+{
+    gnss_sdr_shm_ring_header *header = ring->header;
+    struct timespec timeout;
+    uint32_t seq;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+    __atomic_store_n(&header->consumer_waiting, 1, __ATOMIC_SEQ_CST);
+    seq = __atomic_load_n(&header->write_seq, __ATOMIC_SEQ_CST);
+    if (gnss_sdr_shm_ring_readable(ring) == 0)
+        {
+#if defined(__linux__)
+            syscall(SYS_futex, &header->write_seq, FUTEX_WAIT, seq, &timeout, NULL, 0);
+#else
+            (void)seq;
+            timeout.tv_sec = 0;
+            timeout.tv_nsec = 1000000L; /* no futex: poll every millisecond */
+            nanosleep(&timeout, NULL);
+#endif
+        }
+    __atomic_store_n(&header->consumer_waiting, 0, __ATOMIC_SEQ_CST);
+}
+
+
+/** \} */
+/** \} */
+#endif /* GNSS_SDR_SHM_RING_H */
@@ -16,7 +16,9 @@
 
 
 #include "gnss_sdr_timestamp.h"
-#include "command_event.h"
+#include "control_queue.h"
+#include "gnss_sdr_sample_gap.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>  // for io_signature
 #include <pmt/pmt.h>                // for make_any
 #include <pmt/pmt_sugar.h>          // for mp
@@ -27,17 +29,31 @@
 #include <utility>
 
 
+namespace
+{
+constexpr uint64_t SECONDS_PER_WEEK = 604800;
+}
+
+
 Gnss_Sdr_Timestamp::Gnss_Sdr_Timestamp(size_t sizeof_stream_item,
-    std::string timestamp_file, double clock_offset_ms)
+    std::string timestamp_file, double clock_offset_ms, double sampling_frequency)
     : gr::sync_block("Timestamp",
           gr::io_signature::make(1, 20, sizeof_stream_item),
           gr::io_signature::make(1, 20, sizeof_stream_item)),
       d_timefile(std::move(timestamp_file)),
+      d_rx_time_key(pmt::mp("rx_time")),
       d_clock_offset_ms(clock_offset_ms),
+      d_sampling_frequency(sampling_frequency),
       d_fraction_ms_offset(modf(d_clock_offset_ms, &d_integer_ms_offset)),  // optional clockoffset parameter to convert UTC timestamps to GPS time in some receiver's configuration
+      d_item_size(sizeof_stream_item),
       d_next_timetag_samplecount(0),
-      d_get_next_timetag(true)
+      d_overflows(0),
+      d_dropped_samples(0),
+      d_get_next_timetag(true),
+      d_from_rx_time(sampling_frequency > 0.0)
 {
+    // each channel keeps its own tags
+    set_tag_propagation_policy(TPP_ONE_TO_ONE);
 }
 
 
@@ -48,6 +64,13 @@ gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp(size_t sizeof_stream
 }
 
 
+gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp_from_rx_time(size_t sizeof_stream_item, double sampling_frequency, double clock_offset_ms)
+{
+    gnss_shared_ptr<Gnss_Sdr_Timestamp> Timestamp_(new Gnss_Sdr_Timestamp(sizeof_stream_item, std::string(), clock_offset_ms, sampling_frequency));
+    return Timestamp_;
+}
+
+
 bool Gnss_Sdr_Timestamp::read_next_timetag()
 {
     d_timefilestream.read(reinterpret_cast<char*>(&d_next_timetag_samplecount), sizeof(uint64_t));
@@ -71,6 +94,10 @@ bool Gnss_Sdr_Timestamp::read_next_timetag()
 
 bool Gnss_Sdr_Timestamp::start()
 {
+    if (d_from_rx_time)
+        {
+            return true;
+        }
     d_timefilestream.open(d_timefile, std::ios::in | std::ios::binary);
 
     if (d_timefilestream.is_open() == false)
@@ -85,6 +112,96 @@ bool Gnss_Sdr_Timestamp::start()
 }
 
 
+bool Gnss_Sdr_Timestamp::add_index(const std::string& filename, uint64_t first_item)
+{
+    auto writer = std::make_unique<CaptureIndexWriter>();
+    if (!writer->open(filename, first_item, d_item_size))
+        {
+            return false;
+        }
+    d_index_writers.push_back(std::move(writer));
+    return true;
+}
+
+
+bool Gnss_Sdr_Timestamp::stop()
+{
+    if (d_from_rx_time && d_overflows > 0)
+        {
+            LOG(WARNING) << d_overflows << " overflows of the signal source, " << d_dropped_samples << " samples lost";
+        }
+    return true;
+}
+
+
+uint64_t Gnss_Sdr_Timestamp::overflows() const
+{
+    return d_overflows;
+}
+
+
+uint64_t Gnss_Sdr_Timestamp::dropped_samples() const
+{
+    return d_dropped_samples;
+}
+
+
+void Gnss_Sdr_Timestamp::tag_rx_time(size_t ch, uint64_t offset, const pmt::pmt_t& rx_time)
+{
+    const uint64_t full_secs = pmt::to_uint64(pmt::tuple_ref(rx_time, 0));
+    const double frac_secs = pmt::to_double(pmt::tuple_ref(rx_time, 1));
+
+    // After an overflow, the source restarts the tags at the time of the
+    // first sample received, so the gap tells how many samples were lost
+    RxTime& last = d_rx_time[ch];
+    if (last.valid)
+        {
+            const double elapsed_s = (static_cast<double>(full_secs) - static_cast<double>(last.full_secs)) + (frac_secs - last.frac_secs);
+            const int64_t elapsed_samples = std::llround(elapsed_s * d_sampling_frequency);
+            const uint64_t expected_offset = elapsed_samples > 0 ? last.offset + static_cast<uint64_t>(elapsed_samples) : last.offset;
+            if (expected_offset > offset)
+                {
+                    d_overflows++;
+                    d_dropped_samples += expected_offset - offset;
+                    LOG(WARNING) << "Overflow in RF channel " << ch << ": " << expected_offset - offset << " samples lost before sample " << offset;
+                    add_item_tag(ch, offset, sample_gap_key(), make_sample_gap(expected_offset - offset));
+                }
+        }
+    last.offset = offset;
+    last.full_secs = full_secs;
+    last.frac_secs = frac_secs;
+    last.valid = true;
+
+    // the same time tags as those read from a timestamp file
+    auto week = static_cast<int64_t>(full_secs / SECONDS_PER_WEEK);
+    double tow_ms = static_cast<double>(full_secs % SECONDS_PER_WEEK) * 1000.0 + frac_secs * 1000.0 + d_clock_offset_ms;
+    if (tow_ms < 0.0)
+        {
+            tow_ms += static_cast<double>(SECONDS_PER_WEEK) * 1000.0;
+            week--;
+        }
+    else if (tow_ms >= static_cast<double>(SECONDS_PER_WEEK) * 1000.0)
+        {
+            tow_ms -= static_cast<double>(SECONDS_PER_WEEK) * 1000.0;
+            week++;
+        }
+    const std::shared_ptr<GnssTime> tmp_obj = std::make_shared<GnssTime>(GnssTime());
+    double integer_ms;
+    tmp_obj->tow_ms_fraction = modf(tow_ms, &integer_ms);
+    tmp_obj->tow_ms = static_cast<int>(integer_ms);
+    tmp_obj->week = static_cast<int>(week);
+    tmp_obj->rx_time = 0;
+    add_item_tag(ch, offset, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+    if (ch == 0)
+        {
+            for (auto& writer : d_index_writers)
+                {
+                    writer->write(offset, tmp_obj->week, tmp_obj->tow_ms);
+                }
+        }
+}
+
+
 int64_t Gnss_Sdr_Timestamp::uint64diff(uint64_t first, uint64_t second)
 {
     uint64_t abs_diff = (first > second) ? (first - second) : (second - first);
@@ -97,6 +214,21 @@ int Gnss_Sdr_Timestamp::work(int noutput_items,
     gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items)
 {
+    if (d_from_rx_time)
+        {
+            d_rx_time.resize(output_items.size());
+            for (size_t ch = 0; ch < output_items.size(); ch++)
+                {
+                    std::memcpy(output_items[ch], input_items[ch], noutput_items * input_signature()->sizeof_stream_item(ch));
+                    get_tags_in_range(d_tags, ch, nitems_read(ch), nitems_read(ch) + noutput_items, d_rx_time_key);
+                    for (const auto& tag : d_tags)
+                        {
+                            tag_rx_time(ch, tag.offset, tag.value);
+                        }
+                }
+            return noutput_items;
+        }
+
     // multichannel support
     if (d_get_next_timetag == true)
         {
@@ -121,6 +253,13 @@ int Gnss_Sdr_Timestamp::work(int noutput_items,
                     tmp_obj->tow_ms_fraction = d_fraction_ms_offset;
                     tmp_obj->rx_time = 0;
                     add_item_tag(ch, this->nitems_written(ch) - diff_samplecount, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    if (ch == 0)
+                        {
+                            for (auto& writer : d_index_writers)
+                                {
+                                    writer->write(this->nitems_written(ch) - diff_samplecount, tmp_obj->week, tmp_obj->tow_ms);
+                                }
+                        }
                     // std::cout << "[" << this->nitems_written(ch) - diff_samplecount << "] Sent TimeTag SC: " << d_next_timetag_samplecount * bytes_to_samples << ", Week: " << next_timetag.week << ", TOW: " << next_timetag.tow_ms << " [ms] \n";
                     d_get_next_timetag = true;
                 }
@@ -18,15 +18,19 @@
 #ifndef GNSS_SDR_GNSS_SDR_TIMESTAMP_H
 #define GNSS_SDR_GNSS_SDR_TIMESTAMP_H
 
+#include "capture_index.h"
 #include "gnss_block_interface.h"
 #include "gnss_time.h"
 #include <gnuradio/sync_block.h>  // for sync_block
+#include <gnuradio/tags.h>        // for tag_t
 #include <gnuradio/types.h>       // for gr_vector_const_void_star
 #include <pmt/pmt.h>
 #include <cstddef>  // for size_t
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <vector>
 
 /** \addtogroup Signal_Source
  * \{ */
@@ -41,6 +45,18 @@ gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp(
     std::string timestamp_file,
     double clock_offset_ms);
 
+/*!
+ * \brief Makes a timestamp block that, instead of reading a file, converts
+ * the "rx_time" tags of a UHD source (sent at the start of the stream and
+ * after every overflow) into time tags, and counts the samples lost in each
+ * overflow. The device time is taken as seconds since the GPS epoch, plus
+ * clock_offset_ms.
+ */
+gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp_from_rx_time(
+    size_t sizeof_stream_item,
+    double sampling_frequency,
+    double clock_offset_ms);
+
 
 class Gnss_Sdr_Timestamp : public gr::sync_block
 {
@@ -49,6 +65,18 @@ public:
         gr_vector_const_void_star& input_items,
         gr_vector_void_star& output_items);
     bool start();
+    bool stop();
+
+    //! Overflows found in the rx_time tags, and samples lost in them (all channels)
+    uint64_t overflows() const;
+    uint64_t dropped_samples() const;
+
+    /*!
+     * \brief Also writes each time tag to a capture index, mapping the GNSS
+     * time to the position in a file that starts first_item items before
+     * the stream.
+     */
+    bool add_index(const std::string& filename, uint64_t first_item);
 
 private:
     friend gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp(
@@ -56,20 +84,46 @@ private:
         std::string timestamp_file,
         double clock_offset_ms);
 
+    friend gnss_shared_ptr<Gnss_Sdr_Timestamp> gnss_sdr_make_Timestamp_from_rx_time(
+        size_t sizeof_stream_item,
+        double sampling_frequency,
+        double clock_offset_ms);
+
     Gnss_Sdr_Timestamp(size_t sizeof_stream_item,
         std::string timestamp_file,
-        double clock_offset_ms);
+        double clock_offset_ms,
+        double sampling_frequency = 0.0);
+
+    // last rx_time tag of a channel
+    class RxTime
+    {
+    public:
+        uint64_t offset{0};
+        uint64_t full_secs{0};
+        double frac_secs{0.0};
+        bool valid{false};
+    };
 
     int64_t uint64diff(uint64_t first, uint64_t second);
     bool read_next_timetag();
+    void tag_rx_time(size_t ch, uint64_t offset, const pmt::pmt_t& rx_time);
     std::string d_timefile;
     std::fstream d_timefilestream;
+    std::vector<std::unique_ptr<CaptureIndexWriter>> d_index_writers;
+    std::vector<RxTime> d_rx_time;
+    std::vector<gr::tag_t> d_tags;
+    pmt::pmt_t d_rx_time_key;
     GnssTime next_timetag{};
     double d_clock_offset_ms;
+    double d_sampling_frequency;
     double d_fraction_ms_offset;
     double d_integer_ms_offset;
+    size_t d_item_size;
     uint64_t d_next_timetag_samplecount;
+    uint64_t d_overflows;
+    uint64_t d_dropped_samples;
     bool d_get_next_timetag;
+    bool d_from_rx_time;
 };
 
 
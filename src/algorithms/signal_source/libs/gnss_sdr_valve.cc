@@ -18,7 +18,7 @@
  */
 
 #include "gnss_sdr_valve.h"
-#include "command_event.h"
+#include "control_queue.h"
 #include <glog/logging.h>           // for LOG
 #include <gnuradio/io_signature.h>  // for io_signature
 #include <algorithm>                // for min
@@ -26,7 +26,7 @@
 
 Gnss_Sdr_Valve::Gnss_Sdr_Valve(size_t sizeof_stream_item,
     uint64_t nitems,
-    Concurrent_Queue<pmt::pmt_t>* queue,
+    Control_Queue* queue,
     bool stop_flowgraph) : gr::sync_block("valve",
                                gr::io_signature::make(1, 20, sizeof_stream_item),
                                gr::io_signature::make(1, 20, sizeof_stream_item)),
@@ -39,14 +39,14 @@ Gnss_Sdr_Valve::Gnss_Sdr_Valve(size_t sizeof_stream_item,
 }
 
 
-gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(size_t sizeof_stream_item, uint64_t nitems, Concurrent_Queue<pmt::pmt_t>* queue, bool stop_flowgraph)
+gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(size_t sizeof_stream_item, uint64_t nitems, Control_Queue* queue, bool stop_flowgraph)
 {
     gnss_shared_ptr<Gnss_Sdr_Valve> valve_(new Gnss_Sdr_Valve(sizeof_stream_item, nitems, queue, stop_flowgraph));
     return valve_;
 }
 
 
-gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(size_t sizeof_stream_item, uint64_t nitems, Concurrent_Queue<pmt::pmt_t>* queue)
+gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(size_t sizeof_stream_item, uint64_t nitems, Control_Queue* queue)
 {
     gnss_shared_ptr<Gnss_Sdr_Valve> valve_(new Gnss_Sdr_Valve(sizeof_stream_item, nitems, queue, true));
     return valve_;
@@ -68,7 +68,7 @@ int Gnss_Sdr_Valve::work(int noutput_items,
             if (d_ncopied_items >= d_nitems)
                 {
                     LOG(INFO) << "Stopping receiver, " << d_ncopied_items << " samples processed";
-                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
+                    d_queue->push(command_event_make(200, 0));
                     if (d_stop_flowgraph)
                         {
                             return -1;  // Done!
@@ -20,7 +20,7 @@
 #ifndef GNSS_SDR_GNSS_SDR_VALVE_H
 #define GNSS_SDR_GNSS_SDR_VALVE_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_block.h>  // for sync_block
 #include <gnuradio/types.h>       // for gr_vector_const_void_star
@@ -39,12 +39,12 @@ class Gnss_Sdr_Valve;
 gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(
     size_t sizeof_stream_item,
     uint64_t nitems,
-    Concurrent_Queue<pmt::pmt_t>* queue);
+    Control_Queue* queue);
 
 gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(
     size_t sizeof_stream_item,
     uint64_t nitems,
-    Concurrent_Queue<pmt::pmt_t>* queue,
+    Control_Queue* queue,
     bool stop_flowgraph);
 
 /*!
@@ -64,21 +64,21 @@ private:
     friend gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(
         size_t sizeof_stream_item,
         uint64_t nitems,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     friend gnss_shared_ptr<Gnss_Sdr_Valve> gnss_sdr_make_valve(
         size_t sizeof_stream_item,
         uint64_t nitems,
-        Concurrent_Queue<pmt::pmt_t>* queue,
+        Control_Queue* queue,
         bool stop_flowgraph);
 
     Gnss_Sdr_Valve(size_t sizeof_stream_item,
         uint64_t nitems,
-        Concurrent_Queue<pmt::pmt_t>* queue, bool stop_flowgraph);
+        Control_Queue* queue, bool stop_flowgraph);
 
     uint64_t d_nitems;
     uint64_t d_ncopied_items;
-    Concurrent_Queue<pmt::pmt_t>* d_queue;
+    Control_Queue* d_queue;
     bool d_stop_flowgraph;
     bool d_open_valve;
 };
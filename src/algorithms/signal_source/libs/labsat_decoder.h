@@ -0,0 +1,221 @@
+/*!
+ * \file labsat_decoder.h
+ * \brief Table-driven decoding of the samples of LabSat 2, 3 and 3 Wideband
+ * files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_LABSAT_DECODER_H
+#define GNSS_SDR_LABSAT_DECODER_H
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Decodes LabSat samples to std::complex<float> (gr_complex),
+ * std::complex<int16_t> (cshort) or std::complex<int8_t> (cbyte) with lookup
+ * tables built once: one entry per byte of the 16-bit words of LabSat 2 and 3
+ * files, and one entry per sample code of LabSat 3 Wideband registers.
+ *
+ * The integer outputs are the quantization levels of the samples: +/-1 and
+ * +/-2 for LabSat 2 and 3, and +/-1 ... +/-2^(QUA - 1) for LabSat 3 Wideband,
+ * whose complex<float> samples are those levels divided by 2^(QUA - 1).
+ */
+template <typename T>
+class Labsat_Decoder
+{
+public:
+    Labsat_Decoder()
+    {
+        for (int byte = 0; byte < 256; byte++)
+            {
+                // 1 bit I + 1 bit Q per sample, MSB first
+                for (int j = 0; j < 4; j++)
+                    {
+                        const int i_bit = (byte >> (7 - 2 * j)) & 0x01;
+                        const int q_bit = (byte >> (6 - 2 * j)) & 0x01;
+                        d_lut_2bit[byte][j] = sample(2 * i_bit - 1, 2 * q_bit - 1, 1.0F);
+                    }
+                // I sign, Q sign, I magnitude, Q magnitude per sample, MSB first
+                for (int j = 0; j < 2; j++)
+                    {
+                        const int nibble = (byte >> (4 - 4 * j)) & 0x0F;
+                        d_lut_4bit[byte][j] = sample(level_4bit(nibble >> 3, (nibble >> 1) & 0x01),
+                            level_4bit((nibble >> 2) & 0x01, nibble & 0x01), 1.0F);
+                    }
+            }
+    }
+
+    /*!
+     * \brief Decodes n_words 16-bit words of a single-channel LabSat 2 or 3
+     * file, with 8 (bits_per_sample = 2) or 4 (bits_per_sample = 4) samples
+     * per word. Returns the number of samples written to out.
+     */
+    size_t decode_words(const int16_t* words, size_t n_words, int bits_per_sample, T* out) const
+    {
+        if (bits_per_sample == 2)
+            {
+                for (size_t w = 0; w < n_words; w++)
+                    {
+                        const auto word = static_cast<uint16_t>(words[w]);
+                        const std::array<T, 4>& high = d_lut_2bit[word >> 8];
+                        const std::array<T, 4>& low = d_lut_2bit[word & 0xFF];
+                        T* o = out + 8 * w;
+                        o[0] = high[0];
+                        o[1] = high[1];
+                        o[2] = high[2];
+                        o[3] = high[3];
+                        o[4] = low[0];
+                        o[5] = low[1];
+                        o[6] = low[2];
+                        o[7] = low[3];
+                    }
+                return 8 * n_words;
+            }
+        if (bits_per_sample == 4)
+            {
+                for (size_t w = 0; w < n_words; w++)
+                    {
+                        const auto word = static_cast<uint16_t>(words[w]);
+                        const std::array<T, 2>& high = d_lut_4bit[word >> 8];
+                        const std::array<T, 2>& low = d_lut_4bit[word & 0xFF];
+                        T* o = out + 4 * w;
+                        o[0] = high[0];
+                        o[1] = high[1];
+                        o[2] = low[0];
+                        o[3] = low[1];
+                    }
+                return 4 * n_words;
+            }
+        return 0;
+    }
+
+    /*!
+     * \brief Sets the format of the LabSat 3 Wideband registers: bits per I
+     * or Q component (QUA, 1 to 3), bits between consecutive samples (SFT),
+     * spare bits at the start of each register, and samples per register.
+     */
+    void set_ls3w_format(int quantization, int shift, int spare_bits, int samples_per_register)
+    {
+        d_ls3w_quantization = quantization;
+        d_ls3w_shift = shift;
+        d_ls3w_spare_bits = spare_bits;
+        d_ls3w_samples_per_register = samples_per_register;
+        d_lut_ls3w.clear();
+        if (quantization < 1 || quantization > 3)
+            {
+                return;
+            }
+        // I code in the upper QUA bits, Q code in the lower QUA bits
+        const int levels = 1 << (quantization - 1);
+        const float scale = 1.0F / static_cast<float>(levels);
+        const int mask = (1 << quantization) - 1;
+        d_lut_ls3w.resize(1U << (2 * quantization));
+        for (int code = 0; code < static_cast<int>(d_lut_ls3w.size()); code++)
+            {
+                d_lut_ls3w[code] = sample(level_ls3w(code >> quantization, quantization),
+                    level_ls3w(code & mask, quantization), scale);
+            }
+    }
+
+    /*!
+     * \brief Decodes the samples of the channel starting channel_offset bits
+     * after the spare bits of n_registers LabSat 3 Wideband registers, read
+     * as little-endian 64-bit words. Returns the number of samples written to
+     * out.
+     */
+    size_t decode_ls3w_registers(const uint64_t* registers, size_t n_registers, int channel_offset, T* out) const
+    {
+        if (d_lut_ls3w.empty())
+            {
+                return 0;
+            }
+        const uint64_t code_mask = d_lut_ls3w.size() - 1;
+        const int first_shift = 64 - d_ls3w_spare_bits - channel_offset - 2 * d_ls3w_quantization;
+        T* o = out;
+        for (size_t r = 0; r < n_registers; r++)
+            {
+                const uint64_t reg = registers[r];
+                for (int i = 0; i < d_ls3w_samples_per_register; i++)
+                    {
+                        *o++ = d_lut_ls3w[(reg >> (first_shift - i * d_ls3w_shift)) & code_mask];
+                    }
+            }
+        return static_cast<size_t>(o - out);
+    }
+
+private:
+    // sign and magnitude bits of LabSat 2 and 3 4-bit samples
+    static int level_4bit(int sign, int magnitude)
+    {
+        if (sign)
+            {
+                return magnitude ? -1 : -2;
+            }
+        return magnitude ? 2 : 1;
+    }
+
+    // sign bit followed by QUA - 1 magnitude bits of LabSat 3 Wideband samples
+    static int level_ls3w(int code, int quantization)
+    {
+        const int levels = 1 << (quantization - 1);
+        const int magnitude = code & (levels - 1);
+        if (code >> (quantization - 1))
+            {
+                return -(levels - magnitude);
+            }
+        return magnitude + 1;
+    }
+
+    static std::complex<float> sample(int i, int q, float scale, std::complex<float>* /*unused*/)
+    {
+        return {static_cast<float>(i) * scale, static_cast<float>(q) * scale};
+    }
+
+    static std::complex<int16_t> sample(int i, int q, float /*scale*/, std::complex<int16_t>* /*unused*/)
+    {
+        return {static_cast<int16_t>(i), static_cast<int16_t>(q)};
+    }
+
+    static std::complex<int8_t> sample(int i, int q, float /*scale*/, std::complex<int8_t>* /*unused*/)
+    {
+        return {static_cast<int8_t>(i), static_cast<int8_t>(q)};
+    }
+
+    static T sample(int i, int q, float scale)
+    {
+        return sample(i, q, scale, static_cast<T*>(nullptr));
+    }
+
+    std::array<std::array<T, 4>, 256> d_lut_2bit{};
+    std::array<std::array<T, 2>, 256> d_lut_4bit{};
+    std::vector<T> d_lut_ls3w;
+    int d_ls3w_quantization{0};
+    int d_ls3w_shift{0};
+    int d_ls3w_spare_bits{0};
+    int d_ls3w_samples_per_register{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_LABSAT_DECODER_H
@@ -34,7 +34,8 @@ SbasL1TelemetryDecoder::SbasL1TelemetryDecoder(
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
     // make telemetry decoder object
-    telemetry_decoder_ = sbas_l1_make_telemetry_decoder_gs(satellite_, dump_);  // TODO fix me
+    const bool compact_input = configuration->property("GNSS-SDR.compact_tracking_records", false);
+    telemetry_decoder_ = sbas_l1_make_telemetry_decoder_gs(satellite_, dump_, compact_input);  // TODO fix me
 
     DLOG(INFO) << "telemetry_decoder(" << telemetry_decoder_->unique_id() << ")";
     if (in_streams_ > 1)
@@ -25,6 +25,7 @@
 #include "display.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include "gnss_synchro.h"
+#include "gnss_tracking_record.h"
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -49,7 +50,7 @@ beidou_b1i_make_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_
 beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
     const Tlm_Conf &conf) : gr::block("beidou_b1i_telemetry_decoder_gs",
-                                gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+                                gr::io_signature::make(1, 1, tracking_item_size(conf.compact_tracking_records)),
                                 gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
                             d_dump_filename(conf.dump_filename),
                             d_sample_counter(0),
@@ -74,6 +75,7 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
                             d_dump_mat(conf.dump_mat),
                             d_remove_dat(conf.remove_dat),
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
+                            d_compact_input(conf.compact_tracking_records),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
     // prevent telemetry symbols accumulation in output buffers
@@ -108,6 +110,8 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols);
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
+    d_preamble_correlator.set_capacity(d_required_symbols);
 
     if (d_dump_crc_stats)
         {
@@ -126,17 +130,9 @@ beidou_b1i_telemetry_decoder_gs::~beidou_b1i_telemetry_decoder_gs()
 {
     DLOG(INFO) << "BeiDou B1I Telemetry decoder block (channel " << d_channel << ") destructor called.";
     size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    if (d_dump_stream)
         {
-            pos = d_dump_file.tellp();
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            pos = d_dump_stream->close();
             if (pos == 0)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -360,7 +356,10 @@ void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satell
 
             d_symbol_duration_ms = BEIDOU_B1I_GEO_TELEMETRY_SYMBOLS_PER_BIT * BEIDOU_B1I_CODE_PERIOD_MS;
             d_required_symbols = BEIDOU_DNAV_SUBFRAME_SYMBOLS + d_samples_per_preamble;
+            d_symbol_history.clear();
             d_symbol_history.set_capacity(d_required_symbols);
+            d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
+            d_preamble_correlator.set_capacity(d_required_symbols);
         }
     else
         {
@@ -384,7 +383,10 @@ void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satell
                 }
 
             d_required_symbols = BEIDOU_DNAV_SUBFRAME_SYMBOLS + d_samples_per_preamble;
+            d_symbol_history.clear();
             d_symbol_history.set_capacity(d_required_symbols);
+            d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
+            d_preamble_correlator.set_capacity(d_required_symbols);
         }
 }
 
@@ -396,19 +398,19 @@ void beidou_b1i_telemetry_decoder_gs::set_channel(int32_t channel)
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_stream)
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    d_dump_stream = Gnss_Sdr_Dump_Writer::instance().open(d_dump_filename, TLM_DUMP_RECORD_SIZE);
+                    if (d_dump_stream)
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
+                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
+                                      << " Log file: " << d_dump_filename;
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << ": exception opening Beidou TLM dump file. " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Cannot open the telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -437,12 +439,12 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);  // Get the output buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = read_tracking_item(input_items[0], 0, d_compact_input);
+    d_preamble_correlator.push(current_symbol.Prompt_I);
     d_symbol_history.push_back(current_symbol.Prompt_I);  // add new symbol to the symbol queue
     d_sample_counter++;                                   // count for the processed samples
     consume_each(1);
@@ -451,17 +453,7 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
     if (d_symbol_history.size() >= d_required_symbols)
         {
             // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                {
-                    if (d_symbol_history[i] < 0)  // symbols clipping
-                        {
-                            corr_value -= d_preamble_samples[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preamble_samples[i];
-                        }
-                }
+            corr_value = d_preamble_correlator.correlation();
         }
     // ******* frame sync ******************
     if (d_stat == 0)  // no preamble information
@@ -644,29 +636,24 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
             current_symbol.TOW_at_current_symbol_ms = d_TOW_at_current_symbol_ms;
             current_symbol.Flag_valid_word = d_flag_valid_word;
 
-            if (d_dump == true)
+            if (d_dump_stream)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            uint64_t tmp_ulong_int;
-                            int32_t tmp_int;
-                            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                            tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                            tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                        }
-                    catch (const std::ifstream::failure &e)
-                        {
-                            LOG(WARNING) << "Exception writing Telemetry GPS L5 dump file " << e.what();
-                        }
+                    double tmp_double;
+                    uint64_t tmp_ulong_int;
+                    int32_t tmp_int;
+                    Gnss_Sdr_Dump_Record<TLM_DUMP_RECORD_SIZE> record;
+                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
+                    record.put(tmp_double);
+                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
+                    record.put(tmp_ulong_int);
+                    tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
+                    record.put(tmp_double);
+                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+                    record.put(tmp_int);
+                    tmp_int = static_cast<int32_t>(current_symbol.PRN);
+                    record.put(tmp_int);
+                    d_dump_stream->append(record.data());
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
@@ -29,9 +29,14 @@
 #include "galileo_has_page.h"        // For Galileo_HAS_page
 #include "galileo_iono.h"            // for Galileo_Iono
 #include "galileo_utc_model.h"       // for Galileo_Utc_Model
+#include "gnss_sdr_async_log.h"         // for GNSS_SDR_DLOG_EVERY_MS
 #include "gnss_sdr_make_unique.h"    // for std::make_unique in C++11
+#include "gnss_sdr_trace.h"
 #include "gnss_synchro.h"            // for Gnss_Synchro
+#include "gnss_tracking_record.h"
+#include "tlm_band_coordinator.h"    // for galileo_tlm_band_coordinator
 #include "tlm_crc_stats.h"           // for Tlm_CRC_Stats
+#include "tlm_decode_pool.h"         // for Tlm_Decode_Pool
 #include "tlm_utils.h"               // for save_tlm_matfile, tlm_remove_file
 #include "viterbi_decoder.h"         // for Viterbi_Decoder
 #include <glog/logging.h>            // for LOG, DLOG
@@ -39,6 +44,7 @@
 #include <pmt/pmt.h>                 // for pmt::make_any
 #include <pmt/pmt_sugar.h>           // for pmt::mp
 #include <array>                     // for std::array
+#include <chrono>                    // for std::chrono::seconds
 #include <cmath>                     // for std::fmod, std::abs
 #include <cstddef>                   // for size_t
 #include <exception>                 // for std::exception
@@ -57,13 +63,15 @@ galileo_make_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Con
 galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
     const Tlm_Conf &conf,
-    int frame_type) : gr::block("galileo_telemetry_decoder_gs", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+    int frame_type) : gr::block("galileo_telemetry_decoder_gs", gr::io_signature::make(1, 1, tracking_item_size(conf.compact_tracking_records)),
                           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
                       d_dump_filename(conf.dump_filename),
+                      d_decode_pool(tlm_decode_pool(conf.decode_threads)),
                       d_delta_t(0),
                       d_sample_counter(0ULL),
                       d_preamble_index(0ULL),
                       d_last_valid_preamble(0),
+                      d_page_sample_counter(0ULL),
                       d_frame_type(frame_type),
                       d_CRC_error_counter(0),
                       d_channel(0),
@@ -83,9 +91,11 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                       d_cnav_dummy_page(false),
                       d_print_cnav_page(true),
                       d_enable_navdata_monitor(conf.enable_navdata_monitor),
+                      d_compact_input(conf.compact_tracking_records),
                       d_dump_crc_stats(conf.dump_crc_stats),
                       d_enable_reed_solomon_inav(false),
-                      d_valid_timetag(false)
+                      d_valid_timetag(false),
+                      d_coordinate_bands(conf.coordinate_bands && (frame_type == 1 || frame_type == 2) && !conf.enable_navdata_monitor && !conf.dump_crc_stats)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -235,6 +245,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols + 1);
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
+    d_preamble_correlator.set_capacity(d_required_symbols + 1);
 
     d_inav_nav.init_PRN(d_satellite.get_PRN());
 
@@ -246,18 +258,15 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
 galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 {
     DLOG(INFO) << "Galileo Telemetry decoder block (channel " << d_channel << ") destructor called.";
+    if (d_page_decoding.valid())
+        {
+            d_page_decoding.wait();
+        }
+    release_satellite();
     size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    if (d_dump_stream)
         {
-            pos = d_dump_file.tellp();
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            pos = d_dump_stream->close();
             if (pos == 0)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -294,6 +303,7 @@ void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, con
 
 void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
 {
+    GNSS_SDR_TRACE_ZONE("telemetry_decode");
     // 1. De-interleave
     std::vector<float> page_part_symbols_soft_value(frame_length);
     deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_soft_value.data());
@@ -381,6 +391,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 }
             this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
             d_first_eph_sent = true;  // do not send reduced CED anymore, since we have the full ephemeris set
+            claim_satellite();
         }
     else
         {
@@ -420,8 +431,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
             this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
-            d_delta_t = tmp_obj->A_0G + tmp_obj->A_1G * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - tmp_obj->t_0G + 604800 * (std::fmod(static_cast<float>(d_inav_nav.get_Galileo_week() - tmp_obj->WN_0G), 64.0)));
-            DLOG(INFO) << "delta_t=" << d_delta_t << "[s]";
+            d_decoded_page.utc_model = tmp_obj;  // delta_t is computed in the sample path
         }
     if (d_inav_nav.have_new_almanac() == true)
         {
@@ -437,7 +447,6 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                     std::cout << "Galileo E5b I/NAV almanac received in channel " << d_channel << " from satellite " << d_satellite << '\n';
                 }
             DLOG(INFO) << "Current parameters:";
-            DLOG(INFO) << "d_TOW_at_current_symbol_ms=" << d_TOW_at_current_symbol_ms;
             DLOG(INFO) << "d_nav.WN_0=" << d_inav_nav.get_Galileo_week();
         }
 }
@@ -445,6 +454,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 
 void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length)
 {
+    GNSS_SDR_TRACE_ZONE("telemetry_decode");
     // 1. De-interleave
     std::vector<float> page_symbols_soft_value(frame_length);
     deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
@@ -500,6 +510,7 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
             const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_fnav_nav.get_ephemeris());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
             this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            claim_satellite();
         }
     if (d_fnav_nav.have_new_iono_and_GST() == true)
         {
@@ -518,6 +529,7 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
 
 void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t page_length)
 {
+    GNSS_SDR_TRACE_ZONE("telemetry_decode");
     // 1. De-interleave
     std::vector<float> page_symbols_soft_value(page_length);
     deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
@@ -585,9 +597,272 @@ void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t
 }
 
 
+void galileo_telemetry_decoder_gs::claim_satellite()
+{
+    if (d_coordinate_bands && galileo_tlm_band_coordinator().claim(d_satellite.get_PRN(), d_channel))
+        {
+            DLOG(INFO) << "Channel " << d_channel << " decodes the navigation data of satellite " << d_satellite;
+        }
+}
+
+
+void galileo_telemetry_decoder_gs::release_satellite()
+{
+    if (d_coordinate_bands)
+        {
+            galileo_tlm_band_coordinator().release(d_satellite.get_PRN(), d_channel);
+        }
+}
+
+
+void galileo_telemetry_decoder_gs::skip_page()
+{
+    // The navigation data of this satellite is decoded in another band: only
+    // the preamble is checked, and the TOW is propagated from the last one
+    const int32_t corr_value = d_preamble_correlator.correlation();
+    d_decoded_page.utc_model = nullptr;
+    d_decoded_page.crc_ok = d_flag_PLL_180_deg_phase_locked ? (corr_value <= -d_samples_per_preamble) : (corr_value >= d_samples_per_preamble);
+    d_decoded_page.cnav_crc_ok = false;
+    d_decoded_page.new_TOW = false;
+}
+
+
+void galileo_telemetry_decoder_gs::decode_page()
+{
+    d_decoded_page.utc_model = nullptr;
+    switch (d_frame_type)
+        {
+        case 1:  // INAV
+            decode_INAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+            break;
+        case 2:  // FNAV
+            decode_FNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+            break;
+        case 3:  // CNAV
+            decode_CNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
+            break;
+        default:
+            break;
+        }
+    d_decoded_page.crc_ok = (d_inav_nav.get_flag_CRC_test() || d_fnav_nav.get_flag_CRC_test() || d_cnav_nav.get_flag_CRC_test());
+    d_decoded_page.cnav_crc_ok = d_cnav_nav.get_flag_CRC_test();
+
+    // read the TOW at the preamble instant, if this page has it
+    d_decoded_page.new_TOW = false;
+    switch (d_frame_type)
+        {
+        case 1:  // INAV
+            {
+                if (d_decoded_page.crc_ok && d_inav_nav.get_flag_TOW_set() == true)
+                    {
+                        // TOW_5, TOW_6 and TOW_0 (pages 5, 6 and 0) refer to the even preamble
+                        if (d_inav_nav.is_TOW5_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW5() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_inav_nav.set_TOW5_flag(false);
+                            }
+                        else if (d_inav_nav.is_TOW6_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW6() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_inav_nav.set_TOW6_flag(false);
+                            }
+                        else if (d_inav_nav.is_TOW0_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW0() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_inav_nav.set_TOW0_flag(false);
+                            }
+                    }
+                d_decoded_page.flag_TOW_set = d_inav_nav.get_flag_TOW_set();
+                d_decoded_page.flag_GGTO = d_inav_nav.get_flag_GGTO();
+                d_decoded_page.A0G = d_inav_nav.get_A0G();
+                d_decoded_page.A1G = d_inav_nav.get_A1G();
+                d_decoded_page.t0G = d_inav_nav.get_t0G();
+                d_decoded_page.WN0G = d_inav_nav.get_WN0G();
+                d_decoded_page.Galileo_week = d_inav_nav.get_Galileo_week();
+                break;
+            }
+        case 2:  // FNAV
+            {
+                if (d_decoded_page.crc_ok && d_fnav_nav.get_flag_TOW_set() == true)
+                    {
+                        if (d_fnav_nav.is_TOW1_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW1() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_fnav_nav.set_TOW1_flag(false);
+                            }
+                        else if (d_fnav_nav.is_TOW2_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW2() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_fnav_nav.set_TOW2_flag(false);
+                            }
+                        else if (d_fnav_nav.is_TOW3_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW3() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_fnav_nav.set_TOW3_flag(false);
+                            }
+                        else if (d_fnav_nav.is_TOW4_set() == true)
+                            {
+                                d_decoded_page.TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW4() * 1000.0);
+                                d_decoded_page.new_TOW = true;
+                                d_fnav_nav.set_TOW4_flag(false);
+                            }
+                    }
+                d_decoded_page.flag_TOW_set = d_fnav_nav.get_flag_TOW_set();
+                break;
+            }
+        default:
+            break;
+        }
+}
+
+
+void galileo_telemetry_decoder_gs::collect_decoded_page(const Gnss_Synchro &current_symbol, bool wait)
+{
+    {
+        gr::thread::scoped_lock lock(d_setlock);
+        if (!d_page_decoding.valid())
+            {
+                return;
+            }
+        if (!wait && d_page_decoding.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                return;
+            }
+        d_page_decoding.get();  // rethrows the exceptions of the decoding, if any
+    }
+    process_decoded_page(current_symbol, d_sample_counter - d_page_sample_counter);
+}
+
+
+void galileo_telemetry_decoder_gs::process_decoded_page(const Gnss_Synchro &current_symbol, uint64_t elapsed_symbols)
+{
+    // elapsed_symbols is the number of symbols received since the page was complete
+    // (0 when it is decoded in the flowgraph thread), which are added to the TOW
+    d_last_page = d_decoded_page;
+    const auto elapsed_ms = static_cast<uint32_t>(elapsed_symbols) * d_PRN_code_period_ms;
+    if (d_last_page.utc_model != nullptr)
+        {
+            const auto &utc = *d_last_page.utc_model;
+            d_delta_t = utc.A_0G + utc.A_1G * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - utc.t_0G + 604800 * (std::fmod(static_cast<float>(d_last_page.Galileo_week - utc.WN_0G), 64.0)));
+            GNSS_SDR_DLOG_EVERY_MS(INFO, 1000) << "delta_t=" << d_delta_t << "[s]";
+        }
+
+    const bool crc_ok = d_last_page.crc_ok;
+    if (d_dump_crc_stats)
+        {
+            // update CRC statistics
+            d_Tlm_CRC_Stats->update_CRC_stats(crc_ok);
+        }
+
+    if (crc_ok)
+        {
+            d_CRC_error_counter = 0;
+            d_flag_preamble = true;  // valid preamble indicator (initialized to false every work())
+            gr::thread::scoped_lock lock(d_setlock);
+            d_last_valid_preamble = d_page_sample_counter;
+            if (!d_flag_frame_sync)
+                {
+                    d_flag_frame_sync = true;
+                    DLOG(INFO) << " Frame sync SAT " << this->d_satellite;
+                }
+        }
+    else
+        {
+            d_CRC_error_counter++;
+            if ((d_CRC_error_counter > CRC_ERROR_LIMIT) && (d_frame_type != 3))
+                {
+                    DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
+                    gr::thread::scoped_lock lock(d_setlock);
+                    d_flag_frame_sync = false;
+                    d_stat = 0;
+                    d_TOW_at_current_symbol_ms = 0;
+                    d_TOW_at_Preamble_ms = 0;
+                    d_fnav_nav.set_flag_TOW_set(false);
+                    d_inav_nav.set_flag_TOW_set(false);
+                    d_last_page.flag_TOW_set = false;
+                    release_satellite();
+                }
+            return;
+        }
+
+    // update TOW at the preamble instant
+    switch (d_frame_type)
+        {
+        case 1:  // INAV
+            {
+                if (d_last_page.flag_TOW_set == true)
+                    {
+                        if (d_last_page.new_TOW == true)
+                            {
+                                // the TOW refers to the even preamble, but when we decode it we are in the odd part, so 1 second later plus the decoding delay
+                                const auto decoder_delay_ms = static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms) + elapsed_ms;
+                                d_TOW_at_Preamble_ms = d_last_page.TOW_at_Preamble_ms;
+                                d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + decoder_delay_ms;
+                                // timetag debug
+                                if (d_valid_timetag == true)
+                                    {
+                                        int rx_tow_at_preamble = d_current_timetag.tow_ms - static_cast<int>(decoder_delay_ms);
+                                        if (rx_tow_at_preamble < 0)
+                                            {
+                                                rx_tow_at_preamble += 604800000;
+                                            }
+                                        uint32_t predicted_tow_at_preamble_ms = 1000 * (rx_tow_at_preamble / 1000);  // floor to integer number of seconds
+                                        std::cout << "TOW at PREAMBLE: " << d_TOW_at_Preamble_ms << " predicted TOW at preamble: " << predicted_tow_at_preamble_ms << " [ms]\n";
+                                    }
+                            }
+                        else
+                            {
+                                // this page has no timing information
+                                d_TOW_at_current_symbol_ms += d_PRN_code_period_ms;
+                            }
+                    }
+                break;
+            }
+        case 2:  // FNAV
+            {
+                if (d_last_page.flag_TOW_set == true)
+                    {
+                        if (d_last_page.new_TOW == true)
+                            {
+                                d_TOW_at_Preamble_ms = d_last_page.TOW_at_Preamble_ms;
+                                d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS) + elapsed_ms;
+                            }
+                        else
+                            {
+                                d_TOW_at_current_symbol_ms += static_cast<uint32_t>(GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
+                            }
+                    }
+                break;
+            }
+        case 3:  // CNAV
+            {
+                // TODO
+            }
+        }
+
+    if ((d_frame_type == 1 || d_frame_type == 2) && d_enable_navdata_monitor && !d_nav_msg_packet.nav_message.empty())
+        {
+            d_nav_msg_packet.system = std::string(1, current_symbol.System);
+            d_nav_msg_packet.signal = std::string(current_symbol.Signal);
+            d_nav_msg_packet.prn = static_cast<int32_t>(current_symbol.PRN);
+            d_nav_msg_packet.tow_at_current_symbol_ms = static_cast<int32_t>(d_TOW_at_current_symbol_ms);
+            const std::shared_ptr<Nav_Message_Packet> tmp_obj = std::make_shared<Nav_Message_Packet>(d_nav_msg_packet);
+            this->message_port_pub(pmt::mp("Nav_msg_from_TLM"), pmt::make_any(tmp_obj));
+            d_nav_msg_packet.nav_message = "";
+        }
+}
+
+
 void galileo_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite)
 {
     gr::thread::scoped_lock lock(d_setlock);
+    release_satellite();
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     d_last_valid_preamble = d_sample_counter;
     d_sent_tlm_failed_msg = false;
@@ -599,15 +874,23 @@ void galileo_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite
 void galileo_telemetry_decoder_gs::reset()
 {
     gr::thread::scoped_lock lock(d_setlock);
+    if (d_page_decoding.valid())
+        {
+            // the page still being decoded is dropped
+            d_page_decoding.wait();
+            d_page_decoding = std::future<void>();
+        }
     d_flag_frame_sync = false;
     d_TOW_at_current_symbol_ms = 0;
     d_TOW_at_Preamble_ms = 0;
     d_fnav_nav.set_flag_TOW_set(false);
     d_inav_nav.set_flag_TOW_set(false);
     d_inav_nav.set_TOW0_flag(false);
+    d_last_page.flag_TOW_set = false;
     d_last_valid_preamble = d_sample_counter;
     d_sent_tlm_failed_msg = false;
     d_stat = 0;
+    release_satellite();
     d_viterbi->reset();
     if (d_enable_reed_solomon_inav == true)
         {
@@ -624,19 +907,19 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_stream)
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    d_dump_stream = Gnss_Sdr_Dump_Writer::instance().open(d_dump_filename, TLM_DUMP_RECORD_SIZE);
+                    if (d_dump_stream)
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
+                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
+                                      << " Log file: " << d_dump_filename;
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Cannot open the telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -653,16 +936,19 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
 int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);  // Get the output buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
-    d_band = current_symbol.Signal[0];
+    current_symbol = read_tracking_item(input_items[0], 0, d_compact_input);
+    if (d_band != current_symbol.Signal[0])
+        {
+            d_band = current_symbol.Signal[0];  // also read by decode_page()
+        }
 
     // add new symbol to the symbol queue
     d_symbol_history.push_back(current_symbol.Prompt_I);
+    d_preamble_correlator.push(current_symbol.Prompt_I);
 
     d_sample_counter++;  // count for the processed symbols
 
@@ -724,6 +1010,12 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 }
         }
 
+    if (d_decode_pool != nullptr)
+        {
+            // apply the page decoded by the pool, if it is done
+            collect_decoded_page(current_symbol, false);
+        }
+
     // ******* frame sync ******************
     switch (d_stat)
         {
@@ -734,17 +1026,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 d_preamble_index = d_sample_counter;  // record the preamble sample stamp
@@ -762,17 +1044,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 // check preamble separation
@@ -808,6 +1080,16 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
             {
                 if (d_sample_counter == d_preamble_index + static_cast<uint64_t>(d_preamble_period_symbols))
                     {
+                        if (d_frame_type < 1 || d_frame_type > 3)
+                            {
+                                return -1;
+                            }
+                        // the previous page has to be done before the navigation message is decoded again
+                        collect_decoded_page(current_symbol, true);
+                        if (d_stat != 2)
+                            {
+                                break;  // frame sync was lost with the previous page
+                            }
                         // call the decoder
                         // NEW Galileo page part is received
                         // 0. fetch the symbols into an array
@@ -825,55 +1107,23 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                         d_page_part_symbols[i] = -d_symbol_history[i + d_samples_per_preamble];  // because last symbol of the preamble is just received now!
                                     }
                             }
-                        switch (d_frame_type)
-                            {
-                            case 1:  // INAV
-                                decode_INAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            case 2:  // FNAV
-                                decode_FNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            case 3:  // CNAV
-                                decode_CNAV_word(d_page_part_symbols.data(), d_frame_length_symbols);
-                                break;
-                            default:
-                                return -1;
-                                break;
-                            }
-                        bool crc_ok = (d_inav_nav.get_flag_CRC_test() || d_fnav_nav.get_flag_CRC_test() || d_cnav_nav.get_flag_CRC_test());
-                        if (d_dump_crc_stats)
+                        d_preamble_index = d_sample_counter;  // record the preamble sample stamp (t_P)
+                        d_page_sample_counter = d_sample_counter;
+                        if (d_coordinate_bands && d_last_page.flag_TOW_set && galileo_tlm_band_coordinator().decoded_elsewhere(d_satellite.get_PRN(), d_channel))
                             {
-                                // update CRC statistics
-                                d_Tlm_CRC_Stats->update_CRC_stats(crc_ok);
+                                skip_page();
+                                process_decoded_page(current_symbol, 0);
                             }
-
-                        d_preamble_index = d_sample_counter;  // record the preamble sample stamp (t_P)
-                        if (crc_ok)
+                        else if (d_decode_pool != nullptr)
                             {
-                                d_CRC_error_counter = 0;
-                                d_flag_preamble = true;  // valid preamble indicator (initialized to false every work())
+                                // the results are applied by a later work() call, adding the symbols received in between to the TOW
                                 gr::thread::scoped_lock lock(d_setlock);
-                                d_last_valid_preamble = d_sample_counter;
-                                if (!d_flag_frame_sync)
-                                    {
-                                        d_flag_frame_sync = true;
-                                        DLOG(INFO) << " Frame sync SAT " << this->d_satellite;
-                                    }
+                                d_page_decoding = d_decode_pool->submit([this]() { decode_page(); });
                             }
                         else
                             {
-                                d_CRC_error_counter++;
-                                if ((d_CRC_error_counter > CRC_ERROR_LIMIT) && (d_frame_type != 3))
-                                    {
-                                        DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
-                                        gr::thread::scoped_lock lock(d_setlock);
-                                        d_flag_frame_sync = false;
-                                        d_stat = 0;
-                                        d_TOW_at_current_symbol_ms = 0;
-                                        d_TOW_at_Preamble_ms = 0;
-                                        d_fnav_nav.set_flag_TOW_set(false);
-                                        d_inav_nav.set_flag_TOW_set(false);
-                                    }
+                                decode_page();
+                                process_decoded_page(current_symbol, 0);
                             }
                     }
                 break;
@@ -882,153 +1132,14 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
 
     // UPDATE GNSS SYNCHRO DATA
     // 2. Add the telemetry decoder information
-    if (this->d_flag_preamble == true)
-        // update TOW at the preamble instant
-        {
-            switch (d_frame_type)
-                {
-                case 1:  // INAV
-                    {
-                        if (d_inav_nav.get_flag_TOW_set() == true)
-                            {
-                                if (d_inav_nav.is_TOW5_set() == true)  // page 5 arrived and decoded, so we are in the odd page (since Tow refers to the even page, we have to add 1 sec)
-                                    {
-                                        // TOW_5 refers to the even preamble, but when we decode it we are in the odd part, so 1 second later plus the decoding delay
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW5() * 1000.0);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                        d_inav_nav.set_TOW5_flag(false);
-                                        // timetag debug
-                                        if (d_valid_timetag == true)
-                                            {
-                                                int decoder_delay_ms = static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                                int rx_tow_at_preamble = d_current_timetag.tow_ms - decoder_delay_ms;
-                                                if (rx_tow_at_preamble < 0)
-                                                    {
-                                                        rx_tow_at_preamble += 604800000;
-                                                    }
-                                                uint32_t predicted_tow_at_preamble_ms = 1000 * (rx_tow_at_preamble / 1000);  // floor to integer number of seconds
-                                                std::cout << "TOW at PREAMBLE: " << d_TOW_at_Preamble_ms << " predicted TOW at preamble: " << predicted_tow_at_preamble_ms << " [ms]\n";
-                                            }
-                                    }
-
-                                else if (d_inav_nav.is_TOW6_set() == true)  // page 6 arrived and decoded, so we are in the odd page (since Tow refers to the even page, we have to add 1 sec)
-                                    {
-                                        // TOW_6 refers to the even preamble, but when we decode it we are in the odd part, so 1 second later plus the decoding delay
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW6() * 1000.0);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                        d_inav_nav.set_TOW6_flag(false);
-                                        // timetag debug
-                                        if (d_valid_timetag == true)
-                                            {
-                                                int decoder_delay_ms = static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                                int rx_tow_at_preamble = d_current_timetag.tow_ms - decoder_delay_ms;
-                                                if (rx_tow_at_preamble < 0)
-                                                    {
-                                                        rx_tow_at_preamble += 604800000;
-                                                    }
-                                                uint32_t predicted_tow_at_preamble_ms = 1000 * (rx_tow_at_preamble / 1000);  // floor to integer number of seconds
-                                                std::cout << "TOW at PREAMBLE: " << d_TOW_at_Preamble_ms << " predicted TOW at preamble: " << predicted_tow_at_preamble_ms << " [ms]\n";
-                                            }
-                                    }
-                                else if (d_inav_nav.is_TOW0_set() == true)  // page 0 arrived and decoded
-                                    {
-                                        // TOW_0 refers to the even preamble, but when we decode it we are in the odd part, so 1 second later plus the decoding delay
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_inav_nav.get_TOW0() * 1000.0);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                        d_inav_nav.set_TOW0_flag(false);
-                                        // timetag debug
-                                        if (d_valid_timetag == true)
-                                            {
-                                                int decoder_delay_ms = static_cast<uint32_t>(GALILEO_INAV_PAGE_PART_MS + (d_required_symbols + 1) * d_PRN_code_period_ms);
-                                                int rx_tow_at_preamble = d_current_timetag.tow_ms - decoder_delay_ms;
-                                                if (rx_tow_at_preamble < 0)
-                                                    {
-                                                        rx_tow_at_preamble += 604800000;
-                                                    }
-                                                uint32_t predicted_tow_at_preamble_ms = 1000 * (rx_tow_at_preamble / 1000);  // floor to integer number of seconds
-                                                std::cout << "TOW at PREAMBLE: " << d_TOW_at_Preamble_ms << " predicted TOW at preamble: " << predicted_tow_at_preamble_ms << " [ms]\n";
-                                            }
-                                    }
-                                else
-                                    {
-                                        // this page has no timing information
-                                        d_TOW_at_current_symbol_ms += d_PRN_code_period_ms;
-                                    }
-                            }
-                        if (d_enable_navdata_monitor && !d_nav_msg_packet.nav_message.empty())
-                            {
-                                d_nav_msg_packet.system = std::string(1, current_symbol.System);
-                                d_nav_msg_packet.signal = std::string(current_symbol.Signal);
-                                d_nav_msg_packet.prn = static_cast<int32_t>(current_symbol.PRN);
-                                d_nav_msg_packet.tow_at_current_symbol_ms = static_cast<int32_t>(d_TOW_at_current_symbol_ms);
-                                const std::shared_ptr<Nav_Message_Packet> tmp_obj = std::make_shared<Nav_Message_Packet>(d_nav_msg_packet);
-                                this->message_port_pub(pmt::mp("Nav_msg_from_TLM"), pmt::make_any(tmp_obj));
-                                d_nav_msg_packet.nav_message = "";
-                            }
-                        break;
-                    }
-                case 2:  // FNAV
-                    {
-                        if (d_fnav_nav.get_flag_TOW_set() == true)
-                            {
-                                if (d_fnav_nav.is_TOW1_set() == true)
-                                    {
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW1() * 1000.0);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
-                                        // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
-                                        d_fnav_nav.set_TOW1_flag(false);
-                                    }
-                                else if (d_fnav_nav.is_TOW2_set() == true)
-                                    {
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW2() * 1000.0);
-                                        // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
-                                        d_fnav_nav.set_TOW2_flag(false);
-                                    }
-                                else if (d_fnav_nav.is_TOW3_set() == true)
-                                    {
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW3() * 1000.0);
-                                        // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
-                                        d_fnav_nav.set_TOW3_flag(false);
-                                    }
-                                else if (d_fnav_nav.is_TOW4_set() == true)
-                                    {
-                                        d_TOW_at_Preamble_ms = static_cast<uint32_t>(d_fnav_nav.get_TOW4() * 1000.0);
-                                        // d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((GALILEO_FNAV_CODES_PER_PAGE + GALILEO_FNAV_CODES_PER_PREAMBLE) * GALILEO_E5a_CODE_PERIOD_MS);
-                                        d_TOW_at_current_symbol_ms = d_TOW_at_Preamble_ms + static_cast<uint32_t>((d_required_symbols + 1) * GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
-                                        d_fnav_nav.set_TOW4_flag(false);
-                                    }
-                                else
-                                    {
-                                        d_TOW_at_current_symbol_ms += static_cast<uint32_t>(GALILEO_FNAV_CODES_PER_SYMBOL * GALILEO_E5A_CODE_PERIOD_MS);
-                                    }
-                            }
-                        if (d_enable_navdata_monitor && !d_nav_msg_packet.nav_message.empty())
-                            {
-                                d_nav_msg_packet.system = std::string(1, current_symbol.System);
-                                d_nav_msg_packet.signal = std::string(current_symbol.Signal);
-                                d_nav_msg_packet.prn = static_cast<int32_t>(current_symbol.PRN);
-                                d_nav_msg_packet.tow_at_current_symbol_ms = static_cast<int32_t>(d_TOW_at_current_symbol_ms);
-                                const std::shared_ptr<Nav_Message_Packet> tmp_obj = std::make_shared<Nav_Message_Packet>(d_nav_msg_packet);
-                                this->message_port_pub(pmt::mp("Nav_msg_from_TLM"), pmt::make_any(tmp_obj));
-                                d_nav_msg_packet.nav_message = "";
-                            }
-                        break;
-                    }
-                case 3:  // CNAV
-                    {
-                        // TODO
-                    }
-                }
-        }
-    else  // if there is not a new preamble, we define the TOW of the current symbol
+    // (the TOW at the preamble instant is updated by process_decoded_page())
+    if (this->d_flag_preamble == false)  // if there is not a new preamble, we define the TOW of the current symbol
         {
             switch (d_frame_type)
                 {
                 case 1:  // INAV
                     {
-                        if (d_inav_nav.get_flag_TOW_set() == true)
+                        if (d_last_page.flag_TOW_set == true)
                             {
                                 d_TOW_at_current_symbol_ms += d_PRN_code_period_ms;
                             }
@@ -1036,7 +1147,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                     }
                 case 2:  // FNAV
                     {
-                        if (d_fnav_nav.get_flag_TOW_set() == true)
+                        if (d_last_page.flag_TOW_set == true)
                             {
                                 d_TOW_at_current_symbol_ms += d_PRN_code_period_ms;
                             }
@@ -1055,11 +1166,11 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
         {
         case 1:  // INAV
             {
-                if (d_inav_nav.get_flag_TOW_set() == true)
+                if (d_last_page.flag_TOW_set == true)
                     {
-                        if (d_inav_nav.get_flag_GGTO() == true)  // all GGTO parameters arrived
+                        if (d_last_page.flag_GGTO == true)  // all GGTO parameters arrived
                             {
-                                d_delta_t = d_inav_nav.get_A0G() + d_inav_nav.get_A1G() * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - d_inav_nav.get_t0G() + 604800.0 * (std::fmod(static_cast<float>(d_inav_nav.get_Galileo_week() - d_inav_nav.get_WN0G()), 64.0)));
+                                d_delta_t = d_last_page.A0G + d_last_page.A1G * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - d_last_page.t0G + 604800.0 * (std::fmod(static_cast<float>(d_last_page.Galileo_week - d_last_page.WN0G), 64.0)));
                             }
 
                         current_symbol.Flag_valid_word = true;
@@ -1069,7 +1180,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
 
         case 2:  // FNAV
             {
-                if (d_fnav_nav.get_flag_TOW_set() == true)
+                if (d_last_page.flag_TOW_set == true)
                     {
                         current_symbol.Flag_valid_word = true;
                     }
@@ -1082,7 +1193,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
             }
         }
 
-    if (d_inav_nav.get_flag_TOW_set() == true || d_fnav_nav.get_flag_TOW_set() == true || d_cnav_nav.get_flag_CRC_test() == true)
+    if (d_last_page.flag_TOW_set == true || d_last_page.cnav_crc_ok == true)
         {
             current_symbol.TOW_at_current_symbol_ms = d_TOW_at_current_symbol_ms;
             // todo: Galileo to GPS time conversion should be moved to observable block.
@@ -1099,43 +1210,38 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                     current_symbol.Flag_PLL_180_deg_phase_locked = false;
                 }
 
-            if (d_dump == true)
+            if (d_dump_stream)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            uint64_t tmp_ulong_int;
-                            int32_t tmp_int;
-                            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                            tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            switch (d_frame_type)
-                                {
-                                case 1:
-                                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                                    break;
-                                case 2:
-                                    tmp_int = (current_symbol.Prompt_Q > 0.0 ? 1 : -1);
-                                    break;
-                                case 3:
-                                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                                    break;
-                                default:
-                                    tmp_int = 0;
-                                    break;
-                                }
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                            tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                        }
-                    catch (const std::ifstream::failure &e)
+                    double tmp_double;
+                    uint64_t tmp_ulong_int;
+                    int32_t tmp_int;
+                    Gnss_Sdr_Dump_Record<TLM_DUMP_RECORD_SIZE> record;
+                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
+                    record.put(tmp_double);
+                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
+                    record.put(tmp_ulong_int);
+                    tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
+                    record.put(tmp_double);
+                    switch (d_frame_type)
                         {
-                            LOG(WARNING) << "Exception writing navigation data dump file " << e.what();
+                        case 1:
+                            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+                            break;
+                        case 2:
+                            tmp_int = (current_symbol.Prompt_Q > 0.0 ? 1 : -1);
+                            break;
+                        case 3:
+                            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+                            break;
+                        default:
+                            tmp_int = 0;
+                            break;
                         }
+                    record.put(tmp_int);
+                    tmp_int = static_cast<int32_t>(current_symbol.PRN);
+                    record.put(tmp_int);
+                    d_dump_stream->append(record.data());
                 }
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
             *out[0] = current_symbol;
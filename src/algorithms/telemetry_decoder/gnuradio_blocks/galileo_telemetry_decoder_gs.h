@@ -26,15 +26,17 @@
 #include "galileo_inav_message.h"     // for Galileo_Inav_Message
 #include "gnss_block_interface.h"     // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
 #include "gnss_satellite.h"           // for Gnss_Satellite
+#include "gnss_sdr_dump_writer.h"     // for Gnss_Sdr_Dump_Stream
 #include "gnss_time.h"                // for GnssTime
 #include "nav_message_packet.h"       // for Nav_Message_Packet
 #include "tlm_conf.h"                 // for Tlm_Conf
+#include "tlm_preamble_correlator.h"  // for Tlm_Preamble_Correlator
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
 #include <gnuradio/block.h>           // for block
 #include <gnuradio/types.h>           // for gr_vector_const_void_star
 #include <cstdint>                    // for int32_t, uint32_t
-#include <fstream>                    // for std::ofstream
-#include <memory>                     // for std::unique_ptr
+#include <future>                     // for std::future
+#include <memory>                     // for std::unique_ptr, std::shared_ptr
 #include <string>                     // for std::string
 #include <vector>                     // for std::vector
 
@@ -45,6 +47,9 @@
 
 class Viterbi_Decoder;               // forward declaration
 class Tlm_CRC_Stats;                 // forward declaration
+class Tlm_Decode_Pool;               // forward declaration
+class Galileo_Utc_Model;             // forward declaration
+class Gnss_Synchro;                  // forward declaration
 class galileo_telemetry_decoder_gs;  // forward declaration
 
 using galileo_telemetry_decoder_gs_sptr = gnss_shared_ptr<galileo_telemetry_decoder_gs>;
@@ -84,15 +89,41 @@ private:
     void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
     void decode_FNAV_word(float *page_symbols, int32_t frame_length);
     void decode_CNAV_word(float *page_symbols, int32_t page_length);
+    void decode_page();
+    void process_decoded_page(const Gnss_Synchro &current_symbol, uint64_t elapsed_symbols);
+    void collect_decoded_page(const Gnss_Synchro &current_symbol, bool wait);
+    void skip_page();
+    void claim_satellite();
+    void release_satellite();
+
+    // What the sample path needs from a decoded page. It is written by
+    // decode_page(), which may run in a Tlm_Decode_Pool thread, and read once
+    // the decoding has finished.
+    struct Decoded_Page
+    {
+        std::shared_ptr<Galileo_Utc_Model> utc_model;
+        double A0G{0.0};
+        double A1G{0.0};
+        double t0G{0.0};
+        double WN0G{0.0};
+        int32_t Galileo_week{0};
+        uint32_t TOW_at_Preamble_ms{0};
+        bool crc_ok{false};
+        bool new_TOW{false};
+        bool flag_TOW_set{false};
+        bool flag_GGTO{false};
+        bool cnav_crc_ok{false};
+    };
 
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
     std::vector<int32_t> d_preamble_samples;
     std::vector<float> d_page_part_symbols;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
 
     boost::circular_buffer<float> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     Gnss_Satellite d_satellite;
 
@@ -106,11 +137,17 @@ private:
 
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
+    Tlm_Decode_Pool *d_decode_pool;
+    std::future<void> d_page_decoding;
+    Decoded_Page d_decoded_page;
+    Decoded_Page d_last_page;
+
     double d_delta_t;  // GPS-GALILEO time offset
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
     uint64_t d_last_valid_preamble;
+    uint64_t d_page_sample_counter;  // d_sample_counter when the page being decoded was complete
 
     int32_t d_mm;
     int32_t d_codelength;
@@ -144,9 +181,11 @@ private:
     bool d_cnav_dummy_page;
     bool d_print_cnav_page;
     bool d_enable_navdata_monitor;
+    bool d_compact_input;
     bool d_dump_crc_stats;
     bool d_enable_reed_solomon_inav;
     bool d_valid_timetag;
+    bool d_coordinate_bands;  // skip the pages of a satellite decoded in another band
 };
 
 
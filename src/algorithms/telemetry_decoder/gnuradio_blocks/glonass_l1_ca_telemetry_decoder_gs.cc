@@ -21,6 +21,7 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include "gnss_tracking_record.h"
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -45,7 +46,7 @@ glonass_l1_ca_make_telemetry_decoder_gs(const Gnss_Satellite &satellite, const T
 
 glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
-    const Tlm_Conf &conf) : gr::block("glonass_l1_ca_telemetry_decoder_gs", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+    const Tlm_Conf &conf) : gr::block("glonass_l1_ca_telemetry_decoder_gs", gr::io_signature::make(1, 1, tracking_item_size(conf.compact_tracking_records)),
                                 gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
                             d_dump_filename(conf.dump_filename),
                             d_preamble_time_samples(0),
@@ -61,6 +62,7 @@ glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
                             d_dump_mat(conf.dump_mat),
                             d_remove_dat(conf.remove_dat),
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
+                            d_compact_input(conf.compact_tracking_records),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
     // prevent telemetry symbols accumulation in output buffers
@@ -100,6 +102,8 @@ glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(GLONASS_GNAV_STRING_SYMBOLS);
+    d_preamble_correlator.set_preamble(d_preambles_symbols.data(), d_symbols_per_preamble);
+    d_preamble_correlator.set_capacity(GLONASS_GNAV_STRING_SYMBOLS);
 
     if (d_dump_crc_stats)
         {
@@ -118,17 +122,9 @@ glonass_l1_ca_telemetry_decoder_gs::~glonass_l1_ca_telemetry_decoder_gs()
 {
     DLOG(INFO) << "Glonass L1 Telemetry decoder block (channel " << d_channel << ") destructor called.";
     size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    if (d_dump_stream)
         {
-            pos = d_dump_file.tellp();
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            pos = d_dump_stream->close();
             if (pos == 0)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -282,19 +278,19 @@ void glonass_l1_ca_telemetry_decoder_gs::set_channel(int32_t channel)
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_stream)
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    d_dump_stream = Gnss_Sdr_Dump_Writer::instance().open(d_dump_filename, TLM_DUMP_RECORD_SIZE);
+                    if (d_dump_stream)
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
+                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
+                                      << " Log file: " << d_dump_filename;
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << ": exception opening Glonass TLM dump file. " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Cannot open the telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -313,12 +309,12 @@ int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);  // Get the output buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = read_tracking_item(input_items[0], 0, d_compact_input);
+    d_preamble_correlator.push(current_symbol.Prompt_I);
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
     d_sample_counter++;                          // count for the processed samples
     consume_each(1);
@@ -328,17 +324,7 @@ int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
     if (static_cast<int32_t>(d_symbol_history.size()) >= d_symbols_per_preamble)
         {
             // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_symbols_per_preamble; i++)
-                {
-                    if (d_symbol_history[i].Prompt_I < 0.0)  // symbols clipping
-                        {
-                            corr_value -= d_preambles_symbols[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preambles_symbols[i];
-                        }
-                }
+            corr_value = d_preamble_correlator.correlation();
         }
 
     // ******* frame sync ******************
@@ -474,29 +460,24 @@ int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
     // todo: glonass time to gps time should be done in observables block
     // current_symbol.TOW_at_current_symbol_ms -= -= static_cast<uint32_t>(delta_t) * 1000;  // Galileo to GPS TOW
 
-    if (d_dump == true)
+    if (d_dump_stream)
         {
             // MULTIPLEXED FILE RECORDING - Record results to file
-            try
-                {
-                    double tmp_double;
-                    uint64_t tmp_ulong_int;
-                    int32_t tmp_int;
-                    tmp_double = d_TOW_at_current_symbol;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                    tmp_double = 0;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                    tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                }
+            double tmp_double;
+            uint64_t tmp_ulong_int;
+            int32_t tmp_int;
+            Gnss_Sdr_Dump_Record<TLM_DUMP_RECORD_SIZE> record;
+            tmp_double = d_TOW_at_current_symbol;
+            record.put(tmp_double);
+            tmp_ulong_int = current_symbol.Tracking_sample_counter;
+            record.put(tmp_ulong_int);
+            tmp_double = 0;
+            record.put(tmp_double);
+            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+            record.put(tmp_int);
+            tmp_int = static_cast<int32_t>(current_symbol.PRN);
+            record.put(tmp_int);
+            d_dump_stream->append(record.data());
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
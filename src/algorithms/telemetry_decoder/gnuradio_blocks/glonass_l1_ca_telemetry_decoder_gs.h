@@ -23,16 +23,17 @@
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump_writer.h"
 #include "gnss_synchro.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>
 #include <cstdint>
-#include <fstream>  // for ofstream
 #include <memory>   // for std::unique_ptr
 #include <string>
 
@@ -90,6 +91,7 @@ private:
 
     // Storage for incoming data
     boost::circular_buffer<Gnss_Synchro> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     // Navigation Message variable
     Glonass_Gnav_Navigation_Message d_nav;
@@ -100,7 +102,7 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
 
     double d_preamble_time_samples;
     double d_TOW_at_current_symbol;
@@ -119,6 +121,7 @@ private:
     bool d_dump_mat;
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
+    bool d_compact_input;
     bool d_dump_crc_stats;
 };
 
@@ -22,16 +22,17 @@
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump_writer.h"
 #include "gnss_synchro.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>
 #include <cstdint>
-#include <fstream>
 #include <memory>  // for std::unique_ptr
 #include <string>
 
@@ -83,6 +84,7 @@ private:
 
     // Storage for incoming data
     boost::circular_buffer<Gnss_Synchro> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     std::array<int32_t, GLONASS_GNAV_PREAMBLE_LENGTH_SYMBOLS> d_preambles_symbols{};
 
@@ -94,7 +96,7 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
 
     double d_preamble_time_samples;
     double d_TOW_at_current_symbol;
@@ -112,6 +114,7 @@ private:
     bool d_dump_mat;
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
+    bool d_compact_input;
     bool d_dump_crc_stats;
 };
 
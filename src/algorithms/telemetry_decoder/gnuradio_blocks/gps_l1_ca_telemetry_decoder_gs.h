@@ -19,18 +19,19 @@
 #include "GPS_L1_CA.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump_writer.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
 #include "gps_navigation_message.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>             // for array
 #include <cstdint>           // for int32_t
-#include <fstream>           // for ofstream
 #include <memory>            // for std::unique_ptr
 #include <string>            // for string
 
@@ -84,9 +85,10 @@ private:
     std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
 
     boost::circular_buffer<float> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
@@ -114,6 +116,7 @@ private:
     bool d_dump_mat;
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
+    bool d_compact_input;
     bool d_dump_crc_stats;
 };
 
@@ -20,6 +20,7 @@
 #include "display.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include "gnss_synchro.h"
+#include "gnss_tracking_record.h"
 #include "gps_cnav_ephemeris.h"  // for Gps_CNAV_Ephemeris
 #include "gps_cnav_iono.h"       // for Gps_CNAV_Iono
 #include "gps_cnav_utc_model.h"  // for Gps_CNAV_Utc_Model
@@ -46,7 +47,7 @@ gps_l2c_make_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Con
 gps_l2c_telemetry_decoder_gs::gps_l2c_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
     const Tlm_Conf &conf) : gr::block("gps_l2c_telemetry_decoder_gs",
-                                gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+                                gr::io_signature::make(1, 1, tracking_item_size(conf.compact_tracking_records)),
                                 gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
                             d_dump_filename(conf.dump_filename),
                             d_TOW_at_current_symbol(0),
@@ -61,6 +62,7 @@ gps_l2c_telemetry_decoder_gs::gps_l2c_telemetry_decoder_gs(
                             d_dump_mat(conf.dump_mat),
                             d_remove_dat(conf.remove_dat),
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
+                            d_compact_input(conf.compact_tracking_records),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
     // prevent telemetry symbols accumulation in output buffers
@@ -103,17 +105,9 @@ gps_l2c_telemetry_decoder_gs::~gps_l2c_telemetry_decoder_gs()
 {
     DLOG(INFO) << "GPS L2C Telemetry decoder block (channel " << d_channel << ") destructor called.";
     size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    if (d_dump_stream)
         {
-            pos = d_dump_file.tellp();
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            pos = d_dump_stream->close();
             if (pos == 0)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -150,20 +144,19 @@ void gps_l2c_telemetry_decoder_gs::set_channel(int channel)
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_stream)
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    d_dump_stream = Gnss_Sdr_Dump_Writer::instance().open(d_dump_filename, TLM_DUMP_RECORD_SIZE);
+                    if (d_dump_stream)
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
-                                      << " Log file: " << d_dump_filename.c_str();
+                                      << " Log file: " << d_dump_filename;
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening Telemetry GPS L2 dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Cannot open the telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -188,15 +181,17 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);  // Get the output buffer pointer
+
+    // 1. Copy the current tracking output
+    Gnss_Synchro current_synchro_data = read_tracking_item(input_items[0], 0, d_compact_input);
 
     bool flag_new_cnav_frame = false;
     cnav_msg_t msg;
     uint32_t delay = 0;
 
     // add the symbol to the decoder
-    const uint8_t symbol_clip = static_cast<uint8_t>(in[0].Prompt_I > 0) * 255;
+    const uint8_t symbol_clip = static_cast<uint8_t>(current_synchro_data.Prompt_I > 0) * 255;
     flag_new_cnav_frame = cnav_msg_decoder_add_symbol(&d_cnav_decoder, symbol_clip, &msg, &delay);
     if (d_dump_crc_stats && (d_cnav_decoder.part1.message_lock || d_cnav_decoder.part2.message_lock))
         {
@@ -221,11 +216,6 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
         }
 
     // UPDATE GNSS SYNCHRO DATA
-    Gnss_Synchro current_synchro_data{};  // structure to save the synchronization information and send the output object to the next block
-
-    // 1. Copy the current tracking output
-    current_synchro_data = in[0];
-
     // 2. Add the telemetry decoder information
     // check if new CNAV frame is available
     if (flag_new_cnav_frame == true)
@@ -317,29 +307,24 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
     current_synchro_data.TOW_at_current_symbol_ms = round(d_TOW_at_current_symbol * 1000.0);
     current_synchro_data.Flag_valid_word = d_flag_valid_word;
 
-    if (d_dump == true)
+    if (d_dump_stream)
         {
             // MULTIPLEXED FILE RECORDING - Record results to file
-            try
-                {
-                    double tmp_double;
-                    uint64_t tmp_ulong_int;
-                    int32_t tmp_int;
-                    tmp_double = d_TOW_at_current_symbol;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_ulong_int = current_synchro_data.Tracking_sample_counter;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                    tmp_double = d_TOW_at_Preamble;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_int = (current_synchro_data.Prompt_I > 0.0 ? 1 : -1);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                    tmp_int = static_cast<int32_t>(current_synchro_data.PRN);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing Telemetry GPS L2 dump file " << e.what();
-                }
+            double tmp_double;
+            uint64_t tmp_ulong_int;
+            int32_t tmp_int;
+            Gnss_Sdr_Dump_Record<TLM_DUMP_RECORD_SIZE> record;
+            tmp_double = d_TOW_at_current_symbol;
+            record.put(tmp_double);
+            tmp_ulong_int = current_synchro_data.Tracking_sample_counter;
+            record.put(tmp_ulong_int);
+            tmp_double = d_TOW_at_Preamble;
+            record.put(tmp_double);
+            tmp_int = (current_synchro_data.Prompt_I > 0.0 ? 1 : -1);
+            record.put(tmp_int);
+            tmp_int = static_cast<int32_t>(current_synchro_data.PRN);
+            record.put(tmp_int);
+            d_dump_stream->append(record.data());
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
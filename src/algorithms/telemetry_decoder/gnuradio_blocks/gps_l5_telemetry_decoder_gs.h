@@ -20,6 +20,7 @@
 #include "GPS_L5.h"  // for GPS_L5I_NH_CODE_LENGTH
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"               // for Gnss_Satellite
+#include "gnss_sdr_dump_writer.h"         // for Gnss_Sdr_Dump_Stream
 #include "gps_cnav_navigation_message.h"  // for Gps_CNAV_Navigation_Message
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -28,7 +29,6 @@
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <memory>  // for std::unique_ptr
 #include <string>
 
@@ -82,7 +82,7 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::shared_ptr<Gnss_Sdr_Dump_Stream> d_dump_stream;
 
     uint64_t d_sample_counter;
     uint64_t d_last_valid_preamble;
@@ -100,6 +100,7 @@ private:
     bool d_dump_mat;
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
+    bool d_compact_input;
     bool d_dump_crc_stats;
 };
 
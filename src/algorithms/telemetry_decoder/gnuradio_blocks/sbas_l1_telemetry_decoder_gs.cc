@@ -16,6 +16,7 @@
 
 #include "sbas_l1_telemetry_decoder_gs.h"
 #include "gnss_synchro.h"
+#include "gnss_tracking_record.h"
 #include "viterbi_decoder_sbas.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -35,20 +36,23 @@
 
 sbas_l1_telemetry_decoder_gs_sptr sbas_l1_make_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
-    bool dump)
+    bool dump,
+    bool compact_input)
 {
-    return sbas_l1_telemetry_decoder_gs_sptr(new sbas_l1_telemetry_decoder_gs(satellite, dump));
+    return sbas_l1_telemetry_decoder_gs_sptr(new sbas_l1_telemetry_decoder_gs(satellite, dump, compact_input));
 }
 
 
 sbas_l1_telemetry_decoder_gs::sbas_l1_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
-    bool dump) : gr::block("sbas_l1_telemetry_decoder_gs",
-                     gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
-                     gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
-                 d_dump(dump),
-                 d_channel(0),
-                 d_block_size(D_SAMPLES_PER_SYMBOL * D_SYMBOLS_PER_BIT * D_BLOCK_SIZE_IN_BITS)
+    bool dump,
+    bool compact_input) : gr::block("sbas_l1_telemetry_decoder_gs",
+                              gr::io_signature::make(1, 1, tracking_item_size(compact_input)),
+                              gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+                          d_dump(dump),
+                          d_compact_input(compact_input),
+                          d_channel(0),
+                          d_block_size(D_SAMPLES_PER_SYMBOL * D_SYMBOLS_PER_BIT * D_BLOCK_SIZE_IN_BITS)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -401,17 +405,16 @@ int sbas_l1_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
     VLOG(FLOW) << "general_work(): "
                << "noutput_items=" << noutput_items << "\toutput_items real size=" << output_items.size() << "\tninput_items size=" << ninput_items.size() << "\tinput_items real size=" << input_items.size() << "\tninput_items[0]=" << ninput_items[0];
     // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);  // Get the output buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0];
+    current_symbol = read_tracking_item(input_items[0], 0, d_compact_input);
     // copy correlation samples into samples vector
     d_sample_buf.push_back(current_symbol.Prompt_I);  // add new symbol to the symbol queue
 
     // store the time stamp of the first sample in the processed sample block
-    const double sample_stamp = static_cast<double>(in[0].Tracking_sample_counter) / static_cast<double>(in[0].fs);
+    const double sample_stamp = static_cast<double>(current_symbol.Tracking_sample_counter) / static_cast<double>(current_symbol.fs);
 
     // decode only if enough samples in buffer
     if (d_sample_buf.size() >= d_block_size)
@@ -45,7 +45,8 @@ using sbas_l1_telemetry_decoder_gs_sptr = gnss_shared_ptr<sbas_l1_telemetry_deco
 
 sbas_l1_telemetry_decoder_gs_sptr sbas_l1_make_telemetry_decoder_gs(
     const Gnss_Satellite &satellite,
-    bool dump);
+    bool dump,
+    bool compact_input = false);
 
 /*!
  * \brief This class implements a block that decodes the SBAS integrity and
@@ -68,9 +69,10 @@ public:
 private:
     friend sbas_l1_telemetry_decoder_gs_sptr sbas_l1_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
-        bool dump);
+        bool dump,
+        bool compact_input);
 
-    sbas_l1_telemetry_decoder_gs(const Gnss_Satellite &satellite, bool dump);
+    sbas_l1_telemetry_decoder_gs(const Gnss_Satellite &satellite, bool dump, bool compact_input);
 
     void viterbi_decoder(double *page_part_symbols, int32_t *page_part_bits);
     void align_samples();
@@ -80,6 +82,7 @@ private:
     static const int32_t D_BLOCK_SIZE_IN_BITS = 30;
 
     bool d_dump;
+    bool d_compact_input;  // input items are Gnss_Tracking_Record
     Gnss_Satellite d_satellite;
     int32_t d_channel;
 
@@ -0,0 +1,66 @@
+/*!
+ * \file tlm_band_coordinator.cc
+ * \brief Selects, for each satellite, the telemetry decoder that decodes its
+ * navigation data when it is tracked in several bands
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_band_coordinator.h"
+
+
+Tlm_Band_Coordinator::Tlm_Band_Coordinator()
+{
+    for (auto &channel : d_channels)
+        {
+            channel.store(NO_CHANNEL, std::memory_order_relaxed);
+        }
+}
+
+
+bool Tlm_Band_Coordinator::claim(uint32_t prn, int32_t channel)
+{
+    if (prn >= MAX_PRN)
+        {
+            return false;
+        }
+    int32_t expected = NO_CHANNEL;
+    return d_channels[prn].compare_exchange_strong(expected, channel, std::memory_order_acq_rel) || expected == channel;
+}
+
+
+void Tlm_Band_Coordinator::release(uint32_t prn, int32_t channel)
+{
+    if (prn >= MAX_PRN)
+        {
+            return;
+        }
+    int32_t expected = channel;
+    d_channels[prn].compare_exchange_strong(expected, NO_CHANNEL, std::memory_order_acq_rel);
+}
+
+
+bool Tlm_Band_Coordinator::decoded_elsewhere(uint32_t prn, int32_t channel) const
+{
+    if (prn >= MAX_PRN)
+        {
+            return false;
+        }
+    const int32_t owner = d_channels[prn].load(std::memory_order_acquire);
+    return owner != NO_CHANNEL && owner != channel;
+}
+
+
+Tlm_Band_Coordinator &galileo_tlm_band_coordinator()
+{
+    static Tlm_Band_Coordinator coordinator;
+    return coordinator;
+}
@@ -0,0 +1,78 @@
+/*!
+ * \file tlm_band_coordinator.h
+ * \brief Selects, for each satellite, the telemetry decoder that decodes its
+ * navigation data when it is tracked in several bands
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_BAND_COORDINATOR_H
+#define GNSS_SDR_TLM_BAND_COORDINATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps, for each PRN, the channel whose telemetry decoder decodes the
+ * navigation data of that satellite.
+ *
+ * A decoder claims its satellite once it has sent a complete ephemeris. The
+ * decoders of the same satellite in the other bands, once they know the TOW,
+ * only check the preamble of each page and propagate the TOW, until the
+ * claiming decoder releases the satellite (reset, new satellite or loss of
+ * frame sync). Each call is a single atomic operation, so it can be made
+ * from the decoding threads.
+ */
+class Tlm_Band_Coordinator
+{
+public:
+    Tlm_Band_Coordinator();
+
+    /*!
+     * \brief The decoder of channel decodes the navigation data of prn, if
+     * no other does. Returns true if it does.
+     */
+    bool claim(uint32_t prn, int32_t channel);
+
+    /*!
+     * \brief Ends the claim of channel on prn, if it has it
+     */
+    void release(uint32_t prn, int32_t channel);
+
+    /*!
+     * \brief True if the navigation data of prn is decoded by the decoder of
+     * another channel
+     */
+    bool decoded_elsewhere(uint32_t prn, int32_t channel) const;
+
+private:
+    static constexpr int32_t NO_CHANNEL = -1;
+    static constexpr uint32_t MAX_PRN = 64;
+    std::array<std::atomic<int32_t>, MAX_PRN> d_channels;
+};
+
+
+/*!
+ * \brief Returns the coordinator shared by the Galileo telemetry decoders
+ */
+Tlm_Band_Coordinator &galileo_tlm_band_coordinator();
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_BAND_COORDINATOR_H
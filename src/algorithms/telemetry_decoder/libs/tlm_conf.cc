@@ -30,4 +30,7 @@ void Tlm_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     const std::string default_crc_stats_dumpname("telemetry_crc_stats");
     dump_crc_stats_filename = configuration->property(role + ".dump_crc_stats_filename", default_crc_stats_dumpname);
     enable_navdata_monitor = configuration->property("NavDataMonitor.enable_monitor", false);
+    compact_tracking_records = configuration->property("GNSS-SDR.compact_tracking_records", false);
+    decode_threads = configuration->property("GNSS-SDR.telemetry_decode_threads", decode_threads);
+    coordinate_bands = configuration->property("GNSS-SDR.telemetry_coordinate_bands", coordinate_bands);
 }
@@ -19,6 +19,7 @@
 #define GNSS_SDR_TLM_CONF_H
 
 #include "configuration_interface.h"
+#include <cstdint>
 #include <string>
 
 /** \addtogroup Telemetry_Decoder
@@ -42,6 +43,9 @@ public:
     bool enable_reed_solomon{false};  // for INAV message in Galileo E1B
     bool dump_crc_stats{false};       // telemetry CRC statistics
     bool enable_navdata_monitor{false};
+    bool compact_tracking_records{false};  // input items are Gnss_Tracking_Record
+    uint32_t decode_threads{0};            // pages decoded out of the flowgraph thread if > 0
+    bool coordinate_bands{false};          // navigation data of a satellite decoded in one band only
 };
 
 
@@ -0,0 +1,85 @@
+/*!
+ * \file tlm_decode_pool.cc
+ * \brief Worker threads that decode navigation message pages out of the
+ * flowgraph thread of the telemetry decoders
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_decode_pool.h"
+#include <utility>  // for std::move
+
+
+Tlm_Decode_Pool::Tlm_Decode_Pool(uint32_t threads)
+{
+    for (uint32_t i = 0; i < threads; i++)
+        {
+            d_threads.emplace_back(&Tlm_Decode_Pool::run, this);
+        }
+}
+
+
+Tlm_Decode_Pool::~Tlm_Decode_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    for (auto &thread : d_threads)
+        {
+            thread.join();
+        }
+}
+
+
+std::future<void> Tlm_Decode_Pool::submit(std::function<void()> job)
+{
+    std::packaged_task<void()> task(std::move(job));
+    std::future<void> result = task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_jobs.push_back(std::move(task));
+    }
+    d_cond.notify_one();
+    return result;
+}
+
+
+void Tlm_Decode_Pool::run()
+{
+    while (true)
+        {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop || !d_jobs.empty(); });
+                if (d_jobs.empty())
+                    {
+                        return;  // stopped, and nothing left to do
+                    }
+                task = std::move(d_jobs.front());
+                d_jobs.pop_front();
+            }
+            task();
+        }
+}
+
+
+Tlm_Decode_Pool *tlm_decode_pool(uint32_t threads)
+{
+    if (threads == 0)
+        {
+            return nullptr;
+        }
+    static Tlm_Decode_Pool pool(threads);
+    return &pool;
+}
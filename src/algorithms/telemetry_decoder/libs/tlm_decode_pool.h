@@ -0,0 +1,76 @@
+/*!
+ * \file tlm_decode_pool.h
+ * \brief Worker threads that decode navigation message pages out of the
+ * flowgraph thread of the telemetry decoders
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_DECODE_POOL_H
+#define GNSS_SDR_TLM_DECODE_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Runs decoding jobs (deinterleaving, Viterbi, CRC and Reed-Solomon of
+ * a complete page) on a fixed set of threads.
+ *
+ * Jobs are run in submission order, but jobs of different decoders may run
+ * at the same time. A decoder must not submit a new job before the previous
+ * one has finished, since its navigation message state is not shared.
+ * Exceptions thrown by a job are rethrown by the get() of its future.
+ */
+class Tlm_Decode_Pool
+{
+public:
+    explicit Tlm_Decode_Pool(uint32_t threads);
+    ~Tlm_Decode_Pool();
+
+    Tlm_Decode_Pool(const Tlm_Decode_Pool &) = delete;
+    Tlm_Decode_Pool &operator=(const Tlm_Decode_Pool &) = delete;
+
+    std::future<void> submit(std::function<void()> job);
+
+private:
+    void run();
+
+    std::deque<std::packaged_task<void()>> d_jobs;
+    std::vector<std::thread> d_threads;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    bool d_stop{false};
+};
+
+
+/*!
+ * \brief Returns the pool shared by all the telemetry decoders, which is
+ * started with the given number of threads on first use, or nullptr if
+ * threads is 0 (pages are decoded in the flowgraph thread).
+ */
+Tlm_Decode_Pool *tlm_decode_pool(uint32_t threads);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_DECODE_POOL_H
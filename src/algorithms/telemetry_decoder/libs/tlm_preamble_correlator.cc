@@ -0,0 +1,118 @@
+/*!
+ * \file tlm_preamble_correlator.cc
+ * \brief Incremental correlation of the symbol history with a preamble
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_preamble_correlator.h"
+#include <algorithm>  // for std::fill
+#include <bitset>     // for std::bitset
+
+
+void Tlm_Preamble_Correlator::set_preamble(const int32_t *preamble, int32_t length)
+{
+    d_preamble_length = length > 0 ? static_cast<uint32_t>(length) : 0;
+    d_preamble_signs = std::vector<uint64_t>((d_preamble_length + 63) / 64, 0);
+    d_window_signs = std::vector<uint64_t>(d_preamble_signs.size(), 0);
+    for (uint32_t i = 0; i < d_preamble_length; i++)
+        {
+            if (preamble[i] < 0)
+                {
+                    d_preamble_signs[i / 64] |= uint64_t(1) << (i % 64);
+                }
+        }
+    clear();
+}
+
+
+void Tlm_Preamble_Correlator::set_capacity(uint32_t capacity)
+{
+    d_capacity = capacity;
+    d_history_signs = std::vector<uint64_t>((d_capacity + 63) / 64, 0);
+    clear();
+}
+
+
+void Tlm_Preamble_Correlator::clear()
+{
+    std::fill(d_window_signs.begin(), d_window_signs.end(), 0);
+    d_size = 0;
+    d_write_pos = 0;
+}
+
+
+bool Tlm_Preamble_Correlator::sign_at(uint32_t pos) const
+{
+    return (d_history_signs[pos / 64] >> (pos % 64)) & 1U;
+}
+
+
+void Tlm_Preamble_Correlator::push(double symbol)
+{
+    if (d_capacity == 0)
+        {
+            return;
+        }
+    const uint64_t bit = uint64_t(1) << (d_write_pos % 64);
+    if (symbol < 0.0)  // symbols clipping
+        {
+            d_history_signs[d_write_pos / 64] |= bit;
+        }
+    else
+        {
+            d_history_signs[d_write_pos / 64] &= ~bit;
+        }
+
+    if (d_size < d_capacity)
+        {
+            // the oldest symbols stay in place until the history is full
+            if (d_size < d_preamble_length)
+                {
+                    d_window_signs[d_size / 64] |= static_cast<uint64_t>(symbol < 0.0) << (d_size % 64);
+                }
+            d_size++;
+        }
+    else if (d_preamble_length > 0 && d_preamble_length <= d_capacity)
+        {
+            // the oldest symbol is dropped, the window slides by one
+            const size_t words = d_window_signs.size();
+            for (size_t k = 0; k + 1 < words; k++)
+                {
+                    d_window_signs[k] = (d_window_signs[k] >> 1) | (d_window_signs[k + 1] << 63);
+                }
+            d_window_signs[words - 1] >>= 1;
+            uint32_t pos = d_write_pos + d_preamble_length;
+            if (pos >= d_capacity)
+                {
+                    pos -= d_capacity;
+                }
+            const uint32_t last = d_preamble_length - 1;
+            d_window_signs[last / 64] |= static_cast<uint64_t>(sign_at(pos)) << (last % 64);
+        }
+
+    d_write_pos++;
+    if (d_write_pos == d_capacity)
+        {
+            d_write_pos = 0;
+        }
+}
+
+
+int32_t Tlm_Preamble_Correlator::correlation() const
+{
+    uint32_t mismatches = 0;
+    for (size_t k = 0; k < d_window_signs.size(); k++)
+        {
+            mismatches += static_cast<uint32_t>(std::bitset<64>(d_window_signs[k] ^ d_preamble_signs[k]).count());
+        }
+    return static_cast<int32_t>(d_preamble_length) - 2 * static_cast<int32_t>(mismatches);
+}
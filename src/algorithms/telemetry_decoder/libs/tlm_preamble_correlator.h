@@ -0,0 +1,92 @@
+/*!
+ * \file tlm_preamble_correlator.h
+ * \brief Incremental correlation of the symbol history with a preamble
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+#define GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps the correlation of a preamble with the oldest symbols of the
+ * telemetry decoders symbol history (a boost::circular_buffer of a given
+ * capacity) up to date as symbols are pushed.
+ *
+ * The signs of the symbols are bit-packed, so each push costs a shift of the
+ * preamble window and the correlation is an XOR and a popcount, instead of a
+ * loop over the preamble length. The result is exactly that of the hard
+ * decision loop:
+ *
+ *   for (i = 0; i < preamble_length; i++)
+ *       corr += (history[i] < 0) ? -preamble[i] : preamble[i];
+ *
+ * with preamble samples of +1 or -1. It is only meaningful once
+ * preamble_length symbols have been pushed.
+ */
+class Tlm_Preamble_Correlator
+{
+public:
+    Tlm_Preamble_Correlator() = default;
+
+    /*!
+     * \brief Sets the preamble samples (+1 or -1) and clears the history
+     */
+    void set_preamble(const int32_t *preamble, int32_t length);
+
+    /*!
+     * \brief Sets the capacity of the mirrored symbol history and clears it
+     */
+    void set_capacity(uint32_t capacity);
+
+    void clear();
+
+    /*!
+     * \brief Adds a symbol, as done with push_back in the symbol history
+     */
+    void push(double symbol);
+
+    /*!
+     * \brief Correlation of the preamble with the oldest symbols of the history
+     */
+    int32_t correlation() const;
+
+    inline uint32_t size() const
+    {
+        return d_size;
+    }
+
+private:
+    bool sign_at(uint32_t pos) const;
+
+    std::vector<uint64_t> d_preamble_signs;  // bit i set if preamble[i] < 0
+    std::vector<uint64_t> d_window_signs;    // bit i set if history[i] < 0
+    std::vector<uint64_t> d_history_signs;   // ring with the signs of the whole history
+    uint32_t d_preamble_length{0};
+    uint32_t d_capacity{0};
+    uint32_t d_size{0};
+    uint32_t d_write_pos{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
@@ -17,6 +17,8 @@
 #ifndef GNSS_SDR_TLM_UTILS_H
 #define GNSS_SDR_TLM_UTILS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 /** \addtogroup Telemetry_Decoder
@@ -24,6 +26,13 @@
 /** \addtogroup Telemetry_Decoder_libs
  * \{ */
 
+/*!
+ * \brief Size of a record of the telemetry decoder dump files: TOW at the
+ * current symbol, tracking sample counter, TOW at the preamble, navigation
+ * symbol and PRN
+ */
+constexpr size_t TLM_DUMP_RECORD_SIZE = sizeof(uint64_t) + 2 * sizeof(double) + 2 * sizeof(int32_t);
+
 int save_tlm_matfile(const std::string &dumpfile);
 
 bool tlm_remove_file(const std::string &file_to_remove);
@@ -15,8 +15,8 @@
  */
 
 #include "viterbi_decoder.h"
-#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u
-#include <algorithm>                    // for std::copy
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u, volk_gnsssdr_32f_viterbi27_acs_8u
+#include <algorithm>                    // for std::copy, std::fill
 
 Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     int32_t nn,
@@ -41,11 +41,29 @@ Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     d_state1 = std::vector<int32_t>(d_states);
     nsc_transit(d_out0, d_state0, 0);
     nsc_transit(d_out1, d_state1, 1);
+
+    // The SIMD butterflies need the first and last taps of both polynomials
+    // set, as in all the K=7 codes used by GNSS signals
+    d_use_acs_kernel = (d_KK == 7) and (d_nn == 2) and ((d_g[0] & d_g[1] & 0x41) == 0x41);
+    if (d_use_acs_kernel)
+        {
+            d_decisions = std::vector<uint8_t>(d_states * (d_LL + d_mm));
+            for (int32_t j = 0; j < d_states / 2; j++)
+                {
+                    d_branch_outputs[j] = static_cast<uint8_t>(d_out0[2 * j]);
+                }
+        }
 }
 
 
 void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
 {
+    if (d_use_acs_kernel)
+        {
+            decode_k7(output_u_int, input_c);
+            return;
+        }
+
     int32_t i;
     int32_t t;
     int32_t state;
@@ -58,7 +76,7 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
     // go through trellis
     for (t = 0; t < d_LL + d_mm; t++)
         {
-            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + (d_nn - 1), d_rec_array.begin());
+            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * (t + 1), d_rec_array.begin());
 
             // precompute all possible branch metrics
             for (i = 0; i < d_number_symbols; i++)
@@ -120,6 +138,29 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
 }
 
 
+void Viterbi_Decoder::decode_k7(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
+{
+    // start in all-zeros state
+    std::fill(d_prev_section.begin(), d_prev_section.end(), -d_MAXLOG);
+    d_prev_section[0] = 0.0;
+
+    volk_gnsssdr_32f_viterbi27_acs_8u(d_decisions.data(), d_prev_section.data(), input_c.data(), d_branch_outputs.data(), d_LL + d_mm);
+
+    // trace-back operation, from the all-zeros state reached by the tail.
+    // The survivor of state s comes from state 2 * (s % 32) + decision, and
+    // its info bit is the most significant bit of s.
+    int32_t state = 0;
+    for (int32_t t = d_LL + d_mm - 1; t >= 0; t--)
+        {
+            if (t < d_LL)
+                {
+                    output_u_int[t] = state >> (d_mm - 1);
+                }
+            state = ((state & (d_states / 2 - 1)) << 1) | d_decisions[t * d_states + state];
+        }
+}
+
+
 void Viterbi_Decoder::reset()
 {
     d_out0 = std::vector<int32_t>(d_states);
@@ -57,6 +57,12 @@ public:
     void reset();
 
 private:
+    /*
+     * Forward pass and trace-back for the K=7, rate 1/2 codes, with the
+     * add-compare-select steps done by a SIMD kernel
+     */
+    void decode_k7(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c);
+
     /*
      * Function that creates the transit and output vectors
      */
@@ -115,6 +121,9 @@ private:
     std::vector<int32_t> d_state0;
     std::vector<int32_t> d_state1;
 
+    std::vector<uint8_t> d_decisions;           // survivor decisions of decode_k7()
+    std::array<uint8_t, 32> d_branch_outputs{};  // encoder output of each butterfly, for decode_k7()
+
     float d_MAXLOG = 1e7;  // Define infinity
     int32_t d_KK{};
     int32_t d_nn{};
@@ -123,6 +132,7 @@ private:
     int32_t d_mm{};
     int32_t d_states{};
     int32_t d_number_symbols{};
+    bool d_use_acs_kernel{false};
 };
 
 /** \} */
@@ -17,7 +17,8 @@
 
 #include "viterbi_decoder_sbas.h"
 #include <glog/logging.h>
-#include <algorithm>  // for fill_n
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for fill_n, transform
 #include <ostream>    // for operator<<, basic_ostream, char_traits
 
 // logging
@@ -39,6 +40,9 @@ Viterbi_Decoder_Sbas::Viterbi_Decoder_Sbas(const int g_encoder[],
               d_number_symbols(static_cast<int>(1U << nn)),  // 2^nn
               d_trellis_state_is_initialised(false)
 {
+    // The SIMD butterflies need the first and last taps of both polynomials set
+    d_use_acs_kernel = (KK == 7) and (nn == 2) and ((g_encoder[0] & g_encoder[1] & 0x41) == 0x41);
+
     /* create appropriate transition matrices (trellis) */
     d_out0 = std::vector<int>(d_states);
     d_out1 = std::vector<int>(d_states);
@@ -47,6 +51,13 @@ Viterbi_Decoder_Sbas::Viterbi_Decoder_Sbas(const int g_encoder[],
 
     nsc_transit(d_out0.data(), d_state0.data(), 0, g_encoder, d_KK, d_nn);
     nsc_transit(d_out1.data(), d_state1.data(), 1, g_encoder, d_KK, d_nn);
+    if (d_use_acs_kernel)
+        {
+            for (int j = 0; j < d_states / 2; j++)
+                {
+                    d_branch_outputs[j] = static_cast<uint8_t>(d_out0[2 * j]);
+                }
+        }
 
     // initialise trellis state
     Viterbi_Decoder_Sbas::init_trellis_state();
@@ -147,6 +158,12 @@ int Viterbi_Decoder_Sbas::do_acs(const double sym[], int nbits)
     int state_at_t;
     float metric;
     float max_val;
+
+    if (d_use_acs_kernel)
+        {
+            return do_acs_k7(sym, nbits);
+        }
+
     std::vector<float> pm_t_next(d_states);
 
     /* t:
@@ -236,6 +253,48 @@ int Viterbi_Decoder_Sbas::do_acs(const double sym[], int nbits)
 }
 
 
+int Viterbi_Decoder_Sbas::do_acs_k7(const double sym[], int nbits)
+{
+    int t;
+    int i;
+
+    d_acs_symbols.resize(d_nn * nbits);
+    d_acs_decisions.resize(d_states * nbits);
+    std::transform(sym, sym + d_nn * nbits, d_acs_symbols.begin(), [](double s) { return static_cast<float>(s); });
+
+    // The kernel metrics are the same correlations computed by gamma(), but
+    // normalized to the metric of state 0 instead of the largest one
+    volk_gnsssdr_32f_viterbi27_acs_8u(d_acs_decisions.data(), d_pm_t.data(), d_acs_symbols.data(), d_branch_outputs.data(), nbits);
+
+    for (t = 0; t < nbits; t++)
+        {
+            for (i = 0; i < d_nn; i++)
+                {
+                    d_rec_array[i] = d_acs_symbols[d_nn * t + i];
+                }
+            for (i = 0; i < d_number_symbols; i++)
+                {
+                    d_metric_c[i] = gamma(d_rec_array.data(), i, d_nn);
+                }
+
+            // survivor of state s at t+1 comes from state 2 * (s % 32) + decision
+            const uint8_t* decisions = &d_acs_decisions[d_states * t];
+            Prev next_trellis_states(d_states, t + 1);
+            for (int next_state = 0; next_state < d_states; next_state++)
+                {
+                    const int bit = next_state >> (d_mm - 1);
+                    const int state_at_t = ((next_state & (d_states / 2 - 1)) << 1) | decisions[next_state];
+                    next_trellis_states.set_current_state_as_ancestor_of_next_state(next_state, state_at_t);
+                    next_trellis_states.set_decoded_bit_for_next_state(next_state, bit);
+                    next_trellis_states.set_survivor_branch_metric_of_next_state(next_state, d_metric_c[bit == 0 ? d_out0[state_at_t] : d_out1[state_at_t]]);
+                }
+            d_trellis_paths.push_front(next_trellis_states);
+        }
+
+    return t;
+}
+
+
 int Viterbi_Decoder_Sbas::do_traceback(size_t traceback_length)
 {
     // traceback_length is in bits
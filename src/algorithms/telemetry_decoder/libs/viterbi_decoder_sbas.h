@@ -18,7 +18,9 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_SBAS_H
 #define GNSS_SDR_VITERBI_DECODER_SBAS_H
 
+#include <array>
 #include <cstddef>  // for size_t
+#include <cstdint>
 #include <deque>
 #include <vector>
 
@@ -80,6 +82,7 @@ private:
     // operations on the trellis (change decoder state)
     void init_trellis_state();
     int do_acs(const double sym[], int nbits);
+    int do_acs_k7(const double sym[], int nbits);
     int do_traceback(std::size_t traceback_length);
     int do_tb_and_decode(int traceback_length, int requested_decoding_length, int state, int output_u_int[], float& indicator_metric);
 
@@ -103,6 +106,12 @@ private:
     std::vector<int> d_out1;
     std::vector<int> d_state1;
 
+    // K=7, rate 1/2 codes, decoded with a SIMD add-compare-select kernel
+    std::vector<float> d_acs_symbols;
+    std::vector<uint8_t> d_acs_decisions;
+    std::array<uint8_t, 32> d_branch_outputs{};
+    bool d_use_acs_kernel;
+
     // measures
     float d_indicator_metric;
 
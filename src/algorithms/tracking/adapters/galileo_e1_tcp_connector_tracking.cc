@@ -53,6 +53,7 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
     float early_late_space_chips = configuration->property(role + ".early_late_space_chips", static_cast<float>(0.15));
     float very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", static_cast<float>(0.5));
     size_t port_ch0 = configuration->property(role + ".port_ch0", 2060);
+    bool batched_loop = configuration->property(role + ".batched_loop", false);
     const std::string default_dump_filename("./track_ch");
     std::string dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     const auto vector_length = static_cast<int>(std::round(fs_in / (GALILEO_E1_CODE_CHIP_RATE_CPS / GALILEO_E1_B_CODE_LENGTH_CHIPS)));
@@ -70,7 +71,8 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
                 dll_bw_hz,
                 early_late_space_chips,
                 very_early_late_space_chips,
-                port_ch0);
+                port_ch0,
+                batched_loop);
         }
     else
         {
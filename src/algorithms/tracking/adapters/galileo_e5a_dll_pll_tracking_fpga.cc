@@ -60,6 +60,7 @@ GalileoE5aDllPllTrackingFpga::GalileoE5aDllPllTrackingFpga(
 
     // UIO device file
     device_name = configuration->property(role + ".devicename", default_device_name_Galileo_E5a);
+    result_ring_device_name = trk_params_fpga.result_ring_device_name;
 
     // compute the number of tracking channels that have already been instantiated. The order in which
     // GNSS-SDR instantiates the tracking channels i L1, L2, L5, E1, E5a
@@ -220,6 +221,18 @@ void GalileoE5aDllPllTrackingFpga::set_channel(unsigned int channel)
             throw std::exception();
         }
     tracking_fpga_sc->set_channel(channel, device_io_name);
+
+    // ring shared by all the channels, if the FPGA delivers the results in batches
+    if (!result_ring_device_name.empty())
+        {
+            std::string result_ring_io_name;
+            if (find_uio_dev_file_name(result_ring_io_name, result_ring_device_name, 0) < 0)
+                {
+                    std::cout << "Cannot find the FPGA uio device file corresponding to device name " << result_ring_device_name << std::endl;
+                    throw std::exception();
+                }
+            tracking_fpga_sc->set_result_ring(result_ring_io_name);
+        }
 }
 
 
@@ -51,6 +51,12 @@ GlonassL1CaDllPllTracking::GlonassL1CaDllPllTracking(
             dll_bw_hz = static_cast<float>(FLAGS_dll_bw_hz);
         }
     float early_late_space_chips = configuration->property(role + ".early_late_space_chips", static_cast<float>(0.5));
+    // decimation of the slot channelizer shared by the channels, 1 to correlate at the input rate
+    int fdma_decimation = configuration->property(role + ".fdma_decimation", 1);
+    if (fdma_decimation > 1 and fs_in / fdma_decimation < 2 * GLONASS_L1_CA_CODE_RATE_CPS)
+        {
+            LOG(WARNING) << role << ".fdma_decimation=" << fdma_decimation << " leaves less than two samples per chip";
+        }
     const std::string default_dump_filename("./track_ch");
     std::string dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     const auto vector_length = static_cast<int>(std::round(fs_in / (GLONASS_L1_CA_CODE_RATE_CPS / GLONASS_L1_CA_CODE_LENGTH_CHIPS)));
@@ -66,7 +72,8 @@ GlonassL1CaDllPllTracking::GlonassL1CaDllPllTracking(
                 dump_filename,
                 pll_bw_hz,
                 dll_bw_hz,
-                early_late_space_chips);
+                early_late_space_chips,
+                fdma_decimation);
         }
     else
         {
@@ -0,0 +1,103 @@
+/*!
+ * \file glonass_l1_ca_dll_pll_veml_tracking.h
+ * \brief  Interface of an adapter of a DLL+PLL tracking loop block
+ * for GLONASS L1 C/A to a TrackingInterface
+ *
+ * Based on the GPS L1 C/A adapter, with the frequency channel of the
+ * satellite removed by the carrier NCO of the tracking block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GLONASS_L1_CA_DLL_PLL_VEML_TRACKING_H
+#define GNSS_SDR_GLONASS_L1_CA_DLL_PLL_VEML_TRACKING_H
+
+#include "dll_pll_veml_tracking.h"
+#include "tracking_interface.h"
+#include <string>
+
+/** \addtogroup Tracking
+ * Classes for GNSS signal tracking.
+ * \{ */
+/** \addtogroup Tracking_adapters tracking_adapters
+ * Wrap GNU Radio blocks for GNSS signal tracking with a TrackingInterface
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class implements a code DLL + carrier PLL tracking loop for
+ * GLONASS L1 C/A on the dll_pll_veml_tracking block
+ */
+class GlonassL1CaDllPllVemlTracking : public TrackingInterface
+{
+public:
+    GlonassL1CaDllPllVemlTracking(
+        const ConfigurationInterface* configuration,
+        const std::string& role,
+        unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~GlonassL1CaDllPllVemlTracking() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "GLONASS_L1_CA_DLL_PLL_VEML_Tracking"
+    inline std::string implementation() override
+    {
+        return "GLONASS_L1_CA_DLL_PLL_VEML_Tracking";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    /*!
+     * \brief Set tracking channel unique ID
+     */
+    void set_channel(unsigned int channel) override;
+
+    /*!
+     * \brief Set acquisition/tracking common Gnss_Synchro object pointer
+     * to efficiently exchange synchronization data between acquisition and tracking blocks
+     */
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro) override;
+
+    void start_tracking() override;
+
+    /*!
+     * \brief Stop running tracking
+     */
+    void stop_tracking() override;
+
+private:
+    dll_pll_veml_tracking_sptr tracking_;
+    size_t item_size_;
+    unsigned int channel_;
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GLONASS_L1_CA_DLL_PLL_VEML_TRACKING_H
@@ -0,0 +1,141 @@
+/*!
+ * \file glonass_l2_ca_dll_pll_veml_tracking.cc
+ * \brief Implementation of an adapter of a DLL+PLL tracking loop block
+ * for GLONASS L2 C/A to a TrackingInterface
+ *
+ * Based on the GPS L1 C/A adapter, with the frequency channel of the
+ * satellite removed by the carrier NCO of the tracking block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "glonass_l2_ca_dll_pll_veml_tracking.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "configuration_interface.h"
+#include "display.h"
+#include "dll_pll_conf.h"
+#include "gnss_sdr_flags.h"
+#include <glog/logging.h>
+#include <array>
+#include <cstring>
+
+GlonassL2CaDllPllVemlTracking::GlonassL2CaDllPllVemlTracking(
+    const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    Dll_Pll_Conf trk_params = Dll_Pll_Conf();
+    DLOG(INFO) << "role " << role;
+    trk_params.SetFromConfiguration(configuration, role);
+
+    const auto vector_length = static_cast<int>(std::round(trk_params.fs_in / (GLONASS_L2_CA_CODE_RATE_CPS / GLONASS_L2_CA_CODE_LENGTH_CHIPS)));
+    trk_params.vector_length = vector_length;
+    if (trk_params.extend_correlation_symbols != 1)
+        {
+            // the 10 ms symbols of GLONASS are not synchronized by the tracking block
+            trk_params.extend_correlation_symbols = 1;
+            std::cout << TEXT_RED << "WARNING: GLONASS L2 C/A. Extended coherent integration is not available. Coherent integration has been set to 1 symbol (1 ms)" << TEXT_RESET << '\n';
+        }
+    trk_params.track_pilot = configuration->property(role + ".track_pilot", false);
+    if (trk_params.track_pilot)
+        {
+            trk_params.track_pilot = false;
+            std::cout << TEXT_RED << "WARNING: GLONASS L2 C/A does not have pilot signal. Data tracking has been enabled" << TEXT_RESET << '\n';
+        }
+
+    trk_params.system = 'R';
+    const std::array<char, 3> sig_{'2', 'G', '\0'};
+    std::memcpy(trk_params.signal, sig_.data(), 3);
+
+    // ################# Make a GNU Radio Tracking block object ################
+    if (trk_params.item_type == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
+    else
+        {
+            item_size_ = 0;
+            LOG(WARNING) << trk_params.item_type << " unknown tracking item type.";
+        }
+    channel_ = 0;
+    DLOG(INFO) << "tracking(" << tracking_->unique_id() << ")";
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void GlonassL2CaDllPllVemlTracking::stop_tracking()
+{
+    tracking_->stop_tracking();
+}
+
+
+void GlonassL2CaDllPllVemlTracking::start_tracking()
+{
+    tracking_->start_tracking();
+}
+
+
+/*
+ * Set tracking channel unique ID
+ */
+void GlonassL2CaDllPllVemlTracking::set_channel(unsigned int channel)
+{
+    channel_ = channel;
+    tracking_->set_channel(channel);
+}
+
+
+void GlonassL2CaDllPllVemlTracking::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+{
+    tracking_->set_gnss_synchro(p_gnss_synchro);
+}
+
+
+void GlonassL2CaDllPllVemlTracking::connect(gr::top_block_sptr top_block)
+{
+    if (top_block)
+        { /* top_block is not null */
+        };
+    // nothing to connect, now the tracking uses gr_sync_decimator
+}
+
+
+void GlonassL2CaDllPllVemlTracking::disconnect(gr::top_block_sptr top_block)
+{
+    if (top_block)
+        { /* top_block is not null */
+        };
+    // nothing to disconnect, now the tracking uses gr_sync_decimator
+}
+
+
+gr::basic_block_sptr GlonassL2CaDllPllVemlTracking::get_left_block()
+{
+    return tracking_;
+}
+
+
+gr::basic_block_sptr GlonassL2CaDllPllVemlTracking::get_right_block()
+{
+    return tracking_;
+}
@@ -42,6 +42,7 @@ GpsL1CaTcpConnectorTracking::GpsL1CaTcpConnectorTracking(
     bool dump = configuration->property(role + ".dump", false);
     float early_late_space_chips = configuration->property(role + ".early_late_space_chips", static_cast<float>(0.5));
     size_t port_ch0 = configuration->property(role + ".port_ch0", 2060);
+    bool batched_loop = configuration->property(role + ".batched_loop", false);
     const std::string default_dump_filename("./track_ch");
     std::string dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     const auto vector_length = static_cast<int>(std::round(fs_in / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
@@ -56,7 +57,8 @@ GpsL1CaTcpConnectorTracking::GpsL1CaTcpConnectorTracking(
                 dump,
                 dump_filename,
                 early_late_space_chips,
-                port_ch0);
+                port_ch0,
+                batched_loop);
         }
     else
         {
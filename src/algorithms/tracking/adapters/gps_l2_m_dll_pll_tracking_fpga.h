@@ -95,6 +95,7 @@ private:
     const std::string default_device_name_GPS_L2 = "multicorrelator_resampler_S00_AXI";  // UIO device name
 
     std::string device_name;
+    std::string result_ring_device_name;
     uint32_t num_prev_assigned_ch;
 
     static const uint32_t NUM_PRNs = 32;
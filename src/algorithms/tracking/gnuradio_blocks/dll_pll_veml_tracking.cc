@@ -23,6 +23,7 @@
 #include "dll_pll_veml_tracking.h"
 #include "Beidou_B1I.h"
 #include "Beidou_B3I.h"
+#include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "GPS_L2C.h"
 #include "GPS_L5.h"
@@ -31,15 +32,24 @@
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
 #include "MATH_CONSTANTS.h"
+#include "allocation_counter.h"
 #include "beidou_b1i_signal_replica.h"
 #include "beidou_b3i_signal_replica.h"
 #include "galileo_e1_signal_replica.h"
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_async_log.h"
+#include "gnss_sdr_block_stats.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_device_scheduler.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_sample_gap.h"
+#include "gnss_sdr_trace.h"
 #include "gnss_synchro.h"
+#include "gnss_tracking_record.h"
+#include "glonass_l1_signal_replica.h"
+#include "glonass_l2_signal_replica.h"
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
@@ -51,9 +61,10 @@
 #include <matio.h>                   // for Mat_VarCreate
 #include <pmt/pmt_sugar.h>           // for mp
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n
+#include <algorithm>  // for fill_n, transform
 #include <array>
 #include <cmath>      // for fmod, round, floor
+#include <cstring>    // for memcpy
 #include <exception>  // for exception
 #include <iostream>   // for cout, cerr
 #include <map>
@@ -74,6 +85,21 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
+namespace
+{
+// Size of the records of the dump file, see log_data() and save_matfile()
+const size_t DUMP_RECORD_BYTES = 19 * sizeof(float) + sizeof(uint64_t) + sizeof(double) + sizeof(uint32_t);
+
+
+template <typename T>
+char *append_to_record(char *field, T value)
+{
+    std::memcpy(field, &value, sizeof(T));
+    return field + sizeof(T);
+}
+}  // namespace
+
+
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 {
     return dll_pll_veml_tracking_sptr(new dll_pll_veml_tracking(conf_));
@@ -81,8 +107,8 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 
 
 dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
-    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, conf_.item_type == "cshort" ? sizeof(lv_16sc_t) : sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, tracking_item_size(conf_.compact_output))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
       d_code_chip_rate(0.0),
@@ -91,6 +117,8 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_current_correlation_time_s(0.0),
       d_carrier_doppler_hz(0.0),
       d_acc_carrier_phase_rad(0.0),
+      d_carrier_offset_hz(0.0),
+      d_carrier_offset_step_rad(0.0),
       d_rem_code_phase_chips(0.0),
       d_T_chip_seconds(0.0),
       d_T_prn_seconds(0.0),
@@ -105,16 +133,24 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_code_phase_rate_step_chips(0.0),
       d_rem_code_phase_samples(0.0),  // Residual code phase (in chips)
       d_acq_sample_stamp(0ULL),
+      d_gap_samples(0ULL),
+      d_gap_counted_end(0ULL),
+      d_gap_symbol_counter(0.0),
+      d_gap_symbol_samples(0.0),
       d_rem_carr_phase_rad(0.0),  // Residual carrier phase
       d_state(0),                 // initial state: standby
+      d_first_correlator_tap(0),
       d_current_prn_length_samples(static_cast<int32_t>(d_trk_parameters.vector_length)),
       d_extend_correlation_symbols_count(0),
-      d_cn0_estimation_counter(0),
       d_carrier_lock_fail_counter(0),
       d_code_lock_fail_counter(0),
+      d_gap_skip_samples(0),
+      d_gap_symbols(0),
       d_channel(0),
       d_secondary_code_length(0U),
       d_data_secondary_code_length(0U),
+      d_secondary_sync_shift(0U),
+      d_use_16sc(d_trk_parameters.item_type == "cshort"),
       d_pull_in_transitory(true),
       d_corrected_doppler(false),
       d_interchange_iq(false),
@@ -123,13 +159,22 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_dump(d_trk_parameters.dump),
       d_dump_mat(d_trk_parameters.dump_mat && d_dump),
       d_acc_carrier_phase_initialized(false),
-      d_Flag_PLL_180_deg_phase_locked(false)
+      d_strong_signal_mode(false),
+      d_Flag_PLL_180_deg_phase_locked(false),
+      d_dump_paused(false)
 {
+    d_work_stats = Gnss_Block_Stats_Registry::instance().make(unique_id());
+
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
 
+    d_events_port = pmt::mp("events");
+    d_loss_of_lock_event = pmt::from_long(3);  // 3 -> loss of lock
+    d_timetag_key = pmt::mp("timetag");
+    d_tags_vec.reserve(16);
+
     // Telemetry bit synchronization message port input
-    this->message_port_register_out(pmt::mp("events"));
+    this->message_port_register_out(d_events_port);
     this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length));
 
     // Telemetry message port input
@@ -383,6 +428,54 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
                     d_symbols_per_bit = 0;
                 }
         }
+    else if (d_trk_parameters.system == 'R')
+        {
+            d_systemName = "Glonass";
+            if (d_signal_type == "1G")
+                {
+                    // carrier of frequency channel 0, set for the satellite in start_tracking()
+                    d_signal_carrier_freq = GLONASS_L1_CA_FREQ_HZ;
+                    d_code_period = GLONASS_L1_CA_CODE_PERIOD_S;
+                    d_code_chip_rate = GLONASS_L1_CA_CODE_RATE_CPS;
+                    d_code_length_chips = static_cast<int32_t>(GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+                    // the telemetry decoder takes the 1 ms symbols and finds the time mark
+                    d_symbols_per_bit = 1;
+                    d_correlation_length_ms = 1;
+                    d_code_samples_per_chip = 1;
+                    d_secondary = false;
+                    d_trk_parameters.track_pilot = false;
+                    d_trk_parameters.slope = 1.0;
+                    d_trk_parameters.spc = d_trk_parameters.early_late_space_chips;
+                    d_trk_parameters.y_intercept = 1.0;
+                }
+            else if (d_signal_type == "2G")
+                {
+                    d_signal_carrier_freq = GLONASS_L2_CA_FREQ_HZ;
+                    d_code_period = GLONASS_L2_CA_CODE_PERIOD_S;
+                    d_code_chip_rate = GLONASS_L2_CA_CODE_RATE_CPS;
+                    d_code_length_chips = static_cast<int32_t>(GLONASS_L2_CA_CODE_LENGTH_CHIPS);
+                    d_symbols_per_bit = 1;
+                    d_correlation_length_ms = 1;
+                    d_code_samples_per_chip = 1;
+                    d_secondary = false;
+                    d_trk_parameters.track_pilot = false;
+                    d_trk_parameters.slope = 1.0;
+                    d_trk_parameters.spc = d_trk_parameters.early_late_space_chips;
+                    d_trk_parameters.y_intercept = 1.0;
+                }
+            else
+                {
+                    LOG(WARNING) << "Invalid Signal argument when instantiating tracking blocks";
+                    std::cout << "Invalid Signal argument when instantiating tracking blocks\n";
+                    d_correlation_length_ms = 1;
+                    d_secondary = false;
+                    d_signal_carrier_freq = 0.0;
+                    d_code_period = 0.0;
+                    d_code_length_chips = 0;
+                    d_code_samples_per_chip = 0;
+                    d_symbols_per_bit = 0;
+                }
+        }
     else if (d_trk_parameters.system == 'C')
         {
             d_systemName = "Beidou";
@@ -505,7 +598,25 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_prompt_data_shift = &d_local_code_shift_chips[1];
         }
 
-    d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+    if (d_use_16sc)
+        {
+            // The 16-bit correlators do not model code and carrier phase rates, and
+            // the shared service and the code tables only handle gr_complex samples
+            if (d_trk_parameters.high_dyn or d_trk_parameters.shared_correlator or d_trk_parameters.precomputed_code_tables)
+                {
+                    LOG(WARNING) << "high_dyn, shared_correlator and precomputed_code_tables are not available with cshort samples. Disabled.";
+                    d_trk_parameters.high_dyn = false;
+                    d_trk_parameters.shared_correlator = false;
+                    d_trk_parameters.precomputed_code_tables = false;
+                }
+            d_correlator_outs_16sc = volk_gnsssdr::vector<lv_16sc_t>(d_n_correlator_taps);
+            d_tracking_code_16sc = volk_gnsssdr::vector<lv_16sc_t>(d_tracking_code.size());
+            d_multicorrelator_16sc.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+        }
+    else
+        {
+            d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+        }
 
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
@@ -521,17 +632,63 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
     if (d_trk_parameters.track_pilot)
         {
             // Extra correlator for the data component
-            d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
-            d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+            if (d_use_16sc)
+                {
+                    d_correlator_data_16sc.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
+                    d_Prompt_Data_16sc = volk_gnsssdr::vector<lv_16sc_t>(1);
+                    d_data_code_16sc = volk_gnsssdr::vector<lv_16sc_t>(2 * d_code_length_chips);
+                }
+            else
+                {
+                    d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
+                    d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+                }
             d_data_code.resize(2 * d_code_length_chips, 0.0);
         }
 
     // --- Initializations ---
-    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+    if (d_trk_parameters.precomputed_code_tables)
+        {
+            // Code phase step at zero code Doppler, in local code samples per input sample
+            const auto nominal_code_phase_step = static_cast<float>(d_code_chip_rate / d_trk_parameters.fs_in) * static_cast<float>(d_code_samples_per_chip);
+            d_multicorrelator_cpu.set_code_tables(d_trk_parameters.code_table_granularity, nominal_code_phase_step);
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_correlator_data_cpu.set_code_tables(d_trk_parameters.code_table_granularity, nominal_code_phase_step);
+                }
+        }
+    if (d_trk_parameters.shared_correlator)
+        {
+            d_correlation_jobs = std::vector<Tracking_Correlator_Service::Job>(d_trk_parameters.track_pilot ? 2 : 1);
+            d_correlation_jobs[0].correlator = &d_multicorrelator_cpu;
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_correlation_jobs[1].correlator = &d_correlator_data_cpu;
+                }
+        }
+    if (d_trk_parameters.compute_backend != Gnss_Compute_Backend::CPU)
+        {
+            if (d_use_16sc)
+                {
+                    LOG(WARNING) << "The GPU correlator is not available with cshort samples. Using the CPU";
+                }
+            else
+                {
+                    try
+                        {
+                            d_gpu_correlator = &Tracking_Gpu_Correlator::get(d_trk_parameters.compute_backend);
+                            d_gpu_jobs = std::vector<Tracking_Gpu_Correlator::Job>(d_trk_parameters.track_pilot ? 2 : 1);
+                        }
+                    catch (const std::exception &ex)
+                        {
+                            LOG(WARNING) << ex.what() << ". Using the CPU correlators";
+                        }
+                }
+        }
 
     // CN0 estimation and lock detector buffers
-    d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.cn0_samples);
+    d_cn0_window = Cn0_Estimation_Window(d_trk_parameters.cn0_samples);
     d_Prompt_Data = volk_gnsssdr::vector<gr_complex>(1);
     d_cn0_smoother = Exponential_Smoother();
     d_cn0_smoother.set_alpha(d_trk_parameters.cn0_smoother_alpha);
@@ -547,6 +704,45 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
     d_carrier_lock_test_smoother.set_offset(0.0);
     d_carrier_lock_test_smoother.set_samples_for_initialization(d_trk_parameters.carrier_lock_test_smoother_samples);
 
+    switch (dll_pll_signal(d_trk_parameters.system, d_signal_type))
+        {
+        case Dll_Pll_Signal::GPS_L1_CA:
+            bind_signal_loop<Dll_Pll_Signal::GPS_L1_CA>();
+            break;
+        case Dll_Pll_Signal::GPS_L2_M:
+            bind_signal_loop<Dll_Pll_Signal::GPS_L2_M>();
+            break;
+        case Dll_Pll_Signal::GPS_L5:
+            bind_signal_loop<Dll_Pll_Signal::GPS_L5>();
+            break;
+        case Dll_Pll_Signal::GALILEO_E1:
+            bind_signal_loop<Dll_Pll_Signal::GALILEO_E1>();
+            break;
+        case Dll_Pll_Signal::GALILEO_E5A:
+            bind_signal_loop<Dll_Pll_Signal::GALILEO_E5A>();
+            break;
+        case Dll_Pll_Signal::GALILEO_E5B:
+            bind_signal_loop<Dll_Pll_Signal::GALILEO_E5B>();
+            break;
+        case Dll_Pll_Signal::GALILEO_E6:
+            bind_signal_loop<Dll_Pll_Signal::GALILEO_E6>();
+            break;
+        case Dll_Pll_Signal::GLONASS_L1_CA:
+            bind_signal_loop<Dll_Pll_Signal::GLONASS_L1_CA>();
+            break;
+        case Dll_Pll_Signal::GLONASS_L2_CA:
+            bind_signal_loop<Dll_Pll_Signal::GLONASS_L2_CA>();
+            break;
+        case Dll_Pll_Signal::BEIDOU_B1I:
+            bind_signal_loop<Dll_Pll_Signal::BEIDOU_B1I>();
+            break;
+        case Dll_Pll_Signal::BEIDOU_B3I:
+            bind_signal_loop<Dll_Pll_Signal::BEIDOU_B3I>();
+            break;
+        default:
+            bind_signal_loop<Dll_Pll_Signal::UNKNOWN>();
+        }
+
     clear_tracking_vars();
 
     if (d_trk_parameters.smoother_length > 0)
@@ -599,6 +795,38 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
 }
 
 
+template <Dll_Pll_Signal S>
+void dll_pll_veml_tracking::bind_signal_loop()
+{
+    constexpr bool has_pilot = Dll_Pll_Signal_Traits<S>::pilot;
+    if (has_pilot and d_trk_parameters.track_pilot)
+        {
+            d_correlation_step_cpu = &dll_pll_veml_tracking::do_correlation_step_cpu<S, has_pilot>;
+            d_save_correlation_results = &dll_pll_veml_tracking::save_correlation_results<S, has_pilot>;
+        }
+    else
+        {
+            d_correlation_step_cpu = &dll_pll_veml_tracking::do_correlation_step_cpu<S, false>;
+            d_save_correlation_results = &dll_pll_veml_tracking::save_correlation_results<S, false>;
+        }
+    d_run_dll_pll = &dll_pll_veml_tracking::run_dll_pll<S>;
+}
+
+
+bool dll_pll_veml_tracking::set_dump_enabled(bool enabled)
+{
+    d_dump_paused = !enabled;
+    return d_dump;
+}
+
+
+void dll_pll_veml_tracking::set_time_map(std::shared_ptr<const Gnss_Time_Map> time_map)
+{
+    d_time_map = std::move(time_map);
+    d_time_map_version = 0;
+}
+
+
 void dll_pll_veml_tracking::forecast(int noutput_items,
     gr_vector_int &ninput_items_required)
 {
@@ -643,8 +871,19 @@ void dll_pll_veml_tracking::start_tracking()
     d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
     d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
 
+    // GLONASS: the NCO also removes the offset of the frequency channel of the
+    // satellite, and the Doppler and carrier phase are relative to its carrier
+    if (d_systemName == "Glonass")
+        {
+            const int32_t frequency_channel = GLONASS_PRN.at(d_acquisition_gnss_synchro->PRN);
+            const double channel_spacing_hz = d_signal_type == "1G" ? DFRQ1_GLO : DFRQ2_GLO;
+            d_carrier_offset_hz = channel_spacing_hz * static_cast<double>(frequency_channel);
+            d_signal_carrier_freq = (d_signal_type == "1G" ? GLONASS_L1_CA_FREQ_HZ : GLONASS_L2_CA_FREQ_HZ) + d_carrier_offset_hz;
+        }
+    d_carrier_offset_step_rad = TWO_PI * d_carrier_offset_hz / d_trk_parameters.fs_in;
+
     d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
-    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in;
+    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in + d_carrier_offset_step_rad;
     d_carrier_phase_rate_step_rad = 0.0;
     d_carr_ph_history.clear();
     d_code_ph_history.clear();
@@ -668,7 +907,7 @@ void dll_pll_veml_tracking::start_tracking()
                     gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
                     gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code(d_code_length_chips);
                 }
             else
                 {
@@ -683,7 +922,7 @@ void dll_pll_veml_tracking::start_tracking()
                     galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
                     galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code(d_code_samples_per_chip * d_code_length_chips);
                 }
             else
                 {
@@ -704,7 +943,7 @@ void dll_pll_veml_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code(d_code_length_chips);
                 }
             else
                 {
@@ -728,7 +967,7 @@ void dll_pll_veml_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code(d_code_length_chips);
                 }
             else
                 {
@@ -746,13 +985,29 @@ void dll_pll_veml_tracking::start_tracking()
                     galileo_e6_b_code_gen_float_primary(d_data_code, d_acquisition_gnss_synchro->PRN);
                     galileo_e6_c_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code(d_code_samples_per_chip * d_code_length_chips);
                 }
             else
                 {
                     galileo_e6_b_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
                 }
         }
+    else if (d_systemName == "Glonass")
+        {
+            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
+            if (d_signal_type == "1G")
+                {
+                    glonass_l1_ca_code_gen_complex(aux_code, 0);
+                }
+            else
+                {
+                    glonass_l2_ca_code_gen_complex(aux_code, 0);
+                }
+            for (int32_t i = 0; i < d_code_length_chips; i++)
+                {
+                    d_tracking_code[i] = aux_code[i].real();
+                }
+        }
     else if (d_systemName == "Beidou" and d_signal_type == "B1")
         {
             beidou_b1i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
@@ -768,7 +1023,6 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B1I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -782,7 +1036,6 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
 
@@ -801,7 +1054,6 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B3I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -815,12 +1067,30 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
+    set_secondary_sync();
 
-    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    if (d_use_16sc)
+        {
+            const int32_t code_length = d_code_samples_per_chip * d_code_length_chips;
+            std::transform(d_tracking_code.cbegin(), d_tracking_code.cbegin() + code_length, d_tracking_code_16sc.begin(), [](float chip) {
+                return lv_16sc_t(static_cast<int16_t>(std::lround(chip)), 0);
+            });
+            d_multicorrelator_16sc.set_local_code_and_taps(code_length, d_tracking_code_16sc.data(), d_local_code_shift_chips.data());
+            d_multicorrelator_16sc.set_taps(d_local_code_shift_chips.data(), d_n_correlator_taps);
+        }
+    else
+        {
+            d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+            d_multicorrelator_cpu.set_taps(d_local_code_shift_chips.data(), d_n_correlator_taps);
+            set_gpu_local_code(d_gpu_tracking_code_id, d_tracking_code.data(), d_code_samples_per_chip * d_code_length_chips);
+        }
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
+    // Undo the adaptive correlation of the previous satellite
+    d_first_correlator_tap = 0;
+    d_strong_signal_mode = false;
+    d_enable_extended_integration = d_trk_parameters.extend_correlation_symbols > 1;
 
     d_carrier_lock_fail_counter = 0;
     d_code_lock_fail_counter = 0;
@@ -828,7 +1098,7 @@ void dll_pll_veml_tracking::start_tracking()
     d_rem_carr_phase_rad = 0.0;
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
-    d_cn0_estimation_counter = 0;
+    d_cn0_window.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -856,14 +1126,17 @@ void dll_pll_veml_tracking::start_tracking()
     d_code_loop_filter.initialize();                                                 // initialize the code filter
 
     // DEBUG OUTPUT
-    std::cout << "Tracking of " << d_systemName << " " << d_signal_pretty_name << " signal started on channel " << d_channel << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
-    DLOG(INFO) << "Starting tracking of satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << " on channel " << d_channel;
+    d_satellite = Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+    std::cout << "Tracking of " << d_systemName << " " << d_signal_pretty_name << " signal started on channel " << d_channel << " for satellite " << d_satellite << '\n';
+    DLOG(INFO) << "Starting tracking of satellite " << d_satellite << " on channel " << d_channel;
 
     // enable tracking pull-in
     d_state = 1;
+    d_gap_skip_samples = 0;
+    d_gap_symbols = 0;
     d_cloop = true;
     d_pull_in_transitory = true;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_sync.clear();
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
 }
@@ -871,6 +1144,14 @@ void dll_pll_veml_tracking::start_tracking()
 
 dll_pll_veml_tracking::~dll_pll_veml_tracking()
 {
+    if (d_dump_stream)
+        {
+            d_dump_stream->close();
+            if (d_dump_stream->dropped() > 0)
+                {
+                    LOG(WARNING) << "Tracking channel " << d_channel << " dropped " << d_dump_stream->dropped() << " dump records";
+                }
+        }
     if (d_dump_file.is_open())
         {
             try
@@ -898,8 +1179,21 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
             if (d_trk_parameters.track_pilot)
                 {
                     d_correlator_data_cpu.free();
+                    d_correlator_data_16sc.free();
                 }
             d_multicorrelator_cpu.free();
+            d_multicorrelator_16sc.free();
+            if (d_gpu_correlator != nullptr)
+                {
+                    if (d_gpu_tracking_code_id >= 0)
+                        {
+                            d_gpu_correlator->remove_code(d_gpu_tracking_code_id);
+                        }
+                    if (d_gpu_data_code_id >= 0)
+                        {
+                            d_gpu_correlator->remove_code(d_gpu_data_code_id);
+                        }
+                }
         }
     catch (const std::exception &ex)
         {
@@ -911,68 +1205,48 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
 bool dll_pll_veml_tracking::acquire_secondary()
 {
     // ******* preamble correlation ********
-    int32_t corr_value = 0;
-    for (uint32_t i = 0; i < d_secondary_code_length; i++)
+    bool inverted = false;
+    if (d_secondary_sync.find(d_secondary_sync_shift, inverted))
         {
-            if (d_Prompt_circular_buffer[i].real() < 0.0)  // symbols clipping
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value++;
-                        }
-                    else
-                        {
-                            corr_value--;
-                        }
-                }
-            else
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value--;
-                        }
-                    else
-                        {
-                            corr_value++;
-                        }
-                }
+            d_Flag_PLL_180_deg_phase_locked = inverted;
+            return true;
         }
+    return false;
+}
+
 
-    if (abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
+void dll_pll_veml_tracking::set_secondary_sync()
+{
+    // A periodic secondary code can be locked at any of its chips that starts
+    // a data symbol, so that the extended integration and the symbol output
+    // stay aligned with the data bits. Preambles only at their first symbol.
+    uint32_t shift_step = d_secondary_code_length;
+    if (d_secondary)
         {
-            if (corr_value < 0)
-                {
-                    d_Flag_PLL_180_deg_phase_locked = true;
-                }
-            else
+            shift_step = 1;
+            if (d_symbols_per_bit > 1)
                 {
-                    d_Flag_PLL_180_deg_phase_locked = false;
+                    shift_step = d_data_secondary_code_length > 0 ? d_data_secondary_code_length : static_cast<uint32_t>(d_symbols_per_bit);
                 }
-            return true;
         }
-
-    return false;
+    d_secondary_sync.set_code(d_secondary_code_string.substr(0, d_secondary_code_length), shift_step);
+    d_secondary_sync_shift = 0;
 }
 
 
 bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-    if (d_cn0_estimation_counter < d_trk_parameters.cn0_samples)
+    d_cn0_window.push(d_P_accu);
+    if (!d_cn0_window.full())
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
-            d_cn0_estimation_counter++;
             return true;
         }
-
-    d_Prompt_buffer[d_cn0_estimation_counter % d_trk_parameters.cn0_samples] = d_P_accu;
-    d_cn0_estimation_counter++;
-    // Code lock indicator
-    const float d_CN0_SNV_dB_Hz_raw = cn0_m2m4_estimator(d_Prompt_buffer.data(), d_trk_parameters.cn0_samples, static_cast<float>(coh_integration_time_s));
+    // Code lock indicator, refreshed every prompt with the running sums of the window
+    const float d_CN0_SNV_dB_Hz_raw = d_cn0_window.cn0_m2m4(static_cast<float>(coh_integration_time_s));
     d_CN0_SNV_dB_Hz = d_cn0_smoother.smooth(d_CN0_SNV_dB_Hz_raw);
-    // Carrier lock indicator
-    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(d_Prompt_buffer.data(), 1));
+    // Carrier lock indicator, from the last prompt
+    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(&d_P_accu, 1));
     // Loss of lock detection
     if (!d_pull_in_transitory)
         {
@@ -1006,7 +1280,7 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
             LOG(INFO) << "Loss of lock in channel " << d_channel
                       << " (carrier_lock_fail_counter:" << d_carrier_lock_fail_counter
                       << " code_lock_fail_counter : " << d_code_lock_fail_counter << ")";
-            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));  // 3 -> loss of lock
+            this->message_port_pub(d_events_port, d_loss_of_lock_event);
             d_carrier_lock_fail_counter = 0;
             d_code_lock_fail_counter = 0;
             return false;
@@ -1020,36 +1294,195 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::do_correlation_step(const void *input_items)
 {
+    GNSS_SDR_TRACE_ZONE("do_correlation_step");
+    if (d_use_16sc)
+        {
+            do_correlation_step_16sc(static_cast<const lv_16sc_t *>(input_items));
+            return;
+        }
+    const auto *input_samples = static_cast<const gr_complex *>(input_items);
+
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
+    if (d_gpu_correlator != nullptr and do_correlation_step_gpu(input_samples))
+        {
+            return;
+        }
+    if (d_trk_parameters.shared_correlator)
+        {
+            // Correlate together with the rest of channels using the shared correlator
+            d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data() + d_first_correlator_tap, input_samples);
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
+                }
+            for (auto &job : d_correlation_jobs)
+                {
+                    job.input = input_samples;
+                    job.rem_carrier_phase_in_rad = d_rem_carr_phase_rad;
+                    job.phase_step_rad = static_cast<float>(d_carrier_phase_step_rad);
+                    job.phase_rate_step_rad = static_cast<float>(d_carrier_phase_rate_step_rad);
+                    job.rem_code_phase_chips = static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip);
+                    job.code_phase_step_chips = static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip);
+                    job.code_phase_rate_step_chips = static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip);
+                    job.signal_length_samples = static_cast<int>(d_trk_parameters.vector_length);
+                }
+            Tracking_Correlator_Service::instance().correlate(d_correlation_jobs);
+            return;
+        }
+
+    (this->*d_correlation_step_cpu)(input_samples);
+}
+
+
+template <Dll_Pll_Signal S, bool Pilot>
+void dll_pll_veml_tracking::do_correlation_step_cpu(const gr_complex *input_samples)
+{
+    constexpr auto samples_per_chip = static_cast<float>(Dll_Pll_Signal_Traits<S>::code_samples_per_chip);
+    const float rem_code_phase = static_cast<float>(d_rem_code_phase_chips) * samples_per_chip;
+    const float code_phase_step = static_cast<float>(d_code_phase_step_chips) * samples_per_chip;
+    const float code_phase_rate_step = static_cast<float>(d_code_phase_rate_step_chips) * samples_per_chip;
+
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
-    d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
+    d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data() + d_first_correlator_tap, input_samples);
     d_multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
-        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
-        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-        static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        rem_code_phase, code_phase_step, code_phase_rate_step,
         d_trk_parameters.vector_length);
 
     // DATA CORRELATOR (if tracking tracks the pilot signal)
-    if (d_trk_parameters.track_pilot)
+    if (Pilot)
         {
             d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
             d_correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
                 d_rem_carr_phase_rad,
                 static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                rem_code_phase, code_phase_step, code_phase_rate_step,
+                d_trk_parameters.vector_length);
+        }
+}
+
+
+// Same as do_correlation_step, with the 16-bit correlators. Only the few
+// correlator outputs are converted to gr_complex.
+void dll_pll_veml_tracking::do_correlation_step_16sc(const lv_16sc_t *input_samples)
+{
+    GNSS_SDR_TRACE_ZONE("do_correlation_step_16sc");
+    d_multicorrelator_16sc.set_input_output_vectors(d_correlator_outs_16sc.data() + d_first_correlator_tap, input_samples);
+    d_multicorrelator_16sc.Carrier_wipeoff_multicorrelator_resampler(
+        d_rem_carr_phase_rad,
+        static_cast<float>(d_carrier_phase_step_rad),
+        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+        d_trk_parameters.vector_length);
+    for (int32_t n = 0; n < d_n_correlator_taps; n++)
+        {
+            d_correlator_outs[n] = gr_complex(d_correlator_outs_16sc[n].real(), d_correlator_outs_16sc[n].imag());
+        }
+
+    if (d_trk_parameters.track_pilot)
+        {
+            d_correlator_data_16sc.set_input_output_vectors(d_Prompt_Data_16sc.data(), input_samples);
+            d_correlator_data_16sc.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad),
                 static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
                 static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
                 d_trk_parameters.vector_length);
+            d_Prompt_Data[0] = gr_complex(d_Prompt_Data_16sc[0].real(), d_Prompt_Data_16sc[0].imag());
+        }
+}
+
+
+void dll_pll_veml_tracking::set_data_local_code(int32_t code_length)
+{
+    if (d_use_16sc)
+        {
+            std::transform(d_data_code.cbegin(), d_data_code.cbegin() + code_length, d_data_code_16sc.begin(), [](float chip) {
+                return lv_16sc_t(static_cast<int16_t>(std::lround(chip)), 0);
+            });
+            d_correlator_data_16sc.set_local_code_and_taps(code_length, d_data_code_16sc.data(), d_prompt_data_shift);
+        }
+    else
+        {
+            d_correlator_data_cpu.set_local_code_and_taps(code_length, d_data_code.data(), d_prompt_data_shift);
+            set_gpu_local_code(d_gpu_data_code_id, d_data_code.data(), code_length);
         }
 }
 
 
+// Replaces the GPU copy of a local code. On errors the channel falls back to
+// the CPU correlators, which always have the codes.
+void dll_pll_veml_tracking::set_gpu_local_code(int32_t &code_id, const float *code, int32_t code_length)
+{
+    if (d_gpu_correlator == nullptr)
+        {
+            return;
+        }
+    try
+        {
+            if (code_id >= 0)
+                {
+                    d_gpu_correlator->remove_code(code_id);
+                    code_id = -1;
+                }
+            code_id = d_gpu_correlator->add_code(code, code_length);
+        }
+    catch (const std::exception &ex)
+        {
+            LOG(WARNING) << "Error uploading the local code to the GPU: " << ex.what() << ". Using the CPU correlators";
+            d_gpu_correlator = nullptr;
+        }
+}
+
+
+// Carrier wipe-off and correlators of the channel computed in the GPU,
+// batched with the rest of channels. Returns false if the GPU failed, so the
+// CPU correlators are used instead.
+bool dll_pll_veml_tracking::do_correlation_step_gpu(const gr_complex *input_samples)
+{
+    for (auto &job : d_gpu_jobs)
+        {
+            job.input = input_samples;
+            job.rem_carrier_phase_in_rad = d_rem_carr_phase_rad;
+            job.phase_step_rad = static_cast<float>(d_carrier_phase_step_rad);
+            job.phase_rate_step_rad = static_cast<float>(d_carrier_phase_rate_step_rad);
+            job.rem_code_phase_chips = static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip);
+            job.code_phase_step_chips = static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip);
+            job.code_phase_rate_step_chips = static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip);
+            job.signal_length_samples = static_cast<int>(d_trk_parameters.vector_length);
+        }
+    d_gpu_jobs[0].corr_out = d_correlator_outs.data() + d_first_correlator_tap;
+    d_gpu_jobs[0].shifts_chips = d_local_code_shift_chips.data() + d_first_correlator_tap;
+    d_gpu_jobs[0].n_correlators = d_n_correlator_taps - 2 * d_first_correlator_tap;
+    d_gpu_jobs[0].code_id = d_gpu_tracking_code_id;
+    if (d_trk_parameters.track_pilot)
+        {
+            d_gpu_jobs[1].corr_out = d_Prompt_Data.data();
+            d_gpu_jobs[1].shifts_chips = d_prompt_data_shift;
+            d_gpu_jobs[1].n_correlators = 1;
+            d_gpu_jobs[1].code_id = d_gpu_data_code_id;
+        }
+    try
+        {
+            d_gpu_correlator->correlate(d_gpu_jobs);
+        }
+    catch (const std::exception &ex)
+        {
+            LOG(WARNING) << "Error in the GPU correlator of channel " << d_channel << ": " << ex.what() << ". Using the CPU correlators";
+            d_gpu_correlator = nullptr;
+            return false;
+        }
+    return true;
+}
+
+
+template <Dll_Pll_Signal S>
 void dll_pll_veml_tracking::run_dll_pll()
 {
+    GNSS_SDR_TRACE_ZONE("run_dll_pll");
     // ################## PLL ##########################################################
     // PLL discriminator
     if (d_cloop)
@@ -1097,7 +1530,7 @@ void dll_pll_veml_tracking::run_dll_pll()
 
     // ################## DLL ##########################################################
     // DLL discriminator
-    if (d_veml)
+    if (Dll_Pll_Signal_Traits<S>::veml)
         {
             d_code_error_chips = dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);  // [chips/Ti]
         }
@@ -1108,10 +1541,11 @@ void dll_pll_veml_tracking::run_dll_pll()
     // Code discriminator filter
     d_code_error_filt_chips = d_code_loop_filter.apply(static_cast<float>(d_code_error_chips));  // [chips/second]
     // New code Doppler frequency estimation
-    d_code_freq_chips = d_code_chip_rate - d_code_error_filt_chips;
+    d_code_freq_chips = Dll_Pll_Signal_Traits<S>::code_chip_rate_cps - d_code_error_filt_chips;
     if (d_trk_parameters.carrier_aiding)
         {
-            d_code_freq_chips += d_carrier_doppler_hz * d_code_chip_rate / d_signal_carrier_freq;
+            const double carrier_freq_hz = Dll_Pll_Signal_Traits<S>::fdma ? d_signal_carrier_freq : Dll_Pll_Signal_Traits<S>::carrier_freq_hz;
+            d_code_freq_chips += d_carrier_doppler_hz * (Dll_Pll_Signal_Traits<S>::code_chip_rate_cps / carrier_freq_hz);
         }
 
     // Experimental: detect Carrier Doppler vs. Code Doppler incoherence and correct the Carrier Doppler
@@ -1127,7 +1561,7 @@ void dll_pll_veml_tracking::run_dll_pll()
                             if (std::fabs(avg_code_error_chips_s) > 1.0)
                                 {
                                     const float carrier_doppler_error_hz = static_cast<float>(d_signal_carrier_freq) * avg_code_error_chips_s / static_cast<float>(d_code_chip_rate);
-                                    LOG(INFO) << "Detected and corrected carrier doppler error: " << carrier_doppler_error_hz << " [Hz] on sat " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+                                    GNSS_SDR_LOG_EVERY_MS(INFO, 1000) << "Detected and corrected carrier doppler error: " << carrier_doppler_error_hz << " [Hz] on sat " << d_satellite;
                                     d_carrier_loop_filter.initialize(static_cast<float>(d_carrier_doppler_hz) - carrier_doppler_error_hz);
                                     d_corrected_doppler = true;
                                 }
@@ -1164,7 +1598,7 @@ void dll_pll_veml_tracking::clear_tracking_vars()
     d_code_error_filt_chips = 0.0;
     d_current_symbol = 0;
     d_current_data_symbol = 0;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_sync.clear();
     d_carrier_phase_rate_step_rad = 0.0;
     d_code_phase_rate_step_chips = 0.0;
     d_carr_ph_history.clear();
@@ -1186,7 +1620,7 @@ void dll_pll_veml_tracking::update_tracking_vars()
 
     // ################### PLL COMMANDS #################################################
     // carrier phase step (NCO phase increment per sample) [rads/sample]
-    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in;
+    d_carrier_phase_step_rad = TWO_PI * d_carrier_doppler_hz / d_trk_parameters.fs_in + d_carrier_offset_step_rad;
     // carrier phase rate step (NCO phase increment rate per sample) [rads/sample^2]
     if (d_trk_parameters.high_dyn)
         {
@@ -1216,7 +1650,7 @@ void dll_pll_veml_tracking::update_tracking_vars()
     // double a = d_carrier_phase_step_rad * static_cast<double>(d_current_prn_length_samples);
     // double b = 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples);
     // std::cout << fmod(b, TWO_PI) / fmod(a, TWO_PI) << '\n';
-    d_acc_carrier_phase_rad -= (d_carrier_phase_step_rad * static_cast<double>(d_current_prn_length_samples) + 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples));
+    d_acc_carrier_phase_rad -= ((d_carrier_phase_step_rad - d_carrier_offset_step_rad) * static_cast<double>(d_current_prn_length_samples) + 0.5 * d_carrier_phase_rate_step_rad * static_cast<double>(d_current_prn_length_samples) * static_cast<double>(d_current_prn_length_samples));
 
     // ################### DLL COMMANDS #################################################
     // code phase step (Code resampler phase increment per sample) [chips/sample]
@@ -1246,13 +1680,159 @@ void dll_pll_veml_tracking::update_tracking_vars()
 }
 
 
+int32_t dll_pll_veml_tracking::coast_sample_gap()
+{
+    const uint64_t missing_samples = sample_gap_total(d_tags_vec);
+    d_gap_samples += missing_samples;
+    d_gap_counted_end = d_tags_vec.back().offset + 1;
+    if (missing_samples == 0)
+        {
+            return 0;
+        }
+    const auto gap_position = static_cast<double>(d_tags_vec.front().offset - this->nitems_read(0));
+    const double block_start_counter = static_cast<double>(this->nitems_read(0) + d_gap_samples - missing_samples) + d_rem_code_phase_samples;
+
+    // The PRN boundaries after the gap come missing_samples earlier in the
+    // input. Skip to the first one after the gap, and advance the NCOs by
+    // the time elapsed, including the samples lost.
+    const double periods = std::max(1.0, std::ceil((gap_position + 1.0 + static_cast<double>(missing_samples) - d_rem_code_phase_samples) / d_T_prn_samples));
+    const double next_prn_start = d_rem_code_phase_samples + periods * d_T_prn_samples - static_cast<double>(missing_samples);
+    const auto skip_samples = static_cast<int32_t>(std::floor(next_prn_start));
+    const double elapsed_samples = static_cast<double>(skip_samples) + static_cast<double>(missing_samples);
+    d_rem_code_phase_samples = next_prn_start - static_cast<double>(skip_samples);
+    d_rem_code_phase_chips = d_code_freq_chips * d_rem_code_phase_samples / d_trk_parameters.fs_in;
+    d_rem_carr_phase_rad = static_cast<float>(fmod(static_cast<double>(d_rem_carr_phase_rad) + d_carrier_phase_step_rad * elapsed_samples, TWO_PI));
+    d_acc_carrier_phase_rad -= (d_carrier_phase_step_rad - d_carrier_offset_step_rad) * elapsed_samples;
+
+    // the symbols that ended during the gap are sent to telemetry as
+    // erasures, stamped like the others with the start of their last period
+    int32_t first_symbol_period = -1;
+    for (int32_t k = 0; k < static_cast<int32_t>(periods); k++)
+        {
+            const int32_t symbols = d_gap_symbols;
+            advance_code_period();
+            if (first_symbol_period < 0 && d_gap_symbols > symbols)
+                {
+                    first_symbol_period = k;
+                }
+        }
+    const int32_t periods_per_symbol = d_symbols_per_bit > 1 ? (d_data_secondary_code_length > 0 ? static_cast<int32_t>(d_data_secondary_code_length) : d_symbols_per_bit) : 1;
+    d_gap_symbol_samples = static_cast<double>(periods_per_symbol) * d_T_prn_samples;
+    d_gap_symbol_counter = block_start_counter + static_cast<double>(first_symbol_period) * d_T_prn_samples;
+
+    // the partial integrations do not match the replica anymore
+    d_VE_accu = gr_complex(0.0, 0.0);
+    d_E_accu = gr_complex(0.0, 0.0);
+    d_P_accu = gr_complex(0.0, 0.0);
+    d_P_data_accu = gr_complex(0.0, 0.0);
+    d_L_accu = gr_complex(0.0, 0.0);
+    d_VL_accu = gr_complex(0.0, 0.0);
+    if (d_state == 2)
+        {
+            // restart the bit synchronization
+            d_secondary_sync.clear();
+        }
+
+    const double gap_ms = 1000.0 * static_cast<double>(missing_samples) / d_trk_parameters.fs_in;
+    if (gap_ms > static_cast<double>(d_trk_parameters.max_coast_gap_ms))
+        {
+            d_carrier_lock_fail_counter = 300000;  // force loss-of-lock condition
+            d_gap_symbols = 0;
+            LOG(INFO) << "Gap of " << gap_ms << " ms in the input of tracking channel " << d_channel << ", too long to coast through";
+        }
+    else
+        {
+            LOG(INFO) << "Tracking channel " << d_channel << " for satellite " << d_satellite << " coasting through a gap of " << gap_ms << " ms";
+        }
+    return skip_samples;
+}
+
+
+void dll_pll_veml_tracking::count_sample_gaps(int32_t consumed_samples)
+{
+    const uint64_t first = std::max(this->nitems_read(0), d_gap_counted_end);
+    const uint64_t end = this->nitems_read(0) + static_cast<uint64_t>(std::max(consumed_samples, 0));
+    if (first < end)
+        {
+            this->get_tags_in_range(d_tags_vec, 0, first, end, sample_gap_key());
+            d_gap_samples += sample_gap_total(d_tags_vec);
+            d_gap_counted_end = end;
+        }
+}
+
+
+void dll_pll_veml_tracking::read_time_map()
+{
+    // a single atomic load while there is no new segment
+    if (d_time_map->version() == d_time_map_version)
+        {
+            return;
+        }
+    Gnss_Time_Map::Segment segment;
+    if (!d_time_map->segment_before(this->nitems_read(0) + d_current_prn_length_samples, segment) or segment.version == d_time_map_version)
+        {
+            return;  // the new segments start after this PRN period
+        }
+    d_time_map_version = segment.version;
+    d_last_timetag.rx_time = 0.0;
+    d_last_timetag.week = segment.week;
+    d_last_timetag.tow_ms = static_cast<int>(std::floor(segment.tow_ms));
+    d_last_timetag.tow_ms_fraction = segment.tow_ms - static_cast<double>(d_last_timetag.tow_ms);
+    d_last_timetag_samplecounter = segment.first_sample + d_gap_samples;
+    d_timetag_waiting = true;
+}
+
+
+void dll_pll_veml_tracking::advance_code_period()
+{
+    // same counters as save_correlation_results(), without correlations
+    if (d_secondary)
+        {
+            d_current_symbol++;
+            d_current_symbol %= d_secondary_code_length;
+        }
+    bool symbol_end = true;
+    if (d_symbols_per_bit > 1)
+        {
+            d_current_data_symbol++;
+            d_current_data_symbol %= d_data_secondary_code_length > 0 ? static_cast<int32_t>(d_data_secondary_code_length) : d_symbols_per_bit;
+            symbol_end = (d_current_data_symbol == 0);
+        }
+    if (d_state == 3)
+        {
+            if (symbol_end)
+                {
+                    d_gap_symbols++;
+                }
+            d_extend_correlation_symbols_count++;
+            if (d_extend_correlation_symbols_count == (d_trk_parameters.extend_correlation_symbols - 1))
+                {
+                    d_extend_correlation_symbols_count = 0;
+                    d_state = 4;
+                }
+        }
+    else if (d_state == 4)
+        {
+            if (symbol_end)
+                {
+                    d_gap_symbols++;
+                }
+            if (d_enable_extended_integration)
+                {
+                    d_state = 3;
+                }
+        }
+}
+
+
+template <Dll_Pll_Signal S, bool Pilot>
 void dll_pll_veml_tracking::save_correlation_results()
 {
     if (d_secondary)
         {
             if (d_secondary_code_string[d_current_symbol] == '0')
                 {
-                    if (d_veml)
+                    if (Dll_Pll_Signal_Traits<S>::veml)
                         {
                             d_VE_accu += *d_Very_Early;
                             d_VL_accu += *d_Very_Late;
@@ -1263,7 +1843,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
             else
                 {
-                    if (d_veml)
+                    if (Dll_Pll_Signal_Traits<S>::veml)
                         {
                             d_VE_accu -= *d_Very_Early;
                             d_VL_accu -= *d_Very_Late;
@@ -1278,7 +1858,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         }
     else
         {
-            if (d_veml)
+            if (Dll_Pll_Signal_Traits<S>::veml)
                 {
                     d_VE_accu += *d_Very_Early;
                     d_VL_accu += *d_Very_Late;
@@ -1293,7 +1873,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         {
             if (d_data_secondary_code_length > 0)
                 {
-                    if (d_trk_parameters.track_pilot)
+                    if (Pilot)
                         {
                             if (d_data_secondary_code_string[d_current_data_symbol] == '0')
                                 {
@@ -1322,7 +1902,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
             else
                 {
-                    if (d_trk_parameters.track_pilot)
+                    if (Pilot)
                         {
                             d_P_data_accu += d_Prompt_Data[0];
                         }
@@ -1337,7 +1917,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         }
     else
         {
-            if (d_trk_parameters.track_pilot)
+            if (Pilot)
                 {
                     d_P_data_accu = d_Prompt_Data[0];
                 }
@@ -1347,7 +1927,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
         }
 
-    if (d_trk_parameters.track_pilot)
+    if (Pilot)
         {
             // If tracking pilot, disable Costas loop
             d_cloop = false;
@@ -1359,9 +1939,64 @@ void dll_pll_veml_tracking::save_correlation_results()
 }
 
 
+// Switches between correlation modes with the smoothed C/N0, with hysteresis.
+// Strong signals are tracked with a single code period integration and, for
+// VEML signals, with the Early, Prompt and Late correlators only. Weak signals
+// go back to all the correlators and to extend_correlation_symbols coherent
+// integration, starting at a symbol boundary so that it does not straddle bit
+// or secondary code transitions.
+void dll_pll_veml_tracking::update_adaptive_correlation()
+{
+    if (!d_strong_signal_mode)
+        {
+            if (d_CN0_SNV_dB_Hz >= d_trk_parameters.adaptive_cn0_high_db_hz)
+                {
+                    set_strong_signal_mode(true);
+                }
+        }
+    else if (d_CN0_SNV_dB_Hz < d_trk_parameters.adaptive_cn0_low_db_hz and d_current_symbol == 0 and d_current_data_symbol == 0)
+        {
+            set_strong_signal_mode(false);
+        }
+}
+
+
+void dll_pll_veml_tracking::set_strong_signal_mode(bool strong)
+{
+    d_strong_signal_mode = strong;
+    d_enable_extended_integration = !strong and d_trk_parameters.extend_correlation_symbols > 1;
+    const int32_t symbols = d_enable_extended_integration ? d_trk_parameters.extend_correlation_symbols : 1;
+    d_current_correlation_time_s = static_cast<double>(symbols) * d_code_period;
+    d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
+    // The C/N0 estimator buffer must not mix integration times
+    d_cn0_window.reset();
+
+    if (d_veml)
+        {
+            // Without Very Early and Very Late outputs, the VEMLP discriminator
+            // is the Early minus Late one
+            d_first_correlator_tap = strong ? 1 : 0;
+            const int32_t n_taps = strong ? 3 : d_n_correlator_taps;
+            if (d_use_16sc)
+                {
+                    d_multicorrelator_16sc.set_taps(d_local_code_shift_chips.data() + d_first_correlator_tap, n_taps);
+                    std::fill_n(d_correlator_outs_16sc.begin(), d_n_correlator_taps, lv_16sc_t(0, 0));
+                }
+            else
+                {
+                    d_multicorrelator_cpu.set_taps(d_local_code_shift_chips.data() + d_first_correlator_tap, n_taps);
+                }
+            std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
+        }
+    DLOG(INFO) << (strong ? "Strong" : "Weak") << " signal correlation (" << symbols * static_cast<int32_t>(d_code_period * 1000.0)
+               << " ms) in channel " << d_channel << " for satellite " << d_satellite
+               << " with C/N0 " << d_CN0_SNV_dB_Hz << " dB-Hz";
+}
+
+
 void dll_pll_veml_tracking::log_data()
 {
-    if (d_dump)
+    if (d_dump && !d_dump_paused)
         {
             // Dump results to file
             float prompt_I;
@@ -1371,9 +2006,6 @@ void dll_pll_veml_tracking::log_data()
             float tmp_P;
             float tmp_L;
             float tmp_VL;
-            float tmp_float;
-            double tmp_double;
-            uint64_t tmp_long_int;
             if (d_trk_parameters.track_pilot)
                 {
                     prompt_I = d_Prompt_Data.data()->real();
@@ -1398,61 +2030,59 @@ void dll_pll_veml_tracking::log_data()
             tmp_P = std::abs<float>(d_P_accu);
             tmp_L = std::abs<float>(d_L_accu);
 
-            try
+            // Build the whole record, so it is written at once
+            std::array<char, DUMP_RECORD_BYTES> record{};
+            char *field = record.data();
+            // Dump correlators output
+            field = append_to_record(field, tmp_VE);
+            field = append_to_record(field, tmp_E);
+            field = append_to_record(field, tmp_P);
+            field = append_to_record(field, tmp_L);
+            field = append_to_record(field, tmp_VL);
+            // PROMPT I and Q (to analyze navigation symbols)
+            field = append_to_record(field, prompt_I);
+            field = append_to_record(field, prompt_Q);
+            // PRN start sample stamp
+            field = append_to_record(field, this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples));
+            // accumulated carrier phase
+            field = append_to_record(field, static_cast<float>(d_acc_carrier_phase_rad));
+            // carrier and code frequency
+            field = append_to_record(field, static_cast<float>(d_carrier_doppler_hz));
+            // carrier phase rate [Hz/s]
+            field = append_to_record(field, static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI));
+            field = append_to_record(field, static_cast<float>(d_code_freq_chips));
+            // code phase rate [chips/s^2]
+            field = append_to_record(field, static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in));
+            // PLL commands
+            field = append_to_record(field, static_cast<float>(d_carr_phase_error_hz));
+            field = append_to_record(field, static_cast<float>(d_carr_error_filt_hz));
+            // DLL commands
+            field = append_to_record(field, static_cast<float>(d_code_error_chips));
+            field = append_to_record(field, static_cast<float>(d_code_error_filt_chips));
+            // CN0 and carrier lock test
+            field = append_to_record(field, static_cast<float>(d_CN0_SNV_dB_Hz));
+            field = append_to_record(field, static_cast<float>(d_carrier_lock_test));
+            // AUX vars (for debug purposes)
+            field = append_to_record(field, static_cast<float>(d_rem_code_phase_samples));
+            field = append_to_record(field, static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples));
+            // PRN
+            append_to_record(field, static_cast<uint32_t>(d_acquisition_gnss_synchro->PRN));
+
+            if (d_dump_stream)
+                {
+                    // Written by the background dump writer
+                    d_dump_stream->push(record.data());
+                }
+            else
                 {
-                    // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
-                    // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-                    // PRN start sample stamp
-                    tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
-                    // accumulated carrier phase
-                    tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier and code frequency
-                    tmp_float = static_cast<float>(d_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier phase rate [Hz/s]
-                    tmp_float = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_freq_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // code phase rate [chips/s^2]
-                    tmp_float = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // PLL commands
-                    tmp_float = static_cast<float>(d_carr_phase_error_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carr_error_filt_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // DLL commands
-                    tmp_float = static_cast<float>(d_code_error_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_error_filt_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // CN0 and carrier lock test
-                    tmp_float = static_cast<float>(d_CN0_SNV_dB_Hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carrier_lock_test);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // AUX vars (for debug purposes)
-                    tmp_float = static_cast<float>(d_rem_code_phase_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    // PRN
-                    uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
+                    try
+                        {
+                            d_dump_file.write(record.data(), static_cast<std::streamsize>(record.size()));
+                        }
+                    catch (const std::ifstream::failure &e)
+                        {
+                            LOG(WARNING) << "Exception writing trk dump file " << e.what();
+                        }
                 }
         }
 }
@@ -1663,6 +2293,20 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
     LOG(INFO) << "Tracking Channel set to " << d_channel;
+    if (d_gpu_correlator != nullptr and d_gpu_tracking_code_id < 0 and d_gpu_data_code_id < 0)
+        {
+            // Move to the device of the channel group before uploading any code
+            const int device = Gnss_Device_Scheduler::instance().device(static_cast<int>(d_channel));
+            try
+                {
+                    d_gpu_correlator = &Tracking_Gpu_Correlator::get(d_trk_parameters.compute_backend, device);
+                }
+            catch (const std::exception &ex)
+                {
+                    LOG(WARNING) << "Tracking channel " << d_channel << " cannot use GPU " << device << ": " << ex.what() << ". Using the CPU correlators";
+                    d_gpu_correlator = nullptr;
+                }
+        }
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
         {
@@ -1672,7 +2316,23 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
             // add extension
             dump_filename_.append(".dat");
 
-            if (!d_dump_file.is_open())
+            if (d_trk_parameters.dump_async)
+                {
+                    if (!d_dump_stream)
+                        {
+                            d_dump_stream = Tracking_Dump_Writer::instance().open(dump_filename_, DUMP_RECORD_BYTES);
+                            if (d_dump_stream->is_open())
+                                {
+                                    LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename_.c_str();
+                                }
+                            else
+                                {
+                                    LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << dump_filename_;
+                                    d_dump_stream.reset();
+                                }
+                        }
+                }
+            else if (!d_dump_file.is_open())
                 {
                     try
                         {
@@ -1715,8 +2375,17 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
+    const Gnss_Block_Work_Timer work_timer(d_work_stats.get());
+#if GNSS_SDR_COUNT_ALLOCATIONS
+    // Debug builds check that tracking does not allocate memory
+    if (d_work_allocations > 0)
+        {
+            LOG(WARNING) << "Tracking channel " << d_channel << " made " << d_work_allocations << " heap allocations in general_work";
+            d_work_allocations = 0;
+        }
+    const Allocation_Scope allocation_scope(d_state > 0 ? &d_work_allocations : nullptr);
+#endif
+    const void *in = input_items[0];
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
     bool loss_of_lock = false;
@@ -1731,11 +2400,53 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     d_code_lock_fail_counter = 0;
                 }
         }
+    if (d_state > 1)
+        {
+            if (d_gap_skip_samples > 0)
+                {
+                    // skip the rest of the samples up to the first PRN boundary after a gap
+                    const int32_t skip = std::min(d_gap_skip_samples, ninput_items[0]);
+                    count_sample_gaps(skip);
+                    d_gap_skip_samples -= skip;
+                    consume_each(skip);
+                    return 0;
+                }
+            if (d_gap_symbols > 0)
+                {
+                    // an empty symbol for each one lost in a gap, so that the
+                    // telemetry decoder keeps counting symbols
+                    current_synchro_data = *d_acquisition_gnss_synchro;
+                    current_synchro_data.Prompt_I = 0.0;
+                    current_synchro_data.Prompt_Q = 0.0;
+                    current_synchro_data.Code_phase_samples = d_rem_code_phase_samples;
+                    current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
+                    current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+                    current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
+                    current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                    current_synchro_data.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
+                    current_synchro_data.Tracking_sample_counter = static_cast<uint64_t>(std::llround(d_gap_symbol_counter));
+                    current_synchro_data.Flag_valid_symbol_output = true;
+                    current_synchro_data.Flag_PLL_180_deg_phase_locked = d_Flag_PLL_180_deg_phase_locked;
+                    write_tracking_item(output_items[0], 0, d_trk_parameters.compact_output, current_synchro_data);
+                    d_gap_symbol_counter += d_gap_symbol_samples;
+                    d_gap_symbols--;
+                    return 1;
+                }
+            // one more sample, since the block consumed may be one sample longer than the one correlated
+            this->get_tags_in_range(d_tags_vec, 0, std::max(this->nitems_read(0), d_gap_counted_end), this->nitems_read(0) + d_current_prn_length_samples + 1, sample_gap_key());
+            if (!d_tags_vec.empty())
+                {
+                    d_gap_skip_samples = coast_sample_gap();
+                    return 0;
+                }
+        }
+
     switch (d_state)
         {
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
                 // d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
+                count_sample_gaps(ninput_items[0]);
                 consume_each(ninput_items[0]);
                 return 0;
                 break;
@@ -1748,7 +2459,13 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 const double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / d_trk_parameters.fs_in;
                 const double delta_trk_to_acq_prn_start_samples = static_cast<double>(acq_trk_diff_samples) - d_acq_code_phase_samples;
 
+                // with the code Doppler, the code phase holds over a long
+                // delay, as that of a tracking handoff from another band
                 d_code_freq_chips = d_code_chip_rate;
+                if (d_signal_carrier_freq > 0.0)
+                    {
+                        d_code_freq_chips *= 1.0 + d_acq_carrier_doppler_hz / d_signal_carrier_freq;
+                    }
                 d_code_phase_step_chips = d_code_freq_chips / d_trk_parameters.fs_in;
                 d_code_phase_rate_step_chips = 0.0;
                 const double T_chip_mod_seconds = 1.0 / d_code_freq_chips;
@@ -1759,7 +2476,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 d_current_prn_length_samples = round(T_prn_mod_samples);
 
                 const int32_t samples_offset = round(d_acq_code_phase_samples);
-                d_acc_carrier_phase_rad -= d_carrier_phase_step_rad * static_cast<double>(samples_offset);
+                d_acc_carrier_phase_rad -= (d_carrier_phase_step_rad - d_carrier_offset_step_rad) * static_cast<double>(samples_offset);
                 d_state = 2;
                 // d_sample_counter += samples_offset;  // count for the processed samples
                 d_cn0_smoother.reset();
@@ -1769,6 +2486,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
+                count_sample_gaps(samples_offset);
                 consume_each(samples_offset);  // shift input to perform alignment with local replica
                 return 0;
             }
@@ -1797,7 +2515,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     {
                         d_carrier_lock_fail_counter = 300000;  // force loss-of-lock condition
                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " tracking synchronization time limit reached in channel " << d_channel
-                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                  << " for satellite " << d_satellite << '\n';
                     }
                 // Check lock status
                 if (!cn0_and_tracking_lock_status(d_code_period))
@@ -1811,7 +2529,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     {
                         bool next_state = false;
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
-                        run_dll_pll();
+                        (this->*d_run_dll_pll)();
                         update_tracking_vars();
 
                         // enable write dump file this cycle (valid DLL/PLL cycle)
@@ -1822,32 +2540,32 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 if (d_secondary)
                                     {
                                         // ####### SECONDARY CODE LOCK #####
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_sync.push(d_Prompt->real());
+                                        if (d_secondary_sync.full())
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
                                                     {
                                                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " secondary code locked in channel " << d_channel
-                                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                                                  << " for satellite " << d_satellite << '\n';
                                                         std::cout << d_systemName << " " << d_signal_pretty_name << " secondary code locked in channel " << d_channel
-                                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                                                  << " for satellite " << d_satellite << '\n';
                                                     }
                                             }
                                     }
                                 else if (d_symbols_per_bit > 1)  // Signal does not have secondary code. Search a bit transition by sign change
                                     {
                                         // ******* preamble correlation ********
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_sync.push(d_Prompt->real());
+                                        if (d_secondary_sync.full())
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
                                                     {
                                                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " tracking bit synchronization locked in channel " << d_channel
-                                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                                                  << " for satellite " << d_satellite << '\n';
                                                         std::cout << d_systemName << " " << d_signal_pretty_name << " tracking bit synchronization locked in channel " << d_channel
-                                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                                                  << " for satellite " << d_satellite << '\n';
                                                     }
                                             }
                                     }
@@ -1868,8 +2586,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 d_P_data_accu = gr_complex(0.0, 0.0);
                                 d_L_accu = gr_complex(0.0, 0.0);
                                 d_VL_accu = gr_complex(0.0, 0.0);
-                                d_Prompt_circular_buffer.clear();
-                                d_current_symbol = 0;
+                                d_secondary_sync.clear();
+                                d_current_symbol = static_cast<int32_t>(d_secondary_sync_shift);
                                 d_current_data_symbol = 0;
 
                                 if (d_enable_extended_integration)
@@ -1880,10 +2598,10 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                         d_state = 3;  // next state is the extended correlator integrator
                                         LOG(INFO) << "Enabled " << d_trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
                                                   << d_channel
-                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+                                                  << " for satellite " << d_satellite;
                                         std::cout << "Enabled " << d_trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
                                                   << d_channel
-                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                                                  << " for satellite " << d_satellite << '\n';
                                         // Set narrow taps delay values [chips]
                                         d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
                                         d_code_loop_filter.set_noise_bandwidth(d_trk_parameters.dll_bw_narrow_hz);
@@ -1920,7 +2638,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
             {
                 // perform a correlation step
                 do_correlation_step(in);
-                save_correlation_results();
+                (this->*d_save_correlation_results)();
                 update_tracking_vars();
                 if (d_current_data_symbol == 0)
                     {
@@ -1958,10 +2676,10 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
             {
                 // perform a correlation step
                 do_correlation_step(in);
-                save_correlation_results();
+                (this->*d_save_correlation_results)();
 
                 // check lock status
-                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_trk_parameters.extend_correlation_symbols)))
+                if (!cn0_and_tracking_lock_status(d_current_correlation_time_s))
                     {
                         clear_tracking_vars();
                         d_state = 0;                                         // loss-of-lock detected
@@ -1970,7 +2688,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     }
                 else
                     {
-                        run_dll_pll();
+                        (this->*d_run_dll_pll)();
                         update_tracking_vars();
                         check_carrier_phase_coherent_initialization();
                         if (d_current_data_symbol == 0)
@@ -2005,6 +2723,10 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_P_accu = gr_complex(0.0, 0.0);
                         d_L_accu = gr_complex(0.0, 0.0);
                         d_VL_accu = gr_complex(0.0, 0.0);
+                        if (d_trk_parameters.adaptive_correlation)
+                            {
+                                update_adaptive_correlation();
+                            }
                         if (d_enable_extended_integration)
                             {
                                 d_state = 3;  // new coherent integration (correlation time extension) cycle
@@ -2014,33 +2736,39 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         }
 
     // time tags
-    std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples);
-    for (const auto &it : tags_vec)
+    if (d_time_map != nullptr)
         {
-            try
+            read_time_map();
+        }
+    else
+        {
+            this->get_tags_in_range(d_tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples, d_timetag_key);
+            for (const auto &it : d_tags_vec)
                 {
-                    if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
+                    try
                         {
-                            // std::cout << "ch[" << d_acquisition_gnss_synchro->Channel_ID << "] tracking time tag with offset " << it->offset << " vs. counter " << d_sample_counter << " vs. nread " << this->nitems_read(0) << " containing ";
-                            // std::cout << "ch[" << d_acquisition_gnss_synchro->Channel_ID << "] tracking time tag with offset " << it->offset << " vs. nread " << this->nitems_read(0) << " containing ";
-                            const auto last_timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
-                            d_last_timetag = *last_timetag;
-                            d_last_timetag_samplecounter = it.offset;
-                            d_timetag_waiting = true;
+                            if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
+                                {
+                                    // std::cout << "ch[" << d_acquisition_gnss_synchro->Channel_ID << "] tracking time tag with offset " << it->offset << " vs. counter " << d_sample_counter << " vs. nread " << this->nitems_read(0) << " containing ";
+                                    // std::cout << "ch[" << d_acquisition_gnss_synchro->Channel_ID << "] tracking time tag with offset " << it->offset << " vs. nread " << this->nitems_read(0) << " containing ";
+                                    const auto last_timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
+                                    d_last_timetag = *last_timetag;
+                                    d_last_timetag_samplecounter = it.offset + d_gap_samples;
+                                    d_timetag_waiting = true;
+                                }
+                            else
+                                {
+                                    std::cout << "hash code not match\n";
+                                }
                         }
-                    else
+                    catch (const boost::bad_any_cast &e)
                         {
-                            std::cout << "hash code not match\n";
+                            std::cout << "msg Bad any_cast: " << e.what();
+                        }
+                    catch (std::exception &ex)
+                        {
+                            LOG(WARNING) << "Bad any_cast: " << ex.what();
                         }
-                }
-            catch (const boost::bad_any_cast &e)
-                {
-                    std::cout << "msg Bad any_cast: " << e.what();
-                }
-            catch (std::exception &ex)
-                {
-                    LOG(WARNING) << "Bad any_cast: " << ex.what();
                 }
         }
 
@@ -2049,10 +2777,10 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
     if (current_synchro_data.Flag_valid_symbol_output || loss_of_lock)
         {
             current_synchro_data.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
-            current_synchro_data.Tracking_sample_counter = this->nitems_read(0);
+            current_synchro_data.Tracking_sample_counter = this->nitems_read(0) + d_gap_samples;
             current_synchro_data.Flag_valid_symbol_output = !loss_of_lock;
             current_synchro_data.Flag_PLL_180_deg_phase_locked = d_Flag_PLL_180_deg_phase_locked;
-            *out[0] = current_synchro_data;
+            write_tracking_item(output_items[0], 0, d_trk_parameters.compact_output, current_synchro_data);
 
             // generate new tag associated with gnss-synchro object
 
@@ -2068,7 +2796,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     tmp_obj->tow_ms = d_last_timetag.tow_ms + static_cast<int>(intpart);
                     tmp_obj->tow_ms_fraction = d_last_timetag.tow_ms_fraction;
                     tmp_obj->rx_time = static_cast<double>(current_synchro_data.Tracking_sample_counter) / d_trk_parameters.fs_in;
-                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    add_item_tag(0, this->nitems_written(0) + 1, d_timetag_key, pmt::make_any(tmp_obj));
 
                     // std::cout << "[" << this->nitems_written(0) + 1 << "][diff_time: " << 1000.0 * static_cast<double>(diff_samplecount) / d_trk_parameters.fs_in << "] Sent TimeTag Week: " << d_last_timetag.week << ", TOW: " << d_last_timetag.tow_ms << " [ms], TOW fraction: " << d_last_timetag.tow_ms_fraction << " [ms] \n";
                     d_timetag_waiting = false;
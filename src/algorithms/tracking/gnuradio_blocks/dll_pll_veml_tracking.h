@@ -18,12 +18,21 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "cpu_multicorrelator_16sc.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
+#include "dll_pll_signal_traits.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "gnss_satellite.h"
+#include "gnss_sdr_time_map.h"
 #include "gnss_time.h"                // for timetags produced by File_Timestamp_Signal_Source
+#include "lock_detectors.h"
+#include "secondary_code_sync.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_correlator_service.h"
+#include "tracking_dump_writer.h"
+#include "tracking_gpu_correlator.h"
 #include "tracking_loop_filter.h"     // for DLL filter
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
@@ -31,12 +40,15 @@
 #include <gnuradio/types.h>                   // for gr_vector_int, gr_vector...
 #include <pmt/pmt.h>                          // for pmt_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <atomic>                             // for atomic
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
 #include <fstream>                            // for ofstream
+#include <memory>                             // for shared_ptr
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
+#include <vector>                             // for vector
 
 /** \addtogroup Tracking
  * \{ */
@@ -45,6 +57,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
 class dll_pll_veml_tracking;
 
@@ -65,6 +78,18 @@ public:
     void start_tracking();
     void stop_tracking();
 
+    /*!
+     * \brief Pauses or resumes the dumps set in the configuration. Returns
+     * false if they were not set.
+     */
+    bool set_dump_enabled(bool enabled);
+
+    /*!
+     * \brief Takes the time tags of the input from time_map, instead of
+     * searching them in the input at every PRN period
+     */
+    void set_time_map(std::shared_ptr<const Gnss_Time_Map> time_map);
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
 
@@ -75,23 +100,67 @@ private:
     explicit dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
-    void do_correlation_step(const gr_complex *input_samples);
+    /*
+     * Binds the hot path of the loop (CPU correlators, discriminators and
+     * accumulation of the correlations) to its instance for signal S, where
+     * the signal constants, the number of correlators and whether the pilot
+     * is tracked are known at compile time. Called once, at construction.
+     */
+    template <Dll_Pll_Signal S>
+    void bind_signal_loop();
+    void do_correlation_step(const void *input_items);
+    template <Dll_Pll_Signal S, bool Pilot>
+    void do_correlation_step_cpu(const gr_complex *input_samples);
+    void do_correlation_step_16sc(const lv_16sc_t *input_samples);
+    bool do_correlation_step_gpu(const gr_complex *input_samples);
+    void set_gpu_local_code(int32_t &code_id, const float *code, int32_t code_length);
+    void set_data_local_code(int32_t code_length);
+    template <Dll_Pll_Signal S>
     void run_dll_pll();
     void check_carrier_phase_coherent_initialization();
     void update_tracking_vars();
+    /*
+     * Advances the local replica over the samples lost by the signal source
+     * in the next block (sample_gap tags in d_tags_vec), up to the first PRN
+     * boundary after the gap, and counts the symbols lost. Returns the
+     * number of samples to skip.
+     */
+    int32_t coast_sample_gap();
+    // Adds the gaps in the next consumed_samples input samples, when not coasting through them
+    void count_sample_gaps(int32_t consumed_samples);
+    // Takes the newest time map segment that starts in the current PRN period or before, if not taken yet
+    void read_time_map();
+    void advance_code_period();
     void clear_tracking_vars();
+    template <Dll_Pll_Signal S, bool Pilot>
     void save_correlation_results();
+    void update_adaptive_correlation();
+    void set_strong_signal_mode(bool strong);
     void log_data();
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
+    void set_secondary_sync();
     int64_t uint64diff(uint64_t first, uint64_t second);
     int32_t save_matfile() const;
 
     Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
+    std::vector<Tracking_Correlator_Service::Job> d_correlation_jobs;
+    Cpu_Multicorrelator_16sc d_multicorrelator_16sc;  // for cshort input
+    Cpu_Multicorrelator_16sc d_correlator_data_16sc;
+    std::vector<Tracking_Gpu_Correlator::Job> d_gpu_jobs;
+    Tracking_Gpu_Correlator *d_gpu_correlator{nullptr};  // nullptr if correlating in the CPU
+    int32_t d_gpu_tracking_code_id{-1};
+    int32_t d_gpu_data_code_id{-1};
+
+    // Instances of the hot path for the tracked signal, see bind_signal_loop()
+    void (dll_pll_veml_tracking::*d_correlation_step_cpu)(const gr_complex *){nullptr};
+    void (dll_pll_veml_tracking::*d_run_dll_pll)(){nullptr};
+    void (dll_pll_veml_tracking::*d_save_correlation_results)(){nullptr};
 
     Dll_Pll_Conf d_trk_parameters;
 
+    Cn0_Estimation_Window d_cn0_window;
     Exponential_Smoother d_cn0_smoother;
     Exponential_Smoother d_carrier_lock_test_smoother;
 
@@ -105,15 +174,26 @@ private:
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
-    volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<lv_16sc_t> d_tracking_code_16sc;
+    volk_gnsssdr::vector<lv_16sc_t> d_data_code_16sc;
+    volk_gnsssdr::vector<lv_16sc_t> d_correlator_outs_16sc;
+    volk_gnsssdr::vector<lv_16sc_t> d_Prompt_Data_16sc;
 
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
     boost::circular_buffer<std::pair<double, double>> d_carr_ph_history;
-    boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
+
+    Secondary_Code_Sync d_secondary_sync;  // signs of the last prompts, against the packed code
 
     const size_t int_type_hash_code = typeid(int).hash_code();
 
+    // Created at construction, so that general_work does not allocate them
+    std::vector<gr::tag_t> d_tags_vec;
+    pmt::pmt_t d_events_port;
+    pmt::pmt_t d_loss_of_lock_event;
+    pmt::pmt_t d_timetag_key;
+    Gnss_Satellite d_satellite;
+
     double d_signal_carrier_freq;
     double d_code_period;
     double d_code_chip_rate;
@@ -128,6 +208,8 @@ private:
     double d_code_freq_chips;
     double d_carrier_doppler_hz;
     double d_acc_carrier_phase_rad;
+    double d_carrier_offset_hz;        // GLONASS frequency channel offset, removed by the NCO but not part of the Doppler
+    double d_carrier_offset_step_rad;  // NCO phase increment per sample of d_carrier_offset_hz
     double d_rem_code_phase_chips;
     double d_T_chip_seconds;
     double d_T_prn_seconds;
@@ -164,11 +246,20 @@ private:
     std::string d_dump_filename;
 
     std::ofstream d_dump_file;
+    std::shared_ptr<Tracking_Dump_Writer::Stream> d_dump_stream;  // if dump_async
+    std::shared_ptr<Gnss_Block_Stats> d_work_stats;
+    std::shared_ptr<const Gnss_Time_Map> d_time_map;
 
     // uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
     GnssTime d_last_timetag{};
     uint64_t d_last_timetag_samplecounter;
+    uint64_t d_time_map_version{0};  // version of the last time map segment taken
+    uint64_t d_gap_samples;       // samples lost by the source, added to Tracking_sample_counter
+    uint64_t d_gap_counted_end;   // input sample after the last gap already counted
+    double d_gap_symbol_counter;  // sample counter of the next symbol lost in a gap
+    double d_gap_symbol_samples;
+    uint64_t d_work_allocations{0ULL};  // only counted in Debug builds
     bool d_timetag_waiting;
 
     float *d_prompt_data_shift;
@@ -178,20 +269,24 @@ private:
     int32_t d_state;
     int32_t d_correlation_length_ms;
     int32_t d_n_correlator_taps;
+    int32_t d_first_correlator_tap;  // first correlator computed, 1 if Very Early and Very Late are disabled
     int32_t d_current_prn_length_samples;
     int32_t d_extend_correlation_symbols_count;
     int32_t d_current_symbol;
     int32_t d_current_data_symbol;
-    int32_t d_cn0_estimation_counter;
     int32_t d_carrier_lock_fail_counter;
     int32_t d_code_lock_fail_counter;
     int32_t d_code_samples_per_chip;  // All signals have 1 sample per chip code except Gal. E1 which has 2 (CBOC disabled) or 12 (CBOC enabled)
     int32_t d_code_length_chips;
+    int32_t d_gap_skip_samples;  // samples still to skip after a gap
+    int32_t d_gap_symbols;       // symbols lost in a gap, not yet sent to telemetry
 
     uint32_t d_channel;
     uint32_t d_secondary_code_length;
     uint32_t d_data_secondary_code_length;
+    uint32_t d_secondary_sync_shift;  // secondary code chip of the first symbol after synchronization
 
+    bool d_use_16sc;
     bool d_pull_in_transitory;
     bool d_corrected_doppler;
     bool d_interchange_iq;
@@ -202,7 +297,9 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_strong_signal_mode;
     bool d_Flag_PLL_180_deg_phase_locked;
+    std::atomic<bool> d_dump_paused;
 };
 
 
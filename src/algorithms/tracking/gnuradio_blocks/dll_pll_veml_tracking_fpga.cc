@@ -28,6 +28,7 @@
 #include "Galileo_E5a.h"
 #include "MATH_CONSTANTS.h"
 #include "fpga_multicorrelator.h"
+#include "fpga_tracking_result_ring.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
@@ -430,7 +431,7 @@ dll_pll_veml_tracking_fpga::dll_pll_veml_tracking_fpga(const Dll_Pll_Conf_Fpga &
     // create multicorrelator class
     int32_t *ca_codes = d_trk_parameters.ca_codes;
     int32_t *data_codes = d_trk_parameters.data_codes;
-    d_multicorrelator_fpga = std::make_shared<Fpga_Multicorrelator_8sc>(d_n_correlator_taps, ca_codes, data_codes, d_code_length_chips, d_trk_parameters.track_pilot, d_code_samples_per_chip);
+    d_multicorrelator_fpga = std::make_shared<Fpga_Multicorrelator_8sc>(d_n_correlator_taps, ca_codes, data_codes, d_code_length_chips, d_trk_parameters.track_pilot, d_code_samples_per_chip, d_trk_parameters.code_banks);
     d_multicorrelator_fpga->set_output_vectors(d_correlator_outs.data(), d_Prompt_Data.data());
 
     if (d_dump)
@@ -1305,6 +1306,16 @@ int32_t dll_pll_veml_tracking_fpga::save_matfile() const
 }
 
 
+void dll_pll_veml_tracking_fpga::set_result_ring(const std::string &ring_io_name)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_multicorrelator_fpga->set_result_ring(Fpga_Tracking_Result_Ring::get(ring_io_name,
+        d_trk_parameters.result_ring_irq_entries,
+        d_trk_parameters.result_ring_irq_timeout_us));
+    LOG(INFO) << "Tracking channel " << d_channel << " results delivered through " << ring_io_name;
+}
+
+
 void dll_pll_veml_tracking_fpga::set_channel(uint32_t channel, const std::string &device_io_name)
 {
     gr::thread::scoped_lock l(d_setlock);
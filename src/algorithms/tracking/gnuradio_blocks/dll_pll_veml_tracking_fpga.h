@@ -68,6 +68,13 @@ public:
      */
     void set_channel(uint32_t channel, const std::string &device_io_name);
 
+    /*!
+     * \brief Receive the correlation results through the FPGA result ring of
+     * the UIO device ring_io_name, shared with the other channels. Must be
+     * called after set_channel.
+     */
+    void set_result_ring(const std::string &ring_io_name);
+
     /*!
      * \brief This function is used with two purposes:
      * 1 -> To set the gnss_synchro
@@ -52,10 +52,11 @@ galileo_e1_tcp_connector_tracking_cc_sptr galileo_e1_tcp_connector_make_tracking
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batched_loop)
 {
     return galileo_e1_tcp_connector_tracking_cc_sptr(new Galileo_E1_Tcp_Connector_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0, batched_loop));
 }
 
 
@@ -78,7 +79,8 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
     float dll_bw_hz __attribute__((unused)),
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batched_loop)
     : gr::block("Galileo_E1_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_vector_length(vector_length),
@@ -101,6 +103,7 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
       d_acc_code_phase_secs(0.0),
       d_code_phase_samples(0),
       d_port_ch0(port_ch0),
+      d_batched_loop(batched_loop),
       d_port(0),
       d_listen_connection(true),
       d_control_id(0),
@@ -245,7 +248,16 @@ void Galileo_E1_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
     if (d_listen_connection == true)
         {
             d_port = d_port_ch0 + d_channel;
-            d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+            if (d_batched_loop)
+                {
+                    // all the channels share a single connection on port_ch0
+                    d_tcp_com.connect_batched_loop(d_port_ch0, d_channel);
+                    d_listen_connection = false;
+                }
+            else
+                {
+                    d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+                }
         }
 }
 
@@ -54,7 +54,8 @@ galileo_e1_tcp_connector_make_tracking_cc(
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    bool batched_loop);
 
 /*!
  * \brief This class implements a code DLL + carrier PLL VEML (Very Early
@@ -84,7 +85,8 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batched_loop);
 
     Galileo_E1_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
@@ -94,7 +96,8 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batched_loop);
 
     void update_local_code();
 
@@ -143,6 +146,7 @@ private:
     float d_acc_code_phase_secs;
     float d_code_phase_samples;
     size_t d_port_ch0;
+    bool d_batched_loop;
     size_t d_port;
     int32_t d_listen_connection;
     float d_control_id;
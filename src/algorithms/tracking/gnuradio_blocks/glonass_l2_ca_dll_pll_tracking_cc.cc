@@ -54,10 +54,11 @@ glonass_l2_ca_dll_pll_tracking_cc_sptr glonass_l2_ca_dll_pll_make_tracking_cc(
     const std::string &dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips)
+    float early_late_space_chips,
+    int32_t fdma_decimation)
 {
     return glonass_l2_ca_dll_pll_tracking_cc_sptr(new Glonass_L2_Ca_Dll_Pll_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, fdma_decimation));
 }
 
 
@@ -78,13 +79,16 @@ Glonass_L2_Ca_Dll_Pll_Tracking_cc::Glonass_L2_Ca_Dll_Pll_Tracking_cc(
     const std::string &dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips)
+    float early_late_space_chips,
+    int32_t fdma_decimation)
     : gr::block("Glonass_L1_Ca_Dll_Pll_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_dump_filename(dump_filename),
       d_acquisition_gnss_synchro(nullptr),
       d_fs_in(fs_in),
       d_glonass_freq_ch(0),
+      d_glonass_slot(0),
+      d_fdma_decimation(std::max(fdma_decimation, 1)),
       d_early_late_spc_chips(early_late_space_chips),
       d_vector_length(vector_length),
       d_channel(0),
@@ -136,6 +140,10 @@ Glonass_L2_Ca_Dll_Pll_Tracking_cc::Glonass_L2_Ca_Dll_Pll_Tracking_cc(
     multicorrelator_cpu.init(2 * d_current_prn_length_samples, d_n_correlator_taps);
 
     d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(FLAGS_cn0_samples);
+    if (d_fdma_decimation > 1)
+        {
+            d_fdma_samples = volk_gnsssdr::vector<gr_complex>(2 * d_vector_length / d_fdma_decimation + 1);
+        }
 
     systemName["R"] = std::string("Glonass");
 
@@ -157,7 +165,8 @@ void Glonass_L2_Ca_Dll_Pll_Tracking_cc::start_tracking()
     const double acq_trk_diff_seconds = static_cast<float>(acq_trk_diff_samples) / static_cast<float>(d_fs_in);
     // Doppler effect
     // Fd=(C/(C+Vr))*F
-    d_glonass_freq_ch = GLONASS_L2_CA_FREQ_HZ + (DFRQ2_GLO * GLONASS_PRN.at(d_acquisition_gnss_synchro->PRN));
+    d_glonass_slot = GLONASS_PRN.at(d_acquisition_gnss_synchro->PRN);
+    d_glonass_freq_ch = GLONASS_L2_CA_FREQ_HZ + (DFRQ2_GLO * d_glonass_slot);
     const double radial_velocity = (d_glonass_freq_ch + d_acq_carrier_doppler_hz) / d_glonass_freq_ch;
     // new chip and prn sequence periods based on acq Doppler
     d_code_freq_chips = radial_velocity * GLONASS_L2_CA_CODE_RATE_CPS;
@@ -523,12 +532,40 @@ int Glonass_L2_Ca_Dll_Pll_Tracking_cc::general_work(int noutput_items __attribut
 
             // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
             // perform carrier wipe-off and compute Early, Prompt and Late correlation
-            multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), in);
-            multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
-                static_cast<float>(d_carrier_phase_step_rad),
-                static_cast<float>(d_rem_code_phase_chips),
-                static_cast<float>(d_code_phase_step_chips),
-                d_current_prn_length_samples);
+            if (d_fdma_decimation > 1)
+                {
+                    // correlate the decimated samples of the slot, shared with the other channels
+                    if (d_fdma_channelizer == nullptr)
+                        {
+                            d_fdma_channelizer = Glonass_Fdma_Channelizer::shared(this->detail()->input(0)->buffer().get(),
+                                d_fs_in, static_cast<int64_t>(DFRQ2_GLO), d_fdma_decimation);
+                        }
+                    uint64_t first_output = 0;
+                    const int32_t n_decimated = d_fdma_channelizer->translate(d_glonass_slot, d_sample_counter, in,
+                        d_current_prn_length_samples, d_fdma_samples.data(), first_output);
+                    // the decimated samples are taken at the centre of their dumps
+                    const uint64_t first_dump_sample = first_output * static_cast<uint64_t>(d_fdma_decimation);
+                    const double half_dump_samples = 0.5 * static_cast<double>(d_fdma_decimation - 1);
+                    const double offset_samples = static_cast<double>(first_dump_sample - d_sample_counter) + half_dump_samples;
+                    const double slot_phase_rad = d_fdma_channelizer->translation_phase_rad(d_glonass_slot, first_dump_sample) +
+                                                  TWO_PI * DFRQ2_GLO * d_glonass_slot * half_dump_samples / static_cast<double>(d_fs_in);
+                    const double rem_carr_phase_rad = std::fmod(d_rem_carr_phase_rad + d_carrier_phase_step_rad * offset_samples - slot_phase_rad, TWO_PI);
+                    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), d_fdma_samples.data());
+                    multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(static_cast<float>(rem_carr_phase_rad),
+                        static_cast<float>(d_carrier_doppler_phase_step_rad * d_fdma_decimation),
+                        static_cast<float>(d_rem_code_phase_chips + d_code_phase_step_chips * offset_samples),
+                        static_cast<float>(d_code_phase_step_chips * d_fdma_decimation),
+                        n_decimated);
+                }
+            else
+                {
+                    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), in);
+                    multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
+                        static_cast<float>(d_carrier_phase_step_rad),
+                        static_cast<float>(d_rem_code_phase_chips),
+                        static_cast<float>(d_code_phase_step_chips),
+                        d_current_prn_length_samples);
+                }
 
             // ################## PLL ##########################################################
             // PLL discriminator
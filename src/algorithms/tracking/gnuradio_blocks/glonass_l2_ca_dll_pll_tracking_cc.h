@@ -24,6 +24,7 @@
 #define GNSS_SDR_GLONASS_L2_CA_DLL_PLL_TRACKING_CC_H
 
 #include "cpu_multicorrelator.h"
+#include "glonass_fdma_channelizer.h"
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
@@ -32,6 +33,7 @@
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 /** \addtogroup Tracking
@@ -51,7 +53,8 @@ glonass_l2_ca_dll_pll_make_tracking_cc(
     const std::string& dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips);
+    float early_late_space_chips,
+    int32_t fdma_decimation = 1);
 
 
 /*!
@@ -79,7 +82,8 @@ private:
         const std::string& dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        int32_t fdma_decimation);
 
     Glonass_L2_Ca_Dll_Pll_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
@@ -87,7 +91,8 @@ private:
         const std::string& dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        int32_t fdma_decimation);
 
     void check_carrier_phase_coherent_initialization();
 
@@ -96,6 +101,7 @@ private:
     volk_gnsssdr::vector<gr_complex> d_ca_code;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<gr_complex> d_fdma_samples;
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
 
     Cpu_Multicorrelator multicorrelator_cpu;
@@ -113,9 +119,14 @@ private:
 
     Gnss_Synchro* d_acquisition_gnss_synchro;
 
+    // slot translation and decimation shared with the other channels of the band
+    std::shared_ptr<Glonass_Fdma_Channelizer> d_fdma_channelizer;
+
     // tracking configuration vars
     int64_t d_fs_in;
     int64_t d_glonass_freq_ch;
+    int32_t d_glonass_slot;
+    int32_t d_fdma_decimation;
     double d_early_late_spc_chips;
     uint32_t d_vector_length;
     uint32_t d_channel;
@@ -24,6 +24,7 @@
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 #include <cmath>
 #include <cuda_profiler_api.h>
 #include <iostream>
@@ -39,10 +40,12 @@ gps_l1_ca_dll_pll_make_tracking_gpu_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips)
+    float early_late_space_chips,
+    float input_ring_ms,
+    int32_t channel_groups)
 {
     return gps_l1_ca_dll_pll_tracking_gpu_cc_sptr(new Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, input_ring_ms, channel_groups));
 }
 
 
@@ -63,7 +66,9 @@ Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips) : gr::block("Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    float early_late_space_chips,
+    float input_ring_ms,
+    int32_t channel_groups) : gr::block("Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
                                         gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     // Telemetry bit synchronization message port input
@@ -107,6 +112,13 @@ Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
     // local code resampler on GPU
     multicorrelator_gpu->init_cuda_integrated_resampler(2 * d_vector_length, GPS_L1_CA_CODE_LENGTH_CHIPS, d_n_correlator_taps);
     multicorrelator_gpu->set_input_output_vectors(d_correlator_outs, in_gpu);
+    if (input_ring_ms > 0.0)
+        {
+            // input samples kept in device memory and shared by all the GPU channels,
+            // at least large enough to serve a few correlations of the lagging channels
+            const auto ring_samples = static_cast<int32_t>(std::ceil(static_cast<double>(fs_in) * input_ring_ms / 1000.0));
+            multicorrelator_gpu->set_sample_ring(std::max(ring_samples, 16 * static_cast<int32_t>(d_vector_length)), channel_groups);
+        }
 
     // define initial code frequency basis of NCO
     d_code_freq_chips = GPS_L1_CA_CODE_RATE_CPS;
@@ -349,13 +361,22 @@ int Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc::general_work(int noutput_items __attribut
             // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
             // perform carrier wipe-off and compute Early, Prompt and Late correlation
 
-            memcpy(in_gpu, in, sizeof(gr_complex) * d_correlation_length_samples);
             cudaProfilerStart();
-            multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_cuda(static_cast<float>(d_rem_carrier_phase_rad),
-                static_cast<float>(d_carrier_phase_step_rad),
-                static_cast<float>(d_code_phase_step_chips),
-                static_cast<float>(d_rem_code_phase_chips),
-                d_correlation_length_samples, d_n_correlator_taps);
+            // the input is uploaded once for all the channels, unless this channel lags too much
+            if (!multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_ring_cuda(nitems_read(0), in,
+                    static_cast<float>(d_rem_carrier_phase_rad),
+                    static_cast<float>(d_carrier_phase_step_rad),
+                    static_cast<float>(d_code_phase_step_chips),
+                    static_cast<float>(d_rem_code_phase_chips),
+                    d_correlation_length_samples, d_n_correlator_taps))
+                {
+                    memcpy(in_gpu, in, sizeof(gr_complex) * d_correlation_length_samples);
+                    multicorrelator_gpu->Carrier_wipeoff_multicorrelator_resampler_cuda(static_cast<float>(d_rem_carrier_phase_rad),
+                        static_cast<float>(d_carrier_phase_step_rad),
+                        static_cast<float>(d_code_phase_step_chips),
+                        static_cast<float>(d_rem_code_phase_chips),
+                        d_correlation_length_samples, d_n_correlator_taps);
+                }
             cudaProfilerStop();
             // std::cout<<"c_out[0]="<<d_correlator_outs[0]<<"c_out[1]="<<d_correlator_outs[1]<<"c_out[2]="<<d_correlator_outs[2]<< '\n';
 
@@ -51,7 +51,9 @@ gps_l1_ca_dll_pll_make_tracking_gpu_cc(
     std::string dump_filename,
     float pll_bw_hz,
     float dll_bw_hz,
-    float early_late_space_chips);
+    float early_late_space_chips,
+    float input_ring_ms,
+    int32_t channel_groups);
 
 
 /*!
@@ -80,7 +82,9 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        float input_ring_ms,
+        int32_t channel_groups);
 
     Gps_L1_Ca_Dll_Pll_Tracking_GPU_cc(
         int64_t fs_in,
@@ -89,7 +93,9 @@ private:
         std::string dump_filename,
         float pll_bw_hz,
         float dll_bw_hz,
-        float early_late_space_chips);
+        float early_late_space_chips,
+        float input_ring_ms,
+        int32_t channel_groups);
     void update_local_code();
     void update_local_carrier();
     void check_carrier_phase_coherent_initialization();
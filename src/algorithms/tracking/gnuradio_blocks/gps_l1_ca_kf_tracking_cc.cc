@@ -693,9 +693,10 @@ int Gps_L1_Ca_Kf_Tracking_cc::general_work(int noutput_items __attribute__((unus
                 }
 
             // Kalman filter update step
-            kf_K = (kf_P_x_pre * kf_H.t()) * arma::inv(kf_P_y);                 // Kalman gain
-            kf_x = kf_x_pre + kf_K * kf_y;                                      // updated state estimation
-            kf_P_x = (arma::eye(size(kf_P_x_pre)) - kf_K * kf_H) * kf_P_x_pre;  // update state estimation error covariance matrix
+            // The innovation is scalar, so its inverse is a division
+            kf_K = (kf_P_x_pre * kf_H.t()) / kf_P_y(0, 0);     // Kalman gain
+            kf_x = kf_x_pre + kf_K * kf_y;                     // updated state estimation
+            kf_P_x = kf_P_x_pre - kf_K * (kf_H * kf_P_x_pre);  // update state estimation error covariance matrix
 
             // Store Kalman filter results
             d_rem_carr_phase_rad = kf_x(0);  // set a new carrier Phase estimation to the NCO
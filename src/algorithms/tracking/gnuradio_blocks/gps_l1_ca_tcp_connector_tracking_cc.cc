@@ -46,10 +46,11 @@ gps_l1_ca_tcp_connector_tracking_cc_sptr gps_l1_ca_tcp_connector_make_tracking_c
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batched_loop)
 {
     return gps_l1_ca_tcp_connector_tracking_cc_sptr(new Gps_L1_Ca_Tcp_Connector_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, early_late_space_chips, port_ch0));
+        fs_in, vector_length, dump, dump_filename, early_late_space_chips, port_ch0, batched_loop));
 }
 
 
@@ -69,7 +70,8 @@ Gps_L1_Ca_Tcp_Connector_Tracking_cc::Gps_L1_Ca_Tcp_Connector_Tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    bool batched_loop)
     : gr::block("Gps_L1_Ca_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_acquisition_gnss_synchro(nullptr),
@@ -87,6 +89,7 @@ Gps_L1_Ca_Tcp_Connector_Tracking_cc::Gps_L1_Ca_Tcp_Connector_Tracking_cc(
       d_sample_counter(0ULL),
       d_acq_sample_stamp(0ULL),
       d_port_ch0(port_ch0),
+      d_batched_loop(batched_loop),
       d_port(0),
       d_vector_length(vector_length),
       d_channel(0),
@@ -272,7 +275,16 @@ void Gps_L1_Ca_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
     if (d_listen_connection == true)
         {
             d_port = d_port_ch0 + d_channel;
-            d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+            if (d_batched_loop)
+                {
+                    // all the channels share a single connection on port_ch0
+                    d_tcp_com.connect_batched_loop(d_port_ch0, d_channel);
+                    d_listen_connection = false;
+                }
+            else
+                {
+                    d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
+                }
         }
 }
 
@@ -49,7 +49,8 @@ gps_l1_ca_tcp_connector_make_tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    bool batched_loop);
 
 
 /*!
@@ -81,14 +82,16 @@ private:
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batched_loop);
 
     Gps_L1_Ca_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        bool batched_loop);
 
     volk_gnsssdr::vector<gr_complex> d_ca_code;
     // correlator
@@ -126,6 +129,7 @@ private:
     uint64_t d_acq_sample_stamp;
 
     size_t d_port_ch0;
+    bool d_batched_loop;
     size_t d_port;
 
     uint32_t d_vector_length;
@@ -71,6 +71,14 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
+
+namespace
+{
+// Older Doppler predictions from the PVT are discarded
+const double MAX_VTL_AIDING_AGE_S = 1.0;
+}  // namespace
+
+
 kf_vtl_tracking_sptr kf_vtl_make_tracking(const Kf_Conf &conf_)
 {
     return kf_vtl_tracking_sptr(new kf_vtl_tracking(conf_));
@@ -118,7 +126,6 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
       d_state(0),
       d_current_prn_length_samples(static_cast<int32_t>(d_trk_parameters.vector_length)),
       d_extend_correlation_symbols_count(0),
-      d_cn0_estimation_counter(0),
       d_carrier_lock_fail_counter(0),
       d_code_lock_fail_counter(0),
       d_pull_in_transitory(true),
@@ -518,7 +525,7 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
     d_code_freq_kf_chips_s = d_code_chip_rate;
 
     // CN0 estimation and lock detector buffers
-    d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.cn0_samples);
+    d_cn0_window = Cn0_Estimation_Window(d_trk_parameters.cn0_samples);
 
     d_Prompt_Data = volk_gnsssdr::vector<gr_complex>(1);
     d_cn0_smoother = Exponential_Smoother();
@@ -615,6 +622,19 @@ void kf_vtl_tracking::msg_handler_pvt_to_trk(const pmt::pmt_t &msg)
                     // std::cout << "RX pvt-to-trk cmd with delay: "
                     //           << static_cast<double>(nitems_read(0) - cmd->sample_counter) / d_trk_parameters.fs_in << " [s]\n";
                 }
+            else if (pmt::any_ref(msg).type().hash_code() == typeid(const std::shared_ptr<TrackingCmdMap>).hash_code())
+                {
+                    // The PVT sends the commands of all the channels in one message
+                    const auto cmds = wht::any_cast<const std::shared_ptr<TrackingCmdMap>>(pmt::any_ref(msg));
+                    gr::thread::scoped_lock l(d_setlock);
+                    const auto it = cmds->find(d_channel);
+                    if (d_trk_parameters.enable_vtl_aiding and d_state > 1 and it != cmds->cend() and
+                        it->second.enable_carrier_nco_cmd and it->second.PRN == d_acquisition_gnss_synchro->PRN)
+                        {
+                            d_vtl_cmd = it->second;
+                            d_vtl_cmd_pending = true;
+                        }
+                }
             else
                 {
                     std::cout << "hash code not match\n";
@@ -803,7 +823,7 @@ void kf_vtl_tracking::start_tracking()
     d_rem_carr_phase_rad = 0.0;
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
-    d_cn0_estimation_counter = 0;
+    d_cn0_window.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -835,6 +855,7 @@ void kf_vtl_tracking::start_tracking()
     d_Prompt_circular_buffer.clear();
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
+    d_vtl_cmd_pending = false;
 }
 
 
@@ -843,7 +864,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
     // Kalman Filter class variables
     const double Ti = d_correlation_length_ms * 0.001;
     // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz,carrier_freq_rate_hz, code_freq_chips_s
-    d_F = arma::mat(5, 5);
     d_F << 1 << 0 << 0 << 0 << Ti << arma::endr
         << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
         << 0 << 0 << 1 << Ti << 0 << arma::endr
@@ -852,7 +872,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
 
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
     d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
         << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
 
@@ -863,7 +882,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
     // const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
     //    d_R << Sigma2_Tau << 0 << arma::endr
     //      << 0 << Sigma2_Phase << arma::endr;
 
@@ -871,7 +889,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
         << 0 << pow(d_trk_parameters.carrier_disc_sd_rads, 2.0) << arma::endr;
 
     // system covariance matrix (static)
-    d_Q = arma::mat(5, 5);
     d_Q << pow(d_trk_parameters.code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
         << 0 << pow(d_trk_parameters.carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
         << 0 << 0 << pow(d_trk_parameters.carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
@@ -879,7 +896,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
         << 0 << 0 << 0 << 0 << pow(d_trk_parameters.code_rate_sd_chips_s, 2.0) << arma::endr;
 
     // initial Kalman covariance matrix
-    d_P_old_old = arma::mat(5, 5);
 
     d_P_old_old << pow(d_trk_parameters.init_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
                 << 0 << pow(d_trk_parameters.init_carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
@@ -888,7 +904,6 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
                 << 0 << 0 << 0 << 0 << pow(d_trk_parameters.init_code_rate_sd_chips_s, 2.0) << arma::endr;
 
     // init state vector
-    d_x_old_old = arma::vec(5);
     // states: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz_s, code_freq_rate_chips_s
     d_x_old_old << acq_code_phase_chips << 0 << acq_doppler_hz << 0 << 0 << arma::endr;
 
@@ -937,7 +952,6 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Ti = d_correlation_length_ms * 0.001;
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
     d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
         << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
 
@@ -948,7 +962,6 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
     d_R << Sigma2_Tau << 0 << arma::endr
         << 0 << Sigma2_Phase << arma::endr;
 }
@@ -1035,21 +1048,16 @@ bool kf_vtl_tracking::acquire_secondary()
 bool kf_vtl_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-    if (d_cn0_estimation_counter < d_trk_parameters.cn0_samples)
+    d_cn0_window.push(d_P_accu);
+    if (!d_cn0_window.full())
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
-            d_cn0_estimation_counter++;
             return true;
         }
-
-    d_Prompt_buffer[d_cn0_estimation_counter % d_trk_parameters.cn0_samples] = d_P_accu;
-    d_cn0_estimation_counter++;
-    // Code lock indicator
-    const float d_CN0_SNV_dB_Hz_raw = cn0_m2m4_estimator(d_Prompt_buffer.data(), d_trk_parameters.cn0_samples, static_cast<float>(coh_integration_time_s));
+    // Code lock indicator, refreshed every prompt with the running sums of the window
+    const float d_CN0_SNV_dB_Hz_raw = d_cn0_window.cn0_m2m4(static_cast<float>(coh_integration_time_s));
     d_CN0_SNV_dB_Hz = d_cn0_smoother.smooth(d_CN0_SNV_dB_Hz_raw);
-    // Carrier lock indicator
-    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(d_Prompt_buffer.data(), 1));
+    // Carrier lock indicator, from the last prompt
+    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(&d_P_accu, 1));
     // Loss of lock detection
     if (!d_pull_in_transitory)
         {
@@ -1125,8 +1133,37 @@ void kf_vtl_tracking::do_correlation_step(const gr_complex *input_samples)
 }
 
 
+// Fuses the carrier Doppler predicted by the PVT into the filter state, as a
+// scalar measurement of the carrier frequency with vtl_doppler_sd_hz error.
+void kf_vtl_tracking::apply_vtl_aiding()
+{
+    d_vtl_cmd_pending = false;
+    if (d_sample_counter < d_vtl_cmd.sample_counter)
+        {
+            return;
+        }
+    const double age_s = static_cast<double>(d_sample_counter - d_vtl_cmd.sample_counter) / d_trk_parameters.fs_in;
+    if (age_s > MAX_VTL_AIDING_AGE_S)
+        {
+            return;
+        }
+    // Predicted Doppler, propagated to the current epoch with the estimated Doppler rate
+    const double doppler_hz = -d_vtl_cmd.range_rate_m_s * d_signal_carrier_freq / SPEED_OF_LIGHT_M_S + d_x_old_old(3) * age_s;
+    const double innovation_var = d_P_old_old(2, 2) + d_trk_parameters.vtl_doppler_sd_hz * d_trk_parameters.vtl_doppler_sd_hz;
+    const arma::vec::fixed<5> K = d_P_old_old.col(2) / innovation_var;
+    d_x_old_old += K * (doppler_hz - d_x_old_old(2));
+    const arma::mat::fixed<5, 5> KP = K * d_P_old_old.row(2);
+    d_P_old_old -= KP;
+}
+
+
 void kf_vtl_tracking::run_Kf()
 {
+    if (d_vtl_cmd_pending)
+        {
+            apply_vtl_aiding();
+        }
+
     // Carrier discriminator
     if (d_cloop)
         {
@@ -1152,18 +1189,27 @@ void kf_vtl_tracking::run_Kf()
     // Kalman loop
 
     // Prediction
+    // The products are evaluated one at a time into fixed-size matrices, to
+    // avoid 5x5 temporaries in the heap
     d_x_new_old = d_F * d_x_old_old;
-    d_P_new_old = d_F * d_P_old_old * d_F.t() + d_Q;
+    const arma::mat::fixed<5, 5> FP = d_F * d_P_old_old;
+    d_P_new_old = FP * d_F.t();
+    d_P_new_old += d_Q;
 
     // Innovation
-    arma::vec z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
+    const arma::vec::fixed<2> z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
 
     // Measurement update
-    arma::mat K = d_P_new_old * d_H.t() * arma::inv(d_H * d_P_new_old * d_H.t() + d_R);  // Kalman gain
+    const arma::mat::fixed<5, 2> PHt = d_P_new_old * d_H.t();
+    arma::mat::fixed<2, 2> S = d_H * PHt;
+    S += d_R;
+    const arma::mat::fixed<5, 2> K = PHt * arma::inv(S);  // Kalman gain
 
     d_x_new_new = d_x_new_old + K * z;
 
-    d_P_new_new = (arma::eye(5, 5) - K * d_H) * d_P_new_old;
+    // (I - K * H) * P, with H * P = PHt.t() because P is symmetric
+    d_P_new_new = K * PHt.t();
+    d_P_new_new = d_P_new_old - d_P_new_new;
 
     // new code phase estimation
     d_code_error_kf_chips = d_x_new_new(0);
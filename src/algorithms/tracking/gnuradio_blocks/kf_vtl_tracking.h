@@ -30,8 +30,10 @@
 #include "gnss_block_interface.h"
 #include "gnss_time.h"  // for timetags produced by File_Timestamp_Signal_Source
 #include "kf_conf.h"
+#include "lock_detectors.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
+#include "trackingcmd.h"
 #include <armadillo>
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
@@ -80,6 +82,7 @@ private:
     void update_kf_narrow_integration_time();
     void update_kf_cn0(double current_cn0_dbhz);
     void run_Kf();
+    void apply_vtl_aiding();
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
     void msg_handler_pvt_to_trk(const pmt::pmt_t &msg);
@@ -99,6 +102,7 @@ private:
 
     Kf_Conf d_trk_parameters;
 
+    Cn0_Estimation_Window d_cn0_window;
     Exponential_Smoother d_cn0_smoother;
     Exponential_Smoother d_carrier_lock_test_smoother;
 
@@ -109,23 +113,23 @@ private:
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
-    volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
 
     boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
 
     const size_t d_int_type_hash_code = typeid(int).hash_code();
 
-    // Kalman Filter class variables
-    arma::mat d_F;
-    arma::mat d_H;
-    arma::mat d_R;
-    arma::mat d_Q;
-    arma::mat d_P_old_old;
-    arma::mat d_P_new_old;
-    arma::mat d_P_new_new;
-    arma::vec d_x_old_old;
-    arma::vec d_x_new_old;
-    arma::vec d_x_new_new;
+    // Kalman Filter class variables. Fixed-size, so they live in the object
+    // and the products of the update do not allocate
+    arma::mat::fixed<5, 5> d_F;
+    arma::mat::fixed<2, 5> d_H;
+    arma::mat::fixed<2, 2> d_R;
+    arma::mat::fixed<5, 5> d_Q;
+    arma::mat::fixed<5, 5> d_P_old_old;
+    arma::mat::fixed<5, 5> d_P_new_old;
+    arma::mat::fixed<5, 5> d_P_new_new;
+    arma::vec::fixed<5> d_x_old_old;
+    arma::vec::fixed<5> d_x_new_old;
+    arma::vec::fixed<5> d_x_new_new;
 
     std::string d_secondary_code_string;
     std::string d_data_secondary_code_string;
@@ -211,7 +215,6 @@ private:
     int32_t d_extend_correlation_symbols_count;
     int32_t d_current_symbol;
     int32_t d_current_data_symbol;
-    int32_t d_cn0_estimation_counter;
     int32_t d_carrier_lock_fail_counter;
     int32_t d_code_lock_fail_counter;
     int32_t d_code_samples_per_chip;  // All signals have 1 sample per chip code except Gal. E1 which has 2 (CBOC disabled) or 12 (CBOC enabled)
@@ -227,6 +230,9 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_vtl_cmd_pending{false};
+
+    TrackingCmd d_vtl_cmd;
 };
 
 #endif  // GNSS_SDR_KF_VTL_TRACKING_H
@@ -0,0 +1,43 @@
+/*!
+ * \file tracking_pinned_input.cc
+ * \brief Copies the output of a signal conditioner into a flow graph buffer
+ * in pinned host memory, shared by the channels it feeds
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_pinned_input.h"
+#include "tracking_pinned_buffer.h"
+#include <gnuradio/io_signature.h>
+#include <cstring>  // for memcpy
+
+
+tracking_pinned_input_sptr make_tracking_pinned_input()
+{
+    return tracking_pinned_input_sptr(new tracking_pinned_input());
+}
+
+
+tracking_pinned_input::tracking_pinned_input()
+    : gr::sync_block("tracking_pinned_input",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex), Tracking_Pinned_Buffer::type))
+{
+}
+
+
+int tracking_pinned_input::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    std::memcpy(output_items[0], input_items[0], sizeof(gr_complex) * noutput_items);
+    return noutput_items;
+}
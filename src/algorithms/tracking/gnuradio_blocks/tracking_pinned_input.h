@@ -0,0 +1,63 @@
+/*!
+ * \file tracking_pinned_input.h
+ * \brief Copies the output of a signal conditioner into a flow graph buffer
+ * in pinned host memory, shared by the channels it feeds
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_PINNED_INPUT_H
+#define GNSS_SDR_TRACKING_PINNED_INPUT_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_gnuradio_blocks
+ * \{ */
+
+
+class tracking_pinned_input;
+
+using tracking_pinned_input_sptr = gnss_shared_ptr<tracking_pinned_input>;
+
+tracking_pinned_input_sptr make_tracking_pinned_input();
+
+/*!
+ * \brief Sync block with an output buffer of type Tracking_Pinned_Buffer.
+ *
+ * GNU Radio only replaces the upstream buffer for a reader that asks for a
+ * custom input buffer, which would leave the readers already attached to the
+ * old one behind. Declaring the custom buffer on the output of this block
+ * instead puts all the channels of a signal conditioner, with CPU or GPU
+ * tracking, on the same pinned buffer, at the cost of one copy of the
+ * stream. Item counts are preserved, so the sample stamps of the channels
+ * do not change.
+ */
+class tracking_pinned_input : public gr::sync_block
+{
+public:
+    ~tracking_pinned_input() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend tracking_pinned_input_sptr make_tracking_pinned_input();
+    tracking_pinned_input();
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_PINNED_INPUT_H
@@ -30,6 +30,7 @@ bool Cpu_Multicorrelator_16sc::init(
     size_t size = max_signal_length_samples * sizeof(lv_16sc_t);
 
     d_n_correlators = n_correlators;
+    d_max_correlators = n_correlators;
 
     d_local_codes_resampled = static_cast<lv_16sc_t**>(volk_gnsssdr_malloc(n_correlators * sizeof(lv_16sc_t*), volk_gnsssdr_get_alignment()));
     for (int n = 0; n < n_correlators; n++)
@@ -52,6 +53,18 @@ bool Cpu_Multicorrelator_16sc::set_local_code_and_taps(
 }
 
 
+bool Cpu_Multicorrelator_16sc::set_taps(float* shifts_chips, int n_correlators)
+{
+    if (n_correlators < 1 or n_correlators > d_max_correlators)
+        {
+            return false;
+        }
+    d_shifts_chips = shifts_chips;
+    d_n_correlators = n_correlators;
+    return true;
+}
+
+
 bool Cpu_Multicorrelator_16sc::set_input_output_vectors(lv_16sc_t* corr_out, const lv_16sc_t* sig_in)
 {
     // Save CPU pointers
@@ -105,7 +118,7 @@ bool Cpu_Multicorrelator_16sc::free()
     // Free memory
     if (d_local_codes_resampled != nullptr)
         {
-            for (int n = 0; n < d_n_correlators; n++)
+            for (int n = 0; n < d_max_correlators; n++)
                 {
                     volk_gnsssdr_free(d_local_codes_resampled[n]);
                 }
@@ -39,6 +39,7 @@ public:
     ~Cpu_Multicorrelator_16sc();
     bool init(int max_signal_length_samples, int n_correlators);
     bool set_local_code_and_taps(int code_length_chips, const lv_16sc_t *local_code_in, float *shifts_chips);
+    bool set_taps(float *shifts_chips, int n_correlators);
     bool set_input_output_vectors(lv_16sc_t *corr_out, const lv_16sc_t *sig_in);
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, int signal_length_samples);
@@ -53,6 +54,7 @@ private:
     float *d_shifts_chips{nullptr};
     int d_code_length_chips{0};
     int d_n_correlators{0};
+    int d_max_correlators{0};
 };
 
 
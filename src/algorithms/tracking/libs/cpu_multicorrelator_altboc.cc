@@ -0,0 +1,126 @@
+/*!
+ * \file cpu_multicorrelator_altboc.cc
+ * \brief CPU multicorrelator of both sidebands of the Galileo E5 AltBOC
+ * signal in a single pass over the input
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_altboc.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cmath>
+
+
+Cpu_Multicorrelator_Altboc::~Cpu_Multicorrelator_Altboc()
+{
+    if (d_local_codes_resampled != nullptr)
+        {
+            Cpu_Multicorrelator_Altboc::free();
+        }
+}
+
+
+bool Cpu_Multicorrelator_Altboc::init(
+    int max_signal_length_samples,
+    int n_correlators)
+{
+    // One set of taps per sideband
+    size_t size = max_signal_length_samples * sizeof(std::complex<float>);
+
+    d_local_codes_resampled = static_cast<std::complex<float>**>(volk_gnsssdr_malloc(2 * n_correlators * sizeof(std::complex<float>*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < 2 * n_correlators; n++)
+        {
+            d_local_codes_resampled[n] = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+        }
+    d_n_correlators = n_correlators;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Altboc::set_local_code_and_taps(
+    int code_length_chips,
+    const std::complex<float>* local_code_e5a_in,
+    const std::complex<float>* local_code_e5b_in,
+    float* shifts_chips)
+{
+    d_local_code_e5a_in = local_code_e5a_in;
+    d_local_code_e5b_in = local_code_e5b_in;
+    d_shifts_chips = shifts_chips;
+    d_code_length_chips = code_length_chips;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Altboc::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in)
+{
+    d_sig_in = sig_in;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Altboc::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips)
+{
+    volk_gnsssdr_32fc_xn_resampler_32fc_xn(d_local_codes_resampled,
+        d_local_code_e5a_in,
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_code_length_chips,
+        d_n_correlators,
+        correlator_length_samples);
+    volk_gnsssdr_32fc_xn_resampler_32fc_xn(d_local_codes_resampled + d_n_correlators,
+        d_local_code_e5b_in,
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_code_length_chips,
+        d_n_correlators,
+        correlator_length_samples);
+}
+
+
+bool Cpu_Multicorrelator_Altboc::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    int signal_length_samples)
+{
+    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips);
+    // Regenerate phase at each call in order to avoid numerical issues
+    lv_32fc_t phase_offset_as_complex[1];
+    phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    // Both sidebands in one call, so the carrier is wiped off once
+    volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0, -phase_step_rad)), phase_offset_as_complex, const_cast<const lv_32fc_t**>(d_local_codes_resampled), 2 * d_n_correlators, signal_length_samples);
+    return true;
+}
+
+
+float Cpu_Multicorrelator_Altboc::sideband_power(int tap) const
+{
+    return std::norm(d_corr_out[tap]) + std::norm(d_corr_out[d_n_correlators + tap]);
+}
+
+
+bool Cpu_Multicorrelator_Altboc::free()
+{
+    if (d_local_codes_resampled != nullptr)
+        {
+            for (int n = 0; n < 2 * d_n_correlators; n++)
+                {
+                    volk_gnsssdr_free(d_local_codes_resampled[n]);
+                }
+            volk_gnsssdr_free(d_local_codes_resampled);
+            d_local_codes_resampled = nullptr;
+        }
+    return true;
+}
@@ -0,0 +1,76 @@
+/*!
+ * \file cpu_multicorrelator_altboc.h
+ * \brief CPU multicorrelator of both sidebands of the Galileo E5 AltBOC
+ * signal in a single pass over the input
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_ALTBOC_H
+#define GNSS_SDR_CPU_MULTICORRELATOR_ALTBOC_H
+
+
+#include <complex>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Carrier wipe-off and correlators of a full-band Galileo E5 signal,
+ * with the carrier at the E5 centre frequency, against the local codes of
+ * its lower (E5a) and upper (E5b) sidebands, as generated by
+ * galileo_e5_altboc_sideband_code_gen_complex().
+ *
+ * The two local codes are resampled with the same code phase, and the
+ * 2 * n_correlators taps are accumulated by one rotator and dot product
+ * kernel, so the input is read and its carrier wiped off once per
+ * integration instead of once per sideband channel. The outputs are the
+ * E5a taps followed by the E5b taps. Code phases, steps and tap shifts are
+ * in samples of the local codes, GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP per
+ * chip.
+ */
+class Cpu_Multicorrelator_Altboc
+{
+public:
+    Cpu_Multicorrelator_Altboc() = default;
+    ~Cpu_Multicorrelator_Altboc();
+    bool init(int max_signal_length_samples, int n_correlators);
+    bool set_local_code_and_taps(int code_length_chips, const std::complex<float> *local_code_e5a_in, const std::complex<float> *local_code_e5b_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+    void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, int signal_length_samples);
+
+    /*!
+     * \brief Non-coherent combination of a tap of both sidebands, whose
+     * secondary codes differ, for the code discriminator of the full band
+     */
+    float sideband_power(int tap) const;
+
+    bool free();
+
+private:
+    const std::complex<float> *d_sig_in{nullptr};
+    const std::complex<float> *d_local_code_e5a_in{nullptr};
+    const std::complex<float> *d_local_code_e5b_in{nullptr};
+    std::complex<float> **d_local_codes_resampled{nullptr};
+    std::complex<float> *d_corr_out{nullptr};
+    float *d_shifts_chips{nullptr};
+    int d_code_length_chips{0};
+    int d_n_correlators{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CPU_MULTICORRELATOR_ALTBOC_H
@@ -21,6 +21,7 @@
 
 #include "cpu_multicorrelator_real_codes.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for std::max, std::min
 #include <cmath>
 
 
@@ -45,7 +46,16 @@ bool Cpu_Multicorrelator_Real_Codes::init(
         {
             d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
         }
+    d_local_codes = static_cast<const float**>(volk_gnsssdr_malloc(n_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < n_correlators; n++)
+        {
+            d_local_codes[n] = d_local_codes_resampled[n];
+        }
+    d_local_codes_range = static_cast<const float**>(volk_gnsssdr_malloc(n_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
+    d_corr_range = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_correlators * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
     d_n_correlators = n_correlators;
+    d_max_correlators = n_correlators;
+    d_max_signal_length_samples = max_signal_length_samples;
     return true;
 }
 
@@ -58,7 +68,84 @@ bool Cpu_Multicorrelator_Real_Codes::set_local_code_and_taps(
     d_local_code_in = local_code_in;
     d_shifts_chips = shifts_chips;
     d_code_length_chips = code_length_chips;
+    build_code_tables();
+
+    return true;
+}
+
 
+bool Cpu_Multicorrelator_Real_Codes::set_taps(float* shifts_chips, int n_correlators)
+{
+    if (n_correlators < 1 or n_correlators > d_max_correlators)
+        {
+            return false;
+        }
+    d_shifts_chips = shifts_chips;
+    d_n_correlators = n_correlators;
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::set_code_tables(int granularity, float nominal_code_phase_step_chips)
+{
+    d_code_table_granularity = std::max(granularity, 0);
+    d_nominal_code_phase_step_chips = nominal_code_phase_step_chips;
+    build_code_tables();
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::build_code_tables()
+{
+    d_code_tables.clear();
+    if (d_code_table_granularity == 0 or d_local_code_in == nullptr or d_nominal_code_phase_step_chips <= 0.0)
+        {
+            return;
+        }
+    // Table k holds the code sampled from phase k / granularity. Any start phase is
+    // then, within half a table step, the start of table k shifted by an integer
+    // number of samples, so one code period plus one correlation interval is enough.
+    const auto step = static_cast<double>(d_nominal_code_phase_step_chips);
+    const auto granularity = static_cast<double>(d_code_table_granularity);
+    const int num_tables = static_cast<int>(std::round(step * granularity)) + 1;
+    const int table_length = static_cast<int>(std::floor(static_cast<double>(d_code_length_chips) / step)) + 1 + d_max_signal_length_samples;
+    d_code_tables = std::vector<volk_gnsssdr::vector<float>>(num_tables, volk_gnsssdr::vector<float>(table_length));
+    for (int k = 0; k < num_tables; k++)
+        {
+            for (int n = 0; n < table_length; n++)
+                {
+                    const auto chip_index = static_cast<int>(std::floor(static_cast<double>(k) / granularity + static_cast<double>(n) * step));
+                    d_code_tables[k][n] = d_local_code_in[chip_index % d_code_length_chips];
+                }
+        }
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::select_code_tables(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips)
+{
+    // Code phase error at the end of the interval due to the code Doppler
+    const auto length = static_cast<double>(correlator_length_samples);
+    const double rate = d_use_high_dynamics_resampler ? static_cast<double>(code_phase_rate_step_chips) : 0.0;
+    const double drift = std::abs(static_cast<double>(code_phase_step_chips - d_nominal_code_phase_step_chips)) * length + std::abs(rate) * length * length;
+    const double resolution = 1.0 / static_cast<double>(d_code_table_granularity);
+    if (drift > 0.5 * resolution or correlator_length_samples > d_max_signal_length_samples)
+        {
+            return false;
+        }
+    const auto step = static_cast<double>(d_nominal_code_phase_step_chips);
+    const auto code_length = static_cast<double>(d_code_length_chips);
+    for (int n = 0; n < d_n_correlators; n++)
+        {
+            // Same sampling instants as the resampler, floor(n * step + shift - rem)
+            double start_phase = std::fmod(static_cast<double>(d_shifts_chips[n]) - static_cast<double>(rem_code_phase_chips), code_length);
+            if (start_phase < 0.0)
+                {
+                    start_phase += code_length;
+                }
+            const auto first_sample = static_cast<int>(std::floor(start_phase / step));
+            const double residual = start_phase - static_cast<double>(first_sample) * step;
+            const int table = std::min(static_cast<int>(std::round(residual / resolution)), static_cast<int>(d_code_tables.size()) - 1);
+            d_local_codes[n] = d_code_tables[table].data() + first_sample;
+        }
     return true;
 }
 
@@ -74,29 +161,33 @@ bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float
 
 void Cpu_Multicorrelator_Real_Codes::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips)
 {
+    d_fused_resampler = false;
+    if (!d_code_tables.empty() and select_code_tables(correlator_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips))
+        {
+            return;
+        }
     if (d_use_high_dynamics_resampler)
         {
-            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled,
-                d_local_code_in,
-                rem_code_phase_chips,
-                code_phase_step_chips,
-                code_phase_rate_step_chips,
-                d_shifts_chips,
-                d_code_length_chips,
-                d_n_correlators,
-                correlator_length_samples);
+            // The fused kernel generates the code samples inside the correlation loop,
+            // so the resampled codes are never written to memory
+            d_rem_code_phase_chips = rem_code_phase_chips;
+            d_code_phase_step_chips = code_phase_step_chips;
+            d_code_phase_rate_step_chips = code_phase_rate_step_chips;
+            d_fused_resampler = true;
+            return;
         }
-    else
+    for (int n = 0; n < d_n_correlators; n++)
         {
-            volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled,
-                d_local_code_in,
-                rem_code_phase_chips,
-                code_phase_step_chips,
-                d_shifts_chips,
-                d_code_length_chips,
-                d_n_correlators,
-                correlator_length_samples);
+            d_local_codes[n] = d_local_codes_resampled[n];
         }
+    volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled,
+        d_local_code_in,
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_code_length_chips,
+        d_n_correlators,
+        correlator_length_samples);
 }
 
 
@@ -114,13 +205,20 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
-    if (d_use_high_dynamics_resampler)
+    if (d_fused_resampler)
         {
-            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex,
+                d_local_code_in, d_rem_code_phase_chips, d_code_phase_step_chips, d_code_phase_rate_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
+    else if (d_use_high_dynamics_resampler)
+        {
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, d_local_codes, d_n_correlators, signal_length_samples);
         }
     else
         {
-            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            // Carrier phase kept in double precision by the kernel, so it does not drift over long integrations
+            double carrier_phase_rad = -static_cast<double>(rem_carrier_phase_in_rad);
+            volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, -static_cast<double>(phase_step_rad), &carrier_phase_rad, d_local_codes, d_n_correlators, signal_length_samples);
         }
     return true;
 }
@@ -139,7 +237,67 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+    if (d_fused_resampler)
+        {
+            volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), lv_32fc_t(1.0, 0.0), phase_offset_as_complex,
+                d_local_code_in, d_rem_code_phase_chips, d_code_phase_step_chips, d_code_phase_rate_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
+    else
+        {
+            // Carrier phase kept in double precision by the kernel, so it does not drift over long integrations
+            double carrier_phase_rad = -static_cast<double>(rem_carrier_phase_in_rad);
+            volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, -static_cast<double>(phase_step_rad), &carrier_phase_rad, d_local_codes, d_n_correlators, signal_length_samples);
+        }
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_range(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    int first_sample,
+    int num_samples)
+{
+    // Carrier phase and phase step at first_sample, as the kernels would reach them
+    // after first_sample iterations
+    const auto m = static_cast<double>(first_sample);
+    const double rate = d_use_high_dynamics_resampler ? static_cast<double>(phase_rate_step_rad) : 0.0;
+    const double phase_at_first_sample = static_cast<double>(rem_carrier_phase_in_rad) + static_cast<double>(phase_step_rad) * m + rate * m * m;
+    lv_32fc_t phase_offset_as_complex[1];
+    phase_offset_as_complex[0] = lv_cmake(static_cast<float>(std::cos(phase_at_first_sample)), static_cast<float>(-std::sin(phase_at_first_sample)));
+    for (int n = 0; n < d_n_correlators; n++)
+        {
+            d_local_codes_range[n] = d_local_codes[n] + first_sample;
+        }
+    std::complex<float>* corr_out = (first_sample == 0 ? d_corr_out : d_corr_range);
+    if (d_fused_resampler)
+        {
+            // Code phase and code phase step at first_sample
+            const auto code_rate = static_cast<double>(d_code_phase_rate_step_chips);
+            const auto rem_code_phase_at_first_sample = static_cast<float>(static_cast<double>(d_rem_code_phase_chips) - static_cast<double>(d_code_phase_step_chips) * m - code_rate * m * m);
+            const auto code_phase_step_at_first_sample = static_cast<float>(static_cast<double>(d_code_phase_step_chips) + 2.0 * code_rate * m);
+            const auto phase_step_at_first_sample = static_cast<float>(static_cast<double>(phase_step_rad) + 2.0 * rate * m);
+            volk_gnsssdr_32fc_32f_high_dynamic_resampler_rotator_dot_prod_32fc_xn(corr_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -phase_step_at_first_sample)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex,
+                d_local_code_in, rem_code_phase_at_first_sample, code_phase_step_at_first_sample, d_code_phase_rate_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, num_samples);
+        }
+    else if (d_use_high_dynamics_resampler)
+        {
+            const auto phase_step_at_first_sample = static_cast<float>(static_cast<double>(phase_step_rad) + 2.0 * rate * m);
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(corr_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -phase_step_at_first_sample)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, d_local_codes_range, d_n_correlators, num_samples);
+        }
+    else
+        {
+            double carrier_phase_rad = -phase_at_first_sample;
+            volk_gnsssdr_32fc_32f_s64f_rotator_dot_prod_32fc_xn(corr_out, d_sig_in + first_sample, -static_cast<double>(phase_step_rad), &carrier_phase_rad, d_local_codes_range, d_n_correlators, num_samples);
+        }
+    if (first_sample > 0)
+        {
+            for (int n = 0; n < d_n_correlators; n++)
+                {
+                    d_corr_out[n] += d_corr_range[n];
+                }
+        }
     return true;
 }
 
@@ -149,13 +307,28 @@ bool Cpu_Multicorrelator_Real_Codes::free()
     // Free memory
     if (d_local_codes_resampled != nullptr)
         {
-            for (int n = 0; n < d_n_correlators; n++)
+            for (int n = 0; n < d_max_correlators; n++)
                 {
                     volk_gnsssdr_free(d_local_codes_resampled[n]);
                 }
             volk_gnsssdr_free(d_local_codes_resampled);
             d_local_codes_resampled = nullptr;
         }
+    if (d_local_codes != nullptr)
+        {
+            volk_gnsssdr_free(d_local_codes);
+            d_local_codes = nullptr;
+        }
+    if (d_local_codes_range != nullptr)
+        {
+            volk_gnsssdr_free(d_local_codes_range);
+            d_local_codes_range = nullptr;
+        }
+    if (d_corr_range != nullptr)
+        {
+            volk_gnsssdr_free(d_corr_range);
+            d_corr_range = nullptr;
+        }
     return true;
 }
 
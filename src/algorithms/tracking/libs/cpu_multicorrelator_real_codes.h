@@ -23,7 +23,9 @@
 #define GNSS_SDR_CPU_MULTICORRELATOR_REAL_CODES_H
 
 
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <complex>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -39,24 +41,54 @@ class Cpu_Multicorrelator_Real_Codes
 public:
     Cpu_Multicorrelator_Real_Codes() = default;
     void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+    // Precomputes, for each local code, tables of the code sampled at nominal_code_phase_step_chips with a
+    // 1/granularity chip resolution. update_local_code() then points the correlators to the tables instead of
+    // resampling the code, as long as the actual code phase step keeps the error below 1/granularity chips.
+    // A granularity of 0 disables the tables.
+    void set_code_tables(int granularity, float nominal_code_phase_step_chips);
     ~Cpu_Multicorrelator_Real_Codes();
     bool init(int max_signal_length_samples, int n_correlators);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    // Correlates only n_correlators taps (at most the number given to init()) with the given shifts, keeping
+    // the local code and its tables. Used to disable correlators at runtime.
+    bool set_taps(float *shifts_chips, int n_correlators);
     bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    // Correlates samples [first_sample, first_sample + num_samples) with the codes of the last update_local_code() call,
+    // adding to the outputs if first_sample > 0. Consecutive ranges give the result of a single call over the whole interval.
+    bool Carrier_wipeoff_multicorrelator_range(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, int first_sample, int num_samples);
     bool free();
 
 private:
+    void build_code_tables();
+    bool select_code_tables(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips);
+
+    std::vector<volk_gnsssdr::vector<float>> d_code_tables;
+
+    // Code phase of the last update_local_code() call, when the high dynamics
+    // correlators resample the code on the fly instead
+    float d_rem_code_phase_chips{0.0};
+    float d_code_phase_step_chips{0.0};
+    float d_code_phase_rate_step_chips{0.0};
+    bool d_fused_resampler{false};
+
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in{nullptr};
     const float *d_local_code_in{nullptr};
     std::complex<float> *d_corr_out{nullptr};
     float **d_local_codes_resampled{nullptr};
+    const float **d_local_codes{nullptr};  // codes used by the correlators, either resampled or in the tables
+    const float **d_local_codes_range{nullptr};
+    std::complex<float> *d_corr_range{nullptr};
     float *d_shifts_chips{nullptr};
     int d_code_length_chips{0};
     int d_n_correlators{0};
+    int d_max_correlators{0};
+    int d_max_signal_length_samples{0};
+    int d_code_table_granularity{0};
+    float d_nominal_code_phase_step_chips{0.0};
     bool d_use_high_dynamics_resampler{true};
 };
 
@@ -22,7 +22,9 @@
  */
 
 #include "cuda_multicorrelator.h"
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <stdio.h>
 // For the CUDA runtime routines (prefixed with "cuda_")
 #include <cuda_runtime.h>
@@ -123,6 +125,182 @@ __global__ void Doppler_wippe_scalarProdGPUCPXxN_shifts_chips(
 }
 
 
+// Same as Doppler_wippe_scalarProdGPUCPXxN_shifts_chips, with the input read
+// from the sample ring and the carrier wiped off on the fly, so that it needs
+// no intermediate vector
+__global__ void Doppler_wipe_scalarProdGPUCPXxN_shifts_chips_ring(
+    GPU_Complex *d_corr_out,
+    const GPU_Complex *d_ring,
+    int ring_pos,
+    int ring_capacity,
+    GPU_Complex *d_local_code_in,
+    float *d_shifts_chips,
+    int code_length_chips,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    int vectorN,
+    int elementN,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad)
+{
+    //Accumulators cache
+    __shared__ GPU_Complex accumResult[ACCUM_N];
+
+    float sin;
+    float cos;
+    for (int vec = blockIdx.x; vec < vectorN; vec += gridDim.x)
+        {
+            for (int iAccum = threadIdx.x; iAccum < ACCUM_N; iAccum += blockDim.x)
+                {
+                    GPU_Complex sum = GPU_Complex(0, 0);
+                    float local_code_chip_index = 0.0;
+                    for (int pos = iAccum; pos < elementN; pos += ACCUM_N)
+                        {
+                            int ring_index = ring_pos + pos;
+                            if (ring_index >= ring_capacity) ring_index -= ring_capacity;
+                            GPU_Complex sample = d_ring[ring_index];
+                            __sincosf(rem_carrier_phase_in_rad + pos * phase_step_rad, &sin, &cos);
+
+                            local_code_chip_index = fmodf(code_phase_step_chips * __int2float_rd(pos) + d_shifts_chips[vec] - rem_code_phase_chips, code_length_chips);
+                            //Take into account that in multitap correlators, the shifts can be negative!
+                            if (local_code_chip_index < 0.0) local_code_chip_index += (code_length_chips - 1);
+                            sum.multiply_acc(sample * GPU_Complex(cos, -sin), d_local_code_in[__float2int_rd(local_code_chip_index)]);
+                        }
+                    accumResult[iAccum] = sum;
+                }
+
+            // tree-like reduction of the accumulators, ACCUM_N has to be a power of two
+            for (int stride = ACCUM_N / 2; stride > 0; stride >>= 1)
+                {
+                    __syncthreads();
+
+                    for (int iAccum = threadIdx.x; iAccum < stride; iAccum += blockDim.x)
+                        {
+                            accumResult[iAccum] += accumResult[stride + iAccum];
+                        }
+                }
+
+            if (threadIdx.x == 0)
+                {
+                    d_corr_out[vec] = accumResult[0];
+                }
+            __syncthreads();
+        }
+}
+
+
+std::shared_ptr<cuda_sample_ring> cuda_sample_ring::get(int capacity_samples, int n_streams)
+{
+    static std::mutex rings_mutex;
+    static std::map<int, std::weak_ptr<cuda_sample_ring>> rings;
+
+    int device;
+    cudaGetDevice(&device);
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    std::shared_ptr<cuda_sample_ring> ring = rings[device].lock();
+    if (!ring)
+        {
+            ring = std::shared_ptr<cuda_sample_ring>(new cuda_sample_ring(device, capacity_samples, n_streams));
+            rings[device] = ring;
+        }
+    return ring;
+}
+
+
+cuda_sample_ring::cuda_sample_ring(int device, int capacity_samples, int n_streams)
+    : d_streams(std::max(n_streams, 1)),
+      d_ring(NULL),
+      d_oldest(0),
+      d_newest(0),
+      d_capacity(capacity_samples),
+      d_device(device),
+      d_next_stream(0),
+      d_empty(true)
+{
+    cudaSetDevice(d_device);
+    cudaMalloc((void **)&d_ring, sizeof(GPU_Complex) * d_capacity);
+    for (auto &stream : d_streams)
+        {
+            cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+        }
+    cudaStreamCreateWithFlags(&d_upload_stream, cudaStreamNonBlocking);
+    cudaEventCreateWithFlags(&d_upload_event, cudaEventDisableTiming);
+    printf("GPU sample ring of %i samples shared by %i channel groups\n", d_capacity, static_cast<int>(d_streams.size()));
+}
+
+
+cuda_sample_ring::~cuda_sample_ring()
+{
+    cudaSetDevice(d_device);
+    cudaStreamSynchronize(d_upload_stream);
+    for (auto &stream : d_streams)
+        {
+            cudaStreamSynchronize(stream);
+            cudaStreamDestroy(stream);
+        }
+    cudaStreamDestroy(d_upload_stream);
+    cudaEventDestroy(d_upload_event);
+    if (d_ring != NULL) cudaFree(d_ring);
+}
+
+
+cudaStream_t cuda_sample_ring::next_stream()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_streams[d_next_stream++ % d_streams.size()];
+}
+
+
+int cuda_sample_ring::make_resident(uint64_t sample_index, const std::complex<float> *sig_in, int n, cudaStream_t stream)
+{
+    const uint64_t guard = d_capacity / 4;
+    if (n <= 0 or static_cast<uint64_t>(n) > guard)
+        {
+            return -1;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const uint64_t end = sample_index + n;
+    if (d_empty or sample_index > d_newest)
+        {
+            // first chunk, or the channels skipped some samples: restart the ring
+            d_oldest = sample_index;
+            d_newest = sample_index;
+            d_empty = false;
+        }
+    if (end > d_newest)
+        {
+            // only the samples that no other channel has uploaded yet
+            const uint64_t first = std::max(sample_index, d_newest);
+            upload(first, end, sig_in + (first - sample_index));
+            d_newest = end;
+            d_oldest = std::max(d_oldest, d_newest > static_cast<uint64_t>(d_capacity) ? d_newest - d_capacity : 0);
+        }
+    const uint64_t safe_oldest = std::max(d_oldest, d_newest > d_capacity - guard ? d_newest - (d_capacity - guard) : 0);
+    if (sample_index < safe_oldest)
+        {
+            return -1;
+        }
+    cudaStreamWaitEvent(stream, d_upload_event, 0);
+    return static_cast<int>(sample_index % d_capacity);
+}
+
+
+void cuda_sample_ring::upload(uint64_t first, uint64_t last, const std::complex<float> *src)
+{
+    cudaSetDevice(d_device);
+    const int pos = static_cast<int>(first % d_capacity);
+    const int n = static_cast<int>(last - first);
+    const int n_head = std::min(n, d_capacity - pos);
+    cudaMemcpyAsync(d_ring + pos, src, sizeof(GPU_Complex) * n_head, cudaMemcpyHostToDevice, d_upload_stream);
+    if (n_head < n)
+        {
+            // wrap around
+            cudaMemcpyAsync(d_ring, src + n_head, sizeof(GPU_Complex) * (n - n_head), cudaMemcpyHostToDevice, d_upload_stream);
+        }
+    cudaEventRecord(d_upload_event, d_upload_stream);
+}
+
+
 bool cuda_multicorrelator::init_cuda_integrated_resampler(
     int signal_length_samples,
     int code_length_chips,
@@ -262,6 +440,20 @@ bool cuda_multicorrelator::set_local_code_and_taps(
     cudaMemcpyAsync(d_shifts_chips, shifts_chips, sizeof(float) * n_correlators,
         cudaMemcpyHostToDevice, stream1);
 
+    if (d_sample_ring != nullptr)
+        {
+            // the correlations run in the stream of the channel group
+            cudaStreamSynchronize(stream1);
+        }
+    return true;
+}
+
+
+bool cuda_multicorrelator::set_sample_ring(int capacity_samples, int n_streams)
+{
+    cudaSetDevice(selected_gps_device);
+    d_sample_ring = cuda_sample_ring::get(capacity_samples, n_streams);
+    d_group_stream = d_sample_ring->next_stream();
     return true;
 }
 
@@ -346,8 +538,51 @@ bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_cuda(
 }
 
 
+bool cuda_multicorrelator::Carrier_wipeoff_multicorrelator_resampler_ring_cuda(
+    uint64_t sample_index,
+    const std::complex<float> *sig_in,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float code_phase_step_chips,
+    float rem_code_phase_chips,
+    int signal_length_samples,
+    int n_correlators)
+{
+    if (d_sample_ring == nullptr)
+        {
+            return false;
+        }
+    cudaSetDevice(selected_gps_device);
+    const int ring_pos = d_sample_ring->make_resident(sample_index, sig_in, signal_length_samples, d_group_stream);
+    if (ring_pos < 0)
+        {
+            return false;
+        }
+
+    Doppler_wipe_scalarProdGPUCPXxN_shifts_chips_ring<<<blocksPerGrid, threadsPerBlock, 0, d_group_stream>>>(
+        d_corr_out,
+        d_sample_ring->data(),
+        ring_pos,
+        d_sample_ring->capacity(),
+        d_local_codes_in,
+        d_shifts_chips,
+        d_code_length_chips,
+        code_phase_step_chips,
+        rem_code_phase_chips,
+        n_correlators,
+        signal_length_samples,
+        rem_carrier_phase_in_rad,
+        phase_step_rad);
+
+    gpuErrchk(cudaPeekAtLastError());
+    gpuErrchk(cudaStreamSynchronize(d_group_stream));
+    return true;
+}
+
+
 cuda_multicorrelator::cuda_multicorrelator()
 {
+    d_group_stream = 0;
     d_sig_in = NULL;
     d_nco_in = NULL;
     d_sig_doppler_wiped = NULL;
@@ -377,6 +612,11 @@ bool cuda_multicorrelator::free_cuda()
     // needed to ensure correct operation when the application is being
     // profiled. Calling cudaDeviceReset causes all profile data to be
     // flushed before the application exits
-    cudaDeviceReset();
+    if (d_sample_ring == nullptr)
+        {
+            cudaDeviceReset();
+        }
+    // other channels may still be using the device and its sample ring
+    d_sample_ring.reset();
     return true;
 }
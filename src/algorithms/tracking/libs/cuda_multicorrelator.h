@@ -31,8 +31,12 @@
 #endif
 
 #include <complex>
+#include <cstdint>
 #include <cuda.h>
 #include <cuda_runtime.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -105,6 +109,58 @@ struct GPU_Complex_Short
 };
 
 
+/*!
+ * \brief Ring of input samples in device memory, shared by all the channels
+ * that track the same sample stream on a GPU.
+ *
+ * Each chunk of samples, identified by its sample counter, is uploaded once
+ * by the first channel that needs it, instead of once per channel. The
+ * channels are spread over a few CUDA streams (channel groups), so that the
+ * correlations of different groups overlap. Samples in the oldest quarter of
+ * the ring are not handed out, since a new upload could overwrite them while
+ * a kernel reads them: channels that lag that much use their own input copy.
+ */
+class cuda_sample_ring
+{
+public:
+    /*!
+     * \brief Returns the ring of the current CUDA device, created by its
+     * first user with a capacity of capacity_samples and n_streams streams.
+     */
+    static std::shared_ptr<cuda_sample_ring> get(int capacity_samples, int n_streams);
+
+    ~cuda_sample_ring();
+
+    /*!
+     * \brief Makes the samples [sample_index, sample_index + n), held by
+     * sig_in, resident in the ring, and makes the work queued afterwards in
+     * stream wait for their upload. Returns the position of the first sample
+     * in the ring, or -1 if the samples cannot be served from the ring.
+     */
+    int make_resident(uint64_t sample_index, const std::complex<float>* sig_in, int n, cudaStream_t stream);
+
+    cudaStream_t next_stream();  // streams of the channel groups, in round robin
+    const GPU_Complex* data() const { return d_ring; }
+    int capacity() const { return d_capacity; }
+
+private:
+    cuda_sample_ring(int device, int capacity_samples, int n_streams);
+    void upload(uint64_t first, uint64_t last, const std::complex<float>* src);
+
+    std::mutex d_mutex;
+    std::vector<cudaStream_t> d_streams;
+    cudaStream_t d_upload_stream;
+    cudaEvent_t d_upload_event;
+    GPU_Complex* d_ring;
+    uint64_t d_oldest;  // first sample in the ring
+    uint64_t d_newest;  // one past the last sample in the ring
+    int d_capacity;
+    int d_device;
+    unsigned int d_next_stream;
+    bool d_empty;
+};
+
+
 /*!
  * \brief Class that implements carrier wipe-off and correlators using NVIDIA CUDA GPU accelerators.
  */
@@ -125,6 +181,12 @@ public:
         std::complex<float>* corr_out,
         std::complex<float>* sig_in);
 
+    /*!
+     * \brief Reads the input from the sample ring shared by the channels of
+     * the device, and runs the correlations in the stream of a channel group.
+     */
+    bool set_sample_ring(int capacity_samples, int n_streams);
+
     bool free_cuda();
     bool Carrier_wipeoff_multicorrelator_resampler_cuda(
         float rem_carrier_phase_in_rad,
@@ -134,7 +196,26 @@ public:
         int signal_length_samples,
         int n_correlators);
 
+    /*!
+     * \brief Same as Carrier_wipeoff_multicorrelator_resampler_cuda, with
+     * the input taken from the sample ring. sig_in holds the samples starting
+     * at sample_index, which are only uploaded if no other channel did it.
+     * Returns false if there is no ring or the samples are not in it, and
+     * then nothing is computed.
+     */
+    bool Carrier_wipeoff_multicorrelator_resampler_ring_cuda(
+        uint64_t sample_index,
+        const std::complex<float>* sig_in,
+        float rem_carrier_phase_in_rad,
+        float phase_step_rad,
+        float code_phase_step_chips,
+        float rem_code_phase_chips,
+        int signal_length_samples,
+        int n_correlators);
+
 private:
+    std::shared_ptr<cuda_sample_ring> d_sample_ring;
+    cudaStream_t d_group_stream;
     cudaStream_t stream1;
     // cudaStream_t stream2;
 
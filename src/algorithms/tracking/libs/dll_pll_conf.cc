@@ -46,9 +46,26 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     double fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", fs_in);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
     high_dyn = configuration->property(role + ".high_dyn", high_dyn);
+    shared_correlator = configuration->property(role + ".shared_correlator", shared_correlator);
+    precomputed_code_tables = configuration->property(role + ".precomputed_code_tables", precomputed_code_tables);
+    code_table_granularity = configuration->property(role + ".code_table_granularity", code_table_granularity);
+    if (code_table_granularity < 1)
+        {
+            LOG(WARNING) << "Parameter code_table_granularity should be at least 1. Setting it to 16";
+            code_table_granularity = 16;
+        }
+    compute_backend = compute_backend_from_config(configuration, role);
+    if ((compute_backend != Gnss_Compute_Backend::CPU) and (shared_correlator or precomputed_code_tables))
+        {
+            LOG(WARNING) << "The shared_correlator and precomputed_code_tables options do not apply to the GPU correlator. Setting them to false";
+            shared_correlator = false;
+            precomputed_code_tables = false;
+        }
     dump = configuration->property(role + ".dump", dump);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
     dump_mat = configuration->property(role + ".dump_mat", dump_mat);
+    dump_async = configuration->property(role + ".dump_async", dump_async);
+    compact_output = configuration->property("GNSS-SDR.compact_tracking_records", compact_output);
     pll_bw_hz = configuration->property(role + ".pll_bw_hz", pll_bw_hz);
     if (FLAGS_pll_bw_hz != 0.0)
         {
@@ -99,6 +116,7 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     fll_bw_hz = configuration->property(role + ".fll_bw_hz", fll_bw_hz);
     pull_in_time_s = configuration->property(role + ".pull_in_time_s", pull_in_time_s);
     bit_synchronization_time_limit_s = configuration->property(role + ".bit_synchronization_time_limit_s", bit_synchronization_time_limit_s);
+    max_coast_gap_ms = configuration->property(role + ".max_coast_gap_ms", max_coast_gap_ms);
     early_late_space_chips = configuration->property(role + ".early_late_space_chips", early_late_space_chips);
     early_late_space_narrow_chips = configuration->property(role + ".early_late_space_narrow_chips", early_late_space_narrow_chips);
     very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", very_early_late_space_chips);
@@ -123,4 +141,14 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
         }
     carrier_lock_test_smoother_samples = configuration->property(role + ".carrier_lock_test_smoother_samples", carrier_lock_test_smoother_samples);
     carrier_lock_test_smoother_alpha = configuration->property(role + ".carrier_lock_test_smoother_alpha", carrier_lock_test_smoother_alpha);
+
+    // C/N0 driven selection of correlators and integration time
+    adaptive_correlation = configuration->property(role + ".adaptive_correlation", adaptive_correlation);
+    adaptive_cn0_high_db_hz = configuration->property(role + ".adaptive_cn0_high_db_hz", adaptive_cn0_high_db_hz);
+    adaptive_cn0_low_db_hz = configuration->property(role + ".adaptive_cn0_low_db_hz", adaptive_cn0_low_db_hz);
+    if (adaptive_cn0_low_db_hz > adaptive_cn0_high_db_hz)
+        {
+            adaptive_cn0_low_db_hz = adaptive_cn0_high_db_hz;
+            LOG(WARNING) << "adaptive_cn0_low_db_hz cannot be bigger than adaptive_cn0_high_db_hz. It has been set to " << adaptive_cn0_high_db_hz;
+        }
 }
@@ -20,6 +20,7 @@
 #define GNSS_SDR_DLL_PLL_CONF_H
 
 #include "configuration_interface.h"
+#include "gnss_sdr_compute_backend.h"
 #include <cstdint>
 #include <string>
 
@@ -56,8 +57,11 @@ public:
     float y_intercept{1.0};
     float cn0_smoother_alpha{0.002};
     float carrier_lock_test_smoother_alpha{0.002};
+    float adaptive_cn0_high_db_hz{40.0};
+    float adaptive_cn0_low_db_hz{35.0};
     uint32_t pull_in_time_s{10U};
     uint32_t bit_synchronization_time_limit_s{20U};
+    uint32_t max_coast_gap_ms{500U};
     uint32_t vector_length{0U};
     uint32_t smoother_length{10U};
     int32_t fll_filter_order{1};
@@ -68,6 +72,7 @@ public:
     int32_t cn0_smoother_samples{200};
     int32_t carrier_lock_test_smoother_samples{25};
     int32_t cn0_min{0};
+    int32_t code_table_granularity{16};
     int32_t max_code_lock_fail{0};
     int32_t max_carrier_lock_fail{0};
     char signal[3]{};
@@ -78,7 +83,13 @@ public:
     bool enable_doppler_correction{false};
     bool carrier_aiding{true};
     bool high_dyn{false};
+    bool shared_correlator{false};
+    bool precomputed_code_tables{false};
+    Gnss_Compute_Backend compute_backend{Gnss_Compute_Backend::CPU};
+    bool adaptive_correlation{false};
+    bool compact_output{false};  // send Gnss_Tracking_Record items to the telemetry decoder
     bool dump{false};
+    bool dump_async{false};
     bool dump_mat{true};
 };
 
@@ -120,4 +120,8 @@ void Dll_Pll_Conf_Fpga::SetFromConfiguration(const ConfigurationInterface *confi
     // max_lock_fail = 50;
 
     device_name = configuration->property(role + ".devicename", device_name);
+    result_ring_device_name = configuration->property(role + ".result_ring_devicename", result_ring_device_name);
+    result_ring_irq_entries = configuration->property(role + ".result_ring_irq_entries", result_ring_irq_entries);
+    result_ring_irq_timeout_us = configuration->property(role + ".result_ring_irq_timeout_us", result_ring_irq_timeout_us);
+    code_banks = configuration->property(role + ".code_banks", code_banks);
 }
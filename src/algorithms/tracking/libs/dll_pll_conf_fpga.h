@@ -39,6 +39,7 @@ public:
 
     /* DLL/PLL tracking configuration */
     std::string device_name{"/dev/uio"};
+    std::string result_ring_device_name{};  // empty: each channel waits for its own interrupt
     std::string dump_filename{"./dll_pll_dump.dat"};
 
     double fs_in{12500000.0};
@@ -69,6 +70,9 @@ public:
     uint32_t code_samples_per_chip{0U};
     uint32_t extend_fpga_integration_periods{1};
     uint32_t fpga_integration_period{0};
+    uint32_t result_ring_irq_entries{8};
+    uint32_t result_ring_irq_timeout_us{200};
+    uint32_t code_banks{1};
 
     int32_t fll_filter_order{1};
     int32_t pll_filter_order{3};
@@ -0,0 +1,282 @@
+/*!
+ * \file dll_pll_signal_traits.h
+ * \brief Compile-time constants of the signals tracked by the DLL/PLL
+ * tracking block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H
+#define GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H
+
+#include "Beidou_B1I.h"
+#include "Beidou_B3I.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+#include "GPS_L5.h"
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "Galileo_E5b.h"
+#include "Galileo_E6.h"
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Signal families with a specialized instance of the DLL/PLL
+ * tracking loop
+ */
+enum class Dll_Pll_Signal
+{
+    UNKNOWN,
+    GPS_L1_CA,
+    GPS_L2_M,
+    GPS_L5,
+    GALILEO_E1,
+    GALILEO_E5A,
+    GALILEO_E5B,
+    GALILEO_E6,
+    GLONASS_L1_CA,
+    GLONASS_L2_CA,
+    BEIDOU_B1I,
+    BEIDOU_B3I
+};
+
+
+/*!
+ * \brief Returns the signal family of a system ('G', 'E', 'R' or 'C') and
+ * signal ("1C", "2S", "L5", "1B", "5X", "7X", "E6", "1G", "2G", "B1" or
+ * "B3"), or Dll_Pll_Signal::UNKNOWN.
+ */
+inline Dll_Pll_Signal dll_pll_signal(char system, const std::string& signal)
+{
+    if (system == 'G')
+        {
+            if (signal == "1C")
+                {
+                    return Dll_Pll_Signal::GPS_L1_CA;
+                }
+            if (signal == "2S")
+                {
+                    return Dll_Pll_Signal::GPS_L2_M;
+                }
+            if (signal == "L5")
+                {
+                    return Dll_Pll_Signal::GPS_L5;
+                }
+        }
+    else if (system == 'E')
+        {
+            if (signal == "1B")
+                {
+                    return Dll_Pll_Signal::GALILEO_E1;
+                }
+            if (signal == "5X")
+                {
+                    return Dll_Pll_Signal::GALILEO_E5A;
+                }
+            if (signal == "7X")
+                {
+                    return Dll_Pll_Signal::GALILEO_E5B;
+                }
+            if (signal == "E6")
+                {
+                    return Dll_Pll_Signal::GALILEO_E6;
+                }
+        }
+    else if (system == 'R')
+        {
+            if (signal == "1G")
+                {
+                    return Dll_Pll_Signal::GLONASS_L1_CA;
+                }
+            if (signal == "2G")
+                {
+                    return Dll_Pll_Signal::GLONASS_L2_CA;
+                }
+        }
+    else if (system == 'C')
+        {
+            if (signal == "B1")
+                {
+                    return Dll_Pll_Signal::BEIDOU_B1I;
+                }
+            if (signal == "B3")
+                {
+                    return Dll_Pll_Signal::BEIDOU_B3I;
+                }
+        }
+    return Dll_Pll_Signal::UNKNOWN;
+}
+
+
+/*!
+ * \brief Constants of a signal family, known at compile time: carrier
+ * frequency, code chip rate, samples of the local code per chip, veml (five
+ * correlators, with Very Early and Very Late, instead of three), pilot (has
+ * a pilot component that can be tracked) and fdma (the carrier frequency
+ * depends on the frequency channel of the satellite, and carrier_freq_hz is
+ * that of channel 0). Unknown signals have the zero values that the tracking
+ * block sets for them.
+ */
+template <Dll_Pll_Signal S>
+struct Dll_Pll_Signal_Traits
+{
+    static constexpr double carrier_freq_hz = 0.0;
+    static constexpr double code_chip_rate_cps = 0.0;
+    static constexpr int32_t code_samples_per_chip = 0;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GPS_L1_CA>
+{
+    static constexpr double carrier_freq_hz = GPS_L1_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GPS_L1_CA_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GPS_L2_M>
+{
+    static constexpr double carrier_freq_hz = GPS_L2_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GPS_L2_M_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GPS_L5>
+{
+    static constexpr double carrier_freq_hz = GPS_L5_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GPS_L5I_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = true;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GALILEO_E1>
+{
+    static constexpr double carrier_freq_hz = GALILEO_E1_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GALILEO_E1_CODE_CHIP_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 2;  // sinboc(1,1) replica
+    static constexpr bool veml = true;
+    static constexpr bool pilot = true;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GALILEO_E5A>
+{
+    static constexpr double carrier_freq_hz = GALILEO_E5A_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GALILEO_E5A_CODE_CHIP_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = true;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GALILEO_E5B>
+{
+    static constexpr double carrier_freq_hz = GALILEO_E5B_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GALILEO_E5B_CODE_CHIP_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = true;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GALILEO_E6>
+{
+    static constexpr double carrier_freq_hz = GALILEO_E6_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GALILEO_E6_B_CODE_CHIP_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = true;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GLONASS_L1_CA>
+{
+    static constexpr double carrier_freq_hz = GLONASS_L1_CA_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GLONASS_L1_CA_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = true;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::GLONASS_L2_CA>
+{
+    static constexpr double carrier_freq_hz = GLONASS_L2_CA_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = GLONASS_L2_CA_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = true;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::BEIDOU_B1I>
+{
+    static constexpr double carrier_freq_hz = BEIDOU_B1I_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = BEIDOU_B1I_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = false;
+};
+
+
+template <>
+struct Dll_Pll_Signal_Traits<Dll_Pll_Signal::BEIDOU_B3I>
+{
+    static constexpr double carrier_freq_hz = BEIDOU_B3I_FREQ_HZ;
+    static constexpr double code_chip_rate_cps = BEIDOU_B3I_CODE_RATE_CPS;
+    static constexpr int32_t code_samples_per_chip = 1;
+    static constexpr bool veml = false;
+    static constexpr bool pilot = false;
+    static constexpr bool fdma = false;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H
@@ -51,7 +51,8 @@ Fpga_Multicorrelator_8sc::Fpga_Multicorrelator_8sc(int32_t n_correlators,
     int32_t *data_codes,
     uint32_t code_length_chips,
     bool track_pilot,
-    uint32_t code_samples_per_chip)
+    uint32_t code_samples_per_chip,
+    uint32_t code_banks)
     : d_initial_sample_counter(0),
       d_corr_out(nullptr),
       d_Prompt_Data(nullptr),
@@ -65,6 +66,7 @@ Fpga_Multicorrelator_8sc::Fpga_Multicorrelator_8sc(int32_t n_correlators,
       d_n_correlators(n_correlators),
       d_device_descriptor(0),
       d_map_base(nullptr),
+      d_channel(0),
       d_correlator_length_samples(0),
       d_code_phase_step_chips_num(0),
       d_rem_carr_phase_rad_int(0),
@@ -72,7 +74,8 @@ Fpga_Multicorrelator_8sc::Fpga_Multicorrelator_8sc(int32_t n_correlators,
       d_ca_codes(ca_codes),
       d_data_codes(data_codes),
       d_track_pilot(track_pilot),
-      d_secondary_code_enabled(false)
+      d_secondary_code_enabled(false),
+      d_code_banks(code_banks)
 {
     // instantiate variable length vectors
     if (d_track_pilot)
@@ -108,6 +111,25 @@ uint64_t Fpga_Multicorrelator_8sc::read_sample_counter()
 }
 
 
+void Fpga_Multicorrelator_8sc::set_result_ring(std::shared_ptr<Fpga_Tracking_Result_Ring> result_ring)
+{
+    if (result_ring and !result_ring->enabled())
+        {
+            LOG(WARNING) << "Tracking channel " << d_channel << " cannot use the result ring, falling back to its own interrupt";
+            result_ring = nullptr;
+        }
+    d_result_ring = std::move(result_ring);
+    if (d_result_ring)
+        {
+            d_map_base[result_ring_reg_addr] = ((d_channel % Fpga_Tracking_Result_Ring::max_channels) << 1) | result_ring_enable;
+        }
+    else
+        {
+            d_map_base[result_ring_reg_addr] = 0;
+        }
+}
+
+
 void Fpga_Multicorrelator_8sc::set_initial_sample(uint64_t samples_offset)
 {
     d_initial_sample_counter = samples_offset;
@@ -158,13 +180,23 @@ void Fpga_Multicorrelator_8sc::Carrier_wipeoff_multicorrelator_resampler(
     Fpga_Multicorrelator_8sc::fpga_compute_signal_parameters_in_fpga();
     Fpga_Multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga();
     Fpga_Multicorrelator_8sc::fpga_launch_multicorrelator_fpga();
-    int32_t irq_count;
-    ssize_t nb;
-    nb = read(d_device_descriptor, &irq_count, sizeof(irq_count));
-    if (nb != sizeof(irq_count))
+    if (d_result_ring)
         {
-            std::cout << "Tracking_module Read failed to retrieve 4 bytes!\n";
-            std::cout << "Tracking_module Interrupt number " << irq_count << '\n';
+            if (!d_result_ring->wait_results(d_channel, d_ring_results_real.data(), d_ring_results_imag.data()))
+                {
+                    LOG(WARNING) << "Tracking channel " << d_channel << " stopped waiting for the result ring";
+                }
+        }
+    else
+        {
+            int32_t irq_count;
+            ssize_t nb;
+            nb = read(d_device_descriptor, &irq_count, sizeof(irq_count));
+            if (nb != sizeof(irq_count))
+                {
+                    std::cout << "Tracking_module Read failed to retrieve 4 bytes!\n";
+                    std::cout << "Tracking_module Interrupt number " << irq_count << '\n';
+                }
         }
 
     // release secondary code indices, keep channel locked
@@ -190,6 +222,7 @@ bool Fpga_Multicorrelator_8sc::free()
 
 void Fpga_Multicorrelator_8sc::open_channel(const std::string &device_io_name, uint32_t channel)
 {
+    d_channel = channel;
     std::cout << "trk device_io_name = " << device_io_name << '\n';
 
     if ((d_device_descriptor = open(device_io_name.c_str(), O_RDWR | O_SYNC)) == -1)
@@ -237,6 +270,19 @@ uint32_t Fpga_Multicorrelator_8sc::fpga_acquisition_test_register(uint32_t write
 
 void Fpga_Multicorrelator_8sc::fpga_configure_tracking_gps_local_code(int32_t PRN)
 {
+    if (d_code_banks.num_banks() > 1)
+        {
+            // the selected bank is used by the correlators and written by the next code words
+            bool resident = false;
+            const uint32_t bank = d_code_banks.assign(static_cast<uint64_t>(PRN), resident);
+            d_map_base[prog_mems_addr] = local_code_fpga_select_bank | bank;
+            if (resident)
+                {
+                    d_map_base[code_length_minus_1_reg_addr] = d_code_length_samples - 1;  // number of samples - 1
+                    return;
+                }
+        }
+
     uint32_t k;
     d_map_base[prog_mems_addr] = local_code_fpga_clear_address_counter;
     for (k = 0; k < d_code_length_samples; k++)
@@ -358,12 +404,20 @@ void Fpga_Multicorrelator_8sc::fpga_configure_signal_parameters_in_fpga()
 
 void Fpga_Multicorrelator_8sc::fpga_launch_multicorrelator_fpga()
 {
-    // enable interrupts
-    int32_t reenable = 1;
-    ssize_t nbytes = TEMP_FAILURE_RETRY(write(d_device_descriptor, reinterpret_cast<void *>(&reenable), sizeof(int32_t)));
-    if (nbytes != sizeof(int32_t))
+    if (d_result_ring)
         {
-            std::cerr << "Error launching the FPGA multicorrelator\n";
+            // the results arrive through the shared ring, no interrupt of this channel
+            d_result_ring->arm(d_channel);
+        }
+    else
+        {
+            // enable interrupts
+            int32_t reenable = 1;
+            ssize_t nbytes = TEMP_FAILURE_RETRY(write(d_device_descriptor, reinterpret_cast<void *>(&reenable), sizeof(int32_t)));
+            if (nbytes != sizeof(int32_t))
+                {
+                    std::cerr << "Error launching the FPGA multicorrelator\n";
+                }
         }
     // writing 1 to reg 14 launches the tracking
     d_map_base[start_flag_addr] = 1;
@@ -375,6 +429,19 @@ void Fpga_Multicorrelator_8sc::read_tracking_gps_results()
     int32_t readval_real;
     int32_t readval_imag;
 
+    if (d_result_ring)
+        {
+            for (uint32_t k = 0; k < d_n_correlators; k++)
+                {
+                    d_corr_out[k] = gr_complex(d_ring_results_real[k], d_ring_results_imag[k]);
+                }
+            if (d_track_pilot)
+                {
+                    d_Prompt_Data[0] = gr_complex(d_ring_results_real[d_n_correlators], d_ring_results_imag[d_n_correlators]);
+                }
+            return;
+        }
+
     for (uint32_t k = 0; k < d_n_correlators; k++)
         {
             readval_real = d_map_base[result_reg_real_base_addr + k];
@@ -401,6 +468,11 @@ void Fpga_Multicorrelator_8sc::unlock_channel()
 
 void Fpga_Multicorrelator_8sc::close_device()
 {
+    if (d_result_ring)
+        {
+            d_map_base[result_ring_reg_addr] = 0;
+            d_result_ring = nullptr;
+        }
     auto *aux = const_cast<uint32_t *>(d_map_base);
     if (munmap(static_cast<void *>(aux), page_size) == -1)
         {
@@ -23,9 +23,13 @@
 #ifndef GNSS_SDR_FPGA_MULTICORRELATOR_H
 #define GNSS_SDR_FPGA_MULTICORRELATOR_H
 
+#include "fpga_code_bank_cache.h"
+#include "fpga_tracking_result_ring.h"
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 /** \addtogroup Tracking
@@ -48,7 +52,8 @@ public:
         int32_t *data_codes,
         uint32_t code_length_chips,
         bool track_pilot,
-        uint32_t code_samples_per_chip);
+        uint32_t code_samples_per_chip,
+        uint32_t code_banks = 1);
 
     /*!
      * \brief Destructor
@@ -61,7 +66,9 @@ public:
     void set_output_vectors(gr_complex *corr_out, gr_complex *Prompt_Data);
 
     /*!
-     * \brief Configure the local code in the FPGA multicorrelator
+     * \brief Configure the local code in the FPGA multicorrelator. If the
+     * multicorrelator has several code banks and the code of the PRN is
+     * already in one of them, only the bank is selected.
      */
     void set_local_code_and_taps(
         float *shifts_chips, float *prompt_data_shift, int32_t PRN);
@@ -93,6 +100,13 @@ public:
      */
     void open_channel(const std::string &device_io_name, uint32_t channel);
 
+    /*!
+     * \brief Deliver the results of this channel through a ring shared by all
+     * the channels instead of its own interrupt and result registers. Must be
+     * called after open_channel(). A null ring restores the per-channel mode.
+     */
+    void set_result_ring(std::shared_ptr<Fpga_Tracking_Result_Ring> result_ring);
+
     /*!
      * \brief Set the initial sample number where the tracking process begins
      */
@@ -166,6 +180,7 @@ private:
     static const uint32_t code_phase_step_chips_rate_reg_addr = 21;
     static const uint32_t phase_step_rate_reg_addr = 22;
     static const uint32_t stop_tracking_reg_addr = 23;
+    static const uint32_t result_ring_reg_addr = 24;
     static const uint32_t secondary_code_lengths_reg_addr = 25;
     static const uint32_t prog_secondary_code_0_data_reg_addr = 26;
     static const uint32_t prog_secondary_code_1_data_reg_addr = 27;
@@ -186,9 +201,11 @@ private:
     static const uint32_t drop_samples = 1;                     // bit 0 of drop_samples_reg_addr
     static const uint32_t enable_secondary_code = 2;            // bit 1 of drop_samples_reg_addr
     static const uint32_t init_secondary_code_addresses = 4;    // bit 2 of drop_samples_reg_addr
+    static const uint32_t result_ring_enable = 1;               // bit 0 of result_ring_reg_addr, the channel tag goes above it
     static const uint32_t page_size = 0x10000;
     static const uint32_t max_code_resampler_counter = 1 << 31;  // 2^(number of bits of precision of the code resampler)
     static const uint32_t local_code_fpga_clear_address_counter = 0x10000000;
+    static const uint32_t local_code_fpga_select_bank = 0x20000000;  // the bank goes in the LSBs
     static const uint32_t test_register_track_writeval = 0x55AA;
 
     // private functions
@@ -227,6 +244,12 @@ private:
     // data related to the hardware module and the driver
     int32_t d_device_descriptor;    // driver descriptor
     volatile uint32_t *d_map_base;  // driver memory map
+    uint32_t d_channel;
+
+    // batched delivery of the results, if enabled
+    std::shared_ptr<Fpga_Tracking_Result_Ring> d_result_ring;
+    std::array<int32_t, Fpga_Tracking_Result_Ring::max_results> d_ring_results_real{};
+    std::array<int32_t, Fpga_Tracking_Result_Ring::max_results> d_ring_results_imag{};
 
     // configuration data received from the interface
     uint32_t d_correlator_length_samples;
@@ -247,6 +270,9 @@ private:
 
     bool d_track_pilot;
     bool d_secondary_code_enabled;
+
+    // PRN codes resident in the code banks
+    Fpga_Code_Bank_Cache d_code_banks;
 };
 
 
@@ -0,0 +1,259 @@
+/*!
+ * \file fpga_tracking_result_ring.cc
+ * \brief Ring of correlation results written by DMA from all the FPGA
+ * tracking channels, serviced by a single interrupt handling thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fpga_tracking_result_ring.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>  // for O_RDWR, O_SYNC
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <sys/mman.h>  // for PROT_READ, PROT_WRITE, MAP_SHARED
+#include <unistd.h>
+#include <vector>
+
+#ifndef TEMP_FAILURE_RETRY
+#define TEMP_FAILURE_RETRY(exp)              \
+    ({                                       \
+        decltype(exp) _rc;                   \
+        do                                   \
+            {                                \
+                _rc = (exp);                 \
+            }                                \
+        while (_rc == -1 && errno == EINTR); \
+        _rc;                                 \
+    })
+#endif
+
+
+std::shared_ptr<Fpga_Tracking_Result_Ring> Fpga_Tracking_Result_Ring::get(const std::string& device_io_name,
+    uint32_t irq_entries,
+    uint32_t irq_timeout_us)
+{
+    static std::mutex rings_mutex;
+    static std::map<std::string, std::weak_ptr<Fpga_Tracking_Result_Ring>> rings;
+
+    const std::lock_guard<std::mutex> lock(rings_mutex);
+    std::shared_ptr<Fpga_Tracking_Result_Ring> ring = rings[device_io_name].lock();
+    if (!ring)
+        {
+            ring = std::shared_ptr<Fpga_Tracking_Result_Ring>(new Fpga_Tracking_Result_Ring(device_io_name, irq_entries, irq_timeout_us));
+            rings[device_io_name] = ring;
+        }
+    return ring;
+}
+
+
+Fpga_Tracking_Result_Ring::Fpga_Tracking_Result_Ring(const std::string& device_io_name,
+    uint32_t irq_entries,
+    uint32_t irq_timeout_us)
+{
+    if ((d_device_descriptor = open(device_io_name.c_str(), O_RDWR | O_SYNC)) == -1)
+        {
+            LOG(WARNING) << "Cannot open deviceio " << device_io_name;
+            std::cout << "Cannot open deviceio " << device_io_name << '\n';
+            return;
+        }
+    d_map_base = reinterpret_cast<volatile uint32_t*>(mmap(nullptr, page_size,
+        PROT_READ | PROT_WRITE, MAP_SHARED, d_device_descriptor, 0));
+    if (d_map_base == reinterpret_cast<void*>(-1))
+        {
+            LOG(WARNING) << "Cannot map the FPGA tracking result ring registers into user memory";
+            std::cout << "Cannot map deviceio " << device_io_name << '\n';
+            d_map_base = nullptr;
+            close_device();
+            return;
+        }
+
+    // sanity check: check test register
+    d_map_base[test_reg_addr] = test_register_writeval;
+    if (d_map_base[test_reg_addr] != test_register_writeval)
+        {
+            LOG(WARNING) << "Tracking result ring test register sanity check failed";
+            std::cout << "Tracking result ring test register sanity check failed\n";
+        }
+
+    // the second memory map of a UIO device is selected with an offset of one page
+    d_ring_entries = d_map_base[ring_entries_reg_addr];
+    d_ring_map_size = static_cast<size_t>(d_ring_entries) * entry_words * sizeof(uint32_t);
+    d_ring_base = reinterpret_cast<volatile uint32_t*>(mmap(nullptr, d_ring_map_size,
+        PROT_READ, MAP_SHARED, d_device_descriptor, getpagesize()));
+    if (d_ring_entries == 0 or d_ring_base == reinterpret_cast<void*>(-1))
+        {
+            LOG(WARNING) << "Cannot map the FPGA tracking result ring into user memory";
+            std::cout << "Cannot map the tracking result ring of deviceio " << device_io_name << '\n';
+            d_ring_base = nullptr;
+            close_device();
+            return;
+        }
+
+    d_read_index = d_map_base[write_index_reg_addr];  // discard stale entries
+    d_map_base[read_index_reg_addr] = d_read_index;
+    d_map_base[irq_entries_reg_addr] = irq_entries;
+    d_map_base[irq_timeout_us_reg_addr] = irq_timeout_us;
+    d_map_base[enable_reg_addr] = 1;
+
+    LOG(INFO) << "Tracking result ring " << device_io_name << " with " << d_ring_entries
+              << " entries, interrupt every " << irq_entries << " entries or " << irq_timeout_us << " us";
+    d_running = true;
+    d_thread = std::thread(&Fpga_Tracking_Result_Ring::run, this);
+}
+
+
+Fpga_Tracking_Result_Ring::~Fpga_Tracking_Result_Ring()
+{
+    {
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        d_running = false;
+    }
+    for (auto& slot : d_slots)
+        {
+            slot.cv.notify_all();
+        }
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+    close_device();
+}
+
+
+void Fpga_Tracking_Result_Ring::arm(uint32_t channel)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    d_slots[channel % max_channels].ready = false;
+}
+
+
+bool Fpga_Tracking_Result_Ring::wait_results(uint32_t channel, int32_t* real, int32_t* imag)
+{
+    Slot& slot = d_slots[channel % max_channels];
+    std::unique_lock<std::mutex> lock(d_mutex);
+    slot.cv.wait(lock, [this, &slot] { return slot.ready or !d_running; });
+    if (!slot.ready)
+        {
+            return false;
+        }
+    std::copy(slot.real.cbegin(), slot.real.cend(), real);
+    std::copy(slot.imag.cbegin(), slot.imag.cend(), imag);
+    slot.ready = false;
+    return true;
+}
+
+
+void Fpga_Tracking_Result_Ring::run()
+{
+    pollfd pfd{d_device_descriptor, POLLIN, 0};
+    while (d_running)
+        {
+            // enable interrupts
+            int32_t reenable = 1;
+            if (TEMP_FAILURE_RETRY(write(d_device_descriptor, &reenable, sizeof(int32_t))) != sizeof(int32_t))
+                {
+                    LOG(WARNING) << "Error enabling the tracking result ring interrupt";
+                }
+            // the FPGA may have written entries before the interrupt was enabled
+            drain();
+
+            const int ready = TEMP_FAILURE_RETRY(poll(&pfd, 1, poll_timeout_ms));
+            if (ready > 0)
+                {
+                    int32_t irq_count;
+                    if (read(d_device_descriptor, &irq_count, sizeof(irq_count)) != sizeof(irq_count))
+                        {
+                            LOG(WARNING) << "Tracking result ring read failed to retrieve 4 bytes";
+                        }
+                    d_interrupts++;
+                    drain();
+                }
+            else if (ready < 0)
+                {
+                    LOG(WARNING) << "Error waiting for the tracking result ring interrupt";
+                    {
+                        const std::lock_guard<std::mutex> lock(d_mutex);
+                        d_running = false;
+                    }
+                    for (auto& slot : d_slots)
+                        {
+                            slot.cv.notify_all();
+                        }
+                }
+        }
+}
+
+
+void Fpga_Tracking_Result_Ring::drain()
+{
+    const uint32_t write_index = d_map_base[write_index_reg_addr];
+    if (write_index == d_read_index)
+        {
+            return;
+        }
+
+    std::vector<uint32_t> woken;
+    {
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        for (; d_read_index != write_index; d_read_index++)
+            {
+                const volatile uint32_t* entry = d_ring_base + static_cast<size_t>(d_read_index % d_ring_entries) * entry_words;
+                const uint32_t channel = entry[entry_channel_word] % max_channels;
+                Slot& slot = d_slots[channel];
+                for (uint32_t k = 0; k < max_results; k++)
+                    {
+                        slot.real[k] = static_cast<int32_t>(entry[entry_real_base_word + k]);
+                        slot.imag[k] = static_cast<int32_t>(entry[entry_imag_base_word + k]);
+                    }
+                slot.ready = true;
+                woken.push_back(channel);
+                d_entries++;
+            }
+    }
+    // give the consumed entries back to the FPGA
+    d_map_base[read_index_reg_addr] = d_read_index;
+
+    for (const uint32_t channel : woken)
+        {
+            d_slots[channel].cv.notify_one();
+        }
+}
+
+
+void Fpga_Tracking_Result_Ring::close_device()
+{
+    if (d_map_base != nullptr)
+        {
+            d_map_base[enable_reg_addr] = 0;
+            if (munmap(const_cast<uint32_t*>(d_map_base), page_size) == -1)
+                {
+                    std::cout << "Failed to unmap memory uio\n";
+                }
+            d_map_base = nullptr;
+        }
+    if (d_ring_base != nullptr)
+        {
+            if (munmap(const_cast<uint32_t*>(d_ring_base), d_ring_map_size) == -1)
+                {
+                    std::cout << "Failed to unmap memory uio\n";
+                }
+            d_ring_base = nullptr;
+        }
+    if (d_device_descriptor != -1)
+        {
+            close(d_device_descriptor);
+            d_device_descriptor = -1;
+        }
+}
@@ -0,0 +1,146 @@
+/*!
+ * \file fpga_tracking_result_ring.h
+ * \brief Ring of correlation results written by DMA from all the FPGA
+ * tracking channels, serviced by a single interrupt handling thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FPGA_TRACKING_RESULT_RING_H
+#define GNSS_SDR_FPGA_TRACKING_RESULT_RING_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Batched delivery of the FPGA tracking results.
+ *
+ * When a multicorrelator is attached to the ring, the FPGA does not raise
+ * the interrupt of its channel at the end of each correlation. Instead, it
+ * writes an entry with the channel tag and the correlation results in a ring
+ * buffer in host memory, and raises the interrupt of the ring once
+ * irq_entries entries are pending or irq_timeout_us microseconds after the
+ * oldest pending one, whatever comes first. A single thread waits for that
+ * interrupt, drains all the pending entries and wakes up the channels whose
+ * results have arrived, so one interrupt and two system calls are shared by
+ * all the channels and epochs of the batch.
+ *
+ * The UIO device of the ring exposes the control registers in its first
+ * memory map and the ring entries in the second one.
+ */
+class Fpga_Tracking_Result_Ring
+{
+public:
+    static const uint32_t max_channels = 64;  // channel tags that the FPGA can assign
+    static const uint32_t max_results = 6;    // correlators per entry, including the pilot prompt
+
+    /*!
+     * \brief Returns the ring of the UIO device device_io_name, opening it
+     * and starting its thread on the first call. The ring is closed when the
+     * last multicorrelator attached to it is destroyed.
+     */
+    static std::shared_ptr<Fpga_Tracking_Result_Ring> get(const std::string& device_io_name,
+        uint32_t irq_entries,
+        uint32_t irq_timeout_us);
+
+    ~Fpga_Tracking_Result_Ring();
+
+    Fpga_Tracking_Result_Ring(const Fpga_Tracking_Result_Ring&) = delete;
+    Fpga_Tracking_Result_Ring& operator=(const Fpga_Tracking_Result_Ring&) = delete;
+
+    /*!
+     * \brief Returns true if the device was mapped and its thread is running.
+     */
+    bool enabled() const { return d_running.load(); }
+
+    /*!
+     * \brief Discards the results of the channel before launching a new
+     * correlation.
+     */
+    void arm(uint32_t channel);
+
+    /*!
+     * \brief Blocks until the FPGA delivers the results of the correlation
+     * launched by the channel after its last call to arm(), and copies them
+     * to real and imag. Returns false if the ring is stopped first.
+     */
+    bool wait_results(uint32_t channel, int32_t* real, int32_t* imag);
+
+    /*!
+     * \brief Returns the number of interrupts serviced and the number of
+     * entries they delivered, for diagnostics.
+     */
+    uint64_t interrupts() const { return d_interrupts.load(); }
+    uint64_t entries() const { return d_entries.load(); }
+
+private:
+    // control registers (first memory map)
+    static const uint32_t write_index_reg_addr = 0;     // read only, entries written by the FPGA
+    static const uint32_t read_index_reg_addr = 1;      // entries consumed by the host
+    static const uint32_t irq_entries_reg_addr = 2;     // pending entries that raise the interrupt
+    static const uint32_t irq_timeout_us_reg_addr = 3;  // maximum latency of a pending entry
+    static const uint32_t ring_entries_reg_addr = 4;    // read only, capacity of the ring
+    static const uint32_t enable_reg_addr = 5;          // 1 enables the DMA of the results
+    static const uint32_t test_reg_addr = 31;
+    // layout of each ring entry, in 32-bit words
+    static const uint32_t entry_channel_word = 0;
+    static const uint32_t entry_real_base_word = 1;
+    static const uint32_t entry_imag_base_word = entry_real_base_word + max_results;
+    static const uint32_t entry_words = 16;
+    static const uint32_t page_size = 0x10000;
+    static const uint32_t test_register_writeval = 0x55AA;
+    static const int poll_timeout_ms = 100;  // period to check for a stop request
+
+    struct Slot
+    {
+        std::condition_variable cv;
+        std::array<int32_t, max_results> real{};
+        std::array<int32_t, max_results> imag{};
+        bool ready{false};
+    };
+
+    Fpga_Tracking_Result_Ring(const std::string& device_io_name, uint32_t irq_entries, uint32_t irq_timeout_us);
+    void run();
+    void drain();
+    void close_device();
+
+    std::array<Slot, max_channels> d_slots;
+    std::mutex d_mutex;
+    std::thread d_thread;
+    std::atomic<bool> d_running{false};
+    std::atomic<uint64_t> d_interrupts{0};
+    std::atomic<uint64_t> d_entries{0};
+
+    volatile uint32_t* d_map_base{nullptr};   // control registers
+    volatile uint32_t* d_ring_base{nullptr};  // DMA ring
+    size_t d_ring_map_size{0};
+    int32_t d_device_descriptor{-1};
+    uint32_t d_ring_entries{0};
+    uint32_t d_read_index{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FPGA_TRACKING_RESULT_RING_H
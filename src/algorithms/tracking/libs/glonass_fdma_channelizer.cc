@@ -0,0 +1,168 @@
+/*!
+ * \file glonass_fdma_channelizer.cc
+ * \brief Frequency translation and decimation of the GLONASS FDMA frequency
+ * slots, shared by the tracking channels of a band
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "glonass_fdma_channelizer.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+
+std::shared_ptr<Glonass_Fdma_Channelizer> Glonass_Fdma_Channelizer::shared(const void* stream,
+    int64_t fs_in,
+    int64_t slot_spacing_hz,
+    int32_t decimation)
+{
+    using Key = std::tuple<const void*, int64_t, int64_t, int32_t>;
+    static std::mutex registry_mutex;
+    static std::map<Key, std::weak_ptr<Glonass_Fdma_Channelizer>> registry;
+
+    const std::lock_guard<std::mutex> lock(registry_mutex);
+    const Key key(stream, fs_in, slot_spacing_hz, decimation);
+    std::shared_ptr<Glonass_Fdma_Channelizer> channelizer = registry[key].lock();
+    if (channelizer == nullptr)
+        {
+            // the channels of a previous flow graph released theirs, so its
+            // stream address may now be used by another stream
+            channelizer = std::make_shared<Glonass_Fdma_Channelizer>(fs_in, slot_spacing_hz, decimation);
+            registry[key] = channelizer;
+        }
+    return channelizer;
+}
+
+
+Glonass_Fdma_Channelizer::Glonass_Fdma_Channelizer(int64_t fs_in, int64_t slot_spacing_hz, int32_t decimation)
+    : d_fs_in(fs_in),
+      d_slot_spacing_hz(slot_spacing_hz),
+      d_decimation(std::max(decimation, 1))
+{
+    for (auto& s : d_slots)
+        {
+            s.ring = volk_gnsssdr::vector<std::complex<float>>(RING_SIZE);
+        }
+}
+
+
+double Glonass_Fdma_Channelizer::translation_phase_rad(int32_t slot, uint64_t n) const
+{
+    // exact cycles modulo 1, computed in integers so that the phase does not
+    // lose precision as the sample counter grows
+    const auto fs = static_cast<uint64_t>(d_fs_in);
+    const int64_t freq_hz = static_cast<int64_t>(slot) * d_slot_spacing_hz;
+    const auto freq_mod_fs = static_cast<uint64_t>(((freq_hz % d_fs_in) + d_fs_in) % d_fs_in);
+    const uint64_t cycles_mod_fs = ((n % fs) * freq_mod_fs) % fs;
+    return TWO_PI * static_cast<double>(cycles_mod_fs) / static_cast<double>(fs);
+}
+
+
+void Glonass_Fdma_Channelizer::compute(int32_t slot,
+    Slot& s,
+    uint64_t first_sample,
+    const std::complex<float>* in,
+    uint64_t j_begin,
+    uint64_t j_end,
+    std::complex<float>* out)
+{
+    const auto decimation = static_cast<uint64_t>(d_decimation);
+    const auto n_in = static_cast<size_t>((j_end - j_begin) * decimation);
+    if (s.scratch.size() < n_in)
+        {
+            s.scratch.resize(n_in);
+        }
+    double phase_rad = -translation_phase_rad(slot, j_begin * decimation);
+    const double phase_inc_rad = -TWO_PI * static_cast<double>(static_cast<int64_t>(slot) * d_slot_spacing_hz) / static_cast<double>(d_fs_in);
+    volk_gnsssdr_32fc_s64f_x2_rotator_32fc(s.scratch.data(), in + (j_begin * decimation - first_sample), phase_inc_rad, &phase_rad, static_cast<unsigned int>(n_in));
+
+    const std::complex<float>* translated = s.scratch.data();
+    for (uint64_t j = j_begin; j < j_end; j++)
+        {
+            std::complex<float> dump(0.0, 0.0);
+            for (uint64_t i = 0; i < decimation; i++)
+                {
+                    dump += translated[i];
+                }
+            out[j - j_begin] = dump;
+            translated += decimation;
+        }
+    d_computed_samples += j_end - j_begin;
+}
+
+
+int32_t Glonass_Fdma_Channelizer::translate(int32_t slot,
+    uint64_t first_sample,
+    const std::complex<float>* in,
+    int32_t n_samples,
+    std::complex<float>* out,
+    uint64_t& first_output)
+{
+    const auto decimation = static_cast<uint64_t>(d_decimation);
+    const uint64_t j_begin = (first_sample + decimation - 1) / decimation;
+    const uint64_t j_end = (first_sample + static_cast<uint64_t>(std::max(n_samples, 0))) / decimation;
+    first_output = j_begin;
+    if (slot < MIN_SLOT or slot >= MIN_SLOT + NUM_SLOTS or j_end <= j_begin)
+        {
+            return 0;
+        }
+    const uint64_t n_out = j_end - j_begin;
+    Slot& s = d_slots[slot - MIN_SLOT];
+    const std::lock_guard<std::mutex> lock(s.mutex);
+
+    if (n_out > RING_SIZE / 2)
+        {
+            compute(slot, s, first_sample, in, j_begin, j_end, out);
+            return static_cast<int32_t>(n_out);
+        }
+
+    // older than the ring: computed for this request only
+    const uint64_t ring_begin = s.end - s.count;
+    if (j_begin < ring_begin)
+        {
+            compute(slot, s, first_sample, in, j_begin, std::min(j_end, ring_begin), out);
+        }
+
+    // newer than the ring: computed and appended
+    if (j_end > s.end)
+        {
+            if (j_begin > s.end)
+                {
+                    s.end = j_begin;
+                    s.count = 0;
+                }
+            const uint64_t j_fresh = s.end;
+            if (s.fresh.size() < j_end - j_fresh)
+                {
+                    s.fresh.resize(j_end - j_fresh);
+                }
+            compute(slot, s, first_sample, in, j_fresh, j_end, s.fresh.data());
+            for (uint64_t j = j_fresh; j < j_end; j++)
+                {
+                    s.ring[j & (RING_SIZE - 1)] = s.fresh[j - j_fresh];
+                }
+            s.end = j_end;
+            s.count += j_end - j_fresh;
+            if (s.count > RING_SIZE)
+                {
+                    s.count = RING_SIZE;
+                }
+        }
+
+    for (uint64_t j = std::max(j_begin, ring_begin); j < j_end; j++)
+        {
+            out[j - j_begin] = s.ring[j & (RING_SIZE - 1)];
+        }
+    return static_cast<int32_t>(n_out);
+}
@@ -0,0 +1,115 @@
+/*!
+ * \file glonass_fdma_channelizer.h
+ * \brief Frequency translation and decimation of the GLONASS FDMA frequency
+ * slots, shared by the tracking channels of a band
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GLONASS_FDMA_CHANNELIZER_H
+#define GNSS_SDR_GLONASS_FDMA_CHANNELIZER_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Brings the GLONASS frequency slots of an input stream to baseband
+ * at a lower sample rate.
+ *
+ * The samples of slot k are multiplied by exp(-j 2 pi k slot_spacing_hz n / fs)
+ * (n being the absolute sample number in the stream, so the phase does not
+ * depend on which channel asks first) and integrated in dumps of
+ * `decimation` samples. Decimated sample j is the dump of the input samples
+ * [j * decimation, (j + 1) * decimation).
+ *
+ * The decimated samples of each slot are kept in a ring, so the channels
+ * tracking the same slot of the same stream (the L1 and L2 channels of a
+ * satellite pair, or several channels on a satellite) translate each input
+ * sample once, and then correlate at the decimated rate.
+ */
+class Glonass_Fdma_Channelizer
+{
+public:
+    /*!
+     * \brief Returns the channelizer of a stream (any address identifying
+     * it, e.g. its flow graph buffer), creating it if no channel holds it.
+     */
+    static std::shared_ptr<Glonass_Fdma_Channelizer> shared(const void* stream,
+        int64_t fs_in,
+        int64_t slot_spacing_hz,
+        int32_t decimation);
+
+    Glonass_Fdma_Channelizer(int64_t fs_in, int64_t slot_spacing_hz, int32_t decimation);
+
+    /*!
+     * \brief Writes in out the decimated samples of slot k whose dumps lie
+     * in the input samples [first_sample, first_sample + n_samples), with in
+     * pointing at first_sample. Returns their number, and the index of the
+     * first one in first_output.
+     */
+    int32_t translate(int32_t slot,
+        uint64_t first_sample,
+        const std::complex<float>* in,
+        int32_t n_samples,
+        std::complex<float>* out,
+        uint64_t& first_output);
+
+    /*!
+     * \brief Phase in radians, in [0, 2 pi), removed from input sample n of
+     * slot k.
+     */
+    double translation_phase_rad(int32_t slot, uint64_t n) const;
+
+    inline int32_t decimation() const { return d_decimation; }
+
+    //! Number of decimated samples computed, not served from the ring
+    inline uint64_t computed_samples() const { return d_computed_samples.load(); }
+
+private:
+    static constexpr int32_t MIN_SLOT = -7;
+    static constexpr int32_t NUM_SLOTS = 14;
+    static constexpr uint64_t RING_SIZE = 1U << 16U;  // decimated samples kept per slot
+
+    class Slot
+    {
+    public:
+        volk_gnsssdr::vector<std::complex<float>> ring;
+        volk_gnsssdr::vector<std::complex<float>> scratch;  // translated input samples
+        volk_gnsssdr::vector<std::complex<float>> fresh;    // new decimated samples
+        uint64_t end{0};    // index of the sample following the last one in the ring
+        uint64_t count{0};  // samples in the ring, ending at end
+        std::mutex mutex;
+    };
+
+    void compute(int32_t slot, Slot& s, uint64_t first_sample, const std::complex<float>* in, uint64_t j_begin, uint64_t j_end, std::complex<float>* out);
+
+    std::array<Slot, NUM_SLOTS> d_slots;
+    int64_t d_fs_in;
+    int64_t d_slot_spacing_hz;
+    int32_t d_decimation;
+    std::atomic<uint64_t> d_computed_samples{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GLONASS_FDMA_CHANNELIZER_H
@@ -46,6 +46,7 @@ Kf_Conf::Kf_Conf() : item_type("gr_complex"),
                      init_carrier_phase_sd_rad(10),
                      init_carrier_freq_sd_hz(1000),
                      init_carrier_freq_rate_sd_hz_s(1000),
+                     vtl_doppler_sd_hz(1.0),
                      early_late_space_chips(0.25),
                      very_early_late_space_chips(0.5),
                      early_late_space_narrow_chips(0.15),
@@ -74,7 +75,8 @@ Kf_Conf::Kf_Conf() : item_type("gr_complex"),
                      dump(false),
                      dump_mat(true),
                      enable_dynamic_measurement_covariance(false),
-                     use_estimated_cn0(false)
+                     use_estimated_cn0(false),
+                     enable_vtl_aiding(false)
 {
     signal[0] = '1';
     signal[1] = 'C';
@@ -160,4 +162,13 @@ void Kf_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     init_carrier_phase_sd_rad = configuration->property(role + ".init_carrier_phase_sd_rad", init_carrier_phase_sd_rad);
     init_carrier_freq_sd_hz = configuration->property(role + ".init_carrier_freq_sd_hz", init_carrier_freq_sd_hz);
     init_carrier_freq_rate_sd_hz_s = configuration->property(role + ".init_carrier_freq_rate_sd_hz_s", init_carrier_freq_rate_sd_hz_s);
+
+    // Carrier Doppler aiding from the PVT
+    enable_vtl_aiding = configuration->property(role + ".enable_vtl_aiding", enable_vtl_aiding);
+    vtl_doppler_sd_hz = configuration->property(role + ".vtl_doppler_sd_hz", vtl_doppler_sd_hz);
+    if (vtl_doppler_sd_hz <= 0.0)
+        {
+            LOG(WARNING) << "vtl_doppler_sd_hz must be positive. Set to 1.0";
+            vtl_doppler_sd_hz = 1.0;
+        }
 }
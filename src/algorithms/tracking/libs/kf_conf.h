@@ -69,6 +69,9 @@ public:
     double init_carrier_freq_sd_hz;
     double init_carrier_freq_rate_sd_hz_s;
 
+    // Carrier Doppler aiding from the PVT (vector tracking)
+    double vtl_doppler_sd_hz;
+
     float early_late_space_chips;
     float very_early_late_space_chips;
     float early_late_space_narrow_chips;
@@ -100,6 +103,7 @@ public:
 
     bool enable_dynamic_measurement_covariance;
     bool use_estimated_cn0;
+    bool enable_vtl_aiding;
 };
 
 #endif
@@ -33,6 +33,7 @@
  */
 
 #include "lock_detectors.h"
+#include <algorithm>
 #include <cmath>
 
 /*
@@ -146,3 +147,94 @@ float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
 }
+
+
+Cn0_Estimation_Window::Cn0_Estimation_Window(int length)
+    : d_prompts(std::max(length, 1)),
+      d_length(std::max(length, 1))
+{
+}
+
+
+void Cn0_Estimation_Window::push(const gr_complex& prompt)
+{
+    if (d_count == d_length)
+        {
+            const gr_complex& oldest = d_prompts[d_next];
+            const double p2 = std::norm(oldest);
+            d_sum_abs_re -= std::abs(oldest.real());
+            d_sum_m2 -= p2;
+            d_sum_m4 -= p2 * p2;
+        }
+    else
+        {
+            d_count++;
+        }
+    d_prompts[d_next] = prompt;
+    const double p2 = std::norm(prompt);
+    d_sum_abs_re += std::abs(prompt.real());
+    d_sum_m2 += p2;
+    d_sum_m4 += p2 * p2;
+    d_next++;
+    if (d_next == d_length)
+        {
+            d_next = 0;
+            resum();
+        }
+}
+
+
+void Cn0_Estimation_Window::reset()
+{
+    d_sum_abs_re = 0.0;
+    d_sum_m2 = 0.0;
+    d_sum_m4 = 0.0;
+    d_count = 0;
+    d_next = 0;
+}
+
+
+// Removes the rounding errors accumulated by the updates, once per window
+void Cn0_Estimation_Window::resum()
+{
+    d_sum_abs_re = 0.0;
+    d_sum_m2 = 0.0;
+    d_sum_m4 = 0.0;
+    for (int i = 0; i < d_count; i++)
+        {
+            const double p2 = std::norm(d_prompts[i]);
+            d_sum_abs_re += std::abs(d_prompts[i].real());
+            d_sum_m2 += p2;
+            d_sum_m4 += p2 * p2;
+        }
+}
+
+
+float Cn0_Estimation_Window::cn0_svn(float coh_integration_time_s) const
+{
+    const auto n = static_cast<double>(std::max(d_count, 1));
+    const double Psig = (d_sum_abs_re / n) * (d_sum_abs_re / n);
+    const double Ptot = d_sum_m2 / n;
+    const auto SNR = static_cast<float>(Psig / (Ptot - Psig));
+    return 10.0F * std::log10(SNR) - 10.0F * std::log10(coh_integration_time_s);
+}
+
+
+float Cn0_Estimation_Window::cn0_m2m4(float coh_integration_time_s) const
+{
+    const auto n = static_cast<double>(std::max(d_count, 1));
+    const double m_2 = d_sum_m2 / n;
+    const double m_4 = d_sum_m4 / n;
+    const double aux = std::sqrt(2.0 * m_2 * m_2 - m_4);
+    double SNR_aux;
+    if (std::isnan(aux))
+        {
+            const double Psig = (d_sum_abs_re / n) * (d_sum_abs_re / n);
+            SNR_aux = Psig / (m_2 - Psig);
+        }
+    else
+        {
+            SNR_aux = aux / (m_2 - aux);
+        }
+    return 10.0F * std::log10(static_cast<float>(SNR_aux)) - 10.0F * std::log10(coh_integration_time_s);
+}
@@ -36,6 +36,7 @@
 #define GNSS_SDR_LOCK_DETECTORS_H
 
 #include <gnuradio/gr_complex.h>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -109,6 +110,46 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
 float carrier_lock_detector(gr_complex* Prompt_buffer, int length);
 
 
+/*!
+ * \brief Sliding window of the last prompt correlator outputs, with the
+ * running sums of the C/N0 estimators, so that the estimates over the window
+ * are refreshed every prompt in O(1) instead of recomputed over it.
+ *
+ * cn0_svn() and cn0_m2m4() give the same values as cn0_svn_estimator() and
+ * cn0_m2m4_estimator() over the prompts in the window. The sums are kept in
+ * double precision and recomputed each time the window wraps around, so
+ * they do not drift.
+ */
+class Cn0_Estimation_Window
+{
+public:
+    explicit Cn0_Estimation_Window(int length = 1);
+
+    //! Adds a prompt, dropping the oldest one if the window is full
+    void push(const gr_complex& prompt);
+
+    //! Empties the window
+    void reset();
+
+    inline bool full() const { return d_count == d_length; }
+
+    float cn0_svn(float coh_integration_time_s) const;
+
+    float cn0_m2m4(float coh_integration_time_s) const;
+
+private:
+    void resum();
+
+    std::vector<gr_complex> d_prompts;
+    double d_sum_abs_re{0.0};
+    double d_sum_m2{0.0};
+    double d_sum_m4{0.0};
+    int d_length;
+    int d_count{0};
+    int d_next{0};
+};
+
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_LOCK_DETECTORS_H
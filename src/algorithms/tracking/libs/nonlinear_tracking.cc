@@ -27,6 +27,52 @@
  */
 
 #include "nonlinear_tracking.h"
+#include <cmath>
+
+
+arma::mat ModelFunction::evaluate_columns(const arma::mat& points)
+{
+    arma::mat outputs;
+    for (arma::uword i = 0; i < points.n_cols; i++)
+        {
+            const arma::vec output = (*this)(points.col(i));
+            if (i == 0)
+                {
+                    outputs.set_size(output.n_elem, points.n_cols);
+                }
+            outputs.col(i) = output;
+        }
+    return outputs;
+}
+
+
+namespace
+{
+// Cubature points x +/- sqrt(nx) S.col(i), with S the lower Cholesky factor of P
+void cubature_points(arma::mat& points, const arma::vec& x, const arma::mat& P)
+{
+    const arma::uword nx = x.n_elem;
+    const arma::mat Sm = std::sqrt(static_cast<double>(nx)) * arma::chol(P, "lower");
+    points.set_size(nx, 2 * nx);
+    points.head_cols(nx) = Sm;
+    points.tail_cols(nx) = -Sm;
+    points.each_col() += x;
+}
+
+
+// Sigma points x, and x +/- the columns of scale * sqrtm(P)
+void sigma_points(arma::mat& points, const arma::vec& x, const arma::mat& P, float scale)
+{
+    const arma::uword nx = x.n_elem;
+    const arma::mat Xi_fact = scale * arma::sqrtmat_sympd(P);
+    points.set_size(nx, 2 * nx + 1);
+    points.col(0).zeros();
+    points.cols(1, nx) = Xi_fact;
+    points.cols(nx + 1, 2 * nx) = -Xi_fact;
+    points.each_col() += x;
+}
+}  // namespace
+
 
 /***************** CUBATURE KALMAN FILTER *****************/
 
@@ -73,35 +119,15 @@ void CubatureFilter::initialize(const arma::mat& x_pred_0, const arma::mat& P_x_
 void CubatureFilter::predict_sequential(const arma::vec& x_post, const arma::mat& P_x_post, ModelFunction* transition_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of cubature points
-    int nx = x_post.n_elem;
-    int np = 2 * nx;
+    const double np = 2.0 * static_cast<double>(x_post.n_elem);
 
-    // Generator Matrix
-    arma::mat gen_one = arma::join_horiz(arma::eye(nx, nx), -1.0 * arma::eye(nx, nx));
-
-    // Initialize predicted mean and covariance
-    arma::vec x_pred = arma::zeros(nx, 1);
-    arma::mat P_x_pred = arma::zeros(nx, nx);
-
-    // Factorize posterior covariance
-    arma::mat Sm_post = arma::chol(P_x_post, "lower");
-
-    // Propagate and evaluate cubature points
-    arma::vec Xi_post;
-    arma::vec Xi_pred;
-
-    for (int i = 0; i < np; i++)
-        {
-            Xi_post = Sm_post * (std::sqrt(static_cast<float>(np) / 2.0) * gen_one.col(i)) + x_post;
-            Xi_pred = (*transition_fcn)(Xi_post);
-
-            x_pred = x_pred + Xi_pred;
-            P_x_pred = P_x_pred + Xi_pred * Xi_pred.t();
-        }
+    // Propagate all the cubature points in one call
+    cubature_points(Xi_points, x_post, P_x_post);
+    const arma::mat Xi_pred = transition_fcn->evaluate_columns(Xi_points);
 
     // Compute predicted mean and error covariance
-    x_pred = x_pred / static_cast<float>(np);
-    P_x_pred = P_x_pred / static_cast<float>(np) - x_pred * x_pred.t() + noise_covariance;
+    const arma::vec x_pred = arma::sum(Xi_pred, 1) / np;
+    const arma::mat P_x_pred = Xi_pred * Xi_pred.t() / np - x_pred * x_pred.t() + noise_covariance;
 
     // Store predicted mean and error covariance
     x_pred_out = x_pred;
@@ -115,41 +141,19 @@ void CubatureFilter::predict_sequential(const arma::vec& x_post, const arma::mat
 void CubatureFilter::update_sequential(const arma::vec& z_upd, const arma::vec& x_pred, const arma::mat& P_x_pred, ModelFunction* measurement_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of cubature points
-    int nx = x_pred.n_elem;
-    int nz = z_upd.n_elem;
-    int np = 2 * nx;
-
-    // Generator Matrix
-    arma::mat gen_one = arma::join_horiz(arma::eye(nx, nx), -1.0 * arma::eye(nx, nx));
-
-    // Initialize estimated predicted measurement and covariances
-    arma::mat z_pred = arma::zeros(nz, 1);
-    arma::mat P_zz_pred = arma::zeros(nz, nz);
-    arma::mat P_xz_pred = arma::zeros(nx, nz);
-
-    // Factorize predicted covariance
-    arma::mat Sm_pred = arma::chol(P_x_pred, "lower");
+    const double np = 2.0 * static_cast<double>(x_pred.n_elem);
 
-    // Propagate and evaluate cubature points
-    arma::vec Xi_pred;
-    arma::vec Zi_pred;
-    for (int i = 0; i < np; i++)
-        {
-            Xi_pred = Sm_pred * (std::sqrt(static_cast<float>(np) / 2.0) * gen_one.col(i)) + x_pred;
-            Zi_pred = (*measurement_fcn)(Xi_pred);
-
-            z_pred = z_pred + Zi_pred;
-            P_zz_pred = P_zz_pred + Zi_pred * Zi_pred.t();
-            P_xz_pred = P_xz_pred + Xi_pred * Zi_pred.t();
-        }
+    // Propagate all the cubature points in one call
+    cubature_points(Xi_points, x_pred, P_x_pred);
+    const arma::mat Zi_pred = measurement_fcn->evaluate_columns(Xi_points);
 
     // Compute measurement mean, covariance and cross covariance
-    z_pred = z_pred / static_cast<float>(np);
-    P_zz_pred = P_zz_pred / static_cast<float>(np) - z_pred * z_pred.t() + noise_covariance;
-    P_xz_pred = P_xz_pred / static_cast<float>(np) - x_pred * z_pred.t();
+    const arma::vec z_pred = arma::sum(Zi_pred, 1) / np;
+    const arma::mat P_zz_pred = Zi_pred * Zi_pred.t() / np - z_pred * z_pred.t() + noise_covariance;
+    const arma::mat P_xz_pred = Xi_points * Zi_pred.t() / np - x_pred * z_pred.t();
 
     // Compute cubature Kalman gain
-    arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
+    const arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
 
     // Compute and store the updated mean and error covariance
     x_est = x_pred + W_k * (z_upd - z_pred);
@@ -227,8 +231,8 @@ void UnscentedFilter::initialize(const arma::mat& x_pred_0, const arma::mat& P_x
 void UnscentedFilter::predict_sequential(const arma::vec& x_post, const arma::mat& P_x_post, ModelFunction* transition_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of sigma points
-    int nx = x_post.n_elem;
-    int np = 2 * nx + 1;
+    const arma::uword nx = x_post.n_elem;
+    const arma::uword np = 2 * nx + 1;
 
     float alpha = 0.001;
     float kappa = 0.0;
@@ -241,33 +245,16 @@ void UnscentedFilter::predict_sequential(const arma::vec& x_post, const arma::ma
     float W0_c = lambda / (static_cast<float>(nx) + lambda) + (1 - std::pow(alpha, 2.0F) + beta);
     float Wi_m = 1.0F / (2.0F * (static_cast<float>(nx) + lambda));
 
-    // Propagate and evaluate sigma points
-    arma::mat Xi_fact = arma::zeros(nx, nx);
-    arma::mat Xi_post = arma::zeros(nx, np);
-    arma::mat Xi_pred = arma::zeros(nx, np);
-
-    Xi_post.col(0) = x_post;
-    Xi_pred.col(0) = (*transition_fcn)(Xi_post.col(0));
-    for (int i = 1; i <= nx; i++)
-        {
-            Xi_fact = std::sqrt(static_cast<float>(nx) + lambda) * arma::sqrtmat_sympd(P_x_post);
-            Xi_post.col(i) = x_post + Xi_fact.col(i - 1);
-            Xi_post.col(i + nx) = x_post - Xi_fact.col(i - 1);
-
-            Xi_pred.col(i) = (*transition_fcn)(Xi_post.col(i));
-            Xi_pred.col(i + nx) = (*transition_fcn)(Xi_post.col(i + nx));
-        }
+    // Propagate all the sigma points in one call
+    sigma_points(Xi_points, x_post, P_x_post, std::sqrt(static_cast<float>(nx) + lambda));
+    const arma::mat Xi_pred = transition_fcn->evaluate_columns(Xi_points);
 
     // Compute predicted mean
-    arma::vec x_pred = W0_m * Xi_pred.col(0) + Wi_m * arma::sum(Xi_pred.cols(1, np - 1), 1);
+    const arma::vec x_pred = W0_m * Xi_pred.col(0) + Wi_m * arma::sum(Xi_pred.cols(1, np - 1), 1);
 
     // Compute predicted error covariance
-    arma::mat P_x_pred = W0_c * ((Xi_pred.col(0) - x_pred) * (Xi_pred.col(0).t() - x_pred.t()));
-    for (int i = 1; i < np; i++)
-        {
-            P_x_pred = P_x_pred + Wi_m * ((Xi_pred.col(i) - x_pred) * (Xi_pred.col(i).t() - x_pred.t()));
-        }
-    P_x_pred = P_x_pred + noise_covariance;
+    const arma::mat Xi_dev = Xi_pred.each_col() - x_pred;
+    const arma::mat P_x_pred = W0_c * (Xi_dev.col(0) * Xi_dev.col(0).t()) + Wi_m * (Xi_dev.cols(1, np - 1) * Xi_dev.cols(1, np - 1).t()) + noise_covariance;
 
     // Store predicted mean and error covariance
     x_pred_out = x_pred;
@@ -281,9 +268,8 @@ void UnscentedFilter::predict_sequential(const arma::vec& x_post, const arma::ma
 void UnscentedFilter::update_sequential(const arma::vec& z_upd, const arma::vec& x_pred, const arma::mat& P_x_pred, ModelFunction* measurement_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of sigma points
-    int nx = x_pred.n_elem;
-    int nz = z_upd.n_elem;
-    int np = 2 * nx + 1;
+    const arma::uword nx = x_pred.n_elem;
+    const arma::uword np = 2 * nx + 1;
 
     float alpha = 0.001;
     float kappa = 0.0;
@@ -296,38 +282,22 @@ void UnscentedFilter::update_sequential(const arma::vec& z_upd, const arma::vec&
     float W0_c = lambda / (static_cast<float>(nx) + lambda) + (1.0F - std::pow(alpha, 2.0F) + beta);
     float Wi_m = 1.0F / (2.0F * (static_cast<float>(nx) + lambda));
 
-    // Propagate and evaluate sigma points
-    arma::mat Xi_fact = arma::zeros(nx, nx);
-    arma::mat Xi_pred = arma::zeros(nx, np);
-    arma::mat Zi_pred = arma::zeros(nz, np);
-
-    Xi_pred.col(0) = x_pred;
-    Zi_pred.col(0) = (*measurement_fcn)(Xi_pred.col(0));
-    for (int i = 1; i <= nx; i++)
-        {
-            Xi_fact = std::sqrt(static_cast<float>(nx) + lambda) * arma::sqrtmat_sympd(P_x_pred);
-            Xi_pred.col(i) = x_pred + Xi_fact.col(i - 1);
-            Xi_pred.col(i + nx) = x_pred - Xi_fact.col(i - 1);
-
-            Zi_pred.col(i) = (*measurement_fcn)(Xi_pred.col(i));
-            Zi_pred.col(i + nx) = (*measurement_fcn)(Xi_pred.col(i + nx));
-        }
+    // Propagate all the sigma points in one call
+    sigma_points(Xi_points, x_pred, P_x_pred, std::sqrt(static_cast<float>(nx) + lambda));
+    const arma::mat Zi_pred = measurement_fcn->evaluate_columns(Xi_points);
 
     // Compute measurement mean
-    arma::mat z_pred = W0_m * Zi_pred.col(0) + Wi_m * arma::sum(Zi_pred.cols(1, np - 1), 1);
+    const arma::vec z_pred = W0_m * Zi_pred.col(0) + Wi_m * arma::sum(Zi_pred.cols(1, np - 1), 1);
 
     // Compute measurement covariance and cross covariance
-    arma::mat P_zz_pred = W0_c * ((Zi_pred.col(0) - z_pred) * (Zi_pred.col(0).t() - z_pred.t()));
-    arma::mat P_xz_pred = W0_c * ((Xi_pred.col(0) - x_pred) * (Zi_pred.col(0).t() - z_pred.t()));
-    for (int i = 0; i < np; i++)
-        {
-            P_zz_pred = P_zz_pred + Wi_m * ((Zi_pred.col(i) - z_pred) * (Zi_pred.col(i).t() - z_pred.t()));
-            P_xz_pred = P_xz_pred + Wi_m * ((Xi_pred.col(i) - x_pred) * (Zi_pred.col(i).t() - z_pred.t()));
-        }
+    const arma::mat Xi_dev = Xi_points.each_col() - x_pred;
+    const arma::mat Zi_dev = Zi_pred.each_col() - z_pred;
+    arma::mat P_zz_pred = W0_c * (Zi_dev.col(0) * Zi_dev.col(0).t()) + Wi_m * (Zi_dev * Zi_dev.t());
+    const arma::mat P_xz_pred = W0_c * (Xi_dev.col(0) * Zi_dev.col(0).t()) + Wi_m * (Xi_dev * Zi_dev.t());
     P_zz_pred = P_zz_pred + noise_covariance;
 
     // Estimate cubature Kalman gain
-    arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
+    const arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
 
     // Estimate and store the updated mean and error covariance
     x_est = x_pred + W_k * (z_upd - z_pred);
@@ -48,6 +48,15 @@ class ModelFunction
 public:
     ModelFunction(){};
     virtual arma::vec operator()(const arma::vec& input) = 0;
+
+    /*!
+     * \brief Evaluates the model at each column of points, i.e. at all the
+     * sigma points of a filter step. By default, the columns are evaluated
+     * one at a time; models that can evaluate them with matrix operations
+     * should override it.
+     */
+    virtual arma::mat evaluate_columns(const arma::mat& points);
+
     virtual ~ModelFunction() = default;
 };
 
@@ -78,6 +87,7 @@ private:
     arma::mat P_x_pred_out;
     arma::vec x_est;
     arma::mat P_x_est;
+    arma::mat Xi_points;  // sigma points, kept from one step to the next
 };
 
 class UnscentedFilter
@@ -107,6 +117,7 @@ private:
     arma::mat P_x_pred_out;
     arma::vec x_est;
     arma::mat P_x_est;
+    arma::mat Xi_points;  // sigma points, kept from one step to the next
 };
 
 
@@ -0,0 +1,94 @@
+/*!
+ * \file secondary_code_sync.cc
+ * \brief Bit-packed correlation of the prompt symbols with a secondary code
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "secondary_code_sync.h"
+#include <algorithm>  // for std::fill
+#include <bitset>     // for std::bitset
+
+
+void Secondary_Code_Sync::set_code(const std::string& code, uint32_t shift_step)
+{
+    d_code_length = static_cast<uint32_t>(code.size());
+    d_shift_step = (shift_step > 0 && d_code_length % shift_step == 0) ? shift_step : d_code_length;
+    d_words = (d_code_length + 63) / 64;
+    d_signs = std::vector<uint64_t>(d_words, 0);
+    const uint32_t shifts = d_code_length > 0 ? d_code_length / d_shift_step : 0;
+    d_rotations = std::vector<uint64_t>(shifts * d_words, 0);
+    for (uint32_t s = 0; s < shifts; s++)
+        {
+            uint64_t* rotation = &d_rotations[s * d_words];
+            for (uint32_t i = 0; i < d_code_length; i++)
+                {
+                    if (code[(i + s * d_shift_step) % d_code_length] == '0')
+                        {
+                            rotation[i / 64] |= uint64_t(1) << (i % 64);
+                        }
+                }
+        }
+    clear();
+}
+
+
+void Secondary_Code_Sync::clear()
+{
+    std::fill(d_signs.begin(), d_signs.end(), 0);
+    d_size = 0;
+}
+
+
+void Secondary_Code_Sync::push(float prompt_real)
+{
+    if (d_code_length == 0)
+        {
+            return;
+        }
+    const auto sign = static_cast<uint64_t>(prompt_real < 0.0);  // symbols clipping
+    if (d_size < d_code_length)
+        {
+            d_signs[d_size / 64] |= sign << (d_size % 64);
+            d_size++;
+            return;
+        }
+    // drop the oldest symbol
+    for (size_t k = 0; k + 1 < d_words; k++)
+        {
+            d_signs[k] = (d_signs[k] >> 1) | (d_signs[k + 1] << 63);
+        }
+    d_signs[d_words - 1] >>= 1;
+    const uint32_t last = d_code_length - 1;
+    d_signs[last / 64] |= sign << (last % 64);
+}
+
+
+bool Secondary_Code_Sync::find(uint32_t& shift, bool& inverted) const
+{
+    const uint32_t shifts = d_code_length > 0 ? d_code_length / d_shift_step : 0;
+    for (uint32_t s = 0; s < shifts; s++)
+        {
+            const uint64_t* rotation = &d_rotations[s * d_words];
+            uint32_t mismatches = 0;
+            for (size_t k = 0; k < d_words; k++)
+                {
+                    mismatches += static_cast<uint32_t>(std::bitset<64>(d_signs[k] ^ rotation[k]).count());
+                }
+            if (mismatches == 0 || mismatches == d_code_length)
+                {
+                    shift = s * d_shift_step;
+                    inverted = (mismatches == d_code_length);
+                    return true;
+                }
+        }
+    return false;
+}
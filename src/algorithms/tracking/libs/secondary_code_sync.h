@@ -0,0 +1,93 @@
+/*!
+ * \file secondary_code_sync.h
+ * \brief Bit-packed correlation of the prompt symbols with a secondary code
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SECONDARY_CODE_SYNC_H
+#define GNSS_SDR_SECONDARY_CODE_SYNC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Secondary code (or preamble) synchronization of the tracking blocks.
+ *
+ * The signs of the last code_length prompt symbols are kept bit-packed, and
+ * so are the rotations of the code by the candidate shifts, built once in
+ * set_code(). Matching a shift is an XOR and a popcount per 64 symbols
+ * instead of a loop over the code characters.
+ *
+ * A shift k matches if, for the oldest symbol i = 0 to the newest
+ * i = code_length - 1,
+ *
+ *   symbol[i] < 0  <=>  code[(i + k) % code_length] == '0'
+ *
+ * for all i (inverted = false), or for none of them (inverted = true, the
+ * PLL is locked 180 degrees off). Then the next symbol is chip k of the code.
+ * The candidate shifts are the multiples of shift_step, which must divide
+ * the code length. A shift_step equal to the code length only tries k = 0.
+ */
+class Secondary_Code_Sync
+{
+public:
+    Secondary_Code_Sync() = default;
+
+    /*!
+     * \brief Sets the code, a string of '0' and '1', and clears the history
+     */
+    void set_code(const std::string& code, uint32_t shift_step);
+
+    void clear();
+
+    /*!
+     * \brief Adds the real part of a prompt correlator output
+     */
+    void push(float prompt_real);
+
+    /*!
+     * \brief Searches all the candidate shifts at once. Only meaningful when
+     * full().
+     */
+    bool find(uint32_t& shift, bool& inverted) const;
+
+    inline bool full() const
+    {
+        return d_size == d_code_length;
+    }
+
+    inline uint32_t code_length() const
+    {
+        return d_code_length;
+    }
+
+private:
+    std::vector<uint64_t> d_rotations;  // words_per_code words per candidate shift
+    std::vector<uint64_t> d_signs;      // bit i set if symbol[i] < 0, oldest first
+    uint32_t d_code_length{0};
+    uint32_t d_shift_step{1};
+    uint32_t d_size{0};
+    size_t d_words{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SECONDARY_CODE_SYNC_H
@@ -57,8 +57,40 @@ int Tcp_Communication::listen_tcp_connection(size_t d_port_, size_t d_port_ch0_)
 }
 
 
+void Tcp_Communication::connect_batched_loop(size_t port, uint32_t channel)
+{
+    channel_ = channel;
+    answered_ = false;
+    loop_hub_ = Tcp_Loop_Hub::instance(port);
+}
+
+
+void Tcp_Communication::send_receive_batched(const float* buf, size_t n_values, Tcp_Packet_Data* tcp_data_)
+{
+    loop_hub_->submit(channel_, buf, static_cast<uint32_t>(n_values));
+    if (loop_hub_->latest(channel_, &last_answer_))
+        {
+            answered_ = true;
+        }
+    else if (!answered_)
+        {
+            // Until the first answer, no correction on the acquisition
+            // Doppler, which is the last but one value of the packets
+            last_answer_.proc_pack_code_error = 0.0;
+            last_answer_.proc_pack_carr_error = 0.0;
+            last_answer_.proc_pack_carrier_doppler_hz = buf[n_values - 2];
+        }
+    *tcp_data_ = last_answer_;
+}
+
+
 void Tcp_Communication::send_receive_tcp_packet_galileo_e1(boost::array<float, NUM_TX_VARIABLES_GALILEO_E1> buf, Tcp_Packet_Data* tcp_data_)
 {
+    if (loop_hub_)
+        {
+            send_receive_batched(buf.data(), buf.size(), tcp_data_);
+            return;
+        }
     int controlc = 0;
     boost::array<float, NUM_RX_VARIABLES> readbuf{};
     float d_control_id_ = buf.data()[0];
@@ -99,6 +131,11 @@ void Tcp_Communication::send_receive_tcp_packet_galileo_e1(boost::array<float, N
 
 void Tcp_Communication::send_receive_tcp_packet_gps_l1_ca(boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> buf, Tcp_Packet_Data* tcp_data_)
 {
+    if (loop_hub_)
+        {
+            send_receive_batched(buf.data(), buf.size(), tcp_data_);
+            return;
+        }
     int controlc = 0;
     boost::array<float, NUM_RX_VARIABLES> readbuf{};
     float d_control_id_ = buf.data()[0];
@@ -143,6 +180,11 @@ void Tcp_Communication::send_receive_tcp_packet_gps_l1_ca(boost::array<float, NU
 
 void Tcp_Communication::close_tcp_connection(size_t d_port_)
 {
+    if (loop_hub_)
+        {
+            loop_hub_.reset();  // the connection is closed with the last channel
+            return;
+        }
     // Close the TCP connection
     tcp_socket_.close();
     std::cout << "Socket closed on port " << d_port_ << '\n';
@@ -18,9 +18,13 @@
 #ifndef GNSS_SDR_TCP_COMMUNICATION_H
 #define GNSS_SDR_TCP_COMMUNICATION_H
 
+#include "tcp_loop_hub.h"
 #include "tcp_packet_data.h"
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
 /** \addtogroup Tracking
  * \{ */
@@ -48,13 +52,27 @@ public:
     ~Tcp_Communication() = default;
 
     int listen_tcp_connection(size_t d_port_, size_t d_port_ch0_);
+
+    /*!
+     * \brief Sends the packets of channel through the Tcp_Loop_Hub of port,
+     * together with the other channels, instead of a connection of its own.
+     * The send_receive functions then return at once with the newest answer
+     * of the external loop, one or more epochs old.
+     */
+    void connect_batched_loop(size_t port, uint32_t channel);
     void send_receive_tcp_packet_galileo_e1(boost::array<float, NUM_TX_VARIABLES_GALILEO_E1> buf, Tcp_Packet_Data *tcp_data_);
     void send_receive_tcp_packet_gps_l1_ca(boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> buf, Tcp_Packet_Data *tcp_data_);
     void close_tcp_connection(size_t d_port_);
 
 private:
+    void send_receive_batched(const float *buf, size_t n_values, Tcp_Packet_Data *tcp_data_);
+
     b_io_context io_context_;
     boost::asio::ip::tcp::socket tcp_socket_;
+    std::shared_ptr<Tcp_Loop_Hub> loop_hub_;
+    Tcp_Packet_Data last_answer_;
+    uint32_t channel_{0};
+    bool answered_{false};
 };
 
 
@@ -0,0 +1,211 @@
+/*!
+ * \file tcp_loop_hub.cc
+ * \brief Single TCP connection to an external loop filter, shared by all the
+ * TCP connector tracking channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tcp_loop_hub.h"
+#include <glog/logging.h>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+
+namespace
+{
+constexpr size_t ANSWER_LENGTH = sizeof(uint32_t) + 4 * sizeof(float);
+
+
+template <typename T>
+void append_value(std::vector<char>& buffer, T value)
+{
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+}  // namespace
+
+
+std::shared_ptr<Tcp_Loop_Hub> Tcp_Loop_Hub::instance(size_t port)
+{
+    static std::mutex hubs_mutex;
+    static std::map<size_t, std::weak_ptr<Tcp_Loop_Hub>> hubs;
+    std::lock_guard<std::mutex> lock(hubs_mutex);
+    auto hub = hubs[port].lock();
+    if (!hub)
+        {
+            hub = std::make_shared<Tcp_Loop_Hub>(port);
+            hubs[port] = hub;
+        }
+    return hub;
+}
+
+
+Tcp_Loop_Hub::Tcp_Loop_Hub(size_t port) : d_socket(d_io_context)
+{
+    try
+        {
+            boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), static_cast<uint16_t>(port));
+            boost::asio::ip::tcp::acceptor acceptor(d_io_context, endpoint);
+            acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            std::cout << "Server ready. Listening for the TCP connection of the batched external loop...\n";
+            acceptor.listen(1);
+            acceptor.accept(d_socket);
+            d_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+            std::cout << "Socket accepted on port " << port << '\n';
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Exception: " << e.what() << '\n';
+            return;
+        }
+    d_running.store(true);
+    d_sender = std::thread(&Tcp_Loop_Hub::send_loop, this);
+    d_receiver = std::thread(&Tcp_Loop_Hub::receive_loop, this);
+}
+
+
+Tcp_Loop_Hub::~Tcp_Loop_Hub()
+{
+    stop();
+    if (d_sender.joinable())
+        {
+            d_sender.join();
+        }
+    if (d_receiver.joinable())
+        {
+            d_receiver.join();
+        }
+}
+
+
+void Tcp_Loop_Hub::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_running.exchange(false))
+            {
+                return;
+            }
+    }
+    d_submitted.notify_one();
+    boost::system::error_code ec;
+    d_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);  // unblocks the receiver
+}
+
+
+void Tcp_Loop_Hub::submit(uint32_t channel, const float* values, uint32_t n_values)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_running.load())
+            {
+                return;
+            }
+        append_value(d_pending, channel);
+        append_value(d_pending, n_values);
+        const auto* bytes = reinterpret_cast<const char*>(values);
+        d_pending.insert(d_pending.end(), bytes, bytes + n_values * sizeof(float));
+        d_pending_count++;
+    }
+    d_submitted.notify_one();
+}
+
+
+bool Tcp_Loop_Hub::latest(uint32_t channel, Tcp_Packet_Data* data)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_answers.find(channel);
+    if (it == d_answers.end())
+        {
+            return false;
+        }
+    *data = it->second;
+    return true;
+}
+
+
+void Tcp_Loop_Hub::send_loop()
+{
+    std::vector<char> message;
+    while (true)
+        {
+            uint32_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_submitted.wait(lock, [this] { return d_pending_count != 0 or !d_running.load(); });
+                if (!d_running.load())
+                    {
+                        return;
+                    }
+                // the packets submitted while the previous message was
+                // written go together in this one
+                message.clear();
+                std::swap(message, d_pending);
+                count = d_pending_count;
+                d_pending_count = 0;
+            }
+            try
+                {
+                    const std::array<boost::asio::const_buffer, 2> buffers{{boost::asio::buffer(&count, sizeof(count)), boost::asio::buffer(message)}};
+                    boost::asio::write(d_socket, buffers);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Batched external loop: error sending the packets: " << e.what();
+                    std::cerr << "Batched external loop disconnected\n";
+                    stop();
+                    return;
+                }
+        }
+}
+
+
+void Tcp_Loop_Hub::receive_loop()
+{
+    std::vector<char> message;
+    while (d_running.load())
+        {
+            try
+                {
+                    uint32_t count = 0;
+                    boost::asio::read(d_socket, boost::asio::buffer(&count, sizeof(count)));
+                    message.resize(count * ANSWER_LENGTH);
+                    boost::asio::read(d_socket, boost::asio::buffer(message));
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    for (uint32_t i = 0; i < count; i++)
+                        {
+                            const char* answer = &message[i * ANSWER_LENGTH];
+                            uint32_t channel;
+                            std::array<float, 4> values{};
+                            std::memcpy(&channel, answer, sizeof(uint32_t));
+                            std::memcpy(values.data(), answer + sizeof(uint32_t), sizeof(values));
+                            Tcp_Packet_Data& data = d_answers[channel];
+                            data.proc_pack_code_error = values[1];
+                            data.proc_pack_carr_error = values[2];
+                            data.proc_pack_carrier_doppler_hz = values[3];
+                        }
+                }
+            catch (const std::exception& e)
+                {
+                    if (d_running.load())
+                        {
+                            LOG(WARNING) << "Batched external loop: error receiving the answers: " << e.what();
+                            std::cerr << "Batched external loop disconnected\n";
+                        }
+                    stop();
+                    return;
+                }
+        }
+}
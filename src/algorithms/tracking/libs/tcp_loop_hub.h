@@ -0,0 +1,104 @@
+/*!
+ * \file tcp_loop_hub.h
+ * \brief Single TCP connection to an external loop filter, shared by all the
+ * TCP connector tracking channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TCP_LOOP_HUB_H
+#define GNSS_SDR_TCP_LOOP_HUB_H
+
+#include "tcp_packet_data.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Carries the packets of all the channels over one TCP connection,
+ * batched and pipelined.
+ *
+ * A channel submits its correlator outputs and goes on without waiting for
+ * the answer. A sender thread writes all the packets submitted meanwhile as a
+ * single message, and a receiver thread stores the answers, which the
+ * channels pick up at their next epoch. All the values are in the byte order
+ * of the host, as in the packets of one connection per channel:
+ *
+ *   to the loop:   uint32 count, then count times
+ *                  { uint32 channel, uint32 n, float values[n] }
+ *   from the loop: uint32 count, then count times
+ *                  { uint32 channel, float control_id, float code_error,
+ *                    float carrier_error, float carrier_doppler_hz }
+ */
+class Tcp_Loop_Hub
+{
+public:
+    /*!
+     * \brief Hub listening on port, shared by all the channels that ask for
+     * the same port. The first call waits for the external loop to connect.
+     */
+    static std::shared_ptr<Tcp_Loop_Hub> instance(size_t port);
+
+    explicit Tcp_Loop_Hub(size_t port);
+    ~Tcp_Loop_Hub();
+
+    Tcp_Loop_Hub(const Tcp_Loop_Hub&) = delete;
+    Tcp_Loop_Hub& operator=(const Tcp_Loop_Hub&) = delete;
+
+    //! Queues the packet of channel for the next message
+    void submit(uint32_t channel, const float* values, uint32_t n_values);
+
+    /*!
+     * \brief Copies the newest answer for channel into data. Returns false if
+     * no answer has been received yet for that channel.
+     */
+    bool latest(uint32_t channel, Tcp_Packet_Data* data);
+
+    bool connected() const { return d_running.load(); }
+
+private:
+    void send_loop();
+    void receive_loop();
+    void stop();
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+    boost::asio::io_context d_io_context;
+#else
+    boost::asio::io_service d_io_context;
+#endif
+    boost::asio::ip::tcp::socket d_socket;
+    std::mutex d_mutex;
+    std::condition_variable d_submitted;
+    std::vector<char> d_pending;  // serialized packets of the next message
+    uint32_t d_pending_count{0};
+    std::map<uint32_t, Tcp_Packet_Data> d_answers;
+    std::atomic<bool> d_running{false};
+    std::thread d_sender;
+    std::thread d_receiver;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TCP_LOOP_HUB_H
@@ -0,0 +1,111 @@
+/*!
+ * \file tracking_correlator_service.cc
+ * \brief Service that computes the correlations of several tracking channels
+ * in a single sweep over their input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_correlator_service.h"
+#include <algorithm>  // for std::all_of, std::min, std::make_heap, std::push_heap, std::pop_heap
+#include <cstddef>    // for size_t
+#include <utility>
+
+
+namespace
+{
+// 16 KB of gr_complex input, so each chunk stays in cache while all the jobs
+// overlapping it are correlated
+const int SWEEP_CHUNK_SAMPLES = 2048;
+}  // namespace
+
+
+Tracking_Correlator_Service& Tracking_Correlator_Service::instance()
+{
+    static Tracking_Correlator_Service service;
+    return service;
+}
+
+
+void Tracking_Correlator_Service::correlate(std::vector<Job>& jobs)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    for (auto& job : jobs)
+        {
+            job.done = false;
+            d_queue.push_back(&job);
+        }
+    const auto all_done = [&jobs]() {
+        return std::all_of(jobs.begin(), jobs.end(), [](const Job& job) { return job.done; });
+    };
+    while (!all_done())
+        {
+            if (d_sweeping)
+                {
+                    d_cv.wait(lock);
+                    continue;
+                }
+            // Lead a sweep with everything queued so far, including our jobs
+            d_sweeping = true;
+            const std::vector<Job*> batch = std::move(d_queue);
+            d_queue.clear();
+            lock.unlock();
+
+            sweep(batch);
+
+            lock.lock();
+            for (auto* job : batch)
+                {
+                    job->done = true;
+                }
+            d_sweeping = false;
+            d_cv.notify_all();
+        }
+}
+
+
+void Tracking_Correlator_Service::sweep(const std::vector<Job*>& jobs) const
+{
+    for (const auto* job : jobs)
+        {
+            job->correlator->update_local_code(job->signal_length_samples, job->rem_code_phase_chips, job->code_phase_step_chips, job->code_phase_rate_step_chips);
+        }
+
+    // Always correlate the chunk with the lowest input address, so the input
+    // buffer is read once, in order, by all the jobs
+    std::vector<int> position(jobs.size(), 0);
+    std::vector<size_t> heap(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++)
+        {
+            heap[i] = i;
+        }
+    const auto later = [&jobs, &position](size_t a, size_t b) {
+        return jobs[a]->input + position[a] > jobs[b]->input + position[b];
+    };
+    std::make_heap(heap.begin(), heap.end(), later);
+    while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const size_t i = heap.back();
+            const Job* job = jobs[i];
+            const int num_samples = std::min(SWEEP_CHUNK_SAMPLES, job->signal_length_samples - position[i]);
+            job->correlator->Carrier_wipeoff_multicorrelator_range(job->rem_carrier_phase_in_rad, job->phase_step_rad, job->phase_rate_step_rad, position[i], num_samples);
+            position[i] += num_samples;
+            if (position[i] < job->signal_length_samples)
+                {
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            else
+                {
+                    heap.pop_back();
+                }
+        }
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file tracking_correlator_service.h
+ * \brief Service that computes the correlations of several tracking channels
+ * in a single sweep over their input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_CORRELATOR_SERVICE_H
+#define GNSS_SDR_TRACKING_CORRELATOR_SERVICE_H
+
+#include "cpu_multicorrelator_real_codes.h"
+#include <complex>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Shared carrier wipe-off and multicorrelator.
+ *
+ * Tracking channels submit the correlations of their current integration
+ * interval and wait for them. The first channel to find the service idle
+ * computes all the jobs queued at that moment: it resamples the local codes
+ * of each job, and then walks the input samples of all of them in address
+ * order, in chunks of a few thousand samples, so that each chunk of the
+ * shared input buffer is read from cache by all the channels correlating it.
+ * Channels arriving during a sweep are served by the next one, so nobody
+ * waits for channels that are not ready.
+ */
+class Tracking_Correlator_Service
+{
+public:
+    /*!
+     * \brief Correlation of one Cpu_Multicorrelator_Real_Codes over an
+     * integration interval. Input and output vectors are the ones set in the
+     * correlator.
+     */
+    class Job
+    {
+    public:
+        Cpu_Multicorrelator_Real_Codes* correlator{nullptr};
+        const std::complex<float>* input{nullptr};  // same as the correlator input, used to order the sweep
+        float rem_carrier_phase_in_rad{0.0};
+        float phase_step_rad{0.0};
+        float phase_rate_step_rad{0.0};
+        float rem_code_phase_chips{0.0};
+        float code_phase_step_chips{0.0};
+        float code_phase_rate_step_chips{0.0};
+        int signal_length_samples{0};
+        bool done{false};
+    };
+
+    /*!
+     * \brief Returns the process-wide service.
+     */
+    static Tracking_Correlator_Service& instance();
+
+    /*!
+     * \brief Computes the jobs, possibly together with those of other
+     * channels, and returns when they are done.
+     */
+    void correlate(std::vector<Job>& jobs);
+
+private:
+    void sweep(const std::vector<Job*>& jobs) const;
+
+    std::vector<Job*> d_queue;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    bool d_sweeping{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_CORRELATOR_SERVICE_H
@@ -0,0 +1,331 @@
+/*!
+ * \file tracking_cuda_correlator.cu
+ * \brief Carrier wipe-off and multicorrelator of all the tracking channels
+ * computed in a CUDA GPU, with one kernel launch per batch of channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_cuda_correlator.h"
+#include "gnss_sdr_cuda_pinned.h"
+#include "tracking_device_inputs.h"
+#include <cuComplex.h>
+#include <cuda_runtime.h>
+#include <algorithm>  // for std::copy, std::max
+#include <cstring>    // for memcpy, memset
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+const int THREADS_PER_BLOCK = 256;
+const int CHUNK_SAMPLES = 4096;  // samples of one job correlated by a thread block
+const int MAX_TAPS = Tracking_Gpu_Correlator::max_taps;
+
+
+void check_cuda(cudaError_t code, const char* what)
+{
+    if (code != cudaSuccess)
+        {
+            throw std::runtime_error(std::string("CUDA error in ") + what + ": " + cudaGetErrorString(code));
+        }
+}
+
+
+struct Gpu_Job
+{
+    const float* code;
+    int code_length;
+    const cuFloatComplex* input;  // staged, or in place in a pinned flow graph buffer
+    int signal_length;
+    int output_offset;
+    int n_taps;
+    float shifts[MAX_TAPS];
+    float rem_carrier_phase;
+    float phase_step;
+    float phase_rate_step;
+    float rem_code_phase;
+    float code_phase_step;
+    float code_phase_rate_step;
+};
+
+
+// Block (x, y) correlates chunk x of job y with all the taps of the job, with
+// the same sampling and carrier phase conventions as the VOLK_GNSSSDR kernels
+__global__ void correlation_kernel(cuFloatComplex* outputs, const Gpu_Job* jobs)
+{
+    __shared__ float partial_r[THREADS_PER_BLOCK];
+    __shared__ float partial_i[THREADS_PER_BLOCK];
+    const Gpu_Job& job = jobs[blockIdx.y];
+    const int first = blockIdx.x * CHUNK_SAMPLES;
+    if (first >= job.signal_length)
+        {
+            return;
+        }
+    const int last = min(first + CHUNK_SAMPLES, job.signal_length);
+
+    float acc_r[MAX_TAPS];
+    float acc_i[MAX_TAPS];
+    for (int t = 0; t < MAX_TAPS; t++)
+        {
+            acc_r[t] = 0.0F;
+            acc_i[t] = 0.0F;
+        }
+    for (int n = first + threadIdx.x; n < last; n += blockDim.x)
+        {
+            const auto fn = static_cast<float>(n);
+            // sample * exp(-j * phase)
+            const float phase = job.rem_carrier_phase + fn * (job.phase_step + fn * job.phase_rate_step);
+            float s;
+            float c;
+            sincosf(phase, &s, &c);
+            const cuFloatComplex x = job.input[n];
+            const float wiped_r = x.x * c + x.y * s;
+            const float wiped_i = x.y * c - x.x * s;
+            const float code_phase = job.code_phase_step * fn + job.code_phase_rate_step * fn * fn - job.rem_code_phase;
+            for (int t = 0; t < job.n_taps; t++)
+                {
+                    int chip = static_cast<int>(floorf(code_phase + job.shifts[t])) % job.code_length;
+                    if (chip < 0)
+                        {
+                            chip += job.code_length;
+                        }
+                    const float code = job.code[chip];
+                    acc_r[t] += code * wiped_r;
+                    acc_i[t] += code * wiped_i;
+                }
+        }
+
+    for (int t = 0; t < job.n_taps; t++)
+        {
+            partial_r[threadIdx.x] = acc_r[t];
+            partial_i[threadIdx.x] = acc_i[t];
+            __syncthreads();
+            for (int stride = blockDim.x / 2; stride > 0; stride /= 2)
+                {
+                    if (threadIdx.x < stride)
+                        {
+                            partial_r[threadIdx.x] += partial_r[threadIdx.x + stride];
+                            partial_i[threadIdx.x] += partial_i[threadIdx.x + stride];
+                        }
+                    __syncthreads();
+                }
+            if (threadIdx.x == 0)
+                {
+                    atomicAdd(&outputs[job.output_offset + t].x, partial_r[0]);
+                    atomicAdd(&outputs[job.output_offset + t].y, partial_i[0]);
+                }
+            __syncthreads();
+        }
+}
+}  // namespace
+
+
+bool Tracking_Cuda_Correlator::is_available()
+{
+    int num_devices = 0;
+    return (cudaGetDeviceCount(&num_devices) == cudaSuccess) and (num_devices > 0);
+}
+
+
+Tracking_Cuda_Correlator& Tracking_Cuda_Correlator::instance(int device)
+{
+    static std::mutex instances_mutex;
+    static std::map<int, std::unique_ptr<Tracking_Cuda_Correlator>> instances;
+
+    const std::lock_guard<std::mutex> lock(instances_mutex);
+    auto& correlator = instances[device];
+    if (!correlator)
+        {
+            int num_devices = 0;
+            if (cudaGetDeviceCount(&num_devices) != cudaSuccess or device < 0 or device >= num_devices)
+                {
+                    throw std::runtime_error("No CUDA device " + std::to_string(device));
+                }
+            correlator.reset(new Tracking_Cuda_Correlator(device));
+        }
+    return *correlator;
+}
+
+
+Tracking_Cuda_Correlator::Tracking_Cuda_Correlator(int device) : d_device(device),
+                                                                 d_numa_node(cuda_device_numa_node(device))
+{
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");
+    check_cuda(cudaSetDeviceFlags(cudaDeviceMapHost), "cudaSetDeviceFlags");
+    cudaStream_t stream;
+    check_cuda(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking), "cudaStreamCreate");
+    d_stream = stream;
+}
+
+
+Tracking_Cuda_Correlator::~Tracking_Cuda_Correlator()
+{
+    cudaSetDevice(d_device);
+    for (auto* code : d_codes)
+        {
+            cudaFree(code);
+        }
+    cuda_numa_host_free(d_host_params);
+    cuda_numa_host_free(d_host_input);
+    cuda_numa_host_free(d_host_outputs);
+    cudaStreamDestroy(d_stream);
+}
+
+
+int Tracking_Cuda_Correlator::add_code(const float* code, int code_length)
+{
+    float* gpu_code = nullptr;
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");
+    // Managed memory, so the code is written from the host without staging buffers
+    check_cuda(cudaMallocManaged(reinterpret_cast<void**>(&gpu_code), sizeof(float) * code_length), "cudaMallocManaged");
+    std::memcpy(gpu_code, code, sizeof(float) * code_length);
+    std::lock_guard<std::mutex> lock(d_codes_mutex);
+    for (size_t id = 0; id < d_codes.size(); id++)
+        {
+            if (d_codes[id] == nullptr)
+                {
+                    d_codes[id] = gpu_code;
+                    d_code_lengths[id] = code_length;
+                    return static_cast<int>(id);
+                }
+        }
+    d_codes.push_back(gpu_code);
+    d_code_lengths.push_back(code_length);
+    return static_cast<int>(d_codes.size() - 1);
+}
+
+
+void Tracking_Cuda_Correlator::remove_code(int code_id)
+{
+    // A code is only used by the jobs of its channel, which on return of
+    // correlate() are not being computed
+    std::lock_guard<std::mutex> lock(d_codes_mutex);
+    if (code_id >= 0 and code_id < static_cast<int>(d_codes.size()) and d_codes[code_id] != nullptr)
+        {
+            cudaSetDevice(d_device);
+            cudaFree(d_codes[code_id]);
+            d_codes[code_id] = nullptr;
+        }
+}
+
+
+void Tracking_Cuda_Correlator::reserve(size_t num_jobs, size_t num_samples)
+{
+    // Buffers only grow
+    if (num_jobs > d_max_jobs)
+        {
+            cuda_numa_host_free(d_host_params);
+            cuda_numa_host_free(d_host_outputs);
+            d_host_params = nullptr;
+            d_host_outputs = nullptr;
+            const size_t capacity = std::max(num_jobs, 2 * d_max_jobs);
+            d_max_jobs = 0;
+            check_cuda(cuda_numa_host_alloc(&d_host_params, sizeof(Gpu_Job) * capacity, d_numa_node, cudaHostRegisterMapped), "cudaHostRegister");
+            check_cuda(cuda_numa_host_alloc(reinterpret_cast<void**>(&d_host_outputs), sizeof(std::complex<float>) * capacity * MAX_TAPS, d_numa_node, cudaHostRegisterMapped), "cudaHostRegister");
+            check_cuda(cudaHostGetDevicePointer(&d_gpu_params, d_host_params, 0), "cudaHostGetDevicePointer");
+            check_cuda(cudaHostGetDevicePointer(reinterpret_cast<void**>(&d_gpu_outputs), d_host_outputs, 0), "cudaHostGetDevicePointer");
+            d_max_jobs = capacity;
+        }
+    if (num_samples > d_max_samples)
+        {
+            cuda_numa_host_free(d_host_input);
+            d_host_input = nullptr;
+            const size_t capacity = std::max(num_samples, 2 * d_max_samples);
+            d_max_samples = 0;
+            check_cuda(cuda_numa_host_alloc(reinterpret_cast<void**>(&d_host_input), sizeof(std::complex<float>) * capacity, d_numa_node, cudaHostRegisterMapped), "cudaHostRegister");
+            check_cuda(cudaHostGetDevicePointer(reinterpret_cast<void**>(&d_gpu_input), d_host_input, 0), "cudaHostGetDevicePointer");
+            d_max_samples = capacity;
+        }
+}
+
+
+void Tracking_Cuda_Correlator::sweep(const std::vector<Job*>& jobs)
+{
+    // Sweeps are led by the thread of any channel of this device
+    check_cuda(cudaSetDevice(d_device), "cudaSetDevice");
+    // Inputs in a pinned flow graph buffer are read in place, the rest are staged
+    std::vector<const cuFloatComplex*> inputs(jobs.size(), nullptr);
+    std::vector<Job*> staged_jobs;
+    std::vector<size_t> staged_index;
+    for (size_t i = 0; i < jobs.size(); i++)
+        {
+            inputs[i] = static_cast<const cuFloatComplex*>(Tracking_Device_Inputs::find(jobs[i]->input,
+                sizeof(std::complex<float>) * jobs[i]->signal_length_samples));
+            if (inputs[i] == nullptr)
+                {
+                    staged_index.push_back(i);
+                    staged_jobs.push_back(jobs[i]);
+                }
+        }
+    std::vector<std::pair<const std::complex<float>*, const std::complex<float>*>> segments;
+    std::vector<size_t> staged_offset;
+    const size_t staged_samples = plan_staging(staged_jobs, segments, staged_offset);
+    reserve(jobs.size(), staged_samples);
+    for (size_t k = 0; k < staged_index.size(); k++)
+        {
+            inputs[staged_index[k]] = reinterpret_cast<const cuFloatComplex*>(d_gpu_input + staged_offset[k]);
+        }
+
+    size_t offset = 0;
+    for (const auto& segment : segments)
+        {
+            const auto length = static_cast<size_t>(segment.second - segment.first);
+            std::memcpy(d_host_input + offset, segment.first, sizeof(std::complex<float>) * length);
+            offset += length;
+        }
+
+    auto* params = static_cast<Gpu_Job*>(d_host_params);
+    int max_length = 0;
+    {
+        std::lock_guard<std::mutex> lock(d_codes_mutex);
+        for (size_t i = 0; i < jobs.size(); i++)
+            {
+                const Job* job = jobs[i];
+                if (job->n_correlators < 1 or job->n_correlators > MAX_TAPS or job->code_id < 0 or
+                    job->code_id >= static_cast<int>(d_codes.size()) or d_codes[job->code_id] == nullptr)
+                    {
+                        throw std::runtime_error("Invalid CUDA tracking correlation job");
+                    }
+                Gpu_Job p{};
+                p.code = d_codes[job->code_id];
+                p.code_length = d_code_lengths[job->code_id];
+                p.input = inputs[i];
+                p.signal_length = job->signal_length_samples;
+                p.output_offset = static_cast<int>(i) * MAX_TAPS;
+                p.n_taps = job->n_correlators;
+                std::copy(job->shifts_chips, job->shifts_chips + job->n_correlators, p.shifts);
+                p.rem_carrier_phase = job->rem_carrier_phase_in_rad;
+                p.phase_step = job->phase_step_rad;
+                p.phase_rate_step = job->phase_rate_step_rad;
+                p.rem_code_phase = job->rem_code_phase_chips;
+                p.code_phase_step = job->code_phase_step_chips;
+                p.code_phase_rate_step = job->code_phase_rate_step_chips;
+                params[i] = p;
+                max_length = std::max(max_length, job->signal_length_samples);
+            }
+    }
+    std::memset(d_host_outputs, 0, sizeof(std::complex<float>) * jobs.size() * MAX_TAPS);
+
+    const dim3 blocks((max_length + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES, static_cast<unsigned int>(jobs.size()));
+    correlation_kernel<<<blocks, THREADS_PER_BLOCK, 0, d_stream>>>(reinterpret_cast<cuFloatComplex*>(d_gpu_outputs),
+        static_cast<const Gpu_Job*>(d_gpu_params));
+    check_cuda(cudaGetLastError(), "correlation_kernel");
+    check_cuda(cudaStreamSynchronize(d_stream), "cudaStreamSynchronize");
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        {
+            std::copy(d_host_outputs + i * MAX_TAPS, d_host_outputs + i * MAX_TAPS + jobs[i]->n_correlators, jobs[i]->corr_out);
+        }
+}
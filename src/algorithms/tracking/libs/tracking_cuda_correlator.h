@@ -0,0 +1,96 @@
+/*!
+ * \file tracking_cuda_correlator.h
+ * \brief Carrier wipe-off and multicorrelator of all the tracking channels
+ * computed in a CUDA GPU, with one kernel launch per batch of channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_CUDA_CORRELATOR_H
+#define GNSS_SDR_TRACKING_CUDA_CORRELATOR_H
+
+#include "tracking_gpu_correlator.h"
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+struct CUstream_st;  // cudaStream_t is a pointer to it
+
+
+/*!
+ * \brief Shared CUDA correlator of the tracking channels.
+ *
+ * All the jobs of a sweep are computed in a single kernel launch, with
+ * thread blocks over the jobs and chunks of their samples. Each sample is
+ * wiped off once and correlated with all the taps of its job. The local codes
+ * are resampled in the GPU. The input samples, the job parameters and the
+ * correlator outputs live in mapped pinned host memory, read and written by
+ * the kernel in place, so there are no explicit host-device copies. Inputs
+ * that are already in a Tracking_Pinned_Buffer (GNSS-SDR.accelerator_buffers)
+ * are not even staged. There is one correlator per device, see
+ * Gnss_Device_Scheduler.
+ */
+class Tracking_Cuda_Correlator : public Tracking_Gpu_Correlator
+{
+public:
+    /*!
+     * \brief Returns true if there is at least one CUDA device.
+     */
+    static bool is_available();
+
+    /*!
+     * \brief Returns the process-wide correlator of a device. Throws
+     * std::runtime_error if there is no such device.
+     */
+    static Tracking_Cuda_Correlator& instance(int device = 0);
+
+    int add_code(const float* code, int code_length) override;
+    void remove_code(int code_id) override;
+
+private:
+    friend std::default_delete<Tracking_Cuda_Correlator>;
+    explicit Tracking_Cuda_Correlator(int device);
+    ~Tracking_Cuda_Correlator() override;
+    void sweep(const std::vector<Job*>& jobs) override;
+    void reserve(size_t num_jobs, size_t num_samples);
+
+    std::mutex d_codes_mutex;
+    std::vector<float*> d_codes;  // device memory, nullptr if free
+    std::vector<int> d_code_lengths;
+
+    int d_device;
+    int d_numa_node;  // of the device, for the pinned host buffers
+    CUstream_st* d_stream{nullptr};
+
+    // Mapped pinned host buffers on the NUMA node of the device, and their
+    // device pointers
+    void* d_host_params{nullptr};
+    void* d_gpu_params{nullptr};
+    std::complex<float>* d_host_input{nullptr};
+    std::complex<float>* d_gpu_input{nullptr};
+    std::complex<float>* d_host_outputs{nullptr};
+    std::complex<float>* d_gpu_outputs{nullptr};
+    size_t d_max_jobs{0};
+    size_t d_max_samples{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_CUDA_CORRELATOR_H
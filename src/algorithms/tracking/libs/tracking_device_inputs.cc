@@ -0,0 +1,75 @@
+/*!
+ * \file tracking_device_inputs.cc
+ * \brief Registry of the host buffers of samples that the GPU can read in
+ * place, so the tracking correlators do not need to stage them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_device_inputs.h"
+#include <map>
+#include <mutex>
+
+
+namespace
+{
+struct Device_Input
+{
+    size_t bytes;
+    const char* device_base;
+};
+
+std::mutex& registry_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+std::map<const char*, Device_Input>& registry()
+{
+    static std::map<const char*, Device_Input> buffers;  // by host base
+    return buffers;
+}
+}  // namespace
+
+
+void Tracking_Device_Inputs::add(const void* host_base, size_t bytes, const void* device_base)
+{
+    const std::lock_guard<std::mutex> lock(registry_mutex());
+    registry()[static_cast<const char*>(host_base)] = Device_Input{bytes, static_cast<const char*>(device_base)};
+}
+
+
+void Tracking_Device_Inputs::remove(const void* host_base)
+{
+    const std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().erase(static_cast<const char*>(host_base));
+}
+
+
+const void* Tracking_Device_Inputs::find(const void* host_ptr, size_t bytes)
+{
+    const auto* ptr = static_cast<const char*>(host_ptr);
+    const std::lock_guard<std::mutex> lock(registry_mutex());
+    const auto& buffers = registry();
+    auto it = buffers.upper_bound(ptr);
+    if (it == buffers.begin())
+        {
+            return nullptr;
+        }
+    --it;
+    const auto offset = static_cast<size_t>(ptr - it->first);
+    if (offset + bytes > it->second.bytes)
+        {
+            return nullptr;
+        }
+    return it->second.device_base + offset;
+}
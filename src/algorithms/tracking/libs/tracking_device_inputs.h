@@ -0,0 +1,57 @@
+/*!
+ * \file tracking_device_inputs.h
+ * \brief Registry of the host buffers of samples that the GPU can read in
+ * place, so the tracking correlators do not need to stage them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_DEVICE_INPUTS_H
+#define GNSS_SDR_TRACKING_DEVICE_INPUTS_H
+
+#include <cstddef>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Process-wide list of mapped pinned host buffers and their device
+ * addresses. Tracking_Pinned_Buffer registers the flow graph buffers it
+ * allocates, and Tracking_Cuda_Correlator looks up the inputs of its jobs.
+ */
+class Tracking_Device_Inputs
+{
+public:
+    /*!
+     * \brief Registers bytes of host memory starting at host_base, mapped
+     * at device_base in the device address space.
+     */
+    static void add(const void* host_base, size_t bytes, const void* device_base);
+
+    /*!
+     * \brief Unregisters a buffer added with add().
+     */
+    static void remove(const void* host_base);
+
+    /*!
+     * \brief Returns the device address of host_ptr if the bytes from it lie
+     * in a single registered buffer, or nullptr otherwise.
+     */
+    static const void* find(const void* host_ptr, size_t bytes);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_DEVICE_INPUTS_H
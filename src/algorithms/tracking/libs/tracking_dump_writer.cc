@@ -0,0 +1,149 @@
+/*!
+ * \file tracking_dump_writer.cc
+ * \brief Background writer of the tracking dump files.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_dump_writer.h"
+#include <algorithm>  // for std::min, std::remove_if
+#include <chrono>
+#include <cstring>  // for std::memcpy
+
+
+namespace
+{
+// The writer sleeps this long when there is nothing to write
+const auto WRITER_PERIOD = std::chrono::milliseconds(20);
+}  // namespace
+
+
+Tracking_Dump_Writer::Stream::Stream(const std::string& filename, size_t record_size, size_t capacity_records)
+    : d_ring(record_size * std::max<size_t>(capacity_records, 2)),
+      d_record_size(record_size),
+      d_capacity(std::max<size_t>(capacity_records, 2))
+{
+    d_file.open(filename.c_str(), std::ios::out | std::ios::binary);
+}
+
+
+Tracking_Dump_Writer::Stream::~Stream()
+{
+    close();
+}
+
+
+bool Tracking_Dump_Writer::Stream::push(const void* record)
+{
+    const size_t head = d_head.load(std::memory_order_relaxed);
+    if (head - d_tail.load(std::memory_order_acquire) == d_capacity or d_closed.load(std::memory_order_relaxed))
+        {
+            d_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    std::memcpy(&d_ring[(head % d_capacity) * d_record_size], record, d_record_size);
+    d_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+
+void Tracking_Dump_Writer::Stream::drain()
+{
+    std::lock_guard<std::mutex> lock(d_consumer_mutex);
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    size_t tail = d_tail.load(std::memory_order_relaxed);
+    const size_t head = d_head.load(std::memory_order_acquire);
+    while (tail != head)
+        {
+            // Write the contiguous part of the ring in one call
+            const size_t first = tail % d_capacity;
+            const size_t count = std::min(head - tail, d_capacity - first);
+            d_file.write(&d_ring[first * d_record_size], static_cast<std::streamsize>(count * d_record_size));
+            tail += count;
+            d_tail.store(tail, std::memory_order_release);
+        }
+}
+
+
+void Tracking_Dump_Writer::Stream::close()
+{
+    drain();
+    std::lock_guard<std::mutex> lock(d_consumer_mutex);
+    d_closed.store(true, std::memory_order_release);
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+}
+
+
+Tracking_Dump_Writer& Tracking_Dump_Writer::instance()
+{
+    static Tracking_Dump_Writer writer;
+    return writer;
+}
+
+
+Tracking_Dump_Writer::Tracking_Dump_Writer()
+    : d_thread(&Tracking_Dump_Writer::run, this)
+{
+}
+
+
+Tracking_Dump_Writer::~Tracking_Dump_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv.notify_all();
+    d_thread.join();
+    for (auto& stream : d_streams)
+        {
+            stream->close();
+        }
+}
+
+
+std::shared_ptr<Tracking_Dump_Writer::Stream> Tracking_Dump_Writer::open(const std::string& filename, size_t record_size, size_t capacity_records)
+{
+    auto stream = std::make_shared<Stream>(filename, record_size, capacity_records);
+    if (stream->is_open())
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_streams.push_back(stream);
+        }
+    return stream;
+}
+
+
+void Tracking_Dump_Writer::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            d_cv.wait_for(lock, WRITER_PERIOD);
+            d_streams.erase(std::remove_if(d_streams.begin(), d_streams.end(),
+                                [](const std::shared_ptr<Stream>& stream) { return stream->is_closed(); }),
+                d_streams.end());
+            // Do not hold the lock while writing, so channels can open streams
+            const std::vector<std::shared_ptr<Stream>> streams = d_streams;
+            lock.unlock();
+            for (const auto& stream : streams)
+                {
+                    stream->drain();
+                }
+            lock.lock();
+        }
+}
@@ -0,0 +1,129 @@
+/*!
+ * \file tracking_dump_writer.h
+ * \brief Background writer of the tracking dump files.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_DUMP_WRITER_H
+#define GNSS_SDR_TRACKING_DUMP_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes the dump records of the tracking channels from a single
+ * background thread.
+ *
+ * Each channel opens a stream of fixed-size records. Pushing a record copies
+ * it into a lock-free ring buffer owned by the stream, so the signal
+ * processing thread never waits for the disk. The writer thread drains all
+ * the rings into their files. Records are written as they were pushed, so the
+ * files have the same layout as if they were written directly. If a ring is
+ * full, the record is dropped and counted.
+ */
+class Tracking_Dump_Writer
+{
+public:
+    /*!
+     * \brief Records of one dump file. Written by a single producer thread.
+     */
+    class Stream
+    {
+    public:
+        Stream(const std::string& filename, size_t record_size, size_t capacity_records);
+        ~Stream();
+
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        bool is_open() const { return d_file.is_open(); }
+
+        /*!
+         * \brief Queues a copy of the record_size bytes at record. Returns
+         * false, and drops the record, if the ring is full.
+         */
+        bool push(const void* record);
+
+        /*!
+         * \brief Writes the queued records and closes the file.
+         */
+        void close();
+
+        /*!
+         * \brief Number of records dropped because the ring was full.
+         */
+        uint64_t dropped() const { return d_dropped.load(std::memory_order_relaxed); }
+
+        /*!
+         * \brief Writes the queued records. Called by the writer thread.
+         */
+        void drain();
+
+        bool is_closed() const { return d_closed.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<char> d_ring;
+        std::ofstream d_file;
+        std::mutex d_consumer_mutex;
+        std::atomic<size_t> d_head{0};  // next record to be pushed
+        std::atomic<size_t> d_tail{0};  // next record to be written
+        std::atomic<uint64_t> d_dropped{0};
+        std::atomic<bool> d_closed{false};
+        size_t d_record_size;
+        size_t d_capacity;
+    };
+
+    /*!
+     * \brief Returns the process-wide writer.
+     */
+    static Tracking_Dump_Writer& instance();
+
+    ~Tracking_Dump_Writer();
+
+    Tracking_Dump_Writer(const Tracking_Dump_Writer&) = delete;
+    Tracking_Dump_Writer& operator=(const Tracking_Dump_Writer&) = delete;
+
+    /*!
+     * \brief Opens filename for writing and returns its stream, which may
+     * not be open if the file could not be created.
+     */
+    std::shared_ptr<Stream> open(const std::string& filename, size_t record_size, size_t capacity_records = 16384);
+
+private:
+    Tracking_Dump_Writer();
+    void run();
+
+    std::vector<std::shared_ptr<Stream>> d_streams;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::thread d_thread;
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_DUMP_WRITER_H
@@ -0,0 +1,147 @@
+/*!
+ * \file tracking_gpu_correlator.cc
+ * \brief Interface of the carrier wipe-off and multicorrelator of all the
+ * tracking channels computed in an accelerator (CUDA or OpenCL device).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_gpu_correlator.h"
+#if CUDA_GPU_ACCEL
+#include "tracking_cuda_correlator.h"
+#endif
+#if OPENCL_GPU_ACCEL
+#include "tracking_opencl_correlator.h"
+#endif
+#include <algorithm>  // for std::all_of, std::max, std::sort
+#include <stdexcept>
+#include <string>
+
+
+Tracking_Gpu_Correlator& Tracking_Gpu_Correlator::get(Gnss_Compute_Backend backend, int device __attribute__((unused)))
+{
+    switch (backend)
+        {
+#if CUDA_GPU_ACCEL
+        case Gnss_Compute_Backend::CUDA:
+            if (!Tracking_Cuda_Correlator::is_available())
+                {
+                    throw std::runtime_error("No CUDA device found");
+                }
+            return Tracking_Cuda_Correlator::instance(device);
+#endif
+#if OPENCL_GPU_ACCEL
+        case Gnss_Compute_Backend::OpenCL:
+            return Tracking_Opencl_Correlator::instance();
+#endif
+        default:
+            throw std::runtime_error("The " + compute_backend_to_string(backend) + " backend cannot compute tracking correlations");
+        }
+}
+
+
+void Tracking_Gpu_Correlator::correlate(std::vector<Job>& jobs)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    for (auto& job : jobs)
+        {
+            job.done = false;
+            job.failed = false;
+            d_queue.push_back(&job);
+        }
+    const auto all_done = [&jobs]() {
+        return std::all_of(jobs.begin(), jobs.end(), [](const Job& job) { return job.done; });
+    };
+    while (!all_done())
+        {
+            if (d_sweeping)
+                {
+                    d_cv.wait(lock);
+                    continue;
+                }
+            // Lead a sweep with everything queued so far, including our jobs
+            d_sweeping = true;
+            const std::vector<Job*> batch = std::move(d_queue);
+            d_queue.clear();
+            lock.unlock();
+
+            bool failed = false;
+            std::string error;
+            try
+                {
+                    sweep(batch);
+                }
+            catch (const std::exception& e)
+                {
+                    failed = true;
+                    error = e.what();
+                }
+
+            lock.lock();
+            for (auto* job : batch)
+                {
+                    job->failed = failed;
+                    job->done = true;
+                }
+            d_sweeping = false;
+            d_cv.notify_all();
+            if (failed)
+                {
+                    throw std::runtime_error(error);
+                }
+        }
+    for (const auto& job : jobs)
+        {
+            if (job.failed)
+                {
+                    throw std::runtime_error("GPU tracking correlation failed");
+                }
+        }
+}
+
+
+size_t Tracking_Gpu_Correlator::plan_staging(const std::vector<Job*>& jobs,
+    std::vector<std::pair<const std::complex<float>*, const std::complex<float>*>>& segments,
+    std::vector<size_t>& staged_offset)
+{
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++)
+        {
+            order[i] = i;
+        }
+    std::sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) { return jobs[a]->input < jobs[b]->input; });
+    segments.clear();
+    staged_offset.assign(jobs.size(), 0);
+    size_t staged_samples = 0;
+    for (const size_t i : order)
+        {
+            const Job* job = jobs[i];
+            const std::complex<float>* end = job->input + job->signal_length_samples;
+            if (segments.empty() or job->input > segments.back().second)
+                {
+                    if (!segments.empty())
+                        {
+                            staged_samples += segments.back().second - segments.back().first;
+                        }
+                    segments.emplace_back(job->input, end);
+                }
+            else
+                {
+                    segments.back().second = std::max(segments.back().second, end);
+                }
+            staged_offset[i] = staged_samples + (job->input - segments.back().first);
+        }
+    if (!segments.empty())
+        {
+            staged_samples += segments.back().second - segments.back().first;
+        }
+    return staged_samples;
+}
@@ -0,0 +1,130 @@
+/*!
+ * \file tracking_gpu_correlator.h
+ * \brief Interface of the carrier wipe-off and multicorrelator of all the
+ * tracking channels computed in an accelerator (CUDA or OpenCL device).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_GPU_CORRELATOR_H
+#define GNSS_SDR_TRACKING_GPU_CORRELATOR_H
+
+#include "gnss_sdr_compute_backend.h"
+#include <complex>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Shared accelerator correlator of the tracking channels.
+ *
+ * Works as Tracking_Correlator_Service: channels submit the correlations of
+ * their integration interval, and the first one finding the device idle
+ * computes all the jobs queued at that moment with sweep(), in a single
+ * kernel launch. The local codes are uploaded once per satellite. Jobs can
+ * have up to max_taps correlators. Methods throw std::runtime_error on device
+ * errors, so the channels can fall back to the CPU correlators.
+ */
+class Tracking_Gpu_Correlator
+{
+public:
+    static const int max_taps = 8;
+
+    /*!
+     * \brief Correlation of the local code code_id over an integration
+     * interval, with the same parameters as Cpu_Multicorrelator_Real_Codes.
+     */
+    class Job
+    {
+    public:
+        const std::complex<float>* input{nullptr};
+        std::complex<float>* corr_out{nullptr};  // n_correlators outputs
+        const float* shifts_chips{nullptr};      // n_correlators tap shifts
+        int n_correlators{0};
+        int code_id{-1};
+        float rem_carrier_phase_in_rad{0.0};
+        float phase_step_rad{0.0};
+        float phase_rate_step_rad{0.0};
+        float rem_code_phase_chips{0.0};
+        float code_phase_step_chips{0.0};
+        float code_phase_rate_step_chips{0.0};
+        int signal_length_samples{0};
+        bool done{false};
+        bool failed{false};  // set if the batch could not be computed
+    };
+
+    /*!
+     * \brief Returns the process-wide correlator of the backend on a device
+     * (see Gnss_Device_Scheduler; OpenCL uses a single device). Throws
+     * std::runtime_error if the backend is the CPU, was not built in, or has
+     * no such device.
+     */
+    static Tracking_Gpu_Correlator& get(Gnss_Compute_Backend backend, int device = 0);
+
+    Tracking_Gpu_Correlator(const Tracking_Gpu_Correlator&) = delete;
+    Tracking_Gpu_Correlator& operator=(const Tracking_Gpu_Correlator&) = delete;
+
+    /*!
+     * \brief Uploads a local code, sampled at code_samples_per_chip, and
+     * returns its identifier for the jobs.
+     */
+    virtual int add_code(const float* code, int code_length) = 0;
+
+    /*!
+     * \brief Releases a code returned by add_code().
+     */
+    virtual void remove_code(int code_id) = 0;
+
+    /*!
+     * \brief Computes the jobs, possibly together with those of other
+     * channels, and returns when they are done.
+     */
+    void correlate(std::vector<Job>& jobs);
+
+protected:
+    Tracking_Gpu_Correlator() = default;
+    virtual ~Tracking_Gpu_Correlator() = default;
+
+    /*!
+     * \brief Computes a batch of jobs, throwing std::runtime_error on errors.
+     */
+    virtual void sweep(const std::vector<Job*>& jobs) = 0;
+
+    /*!
+     * \brief Plans the staging of the inputs of the jobs in a single device
+     * buffer. Channels read the same input buffer, a few samples apart, so
+     * each range of overlapping inputs is staged once: segments are the host
+     * ranges to copy one after the other, staged_offset is the position of the
+     * input of each job in the staged buffer. Returns the staged samples.
+     */
+    static size_t plan_staging(const std::vector<Job*>& jobs,
+        std::vector<std::pair<const std::complex<float>*, const std::complex<float>*>>& segments,
+        std::vector<size_t>& staged_offset);
+
+private:
+    std::vector<Job*> d_queue;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    bool d_sweeping{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_GPU_CORRELATOR_H
@@ -0,0 +1,372 @@
+/*!
+ * \file tracking_opencl_correlator.cc
+ * \brief Carrier wipe-off and multicorrelator of all the tracking channels
+ * computed in an OpenCL device, with one kernel launch per batch of channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_opencl_correlator.h"
+#include <algorithm>  // for std::copy, std::max
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+const size_t THREADS_PER_GROUP = 256;
+const int CHUNK_SAMPLES = 4096;  // samples of one job correlated by a work-group
+const int MAX_TAPS = Tracking_Gpu_Correlator::max_taps;
+
+
+// Same layout in the host and in the device: 32-bit members only
+struct Gpu_Job
+{
+    int code_offset;
+    int code_length;
+    int input_offset;  // in the staged input buffer
+    int signal_length;
+    int n_taps;
+    float shifts[MAX_TAPS];
+    float rem_carrier_phase;
+    float phase_step;
+    float phase_rate_step;
+    float rem_code_phase;
+    float code_phase_step;
+    float code_phase_rate_step;
+};
+
+
+// Work-group (x, y) correlates chunk x of job y with all the taps of the job,
+// with the same sampling and carrier phase conventions as the VOLK_GNSSSDR kernels
+const char* TRACKING_OPENCL_KERNELS = R"(
+#define THREADS_PER_GROUP 256
+#define CHUNK_SAMPLES 4096
+#define MAX_TAPS 8
+
+typedef struct
+{
+    int code_offset;
+    int code_length;
+    int input_offset;
+    int signal_length;
+    int n_taps;
+    float shifts[MAX_TAPS];
+    float rem_carrier_phase;
+    float phase_step;
+    float phase_rate_step;
+    float rem_code_phase;
+    float code_phase_step;
+    float code_phase_rate_step;
+} Gpu_Job;
+
+__kernel __attribute__((reqd_work_group_size(THREADS_PER_GROUP, 1, 1)))
+void correlation(__global float2* partials, __global const float2* input,
+    __global const float* codes, __global const Gpu_Job* jobs, int max_chunks)
+{
+    __local float partial_r[THREADS_PER_GROUP];
+    __local float partial_i[THREADS_PER_GROUP];
+    const int lid = get_local_id(0);
+    const int chunk = get_group_id(0);
+    const int job_index = get_group_id(1);
+    __global const Gpu_Job* job = &jobs[job_index];
+    const int first = chunk * CHUNK_SAMPLES;
+    if (first >= job->signal_length)
+        {
+            return;  // the whole work-group
+        }
+    const int last = min(first + CHUNK_SAMPLES, job->signal_length);
+    __global const float* code = codes + job->code_offset;
+
+    float acc_r[MAX_TAPS];
+    float acc_i[MAX_TAPS];
+    for (int t = 0; t < MAX_TAPS; t++)
+        {
+            acc_r[t] = 0.0f;
+            acc_i[t] = 0.0f;
+        }
+    for (int n = first + lid; n < last; n += THREADS_PER_GROUP)
+        {
+            const float fn = (float)n;
+            // sample * exp(-j * phase)
+            const float phase = job->rem_carrier_phase + fn * (job->phase_step + fn * job->phase_rate_step);
+            float c;
+            const float s = sincos(phase, &c);
+            const float2 x = input[job->input_offset + n];
+            const float wiped_r = x.x * c + x.y * s;
+            const float wiped_i = x.y * c - x.x * s;
+            const float code_phase = job->code_phase_step * fn + job->code_phase_rate_step * fn * fn - job->rem_code_phase;
+            for (int t = 0; t < job->n_taps; t++)
+                {
+                    int chip = ((int)floor(code_phase + job->shifts[t])) % job->code_length;
+                    if (chip < 0)
+                        {
+                            chip += job->code_length;
+                        }
+                    acc_r[t] += code[chip] * wiped_r;
+                    acc_i[t] += code[chip] * wiped_i;
+                }
+        }
+
+    for (int t = 0; t < job->n_taps; t++)
+        {
+            partial_r[lid] = acc_r[t];
+            partial_i[lid] = acc_i[t];
+            barrier(CLK_LOCAL_MEM_FENCE);
+            for (int stride = THREADS_PER_GROUP / 2; stride > 0; stride /= 2)
+                {
+                    if (lid < stride)
+                        {
+                            partial_r[lid] += partial_r[lid + stride];
+                            partial_i[lid] += partial_i[lid + stride];
+                        }
+                    barrier(CLK_LOCAL_MEM_FENCE);
+                }
+            if (lid == 0)
+                {
+                    partials[(job_index * max_chunks + chunk) * MAX_TAPS + t] = (float2)(partial_r[0], partial_i[0]);
+                }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+}
+)";
+
+
+void release_buffer(cl_mem& buffer)
+{
+    if (buffer != nullptr)
+        {
+            clReleaseMemObject(buffer);
+            buffer = nullptr;
+        }
+}
+
+
+cl_mem create_buffer(cl_context context, size_t size)
+{
+    cl_int err = CL_SUCCESS;
+    cl_mem buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, size, nullptr, &err);
+    check_opencl(err, "clCreateBuffer");
+    return buffer;
+}
+}  // namespace
+
+
+Tracking_Opencl_Correlator& Tracking_Opencl_Correlator::instance()
+{
+    static Tracking_Opencl_Correlator correlator;
+    return correlator;
+}
+
+
+Tracking_Opencl_Correlator::Tracking_Opencl_Correlator() : d_context(Gnss_Opencl_Context::get())
+{
+    d_queue = d_context->create_queue();
+    try
+        {
+            d_program = d_context->build_program(TRACKING_OPENCL_KERNELS);
+            cl_int err = CL_SUCCESS;
+            d_kernel = clCreateKernel(d_program, "correlation", &err);
+            check_opencl(err, "clCreateKernel");
+        }
+    catch (const std::runtime_error&)
+        {
+            if (d_program != nullptr)
+                {
+                    clReleaseProgram(d_program);
+                }
+            clReleaseCommandQueue(d_queue);
+            throw;
+        }
+}
+
+
+Tracking_Opencl_Correlator::~Tracking_Opencl_Correlator()
+{
+    release_buffer(d_cl_codes);
+    release_buffer(d_cl_params);
+    release_buffer(d_cl_input);
+    release_buffer(d_cl_partials);
+    clReleaseKernel(d_kernel);
+    clReleaseProgram(d_program);
+    clReleaseCommandQueue(d_queue);
+}
+
+
+int Tracking_Opencl_Correlator::add_code(const float* code, int code_length)
+{
+    std::lock_guard<std::mutex> lock(d_codes_mutex);
+    d_codes_changed = true;
+    for (size_t id = 0; id < d_codes.size(); id++)
+        {
+            if (d_codes[id].empty())
+                {
+                    d_codes[id].assign(code, code + code_length);
+                    return static_cast<int>(id);
+                }
+        }
+    d_codes.emplace_back(code, code + code_length);
+    d_code_offsets.push_back(0);
+    return static_cast<int>(d_codes.size() - 1);
+}
+
+
+void Tracking_Opencl_Correlator::remove_code(int code_id)
+{
+    // The slot is reused by the next add_code(); the device copy is packed
+    // again before the next sweep using it
+    std::lock_guard<std::mutex> lock(d_codes_mutex);
+    if (code_id >= 0 and code_id < static_cast<int>(d_codes.size()))
+        {
+            d_codes[code_id].clear();
+            d_codes[code_id].shrink_to_fit();
+        }
+}
+
+
+// Called with d_codes_mutex locked
+void Tracking_Opencl_Correlator::upload_codes()
+{
+    std::vector<float> packed;
+    for (size_t id = 0; id < d_codes.size(); id++)
+        {
+            d_code_offsets[id] = static_cast<int>(packed.size());
+            packed.insert(packed.end(), d_codes[id].begin(), d_codes[id].end());
+        }
+    release_buffer(d_cl_codes);
+    if (!packed.empty())
+        {
+            d_cl_codes = create_buffer(d_context->context(), sizeof(float) * packed.size());
+            check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_codes, CL_TRUE, 0, sizeof(float) * packed.size(), packed.data(), 0, nullptr, nullptr),
+                "clEnqueueWriteBuffer");
+        }
+    d_codes_changed = false;
+}
+
+
+void Tracking_Opencl_Correlator::reserve(size_t num_jobs, size_t num_samples, size_t num_chunks)
+{
+    // Buffers only grow
+    if (num_jobs > d_max_jobs)
+        {
+            release_buffer(d_cl_params);
+            const size_t capacity = std::max(num_jobs, 2 * d_max_jobs);
+            d_max_jobs = 0;
+            d_cl_params = create_buffer(d_context->context(), sizeof(Gpu_Job) * capacity);
+            d_max_jobs = capacity;
+        }
+    if (num_samples > d_max_samples)
+        {
+            release_buffer(d_cl_input);
+            const size_t capacity = std::max(num_samples, 2 * d_max_samples);
+            d_max_samples = 0;
+            d_cl_input = create_buffer(d_context->context(), sizeof(std::complex<float>) * capacity);
+            d_max_samples = capacity;
+        }
+    const size_t num_partials = num_jobs * num_chunks * MAX_TAPS;
+    if (num_partials > d_max_partials)
+        {
+            release_buffer(d_cl_partials);
+            const size_t capacity = std::max(num_partials, 2 * d_max_partials);
+            d_max_partials = 0;
+            d_cl_partials = create_buffer(d_context->context(), sizeof(std::complex<float>) * capacity);
+            d_host_partials.resize(capacity);
+            d_max_partials = capacity;
+        }
+}
+
+
+void Tracking_Opencl_Correlator::sweep(const std::vector<Job*>& jobs)
+{
+    std::vector<std::pair<const std::complex<float>*, const std::complex<float>*>> segments;
+    std::vector<size_t> staged_offset;
+    const size_t staged_samples = plan_staging(jobs, segments, staged_offset);
+    int max_length = 0;
+    for (const auto* job : jobs)
+        {
+            max_length = std::max(max_length, job->signal_length_samples);
+        }
+    const int max_chunks = (max_length + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES;
+    reserve(jobs.size(), staged_samples, static_cast<size_t>(max_chunks));
+
+    // The channels wait for the sweep, so their inputs stay valid until the
+    // blocking read of the results
+    size_t offset = 0;
+    for (const auto& segment : segments)
+        {
+            const auto length = static_cast<size_t>(segment.second - segment.first);
+            check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_input, CL_FALSE, sizeof(std::complex<float>) * offset,
+                             sizeof(std::complex<float>) * length, segment.first, 0, nullptr, nullptr),
+                "clEnqueueWriteBuffer");
+            offset += length;
+        }
+
+    std::vector<Gpu_Job> params(jobs.size());
+    {
+        std::lock_guard<std::mutex> lock(d_codes_mutex);
+        if (d_codes_changed)
+            {
+                upload_codes();
+            }
+        for (size_t i = 0; i < jobs.size(); i++)
+            {
+                const Job* job = jobs[i];
+                if (job->n_correlators < 1 or job->n_correlators > MAX_TAPS or job->code_id < 0 or
+                    job->code_id >= static_cast<int>(d_codes.size()) or d_codes[job->code_id].empty())
+                    {
+                        throw std::runtime_error("Invalid OpenCL tracking correlation job");
+                    }
+                Gpu_Job& p = params[i];
+                p.code_offset = d_code_offsets[job->code_id];
+                p.code_length = static_cast<int>(d_codes[job->code_id].size());
+                p.input_offset = static_cast<int>(staged_offset[i]);
+                p.signal_length = job->signal_length_samples;
+                p.n_taps = job->n_correlators;
+                std::copy(job->shifts_chips, job->shifts_chips + job->n_correlators, p.shifts);
+                p.rem_carrier_phase = job->rem_carrier_phase_in_rad;
+                p.phase_step = job->phase_step_rad;
+                p.phase_rate_step = job->phase_rate_step_rad;
+                p.rem_code_phase = job->rem_code_phase_chips;
+                p.code_phase_step = job->code_phase_step_chips;
+                p.code_phase_rate_step = job->code_phase_rate_step_chips;
+            }
+    }
+    check_opencl(clEnqueueWriteBuffer(d_queue, d_cl_params, CL_FALSE, 0, sizeof(Gpu_Job) * params.size(), params.data(), 0, nullptr, nullptr),
+        "clEnqueueWriteBuffer");
+
+    clSetKernelArg(d_kernel, 0, sizeof(cl_mem), &d_cl_partials);
+    clSetKernelArg(d_kernel, 1, sizeof(cl_mem), &d_cl_input);
+    clSetKernelArg(d_kernel, 2, sizeof(cl_mem), &d_cl_codes);
+    clSetKernelArg(d_kernel, 3, sizeof(cl_mem), &d_cl_params);
+    clSetKernelArg(d_kernel, 4, sizeof(cl_int), &max_chunks);
+    const size_t global_size[2] = {static_cast<size_t>(max_chunks) * THREADS_PER_GROUP, jobs.size()};
+    const size_t local_size[2] = {THREADS_PER_GROUP, 1};
+    check_opencl(clEnqueueNDRangeKernel(d_queue, d_kernel, 2, nullptr, global_size, local_size, 0, nullptr, nullptr), "clEnqueueNDRangeKernel");
+    const size_t num_partials = jobs.size() * static_cast<size_t>(max_chunks) * MAX_TAPS;
+    check_opencl(clEnqueueReadBuffer(d_queue, d_cl_partials, CL_TRUE, 0, sizeof(std::complex<float>) * num_partials, d_host_partials.data(), 0, nullptr, nullptr),
+        "clEnqueueReadBuffer");
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        {
+            const Job* job = jobs[i];
+            const int chunks = (job->signal_length_samples + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES;
+            for (int t = 0; t < job->n_correlators; t++)
+                {
+                    std::complex<float> sum(0.0, 0.0);
+                    for (int chunk = 0; chunk < chunks; chunk++)
+                        {
+                            sum += d_host_partials[(i * max_chunks + static_cast<size_t>(chunk)) * MAX_TAPS + t];
+                        }
+                    job->corr_out[t] = sum;
+                }
+        }
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file tracking_opencl_correlator.h
+ * \brief Carrier wipe-off and multicorrelator of all the tracking channels
+ * computed in an OpenCL device, with one kernel launch per batch of channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_OPENCL_CORRELATOR_H
+#define GNSS_SDR_TRACKING_OPENCL_CORRELATOR_H
+
+#include "gnss_sdr_opencl.h"
+#include "tracking_gpu_correlator.h"
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Shared OpenCL correlator of the tracking channels.
+ *
+ * Same kernel as Tracking_Cuda_Correlator, for any GPU vendor: work-groups
+ * over the jobs and chunks of their samples, each sample wiped off once and
+ * correlated with all the taps of its job. OpenCL 1.2 has no floating point
+ * atomics, so each work-group writes the sums of its chunk and the host adds
+ * them up. The local codes are kept packed in a single device buffer, which
+ * is uploaded again only when a channel changes its satellite.
+ */
+class Tracking_Opencl_Correlator : public Tracking_Gpu_Correlator
+{
+public:
+    /*!
+     * \brief Returns the process-wide correlator. Throws std::runtime_error
+     * if there is no OpenCL device.
+     */
+    static Tracking_Opencl_Correlator& instance();
+
+    int add_code(const float* code, int code_length) override;
+    void remove_code(int code_id) override;
+
+private:
+    Tracking_Opencl_Correlator();
+    ~Tracking_Opencl_Correlator() override;
+    void sweep(const std::vector<Job*>& jobs) override;
+    void upload_codes();
+    void reserve(size_t num_jobs, size_t num_samples, size_t num_chunks);
+
+    std::shared_ptr<Gnss_Opencl_Context> d_context;
+    cl_command_queue d_queue{nullptr};
+    cl_program d_program{nullptr};
+    cl_kernel d_kernel{nullptr};
+
+    std::mutex d_codes_mutex;
+    std::vector<std::vector<float>> d_codes;  // empty if free
+    std::vector<int> d_code_offsets;          // in d_cl_codes
+    bool d_codes_changed{false};
+
+    cl_mem d_cl_codes{nullptr};
+    cl_mem d_cl_params{nullptr};
+    cl_mem d_cl_input{nullptr};
+    cl_mem d_cl_partials{nullptr};
+    std::vector<std::complex<float>> d_host_partials;
+    size_t d_max_jobs{0};
+    size_t d_max_samples{0};
+    size_t d_max_partials{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_OPENCL_CORRELATOR_H
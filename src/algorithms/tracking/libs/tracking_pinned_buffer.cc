@@ -0,0 +1,114 @@
+/*!
+ * \file tracking_pinned_buffer.cc
+ * \brief GNU Radio custom buffer in mapped pinned host memory, readable in
+ * place by the CUDA tracking correlators.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_pinned_buffer.h"
+#include "tracking_device_inputs.h"
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <cstring>  // for memcpy, memmove
+#include <new>      // for bad_alloc
+
+
+gr::buffer_type Tracking_Pinned_Buffer::type(Tracking_Pinned_Buffer_Type{});
+
+
+gr::buffer_sptr Tracking_Pinned_Buffer::make_buffer(int nitems,
+    size_t sizeof_item,
+    uint64_t downstream_lcm_nitems,
+    uint32_t downstream_max_out_mult,
+    gr::block_sptr link,
+    gr::block_sptr buf_owner)
+{
+    return gr::buffer_sptr(new Tracking_Pinned_Buffer(nitems, sizeof_item, downstream_lcm_nitems, downstream_max_out_mult, link, buf_owner));
+}
+
+
+Tracking_Pinned_Buffer::Tracking_Pinned_Buffer(int nitems,
+    size_t sizeof_item,
+    uint64_t downstream_lcm_nitems,
+    uint32_t downstream_max_out_mult,
+    gr::block_sptr link,
+    gr::block_sptr buf_owner)
+    : gr::buffer_single_mapped(nitems, sizeof_item, downstream_lcm_nitems, downstream_max_out_mult, link, buf_owner)
+{
+    if (!allocate_buffer(nitems))
+        {
+            throw std::bad_alloc();
+        }
+}
+
+
+Tracking_Pinned_Buffer::~Tracking_Pinned_Buffer()
+{
+    if (d_pinned != nullptr)
+        {
+            Tracking_Device_Inputs::remove(d_pinned);
+            cudaFreeHost(d_pinned);
+        }
+}
+
+
+bool Tracking_Pinned_Buffer::do_allocate_buffer(size_t final_nitems, size_t sizeof_item)
+{
+    const size_t bytes = final_nitems * sizeof_item;
+    // Not write-combined: CPU blocks read the samples too
+    if (cudaHostAlloc(reinterpret_cast<void**>(&d_pinned), bytes, cudaHostAllocMapped | cudaHostAllocPortable) != cudaSuccess)
+        {
+            LOG(WARNING) << "Cannot allocate " << bytes << " bytes of pinned host memory";
+            d_pinned = nullptr;
+            return false;
+        }
+    void* device_base = nullptr;
+    if (cudaHostGetDevicePointer(&device_base, d_pinned, 0) != cudaSuccess)
+        {
+            cudaFreeHost(d_pinned);
+            d_pinned = nullptr;
+            return false;
+        }
+    Tracking_Device_Inputs::add(d_pinned, bytes, device_base);
+    d_base = d_pinned;
+    return true;
+}
+
+
+void Tracking_Pinned_Buffer::post_work(int nitems __attribute__((unused)))
+{
+    // The device reads the samples where they were written
+}
+
+
+void* Tracking_Pinned_Buffer::write_pointer()
+{
+    return &d_base[d_write_index * d_sizeof_item];
+}
+
+
+const void* Tracking_Pinned_Buffer::_read_pointer(unsigned int read_index)
+{
+    return &d_base[read_index * d_sizeof_item];
+}
+
+
+bool Tracking_Pinned_Buffer::input_blocked_callback(int items_required, int items_avail, unsigned read_index)
+{
+    return input_blocked_callback_logic(items_required, items_avail, read_index, d_base, std::memcpy, std::memmove);
+}
+
+
+bool Tracking_Pinned_Buffer::output_blocked_callback(int output_multiple, bool force)
+{
+    return output_blocked_callback_logic(output_multiple, force, d_base, std::memmove);
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file tracking_pinned_buffer.h
+ * \brief GNU Radio custom buffer in mapped pinned host memory, readable in
+ * place by the CUDA tracking correlators.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_PINNED_BUFFER_H
+#define GNSS_SDR_TRACKING_PINNED_BUFFER_H
+
+#include <gnuradio/buffer_single_mapped.h>
+#include <gnuradio/buffer_type.h>
+#include <cstddef>
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Single-mapped flow graph buffer allocated with cudaHostAlloc().
+ *
+ * The host and device views of the samples are the same memory, so all
+ * the transfer contexts of GNU Radio work the same way and post_work() does
+ * not copy anything: CPU blocks read it as any other buffer, and the GPU
+ * correlators read it over the bus without staging (see
+ * Tracking_Device_Inputs). Use it as the output buffer type of the block
+ * feeding the channels, so that all their readers share it.
+ */
+class Tracking_Pinned_Buffer : public gr::buffer_single_mapped
+{
+public:
+    static gr::buffer_type type;
+
+    static gr::buffer_sptr make_buffer(int nitems,
+        size_t sizeof_item,
+        uint64_t downstream_lcm_nitems,
+        uint32_t downstream_max_out_mult,
+        gr::block_sptr link = gr::block_sptr(),
+        gr::block_sptr buf_owner = gr::block_sptr());
+
+    ~Tracking_Pinned_Buffer() override;
+
+    void post_work(int nitems) override;
+    void* write_pointer() override;
+    const void* _read_pointer(unsigned int read_index) override;
+    bool input_blocked_callback(int items_required, int items_avail, unsigned read_index) override;
+    bool output_blocked_callback(int output_multiple, bool force) override;
+
+protected:
+    bool do_allocate_buffer(size_t final_nitems, size_t sizeof_item) override;
+
+private:
+    Tracking_Pinned_Buffer(int nitems,
+        size_t sizeof_item,
+        uint64_t downstream_lcm_nitems,
+        uint32_t downstream_max_out_mult,
+        gr::block_sptr link,
+        gr::block_sptr buf_owner);
+
+    char* d_pinned{nullptr};
+};
+
+
+/*!
+ * \brief Buffer type of Tracking_Pinned_Buffer, as generated by GNU Radio's
+ * MAKE_CUSTOM_BUFFER_TYPE.
+ */
+class Tracking_Pinned_Buffer_Type : public gr::buffer_type_base
+{
+public:
+    Tracking_Pinned_Buffer_Type()
+        : gr::buffer_type_base("TRACKING_PINNED_BUFFER", &Tracking_Pinned_Buffer::make_buffer)
+    {
+    }
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_PINNED_BUFFER_H
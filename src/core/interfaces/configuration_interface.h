@@ -45,17 +45,17 @@ class ConfigurationInterface
 {
 public:
     virtual ~ConfigurationInterface() = default;
-    virtual std::string property(std::string property_name, std::string default_value) const = 0;
-    virtual bool property(std::string property_name, bool default_value) const = 0;
-    virtual int64_t property(std::string property_name, int64_t default_value) const = 0;
-    virtual uint64_t property(std::string property_name, uint64_t default_value) const = 0;
-    virtual int32_t property(std::string property_name, int32_t default_value) const = 0;
-    virtual uint32_t property(std::string property_name, uint32_t default_value) const = 0;
-    virtual int16_t property(std::string property_name, int16_t default_value) const = 0;
-    virtual uint16_t property(std::string property_name, uint16_t default_value) const = 0;
-    virtual float property(std::string property_name, float default_value) const = 0;
-    virtual double property(std::string property_name, double default_value) const = 0;
-    virtual void set_property(std::string property_name, std::string value) = 0;
+    virtual std::string property(const std::string& property_name, std::string default_value) const = 0;
+    virtual bool property(const std::string& property_name, bool default_value) const = 0;
+    virtual int64_t property(const std::string& property_name, int64_t default_value) const = 0;
+    virtual uint64_t property(const std::string& property_name, uint64_t default_value) const = 0;
+    virtual int32_t property(const std::string& property_name, int32_t default_value) const = 0;
+    virtual uint32_t property(const std::string& property_name, uint32_t default_value) const = 0;
+    virtual int16_t property(const std::string& property_name, int16_t default_value) const = 0;
+    virtual uint16_t property(const std::string& property_name, uint16_t default_value) const = 0;
+    virtual float property(const std::string& property_name, float default_value) const = 0;
+    virtual double property(const std::string& property_name, double default_value) const = 0;
+    virtual void set_property(const std::string& property_name, std::string value) = 0;
 };
 
 
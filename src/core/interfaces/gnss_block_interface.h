@@ -25,6 +25,7 @@
 
 #include <gnuradio/top_block.h>
 #include <cassert>
+#include <functional>
 #include <string>
 #include <utility>  // for std::forward
 
@@ -95,6 +96,18 @@ public:
         return nullptr;  // added to support raw array access (non pure virtual to allow left unimplemented)= 0;
     }
 
+    /*!
+     * \brief Returns a function doing the job of this block on a buffer of
+     * nitems items of item_size() bytes, in place, or an empty function if
+     * the block cannot work that way. Signal conditioners run the adjacent
+     * stages that provide one back to back on a single buffer, instead of
+     * connecting their blocks.
+     */
+    virtual std::function<void(void *items, int nitems)> in_place_kernel()
+    {
+        return nullptr;
+    }
+
     /*!
      * \brief Start the flow of samples if needed.
      */
@@ -28,7 +28,10 @@
 #include "gnss_block_interface.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
+#include <cstdint>
 #include <map>
+#include <string>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -36,6 +39,20 @@
  * \{ */
 
 
+/*!
+ * \brief A satellite used in the last position fix, and what the fix would
+ * lose without it
+ */
+struct Pvt_Satellite_Contribution
+{
+    char system{0};            //!< 'G', 'R', 'E' or 'C'
+    uint32_t prn{0};
+    double elevation_deg{0.0};
+    double gdop{0.0};          //!< GDOP of the fix
+    double gdop_without{0.0};  //!< GDOP of the fix without this satellite, 0 if there would be no fix
+};
+
+
 /*!
  * \brief This class represents an interface to a PVT block.
  *
@@ -61,6 +78,25 @@ public:
         double* ground_speed_kmh,
         double* course_over_ground_deg,
         time_t* UTC_time) = 0;
+
+    /*!
+     * \brief Changes at run time the rate of an output ("kml", "gpx",
+     * "geojson", "nmea" or "display"). Returns false if the output is
+     * not enabled, or if the rate is not a multiple of the PVT output rate.
+     */
+    virtual bool set_output_rate(const std::string& output __attribute__((unused)), int32_t rate_ms __attribute__((unused)))
+    {
+        return false;
+    }
+
+    /*!
+     * \brief Satellites used in the last position fix. Empty if there is no
+     * fix, or if the PVT does not report them.
+     */
+    virtual std::vector<Pvt_Satellite_Contribution> get_satellite_contributions() const
+    {
+        return {};
+    }
 };
 
 
@@ -28,6 +28,10 @@
 
 #include "gnss_block_interface.h"
 #include <glog/logging.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -48,6 +52,34 @@ class SignalSourceInterface : public GNSSBlockInterface
 public:
     virtual size_t getRfChannels() const = 0;
 
+    /*!
+     * \brief Moves a running file-based source to the given time, in seconds
+     * from the beginning of the file. Returns false if the source cannot seek.
+     */
+    virtual bool seek_to_seconds(double seconds __attribute__((unused)))
+    {
+        return false;
+    }
+
+    /*!
+     * \brief Moves a running file-based source to the sample recorded at the
+     * given GNSS time. Returns false if the source cannot seek, or if the time
+     * is not in its capture index.
+     */
+    virtual bool seek_to_time(int32_t week __attribute__((unused)), double tow_s __attribute__((unused)))
+    {
+        return false;
+    }
+
+    /*!
+     * \brief Named gauges and counters of the front-end (e.g., the state of
+     * its gain control), reported with the receiver metrics.
+     */
+    virtual std::vector<std::pair<std::string, double>> metrics() const
+    {
+        return {};
+    }
+
 protected:
     SignalSourceInterface()
     {
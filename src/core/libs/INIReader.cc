@@ -101,3 +101,9 @@ bool INIReader::HasValue(const std::string& section, const std::string& name) co
     std::string key = MakeKey(section, name);
     return _values.count(key);
 }
+
+
+const std::map<std::string, std::string>& INIReader::Values() const
+{
+    return _values;
+}
@@ -74,6 +74,7 @@ void channel_status_msg_receiver::msg_handler_channel_status(const pmt::pmt_t& m
                     if (gnss_synchro_obj->Flag_valid_pseudorange == true)
                         {
                             d_channel_status_map[gnss_synchro_obj->Channel_ID] = gnss_synchro_obj;
+                            d_last_valid_status_map[gnss_synchro_obj->Channel_ID] = gnss_synchro_obj;
                         }
                     else
                         {
@@ -116,6 +117,18 @@ std::map<int, std::shared_ptr<Gnss_Synchro>> channel_status_msg_receiver::get_cu
 }
 
 
+std::shared_ptr<Gnss_Synchro> channel_status_msg_receiver::get_last_valid_status(int channel_id)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with msg_handler_channel_status function called by the scheduler
+    const auto it = d_last_valid_status_map.find(channel_id);
+    if (it == d_last_valid_status_map.end())
+        {
+            return nullptr;
+        }
+    return it->second;
+}
+
+
 Monitor_Pvt channel_status_msg_receiver::get_current_status_pvt()
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with msg_handler_channel_status function called by the scheduler
@@ -51,6 +51,12 @@ public:
      */
     std::map<int, std::shared_ptr<Gnss_Synchro>> get_current_status_map();
 
+    /*!
+     * \brief return the last valid status of a channel, even if its telemetry
+     * is no longer valid, or nullptr if the channel has never been valid
+     */
+    std::shared_ptr<Gnss_Synchro> get_last_valid_status(int channel_id);
+
     /*!
      * \brief return the current receiver PVT
      */
@@ -62,6 +68,7 @@ private:
     void msg_handler_channel_status(const pmt::pmt_t& msg);
     Monitor_Pvt d_pvt_status{};
     std::map<int, std::shared_ptr<Gnss_Synchro>> d_channel_status_map;
+    std::map<int, std::shared_ptr<Gnss_Synchro>> d_last_valid_status_map;
 };
 
 
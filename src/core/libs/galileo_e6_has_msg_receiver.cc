@@ -78,6 +78,7 @@ galileo_e6_has_msg_receiver::galileo_e6_has_msg_receiver() : gr::block("galileo_
     d_C_matrix = std::vector<std::vector<std::vector<uint8_t>>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)));  // 32 x 255 x 53
     d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));                                                                                                 // HAS message matrix 32 x 53
     d_received_pids = std::vector<std::vector<uint8_t>>(HAS_MSG_NUMBER_MESSAGE_IDS, std::vector<uint8_t>());
+    d_received_rows.reserve(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
 
     // Reserve memory to store masks
     d_nsat_in_mask_id = std::vector<int>(HAS_MSG_NUMBER_MASK_IDS);
@@ -138,7 +139,10 @@ void galileo_e6_has_msg_receiver::msg_handler_galileo_e6_has(const pmt::pmt_t& m
         {
             d_HAS_data.has_status = d_current_has_status;
             d_HAS_data.message_id = d_current_message_id;
-            auto has_data_ptr = std::make_shared<Galileo_HAS_data>(d_HAS_data);
+            // d_HAS_data is rebuilt from scratch at the next decoding, so it
+            // can be handed over without a copy
+            auto has_data_ptr = std::make_shared<Galileo_HAS_data>(std::move(d_HAS_data));
+            d_HAS_data = Galileo_HAS_data();
             this->message_port_pub(pmt::mp("E6_HAS_to_PVT"), pmt::make_any(has_data_ptr));
             d_new_message = false;
             DLOG(INFO) << "HAS message sent to the PVT block through the E6_HAS_to_PVT async message port";
@@ -150,7 +154,7 @@ void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_p
 {
     if (has_page.has_status == 0 || has_page.has_status == 1)
         {
-            std::string page_string(has_page.has_message_string);
+            const std::string& page_string = has_page.has_message_string;
             if (has_page.message_page_id != 0)  // PID=0 is reserved, ignore it
                 {
                     if (has_page.message_type == 1)  // contains satellite corrections
@@ -161,12 +165,16 @@ void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_p
                                         {
                                             // New pid! Annotate it.
                                             d_received_pids[has_page.message_id].push_back(has_page.message_page_id);
-                                            for (int k = 0; k < GALILEO_CNAV_OCTETS_IN_SUBPAGE; k++)
+                                            constexpr size_t bits_in_octet = 8;
+                                            auto& C_row = d_C_matrix[has_page.message_id][has_page.message_page_id - 1];
+                                            for (size_t k = 0; k < static_cast<size_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE) && (k + 1) * bits_in_octet <= page_string.size(); k++)
                                                 {
-                                                    constexpr int bits_in_octet = 8;
-                                                    std::string bits8 = page_string.substr(k * bits_in_octet, bits_in_octet);
-                                                    std::bitset<bits_in_octet> bs(bits8);
-                                                    d_C_matrix[has_page.message_id][has_page.message_page_id - 1][k] = static_cast<uint8_t>(bs.to_ulong());
+                                                    uint8_t octet = 0;
+                                                    for (size_t b = 0; b < bits_in_octet; b++)
+                                                        {
+                                                            octet = static_cast<uint8_t>((octet << 1) | (page_string[k * bits_in_octet + b] == '1' ? 1 : 0));
+                                                        }
+                                                    C_row[k] = octet;
                                                 }
                                         }
                                 }
@@ -176,7 +184,7 @@ void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_p
 
     // If we have received for this message ID a number of pages equal to the message size
     d_new_message = false;
-    if (d_received_pids[has_page.message_id].size() == has_page.message_size)
+    if (has_page.message_id < HAS_MSG_NUMBER_MESSAGE_IDS && d_received_pids[has_page.message_id].size() == has_page.message_size)
         {
             // Try to decode the message
             int res = decode_message_type1(has_page.message_id, has_page.message_size);
@@ -199,78 +207,55 @@ void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_p
 int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_t message_size)
 {
     DLOG(INFO) << "Start decoding of a HAS message";
-    constexpr int32_t max_erasure_positions = GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK - GALILEO_CNAV_INFORMATION_VECTOR_LENGTH;  // 223 Maximum erasure positions ( = number of parity symbols in a block)
 
-    // Compute erasure positions
-    std::vector<int> erasure_positions;
-    erasure_positions.reserve(max_erasure_positions);
-
-    for (uint8_t i = 1; i < message_size + 1; i++)  // we know that from message_size to 32, the value is 0
+    // The pages received so far, in PID order, identify the erasure pattern.
+    // Messages are repeated with the same pages, so the matrix that decodes
+    // a pattern is computed once and kept.
+    std::vector<uint8_t>& pids = d_received_pids[message_id];
+    std::sort(pids.begin(), pids.end());
+    auto it = d_decoding_matrices.find(pids);
+    if (it == d_decoding_matrices.end())
         {
-            if (std::find(d_received_pids[message_id].begin(), d_received_pids[message_id].end(), i) == d_received_pids[message_id].end())
+            std::vector<int> received_positions(pids.begin(), pids.end());
+            for (auto& position : received_positions)
                 {
-                    erasure_positions.push_back(i - 1);
+                    position--;
                 }
-        }
-    for (int i = GALILEO_CNAV_INFORMATION_VECTOR_LENGTH + 1; i < GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK + 1; i++)  // from 33 to 255
-        {
-            if (std::find(d_received_pids[message_id].begin(), d_received_pids[message_id].end(), static_cast<uint8_t>(i)) == d_received_pids[message_id].end())
+            std::vector<uint8_t> decoding_matrix;
+            if (!d_rs->get_erasure_decoding_matrix(received_positions, decoding_matrix))
                 {
-                    erasure_positions.push_back(i - 1);
+                    // This should not happen! Maybe message_size < PID < 33 ?
+                    std::string msg("Reed Solomon decoding of HAS message is not possible. Received PIDs:");
+                    std::stringstream ss;
+                    for (auto pid : pids)
+                        {
+                            ss << " " << static_cast<float>(pid);
+                        }
+                    ss << ", Message size: " << static_cast<float>(message_size) << "  Message ID: " << static_cast<float>(message_id);
+                    msg += ss.str();
+                    LOG(ERROR) << msg;
+                    pids.clear();
+                    return -1;
                 }
-        }
-
-    if (erasure_positions.size() > static_cast<size_t>(max_erasure_positions))
-        {
-            // This should not happen! Maybe message_size < PID < 33 ?
-            // Don't even try to decode
-            std::string msg("Reed Solomon decoding of HAS message is not possible. Received PIDs:");
-            std::stringstream ss;
-            for (auto pid : d_received_pids[message_id])
+            if (d_decoding_matrices.size() >= HAS_DECODING_MATRICES_CACHE_SIZE)
                 {
-                    ss << " " << static_cast<float>(pid);
+                    d_decoding_matrices.clear();
                 }
-            ss << ", Message size: " << static_cast<float>(message_size) << "  Message ID: " << static_cast<float>(message_id);
-            msg += ss.str();
-            LOG(ERROR) << msg;
-            d_received_pids[message_id].clear();
-            d_C_matrix[message_id] = {GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)};
-            return -1;
+            it = d_decoding_matrices.emplace(pids, std::move(decoding_matrix)).first;
         }
 
-    DLOG(INFO) << debug_print_vector("List of received PIDs", d_received_pids[message_id]);
-    DLOG(INFO) << debug_print_vector("erasure_positions", erasure_positions);
+    DLOG(INFO) << debug_print_vector("List of received PIDs", pids);
     DLOG(INFO) << debug_print_matrix("C_matrix", d_C_matrix[message_id]);
 
-    // Reset HAS decoded message matrix
-    d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
-
-    // Vertical decoding of d_C_matrix
-    for (int col = 0; col < GALILEO_CNAV_OCTETS_IN_SUBPAGE; col++)
+    // All the columns of d_C_matrix share the erasure pattern, so they are
+    // decoded at once by the same matrix product
+    d_received_rows.clear();
+    for (auto pid : pids)
         {
-            std::vector<uint8_t> C_column(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK);
-            for (auto pid : d_received_pids[message_id])
-                {
-                    C_column[pid - 1] = d_C_matrix[message_id][pid - 1][col];
-                }
-
-            int result = d_rs->decode(C_column, erasure_positions);
-
-            if (result < 0)
-                {
-                    DLOG(ERROR) << "Decoding of HAS page failed";
-                    return -1;
-                }
-
-            std::vector<uint8_t> M_column(C_column.begin(), C_column.begin() + GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
-            for (int i = 0; i < GALILEO_CNAV_INFORMATION_VECTOR_LENGTH; i++)
-                {
-                    d_M_matrix[i][col] = M_column[i];
-                }
-
-            DLOG(INFO) << debug_print_vector("C_column entering the decoder", C_column);
-            DLOG(INFO) << "Successful HAS page decoding";
+            d_received_rows.push_back(d_C_matrix[message_id][pid - 1].data());
         }
+    d_rs->decode_with_erasure_matrix(it->second, d_received_rows, GALILEO_CNAV_OCTETS_IN_SUBPAGE, d_M_matrix);
+    DLOG(INFO) << "Successful HAS page decoding";
 
     DLOG(INFO) << debug_print_matrix("M_matrix", d_M_matrix);
 
@@ -299,8 +284,8 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
             this->message_port_pub(pmt::mp("Nav_msg_from_TLM"), pmt::make_any(tmp_obj));
         }
 
-    // reset data for next decoding
-    d_C_matrix[message_id] = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
+    // reset data for next decoding. Only the rows of the received PIDs are
+    // read, so d_C_matrix does not need to be cleared.
     d_received_pids[message_id].clear();
 
     // Trigger HAS message content reading and fill the d_HAS_data object
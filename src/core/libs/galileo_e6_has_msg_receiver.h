@@ -27,7 +27,9 @@
 #include <gnuradio/block.h>        // for gr::block
 #include <pmt/pmt.h>               // for pmt::pmt_t
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>  // for std::unique_ptr
 #include <string>
 #include <utility>  // std::pair
@@ -92,6 +94,11 @@ private:
     std::vector<std::vector<std::vector<uint8_t>>> d_C_matrix;
     std::vector<std::vector<uint8_t>> d_M_matrix;
     std::vector<std::vector<uint8_t>> d_received_pids;
+    std::vector<const uint8_t*> d_received_rows;
+
+    // Decoding matrices of the erasure patterns seen so far, by sorted PIDs
+    static constexpr size_t HAS_DECODING_MATRICES_CACHE_SIZE = 256;
+    std::map<std::vector<uint8_t>, std::vector<uint8_t>> d_decoding_matrices;
 
     // Store masks
     std::vector<int> d_nsat_in_mask_id;
@@ -0,0 +1,94 @@
+/*!
+ * \file gnss_sdr_acquisition_record.cc
+ * \brief Record of the acquisitions that start the tracking of the channels,
+ * for the replay of the tracking stage
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_acquisition_record.h"
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+#include <glog/logging.h>
+#include <exception>
+#include <fstream>
+#include <utility>
+
+
+Gnss_Sdr_Acquisition_Record::Gnss_Sdr_Acquisition_Record(std::string filename)
+    : filename_(std::move(filename))
+{
+}
+
+
+Gnss_Sdr_Acquisition_Record::~Gnss_Sdr_Acquisition_Record()
+{
+    save();
+}
+
+
+void Gnss_Sdr_Acquisition_Record::add(const Gnss_Synchro& acquisition)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    acquisitions_.push_back(acquisition);
+}
+
+
+size_t Gnss_Sdr_Acquisition_Record::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return acquisitions_.size();
+}
+
+
+bool Gnss_Sdr_Acquisition_Record::save() const
+{
+    std::vector<Gnss_Synchro> acquisitions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        acquisitions = acquisitions_;
+    }
+    std::ofstream ofs;
+    try
+        {
+            ofs.open(filename_.c_str(), std::ofstream::trunc | std::ofstream::out);
+            boost::archive::xml_oarchive xml(ofs);
+            xml << boost::serialization::make_nvp("GNSS-SDR_acquisitions", acquisitions);
+            LOG(INFO) << "Saved " << acquisitions.size() << " acquisitions to " << filename_;
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Could not save the acquisitions to " << filename_ << ": " << e.what();
+            return false;
+        }
+    return true;
+}
+
+
+bool Gnss_Sdr_Acquisition_Record::load(const std::string& filename, std::vector<Gnss_Synchro>& acquisitions)
+{
+    std::ifstream ifs;
+    try
+        {
+            ifs.open(filename.c_str(), std::ifstream::binary | std::ifstream::in);
+            boost::archive::xml_iarchive xml(ifs);
+            acquisitions.clear();
+            xml >> boost::serialization::make_nvp("GNSS-SDR_acquisitions", acquisitions);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << e.what() << " File: " << filename;
+            return false;
+        }
+    return true;
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file gnss_sdr_acquisition_record.h
+ * \brief Record of the acquisitions that start the tracking of the channels,
+ * for the replay of the tracking stage
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_ACQUISITION_RECORD_H
+#define GNSS_SDR_GNSS_SDR_ACQUISITION_RECORD_H
+
+#include "gnss_synchro.h"
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief Keeps a copy of the Gnss_Synchro of every positive acquisition
+ * that starts a tracking, and saves them as an XML archive.
+ *
+ * Together with the samples at the input of the tracking blocks, they are
+ * all that is needed to run the tracking of the channels again, without
+ * the rest of the receiver. add() is called from the channel state machines,
+ * so it only takes a copy; the file is written by save() and at destruction.
+ */
+class Gnss_Sdr_Acquisition_Record
+{
+public:
+    explicit Gnss_Sdr_Acquisition_Record(std::string filename);
+    ~Gnss_Sdr_Acquisition_Record();
+
+    void add(const Gnss_Synchro& acquisition);
+
+    bool save() const;
+
+    size_t size() const;
+
+    /*!
+     * \brief Reads the acquisitions saved by save()
+     */
+    static bool load(const std::string& filename, std::vector<Gnss_Synchro>& acquisitions);
+
+private:
+    std::string filename_;
+    std::vector<Gnss_Synchro> acquisitions_;
+    mutable std::mutex mutex_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_ACQUISITION_RECORD_H
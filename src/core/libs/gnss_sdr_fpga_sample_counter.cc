@@ -50,26 +50,17 @@ gnss_sdr_fpga_sample_counter::gnss_sdr_fpga_sample_counter(
     : gr::block("fpga_fpga_sample_counter",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+      receiver_clock(std::make_shared<Gnss_Sdr_Receiver_Clock>(_fs)),
       fs(_fs),
       sample_counter(0ULL),
-      last_sample_counter(0ULL),
       current_T_rx_ms(0),
       interval_ms(_interval_ms),
-      current_s(0),
-      current_m(0),
-      current_h(0),
-      current_days(0),
-      report_interval_ms(1000),     // default reporting 1 second
       flag_enable_send_msg(false),  // enable it for reporting time with asynchronous message
-      flag_m(false),
-      flag_h(false),
-      flag_days(false),
       is_open(true)
 {
     message_port_register_out(pmt::mp("fpga_sample_counter"));
     set_max_noutput_items(1);
     samples_per_output = std::round(fs * static_cast<double>(interval_ms) / 1e3);
-    samples_per_report = std::round(fs * static_cast<double>(report_interval_ms) / 1e3);
     open_device();
 }
 
@@ -206,68 +197,12 @@ int gnss_sdr_fpga_sample_counter::general_work(int noutput_items __attribute__((
     out[0].Channel_ID = -1;
     out[0].fs = fs;
 
-    if ((sample_counter - last_sample_counter) > samples_per_report)
-        {
-            last_sample_counter = sample_counter;
-
-            current_s++;
-            if ((current_s % 60) == 0)
-                {
-                    current_s = 0;
-                    current_m++;
-                    flag_m = true;
-                    if ((current_m % 60) == 0)
-                        {
-                            current_m = 0;
-                            current_h++;
-                            flag_h = true;
-                            if ((current_h % 24) == 0)
-                                {
-                                    current_h = 0;
-                                    current_days++;
-                                    flag_days = true;
-                                }
-                        }
-                }
-
-            if (flag_days)
-                {
-                    std::string day;
-                    if (current_days == 1)
-                        {
-                            day = " day ";
-                        }
-                    else
-                        {
-                            day = " days ";
-                        }
-                    std::cout << "Current receiver time: " << current_days << day << current_h << " h " << current_m << " min " << current_s << " s\n";
-                }
-            else
-                {
-                    if (flag_h)
-                        {
-                            std::cout << "Current receiver time: " << current_h << " h " << current_m << " min " << current_s << " s\n";
-                        }
-                    else
-                        {
-                            if (flag_m)
-                                {
-                                    std::cout << "Current receiver time: " << current_m << " min " << current_s << " s\n";
-                                }
-                            else
-                                {
-                                    std::cout << "Current receiver time: " << current_s << " s\n";
-                                }
-                        }
-                }
-            if (flag_enable_send_msg)
-                {
-                    message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
-                }
-        }
     out[0].Tracking_sample_counter = sample_counter;
     current_T_rx_ms = interval_ms * (sample_counter) / samples_per_output;
+    if (receiver_clock->publish_epoch(sample_counter) and flag_enable_send_msg)
+        {
+            message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
+        }
     return 1;
 }
 
@@ -20,9 +20,11 @@
 #define GNSS_SDR_GNSS_SDR_FPGA_SAMPLE_COUNTER_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_receiver_clock.h"
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
+#include <memory>
 #include <string>
 
 /** \addtogroup Core
@@ -46,6 +48,15 @@ public:
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
+    /*!
+     * \brief Clock published at each output with the sample counter of the
+     * FPGA. Safe to read from any thread.
+     */
+    std::shared_ptr<const Gnss_Sdr_Receiver_Clock> get_receiver_clock() const
+    {
+        return receiver_clock;
+    }
+
 private:
     const std::string device_name = "counter";  // UIO device name
 
@@ -62,27 +73,18 @@ private:
     bool stop();
     void wait_for_interrupt(void) const;
 
+    std::shared_ptr<Gnss_Sdr_Receiver_Clock> receiver_clock;
     volatile uint32_t *map_base;  // driver memory map
 
     double fs;
     uint64_t sample_counter;
-    uint64_t last_sample_counter;
     uint64_t current_T_rx_ms;  // Receiver time in ms since the beginning of the run
 
     uint32_t samples_per_output;
-    uint32_t samples_per_report;
     uint32_t interval_ms;
-    uint32_t current_s;     // Receiver time in seconds, modulo 60
-    uint32_t current_m;     // Receiver time in minutes, modulo 60
-    uint32_t current_h;     // Receiver time in hours, modulo 24
-    uint32_t current_days;  // Receiver time in days since the beginning of the run
-    int32_t report_interval_ms;
     int32_t fd;  // driver descriptor
 
     bool flag_enable_send_msg;
-    bool flag_m;     // True if the receiver has been running for at least 1 minute
-    bool flag_h;     // True if the receiver has been running for at least 1 hour
-    bool flag_days;  // True if the receiver has been running for at least 1 day
     bool is_open;
 };
 
@@ -0,0 +1,73 @@
+/*!
+ * \file gnss_sdr_receiver_clock.cc
+ * \brief Receiver clock shared by the blocks of a receiver, kept by the
+ * sample counter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_receiver_clock.h"
+#include <algorithm>  // for max
+#include <cmath>      // for round
+#include <iostream>   // for cout
+#include <sstream>    // for stringstream
+
+
+Gnss_Sdr_Receiver_Clock::Gnss_Sdr_Receiver_Clock(double fs, int32_t report_interval_ms)
+    : d_fs(fs),
+      d_samples_per_report(std::max<uint64_t>(1, static_cast<uint64_t>(std::round(fs * static_cast<double>(report_interval_ms) / 1e3))))
+{
+}
+
+
+bool Gnss_Sdr_Receiver_Clock::publish_epoch(uint64_t sample_counter)
+{
+    d_sample_counter.store(sample_counter, std::memory_order_relaxed);
+    d_epochs.fetch_add(1, std::memory_order_relaxed);
+    if (sample_counter < d_next_report)
+        {
+            return false;
+        }
+    // the first epoch is reported as second 1, and a gap in the input
+    // samples skips the seconds it lasted
+    const uint64_t seconds = sample_counter / d_samples_per_report + 1;
+    d_next_report = seconds * d_samples_per_report;
+    std::cout << receiver_time_message(seconds) << '\n';
+    return true;
+}
+
+
+std::string Gnss_Sdr_Receiver_Clock::receiver_time_message(uint64_t seconds)
+{
+    const uint64_t days = seconds / 86400;
+    const uint64_t h = (seconds / 3600) % 24;
+    const uint64_t m = (seconds / 60) % 60;
+    const uint64_t s = seconds % 60;
+    std::stringstream msg;
+    msg << "Current receiver time: ";
+    if (days > 0)
+        {
+            msg << days << (days == 1 ? " day " : " days ") << h << " h " << m << " min " << s << " s";
+        }
+    else if (seconds >= 3600)
+        {
+            msg << h << " h " << m << " min " << s << " s";
+        }
+    else if (seconds >= 60)
+        {
+            msg << m << " min " << s << " s";
+        }
+    else
+        {
+            msg << s << " s";
+        }
+    return msg.str();
+}
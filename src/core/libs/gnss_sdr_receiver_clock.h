@@ -0,0 +1,73 @@
+/*!
+ * \file gnss_sdr_receiver_clock.h
+ * \brief Receiver clock shared by the blocks of a receiver, kept by the
+ * sample counter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_RECEIVER_CLOCK_H
+#define GNSS_SDR_GNSS_SDR_RECEIVER_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief Samples counted at the last observables epoch, and number of
+ * epochs, published by the block that counts them (the sample counter, or
+ * the FPGA sample counter) and read from any thread with an atomic load.
+ * It also prints the receiver time once per report interval.
+ */
+class Gnss_Sdr_Receiver_Clock
+{
+public:
+    explicit Gnss_Sdr_Receiver_Clock(double fs, int32_t report_interval_ms = 1000);
+
+    /*!
+     * \brief Publishes the sample counter of a new epoch. Only called by
+     * the block that keeps the clock. Returns true if the receiver time was
+     * printed.
+     */
+    bool publish_epoch(uint64_t sample_counter);
+
+    //! Samples counted at the last epoch, including the ones lost by the source
+    uint64_t sample_counter() const { return d_sample_counter.load(std::memory_order_relaxed); }
+
+    //! Epochs published so far
+    uint64_t epochs() const { return d_epochs.load(std::memory_order_relaxed); }
+
+    double fs() const { return d_fs; }
+
+    /*!
+     * \brief "Current receiver time: " message of seconds, with the days,
+     * hours and minutes once reached
+     */
+    static std::string receiver_time_message(uint64_t seconds);
+
+private:
+    double d_fs;
+    uint64_t d_samples_per_report;
+    uint64_t d_next_report{0};  // sample counter of the next report
+    std::atomic<uint64_t> d_sample_counter{0};
+    std::atomic<uint64_t> d_epochs{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_RECEIVER_CLOCK_H
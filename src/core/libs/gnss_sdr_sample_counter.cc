@@ -16,6 +16,7 @@
  */
 
 #include "gnss_sdr_sample_counter.h"
+#include "gnss_sdr_sample_gap.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
 #include <gnuradio/io_signature.h>
@@ -24,7 +25,6 @@
 #include <cmath>            // for round
 #include <iostream>         // for operator<<
 #include <memory>
-#include <string>  // for string
 #include <vector>
 
 
@@ -36,19 +36,14 @@ gnss_sdr_sample_counter::gnss_sdr_sample_counter(
           gr::io_signature::make(1, 1, _size),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
           static_cast<uint32_t>(std::round(_fs * static_cast<double>(_interval_ms) / 1e3))),
+      receiver_clock(std::make_shared<Gnss_Sdr_Receiver_Clock>(_fs)),
+      time_map(std::make_shared<Gnss_Time_Map>()),
       fs(_fs),
       current_T_rx_ms(0),
       sample_counter(0),
+      pending_gap_samples(0),
       interval_ms(_interval_ms),
-      report_interval_ms(1000),  // default reporting 1 second
       samples_per_output(std::round(fs * static_cast<double>(interval_ms) / 1e3)),
-      current_s(0),
-      current_m(0),
-      current_h(0),
-      current_days(0),
-      flag_m(false),
-      flag_h(false),
-      flag_days(false),
       flag_enable_send_msg(false)  // enable it for reporting time with asynchronous message
 {
     message_port_register_out(pmt::mp("sample_counter"));
@@ -82,74 +77,36 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
     out[0].Flag_valid_word = false;
     out[0].Channel_ID = -1;
     out[0].fs = fs;
-    if ((current_T_rx_ms % report_interval_ms) == 0)
+    // notice that nitems_read is updated in decimation blocks after leaving work() with return 1, equivalent to call consume_each
+    // a single search for the sample gaps and the time tags of the input
+    std::vector<gr::tag_t> tags_vec;
+    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + samples_per_output);
+    pending_gap_samples += static_cast<int64_t>(sample_gap_total(tags_vec));
+    if (pending_gap_samples != 0)
         {
-            current_s++;
-            if ((current_s % 60) == 0)
-                {
-                    current_s = 0;
-                    current_m++;
-                    flag_m = true;
-                    if ((current_m % 60) == 0)
-                        {
-                            current_m = 0;
-                            current_h++;
-                            flag_h = true;
-                            if ((current_h % 24) == 0)
-                                {
-                                    current_h = 0;
-                                    current_days++;
-                                    flag_days = true;
-                                }
-                        }
-                }
-
-            if (flag_days)
-                {
-                    std::string day;
-                    if (current_days == 1)
-                        {
-                            day = " day ";
-                        }
-                    else
-                        {
-                            day = " days ";
-                        }
-                    std::cout << "Current receiver time: " << current_days << day << current_h << " h " << current_m << " min " << current_s << " s\n";
-                }
-            else
-                {
-                    if (flag_h)
-                        {
-                            std::cout << "Current receiver time: " << current_h << " h " << current_m << " min " << current_s << " s\n";
-                        }
-                    else
-                        {
-                            if (flag_m)
-                                {
-                                    std::cout << "Current receiver time: " << current_m << " min " << current_s << " s\n";
-                                }
-                            else
-                                {
-                                    std::cout << "Current receiver time: " << current_s << " s\n";
-                                }
-                        }
-                }
-            if (flag_enable_send_msg)
-                {
-                    message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
-                }
+            // The samples lost by the signal source are counted as elapsed
+            // time in whole output intervals, so that the receiver clock
+            // stays on its grid. The remainder is kept for later gaps.
+            const int64_t gap_outputs = (pending_gap_samples + samples_per_output / 2) / samples_per_output;
+            sample_counter += static_cast<uint64_t>(gap_outputs) * samples_per_output;
+            pending_gap_samples -= gap_outputs * samples_per_output;
         }
     sample_counter += samples_per_output;
     out[0].Tracking_sample_counter = sample_counter;
     current_T_rx_ms += interval_ms;
+    if (receiver_clock->publish_epoch(sample_counter) and flag_enable_send_msg)
+        {
+            message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
+        }
 
     //**************** time tags ****************
-    std::vector<gr::tag_t> tags_vec;
-    // notice that nitems_read is updated in decimation blocks after leaving work() with return 1, equivalent to call consume_each
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + samples_per_output);
+    const pmt::pmt_t timetag_key = pmt::mp("timetag");
     for (const auto &it : tags_vec)
         {
+            if (!pmt::eqv(it.key, timetag_key))
+                {
+                    continue;
+                }
             try
                 {
                     if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
@@ -157,6 +114,13 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
                             // recompute timestamp to match the last sample in the consumed samples in this batch
                             int64_t diff_samplecount = uint64diff(out[0].Tracking_sample_counter, it.offset);
                             const auto last_timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
+                            // published before the tag value is adjusted below
+                            Gnss_Time_Map::Segment segment;
+                            segment.first_sample = it.offset;
+                            segment.tow_ms = static_cast<double>(last_timetag->tow_ms) + last_timetag->tow_ms_fraction;
+                            segment.ms_per_sample = 1000.0 / fs;
+                            segment.week = last_timetag->week;
+                            time_map->publish(segment);
                             double intpart;
                             last_timetag->tow_ms_fraction += modf(1000.0 * static_cast<double>(diff_samplecount) / fs, &intpart);
 
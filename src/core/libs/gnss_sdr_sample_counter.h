@@ -19,10 +19,13 @@
 #define GNSS_SDR_GNSS_SDR_SAMPLE_COUNTER_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_receiver_clock.h"
+#include "gnss_sdr_time_map.h"
 #include <gnuradio/sync_decimator.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstddef>           // for size_t
 #include <cstdint>
+#include <memory>            // for shared_ptr
 
 /** \addtogroup Core
  * \{ */
@@ -48,6 +51,25 @@ public:
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
+    /*!
+     * \brief Clock published at each output: samples counted so far,
+     * including the ones lost by the source. Safe to read from any thread.
+     */
+    std::shared_ptr<const Gnss_Sdr_Receiver_Clock> get_receiver_clock() const
+    {
+        return receiver_clock;
+    }
+
+    /*!
+     * \brief Time of the signal source as a function of the input sample
+     * number, updated at each time tag of the input. It is valid for the
+     * streams of all the channels, which share the sample numbering.
+     */
+    std::shared_ptr<const Gnss_Time_Map> get_time_map() const
+    {
+        return time_map;
+    }
+
 private:
     friend gnss_sdr_sample_counter_sptr gnss_sdr_make_sample_counter(
         double _fs,
@@ -60,19 +82,15 @@ private:
 
     int64_t uint64diff(uint64_t first, uint64_t second);
 
+    std::shared_ptr<Gnss_Sdr_Receiver_Clock> receiver_clock;
+    std::shared_ptr<Gnss_Time_Map> time_map;
+
     double fs;
     int64_t current_T_rx_ms;  // Receiver time in ms since the beginning of the run
     uint64_t sample_counter;
+    int64_t pending_gap_samples;  // Samples lost by the source not yet added to sample_counter
     int32_t interval_ms;
-    int32_t report_interval_ms;
     uint32_t samples_per_output;
-    uint32_t current_s;     // Receiver time in seconds, modulo 60
-    uint32_t current_m;     // Receiver time in minutes, modulo 60
-    uint32_t current_h;     // Receiver time in hours, modulo 24
-    uint32_t current_days;  // Receiver time in days since the beginning of the run
-    bool flag_m;            // True if the receiver has been running for at least 1 minute
-    bool flag_h;            // True if the receiver has been running for at least 1 hour
-    bool flag_days;         // True if the receiver has been running for at least 1 day
     bool flag_enable_send_msg;
 };
 
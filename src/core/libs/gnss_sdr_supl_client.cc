@@ -20,12 +20,14 @@
 #include "gnss_sdr_supl_client.h"
 #include "GPS_L1_CA.h"
 #include "MATH_CONSTANTS.h"
+#include "agnss_assistance_data.h"
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/serialization/map.hpp>
 #include <glog/logging.h>
 #include <pugixml.hpp>
 #include <cmath>      // for pow
+#include <ctime>      // for time
 #include <exception>  // for exception
 #include <iostream>   // for cerr
 #include <utility>    // for pair
@@ -1012,6 +1014,51 @@ bool Gnss_Sdr_Supl_Client::save_ref_time_xml(const std::string& file_name, Agnss
 }
 
 
+bool Gnss_Sdr_Supl_Client::save_assistance_cache(const std::string& file_name) const
+{
+    if (gps_ephemeris_map.empty() and gps_almanac_map.empty() and !gps_ref_loc.valid)
+        {
+            LOG(WARNING) << "Failed to save the assistance cache, there is no assistance data";
+            return false;
+        }
+    Agnss_Assistance_Data cache;
+    cache.gps_ephemeris_map = gps_ephemeris_map;
+    cache.gps_almanac_map = gps_almanac_map;
+    cache.gps_iono = gps_iono;
+    cache.gps_utc = gps_utc;
+    cache.ref_location = gps_ref_loc;
+    if (!cache.save(file_name))
+        {
+            return false;
+        }
+    LOG(INFO) << "Saved the assistance cache with " << gps_ephemeris_map.size() << " ephemeris";
+    return true;
+}
+
+
+bool Gnss_Sdr_Supl_Client::load_assistance_cache(const std::string& file_name, int64_t max_age_s)
+{
+    Agnss_Assistance_Data cache;
+    if (!cache.load(file_name))
+        {
+            return false;
+        }
+    const int64_t age_s = static_cast<int64_t>(std::time(nullptr)) - cache.creation_time;
+    if (age_s < 0 or age_s > max_age_s)
+        {
+            LOG(INFO) << "Assistance cache " << file_name << " expired";
+            return false;
+        }
+    gps_ephemeris_map = std::move(cache.gps_ephemeris_map);
+    gps_almanac_map = std::move(cache.gps_almanac_map);
+    gps_iono = cache.gps_iono;
+    gps_utc = cache.gps_utc;
+    gps_ref_loc = cache.ref_location;
+    LOG(INFO) << "Loaded the assistance cache saved " << age_s << " s ago, with " << gps_ephemeris_map.size() << " ephemeris";
+    return true;
+}
+
+
 bool Gnss_Sdr_Supl_Client::load_ref_location_xml(const std::string& file_name)
 {
     std::ifstream ifs;
@@ -39,6 +39,7 @@ extern "C"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
+#include <cstdint>
 #include <fstream>
 #include <map>
 #include <string>
@@ -249,6 +250,19 @@ public:
     bool save_ref_location_xml(const std::string& file_name,
         Agnss_Ref_Location& ref_location);
 
+    /*!
+     * \brief Saves the GPS ephemeris and almanac maps, the ionospheric and
+     * UTC models and the reference location to a binary cache file, stamped
+     * with the current time
+     */
+    bool save_assistance_cache(const std::string& file_name) const;
+
+    /*!
+     * \brief Loads the data saved by save_assistance_cache, if the file was
+     * saved less than max_age_s seconds ago
+     */
+    bool load_assistance_cache(const std::string& file_name, int64_t max_age_s);
+
     /*
      * Prints SUPL data to std::cout. Use it for debug purposes only.
      */
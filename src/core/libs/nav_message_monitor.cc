@@ -19,8 +19,10 @@
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
-#include <cstddef>   // size_t
-#include <typeinfo>  // typeid
+#include <algorithm>  // std::min
+#include <cstddef>    // size_t
+#include <cstring>    // std::memcpy
+#include <typeinfo>   // typeid
 
 #if HAS_GENERIC_LAMBDA
 #else
@@ -35,13 +37,13 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
-nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port)
+nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name)
 {
-    return nav_message_monitor_sptr(new nav_message_monitor(addresses, port));
+    return nav_message_monitor_sptr(new nav_message_monitor(addresses, port, shm_name));
 }
 
 
-nav_message_monitor::nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port) : gr::block("nav_message_monitor", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+nav_message_monitor::nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name) : gr::block("nav_message_monitor", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
 {
     // register Nav_msg_from_TLM input message port from telemetry blocks
     this->message_port_register_in(pmt::mp("Nav_msg_from_TLM"));
@@ -55,7 +57,14 @@ nav_message_monitor::nav_message_monitor(const std::vector<std::string>& address
         boost::bind(&nav_message_monitor::msg_handler_nav_message, this, _1));
 #endif
 #endif
-    nav_message_udp_sink_ = std::make_unique<Nav_Message_Udp_Sink>(addresses, port);
+    if (shm_name.empty())
+        {
+            nav_message_udp_sink_ = std::make_unique<Nav_Message_Udp_Sink>(addresses, port);
+        }
+    else
+        {
+            ring_ = std::make_unique<Gnss_Monitor_Ring_Writer>(shm_name, GNSS_SDR_MONITOR_RECORD_NAV_MESSAGE, sizeof(gnss_sdr_nav_message_record));
+        }
 }
 
 
@@ -69,7 +78,14 @@ void nav_message_monitor::msg_handler_nav_message(const pmt::pmt_t& msg)
             if (msg_type_hash_code == typeid(std::shared_ptr<Nav_Message_Packet>).hash_code())
                 {
                     const auto nav_message_packet = wht::any_cast<std::shared_ptr<Nav_Message_Packet>>(pmt::any_ref(msg));
-                    nav_message_udp_sink_->write_nav_message(nav_message_packet);
+                    if (ring_)
+                        {
+                            publish_nav_message(*nav_message_packet);
+                        }
+                    else
+                        {
+                            nav_message_udp_sink_->write_nav_message(nav_message_packet);
+                        }
                 }
             else
                 {
@@ -81,3 +97,17 @@ void nav_message_monitor::msg_handler_nav_message(const pmt::pmt_t& msg)
             LOG(WARNING) << "nav_message_monitor Bad any_cast: " << e.what();
         }
 }
+
+
+void nav_message_monitor::publish_nav_message(const Nav_Message_Packet& packet)
+{
+    record_.system = packet.system.empty() ? '\0' : packet.system[0];
+    const size_t signal_length = std::min<size_t>(packet.signal.size(), sizeof(record_.signal) - 1);
+    std::memcpy(record_.signal, packet.signal.data(), signal_length);
+    record_.signal[signal_length] = '\0';
+    record_.prn = packet.prn;
+    record_.tow_at_current_symbol_ms = packet.tow_at_current_symbol_ms;
+    record_.length = static_cast<uint32_t>(std::min<size_t>(packet.nav_message.size(), GNSS_SDR_NAV_MESSAGE_RECORD_MAX_LENGTH));
+    std::memcpy(record_.nav_message, packet.nav_message.data(), record_.length);
+    ring_->publish(&record_);
+}
@@ -19,6 +19,7 @@
 #define GNSS_SDR_NAV_MESSAGE_MONITOR_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sdr_monitor_ring_writer.h"
 #include "nav_message_udp_sink.h"
 #include <gnuradio/block.h>
 #include <pmt/pmt.h>
@@ -36,11 +37,13 @@ class nav_message_monitor;
 
 using nav_message_monitor_sptr = gnss_shared_ptr<nav_message_monitor>;
 
-nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port);
+nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name = std::string());
 
 /*!
  * \brief GNU Radio block that receives asynchronous Nav_Message_Packet obkects
- * from the telemetry blocks and sends them via UDP
+ * from the telemetry blocks and sends them via UDP, or publishes them as
+ * gnss_sdr_nav_message_record objects in a ring in shared memory if a
+ * shm_name is given.
  */
 class nav_message_monitor : public gr::block
 {
@@ -48,10 +51,13 @@ public:
     ~nav_message_monitor() = default;  //!< Default destructor
 
 private:
-    friend nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port);
-    nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port);
+    friend nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name);
+    nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name);
     void msg_handler_nav_message(const pmt::pmt_t& msg);
+    void publish_nav_message(const Nav_Message_Packet& packet);
     std::unique_ptr<Nav_Message_Udp_Sink> nav_message_udp_sink_;
+    std::unique_ptr<Gnss_Monitor_Ring_Writer> ring_;
+    gnss_sdr_nav_message_record record_{};
 };
 
 
@@ -0,0 +1,215 @@
+/*!
+ * \file sample_stream_udp_sink.cc
+ * \brief GNU Radio block that streams the outputs of the signal conditioners
+ * to other receivers over UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_stream_udp_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+template <typename T>
+T quantize(float x, float lo, float hi)
+{
+    return static_cast<T>(std::lround(std::min(std::max(x, lo), hi)));
+}
+
+
+// Level 2 * v + 1 nearest to x, as a two's complement nibble
+uint8_t nibble(float x)
+{
+    const float v = std::min(std::max(std::floor(x * 0.5F), -8.0F), 7.0F);
+    return static_cast<uint8_t>(static_cast<int>(v) & 0x0F);
+}
+}  // namespace
+
+
+sample_stream_udp_sink_sptr sample_stream_udp_sink_make(int n_inputs,
+    const Sample_Stream_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port)
+{
+    return sample_stream_udp_sink_sptr(new sample_stream_udp_sink(n_inputs, conf, addresses, port));
+}
+
+
+sample_stream_udp_sink::sample_stream_udp_sink(int n_inputs,
+    const Sample_Stream_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port)
+    : gr::sync_block("sample_stream_udp_sink",
+          gr::io_signature::make(n_inputs, n_inputs, sizeof(gr_complex)),
+          gr::io_signature::make(0, 0, 0)),
+      d_socket{d_io_context},
+      d_in(n_inputs),
+      d_scale(conf.scale),
+      d_format(Wire_Format::C4bits),
+      d_n_inputs(n_inputs)
+{
+    if (conf.sample_type == "cbyte")
+        {
+            d_format = Wire_Format::Cbyte;
+        }
+    else if (conf.sample_type == "ishort")
+        {
+            d_format = Wire_Format::Ishort;
+        }
+    else if (conf.sample_type == "cfloat")
+        {
+            d_format = Wire_Format::Cfloat;
+        }
+    else if (conf.sample_type != "c4bits")
+        {
+            LOG(WARNING) << "Unknown SampleStream.sample_type " << conf.sample_type << ", using c4bits";
+        }
+    const size_t sample_bytes = bytes_per_sample(d_format) * static_cast<size_t>(n_inputs);
+    d_samples_per_packet = std::max(1, conf.payload_bytes / static_cast<int>(sample_bytes));
+    d_packet.resize(static_cast<size_t>(d_samples_per_packet) * sample_bytes);
+
+    boost::system::error_code error;
+    d_socket.open(boost::asio::ip::udp::v4(), error);
+    if (error)
+        {
+            LOG(ERROR) << "Cannot open the socket of the sample stream: " << error.message();
+        }
+    for (const auto& address : addresses)
+        {
+            const auto ip = boost::asio::ip::address::from_string(address, error);
+            if (error)
+                {
+                    LOG(WARNING) << "Invalid address " << address << " of the sample stream";
+                    continue;
+                }
+            d_endpoints.emplace_back(ip, port);
+        }
+    LOG(INFO) << "Streaming " << n_inputs << " bands as " << conf.sample_type << " to "
+              << d_endpoints.size() << " nodes, " << d_samples_per_packet << " samples per packet";
+}
+
+
+size_t sample_stream_udp_sink::bytes_per_sample(Wire_Format format)
+{
+    switch (format)
+        {
+        case Wire_Format::C4bits:
+            return 1;
+        case Wire_Format::Cbyte:
+            return 2;
+        case Wire_Format::Ishort:
+            return 2 * sizeof(int16_t);
+        case Wire_Format::Cfloat:
+        default:
+            return 2 * sizeof(float);
+        }
+}
+
+
+size_t sample_stream_udp_sink::pack(const std::vector<const gr_complex*>& in, size_t first, size_t n,
+    Wire_Format format, float scale, uint8_t* out)
+{
+    uint8_t* const start = out;
+    for (size_t i = first; i < first + n; i++)
+        {
+            for (const gr_complex* channel : in)
+                {
+                    const float re = channel[i].real() * scale;
+                    const float im = channel[i].imag() * scale;
+                    switch (format)
+                        {
+                        case Wire_Format::C4bits:
+                            *out++ = static_cast<uint8_t>(nibble(re) | (nibble(im) << 4));
+                            break;
+                        case Wire_Format::Cbyte:
+                            *out++ = static_cast<uint8_t>(quantize<int8_t>(im, -128.0F, 127.0F));
+                            *out++ = static_cast<uint8_t>(quantize<int8_t>(re, -128.0F, 127.0F));
+                            break;
+                        case Wire_Format::Ishort:
+                            {
+                                const int16_t iq[2] = {quantize<int16_t>(im, -32768.0F, 32767.0F), quantize<int16_t>(re, -32768.0F, 32767.0F)};
+                                std::memcpy(out, iq, sizeof(iq));
+                                out += sizeof(iq);
+                                break;
+                            }
+                        case Wire_Format::Cfloat:
+                        default:
+                            {
+                                const float iq[2] = {im, re};
+                                std::memcpy(out, iq, sizeof(iq));
+                                out += sizeof(iq);
+                            }
+                        }
+                }
+        }
+    return static_cast<size_t>(out - start);
+}
+
+
+void sample_stream_udp_sink::send_packet()
+{
+    for (const auto& endpoint : d_endpoints)
+        {
+            boost::system::error_code error;
+            d_socket.send_to(boost::asio::buffer(d_packet.data(), d_packet_bytes), endpoint, 0, error);
+            if (error)
+                {
+                    if (d_send_errors % 1000 == 0)
+                        {
+                            LOG(WARNING) << "Cannot send the samples to " << endpoint << ": " << error.message()
+                                         << " (" << d_send_errors + 1 << " packets lost so far)";
+                        }
+                    d_send_errors++;
+                }
+        }
+    d_packets_sent++;
+    d_packet_bytes = 0;
+}
+
+
+bool sample_stream_udp_sink::stop()
+{
+    if (d_packet_bytes > 0)
+        {
+            send_packet();
+        }
+    return true;
+}
+
+
+int sample_stream_udp_sink::work(int noutput_items, gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    for (int c = 0; c < d_n_inputs; c++)
+        {
+            d_in[c] = static_cast<const gr_complex*>(input_items[c]);
+        }
+    const size_t packet_size = d_packet.size();
+    const size_t sample_bytes = packet_size / static_cast<size_t>(d_samples_per_packet);
+    size_t consumed = 0;
+    while (consumed < static_cast<size_t>(noutput_items))
+        {
+            const size_t n = std::min(static_cast<size_t>(noutput_items) - consumed, (packet_size - d_packet_bytes) / sample_bytes);
+            d_packet_bytes += pack(d_in, consumed, n, d_format, d_scale, d_packet.data() + d_packet_bytes);
+            consumed += n;
+            if (d_packet_bytes == packet_size)
+                {
+                    send_packet();
+                }
+        }
+    return noutput_items;
+}
@@ -0,0 +1,137 @@
+/*!
+ * \file sample_stream_udp_sink.h
+ * \brief GNU Radio block that streams the outputs of the signal conditioners
+ * to other receivers over UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_STREAM_UDP_SINK_H
+#define GNSS_SDR_SAMPLE_STREAM_UDP_SINK_H
+
+#include "gnss_block_interface.h"
+#include <boost/asio.hpp>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief Parameters of the sample stream (SampleStream.* in the
+ * configuration file)
+ */
+struct Sample_Stream_Conf
+{
+    std::string sample_type{"c4bits"};  //!< Wire format: c4bits, cbyte, ishort or cfloat
+    float scale{1.0F};                  //!< Gain applied to the samples before they are quantized
+    int payload_bytes{1472};            //!< Maximum UDP payload, rounded down to whole samples
+};
+
+
+class sample_stream_udp_sink;
+
+using sample_stream_udp_sink_sptr = gnss_shared_ptr<sample_stream_udp_sink>;
+
+sample_stream_udp_sink_sptr sample_stream_udp_sink_make(int n_inputs,
+    const Sample_Stream_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port);
+
+/*!
+ * \brief Sink of gr_complex samples that sends them in UDP packets, in the
+ * wire formats read by the Custom_UDP_Signal_Source.
+ *
+ * It makes a receiver the source node of a distributed receiver: it runs the
+ * signal source and the conditioners, and streams one input per band to the
+ * worker nodes, which run their groups of channels behind a
+ * Custom_UDP_Signal_Source with channels_in_udp set to the number of inputs,
+ * the same sample_type and IQ_swap=false. The inputs are interleaved sample
+ * by sample, so all the bands of a packet share the same sample counter and
+ * the worker nodes see them aligned (the bands must then share the sample
+ * rate, as those of the RF channels of a front-end do). c4bits packs each component in a nibble
+ * (the I one in the low nibble) as the odd levels -15..15, halving the
+ * bandwidth of cbyte; the other formats send the Q component first.
+ */
+class sample_stream_udp_sink : public gr::sync_block
+{
+public:
+    enum class Wire_Format
+    {
+        C4bits,
+        Cbyte,
+        Ishort,
+        Cfloat
+    };
+
+    ~sample_stream_udp_sink() = default;
+
+    bool stop() override;  //!< Sends the last, partial packet
+
+    int work(int noutput_items, gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    /*!
+     * \brief Packs samples [first, first + n) of each input, interleaved,
+     * into out. Returns the number of bytes written.
+     */
+    static size_t pack(const std::vector<const gr_complex*>& in, size_t first, size_t n,
+        Wire_Format format, float scale, uint8_t* out);
+
+    static size_t bytes_per_sample(Wire_Format format);  //!< Of one input
+
+    int samples_per_packet() const { return d_samples_per_packet; }
+
+    uint64_t packets_sent() const { return d_packets_sent; }
+
+private:
+    friend sample_stream_udp_sink_sptr sample_stream_udp_sink_make(int n_inputs,
+        const Sample_Stream_Conf& conf,
+        const std::vector<std::string>& addresses,
+        uint16_t port);
+
+    sample_stream_udp_sink(int n_inputs,
+        const Sample_Stream_Conf& conf,
+        const std::vector<std::string>& addresses,
+        uint16_t port);
+
+    void send_packet();
+
+    b_io_context d_io_context;
+    boost::asio::ip::udp::socket d_socket;
+    std::vector<boost::asio::ip::udp::endpoint> d_endpoints;
+    std::vector<uint8_t> d_packet;
+    std::vector<const gr_complex*> d_in;
+    uint64_t d_packets_sent{0};
+    uint64_t d_send_errors{0};
+    size_t d_packet_bytes{0};  // bytes of the packet being filled
+    float d_scale;
+    Wire_Format d_format;
+    int d_samples_per_packet;
+    int d_n_inputs;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_STREAM_UDP_SINK_H
@@ -0,0 +1,99 @@
+/*!
+ * \file serdes_spectrum_monitor.h
+ * \brief Serialization / Deserialization of Spectrum_Monitor_Packet objects
+ * using Protocol Buffers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SERDES_SPECTRUM_MONITOR_H
+#define GNSS_SDR_SERDES_SPECTRUM_MONITOR_H
+
+#include "spectrum_monitor.pb.h"  // file created by Protocol Buffers at compile time
+#include "spectrum_monitor_packet.h"
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief This class implements serialization and deserialization of
+ * Spectrum_Monitor_Packet objects using Protocol Buffers.
+ */
+class Serdes_Spectrum_Monitor
+{
+public:
+    Serdes_Spectrum_Monitor()
+    {
+        // Verify that the version of the library that we linked against is
+        // compatible with the version of the headers we compiled against.
+        GOOGLE_PROTOBUF_VERIFY_VERSION;
+    }
+
+    inline std::string createProtobuffer(const Spectrum_Monitor_Packet& packet)  //!< Serialization into a string
+    {
+        msg_.Clear();
+        std::string data;
+
+        msg_.set_rf_channel(packet.rf_channel);
+        msg_.set_sample_rate_hz(packet.sample_rate_hz);
+        msg_.set_sample_counter(packet.sample_counter);
+        msg_.set_fft_size(packet.fft_size);
+        msg_.set_averaged_segments(packet.averaged_segments);
+        for (const float p : packet.psd_db)
+            {
+                msg_.add_psd_db(p);
+            }
+        msg_.set_total_power_db(packet.total_power_db);
+        msg_.set_noise_floor_db(packet.noise_floor_db);
+        msg_.set_peak_to_floor_db(packet.peak_to_floor_db);
+        msg_.set_peak_frequency_hz(packet.peak_frequency_hz);
+        msg_.set_spectral_flatness(packet.spectral_flatness);
+        msg_.set_kurtosis(packet.kurtosis);
+        msg_.set_interference_detected(packet.interference_detected);
+
+        msg_.SerializeToString(&data);
+
+        return data;
+    }
+
+    inline Spectrum_Monitor_Packet readProtobuffer(const gnss_sdr::spectrumMonitor& msg) const  //!< Deserialization
+    {
+        Spectrum_Monitor_Packet packet;
+
+        packet.rf_channel = msg.rf_channel();
+        packet.sample_rate_hz = msg.sample_rate_hz();
+        packet.sample_counter = msg.sample_counter();
+        packet.fft_size = msg.fft_size();
+        packet.averaged_segments = msg.averaged_segments();
+        packet.psd_db.assign(msg.psd_db().begin(), msg.psd_db().end());
+        packet.total_power_db = msg.total_power_db();
+        packet.noise_floor_db = msg.noise_floor_db();
+        packet.peak_to_floor_db = msg.peak_to_floor_db();
+        packet.peak_frequency_hz = msg.peak_frequency_hz();
+        packet.spectral_flatness = msg.spectral_flatness();
+        packet.kurtosis = msg.kurtosis();
+        packet.interference_detected = msg.interference_detected();
+
+        return packet;
+    }
+
+private:
+    gnss_sdr::spectrumMonitor msg_{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SERDES_SPECTRUM_MONITOR_H
@@ -0,0 +1,290 @@
+/*!
+ * \file spectrum_monitor.cc
+ * \brief GNU Radio block that estimates the power spectral density and
+ * interference statistics of a signal conditioner output and sends them via UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spectrum_monitor.h"
+#include "MATH_CONSTANTS.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+
+spectrum_monitor_sptr spectrum_monitor_make(int rf_channel,
+    double sample_rate_hz,
+    const Spectrum_Monitor_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port)
+{
+    return spectrum_monitor_sptr(new spectrum_monitor(rf_channel, sample_rate_hz, conf, addresses, port));
+}
+
+
+spectrum_monitor::spectrum_monitor(int rf_channel,
+    double sample_rate_hz,
+    const Spectrum_Monitor_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port)
+    : gr::sync_block("spectrum_monitor",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(0, 0, 0)),
+      d_udp_sink(std::make_unique<Spectrum_Monitor_Udp_Sink>(addresses, port)),
+      d_conf(conf),
+      d_sample_rate_hz(sample_rate_hz),
+      d_rf_channel(rf_channel),
+      d_fft_size(16)
+{
+    while (d_fft_size < d_conf.fft_size)
+        {
+            d_fft_size *= 2;
+        }
+    d_conf.averages = std::max(1, d_conf.averages);
+    // the reported bins are averages of an integer number of FFT bins
+    const int group = std::max(1, d_fft_size / std::max(1, std::min(d_conf.bins, d_fft_size)));
+    d_bins = d_fft_size / group;
+    d_capture_length = (d_conf.averages + 1) * d_fft_size / 2;
+    d_update_period = std::max(static_cast<uint64_t>(d_capture_length),
+        static_cast<uint64_t>(std::max(0.0, d_sample_rate_hz * d_conf.update_period_ms / 1000.0)));
+
+    d_capture = std::vector<gr_complex>(d_capture_length);
+    d_psd = std::vector<float>(d_fft_size);
+    d_magnitude = std::vector<float>(d_fft_size);
+    d_window = std::vector<float>(d_fft_size);
+    d_window_power = 0.0;
+    for (int n = 0; n < d_fft_size; n++)
+        {
+            d_window[n] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * GNSS_PI * n / d_fft_size));
+            d_window_power += static_cast<double>(d_window[n]) * d_window[n];
+        }
+    d_fft = gnss_fft_fwd_make_unique(d_fft_size);
+}
+
+
+spectrum_monitor::~spectrum_monitor()
+{
+    d_stop.store(true);
+    d_analysis_cv.notify_one();
+    if (d_analysis_thread.joinable())
+        {
+            d_analysis_thread.join();
+        }
+}
+
+
+bool spectrum_monitor::start()
+{
+    if (!d_analysis_thread.joinable())
+        {
+            d_stop.store(false);
+            d_analysis_thread = std::thread(&spectrum_monitor::analysis_loop, this);
+        }
+    return gr::sync_block::start();
+}
+
+
+bool spectrum_monitor::stop()
+{
+    d_stop.store(true);
+    d_analysis_cv.notify_one();
+    if (d_analysis_thread.joinable())
+        {
+            d_analysis_thread.join();
+        }
+    return gr::sync_block::stop();
+}
+
+
+int spectrum_monitor::work(int noutput_items, gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);
+
+    if (!d_capturing)
+        {
+            d_samples_since_capture += noutput_items;
+            if (d_samples_since_capture >= d_update_period)
+                {
+                    d_samples_since_capture = 0;
+                    // if the previous capture is still being analyzed, this one is skipped
+                    if (!d_capture_ready.load(std::memory_order_acquire))
+                        {
+                            d_capturing = true;
+                            d_captured = 0;
+                            d_capture_start = d_sample_counter;
+                        }
+                }
+        }
+    if (d_capturing)
+        {
+            const int n = std::min(noutput_items, d_capture_length - d_captured);
+            memcpy(d_capture.data() + d_captured, in, sizeof(gr_complex) * n);
+            d_captured += n;
+            if (d_captured == d_capture_length)
+                {
+                    d_capturing = false;
+                    d_capture_ready.store(true, std::memory_order_release);
+                    d_analysis_cv.notify_one();
+                }
+        }
+
+    d_sample_counter += noutput_items;
+    return noutput_items;
+}
+
+
+void spectrum_monitor::analysis_loop()
+{
+    Spectrum_Monitor_Packet report;
+    while (!d_stop.load())
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_analysis_mutex);
+                // work() does not take the mutex to notify, so the wait is bounded
+                while (!d_capture_ready.load(std::memory_order_acquire) and !d_stop.load())
+                    {
+                        d_analysis_cv.wait_for(lock, std::chrono::milliseconds(100));
+                    }
+            }
+            if (d_stop.load())
+                {
+                    break;
+                }
+            report.sample_counter = d_capture_start;
+            analyze(d_capture.data(), report);
+            d_capture_ready.store(false, std::memory_order_release);
+            if (report.interference_detected)
+                {
+                    DLOG(INFO) << "Possible interference in RF channel " << d_rf_channel
+                               << ": peak-to-floor ratio " << report.peak_to_floor_db << " dB at "
+                               << report.peak_frequency_hz << " Hz, kurtosis " << report.kurtosis;
+                }
+            if (d_udp_sink->write_spectrum_report(report))
+                {
+                    d_reports_sent++;
+                }
+        }
+}
+
+
+void spectrum_monitor::analyze(const gr_complex* samples, Spectrum_Monitor_Packet& report)
+{
+    const int hop = d_fft_size / 2;
+    const auto length = static_cast<unsigned int>(d_fft_size);
+
+    // Welch estimation: average of the periodograms of Hann-windowed, 50%
+    // overlapped segments
+    std::fill(d_psd.begin(), d_psd.end(), 0.0F);
+    for (int s = 0; s < d_conf.averages; s++)
+        {
+            volk_32fc_32f_multiply_32fc(d_fft->get_inbuf(), samples + s * hop, d_window.data(), length);
+            d_fft->execute();
+            volk_32fc_magnitude_squared_32f(d_magnitude.data(), d_fft->get_outbuf(), length);
+            volk_32f_x2_add_32f(d_psd.data(), d_psd.data(), d_magnitude.data(), length);
+        }
+
+    // one-sided scaling is not applicable to complex samples: the PSD spans
+    // [-fs/2, fs/2) and integrates to the average power
+    const double scale = 1.0 / (static_cast<double>(d_conf.averages) * d_window_power * d_sample_rate_hz);
+    std::vector<double> psd(d_fft_size);
+    for (int k = 0; k < d_fft_size; k++)
+        {
+            psd[k] = std::max(static_cast<double>(d_psd[(k + hop) % d_fft_size]) * scale, 1e-30);
+        }
+
+    int peak = 0;
+    double sum = 0.0;
+    double sum_log = 0.0;
+    for (int k = 0; k < d_fft_size; k++)
+        {
+            if (psd[k] > psd[peak])
+                {
+                    peak = k;
+                }
+            sum += psd[k];
+            sum_log += std::log(psd[k]);
+        }
+    const double mean = sum / d_fft_size;
+
+    const int group = d_fft_size / d_bins;
+    report.psd_db.resize(d_bins);
+    for (int b = 0; b < d_bins; b++)
+        {
+            double bin = 0.0;
+            for (int k = b * group; k < (b + 1) * group; k++)
+                {
+                    bin += psd[k];
+                }
+            report.psd_db[b] = static_cast<float>(10.0 * std::log10(bin / group));
+        }
+    const double peak_value = psd[peak];
+
+    std::vector<double> sorted(psd);
+    std::nth_element(sorted.begin(), sorted.begin() + hop, sorted.end());
+    const double floor = sorted[hop];
+
+    // kurtosis of I and Q, and average power, in the time domain
+    double mean_i = 0.0;
+    double mean_q = 0.0;
+    for (int n = 0; n < d_capture_length; n++)
+        {
+            mean_i += samples[n].real();
+            mean_q += samples[n].imag();
+        }
+    mean_i /= d_capture_length;
+    mean_q /= d_capture_length;
+    double m2_i = 0.0;
+    double m2_q = 0.0;
+    double m4_i = 0.0;
+    double m4_q = 0.0;
+    double power = 0.0;
+    for (int n = 0; n < d_capture_length; n++)
+        {
+            const double i2 = (samples[n].real() - mean_i) * (samples[n].real() - mean_i);
+            const double q2 = (samples[n].imag() - mean_q) * (samples[n].imag() - mean_q);
+            m2_i += i2;
+            m2_q += q2;
+            m4_i += i2 * i2;
+            m4_q += q2 * q2;
+            power += std::norm(samples[n]);
+        }
+    double kurtosis = 0.0;
+    int components = 0;
+    if (m2_i > 0.0)
+        {
+            kurtosis += m4_i * d_capture_length / (m2_i * m2_i);
+            components++;
+        }
+    if (m2_q > 0.0)
+        {
+            kurtosis += m4_q * d_capture_length / (m2_q * m2_q);
+            components++;
+        }
+
+    report.rf_channel = d_rf_channel;
+    report.sample_rate_hz = d_sample_rate_hz;
+    report.fft_size = d_fft_size;
+    report.averaged_segments = d_conf.averages;
+    report.total_power_db = 10.0 * std::log10(std::max(power / d_capture_length, 1e-30));
+    report.noise_floor_db = 10.0 * std::log10(floor);
+    report.peak_to_floor_db = 10.0 * std::log10(peak_value / floor);
+    report.peak_frequency_hz = static_cast<double>(peak - hop) * d_sample_rate_hz / d_fft_size;
+    report.spectral_flatness = std::exp(sum_log / d_fft_size) / mean;
+    report.kurtosis = components > 0 ? kurtosis / components : 0.0;
+    report.interference_detected = report.peak_to_floor_db > d_conf.interference_threshold_db or
+                                   (components > 0 and std::abs(report.kurtosis - 3.0) > d_conf.kurtosis_threshold);
+}
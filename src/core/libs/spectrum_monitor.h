@@ -0,0 +1,143 @@
+/*!
+ * \file spectrum_monitor.h
+ * \brief GNU Radio block that estimates the power spectral density and
+ * interference statistics of a signal conditioner output and sends them via UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRUM_MONITOR_H
+#define GNSS_SDR_SPECTRUM_MONITOR_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_fft.h"
+#include "spectrum_monitor_packet.h"
+#include "spectrum_monitor_udp_sink.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+/*!
+ * \brief Parameters of the spectrum monitor (SpectrumMonitor.* in the
+ * configuration file)
+ */
+struct Spectrum_Monitor_Conf
+{
+    int fft_size{1024};                       //!< Length of the Welch segments (rounded up to a power of two)
+    int averages{16};                         //!< Number of 50% overlapped segments per estimation
+    int bins{256};                            //!< Number of reported PSD values, averaged from the fft_size ones
+    double update_period_ms{1000.0};          //!< Time between estimations
+    double interference_threshold_db{10.0};   //!< Peak-to-floor ratio that flags narrowband interference
+    double kurtosis_threshold{1.0};           //!< Deviation from 3 of the kurtosis that flags non-Gaussian interference
+};
+
+
+class spectrum_monitor;
+
+using spectrum_monitor_sptr = gnss_shared_ptr<spectrum_monitor>;
+
+spectrum_monitor_sptr spectrum_monitor_make(int rf_channel,
+    double sample_rate_hz,
+    const Spectrum_Monitor_Conf& conf,
+    const std::vector<std::string>& addresses,
+    uint16_t port);
+
+/*!
+ * \brief Sink of gr_complex samples that reports the spectrum of a signal
+ * conditioner output.
+ *
+ * work() only counts the samples and, once per update period, copies the
+ * (averages + 1) * fft_size / 2 contiguous ones that make an estimation, so
+ * it samples a small fraction of the stream. The Welch estimation (Hann
+ * window, 50% overlap), the statistics and the UDP transmission run in a
+ * background thread; if it is still busy when a new capture is due, that
+ * capture is skipped instead of making the sample path wait.
+ */
+class spectrum_monitor : public gr::sync_block
+{
+public:
+    ~spectrum_monitor();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items, gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    /*!
+     * \brief Fills the spectral fields of report from capture_length() samples
+     */
+    void analyze(const gr_complex* samples, Spectrum_Monitor_Packet& report);
+
+    int capture_length() const { return d_capture_length; }
+
+    int fft_size() const { return d_fft_size; }
+
+    uint64_t reports_sent() const { return d_reports_sent.load(); }
+
+private:
+    friend spectrum_monitor_sptr spectrum_monitor_make(int rf_channel,
+        double sample_rate_hz,
+        const Spectrum_Monitor_Conf& conf,
+        const std::vector<std::string>& addresses,
+        uint16_t port);
+
+    spectrum_monitor(int rf_channel,
+        double sample_rate_hz,
+        const Spectrum_Monitor_Conf& conf,
+        const std::vector<std::string>& addresses,
+        uint16_t port);
+
+    void analysis_loop();
+
+    std::unique_ptr<Spectrum_Monitor_Udp_Sink> d_udp_sink;
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft;
+    std::vector<gr_complex> d_capture;
+    std::vector<float> d_window;
+    std::vector<float> d_psd;        // accumulated periodograms, natural FFT order
+    std::vector<float> d_magnitude;  // periodogram of one segment
+    std::thread d_analysis_thread;
+    std::mutex d_analysis_mutex;
+    std::condition_variable d_analysis_cv;
+    std::atomic<uint64_t> d_reports_sent{0};
+    std::atomic<bool> d_capture_ready{false};
+    std::atomic<bool> d_stop{false};
+    Spectrum_Monitor_Conf d_conf;
+    double d_sample_rate_hz;
+    double d_window_power;  // sum of the squared window coefficients
+    uint64_t d_sample_counter{0};
+    uint64_t d_capture_start{0};
+    uint64_t d_samples_since_capture{0};
+    uint64_t d_update_period;
+    int d_rf_channel;
+    int d_fft_size;
+    int d_bins;
+    int d_capture_length;
+    int d_captured{0};
+    bool d_capturing{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPECTRUM_MONITOR_H
@@ -0,0 +1,51 @@
+/*!
+ * \file spectrum_monitor_packet.h
+ * \brief Class for storage of the spectrum and interference reports of a
+ * signal conditioner output
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRUM_MONITOR_PACKET_H
+#define GNSS_SDR_SPECTRUM_MONITOR_PACKET_H
+
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+class Spectrum_Monitor_Packet
+{
+public:
+    Spectrum_Monitor_Packet() = default;  //!< Default constructor
+
+    int32_t rf_channel{0};             //!< Index of the signal conditioner being monitored
+    double sample_rate_hz{0.0};        //!< Sample rate of the monitored stream [Hz]
+    uint64_t sample_counter{0};        //!< Samples received before the first analyzed one
+    int32_t fft_size{0};               //!< Length of the Welch segments [samples]
+    int32_t averaged_segments{0};      //!< Number of averaged segments
+    std::vector<float> psd_db;         //!< Power spectral density from -fs/2 to fs/2 [dB/Hz]
+    double total_power_db{0.0};        //!< Average power of the analyzed samples [dB]
+    double noise_floor_db{0.0};        //!< Median of the power spectral density [dB/Hz]
+    double peak_to_floor_db{0.0};      //!< Highest spectral line over the noise floor [dB]
+    double peak_frequency_hz{0.0};     //!< Frequency of the highest spectral line [Hz]
+    double spectral_flatness{0.0};     //!< Geometric to arithmetic mean ratio of the PSD
+    double kurtosis{0.0};              //!< Kurtosis of the I and Q components
+    bool interference_detected{false};  //!< Peak-to-floor ratio or kurtosis above their thresholds
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPECTRUM_MONITOR_PACKET_H
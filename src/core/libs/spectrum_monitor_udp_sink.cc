@@ -0,0 +1,51 @@
+/*!
+ * \file spectrum_monitor_udp_sink.cc
+ * \brief Sends serialized Spectrum_Monitor_Packet objects via UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spectrum_monitor_udp_sink.h"
+
+
+Spectrum_Monitor_Udp_Sink::Spectrum_Monitor_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port) : socket{io_context}
+{
+    for (const auto& address : addresses)
+        {
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
+            endpoints.push_back(endpoint);
+        }
+}
+
+
+bool Spectrum_Monitor_Udp_Sink::write_spectrum_report(const Spectrum_Monitor_Packet& packet)
+{
+    std::string outbound_data = serdes_spectrum.createProtobuffer(packet);
+
+    for (const auto& endpoint : endpoints)
+        {
+            socket.open(endpoint.protocol(), error);
+            socket.connect(endpoint, error);
+
+            try
+                {
+                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
+                        {
+                            return false;
+                        }
+                }
+            catch (boost::system::system_error const& e)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
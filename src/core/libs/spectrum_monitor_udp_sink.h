@@ -0,0 +1,54 @@
+/*!
+ * \file spectrum_monitor_udp_sink.h
+ * \brief Sends serialized Spectrum_Monitor_Packet objects via UDP
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRUM_MONITOR_UDP_SINK_H
+#define GNSS_SDR_SPECTRUM_MONITOR_UDP_SINK_H
+
+#include "serdes_spectrum_monitor.h"
+#include "spectrum_monitor_packet.h"
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+class Spectrum_Monitor_Udp_Sink
+{
+public:
+    Spectrum_Monitor_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port);
+    bool write_spectrum_report(const Spectrum_Monitor_Packet& packet);
+
+private:
+    Serdes_Spectrum_Monitor serdes_spectrum;
+    b_io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    std::vector<boost::asio::ip::udp::endpoint> endpoints;
+    boost::system::error_code error;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPECTRUM_MONITOR_UDP_SINK_H
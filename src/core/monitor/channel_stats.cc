@@ -0,0 +1,113 @@
+/*!
+ * \file channel_stats.cc
+ * \brief Statistics of the Gnss_Synchro objects of a channel over a time
+ * window, as sent by the aggregating monitors
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "channel_stats.h"
+#include "MATH_CONSTANTS.h"
+#include <algorithm>  // for std::min, std::max
+#include <cmath>      // for std::abs
+#include <cstring>    // for std::memcpy
+
+
+Channel_Stats_Accumulator::Channel_Stats_Accumulator(double window_s) : d_window_s(window_s)
+{
+}
+
+
+bool Channel_Stats_Accumulator::add(const Gnss_Synchro& gs, Channel_Stats& stats)
+{
+    if (gs.fs <= 0)
+        {
+            return false;
+        }
+    const double time_s = static_cast<double>(gs.Tracking_sample_counter) / static_cast<double>(gs.fs);
+
+    bool closed = false;
+    if (d_window.Items > 0)
+        {
+            const bool new_satellite = gs.PRN != d_window.PRN || gs.System != d_window.System || time_s < d_last_time_s;
+            if (new_satellite || time_s - d_window.Start_time_s >= d_window_s)
+                {
+                    finish(stats);
+                    closed = true;
+                    d_window.Items = 0;
+                }
+            if (new_satellite)
+                {
+                    d_locked_before = false;  // the carrier phase is not continuous
+                }
+        }
+    if (d_window.Items == 0)
+        {
+            start(gs, time_s);
+        }
+
+    d_window.Items++;
+    d_cn0_sum += gs.CN0_dB_hz;
+    d_window.CN0_min_dB_hz = std::min(d_window.CN0_min_dB_hz, gs.CN0_dB_hz);
+    d_window.CN0_max_dB_hz = std::max(d_window.CN0_max_dB_hz, gs.CN0_dB_hz);
+    d_last_time_s = time_s;
+
+    if (gs.Flag_valid_symbol_output)
+        {
+            if (d_window.Locked_items == 0)
+                {
+                    d_first_locked_time_s = time_s;
+                    d_first_locked_doppler_hz = gs.Carrier_Doppler_hz;
+                }
+            if (d_locked_before)
+                {
+                    // The tracking loops accumulate the carrier phase with the
+                    // opposite sign of the Doppler, so the phase is expected to
+                    // change by -2 pi times the mean Doppler times the interval.
+                    const double expected_rads = -TWO_PI * 0.5 * (d_last_locked_doppler_hz + gs.Carrier_Doppler_hz) * (time_s - d_last_locked_time_s);
+                    if (std::abs(gs.Carrier_phase_rads - d_last_locked_phase_rads - expected_rads) > GNSS_PI)
+                        {
+                            d_window.Cycle_slips++;
+                        }
+                }
+            d_window.Locked_items++;
+            d_last_locked_time_s = time_s;
+            d_last_locked_doppler_hz = gs.Carrier_Doppler_hz;
+            d_last_locked_phase_rads = gs.Carrier_phase_rads;
+        }
+    d_locked_before = gs.Flag_valid_symbol_output;
+    return closed;
+}
+
+
+void Channel_Stats_Accumulator::start(const Gnss_Synchro& gs, double time_s)
+{
+    d_window = Channel_Stats();
+    d_window.System = gs.System;
+    std::memcpy(d_window.Signal, gs.Signal, sizeof(d_window.Signal));
+    d_window.PRN = gs.PRN;
+    d_window.Channel_ID = gs.Channel_ID;
+    d_window.Start_time_s = time_s;
+    d_window.CN0_min_dB_hz = gs.CN0_dB_hz;
+    d_window.CN0_max_dB_hz = gs.CN0_dB_hz;
+    d_cn0_sum = 0.0;
+}
+
+
+void Channel_Stats_Accumulator::finish(Channel_Stats& stats) const
+{
+    stats = d_window;
+    stats.Duration_s = d_last_time_s - d_window.Start_time_s;
+    stats.Lock_ratio = static_cast<double>(d_window.Locked_items) / static_cast<double>(d_window.Items);
+    stats.CN0_mean_dB_hz = d_cn0_sum / static_cast<double>(d_window.Items);
+    const double locked_span_s = d_last_locked_time_s - d_first_locked_time_s;
+    stats.Doppler_rate_hz_s = (d_window.Locked_items > 1 && locked_span_s > 0.0) ? (d_last_locked_doppler_hz - d_first_locked_doppler_hz) / locked_span_s : 0.0;
+}
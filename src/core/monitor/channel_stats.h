@@ -0,0 +1,116 @@
+/*!
+ * \file channel_stats.h
+ * \brief Statistics of the Gnss_Synchro objects of a channel over a time
+ * window, as sent by the aggregating monitors
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNEL_STATS_H
+#define GNSS_SDR_CHANNEL_STATS_H
+
+#include "gnss_synchro.h"
+#include <boost/serialization/nvp.hpp>
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+/*!
+ * \brief Statistics of one channel over a window. Trivially copyable, so it
+ * is also the record of the shared memory transport.
+ */
+class Channel_Stats
+{
+public:
+    char System{};           //!< Constellation, as in Gnss_Synchro
+    char Signal[3]{};        //!< Signal, as in Gnss_Synchro
+    uint32_t PRN{};          //!< Satellite tracked during the window
+    int32_t Channel_ID{};    //!< Channel
+    uint32_t Items{};        //!< Gnss_Synchro objects in the window
+    uint32_t Locked_items{};  //!< Of them, with valid tracking (Flag_valid_symbol_output)
+    uint32_t Cycle_slips{};  //!< Carrier phase jumps of more than half a cycle between locked items
+
+    double Start_time_s{};       //!< Time of the first item, from its sample counter, in s
+    double Duration_s{};         //!< From the first to the last item, in s
+    double Lock_ratio{};         //!< Locked_items / Items
+    double CN0_mean_dB_hz{};     //!< Mean C/N0, in dB-Hz
+    double CN0_min_dB_hz{};      //!< Minimum C/N0, in dB-Hz
+    double CN0_max_dB_hz{};      //!< Maximum C/N0, in dB-Hz
+    double Doppler_rate_hz_s{};  //!< Doppler change between the first and last locked items, in Hz/s
+
+    /*!
+     * \brief Serializes and restores Channel_Stats objects from a byte stream.
+     */
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version)
+    {
+        if (version)
+            {
+            };
+        ar& BOOST_SERIALIZATION_NVP(System);
+        ar& BOOST_SERIALIZATION_NVP(Signal);
+        ar& BOOST_SERIALIZATION_NVP(PRN);
+        ar& BOOST_SERIALIZATION_NVP(Channel_ID);
+        ar& BOOST_SERIALIZATION_NVP(Items);
+        ar& BOOST_SERIALIZATION_NVP(Locked_items);
+        ar& BOOST_SERIALIZATION_NVP(Cycle_slips);
+        ar& BOOST_SERIALIZATION_NVP(Start_time_s);
+        ar& BOOST_SERIALIZATION_NVP(Duration_s);
+        ar& BOOST_SERIALIZATION_NVP(Lock_ratio);
+        ar& BOOST_SERIALIZATION_NVP(CN0_mean_dB_hz);
+        ar& BOOST_SERIALIZATION_NVP(CN0_min_dB_hz);
+        ar& BOOST_SERIALIZATION_NVP(CN0_max_dB_hz);
+        ar& BOOST_SERIALIZATION_NVP(Doppler_rate_hz_s);
+    }
+};
+
+
+/*!
+ * \brief Accumulates the full-rate Gnss_Synchro objects of one channel and
+ * closes a window of statistics every window_s seconds of signal (measured
+ * with the sample counter, not with the wall clock), or earlier if the
+ * channel starts tracking another satellite.
+ */
+class Channel_Stats_Accumulator
+{
+public:
+    explicit Channel_Stats_Accumulator(double window_s = 1.0);
+
+    /*!
+     * \brief Adds an item. Returns true if the item closed a window, whose
+     * statistics are then written to stats; the item starts the next one.
+     */
+    bool add(const Gnss_Synchro& gs, Channel_Stats& stats);
+
+private:
+    void start(const Gnss_Synchro& gs, double time_s);
+    void finish(Channel_Stats& stats) const;
+
+    Channel_Stats d_window{};
+    double d_window_s;
+    double d_cn0_sum{};
+    double d_last_time_s{};
+    double d_first_locked_time_s{};
+    double d_first_locked_doppler_hz{};
+    double d_last_locked_time_s{};
+    double d_last_locked_doppler_hz{};
+    double d_last_locked_phase_rads{};
+    bool d_locked_before{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CHANNEL_STATS_H
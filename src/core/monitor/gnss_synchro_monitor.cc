@@ -21,20 +21,29 @@
 #include "gnss_synchro.h"
 #include <algorithm>
 #include <iostream>
+#include <type_traits>
 #include <utility>
 
 
+static_assert(std::is_trivially_copyable<Gnss_Synchro>::value, "the shared memory monitor copies Gnss_Synchro objects byte by byte");
+static_assert(std::is_trivially_copyable<Channel_Stats>::value, "the shared memory monitor copies Channel_Stats objects byte by byte");
+
+
 gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf)
+    bool enable_protobuf,
+    const std::string& shm_name,
+    int aggregation_window_ms)
 {
     return gnss_synchro_monitor_sptr(new gnss_synchro_monitor(n_channels,
         decimation_factor,
         udp_port,
         udp_addresses,
-        enable_protobuf));
+        enable_protobuf,
+        shm_name,
+        aggregation_window_ms));
 }
 
 
@@ -42,14 +51,32 @@ gnss_synchro_monitor::gnss_synchro_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf)
+    bool enable_protobuf,
+    const std::string& shm_name,
+    int aggregation_window_ms)
     : gr::block("gnss_synchro_monitor",
           gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
           gr::io_signature::make(0, 0, 0)),
       d_nchannels(n_channels),
-      d_decimation_factor(decimation_factor)
+      d_decimation_factor(decimation_factor),
+      d_enabled_channels(n_channels, true)
 {
-    udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf);
+    if (shm_name.empty())
+        {
+            udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf);
+        }
+    else if (aggregation_window_ms > 0)
+        {
+            d_ring = std::make_unique<Gnss_Monitor_Ring_Writer>(shm_name, GNSS_SDR_MONITOR_RECORD_CHANNEL_STATS, sizeof(Channel_Stats));
+        }
+    else
+        {
+            d_ring = std::make_unique<Gnss_Monitor_Ring_Writer>(shm_name, GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro));
+        }
+    if (aggregation_window_ms > 0)
+        {
+            d_accumulators.assign(n_channels, Channel_Stats_Accumulator(static_cast<double>(aggregation_window_ms) / 1000.0));
+        }
 }
 
 
@@ -69,6 +96,26 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
     // Get the input buffer pointer
     const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);
 
+    gr::thread::scoped_lock lock(d_setlock);
+    for (int channel_index = 0; channel_index < d_nchannels; channel_index++)
+        {
+            if (!d_enabled_channels[channel_index])
+                {
+                    consume(channel_index, ninput_items[channel_index]);
+                    ninput_items[channel_index] = 0;
+                }
+        }
+
+    if (!d_accumulators.empty())
+        {
+            for (int channel_index = 0; channel_index < d_nchannels; channel_index++)
+                {
+                    aggregate(channel_index, in[channel_index], ninput_items[channel_index]);
+                    consume(channel_index, ninput_items[channel_index]);
+                }
+            return 0;
+        }
+
     // Loop through each input stream channel
     for (int channel_index = 0; channel_index < d_nchannels; channel_index++)
         {
@@ -80,10 +127,16 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
                     count++;
                     if (count >= d_decimation_factor)
                         {
-                            // Convert to a vector and write to the UDP sink
-                            std::vector<Gnss_Synchro> stocks;
-                            stocks.push_back(in[channel_index][item_index]);
-                            udp_sink_ptr->write_gnss_synchro(stocks);
+                            if (d_ring)
+                                {
+                                    d_ring->publish(&in[channel_index][item_index]);
+                                }
+                            else
+                                {
+                                    // Write to the UDP sink, one item per datagram
+                                    d_stocks[0] = in[channel_index][item_index];
+                                    udp_sink_ptr->write_gnss_synchro(d_stocks);
+                                }
                             // Reset count variable
                             count = 0;
                             // Consume the number of items for the input stream channel
@@ -95,3 +148,34 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
     // Not producing any outputs
     return 0;
 }
+
+
+bool gnss_synchro_monitor::set_channel_enabled(int channel_index, bool enabled)
+{
+    if (channel_index < 0 or channel_index >= d_nchannels)
+        {
+            return false;
+        }
+    gr::thread::scoped_lock lock(d_setlock);
+    d_enabled_channels[channel_index] = enabled;
+    return true;
+}
+
+
+void gnss_synchro_monitor::aggregate(int channel_index, const Gnss_Synchro* items, int nitems)
+{
+    for (int item_index = 0; item_index < nitems; item_index++)
+        {
+            if (d_accumulators[channel_index].add(items[item_index], d_channel_stats[0]))
+                {
+                    if (d_ring)
+                        {
+                            d_ring->publish(&d_channel_stats[0]);
+                        }
+                    else
+                        {
+                            udp_sink_ptr->write_channel_stats(d_channel_stats);
+                        }
+                }
+        }
+}
@@ -20,7 +20,9 @@
 #ifndef GNSS_SDR_GNSS_SYNCHRO_MONITOR_H
 #define GNSS_SDR_GNSS_SYNCHRO_MONITOR_H
 
+#include "channel_stats.h"
 #include "gnss_block_interface.h"
+#include "gnss_sdr_monitor_ring_writer.h"
 #include "gnss_synchro_udp_sink.h"
 #include <gnuradio/block.h>
 #include <gnuradio/runtime_types.h>  // for gr_vector_void_star
@@ -43,12 +45,18 @@ gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf);
+    bool enable_protobuf,
+    const std::string& shm_name = std::string(),
+    int aggregation_window_ms = 0);
 
 /*!
  * \brief This class implements a monitoring block which allows sending
  * a data stream with the receiver internal parameters (Gnss_Synchro objects)
- * to local or remote clients over UDP.
+ * to local or remote clients over UDP, or to local clients through a ring in
+ * shared memory (see gnss_sdr_monitor_ring.h) if a shm_name is given.
+ *
+ * If aggregation_window_ms is positive, the block reads every item and sends,
+ * instead of the items, one Channel_Stats object per channel and window.
  */
 class gnss_synchro_monitor : public gr::block
 {
@@ -58,22 +66,39 @@ public:
     int general_work(int noutput_items, gr_vector_int& ninput_items,
         gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
 
+    /*!
+     * \brief Stops or resumes sending the items of a channel. Returns false
+     * if there is no such channel.
+     */
+    bool set_channel_enabled(int channel_index, bool enabled);
+
 private:
+    void aggregate(int channel_index, const Gnss_Synchro* items, int nitems);
+
     friend gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        const std::string& shm_name,
+        int aggregation_window_ms);
 
     gnss_synchro_monitor(int n_channels,
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        const std::string& shm_name,
+        int aggregation_window_ms);
 
     int d_nchannels;
     int d_decimation_factor;
     std::unique_ptr<Gnss_Synchro_Udp_Sink> udp_sink_ptr;
+    std::unique_ptr<Gnss_Monitor_Ring_Writer> d_ring;
+    std::vector<Gnss_Synchro> d_stocks{1};
+    std::vector<Channel_Stats_Accumulator> d_accumulators;  // one per channel if aggregating
+    std::vector<Channel_Stats> d_channel_stats{1};
+    std::vector<bool> d_enabled_channels;  // guarded by d_setlock
 };
 
 
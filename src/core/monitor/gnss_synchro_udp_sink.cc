@@ -16,60 +16,69 @@
  */
 
 #include "gnss_synchro_udp_sink.h"
+#include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_udp_sender.h"
 #include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/serialization/vector.hpp>
-#include <iostream>
-#include <sstream>
+#include <glog/logging.h>
+#include <utility>
+
 
 Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
     bool enable_protobuf)
-    : socket{io_context},
-      use_protobuf(enable_protobuf)
+    : use_protobuf(enable_protobuf)
 {
-    if (enable_protobuf)
-        {
-            serdes = Serdes_Gnss_Synchro();
-        }
+    std::vector<boost::asio::ip::udp::endpoint> endpoints;
     for (const auto& address : addresses)
         {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
+            boost::system::error_code error;
+            const auto ip = boost::asio::ip::address::from_string(address, error);
+            if (error)
+                {
+                    LOG(WARNING) << "Invalid address for the Gnss_Synchro monitor: " << address;
+                    continue;
+                }
+            endpoints.emplace_back(ip, port);
         }
+    sender = std::make_unique<Gnss_Udp_Sender>(std::move(endpoints));
 }
 
 
+Gnss_Synchro_Udp_Sink::~Gnss_Synchro_Udp_Sink() = default;
+
+
 bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
 {
-    std::string outbound_data;
+    return write(stocks);
+}
+
+
+bool Gnss_Synchro_Udp_Sink::write_channel_stats(const std::vector<Channel_Stats>& stats)
+{
+    return write(stats);
+}
+
+
+template <typename T>
+bool Gnss_Synchro_Udp_Sink::write(const std::vector<T>& objects)
+{
+    std::string outbound_data = sender->get_buffer();
     if (use_protobuf == false)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << stocks;
-            outbound_data = archive_stream.str();
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << objects;
+            }
+            archive_stream.flush();
         }
     else
         {
-            outbound_data = serdes.createProtobuffer(stocks);
-        }
-    for (const auto& endpoint : endpoints)
-        {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            std::cerr << "Gnss_Synchro_Udp_Sink sent 0 bytes\n";
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    std::cerr << e.what() << '\n';
-                    return false;
-                }
+            serdes.createProtobuffer(objects, outbound_data);
         }
+    sender->send(std::move(outbound_data));
     return true;
 }
@@ -18,11 +18,12 @@
 #ifndef GNSS_SDR_GNSS_SYNCHRO_UDP_SINK_H
 #define GNSS_SDR_GNSS_SYNCHRO_UDP_SINK_H
 
+#include "channel_stats.h"
 #include "gnss_synchro.h"
 #include "serdes_gnss_synchro.h"
 #include <boost/asio.hpp>
-#include <boost/system/error_code.hpp>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,26 +39,33 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+class Gnss_Udp_Sender;
+
 /*!
  * \brief This class sends serialized Gnss_Synchro objects
  * over UDP to one or multiple endpoints.
+ *
+ * The objects are serialized into recycled buffers and handed to a
+ * Gnss_Udp_Sender, which sends them from its own thread, so writing never
+ * waits for the network.
  */
 class Gnss_Synchro_Udp_Sink
 {
 public:
     Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf);
+    ~Gnss_Synchro_Udp_Sink();
     bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks);
+    bool write_channel_stats(const std::vector<Channel_Stats>& stats);
 
 private:
-    b_io_context io_context;
-    boost::asio::ip::udp::socket socket;
-    boost::system::error_code error;
-    std::vector<boost::asio::ip::udp::endpoint> endpoints;
+    template <typename T>
+    bool write(const std::vector<T>& objects);
+
+    std::unique_ptr<Gnss_Udp_Sender> sender;
     Serdes_Gnss_Synchro serdes;
     bool use_protobuf;
 };
 
-
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_GNSS_SYNCHRO_UDP_SINK_H
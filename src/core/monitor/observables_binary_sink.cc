@@ -0,0 +1,120 @@
+/*!
+ * \file observables_binary_sink.cc
+ * \brief GNU Radio block that streams the observables of every epoch to a
+ * file in a compact binary format
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "observables_binary_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::max
+#include <exception>  // for std::exception
+#include <iostream>   // for std::cerr
+
+
+observables_binary_sink_sptr observables_make_binary_sink(int n_channels,
+    int decimation_factor,
+    const std::string& filename)
+{
+    return observables_binary_sink_sptr(new observables_binary_sink(n_channels,
+        decimation_factor,
+        filename));
+}
+
+
+observables_binary_sink::observables_binary_sink(int n_channels,
+    int decimation_factor,
+    const std::string& filename)
+    : gr::sync_block("observables_binary_sink",
+          gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
+          gr::io_signature::make(0, 0, 0)),
+      d_epoch_counter(0),
+      d_nchannels(n_channels),
+      d_decimation_factor(std::max(decimation_factor, 1))
+{
+    d_epoch.reserve(n_channels);
+    d_buffer.reserve(Serdes_Observables_Binary::HEADER_SIZE + Serdes_Observables_Binary::RECORD_SIZE * n_channels);
+    d_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+        {
+            d_file.open(filename.c_str(), std::ios::out | std::ios::binary);
+            LOG(INFO) << "Observables binary stream enabled, writing to " << filename;
+        }
+    catch (const std::ofstream::failure& e)
+        {
+            LOG(WARNING) << "Problem opening the observables binary stream " << filename << ": " << e.what();
+            std::cerr << "Problem opening the observables binary stream " << filename << ", it will not be written\n";
+        }
+}
+
+
+observables_binary_sink::~observables_binary_sink()
+{
+    if (d_file.is_open())
+        {
+            try
+                {
+                    d_file.close();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Problem closing the observables binary stream: " << e.what();
+                }
+        }
+}
+
+
+int observables_binary_sink::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    if (!d_file.is_open())
+        {
+            return noutput_items;
+        }
+    const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);
+    d_buffer.clear();
+    for (int epoch = 0; epoch < noutput_items; epoch++)
+        {
+            if (d_epoch_counter++ % d_decimation_factor != 0)
+                {
+                    continue;
+                }
+            d_epoch.clear();
+            for (int ch = 0; ch < d_nchannels; ch++)
+                {
+                    if (in[ch][epoch].Flag_valid_pseudorange)
+                        {
+                            d_epoch.push_back(in[ch][epoch]);
+                        }
+                }
+            if (!d_epoch.empty())
+                {
+                    d_serdes.serialize(d_epoch, d_epoch.front().RX_time, d_buffer);
+                }
+        }
+    if (!d_buffer.empty())
+        {
+            try
+                {
+                    d_file.write(reinterpret_cast<const char*>(d_buffer.data()), static_cast<std::streamsize>(d_buffer.size()));
+                }
+            catch (const std::ofstream::failure& e)
+                {
+                    LOG(WARNING) << "Problem writing the observables binary stream, closing it: " << e.what();
+                    d_file.exceptions(std::ofstream::goodbit);
+                    d_file.close();
+                }
+        }
+    return noutput_items;
+}
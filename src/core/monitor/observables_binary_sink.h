@@ -0,0 +1,82 @@
+/*!
+ * \file observables_binary_sink.h
+ * \brief GNU Radio block that streams the observables of every epoch to a
+ * file in a compact binary format
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBSERVABLES_BINARY_SINK_H
+#define GNSS_SDR_OBSERVABLES_BINARY_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_synchro.h"
+#include "serdes_observables_binary.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+class observables_binary_sink;
+
+using observables_binary_sink_sptr = gnss_shared_ptr<observables_binary_sink>;
+
+observables_binary_sink_sptr observables_make_binary_sink(int n_channels,
+    int decimation_factor,
+    const std::string& filename);
+
+/*!
+ * \brief This class implements a block that writes the valid observables
+ * of each epoch (or of one every decimation_factor epochs) to a file or a
+ * named pipe, serialized by Serdes_Observables_Binary.
+ *
+ * It takes the outputs of the Observables block in parallel to the PVT
+ * block, so the rate of the stream does not depend on the PVT output rate.
+ */
+class observables_binary_sink : public gr::sync_block
+{
+public:
+    ~observables_binary_sink();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend observables_binary_sink_sptr observables_make_binary_sink(int n_channels,
+        int decimation_factor,
+        const std::string& filename);
+
+    observables_binary_sink(int n_channels,
+        int decimation_factor,
+        const std::string& filename);
+
+    Serdes_Observables_Binary d_serdes;
+    std::vector<Gnss_Synchro> d_epoch;
+    std::vector<uint8_t> d_buffer;
+    std::ofstream d_file;
+    uint64_t d_epoch_counter;
+    int d_nchannels;
+    int d_decimation_factor;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBSERVABLES_BINARY_SINK_H
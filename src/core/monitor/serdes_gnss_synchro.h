@@ -18,6 +18,7 @@
 #ifndef GNSS_SDR_SERDES_GNSS_SYNCHRO_H
 #define GNSS_SDR_SERDES_GNSS_SYNCHRO_H
 
+#include "channel_stats.h"
 #include "gnss_synchro.h"
 #include "gnss_synchro.pb.h"  // file created by Protocol Buffers at compile time
 #include <array>
@@ -71,9 +72,19 @@ public:
 
     inline std::string createProtobuffer(const std::vector<Gnss_Synchro>& vgs)  //!< Serialization into a string
     {
-        observables.Clear();
         std::string data;
-        for (auto gs : vgs)
+        createProtobuffer(vgs, data);
+        return data;
+    }
+
+    /*!
+     * \brief Serialization into data, which keeps its capacity from one call
+     * to the next
+     */
+    inline void createProtobuffer(const std::vector<Gnss_Synchro>& vgs, std::string& data)
+    {
+        observables.Clear();
+        for (const auto& gs : vgs)
             {
                 gnss_sdr::GnssSynchro* obs = observables.add_observable();
                 char c = gs.System;
@@ -116,7 +127,34 @@ public:
                 obs->set_interp_tow_ms(gs.interp_TOW_ms);
             }
         observables.SerializeToString(&data);
-        return data;
+    }
+
+    /*!
+     * \brief Serialization of Channel_Stats objects into data, which keeps its
+     * capacity from one call to the next
+     */
+    inline void createProtobuffer(const std::vector<Channel_Stats>& vstats, std::string& data)
+    {
+        channel_stats.Clear();
+        for (const auto& cs : vstats)
+            {
+                gnss_sdr::ChannelStats* stats = channel_stats.add_stats();
+                stats->set_system(std::string(1, cs.System));
+                stats->set_signal(std::string(cs.Signal, 2));
+                stats->set_prn(cs.PRN);
+                stats->set_channel_id(cs.Channel_ID);
+                stats->set_items(cs.Items);
+                stats->set_locked_items(cs.Locked_items);
+                stats->set_cycle_slips(cs.Cycle_slips);
+                stats->set_start_time_s(cs.Start_time_s);
+                stats->set_duration_s(cs.Duration_s);
+                stats->set_lock_ratio(cs.Lock_ratio);
+                stats->set_cn0_mean_db_hz(cs.CN0_mean_dB_hz);
+                stats->set_cn0_min_db_hz(cs.CN0_min_dB_hz);
+                stats->set_cn0_max_db_hz(cs.CN0_max_dB_hz);
+                stats->set_doppler_rate_hz_s(cs.Doppler_rate_hz_s);
+            }
+        channel_stats.SerializeToString(&data);
     }
 
     inline std::vector<Gnss_Synchro> readProtobuffer(const gnss_sdr::Observables& obs) const  //!< Deserialization
@@ -167,6 +205,7 @@ public:
 
 private:
     gnss_sdr::Observables observables{};
+    gnss_sdr::ChannelStatsList channel_stats{};  // scratch message, not copied
 };
 
 #endif  // GNSS_SDR_SERDES_GNSS_SYNCHRO_H
@@ -0,0 +1,181 @@
+/*!
+ * \file serdes_observables_binary.h
+ * \brief Serialization / Deserialization of epochs of observables in a
+ * compact binary format
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SERDES_OBSERVABLES_BINARY_H
+#define GNSS_SDR_SERDES_OBSERVABLES_BINARY_H
+
+#include "gnss_synchro.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+/*!
+ * \brief This class implements serialization and deserialization of epochs
+ * of observables into fixed-size little-endian records, cheap enough to
+ * stream every observable epoch at high rates.
+ *
+ * An epoch is a 16 bytes header:
+ *   uint32 magic "GOBS", uint16 format version, uint16 number of observables,
+ *   uint64 receiver time [ns]
+ * followed by a 48 bytes record per observable:
+ *   char System, char Signal[2], uint8 flags (bit 0: valid pseudorange,
+ *   bit 1: valid word, bit 2: PLL 180 deg. locked), uint16 PRN,
+ *   uint16 Channel_ID, and the doubles Pseudorange_m, Carrier_phase_rads,
+ *   Carrier_Doppler_hz, CN0_dB_hz and interp_TOW_ms.
+ */
+class Serdes_Observables_Binary
+{
+public:
+    static constexpr uint32_t MAGIC = 0x53424F47;  // "GOBS"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t RECORD_SIZE = 48;
+
+    /*!
+     * \brief Appends an epoch with the given observables to buffer
+     */
+    inline void serialize(const std::vector<Gnss_Synchro>& observables, double rx_time_s, std::vector<uint8_t>& buffer) const
+    {
+        const size_t start = buffer.size();
+        buffer.resize(start + HEADER_SIZE + RECORD_SIZE * observables.size());
+        uint8_t* p = buffer.data() + start;
+        p = put(p, MAGIC);
+        p = put(p, VERSION);
+        p = put(p, static_cast<uint16_t>(observables.size()));
+        p = put(p, static_cast<uint64_t>(rx_time_s * 1e9 + 0.5));
+        for (const auto& gs : observables)
+            {
+                *p++ = static_cast<uint8_t>(gs.System);
+                *p++ = static_cast<uint8_t>(gs.Signal[0]);
+                *p++ = static_cast<uint8_t>(gs.Signal[1]);
+                *p++ = static_cast<uint8_t>((gs.Flag_valid_pseudorange ? 1U : 0U) |
+                                            (gs.Flag_valid_word ? 2U : 0U) |
+                                            (gs.Flag_PLL_180_deg_phase_locked ? 4U : 0U));
+                p = put(p, static_cast<uint16_t>(gs.PRN));
+                p = put(p, static_cast<uint16_t>(gs.Channel_ID));
+                p = put(p, gs.Pseudorange_m);
+                p = put(p, gs.Carrier_phase_rads);
+                p = put(p, gs.Carrier_Doppler_hz);
+                p = put(p, gs.CN0_dB_hz);
+                p = put(p, gs.interp_TOW_ms);
+            }
+    }
+
+    /*!
+     * \brief Reads an epoch from data. Returns the number of bytes read, or 0
+     * if data does not start with a complete epoch.
+     */
+    inline size_t deserialize(const uint8_t* data, size_t size, std::vector<Gnss_Synchro>& observables, double& rx_time_s) const
+    {
+        if (size < HEADER_SIZE)
+            {
+                return 0;
+            }
+        uint32_t magic;
+        uint16_t version;
+        uint16_t nobs;
+        uint64_t rx_time_ns;
+        const uint8_t* p = get(data, magic);
+        p = get(p, version);
+        p = get(p, nobs);
+        p = get(p, rx_time_ns);
+        const size_t epoch_size = HEADER_SIZE + RECORD_SIZE * nobs;
+        if (magic != MAGIC || version != VERSION || size < epoch_size)
+            {
+                return 0;
+            }
+        rx_time_s = static_cast<double>(rx_time_ns) / 1e9;
+        observables = std::vector<Gnss_Synchro>(nobs);
+        for (auto& gs : observables)
+            {
+                gs.System = static_cast<char>(*p++);
+                gs.Signal[0] = static_cast<char>(*p++);
+                gs.Signal[1] = static_cast<char>(*p++);
+                const uint8_t flags = *p++;
+                gs.Flag_valid_pseudorange = (flags & 1U) != 0;
+                gs.Flag_valid_word = (flags & 2U) != 0;
+                gs.Flag_PLL_180_deg_phase_locked = (flags & 4U) != 0;
+                uint16_t prn;
+                uint16_t channel_id;
+                p = get(p, prn);
+                p = get(p, channel_id);
+                gs.PRN = prn;
+                gs.Channel_ID = channel_id;
+                p = get(p, gs.Pseudorange_m);
+                p = get(p, gs.Carrier_phase_rads);
+                p = get(p, gs.Carrier_Doppler_hz);
+                p = get(p, gs.CN0_dB_hz);
+                p = get(p, gs.interp_TOW_ms);
+                gs.RX_time = rx_time_s;
+            }
+        return epoch_size;
+    }
+
+private:
+    template <typename T>
+    static inline uint8_t* put_le(uint8_t* p, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+            {
+                *p++ = static_cast<uint8_t>(value >> (8 * i));
+            }
+        return p;
+    }
+
+    template <typename T>
+    static inline const uint8_t* get_le(const uint8_t* p, T& value)
+    {
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+            {
+                value |= static_cast<T>(static_cast<T>(*p++) << (8 * i));
+            }
+        return p;
+    }
+
+    static inline uint8_t* put(uint8_t* p, uint16_t value) { return put_le(p, value); }
+    static inline uint8_t* put(uint8_t* p, uint32_t value) { return put_le(p, value); }
+    static inline uint8_t* put(uint8_t* p, uint64_t value) { return put_le(p, value); }
+    static inline uint8_t* put(uint8_t* p, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return put_le(p, bits);
+    }
+
+    static inline const uint8_t* get(const uint8_t* p, uint16_t& value) { return get_le(p, value); }
+    static inline const uint8_t* get(const uint8_t* p, uint32_t& value) { return get_le(p, value); }
+    static inline const uint8_t* get(const uint8_t* p, uint64_t& value) { return get_le(p, value); }
+    static inline const uint8_t* get(const uint8_t* p, double& value)
+    {
+        uint64_t bits;
+        p = get_le(p, bits);
+        std::memcpy(&value, &bits, sizeof(value));
+        return p;
+    }
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SERDES_OBSERVABLES_BINARY_H
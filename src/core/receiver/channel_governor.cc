@@ -0,0 +1,113 @@
+/*!
+ * \file channel_governor.cc
+ * \brief Chooses the tracking channels to put on standby when the receiver
+ * cannot keep up with a live signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "channel_governor.h"
+#include "MATH_CONSTANTS.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+const Pvt_Satellite_Contribution* find_contribution(const Channel_Governor::Channel& channel,
+    const std::vector<Pvt_Satellite_Contribution>& contributions)
+{
+    for (const auto& contribution : contributions)
+        {
+            if (contribution.system == channel.system and contribution.prn == channel.prn)
+                {
+                    return &contribution;
+                }
+        }
+    return nullptr;
+}
+}  // namespace
+
+
+double Channel_Governor::utility(const Channel& channel, const std::vector<Pvt_Satellite_Contribution>& contributions)
+{
+    const double cn0_term = std::min(std::max((channel.cn0_db_hz - 25.0) / 25.0, 0.0), 1.0);
+    double elevation_term = 0.0;
+    double dop_term = 0.0;
+    const Pvt_Satellite_Contribution* contribution = find_contribution(channel, contributions);
+    if (contribution != nullptr)
+        {
+            elevation_term = std::max(std::sin(contribution->elevation_deg * D2R), 0.0);
+            if (contribution->gdop_without <= 0.0)
+                {
+                    dop_term = 1.0;  // there would be no fix without it
+                }
+            else if (contribution->gdop > 0.0)
+                {
+                    dop_term = std::min(std::max(4.0 * (contribution->gdop_without / contribution->gdop - 1.0), 0.0), 1.0);
+                }
+        }
+    return (cn0_term + elevation_term + dop_term) / 3.0;
+}
+
+
+bool Channel_Governor::is_essential(const Channel& channel, const std::vector<Pvt_Satellite_Contribution>& contributions)
+{
+    const Pvt_Satellite_Contribution* contribution = find_contribution(channel, contributions);
+    return contribution != nullptr and contribution->gdop > 0.0 and contribution->gdop_without <= 0.0;
+}
+
+
+int Channel_Governor::select_standby(const std::vector<Channel>& channels, const std::vector<Pvt_Satellite_Contribution>& contributions)
+{
+    // work time of each channel since the last selection
+    std::vector<double> work_s(channels.size(), 0.0);
+    double total_work_s = 0.0;
+    size_t timed = 0;
+    for (size_t i = 0; i < channels.size(); i++)
+        {
+            const auto it = d_last_work_ns.find(channels[i].id);
+            if (it != d_last_work_ns.end() and channels[i].work_ns > it->second)
+                {
+                    work_s[i] = static_cast<double>(channels[i].work_ns - it->second) * 1e-9;
+                    total_work_s += work_s[i];
+                    timed++;
+                }
+        }
+    d_last_work_ns.clear();
+    for (const auto& channel : channels)
+        {
+            d_last_work_ns[channel.id] = channel.work_ns;
+        }
+    const double mean_work_s = timed > 0 ? total_work_s / static_cast<double>(timed) : 0.0;
+
+    int selected = -1;
+    double lowest_score = 0.0;
+    for (size_t i = 0; i < channels.size(); i++)
+        {
+            if (is_essential(channels[i], contributions))
+                {
+                    continue;
+                }
+            double cost = 1.0;
+            if (mean_work_s > 0.0 and work_s[i] > 0.0)
+                {
+                    cost = std::min(std::max(work_s[i] / mean_work_s, 0.25), 4.0);
+                }
+            const double score = utility(channels[i], contributions) / cost;
+            if (selected < 0 or score < lowest_score)
+                {
+                    selected = channels[i].id;
+                    lowest_score = score;
+                }
+        }
+    return selected;
+}
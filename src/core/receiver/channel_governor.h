@@ -0,0 +1,84 @@
+/*!
+ * \file channel_governor.h
+ * \brief Chooses the tracking channels to put on standby when the receiver
+ * cannot keep up with a live signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNEL_GOVERNOR_H
+#define GNSS_SDR_CHANNEL_GOVERNOR_H
+
+#include "pvt_interface.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Ranks the tracking channels by their utility for the position fix
+ * per unit of CPU time, so that the load shedding stops the channels that
+ * cost the most for what they give, and keeps a fix under overload.
+ *
+ * The utility of a channel (0 to 1) is the mean of three terms:
+ * - its C/N0, from 0 at 25 dB-Hz to 1 at 50 dB-Hz;
+ * - the sine of the elevation of its satellite, if used in the last fix;
+ * - the increase of the GDOP of the last fix without its satellite, with 1
+ *   for an increase of 25 % or more.
+ *
+ * A channel whose satellite cannot be removed without losing the fix is
+ * never chosen. The CPU time of a channel is the work time of its tracking
+ * block between two selections (see GNSS-SDR.enable_block_stats): the
+ * utility is divided by the ratio of that time to the mean one, limited to
+ * [0.25, 4]. Without work times, the channels are ranked by utility only.
+ */
+class Channel_Governor
+{
+public:
+    struct Channel
+    {
+        int id{0};
+        char system{0};  //!< 'G', 'R', 'E' or 'C'
+        uint32_t prn{0};
+        double cn0_db_hz{0.0};
+        uint64_t work_ns{0};  //!< total work time of its tracking block, 0 if unknown
+    };
+
+    /*!
+     * \brief Utility of a channel for the fix described by contributions
+     */
+    static double utility(const Channel& channel, const std::vector<Pvt_Satellite_Contribution>& contributions);
+
+    /*!
+     * \brief True if the fix would be lost without the satellite of the channel
+     */
+    static bool is_essential(const Channel& channel, const std::vector<Pvt_Satellite_Contribution>& contributions);
+
+    /*!
+     * \brief Returns the id of the tracking channel to put on standby, or -1
+     * if all of them are essential. Also records the work times of the
+     * channels for the next call.
+     */
+    int select_standby(const std::vector<Channel>& channels, const std::vector<Pvt_Satellite_Contribution>& contributions);
+
+private:
+    std::map<int, uint64_t> d_last_work_ns;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CHANNEL_GOVERNOR_H
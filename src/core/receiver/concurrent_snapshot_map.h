@@ -0,0 +1,125 @@
+/*!
+ * \file concurrent_snapshot_map.h
+ * \brief Interface of a std::map published as immutable, versioned snapshots
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CONCURRENT_SNAPSHOT_MAP_H
+#define GNSS_SDR_CONCURRENT_SNAPSHOT_MAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief This class implements a std::map with copy-on-write updates.
+ *
+ * Readers take a snapshot, a shared pointer to an immutable version of the
+ * map, which stays valid (and unchanged) for as long as they hold it. They
+ * never wait for writers nor copy the map. Writers are serialized, build the
+ * next version from the current one and publish it atomically, so a reader
+ * sees either the whole update or none of it. The old version is released
+ * when its last reader drops it.
+ *
+ * Updates cost a copy of the map, which is cheap for the ones it is intended
+ * for (a few dozens of satellites, updated every few seconds at most).
+ */
+template <typename Data>
+class Concurrent_Snapshot_Map
+{
+public:
+    using Map = std::map<int, Data>;
+    using Snapshot = std::shared_ptr<const Map>;
+
+    Concurrent_Snapshot_Map() : d_map(std::make_shared<const Map>())
+    {
+    }
+
+    /*!
+     * \brief Current version of the map
+     */
+    Snapshot snapshot() const
+    {
+        return std::atomic_load(&d_map);
+    }
+
+    /*!
+     * \brief Number of updates published so far
+     */
+    uint64_t version() const
+    {
+        return d_version.load(std::memory_order_acquire);
+    }
+
+    bool read(int key, Data& data) const
+    {
+        const Snapshot map = snapshot();
+        const auto it = map->find(key);
+        if (it == map->cend())
+            {
+                return false;
+            }
+        data = it->second;
+        return true;
+    }
+
+    void write(int key, const Data& data)
+    {
+        std::lock_guard<std::mutex> lock(d_writer_mutex);
+        auto next = std::make_shared<Map>(*d_map);
+        (*next)[key] = data;
+        publish(std::move(next));
+    }
+
+    void erase(int key)
+    {
+        std::lock_guard<std::mutex> lock(d_writer_mutex);
+        if (d_map->count(key) == 0)
+            {
+                return;
+            }
+        auto next = std::make_shared<Map>(*d_map);
+        next->erase(key);
+        publish(std::move(next));
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(d_writer_mutex);
+        publish(std::make_shared<Map>());
+    }
+
+private:
+    void publish(std::shared_ptr<Map> next)
+    {
+        std::atomic_store(&d_map, Snapshot(std::move(next)));
+        d_version.fetch_add(1, std::memory_order_release);
+    }
+
+    Snapshot d_map;  // only replaced through std::atomic_store
+    std::atomic<uint64_t> d_version{0};
+    std::mutex d_writer_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CONCURRENT_SNAPSHOT_MAP_H
@@ -0,0 +1,342 @@
+/*!
+ * \file configuration_snapshot.cc
+ * \brief Configuration parameters with their values already converted to
+ * every supported type, and their binary cache
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "configuration_snapshot.h"
+#include <algorithm>  // for std::equal
+#include <cctype>     // for tolower
+#include <cstdio>     // for std::rename, std::remove
+#include <fstream>    // for ifstream, ofstream
+#include <sstream>    // for stringstream
+#include <utility>    // for std::move
+#include <vector>     // for vector
+
+
+namespace
+{
+enum Parsed_Type : uint16_t
+{
+    parsed_bool = 1 << 0,
+    parsed_int64 = 1 << 1,
+    parsed_uint64 = 1 << 2,
+    parsed_int32 = 1 << 3,
+    parsed_uint32 = 1 << 4,
+    parsed_int16 = 1 << 5,
+    parsed_uint16 = 1 << 6,
+    parsed_float = 1 << 7,
+    parsed_double = 1 << 8
+};
+
+const char CACHE_MAGIC[8] = {'G', 'N', 'S', 'S', 'C', 'F', 'G', '\0'};
+const uint32_t CACHE_VERSION = 1;
+
+
+// Same conversion as StringConverter
+template <typename T>
+bool parse_number(const std::string& text, T& result)
+{
+    std::stringstream stream(text);
+    stream >> result;
+    return !stream.fail();
+}
+
+
+template <typename T>
+void write_pod(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+
+template <typename T>
+bool read_pod(std::ifstream& file, T& value)
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+
+void write_string(std::ofstream& file, const std::string& text)
+{
+    write_pod(file, static_cast<uint32_t>(text.size()));
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+
+bool read_string(std::ifstream& file, std::string& text)
+{
+    uint32_t length = 0;
+    if (!read_pod(file, length) or length > (1U << 20))
+        {
+            return false;
+        }
+    text.resize(length);
+    return length == 0 or static_cast<bool>(file.read(&text[0], length));
+}
+}  // namespace
+
+
+Configuration_Snapshot::Entry::Entry(std::string text)
+    : d_text(std::move(text))
+{
+    if (d_text == "true" or d_text == "false")
+        {
+            d_values.boolean = (d_text == "true");
+            d_values.parsed |= parsed_bool;
+        }
+    int32_t int32 = 0;  // parsed as int, as StringConverter does
+    if (parse_number(d_text, d_values.int64))
+        {
+            d_values.parsed |= parsed_int64;
+        }
+    if (parse_number(d_text, d_values.uint64))
+        {
+            d_values.parsed |= parsed_uint64;
+        }
+    if (parse_number(d_text, int32))
+        {
+            d_values.int32 = int32;
+            d_values.parsed |= parsed_int32;
+        }
+    if (parse_number(d_text, d_values.uint32))
+        {
+            d_values.parsed |= parsed_uint32;
+        }
+    if (parse_number(d_text, d_values.int16))
+        {
+            d_values.parsed |= parsed_int16;
+        }
+    if (parse_number(d_text, d_values.uint16))
+        {
+            d_values.parsed |= parsed_uint16;
+        }
+    if (parse_number(d_text, d_values.float32))
+        {
+            d_values.parsed |= parsed_float;
+        }
+    if (parse_number(d_text, d_values.float64))
+        {
+            d_values.parsed |= parsed_double;
+        }
+}
+
+
+std::string Configuration_Snapshot::Entry::get(const std::string& default_value __attribute__((unused))) const
+{
+    return d_text;
+}
+
+
+bool Configuration_Snapshot::Entry::get(bool default_value) const
+{
+    return (d_values.parsed & parsed_bool) ? d_values.boolean : default_value;
+}
+
+
+int64_t Configuration_Snapshot::Entry::get(int64_t default_value) const
+{
+    return (d_values.parsed & parsed_int64) ? d_values.int64 : default_value;
+}
+
+
+uint64_t Configuration_Snapshot::Entry::get(uint64_t default_value) const
+{
+    return (d_values.parsed & parsed_uint64) ? d_values.uint64 : default_value;
+}
+
+
+int32_t Configuration_Snapshot::Entry::get(int32_t default_value) const
+{
+    return (d_values.parsed & parsed_int32) ? d_values.int32 : default_value;
+}
+
+
+uint32_t Configuration_Snapshot::Entry::get(uint32_t default_value) const
+{
+    return (d_values.parsed & parsed_uint32) ? d_values.uint32 : default_value;
+}
+
+
+int16_t Configuration_Snapshot::Entry::get(int16_t default_value) const
+{
+    return (d_values.parsed & parsed_int16) ? d_values.int16 : default_value;
+}
+
+
+uint16_t Configuration_Snapshot::Entry::get(uint16_t default_value) const
+{
+    return (d_values.parsed & parsed_uint16) ? d_values.uint16 : default_value;
+}
+
+
+float Configuration_Snapshot::Entry::get(float default_value) const
+{
+    return (d_values.parsed & parsed_float) ? d_values.float32 : default_value;
+}
+
+
+double Configuration_Snapshot::Entry::get(double default_value) const
+{
+    return (d_values.parsed & parsed_double) ? d_values.float64 : default_value;
+}
+
+
+size_t Configuration_Snapshot::Name_Hash::operator()(const std::string& name) const
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : name)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            hash ^= d_ignore_case ? static_cast<unsigned char>(std::tolower(byte)) : byte;
+            hash *= 1099511628211ULL;
+        }
+    return static_cast<size_t>(hash);
+}
+
+
+bool Configuration_Snapshot::Name_Equal::operator()(const std::string& lhs, const std::string& rhs) const
+{
+    if (!d_ignore_case)
+        {
+            return lhs == rhs;
+        }
+    if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+    for (size_t i = 0; i < lhs.size(); i++)
+        {
+            if (std::tolower(static_cast<unsigned char>(lhs[i])) != std::tolower(static_cast<unsigned char>(rhs[i])))
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+Configuration_Snapshot::Configuration_Snapshot(bool ignore_case)
+    : d_entries(64, Name_Hash(ignore_case), Name_Equal(ignore_case))
+{
+}
+
+
+const Configuration_Snapshot::Entry* Configuration_Snapshot::find(const std::string& name) const
+{
+    const auto it = d_entries.find(name);
+    return it == d_entries.end() ? nullptr : &it->second;
+}
+
+
+bool Configuration_Snapshot::insert(const std::string& name, const std::string& value)
+{
+    if (d_entries.count(name) != 0)
+        {
+            return false;
+        }
+    d_entries.emplace(name, Entry(value));
+    return true;
+}
+
+
+void Configuration_Snapshot::supersede(const std::string& name, const std::string& value)
+{
+    d_entries.erase(name);
+    d_entries.emplace(name, Entry(value));
+}
+
+
+bool Configuration_Snapshot::save(const std::string& filename, uint64_t source_size, uint64_t source_hash) const
+{
+    // Write to a temporary file and rename it, so that a receiver starting at
+    // the same time never reads half a cache
+    const std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            {
+                return false;
+            }
+        file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        write_pod(file, CACHE_VERSION);
+        write_pod(file, static_cast<uint32_t>(sizeof(Entry::Values)));
+        write_pod(file, source_size);
+        write_pod(file, source_hash);
+        write_pod(file, static_cast<uint64_t>(d_entries.size()));
+        for (const auto& entry : d_entries)
+            {
+                write_string(file, entry.first);
+                write_string(file, entry.second.d_text);
+                write_pod(file, entry.second.d_values);
+            }
+        if (!file.good())
+            {
+                file.close();
+                std::remove(tmp_filename.c_str());
+                return false;
+            }
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    return true;
+}
+
+
+bool Configuration_Snapshot::load(const std::string& filename, uint64_t source_size, uint64_t source_hash)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        {
+            return false;
+        }
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t version = 0;
+    uint32_t values_size = 0;
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    uint64_t count = 0;
+    if (!file.read(magic, sizeof(magic)) or !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC) or
+        !read_pod(file, version) or version != CACHE_VERSION or
+        !read_pod(file, values_size) or values_size != sizeof(Entry::Values) or
+        !read_pod(file, size) or size != source_size or
+        !read_pod(file, hash) or hash != source_hash or
+        !read_pod(file, count))
+        {
+            return false;
+        }
+
+    std::vector<std::pair<std::string, Entry>> entries;
+    for (uint64_t n = 0; n < count; n++)
+        {
+            std::string name;
+            Entry entry;
+            if (!read_string(file, name) or !read_string(file, entry.d_text) or !read_pod(file, entry.d_values))
+                {
+                    return false;
+                }
+            entries.emplace_back(std::move(name), std::move(entry));
+        }
+
+    d_entries.clear();
+    d_entries.reserve(entries.size());
+    for (auto& entry : entries)
+        {
+            d_entries.emplace(std::move(entry.first), std::move(entry.second));
+        }
+    return true;
+}
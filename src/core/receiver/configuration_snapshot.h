@@ -0,0 +1,153 @@
+/*!
+ * \file configuration_snapshot.h
+ * \brief Configuration parameters with their values already converted to
+ * every supported type, and their binary cache
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CONFIGURATION_SNAPSHOT_H
+#define GNSS_SDR_CONFIGURATION_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Set of configuration parameters, looked up by name in constant time.
+ *
+ * Each value is converted to every type of ConfigurationInterface::property()
+ * when it is stored, so a lookup is a hash of the name and a copy of the
+ * value, with no parsing. Names are compared without copying them, either
+ * exactly or ignoring case (the INI file convention).
+ */
+class Configuration_Snapshot
+{
+public:
+    /*!
+     * \brief Value of a parameter, as text and converted to each type.
+     */
+    class Entry
+    {
+    public:
+        explicit Entry(std::string text);
+
+        const std::string& text() const { return d_text; }
+        std::string get(const std::string& default_value) const;
+        bool get(bool default_value) const;
+        int64_t get(int64_t default_value) const;
+        uint64_t get(uint64_t default_value) const;
+        int32_t get(int32_t default_value) const;
+        uint32_t get(uint32_t default_value) const;
+        int16_t get(int16_t default_value) const;
+        uint16_t get(uint16_t default_value) const;
+        float get(float default_value) const;
+        double get(double default_value) const;
+
+    private:
+        friend class Configuration_Snapshot;
+        Entry() = default;
+
+        // trivially copyable, so that it is stored as is in the binary cache
+        struct Values
+        {
+            int64_t int64;
+            uint64_t uint64;
+            double float64;
+            int32_t int32;
+            uint32_t uint32;
+            float float32;
+            int16_t int16;
+            uint16_t uint16;
+            uint16_t parsed;  // bit mask of the types the text converts to
+            bool boolean;
+        };
+
+        std::string d_text;
+        Values d_values{};
+    };
+
+    explicit Configuration_Snapshot(bool ignore_case = false);
+
+    /*!
+     * \brief Returns the value of the parameter, or nullptr if it is not set.
+     */
+    const Entry* find(const std::string& name) const;
+
+    template <typename T>
+    T property(const std::string& name, T default_value) const
+    {
+        const Entry* entry = find(name);
+        return entry == nullptr ? default_value : entry->get(default_value);
+    }
+
+    /*!
+     * \brief Sets the parameter, unless it is already set. Returns false if
+     * it was.
+     */
+    bool insert(const std::string& name, const std::string& value);
+
+    /*!
+     * \brief Sets the parameter, replacing its previous value if any.
+     */
+    void supersede(const std::string& name, const std::string& value);
+
+    size_t size() const { return d_entries.size(); }
+    bool empty() const { return d_entries.empty(); }
+
+    /*!
+     * \brief Writes the parameters to a binary file, tagged with the size
+     * and a hash of the contents of the file they were read from.
+     */
+    bool save(const std::string& filename, uint64_t source_size, uint64_t source_hash) const;
+
+    /*!
+     * \brief Reads the parameters from a binary file written by save(). Fails,
+     * leaving the snapshot unchanged, if the file does not exist, is corrupted
+     * or was written from other contents of the source file.
+     */
+    bool load(const std::string& filename, uint64_t source_size, uint64_t source_hash);
+
+private:
+    class Name_Hash
+    {
+    public:
+        explicit Name_Hash(bool ignore_case) : d_ignore_case(ignore_case) {}
+        size_t operator()(const std::string& name) const;
+
+    private:
+        bool d_ignore_case;
+    };
+
+    class Name_Equal
+    {
+    public:
+        explicit Name_Equal(bool ignore_case) : d_ignore_case(ignore_case) {}
+        bool operator()(const std::string& lhs, const std::string& rhs) const;
+
+    private:
+        bool d_ignore_case;
+    };
+
+    std::unordered_map<std::string, Entry, Name_Hash, Name_Equal> d_entries;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CONFIGURATION_SNAPSHOT_H
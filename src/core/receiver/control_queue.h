@@ -0,0 +1,68 @@
+/*!
+ * \file control_queue.h
+ * \brief Messages of the control plane and the queue that carries them to
+ * the ControlThread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CONTROL_QUEUE_H
+#define GNSS_SDR_CONTROL_QUEUE_H
+
+#include "mpsc_queue.h"
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Message sent to the ControlThread. A plain record, passed by value.
+ */
+struct Control_Message
+{
+    enum Type : int32_t
+    {
+        channel_event,  //!< From a channel: id is the channel ID. event_type 0: acquisition failed, 1: acquisition succeeded, 2: loss of lock
+        command_event   //!< From the receiver: id 200 for the receiver itself, 300 for the telecommand interface, 400 + channel ID for the telecommand channel control
+    };
+
+    Type type;
+    int32_t id;
+    int32_t event_type;
+    int32_t value;  //!< Argument of the command, if any (e.g. the PRN of the satellite assigned to a channel)
+};
+
+
+inline Control_Message channel_event_make(int channel_id, int event_type)
+{
+    return Control_Message{Control_Message::channel_event, channel_id, event_type, 0};
+}
+
+
+inline Control_Message command_event_make(int command_id, int event_type, int value = 0)
+{
+    return Control_Message{Control_Message::command_event, command_id, event_type, value};
+}
+
+
+/*!
+ * \brief Queue of the control plane: every channel, signal source and the
+ * telecommand interface push to it, the ControlThread pops.
+ */
+using Control_Queue = Mpsc_Queue<Control_Message>;
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CONTROL_QUEUE_H
@@ -23,6 +23,8 @@
 #endif
 
 #include "control_thread.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S
+#include "agnss_assistance_data.h"
 #include "concurrent_map.h"
 #include "configuration_interface.h"
 #include "file_configuration.h"
@@ -34,8 +36,12 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_flowgraph.h"
+#include "gnss_frequencies.h"  // for FREQ1
+#include "gnss_nav_data_store.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include "gnss_sdr_trace.h"        // for Gnss_Sdr_Tracer
 #include "gps_acq_assist.h"        // for Gps_Acq_Assist
 #include "gps_almanac.h"           // for Gps_Almanac
 #include "gps_cnav_ephemeris.h"    // for Gps_CNAV_Ephemeris
@@ -54,7 +60,7 @@
 #include <pmt/pmt.h>               // for make_any
 #include <algorithm>               // for find, min
 #include <chrono>                  // for milliseconds
-#include <cmath>                   // for floor, fmod, log
+#include <cmath>                   // for floor, fmod, log, sqrt
 #include <ctime>                   // for time_t, gmtime, strftime
 #include <exception>               // for exception
 #include <iostream>                // for operator<<
@@ -69,26 +75,48 @@
 #include <boost/chrono.hpp>  // for steady_clock
 #endif
 
-#if PMT_USES_BOOST_ANY
-namespace wht = boost;
-#else
-namespace wht = std;
-#endif
-
 extern Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
 extern Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 
+namespace
+{
+// Refresh period of the Doppler predictions used by the assisted acquisition
+const std::chrono::seconds DOPPLER_PREDICTION_PERIOD{10};
+
+// Refresh period of the predicted visibility of the satellites
+const std::chrono::seconds VISIBILITY_SCHEDULE_PERIOD{10};
+
+
+// Line of sight from r_eb_e to a satellite at r_sat
+std::array<double, 3> line_of_sight(const std::array<double, 3> &r_eb_e, const std::array<double, 3> &r_sat)
+{
+    return {r_sat[0] - r_eb_e[0], r_sat[1] - r_eb_e[1], r_sat[2] - r_eb_e[2]};
+}
+
+
+// Doppler shift at the L1/E1 frequency of a satellite observed from r_eb_e, given
+// two positions of the satellite one second apart
+double predicted_l1_doppler(const std::array<double, 3> &r_eb_e, const std::array<double, 3> &r_sat, const std::array<double, 3> &r_sat_next)
+{
+    const std::array<double, 3> los = line_of_sight(r_eb_e, r_sat);
+    const std::array<double, 3> los_next = line_of_sight(r_eb_e, r_sat_next);
+    const double range = std::sqrt(los[0] * los[0] + los[1] * los[1] + los[2] * los[2]);
+    const double range_next = std::sqrt(los_next[0] * los_next[0] + los_next[1] * los_next[1] + los_next[2] * los_next[2]);
+    return -(range_next - range) * FREQ1 / SPEED_OF_LIGHT_M_S;
+}
+}  // namespace
+
 
 ControlThread::ControlThread()
+    : ControlThread(FLAGS_c == "-" ? FLAGS_config_file : FLAGS_c, FLAGS_config_cache, false)
 {
-    if (FLAGS_c == "-")
-        {
-            configuration_ = std::make_shared<FileConfiguration>(FLAGS_config_file);
-        }
-    else
-        {
-            configuration_ = std::make_shared<FileConfiguration>(FLAGS_c);
-        }
+}
+
+
+ControlThread::ControlThread(const std::string &config_file, const std::string &config_cache, bool hosted)
+    : hosted_(hosted)
+{
+    configuration_ = std::make_shared<FileConfiguration>(config_file, config_cache);
     // Basic configuration checks
     auto aux = std::dynamic_pointer_cast<FileConfiguration>(configuration_);
     conf_file_has_section_ = aux->has_section();
@@ -136,7 +164,8 @@ ControlThread::ControlThread(std::shared_ptr<ConfigurationInterface> configurati
       conf_has_signal_sources_(true),
       conf_has_observables_(true),
       conf_has_pvt_(true),
-      restart_(false)
+      restart_(false),
+      hosted_(false)
 {
     init();
 }
@@ -145,10 +174,16 @@ ControlThread::ControlThread(std::shared_ptr<ConfigurationInterface> configurati
 void ControlThread::init()
 {
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
+    enable_assisted_acquisition_ = configuration_->property("GNSS-SDR.assisted_acquisition", false);
+    enable_visibility_scheduler_ = configuration_->property("GNSS-SDR.visibility_scheduler", false);
+    visibility_elevation_mask_deg_ = configuration_->property("GNSS-SDR.visibility_elevation_mask_deg", 0.0);
+    visibility_lookahead_s_ = configuration_->property("GNSS-SDR.visibility_lookahead_s", 600.0);
+    last_doppler_prediction_time_ = std::chrono::steady_clock::time_point();
+    last_visibility_schedule_time_ = std::chrono::steady_clock::time_point();
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
-    control_queue_ = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    control_queue_ = std::make_shared<Control_Queue>();
     cmd_interface_.set_msg_queue(control_queue_);  // set also the queue pointer for the telecommand thread
     if (well_formatted_configuration_)
         {
@@ -276,57 +311,81 @@ void ControlThread::telecommand_listener()
 }
 
 
-void ControlThread::event_dispatcher(bool &valid_event, pmt::pmt_t &msg)
+void ControlThread::event_dispatcher(bool &valid_event, Control_Message &msg)
 {
     if (valid_event)
         {
-            processed_control_messages_++;
-            const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
-            if (msg_type_hash_code == channel_event_type_hash_code_)
+            // Drain the queue, so that the flow graph applies all the pending
+            // channel events and reassigns satellites in a single pass
+            do
                 {
-                    if (receiver_on_standby_ == false)
+                    processed_control_messages_++;
+                    if (msg.type == Control_Message::channel_event)
                         {
-                            const auto new_event = wht::any_cast<channel_event_sptr>(pmt::any_ref(msg));
-                            DLOG(INFO) << "New channel event rx from ch id: " << new_event->channel_id
-                                       << " what: " << new_event->event_type;
-                            flowgraph_->apply_action(new_event->channel_id, new_event->event_type);
+                            if (receiver_on_standby_ == false)
+                                {
+                                    DLOG(INFO) << "New channel event rx from ch id: " << msg.id
+                                               << " what: " << msg.event_type;
+                                    channel_events_.emplace_back(msg.id, msg.event_type);
+                                }
                         }
-                }
-            else if (msg_type_hash_code == command_event_type_hash_code_)
-                {
-                    const auto new_event = wht::any_cast<command_event_sptr>(pmt::any_ref(msg));
-                    DLOG(INFO) << "New command event rx from ch id: " << new_event->command_id
-                               << " what: " << new_event->event_type;
-
-                    if (new_event->command_id == 200)
+                    else if (msg.type == Control_Message::command_event)
                         {
-                            apply_action(new_event->event_type);
+                            // commands see the effect of the channel events received before them
+                            apply_channel_events();
+                            DLOG(INFO) << "New command event rx from ch id: " << msg.id
+                                       << " what: " << msg.event_type;
+
+                            if (msg.id == 200)
+                                {
+                                    apply_action(msg.event_type);
+                                }
+                            else
+                                {
+                                    if (msg.id == 300)  // some TC commands require also actions from control_thread
+                                        {
+                                            apply_action(msg.event_type);
+                                        }
+                                    flowgraph_->apply_action(msg.id, msg.event_type, msg.value);
+                                }
                         }
                     else
                         {
-                            if (new_event->command_id == 300)  // some TC commands require also actions from control_thread
-                                {
-                                    apply_action(new_event->event_type);
-                                }
-                            flowgraph_->apply_action(new_event->command_id, new_event->event_type);
+                            DLOG(INFO) << "Control Queue: unknown object type!\n";
                         }
                 }
-            else
-                {
-                    DLOG(INFO) << "Control Queue: unknown object type!\n";
-                }
+            while (!stop_ && control_queue_->try_pop(msg));
+            apply_channel_events();
         }
     else
         {
             if (receiver_on_standby_ == false)
                 {
                     // perform non-priority tasks
+                    if (enable_visibility_scheduler_)
+                        {
+                            update_visibility_schedule();  // also refreshes the Doppler predictions
+                        }
+                    else if (enable_assisted_acquisition_)
+                        {
+                            update_doppler_predictions();
+                        }
                     flowgraph_->acquisition_manager(0);  // start acquisition of untracked satellites
                 }
         }
 }
 
 
+void ControlThread::apply_channel_events()
+{
+    if (!channel_events_.empty())
+        {
+            flowgraph_->apply_channel_actions(channel_events_);
+            channel_events_.clear();
+        }
+}
+
+
 /*
  * Runs the control thread that manages the receiver control plane
  *
@@ -361,6 +420,16 @@ int ControlThread::run()
         {
             return 0;
         }
+    const std::string trace_file = configuration_->property("GNSS-SDR.trace_file", std::string(""));
+    if (!trace_file.empty())
+        {
+#if GNSS_SDR_ENABLE_TRACING
+            Gnss_Sdr_Tracer::instance().start(configuration_->property("GNSS-SDR.trace_max_events_per_thread", 1000000));
+#else
+            std::cout << "GNSS-SDR.trace_file is set, but this build does not record execution zones. Build with -DENABLE_TRACING=ON\n";
+#endif
+        }
+
     // Start the flowgraph
     flowgraph_->start();
     if (flowgraph_->running())
@@ -372,38 +441,91 @@ int ControlThread::run()
             return 0;
         }
 
-    // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs
-    assist_GNSS();
+    // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs.
+    // It runs in a thread of its own, so that the receiver does not wait for the SUPL server to start acquiring
+    assistance_thread_ = std::thread(&ControlThread::assist_GNSS, this);
     // start the keyboard_listener thread
-    if (FLAGS_keyboard)
+    if (FLAGS_keyboard && !hosted_)
         {
             keyboard_thread_ = std::thread(&ControlThread::keyboard_listener, this);
         }
-    sysv_queue_thread_ = std::thread(&ControlThread::sysv_queue_listener, this);
+    if (!hosted_)
+        {
+            sysv_queue_thread_ = std::thread(&ControlThread::sysv_queue_listener, this);
+        }
 
     // start the telecommand listener thread
     cmd_interface_.set_pvt(flowgraph_->get_pvt());
+    cmd_interface_.set_signal_source(flowgraph_->get_signal_source());
+    cmd_interface_.set_flowgraph(flowgraph_);
     cmd_interface_thread_ = std::thread(&ControlThread::telecommand_listener, this);
 
+    const int metrics_port = configuration_->property("GNSS-SDR.metrics_port", 0);
+    if (metrics_port > 0 and metrics_port < 65536)
+        {
+            const std::shared_ptr<GNSSFlowgraph> flowgraph = flowgraph_;
+            metrics_server_ = std::make_unique<Metrics_Http_Server>([flowgraph]() { return flowgraph->metrics_report(true); });
+            if (!metrics_server_->start(static_cast<uint16_t>(metrics_port)))
+                {
+                    std::cerr << "Unable to serve the receiver metrics on port " << metrics_port << '\n';
+                    metrics_server_.reset();
+                }
+        }
+
 #ifdef ENABLE_FPGA
     // Create a task for the acquisition such that id doesn't block the flow of the control thread
     fpga_helper_thread_ = boost::thread(&GNSSFlowgraph::start_acquisition_helper,
         flowgraph_);
 #endif
     // Main loop to read and process the control messages
-    pmt::pmt_t msg;
+    Control_Message msg{};
     while (flowgraph_->running() && !stop_)
         {
             // read event messages, triggered by event signaling with a 100 ms timeout to perform low priority receiver management tasks
             bool valid_event = control_queue_->timed_wait_and_pop(msg, 100);
             // call the new sat dispatcher and receiver controller
             event_dispatcher(valid_event, msg);
+            apply_assistance();
+            flowgraph_->check_realtime_headroom();
+            flowgraph_->save_tracking_checkpoint();
         }
     std::cout << "Stopping GNSS-SDR, please wait!\n";
+    if (metrics_server_ != nullptr)
+        {
+            metrics_server_->stop();
+        }
+    if (assistance_thread_.joinable())
+        {
+            if (!assistance_done_)
+                {
+                    std::cout << "Waiting for the SUPL server to answer...\n";
+                }
+            assistance_thread_.join();
+        }
     flowgraph_->stop();
     stop_ = true;
     flowgraph_->disconnect();
 
+#if GNSS_SDR_ENABLE_TRACING
+    if (!trace_file.empty())
+        {
+            if (Gnss_Sdr_Tracer::instance().save(trace_file))
+                {
+                    std::cout << "Execution zones written to " << trace_file;
+                    const auto dropped = Gnss_Sdr_Tracer::instance().dropped();
+                    if (dropped > 0)
+                        {
+                            std::cout << " (" << dropped << " zones dropped, see GNSS-SDR.trace_max_events_per_thread)";
+                        }
+                    std::cout << '\n';
+                }
+            else
+                {
+                    LOG(WARNING) << "Unable to write the execution zones to " << trace_file;
+                }
+        }
+#endif
+
 #ifdef ENABLE_FPGA
     // trigger a HW reset
     // The HW reset causes any HW accelerator module that is waiting for more samples to complete its calculations
@@ -414,7 +536,7 @@ int ControlThread::run()
 #endif
 
     // Terminate keyboard thread
-    if (FLAGS_keyboard && keyboard_thread_.joinable())
+    if (keyboard_thread_.joinable())
         {
             pthread_t id = keyboard_thread_.native_handle();
             keyboard_thread_.detach();
@@ -448,7 +570,7 @@ int ControlThread::run()
 }
 
 
-void ControlThread::set_control_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue)
+void ControlThread::set_control_queue(std::shared_ptr<Control_Queue> control_queue)
 {
     if (flowgraph_->running())
         {
@@ -460,9 +582,132 @@ void ControlThread::set_control_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_
 }
 
 
+void ControlThread::request_stop()
+{
+    control_queue_->push(command_event_make(200, 0));
+}
+
+
 /*
  * Returns true if reading was successful
  */
+bool ControlThread::read_assistance_from_files()
+{
+    const std::string binary_filename = configuration_->property("GNSS-SDR.AGNSS_binary_file", std::string(""));
+    if (!binary_filename.empty())
+        {
+            if (read_assistance_from_binary(binary_filename))
+                {
+                    return true;
+                }
+            std::cout << "Could not read the binary assistance file " << binary_filename << '\n';
+        }
+    return read_assistance_from_XML();
+}
+
+
+bool ControlThread::read_assistance_from_binary(const std::string &file_name)
+{
+    std::cout << "Trying to read GNSS ephemeris from binary file " << file_name << "...\n";
+    Agnss_Assistance_Data assistance;
+    if (!assistance.load(file_name))
+        {
+            return false;
+        }
+    bool ret = false;
+    if (configuration_->property("Channels_1C.count", 0) > 0)
+        {
+            for (const auto &eph : assistance.gps_ephemeris_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Ephemeris>(eph.second)));
+                }
+            for (const auto &alm : assistance.gps_almanac_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Almanac>(alm.second)));
+                }
+            if (assistance.gps_utc.valid == true)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Utc_Model>(assistance.gps_utc)));
+                }
+            if (assistance.gps_iono.valid == true)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Iono>(assistance.gps_iono)));
+                }
+            std::cout << "From binary file: Read " << assistance.gps_ephemeris_map.size() << " GPS NAV ephemeris and "
+                      << assistance.gps_almanac_map.size() << " almanacs.\n";
+            ret = ret or !assistance.gps_ephemeris_map.empty() or !assistance.gps_almanac_map.empty();
+        }
+
+    if ((configuration_->property("Channels_1B.count", 0) > 0) or (configuration_->property("Channels_5X.count", 0) > 0))
+        {
+            for (const auto &eph : assistance.gal_ephemeris_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Galileo_Ephemeris>(eph.second)));
+                }
+            for (const auto &alm : assistance.gal_almanac_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Galileo_Almanac>(alm.second)));
+                }
+            if (assistance.gal_iono.ai0 != 0.0)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Galileo_Iono>(assistance.gal_iono)));
+                }
+            if (assistance.gal_utc.A0 != 0.0)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Galileo_Utc_Model>(assistance.gal_utc)));
+                }
+            std::cout << "From binary file: Read " << assistance.gal_ephemeris_map.size() << " Galileo ephemeris and "
+                      << assistance.gal_almanac_map.size() << " almanacs.\n";
+            ret = ret or !assistance.gal_ephemeris_map.empty() or !assistance.gal_almanac_map.empty();
+        }
+
+    if ((configuration_->property("Channels_2S.count", 0) > 0) or (configuration_->property("Channels_L5.count", 0) > 0))
+        {
+            for (const auto &eph : assistance.gps_cnav_ephemeris_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_CNAV_Ephemeris>(eph.second)));
+                }
+            if (assistance.gps_cnav_utc.valid == true)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_CNAV_Utc_Model>(assistance.gps_cnav_utc)));
+                }
+            std::cout << "From binary file: Read " << assistance.gps_cnav_ephemeris_map.size() << " GPS CNAV ephemeris.\n";
+            ret = ret or !assistance.gps_cnav_ephemeris_map.empty();
+        }
+
+    if ((configuration_->property("Channels_1G.count", 0) > 0) or (configuration_->property("Channels_2G.count", 0) > 0))
+        {
+            for (const auto &eph : assistance.glonass_gnav_ephemeris_map)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Glonass_Gnav_Ephemeris>(eph.second)));
+                }
+            if (assistance.glo_gnav_utc.valid == true)
+                {
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Glonass_Gnav_Utc_Model>(assistance.glo_gnav_utc)));
+                }
+            std::cout << "From binary file: Read " << assistance.glonass_gnav_ephemeris_map.size() << " GLONASS GNAV ephemeris.\n";
+            ret = ret or !assistance.glonass_gnav_ephemeris_map.empty();
+        }
+
+    // Only look for {ref time, ref location} if SUPL is enabled
+    if (configuration_->property("GNSS-SDR.SUPL_gps_enabled", false) == true)
+        {
+            if (assistance.ref_time.valid == true)
+                {
+                    supl_client_acquisition_.gps_time = assistance.ref_time;
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Agnss_Ref_Time>(assistance.ref_time)));
+                }
+            if (assistance.ref_location.valid == true)
+                {
+                    supl_client_acquisition_.gps_ref_loc = assistance.ref_location;
+                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Agnss_Ref_Location>(assistance.ref_location)));
+                }
+        }
+
+    return ret;
+}
+
+
 bool ControlThread::read_assistance_from_XML()
 {
     // return variable (true == succeeded)
@@ -741,18 +986,48 @@ void ControlThread::assist_GNSS()
             if (SUPL_read_gps_assistance_xml == true)
                 {
                     // Read assistance from file
-                    if (read_assistance_from_XML())
+                    if (read_assistance_from_files())
                         {
-                            std::cout << "GNSS assistance data loaded from local XML file(s).\n";
+                            std::cout << "GNSS assistance data loaded from local file(s).\n";
                             std::cout << "No SUPL request has been performed.\n";
                         }
                 }
             else
                 {
+                    // Send the cached assistance at once, while the SUPL server is queried
+                    const std::string cache_filename = configuration_->property("GNSS-SDR.SUPL_cache_file", supl_cache_default_filename_);
+                    const int64_t cache_max_age_s = configuration_->property("GNSS-SDR.SUPL_cache_max_age_s", static_cast<int64_t>(7200));
+                    if (!cache_filename.empty() and supl_client_ephemeris_.load_assistance_cache(cache_filename, cache_max_age_s))
+                        {
+                            std::cout << "SUPL: Read assistance data for " << supl_client_ephemeris_.gps_ephemeris_map.size() << " satellites from " << cache_filename << '\n';
+                            for (const auto &eph : supl_client_ephemeris_.gps_ephemeris_map)
+                                {
+                                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Ephemeris>(eph.second)));
+                                }
+                            for (const auto &alm : supl_client_ephemeris_.gps_almanac_map)
+                                {
+                                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Almanac>(alm.second)));
+                                }
+                            if (supl_client_ephemeris_.gps_iono.valid == true)
+                                {
+                                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Iono>(supl_client_ephemeris_.gps_iono)));
+                                }
+                            if (supl_client_ephemeris_.gps_utc.valid == true)
+                                {
+                                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Gps_Utc_Model>(supl_client_ephemeris_.gps_utc)));
+                                }
+                            if (supl_client_ephemeris_.gps_ref_loc.valid == true)
+                                {
+                                    flowgraph_->send_telemetry_msg(pmt::make_any(std::make_shared<Agnss_Ref_Location>(supl_client_ephemeris_.gps_ref_loc)));
+                                }
+                            publish_assistance(supl_client_ephemeris_.gps_ref_loc, Agnss_Ref_Time());
+                        }
+
                     // Request ephemeris from SUPL server
                     supl_client_ephemeris_.request = 1;
                     std::cout << "SUPL: Try to read GPS ephemeris data from SUPL server...\n";
                     int error = supl_client_ephemeris_.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
+                    const bool received_ephemeris = (error == 0);
                     if (error == 0)
                         {
                             std::map<int, Gps_Ephemeris>::const_iterator gps_eph_iter;
@@ -779,10 +1054,10 @@ void ControlThread::assist_GNSS()
                         {
                             std::cout << "ERROR: SUPL client request for ephemeris data returned " << error << '\n';
                             std::cout << "Please check your network connectivity and SUPL server configuration\n";
-                            std::cout << "Trying to read AGNSS data from local XML file(s)...\n";
-                            if (read_assistance_from_XML() == false)
+                            std::cout << "Trying to read AGNSS data from local file(s)...\n";
+                            if (read_assistance_from_files() == false)
                                 {
-                                    std::cout << "ERROR: Could not read XML files: Disabling SUPL assistance.\n";
+                                    std::cout << "ERROR: Could not read assistance files: Disabling SUPL assistance.\n";
                                 }
                         }
 
@@ -857,19 +1132,19 @@ void ControlThread::assist_GNSS()
                             if (supl_client_acquisition_.gps_ref_loc.valid == true)
                                 {
                                     std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)\n";
-                                    agnss_ref_location_ = supl_client_acquisition_.gps_ref_loc;
-                                    const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(agnss_ref_location_);
+                                    const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", agnss_ref_location_);
+                                    supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", supl_client_acquisition_.gps_ref_loc);
+                                    supl_client_ephemeris_.gps_ref_loc = supl_client_acquisition_.gps_ref_loc;
                                 }
                             if (supl_client_acquisition_.gps_time.valid == true)
                                 {
                                     std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)\n";
-                                    agnss_ref_time_ = supl_client_acquisition_.gps_time;
-                                    const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(agnss_ref_time_);
+                                    const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(supl_client_acquisition_.gps_time);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", agnss_ref_time_);
+                                    supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", supl_client_acquisition_.gps_time);
                                 }
+                            publish_assistance(supl_client_acquisition_.gps_ref_loc, supl_client_acquisition_.gps_time);
                         }
                     else
                         {
@@ -877,21 +1152,69 @@ void ControlThread::assist_GNSS()
                             std::cout << "Please check your network connectivity and SUPL server configuration\n";
                             std::cout << "Disabling SUPL acquisition assistance.\n";
                         }
+
+                    // Cache the server data for the next start
+                    if (received_ephemeris and !cache_filename.empty())
+                        {
+                            supl_client_ephemeris_.save_assistance_cache(cache_filename);
+                        }
                 }
         }
 
     if ((enable_gps_supl_assistance == false) and (enable_agnss_xml == true))
         {
             // read assistance from file
-            if (read_assistance_from_XML())
+            if (read_assistance_from_files())
                 {
-                    std::cout << "GNSS assistance data loaded from local XML file(s).\n";
+                    std::cout << "GNSS assistance data loaded from local file(s).\n";
                 }
         }
 
     // If AGNSS is enabled, make use of it
-    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true)))
+    if ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true))
         {
+            publish_assistance(Agnss_Ref_Location(), Agnss_Ref_Time());
+        }
+    assistance_done_ = true;
+}
+
+
+void ControlThread::publish_assistance(const Agnss_Ref_Location &ref_location, const Agnss_Ref_Time &ref_time)
+{
+    const std::lock_guard<std::mutex> lock(assistance_mutex_);
+    if (ref_location.valid == true)
+        {
+            assistance_ref_location_ = ref_location;
+        }
+    if (ref_time.valid == true)
+        {
+            assistance_ref_time_ = ref_time;
+        }
+    assistance_received_ = true;
+}
+
+
+void ControlThread::apply_assistance()
+{
+    if (!assistance_received_.exchange(false) or assistance_applied_)
+        {
+            return;
+        }
+    {
+        const std::lock_guard<std::mutex> lock(assistance_mutex_);
+        if (assistance_ref_location_.valid == true)
+            {
+                agnss_ref_location_ = assistance_ref_location_;
+            }
+        if (assistance_ref_time_.valid == true)
+            {
+                agnss_ref_time_ = assistance_ref_time_;
+            }
+    }
+    if (agnss_ref_location_.valid == true)
+        {
+            // Only once, since it restarts the search of all the channels
+            assistance_applied_ = true;
             // Get the list of visible satellites
             std::array<float, 3> ref_LLH{};
             ref_LLH[0] = agnss_ref_location_.lat;
@@ -948,6 +1271,10 @@ void ControlThread::apply_action(unsigned int what)
             visible_satellites = get_visible_sats(cmd_interface_.get_utc_time(), cmd_interface_.get_LLH());
             // reorder the satellite queue to acquire first those visible satellites
             flowgraph_->priorize_satellites(visible_satellites);
+            if (enable_assisted_acquisition_)
+                {
+                    flowgraph_->set_doppler_predictions(get_doppler_predictions(cmd_interface_.get_utc_time(), cmd_interface_.get_LLH()));
+                }
             // start again the satellite acquisitions
             receiver_on_standby_ = false;
             break;
@@ -956,8 +1283,8 @@ void ControlThread::apply_action(unsigned int what)
             // delete all ephemeris and almanac information from maps (also the PVT map queue)
             pvt_ptr = flowgraph_->get_pvt();
             pvt_ptr->clear_ephemeris();
-            // load the ephemeris and the almanac from XML files (receiver assistance)
-            read_assistance_from_XML();
+            // load the ephemeris and the almanac from the assistance files
+            read_assistance_from_files();
             // call here the function that computes the set of visible satellites and its elevation
             // for the date and time specified by the warm start command and the assisted position
             get_visible_sats(cmd_interface_.get_utc_time(), cmd_interface_.get_LLH());
@@ -981,6 +1308,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     arma::vec r_eb_e = arma::zeros(3, 1);
     arma::vec v_eb_e = arma::zeros(3, 1);
     Geo_to_ECEF(LLH_rad, arma::vec{0, 0, 0}, C_tmp, r_eb_e, v_eb_e, C_tmp);
+    const std::array<double, 3> r_rx{r_eb_e(0), r_eb_e(1), r_eb_e(2)};
 
     // 2. Compute rx GPS time from UTC time
     gtime_t utc_gtime;
@@ -993,7 +1321,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     std::vector<std::pair<int, Gnss_Satellite>> available_satellites;
     std::vector<unsigned int> visible_gps;
     std::vector<unsigned int> visible_gal;
-    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    const Gnss_Nav_Data_Store &nav_data = gnss_nav_data_store();
     struct tm tstruct
     {
     };
@@ -1004,8 +1332,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     std::cout << "Get visible satellites at " << str_time
               << "UTC, assuming RX position " << LLH[0] << " [deg], " << LLH[1] << " [deg], " << LLH[2] << " [m]\n";
 
-    const std::map<int, Gps_Ephemeris> gps_eph_map = pvt_ptr->get_gps_ephemeris();
-    for (const auto &it : gps_eph_map)
+    const auto gps_eph_map = nav_data.gps_ephemeris.snapshot();
+    for (const auto &it : *gps_eph_map)
         {
             const eph_t rtklib_eph = eph_to_rtklib(it.second, pre_2009_file_);
             std::array<double, 3> r_sat{};
@@ -1016,9 +1344,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double Az;
             double El;
             double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            const arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
+            topocent(&Az, &El, &dist_m, r_rx, line_of_sight(r_rx, r_sat));
             // push sat
             if (El > 0)
                 {
@@ -1029,8 +1355,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Galileo_Ephemeris> gal_eph_map = pvt_ptr->get_galileo_ephemeris();
-    for (const auto &it : gal_eph_map)
+    const auto gal_eph_map = nav_data.galileo_ephemeris.snapshot();
+    for (const auto &it : *gal_eph_map)
         {
             const eph_t rtklib_eph = eph_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -1041,9 +1367,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double Az;
             double El;
             double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            const arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
+            topocent(&Az, &El, &dist_m, r_rx, line_of_sight(r_rx, r_sat));
             // push sat
             if (El > 0)
                 {
@@ -1054,8 +1378,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Gps_Almanac> gps_alm_map = pvt_ptr->get_gps_almanac();
-    for (const auto &it : gps_alm_map)
+    const auto gps_alm_map = nav_data.gps_almanac.snapshot();
+    for (const auto &it : *gps_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -1067,9 +1391,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double Az;
             double El;
             double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            const arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
+            topocent(&Az, &El, &dist_m, r_rx, line_of_sight(r_rx, r_sat));
             // push sat
             std::vector<unsigned int>::iterator it2;
             if (El > 0)
@@ -1084,8 +1406,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Galileo_Almanac> gal_alm_map = pvt_ptr->get_galileo_almanac();
-    for (const auto &it : gal_alm_map)
+    const auto gal_alm_map = nav_data.galileo_almanac.snapshot();
+    for (const auto &it : *gal_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -1097,9 +1419,7 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             double Az;
             double El;
             double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            const arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
+            topocent(&Az, &El, &dist_m, r_rx, line_of_sight(r_rx, r_sat));
             // push sat
             std::vector<unsigned int>::iterator it2;
             if (El > 0)
@@ -1124,6 +1444,223 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
 }
 
 
+std::map<std::pair<std::string, uint32_t>, ControlThread::Satellite_Prediction> ControlThread::get_satellite_predictions(time_t rx_utc_time, const std::array<float, 3> &LLH, double lookahead_s)
+{
+    const arma::vec LLH_rad = arma::vec{degtorad(LLH[0]), degtorad(LLH[1]), LLH[2]};
+    arma::mat C_tmp = arma::zeros(3, 3);
+    arma::vec r_eb_e = arma::zeros(3, 1);
+    arma::vec v_eb_e = arma::zeros(3, 1);
+    Geo_to_ECEF(LLH_rad, arma::vec{0, 0, 0}, C_tmp, r_eb_e, v_eb_e, C_tmp);
+    const std::array<double, 3> r_rx{r_eb_e(0), r_eb_e(1), r_eb_e(2)};
+
+    gtime_t utc_gtime;
+    utc_gtime.time = rx_utc_time;
+    utc_gtime.sec = 0.0;
+    const gtime_t gps_gtime = utc2gpst(utc_gtime);
+    const gtime_t gps_gtime_next = timeadd(gps_gtime, 1.0);
+    const gtime_t gps_gtime_future = timeadd(gps_gtime, lookahead_s);
+    gtime_t alm_gtime;
+    alm_gtime.time = fmod(utc2gpst(gps_gtime).time + 345600, 604800);
+    alm_gtime.sec = 0.0;
+    const gtime_t alm_gtime_next = timeadd(alm_gtime, 1.0);
+    const gtime_t alm_gtime_future = timeadd(alm_gtime, lookahead_s);
+
+    std::map<std::pair<std::string, uint32_t>, Satellite_Prediction> predictions;
+    // Ephemeris are used first, and almanac only for the remaining satellites
+    auto add_prediction = [&](const std::string &system, uint32_t prn, const std::array<double, 3> &r_sat, const std::array<double, 3> &r_sat_next, const std::array<double, 3> &r_sat_future) {
+        const auto key = std::make_pair(system, prn);
+        if (predictions.count(key) != 0)
+            {
+                return;
+            }
+        double Az;
+        double dist_m;
+        Satellite_Prediction prediction;
+        topocent(&Az, &prediction.elevation_deg, &dist_m, r_rx, line_of_sight(r_rx, r_sat));
+        topocent(&Az, &prediction.future_elevation_deg, &dist_m, r_rx, line_of_sight(r_rx, r_sat_future));
+        prediction.doppler_hz = predicted_l1_doppler(r_rx, r_sat, r_sat_next);
+        predictions[key] = prediction;
+    };
+
+    const Gnss_Nav_Data_Store &nav_data = gnss_nav_data_store();
+    const auto gps_eph_map = nav_data.gps_ephemeris.snapshot();
+    const auto gal_eph_map = nav_data.galileo_ephemeris.snapshot();
+    const auto gps_alm_map = nav_data.gps_almanac.snapshot();
+    const auto gal_alm_map = nav_data.galileo_almanac.snapshot();
+    std::array<double, 3> r_sat{};
+    std::array<double, 3> r_sat_next{};
+    std::array<double, 3> r_sat_future{};
+    double clock_bias_s;
+    double sat_pos_variance_m2;
+
+    for (const auto &it : *gps_eph_map)
+        {
+            const eph_t rtklib_eph = eph_to_rtklib(it.second, pre_2009_file_);
+            eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_gtime_next, &rtklib_eph, r_sat_next.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_gtime_future, &rtklib_eph, r_sat_future.data(), &clock_bias_s, &sat_pos_variance_m2);
+            add_prediction("GPS", it.second.PRN, r_sat, r_sat_next, r_sat_future);
+        }
+
+    for (const auto &it : *gal_eph_map)
+        {
+            const eph_t rtklib_eph = eph_to_rtklib(it.second);
+            eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_gtime_next, &rtklib_eph, r_sat_next.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_gtime_future, &rtklib_eph, r_sat_future.data(), &clock_bias_s, &sat_pos_variance_m2);
+            add_prediction("Galileo", it.second.PRN, r_sat, r_sat_next, r_sat_future);
+        }
+
+    for (const auto &it : *gps_alm_map)
+        {
+            const alm_t rtklib_alm = alm_to_rtklib(it.second);
+            alm2pos(alm_gtime, &rtklib_alm, r_sat.data(), &clock_bias_s);
+            alm2pos(alm_gtime_next, &rtklib_alm, r_sat_next.data(), &clock_bias_s);
+            alm2pos(alm_gtime_future, &rtklib_alm, r_sat_future.data(), &clock_bias_s);
+            add_prediction("GPS", it.second.PRN, r_sat, r_sat_next, r_sat_future);
+        }
+
+    for (const auto &it : *gal_alm_map)
+        {
+            const alm_t rtklib_alm = alm_to_rtklib(it.second);
+            alm2pos(alm_gtime, &rtklib_alm, r_sat.data(), &clock_bias_s);
+            alm2pos(alm_gtime_next, &rtklib_alm, r_sat_next.data(), &clock_bias_s);
+            alm2pos(alm_gtime_future, &rtklib_alm, r_sat_future.data(), &clock_bias_s);
+            add_prediction("Galileo", it.second.PRN, r_sat, r_sat_next, r_sat_future);
+        }
+
+    return predictions;
+}
+
+
+std::map<std::pair<std::string, uint32_t>, double> ControlThread::get_doppler_predictions(time_t rx_utc_time, const std::array<float, 3> &LLH)
+{
+    std::map<std::pair<std::string, uint32_t>, double> doppler_predictions;
+    for (const auto &prediction : get_satellite_predictions(rx_utc_time, LLH, 0.0))
+        {
+            if (prediction.second.elevation_deg > 0)
+                {
+                    doppler_predictions[prediction.first] = prediction.second.doppler_hz;
+                    DLOG(INFO) << "Predicted Doppler for " << Gnss_Satellite(prediction.first.first, prediction.first.second) << ": " << prediction.second.doppler_hz << " [Hz]";
+                }
+        }
+    return doppler_predictions;
+}
+
+
+void ControlThread::update_doppler_predictions()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_doppler_prediction_time_ < DOPPLER_PREDICTION_PERIOD)
+        {
+            return;
+        }
+    last_doppler_prediction_time_ = now;
+
+    double longitude_deg;
+    double latitude_deg;
+    double height_m;
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t UTC_time;
+    if (flowgraph_->get_pvt()->get_latest_PVT(&longitude_deg,
+            &latitude_deg,
+            &height_m,
+            &ground_speed_kmh,
+            &course_over_ground_deg,
+            &UTC_time) == true)
+        {
+            const std::array<float, 3> LLH{static_cast<float>(latitude_deg), static_cast<float>(longitude_deg), static_cast<float>(height_m)};
+            flowgraph_->set_doppler_predictions(get_doppler_predictions(UTC_time, LLH));
+        }
+}
+
+
+void ControlThread::update_visibility_schedule()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_visibility_schedule_time_ < VISIBILITY_SCHEDULE_PERIOD)
+        {
+            return;
+        }
+    last_visibility_schedule_time_ = now;
+
+    // Use the latest fix, or else the reference location of the assistance and the system time
+    double longitude_deg;
+    double latitude_deg;
+    double height_m;
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t UTC_time;
+    std::array<float, 3> LLH{};
+    if (flowgraph_->get_pvt()->get_latest_PVT(&longitude_deg,
+            &latitude_deg,
+            &height_m,
+            &ground_speed_kmh,
+            &course_over_ground_deg,
+            &UTC_time) == true)
+        {
+            LLH = {static_cast<float>(latitude_deg), static_cast<float>(longitude_deg), static_cast<float>(height_m)};
+        }
+    else if (agnss_ref_location_.valid == true)
+        {
+            LLH = {static_cast<float>(agnss_ref_location_.lat), static_cast<float>(agnss_ref_location_.lon), 0.0F};
+            UTC_time = std::time(nullptr);
+        }
+    else
+        {
+            return;
+        }
+
+    const auto predictions = get_satellite_predictions(UTC_time, LLH, visibility_lookahead_s_);
+    if (predictions.empty())
+        {
+            return;  // no orbits yet: every satellite keeps being searched
+        }
+
+    // priorize_satellites() moves each satellite to the front of the search
+    // lists, so the last one of the vector is searched first: the rising ones,
+    // and then the visible ones, in ascending order of elevation
+    std::vector<std::pair<int, Gnss_Satellite>> visible;
+    std::vector<std::pair<int, Gnss_Satellite>> rising;
+    std::vector<Gnss_Satellite> unscheduled;
+    std::map<std::pair<std::string, uint32_t>, double> doppler_predictions;
+    for (const auto &prediction : predictions)
+        {
+            const Gnss_Satellite satellite(prediction.first.first, prediction.first.second);
+            if (prediction.second.elevation_deg > visibility_elevation_mask_deg_)
+                {
+                    visible.emplace_back(floor(prediction.second.elevation_deg), satellite);
+                }
+            else if (prediction.second.future_elevation_deg > visibility_elevation_mask_deg_)
+                {
+                    rising.emplace_back(floor(prediction.second.future_elevation_deg), satellite);
+                }
+            else
+                {
+                    unscheduled.push_back(satellite);
+                    continue;
+                }
+            doppler_predictions[prediction.first] = prediction.second.doppler_hz;
+        }
+    const auto by_elevation = [](const std::pair<int, Gnss_Satellite> &a, const std::pair<int, Gnss_Satellite> &b) {
+        return a.first < b.first;
+    };
+    std::sort(visible.begin(), visible.end(), by_elevation);
+    std::sort(rising.begin(), rising.end(), by_elevation);
+    rising.insert(rising.end(), visible.begin(), visible.end());
+
+    DLOG(INFO) << "Visibility schedule: " << visible.size() << " visible, " << rising.size() - visible.size()
+               << " rising and " << unscheduled.size() << " satellites below the horizon";
+    flowgraph_->set_visibility_schedule(rising, unscheduled);
+    if (enable_assisted_acquisition_)
+        {
+            // the rising satellites are acquired with a narrow search too
+            flowgraph_->set_doppler_predictions(doppler_predictions);
+        }
+}
+
+
 void ControlThread::gps_acq_assist_data_collector() const
 {
     // ############ 1.bis READ EPHEMERIS/UTC_MODE/IONO QUEUE ####################
@@ -1188,7 +1725,7 @@ void ControlThread::sysv_queue_listener()
                     if ((std::abs(received_message - (-200.0)) < 10 * std::numeric_limits<double>::epsilon()))
                         {
                             std::cout << "Quit order received, stopping GNSS-SDR !!\n";
-                            control_queue_->push(pmt::make_any(command_event_make(200, 0)));
+                            control_queue_->push(command_event_make(200, 0));
                             read_queue = false;
                         }
                 }
@@ -1206,7 +1743,7 @@ void ControlThread::keyboard_listener()
             if (c == 'q')
                 {
                     std::cout << "Quit keystroke order received, stopping GNSS-SDR !!\n";
-                    control_queue_->push(pmt::make_any(command_event_make(200, 0)));
+                    control_queue_->push(command_event_make(200, 0));
                     stop_ = true;
                     read_keys = false;
                 }
@@ -23,18 +23,21 @@
 
 #include "agnss_ref_location.h"    // for Agnss_Ref_Location
 #include "agnss_ref_time.h"        // for Agnss_Ref_Time
-#include "channel_event.h"         // for channel_event_sptr
-#include "command_event.h"         // for command_event_sptr
 #include "concurrent_queue.h"      // for Concurrent_Queue
+#include "control_queue.h"         // for Control_Queue
 #include "gnss_sdr_supl_client.h"  // for Gnss_Sdr_Supl_Client
+#include "metrics_http_server.h"   // for Metrics_Http_Server
 #include "tcp_cmd_interface.h"     // for TcpCmdInterface
-#include <pmt/pmt.h>
 #include <array>     // for array
+#include <atomic>    // for atomic
+#include <chrono>    // for steady_clock
 #include <cstddef>   // for size_t
+#include <cstdint>   // for uint32_t
+#include <map>       // for map
 #include <memory>    // for shared_ptr
+#include <mutex>     // for mutex
 #include <string>    // for string
 #include <thread>    // for std::thread
-#include <typeinfo>  // for std::type_info, typeid
 #include <utility>   // for pair
 #include <vector>    // for vector
 
@@ -75,6 +78,17 @@ public:
      */
     explicit ControlThread(std::shared_ptr<ConfigurationInterface> configuration);
 
+    /*!
+     * \brief Constructor that reads the configuration from a file
+     *
+     * \param[in] config_file Path to the configuration file
+     * \param[in] config_cache Path to its binary cache, or empty
+     * \param[in] hosted If true, the receiver is one of several of the same
+     * process (see Receiver_Host) and it does not listen to the keyboard nor
+     * to the SysV queue, which belong to the whole process
+     */
+    ControlThread(const std::string &config_file, const std::string &config_cache, bool hosted);
+
     /*!
      * \brief Destructor
      */
@@ -97,9 +111,14 @@ public:
     /*!
      * \brief Sets the control_queue
      *
-     * \param[in] std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue
+     * \param[in] std::shared_ptr<Control_Queue> control_queue
      */
-    void set_control_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue);
+    void set_control_queue(std::shared_ptr<Control_Queue> control_queue);
+
+    /*!
+     * \brief Asks the receiver to stop, as the 'q' key does. Thread-safe.
+     */
+    void request_stop();
 
     unsigned int processed_control_messages() const
     {
@@ -129,11 +148,23 @@ private:
     /*
      * New receiver event dispatcher
      */
-    void event_dispatcher(bool &valid_event, pmt::pmt_t &msg);
+    void event_dispatcher(bool &valid_event, Control_Message &msg);
+
+    /*
+     * Sends the channel events collected by event_dispatcher to the flow graph
+     */
+    void apply_channel_events();
+
+    // Read {ephemeris, iono, utc, ref loc, ref time} assistance from the binary file
+    // GNSS-SDR.AGNSS_binary_file if set, or else from the local XML files
+    bool read_assistance_from_files();
 
     // Read {ephemeris, iono, utc, ref loc, ref time} assistance from a local XML file previously recorded
     bool read_assistance_from_XML();
 
+    // Read {ephemeris, iono, utc, ref loc, ref time} assistance from a binary file written by rinex2assist
+    bool read_assistance_from_binary(const std::string &file_name);
+
     /*
      * Blocking function that reads the GPS assistance queue
      */
@@ -146,10 +177,55 @@ private:
     std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH);
 
     /*
-     * Read initial GNSS assistance from SUPL server or local XML files
+     * Predict the Doppler shift at the L1/E1 frequency of all the visible satellites
+     * in ephemeris and almanac queues, for the specified time and position.
+     */
+    std::map<std::pair<std::string, uint32_t>, double> get_doppler_predictions(time_t rx_utc_time, const std::array<float, 3> &LLH);
+
+    class Satellite_Prediction
+    {
+    public:
+        double elevation_deg{0.0};
+        double future_elevation_deg{0.0};  // after the look-ahead time
+        double doppler_hz{0.0};            // at the L1/E1 frequency
+    };
+
+    /*
+     * Predict the elevation, now and lookahead_s seconds later, and the Doppler
+     * shift of all the satellites in ephemeris and almanac queues, for the
+     * specified time and position
+     */
+    std::map<std::pair<std::string, uint32_t>, Satellite_Prediction> get_satellite_predictions(time_t rx_utc_time, const std::array<float, 3> &LLH, double lookahead_s);
+
+    /*
+     * Periodically refresh the Doppler predictions used by the assisted
+     * acquisition, using the latest PVT fix
+     */
+    void update_doppler_predictions();
+
+    /*
+     * Periodically predict which satellites are above the elevation mask or
+     * will rise above it within the look-ahead time, and keep the others out
+     * of the acquisition search lists
+     */
+    void update_visibility_schedule();
+
+    /*
+     * Read initial GNSS assistance from the SUPL cache file, SUPL server or
+     * local XML files, in the assistance thread. The data are sent to the
+     * flowgraph as soon as they are read.
      */
     void assist_GNSS();
 
+    // Hands the reference location and time read by assist_GNSS() to the control thread
+    void publish_assistance(const Agnss_Ref_Location &ref_location, const Agnss_Ref_Time &ref_time);
+
+    /*
+     * Gives priority to the satellites visible from the reference location,
+     * the first time the assistance thread publishes one
+     */
+    void apply_assistance();
+
     void telecommand_listener();
     void keyboard_listener();
     void sysv_queue_listener();
@@ -170,24 +246,25 @@ private:
     const std::string glo_utc_default_xml_filename_ = "./glo_utc_model.xml";
     const std::string gal_almanac_default_xml_filename_ = "./gal_almanac.xml";
     const std::string gps_almanac_default_xml_filename_ = "./gps_almanac.xml";
-
-    const size_t channel_event_type_hash_code_ = typeid(channel_event_sptr).hash_code();
-    const size_t command_event_type_hash_code_ = typeid(command_event_sptr).hash_code();
+    const std::string supl_cache_default_filename_ = "./gps_supl_assistance.bin";
 
     std::shared_ptr<ConfigurationInterface> configuration_;
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
+    std::shared_ptr<Control_Queue> control_queue_;
+    std::vector<std::pair<unsigned int, unsigned int>> channel_events_;  // (who, what), pending for the flow graph
     std::shared_ptr<GNSSFlowgraph> flowgraph_;
 
     std::thread cmd_interface_thread_;
     std::thread keyboard_thread_;
     std::thread sysv_queue_thread_;
     std::thread gps_acq_assist_data_collector_thread_;
+    std::thread assistance_thread_;
 
 #ifdef ENABLE_FPGA
     boost::thread fpga_helper_thread_;
 #endif
 
     TcpCmdInterface cmd_interface_;
+    std::unique_ptr<Metrics_Http_Server> metrics_server_;  // if GNSS-SDR.metrics_port > 0
 
     // SUPL assistance classes
     Gnss_Sdr_Supl_Client supl_client_acquisition_;
@@ -199,6 +276,17 @@ private:
 
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
+    std::mutex assistance_mutex_;
+    Agnss_Ref_Location assistance_ref_location_;  // published by the assistance thread
+    Agnss_Ref_Time assistance_ref_time_;          // published by the assistance thread
+    std::atomic<bool> assistance_received_{false};
+    std::atomic<bool> assistance_done_{false};
+    bool assistance_applied_{false};
+
+    std::chrono::steady_clock::time_point last_doppler_prediction_time_;
+    std::chrono::steady_clock::time_point last_visibility_schedule_time_;
+    double visibility_elevation_mask_deg_;
+    double visibility_lookahead_s_;
 
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
@@ -213,7 +301,10 @@ private:
     bool receiver_on_standby_;
     bool stop_;
     bool restart_;
+    bool hosted_;
     bool telecommand_enabled_;
+    bool enable_assisted_acquisition_;
+    bool enable_visibility_scheduler_;
     bool pre_2009_file_;  // to override the system time to postprocess old gnss records and avoid wrong week rollover
 };
 
@@ -20,14 +20,40 @@
  */
 
 #include "file_configuration.h"
-#include "gnss_sdr_make_unique.h"
+#include "INIReader.h"
 #include <glog/logging.h>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <utility>
 
 
-FileConfiguration::FileConfiguration(std::string filename)
-    : filename_(std::move(filename))
+namespace
+{
+// Size and FNV-1a hash of the contents of a file. Returns false if it cannot be read.
+bool file_signature(const std::string& filename, uint64_t& size, uint64_t& hash)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        {
+            return false;
+        }
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size = contents.size();
+    hash = 14695981039346656037ULL;
+    for (const char c : contents)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+    return true;
+}
+}  // namespace
+
+
+FileConfiguration::FileConfiguration(std::string filename, std::string cache_filename)
+    : filename_(std::move(filename)),
+      cache_filename_(std::move(cache_filename))
 {
     init();
 }
@@ -42,10 +68,34 @@ FileConfiguration::FileConfiguration()
 
 void FileConfiguration::init()
 {
-    converter_ = std::make_unique<StringConverter>();
-    overrided_ = std::make_unique<InMemoryConfiguration>();
-    ini_reader_ = std::make_unique<INIReader>(filename_);
-    error_ = ini_reader_->ParseError();
+    uint64_t source_size = 0;
+    uint64_t source_hash = 0;
+    const bool use_cache = !cache_filename_.empty() && file_signature(filename_, source_size, source_hash);
+    if (use_cache && values_.load(cache_filename_, source_size, source_hash))
+        {
+            DLOG(INFO) << "Configuration file " << filename_ << " read from the cache " << cache_filename_;
+            return;
+        }
+
+    parse();
+    if (use_cache && error_ == 0)
+        {
+            if (values_.save(cache_filename_, source_size, source_hash))
+                {
+                    DLOG(INFO) << "Configuration cache " << cache_filename_ << " written";
+                }
+            else
+                {
+                    LOG(WARNING) << "Unable to write the configuration cache " << cache_filename_;
+                }
+        }
+}
+
+
+void FileConfiguration::parse()
+{
+    const INIReader ini_reader(filename_);
+    error_ = ini_reader.ParseError();
     if (error_ == 0)
         {
             DLOG(INFO) << "Configuration file " << filename_ << " opened with no errors";
@@ -58,131 +108,104 @@ void FileConfiguration::init()
         {
             std::cerr << "Unable to open configuration file " << filename_ << '\n';
         }
+
+    // Only the GNSS-SDR section is looked up
+    const std::string section("gnss-sdr.");
+    for (const auto& value : ini_reader.Values())
+        {
+            if (value.first.compare(0, section.size(), section) == 0)
+                {
+                    values_.insert(value.first.substr(section.size()), value.second);
+                }
+        }
 }
 
 
 bool FileConfiguration::has_section() const
 {
-    return ini_reader_->HasSection("GNSS-SDR");
+    return !values_.empty();
 }
 
 
-std::string FileConfiguration::property(std::string property_name, std::string default_value) const
+template <typename T>
+T FileConfiguration::lookup(const std::string& property_name, T default_value) const
 {
-    if (overrided_->is_present(property_name))
+    const Configuration_Snapshot::Entry* entry = overrided_.find(property_name);
+    if (entry == nullptr)
         {
-            return overrided_->property(property_name, default_value);
+            entry = values_.find(property_name);
         }
-    return ini_reader_->Get("GNSS-SDR", property_name, default_value);
+    return entry == nullptr ? default_value : entry->get(default_value);
 }
 
 
-bool FileConfiguration::property(std::string property_name, bool default_value) const
+std::string FileConfiguration::property(const std::string& property_name, std::string default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-int64_t FileConfiguration::property(std::string property_name, int64_t default_value) const
+bool FileConfiguration::property(const std::string& property_name, bool default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-uint64_t FileConfiguration::property(std::string property_name, uint64_t default_value) const
+int64_t FileConfiguration::property(const std::string& property_name, int64_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-int FileConfiguration::property(std::string property_name, int default_value) const
+uint64_t FileConfiguration::property(const std::string& property_name, uint64_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-unsigned int FileConfiguration::property(std::string property_name, unsigned int default_value) const
+int32_t FileConfiguration::property(const std::string& property_name, int32_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-uint16_t FileConfiguration::property(std::string property_name, uint16_t default_value) const
+uint32_t FileConfiguration::property(const std::string& property_name, uint32_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-int16_t FileConfiguration::property(std::string property_name, int16_t default_value) const
+uint16_t FileConfiguration::property(const std::string& property_name, uint16_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-float FileConfiguration::property(std::string property_name, float default_value) const
+int16_t FileConfiguration::property(const std::string& property_name, int16_t default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
 }
 
 
-double FileConfiguration::property(std::string property_name, double default_value) const
+float FileConfiguration::property(const std::string& property_name, float default_value) const
 {
-    if (overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return lookup(property_name, default_value);
+}
+
+
+double FileConfiguration::property(const std::string& property_name, double default_value) const
+{
+    return lookup(property_name, default_value);
 }
 
 
-void FileConfiguration::set_property(std::string property_name, std::string value)
+void FileConfiguration::set_property(const std::string& property_name, std::string value)
 {
-    overrided_->set_property(property_name, value);
+    overrided_.insert(property_name, value);
 }
 
 
 bool FileConfiguration::is_present(const std::string& property_name) const
 {
-    return (overrided_->is_present(property_name));
+    return overrided_.find(property_name) != nullptr;
 }
@@ -22,12 +22,9 @@
 #ifndef GNSS_SDR_FILE_CONFIGURATION_H
 #define GNSS_SDR_FILE_CONFIGURATION_H
 
-#include "INIReader.h"
 #include "configuration_interface.h"
-#include "in_memory_configuration.h"
-#include "string_converter.h"
+#include "configuration_snapshot.h"
 #include <cstdint>
-#include <memory>
 #include <string>
 
 /** \addtogroup Core
@@ -44,33 +41,42 @@
  * for the values of the parameters.
  * The file is in the INI format, containing sections and pairs of names and values.
  * For more information about the INI format, see https://en.wikipedia.org/wiki/INI_file
+ *
+ * The file is parsed once, at construction, into a Configuration_Snapshot. If
+ * a cache file name is given, the snapshot is read from that binary cache
+ * while the contents of the configuration file do not change, and written to
+ * it otherwise.
  */
 class FileConfiguration : public ConfigurationInterface
 {
 public:
-    explicit FileConfiguration(std::string filename);
+    explicit FileConfiguration(std::string filename, std::string cache_filename = std::string());
     FileConfiguration();
     ~FileConfiguration() = default;
-    std::string property(std::string property_name, std::string default_value) const override;
-    bool property(std::string property_name, bool default_value) const override;
-    int64_t property(std::string property_name, int64_t default_value) const override;
-    uint64_t property(std::string property_name, uint64_t default_value) const override;
-    int32_t property(std::string property_name, int32_t default_value) const override;
-    uint32_t property(std::string property_name, uint32_t default_value) const override;
-    int16_t property(std::string property_name, int16_t default_value) const override;
-    uint16_t property(std::string property_name, uint16_t default_value) const override;
-    float property(std::string property_name, float default_value) const override;
-    double property(std::string property_name, double default_value) const override;
-    void set_property(std::string property_name, std::string value) override;
+    std::string property(const std::string& property_name, std::string default_value) const override;
+    bool property(const std::string& property_name, bool default_value) const override;
+    int64_t property(const std::string& property_name, int64_t default_value) const override;
+    uint64_t property(const std::string& property_name, uint64_t default_value) const override;
+    int32_t property(const std::string& property_name, int32_t default_value) const override;
+    uint32_t property(const std::string& property_name, uint32_t default_value) const override;
+    int16_t property(const std::string& property_name, int16_t default_value) const override;
+    uint16_t property(const std::string& property_name, uint16_t default_value) const override;
+    float property(const std::string& property_name, float default_value) const override;
+    double property(const std::string& property_name, double default_value) const override;
+    void set_property(const std::string& property_name, std::string value) override;
     bool is_present(const std::string& property_name) const;
     bool has_section() const;
 
 private:
     void init();
+    void parse();
+    template <typename T>
+    T lookup(const std::string& property_name, T default_value) const;
+
     std::string filename_;
-    std::unique_ptr<INIReader> ini_reader_;
-    std::unique_ptr<InMemoryConfiguration> overrided_;
-    std::unique_ptr<StringConverter> converter_;
+    std::string cache_filename_;
+    Configuration_Snapshot values_{true};  // parameters of the GNSS-SDR section, case insensitive
+    Configuration_Snapshot overrided_;     // parameters set at runtime, they take precedence
     int error_{};
 };
 
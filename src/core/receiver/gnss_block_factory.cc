@@ -25,6 +25,7 @@
 
 #include "gnss_block_factory.h"
 #include "acquisition_interface.h"
+#include "agc_requantizer_adapter.h"
 #include "array_signal_conditioner.h"
 #include "beamformer_filter.h"
 #include "beidou_b1i_dll_pll_tracking.h"
@@ -62,14 +63,18 @@
 #include "galileo_e6_telemetry_decoder.h"
 #include "glonass_l1_ca_dll_pll_c_aid_tracking.h"
 #include "glonass_l1_ca_dll_pll_tracking.h"
+#include "glonass_l1_ca_dll_pll_veml_tracking.h"
 #include "glonass_l1_ca_pcps_acquisition.h"
 #include "glonass_l1_ca_telemetry_decoder.h"
 #include "glonass_l2_ca_dll_pll_c_aid_tracking.h"
 #include "glonass_l2_ca_dll_pll_tracking.h"
+#include "glonass_l2_ca_dll_pll_veml_tracking.h"
 #include "glonass_l2_ca_pcps_acquisition.h"
 #include "glonass_l2_ca_telemetry_decoder.h"
 #include "gnss_block_interface.h"
+#include "gnss_sdr_device_scheduler.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_memory_accounting.h"
 #include "gnss_sdr_string_literals.h"
 #include "gps_l1_ca_dll_pll_tracking.h"
 #include "gps_l1_ca_kf_tracking.h"
@@ -101,10 +106,13 @@
 #include "notch_filter_lite.h"
 #include "nsr_file_signal_source.h"
 #include "pass_through.h"
+#include "pfb_channelizer_filter.h"
 #include "pulse_blanking_filter.h"
+#include "rational_resampler_conditioner.h"
 #include "rtklib_pvt.h"
 #include "rtl_tcp_signal_source.h"
 #include "sbas_l1_telemetry_decoder.h"
+#include "shm_signal_source.h"
 #include "signal_conditioner.h"
 #include "spir_file_signal_source.h"
 #include "spir_gss6450_file_signal_source.h"
@@ -121,6 +129,10 @@
 #include "custom_udp_signal_source.h"
 #endif
 
+#if ENABLE_ZSTD
+#include "compressed_file_signal_source.h"
+#endif
+
 #if ENABLE_FPGA
 #include "galileo_e1_dll_pll_veml_tracking_fpga.h"
 #include "galileo_e1_pcps_ambiguous_acquisition_fpga.h"
@@ -213,7 +225,7 @@ auto findRole(ConfigurationInterface const* configuration, std::string const& ba
 
 
 std::unique_ptr<SignalSourceInterface> GNSSBlockFactory::GetSignalSource(
-    const ConfigurationInterface* configuration, Concurrent_Queue<pmt::pmt_t>* queue, int ID)
+    const ConfigurationInterface* configuration, Control_Queue* queue, int ID)
 {
     auto role = findRole(configuration, "SignalSource"s, ID);
     auto implementation = configuration->property(role + impl_prop, ""s);
@@ -369,7 +381,7 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetChannel(
     const ConfigurationInterface* configuration,
     const std::string& signal,
     int channel,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
 {
     // "appendix" is added to the "role" with the aim of Acquisition, Tracking and Telemetry Decoder adapters
     // can find their specific configurations for channels
@@ -438,7 +450,7 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetChannel(
 
 std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFactory::GetChannels(
     const ConfigurationInterface* configuration,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
 {
     int channel_absolute_id = 0;
 
@@ -466,6 +478,9 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                                         Channels_7X_count +
                                         Channels_E6_count;
 
+    // The channels learn their GPU when they are given their channel number
+    Gnss_Device_Scheduler::instance().configure(configuration, static_cast<int>(total_channels));
+
     auto channels = std::make_unique<std::vector<std::unique_ptr<GNSSBlockInterface>>>(total_channels);
     try
         {
@@ -635,8 +650,10 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
     const std::string& role,
     unsigned int in_streams,
     unsigned int out_streams,
-    Concurrent_Queue<pmt::pmt_t>* queue)
+    Control_Queue* queue)
 {
+    // the buffers allocated by the constructors are charged to the subsystem of the block
+    const Gnss_Memory_Tag_Scope memory_tag(Gnss_Memory_Accounting::subsystem_of_role(role));
     std::unique_ptr<GNSSBlockInterface> block;
     const std::string implementation = configuration->property(role + impl_prop, "Pass_Through"s);
 
@@ -656,6 +673,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+            else if (implementation == "Shm_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<ShmSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
             else if (implementation == "File_Signal_Source")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<FileSignalSource>(configuration, role, in_streams,
@@ -681,6 +704,14 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+#endif
+#if ENABLE_ZSTD
+            else if (implementation == "Compressed_File_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<CompressedFileSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
 #endif
             else if (implementation == "Nsr_File_Signal_Source")
                 {
@@ -836,6 +867,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "Agc_Requantizer")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<AgcRequantizerAdapter>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
 
             // INPUT FILTER ------------------------------------------------------------
             else if (implementation == "Fir_Filter")
@@ -856,6 +893,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "Pfb_Channelizer_Filter")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<PfbChannelizerFilter>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
             else if (implementation == "Pulse_Blanking_Filter")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<PulseBlankingFilter>(configuration, role, in_streams,
@@ -890,6 +933,13 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     block = std::move(block_);
                 }
 
+            else if (implementation == "Rational_Resampler")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<RationalResamplerConditioner>(configuration, role,
+                        in_streams, out_streams);
+                    block = std::move(block_);
+                }
+
             // ACQUISITION BLOCKS ------------------------------------------------------
             else if (implementation == "GPS_L1_CA_PCPS_Acquisition")
                 {
@@ -1137,6 +1187,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "GLONASS_L1_CA_DLL_PLL_VEML_Tracking")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GlonassL1CaDllPllVemlTracking>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
             else if (implementation == "GLONASS_L2_CA_DLL_PLL_Tracking")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GlonassL2CaDllPllTracking>(configuration, role, in_streams,
@@ -1149,6 +1205,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "GLONASS_L2_CA_DLL_PLL_VEML_Tracking")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GlonassL2CaDllPllVemlTracking>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
             else if (implementation == "BEIDOU_B1I_DLL_PLL_Tracking")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<BeidouB1iDllPllTracking>(configuration, role, in_streams,
@@ -1324,6 +1386,7 @@ std::unique_ptr<AcquisitionInterface> GNSSBlockFactory::GetAcqBlock(
     unsigned int in_streams,
     unsigned int out_streams)
 {
+    const Gnss_Memory_Tag_Scope memory_tag(Gnss_Memory_Accounting::subsystem_of_role(role));
     std::unique_ptr<AcquisitionInterface> block;
     const std::string implementation = configuration->property(role + impl_prop, "Wrong"s);
 
@@ -1511,6 +1574,7 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
     unsigned int in_streams,
     unsigned int out_streams)
 {
+    const Gnss_Memory_Tag_Scope memory_tag(Gnss_Memory_Accounting::subsystem_of_role(role));
     std::unique_ptr<TrackingInterface> block;
     const std::string implementation = configuration->property(role + impl_prop, "Wrong"s);
 
@@ -1593,6 +1657,12 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "GLONASS_L1_CA_DLL_PLL_VEML_Tracking")
+        {
+            std::unique_ptr<TrackingInterface> block_ = std::make_unique<GlonassL1CaDllPllVemlTracking>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
     else if (implementation == "GLONASS_L2_CA_DLL_PLL_Tracking")
         {
             std::unique_ptr<TrackingInterface> block_ = std::make_unique<GlonassL2CaDllPllTracking>(configuration, role, in_streams,
@@ -1605,6 +1675,12 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "GLONASS_L2_CA_DLL_PLL_VEML_Tracking")
+        {
+            std::unique_ptr<TrackingInterface> block_ = std::make_unique<GlonassL2CaDllPllVemlTracking>(configuration, role, in_streams,
+                out_streams);
+            block = std::move(block_);
+        }
     else if (implementation == "BEIDOU_B1I_DLL_PLL_Tracking")
         {
             std::unique_ptr<TrackingInterface> block_ = std::make_unique<BeidouB1iDllPllTracking>(configuration, role, in_streams,
@@ -1672,6 +1748,7 @@ std::unique_ptr<TelemetryDecoderInterface> GNSSBlockFactory::GetTlmBlock(
     unsigned int in_streams,
     unsigned int out_streams)
 {
+    const Gnss_Memory_Tag_Scope memory_tag(Gnss_Memory_Accounting::subsystem_of_role(role));
     std::unique_ptr<TelemetryDecoderInterface> block;
     const std::string implementation = configuration->property(role + impl_prop, "Wrong"s);
 
@@ -24,7 +24,7 @@
 #ifndef GNSS_SDR_BLOCK_FACTORY_H
 #define GNSS_SDR_BLOCK_FACTORY_H
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include <pmt/pmt.h>
 #include <memory>  // for unique_ptr
 #include <string>  // for string
@@ -53,12 +53,12 @@ public:
     ~GNSSBlockFactory() = default;
 
     std::unique_ptr<SignalSourceInterface> GetSignalSource(const ConfigurationInterface* configuration,
-        Concurrent_Queue<pmt::pmt_t>* queue, int ID = -1);
+        Control_Queue* queue, int ID = -1);
 
     std::unique_ptr<GNSSBlockInterface> GetSignalConditioner(const ConfigurationInterface* configuration, int ID = -1);
 
     std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GetChannels(const ConfigurationInterface* configuration,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     std::unique_ptr<GNSSBlockInterface> GetObservables(const ConfigurationInterface* configuration);
 
@@ -71,14 +71,14 @@ public:
         const std::string& role,
         unsigned int in_streams,
         unsigned int out_streams,
-        Concurrent_Queue<pmt::pmt_t>* queue = nullptr);
+        Control_Queue* queue = nullptr);
 
 private:
     std::unique_ptr<GNSSBlockInterface> GetChannel(
         const ConfigurationInterface* configuration,
         const std::string& signal,
         int channel,
-        Concurrent_Queue<pmt::pmt_t>* queue);
+        Control_Queue* queue);
 
     std::unique_ptr<AcquisitionInterface> GetAcqBlock(
         const ConfigurationInterface* configuration,
@@ -27,29 +27,53 @@
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
+#include "acq_sample_ring.h"
+#include "acq_sample_ring_sink.h"
 #include "channel.h"
 #include "channel_fsm.h"
 #include "channel_interface.h"
 #include "configuration_interface.h"
+#include "dll_pll_veml_tracking.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_acquisition_record.h"
+#include "gnss_sdr_block_stats.h"
+#include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_memory_accounting.h"
+#include "gnss_sdr_resampling_ratio.h"
+#include "gnss_sdr_thread_pool.h"
 #include "gnss_synchro_monitor.h"
 #include "nav_message_monitor.h"
+#include "observables_binary_sink.h"
+#include "pcps_acquisition.h"
+#include "realtime_headroom_monitor.h"
+#include "rational_resampler_cc.h"
+#include "sample_stream_udp_sink.h"
 #include "signal_source_interface.h"
+#include "spectrum_monitor.h"
+#include "tracking_checkpoint.h"
 #include <boost/lexical_cast.hpp>    // for boost::lexical_cast
 #include <boost/tokenizer.hpp>       // for boost::tokenizer
 #include <glog/logging.h>            // for LOG
 #include <gnuradio/basic_block.h>    // for basic_block
+#include <gnuradio/block.h>          // for block
+#include <gnuradio/block_detail.h>   // for block_detail
+#include <gnuradio/buffer.h>         // for buffer
 #include <gnuradio/filter/firdes.h>  // for gr::filter::firdes
+#include <gnuradio/high_res_timer.h> // for high_res_timer_tps
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/top_block.h>      // for top_block, make_top_block
 #include <pmt/pmt_sugar.h>           // for mp
-#include <algorithm>                 // for transform, sort, unique
-#include <cmath>                     // for floor
+#include <algorithm>                 // for transform, sort, unique, remove_if, find, find_if
+#include <array>                     // for array
+#include <chrono>                    // for steady_clock, duration
+#include <cmath>                     // for floor, ceil
 #include <cstddef>                   // for size_t
 #include <exception>                 // for exception
+#include <fstream>                   // for ifstream
+#include <iomanip>                   // for setprecision
 #include <iostream>                  // for operator<<
 #include <iterator>                  // for insert_iterator, inserter
 #include <memory>                    // for std::shared_ptr
@@ -58,6 +82,7 @@
 #include <stdexcept>                 // for invalid_argument
 #include <thread>                    // for std::thread
 #include <utility>                   // for std::move
+#include <vector>                    // for vector
 
 #ifdef GR_GREATER_38
 #include <gnuradio/filter/fir_filter_blk.h>
@@ -65,20 +90,112 @@
 #include <gnuradio/filter/fir_filter_ccf.h>
 #endif
 
+#if GNURADIO_HAS_BUFFER_READER_H
+#include <gnuradio/buffer_reader.h>
+#endif
+
+#if GNURADIO_HAS_CUSTOM_BUFFERS
+#include "tracking_pinned_input.h"
+#endif
+
+#if ENABLE_FPGA
+#include <gnuradio/blocks/deinterleave.h>
+#include <gnuradio/blocks/vector_to_stream.h>
+#endif
+
 
 #define GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS 8
 
 
+namespace
+{
+// Parses a CPU list in the Linux cpulist format, e.g. "0-3,8,10-11"
+std::vector<int> parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<int> cpus;
+    const boost::char_separator<char> sep(", \n");
+    const boost::tokenizer<boost::char_separator<char>> tok(cpu_list, sep);
+    for (const auto& range : tok)
+        {
+            try
+                {
+                    const size_t dash = range.find('-');
+                    const int first = boost::lexical_cast<int>(range.substr(0, dash));
+                    const int last = (dash == std::string::npos) ? first : boost::lexical_cast<int>(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; cpu++)
+                        {
+                            cpus.push_back(cpu);
+                        }
+                }
+            catch (const boost::bad_lexical_cast&)
+                {
+                    LOG(WARNING) << "Invalid CPU range " << range << " in " << cpu_list;
+                }
+        }
+    return cpus;
+}
+
+
+// CPUs of a NUMA node, empty if the node is not known by the system
+std::vector<int> numa_node_cpu_list(int node)
+{
+    std::ifstream cpulist_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpu_list;
+    if (!cpulist_file.is_open() or !std::getline(cpulist_file, cpu_list))
+        {
+            return {};
+        }
+    return parse_cpu_list(cpu_list);
+}
+
+
+// Highest fill level (0 to 1) of the input and of the output buffers of a block
+void buffer_fill(const gr::block_detail_sptr& detail, double& input_fill, double& output_fill)
+{
+    input_fill = 0.0;
+    output_fill = 0.0;
+    for (int i = 0; i < detail->ninputs(); i++)
+        {
+            const gr::buffer_reader_sptr reader = detail->input(i);
+            if (reader != nullptr and reader->buffer()->bufsize() > 0)
+                {
+                    input_fill = std::max(input_fill, static_cast<double>(reader->items_available()) / reader->buffer()->bufsize());
+                }
+        }
+    for (int i = 0; i < detail->noutputs(); i++)
+        {
+            const gr::buffer_sptr buffer = detail->output(i);
+            if (buffer != nullptr and buffer->bufsize() > 0)
+                {
+                    output_fill = std::max(output_fill, 1.0 - static_cast<double>(buffer->space_available()) / buffer->bufsize());
+                }
+        }
+}
+}  // namespace
+
+
 GNSSFlowgraph::GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configuration,
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue)  // NOLINT(performance-unnecessary-value-param)
+    std::shared_ptr<Control_Queue> queue)  // NOLINT(performance-unnecessary-value-param)
     : configuration_(std::move(configuration)),
       queue_(std::move(queue)),
       connected_(false),
       running_(false),
       multiband_(GNSSFlowgraph::is_multiband()),
-      enable_e6_has_rx_(false)
+      enable_e6_has_rx_(false),
+      assist_dual_frequency_acq_(false),
+      dual_frequency_handoff_(false),
+      channels_status_snapshot_valid_(false)
 {
     enable_fpga_offloading_ = configuration_->property("GNSS-SDR.enable_FPGA", false);
+    assisted_acq_doppler_window_hz_ = configuration_->property("GNSS-SDR.assisted_acquisition_doppler_window_hz", 1500);
+    enable_fast_reacquisition_ = configuration_->property("GNSS-SDR.fast_reacquisition", false);
+    Gnss_Block_Stats::set_enabled(configuration_->property("GNSS-SDR.enable_block_stats", false));
+    detach_idle_signal_paths_ = configuration_->property("GNSS-SDR.detach_idle_signal_paths", false);
+    fast_reacq_max_outage_ms_ = configuration_->property("GNSS-SDR.fast_reacquisition_max_outage_ms", 10000);
+    fast_reacq_doppler_window_hz_ = configuration_->property("GNSS-SDR.fast_reacquisition_doppler_window_hz", 250);
+    tracking_checkpoint_file_ = configuration_->property("GNSS-SDR.tracking_checkpoint_file", std::string(""));
+    tracking_checkpoint_period_ms_ = configuration_->property("GNSS-SDR.tracking_checkpoint_period_ms", tracking_checkpoint_period_ms_);
+    tracking_checkpoint_max_age_s_ = configuration_->property("GNSS-SDR.tracking_checkpoint_max_age_s", tracking_checkpoint_max_age_s_);
     init();
 }
 
@@ -98,6 +215,7 @@ void GNSSFlowgraph::init()
     /*
      * Instantiates the receiver blocks
      */
+    startup_stage_start_ = std::chrono::steady_clock::now();
     auto block_factory = std::make_unique<GNSSBlockFactory>();
 
     channels_status_ = channel_status_msg_receiver_make();
@@ -126,6 +244,12 @@ void GNSSFlowgraph::init()
                 {
                     auto& src = sig_source_.back();
                     auto RF_Channels = src->getRfChannels();
+                    if (i == 0 and !configuration_->property("Channelizer.implementation", std::string("")).empty())
+                        {
+                            // every band extracted by the channelizer feeds its own signal conditioner
+                            RF_Channels = configuration_->property("Channelizer.number_of_bands", 1U);
+                            channelizer_ = block_factory->GetBlock(configuration_.get(), "Channelizer", 1, RF_Channels);
+                        }
                     if (sources_count_ == 1)
                         {
                             std::cout << "RF Channels: " << RF_Channels << '\n';
@@ -144,11 +268,14 @@ void GNSSFlowgraph::init()
     if (!sig_conditioner_.empty())
         {
             signal_conditioner_connected_ = std::vector<bool>(sig_conditioner_.size(), false);
+            signal_conditioner_inputs_ = std::vector<std::pair<gr::basic_block_sptr, int>>(sig_conditioner_.size());
         }
+    startup_stage_done("Signal sources and conditioners");
 
     observables_ = block_factory->GetObservables(configuration_.get());
 
     pvt_ = block_factory->GetPVT(configuration_.get());
+    startup_stage_done("Observables and PVT");
 
     auto channels = block_factory->GetChannels(configuration_.get(), queue_.get());
 
@@ -158,25 +285,46 @@ void GNSSFlowgraph::init()
             std::shared_ptr<GNSSBlockInterface> chan_ = std::move(channels->at(i));
             channels_.push_back(std::dynamic_pointer_cast<ChannelInterface>(chan_));
         }
+    if (enable_fpga_offloading_)
+        {
+            // Channels with host acquisition and tracking blocks take the
+            // signals that do not fit in the FPGA channels, fed by the FPGA
+            // sample tap through one signal conditioner per frequency band
+            for (int i = 0; i < channels_count_; i++)
+                {
+                    if (channels_.at(i) != nullptr and channels_.at(i)->get_left_block_acq() != nullptr)
+                        {
+                            host_channels_.push_back(i);
+                        }
+                    else
+                        {
+                            fpga_channels_.push_back(i);
+                        }
+                }
+            const auto sample_tap = sig_source_.at(0) != nullptr ? sig_source_.at(0)->get_right_block() : nullptr;
+            if (!host_channels_.empty() and sample_tap != nullptr)
+                {
+                    // 8-bit I and Q samples of each band
+                    const auto bands = sample_tap->output_signature()->sizeof_stream_item(0) / 2;
+                    for (int j = 0; j < bands; j++)
+                        {
+                            sig_conditioner_.push_back(block_factory->GetSignalConditioner(configuration_.get(), j));
+                        }
+                    signal_conditioner_connected_ = std::vector<bool>(sig_conditioner_.size(), false);
+                    signal_conditioner_inputs_ = std::vector<std::pair<gr::basic_block_sptr, int>>(sig_conditioner_.size());
+                    std::cout << "Channels with host tracking: " << host_channels_.size() << '\n';
+                }
+        }
+    read_acquisition_configuration();
+    startup_stage_done("Channels");
 
     top_block_ = gr::make_top_block("GNSSFlowgraph");
 
-    mapStringValues_["1C"] = evGPS_1C;
-    mapStringValues_["2S"] = evGPS_2S;
-    mapStringValues_["L5"] = evGPS_L5;
-    mapStringValues_["1B"] = evGAL_1B;
-    mapStringValues_["5X"] = evGAL_5X;
-    mapStringValues_["7X"] = evGAL_7X;
-    mapStringValues_["E6"] = evGAL_E6;
-    mapStringValues_["1G"] = evGLO_1G;
-    mapStringValues_["2G"] = evGLO_2G;
-    mapStringValues_["B1"] = evBDS_B1;
-    mapStringValues_["B3"] = evBDS_B3;
-
     // fill the signals queue with the satellites ID's to be searched by the acquisition
     set_signals_list();
     set_channels_state();
     DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
+    startup_stage_done("Signal lists");
 
     /*
      * Instantiate the receiver monitor block, if required
@@ -190,6 +338,11 @@ void GNSSFlowgraph::init()
                 {
                     enable_protobuf = true;
                 }
+            std::string shm_name;
+            if (configuration_->property("Monitor.transport", std::string("udp")) == "shm")
+                {
+                    shm_name = configuration_->property("Monitor.shm_name", std::string("/gnss-sdr-monitor"));
+                }
             std::string address_string = configuration_->property("Monitor.client_addresses", std::string("127.0.0.1"));
             std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
@@ -199,7 +352,8 @@ void GNSSFlowgraph::init()
             GnssSynchroMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("Monitor.decimation_factor", 1),
                 configuration_->property("Monitor.udp_port", 1234),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf, shm_name,
+                configuration_->property("Monitor.aggregation_window_ms", 0));
         }
 
     /*
@@ -214,6 +368,11 @@ void GNSSFlowgraph::init()
                 {
                     enable_protobuf = true;
                 }
+            std::string shm_name;
+            if (configuration_->property("AcquisitionMonitor.transport", std::string("udp")) == "shm")
+                {
+                    shm_name = configuration_->property("AcquisitionMonitor.shm_name", std::string("/gnss-sdr-acquisition-monitor"));
+                }
             std::string address_string = configuration_->property("AcquisitionMonitor.client_addresses", std::string("127.0.0.1"));
             std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
@@ -222,7 +381,8 @@ void GNSSFlowgraph::init()
             GnssSynchroAcquisitionMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("AcquisitionMonitor.decimation_factor", 1),
                 configuration_->property("AcquisitionMonitor.udp_port", 1235),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf, shm_name,
+                configuration_->property("AcquisitionMonitor.aggregation_window_ms", 0));
         }
 
     /*
@@ -237,6 +397,11 @@ void GNSSFlowgraph::init()
                 {
                     enable_protobuf = true;
                 }
+            std::string shm_name;
+            if (configuration_->property("TrackingMonitor.transport", std::string("udp")) == "shm")
+                {
+                    shm_name = configuration_->property("TrackingMonitor.shm_name", std::string("/gnss-sdr-tracking-monitor"));
+                }
             std::string address_string = configuration_->property("TrackingMonitor.client_addresses", std::string("127.0.0.1"));
             std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
@@ -245,7 +410,8 @@ void GNSSFlowgraph::init()
             GnssSynchroTrackingMonitor_ = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("TrackingMonitor.decimation_factor", 1),
                 configuration_->property("TrackingMonitor.udp_port", 1236),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf, shm_name,
+                configuration_->property("TrackingMonitor.aggregation_window_ms", 0));
         }
 
     /*
@@ -255,12 +421,92 @@ void GNSSFlowgraph::init()
     if (enable_navdata_monitor_)
         {
             // Retrieve monitor properties
+            std::string shm_name;
+            if (configuration_->property("NavDataMonitor.transport", std::string("udp")) == "shm")
+                {
+                    shm_name = configuration_->property("NavDataMonitor.shm_name", std::string("/gnss-sdr-navdata-monitor"));
+                }
             std::string address_string = configuration_->property("NavDataMonitor.client_addresses", std::string("127.0.0.1"));
             std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
-            NavDataMonitor_ = nav_message_monitor_make(udp_addr_vec, configuration_->property("NavDataMonitor.port", 1237));
+            NavDataMonitor_ = nav_message_monitor_make(udp_addr_vec, configuration_->property("NavDataMonitor.port", 1237), shm_name);
+        }
+
+    /*
+     * Instantiate the spectrum monitor blocks, if required
+     */
+    enable_spectrum_monitor_ = configuration_->property("SpectrumMonitor.enable_monitor", false);
+    if (enable_spectrum_monitor_)
+        {
+            Spectrum_Monitor_Conf conf;
+            conf.fft_size = configuration_->property("SpectrumMonitor.fft_size", conf.fft_size);
+            conf.averages = configuration_->property("SpectrumMonitor.averages", conf.averages);
+            conf.bins = configuration_->property("SpectrumMonitor.bins", conf.bins);
+            conf.update_period_ms = configuration_->property("SpectrumMonitor.update_period_ms", conf.update_period_ms);
+            conf.interference_threshold_db = configuration_->property("SpectrumMonitor.interference_threshold_db", conf.interference_threshold_db);
+            conf.kurtosis_threshold = configuration_->property("SpectrumMonitor.kurtosis_threshold", conf.kurtosis_threshold);
+            const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+            std::string address_string = configuration_->property("SpectrumMonitor.client_addresses", std::string("127.0.0.1"));
+            std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
+            std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+            udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+            const auto port = static_cast<uint16_t>(configuration_->property("SpectrumMonitor.udp_port", 1238));
+            for (size_t i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    spectrum_monitors_.push_back(spectrum_monitor_make(static_cast<int>(i), fs, conf, udp_addr_vec, port));
+                }
+        }
+
+    /*
+     * Instantiate the stream of samples to the worker nodes, if required
+     */
+    enable_sample_stream_ = configuration_->property("SampleStream.enable_stream", false);
+    if (enable_sample_stream_)
+        {
+            Sample_Stream_Conf conf;
+            conf.sample_type = configuration_->property("SampleStream.sample_type", conf.sample_type);
+            conf.scale = configuration_->property("SampleStream.scale", conf.scale);
+            conf.payload_bytes = configuration_->property("SampleStream.payload_bytes", conf.payload_bytes);
+            std::string address_string = configuration_->property("SampleStream.client_addresses", std::string("127.0.0.1"));
+            std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
+            std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+            udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+            const auto port = static_cast<uint16_t>(configuration_->property("SampleStream.udp_port", 1240));
+            SampleStream_ = sample_stream_udp_sink_make(static_cast<int>(sig_conditioner_.size()), conf, udp_addr_vec, port);
+        }
+
+    /*
+     * Instantiate the observables binary stream, if required
+     */
+    enable_observables_stream_ = configuration_->property("ObservablesStream.enable_stream", false);
+    if (enable_observables_stream_)
+        {
+            ObservablesBinarySink_ = observables_make_binary_sink(channels_count_,
+                configuration_->property("ObservablesStream.decimation_factor", 1),
+                configuration_->property("ObservablesStream.filename", std::string("observables.bin")));
+        }
+
+    /*
+     * Real-time headroom monitor, for live signal sources
+     */
+    if (configuration_->property("GNSS-SDR.realtime_monitor", false))
+        {
+            Realtime_Headroom_Conf conf;
+            conf.warning_lag_ms = configuration_->property("GNSS-SDR.realtime_warning_lag_ms", conf.warning_lag_ms);
+            conf.overload_lag_ms = configuration_->property("GNSS-SDR.realtime_overload_lag_ms", conf.overload_lag_ms);
+            conf.warning_occupancy = configuration_->property("GNSS-SDR.realtime_warning_buffer_fill", conf.warning_occupancy);
+            conf.overload_occupancy = configuration_->property("GNSS-SDR.realtime_overload_buffer_fill", conf.overload_occupancy);
+            conf.min_processing_ratio = configuration_->property("GNSS-SDR.realtime_min_processing_ratio", conf.min_processing_ratio);
+            conf.window_ms = configuration_->property("GNSS-SDR.realtime_window_ms", conf.window_ms);
+            const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+            headroom_monitor_ = std::make_unique<Realtime_Headroom_Monitor>(fs, conf);
+            enable_load_shedding_ = configuration_->property("GNSS-SDR.realtime_load_shedding", false);
+            shedding_min_channels_ = configuration_->property("GNSS-SDR.realtime_shedding_min_channels", 4);
+            shedding_period_ms_ = configuration_->property("GNSS-SDR.realtime_shedding_period_ms", 5000);
+            recovery_period_ms_ = configuration_->property("GNSS-SDR.realtime_recovery_period_ms", 30000);
         }
+    startup_stage_done("Monitors");
 }
 
 
@@ -309,6 +555,11 @@ void GNSSFlowgraph::stop()
             top_block_->wait();
         }
 
+    if (acquisition_record_ != nullptr)
+        {
+            acquisition_record_->save();
+        }
+
     running_ = false;
 }
 
@@ -335,6 +586,7 @@ void GNSSFlowgraph::connect()
             LOG(WARNING) << "flowgraph already connected";
             return;
         }
+    startup_stage_start_ = std::chrono::steady_clock::now();
 
 #if ENABLE_FPGA
     if (enable_fpga_offloading_ == true)
@@ -367,6 +619,8 @@ void GNSSFlowgraph::connect()
     connected_ = true;
     LOG(INFO) << "Flowgraph connected";
     top_block_->dump();
+    startup_stage_done("Connection of the flow graph");
+    print_startup_report();
 }
 
 
@@ -420,6 +674,9 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
             return 1;
         }
 
+    set_tracking_affinity();
+    set_blocks_scheduling();
+
     if (connect_observables() != 0)
         {
             return 1;
@@ -453,10 +710,17 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
 
     check_signal_conditioners();
 
+    if (connect_tracking_replay_record() != 0)
+        {
+            return 1;
+        }
+    startup_stage_done("Connection of the blocks");
+
     if (assign_channels() != 0)
         {
             return 1;
         }
+    startup_stage_done("Assignment of the channels");
 
     if (connect_observables_to_pvt() != 0)
         {
@@ -526,11 +790,22 @@ int GNSSFlowgraph::connect_fpga_flowgraph()
         }
 
     // Connect blocks to the top_block
+    for (auto& src : sig_source_)
+        {
+            // the samples only reach the host if the FPGA sample tap is enabled
+            src->connect(top_block_);
+        }
+
     if (connect_channels() != 0)
         {
             return 1;
         }
 
+    if (!host_channels_.empty() and connect_fpga_host_channels() != 0)
+        {
+            return 1;
+        }
+
     if (connect_observables() != 0)
         {
             return 1;
@@ -541,6 +816,8 @@ int GNSSFlowgraph::connect_fpga_flowgraph()
             return 1;
         }
 
+    set_blocks_scheduling();
+
     DLOG(INFO) << "Blocks connected internally to the top_block";
 
     // Connect the counter
@@ -602,6 +879,19 @@ int GNSSFlowgraph::connect_signal_sources()
                     return 1;
                 }
         }
+    if (channelizer_ != nullptr)
+        {
+            try
+                {
+                    channelizer_->connect(top_block_);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(ERROR) << "Can't connect the channelizer block internally: " << e.what();
+                    top_block_->disconnect_all();
+                    return 1;
+                }
+        }
     DLOG(INFO) << "Signal Source blocks successfully connected to the top_block";
     return 0;
 }
@@ -720,6 +1010,175 @@ int GNSSFlowgraph::connect_channels()
 }
 
 
+// Pins the tracking blocks of each group of GNSS-SDR.tracking_channels_per_core
+// consecutive channels to the same CPU, taken in order from
+// GNSS-SDR.tracking_cpu_list and/or the CPUs of GNSS-SDR.tracking_numa_node.
+// Channels of a group then hand over their core to each other instead of
+// migrating across the machine with their working sets.
+void GNSSFlowgraph::set_tracking_affinity()
+{
+    const int channels_per_core = configuration_->property("GNSS-SDR.tracking_channels_per_core", 0);
+    if (channels_per_core <= 0)
+        {
+            return;
+        }
+    std::vector<int> cpus = parse_cpu_list(configuration_->property("GNSS-SDR.tracking_cpu_list", std::string("")));
+    const int numa_node = configuration_->property("GNSS-SDR.tracking_numa_node", -1);
+    if (numa_node >= 0)
+        {
+            const std::vector<int> node_cpus = numa_node_cpu_list(numa_node);
+            if (node_cpus.empty())
+                {
+                    LOG(WARNING) << "Unknown NUMA node " << numa_node << ", GNSS-SDR.tracking_numa_node ignored";
+                }
+            else if (cpus.empty())
+                {
+                    cpus = node_cpus;
+                }
+            else
+                {
+                    cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&node_cpus](int cpu) {
+                        return std::find(node_cpus.cbegin(), node_cpus.cend(), cpu) == node_cpus.cend();
+                    }),
+                        cpus.end());
+                }
+        }
+    if (cpus.empty())
+        {
+            for (int cpu = 0; cpu < static_cast<int>(std::thread::hardware_concurrency()); cpu++)
+                {
+                    cpus.push_back(cpu);
+                }
+        }
+    if (cpus.empty())
+        {
+            LOG(WARNING) << "No CPUs available for the tracking channels, affinity not set";
+            return;
+        }
+
+    for (int i = 0; i < channels_count_; i++)
+        {
+            // Groups wrap around the list if there are more groups than CPUs
+            const int cpu = cpus[(i / channels_per_core) % cpus.size()];
+            try
+                {
+                    channels_.at(i)->get_left_block_trk()->set_processor_affinity(std::vector<int>{cpu});
+                    DLOG(INFO) << "Tracking of channel " << i << " pinned to CPU " << cpu;
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Can't set the CPU affinity of the tracking block of channel " << i << ": " << e.what();
+                }
+        }
+}
+
+
+// Applies the scheduling options of each processing block, read from its
+// role (e.g. SignalSource.buffer_size, Tracking_1C.affinity, PVT.rt_priority).
+// The channel blocks first look for the per-channel role (e.g.
+// Tracking_1C3.affinity). This is done before the flowgraph is started, so
+// that GNU Radio allocates the buffers and creates the threads with them.
+void GNSSFlowgraph::set_blocks_scheduling()
+{
+    for (const auto& source : sig_source_)
+        {
+            if (source != nullptr)
+                {
+                    set_block_scheduling(source->role(), "", source->get_right_block());
+                }
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            if (conditioner != nullptr)
+                {
+                    set_block_scheduling(conditioner->role(), "", conditioner->get_right_block());
+                }
+        }
+    for (int i = 0; i < channels_count_; i++)
+        {
+            if (channels_.at(i) == nullptr)
+                {
+                    continue;
+                }
+            const std::string signal = channels_.at(i)->get_signal().get_signal_str();
+            const std::string channel = std::to_string(i);
+            set_block_scheduling("Acquisition_" + signal, "Acquisition_" + signal + channel, channels_.at(i)->get_right_block_acq());
+            set_block_scheduling("Tracking_" + signal, "Tracking_" + signal + channel, channels_.at(i)->get_left_block_trk());
+            set_block_scheduling("TelemetryDecoder_" + signal, "TelemetryDecoder_" + signal + channel, channels_.at(i)->get_right_block());
+        }
+    if (observables_ != nullptr)
+        {
+            set_block_scheduling(observables_->role(), "", observables_->get_left_block());
+        }
+    if (pvt_ != nullptr)
+        {
+            set_block_scheduling(pvt_->role(), "", pvt_->get_left_block());
+        }
+}
+
+
+// Options of a block:
+//   <role>.affinity         CPUs of its thread, in cpulist format (e.g. "2-3")
+//   <role>.rt_priority      real-time priority of its thread (1 to 99, SCHED_FIFO)
+//   <role>.buffer_size      minimum size of its output buffers, in items
+//   <role>.max_buffer_size  maximum size of its output buffers, in items
+void GNSSFlowgraph::set_block_scheduling(const std::string& role, const std::string& channel_role, const gr::basic_block_sptr& block)
+{
+    // the options of the channel, if present, override the ones of its signal
+    std::string cpu_list = configuration_->property(role + ".affinity", std::string(""));
+    int rt_priority = configuration_->property(role + ".rt_priority", 0);
+    int64_t buffer_size = configuration_->property(role + ".buffer_size", static_cast<int64_t>(0));
+    int64_t max_buffer_size = configuration_->property(role + ".max_buffer_size", static_cast<int64_t>(0));
+    if (!channel_role.empty())
+        {
+            cpu_list = configuration_->property(channel_role + ".affinity", cpu_list);
+            rt_priority = configuration_->property(channel_role + ".rt_priority", rt_priority);
+            buffer_size = configuration_->property(channel_role + ".buffer_size", buffer_size);
+            max_buffer_size = configuration_->property(channel_role + ".max_buffer_size", max_buffer_size);
+        }
+    if (cpu_list.empty() && rt_priority <= 0 && buffer_size <= 0 && max_buffer_size <= 0)
+        {
+            return;
+        }
+    const std::string name = channel_role.empty() ? role : channel_role;
+    auto* gr_block = dynamic_cast<gr::block*>(block.get());
+    if (gr_block == nullptr)
+        {
+            LOG(WARNING) << "The block of " << name << " is not a GNU Radio block, its scheduling options are ignored";
+            return;
+        }
+    try
+        {
+            if (!cpu_list.empty())
+                {
+                    const std::vector<int> cpus = parse_cpu_list(cpu_list);
+                    if (!cpus.empty())
+                        {
+                            gr_block->set_processor_affinity(cpus);
+                        }
+                }
+            if (rt_priority > 0)
+                {
+                    gr_block->set_thread_priority(rt_priority);
+                }
+            if (buffer_size > 0)
+                {
+                    gr_block->set_min_output_buffer(static_cast<long>(buffer_size));  // NOLINT(google-runtime-int)
+                }
+            if (max_buffer_size > 0)
+                {
+                    gr_block->set_max_output_buffer(static_cast<long>(max_buffer_size));  // NOLINT(google-runtime-int)
+                }
+            DLOG(INFO) << "Scheduling of " << name << ": affinity " << cpu_list << ", rt_priority " << rt_priority
+                       << ", buffer_size " << buffer_size << ", max_buffer_size " << max_buffer_size;
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Can't set the scheduling options of " << name << ": " << e.what();
+        }
+}
+
+
 int GNSSFlowgraph::connect_observables()
 {
     if (observables_ == nullptr)
@@ -786,6 +1245,17 @@ int GNSSFlowgraph::connect_sample_counter()
             ch_out_sample_counter_ = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
             top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter_, 0);
             top_block_->connect(ch_out_sample_counter_, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+            receiver_clock_ = ch_out_sample_counter_->get_receiver_clock();
+            // the tracking blocks take the time tags of the signal source from
+            // the sample counter, instead of searching their input for them
+            for (int i = 0; i < channels_count_; i++)
+                {
+                    auto* trk = dynamic_cast<dll_pll_veml_tracking*>(channels_.at(i)->get_right_block_trk().get());
+                    if (trk != nullptr)
+                        {
+                            trk->set_time_map(ch_out_sample_counter_->get_time_map());
+                        }
+                }
         }
     catch (const std::exception& e)
         {
@@ -814,6 +1284,7 @@ int GNSSFlowgraph::connect_fpga_sample_counter()
             const int observable_interval_ms = configuration_->property("GNSS-SDR.observable_interval_ms", 20);
             ch_out_fpga_sample_counter_ = gnss_sdr_make_fpga_sample_counter(fs, observable_interval_ms);
             top_block_->connect(ch_out_fpga_sample_counter_, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+            receiver_clock_ = ch_out_fpga_sample_counter_->get_receiver_clock();
         }
     catch (const std::exception& e)
         {
@@ -833,6 +1304,60 @@ int GNSSFlowgraph::connect_fpga_sample_counter()
     LOG(INFO) << "FPGA sample counter successfully connected";
     return 0;
 }
+
+
+// Feeds the channels with host acquisition and tracking blocks with the
+// samples of the FPGA sample tap, one signal conditioner per frequency band
+int GNSSFlowgraph::connect_fpga_host_channels()
+{
+    const auto sample_tap = sig_source_.at(0)->get_right_block();
+    if (sample_tap == nullptr)
+        {
+            help_hint_ += " * Some channels have acquisition and tracking implementations that run in the host,\n";
+            help_hint_ += "   but the FPGA samples do not reach the host.\n";
+            help_hint_ += "   Set " + sig_source_.at(0)->role() + ".enable_sample_tap=true, or use FPGA implementations in all the channels.\n";
+            top_block_->disconnect_all();
+            return 1;
+        }
+    if (connect_signal_conditioners() != 0)
+        {
+            return 1;
+        }
+    try
+        {
+            const auto bands = static_cast<int>(sig_conditioner_.size());
+            gr::basic_block_sptr bands_block = sample_tap;
+            if (bands > 1)
+                {
+                    bands_block = gr::blocks::deinterleave::make(2 * sizeof(int8_t));
+                    top_block_->connect(sample_tap, 0, bands_block, 0);
+                    sample_tap_blocks_.push_back(bands_block);
+                }
+            for (int j = 0; j < bands; j++)
+                {
+                    // the signal conditioners take the 8-bit I and Q samples as a stream of bytes
+                    sample_tap_blocks_.push_back(gr::blocks::vector_to_stream::make(sizeof(int8_t), 2));
+                    top_block_->connect(bands_block, bands > 1 ? j : 0, sample_tap_blocks_.back(), 0);
+                    top_block_->connect(sample_tap_blocks_.back(), 0, sig_conditioner_.at(j)->get_left_block(), 0);
+                    signal_conditioner_inputs_.at(j) = std::make_pair(sample_tap_blocks_.back(), 0);
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect the FPGA sample tap to the signal conditioners: " << e.what();
+            help_hint_ += " * The signal conditioners of the channels that run in the host must take 8-bit samples,\n";
+            help_hint_ += "   e.g. with DataTypeAdapter.implementation=Ibyte_To_Complex\n";
+            top_block_->disconnect_all();
+            return 1;
+        }
+    if (connect_signal_conditioners_to_channels() != 0)
+        {
+            return 1;
+        }
+    check_signal_conditioners();
+    LOG(INFO) << host_channels_.size() << " channels with host tracking fed by the FPGA sample tap";
+    return 0;
+}
 #endif
 
 
@@ -852,13 +1377,30 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                 {
                     auto& src = sig_source_.at(i);
 
+                    if (i == 0 and channelizer_ != nullptr)
+                        {
+                            // Wideband source split by the channelizer: band j feeds conditioner j
+                            LOG(INFO) << "connecting sig_source_ 0 to the channelizer";
+                            top_block_->connect(src->get_right_block(), 0, channelizer_->get_left_block(), 0);
+                            const auto bands = configuration_->property("Channelizer.number_of_bands", 1U);
+                            for (auto j = 0U; j < bands; ++j)
+                                {
+                                    LOG(INFO) << "connecting channelizer band " << j << " to conditioner " << signal_conditioner_ID;
+                                    top_block_->connect(channelizer_->get_right_block(static_cast<int>(j)), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                    signal_conditioner_inputs_.at(signal_conditioner_ID) = std::make_pair(channelizer_->get_right_block(static_cast<int>(j)), 0);
+                                    signal_conditioner_ID++;
+                                }
+                            continue;
+                        }
+
                     // TODO: Remove this array implementation and create generic multistream connector
                     // (if a signal source has more than 1 stream, then connect it to the multistream signal conditioner)
                     if (src->implementation() == "Raw_Array_Signal_Source")
                         {
                             // Multichannel Array
                             std::cout << "ARRAY MODE\n";
-                            for (int j = 0; j < GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS; j++)
+                            const int elements = configuration_->property(src->role() + ".channels", GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS);
+                            for (int j = 0; j < elements; j++)
                                 {
                                     std::cout << "connecting ch " << j << '\n';
                                     top_block_->connect(src->get_right_block(), j, sig_conditioner_.at(i)->get_left_block(), j);
@@ -892,6 +1434,7 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                                                 {
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    signal_conditioner_inputs_.at(signal_conditioner_ID) = std::make_pair(src->get_right_block(), static_cast<int>(j));
                                                 }
                                         }
                                     else
@@ -901,12 +1444,14 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                                                     // RF_channel 0 backward compatibility with single channel sources
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << 0 << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    signal_conditioner_inputs_.at(signal_conditioner_ID) = std::make_pair(src->get_right_block(), 0);
                                                 }
                                             else
                                                 {
                                                     // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    signal_conditioner_inputs_.at(signal_conditioner_ID) = std::make_pair(src->get_right_block(j), 0);
                                                 }
                                         }
                                     signal_conditioner_ID++;
@@ -944,9 +1489,16 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
 {
     for (int i = 0; i < channels_count_; i++)
         {
+            if (enable_fpga_offloading_ and channels_.at(i)->get_left_block_acq() == nullptr)
+                {
+                    continue;  // FPGA channel, its samples do not go through the host
+                }
             int selected_signal_conditioner_ID = 0;
             const bool use_acq_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
+            const uint32_t acq_resampler_max_interpolation = configuration_->property("GNSS-SDR.acquisition_resampler_max_interpolation", 1U);
+            const double acq_ring_ms = configuration_->property("GNSS-SDR.acquisition_ring_ms", 250.0);
             const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
+            const bool accelerator_buffers = configuration_->property("GNSS-SDR.accelerator_buffers", false);
 
             try
                 {
@@ -958,43 +1510,58 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                 }
             try
                 {
+                    gr::basic_block_sptr conditioner_output = sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block();
+                    if (accelerator_buffers)
+                        {
+#if GNURADIO_HAS_CUSTOM_BUFFERS
+                            // The channels read the conditioned samples from pinned
+                            // host memory, which the GPU correlators access in place
+                            pinned_inputs_.resize(sig_conditioner_.size());
+                            auto& pinned_input = pinned_inputs_.at(selected_signal_conditioner_ID);
+                            if (pinned_input == nullptr)
+                                {
+                                    pinned_input = make_tracking_pinned_input();
+                                    top_block_->connect(conditioner_output, 0, pinned_input, 0);
+                                    LOG(INFO) << "Channels of RF channel " << selected_signal_conditioner_ID << " read their samples from pinned host memory";
+                                }
+                            conditioner_output = pinned_input;
+#else
+                            LOG(WARNING) << "GNSS-SDR.accelerator_buffers requires GNU Radio 3.10 or later and -DENABLE_CUDA=ON. Ignored.";
+#endif
+                        }
                     // Enable automatic resampler for the acquisition, if required
                     if (use_acq_resampler == true)
                         {
                             // create acquisition resamplers if required
-                            double resampler_ratio = 1.0;
                             double acq_fs = fs;
                             // find the signal associated to this channel
-                            switch (mapStringValues_[channels_.at(i)->get_signal().get_signal_str()])
+                            switch (channels_.at(i)->get_signal().get_id().code())
                                 {
-                                case evGPS_1C:
+                                case Gnss_Signal_Code::SIG_1C:
                                     acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGPS_2S:
+                                case Gnss_Signal_Code::SIG_2S:
                                     acq_fs = GPS_L2C_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGPS_L5:
+                                case Gnss_Signal_Code::SIG_L5:
                                     acq_fs = GPS_L5_OPT_ACQ_FS_SPS;
                                     break;
-                                case evSBAS_1C:
-                                    acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGAL_1B:
+                                case Gnss_Signal_Code::SIG_1B:
                                     acq_fs = GALILEO_E1_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGAL_5X:
+                                case Gnss_Signal_Code::SIG_5X:
                                     acq_fs = GALILEO_E5A_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGAL_7X:
+                                case Gnss_Signal_Code::SIG_7X:
                                     acq_fs = GALILEO_E5B_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGAL_E6:
+                                case Gnss_Signal_Code::SIG_E6:
                                     acq_fs = GALILEO_E6_OPT_ACQ_FS_SPS;
                                     break;
-                                case evGLO_1G:
-                                case evGLO_2G:
-                                case evBDS_B1:
-                                case evBDS_B3:
+                                case Gnss_Signal_Code::SIG_1G:
+                                case Gnss_Signal_Code::SIG_2G:
+                                case Gnss_Signal_Code::SIG_B1:
+                                case Gnss_Signal_Code::SIG_B3:
                                     acq_fs = fs;
                                     break;
                                 default:
@@ -1005,68 +1572,97 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                                 {
                                     // check if the resampler is already created for the channel system/signal and for the specific RF Channel
                                     const std::string map_key = channels_.at(i)->get_signal().get_signal_str() + std::to_string(selected_signal_conditioner_ID);
-                                    resampler_ratio = static_cast<double>(fs) / acq_fs;
-                                    int decimation = floor(resampler_ratio);
-                                    while (fs % decimation > 0)
-                                        {
-                                            decimation--;
-                                        };
-                                    const double acq_fs_decimated = static_cast<double>(fs) / static_cast<double>(decimation);
+                                    // integer decimation, or a rational ratio if allowed
+                                    const Resampling_Ratio ratio = acquisition_resampling_ratio(fs, acq_fs, acq_resampler_max_interpolation);
 
-                                    if (decimation > 1)
+                                    if (ratio.decimation > ratio.interpolation)
                                         {
-                                            // create a FIR low pass filter
-                                            std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
-                                                fs,
-                                                acq_fs_decimated / 2.1,
-                                                acq_fs_decimated / 2);
-
-                                            gr::basic_block_sptr fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(decimation, taps);
-
-                                            std::pair<std::map<std::string, gr::basic_block_sptr>::iterator, bool> ret;
-                                            ret = acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, fir_filter_ccf_));
+                                            gr::basic_block_sptr acq_resampler;
+                                            size_t ntaps;
+                                            uint32_t latency_samples;
+                                            if (ratio.interpolation == 1)
+                                                {
+                                                    const double acq_fs_decimated = ratio.output_rate(static_cast<double>(fs));
+                                                    // create a FIR low pass filter
+                                                    std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
+                                                        fs,
+                                                        acq_fs_decimated / 2.1,
+                                                        acq_fs_decimated / 2);
+                                                    acq_resampler = gr::filter::fir_filter_ccf::make(ratio.decimation, taps);
+                                                    ntaps = taps.size();
+                                                    latency_samples = (taps.size() - 1) / 2;
+                                                }
+                                            else
+                                                {
+                                                    auto rational_resampler = make_rational_resampler_cc(ratio.interpolation, ratio.decimation);
+                                                    ntaps = rational_resampler->ntaps();
+                                                    latency_samples = static_cast<uint32_t>(std::round(rational_resampler->delay()));
+                                                    acq_resampler = rational_resampler;
+                                                }
+
+                                            std::pair<std::map<std::string, gr::basic_block_sptr>::iterator, bool> ret;
+                                            ret = acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, acq_resampler));
                                             if (ret.second == true)
                                                 {
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                                    top_block_->connect(conditioner_output, 0,
                                                         acq_resamplers_.at(map_key), 0);
                                                     LOG(INFO) << "Created "
                                                               << channels_.at(i)->get_signal().get_signal_str()
-                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << taps.size() << " taps and decimation factor of " << decimation;
+                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << ntaps << " taps and resampling ratio of " << ratio.interpolation << "/" << ratio.decimation;
+                                                    if (acq_ring_ms > 0.0)
+                                                        {
+                                                            // one copy of the resampled stream for all the acquisitions of this signal
+                                                            const auto capacity = static_cast<size_t>(std::ceil(ratio.output_rate(static_cast<double>(fs)) * acq_ring_ms / 1000.0));
+                                                            acq_sample_rings_[map_key] = std::make_shared<Acq_Sample_Ring>(capacity);
+                                                            acq_sample_ring_sinks_[map_key] = make_acq_sample_ring_sink(acq_sample_rings_.at(map_key));
+                                                            top_block_->connect(acq_resamplers_.at(map_key), 0, acq_sample_ring_sinks_.at(map_key), 0);
+                                                            LOG(INFO) << "Created shared acquisition ring of " << capacity << " samples for "
+                                                                      << channels_.at(i)->get_signal().get_signal_str() << " in RF channel " << selected_signal_conditioner_ID;
+                                                        }
                                                 }
                                             else
                                                 {
                                                     LOG(INFO) << "Found existing "
                                                               << channels_.at(i)->get_signal().get_signal_str()
-                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << taps.size() << " taps and decimation factor of " << decimation;
+                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << ntaps << " taps and resampling ratio of " << ratio.interpolation << "/" << ratio.decimation;
                                                 }
 
                                             top_block_->connect(acq_resamplers_.at(map_key), 0,
                                                 channels_.at(i)->get_left_block_acq(), 0);
 
                                             std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(i));
-                                            channel_ptr->acquisition()->set_resampler_latency((taps.size() - 1) / 2);
+                                            channel_ptr->acquisition()->set_resampler_latency(latency_samples);
+
+                                            if (acq_sample_rings_.count(map_key) > 0)
+                                                {
+                                                    auto* acq = dynamic_cast<pcps_acquisition*>(channels_.at(i)->get_right_block_acq().get());
+                                                    if (acq != nullptr)
+                                                        {
+                                                            acq->set_sample_ring(acq_sample_rings_.at(map_key));
+                                                        }
+                                                }
                                         }
                                     else
                                         {
                                             LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
                                             // resampler not required!
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                            top_block_->connect(conditioner_output, 0,
                                                 channels_.at(i)->get_left_block_acq(), 0);
                                         }
                                 }
                             else
                                 {
                                     LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                    top_block_->connect(conditioner_output, 0,
                                         channels_.at(i)->get_left_block_acq(), 0);
                                 }
                         }
                     else
                         {
-                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                            top_block_->connect(conditioner_output, 0,
                                 channels_.at(i)->get_left_block_acq(), 0);
                         }
-                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                    top_block_->connect(conditioner_output, 0,
                         channels_.at(i)->get_left_block_trk(), 0);
                 }
             catch (const std::exception& e)
@@ -1163,6 +1759,26 @@ int GNSSFlowgraph::connect_gnss_synchro_monitor()
 }
 
 
+int GNSSFlowgraph::connect_observables_stream()
+{
+    try
+        {
+            for (int i = 0; i < channels_count_; i++)
+                {
+                    top_block_->connect(observables_->get_right_block(), i, ObservablesBinarySink_, i);
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect observables to the observables binary stream: " << e.what();
+            top_block_->disconnect_all();
+            return 1;
+        }
+    DLOG(INFO) << "observables_binary_sink successfully connected to Observables block";
+    return 0;
+}
+
+
 int GNSSFlowgraph::connect_acquisition_monitor()
 {
     try
@@ -1228,6 +1844,62 @@ int GNSSFlowgraph::connect_navdata_monitor()
 }
 
 
+int GNSSFlowgraph::connect_spectrum_monitor()
+{
+    try
+        {
+            for (size_t i = 0; i < spectrum_monitors_.size(); i++)
+                {
+                    const auto right_block = sig_conditioner_.at(i)->get_right_block();
+                    if (right_block == nullptr or right_block->output_signature()->sizeof_stream_item(0) != sizeof(gr_complex))
+                        {
+                            LOG(WARNING) << "Signal conditioner " << i << " does not deliver gr_complex samples, it will not be monitored by SpectrumMonitor";
+                            continue;
+                        }
+                    top_block_->connect(right_block, 0, spectrum_monitors_[i], 0);
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect signal conditioners to SpectrumMonitor blocks: " << e.what();
+            top_block_->disconnect_all();
+            return 1;
+        }
+    DLOG(INFO) << "spectrum monitor successfully connected to signal conditioners";
+    return 0;
+}
+
+
+int GNSSFlowgraph::connect_sample_stream()
+{
+    try
+        {
+            for (size_t i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    const auto right_block = sig_conditioner_.at(i)->get_right_block();
+                    if (right_block == nullptr or right_block->output_signature()->sizeof_stream_item(0) != sizeof(gr_complex))
+                        {
+                            // the bands of a packet must be aligned, so no band is streamed
+                            LOG(WARNING) << "Signal conditioner " << i << " does not deliver gr_complex samples, SampleStream disabled";
+                            return 0;
+                        }
+                }
+            for (size_t i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    top_block_->connect(sig_conditioner_.at(i)->get_right_block(), 0, SampleStream_, static_cast<int>(i));
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect signal conditioners to SampleStream block: " << e.what();
+            top_block_->disconnect_all();
+            return 1;
+        }
+    DLOG(INFO) << "sample stream successfully connected to signal conditioners";
+    return 0;
+}
+
+
 int GNSSFlowgraph::connect_monitors()
 {
     // GNSS SYNCHRO MONITOR
@@ -1239,6 +1911,15 @@ int GNSSFlowgraph::connect_monitors()
                 }
         }
 
+    // OBSERVABLES BINARY STREAM
+    if (enable_observables_stream_)
+        {
+            if (connect_observables_stream() != 0)
+                {
+                    return 1;
+                }
+        }
+
     // GNSS SYNCHRO ACQUISITION MONITOR
     if (enable_acquisition_monitor_)
         {
@@ -1265,6 +1946,24 @@ int GNSSFlowgraph::connect_monitors()
                     return 1;
                 }
         }
+
+    // SPECTRUM MONITOR
+    if (enable_spectrum_monitor_)
+        {
+            if (connect_spectrum_monitor() != 0)
+                {
+                    return 1;
+                }
+        }
+
+    // SAMPLE STREAM TO WORKER NODES
+    if (enable_sample_stream_)
+        {
+            if (connect_sample_stream() != 0)
+                {
+                    return 1;
+                }
+        }
     return 0;
 }
 
@@ -1276,10 +1975,9 @@ int GNSSFlowgraph::connect_gal_e6_has()
             bool gal_e6_channels = false;
             for (int i = 0; i < channels_count_; i++)
                 {
-                    const std::string gnss_signal = channels_.at(i)->get_signal().get_signal_str();
-                    switch (mapStringValues_[gnss_signal])
+                    switch (channels_.at(i)->get_signal().get_id().code())
                         {
-                        case evGAL_E6:
+                        case Gnss_Signal_Code::SIG_E6:
                             top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("E6_HAS_from_TLM"), gal_e6_has_rx_, pmt::mp("E6_HAS_from_TLM"));
                             gal_e6_channels = true;
                             break;
@@ -1313,6 +2011,19 @@ void GNSSFlowgraph::check_signal_conditioners()
         {
             if (signal_conditioner_connected_.at(n) == false)
                 {
+                    // The first conditioner also feeds the sample counter
+                    if (detach_idle_signal_paths_ and n > 0 and signal_conditioner_inputs_.at(n).first != nullptr)
+                        {
+                            // Take the whole branch out of the flow graph, so that it
+                            // does not filter nor resample samples that nobody reads
+                            const auto& input = signal_conditioner_inputs_.at(n);
+                            top_block_->disconnect(input.first, input.second, sig_conditioner_.at(n)->get_left_block(), 0);
+                            sig_conditioner_.at(n)->disconnect(top_block_);
+                            null_sinks_.push_back(gr::blocks::null_sink::make(input.first->output_signature()->sizeof_stream_item(input.second)));
+                            top_block_->connect(input.first, input.second, null_sinks_.back(), 0);
+                            LOG(INFO) << "Signal conditioner " << n << " detached from the flow graph due to lack of connection to any channel";
+                            continue;
+                        }
                     null_sinks_.push_back(gr::blocks::null_sink::make(sizeof(gr_complex)));
                     top_block_->connect(sig_conditioner_.at(n)->get_right_block(), 0,
                         null_sinks_.back(), 0);
@@ -1322,22 +2033,117 @@ void GNSSFlowgraph::check_signal_conditioners()
 }
 
 
-int GNSSFlowgraph::assign_channels()
+// Records the input of the tracking blocks and the acquisitions that start
+// them, so that the tracking stage can be run again alone by tracking-replay
+int GNSSFlowgraph::connect_tracking_replay_record()
 {
-    // Put channels fixed to a given satellite at the beginning of the vector, then the rest
-    std::vector<unsigned int> vector_of_channels;
+    const std::string dir = configuration_->property("GNSS-SDR.tracking_replay_record_dir", std::string(""));
+    if (dir.empty())
+        {
+            return 0;
+        }
+    errorlib::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec)
+        {
+            help_hint_ += " * Could not create the directory GNSS-SDR.tracking_replay_record_dir=" + dir + "\n";
+            return 1;
+        }
+    try
+        {
+            for (size_t n = 0; n < sig_conditioner_.size(); n++)
+                {
+                    if (signal_conditioner_connected_.at(n))
+                        {
+                            const std::string filename = dir + "/signal_conditioner_" + std::to_string(n) + ".dat";
+                            replay_sinks_.push_back(gr::blocks::file_sink::make(sizeof(gr_complex), filename.c_str()));
+                            top_block_->connect(sig_conditioner_.at(n)->get_right_block(), 0, replay_sinks_.back(), 0);
+                            LOG(INFO) << "Recording the output of signal conditioner " << n << " to " << filename;
+                        }
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect the tracking replay record: " << e.what();
+            top_block_->disconnect_all();
+            return 1;
+        }
+
+    acquisition_record_ = std::make_shared<Gnss_Sdr_Acquisition_Record>(dir + "/acquisitions.xml");
+    for (const auto& ch : channels_)
+        {
+            auto channel = std::dynamic_pointer_cast<Channel>(ch);
+            if (channel != nullptr)
+                {
+                    channel->set_acquisition_record(acquisition_record_);
+                }
+        }
+    return 0;
+}
+
+
+// Reads once the configuration that the acquisition manager needs on each channel event
+void GNSSFlowgraph::read_acquisition_configuration()
+{
+    channels_1C_count_ = configuration_->property("Channels_1C.count", 0);
+    channels_1B_count_ = configuration_->property("Channels_1B.count", 0);
+    assist_dual_frequency_acq_ = configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_);
+    dual_frequency_handoff_ = assist_dual_frequency_acq_ && configuration_->property("GNSS-SDR.dual_frequency_handoff", false);
+    channels_satellite_ = std::vector<unsigned int>(channels_count_, 0);
     for (int i = 0; i < channels_count_; i++)
         {
-            unsigned int sat = 0;
             try
                 {
-                    sat = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
+                    channels_satellite_[i] = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
                 }
             catch (const std::exception& e)
                 {
                     LOG(WARNING) << e.what();
                 }
-            if (sat == 0)
+        }
+}
+
+
+void GNSSFlowgraph::startup_stage_done(const std::string& stage)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(now - startup_stage_start_).count();
+    startup_stages_.emplace_back(stage, elapsed_ms);
+    LOG(INFO) << "Startup stage \"" << stage << "\" took " << elapsed_ms << " ms";
+    startup_stage_start_ = now;
+}
+
+
+void GNSSFlowgraph::print_startup_report() const
+{
+    double total_ms = 0.0;
+    std::stringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Receiver startup time per stage:\n";
+    for (const auto& stage : startup_stages_)
+        {
+            report << "  " << stage.first << ": " << stage.second << " ms\n";
+            total_ms += stage.second;
+        }
+    report << "  Total: " << total_ms << " ms\n";
+    LOG(INFO) << report.str();
+    if (configuration_->property("GNSS-SDR.print_startup_report", false))
+        {
+            std::cout << report.str();
+        }
+}
+
+
+int GNSSFlowgraph::assign_channels()
+{
+    read_acquisition_configuration();
+    channels_status_snapshot_valid_ = false;
+
+    // Put channels fixed to a given satellite at the beginning of the vector, then the rest
+    std::vector<unsigned int> vector_of_channels;
+    for (int i = 0; i < channels_count_; i++)
+        {
+            if (channels_satellite_[i] == 0)
                 {
                     vector_of_channels.push_back(i);
                 }
@@ -1437,19 +2243,13 @@ int GNSSFlowgraph::assign_channels()
             return 1;
         }
 
+    restore_tracking_checkpoint();
+
     // Assign satellites to channels in the initialization
     for (unsigned int& i : vector_of_channels)
         {
             const std::string gnss_signal_str = channels_.at(i)->get_signal().get_signal_str();  // use channel's implicit signal
-            unsigned int sat = 0;
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            const unsigned int sat = channels_satellite_[i];
             if (sat == 0)
                 {
                     bool assistance_available;
@@ -1462,69 +2262,69 @@ int GNSSFlowgraph::assign_channels()
                 {
                     std::string gnss_system_str;
                     Gnss_Signal gnss_signal;
-                    switch (mapStringValues_[gnss_signal_str])
+                    switch (gnss_signal_code(gnss_signal_str.c_str()))
                         {
-                        case evGPS_1C:
+                        case Gnss_Signal_Code::SIG_1C:
                             gnss_system_str = "GPS";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GPS_1C_signals_.remove(gnss_signal);
                             break;
 
-                        case evGPS_2S:
+                        case Gnss_Signal_Code::SIG_2S:
                             gnss_system_str = "GPS";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GPS_2S_signals_.remove(gnss_signal);
                             break;
 
-                        case evGPS_L5:
+                        case Gnss_Signal_Code::SIG_L5:
                             gnss_system_str = "GPS";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GPS_L5_signals_.remove(gnss_signal);
                             break;
 
-                        case evGAL_1B:
+                        case Gnss_Signal_Code::SIG_1B:
                             gnss_system_str = "Galileo";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GAL_1B_signals_.remove(gnss_signal);
                             break;
 
-                        case evGAL_5X:
+                        case Gnss_Signal_Code::SIG_5X:
                             gnss_system_str = "Galileo";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GAL_5X_signals_.remove(gnss_signal);
                             break;
 
-                        case evGAL_7X:
+                        case Gnss_Signal_Code::SIG_7X:
                             gnss_system_str = "Galileo";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GAL_7X_signals_.remove(gnss_signal);
                             break;
 
-                        case evGAL_E6:
+                        case Gnss_Signal_Code::SIG_E6:
                             gnss_system_str = "Galileo";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GAL_E6_signals_.remove(gnss_signal);
                             break;
 
-                        case evGLO_1G:
+                        case Gnss_Signal_Code::SIG_1G:
                             gnss_system_str = "Glonass";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GLO_1G_signals_.remove(gnss_signal);
                             break;
 
-                        case evGLO_2G:
+                        case Gnss_Signal_Code::SIG_2G:
                             gnss_system_str = "Glonass";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_GLO_2G_signals_.remove(gnss_signal);
                             break;
 
-                        case evBDS_B1:
+                        case Gnss_Signal_Code::SIG_B1:
                             gnss_system_str = "Beidou";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_BDS_B1_signals_.remove(gnss_signal);
                             break;
 
-                        case evBDS_B3:
+                        case Gnss_Signal_Code::SIG_B3:
                             gnss_system_str = "Beidou";
                             gnss_signal = Gnss_Signal(Gnss_Satellite(gnss_system_str, sat), gnss_signal_str);
                             available_BDS_B3_signals_.remove(gnss_signal);
@@ -1558,15 +2358,8 @@ void GNSSFlowgraph::print_help()
 
 void GNSSFlowgraph::check_desktop_conf_in_fpga_env()
 {
-    int number_of_fpga_acq_channels = 0;
-    for (int i = 0; i < channels_count_; i++)
-        {
-            if (channels_.at(i)->get_left_block_acq() == nullptr)
-                {
-                    number_of_fpga_acq_channels++;
-                }
-        }
-    if (number_of_fpga_acq_channels != channels_count_)
+    // host channels complement the FPGA ones, but cannot replace them all
+    if (fpga_channels_.empty())
         {
             help_hint_ += " * The Acquisition block implementation is not suitable for GNSS-SDR flowgraph with FPGA off-loading\n";
             help_hint_ += "   If you want to use this configuration in an environment without FPGA, please rebuild GNSS-SDR with CMake option '-DENABLE_FPGA=OFF'\n";
@@ -1585,60 +2378,49 @@ bool GNSSFlowgraph::send_telemetry_msg(const pmt::pmt_t& msg)
 
 void GNSSFlowgraph::push_back_signal(const Gnss_Signal& gs)
 {
-    switch (mapStringValues_[gs.get_signal_str()])
+    switch (gs.get_id().code())
         {
-        case evGPS_1C:
-            available_GPS_1C_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_1C:
             available_GPS_1C_signals_.push_back(gs);
             break;
 
-        case evGPS_2S:
-            available_GPS_2S_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_2S:
             available_GPS_2S_signals_.push_back(gs);
             break;
 
-        case evGPS_L5:
-            available_GPS_L5_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_L5:
             available_GPS_L5_signals_.push_back(gs);
             break;
 
-        case evGAL_1B:
-            available_GAL_1B_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_1B:
             available_GAL_1B_signals_.push_back(gs);
             break;
 
-        case evGAL_5X:
-            available_GAL_5X_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_5X:
             available_GAL_5X_signals_.push_back(gs);
             break;
 
-        case evGAL_7X:
-            available_GAL_7X_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_7X:
             available_GAL_7X_signals_.push_back(gs);
             break;
 
-        case evGAL_E6:
-            available_GAL_E6_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_E6:
             available_GAL_E6_signals_.push_back(gs);
             break;
 
-        case evGLO_1G:
-            available_GLO_1G_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_1G:
             available_GLO_1G_signals_.push_back(gs);
             break;
 
-        case evGLO_2G:
-            available_GLO_2G_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_2G:
             available_GLO_2G_signals_.push_back(gs);
             break;
 
-        case evBDS_B1:
-            available_BDS_B1_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_B1:
             available_BDS_B1_signals_.push_back(gs);
             break;
 
-        case evBDS_B3:
-            available_BDS_B3_signals_.remove(gs);
+        case Gnss_Signal_Code::SIG_B3:
             available_BDS_B3_signals_.push_back(gs);
             break;
 
@@ -1649,77 +2431,67 @@ void GNSSFlowgraph::push_back_signal(const Gnss_Signal& gs)
 }
 
 
-void GNSSFlowgraph::remove_signal(const Gnss_Signal& gs)
+bool GNSSFlowgraph::remove_signal(const Gnss_Signal& gs)
 {
-    switch (mapStringValues_[gs.get_signal_str()])
+    switch (gs.get_id().code())
         {
-        case evGPS_1C:
-            available_GPS_1C_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_1C:
+            return available_GPS_1C_signals_.remove(gs);
 
-        case evGPS_2S:
-            available_GPS_2S_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_2S:
+            return available_GPS_2S_signals_.remove(gs);
 
-        case evGPS_L5:
-            available_GPS_L5_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_L5:
+            return available_GPS_L5_signals_.remove(gs);
 
-        case evGAL_1B:
-            available_GAL_1B_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_1B:
+            return available_GAL_1B_signals_.remove(gs);
 
-        case evGAL_5X:
-            available_GAL_5X_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_5X:
+            return available_GAL_5X_signals_.remove(gs);
 
-        case evGAL_7X:
-            available_GAL_7X_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_7X:
+            return available_GAL_7X_signals_.remove(gs);
 
-        case evGAL_E6:
-            available_GAL_E6_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_E6:
+            return available_GAL_E6_signals_.remove(gs);
 
-        case evGLO_1G:
-            available_GLO_1G_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_1G:
+            return available_GLO_1G_signals_.remove(gs);
 
-        case evGLO_2G:
-            available_GLO_2G_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_2G:
+            return available_GLO_2G_signals_.remove(gs);
 
-        case evBDS_B1:
-            available_BDS_B1_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_B1:
+            return available_BDS_B1_signals_.remove(gs);
 
-        case evBDS_B3:
-            available_BDS_B3_signals_.remove(gs);
-            break;
+        case Gnss_Signal_Code::SIG_B3:
+            return available_BDS_B3_signals_.remove(gs);
 
         default:
             LOG(ERROR) << "This should not happen :-(";
             break;
         }
+    return false;
 }
 
 
 // project Doppler from primary frequency to secondary frequency
 double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz)
 {
-    switch (mapStringValues_[searched_signal])
+    switch (gnss_signal_code(searched_signal.c_str()))
         {
-        case evGPS_L5:
-        case evGAL_5X:
+        case Gnss_Signal_Code::SIG_L5:
+        case Gnss_Signal_Code::SIG_5X:
             return (primary_freq_doppler_hz / FREQ1) * FREQ5;
             break;
-        case evGAL_7X:
+        case Gnss_Signal_Code::SIG_7X:
             return (primary_freq_doppler_hz / FREQ1) * FREQ7;
             break;
-        case evGPS_2S:
+        case Gnss_Signal_Code::SIG_2S:
             return (primary_freq_doppler_hz / FREQ1) * FREQ2;
             break;
-        case evGAL_E6:
+        case Gnss_Signal_Code::SIG_E6:
             return (primary_freq_doppler_hz / FREQ1) * FREQ6;
             break;
         default:
@@ -1728,21 +2500,64 @@ double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double
 }
 
 
+// Starts the tracking of the secondary band signal set in channel ch with
+// the code phase and Doppler of the channel that tracks the same satellite
+// in the primary band, instead of acquiring it. The 1 ms codes of L5, E5a,
+// E5b and E6 start with each millisecond of the primary band codes, so a
+// code period of the primary band, once its symbols are synchronized, is one
+// of the secondary band. The inter-frequency ionospheric and hardware delays
+// are well within the pull-in range of the DLL.
+bool GNSSFlowgraph::handoff_tracking(unsigned int ch)
+{
+    if (assisting_status_ == nullptr or !assisting_status_->Flag_valid_word or assisting_status_->fs <= 0)
+        {
+            return false;
+        }
+    const std::string signal = channels_[ch]->get_signal().get_signal_str();
+    switch (gnss_signal_code(signal.c_str()))
+        {
+        case Gnss_Signal_Code::SIG_L5:
+        case Gnss_Signal_Code::SIG_5X:
+        case Gnss_Signal_Code::SIG_7X:
+        case Gnss_Signal_Code::SIG_E6:
+            break;
+        default:
+            return false;  // the 20 ms L2 CM code needs the acquisition
+        }
+    auto channel = std::dynamic_pointer_cast<Channel>(channels_[ch]);
+    if (channel == nullptr)
+        {
+            return false;
+        }
+
+    // the code period of the primary band starts at this receiver sample
+    const double code_start_sample = static_cast<double>(assisting_status_->Tracking_sample_counter) + assisting_status_->Code_phase_samples;
+    const auto sample_stamp = static_cast<uint64_t>(std::floor(code_start_sample));
+    const double doppler_hz = project_doppler(signal, assisting_status_->Carrier_Doppler_hz);
+
+    // counted as an acquisition until its success event is applied
+    channels_state_[ch] = 1;
+    acq_channels_count_++;
+    if (!channel->start_tracking_handoff(code_start_sample - static_cast<double>(sample_stamp), doppler_hz, sample_stamp))
+        {
+            channels_state_[ch] = 0;
+            acq_channels_count_--;
+            return false;
+        }
+    DLOG(INFO) << "Channel " << ch << " tracking handoff " << channels_[ch]->get_signal().get_satellite()
+               << ", Signal " << signal << " from channel " << assisting_status_->Channel_ID;
+    return true;
+}
+
+
 void GNSSFlowgraph::acquisition_manager(unsigned int who)
 {
     unsigned int current_channel;
+    channels_status_snapshot_valid_ = false;
     for (int i = 0; i < channels_count_; i++)
         {
-            current_channel = (i + who + 1) % channels_count_;
-            unsigned int sat_ = 0;
-            try
-                {
-                    sat_ = configuration_->property("Channel" + std::to_string(current_channel) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            current_channel = pool_channel(i, who + 1);
+            const unsigned int sat_ = channels_satellite_[current_channel];
             if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[current_channel] == 0))
                 {
                     bool is_primary_freq = true;
@@ -1759,8 +2574,16 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                                 assistance_available,
                                 estimated_doppler,
                                 RX_time);
+                            if (gnss_signal.get_satellite().get_PRN() == 0)
+                                {
+                                    continue;  // all the satellites of this signal are tracked or below the horizon
+                                }
                             channels_[current_channel]->set_signal(gnss_signal);
-                            start_acquisition = is_primary_freq or assistance_available or !configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_);
+                            if (assistance_available and dual_frequency_handoff_ and handoff_tracking(current_channel))
+                                {
+                                    continue;
+                                }
+                            start_acquisition = is_primary_freq or assistance_available or !assist_dual_frequency_acq_;
                         }
                     else
                         {
@@ -1775,10 +2598,19 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                             DLOG(INFO) << "Channel " << current_channel
                                        << " Starting acquisition " << channels_[current_channel]->get_signal().get_satellite()
                                        << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
-                            if (assistance_available == true and configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_))
+                            double predicted_doppler = 0.0;
+                            if (assistance_available == true and assist_dual_frequency_acq_)
                                 {
                                     channels_[current_channel]->assist_acquisition_doppler(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), estimated_doppler));
                                 }
+                            else if (take_reacquisition_entry(channels_[current_channel]->get_signal(), predicted_doppler))
+                                {
+                                    channels_[current_channel]->assist_acquisition_doppler_window(predicted_doppler, fast_reacq_doppler_window_hz_);
+                                }
+                            else if (take_doppler_prediction(channels_[current_channel]->get_signal().get_satellite(), predicted_doppler))
+                                {
+                                    channels_[current_channel]->assist_acquisition_doppler_window(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), predicted_doppler), assisted_acq_doppler_window_hz_);
+                                }
                             else
                                 {
                                     // set Doppler center to 0 Hz
@@ -1806,6 +2638,118 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
 }
 
 
+/*
+ * Applies the events of the channels (0: acquisition failed, 1: acquisition
+ * successful, 2: tracking lost) received since the last call, and then
+ * assigns satellites to all the idle channels in a single pass
+ */
+void GNSSFlowgraph::apply_channel_actions(const std::vector<std::pair<unsigned int, unsigned int>>& actions)
+{
+    // todo: the acquisition events are initiated from the acquisition success or failure queued msg. If the acquisition is disabled for non-assisted secondary freq channels, the engine stops..
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    bool assign_signals = false;
+    unsigned int last_who = 0;
+    Gnss_Signal gs;
+    for (const auto& action : actions)
+        {
+            const unsigned int who = action.first;
+            const unsigned int what = action.second;
+            DLOG(INFO) << "Received " << what << " from " << who;
+            if (who >= channels_.size())
+                {
+                    LOG(WARNING) << "Event " << what << " from unknown channel " << who;
+                    continue;
+                }
+            if (channels_state_[who] == 3)
+                {
+                    continue;  // stopped by the TC, late event
+                }
+            const unsigned int sat = channels_satellite_[who];
+            switch (what)
+                {
+                case 0:
+                    gs = channels_[who]->get_signal();
+                    DLOG(INFO) << "Channel " << who << " ACQ FAILED satellite " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
+                    channels_state_[who] = 0;
+                    if (acq_channels_count_ > 0)
+                        {
+                            acq_channels_count_--;
+                        }
+                    // the old signal is pushed back AFTER assigning new ones to avoid selecting the same signal
+                    if (sat == 0)
+                        {
+                            released_signals_.push_back(gs);
+                        }
+                    assign_signals = true;
+                    last_who = who;
+                    break;
+                case 1:
+                    gs = channels_[who]->get_signal();
+                    DLOG(INFO) << "Channel " << who << " ACQ SUCCESS satellite " << gs.get_satellite();
+                    // If the satellite is in the list of available ones, remove it.
+                    remove_signal(gs);
+
+                    channels_state_[who] = 2;
+                    if (acq_channels_count_ > 0)
+                        {
+                            acq_channels_count_--;
+                        }
+                    assign_signals = true;
+                    last_who = who;
+                    break;
+
+                case 2:
+                    gs = channels_[who]->get_signal();
+                    DLOG(INFO) << "Channel " << who << " TRK FAILED satellite " << gs.get_satellite();
+                    store_reacquisition_entry(who, gs);
+                    if (acq_channels_count_ < max_acq_channels_)
+                        {
+                            // try to acquire the same satellite
+                            channels_state_[who] = 1;
+                            acq_channels_count_++;
+                            DLOG(INFO) << "Channel " << who << " Starting acquisition " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
+                            channels_[who]->set_signal(channels_[who]->get_signal());
+                            double last_doppler = 0.0;
+                            if (take_reacquisition_entry(gs, last_doppler))
+                                {
+                                    channels_[who]->assist_acquisition_doppler_window(last_doppler, fast_reacq_doppler_window_hz_);
+                                }
+
+#if ENABLE_FPGA
+                            // create a task for the FPGA such that it doesn't stop the flow
+                            std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[who]);
+                            tmp_thread.detach();
+#else
+                            channels_[who]->start_acquisition();
+#endif
+                        }
+                    else
+                        {
+                            channels_state_[who] = 0;
+                            LOG(INFO) << "Channel " << who << " Idle state";
+                            if (sat == 0)
+                                {
+                                    push_back_signal(channels_[who]->get_signal());
+                                }
+                        }
+                    break;
+                default:
+                    break;
+                }
+        }
+    if (assign_signals)
+        {
+            // call the acquisition manager to assign new satellites and start the next acquisitions (if required)
+            acquisition_manager(last_who);
+        }
+    for (const auto& released_signal : released_signals_)
+        {
+            push_back_signal(released_signal);
+        }
+    released_signals_.clear();
+}
+
+
 /*
  * Applies an action to the flow graph
  *
@@ -1827,136 +2771,740 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
  * --- actions from TC channel control ---
  * -> 20 stop channel
  * -> 21 start channel
+ * -> 22 set the satellite of the channel to the PRN in value (0 returns it to the automatic assignment)
+ * \param[in] value  Argument of the action, if any
  */
-void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
+void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what, uint32_t value)
 {
-    // todo: the acquisition events are initiated from the acquisition success or failure queued msg. If the acquisition is disabled for non-assisted secondary freq channels, the engine stops..
-    std::lock_guard<std::mutex> lock(signal_list_mutex_);
-    DLOG(INFO) << "Received " << what << " from " << who;
-    unsigned int sat = 0;
-    Gnss_Signal gs;
-    if (who < 200)
+    if (what <= 2)
         {
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(who) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            apply_channel_actions(std::vector<std::pair<unsigned int, unsigned int>>{{who, what}});
+            return;
         }
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    DLOG(INFO) << "Received " << what << " from " << who;
     switch (what)
         {
-        case 0:
-            gs = channels_[who]->get_signal();
-            DLOG(INFO) << "Channel " << who << " ACQ FAILED satellite " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
-            channels_state_[who] = 0;
-            if (acq_channels_count_ > 0)
+        case 10:  // request standby mode
+            for (size_t n = 0; n < channels_.size(); n++)
                 {
-                    acq_channels_count_--;
-                }
-            // call the acquisition manager to assign new satellite and start next acquisition (if required)
-            acquisition_manager(who);
-            // push back the old signal AFTER assigning a new one to avoid selecting the same signal
-            if (sat == 0)
+                    if (channels_state_[n] == 1 or channels_state_[n] == 2)  // channel in acquisition or in tracking
+                        {
+                            // recover the satellite assigned
+                            Gnss_Signal gs_assigned = channels_[n]->get_signal();
+                            push_back_signal(gs_assigned);
+
+                            channels_[n]->stop_channel();  // stop the acquisition or tracking operation
+                            channels_state_[n] = 0;
+                        }
+                }
+            acq_channels_count_ = 0;  // all channels are in standby now and no new acquisition should be started
+            break;
+        case 20:
+        case 21:
+        case 22:
+            if (who < 400 or who - 400 >= channels_.size())
                 {
-                    push_back_signal(gs);
+                    LOG(WARNING) << "TC channel control " << what << " for unknown channel " << static_cast<int>(who) - 400;
+                    break;
                 }
+            control_channel(who - 400, what, value);
             break;
-        case 1:
-            gs = channels_[who]->get_signal();
-            DLOG(INFO) << "Channel " << who << " ACQ SUCCESS satellite " << gs.get_satellite();
-            // If the satellite is in the list of available ones, remove it.
-            remove_signal(gs);
+        default:
+            break;
+        }
+}
+
 
-            channels_state_[who] = 2;
-            if (acq_channels_count_ > 0)
+/*
+ * Stops, starts or reassigns one channel while the flow graph is running.
+ * The blocks of the channel stay connected and the other channels keep
+ * tracking: a stopped channel is only skipped by the acquisition manager.
+ */
+void GNSSFlowgraph::control_channel(unsigned int ch, unsigned int what, uint32_t prn)
+{
+    const Gnss_Signal old_signal = channels_[ch]->get_signal();
+    const bool stopped = (what == 20) or (what != 21 and channels_state_[ch] == 3);
+    if (what == 21 and channels_state_[ch] != 3)
+        {
+            return;  // already running
+        }
+    if (channels_state_[ch] == 1 or channels_state_[ch] == 2)
+        {
+            if (channels_state_[ch] == 1 and acq_channels_count_ > 0)
                 {
                     acq_channels_count_--;
                 }
-            // call the acquisition manager to assign new satellite and start next acquisition (if required)
-            acquisition_manager(who);
-            break;
+            channels_[ch]->stop_channel();
+            if (channels_satellite_[ch] == 0 and old_signal.get_satellite().get_PRN() != 0)
+                {
+                    push_back_signal(old_signal);
+                }
+        }
+    channels_state_[ch] = stopped ? 3 : 0;
 
-        case 2:
-            gs = channels_[who]->get_signal();
-            DLOG(INFO) << "Channel " << who << " TRK FAILED satellite " << gs.get_satellite();
-            if (acq_channels_count_ < max_acq_channels_)
+    if (what == 22)
+        {
+            if (channels_satellite_[ch] != 0)
+                {
+                    push_back_signal(old_signal);  // no longer reserved for this channel
+                }
+            channels_satellite_[ch] = 0;
+            if (prn != 0)
                 {
-                    // try to acquire the same satellite
-                    channels_state_[who] = 1;
-                    acq_channels_count_++;
-                    DLOG(INFO) << "Channel " << who << " Starting acquisition " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
-                    channels_[who]->set_signal(channels_[who]->get_signal());
+                    const Gnss_Signal gs(Gnss_Satellite(old_signal.get_satellite().get_system(), prn), old_signal.get_signal_str());
+                    if (gs.get_satellite().get_PRN() != prn)
+                        {
+                            LOG(WARNING) << "Channel " << ch << ": invalid PRN " << prn << " for signal " << old_signal.get_signal_str();
+                        }
+                    else
+                        {
+                            channels_satellite_[ch] = prn;
+                            channels_[ch]->set_signal(gs);
+                            remove_signal(gs);
+                        }
+                }
+        }
+    LOG(INFO) << "Channel " << ch << (stopped ? " stopped" : " running") << ", satellite "
+              << (channels_satellite_[ch] == 0 ? std::string("automatic") : std::to_string(channels_satellite_[ch]));
+    if (!stopped)
+        {
+            // start with this channel
+            acquisition_manager(ch == 0 ? channels_count_ - 1 : ch - 1);
+        }
+}
 
-#if ENABLE_FPGA
-                    // create a task for the FPGA such that it doesn't stop the flow
-                    std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[who]);
-                    tmp_thread.detach();
-#else
-                    channels_[who]->start_acquisition();
-#endif
+
+void GNSSFlowgraph::set_doppler_predictions(const std::map<std::pair<std::string, uint32_t>, double>& predicted_doppler_hz)
+{
+    std::lock_guard<std::mutex> lock(predicted_doppler_mutex_);
+    predicted_doppler_hz_ = predicted_doppler_hz;
+}
+
+
+int GNSSFlowgraph::set_acquisition_threshold(const std::string& signal, float threshold)
+{
+    int changed = 0;
+    for (const auto& ch : channels_)
+        {
+            auto channel = std::dynamic_pointer_cast<Channel>(ch);
+            if (channel != nullptr and channel->get_signal().get_signal_str() == signal)
+                {
+                    channel->set_acquisition_threshold(threshold);
+                    changed++;
                 }
-            else
+        }
+    LOG(INFO) << "Acquisition threshold of signal " << signal << " set to " << threshold << " in " << changed << " channels";
+    return changed;
+}
+
+
+int GNSSFlowgraph::set_acquisition_doppler_max(const std::string& signal, uint32_t doppler_max_hz)
+{
+    int changed = 0;
+    for (const auto& ch : channels_)
+        {
+            auto channel = std::dynamic_pointer_cast<Channel>(ch);
+            if (channel != nullptr and channel->get_signal().get_signal_str() == signal)
                 {
-                    channels_state_[who] = 0;
-                    LOG(INFO) << "Channel " << who << " Idle state";
-                    if (sat == 0)
+                    channel->set_acquisition_doppler_max(doppler_max_hz);
+                    changed++;
+                }
+        }
+    LOG(INFO) << "Maximum Doppler shift of signal " << signal << " set to " << doppler_max_hz << " Hz in " << changed << " channels";
+    return changed;
+}
+
+
+bool GNSSFlowgraph::set_channel_dump(int channel, bool enable)
+{
+    if (channel < 0 or channel >= channels_count_)
+        {
+            return false;
+        }
+    bool dumping = false;
+    // only the blocks that write their dumps from the GNU Radio thread can be paused
+    auto* acq = dynamic_cast<pcps_acquisition*>(channels_.at(channel)->get_right_block_acq().get());
+    if (acq != nullptr)
+        {
+            dumping = acq->set_dump_enabled(enable) or dumping;
+        }
+    auto* trk = dynamic_cast<dll_pll_veml_tracking*>(channels_.at(channel)->get_right_block_trk().get());
+    if (trk != nullptr)
+        {
+            dumping = trk->set_dump_enabled(enable) or dumping;
+        }
+    return dumping;
+}
+
+
+bool GNSSFlowgraph::set_channel_monitor(int channel, bool enable)
+{
+    if (channel < 0 or channel >= channels_count_)
+        {
+            return false;
+        }
+    bool monitored = false;
+    for (const auto& block : {GnssSynchroMonitor_, GnssSynchroAcquisitionMonitor_, GnssSynchroTrackingMonitor_})
+        {
+            auto* monitor = dynamic_cast<gnss_synchro_monitor*>(block.get());
+            if (monitor != nullptr)
+                {
+                    monitored = monitor->set_channel_enabled(channel, enable) or monitored;
+                }
+        }
+    return monitored;
+}
+
+
+std::vector<std::pair<std::string, gr::basic_block_sptr>> GNSSFlowgraph::processing_blocks() const
+{
+    std::vector<std::pair<std::string, gr::basic_block_sptr>> blocks;
+    for (const auto& source : sig_source_)
+        {
+            blocks.emplace_back(source->role(), source->get_right_block());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            blocks.emplace_back(conditioner->role(), conditioner->get_right_block());
+        }
+    for (int i = 0; i < channels_count_; i++)
+        {
+            blocks.emplace_back("Acquisition_CH" + std::to_string(i), channels_.at(i)->get_right_block_acq());
+            blocks.emplace_back("Tracking_CH" + std::to_string(i), channels_.at(i)->get_right_block_trk());
+        }
+    if (observables_ != nullptr)
+        {
+            blocks.emplace_back(observables_->role(), observables_->get_left_block());
+        }
+    if (pvt_ != nullptr)
+        {
+            blocks.emplace_back(pvt_->role(), pvt_->get_left_block());
+        }
+    return blocks;
+}
+
+
+std::string GNSSFlowgraph::performance_report() const
+{
+    // the work times are counted in ticks of the GNU Radio high resolution timer
+    const double tps = static_cast<double>(gr::high_res_timer_tps());
+    std::stringstream report;
+    report << std::fixed << std::setprecision(1);
+    for (const auto& entry : processing_blocks())
+        {
+            auto* block = dynamic_cast<gr::block*>(entry.second.get());
+            if (block != nullptr)
+                {
+                    report << entry.first << " [" << block->name() << "]: "
+                           << block->pc_work_time_avg() * 1e6 / tps << " us/call avg, "
+                           << block->pc_work_time_total() / tps << " s total\n";
+                }
+        }
+    return report.str();
+}
+
+
+std::string GNSSFlowgraph::memory_report() const
+{
+    constexpr auto num_subsystems = static_cast<size_t>(Gnss_Memory_Subsystem::COUNT);
+    std::array<int64_t, num_subsystems> gnuradio_bytes{};
+    for (const auto& entry : processing_blocks())
+        {
+            auto* block = dynamic_cast<gr::block*>(entry.second.get());
+            if (block == nullptr or block->detail() == nullptr)
+                {
+                    continue;  // the buffers are allocated when the flowgraph starts
+                }
+            const gr::block_detail_sptr detail = block->detail();
+            const auto subsystem = static_cast<size_t>(Gnss_Memory_Accounting::subsystem_of_role(entry.first));
+            for (int i = 0; i < detail->noutputs(); i++)
+                {
+                    const gr::buffer_sptr buffer = detail->output(i);
+                    if (buffer != nullptr)
                         {
-                            push_back_signal(channels_[who]->get_signal());
+                            gnuradio_bytes[subsystem] += static_cast<int64_t>(buffer->bufsize()) * block->output_signature()->sizeof_stream_item(i);
                         }
                 }
-            break;
-        case 10:  // request standby mode
-            for (size_t n = 0; n < channels_.size(); n++)
+        }
+
+    std::stringstream report;
+    int64_t total = 0;
+    for (size_t i = 0; i < num_subsystems; i++)
+        {
+            const auto subsystem = static_cast<Gnss_Memory_Subsystem>(i);
+            const Gnss_Memory_Accounting::Snapshot memory = Gnss_Memory_Accounting::snapshot(subsystem);
+            const int64_t bytes = memory.bytes() + gnuradio_bytes[i];
+            total += bytes;
+            report << Gnss_Memory_Accounting::name(subsystem) << ": " << bytes << " bytes"
+                   << " volk=" << memory.volk_bytes
+                   << " volk_peak=" << memory.volk_peak_bytes
+                   << " volk_blocks=" << memory.volk_blocks
+                   << " containers=" << memory.gauge_bytes
+                   << " gnuradio_buffers=" << gnuradio_bytes[i] << '\n';
+        }
+    report << "Total: " << total << " bytes\n";
+    return report.str();
+}
+
+
+std::string GNSSFlowgraph::metrics_report(bool prometheus) const
+{
+    std::stringstream report;
+    // the label of a block is its role, which is unique in the flowgraph
+    const auto metric = [&report, prometheus](const std::string& name, const std::string& role, double value) {
+        if (prometheus)
+            {
+                report << "gnss_sdr_" << name << "{block=\"" << role << "\"} " << value << '\n';
+            }
+        else
+            {
+                report << ' ' << name << '=' << value;
+            }
+    };
+    if (prometheus)
+        {
+            report << "# TYPE gnss_sdr_items_read_total counter\n"
+                   << "# TYPE gnss_sdr_items_written_total counter\n"
+                   << "# TYPE gnss_sdr_input_buffer_fill gauge\n"
+                   << "# TYPE gnss_sdr_output_buffer_fill gauge\n"
+                   << "# TYPE gnss_sdr_message_queue_depth gauge\n"
+                   << "# TYPE gnss_sdr_work_seconds histogram\n";
+        }
+    for (const auto& entry : processing_blocks())
+        {
+            auto* block = dynamic_cast<gr::block*>(entry.second.get());
+            if (block == nullptr or block->detail() == nullptr)
                 {
-                    if (channels_state_[n] == 1 or channels_state_[n] == 2)  // channel in acquisition or in tracking
+                    continue;  // not connected, or the flowgraph has not started
+                }
+            const std::string& role = entry.first;
+            if (!prometheus)
+                {
+                    report << role << " [" << block->name() << "]:";
+                }
+            const gr::block_detail_sptr detail = block->detail();
+            uint64_t items_read = 0;
+            for (int i = 0; i < detail->ninputs(); i++)
+                {
+                    items_read += block->nitems_read(i);
+                }
+            uint64_t items_written = 0;
+            for (int i = 0; i < detail->noutputs(); i++)
+                {
+                    items_written += block->nitems_written(i);
+                }
+            double input_fill;
+            double output_fill;
+            buffer_fill(detail, input_fill, output_fill);
+            size_t queued_messages = 0;
+            const pmt::pmt_t ports = block->message_ports_in();
+            for (size_t i = 0; i < pmt::length(ports); i++)
+                {
+                    queued_messages += block->nmsgs(pmt::nth(i, ports));
+                }
+            metric("items_read_total", role, static_cast<double>(items_read));
+            metric("items_written_total", role, static_cast<double>(items_written));
+            metric("input_buffer_fill", role, input_fill);
+            metric("output_buffer_fill", role, output_fill);
+            metric("message_queue_depth", role, static_cast<double>(queued_messages));
+
+            const std::shared_ptr<Gnss_Block_Stats> stats = Gnss_Block_Stats_Registry::instance().find(block->unique_id());
+            if (stats != nullptr)
+                {
+                    const Gnss_Block_Stats::Snapshot work = stats->snapshot();
+                    if (prometheus)
                         {
-                            // recover the satellite assigned
-                            Gnss_Signal gs_assigned = channels_[n]->get_signal();
-                            push_back_signal(gs_assigned);
+                            uint64_t cumulative = 0;
+                            for (size_t b = 0; b + 1 < Gnss_Block_Stats::BUCKETS; b++)
+                                {
+                                    cumulative += work.buckets[b];
+                                    report << "gnss_sdr_work_seconds_bucket{block=\"" << role << "\",le=\""
+                                           << Gnss_Block_Stats::bucket_upper_bound_s(b) << "\"} " << cumulative << '\n';
+                                }
+                            report << "gnss_sdr_work_seconds_bucket{block=\"" << role << "\",le=\"+Inf\"} " << work.calls << '\n'
+                                   << "gnss_sdr_work_seconds_sum{block=\"" << role << "\"} " << static_cast<double>(work.total_ns) * 1e-9 << '\n'
+                                   << "gnss_sdr_work_seconds_count{block=\"" << role << "\"} " << work.calls << '\n';
+                        }
+                    else
+                        {
+                            report << " calls=" << work.calls
+                                   << " p50_us<=" << work.quantile_s(0.5) * 1e6
+                                   << " p99_us<=" << work.quantile_s(0.99) * 1e6
+                                   << " max_us=" << static_cast<double>(work.max_ns) * 1e-3;
+                        }
+                }
+            if (!prometheus)
+                {
+                    report << '\n';
+                }
+        }
 
-                            channels_[n]->stop_channel();  // stop the acquisition or tracking operation
-                            channels_state_[n] = 0;
+    const double control_queue_depth = queue_ != nullptr ? static_cast<double>(queue_->size_approx()) : 0.0;
+    const double pool_tasks = static_cast<double>(Gnss_Thread_Pool::instance().pending());
+    if (prometheus)
+        {
+            report << "# TYPE gnss_sdr_control_queue_depth gauge\n"
+                   << "gnss_sdr_control_queue_depth " << control_queue_depth << '\n'
+                   << "# TYPE gnss_sdr_thread_pool_pending_tasks gauge\n"
+                   << "gnss_sdr_thread_pool_pending_tasks " << pool_tasks << '\n';
+            if (headroom_monitor_ != nullptr)
+                {
+                    std::lock_guard<std::mutex> lock(headroom_mutex_);
+                    report << "# TYPE gnss_sdr_realtime_backlog_seconds gauge\n"
+                           << "gnss_sdr_realtime_backlog_seconds " << headroom_monitor_->backlog_ms() * 1e-3 << '\n'
+                           << "# TYPE gnss_sdr_realtime_processing_ratio gauge\n"
+                           << "gnss_sdr_realtime_processing_ratio " << headroom_monitor_->processing_ratio() << '\n'
+                           << "# TYPE gnss_sdr_realtime_source_buffer_fill gauge\n"
+                           << "gnss_sdr_realtime_source_buffer_fill " << headroom_monitor_->buffer_occupancy() << '\n'
+                           << "# TYPE gnss_sdr_realtime_state gauge\n"
+                           << "gnss_sdr_realtime_state " << static_cast<int>(headroom_monitor_->state()) << '\n'
+                           << "# TYPE gnss_sdr_realtime_shed_channels gauge\n"
+                           << "gnss_sdr_realtime_shed_channels " << shed_channels_.size() << '\n';
+                }
+        }
+    else
+        {
+            report << "Control queue depth: " << control_queue_depth
+                   << ", thread pool pending tasks: " << pool_tasks << '\n';
+            if (headroom_monitor_ != nullptr)
+                {
+                    std::lock_guard<std::mutex> lock(headroom_mutex_);
+                    report << "Real time: " << Realtime_Headroom_Monitor::state_name(headroom_monitor_->state())
+                           << ", backlog " << headroom_monitor_->backlog_ms() << " ms"
+                           << ", processing ratio " << headroom_monitor_->processing_ratio()
+                           << ", source buffer fill " << headroom_monitor_->buffer_occupancy()
+                           << ", shed channels " << shed_channels_.size() << (monitors_shed_ ? ", monitors paused" : "") << '\n';
+                }
+            if (!Gnss_Block_Stats::enabled())
+                {
+                    report << "Work time histograms are disabled (GNSS-SDR.enable_block_stats=false)\n";
+                }
+        }
+
+    for (const auto& source : sig_source_)
+        {
+            const auto source_metrics = source != nullptr ? source->metrics() : std::vector<std::pair<std::string, double>>();
+            if (source_metrics.empty())
+                {
+                    continue;
+                }
+            if (!prometheus)
+                {
+                    report << source->role() << ':';
+                }
+            for (const auto& m : source_metrics)
+                {
+                    metric("source_" + m.first, source->role(), m.second);
+                }
+            if (!prometheus)
+                {
+                    report << '\n';
+                }
+        }
+    return report.str();
+}
+
+
+void GNSSFlowgraph::check_realtime_headroom()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (headroom_monitor_ == nullptr or !running_ or receiver_clock_ == nullptr or now - last_headroom_check_ < std::chrono::milliseconds(500))
+        {
+            return;
+        }
+    last_headroom_check_ = now;
+
+    // samples waiting in the buffers after the signal sources
+    double occupancy = 0.0;
+    for (const auto& source : sig_source_)
+        {
+            auto* block = dynamic_cast<gr::block*>(source->get_right_block().get());
+            if (block != nullptr and block->detail() != nullptr)
+                {
+                    double input_fill;
+                    double output_fill;
+                    buffer_fill(block->detail(), input_fill, output_fill);
+                    occupancy = std::max(occupancy, output_fill);
+                }
+        }
+
+    Realtime_Headroom_Monitor::State state;
+    double backlog_ms;
+    {
+        std::lock_guard<std::mutex> lock(headroom_mutex_);
+        const Realtime_Headroom_Monitor::State previous = headroom_monitor_->state();
+        state = headroom_monitor_->update(receiver_clock_->sample_counter(), occupancy, now);
+        backlog_ms = headroom_monitor_->backlog_ms();
+        if (state != previous)
+            {
+                std::stringstream msg;
+                msg << "Real-time headroom " << Realtime_Headroom_Monitor::state_name(state) << ": backlog "
+                    << std::fixed << std::setprecision(0) << backlog_ms << " ms, processing ratio " << std::setprecision(3)
+                    << headroom_monitor_->processing_ratio() << ", source buffer fill " << std::setprecision(2) << occupancy;
+                if (state == Realtime_Headroom_Monitor::OK)
+                    {
+                        LOG(INFO) << msg.str();
+                    }
+                else
+                    {
+                        LOG(WARNING) << msg.str();
+                        std::cerr << msg.str() << '\n';
+                    }
+            }
+    }
+    if (state != Realtime_Headroom_Monitor::OK)
+        {
+            last_headroom_trouble_ = now;
+        }
+    if (!enable_load_shedding_)
+        {
+            return;
+        }
+
+    if (state == Realtime_Headroom_Monitor::OVERLOAD and now - last_load_shedding_ >= std::chrono::milliseconds(shedding_period_ms_))
+        {
+            last_load_shedding_ = now;
+            if (!monitors_shed_)
+                {
+                    // the monitors are the cheapest thing to give up
+                    bool paused = false;
+                    for (int ch = 0; ch < channels_count_; ch++)
+                        {
+                            paused = set_channel_monitor(ch, false) or paused;
+                        }
+                    monitors_shed_ = true;
+                    if (paused)
+                        {
+                            LOG(WARNING) << "Receiver overload: monitors paused";
+                            return;
+                        }
+                }
+            // then the tracking channel with the lowest utility for the fix per unit of CPU time
+            const std::map<int, std::shared_ptr<Gnss_Synchro>> status = channels_status_->get_current_status_map();
+            std::vector<Channel_Governor::Channel> tracking;
+            for (int ch = 0; ch < channels_count_; ch++)
+                {
+                    if (channels_state_[ch] != 2)
+                        {
+                            continue;
+                        }
+                    Channel_Governor::Channel channel;
+                    channel.id = ch;
+                    const Gnss_Satellite satellite = channels_[ch]->get_signal().get_satellite();
+                    const std::string system = satellite.get_system_short();
+                    channel.system = system.empty() ? 0 : system[0];
+                    channel.prn = satellite.get_PRN();
+                    const auto it = status.find(ch);
+                    channel.cn0_db_hz = it != status.end() and it->second != nullptr ? it->second->CN0_dB_hz : 0.0;
+                    const gr::basic_block_sptr trk = channels_[ch]->get_left_block_trk();
+                    const std::shared_ptr<Gnss_Block_Stats> stats = trk != nullptr ? Gnss_Block_Stats_Registry::instance().find(trk->unique_id()) : nullptr;
+                    if (stats != nullptr)
+                        {
+                            channel.work_ns = stats->snapshot().total_ns;
+                        }
+                    tracking.push_back(channel);
+                }
+            const std::shared_ptr<PvtInterface> pvt = get_pvt();
+            const std::vector<Pvt_Satellite_Contribution> contributions = pvt != nullptr ? pvt->get_satellite_contributions() : std::vector<Pvt_Satellite_Contribution>();
+            const int selected = channel_governor_.select_standby(tracking, contributions);
+            if (selected >= 0 and static_cast<int>(tracking.size()) > shedding_min_channels_)
+                {
+                    const auto channel = std::find_if(tracking.begin(), tracking.end(), [selected](const Channel_Governor::Channel& c) { return c.id == selected; });
+                    LOG(WARNING) << "Receiver overload: stopping channel " << selected << " (" << channels_[selected]->get_signal().get_satellite()
+                                 << ", C/N0 " << channel->cn0_db_hz << " dB-Hz, utility " << Channel_Governor::utility(*channel, contributions)
+                                 << "), backlog " << backlog_ms << " ms";
+                    std::cerr << "Receiver overload: stopping channel " << selected << '\n';
+                    control_channel(selected, 20, 0);
+                    std::lock_guard<std::mutex> lock(headroom_mutex_);
+                    shed_channels_.push_back(selected);
+                }
+        }
+    else if (state == Realtime_Headroom_Monitor::OK and now - last_headroom_trouble_ >= std::chrono::milliseconds(recovery_period_ms_) and now - last_load_shedding_ >= std::chrono::milliseconds(recovery_period_ms_))
+        {
+            // give back what was shed, one step per recovery period, in reverse order
+            last_load_shedding_ = now;
+            std::unique_lock<std::mutex> lock(headroom_mutex_);
+            if (!shed_channels_.empty())
+                {
+                    const int ch = shed_channels_.back();
+                    shed_channels_.pop_back();
+                    lock.unlock();
+                    if (channels_state_[ch] == 3)
+                        {
+                            LOG(INFO) << "Real-time headroom recovered: restarting channel " << ch;
+                            control_channel(ch, 21, 0);
+                        }
+                }
+            else if (monitors_shed_)
+                {
+                    monitors_shed_ = false;
+                    lock.unlock();
+                    LOG(INFO) << "Real-time headroom recovered: monitors resumed";
+                    for (int ch = 0; ch < channels_count_; ch++)
+                        {
+                            set_channel_monitor(ch, true);
                         }
                 }
-            acq_channels_count_ = 0;  // all channels are in standby now and no new acquisition should be started
-            break;
-        default:
-            break;
         }
 }
 
 
+bool GNSSFlowgraph::take_doppler_prediction(const Gnss_Satellite& satellite, double& predicted_doppler_hz)
+{
+    // Each prediction is used only once, so a failed attempt is followed by a full search
+    std::lock_guard<std::mutex> lock(predicted_doppler_mutex_);
+    const auto it = predicted_doppler_hz_.find(std::make_pair(satellite.get_system(), satellite.get_PRN()));
+    if (it == predicted_doppler_hz_.end())
+        {
+            return false;
+        }
+    predicted_doppler_hz = it->second;
+    predicted_doppler_hz_.erase(it);
+    return true;
+}
+
+
+void GNSSFlowgraph::store_reacquisition_entry(unsigned int who, const Gnss_Signal& gs)
+{
+    if (!enable_fast_reacquisition_)
+        {
+            return;
+        }
+    const std::shared_ptr<Gnss_Synchro> last_status = channels_status_->get_last_valid_status(static_cast<int>(who));
+    if (last_status == nullptr or last_status->PRN != gs.get_satellite().get_PRN() or gnss_signal_code(last_status->Signal) != gs.get_id().code())
+        {
+            return;
+        }
+    Reacquisition_Entry entry;
+    entry.Carrier_Doppler_hz = last_status->Carrier_Doppler_hz;
+    entry.Code_phase_samples = last_status->Code_phase_samples;
+    entry.Tracking_sample_counter = last_status->Tracking_sample_counter;
+    entry.loss_time = std::chrono::steady_clock::now();
+    reacquisition_cache_[gs.get_id()] = entry;
+    DLOG(INFO) << "Stored reacquisition entry for " << gs.get_satellite() << ", Signal " << gs.get_signal_str()
+               << ": Doppler " << entry.Carrier_Doppler_hz << " [Hz], code phase " << entry.Code_phase_samples
+               << " [samples] at sample stamp " << entry.Tracking_sample_counter;
+}
+
+
+bool GNSSFlowgraph::take_reacquisition_entry(const Gnss_Signal& gs, double& doppler_hz)
+{
+    // Each entry is used only once, so a failed attempt is followed by a full search
+    const auto it = reacquisition_cache_.find(gs.get_id());
+    if (it == reacquisition_cache_.end())
+        {
+            return false;
+        }
+    const auto outage_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->second.loss_time).count();
+    const bool valid = outage_ms <= static_cast<int64_t>(fast_reacq_max_outage_ms_);
+    if (valid)
+        {
+            // The Doppler shift barely changes during a short outage
+            doppler_hz = it->second.Carrier_Doppler_hz;
+            DLOG(INFO) << "Fast reacquisition of " << gs.get_satellite() << ", Signal " << gs.get_signal_str()
+                       << " after " << outage_ms << " ms around " << doppler_hz << " [Hz]";
+        }
+    reacquisition_cache_.erase(it);
+    return valid;
+}
+
+
+void GNSSFlowgraph::save_tracking_checkpoint()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (tracking_checkpoint_file_.empty() or !running_ or now - last_tracking_checkpoint_ < std::chrono::milliseconds(tracking_checkpoint_period_ms_))
+        {
+            return;
+        }
+    last_tracking_checkpoint_ = now;
+    Tracking_Checkpoint checkpoint;
+    for (const auto& status : channels_status_->get_current_status_map())
+        {
+            const int ch = status.first;
+            if (ch < 0 or ch >= channels_count_ or channels_state_[ch] != 2)
+                {
+                    continue;
+                }
+            const Gnss_Signal gs = channels_[ch]->get_signal();
+            if (status.second->PRN != gs.get_satellite().get_PRN())
+                {
+                    continue;
+                }
+            Tracking_Checkpoint::Entry entry;
+            entry.System = gs.get_satellite().get_system();
+            entry.Signal = gs.get_signal_str();
+            entry.PRN = gs.get_satellite().get_PRN();
+            entry.channel = ch;
+            entry.Carrier_Doppler_hz = status.second->Carrier_Doppler_hz;
+            entry.CN0_dB_hz = status.second->CN0_dB_hz;
+            entry.TOW_at_current_symbol_ms = status.second->TOW_at_current_symbol_ms;
+            checkpoint.entries.push_back(entry);
+        }
+    checkpoint.save(tracking_checkpoint_file_);
+}
+
+
+// Puts the satellites of a recent checkpoint at the front of the search
+// lists, so that assign_channels() gives them the first channels, and leaves
+// their Doppler in the reacquisition cache, so that their first acquisition
+// only searches GNSS-SDR.fast_reacquisition_doppler_window_hz around it
+void GNSSFlowgraph::restore_tracking_checkpoint()
+{
+    if (tracking_checkpoint_file_.empty())
+        {
+            return;
+        }
+    Tracking_Checkpoint checkpoint;
+    if (!checkpoint.load(tracking_checkpoint_file_, tracking_checkpoint_max_age_s_))
+        {
+            return;
+        }
+    std::vector<std::pair<int, Gnss_Satellite>> satellites;
+    const auto now = std::chrono::steady_clock::now();
+    // priorize_satellites() pushes each one to the front, so the strongest go last
+    std::sort(checkpoint.entries.begin(), checkpoint.entries.end(), [](const Tracking_Checkpoint::Entry& a, const Tracking_Checkpoint::Entry& b) {
+        return a.CN0_dB_hz < b.CN0_dB_hz;
+    });
+    for (const auto& entry : checkpoint.entries)
+        {
+            const Gnss_Satellite satellite(entry.System, entry.PRN);
+            if (satellite.get_PRN() == 0)
+                {
+                    continue;
+                }
+            satellites.emplace_back(entry.channel, satellite);
+            Reacquisition_Entry reacquisition;
+            reacquisition.Carrier_Doppler_hz = entry.Carrier_Doppler_hz;
+            reacquisition.loss_time = now;
+            reacquisition_cache_[Gnss_Signal(satellite, entry.Signal).get_id()] = reacquisition;
+        }
+    priorize_satellites(satellites);
+    std::cout << "Resuming " << satellites.size() << " signals from the tracking checkpoint " << tracking_checkpoint_file_ << '\n';
+}
+
+
 void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites)
 {
-    size_t old_size;
     Gnss_Signal gs;
     for (const auto& visible_satellite : visible_satellites)
         {
             if (visible_satellite.second.get_system() == "GPS")
                 {
                     gs = Gnss_Signal(visible_satellite.second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
+                    if (available_GPS_1C_signals_.remove(gs))
                         {
                             available_GPS_1C_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(visible_satellite.second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
+                    if (available_GPS_2S_signals_.remove(gs))
                         {
                             available_GPS_2S_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(visible_satellite.second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
+                    if (available_GPS_L5_signals_.remove(gs))
                         {
                             available_GPS_L5_signals_.push_front(gs);
                         }
@@ -1964,33 +3512,25 @@ void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Sa
             else if (visible_satellite.second.get_system() == "Galileo")
                 {
                     gs = Gnss_Signal(visible_satellite.second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
+                    if (available_GAL_1B_signals_.remove(gs))
                         {
                             available_GAL_1B_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(visible_satellite.second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
+                    if (available_GAL_5X_signals_.remove(gs))
                         {
                             available_GAL_5X_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(visible_satellite.second, "7X");
-                    old_size = available_GAL_7X_signals_.size();
-                    available_GAL_7X_signals_.remove(gs);
-                    if (old_size > available_GAL_7X_signals_.size())
+                    if (available_GAL_7X_signals_.remove(gs))
                         {
                             available_GAL_7X_signals_.push_front(gs);
                         }
 
                     gs = Gnss_Signal(visible_satellite.second, "E6");
-                    old_size = available_GAL_E6_signals_.size();
-                    available_GAL_E6_signals_.remove(gs);
-                    if (old_size > available_GAL_E6_signals_.size())
+                    if (available_GAL_E6_signals_.remove(gs))
                         {
                             available_GAL_E6_signals_.push_front(gs);
                         }
@@ -1999,6 +3539,54 @@ void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Sa
 }
 
 
+void GNSSFlowgraph::set_visibility_schedule(const std::vector<std::pair<int, Gnss_Satellite>>& scheduled_satellites,
+    const std::vector<Gnss_Satellite>& unscheduled_satellites)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    std::set<std::pair<std::string, uint32_t>> below_horizon;
+    for (const auto& satellite : unscheduled_satellites)
+        {
+            below_horizon.emplace(satellite.get_system(), satellite.get_PRN());
+        }
+
+    // Give back the signals of the satellites that are no longer below the horizon
+    auto first_kept = std::remove_if(unscheduled_signals_.begin(), unscheduled_signals_.end(), [&below_horizon](const Gnss_Signal& gs) {
+        return below_horizon.count(std::make_pair(gs.get_satellite().get_system(), gs.get_satellite().get_PRN())) == 0;
+    });
+    for (auto it = first_kept; it != unscheduled_signals_.end(); ++it)
+        {
+            push_back_signal(*it);
+        }
+    unscheduled_signals_.erase(first_kept, unscheduled_signals_.end());
+
+    // and take out the ones of the satellites that have set
+    for (const auto& satellite : unscheduled_satellites)
+        {
+            std::vector<std::string> signals;
+            if (satellite.get_system() == "GPS")
+                {
+                    signals = {"1C", "2S", "L5"};
+                }
+            else if (satellite.get_system() == "Galileo")
+                {
+                    signals = {"1B", "5X", "7X", "E6"};
+                }
+            for (const auto& signal : signals)
+                {
+                    const Gnss_Signal gs(satellite, signal);
+                    if (remove_signal(gs))
+                        {
+                            unscheduled_signals_.push_back(gs);
+                        }
+                }
+        }
+
+    priorize_satellites(scheduled_satellites);
+    DLOG(INFO) << "Visibility schedule: " << scheduled_satellites.size() << " satellites scheduled, "
+               << unscheduled_signals_.size() << " signals of satellites below the horizon not searched";
+}
+
+
 void GNSSFlowgraph::set_configuration(const std::shared_ptr<ConfigurationInterface>& configuration)
 {
     if (running_)
@@ -2040,7 +3628,8 @@ void GNSSFlowgraph::perform_hw_reset()
 
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-    channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(0));
+    // the acquisition of a host channel would not reach the FPGA
+    channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(fpga_channels_.empty() ? 0 : fpga_channels_.front()));
     channel_ptr->acquisition()->stop_acquisition();
 }
 #endif
@@ -2443,6 +4032,24 @@ void GNSSFlowgraph::set_signals_list()
 }
 
 
+// Returns the i-th channel offered a new signal, starting at offset. In a
+// hybrid pool, all the FPGA channels come before the host channels, which
+// only take the signals that do not fit in the FPGA.
+unsigned int GNSSFlowgraph::pool_channel(int i, unsigned int offset) const
+{
+    if (host_channels_.empty() or fpga_channels_.empty())
+        {
+            return (i + offset) % channels_count_;
+        }
+    const auto fpga_count = static_cast<int>(fpga_channels_.size());
+    if (i < fpga_count)
+        {
+            return fpga_channels_[(i + offset) % fpga_count];
+        }
+    return host_channels_[(i - fpga_count + offset) % host_channels_.size()];
+}
+
+
 void GNSSFlowgraph::set_channels_state()
 {
     std::lock_guard<std::mutex> lock(signal_list_mutex_);
@@ -2452,17 +4059,13 @@ void GNSSFlowgraph::set_channels_state()
             max_acq_channels_ = channels_count_;
             LOG(WARNING) << "Channels_in_acquisition is bigger than number of channels. Variable acq_channels_count_ is set to " << channels_count_;
         }
-    channels_state_.reserve(channels_count_);
+    channels_state_.assign(channels_count_, 0);
+    for (int i = 0; i < max_acq_channels_; i++)
+        {
+            channels_state_[pool_channel(i, 0)] = 1;
+        }
     for (int i = 0; i < channels_count_; i++)
         {
-            if (i < max_acq_channels_)
-                {
-                    channels_state_.push_back(1);
-                }
-            else
-                {
-                    channels_state_.push_back(0);
-                }
             DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
         }
     acq_channels_count_ = max_acq_channels_;
@@ -2517,6 +4120,41 @@ bool GNSSFlowgraph::is_multiband() const
 }
 
 
+const std::map<int, std::shared_ptr<Gnss_Synchro>>& GNSSFlowgraph::current_channels_status()
+{
+    // one copy of the channels status per assignment pass
+    if (!channels_status_snapshot_valid_)
+        {
+            channels_status_snapshot_ = channels_status_->get_current_status_map();
+            channels_status_snapshot_valid_ = true;
+        }
+    return channels_status_snapshot_;
+}
+
+
+bool GNSSFlowgraph::search_assisted_signal(Gnss_Signal_Queue& available_signals,
+    const std::string& primary_signal,
+    Gnss_Signal& result,
+    float& estimated_doppler,
+    double& RX_time)
+{
+    // search the satellites currently tracked in the primary frequency and
+    // assist the acquisition of the first one not yet tracked in the secondary
+    const Gnss_Signal_Code primary_code = gnss_signal_code(primary_signal.c_str());
+    for (const auto& current_status : current_channels_status())
+        {
+            if (gnss_signal_code(current_status.second->Signal) == primary_code && available_signals.take(current_status.second->PRN, result))
+                {
+                    assisting_status_ = current_status.second;
+                    estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
+                    RX_time = current_status.second->RX_time;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
 Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal,
     bool& is_primary_frequency,
     bool& assistance_available,
@@ -2525,248 +4163,87 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
 {
     is_primary_frequency = false;
     assistance_available = false;
+    assisting_status_ = nullptr;
     Gnss_Signal result{};
-    bool found_signal = false;
-    switch (mapStringValues_[searched_signal])
+    switch (gnss_signal_code(searched_signal.c_str()))
         {
-        case evGPS_1C:
+        case Gnss_Signal_Code::SIG_1C:
             // todo: assist the satellite selection with almanac and current PVT here (reuse priorize_satellite function used in control_thread)
-            result = available_GPS_1C_signals_.front();
-            available_GPS_1C_signals_.pop_front();
-            available_GPS_1C_signals_.push_back(result);
+            result = available_GPS_1C_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
-        case evGPS_2S:
-            if (configuration_->property("Channels_1C.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked GPS L1 satellites and assist the GPS L2 acquisition if the satellite is not tracked on L2
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1C")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GPS_2S_signals_), std::end(available_GPS_2S_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GPS_2S_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // 3. return the GPS L2 satellite and remove it from list
-                                            result = *it2;
-                                            available_GPS_2S_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
+        case Gnss_Signal_Code::SIG_2S:
+            assistance_available = channels_1C_count_ > 0 && search_assisted_signal(available_GPS_2S_signals_, "1C", result, estimated_doppler, RX_time);
             // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L2
-            if (found_signal == false)
+            if (!assistance_available)
                 {
-                    result = available_GPS_2S_signals_.front();
-                    available_GPS_2S_signals_.pop_front();
-                    available_GPS_2S_signals_.push_back(result);
+                    result = available_GPS_2S_signals_.next();
                 }
             break;
 
-        case evGPS_L5:
-            if (configuration_->property("Channels_1C.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked GPS L1 satellites and assist the GPS L5 acquisition if the satellite is not tracked on L5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1C")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GPS_L5_signals_), std::end(available_GPS_L5_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GPS_L5_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the GPS L5 satellite and remove it from list
-                                            result = *it2;
-                                            available_GPS_L5_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
+        case Gnss_Signal_Code::SIG_L5:
+            assistance_available = channels_1C_count_ > 0 && search_assisted_signal(available_GPS_L5_signals_, "1C", result, estimated_doppler, RX_time);
             // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L5
-            if (found_signal == false)
+            if (!assistance_available)
                 {
-                    result = available_GPS_L5_signals_.front();
-                    available_GPS_L5_signals_.pop_front();
-                    available_GPS_L5_signals_.push_back(result);
+                    result = available_GPS_L5_signals_.next();
                 }
             break;
 
-        case evGAL_1B:
-            result = available_GAL_1B_signals_.front();
-            available_GAL_1B_signals_.pop_front();
-            available_GAL_1B_signals_.push_back(result);
+        case Gnss_Signal_Code::SIG_1B:
+            result = available_GAL_1B_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
-        case evGAL_5X:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_5X_signals_), std::end(available_GAL_5X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_5X_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal 5X satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_5X_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
+        case Gnss_Signal_Code::SIG_5X:
+            assistance_available = channels_1B_count_ > 0 && search_assisted_signal(available_GAL_5X_signals_, "1B", result, estimated_doppler, RX_time);
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
-            if (found_signal == false)
+            if (!assistance_available)
                 {
-                    result = available_GAL_5X_signals_.front();
-                    available_GAL_5X_signals_.pop_front();
-                    available_GAL_5X_signals_.push_back(result);
+                    result = available_GAL_5X_signals_.next();
                 }
             break;
 
-        case evGAL_7X:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_7X_signals_), std::end(available_GAL_7X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_7X_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal 7X satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_7X_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
+        case Gnss_Signal_Code::SIG_7X:
+            assistance_available = channels_1B_count_ > 0 && search_assisted_signal(available_GAL_7X_signals_, "1B", result, estimated_doppler, RX_time);
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
-            if (found_signal == false)
+            if (!assistance_available)
                 {
-                    result = available_GAL_7X_signals_.front();
-                    available_GAL_7X_signals_.pop_front();
-                    available_GAL_7X_signals_.push_back(result);
+                    result = available_GAL_7X_signals_.next();
                 }
             break;
 
-        case evGAL_E6:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_E6_signals_), std::end(available_GAL_E6_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_E6_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal E6 satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_E6_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
+        case Gnss_Signal_Code::SIG_E6:
+            assistance_available = channels_1B_count_ > 0 && search_assisted_signal(available_GAL_E6_signals_, "1B", result, estimated_doppler, RX_time);
             // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E6
-            if (found_signal == false)
+            if (!assistance_available)
                 {
-                    result = available_GAL_E6_signals_.front();
-                    available_GAL_E6_signals_.pop_front();
-                    available_GAL_E6_signals_.push_back(result);
+                    result = available_GAL_E6_signals_.next();
                 }
             break;
 
-        case evGLO_1G:
-            result = available_GLO_1G_signals_.front();
-            available_GLO_1G_signals_.pop_front();
-            available_GLO_1G_signals_.push_back(result);
+        case Gnss_Signal_Code::SIG_1G:
+            result = available_GLO_1G_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
-        case evGLO_2G:
-            result = available_GLO_2G_signals_.front();
-            available_GLO_2G_signals_.pop_front();
-            available_GLO_2G_signals_.push_back(result);
+        case Gnss_Signal_Code::SIG_2G:
+            result = available_GLO_2G_signals_.next();
             break;
 
-        case evBDS_B1:
-            result = available_BDS_B1_signals_.front();
-            available_BDS_B1_signals_.pop_front();
-            available_BDS_B1_signals_.push_back(result);
+        case Gnss_Signal_Code::SIG_B1:
+            result = available_BDS_B1_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
-        case evBDS_B3:
-            result = available_BDS_B3_signals_.front();
-            available_BDS_B3_signals_.pop_front();
-            available_BDS_B3_signals_.push_back(result);
+        case Gnss_Signal_Code::SIG_B3:
+            result = available_BDS_B3_signals_.next();
             break;
 
         default:
             LOG(ERROR) << "This should not happen :-(";
-            if (!available_GPS_1C_signals_.empty())
-                {
-                    result = available_GPS_1C_signals_.front();
-                    available_GPS_1C_signals_.pop_front();
-                    available_GPS_1C_signals_.push_back(result);
-                }
+            result = available_GPS_1C_signals_.next();
             break;
         }
     return result;
@@ -24,20 +24,26 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H
 #define GNSS_SDR_GNSS_FLOWGRAPH_H
 
+#include "channel_governor.h"
 #include "channel_status_msg_receiver.h"
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "galileo_e6_has_msg_receiver.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_signal.h"
+#include "gnss_signal_queue.h"
+#include "gnss_synchro.h"
 #include "pvt_interface.h"
+#include <gnuradio/blocks/file_sink.h>  // for file_sink
 #include <gnuradio/blocks/null_sink.h>  // for null_sink
 #include <gnuradio/runtime_types.h>     // for basic_block_sptr, top_block_sptr
 #include <pmt/pmt.h>                    // for pmt_t
-#include <list>                         // for list
+#include <chrono>                       // for steady_clock
+#include <cstdint>                      // for uint32_t
 #include <map>                          // for map
 #include <memory>                       // for for shared_ptr, dynamic_pointer_cast
 #include <mutex>                        // for mutex
 #include <string>                       // for string
+#include <unordered_map>                // for unordered_map
 #include <utility>                      // for pair
 #include <vector>                       // for vector
 #if ENABLE_FPGA
@@ -50,10 +56,13 @@
  * \{ */
 
 
+class Acq_Sample_Ring;
 class ChannelInterface;
 class ConfigurationInterface;
 class GNSSBlockInterface;
 class Gnss_Satellite;
+class Gnss_Sdr_Acquisition_Record;
+class Realtime_Headroom_Monitor;
 class SignalSourceInterface;
 
 /*! \brief This class represents a GNSS flow graph.
@@ -67,7 +76,7 @@ public:
     /*!
      * \brief Constructor that initializes the receiver flow graph
      */
-    GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configuration, std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue);
+    GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configuration, std::shared_ptr<Control_Queue> queue);
 
     /*!
      * \brief Destructor
@@ -117,8 +126,15 @@ public:
      *
      * \param[in] who   Who generated the action
      * \param[in] what  What is the action. 0: acquisition failed; 1: acquisition success; 2: tracking lost
+     * \param[in] value Argument of the action, if any
      */
-    void apply_action(unsigned int who, unsigned int what);
+    void apply_action(unsigned int who, unsigned int what, uint32_t value = 0);
+
+    /*!
+     * \brief Applies a batch of channel events (who, what), in order, and
+     * then assigns satellites to the idle channels in a single pass
+     */
+    void apply_channel_actions(const std::vector<std::pair<unsigned int, unsigned int>>& actions);
 
     /*!
      * \brief Set flow graph configuratiob
@@ -150,11 +166,104 @@ public:
         return std::dynamic_pointer_cast<PvtInterface>(pvt_);
     }
 
+    /*!
+     * \brief Returns a smart pointer to the first signal source, or nullptr
+     */
+    std::shared_ptr<SignalSourceInterface> get_signal_source()
+    {
+        return sig_source_.empty() ? nullptr : sig_source_.at(0);
+    }
+
     /*!
      * \brief Priorize visible satellites in the specified vector
      */
     void priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites);
 
+    /*!
+     * \brief Takes the signals of the satellites predicted below the horizon
+     * out of the search lists, gives back the ones that are no longer below
+     * it, and priorizes the scheduled satellites (see priorize_satellites()).
+     */
+    void set_visibility_schedule(const std::vector<std::pair<int, Gnss_Satellite>>& scheduled_satellites,
+        const std::vector<Gnss_Satellite>& unscheduled_satellites);
+
+    /*!
+     * \brief Sets the Doppler shift at the L1/E1 frequency predicted for each
+     * satellite, keyed by system name and PRN. The next acquisition of each of
+     * those satellites will search only a window around the prediction,
+     * projected to the searched band.
+     */
+    void set_doppler_predictions(const std::map<std::pair<std::string, uint32_t>, double>& predicted_doppler_hz);
+
+    /*!
+     * \brief Sets the acquisition threshold of the channels of the given
+     * signal (e.g. "1C"). Returns the number of channels changed.
+     */
+    int set_acquisition_threshold(const std::string& signal, float threshold);
+
+    /*!
+     * \brief Sets the maximum Doppler shift searched by the channels of the
+     * given signal. Returns the number of channels changed.
+     */
+    int set_acquisition_doppler_max(const std::string& signal, uint32_t doppler_max_hz);
+
+    /*!
+     * \brief Pauses or resumes the acquisition and tracking dumps of a
+     * channel. Returns false if the channel has no dump configured.
+     */
+    bool set_channel_dump(int channel, bool enable);
+
+    /*!
+     * \brief Stops or resumes sending the observables of a channel to the
+     * monitors. Returns false if no monitor is enabled.
+     */
+    bool set_channel_monitor(int channel, bool enable);
+
+    /*!
+     * \brief Returns the average and total work time of each block, one
+     * per line. The values are zero unless the performance counters of
+     * GNU Radio are enabled.
+     */
+    std::string performance_report() const;
+
+    /*!
+     * \brief Returns the items processed, the buffer fill levels and the
+     * message queue depths of each block, the work time histograms of the
+     * instrumented ones (see GNSS-SDR.enable_block_stats), and the depth of
+     * the control queue. With prometheus set to true, the report follows
+     * the Prometheus text exposition format; otherwise there is one line
+     * per block.
+     */
+    std::string metrics_report(bool prometheus) const;
+
+    /*!
+     * \brief Returns the memory held by each subsystem, one per line: the
+     * volk_gnsssdr::vector buffers charged to it, the containers with a
+     * Gnss_Memory_Gauge, and the GNU Radio output buffers of its blocks.
+     */
+    std::string memory_report() const;
+
+    /*!
+     * \brief Compares the samples counted by the receiver with the wall
+     * clock (see Realtime_Headroom_Monitor), warns when the receiver is
+     * falling behind a live source and, with GNSS-SDR.realtime_load_shedding
+     * enabled, pauses the monitors and then stops the tracking channels
+     * with the lowest utility for the fix per unit of CPU time (see
+     * Channel_Governor) until it catches up. Called periodically by the control
+     * thread; it does nothing unless GNSS-SDR.realtime_monitor is true.
+     */
+    void check_realtime_headroom();
+
+    /*!
+     * \brief Writes the satellites in tracking, with their Doppler shift, to
+     * GNSS-SDR.tracking_checkpoint_file every
+     * GNSS-SDR.tracking_checkpoint_period_ms. Called periodically by the
+     * control thread; it does nothing if the file is not set. After a
+     * restart, those satellites are searched first, around their Doppler
+     * (see Tracking_Checkpoint).
+     */
+    void save_tracking_checkpoint();
+
 #if ENABLE_FPGA
     void start_acquisition_helper();
 
@@ -179,115 +288,193 @@ private:
     int connect_monitors();
     int connect_gal_e6_has();
     int connect_gnss_synchro_monitor();
+    int connect_observables_stream();
     int connect_acquisition_monitor();
     int connect_tracking_monitor();
     int connect_navdata_monitor();
+    int connect_spectrum_monitor();
+    int connect_sample_stream();
+    void set_tracking_affinity();
+    void set_blocks_scheduling();
+    void set_block_scheduling(const std::string& role, const std::string& channel_role, const gr::basic_block_sptr& block);
 
 #if ENABLE_FPGA
     int connect_fpga_flowgraph();
     int connect_fpga_sample_counter();
+    int connect_fpga_host_channels();
 #endif
 
     int assign_channels();
     void check_signal_conditioners();
+    int connect_tracking_replay_record();
 
     void set_signals_list();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
+    unsigned int pool_channel(int i, unsigned int offset) const;  // i-th channel offered a new signal, FPGA channels first
     Gnss_Signal search_next_signal(const std::string& searched_signal,
         bool& is_primary_frequency,
         bool& assistance_available,
         float& estimated_doppler,
         double& RX_time);
+    bool search_assisted_signal(Gnss_Signal_Queue& available_signals,
+        const std::string& primary_signal,
+        Gnss_Signal& result,
+        float& estimated_doppler,
+        double& RX_time);
+    const std::map<int, std::shared_ptr<Gnss_Synchro>>& current_channels_status();
+    void read_acquisition_configuration();
+    void startup_stage_done(const std::string& stage);  // Records the time spent since the previous stage
+    void print_startup_report() const;
+    std::vector<std::pair<std::string, gr::basic_block_sptr>> processing_blocks() const;  // role and block of each stage
+    void control_channel(unsigned int ch, unsigned int what, uint32_t prn);
 
     void push_back_signal(const Gnss_Signal& gs);
-    void remove_signal(const Gnss_Signal& gs);
+    bool remove_signal(const Gnss_Signal& gs);
     void print_help();
     void check_desktop_conf_in_fpga_env();
 
     double project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz);
+    bool handoff_tracking(unsigned int ch);
+    bool take_doppler_prediction(const Gnss_Satellite& satellite, double& predicted_doppler_hz);
+    void store_reacquisition_entry(unsigned int who, const Gnss_Signal& gs);
+    bool take_reacquisition_entry(const Gnss_Signal& gs, double& doppler_hz);
+    void restore_tracking_checkpoint();
     bool is_multiband() const;
 
     std::vector<std::string> split_string(const std::string& s, char delim);
     std::vector<bool> signal_conditioner_connected_;
+    std::vector<std::pair<gr::basic_block_sptr, int>> signal_conditioner_inputs_;  // source block and port feeding each conditioner
 
     gr::top_block_sptr top_block_;
 
     std::shared_ptr<ConfigurationInterface> configuration_;
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue_;
+    std::shared_ptr<Control_Queue> queue_;
 
     std::vector<std::shared_ptr<SignalSourceInterface>> sig_source_;
     std::vector<std::shared_ptr<GNSSBlockInterface>> sig_conditioner_;
+    std::shared_ptr<GNSSBlockInterface> channelizer_;  // optional, splits the first source into one stream per signal conditioner
     std::vector<std::shared_ptr<ChannelInterface>> channels_;
+    std::vector<unsigned int> fpga_channels_;  // hybrid pool with FPGA off-loading: channels with FPGA acquisition and tracking
+    std::vector<unsigned int> host_channels_;  // and channels fed with the samples of the FPGA sample tap
+    std::vector<gr::basic_block_sptr> sample_tap_blocks_;  // split the sample tap into the signal conditioners of the host channels
     std::shared_ptr<GNSSBlockInterface> observables_;
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::map<std::string, std::shared_ptr<Acq_Sample_Ring>> acq_sample_rings_;  // resampled streams, shared by the acquisitions of each signal
+    std::map<std::string, gr::basic_block_sptr> acq_sample_ring_sinks_;
+    std::vector<gr::basic_block_sptr> pinned_inputs_;  // signal conditioner outputs copied to pinned memory, if GNSS-SDR.accelerator_buffers=true
     std::vector<gr::blocks::null_sink::sptr> null_sinks_;
 
+    // if GNSS-SDR.tracking_replay_record_dir is set: the tracking inputs and
+    // the acquisitions that start the tracking, for the tracking-replay tool
+    std::vector<gr::blocks::file_sink::sptr> replay_sinks_;
+    std::shared_ptr<Gnss_Sdr_Acquisition_Record> acquisition_record_;
+
     gr::basic_block_sptr GnssSynchroMonitor_;
     gr::basic_block_sptr GnssSynchroAcquisitionMonitor_;
     gr::basic_block_sptr GnssSynchroTrackingMonitor_;
     gr::basic_block_sptr NavDataMonitor_;
+    std::vector<gr::basic_block_sptr> spectrum_monitors_;  // one per signal conditioner
+    gr::basic_block_sptr SampleStream_;                    // to the worker nodes, with one input per signal conditioner
+    gr::basic_block_sptr ObservablesBinarySink_;
     channel_status_msg_receiver_sptr channels_status_;  // class that receives and stores the current status of the receiver channels
     galileo_e6_has_msg_receiver_sptr gal_e6_has_rx_;
 
     gnss_sdr_sample_counter_sptr ch_out_sample_counter_;
+    std::shared_ptr<const Gnss_Sdr_Receiver_Clock> receiver_clock_;  // kept by the sample counter in use
 #if ENABLE_FPGA
     gnss_sdr_fpga_sample_counter_sptr ch_out_fpga_sample_counter_;
 #endif
 
-    std::vector<unsigned int> channels_state_;
-
-    std::list<Gnss_Signal> available_GPS_1C_signals_;
-    std::list<Gnss_Signal> available_GPS_2S_signals_;
-    std::list<Gnss_Signal> available_GPS_L5_signals_;
-    std::list<Gnss_Signal> available_SBAS_1C_signals_;
-    std::list<Gnss_Signal> available_GAL_1B_signals_;
-    std::list<Gnss_Signal> available_GAL_5X_signals_;
-    std::list<Gnss_Signal> available_GAL_7X_signals_;
-    std::list<Gnss_Signal> available_GAL_E6_signals_;
-    std::list<Gnss_Signal> available_GLO_1G_signals_;
-    std::list<Gnss_Signal> available_GLO_2G_signals_;
-    std::list<Gnss_Signal> available_BDS_B1_signals_;
-    std::list<Gnss_Signal> available_BDS_B3_signals_;
-
-    enum StringValue
-    {
-        evGPS_1C,
-        evGPS_2S,
-        evGPS_L5,
-        evSBAS_1C,
-        evGAL_1B,
-        evGAL_5X,
-        evGAL_7X,
-        evGAL_E6,
-        evGLO_1G,
-        evGLO_2G,
-        evBDS_B1,
-        evBDS_B3
-    };
-    std::map<std::string, StringValue> mapStringValues_;
+    std::vector<unsigned int> channels_state_;  // 0: idle, 1: acquisition, 2: tracking, 3: stopped by the TC
+    std::vector<unsigned int> channels_satellite_;  // satellite each channel is fixed to, 0 if none
+    std::vector<Gnss_Signal> released_signals_;
+    std::vector<Gnss_Signal> unscheduled_signals_;  // signals of the satellites below the horizon, not searched
+    std::map<int, std::shared_ptr<Gnss_Synchro>> channels_status_snapshot_;
+    std::shared_ptr<Gnss_Synchro> assisting_status_;  // primary band channel found by the last search_assisted_signal()
+
+    Gnss_Signal_Queue available_GPS_1C_signals_;
+    Gnss_Signal_Queue available_GPS_2S_signals_;
+    Gnss_Signal_Queue available_GPS_L5_signals_;
+    Gnss_Signal_Queue available_SBAS_1C_signals_;
+    Gnss_Signal_Queue available_GAL_1B_signals_;
+    Gnss_Signal_Queue available_GAL_5X_signals_;
+    Gnss_Signal_Queue available_GAL_7X_signals_;
+    Gnss_Signal_Queue available_GAL_E6_signals_;
+    Gnss_Signal_Queue available_GLO_1G_signals_;
+    Gnss_Signal_Queue available_GLO_2G_signals_;
+    Gnss_Signal_Queue available_BDS_B1_signals_;
+    Gnss_Signal_Queue available_BDS_B3_signals_;
 
     std::string config_file_;
     std::string help_hint_;
 
+    std::vector<std::pair<std::string, double>> startup_stages_;  // stage name, elapsed time [ms]
+    std::chrono::steady_clock::time_point startup_stage_start_;
+
+    // Last tracking state of the signals that lost lock, kept for a fast reacquisition
+    class Reacquisition_Entry
+    {
+    public:
+        double Carrier_Doppler_hz{0.0};
+        double Code_phase_samples{0.0};
+        uint64_t Tracking_sample_counter{0U};
+        std::chrono::steady_clock::time_point loss_time;
+    };
+
+    std::map<std::pair<std::string, uint32_t>, double> predicted_doppler_hz_;
+    std::unordered_map<Gnss_Signal_Id, Reacquisition_Entry> reacquisition_cache_;
+
     std::mutex signal_list_mutex_;
+    std::mutex predicted_doppler_mutex_;
+
+    std::unique_ptr<Realtime_Headroom_Monitor> headroom_monitor_;  // if GNSS-SDR.realtime_monitor
+    std::vector<int> shed_channels_;                              // stopped by the load shedding, in order
+    Channel_Governor channel_governor_;                           // chooses the channels to stop
+    std::chrono::steady_clock::time_point last_headroom_check_{};
+    std::chrono::steady_clock::time_point last_headroom_trouble_{};  // last check not in the OK state
+    std::chrono::steady_clock::time_point last_load_shedding_{};     // last shedding or recovery step
+    mutable std::mutex headroom_mutex_;                              // the monitor is also read by metrics_report()
+    int shedding_min_channels_{4};
+    int shedding_period_ms_{5000};
+    int recovery_period_ms_{30000};
+    bool enable_load_shedding_{false};
+    bool monitors_shed_{false};
+
+    std::string tracking_checkpoint_file_;  // if GNSS-SDR.tracking_checkpoint_file
+    std::chrono::steady_clock::time_point last_tracking_checkpoint_{};
+    int64_t tracking_checkpoint_max_age_s_{60};
+    uint32_t tracking_checkpoint_period_ms_{1000};
 
     int sources_count_;
     int channels_count_;
     int acq_channels_count_;
     int max_acq_channels_;
+    int channels_1C_count_;
+    int channels_1B_count_;
+    uint32_t assisted_acq_doppler_window_hz_;
+    uint32_t fast_reacq_doppler_window_hz_;
+    uint32_t fast_reacq_max_outage_ms_;
 
     bool connected_;
     bool running_;
     bool multiband_;
+    bool enable_fast_reacquisition_;
+    bool detach_idle_signal_paths_;
     bool enable_monitor_;
     bool enable_acquisition_monitor_;
     bool enable_tracking_monitor_;
     bool enable_navdata_monitor_;
+    bool enable_spectrum_monitor_;
+    bool enable_sample_stream_;
+    bool enable_observables_stream_;
     bool enable_fpga_offloading_;
     bool enable_e6_has_rx_;
+    bool assist_dual_frequency_acq_;
+    bool dual_frequency_handoff_;
+    bool channels_status_snapshot_valid_;
 };
 
 
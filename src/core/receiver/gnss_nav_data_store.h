@@ -0,0 +1,81 @@
+/*!
+ * \file gnss_nav_data_store.h
+ * \brief Navigation data decoded by the receiver, shared by all its consumers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_NAV_DATA_STORE_H
+#define GNSS_SDR_GNSS_NAV_DATA_STORE_H
+
+#include "beidou_dnav_almanac.h"
+#include "beidou_dnav_ephemeris.h"
+#include "concurrent_snapshot_map.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "gps_almanac.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Ephemeris and almanac records received so far, by PRN.
+ *
+ * The PVT block publishes every record it gets from the telemetry decoders,
+ * and the rest of the receiver (control thread, assistance, commands) reads
+ * snapshots of it instead of asking the PVT block for copies of the maps of
+ * its solver, which it keeps updating from the flowgraph thread.
+ */
+class Gnss_Nav_Data_Store
+{
+public:
+    Concurrent_Snapshot_Map<Gps_Ephemeris> gps_ephemeris;
+    Concurrent_Snapshot_Map<Gps_CNAV_Ephemeris> gps_cnav_ephemeris;
+    Concurrent_Snapshot_Map<Gps_Almanac> gps_almanac;
+    Concurrent_Snapshot_Map<Galileo_Ephemeris> galileo_ephemeris;
+    Concurrent_Snapshot_Map<Galileo_Almanac> galileo_almanac;
+    Concurrent_Snapshot_Map<Glonass_Gnav_Ephemeris> glonass_gnav_ephemeris;
+    Concurrent_Snapshot_Map<Beidou_Dnav_Ephemeris> beidou_dnav_ephemeris;
+    Concurrent_Snapshot_Map<Beidou_Dnav_Almanac> beidou_dnav_almanac;
+
+    void clear()
+    {
+        gps_ephemeris.clear();
+        gps_cnav_ephemeris.clear();
+        gps_almanac.clear();
+        galileo_ephemeris.clear();
+        galileo_almanac.clear();
+        glonass_gnav_ephemeris.clear();
+        beidou_dnav_ephemeris.clear();
+        beidou_dnav_almanac.clear();
+    }
+};
+
+
+/*!
+ * \brief Returns the navigation data store of the receiver
+ */
+inline Gnss_Nav_Data_Store& gnss_nav_data_store()
+{
+    static Gnss_Nav_Data_Store store;
+    return store;
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_NAV_DATA_STORE_H
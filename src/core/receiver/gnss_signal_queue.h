@@ -0,0 +1,144 @@
+/*!
+ * \file gnss_signal_queue.h
+ * \brief Queue of the signals available for acquisition, indexed by PRN
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_QUEUE_H
+#define GNSS_SDR_GNSS_SIGNAL_QUEUE_H
+
+#include "gnss_signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Signals of one kind (e.g. GPS L1 C/A) waiting to be assigned to a
+ * channel, in order of priority.
+ *
+ * The order is kept in a list and every element is indexed by the PRN of its
+ * satellite, so that moving a signal to the front or to the back, removing
+ * it or looking for a given satellite takes constant time, instead of a scan
+ * of the whole list.
+ */
+class Gnss_Signal_Queue
+{
+public:
+    bool empty() const
+    {
+        return d_signals.empty();
+    }
+
+    size_t size() const
+    {
+        return d_signals.size();
+    }
+
+    const Gnss_Signal& front() const
+    {
+        return d_signals.front();
+    }
+
+    bool contains(uint32_t prn) const
+    {
+        return d_index.count(prn) != 0;
+    }
+
+    /*!
+     * \brief Appends the signal, or moves it to the back if it is already
+     * in the queue.
+     */
+    void push_back(const Gnss_Signal& gs)
+    {
+        remove(gs);
+        d_index[gs.get_satellite().get_PRN()] = d_signals.insert(d_signals.end(), gs);
+    }
+
+    void emplace_back(const Gnss_Satellite& satellite, const std::string& signal)
+    {
+        push_back(Gnss_Signal(satellite, signal));
+    }
+
+    /*!
+     * \brief Prepends the signal, or moves it to the front if it is already
+     * in the queue.
+     */
+    void push_front(const Gnss_Signal& gs)
+    {
+        remove(gs);
+        d_index[gs.get_satellite().get_PRN()] = d_signals.insert(d_signals.begin(), gs);
+    }
+
+    /*!
+     * \brief Removes the signal. Returns false if it was not in the queue.
+     */
+    bool remove(const Gnss_Signal& gs)
+    {
+        const auto it = d_index.find(gs.get_satellite().get_PRN());
+        if (it == d_index.end() || !(*it->second == gs))
+            {
+                return false;
+            }
+        d_signals.erase(it->second);
+        d_index.erase(it);
+        return true;
+    }
+
+    /*!
+     * \brief Returns the signal with the highest priority and moves it to
+     * the back of the queue, so that the next call returns another one.
+     * Returns a default signal if the queue is empty.
+     */
+    Gnss_Signal next()
+    {
+        if (d_signals.empty())
+            {
+                return Gnss_Signal();
+            }
+        d_signals.splice(d_signals.end(), d_signals, d_signals.begin());
+        return d_signals.back();
+    }
+
+    /*!
+     * \brief Removes the signal of the satellite with the given PRN and
+     * returns it in gs. Returns false if there is none.
+     */
+    bool take(uint32_t prn, Gnss_Signal& gs)
+    {
+        const auto it = d_index.find(prn);
+        if (it == d_index.end())
+            {
+                return false;
+            }
+        gs = *it->second;
+        d_signals.erase(it->second);
+        d_index.erase(it);
+        return true;
+    }
+
+private:
+    std::list<Gnss_Signal> d_signals;
+    std::unordered_map<uint32_t, std::list<Gnss_Signal>::iterator> d_index;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SIGNAL_QUEUE_H
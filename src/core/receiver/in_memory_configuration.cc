@@ -17,110 +17,81 @@
 
 
 #include "in_memory_configuration.h"
-#include "gnss_sdr_make_unique.h"
-#include <utility>
 
 
-InMemoryConfiguration::InMemoryConfiguration()
+std::string InMemoryConfiguration::property(const std::string& property_name, std::string default_value) const
 {
-    converter_ = std::make_unique<StringConverter>();
+    return properties_.property(property_name, default_value);
 }
 
 
-InMemoryConfiguration::~InMemoryConfiguration()
+bool InMemoryConfiguration::property(const std::string& property_name, bool default_value) const
 {
-    properties_.clear();
+    return properties_.property(property_name, default_value);
 }
 
 
-std::string InMemoryConfiguration::property(std::string property_name, std::string default_value) const
+int64_t InMemoryConfiguration::property(const std::string& property_name, int64_t default_value) const
 {
-    const auto iter = properties_.find(property_name);
-    if (iter != properties_.end())
-        {
-            return iter->second;
-        }
-    return default_value;
+    return properties_.property(property_name, default_value);
 }
 
 
-bool InMemoryConfiguration::property(std::string property_name, bool default_value) const
+uint64_t InMemoryConfiguration::property(const std::string& property_name, uint64_t default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-int64_t InMemoryConfiguration::property(std::string property_name, int64_t default_value) const
+int32_t InMemoryConfiguration::property(const std::string& property_name, int32_t default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-uint64_t InMemoryConfiguration::property(std::string property_name, uint64_t default_value) const
+uint32_t InMemoryConfiguration::property(const std::string& property_name, uint32_t default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-int32_t InMemoryConfiguration::property(std::string property_name, int32_t default_value) const
+uint16_t InMemoryConfiguration::property(const std::string& property_name, uint16_t default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-uint32_t InMemoryConfiguration::property(std::string property_name, uint32_t default_value) const
+int16_t InMemoryConfiguration::property(const std::string& property_name, int16_t default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-uint16_t InMemoryConfiguration::property(std::string property_name, uint16_t default_value) const
+float InMemoryConfiguration::property(const std::string& property_name, float default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-int16_t InMemoryConfiguration::property(std::string property_name, int16_t default_value) const
+double InMemoryConfiguration::property(const std::string& property_name, double default_value) const
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return properties_.property(property_name, default_value);
 }
 
 
-float InMemoryConfiguration::property(std::string property_name, float default_value) const
+void InMemoryConfiguration::set_property(const std::string& property_name, std::string value)
 {
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
-}
-
-
-double InMemoryConfiguration::property(std::string property_name, double default_value) const
-{
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
-}
-
-
-void InMemoryConfiguration::set_property(std::string property_name, std::string value)
-{
-    properties_.insert(std::make_pair(property_name, value));
+    properties_.insert(property_name, value);
 }
 
 
 void InMemoryConfiguration::supersede_property(const std::string& property_name, const std::string& value)
 {
-    properties_.erase(property_name);
-    properties_.insert(std::make_pair(property_name, value));
+    properties_.supersede(property_name, value);
 }
 
 
 bool InMemoryConfiguration::is_present(const std::string& property_name) const
 {
-    return (properties_.find(property_name) != properties_.end());
+    return properties_.find(property_name) != nullptr;
 }
@@ -22,10 +22,8 @@
 #define GNSS_SDR_IN_MEMORY_CONFIGURATION_H
 
 #include "configuration_interface.h"
-#include "string_converter.h"
+#include "configuration_snapshot.h"
 #include <cstdint>
-#include <map>
-#include <memory>
 #include <string>
 
 /** \addtogroup Core
@@ -43,25 +41,24 @@
 class InMemoryConfiguration : public ConfigurationInterface
 {
 public:
-    InMemoryConfiguration();
-    ~InMemoryConfiguration();
-    std::string property(std::string property_name, std::string default_value) const override;
-    bool property(std::string property_name, bool default_value) const override;
-    int64_t property(std::string property_name, int64_t default_value) const override;
-    uint64_t property(std::string property_name, uint64_t default_value) const override;
-    int32_t property(std::string property_name, int32_t default_value) const override;
-    uint32_t property(std::string property_name, uint32_t default_value) const override;
-    int16_t property(std::string property_name, int16_t default_value) const override;
-    uint16_t property(std::string property_name, uint16_t default_value) const override;
-    float property(std::string property_name, float default_value) const override;
-    double property(std::string property_name, double default_value) const override;
-    void set_property(std::string property_name, std::string value) override;
+    InMemoryConfiguration() = default;
+    ~InMemoryConfiguration() = default;
+    std::string property(const std::string& property_name, std::string default_value) const override;
+    bool property(const std::string& property_name, bool default_value) const override;
+    int64_t property(const std::string& property_name, int64_t default_value) const override;
+    uint64_t property(const std::string& property_name, uint64_t default_value) const override;
+    int32_t property(const std::string& property_name, int32_t default_value) const override;
+    uint32_t property(const std::string& property_name, uint32_t default_value) const override;
+    int16_t property(const std::string& property_name, int16_t default_value) const override;
+    uint16_t property(const std::string& property_name, uint16_t default_value) const override;
+    float property(const std::string& property_name, float default_value) const override;
+    double property(const std::string& property_name, double default_value) const override;
+    void set_property(const std::string& property_name, std::string value) override;
     void supersede_property(const std::string& property_name, const std::string& value);
     bool is_present(const std::string& property_name) const;
 
 private:
-    std::map<std::string, std::string> properties_;
-    std::unique_ptr<StringConverter> converter_;
+    Configuration_Snapshot properties_;
 };
 
 
@@ -0,0 +1,181 @@
+/*!
+ * \file metrics_http_server.cc
+ * \brief Minimal HTTP server of the receiver metrics in the Prometheus text
+ * exposition format
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "metrics_http_server.h"
+#include <boost/asio.hpp>
+#include <glog/logging.h>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <sstream>
+#include <utility>
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+namespace
+{
+// the acceptor and the clients are polled, so that stop() never waits more
+// than this for the server thread
+const auto METRICS_POLL_PERIOD = std::chrono::milliseconds(100);
+
+// a client that does not complete its request in this time is dropped
+const auto METRICS_REQUEST_TIMEOUT = std::chrono::seconds(2);
+}  // namespace
+
+
+Metrics_Http_Server::Metrics_Http_Server(std::function<std::string()> metrics)
+    : d_metrics(std::move(metrics))
+{
+}
+
+
+Metrics_Http_Server::~Metrics_Http_Server()
+{
+    stop();
+}
+
+
+bool Metrics_Http_Server::start(uint16_t port)
+{
+    if (d_thread.joinable())
+        {
+            return d_listening.load();
+        }
+    d_keep_running.store(true);
+    d_bind_done.store(false);
+    d_thread = std::thread(&Metrics_Http_Server::serve, this, port);
+    while (!d_bind_done.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    if (!d_listening.load())
+        {
+            d_thread.join();
+            return false;
+        }
+    return true;
+}
+
+
+void Metrics_Http_Server::stop()
+{
+    d_keep_running.store(false);
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+}
+
+
+void Metrics_Http_Server::serve(uint16_t port)
+{
+    b_io_context context;
+    boost::asio::ip::tcp::acceptor acceptor(context);
+    boost::system::error_code error;
+    acceptor.open(boost::asio::ip::tcp::v4(), error);
+    if (!error)
+        {
+            acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+            acceptor.bind(boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port), error);
+        }
+    if (!error)
+        {
+            acceptor.listen(boost::asio::socket_base::max_connections, error);
+        }
+    if (!error)
+        {
+            acceptor.non_blocking(true, error);
+        }
+    if (error)
+        {
+            LOG(WARNING) << "The metrics server cannot listen on port " << port << ": " << error.message();
+            d_bind_done.store(true);
+            return;
+        }
+    d_listening.store(true);
+    d_bind_done.store(true);
+    LOG(INFO) << "Serving the receiver metrics at http://localhost:" << port << "/metrics";
+
+    while (d_keep_running.load())
+        {
+            boost::asio::ip::tcp::socket socket(context);
+            acceptor.accept(socket, error);
+            if (error)
+                {
+                    std::this_thread::sleep_for(METRICS_POLL_PERIOD);
+                    continue;
+                }
+
+            // read the request line and the headers, which are ignored
+            std::string request;
+            socket.non_blocking(true, error);
+            std::array<char, 1024> buffer{};
+            const auto deadline = std::chrono::steady_clock::now() + METRICS_REQUEST_TIMEOUT;
+            while (request.find("\r\n\r\n") == std::string::npos and request.size() < 65536 and d_keep_running.load())
+                {
+                    const size_t n = socket.read_some(boost::asio::buffer(buffer), error);
+                    if (error == boost::asio::error::would_block and std::chrono::steady_clock::now() < deadline)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            continue;
+                        }
+                    if (error)
+                        {
+                            break;
+                        }
+                    request.append(buffer.data(), n);
+                }
+            if (request.find("\r\n\r\n") == std::string::npos)
+                {
+                    continue;
+                }
+
+            const std::string request_line = request.substr(0, request.find("\r\n"));
+            std::string status = "200 OK";
+            std::string body;
+            if (request_line.compare(0, 13, "GET /metrics ") == 0 or request_line.compare(0, 13, "GET /metrics?") == 0)
+                {
+                    try
+                        {
+                            body = d_metrics();
+                        }
+                    catch (const std::exception& e)
+                        {
+                            status = "500 Internal Server Error";
+                            body = std::string(e.what()) + '\n';
+                        }
+                }
+            else
+                {
+                    status = "404 Not Found";
+                    body = "Not found\n";
+                }
+            std::stringstream response;
+            response << "HTTP/1.0 " << status << "\r\n"
+                     << "Content-Type: text/plain; version=0.0.4\r\n"
+                     << "Content-Length: " << body.size() << "\r\n"
+                     << "Connection: close\r\n\r\n"
+                     << body;
+            socket.non_blocking(false, error);
+            boost::asio::write(socket, boost::asio::buffer(response.str()), error);
+            socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+        }
+    d_listening.store(false);
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file metrics_http_server.h
+ * \brief Minimal HTTP server of the receiver metrics in the Prometheus text
+ * exposition format
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_METRICS_HTTP_SERVER_H
+#define GNSS_SDR_METRICS_HTTP_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Answers GET /metrics with the text returned by a callback, so that
+ * a Prometheus server can scrape the receiver. Requests are served one at a
+ * time from a background thread, and any other path gets a 404.
+ */
+class Metrics_Http_Server
+{
+public:
+    explicit Metrics_Http_Server(std::function<std::string()> metrics);
+    ~Metrics_Http_Server();
+
+    Metrics_Http_Server(const Metrics_Http_Server&) = delete;
+    Metrics_Http_Server& operator=(const Metrics_Http_Server&) = delete;
+
+    /*!
+     * \brief Starts listening on the given TCP port. Returns false if the
+     * port cannot be bound.
+     */
+    bool start(uint16_t port);
+
+    void stop();
+
+private:
+    void serve(uint16_t port);
+
+    std::function<std::string()> d_metrics;
+    std::thread d_thread;
+    std::atomic<bool> d_keep_running{false};
+    std::atomic<bool> d_listening{false};
+    std::atomic<bool> d_bind_done{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_METRICS_HTTP_SERVER_H
@@ -0,0 +1,196 @@
+/*!
+ * \file mpsc_queue.h
+ * \brief Lock-free multiple producer, single consumer queue
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MPSC_QUEUE_H
+#define GNSS_SDR_MPSC_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Bounded queue where any number of threads push and one thread pops,
+ * with the same interface as Concurrent_Queue.
+ *
+ * Producers claim a slot of a ring with a compare-and-swap and publish it
+ * with a sequence number per slot (D. Vyukov's bounded queue), so pushing
+ * neither allocates nor takes a lock. The mutex is only taken to wake up the
+ * consumer when it is waiting on an empty queue. If the ring is full, push
+ * yields until the consumer makes room: messages are never dropped.
+ *
+ * Only one thread at a time may call the popping methods and empty().
+ * size_approx() may be called from any thread.
+ */
+template <typename Data>
+class Mpsc_Queue
+{
+    static_assert(std::is_trivially_copyable<Data>::value, "Mpsc_Queue stores trivially copyable records");
+
+public:
+    explicit Mpsc_Queue(size_t capacity = 4096)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            {
+                size *= 2;
+            }
+        d_mask = size - 1;
+        d_cells = std::unique_ptr<Cell[]>(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+            {
+                d_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+    }
+
+    Mpsc_Queue(const Mpsc_Queue&) = delete;
+    Mpsc_Queue& operator=(const Mpsc_Queue&) = delete;
+
+    void push(Data const& data)
+    {
+        while (!try_push(data))
+            {
+                std::this_thread::yield();
+            }
+        // pairs with the fence in timed_wait_and_pop(): either the consumer sees
+        // the record, or this thread sees that the consumer is waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (d_consumer_waiting.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_condition_variable.notify_one();
+            }
+    }
+
+    bool empty() const
+    {
+        const Cell& cell = d_cells[d_dequeue_pos & d_mask];
+        return cell.sequence.load(std::memory_order_acquire) != d_dequeue_pos + 1;
+    }
+
+    /*!
+     * \brief Number of records waiting to be popped. It may be stale by the
+     * time it is returned, so it is only meant for monitoring.
+     */
+    size_t size_approx() const
+    {
+        // the consumer position is read first, so it never exceeds the producers one
+        const size_t dequeued = d_dequeued.load(std::memory_order_acquire);
+        const size_t enqueued = d_enqueue_pos.load(std::memory_order_acquire);
+        return enqueued - dequeued;
+    }
+
+    bool try_pop(Data& popped_value)
+    {
+        Cell& cell = d_cells[d_dequeue_pos & d_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != d_dequeue_pos + 1)
+            {
+                return false;
+            }
+        popped_value = cell.data;
+        cell.sequence.store(d_dequeue_pos + d_mask + 1, std::memory_order_release);
+        d_dequeue_pos++;
+        d_dequeued.store(d_dequeue_pos, std::memory_order_release);
+        return true;
+    }
+
+    void wait_and_pop(Data& popped_value)
+    {
+        while (!timed_wait_and_pop(popped_value, 1000))
+            {
+            }
+    }
+
+    bool timed_wait_and_pop(Data& popped_value, int wait_ms)
+    {
+        if (try_pop(popped_value))
+            {
+                return true;
+            }
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_consumer_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool popped = d_condition_variable.wait_for(lock, std::chrono::milliseconds(wait_ms),
+            [this, &popped_value] { return try_pop(popped_value); });
+        d_consumer_waiting.store(false, std::memory_order_relaxed);
+        return popped;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        Data data{};
+    };
+
+    bool try_push(Data const& data)
+    {
+        size_t pos = d_enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+            {
+                cell = &d_cells[pos & d_mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+                if (difference == 0)
+                    {
+                        if (d_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (difference < 0)
+                    {
+                        return false;  // full
+                    }
+                else
+                    {
+                        pos = d_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+            }
+        cell->data = data;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::unique_ptr<Cell[]> d_cells;
+    size_t d_mask{};
+    // padding keeps the producers and the consumer positions on separate
+    // cache lines (alignas would need C++17 to be honored by make_shared)
+    char d_padding0[64]{};
+    std::atomic<size_t> d_enqueue_pos{0};
+    char d_padding1[64]{};
+    size_t d_dequeue_pos{0};
+    std::atomic<size_t> d_dequeued{0};  // copy of d_dequeue_pos for size_approx()
+    std::atomic<bool> d_consumer_waiting{false};
+    std::mutex d_mutex;
+    std::condition_variable d_condition_variable;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MPSC_QUEUE_H
@@ -0,0 +1,89 @@
+/*!
+ * \file realtime_headroom_monitor.cc
+ * \brief Estimates how far the receiver is from falling behind the sample
+ * rate of a live signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "realtime_headroom_monitor.h"
+#include <algorithm>
+
+
+Realtime_Headroom_Monitor::Realtime_Headroom_Monitor(double fs, const Realtime_Headroom_Conf& conf)
+    : d_conf(conf),
+      d_fs(fs)
+{
+}
+
+
+Realtime_Headroom_Monitor::State Realtime_Headroom_Monitor::update(uint64_t sample_counter, double buffer_occupancy, std::chrono::steady_clock::time_point now)
+{
+    d_buffer_occupancy = buffer_occupancy;
+    if (!d_started or sample_counter < d_start_samples or d_fs <= 0.0)
+        {
+            // the counter is reset when the flowgraph is restarted
+            d_started = true;
+            d_start_time = now;
+            d_start_samples = sample_counter;
+            d_min_lag_s = 0.0;
+            d_window.clear();
+        }
+
+    const double elapsed_s = std::chrono::duration<double>(now - d_start_time).count();
+    const double processed_s = d_fs > 0.0 ? static_cast<double>(sample_counter - d_start_samples) / d_fs : 0.0;
+    const double lag_s = elapsed_s - processed_s;
+    d_min_lag_s = std::min(d_min_lag_s, lag_s);
+    d_backlog_ms = (lag_s - d_min_lag_s) * 1e3;
+
+    d_window.emplace_back(now, sample_counter);
+    while (d_window.size() > 2 and now - d_window[1].first >= std::chrono::milliseconds(d_conf.window_ms))
+        {
+            d_window.pop_front();
+        }
+    const double window_s = std::chrono::duration<double>(now - d_window.front().first).count();
+    const bool window_full = window_s * 1e3 >= 0.5 * d_conf.window_ms;
+    d_processing_ratio = 1.0;
+    if (window_full and d_fs > 0.0)
+        {
+            d_processing_ratio = static_cast<double>(sample_counter - d_window.front().second) / d_fs / window_s;
+        }
+
+    if (d_backlog_ms >= d_conf.overload_lag_ms or d_buffer_occupancy >= d_conf.overload_occupancy)
+        {
+            d_state = OVERLOAD;
+        }
+    else if (d_backlog_ms >= d_conf.warning_lag_ms or d_buffer_occupancy >= d_conf.warning_occupancy or d_processing_ratio < d_conf.min_processing_ratio)
+        {
+            d_state = WARNING;
+        }
+    else
+        {
+            d_state = OK;
+        }
+    return d_state;
+}
+
+
+const char* Realtime_Headroom_Monitor::state_name(State state)
+{
+    switch (state)
+        {
+        case OK:
+            return "OK";
+        case WARNING:
+            return "WARNING";
+        case OVERLOAD:
+            return "OVERLOAD";
+        default:
+            return "UNKNOWN";
+        }
+}
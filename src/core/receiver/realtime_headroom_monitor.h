@@ -0,0 +1,99 @@
+/*!
+ * \file realtime_headroom_monitor.h
+ * \brief Estimates how far the receiver is from falling behind the sample
+ * rate of a live signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_REALTIME_HEADROOM_MONITOR_H
+#define GNSS_SDR_REALTIME_HEADROOM_MONITOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+class Realtime_Headroom_Conf
+{
+public:
+    double warning_lag_ms = 100.0;       //!< backlog that raises a warning
+    double overload_lag_ms = 500.0;      //!< backlog that declares an overload
+    double warning_occupancy = 0.5;      //!< source buffer fill that raises a warning
+    double overload_occupancy = 0.9;     //!< source buffer fill that declares an overload
+    double min_processing_ratio = 0.98;  //!< processed / elapsed time below which the receiver falls behind
+    int window_ms = 2000;                //!< window of the processing ratio
+};
+
+
+/*!
+ * \brief Compares the time spanned by the samples counted by the receiver
+ * (gnss_sdr_sample_counter, gaps included) with the wall clock.
+ *
+ * The receiver lags the source by the latency of its buffers. That lag
+ * only grows when the processing is slower than real time, so the backlog
+ * reported here is the lag over the smallest one observed. Together with
+ * the fill level of the buffers after the signal sources, and with the
+ * ratio of processed to elapsed time over a sliding window, it gives an
+ * early warning before the source overflows and the channels lose lock.
+ *
+ * With a file source the receiver runs faster than real time, and the
+ * backlog stays at zero.
+ */
+class Realtime_Headroom_Monitor
+{
+public:
+    enum State
+    {
+        OK = 0,
+        WARNING = 1,
+        OVERLOAD = 2
+    };
+
+    Realtime_Headroom_Monitor(double fs, const Realtime_Headroom_Conf& conf);
+
+    /*!
+     * \brief Adds a measurement and returns the new state. buffer_occupancy
+     * is the fill level (0 to 1) of the buffers after the signal sources.
+     */
+    State update(uint64_t sample_counter, double buffer_occupancy, std::chrono::steady_clock::time_point now);
+
+    State state() const { return d_state; }
+    double backlog_ms() const { return d_backlog_ms; }
+    double processing_ratio() const { return d_processing_ratio; }
+    double buffer_occupancy() const { return d_buffer_occupancy; }
+
+    static const char* state_name(State state);
+
+private:
+    std::deque<std::pair<std::chrono::steady_clock::time_point, uint64_t>> d_window;
+    Realtime_Headroom_Conf d_conf;
+    std::chrono::steady_clock::time_point d_start_time;
+    uint64_t d_start_samples{0};
+    double d_fs;
+    double d_min_lag_s{0.0};
+    double d_backlog_ms{0.0};
+    double d_processing_ratio{1.0};
+    double d_buffer_occupancy{0.0};
+    State d_state{OK};
+    bool d_started{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_REALTIME_HEADROOM_MONITOR_H
@@ -0,0 +1,223 @@
+/*!
+ * \file receiver_host.cc
+ * \brief Runs several independent receivers in a single process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "receiver_host.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <glog/logging.h>
+#include <chrono>     // for milliseconds
+#include <cmath>      // for abs
+#include <iostream>   // for cin, cout, cerr
+#include <limits>     // for numeric_limits
+#include <map>        // for map
+#include <pthread.h>  // for pthread_cancel
+#include <sys/ipc.h>  // for IPC_CREAT
+#include <sys/msg.h>  // for msgctl, msgget
+#include <utility>    // for move
+
+
+Receiver_Host::Receiver_Host(std::vector<std::string> config_files, std::string config_cache)
+    : d_config_files(std::move(config_files)),
+      d_config_cache(std::move(config_cache)),
+      d_msqid(-1),
+      d_stop(false)
+{
+}
+
+
+Receiver_Host::~Receiver_Host()
+{
+    if (d_msqid != -1)
+        {
+            msgctl(d_msqid, IPC_RMID, nullptr);
+        }
+    if (d_sysv_queue_thread.joinable())
+        {
+            d_sysv_queue_thread.join();
+        }
+    if (d_keyboard_thread.joinable())
+        {
+            d_keyboard_thread.detach();
+        }
+}
+
+
+int Receiver_Host::run()
+{
+    if (!check_configurations())
+        {
+            return 1;
+        }
+
+    for (size_t i = 0; i < d_config_files.size(); i++)
+        {
+            const std::string cache = d_config_cache.empty() ? d_config_cache : d_config_cache + "." + std::to_string(i);
+            std::cout << "Receiver " << i << ": " << d_config_files[i] << '\n';
+            d_receivers.push_back(std::make_unique<ControlThread>(d_config_files[i], cache, true));
+        }
+
+    std::vector<int> return_codes(d_receivers.size(), 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < d_receivers.size(); i++)
+        {
+            threads.emplace_back([this, i, &return_codes]() {
+                try
+                    {
+                        return_codes[i] = d_receivers[i]->run();
+                    }
+                catch (const std::exception& e)
+                    {
+                        LOG(WARNING) << "Receiver " << i << " ended with an exception: " << e.what();
+                        std::cerr << "Receiver " << i << ": " << e.what() << '\n';
+                        return_codes[i] = 1;
+                    }
+                LOG(INFO) << "Receiver " << i << " stopped";
+            });
+        }
+
+    if (FLAGS_keyboard)
+        {
+            d_keyboard_thread = std::thread(&Receiver_Host::keyboard_listener, this);
+        }
+    const key_t key = 1102;
+    d_msqid = msgget(key, 0644 | IPC_CREAT);
+    if (d_msqid == -1)
+        {
+            std::cerr << "GNSS-SDR cannot create SysV message queues\n";
+        }
+    else
+        {
+            d_sysv_queue_thread = std::thread(&Receiver_Host::sysv_queue_listener, this);
+        }
+
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    d_stop = true;
+
+    // Removing the queue wakes up its listener
+    if (d_msqid != -1)
+        {
+            msgctl(d_msqid, IPC_RMID, nullptr);
+            d_msqid = -1;
+        }
+    if (d_sysv_queue_thread.joinable())
+        {
+            d_sysv_queue_thread.join();
+        }
+
+    // Terminate the keyboard thread, blocked on the standard input
+    if (d_keyboard_thread.joinable())
+        {
+            pthread_t id = d_keyboard_thread.native_handle();
+            d_keyboard_thread.detach();
+#ifndef ANDROID
+            pthread_cancel(id);
+#endif
+        }
+
+    for (const auto code : return_codes)
+        {
+            if (code != 0)
+                {
+                    return code;
+                }
+        }
+    return 0;
+}
+
+
+void Receiver_Host::stop_all()
+{
+    for (auto& receiver : d_receivers)
+        {
+            receiver->request_stop();
+        }
+}
+
+
+// Ports and resources set in the configuration cannot be shared by two receivers
+bool Receiver_Host::check_configurations() const
+{
+    std::map<int, size_t> telecommand_ports;
+    for (size_t i = 0; i < d_config_files.size(); i++)
+        {
+            const FileConfiguration configuration(d_config_files[i]);
+            if (!configuration.has_section())
+                {
+                    std::cerr << "Error: the configuration file " << d_config_files[i] << " of receiver " << i << " is not well formatted\n";
+                    return false;
+                }
+            if (configuration.property("GNSS-SDR.telecommand_enabled", false))
+                {
+                    const int port = configuration.property("GNSS-SDR.telecommand_tcp_port", 3333);
+                    const auto ret = telecommand_ports.emplace(port, i);
+                    if (!ret.second)
+                        {
+                            std::cerr << "Error: receivers " << ret.first->second << " and " << i
+                                      << " set the same GNSS-SDR.telecommand_tcp_port=" << port << '\n';
+                            return false;
+                        }
+                }
+        }
+    return true;
+}
+
+
+void Receiver_Host::keyboard_listener()
+{
+    char c = '0';
+    while (!d_stop)
+        {
+            std::cin.get(c);
+            if (c == 'q')
+                {
+                    std::cout << "Quit keystroke order received, stopping all the receivers !!\n";
+                    stop_all();
+                    return;
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+}
+
+
+void Receiver_Host::sysv_queue_listener()
+{
+    typedef struct
+    {
+        long mtype;  // NOLINT(google-runtime-int) required by SysV queue messaging
+        double stop_message;
+    } stop_msgbuf;
+
+    stop_msgbuf msg;
+    const int msgrcv_size = sizeof(msg.stop_message);
+    const int msqid = d_msqid;
+    while (!d_stop)
+        {
+            if (msgrcv(msqid, &msg, msgrcv_size, 1, 0) == -1)
+                {
+                    return;  // the queue was removed
+                }
+            if (std::abs(msg.stop_message - (-200.0)) < 10 * std::numeric_limits<double>::epsilon())
+                {
+                    std::cout << "Quit order received, stopping all the receivers !!\n";
+                    stop_all();
+                    return;
+                }
+        }
+}
@@ -0,0 +1,82 @@
+/*!
+ * \file receiver_host.h
+ * \brief Runs several independent receivers in a single process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RECEIVER_HOST_H
+#define GNSS_SDR_RECEIVER_HOST_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+class ControlThread;
+
+/*!
+ * \brief Hosts one ControlThread, with its own flow graph, per configuration
+ * file, instead of one gnss-sdr process per receiver.
+ *
+ * The receivers do not share any configuration, but they do share what is
+ * process-wide and immutable or already thread-safe: the FFT plans and
+ * FFTW wisdom, the tables of code replicas, the worker thread pools and the
+ * ephemeris and almanac stores. The keyboard and the SysV stop queue belong
+ * to the process, so the host listens to them and stops every receiver.
+ */
+class Receiver_Host
+{
+public:
+    /*!
+     * \param[in] config_files One configuration file per receiver
+     * \param[in] config_cache If not empty, base name of the binary caches of
+     * the configuration files, to which the index of the receiver is appended
+     */
+    Receiver_Host(std::vector<std::string> config_files, std::string config_cache);
+    ~Receiver_Host();
+
+    /*!
+     * \brief Runs all the receivers until all of them stop. Returns the
+     * first non-zero exit code, or zero.
+     */
+    int run();
+
+    /*!
+     * \brief Asks all the receivers to stop. Thread-safe.
+     */
+    void stop_all();
+
+private:
+    void keyboard_listener();
+    void sysv_queue_listener();
+    bool check_configurations() const;
+
+    std::vector<std::string> d_config_files;
+    std::string d_config_cache;
+    std::vector<std::unique_ptr<ControlThread>> d_receivers;
+    std::thread d_keyboard_thread;
+    std::thread d_sysv_queue_thread;
+    std::atomic<int> d_msqid;
+    std::atomic<bool> d_stop;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RECEIVER_HOST_H
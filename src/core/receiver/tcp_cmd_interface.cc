@@ -16,8 +16,10 @@
  */
 
 #include "tcp_cmd_interface.h"
-#include "command_event.h"
+#include "control_queue.h"
+#include "gnss_flowgraph.h"
 #include "pvt_interface.h"
+#include "signal_source_interface.h"
 #include <boost/asio.hpp>
 #include <cmath>      // for isnan
 #include <exception>  // for exception
@@ -53,6 +55,16 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = [&](auto &s) { return TcpCmdInterface::warmstart(s); };
     functions_["coldstart"] = [&](auto &s) { return TcpCmdInterface::coldstart(s); };
     functions_["set_ch_satellite"] = [&](auto &s) { return TcpCmdInterface::set_ch_satellite(s); };
+    functions_["stop_channel"] = [&](auto &s) { return TcpCmdInterface::stop_channel(s); };
+    functions_["start_channel"] = [&](auto &s) { return TcpCmdInterface::start_channel(s); };
+    functions_["seek"] = [&](auto &s) { return TcpCmdInterface::seek(s); };
+    functions_["set_acq_threshold"] = [&](auto &s) { return TcpCmdInterface::set_acq_threshold(s); };
+    functions_["set_acq_doppler"] = [&](auto &s) { return TcpCmdInterface::set_acq_doppler(s); };
+    functions_["set_ch_dump"] = [&](auto &s) { return TcpCmdInterface::set_ch_dump(s); };
+    functions_["set_ch_monitor"] = [&](auto &s) { return TcpCmdInterface::set_ch_monitor(s); };
+    functions_["set_pvt_rate"] = [&](auto &s) { return TcpCmdInterface::set_pvt_rate(s); };
+    functions_["perf"] = [&](auto &s) { return TcpCmdInterface::perf(s); };
+    functions_["memory"] = [&](auto &s) { return TcpCmdInterface::memory(s); };
 #else
     functions_["status"] = std::bind(&TcpCmdInterface::status, this, std::placeholders::_1);
     functions_["standby"] = std::bind(&TcpCmdInterface::standby, this, std::placeholders::_1);
@@ -61,6 +73,16 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = std::bind(&TcpCmdInterface::warmstart, this, std::placeholders::_1);
     functions_["coldstart"] = std::bind(&TcpCmdInterface::coldstart, this, std::placeholders::_1);
     functions_["set_ch_satellite"] = std::bind(&TcpCmdInterface::set_ch_satellite, this, std::placeholders::_1);
+    functions_["stop_channel"] = std::bind(&TcpCmdInterface::stop_channel, this, std::placeholders::_1);
+    functions_["start_channel"] = std::bind(&TcpCmdInterface::start_channel, this, std::placeholders::_1);
+    functions_["seek"] = std::bind(&TcpCmdInterface::seek, this, std::placeholders::_1);
+    functions_["set_acq_threshold"] = std::bind(&TcpCmdInterface::set_acq_threshold, this, std::placeholders::_1);
+    functions_["set_acq_doppler"] = std::bind(&TcpCmdInterface::set_acq_doppler, this, std::placeholders::_1);
+    functions_["set_ch_dump"] = std::bind(&TcpCmdInterface::set_ch_dump, this, std::placeholders::_1);
+    functions_["set_ch_monitor"] = std::bind(&TcpCmdInterface::set_ch_monitor, this, std::placeholders::_1);
+    functions_["set_pvt_rate"] = std::bind(&TcpCmdInterface::set_pvt_rate, this, std::placeholders::_1);
+    functions_["perf"] = std::bind(&TcpCmdInterface::perf, this, std::placeholders::_1);
+    functions_["memory"] = std::bind(&TcpCmdInterface::memory, this, std::placeholders::_1);
 #endif
 }
 
@@ -71,6 +93,18 @@ void TcpCmdInterface::set_pvt(std::shared_ptr<PvtInterface> PVT_sptr)
 }
 
 
+void TcpCmdInterface::set_signal_source(std::shared_ptr<SignalSourceInterface> signal_source_sptr)
+{
+    signal_source_sptr_ = std::move(signal_source_sptr);
+}
+
+
+void TcpCmdInterface::set_flowgraph(std::shared_ptr<GNSSFlowgraph> flowgraph)
+{
+    flowgraph_ = std::move(flowgraph);
+}
+
+
 time_t TcpCmdInterface::get_utc_time() const
 {
     return receiver_utc_time_;
@@ -88,8 +122,8 @@ std::string TcpCmdInterface::reset(const std::vector<std::string> &commandLine _
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(200, 1);  // send the restart message (who=200,what=1)
-            control_queue_->push(pmt::make_any(new_evnt));
+            const Control_Message new_evnt = command_event_make(200, 1);  // send the restart message (who=200,what=1)
+            control_queue_->push(new_evnt);
             response = "OK\n";
         }
     else
@@ -105,8 +139,8 @@ std::string TcpCmdInterface::standby(const std::vector<std::string> &commandLine
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(300, 10);  // send the standby message (who=300,what=10)
-            control_queue_->push(pmt::make_any(new_evnt));
+            const Control_Message new_evnt = command_event_make(300, 10);  // send the standby message (who=300,what=10)
+            control_queue_->push(new_evnt);
             response = "OK\n";
         }
     else
@@ -169,6 +203,10 @@ std::string TcpCmdInterface::status(const std::vector<std::string> &commandLine
             str_stream << "No PVT information available.\n";
         }
 
+    if (flowgraph_ != nullptr)
+        {
+            str_stream << flowgraph_->metrics_report(false);
+        }
     return str_stream.str();
 }
 
@@ -203,8 +241,8 @@ std::string TcpCmdInterface::hotstart(const std::vector<std::string> &commandLin
                 {
                     if (control_queue_ != nullptr)
                         {
-                            const command_event_sptr new_evnt = command_event_make(300, 12);  // send the standby message (who=300,what=12)
-                            control_queue_->push(pmt::make_any(new_evnt));
+                            const Control_Message new_evnt = command_event_make(300, 12);  // send the standby message (who=300,what=12)
+                            control_queue_->push(new_evnt);
                             response = "OK\n";
                         }
                     else
@@ -251,8 +289,8 @@ std::string TcpCmdInterface::warmstart(const std::vector<std::string> &commandLi
                 {
                     if (control_queue_ != nullptr)
                         {
-                            const command_event_sptr new_evnt = command_event_make(300, 13);  // send the warmstart message (who=300,what=13)
-                            control_queue_->push(pmt::make_any(new_evnt));
+                            const Control_Message new_evnt = command_event_make(300, 13);  // send the warmstart message (who=300,what=13)
+                            control_queue_->push(new_evnt);
                             response = "OK\n";
                         }
                     else
@@ -274,8 +312,8 @@ std::string TcpCmdInterface::coldstart(const std::vector<std::string> &commandLi
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(300, 11);  // send the coldstart message (who=300,what=11)
-            control_queue_->push(pmt::make_any(new_evnt));
+            const Control_Message new_evnt = command_event_make(300, 11);  // send the coldstart message (who=300,what=11)
+            control_queue_->push(new_evnt);
             response = "OK\n";
         }
     else
@@ -287,16 +325,193 @@ std::string TcpCmdInterface::coldstart(const std::vector<std::string> &commandLi
 }
 
 
-std::string TcpCmdInterface::set_ch_satellite(const std::vector<std::string> &commandLine __attribute__((unused)))
+std::string TcpCmdInterface::set_ch_satellite(const std::vector<std::string> &commandLine)
+{
+    // set_ch_satellite channel PRN (PRN 0 returns the channel to the automatic satellite assignment)
+    if (commandLine.size() != 3)
+        {
+            return "ERROR: please use set_ch_satellite channel PRN\n";
+        }
+    const int prn = std::stoi(commandLine.at(2));
+    if (prn < 0)
+        {
+            return "ERROR: invalid PRN\n";
+        }
+    return channel_command(commandLine.at(1), 22, prn);  // who=400+channel, what=22
+}
+
+
+std::string TcpCmdInterface::stop_channel(const std::vector<std::string> &commandLine)
+{
+    if (commandLine.size() != 2)
+        {
+            return "ERROR: please use stop_channel channel\n";
+        }
+    return channel_command(commandLine.at(1), 20, 0);  // who=400+channel, what=20
+}
+
+
+std::string TcpCmdInterface::start_channel(const std::vector<std::string> &commandLine)
+{
+    if (commandLine.size() != 2)
+        {
+            return "ERROR: please use start_channel channel\n";
+        }
+    return channel_command(commandLine.at(1), 21, 0);  // who=400+channel, what=21
+}
+
+
+std::string TcpCmdInterface::channel_command(const std::string &channel, int what, int value)
+{
+    const int ch = std::stoi(channel);
+    if (ch < 0 or ch >= 200)
+        {
+            return "ERROR: invalid channel\n";
+        }
+    if (control_queue_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    control_queue_->push(command_event_make(400 + ch, what, value));
+    return "OK\n";
+}
+
+
+std::string TcpCmdInterface::seek(const std::vector<std::string> &commandLine)
 {
     std::string response;
-    // todo: implement the set satellite command
-    response = "Not implemented\n";
+    if (signal_source_sptr_ == nullptr)
+        {
+            response = "ERROR: no signal source\n";
+        }
+    else if (commandLine.size() == 2)
+        {
+            // seek seconds_from_the_beginning_of_the_file
+            const double seconds = std::stod(commandLine.at(1));
+            response = signal_source_sptr_->seek_to_seconds(seconds) ? "OK\n" : "ERROR: the signal source cannot seek to that time\n";
+        }
+    else if (commandLine.size() == 3)
+        {
+            // seek GNSS_week TOW_s
+            const int32_t week = std::stoi(commandLine.at(1));
+            const double tow_s = std::stod(commandLine.at(2));
+            response = signal_source_sptr_->seek_to_time(week, tow_s) ? "OK\n" : "ERROR: the signal source cannot seek to that time\n";
+        }
+    else
+        {
+            response = "ERROR: time parameter not found, please use seek seconds or seek week TOW[s]\n";
+        }
     return response;
 }
 
 
-void TcpCmdInterface::set_msg_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue)
+std::string TcpCmdInterface::set_acq_threshold(const std::vector<std::string> &commandLine)
+{
+    // set_acq_threshold signal threshold (e.g. set_acq_threshold 1C 2.5)
+    if (commandLine.size() != 3)
+        {
+            return "ERROR: please use set_acq_threshold signal threshold\n";
+        }
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    const float threshold = std::stof(commandLine.at(2));
+    if (!(threshold > 0.0))
+        {
+            return "ERROR: invalid threshold\n";
+        }
+    return flowgraph_->set_acquisition_threshold(commandLine.at(1), threshold) > 0 ? "OK\n" : "ERROR: no channel of that signal\n";
+}
+
+
+std::string TcpCmdInterface::set_acq_doppler(const std::vector<std::string> &commandLine)
+{
+    // set_acq_doppler signal doppler_max_hz
+    if (commandLine.size() != 3)
+        {
+            return "ERROR: please use set_acq_doppler signal doppler_max_hz\n";
+        }
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    const int doppler_max = std::stoi(commandLine.at(2));
+    if (doppler_max <= 0)
+        {
+            return "ERROR: invalid Doppler shift\n";
+        }
+    return flowgraph_->set_acquisition_doppler_max(commandLine.at(1), static_cast<uint32_t>(doppler_max)) > 0 ? "OK\n" : "ERROR: no channel of that signal\n";
+}
+
+
+std::string TcpCmdInterface::set_ch_dump(const std::vector<std::string> &commandLine)
+{
+    // set_ch_dump channel on|off
+    if (commandLine.size() != 3 or (commandLine.at(2) != "on" and commandLine.at(2) != "off"))
+        {
+            return "ERROR: please use set_ch_dump channel on|off\n";
+        }
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    return flowgraph_->set_channel_dump(std::stoi(commandLine.at(1)), commandLine.at(2) == "on") ? "OK\n" : "ERROR: the channel does not exist or has no dump configured\n";
+}
+
+
+std::string TcpCmdInterface::set_ch_monitor(const std::vector<std::string> &commandLine)
+{
+    // set_ch_monitor channel on|off
+    if (commandLine.size() != 3 or (commandLine.at(2) != "on" and commandLine.at(2) != "off"))
+        {
+            return "ERROR: please use set_ch_monitor channel on|off\n";
+        }
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    return flowgraph_->set_channel_monitor(std::stoi(commandLine.at(1)), commandLine.at(2) == "on") ? "OK\n" : "ERROR: the channel does not exist or no monitor is enabled\n";
+}
+
+
+std::string TcpCmdInterface::set_pvt_rate(const std::vector<std::string> &commandLine)
+{
+    // set_pvt_rate kml|gpx|geojson|nmea|display rate_ms
+    if (commandLine.size() != 3)
+        {
+            return "ERROR: please use set_pvt_rate output rate_ms\n";
+        }
+    if (PVT_sptr_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    const int32_t rate_ms = std::stoi(commandLine.at(2));
+    return PVT_sptr_->set_output_rate(commandLine.at(1), rate_ms) ? "OK\n" : "ERROR: the output is not enabled or the rate is not a multiple of the PVT rate\n";
+}
+
+
+std::string TcpCmdInterface::perf(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    return flowgraph_->performance_report();
+}
+
+
+std::string TcpCmdInterface::memory(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    if (flowgraph_ == nullptr)
+        {
+            return "ERROR\n";
+        }
+    return flowgraph_->memory_report();
+}
+
+
+void TcpCmdInterface::set_msg_queue(std::shared_ptr<Control_Queue> control_queue)
 {
     control_queue_ = std::move(control_queue);
 }
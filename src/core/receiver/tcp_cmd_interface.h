@@ -19,7 +19,7 @@
 #define GNSS_SDR_TCP_CMD_INTERFACE_H
 
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include <pmt/pmt.h>
 #include <array>
 #include <cstdint>
@@ -36,7 +36,9 @@
  * \{ */
 
 
+class GNSSFlowgraph;
 class PvtInterface;
+class SignalSourceInterface;
 
 class TcpCmdInterface
 {
@@ -44,7 +46,7 @@ public:
     TcpCmdInterface();
     ~TcpCmdInterface() = default;
     void run_cmd_server(int tcp_port);
-    void set_msg_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue);
+    void set_msg_queue(std::shared_ptr<Control_Queue> control_queue);
 
     /*!
      * \brief gets the UTC time parsed from the last TC command issued
@@ -58,6 +60,10 @@ public:
 
     void set_pvt(std::shared_ptr<PvtInterface> PVT_sptr);
 
+    void set_signal_source(std::shared_ptr<SignalSourceInterface> signal_source_sptr);
+
+    void set_flowgraph(std::shared_ptr<GNSSFlowgraph> flowgraph);
+
 private:
     std::unordered_map<std::string, std::function<std::string(const std::vector<std::string> &)>>
         functions_;
@@ -68,11 +74,24 @@ private:
     std::string warmstart(const std::vector<std::string> &commandLine);
     std::string coldstart(const std::vector<std::string> &commandLine);
     std::string set_ch_satellite(const std::vector<std::string> &commandLine);
+    std::string stop_channel(const std::vector<std::string> &commandLine);
+    std::string start_channel(const std::vector<std::string> &commandLine);
+    std::string channel_command(const std::string &channel, int what, int value);
+    std::string seek(const std::vector<std::string> &commandLine);
+    std::string set_acq_threshold(const std::vector<std::string> &commandLine);
+    std::string set_acq_doppler(const std::vector<std::string> &commandLine);
+    std::string set_ch_dump(const std::vector<std::string> &commandLine);
+    std::string set_ch_monitor(const std::vector<std::string> &commandLine);
+    std::string set_pvt_rate(const std::vector<std::string> &commandLine);
+    std::string perf(const std::vector<std::string> &commandLine);
+    std::string memory(const std::vector<std::string> &commandLine);
 
     void register_functions();
 
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
+    std::shared_ptr<Control_Queue> control_queue_;
     std::shared_ptr<PvtInterface> PVT_sptr_;
+    std::shared_ptr<SignalSourceInterface> signal_source_sptr_;
+    std::shared_ptr<GNSSFlowgraph> flowgraph_;
 
     float rx_latitude_;
     float rx_longitude_;
@@ -0,0 +1,108 @@
+/*!
+ * \file tracking_checkpoint.cc
+ * \brief Periodic record of the satellites in tracking, used to resume them
+ * quickly after a restart of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_checkpoint.h"
+#include <glog/logging.h>  // for LOG
+#include <cstdio>          // for std::rename
+#include <ctime>           // for std::time
+#include <exception>       // for std::exception
+#include <fstream>         // for std::ifstream, std::ofstream
+#include <iomanip>         // for std::setprecision
+#include <sstream>         // for std::istringstream
+#include <utility>         // for std::move
+
+
+namespace
+{
+const char* const FILE_HEADER = "# GNSS-SDR tracking checkpoint 1";
+}
+
+
+bool Tracking_Checkpoint::save(const std::string& file_name)
+{
+    creation_time = static_cast<int64_t>(std::time(nullptr));
+    const std::string tmp_file_name = file_name + ".tmp";
+    try
+        {
+            std::ofstream file;
+            file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            file.open(tmp_file_name.c_str(), std::ios::out | std::ios::trunc);
+            file << FILE_HEADER << '\n'
+                 << creation_time << '\n'
+                 << std::setprecision(12);
+            for (const auto& entry : entries)
+                {
+                    file << entry.channel << ' ' << entry.System << ' ' << entry.Signal << ' ' << entry.PRN << ' '
+                         << entry.Carrier_Doppler_hz << ' ' << entry.CN0_dB_hz << ' ' << entry.TOW_at_current_symbol_ms << '\n';
+                }
+            file.close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Failed to write the tracking checkpoint " << tmp_file_name << ": " << e.what();
+            return false;
+        }
+    if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+        {
+            LOG(WARNING) << "Failed to rename the tracking checkpoint " << tmp_file_name;
+            return false;
+        }
+    return true;
+}
+
+
+bool Tracking_Checkpoint::load(const std::string& file_name, int64_t max_age_s)
+{
+    std::ifstream file(file_name.c_str());
+    std::string line;
+    if (!file.is_open() or !std::getline(file, line) or line != FILE_HEADER or !std::getline(file, line))
+        {
+            return false;
+        }
+    int64_t time = 0;
+    std::istringstream time_line(line);
+    if (!(time_line >> time))
+        {
+            LOG(WARNING) << "Invalid tracking checkpoint " << file_name;
+            return false;
+        }
+    const int64_t age_s = static_cast<int64_t>(std::time(nullptr)) - time;
+    if (age_s < 0 or age_s > max_age_s)
+        {
+            LOG(INFO) << "Tracking checkpoint " << file_name << " expired";
+            return false;
+        }
+    std::vector<Entry> read_entries;
+    while (std::getline(file, line))
+        {
+            if (line.empty())
+                {
+                    continue;
+                }
+            Entry entry;
+            std::istringstream fields(line);
+            if (!(fields >> entry.channel >> entry.System >> entry.Signal >> entry.PRN >> entry.Carrier_Doppler_hz >> entry.CN0_dB_hz >> entry.TOW_at_current_symbol_ms))
+                {
+                    LOG(WARNING) << "Invalid tracking checkpoint " << file_name;
+                    return false;
+                }
+            read_entries.push_back(std::move(entry));
+        }
+    entries = std::move(read_entries);
+    creation_time = time;
+    LOG(INFO) << "Loaded the tracking checkpoint saved " << age_s << " s ago, with " << entries.size() << " channels";
+    return true;
+}
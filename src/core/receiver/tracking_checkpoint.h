@@ -0,0 +1,74 @@
+/*!
+ * \file tracking_checkpoint.h
+ * \brief Periodic record of the satellites in tracking, used to resume them
+ * quickly after a restart of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_CHECKPOINT_H
+#define GNSS_SDR_TRACKING_CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Tracking state of the channels, saved to a text file.
+ *
+ * The loop filter and NCO states refer to the sample counter of the signal
+ * source, which starts again from zero with the receiver, so they are not
+ * kept. What survives a restart is which satellite each channel tracked and
+ * its Doppler shift, which is enough to acquire it again in a narrow Doppler
+ * window instead of a full search.
+ */
+class Tracking_Checkpoint
+{
+public:
+    class Entry
+    {
+    public:
+        std::string System;  // "GPS", "Galileo", ...
+        std::string Signal;  // "1C", "1B", ...
+        uint32_t PRN{0};
+        int32_t channel{0};
+        double Carrier_Doppler_hz{0.0};
+        double CN0_dB_hz{0.0};
+        uint32_t TOW_at_current_symbol_ms{0};
+    };
+
+    std::vector<Entry> entries;
+    int64_t creation_time{0};  // seconds since the Unix epoch
+
+    /*!
+     * \brief Writes the entries, stamped with the current time. The file is
+     * replaced at once, so a crash while writing leaves the previous one.
+     */
+    bool save(const std::string& file_name);
+
+    /*!
+     * \brief Reads a file written by save(). Fails, leaving the checkpoint
+     * unchanged, if it does not exist, cannot be parsed or is older than
+     * max_age_s.
+     */
+    bool load(const std::string& file_name, int64_t max_age_s);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_CHECKPOINT_H
@@ -42,6 +42,11 @@ constexpr int32_t GALILEO_E5B_Q_SECONDARY_CODE_LENGTH = 100;  //!< Galileo E5b-Q
 constexpr int32_t GALILEO_E5B_SYMBOL_RATE_BPS = 250;          //!< Galileo E5b symbol rate [bits/second]
 constexpr int32_t GALILEO_E5B_NUMBER_OF_CODES = 50;
 
+// Full-band E5 AltBOC(15,10), with E5a as lower and E5b as upper sideband
+constexpr double GALILEO_E5_FREQ_HZ = FREQ8;                      //!< Galileo E5 (E5a+E5b) carrier frequency [Hz]
+constexpr double GALILEO_E5_ALTBOC_SUBCARRIER_FREQ_HZ = 1.5345e7;  //!< Galileo E5 AltBOC subcarrier frequency [Hz]
+constexpr int32_t GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP = 12;          //!< Eight subcarrier segments per subcarrier period, 1.5 periods per chip
+
 
 // OBSERVABLE HISTORY DEEP FOR INTERPOLATION
 constexpr int32_t GALILEO_E5B_HISTORY_DEEP = 100;
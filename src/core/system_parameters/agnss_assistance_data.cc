@@ -0,0 +1,185 @@
+/*!
+ * \file agnss_assistance_data.cc
+ * \brief Assisted GNSS data of all the systems, stored in a versioned binary
+ * file that is loaded through a memory mapping
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "agnss_assistance_data.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/serialization/map.hpp>
+#include <glog/logging.h>
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#include <cstdio>      // for std::rename
+#include <cstring>     // for std::memcmp, std::memcpy
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+const char FILE_MAGIC[4] = {'G', 'S', 'A', 'D'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t HEADER_LENGTH = 32;
+
+
+template <typename T>
+void write_value(std::ofstream& file, T value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+
+template <typename T>
+T read_value(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+
+// Same order for saving (Data is const) and loading. The valid flag of
+// Gps_Iono is not in its serialize(), which is shared with the XML files.
+template <class Archive, class Data>
+void serialize_payload(Archive& archive, Data& data)
+{
+    archive& data.gps_ephemeris_map;
+    archive& data.gps_cnav_ephemeris_map;
+    archive& data.gal_ephemeris_map;
+    archive& data.glonass_gnav_ephemeris_map;
+    archive& data.gps_almanac_map;
+    archive& data.gal_almanac_map;
+    archive& data.gps_iono;
+    archive& data.gps_iono.valid;
+    archive& data.gal_iono;
+    archive& data.gps_utc;
+    archive& data.gps_cnav_utc;
+    archive& data.gal_utc;
+    archive& data.glo_gnav_utc;
+    archive& data.ref_location;
+    archive& data.ref_time;
+}
+}  // namespace
+
+
+bool Agnss_Assistance_Data::save(const std::string& file_name)
+{
+    creation_time = static_cast<int64_t>(std::time(nullptr));
+    const std::string tmp_file_name = file_name + ".tmp";
+    try
+        {
+            std::ostringstream payload;
+            {
+                boost::archive::binary_oarchive archive(payload);
+                serialize_payload(archive, static_cast<const Agnss_Assistance_Data&>(*this));
+            }
+            const std::string bytes = payload.str();
+
+            // written to a temporary file first, so that a receiver that
+            // starts meanwhile does not read half a file
+            std::ofstream file;
+            file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            file.open(tmp_file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+            write_value<uint32_t>(file, format_version);
+            write_value<uint32_t>(file, BYTE_ORDER_MARK);
+            write_value<uint32_t>(file, 0);
+            write_value<int64_t>(file, creation_time);
+            write_value<uint64_t>(file, static_cast<uint64_t>(bytes.size()));
+            file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            file.close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Failed to write the assistance file " << tmp_file_name << ": " << e.what();
+            return false;
+        }
+    if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+        {
+            LOG(WARNING) << "Failed to rename the assistance file " << tmp_file_name;
+            return false;
+        }
+    return true;
+}
+
+
+bool Agnss_Assistance_Data::load(const std::string& file_name)
+{
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            return false;
+        }
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_LENGTH)
+        {
+            ::close(fd);
+            return false;
+        }
+    const auto length = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    const char* data = static_cast<const char*>(mapping);
+
+    bool loaded = false;
+    if (std::memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        read_value<uint32_t>(data + 4) != format_version ||
+        read_value<uint32_t>(data + 8) != BYTE_ORDER_MARK ||
+        read_value<uint64_t>(data + 24) != length - HEADER_LENGTH)
+        {
+            LOG(WARNING) << "The assistance file " << file_name << " is truncated, or of another version or byte order";
+        }
+    else
+        {
+            try
+                {
+                    boost::iostreams::stream<boost::iostreams::array_source> payload(data + HEADER_LENGTH, length - HEADER_LENGTH);
+                    boost::archive::binary_iarchive archive(payload);
+                    Agnss_Assistance_Data loaded_data;
+                    serialize_payload(archive, loaded_data);
+                    loaded_data.creation_time = read_value<int64_t>(data + 16);
+                    *this = std::move(loaded_data);
+                    loaded = true;
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Failed to read the assistance file " << file_name << ": " << e.what();
+                }
+        }
+    munmap(mapping, length);
+    return loaded;
+}
+
+
+bool Agnss_Assistance_Data::empty() const
+{
+    return gps_ephemeris_map.empty() and gps_cnav_ephemeris_map.empty() and
+           gal_ephemeris_map.empty() and glonass_gnav_ephemeris_map.empty() and
+           gps_almanac_map.empty() and gal_almanac_map.empty();
+}
@@ -0,0 +1,100 @@
+/*!
+ * \file agnss_assistance_data.h
+ * \brief Assisted GNSS data of all the systems, stored in a versioned binary
+ * file that is loaded through a memory mapping
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_AGNSS_ASSISTANCE_DATA_H
+#define GNSS_SDR_AGNSS_ASSISTANCE_DATA_H
+
+#include "agnss_ref_location.h"
+#include "agnss_ref_time.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gps_almanac.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Ephemeris, almanacs, ionospheric and UTC models, reference location
+ * and reference time of all the systems, as a single binary file:
+ *
+ *   header:  "GSAD", version, byte order mark, 0, creation time, payload length
+ *   payload: Boost binary archive of the data members
+ *
+ * It holds the same data as the set of XML files, but it is loaded with a
+ * single memory mapping instead of parsing text. Values are stored in the byte
+ * order of the host, and a file of another version or byte order is rejected.
+ */
+class Agnss_Assistance_Data
+{
+public:
+    Agnss_Assistance_Data() = default;
+
+    /*!
+     * \brief Writes the data to file_name, through a temporary file that is
+     * renamed at the end, stamped with the current time
+     */
+    bool save(const std::string& file_name);
+
+    /*!
+     * \brief Replaces the data by the contents of file_name. Nothing is
+     * changed if the file cannot be read.
+     */
+    bool load(const std::string& file_name);
+
+    /*!
+     * \brief True if there is neither ephemeris nor almanac data
+     */
+    bool empty() const;
+
+    static const uint32_t format_version = 1;
+
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;
+    std::map<int, Galileo_Ephemeris> gal_ephemeris_map;
+    std::map<int, Glonass_Gnav_Ephemeris> glonass_gnav_ephemeris_map;
+    std::map<int, Gps_Almanac> gps_almanac_map;
+    std::map<int, Galileo_Almanac> gal_almanac_map;
+    Gps_Iono gps_iono;
+    Galileo_Iono gal_iono;
+    Gps_Utc_Model gps_utc;
+    Gps_CNAV_Utc_Model gps_cnav_utc;
+    Galileo_Utc_Model gal_utc;
+    Glonass_Gnav_Utc_Model glo_gnav_utc;
+    Agnss_Ref_Location ref_location;
+    Agnss_Ref_Time ref_time;
+    int64_t creation_time{0};  //!< Seconds since the Unix epoch when saved
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_AGNSS_ASSISTANCE_DATA_H
@@ -18,6 +18,7 @@
 
 #include "beidou_dnav_navigation_message.h"
 #include "gnss_satellite.h"
+#include <bitset>
 #include <cmath>     // for cos, sin, fmod, sqrt, atan2, fabs, floor
 #include <iostream>  // for string, operator<<, cout, ostream
 #include <limits>    // for std::numeric_limits
@@ -45,80 +46,32 @@ void Beidou_Dnav_Navigation_Message::print_beidou_word_bytes(uint32_t BEIDOU_wor
 
 
 bool Beidou_Dnav_Navigation_Message::read_navigation_bool(
-    const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
-    const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+    const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
+    const Gnss_Nav_Field& parameter) const
 {
-    bool value;
-
-    if (bits[BEIDOU_DNAV_SUBFRAME_DATA_BITS - parameter[0].first] == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
 uint64_t Beidou_Dnav_Navigation_Message::read_navigation_unsigned(
-    const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
-    const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+    const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
+    const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1U;  // shift left
-                    if (bits[BEIDOU_DNAV_SUBFRAME_DATA_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1U;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
 int64_t Beidou_Dnav_Navigation_Message::read_navigation_signed(
-    const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
-    const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+    const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits,
+    const Gnss_Nav_Field& parameter) const
 {
-    int64_t value = 0;
-    const int32_t num_of_slices = parameter.size();
-
-    // read the MSB and perform the sign extension
-    if (bits[BEIDOU_DNAV_SUBFRAME_DATA_BITS - parameter[0].first] == 1)
-        {
-            value ^= 0xFFFFFFFFFFFFFFFF;  // 64 bits variable
-        }
-    else
-        {
-            value &= 0;
-        }
-
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value *= 2;                   // shift left the signed integer
-                    value &= 0xFFFFFFFFFFFFFFFE;  // reset the corresponding bit (for the 64 bits variable)
-                    if (bits[BEIDOU_DNAV_SUBFRAME_DATA_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_signed(parameter);
 }
 
 
 int32_t Beidou_Dnav_Navigation_Message::d1_subframe_decoder(std::string const& subframe)
 {
-    const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits(subframe);
+    const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits(subframe);
     const auto subframe_ID = static_cast<int>(read_navigation_unsigned(subframe_bits, D1_FRAID));
 
     // Perform crc computation (tbd)
@@ -410,7 +363,7 @@ int32_t Beidou_Dnav_Navigation_Message::d1_subframe_decoder(std::string const& s
 
 int32_t Beidou_Dnav_Navigation_Message::d2_subframe_decoder(std::string const& subframe)
 {
-    const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits(subframe);
+    const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits(subframe);
 
     const auto subframe_ID = static_cast<int>(read_navigation_unsigned(subframe_bits, D2_FRAID));
     const auto page_ID = static_cast<int>(read_navigation_unsigned(subframe_bits, D2_PNUM));
@@ -649,7 +602,7 @@ Beidou_Dnav_Ephemeris Beidou_Dnav_Navigation_Message::get_ephemeris() const
 
     if (i_satellite_PRN > 0 and i_satellite_PRN < 6)
         {
-            std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits;
+            Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS> subframe_bits;
 
             // Order as given by eph_t in rtklib
             eph.PRN = i_satellite_PRN;
@@ -667,29 +620,29 @@ Beidou_Dnav_Ephemeris Beidou_Dnav_Navigation_Message::get_ephemeris() const
 
             eph.sqrtA = d_sqrt_A;
             eph.ecc = static_cast<double>((d_eccentricity_msb + d_eccentricity_lsb)) * D1_E_LSB;
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_i_0_msb_bits + d_i_0_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_i_0_msb_bits + d_i_0_lsb_bits);
             eph.i_0 = static_cast<double>(read_navigation_signed(subframe_bits, D2_I0)) * D1_I0_LSB;
             eph.OMEGA_0 = d_OMEGA0;
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_OMEGA_msb_bits + d_OMEGA_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_OMEGA_msb_bits + d_OMEGA_lsb_bits);
             eph.omega = static_cast<double>(read_navigation_signed(subframe_bits, D2_OMEGA)) * D1_OMEGA_LSB;
             eph.M_0 = d_M_0;
             eph.delta_n = d_Delta_n;
 
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_OMEGA_DOT_msb_bits + d_OMEGA_DOT_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_OMEGA_DOT_msb_bits + d_OMEGA_DOT_lsb_bits);
             eph.OMEGAdot = static_cast<double>(read_navigation_signed(subframe_bits, D2_OMEGA_DOT)) * D1_OMEGA_DOT_LSB;
             eph.idot = d_IDOT;
 
             eph.Crc = d_Crc;
             eph.Crs = d_Crs;
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_Cuc_msb_bits + d_Cuc_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_Cuc_msb_bits + d_Cuc_lsb_bits);
             eph.Cuc = static_cast<double>(read_navigation_signed(subframe_bits, D2_CUC)) * D1_CUC_LSB;
             eph.Cus = d_Cus;
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_Cic_msb_bits + d_Cic_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_Cic_msb_bits + d_Cic_lsb_bits);
             eph.Cic = static_cast<double>(read_navigation_signed(subframe_bits, D2_CIC)) * D1_CIC_LSB;
             eph.Cis = d_Cis;
 
             eph.af0 = d_A_f0;
-            subframe_bits = std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>(d_A_f1_msb_bits + d_A_f1_lsb_bits);
+            subframe_bits.set_bits(BEIDOU_DNAV_SUBFRAME_DATA_BITS - 63, 64, d_A_f1_msb_bits + d_A_f1_lsb_bits);
             eph.af1 = static_cast<double>(read_navigation_signed(subframe_bits, D2_A1)) * D1_A1_LSB;
             eph.af2 = d_A_f2;
 
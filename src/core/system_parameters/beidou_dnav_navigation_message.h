@@ -27,12 +27,9 @@
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
-#include <bitset>
 #include <cstdint>
 #include <map>
 #include <string>
-#include <utility>
-#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -138,9 +135,9 @@ public:
     }
 
 private:
-    uint64_t read_navigation_unsigned(const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    bool read_navigation_bool(const std::bitset<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    bool read_navigation_bool(const Gnss_Nav_Bits<BEIDOU_DNAV_SUBFRAME_DATA_BITS>& bits, const Gnss_Nav_Field& parameter) const;
     void print_beidou_word_bytes(uint32_t BEIDOU_word) const;
 
     // broadcast orbit 1
@@ -21,15 +21,13 @@
  */
 
 #include "galileo_fnav_message.h"
-#include <boost/crc.hpp>  // for boost::crc_basic, boost::crc_optimal
 #include <boost/dynamic_bitset.hpp>
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>  // for reverse
 #include <iostream>   // for string, operator<<
 #include <iterator>   // for back_insert_iterator
 
-using CRC_Galileo_FNAV_type = boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false>;
-
 
 void Galileo_Fnav_Message::split_page(const std::string& page_string)
 {
@@ -52,8 +50,6 @@ void Galileo_Fnav_Message::split_page(const std::string& page_string)
 
 bool Galileo_Fnav_Message::CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, uint32_t checksum) const
 {
-    CRC_Galileo_FNAV_type CRC_Galileo;
-
     // Galileo FNAV frame for CRC is not an integer multiple of bytes
     // it needs to be filled with zeroes at the start of the frame.
     // This operation is done in the transformation from bits to bytes
@@ -66,9 +62,8 @@ bool Galileo_Fnav_Message::CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BI
     boost::to_block_range(frame_bits, std::back_inserter(bytes));
     std::reverse(bytes.begin(), bytes.end());
 
-    CRC_Galileo.process_bytes(bytes.data(), GALILEO_FNAV_DATA_FRAME_BYTES);
-
-    const uint32_t crc_computed = CRC_Galileo.checksum();
+    uint32_t crc_computed = 0;
+    volk_gnsssdr_8u_crc24q_32u(&crc_computed, bytes.data(), GALILEO_FNAV_DATA_FRAME_BYTES);
     if (checksum == crc_computed)
         {
             return true;
@@ -80,7 +75,7 @@ bool Galileo_Fnav_Message::CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BI
 
 void Galileo_Fnav_Message::decode_page(const std::string& data)
 {
-    const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> data_bits(data);
+    const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS> data_bits(data);
     page_type = read_navigation_unsigned(data_bits, FNAV_PAGE_TYPE_BIT);
     switch (page_type)
         {
@@ -239,8 +234,8 @@ void Galileo_Fnav_Message::decode_page(const std::string& data)
             // flag will be set to false and the data won't be recorded.*/
             const std::string omega0_2 = data.substr(10, 12);
             const std::string Omega0 = omega0_1 + omega0_2;
-            const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> omega_bits(Omega0);
-            const std::vector<std::pair<int32_t, int32_t>> om_bit({{0, 12}});
+            const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS> omega_bits(Omega0);  // in the last 16 positions
+            const Gnss_Nav_Field om_bit({GALILEO_FNAV_DATA_FRAME_BITS - 15, 16});
             FNAV_Omega0_2_6 = static_cast<double>(read_navigation_signed(omega_bits, om_bit));
             FNAV_Omega0_2_6 *= FNAV_OMEGA0_5_LSB;
             FNAV_Omegadot_2_6 = static_cast<double>(read_navigation_signed(data_bits, FNAV_OMEGADOT_2_6_BIT));
@@ -279,53 +274,15 @@ void Galileo_Fnav_Message::decode_page(const std::string& data)
 }
 
 
-uint64_t Galileo_Fnav_Message::read_navigation_unsigned(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint64_t Galileo_Fnav_Message::read_navigation_unsigned(const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int num_of_slices = parameter.size();
-    for (int i = 0; i < num_of_slices; i++)
-        {
-            for (int j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1U;  // shift left
-                    if (static_cast<int>(bits[GALILEO_FNAV_DATA_FRAME_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-int64_t Galileo_Fnav_Message::read_navigation_signed(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+int64_t Galileo_Fnav_Message::read_navigation_signed(const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    int64_t value = 0LL;
-    const int num_of_slices = parameter.size();
-
-    // read the MSB and perform the sign extension
-    if (static_cast<int>(bits[GALILEO_FNAV_DATA_FRAME_BITS - parameter[0].first]) == 1)
-        {
-            value ^= 0x0FFFFFFFFFFFFFFF;  // 64 bits variable
-        }
-    else
-        {
-            value &= 0;
-        }
-
-    for (int i = 0; i < num_of_slices; i++)
-        {
-            for (int j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;                  // shift left
-                    value &= 0xFFFFFFFFFFFFFFFE;  // reset the corresponding bit (for the 64 bits variable)
-                    if (static_cast<int>(bits[GALILEO_FNAV_DATA_FRAME_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_signed(parameter);
 }
 
 
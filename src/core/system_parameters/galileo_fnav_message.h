@@ -33,8 +33,6 @@
 #include <bitset>
 #include <cstdint>
 #include <string>
-#include <utility>
-#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -140,8 +138,8 @@ public:
 private:
     bool CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, uint32_t checksum) const;
     void decode_page(const std::string& data);
-    uint64_t read_navigation_unsigned(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Nav_Bits<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const;
 
     std::string omega0_1{};
     // std::string omega0_2{};
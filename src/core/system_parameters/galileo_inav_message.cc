@@ -19,18 +19,15 @@
 #include "galileo_inav_message.h"
 #include "galileo_reduced_ced.h"
 #include "reed_solomon.h"
-#include <boost/crc.hpp>             // for boost::crc_basic, boost::crc_optimal
 #include <boost/dynamic_bitset.hpp>  // for boost::dynamic_bitset
 #include <glog/logging.h>            // for DLOG
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>                 // for reverse
 #include <iostream>                  // for operator<<
 #include <limits>                    // for std::numeric_limits
 #include <numeric>                   // for std::accumulate
 
 
-using CRC_Galileo_INAV_type = boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false>;
-
-
 Galileo_Inav_Message::Galileo_Inav_Message()
 {
     rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
@@ -46,8 +43,6 @@ Galileo_Inav_Message::~Galileo_Inav_Message() = default;
 
 bool Galileo_Inav_Message::CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>& bits, uint32_t checksum) const
 {
-    CRC_Galileo_INAV_type CRC_Galileo;
-
     // Galileo INAV frame for CRC is not an integer multiple of bytes
     // it needs to be filled with zeroes at the start of the frame.
     // This operation is done in the transformation from bits to bytes
@@ -60,9 +55,8 @@ bool Galileo_Inav_Message::CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>&
     boost::to_block_range(frame_bits, std::back_inserter(bytes));
     std::reverse(bytes.begin(), bytes.end());
 
-    CRC_Galileo.process_bytes(bytes.data(), GALILEO_DATA_FRAME_BYTES);
-
-    const uint32_t crc_computed = CRC_Galileo.checksum();
+    uint32_t crc_computed = 0;
+    volk_gnsssdr_8u_crc24q_32u(&crc_computed, bytes.data(), GALILEO_DATA_FRAME_BYTES);
     if (checksum == crc_computed)
         {
             return true;
@@ -71,106 +65,33 @@ bool Galileo_Inav_Message::CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>&
 }
 
 
-uint64_t Galileo_Inav_Message::read_navigation_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint64_t Galileo_Inav_Message::read_navigation_unsigned(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1U;  // shift left
-                    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-uint8_t Galileo_Inav_Message::read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint8_t Galileo_Inav_Message::read_octet_unsigned(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint8_t value = 0;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return static_cast<uint8_t>(bits.read_unsigned(parameter));
 }
 
 
-uint64_t Galileo_Inav_Message::read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint64_t Galileo_Inav_Message::read_page_type_unsigned(const Gnss_Nav_Bits<GALILEO_PAGE_TYPE_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1U;  // shift left
-                    if (static_cast<int>(bits[GALILEO_PAGE_TYPE_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1ULL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-int64_t Galileo_Inav_Message::read_navigation_signed(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+int64_t Galileo_Inav_Message::read_navigation_signed(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    int64_t value = 0LL;
-    const int32_t num_of_slices = parameter.size();
-
-    // read the MSB and perform the sign extension
-    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[0].first]) == 1)
-        {
-            value ^= 0xFFFFFFFFFFFFFFFFLL;  // 64 bits variable
-        }
-    else
-        {
-            value &= 0LL;
-        }
-
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value *= 2;                   // shift left the signed integer
-                    value &= 0xFFFFFFFFFFFFFFFE;  // reset the corresponding bit (for the 64 bits variable)
-                    if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1LL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_signed(parameter);
 }
 
 
-bool Galileo_Inav_Message::read_navigation_bool(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+bool Galileo_Inav_Message::read_navigation_bool(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    bool value;
-    if (static_cast<int>(static_cast<int>(bits[GALILEO_DATA_JK_BITS - parameter[0].first])) == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
@@ -214,7 +135,7 @@ void Galileo_Inav_Message::split_page(std::string page_string, int32_t flag_even
                             flag_CRC_test = true;
                             // CRC correct: Decode word
                             const std::string page_number_bits = Data_k.substr(0, 6);
-                            const std::bitset<GALILEO_PAGE_TYPE_BITS> page_type_bits(page_number_bits);  // from string to bitset
+                            const Gnss_Nav_Bits<GALILEO_PAGE_TYPE_BITS> page_type_bits(page_number_bits);
                             Page_type = static_cast<int32_t>(read_page_type_unsigned(page_type_bits, TYPE));
                             Page_type_time_stamp = Page_type;
                             const std::string Data_jk_ephemeris = Data_k + Data_j;
@@ -332,22 +253,22 @@ bool Galileo_Inav_Message::have_new_ephemeris()  // Check if we have a new ephem
                             if (inav_rs_pages[0] == 0)
                                 {
                                     std::bitset<GALILEO_DATA_JK_BITS> missing_bits = regenerate_page_1(rs_buffer);
-                                    read_page_1(missing_bits);
+                                    read_page_1(Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>(missing_bits));
                                 }
                             if (inav_rs_pages[1] == 0)
                                 {
                                     std::bitset<GALILEO_DATA_JK_BITS> missing_bits = regenerate_page_2(rs_buffer);
-                                    read_page_2(missing_bits);
+                                    read_page_2(Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>(missing_bits));
                                 }
                             if (inav_rs_pages[2] == 0)
                                 {
                                     std::bitset<GALILEO_DATA_JK_BITS> missing_bits = regenerate_page_3(rs_buffer);
-                                    read_page_3(missing_bits);
+                                    read_page_3(Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>(missing_bits));
                                 }
                             if (inav_rs_pages[3] == 0)
                                 {
                                     std::bitset<GALILEO_DATA_JK_BITS> missing_bits = regenerate_page_4(rs_buffer);
-                                    read_page_4(missing_bits);
+                                    read_page_4(Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>(missing_bits));
                                 }
 
                             // Reset flags
@@ -615,7 +536,7 @@ Galileo_Ephemeris Galileo_Inav_Message::get_reduced_ced() const
 }
 
 
-void Galileo_Inav_Message::read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits)
+void Galileo_Inav_Message::read_page_1(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits)
 {
     IOD_nav_1 = static_cast<int32_t>(read_navigation_unsigned(data_bits, IOD_NAV_1_BIT));
     DLOG(INFO) << "IOD_nav_1= " << IOD_nav_1;
@@ -636,7 +557,7 @@ void Galileo_Inav_Message::read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>&
 }
 
 
-void Galileo_Inav_Message::read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits)
+void Galileo_Inav_Message::read_page_2(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits)
 {
     IOD_nav_2 = static_cast<int32_t>(read_navigation_unsigned(data_bits, IOD_NAV_2_BIT));
     DLOG(INFO) << "IOD_nav_2= " << IOD_nav_2;
@@ -657,7 +578,7 @@ void Galileo_Inav_Message::read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>&
 }
 
 
-void Galileo_Inav_Message::read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits)
+void Galileo_Inav_Message::read_page_3(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits)
 {
     IOD_nav_3 = static_cast<int32_t>(read_navigation_unsigned(data_bits, IOD_NAV_3_BIT));
     DLOG(INFO) << "IOD_nav_3= " << IOD_nav_3;
@@ -686,7 +607,7 @@ void Galileo_Inav_Message::read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>&
 }
 
 
-void Galileo_Inav_Message::read_page_4(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits)
+void Galileo_Inav_Message::read_page_4(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits)
 {
     IOD_nav_4 = static_cast<int32_t>(read_navigation_unsigned(data_bits, IOD_NAV_4_BIT));
     DLOG(INFO) << "IOD_nav_4= " << IOD_nav_4;
@@ -840,7 +761,7 @@ std::bitset<GALILEO_DATA_JK_BITS> Galileo_Inav_Message::regenerate_page_4(const
 int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
 {
     const std::string data_jk_string = data_jk;
-    const std::bitset<GALILEO_DATA_JK_BITS> data_jk_bits(data_jk_string);
+    const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS> data_jk_bits(data_jk_string);
 
     const auto page_number = static_cast<int32_t>(read_navigation_unsigned(data_jk_bits, PAGE_TYPE_BIT));
     DLOG(INFO) << "Page number = " << page_number;
@@ -866,14 +787,14 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                             }
 
                         // Store RS information vector C_{RS,0}
-                        std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{1, 6}, {15, 2}});
+                        Gnss_Nav_Field info_octet_bits({1, 6}, {15, 2});
                         rs_buffer[0] = read_octet_unsigned(data_jk_bits, info_octet_bits);
-                        info_octet_bits = std::vector<std::pair<int32_t, int32_t>>({{7, BITS_IN_OCTET}});
+                        info_octet_bits = Gnss_Nav_Field({7, BITS_IN_OCTET});
                         rs_buffer[1] = read_octet_unsigned(data_jk_bits, info_octet_bits);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 2; i < 16; i++)
                             {
-                                info_octet_bits = std::vector<std::pair<int32_t, int32_t>>({{start_bit, BITS_IN_OCTET}});
+                                info_octet_bits = Gnss_Nav_Field({start_bit, BITS_IN_OCTET});
                                 rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -906,7 +827,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 16; i < 30; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
+                                Gnss_Nav_Field info_octet_bits({start_bit, BITS_IN_OCTET});
                                 rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -937,7 +858,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 30; i < 44; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
+                                Gnss_Nav_Field info_octet_bits({start_bit, BITS_IN_OCTET});
                                 rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -969,7 +890,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 44; i < INAV_RS_INFO_VECTOR_LENGTH; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
+                                Gnss_Nav_Field info_octet_bits({start_bit, BITS_IN_OCTET});
                                 rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -1252,12 +1173,12 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,0}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
+                        Gnss_Nav_Field gamma_octet_bits({FIRST_RS_BIT, BITS_IN_OCTET});
                         rs_buffer[INAV_RS_INFO_VECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 1; i < INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
+                                gamma_octet_bits = Gnss_Nav_Field({start_bit, BITS_IN_OCTET});
                                 rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -1281,12 +1202,12 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,1}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
+                        Gnss_Nav_Field gamma_octet_bits({FIRST_RS_BIT, BITS_IN_OCTET});
                         rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = INAV_RS_SUBVECTOR_LENGTH + 1; i < 2 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
+                                gamma_octet_bits = Gnss_Nav_Field({start_bit, BITS_IN_OCTET});
                                 rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -1310,12 +1231,12 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,2}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
+                        Gnss_Nav_Field gamma_octet_bits({FIRST_RS_BIT, BITS_IN_OCTET});
                         rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 2 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 2 * INAV_RS_SUBVECTOR_LENGTH + 1; i < 3 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
+                                gamma_octet_bits = Gnss_Nav_Field({start_bit, BITS_IN_OCTET});
                                 rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -1339,12 +1260,12 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,4}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
+                        Gnss_Nav_Field gamma_octet_bits({FIRST_RS_BIT, BITS_IN_OCTET});
                         rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 3 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 3 * INAV_RS_SUBVECTOR_LENGTH + 1; i < 4 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
+                                gamma_octet_bits = Gnss_Nav_Field({start_bit, BITS_IN_OCTET});
                                 rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
                                 start_bit += BITS_IN_OCTET;
                             }
@@ -222,15 +222,15 @@ public:
 
 private:
     bool CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>& bits, uint32_t checksum) const;
-    bool read_navigation_bool(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_navigation_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint8_t read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    void read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_4(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
+    bool read_navigation_bool(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    uint64_t read_page_type_unsigned(const Gnss_Nav_Bits<GALILEO_PAGE_TYPE_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    uint8_t read_octet_unsigned(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    void read_page_1(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_2(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_3(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_4(const Gnss_Nav_Bits<GALILEO_DATA_JK_BITS>& data_bits);
     std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_1(const std::vector<uint8_t>& decoded) const;
     std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_2(const std::vector<uint8_t>& decoded) const;
     std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_3(const std::vector<uint8_t>& decoded) const;
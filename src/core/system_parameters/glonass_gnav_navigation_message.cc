@@ -133,67 +133,21 @@ bool Glonass_Gnav_Navigation_Message::CRC_test(const std::bitset<GLONASS_GNAV_ST
 }
 
 
-bool Glonass_Gnav_Navigation_Message::read_navigation_bool(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+bool Glonass_Gnav_Navigation_Message::read_navigation_bool(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    bool value;
-
-    if (bits[GLONASS_GNAV_STRING_BITS - parameter[0].first] == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
-uint64_t Glonass_Gnav_Navigation_Message::read_navigation_unsigned(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint64_t Glonass_Gnav_Navigation_Message::read_navigation_unsigned(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1ULL;  // shift left
-                    if (bits[GLONASS_GNAV_STRING_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1ULL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-int64_t Glonass_Gnav_Navigation_Message::read_navigation_signed(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+int64_t Glonass_Gnav_Navigation_Message::read_navigation_signed(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    int64_t value = 0LL;
-    int64_t sign = 0LL;
-    const int32_t num_of_slices = parameter.size();
-    // read the MSB and perform the sign extension
-    if (bits[GLONASS_GNAV_STRING_BITS - parameter[0].first] == 1)
-        {
-            sign = -1LL;
-        }
-    else
-        {
-            sign = 1LL;
-        }
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 1; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (bits[GLONASS_GNAV_STRING_BITS - parameter[i].first - j] == 1)
-                        {
-                            value += 1LL;  // insert the bit
-                        }
-                }
-        }
-    return (sign * value);
+    return bits.read_sign_magnitude(parameter);
 }
 
 
@@ -237,10 +191,11 @@ int32_t Glonass_Gnav_Navigation_Message::string_decoder(const std::string& frame
     d_frame_ID = 0U;
 
     // Unpack bytes to bits
-    const std::bitset<GLONASS_GNAV_STRING_BITS> string_bits(frame_string);
+    const std::bitset<GLONASS_GNAV_STRING_BITS> crc_bits(frame_string);
+    const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS> string_bits(frame_string);
 
     // Perform data verification and exit code if error in bit sequence
-    flag_CRC_test = CRC_test(string_bits);
+    flag_CRC_test = CRC_test(crc_bits);
     if (flag_CRC_test == false)
         {
             return 0;
@@ -29,7 +29,6 @@
 #include <cstdint>
 #include <map>
 #include <string>
-#include <utility>  // for pair
 #include <vector>   // for vector
 
 /** \addtogroup Core
@@ -170,9 +169,9 @@ public:
     }
 
 private:
-    uint64_t read_navigation_unsigned(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    bool read_navigation_bool(const std::bitset<GLONASS_GNAV_STRING_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    bool read_navigation_bool(const Gnss_Nav_Bits<GLONASS_GNAV_STRING_BITS>& bits, const Gnss_Nav_Field& parameter) const;
 
     Glonass_Gnav_Ephemeris gnav_ephemeris{};                   // Ephemeris information decoded
     Glonass_Gnav_Utc_Model gnav_utc_model{};                   // UTC model information
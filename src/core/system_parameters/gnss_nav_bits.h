@@ -0,0 +1,217 @@
+/*!
+ * \file gnss_nav_bits.h
+ * \brief Navigation message frames packed in 64-bit words, and compile-time
+ * descriptors of their fields
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_NAV_BITS_H
+#define GNSS_SDR_GNSS_NAV_BITS_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Consecutive bits of a field: position of its first (most
+ * significant) bit in the frame, counted from 1 as in the ICDs, and number
+ * of bits
+ */
+struct Gnss_Nav_Field_Slice
+{
+    int32_t first;
+    int32_t length;
+};
+
+
+/*!
+ * \brief Position of a field in a navigation frame, made of up to four
+ * slices that are concatenated most significant first. Literal type, so
+ * the field tables of the ICDs are built at compile time, e.g.
+ * constexpr Gnss_Nav_Field D1_SOW({19, 8}, {31, 12});
+ */
+class Gnss_Nav_Field
+{
+public:
+    constexpr Gnss_Nav_Field(Gnss_Nav_Field_Slice s0,
+        Gnss_Nav_Field_Slice s1 = {0, 0},
+        Gnss_Nav_Field_Slice s2 = {0, 0},
+        Gnss_Nav_Field_Slice s3 = {0, 0})
+        : d_slices{s0, s1, s2, s3},
+          d_num_slices(1 + (s1.length > 0 ? 1 : 0) + (s2.length > 0 ? 1 : 0) + (s3.length > 0 ? 1 : 0))
+    {
+    }
+
+    constexpr int32_t num_slices() const { return d_num_slices; }
+
+    constexpr Gnss_Nav_Field_Slice slice(int32_t i) const { return d_slices[i]; }
+
+    //! Total number of bits
+    constexpr int32_t length() const
+    {
+        return d_slices[0].length + d_slices[1].length + d_slices[2].length + d_slices[3].length;
+    }
+
+private:
+    Gnss_Nav_Field_Slice d_slices[4];
+    int32_t d_num_slices;
+};
+
+
+/*!
+ * \brief A frame of N bits, stored most significant bit first in 64-bit
+ * words, from which fields are read with a shift and a mask per slice
+ * instead of bit by bit. Bit positions are counted from 1, so position p is
+ * the p-th character of the bit string of the frame, and bit N - p of a
+ * std::bitset<N> built from that string.
+ */
+template <size_t N>
+class Gnss_Nav_Bits
+{
+public:
+    Gnss_Nav_Bits() = default;
+
+    /*!
+     * \brief From a string of '0' and '1' characters. As with std::bitset, a
+     * string shorter than N fills the last positions.
+     */
+    explicit Gnss_Nav_Bits(const std::string& bits)
+    {
+        const size_t length = bits.size() < N ? bits.size() : N;
+        const size_t offset = N - length;
+        for (size_t k = 0; k < length; k++)
+            {
+                if (bits[k] == '1')
+                    {
+                        const size_t p = offset + k;
+                        d_words[p >> 6U] |= uint64_t(1) << (63U - (p & 63U));
+                    }
+            }
+    }
+
+    explicit Gnss_Nav_Bits(const std::bitset<N>& bits)
+    {
+        for (size_t p = 0; p < N; p++)
+            {
+                if (bits[N - 1 - p])
+                    {
+                        d_words[p >> 6U] |= uint64_t(1) << (63U - (p & 63U));
+                    }
+            }
+    }
+
+    inline bool bit(int32_t position) const
+    {
+        const auto p = static_cast<size_t>(position - 1);
+        return ((d_words[p >> 6U] >> (63U - (p & 63U))) & 1U) != 0U;
+    }
+
+    /*!
+     * \brief Writes the length (up to 64) least significant bits of value
+     * starting at position first, most significant first.
+     */
+    void set_bits(int32_t first, int32_t length, uint64_t value)
+    {
+        for (int32_t j = 0; j < length; j++)
+            {
+                const auto p = static_cast<size_t>(first - 1 + j);
+                const uint64_t mask = uint64_t(1) << (63U - (p & 63U));
+                if ((value >> (length - 1 - j)) & 1U)
+                    {
+                        d_words[p >> 6U] |= mask;
+                    }
+                else
+                    {
+                        d_words[p >> 6U] &= ~mask;
+                    }
+            }
+    }
+
+    inline bool read_bool(const Gnss_Nav_Field& field) const
+    {
+        return bit(field.slice(0).first);
+    }
+
+    uint64_t read_unsigned(const Gnss_Nav_Field& field) const
+    {
+        uint64_t value = 0;
+        for (int32_t i = 0; i < field.num_slices(); i++)
+            {
+                const Gnss_Nav_Field_Slice s = field.slice(i);
+                value = (s.length >= 64 ? 0 : (value << s.length)) | read_bits(s.first, s.length);
+            }
+        return value;
+    }
+
+    //! Two's complement field
+    int64_t read_signed(const Gnss_Nav_Field& field) const
+    {
+        uint64_t value = read_unsigned(field);
+        const int32_t length = field.length();
+        if (length > 0 and length < 64 and ((value >> (length - 1)) & 1U))
+            {
+                value |= ~uint64_t(0) << length;  // sign extension
+            }
+        return static_cast<int64_t>(value);
+    }
+
+    /*!
+     * \brief Sign and magnitude field (GLONASS): the first bit of the field
+     * is the sign, and the other bits of each slice the magnitude.
+     */
+    int64_t read_sign_magnitude(const Gnss_Nav_Field& field) const
+    {
+        uint64_t magnitude = 0;
+        for (int32_t i = 0; i < field.num_slices(); i++)
+            {
+                const Gnss_Nav_Field_Slice s = field.slice(i);
+                magnitude = (magnitude << (s.length - 1)) | read_bits(s.first + 1, s.length - 1);
+            }
+        const auto value = static_cast<int64_t>(magnitude);
+        return bit(field.slice(0).first) ? -value : value;
+    }
+
+private:
+    // Up to 64 bits starting at position first, right-aligned
+    inline uint64_t read_bits(int32_t first, int32_t length) const
+    {
+        if (length <= 0 or first < 1 or static_cast<size_t>(first - 1 + length) > N)
+            {
+                return 0;
+            }
+        const auto p = static_cast<size_t>(first - 1);
+        const uint32_t offset = p & 63U;
+        uint64_t window = d_words[p >> 6U] << offset;
+        if (offset != 0)
+            {
+                window |= d_words[(p >> 6U) + 1] >> (64U - offset);
+            }
+        return window >> (64 - length);
+    }
+
+    // One word more than required, so that reads never cross the end
+    std::array<uint64_t, (N + 63) / 64 + 1> d_words{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_NAV_BITS_H
@@ -18,15 +18,47 @@
 #include "gnss_signal.h"
 
 
+namespace
+{
+char system_char(const Gnss_Satellite& satellite)
+{
+    const std::string system = satellite.get_system();
+    if (system == "GPS")
+        {
+            return 'G';
+        }
+    if (system == "Glonass")
+        {
+            return 'R';
+        }
+    if (system == "SBAS")
+        {
+            return 'S';
+        }
+    if (system == "Galileo")
+        {
+            return 'E';
+        }
+    if (system == "Beidou")
+        {
+            return 'C';
+        }
+    return '\0';
+}
+}  // namespace
+
+
 Gnss_Signal::Gnss_Signal(const std::string& signal_)
-    : signal(signal_)
+    : signal(signal_),
+      id('\0', signal_.c_str(), 0)
 {
 }
 
 
 Gnss_Signal::Gnss_Signal(const Gnss_Satellite& satellite_, const std::string& signal_)
     : satellite(satellite_),
-      signal(signal_)
+      signal(signal_),
+      id(system_char(satellite_), signal_.c_str(), satellite_.get_PRN())
 {
 }
 
@@ -52,14 +84,5 @@ std::ostream& operator<<(std::ostream& out, const Gnss_Signal& sig)  // output
 
 bool operator==(const Gnss_Signal& sig1, const Gnss_Signal& sig2)
 {
-    bool equal = false;
-
-    if (sig1.get_satellite() == sig2.get_satellite())
-        {
-            if (sig1.get_signal_str() == sig1.get_signal_str())
-                {
-                    equal = true;
-                }
-        }
-    return equal;
+    return sig1.id == sig2.id;
 }
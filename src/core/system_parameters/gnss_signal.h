@@ -20,6 +20,7 @@
 #define GNSS_SDR_GNSS_SIGNAL_H
 
 #include "gnss_satellite.h"
+#include "gnss_signal_id.h"
 #include <ostream>
 #include <string>
 
@@ -43,6 +44,7 @@ public:
     ~Gnss_Signal() = default;
     std::string get_signal_str() const;    //!< Get the satellite signal {"1C" for GPS L1 C/A, "2S" for GPS L2C (M), "L5" for GPS L5, "1G" for GLONASS L1 C/A, "1B" for Galileo E1B, "5X" for Galileo E5a.
     Gnss_Satellite get_satellite() const;  //!< Get the Gnss_Satellite associated to the signal
+    inline Gnss_Signal_Id get_id() const { return id; }  //!< Get the compact identifier of system, signal and PRN
 
     friend bool operator==(const Gnss_Signal& /*sig1*/, const Gnss_Signal& /*sig2*/);    //!< operator== for comparison
     friend std::ostream& operator<<(std::ostream& /*out*/, const Gnss_Signal& /*sig*/);  //!< operator<< for pretty printing
@@ -50,6 +52,7 @@ public:
 private:
     Gnss_Satellite satellite{};
     std::string signal{};
+    Gnss_Signal_Id id{};
 };
 
 
@@ -0,0 +1,187 @@
+/*!
+ * \file gnss_signal_id.h
+ * \brief Compact identifier of a GNSS signal of a satellite, packed in 16 bits
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_ID_H
+#define GNSS_SDR_GNSS_SIGNAL_ID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Signals of the receiver, identified by their two-character code
+ * ("1C", "2S", "L5", "1B", "5X", "7X", "E6", "1G", "2G", "B1" and "B3")
+ */
+enum class Gnss_Signal_Code : uint8_t
+{
+    UNKNOWN = 0,
+    SIG_1C,
+    SIG_2S,
+    SIG_L5,
+    SIG_1B,
+    SIG_5X,
+    SIG_7X,
+    SIG_E6,
+    SIG_1G,
+    SIG_2G,
+    SIG_B1,
+    SIG_B3
+};
+
+
+namespace gnss_signal_id_detail
+{
+struct Signal_Code_Entry
+{
+    char c0;
+    char c1;
+    Gnss_Signal_Code code;
+};
+
+// (c0 * 12 + c1) % 15 is a perfect hash of the eleven signal codes, so a
+// code is found with one table access and one comparison
+constexpr Signal_Code_Entry SIGNAL_CODE_TABLE[15] = {
+    {'\0', '\0', Gnss_Signal_Code::UNKNOWN},
+    {'B', '1', Gnss_Signal_Code::SIG_B1},
+    {'\0', '\0', Gnss_Signal_Code::UNKNOWN},
+    {'B', '3', Gnss_Signal_Code::SIG_B3},
+    {'5', 'X', Gnss_Signal_Code::SIG_5X},
+    {'L', '5', Gnss_Signal_Code::SIG_L5},
+    {'\0', '\0', Gnss_Signal_Code::UNKNOWN},
+    {'\0', '\0', Gnss_Signal_Code::UNKNOWN},
+    {'2', 'S', Gnss_Signal_Code::SIG_2S},
+    {'1', 'B', Gnss_Signal_Code::SIG_1B},
+    {'1', 'C', Gnss_Signal_Code::SIG_1C},
+    {'2', 'G', Gnss_Signal_Code::SIG_2G},
+    {'E', '6', Gnss_Signal_Code::SIG_E6},
+    {'7', 'X', Gnss_Signal_Code::SIG_7X},
+    {'1', 'G', Gnss_Signal_Code::SIG_1G}};
+
+constexpr uint32_t signal_code_hash(char c0, char c1)
+{
+    return (static_cast<uint32_t>(static_cast<unsigned char>(c0)) * 12U + static_cast<uint32_t>(static_cast<unsigned char>(c1))) % 15U;
+}
+
+constexpr Gnss_Signal_Code signal_code_lookup(const Signal_Code_Entry& entry, char c0, char c1)
+{
+    return (entry.c0 == c0 && entry.c1 == c1) ? entry.code : Gnss_Signal_Code::UNKNOWN;
+}
+
+constexpr uint16_t system_bits(char system)
+{
+    return system == 'G' ? 1U : system == 'R' ? 2U : system == 'S' ? 3U : system == 'E' ? 4U : system == 'C' ? 5U : 0U;
+}
+}  // namespace gnss_signal_id_detail
+
+
+/*!
+ * \brief Returns the signal of a two-character code, or
+ * Gnss_Signal_Code::UNKNOWN. Usable at compile time.
+ */
+constexpr Gnss_Signal_Code gnss_signal_code(char c0, char c1)
+{
+    return gnss_signal_id_detail::signal_code_lookup(
+        gnss_signal_id_detail::SIGNAL_CODE_TABLE[gnss_signal_id_detail::signal_code_hash(c0, c1)], c0, c1);
+}
+
+
+/*!
+ * \brief Returns the signal of a null-terminated code such as the Signal
+ * field of Gnss_Synchro, or Gnss_Signal_Code::UNKNOWN.
+ */
+constexpr Gnss_Signal_Code gnss_signal_code(const char* signal)
+{
+    return signal[0] == '\0' ? Gnss_Signal_Code::UNKNOWN : gnss_signal_code(signal[0], signal[1]);
+}
+
+
+/*!
+ * \brief Identifier of a signal of a satellite packed in 16 bits: system
+ * (bits 15 to 13), signal code (bits 12 to 9) and PRN (bits 7 to 0). It is
+ * compared, hashed and used as a map key as an integer, instead of
+ * comparing the system and signal strings of Gnss_Satellite and
+ * Gnss_Signal.
+ */
+class Gnss_Signal_Id
+{
+public:
+    constexpr Gnss_Signal_Id() = default;
+
+    /*!
+     * \brief From the system ('G', 'R', 'S', 'E' or 'C'), the signal code
+     * and the PRN (up to 255)
+     */
+    constexpr Gnss_Signal_Id(char system, Gnss_Signal_Code code, uint32_t prn)
+        : d_id(static_cast<uint16_t>((gnss_signal_id_detail::system_bits(system) << 13U) | (static_cast<uint16_t>(code) << 9U) | (prn & 0xFFU)))
+    {
+    }
+
+    constexpr Gnss_Signal_Id(char system, const char* signal, uint32_t prn)
+        : Gnss_Signal_Id(system, gnss_signal_code(signal), prn)
+    {
+    }
+
+    constexpr uint16_t raw() const { return d_id; }
+
+    constexpr char system() const
+    {
+        return "\0GRSEC\0\0"[d_id >> 13U];
+    }
+
+    constexpr Gnss_Signal_Code code() const
+    {
+        return static_cast<Gnss_Signal_Code>((d_id >> 9U) & 0xFU);
+    }
+
+    constexpr uint32_t prn() const { return d_id & 0xFFU; }
+
+    //! The same signal with PRN 0, to key data per signal instead of per satellite
+    constexpr Gnss_Signal_Id signal() const
+    {
+        return Gnss_Signal_Id(static_cast<uint16_t>(d_id & 0xFF00U));
+    }
+
+    friend constexpr bool operator==(const Gnss_Signal_Id& a, const Gnss_Signal_Id& b) { return a.d_id == b.d_id; }
+    friend constexpr bool operator!=(const Gnss_Signal_Id& a, const Gnss_Signal_Id& b) { return a.d_id != b.d_id; }
+    friend constexpr bool operator<(const Gnss_Signal_Id& a, const Gnss_Signal_Id& b) { return a.d_id < b.d_id; }
+
+private:
+    explicit constexpr Gnss_Signal_Id(uint16_t raw) : d_id(raw) {}
+    uint16_t d_id{0};
+};
+
+
+namespace std
+{
+template <>
+struct hash<Gnss_Signal_Id>
+{
+    size_t operator()(const Gnss_Signal_Id& id) const noexcept
+    {
+        return id.raw();
+    }
+};
+}  // namespace std
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SIGNAL_ID_H
@@ -0,0 +1,143 @@
+/*!
+ * \file gnss_tracking_record.h
+ * \brief Compact record sent by the tracking blocks to the telemetry decoders
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_TRACKING_RECORD_H
+#define GNSS_SDR_GNSS_TRACKING_RECORD_H
+
+#include "gnss_synchro.h"
+#include <cstddef>
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Compact version of Gnss_Synchro, with only the fields that the
+ * tracking blocks fill in, sent from tracking to the telemetry decoder when
+ * GNSS-SDR.compact_tracking_records=true.
+ *
+ * It takes 64 bytes instead of the 152 bytes of a Gnss_Synchro. The
+ * telemetry decoder rebuilds the Gnss_Synchro, so everything downstream is
+ * unchanged, except that the acquisition fields are left empty.
+ */
+class Gnss_Tracking_Record
+{
+public:
+    Gnss_Tracking_Record() = default;
+
+    //! Takes the tracking fields of a Gnss_Synchro
+    explicit Gnss_Tracking_Record(const Gnss_Synchro& synchro)
+        : Tracking_sample_counter(synchro.Tracking_sample_counter),
+          fs(synchro.fs),
+          Carrier_phase_rads(synchro.Carrier_phase_rads),
+          Code_phase_samples(synchro.Code_phase_samples),
+          Carrier_Doppler_hz(synchro.Carrier_Doppler_hz),
+          Prompt_I(static_cast<float>(synchro.Prompt_I)),
+          Prompt_Q(static_cast<float>(synchro.Prompt_Q)),
+          CN0_dB_hz(static_cast<float>(synchro.CN0_dB_hz)),
+          Channel_ID(synchro.Channel_ID),
+          PRN(static_cast<uint16_t>(synchro.PRN)),
+          correlation_length_ms(static_cast<uint8_t>(synchro.correlation_length_ms)),
+          Flags(static_cast<uint8_t>((synchro.Flag_valid_acquisition ? FLAG_VALID_ACQUISITION : 0) |
+                                     (synchro.Flag_valid_symbol_output ? FLAG_VALID_SYMBOL_OUTPUT : 0) |
+                                     (synchro.Flag_PLL_180_deg_phase_locked ? FLAG_PLL_180_DEG_PHASE_LOCKED : 0))),
+          System(synchro.System),
+          Signal{synchro.Signal[0], synchro.Signal[1]}
+    {
+    }
+
+    //! Rebuilds a Gnss_Synchro
+    Gnss_Synchro to_gnss_synchro() const
+    {
+        Gnss_Synchro synchro{};
+        synchro.System = System;
+        synchro.Signal[0] = Signal[0];
+        synchro.Signal[1] = Signal[1];
+        synchro.PRN = PRN;
+        synchro.Channel_ID = Channel_ID;
+        synchro.fs = fs;
+        synchro.Prompt_I = static_cast<double>(Prompt_I);
+        synchro.Prompt_Q = static_cast<double>(Prompt_Q);
+        synchro.CN0_dB_hz = static_cast<double>(CN0_dB_hz);
+        synchro.Carrier_Doppler_hz = Carrier_Doppler_hz;
+        synchro.Carrier_phase_rads = Carrier_phase_rads;
+        synchro.Code_phase_samples = Code_phase_samples;
+        synchro.Tracking_sample_counter = Tracking_sample_counter;
+        synchro.correlation_length_ms = correlation_length_ms;
+        synchro.Flag_valid_acquisition = (Flags & FLAG_VALID_ACQUISITION) != 0;
+        synchro.Flag_valid_symbol_output = (Flags & FLAG_VALID_SYMBOL_OUTPUT) != 0;
+        synchro.Flag_PLL_180_deg_phase_locked = (Flags & FLAG_PLL_180_DEG_PHASE_LOCKED) != 0;
+        return synchro;
+    }
+
+    static constexpr uint8_t FLAG_VALID_ACQUISITION = 0x01;
+    static constexpr uint8_t FLAG_VALID_SYMBOL_OUTPUT = 0x02;
+    static constexpr uint8_t FLAG_PLL_180_DEG_PHASE_LOCKED = 0x04;
+
+    uint64_t Tracking_sample_counter{};
+    int64_t fs{};
+    double Carrier_phase_rads{};
+    double Code_phase_samples{};
+    double Carrier_Doppler_hz{};
+    float Prompt_I{};
+    float Prompt_Q{};
+    float CN0_dB_hz{};
+    int32_t Channel_ID{};
+    uint16_t PRN{};
+    uint8_t correlation_length_ms{};
+    uint8_t Flags{};
+    char System{};
+    char Signal[2]{};
+};
+
+
+//! Size of the items sent from tracking to the telemetry decoder
+inline size_t tracking_item_size(bool compact)
+{
+    return compact ? sizeof(Gnss_Tracking_Record) : sizeof(Gnss_Synchro);
+}
+
+
+//! Reads the n-th item of a tracking output stream
+inline Gnss_Synchro read_tracking_item(const void* items, size_t n, bool compact)
+{
+    if (compact)
+        {
+            return static_cast<const Gnss_Tracking_Record*>(items)[n].to_gnss_synchro();
+        }
+    return static_cast<const Gnss_Synchro*>(items)[n];
+}
+
+
+//! Writes the n-th item of a tracking output stream
+inline void write_tracking_item(void* items, size_t n, bool compact, const Gnss_Synchro& synchro)
+{
+    if (compact)
+        {
+            static_cast<Gnss_Tracking_Record*>(items)[n] = Gnss_Tracking_Record(synchro);
+        }
+    else
+        {
+            static_cast<Gnss_Synchro*>(items)[n] = synchro;
+        }
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_TRACKING_RECORD_H
@@ -19,6 +19,7 @@
 
 #include "gps_navigation_message.h"
 #include "gnss_satellite.h"
+#include <bitset>
 #include <cmath>     // for fmod, abs, floor
 #include <cstring>   // for memcpy
 #include <iostream>  // for operator<<, cout
@@ -46,69 +47,21 @@ void Gps_Navigation_Message::print_gps_word_bytes(uint32_t GPS_word) const
 }
 
 
-bool Gps_Navigation_Message::read_navigation_bool(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+bool Gps_Navigation_Message::read_navigation_bool(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    bool value;
-
-    if (static_cast<int>(bits[GPS_SUBFRAME_BITS - parameter[0].first]) == 1)
-        {
-            value = true;
-        }
-    else
-        {
-            value = false;
-        }
-    return value;
+    return bits.read_bool(parameter);
 }
 
 
-uint64_t Gps_Navigation_Message::read_navigation_unsigned(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+uint64_t Gps_Navigation_Message::read_navigation_unsigned(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    uint64_t value = 0ULL;
-    const int32_t num_of_slices = parameter.size();
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value <<= 1;  // shift left
-                    if (static_cast<int>(bits[GPS_SUBFRAME_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1ULL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_unsigned(parameter);
 }
 
 
-int64_t Gps_Navigation_Message::read_navigation_signed(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
+int64_t Gps_Navigation_Message::read_navigation_signed(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const
 {
-    int64_t value = 0LL;
-    const int32_t num_of_slices = parameter.size();
-
-    // read the MSB and perform the sign extension
-    if (static_cast<int>(bits[GPS_SUBFRAME_BITS - parameter[0].first]) == 1)
-        {
-            value ^= 0xFFFFFFFFFFFFFFFFLL;  // 64 bits variable
-        }
-    else
-        {
-            value &= 0LL;
-        }
-
-    for (int32_t i = 0; i < num_of_slices; i++)
-        {
-            for (int32_t j = 0; j < parameter[i].second; j++)
-                {
-                    value *= 2;                     // shift left the signed integer
-                    value &= 0xFFFFFFFFFFFFFFFELL;  // reset the corresponding bit (for the 64 bits variable)
-                    if (static_cast<int>(bits[GPS_SUBFRAME_BITS - parameter[i].first - j]) == 1)
-                        {
-                            value += 1LL;  // insert the bit
-                        }
-                }
-        }
-    return value;
+    return bits.read_signed(parameter);
 }
 
 
@@ -117,16 +70,11 @@ int32_t Gps_Navigation_Message::subframe_decoder(char* subframe)
     uint32_t gps_word;
 
     // UNPACK BYTES TO BITS AND REMOVE THE CRC REDUNDANCE
-    std::bitset<GPS_SUBFRAME_BITS> subframe_bits;
-    std::bitset<GPS_WORD_BITS + 2> word_bits;
+    Gnss_Nav_Bits<GPS_SUBFRAME_BITS> subframe_bits;
     for (int32_t i = 0; i < 10; i++)
         {
             memcpy(&gps_word, &subframe[i * 4], sizeof(char) * 4);
-            word_bits = std::bitset<(GPS_WORD_BITS + 2)>(gps_word);
-            for (int32_t j = 0; j < GPS_WORD_BITS; j++)
-                {
-                    subframe_bits[GPS_WORD_BITS * (9 - i) + j] = word_bits[j];
-                }
+            subframe_bits.set_bits(GPS_WORD_BITS * i + 1, GPS_WORD_BITS, gps_word & 0x3FFFFFFFU);
         }
 
     const auto subframe_ID = static_cast<int32_t>(read_navigation_unsigned(subframe_bits, SUBFRAME_ID));
@@ -24,12 +24,9 @@
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
-#include <bitset>
 #include <cstdint>
 #include <map>
 #include <string>
-#include <utility>  // for pair
-#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -135,9 +132,9 @@ public:
     bool satellite_validation();
 
 private:
-    uint64_t read_navigation_unsigned(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    bool read_navigation_bool(const std::bitset<GPS_SUBFRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const;
+    bool read_navigation_bool(const Gnss_Nav_Bits<GPS_SUBFRAME_BITS>& bits, const Gnss_Nav_Field& parameter) const;
     void print_gps_word_bytes(uint32_t GPS_word) const;
 
     std::map<int32_t, int32_t> almanacHealth;  //!< Map that stores the health information stored in the almanac
@@ -16,6 +16,7 @@
  */
 
 #include "reed_solomon.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
 #include <cstring>
 #include <iostream>
@@ -479,6 +480,7 @@ ReedSolomon::ReedSolomon(const std::string& gnss_signal)
 
     d_a0 = static_cast<uint8_t>(d_symbols_per_block);
     d_genpoly_index = std::vector<uint8_t>(d_nroots + 1);
+    d_root_products = std::vector<uint8_t>(8 * d_nroots);
 
     init_log_tables();
     init_alpha_tables();
@@ -568,6 +570,7 @@ ReedSolomon::ReedSolomon(int nroots,
         }
 
     d_genpoly_index = std::vector<uint8_t>(d_nroots + 1);
+    d_root_products = std::vector<uint8_t>(8 * d_nroots);
 
     init_log_tables();
     init_alpha_tables();
@@ -635,6 +638,13 @@ uint8_t ReedSolomon::galois_mul_table(uint8_t a, uint8_t b) const
 }
 
 
+uint8_t ReedSolomon::galois_inv_table(uint8_t a) const
+{
+    // a must not be zero
+    return d_antilog[(d_symbols_per_block - d_log_table[a]) % d_symbols_per_block];
+}
+
+
 void ReedSolomon::init_log_tables()
 {
     d_log_table[0] = 0;  // dummy value
@@ -682,6 +692,17 @@ void ReedSolomon::init_alpha_tables()
         {
             d_genpoly_index[i] = d_index_of[d_genpoly_coeff[i]];
         }
+
+    // products of the roots of the generator polynomial by 1, x, ..., x^7,
+    // used for the bit-sliced syndrome computation
+    for (int i = 0; i < d_nroots; i++)
+        {
+            const int root_index = mod255((d_fcr + i) * d_prim);
+            for (int b = 0; b < d_symsize; b++)
+                {
+                    d_root_products[b * d_nroots + i] = d_alpha_to[mod255(root_index + b)];
+                }
+        }
 }
 
 
@@ -738,6 +759,101 @@ std::vector<uint8_t> ReedSolomon::encode_with_generator_poly(const std::vector<u
 }
 
 
+bool ReedSolomon::get_erasure_decoding_matrix(const std::vector<int>& received_positions,
+    std::vector<uint8_t>& decoding_matrix) const
+{
+    const size_t k = received_positions.size();
+    if (d_rows_G == 0 || k == 0 || k > d_columns_G)
+        {
+            return false;
+        }
+
+    // Gauss-Jordan elimination of [A | I], A being the rows of G at the
+    // received positions restricted to the first k columns
+    std::vector<uint8_t> a(k * k);
+    decoding_matrix.assign(k * k, 0);
+    for (size_t i = 0; i < k; i++)
+        {
+            const int position = received_positions[i];
+            if (position < 0 || static_cast<size_t>(position) >= d_rows_G)
+                {
+                    return false;
+                }
+            std::copy(d_genmatrix[position].begin(), d_genmatrix[position].begin() + k, a.begin() + i * k);
+            decoding_matrix[i * k + i] = 1;
+        }
+
+    for (size_t col = 0; col < k; col++)
+        {
+            size_t pivot = col;
+            while (pivot < k && a[pivot * k + col] == 0)
+                {
+                    pivot++;
+                }
+            if (pivot == k)
+                {
+                    return false;  // singular
+                }
+            if (pivot != col)
+                {
+                    std::swap_ranges(a.begin() + pivot * k, a.begin() + (pivot + 1) * k, a.begin() + col * k);
+                    std::swap_ranges(decoding_matrix.begin() + pivot * k, decoding_matrix.begin() + (pivot + 1) * k, decoding_matrix.begin() + col * k);
+                }
+            const uint8_t inv = galois_inv_table(a[col * k + col]);
+            for (size_t j = 0; j < k; j++)
+                {
+                    a[col * k + j] = galois_mul_table(a[col * k + j], inv);
+                    decoding_matrix[col * k + j] = galois_mul_table(decoding_matrix[col * k + j], inv);
+                }
+            for (size_t row = 0; row < k; row++)
+                {
+                    const uint8_t factor = a[row * k + col];
+                    if (row == col || factor == 0)
+                        {
+                            continue;
+                        }
+                    for (size_t j = 0; j < k; j++)
+                        {
+                            a[row * k + j] ^= galois_mul_table(factor, a[col * k + j]);
+                            decoding_matrix[row * k + j] ^= galois_mul_table(factor, decoding_matrix[col * k + j]);
+                        }
+                }
+        }
+    return true;
+}
+
+
+void ReedSolomon::decode_with_erasure_matrix(const std::vector<uint8_t>& decoding_matrix,
+    const std::vector<const uint8_t*>& received,
+    size_t n,
+    std::vector<std::vector<uint8_t>>& decoded) const
+{
+    const size_t k = received.size();
+    for (size_t i = 0; i < k; i++)
+        {
+            uint8_t* out = decoded[i].data();
+            std::fill(out, out + n, 0);
+            for (size_t j = 0; j < k; j++)
+                {
+                    const uint8_t coefficient = decoding_matrix[i * k + j];
+                    if (coefficient == 0)
+                        {
+                            continue;
+                        }
+                    const int log_coefficient = d_log_table[coefficient];
+                    const uint8_t* in = received[j];
+                    for (size_t col = 0; col < n; col++)
+                        {
+                            if (in[col] != 0)
+                                {
+                                    out[col] ^= d_antilog[(log_coefficient + d_log_table[in[col]]) % d_symbols_per_block];
+                                }
+                        }
+                }
+        }
+}
+
+
 void ReedSolomon::encode_rs_8(const uint8_t* data, uint8_t* parity) const
 {
     int i;
@@ -839,25 +955,7 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
 
     // Syndrome computation
     // form the syndromes; i.e., evaluate data(x) at roots of g(x)
-    for (i = 0; i < d_nroots; i++)
-        {
-            s[i] = data[0];
-        }
-
-    for (j = 1; j < d_symbols_per_block - d_pad; j++)
-        {
-            for (i = 0; i < d_nroots; i++)
-                {
-                    if (s[i] == 0)
-                        {
-                            s[i] = data[j];
-                        }
-                    else
-                        {
-                            s[i] = data[j] ^ d_alpha_to[mod255(d_index_of[s[i]] + (d_fcr + i) * d_prim)];
-                        }
-                }
-        }
+    volk_gnsssdr_8u_x2_rs_syndromes_8u(s.data(), data, d_root_products.data(), d_nroots, d_symbols_per_block - d_pad);
 
     // Convert syndromes to index form, checking for nonzero condition
     syn_error = 0;
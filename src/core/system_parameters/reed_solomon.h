@@ -117,6 +117,35 @@ public:
      */
     std::vector<uint8_t> encode_with_generator_poly(const std::vector<uint8_t>& data_to_encode) const;
 
+    /*!
+     * \brief Computes the matrix that recovers the first k information
+     * symbols from the k symbols received at received_positions (0-based
+     * positions in the codeword), the other information symbols being known
+     * to be zero, as in the Galileo HAS messages of k < 32 pages. It is the
+     * inverse of the k x k submatrix of the generator matrix formed by those
+     * rows and its first k columns, stored by rows in decoding_matrix.
+     *
+     * The result only depends on the erasure pattern, so it can be computed
+     * once and applied to every column with decode_with_erasure_matrix.
+     *
+     * Returns false if the generator matrix is not defined, k is larger than
+     * the number of information symbols, or the received positions do not
+     * determine the information symbols.
+     */
+    bool get_erasure_decoding_matrix(const std::vector<int>& received_positions,
+        std::vector<uint8_t>& decoding_matrix) const;
+
+    /*!
+     * \brief Multiplies the k x k decoding_matrix by the k received rows of n
+     * symbols each (received[j] points to the row received at the j-th
+     * position passed to get_erasure_decoding_matrix), writing the first k
+     * rows of decoded, which must be at least n symbols long.
+     */
+    void decode_with_erasure_matrix(const std::vector<uint8_t>& decoding_matrix,
+        const std::vector<const uint8_t*>& received,
+        size_t n,
+        std::vector<std::vector<uint8_t>>& decoded) const;
+
 private:
     static const int d_symbols_per_block = 255;  // the total number of symbols in a RS block.
     static const int d_symsize = 8;              // symbol size, in bits.
@@ -128,6 +157,7 @@ private:
     uint8_t galois_mul(uint8_t a, uint8_t b) const;
     uint8_t galois_add(uint8_t a, uint8_t b) const;
     uint8_t galois_mul_table(uint8_t a, uint8_t b) const;
+    uint8_t galois_inv_table(uint8_t a) const;
 
     void encode_rs_8(const uint8_t* data, uint8_t* parity) const;
     void init_log_tables();    // initialize d_log_table and d_antilog
@@ -141,6 +171,7 @@ private:
     std::vector<std::vector<uint8_t>> d_genmatrix;  // used for encoding
     std::vector<uint8_t> d_genpoly_coeff;           // used for encoding
     std::vector<uint8_t> d_genpoly_index;           // used for encoding
+    std::vector<uint8_t> d_root_products;           // used for decoding
 
     size_t d_data_in_block{};           // number of information symbols in a block
     size_t d_rows_G{};                  // number of rows of the generator matrix
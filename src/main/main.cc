@@ -28,9 +28,12 @@
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_thread.h"
+#include "gnss_sdr_async_log.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_flags.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"
+#include "receiver_host.h"
 #include <boost/exception/diagnostic_information.hpp>  // for diagnostic_information
 #include <boost/exception/exception.hpp>               // for exception
 #include <boost/thread/exceptions.hpp>                 // for thread_resource_error
@@ -40,7 +43,9 @@
 #include <exception>                                   // for exception
 #include <iostream>                                    // for operator<<
 #include <memory>                                      // for unique_ptr
+#include <sstream>                                     // for stringstream
 #include <string>                                      // for string
+#include <vector>                                      // for vector
 
 #if CUDA_GPU_ACCEL
 // For the CUDA runtime routines (prefixed with "cuda_")
@@ -88,6 +93,8 @@ int main(int argc, char** argv)
     std::cout << "Reset CUDA device done.\n";
 #endif
 
+    // restores the glog loggers when main returns
+    std::unique_ptr<Gnss_Sdr_Async_Logger> async_logger;
     if (GOOGLE_STRIP_LOG == 0)
         {
             google::InitGoogleLogging(argv[0]);
@@ -116,6 +123,10 @@ int main(int argc, char** argv)
                         }
                     std::cout << "Logging will be written at " << FLAGS_log_dir << '\n';
                 }
+            if (FLAGS_log_async)
+                {
+                    async_logger = Gnss_Sdr_Async_Logger::install(FLAGS_log_async_queue_size);
+                }
         }
 
     std::chrono::time_point<std::chrono::system_clock> start;
@@ -124,10 +135,30 @@ int main(int argc, char** argv)
     int return_code = 0;
     try
         {
-            auto control_thread = std::make_unique<ControlThread>();
-            // record startup time
-            start = std::chrono::system_clock::now();
-            return_code = control_thread->run();
+            if (!FLAGS_config_files.empty())
+                {
+                    // several receivers in this process, one per configuration file
+                    std::vector<std::string> config_files;
+                    std::stringstream ss(FLAGS_config_files);
+                    std::string config_file;
+                    while (std::getline(ss, config_file, ','))
+                        {
+                            if (!config_file.empty())
+                                {
+                                    config_files.push_back(config_file);
+                                }
+                        }
+                    Receiver_Host receiver_host(config_files, FLAGS_config_cache);
+                    start = std::chrono::system_clock::now();
+                    return_code = receiver_host.run();
+                }
+            else
+                {
+                    auto control_thread = std::make_unique<ControlThread>();
+                    // record startup time
+                    start = std::chrono::system_clock::now();
+                    return_code = control_thread->run();
+                }
         }
     catch (const boost::thread_resource_error& e)
         {
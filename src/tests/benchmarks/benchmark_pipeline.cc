@@ -0,0 +1,379 @@
+/*!
+ * \file benchmark_pipeline.cc
+ * \brief Benchmark of the throughput of the receiver stages (acquisition,
+ * tracking, observables and PVT) on recorded signals and observables
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "acquisition_interface.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "gnss_sdr_supl_client.h"
+#include "gnss_synchro.h"
+#include "hybrid_observables_gs.h"
+#include "in_memory_configuration.h"
+#include "obs_conf.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_rtksvr.h"
+#include "rtklib_solver.h"
+#include "tracking_interface.h"
+#include <benchmark/benchmark.h>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/sync_block.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// the bundled GPS L1 C/A capture: 2 ms at 4 Msps, PRN 1 with a code delay of
+// 524 samples and a Doppler shift of 1680 Hz
+const std::string GPS_L1_CA_SAMPLES = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+const int64_t GPS_L1_CA_SAMPLES_FS = 4000000;
+const int64_t GPS_L1_CA_SAMPLES_LENGTH = 8000;
+const double GPS_L1_CA_SAMPLES_DELAY = 524.0;
+const double GPS_L1_CA_SAMPLES_DOPPLER = 1680.0;
+
+const std::string OBS_XML = std::string(TEST_PATH) + "data/rtklib_test/obs_test1.xml";
+const std::string EPH_XML = std::string(TEST_PATH) + "data/rtklib_test/eph_GPS_L1CA_test1.xml";
+
+
+Gnss_Synchro gps_l1_ca_synchro(uint32_t prn, int channel)
+{
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.Channel_ID = channel;
+    gnss_synchro.System = 'G';
+    std::memcpy(static_cast<void*>(gnss_synchro.Signal), "1C", 3);
+    gnss_synchro.PRN = prn;
+    return gnss_synchro;
+}
+
+
+std::shared_ptr<InMemoryConfiguration> receiver_configuration()
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(GPS_L1_CA_SAMPLES_FS));
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.item_type", "gr_complex");
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", "1");
+    config->set_property("Acquisition_1C.doppler_max", "5000");
+    config->set_property("Acquisition_1C.doppler_step", "250");
+    config->set_property("Acquisition_1C.threshold", "0.001");
+    config->set_property("Acquisition_1C.max_dwells", "1");
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", "gr_complex");
+    config->set_property("Tracking_1C.pll_bw_hz", "35.0");
+    config->set_property("Tracking_1C.dll_bw_hz", "2.0");
+    // The capture is played in a loop, with a carrier phase jump at each
+    // wrap. The loss of lock checks are disabled so that all the channels
+    // keep tracking for the whole run.
+    config->set_property("Tracking_1C.max_lock_fail", "1000000000");
+    config->set_property("Tracking_1C.max_carrier_lock_fail", "1000000000");
+    return config;
+}
+
+
+/*
+ * Source of pre-computed Gnss_Synchro items, standing for the output of a
+ * tracking channel or of the receiver sample counter.
+ */
+class gnss_synchro_source : public gr::sync_block
+{
+public:
+    explicit gnss_synchro_source(std::vector<Gnss_Synchro> items)
+        : gr::sync_block("gnss_synchro_source",
+              gr::io_signature::make(0, 0, 0),
+              gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
+          d_items(std::move(items))
+    {
+    }
+
+    int work(int noutput_items, gr_vector_const_void_star& input_items __attribute__((unused)),
+        gr_vector_void_star& output_items)
+    {
+        if (d_next == d_items.size())
+            {
+                return -1;  // WORK_DONE
+            }
+        const auto n = std::min(static_cast<size_t>(noutput_items), d_items.size() - d_next);
+        std::copy_n(d_items.cbegin() + d_next, n, reinterpret_cast<Gnss_Synchro*>(output_items[0]));
+        d_next += n;
+        return static_cast<int>(n);
+    }
+
+private:
+    std::vector<Gnss_Synchro> d_items;
+    size_t d_next{0};
+};
+
+
+// One tracking output per millisecond, as from a locked GPS L1 C/A channel
+// of a satellite about 70 ms away
+std::vector<Gnss_Synchro> synthetic_tracking_output(int channel, int duration_ms)
+{
+    std::vector<Gnss_Synchro> items(duration_ms, gps_l1_ca_synchro(channel + 1, channel));
+    const double doppler_hz = 1000.0 + 100.0 * channel;
+    for (int m = 0; m < duration_ms; m++)
+        {
+            Gnss_Synchro& gs = items[m];
+            gs.fs = GPS_L1_CA_SAMPLES_FS;
+            gs.Tracking_sample_counter = static_cast<uint64_t>(m) * GPS_L1_CA_SAMPLES_FS / 1000;
+            gs.Code_phase_samples = 0.0;
+            gs.Carrier_Doppler_hz = doppler_hz;
+            gs.Carrier_phase_rads = TWO_PI * doppler_hz * m / 1000.0;
+            gs.CN0_dB_hz = 45.0;
+            gs.correlation_length_ms = 1;
+            gs.TOW_at_current_symbol_ms = 345600000 + m - 67 - channel;
+            gs.Flag_valid_acquisition = true;
+            gs.Flag_valid_symbol_output = true;
+            gs.Flag_valid_word = true;
+        }
+    return items;
+}
+
+
+// One receiver clock item per observables epoch
+std::vector<Gnss_Synchro> synthetic_sample_counter(int duration_ms, int interval_ms)
+{
+    std::vector<Gnss_Synchro> items(duration_ms / interval_ms);
+    for (size_t k = 0; k < items.size(); k++)
+        {
+            items[k].fs = GPS_L1_CA_SAMPLES_FS;
+            items[k].Tracking_sample_counter = static_cast<uint64_t>(k) * interval_ms * GPS_L1_CA_SAMPLES_FS / 1000;
+        }
+    return items;
+}
+}  // namespace
+
+
+/*
+ * Acquisition of state.range(0) PRNs on the same 1 ms of signal: one full
+ * search of the Doppler and code delay grid per PRN.
+ */
+void bm_acquisition(benchmark::State& state)
+{
+    const auto nprn = static_cast<int>(state.range(0));
+    const auto config = receiver_configuration();
+    GNSSBlockFactory factory;
+
+    for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto top_block = gr::make_top_block("Acquisition benchmark");
+            auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), GPS_L1_CA_SAMPLES.c_str(), false);
+            std::vector<Gnss_Synchro> synchros;
+            synchros.reserve(nprn);
+            std::vector<std::shared_ptr<AcquisitionInterface>> acquisitions;
+            for (int n = 0; n < nprn; n++)
+                {
+                    synchros.push_back(gps_l1_ca_synchro(n + 1, n));
+                    std::shared_ptr<GNSSBlockInterface> block = factory.GetBlock(config.get(), "Acquisition_1C", 1, 0);
+                    auto acquisition = std::dynamic_pointer_cast<AcquisitionInterface>(block);
+                    acquisition->set_channel(n);
+                    acquisition->set_gnss_synchro(&synchros.back());
+                    acquisition->connect(top_block);
+                    top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+                    acquisition->set_local_code();
+                    acquisition->set_state(1);  // start at the first sample
+                    acquisition->init();
+                    acquisitions.push_back(acquisition);
+                }
+            state.ResumeTiming();
+
+            top_block->run();
+        }
+
+    state.SetItemsProcessed(state.iterations() * GPS_L1_CA_SAMPLES_LENGTH);
+    state.counters["PRN_searches"] = benchmark::Counter(static_cast<double>(state.iterations() * nprn), benchmark::Counter::kIsRate);
+}
+
+
+/*
+ * Tracking of state.range(0) channels for one second of signal, all of them
+ * on the satellite of the capture.
+ */
+void bm_tracking(benchmark::State& state)
+{
+    const auto nchannels = static_cast<int>(state.range(0));
+    const int64_t nsamples = GPS_L1_CA_SAMPLES_FS;  // one second
+    const auto config = receiver_configuration();
+    GNSSBlockFactory factory;
+
+    for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto top_block = gr::make_top_block("Tracking benchmark");
+            auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), GPS_L1_CA_SAMPLES.c_str(), true);
+            auto head = gr::blocks::head::make(sizeof(gr_complex), nsamples);
+            top_block->connect(file_source, 0, head, 0);
+            std::vector<Gnss_Synchro> synchros(nchannels);
+            std::vector<std::shared_ptr<TrackingInterface>> trackings;
+            for (int n = 0; n < nchannels; n++)
+                {
+                    synchros[n] = gps_l1_ca_synchro(1, n);
+                    synchros[n].Acq_delay_samples = GPS_L1_CA_SAMPLES_DELAY;
+                    synchros[n].Acq_doppler_hz = GPS_L1_CA_SAMPLES_DOPPLER;
+                    synchros[n].Acq_samplestamp_samples = 0;
+                    std::shared_ptr<GNSSBlockInterface> block = factory.GetBlock(config.get(), "Tracking_1C", 1, 1);
+                    auto tracking = std::dynamic_pointer_cast<TrackingInterface>(block);
+                    tracking->set_channel(n);
+                    tracking->set_gnss_synchro(&synchros[n]);
+                    tracking->connect(top_block);
+                    top_block->connect(head, 0, tracking->get_left_block(), 0);
+                    top_block->connect(tracking->get_right_block(), 0, gr::blocks::null_sink::make(sizeof(Gnss_Synchro)), 0);
+                    tracking->start_tracking();
+                    trackings.push_back(tracking);
+                }
+            state.ResumeTiming();
+
+            top_block->run();
+        }
+
+    state.SetItemsProcessed(state.iterations() * nsamples);
+    state.counters["channel_seconds"] = benchmark::Counter(static_cast<double>(state.iterations() * nchannels), benchmark::Counter::kIsRate);
+}
+
+
+/*
+ * Observables of state.range(0) channels over ten seconds of tracking
+ * outputs, one epoch every 20 ms.
+ */
+void bm_observables(benchmark::State& state)
+{
+    const auto nchannels = static_cast<int>(state.range(0));
+    const int duration_ms = 10000;
+    Obs_Conf conf;
+    conf.nchannels_in = nchannels + 1;
+    conf.nchannels_out = nchannels;
+    conf.dump = false;
+
+    std::vector<std::vector<Gnss_Synchro>> inputs;
+    for (int n = 0; n < nchannels; n++)
+        {
+            inputs.push_back(synthetic_tracking_output(n, duration_ms));
+        }
+    const std::vector<Gnss_Synchro> clock = synthetic_sample_counter(duration_ms, static_cast<int>(conf.observable_interval_ms));
+
+    for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto top_block = gr::make_top_block("Observables benchmark");
+            auto observables = hybrid_observables_gs_make(conf);
+            for (int n = 0; n < nchannels; n++)
+                {
+                    top_block->connect(gnss_shared_ptr<gnss_synchro_source>(new gnss_synchro_source(inputs[n])), 0, observables, n);
+                    top_block->connect(observables, n, gr::blocks::null_sink::make(sizeof(Gnss_Synchro)), 0);
+                }
+            top_block->connect(gnss_shared_ptr<gnss_synchro_source>(new gnss_synchro_source(clock)), 0, observables, nchannels);
+            state.ResumeTiming();
+
+            top_block->run();
+        }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(clock.size()));
+    state.counters["epochs"] = benchmark::Counter(static_cast<double>(state.iterations() * clock.size()), benchmark::Counter::kIsRate);
+}
+
+
+/*
+ * Rtklib_Solver::get_PVT on the recorded epoch of the RTKLIB unit tests,
+ * using its first state.range(0) observables.
+ */
+void bm_pvt(benchmark::State& state)
+{
+    std::map<int, Gnss_Synchro> all_observables;
+    try
+        {
+            std::ifstream ifs(OBS_XML, std::ifstream::binary | std::ifstream::in);
+            boost::archive::xml_iarchive xml(ifs);
+            xml >> boost::serialization::make_nvp("GNSS-SDR_gnss_synchro_map", all_observables);
+        }
+    catch (const std::exception& e)
+        {
+            state.SkipWithError(("Cannot read " + OBS_XML + ": " + e.what()).c_str());
+            return;
+        }
+    std::map<int, Gnss_Synchro> observables;
+    for (const auto& obs : all_observables)
+        {
+            if (static_cast<int64_t>(observables.size()) < state.range(0))
+                {
+                    observables.insert(obs);
+                }
+        }
+
+    prcopt_t opt = PRCOPT_DEFAULT;
+    opt.mode = PMODE_SINGLE;
+    opt.navsys = SYS_GPS;
+    opt.elmin = 0.0;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    {
+        Rtklib_Solver solver(rtk, "", false, false);
+        Gnss_Sdr_Supl_Client supl_client;
+        if (!supl_client.load_ephemeris_xml(EPH_XML))
+            {
+                state.SkipWithError(("Cannot read " + EPH_XML).c_str());
+            }
+        else
+            {
+                solver.gps_ephemeris_map = supl_client.gps_ephemeris_map;
+                int64_t valid = 0;
+                for (auto _ : state)
+                    {
+                        valid += solver.get_PVT(observables, false) ? 1 : 0;
+                    }
+                state.SetItemsProcessed(state.iterations());
+                state.counters["satellites"] = static_cast<double>(observables.size());
+                state.counters["valid_ratio"] = static_cast<double>(valid) / std::max(1.0, static_cast<double>(state.iterations()));
+            }
+    }
+    rtkfree(&rtk);
+}
+
+
+BENCHMARK(bm_acquisition)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_tracking)->RangeMultiplier(2)->Range(1, 16)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_observables)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_pvt)->DenseRange(4, 10, 2)->Unit(benchmark::kMicrosecond);
+
+
+int main(int argc, char** argv)
+{
+    // the receiver blocks log through glog: to files, not to the console
+    google::InitGoogleLogging(argv[0]);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        {
+            return 1;
+        }
+    benchmark::RunSpecifiedBenchmarks();
+    google::ShutdownGoogleLogging();
+    return 0;
+}
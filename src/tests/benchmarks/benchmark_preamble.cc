@@ -1,6 +1,6 @@
 /*!
  * \file benchmark_preamble.cc
- * \brief Benchmark for preamble conversion implementations
+ * \brief Benchmark for preamble conversion and correlation implementations
  * \author Carles Fernandez-Prades, 2020. cfernandez(at)cttc.es
  *
  *
@@ -16,9 +16,13 @@
  */
 
 #include "GPS_L1_CA.h"
+#include "tlm_preamble_correlator.h"
 #include <benchmark/benchmark.h>
+#include <boost/circular_buffer.hpp>
 #include <algorithm>
 #include <array>
+#include <random>
+#include <vector>
 
 void bm_forloop(benchmark::State& state)
 {
@@ -65,6 +69,75 @@ void bm_generate(benchmark::State& state)
 }
 
 
+std::vector<float> bm_symbols()
+{
+    std::vector<float> symbols(4096);
+    std::mt19937 gen(0);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::generate(symbols.begin(), symbols.end(), [&]() { return noise(gen); });
+    return symbols;
+}
+
+
+void bm_correlation_forloop(benchmark::State& state)
+{
+    std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
+    std::generate(d_preamble_samples.begin(), d_preamble_samples.end(), [n = 0]() mutable { return (GPS_CA_PREAMBLE[n++] == '1' ? 1 : -1); });
+    const std::vector<float> symbols = bm_symbols();
+    boost::circular_buffer<float> d_symbol_history(GPS_SUBFRAME_BITS, 1.0);
+    size_t k = 0;
+    volatile int32_t res;  // Prevent the compiler from optimizing the loop away
+    while (state.KeepRunning())
+        {
+            d_symbol_history.push_back(symbols[k++ % symbols.size()]);
+            int32_t corr_value = 0;
+            for (int32_t i = 0; i < GPS_CA_PREAMBLE_LENGTH_BITS; i++)
+                {
+                    if (d_symbol_history[i] < 0.0)  // symbols clipping
+                        {
+                            corr_value -= d_preamble_samples[i];
+                        }
+                    else
+                        {
+                            corr_value += d_preamble_samples[i];
+                        }
+                }
+            res = corr_value;
+        }
+    if (res > 100)
+        {
+            // Avoid unused-but-set-variable warning
+        }
+}
+
+
+void bm_correlation_incremental(benchmark::State& state)
+{
+    std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
+    std::generate(d_preamble_samples.begin(), d_preamble_samples.end(), [n = 0]() mutable { return (GPS_CA_PREAMBLE[n++] == '1' ? 1 : -1); });
+    const std::vector<float> symbols = bm_symbols();
+    boost::circular_buffer<float> d_symbol_history(GPS_SUBFRAME_BITS, 1.0);
+    Tlm_Preamble_Correlator d_preamble_correlator;
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), GPS_CA_PREAMBLE_LENGTH_BITS);
+    d_preamble_correlator.set_capacity(GPS_SUBFRAME_BITS);
+    size_t k = 0;
+    volatile int32_t res;  // Prevent the compiler from optimizing the loop away
+    while (state.KeepRunning())
+        {
+            const float symbol = symbols[k++ % symbols.size()];
+            d_symbol_history.push_back(symbol);
+            d_preamble_correlator.push(symbol);
+            res = d_preamble_correlator.correlation();
+        }
+    if (res > 100)
+        {
+            // Avoid unused-but-set-variable warning
+        }
+}
+
+
 BENCHMARK(bm_forloop);
 BENCHMARK(bm_generate);
+BENCHMARK(bm_correlation_forloop);
+BENCHMARK(bm_correlation_incremental);
 BENCHMARK_MAIN();
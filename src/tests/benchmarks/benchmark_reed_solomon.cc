@@ -1,6 +1,6 @@
 /*!
- * \file benchmark_redd_solomon.cc
- * \brief Benchmark for Reed Solomon decoder
+ * \file benchmark_reed_solomon.cc
+ * \brief Benchmark for Reed Solomon decoder and CRC-24Q computation
  * \author Carles Fernandez-Prades, 2021. cfernandez(at)cttc.es
  *
  *
@@ -18,6 +18,9 @@
 #include "gnss_sdr_make_unique.h"  // for std::unique_ptr in C++11
 #include "reed_solomon.h"
 #include <benchmark/benchmark.h>
+#include <boost/crc.hpp>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -295,8 +298,40 @@ void bm_e6b_erasure(benchmark::State& state)
 }
 
 
+// The 196 bits protected by the CRC-24Q in a Galileo I/NAV page, left-padded
+// with zeros up to 25 bytes
+const std::vector<uint8_t> inav_crc_frame = {13, 218, 33, 192, 71, 150, 9,
+    140, 223, 93, 52, 70, 11, 241, 26, 176, 96, 63, 180, 20, 8, 231, 201, 81, 146};
+
+
+void bm_crc24q_boost(benchmark::State& state)
+{
+    volatile uint32_t crc;  // Prevent the compiler from optimizing the loop away
+    while (state.KeepRunning())
+        {
+            boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc_24q;
+            crc_24q.process_bytes(inav_crc_frame.data(), inav_crc_frame.size());
+            crc = crc_24q.checksum();
+        }
+}
+
+
+void bm_crc24q_volk(benchmark::State& state)
+{
+    volatile uint32_t crc;  // Prevent the compiler from optimizing the loop away
+    while (state.KeepRunning())
+        {
+            uint32_t crc_24q = 0;
+            volk_gnsssdr_8u_crc24q_32u(&crc_24q, inav_crc_frame.data(), inav_crc_frame.size());
+            crc = crc_24q;
+        }
+}
+
+
 BENCHMARK(bm_e1b_erasurecorrection_shortened);
 BENCHMARK(bm_e1b_erasurecorrection_unshortened);
 BENCHMARK(bm_e6b_correction);
 BENCHMARK(bm_e6b_erasure);
+BENCHMARK(bm_crc24q_boost);
+BENCHMARK(bm_crc24q_volk);
 BENCHMARK_MAIN();
@@ -35,5 +35,8 @@ DEFINE_double(precision_SEP, 15.0, "Static scenario 3D (East, North, Up) precisi
 DEFINE_double(dynamic_3D_position_RMSE, 10.0, "Dynamic scenario 3D (ECEF) accuracy RMSE threshold [meters]");
 DEFINE_double(dynamic_3D_velocity_RMSE, 5.0, "Dynamic scenario 3D (ECEF) velocity accuracy RMSE threshold [meters/second]");
 DEFINE_bool(enable_carrier_smoothing, false, "Activates carrier smoothing of pseudoranges");
+DEFINE_double(cpu_time_budget_s, 0.0, "Maximum CPU time (all threads) spent by the receiver [seconds]. 0 disables the check");
+DEFINE_double(max_ttff_s, 0.0, "Maximum wall-clock Time-To-First-Fix [seconds]. 0 disables the check");
+DEFINE_string(perf_report_json, std::string("position_test_perf.json"), "Path and filename for the JSON report of the runtime, CPU time and TTFF. Empty to disable it");
 
 #endif
@@ -17,8 +17,8 @@
 #ifndef GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
 #define GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
 
+#include "columnar_dump.h"
 #include <cstdint>
-#include <fstream>
 #include <string>
 #include <vector>
 
@@ -68,7 +68,8 @@ public:
 
 private:
     std::string d_dump_filename;
-    std::ifstream d_dump_file;
+    Columnar_Dump_Reader d_dump_file;
+    uint64_t d_record{0};
 };
 
 #endif  // GNSS_SDR_RTKLIB_SOLVER_DUMP_READER_H
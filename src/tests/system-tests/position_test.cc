@@ -43,10 +43,15 @@
 #include <matio.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <numeric>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <sys/resource.h>
 #include <thread>
 
 #if GFLAGS_OLD_NAMESPACE
@@ -62,6 +67,45 @@ DEFINE_int32(num_channels, 11, "Number of channels");
 Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
 
+namespace
+{
+// CPU time of all the threads of the process, in seconds
+double process_cpu_time_s()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+
+// Waits for the Time-To-First-Fix that the PVT block sends through its
+// System V message queue, until done is set
+void receive_ttff(const std::atomic<bool>* done, double* ttff_s)
+{
+    struct
+    {
+        long mtype;  // required by SysV message
+        double ttff;
+    } msg{};
+    const key_t key = 1101;
+    int msqid = -1;
+    while (!done->load())
+        {
+            if (msqid == -1)
+                {
+                    msqid = msgget(key, 0644);
+                }
+            if (msqid != -1 and msgrcv(msqid, &msg, sizeof(msg.ttff), 1, IPC_NOWAIT) != -1 and msg.ttff > 0.0)
+                {
+                    *ttff_s = msg.ttff;
+                    return;
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+}
+}  // namespace
+
 class PositionSystemTest : public ::testing::Test
 {
 public:
@@ -70,6 +114,7 @@ public:
     int configure_receiver();
     int run_receiver();
     void check_results();
+    void check_performance();
     bool save_mat_xy(std::vector<double>* x, std::vector<double>* y, std::string filename);
     bool save_mat_x(std::vector<double>* x, std::string filename);
     std::string config_filename_no_extension;
@@ -95,6 +140,8 @@ private:
 
     std::chrono::time_point<std::chrono::system_clock> start;
     std::chrono::time_point<std::chrono::system_clock> end;
+    double cpu_time_s = 0.0;
+    double ttff_s = -1.0;  // not obtained
 };
 
 
@@ -351,6 +398,9 @@ int PositionSystemTest::run_receiver()
             control_thread = std::make_shared<ControlThread>(config_f);
         }
 
+    std::atomic<bool> receiver_done{false};
+    std::thread ttff_thread(receive_ttff, &receiver_done, &ttff_s);
+    const double cpu_start_s = process_cpu_time_s();
     start = std::chrono::system_clock::now();
     // start receiver
     try
@@ -366,6 +416,9 @@ int PositionSystemTest::run_receiver()
             std::cout << "STD exception: " << ex.what();
         }
     end = std::chrono::system_clock::now();
+    cpu_time_s = process_cpu_time_s() - cpu_start_s;
+    receiver_done = true;
+    ttff_thread.join();
     // Get the name of the KML file generated by the receiver
     std::this_thread::sleep_for(std::chrono::milliseconds(2000));
     FILE* fp;
@@ -947,6 +1000,54 @@ void PositionSystemTest::print_results(const arma::mat& R_eb_enu) const
 }
 
 
+void PositionSystemTest::check_performance()
+{
+    const std::chrono::duration<double> elapsed_seconds = end - start;
+    const bool cpu_time_ok = FLAGS_cpu_time_budget_s <= 0.0 or cpu_time_s < FLAGS_cpu_time_budget_s;
+    const bool ttff_ok = FLAGS_max_ttff_s <= 0.0 or (ttff_s > 0.0 and ttff_s < FLAGS_max_ttff_s);
+
+    std::cout << "---- PERFORMANCE ----\n"
+              << "Receiver runtime: " << elapsed_seconds.count() << " [seconds]\n"
+              << "Receiver CPU time: " << cpu_time_s << " [seconds]\n"
+              << "Time-To-First-Fix: " << ttff_s << " [seconds]\n";
+
+    if (!FLAGS_perf_report_json.empty())
+        {
+            std::ofstream report(FLAGS_perf_report_json);
+            if (report.is_open())
+                {
+                    const std::string config_name = FLAGS_config_file_ptest.empty() ? std::string("generated") : config_filename_no_extension;
+                    report << std::setprecision(6)
+                           << "{\n"
+                           << "  \"test\": \"position_test\",\n"
+                           << "  \"config\": \"" << config_name << "\",\n"
+                           << "  \"runtime_s\": " << elapsed_seconds.count() << ",\n"
+                           << "  \"cpu_time_s\": " << cpu_time_s << ",\n"
+                           << "  \"cpu_time_budget_s\": " << FLAGS_cpu_time_budget_s << ",\n"
+                           << "  \"cpu_load\": " << (elapsed_seconds.count() > 0.0 ? cpu_time_s / elapsed_seconds.count() : 0.0) << ",\n"
+                           << "  \"ttff_s\": " << ttff_s << ",\n"
+                           << "  \"max_ttff_s\": " << FLAGS_max_ttff_s << ",\n"
+                           << "  \"passed\": " << (cpu_time_ok and ttff_ok ? "true" : "false") << "\n"
+                           << "}\n";
+                }
+            else
+                {
+                    std::cout << "Unable to write " << FLAGS_perf_report_json << '\n';
+                }
+        }
+
+    if (FLAGS_cpu_time_budget_s > 0.0)
+        {
+            EXPECT_LT(cpu_time_s, FLAGS_cpu_time_budget_s) << "CPU time budget exceeded";
+        }
+    if (FLAGS_max_ttff_s > 0.0)
+        {
+            EXPECT_GT(ttff_s, 0.0) << "No position fix";
+            EXPECT_LT(ttff_s, FLAGS_max_ttff_s) << "Time-To-First-Fix too long";
+        }
+}
+
+
 TEST_F(PositionSystemTest /*unused*/, Position_system_test /*unused*/)
 {
     if (FLAGS_config_file_ptest.empty())
@@ -974,6 +1075,9 @@ TEST_F(PositionSystemTest /*unused*/, Position_system_test /*unused*/)
 
     // Check results
     check_results();
+
+    // Check CPU time and TTFF
+    check_performance();
 }
 
 
@@ -51,16 +51,33 @@ DECLARE_string(log_dir);
 #include "unit-tests/arithmetic/conjugate_test.cc"
 #include "unit-tests/arithmetic/fft_length_test.cc"
 #include "unit-tests/arithmetic/fft_speed_test.cc"
+#include "unit-tests/arithmetic/geofunctions_test.cc"
 #include "unit-tests/arithmetic/magnitude_squared_test.cc"
 #include "unit-tests/arithmetic/multiply_test.cc"
 #include "unit-tests/arithmetic/preamble_correlator_test.cc"
+#include "unit-tests/control-plane/acquisition_record_test.cc"
+#include "unit-tests/control-plane/channel_governor_test.cc"
+#include "unit-tests/control-plane/channel_stats_test.cc"
+#include "unit-tests/control-plane/concurrent_snapshot_map_test.cc"
 #include "unit-tests/control-plane/control_thread_test.cc"
 #include "unit-tests/control-plane/file_configuration_test.cc"
 #include "unit-tests/control-plane/gnss_block_factory_test.cc"
 #include "unit-tests/control-plane/gnss_flowgraph_test.cc"
+#include "unit-tests/control-plane/gnss_signal_queue_test.cc"
 #include "unit-tests/control-plane/in_memory_configuration_test.cc"
+#include "unit-tests/control-plane/metrics_http_server_test.cc"
+#include "unit-tests/control-plane/mpsc_queue_test.cc"
 #include "unit-tests/control-plane/protobuf_test.cc"
+#include "unit-tests/control-plane/realtime_headroom_monitor_test.cc"
+#include "unit-tests/control-plane/receiver_clock_test.cc"
+#include "unit-tests/control-plane/sample_stream_udp_sink_test.cc"
+#include "unit-tests/control-plane/serdes_observables_binary_test.cc"
+#include "unit-tests/control-plane/spectrum_monitor_test.cc"
 #include "unit-tests/control-plane/string_converter_test.cc"
+#include "unit-tests/control-plane/supl_assistance_cache_test.cc"
+#include "unit-tests/control-plane/tracking_checkpoint_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_fft_code_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_sample_ring_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_8ms_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc_test.cc"
@@ -78,16 +95,40 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/acquisition/gps_l1_ca_pcps_tong_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/adapter_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/pass_through_test.cc"
+#include "unit-tests/signal-processing-blocks/adapter/agc_requantizer_test.cc"
+#include "unit-tests/signal-processing-blocks/filter/beamformer_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/fir_filter_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_lite_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/pulse_blanking_filter_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/direct_resampler_conditioner_cc_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/mmse_resampler_test.cc"
+#include "unit-tests/signal-processing-blocks/resampler/rational_resampler_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/capture_index_test.cc"
+#if ENABLE_ZSTD
+#include "unit-tests/signal-processing-blocks/sources/compressed_capture_test.cc"
+#endif
 #include "unit-tests/signal-processing-blocks/sources/file_signal_source_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/gnss_sdr_valve_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/labsat_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/mmap_file_sink_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/shm_ring_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/unpack_2bit_samples_test.cc"
 // #include "unit-tests/signal-processing-blocks/acquisition/glonass_l2_ca_pcps_acquisition_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/allocation_counter_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/fpga_code_bank_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_circular_deque_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_code_table_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_async_log_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_block_stats_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_dump_writer_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_memory_accounting_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_monitor_ring_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_stream_writer_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_thread_pool_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_time_map_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_trace_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sdr_udp_sender_test.cc"
 #include "unit-tests/signal-processing-blocks/libs/item_type_helpers_test.cc"
 
 #if OPENCL_BLOCKS_TEST
@@ -99,14 +140,19 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/cubature_filter_test.cc"
 // #include "unit-tests/signal-processing-blocks/tracking/unscented_filter_test.cc"
 #endif
+#include "unit-tests/signal-processing-blocks/tracking/cn0_estimation_window_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_altboc_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_real_codes_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/discriminator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e1_dll_pll_veml_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5a_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5b_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/glonass_fdma_channelizer_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_c_aid_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/secondary_code_sync_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tcp_loop_hub_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/tracking_loop_filter_test.cc"
 
 
@@ -120,17 +166,44 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/gps_l1_ca_dll_pll_tracking_test_fpga.cc"
 #endif
 
+#include "unit-tests/signal-processing-blocks/observables/obs_carrier_smoothing_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/obs_history_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/obs_shard_pool_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/columnar_dump_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/compact_ephemeris_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/nmea_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_observables_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_output_worker_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_solution_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_solver_engines_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_text_format_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rinex_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtcm_bit_writer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_atmoscorr_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_ephemeris_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_ephemeris_interp_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_lambda_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_matrix_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_rtkposrovers_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_sbas_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_solver_warm_start_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_time_conversions_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/serdes_monitor_pvt_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/snapshot_solver_test.cc"
 #include "unit-tests/signal-processing-blocks/telemetry_decoder/galileo_fnav_inav_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/tlm_band_coordinator_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/tlm_preamble_correlator_test.cc"
+#include "unit-tests/system-parameters/agnss_assistance_data_test.cc"
 #include "unit-tests/system-parameters/galileo_e1b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/galileo_e6b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_crc_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_ephemeris_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_nav_message_test.cc"
+#include "unit-tests/system-parameters/gnss_nav_bits_test.cc"
+#include "unit-tests/system-parameters/gnss_signal_id_test.cc"
+#include "unit-tests/system-parameters/gnss_tracking_record_test.cc"
 
 #if EXTRA_TESTS
 #include "unit-tests/signal-processing-blocks/acquisition/acq_performance_test.cc"
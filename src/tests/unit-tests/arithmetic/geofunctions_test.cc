@@ -0,0 +1,107 @@
+/*!
+ * \file geofunctions_test.cc
+ * \brief Tests the batched and fixed-size coordinate transformations against
+ * the single-point ones
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "geofunctions.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// n points in ECEF (m) at a random distance from the center of the Earth
+// between radius_min and radius_max
+void random_points(size_t n, std::vector<double>& X, std::vector<double>& Y, std::vector<double>& Z, double radius_min, double radius_max)
+{
+    std::mt19937 gen(static_cast<uint32_t>(n));
+    std::uniform_real_distribution<double> lat(-1.5, 1.5);
+    std::uniform_real_distribution<double> lon(-3.1, 3.1);
+    std::uniform_real_distribution<double> radius(radius_min, radius_max);
+    for (size_t i = 0; i < n; i++)
+        {
+            const double r = radius(gen);
+            const double phi = lat(gen);
+            const double lambda = lon(gen);
+            X.push_back(r * cos(phi) * cos(lambda));
+            Y.push_back(r * cos(phi) * sin(lambda));
+            Z.push_back(r * sin(phi));
+        }
+}
+}  // namespace
+
+
+TEST(GeofunctionsTest, BatchedCart2geo)
+{
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+    random_points(1000, X, Y, Z, 6.35e6, 6.4e6);
+    std::vector<double> lat(X.size());
+    std::vector<double> lon(X.size());
+    std::vector<double> h(X.size());
+    for (int elipsoid = 0; elipsoid < 5; elipsoid++)
+        {
+            cart2geo(X.data(), Y.data(), Z.data(), X.size(), elipsoid, lat.data(), lon.data(), h.data());
+            for (size_t i = 0; i < X.size(); i++)
+                {
+                    const arma::vec LLH = cart2geo(arma::vec{X[i], Y[i], Z[i]}, elipsoid);
+                    EXPECT_NEAR(lat[i], LLH(0), 1e-12);
+                    EXPECT_NEAR(lon[i], LLH(1), 1e-12);
+                    EXPECT_NEAR(h[i], LLH(2), 1e-6);
+                }
+        }
+}
+
+
+TEST(GeofunctionsTest, TopocentOverloads)
+{
+    const std::array<double, 3> rx{4.7e6, 0.18e6, 4.27e6};
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+    random_points(200, X, Y, Z, 2.6e7, 2.7e7);
+    // a null vector, seen at the zenith
+    X.push_back(rx[0]);
+    Y.push_back(rx[1]);
+    Z.push_back(rx[2]);
+    for (size_t i = 0; i < X.size(); i++)
+        {
+            X[i] -= rx[0];
+            Y[i] -= rx[1];
+            Z[i] -= rx[2];
+        }
+    std::vector<double> Az(X.size());
+    std::vector<double> El(X.size());
+    std::vector<double> D(X.size());
+    topocent(rx, X.data(), Y.data(), Z.data(), X.size(), Az.data(), El.data(), D.data());
+    for (size_t i = 0; i < X.size(); i++)
+        {
+            double az;
+            double el;
+            double d;
+            topocent(&az, &el, &d, arma::vec{rx[0], rx[1], rx[2]}, arma::vec{X[i], Y[i], Z[i]});
+            EXPECT_NEAR(Az[i], az, 1e-9);
+            EXPECT_NEAR(El[i], el, 1e-9);
+            EXPECT_NEAR(D[i], d, 1e-6);
+            topocent(&az, &el, &d, rx, std::array<double, 3>{X[i], Y[i], Z[i]});
+            EXPECT_DOUBLE_EQ(Az[i], az);
+            EXPECT_DOUBLE_EQ(El[i], el);
+            EXPECT_DOUBLE_EQ(D[i], d);
+        }
+    EXPECT_EQ(Az.back(), 0.0);
+    EXPECT_EQ(El.back(), 90.0);
+}
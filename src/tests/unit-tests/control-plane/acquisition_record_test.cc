@@ -0,0 +1,64 @@
+/*!
+ * \file acquisition_record_test.cc
+ * \brief This file implements tests for Gnss_Sdr_Acquisition_Record
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_acquisition_record.h"
+#include "gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+TEST(AcquisitionRecordTest, SaveAndLoad)
+{
+    const std::string filename = "./acquisition_record_test.xml";
+    {
+        Gnss_Sdr_Acquisition_Record record(filename);
+        for (uint32_t prn = 1; prn <= 3; prn++)
+            {
+                Gnss_Synchro gs{};
+                gs.System = 'G';
+                std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+                gs.PRN = prn;
+                gs.Channel_ID = static_cast<int32_t>(prn + 4);
+                gs.Acq_delay_samples = 100.25 * prn;
+                gs.Acq_doppler_hz = -1250.0 + prn;
+                gs.Acq_samplestamp_samples = 4000000ULL * prn + 17ULL;
+                gs.Acq_doppler_step = 250;
+                record.add(gs);
+            }
+        EXPECT_EQ(record.size(), 3U);
+    }  // saved at destruction
+
+    std::vector<Gnss_Synchro> acquisitions;
+    ASSERT_TRUE(Gnss_Sdr_Acquisition_Record::load(filename, acquisitions));
+    ASSERT_EQ(acquisitions.size(), 3U);
+    for (uint32_t prn = 1; prn <= 3; prn++)
+        {
+            const Gnss_Synchro& gs = acquisitions[prn - 1];
+            EXPECT_EQ(gs.System, 'G');
+            EXPECT_EQ(std::string(gs.Signal, 2), "1C");
+            EXPECT_EQ(gs.PRN, prn);
+            EXPECT_EQ(gs.Channel_ID, static_cast<int32_t>(prn + 4));
+            EXPECT_DOUBLE_EQ(gs.Acq_delay_samples, 100.25 * prn);
+            EXPECT_DOUBLE_EQ(gs.Acq_doppler_hz, -1250.0 + prn);
+            EXPECT_EQ(gs.Acq_samplestamp_samples, 4000000ULL * prn + 17ULL);
+            EXPECT_EQ(gs.Acq_doppler_step, 250U);
+        }
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE(Gnss_Sdr_Acquisition_Record::load("./non_existent_acquisition_record.xml", acquisitions));
+}
@@ -0,0 +1,91 @@
+/*!
+ * \file channel_governor_test.cc
+ * \brief Tests the choice of the tracking channels to stop under overload
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "channel_governor.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+Channel_Governor::Channel make_channel(int id, uint32_t prn, double cn0_db_hz, uint64_t work_ns = 0)
+{
+    Channel_Governor::Channel channel;
+    channel.id = id;
+    channel.system = 'G';
+    channel.prn = prn;
+    channel.cn0_db_hz = cn0_db_hz;
+    channel.work_ns = work_ns;
+    return channel;
+}
+
+
+Pvt_Satellite_Contribution make_contribution(uint32_t prn, double elevation_deg, double gdop, double gdop_without)
+{
+    Pvt_Satellite_Contribution contribution;
+    contribution.system = 'G';
+    contribution.prn = prn;
+    contribution.elevation_deg = elevation_deg;
+    contribution.gdop = gdop;
+    contribution.gdop_without = gdop_without;
+    return contribution;
+}
+}  // namespace
+
+
+TEST(ChannelGovernorTest, Utility)
+{
+    const std::vector<Pvt_Satellite_Contribution> fix = {make_contribution(1, 90.0, 2.0, 3.0), make_contribution(2, 10.0, 2.0, 2.02)};
+    EXPECT_NEAR(Channel_Governor::utility(make_channel(0, 1, 50.0), fix), 1.0, 1e-9);
+    EXPECT_NEAR(Channel_Governor::utility(make_channel(0, 3, 20.0), fix), 0.0, 1e-9);  // not in the fix
+    EXPECT_LT(Channel_Governor::utility(make_channel(0, 2, 45.0), fix), Channel_Governor::utility(make_channel(0, 1, 45.0), fix));
+    EXPECT_GT(Channel_Governor::utility(make_channel(0, 2, 45.0), fix), Channel_Governor::utility(make_channel(0, 3, 45.0), fix));
+}
+
+
+TEST(ChannelGovernorTest, KeepsTheFix)
+{
+    Channel_Governor governor;
+    const std::vector<Channel_Governor::Channel> channels = {make_channel(0, 1, 45.0), make_channel(1, 2, 46.0), make_channel(2, 3, 30.0), make_channel(3, 4, 44.0)};
+
+    // without a fix, the weakest signal goes first
+    EXPECT_EQ(governor.select_standby(channels, {}), 2);
+
+    // the weak satellite is high and improves the geometry, the strong one is low and redundant
+    const std::vector<Pvt_Satellite_Contribution> fix = {make_contribution(1, 60.0, 2.0, 2.4), make_contribution(2, 5.0, 2.0, 2.01),
+        make_contribution(3, 80.0, 2.0, 3.0), make_contribution(4, 45.0, 2.0, 2.3)};
+    EXPECT_EQ(governor.select_standby(channels, fix), 1);
+
+    // a satellite the fix cannot do without is never stopped
+    const std::vector<Pvt_Satellite_Contribution> essential = {make_contribution(1, 60.0, 2.0, 0.0), make_contribution(2, 5.0, 2.0, 0.0),
+        make_contribution(3, 80.0, 2.0, 0.0), make_contribution(4, 45.0, 2.0, 0.0)};
+    EXPECT_TRUE(Channel_Governor::is_essential(channels[1], essential));
+    EXPECT_EQ(governor.select_standby(channels, essential), -1);
+}
+
+
+TEST(ChannelGovernorTest, WeighsTheCpuTime)
+{
+    Channel_Governor governor;
+    std::vector<Channel_Governor::Channel> channels = {make_channel(0, 1, 40.0, 1000000), make_channel(1, 2, 38.0, 1000000), make_channel(2, 3, 42.0, 1000000)};
+    EXPECT_EQ(governor.select_standby(channels, {}), 1);
+
+    // the strongest channel now costs four times as much as the others
+    channels[0].work_ns += 1000000;
+    channels[1].work_ns += 1000000;
+    channels[2].work_ns += 4000000;
+    EXPECT_EQ(governor.select_standby(channels, {}), 2);
+}
@@ -0,0 +1,107 @@
+/*!
+ * \file channel_stats_test.cc
+ * \brief Tests the windowed statistics of the aggregating monitors
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "channel_stats.h"
+#include "serdes_gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// 1 ms items of a satellite with a Doppler ramp of 2 Hz/s, as the tracking blocks produce them
+Gnss_Synchro make_item(int ms, double phase_offset_rads = 0.0)
+{
+    Gnss_Synchro gs{};
+    gs.System = 'G';
+    gs.Signal[0] = '1';
+    gs.Signal[1] = 'C';
+    gs.PRN = 7;
+    gs.Channel_ID = 3;
+    gs.fs = 4000000;
+    gs.Tracking_sample_counter = static_cast<uint64_t>(ms) * 4000;
+    const double t = ms / 1000.0;
+    gs.Carrier_Doppler_hz = 1000.0 + 2.0 * t;
+    gs.Carrier_phase_rads = -TWO_PI * (1000.0 * t + t * t) + phase_offset_rads;
+    gs.CN0_dB_hz = 40.0 + (ms % 10);
+    gs.Flag_valid_symbol_output = (ms % 4) != 0;
+    return gs;
+}
+}  // namespace
+
+
+TEST(ChannelStatsTest, WindowsOfOneSecond)
+{
+    Channel_Stats_Accumulator accumulator(1.0);
+    Channel_Stats stats{};
+    std::vector<Channel_Stats> windows;
+    for (int ms = 0; ms < 3000; ms++)
+        {
+            // a jump of one cycle between two locked items
+            if (accumulator.add(make_item(ms, ms >= 1502 ? TWO_PI : 0.0), stats))
+                {
+                    windows.push_back(stats);
+                }
+        }
+    ASSERT_EQ(windows.size(), 2U);
+    EXPECT_EQ(windows[0].PRN, 7U);
+    EXPECT_EQ(windows[0].Channel_ID, 3);
+    EXPECT_EQ(std::string(windows[0].Signal), "1C");
+    EXPECT_EQ(windows[0].Items, 1000U);
+    EXPECT_EQ(windows[0].Locked_items, 750U);
+    EXPECT_DOUBLE_EQ(windows[0].Lock_ratio, 0.75);
+    EXPECT_NEAR(windows[0].Duration_s, 0.999, 1e-9);
+    EXPECT_NEAR(windows[0].CN0_mean_dB_hz, 44.5, 1e-9);
+    EXPECT_DOUBLE_EQ(windows[0].CN0_min_dB_hz, 40.0);
+    EXPECT_DOUBLE_EQ(windows[0].CN0_max_dB_hz, 49.0);
+    EXPECT_NEAR(windows[0].Doppler_rate_hz_s, 2.0, 1e-6);
+    EXPECT_EQ(windows[0].Cycle_slips, 0U);
+    EXPECT_NEAR(windows[1].Start_time_s, 1.0, 1e-12);
+    EXPECT_EQ(windows[1].Cycle_slips, 1U);
+
+    // another satellite in the channel closes the window
+    Gnss_Synchro other = make_item(3000);
+    other.PRN = 8;
+    EXPECT_TRUE(accumulator.add(other, stats));
+    EXPECT_EQ(stats.PRN, 7U);
+    EXPECT_EQ(stats.Items, 1000U);
+    EXPECT_EQ(stats.Cycle_slips, 0U);
+}
+
+
+TEST(ChannelStatsTest, Protobuf)
+{
+    Channel_Stats stats{};
+    stats.System = 'E';
+    stats.Signal[0] = '1';
+    stats.Signal[1] = 'B';
+    stats.PRN = 11;
+    stats.Items = 500;
+    stats.Lock_ratio = 0.5;
+    Serdes_Gnss_Synchro serdes;
+    std::string data;
+    serdes.createProtobuffer(std::vector<Channel_Stats>{stats}, data);
+
+    gnss_sdr::ChannelStatsList list;
+    ASSERT_TRUE(list.ParseFromString(data));
+    ASSERT_EQ(list.stats_size(), 1);
+    EXPECT_EQ(list.stats(0).system(), "E");
+    EXPECT_EQ(list.stats(0).signal(), "1B");
+    EXPECT_EQ(list.stats(0).prn(), 11U);
+    EXPECT_EQ(list.stats(0).items(), 500U);
+    EXPECT_DOUBLE_EQ(list.stats(0).lock_ratio(), 0.5);
+}
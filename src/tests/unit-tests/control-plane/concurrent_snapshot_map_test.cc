@@ -0,0 +1,83 @@
+/*!
+ * \file concurrent_snapshot_map_test.cc
+ * \brief Tests the copy-on-write map shared by the receiver threads
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_snapshot_map.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+
+TEST(ConcurrentSnapshotMapTest, SnapshotsAreImmutable)
+{
+    Concurrent_Snapshot_Map<int> map;
+    EXPECT_EQ(map.version(), 0U);
+    map.write(1, 10);
+    const auto before = map.snapshot();
+    map.write(1, 11);
+    map.write(2, 20);
+    EXPECT_EQ(map.version(), 3U);
+
+    EXPECT_EQ(before->size(), 1U);
+    EXPECT_EQ(before->at(1), 10);
+    const auto after = map.snapshot();
+    EXPECT_EQ(after->size(), 2U);
+    EXPECT_EQ(after->at(1), 11);
+
+    int value = 0;
+    EXPECT_TRUE(map.read(2, value));
+    EXPECT_EQ(value, 20);
+    map.erase(2);
+    map.erase(3);  // not there, nothing is published
+    EXPECT_EQ(map.version(), 4U);
+    EXPECT_FALSE(map.read(2, value));
+    map.clear();
+    EXPECT_TRUE(map.snapshot()->empty());
+}
+
+
+TEST(ConcurrentSnapshotMapTest, ConcurrentReaders)
+{
+    // readers only see complete versions, which never shrink while the writer adds entries
+    Concurrent_Snapshot_Map<int> map;
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&] {
+        size_t last_size = 0;
+        while (!done)
+            {
+                const auto snapshot = map.snapshot();
+                if (snapshot->size() < last_size)
+                    {
+                        errors++;
+                    }
+                last_size = snapshot->size();
+                for (const auto& it : *snapshot)
+                    {
+                        if (it.second != 2 * it.first)
+                            {
+                                errors++;
+                            }
+                    }
+            }
+    });
+    for (int i = 0; i < 2000; i++)
+        {
+            map.write(i, 2 * i);
+        }
+    done = true;
+    reader.join();
+    EXPECT_EQ(errors, 0);
+    EXPECT_EQ(map.snapshot()->size(), 2000U);
+}
@@ -18,6 +18,8 @@
 
 #include "file_configuration.h"
 #include "gnss_sdr_make_unique.h"
+#include <cstdio>
+#include <fstream>
 #include <string>
 
 
@@ -54,3 +56,45 @@ TEST(FileConfigurationTest, PropertyDoesNotExist)
     std::string value = configuration->property("whatever.whatever", default_value);
     EXPECT_STREQ("default_value", value.c_str());
 }
+
+
+TEST(FileConfigurationTest, BinaryCache)
+{
+    const std::string filename("./file_configuration_test.conf");
+    const std::string cache_filename("./file_configuration_test.cache");
+    std::remove(cache_filename.c_str());
+    {
+        std::ofstream conf(filename);
+        conf << "[GNSS-SDR]\nGNSS-SDR.internal_fs_sps=4000000\nChannels_1C.count=8\nAcquisition_1C.pfa=0.01\nPVT.flag=true\n";
+    }
+    {
+        // first run: parses the file and writes the cache
+        auto configuration = std::make_unique<FileConfiguration>(filename, cache_filename);
+        EXPECT_TRUE(configuration->has_section());
+        EXPECT_EQ(configuration->property("GNSS-SDR.internal_fs_sps", 0), 4000000);
+        EXPECT_EQ(configuration->property("channels_1c.COUNT", 0), 8);  // names are case insensitive
+        EXPECT_TRUE(std::ifstream(cache_filename).good());
+    }
+    {
+        // second run: reads the cache
+        auto configuration = std::make_unique<FileConfiguration>(filename, cache_filename);
+        EXPECT_TRUE(configuration->has_section());
+        EXPECT_EQ(configuration->property("Channels_1C.count", 0U), 8U);
+        EXPECT_DOUBLE_EQ(configuration->property("Acquisition_1C.pfa", 0.0), 0.01);
+        EXPECT_TRUE(configuration->property("PVT.flag", false));
+        EXPECT_EQ(configuration->property("PVT.flag", 3), 3);  // not a number
+        EXPECT_EQ(configuration->property("PVT.flag", std::string("")), "true");
+        configuration->set_property("Channels_1C.count", "4");
+        EXPECT_EQ(configuration->property("Channels_1C.count", 0), 4);
+    }
+    {
+        // the file changed: the cache is not used
+        std::ofstream conf(filename);
+        conf << "[GNSS-SDR]\nGNSS-SDR.internal_fs_sps=4000000\nChannels_1C.count=12\n";
+    }
+    auto configuration = std::make_unique<FileConfiguration>(filename, cache_filename);
+    EXPECT_EQ(configuration->property("Channels_1C.count", 0), 12);
+    EXPECT_DOUBLE_EQ(configuration->property("Acquisition_1C.pfa", 0.0), 0.0);
+    std::remove(filename.c_str());
+    std::remove(cache_filename.c_str());
+}
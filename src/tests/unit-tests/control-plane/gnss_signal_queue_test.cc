@@ -0,0 +1,84 @@
+/*!
+ * \file gnss_signal_queue_test.cc
+ * \brief Tests the queue of the signals available for acquisition
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_queue.h"
+#include <gtest/gtest.h>
+#include <string>
+
+
+namespace
+{
+Gnss_Signal gps_l1(uint32_t prn)
+{
+    return Gnss_Signal(Gnss_Satellite(std::string("GPS"), prn), std::string("1C"));
+}
+}  // namespace
+
+
+TEST(GnssSignalQueueTest, RoundRobin)
+{
+    Gnss_Signal_Queue queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 0U);
+    for (uint32_t prn = 1; prn <= 4; prn++)
+        {
+            queue.emplace_back(Gnss_Satellite(std::string("GPS"), prn), std::string("1C"));
+        }
+    EXPECT_EQ(queue.size(), 4U);
+
+    // next() cycles through the satellites without removing them
+    for (uint32_t prn = 1; prn <= 8; prn++)
+        {
+            EXPECT_EQ(queue.next().get_satellite().get_PRN(), (prn - 1) % 4 + 1);
+        }
+    EXPECT_EQ(queue.size(), 4U);
+
+    // pushing a satellite already in the queue moves it
+    queue.push_back(gps_l1(1));
+    EXPECT_EQ(queue.size(), 4U);
+    EXPECT_EQ(queue.front().get_satellite().get_PRN(), 2U);
+    queue.push_front(gps_l1(3));
+    EXPECT_EQ(queue.size(), 4U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 3U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 2U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 4U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 1U);
+}
+
+
+TEST(GnssSignalQueueTest, RemoveAndTake)
+{
+    Gnss_Signal_Queue queue;
+    for (uint32_t prn = 1; prn <= 5; prn++)
+        {
+            queue.push_back(gps_l1(prn));
+        }
+    EXPECT_TRUE(queue.remove(gps_l1(2)));
+    EXPECT_FALSE(queue.remove(gps_l1(2)));
+    EXPECT_FALSE(queue.contains(2));
+    // same PRN, another system
+    EXPECT_FALSE(queue.remove(Gnss_Signal(Gnss_Satellite(std::string("Galileo"), 3), std::string("1B"))));
+    EXPECT_TRUE(queue.contains(3));
+
+    Gnss_Signal gs;
+    EXPECT_TRUE(queue.take(4, gs));
+    EXPECT_EQ(gs.get_satellite().get_PRN(), 4U);
+    EXPECT_EQ(gs.get_signal_str(), "1C");
+    EXPECT_FALSE(queue.take(4, gs));
+    EXPECT_EQ(queue.size(), 3U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 1U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 3U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 5U);
+}
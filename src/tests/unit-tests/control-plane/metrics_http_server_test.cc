@@ -0,0 +1,65 @@
+/*!
+ * \file metrics_http_server_test.cc
+ * \brief Tests the HTTP server of the receiver metrics
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "metrics_http_server.h"
+#include <boost/asio.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+std::string http_get(uint16_t port, const std::string& path)
+{
+#if USE_BOOST_ASIO_IO_CONTEXT
+    boost::asio::io_context context;
+#else
+    boost::asio::io_service context;
+#endif
+    boost::asio::ip::tcp::socket socket(context);
+    socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+    const std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+    boost::asio::write(socket, boost::asio::buffer(request));
+    std::string response;
+    boost::system::error_code error;
+    char buffer[1024];
+    size_t n;
+    while ((n = socket.read_some(boost::asio::buffer(buffer), error)) > 0 or !error)
+        {
+            response.append(buffer, n);
+        }
+    return response;
+}
+}  // namespace
+
+
+TEST(MetricsHttpServerTest, ServesTheMetrics)
+{
+    const uint16_t port = 19090;
+    Metrics_Http_Server server([]() { return std::string("gnss_sdr_control_queue_depth 3\n"); });
+    ASSERT_TRUE(server.start(port));
+
+    const std::string metrics = http_get(port, "/metrics");
+    EXPECT_EQ(metrics.compare(0, 15, "HTTP/1.0 200 OK"), 0);
+    EXPECT_NE(metrics.find("Content-Length: 31\r\n"), std::string::npos);
+    EXPECT_NE(metrics.find("\r\n\r\ngnss_sdr_control_queue_depth 3\n"), std::string::npos);
+
+    const std::string other = http_get(port, "/");
+    EXPECT_EQ(other.compare(0, 22, "HTTP/1.0 404 Not Found"), 0);
+
+    // the port is taken
+    Metrics_Http_Server second([]() { return std::string(); });
+    EXPECT_FALSE(second.start(port));
+    server.stop();
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file mpsc_queue_test.cc
+ * \brief Tests the lock-free queue that carries the control plane events
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "control_queue.h"
+#include "mpsc_queue.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+TEST(MpscQueueTest, TimedWait)
+{
+    Control_Queue queue;
+    Control_Message msg{};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size_approx(), size_t(0));
+    EXPECT_FALSE(queue.try_pop(msg));
+    EXPECT_FALSE(queue.timed_wait_and_pop(msg, 10));
+
+    queue.push(command_event_make(200, 1));
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size_approx(), size_t(1));
+    EXPECT_TRUE(queue.timed_wait_and_pop(msg, 10));
+    EXPECT_EQ(msg.type, Control_Message::command_event);
+    EXPECT_EQ(msg.id, 200);
+    EXPECT_EQ(msg.event_type, 1);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size_approx(), size_t(0));
+
+    // the consumer is woken up by a push from another thread
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(channel_event_make(3, 2));
+    });
+    EXPECT_TRUE(queue.timed_wait_and_pop(msg, 5000));
+    EXPECT_EQ(msg.type, Control_Message::channel_event);
+    EXPECT_EQ(msg.id, 3);
+    producer.join();
+}
+
+
+TEST(MpscQueueTest, ProducersKeepTheirOrder)
+{
+    const int producers = 4;
+    const int messages = 20000;  // several times the capacity, so that pushes wait for room
+    Mpsc_Queue<Control_Message> queue(64);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&queue, p]() {
+                for (int n = 0; n < messages; n++)
+                    {
+                        queue.push(channel_event_make(p, n));
+                    }
+            });
+        }
+
+    std::vector<int> next(producers, 0);
+    Control_Message msg{};
+    for (int received = 0; received < producers * messages; received++)
+        {
+            queue.wait_and_pop(msg);
+            ASSERT_GE(msg.id, 0);
+            ASSERT_LT(msg.id, producers);
+            ASSERT_EQ(msg.event_type, next[msg.id]);
+            next[msg.id]++;
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    EXPECT_TRUE(queue.empty());
+}
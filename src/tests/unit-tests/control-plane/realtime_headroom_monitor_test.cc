@@ -0,0 +1,86 @@
+/*!
+ * \file realtime_headroom_monitor_test.cc
+ * \brief Tests the detection of a receiver falling behind real time
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "realtime_headroom_monitor.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+
+
+TEST(RealtimeHeadroomMonitorTest, KeepingUp)
+{
+    const double fs = 4e6;
+    Realtime_Headroom_Monitor monitor(fs, Realtime_Headroom_Conf());
+    auto now = std::chrono::steady_clock::now();
+    uint64_t samples = 0;
+    for (int i = 0; i < 20; i++)
+        {
+            EXPECT_EQ(monitor.update(samples, 0.1, now), Realtime_Headroom_Monitor::OK);
+            now += std::chrono::milliseconds(500);
+            samples += static_cast<uint64_t>(fs * 0.5);
+        }
+    EXPECT_NEAR(monitor.backlog_ms(), 0.0, 1e-6);
+    EXPECT_NEAR(monitor.processing_ratio(), 1.0, 1e-6);
+
+    // a file source runs faster than real time
+    Realtime_Headroom_Monitor file(fs, Realtime_Headroom_Conf());
+    samples = 0;
+    for (int i = 0; i < 20; i++)
+        {
+            EXPECT_EQ(file.update(samples, 0.0, now), Realtime_Headroom_Monitor::OK);
+            now += std::chrono::milliseconds(500);
+            samples += static_cast<uint64_t>(fs * 5.0);
+        }
+    EXPECT_NEAR(file.backlog_ms(), 0.0, 1e-6);
+}
+
+
+TEST(RealtimeHeadroomMonitorTest, FallingBehind)
+{
+    const double fs = 4e6;
+    Realtime_Headroom_Conf conf;
+    Realtime_Headroom_Monitor monitor(fs, conf);
+    auto now = std::chrono::steady_clock::now();
+    uint64_t samples = 0;
+    // 95 % of real time: the backlog grows by 25 ms every half a second
+    Realtime_Headroom_Monitor::State state = Realtime_Headroom_Monitor::OK;
+    int first_warning = -1;
+    int first_overload = -1;
+    for (int i = 0; i < 40; i++)
+        {
+            state = monitor.update(samples, 0.2, now);
+            if (state == Realtime_Headroom_Monitor::WARNING and first_warning < 0)
+                {
+                    first_warning = i;
+                }
+            if (state == Realtime_Headroom_Monitor::OVERLOAD and first_overload < 0)
+                {
+                    first_overload = i;
+                }
+            now += std::chrono::milliseconds(500);
+            samples += static_cast<uint64_t>(fs * 0.5 * 0.95);
+        }
+    EXPECT_EQ(state, Realtime_Headroom_Monitor::OVERLOAD);
+    // the ratio warns as soon as the window is half full, before the backlog does
+    EXPECT_EQ(first_warning, 2);
+    EXPECT_EQ(first_overload, 20);
+    EXPECT_NEAR(monitor.processing_ratio(), 0.95, 1e-6);
+    EXPECT_NEAR(monitor.backlog_ms(), 39 * 25.0, 1e-3);
+
+    // the source buffer fill raises the alarm by itself
+    Realtime_Headroom_Monitor buffers(fs, conf);
+    EXPECT_EQ(buffers.update(0, 0.6, now), Realtime_Headroom_Monitor::WARNING);
+    EXPECT_EQ(buffers.update(0, 0.95, now), Realtime_Headroom_Monitor::OVERLOAD);
+}
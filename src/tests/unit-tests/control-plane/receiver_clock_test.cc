@@ -0,0 +1,51 @@
+/*!
+ * \file receiver_clock_test.cc
+ * \brief This file implements tests for Gnss_Sdr_Receiver_Clock
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_receiver_clock.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+
+TEST(ReceiverClockTest, PublishesEpochsAndReportsEachSecond)
+{
+    Gnss_Sdr_Receiver_Clock clock(4e6);
+    EXPECT_EQ(clock.sample_counter(), 0U);
+    EXPECT_EQ(clock.epochs(), 0U);
+    int reports = 0;
+    for (uint64_t epoch = 1; epoch <= 100; epoch++)
+        {
+            if (clock.publish_epoch(epoch * 80000))  // 20 ms epochs
+                {
+                    reports++;
+                }
+        }
+    EXPECT_EQ(clock.sample_counter(), 8000000U);
+    EXPECT_EQ(clock.epochs(), 100U);
+    EXPECT_EQ(reports, 3);  // 1 s at the first epoch, then at 1 s and 2 s of samples
+
+    // a gap in the input samples skips the seconds it lasted, with a single report
+    EXPECT_TRUE(clock.publish_epoch(40000000));
+    EXPECT_FALSE(clock.publish_epoch(40080000));
+}
+
+
+TEST(ReceiverClockTest, FormatsTheReceiverTime)
+{
+    EXPECT_EQ(Gnss_Sdr_Receiver_Clock::receiver_time_message(5), "Current receiver time: 5 s");
+    EXPECT_EQ(Gnss_Sdr_Receiver_Clock::receiver_time_message(125), "Current receiver time: 2 min 5 s");
+    EXPECT_EQ(Gnss_Sdr_Receiver_Clock::receiver_time_message(3600), "Current receiver time: 1 h 0 min 0 s");
+    EXPECT_EQ(Gnss_Sdr_Receiver_Clock::receiver_time_message(86400 + 61), "Current receiver time: 1 day 0 h 1 min 1 s");
+    EXPECT_EQ(Gnss_Sdr_Receiver_Clock::receiver_time_message(2 * 86400), "Current receiver time: 2 days 0 h 0 min 0 s");
+}
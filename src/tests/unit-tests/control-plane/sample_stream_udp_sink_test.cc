@@ -0,0 +1,121 @@
+/*!
+ * \file sample_stream_udp_sink_test.cc
+ * \brief Implements Unit Tests for the block that streams the conditioned
+ * samples to the worker nodes of a distributed receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_stream_udp_sink.h"
+#include <boost/asio.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// c4bits decoding of Gr_Complex_Ip_Packet_Source
+float c4bits_level(uint8_t nibble)
+{
+    return nibble >= 8 ? static_cast<float>(2 * (nibble - 16) + 1) : static_cast<float>(2 * nibble + 1);
+}
+}  // namespace
+
+
+TEST(SampleStreamUdpSinkTest, PacksC4bits)
+{
+    std::vector<gr_complex> band0;
+    std::vector<gr_complex> band1;
+    for (int level = -15; level <= 15; level += 2)
+        {
+            // anything within one unit of an odd level is quantized to it
+            band0.emplace_back(static_cast<float>(level) + 0.9F, static_cast<float>(-level) - 0.9F);
+            band1.emplace_back(static_cast<float>(level) - 0.9F, 100.0F);
+        }
+    const std::vector<const gr_complex*> in = {band0.data(), band1.data()};
+    std::vector<uint8_t> out(2 * band0.size());
+    ASSERT_EQ(sample_stream_udp_sink::pack(in, 0, band0.size(), sample_stream_udp_sink::Wire_Format::C4bits, 1.0F, out.data()), out.size());
+    for (size_t i = 0; i < band0.size(); i++)
+        {
+            const float level = static_cast<float>(2 * static_cast<int>(i) - 15);
+            EXPECT_EQ(c4bits_level(out[2 * i] & 0x0F), level);
+            EXPECT_EQ(c4bits_level(out[2 * i] >> 4), -level);
+            // out of range components are clipped to the largest level
+            EXPECT_EQ(c4bits_level(out[2 * i + 1] & 0x0F), level);
+            EXPECT_EQ(c4bits_level(out[2 * i + 1] >> 4), 15.0F);
+        }
+}
+
+
+TEST(SampleStreamUdpSinkTest, PacksQFirst)
+{
+    const std::vector<gr_complex> band = {{1.2F, -3.7F}, {-200.0F, 1000.0F}};
+    const std::vector<const gr_complex*> in = {band.data()};
+    std::vector<uint8_t> out(2 * sample_stream_udp_sink::bytes_per_sample(sample_stream_udp_sink::Wire_Format::Ishort));
+    ASSERT_EQ(sample_stream_udp_sink::pack(in, 0, 2, sample_stream_udp_sink::Wire_Format::Cbyte, 1.0F, out.data()), 4U);
+    EXPECT_EQ(static_cast<int8_t>(out[0]), -4);
+    EXPECT_EQ(static_cast<int8_t>(out[1]), 1);
+    EXPECT_EQ(static_cast<int8_t>(out[2]), 127);
+    EXPECT_EQ(static_cast<int8_t>(out[3]), -128);
+    ASSERT_EQ(sample_stream_udp_sink::pack(in, 1, 1, sample_stream_udp_sink::Wire_Format::Ishort, 10.0F, out.data()), 4U);
+    int16_t iq[2];
+    std::memcpy(iq, out.data(), sizeof(iq));
+    EXPECT_EQ(iq[0], 10000);
+    EXPECT_EQ(iq[1], -2000);
+}
+
+
+TEST(SampleStreamUdpSinkTest, SendsWholeSamples)
+{
+    b_io_context io_context;
+    boost::asio::ip::udp::socket receiver(io_context, boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    const uint16_t port = receiver.local_endpoint().port();
+
+    Sample_Stream_Conf conf;
+    conf.sample_type = "cbyte";
+    conf.payload_bytes = 1001;  // 250 samples of the two bands
+    auto sink = sample_stream_udp_sink_make(2, conf, {"127.0.0.1"}, port);
+    ASSERT_EQ(sink->samples_per_packet(), 250);
+
+    const int n_samples = 600;
+    std::vector<gr_complex> band0(n_samples);
+    std::vector<gr_complex> band1(n_samples);
+    for (int i = 0; i < n_samples; i++)
+        {
+            band0[i] = gr_complex(static_cast<float>(i % 100), 0.0F);
+            band1[i] = gr_complex(0.0F, static_cast<float>(-(i % 100)));
+        }
+    gr_vector_const_void_star input_items = {band0.data(), band1.data()};
+    gr_vector_void_star output_items;
+    EXPECT_EQ(sink->work(450, input_items, output_items), 450);
+    input_items = {band0.data() + 450, band1.data() + 450};
+    EXPECT_EQ(sink->work(n_samples - 450, input_items, output_items), n_samples - 450);
+    sink->stop();
+    EXPECT_EQ(sink->packets_sent(), 3U);
+
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> packet(2048);
+    for (int p = 0; p < 3; p++)
+        {
+            const size_t received = receiver.receive(boost::asio::buffer(packet));
+            EXPECT_EQ(received, p < 2 ? 1000U : 400U);
+            stream.insert(stream.end(), packet.begin(), packet.begin() + received);
+        }
+    ASSERT_EQ(stream.size(), static_cast<size_t>(4 * n_samples));
+    for (int i = 0; i < n_samples; i++)
+        {
+            EXPECT_EQ(static_cast<int8_t>(stream[4 * i + 1]), i % 100);      // I of band 0
+            EXPECT_EQ(static_cast<int8_t>(stream[4 * i + 2]), -(i % 100));  // Q of band 1
+        }
+}
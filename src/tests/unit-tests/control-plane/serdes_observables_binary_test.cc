@@ -0,0 +1,80 @@
+/*!
+ * \file serdes_observables_binary_test.cc
+ * \brief Tests the binary serialization of epochs of observables
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "serdes_observables_binary.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+
+TEST(SerdesObservablesBinaryTest, RoundTrip)
+{
+    std::vector<Gnss_Synchro> epoch(3);
+    for (uint32_t i = 0; i < epoch.size(); i++)
+        {
+            epoch[i].System = i == 2 ? 'E' : 'G';
+            epoch[i].Signal[0] = '1';
+            epoch[i].Signal[1] = i == 2 ? 'B' : 'C';
+            epoch[i].PRN = 3 + i;
+            epoch[i].Channel_ID = static_cast<int32_t>(i);
+            epoch[i].Pseudorange_m = 21000000.123456 + i;
+            epoch[i].Carrier_phase_rads = -12345.678 * i;
+            epoch[i].Carrier_Doppler_hz = 1234.5 - i;
+            epoch[i].CN0_dB_hz = 45.25;
+            epoch[i].interp_TOW_ms = 345600010.5;
+            epoch[i].Flag_valid_pseudorange = true;
+            epoch[i].Flag_PLL_180_deg_phase_locked = i == 1;
+        }
+    const Serdes_Observables_Binary serdes;
+    std::vector<uint8_t> buffer;
+    serdes.serialize(epoch, 345600.01, buffer);
+    serdes.serialize(std::vector<Gnss_Synchro>(epoch.begin(), epoch.begin() + 1), 345600.02, buffer);
+    ASSERT_EQ(buffer.size(), 2 * Serdes_Observables_Binary::HEADER_SIZE + 4 * Serdes_Observables_Binary::RECORD_SIZE);
+    EXPECT_EQ(buffer[0], 'G');
+    EXPECT_EQ(buffer[1], 'O');
+    EXPECT_EQ(buffer[2], 'B');
+    EXPECT_EQ(buffer[3], 'S');
+
+    std::vector<Gnss_Synchro> decoded;
+    double rx_time_s = 0.0;
+    const size_t used = serdes.deserialize(buffer.data(), buffer.size(), decoded, rx_time_s);
+    ASSERT_EQ(used, Serdes_Observables_Binary::HEADER_SIZE + 3 * Serdes_Observables_Binary::RECORD_SIZE);
+    EXPECT_NEAR(rx_time_s, 345600.01, 1e-9);
+    ASSERT_EQ(decoded.size(), epoch.size());
+    for (size_t i = 0; i < epoch.size(); i++)
+        {
+            EXPECT_EQ(decoded[i].System, epoch[i].System);
+            EXPECT_EQ(decoded[i].Signal[0], epoch[i].Signal[0]);
+            EXPECT_EQ(decoded[i].Signal[1], epoch[i].Signal[1]);
+            EXPECT_EQ(decoded[i].PRN, epoch[i].PRN);
+            EXPECT_EQ(decoded[i].Channel_ID, epoch[i].Channel_ID);
+            EXPECT_EQ(decoded[i].Pseudorange_m, epoch[i].Pseudorange_m);
+            EXPECT_EQ(decoded[i].Carrier_phase_rads, epoch[i].Carrier_phase_rads);
+            EXPECT_EQ(decoded[i].Carrier_Doppler_hz, epoch[i].Carrier_Doppler_hz);
+            EXPECT_EQ(decoded[i].CN0_dB_hz, epoch[i].CN0_dB_hz);
+            EXPECT_EQ(decoded[i].interp_TOW_ms, epoch[i].interp_TOW_ms);
+            EXPECT_TRUE(decoded[i].Flag_valid_pseudorange);
+            EXPECT_FALSE(decoded[i].Flag_valid_word);
+            EXPECT_EQ(decoded[i].Flag_PLL_180_deg_phase_locked, epoch[i].Flag_PLL_180_deg_phase_locked);
+        }
+
+    const size_t used2 = serdes.deserialize(buffer.data() + used, buffer.size() - used, decoded, rx_time_s);
+    EXPECT_EQ(used + used2, buffer.size());
+    EXPECT_EQ(decoded.size(), 1U);
+
+    // truncated epoch
+    EXPECT_EQ(serdes.deserialize(buffer.data(), used - 1, decoded, rx_time_s), 0U);
+}
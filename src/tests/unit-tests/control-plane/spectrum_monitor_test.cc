@@ -0,0 +1,103 @@
+/*!
+ * \file spectrum_monitor_test.cc
+ * \brief Implements Unit Tests for the spectrum monitor block and the
+ * serialization of its reports.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "serdes_spectrum_monitor.h"
+#include "spectrum_monitor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <string>
+#include <vector>
+
+
+TEST(SpectrumMonitorTest, WhiteNoise)
+{
+    const double fs = 4e6;
+    auto monitor = spectrum_monitor_make(0, fs, Spectrum_Monitor_Conf(), std::vector<std::string>(), 1238);
+    std::mt19937 gen(1);
+    std::normal_distribution<float> dist(0.0, std::sqrt(0.5));
+    std::vector<gr_complex> samples(monitor->capture_length());
+    for (auto& x : samples)
+        {
+            x = gr_complex(dist(gen), dist(gen));
+        }
+
+    Spectrum_Monitor_Packet report;
+    monitor->analyze(samples.data(), report);
+    ASSERT_EQ(report.psd_db.size(), 256U);
+    EXPECT_EQ(report.fft_size, 1024);
+    // unit power spread over fs
+    EXPECT_NEAR(report.total_power_db, 0.0, 0.2);
+    EXPECT_NEAR(report.noise_floor_db, -10.0 * std::log10(fs), 0.5);
+    EXPECT_GT(report.spectral_flatness, 0.9);
+    EXPECT_NEAR(report.kurtosis, 3.0, 0.3);
+    EXPECT_FALSE(report.interference_detected);
+}
+
+
+TEST(SpectrumMonitorTest, ContinuousWaveInterference)
+{
+    const double fs = 4e6;
+    const double tone_hz = fs / 8.0;
+    auto monitor = spectrum_monitor_make(1, fs, Spectrum_Monitor_Conf(), std::vector<std::string>(), 1238);
+    std::mt19937 gen(2);
+    std::normal_distribution<float> dist(0.0, std::sqrt(0.5));
+    std::vector<gr_complex> samples(monitor->capture_length());
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            samples[n] = gr_complex(dist(gen), dist(gen)) +
+                         std::polar(3.0F, static_cast<float>(2.0 * M_PI * tone_hz * static_cast<double>(n) / fs));
+        }
+
+    Spectrum_Monitor_Packet report;
+    monitor->analyze(samples.data(), report);
+    EXPECT_EQ(report.rf_channel, 1);
+    EXPECT_NEAR(report.peak_frequency_hz, tone_hz, fs / monitor->fft_size());
+    EXPECT_GT(report.peak_to_floor_db, 20.0);
+    EXPECT_LT(report.spectral_flatness, 0.5);
+    EXPECT_TRUE(report.interference_detected);
+}
+
+
+TEST(SpectrumMonitorTest, Serdes)
+{
+    Spectrum_Monitor_Packet report;
+    report.rf_channel = 2;
+    report.sample_rate_hz = 2e6;
+    report.sample_counter = 123456789;
+    report.fft_size = 512;
+    report.averaged_segments = 8;
+    report.psd_db = {-60.0, -61.5, -59.25};
+    report.peak_to_floor_db = 12.5;
+    report.kurtosis = 4.5;
+    report.interference_detected = true;
+
+    Serdes_Spectrum_Monitor serdes;
+    const std::string data = serdes.createProtobuffer(report);
+    gnss_sdr::spectrumMonitor msg;
+    ASSERT_TRUE(msg.ParseFromString(data));
+    const Spectrum_Monitor_Packet read = serdes.readProtobuffer(msg);
+    EXPECT_EQ(read.rf_channel, report.rf_channel);
+    EXPECT_EQ(read.sample_rate_hz, report.sample_rate_hz);
+    EXPECT_EQ(read.sample_counter, report.sample_counter);
+    EXPECT_EQ(read.fft_size, report.fft_size);
+    EXPECT_EQ(read.averaged_segments, report.averaged_segments);
+    EXPECT_EQ(read.psd_db, report.psd_db);
+    EXPECT_EQ(read.peak_to_floor_db, report.peak_to_floor_db);
+    EXPECT_EQ(read.kurtosis, report.kurtosis);
+    EXPECT_TRUE(read.interference_detected);
+}
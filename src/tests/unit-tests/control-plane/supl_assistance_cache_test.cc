@@ -0,0 +1,61 @@
+/*!
+ * \file supl_assistance_cache_test.cc
+ * \brief This file implements tests for the assistance cache of
+ * Gnss_Sdr_Supl_Client
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_supl_client.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+
+TEST(SuplAssistanceCacheTest, SaveAndLoad)
+{
+    const std::string filename = "./supl_assistance_cache_test.bin";
+    {
+        Gnss_Sdr_Supl_Client supl_client;
+        EXPECT_FALSE(supl_client.save_assistance_cache(filename));  // nothing to save
+        for (int prn = 1; prn <= 3; prn++)
+            {
+                Gps_Ephemeris eph;
+                eph.PRN = prn;
+                eph.sqrtA = 5153.7 + prn;
+                supl_client.gps_ephemeris_map[prn] = eph;
+            }
+        supl_client.gps_iono.alpha0 = 1.1e-8;
+        supl_client.gps_iono.valid = true;
+        supl_client.gps_ref_loc.lat = 41.27;
+        supl_client.gps_ref_loc.lon = 1.99;
+        supl_client.gps_ref_loc.valid = true;
+        ASSERT_TRUE(supl_client.save_assistance_cache(filename));
+    }
+
+    Gnss_Sdr_Supl_Client supl_client;
+    ASSERT_TRUE(supl_client.load_assistance_cache(filename, 3600));
+    ASSERT_EQ(supl_client.gps_ephemeris_map.size(), 3U);
+    EXPECT_EQ(supl_client.gps_ephemeris_map.at(2).PRN, 2U);
+    EXPECT_DOUBLE_EQ(supl_client.gps_ephemeris_map.at(2).sqrtA, 5155.7);
+    EXPECT_TRUE(supl_client.gps_iono.valid);
+    EXPECT_DOUBLE_EQ(supl_client.gps_iono.alpha0, 1.1e-8);
+    EXPECT_TRUE(supl_client.gps_ref_loc.valid);
+    EXPECT_DOUBLE_EQ(supl_client.gps_ref_loc.lat, 41.27);
+
+    // expired
+    Gnss_Sdr_Supl_Client expired_client;
+    EXPECT_FALSE(expired_client.load_assistance_cache(filename, -1));
+    EXPECT_TRUE(expired_client.gps_ephemeris_map.empty());
+
+    std::remove(filename.c_str());
+    EXPECT_FALSE(expired_client.load_assistance_cache(filename, 3600));
+}
@@ -0,0 +1,70 @@
+/*!
+ * \file tracking_checkpoint_test.cc
+ * \brief This file implements tests for the Tracking_Checkpoint class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_checkpoint.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+TEST(TrackingCheckpointTest, SaveAndLoad)
+{
+    const std::string filename = "./tracking_checkpoint_test.txt";
+    {
+        Tracking_Checkpoint checkpoint;
+        for (int32_t ch = 0; ch < 3; ch++)
+            {
+                Tracking_Checkpoint::Entry entry;
+                entry.System = (ch == 2) ? "Galileo" : "GPS";
+                entry.Signal = (ch == 2) ? "1B" : "1C";
+                entry.PRN = static_cast<uint32_t>(ch + 5);
+                entry.channel = ch;
+                entry.Carrier_Doppler_hz = -1234.5678 + ch;
+                entry.CN0_dB_hz = 40.25 + ch;
+                entry.TOW_at_current_symbol_ms = 345678000U + static_cast<uint32_t>(ch);
+                checkpoint.entries.push_back(entry);
+            }
+        ASSERT_TRUE(checkpoint.save(filename));
+    }
+
+    Tracking_Checkpoint checkpoint;
+    ASSERT_TRUE(checkpoint.load(filename, 60));
+    ASSERT_EQ(checkpoint.entries.size(), 3U);
+    EXPECT_EQ(checkpoint.entries[2].System, "Galileo");
+    EXPECT_EQ(checkpoint.entries[2].Signal, "1B");
+    EXPECT_EQ(checkpoint.entries[2].PRN, 7U);
+    EXPECT_EQ(checkpoint.entries[2].channel, 2);
+    EXPECT_DOUBLE_EQ(checkpoint.entries[2].Carrier_Doppler_hz, -1232.5678);
+    EXPECT_DOUBLE_EQ(checkpoint.entries[2].CN0_dB_hz, 42.25);
+    EXPECT_EQ(checkpoint.entries[2].TOW_at_current_symbol_ms, 345678002U);
+    EXPECT_GT(checkpoint.creation_time, 0);
+
+    // expired
+    Tracking_Checkpoint expired;
+    EXPECT_FALSE(expired.load(filename, -1));
+    EXPECT_TRUE(expired.entries.empty());
+
+    // corrupted
+    {
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::app);
+        file << "3 GPS 1C\n";
+    }
+    EXPECT_FALSE(expired.load(filename, 60));
+    EXPECT_TRUE(expired.entries.empty());
+
+    std::remove(filename.c_str());
+    EXPECT_FALSE(expired.load(filename, 60));
+}
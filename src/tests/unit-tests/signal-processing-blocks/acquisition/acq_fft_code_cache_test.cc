@@ -0,0 +1,53 @@
+/*!
+ * \file acq_fft_code_cache_test.cc
+ * \brief This file implements unit tests for the code spectra cache shared
+ * by the PCPS acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_fft_code_cache.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <memory>
+#include <vector>
+
+
+TEST(AcqFftCodeCacheTest, SharesSpectraWithSameKey)
+{
+    std::vector<std::complex<float>> code(1000, std::complex<float>(1.0, -1.0));
+    const Acq_Fft_Code_Cache::Key key("1C", 7, 4000000, 1000, 0, code.data(), 1000);
+    Acq_Fft_Code_Cache& cache = Acq_Fft_Code_Cache::instance();
+    const size_t entries = cache.size();
+
+    EXPECT_EQ(cache.find(key), nullptr);
+    auto spectrum = std::make_shared<volk_gnsssdr::vector<std::complex<float>>>(1000);
+    auto stored = cache.insert(key, spectrum);
+    EXPECT_EQ(stored, spectrum);
+    EXPECT_EQ(cache.size(), entries + 1);
+
+    // A second channel asking for the same code gets the same spectrum
+    const Acq_Fft_Code_Cache::Key same_key("1C", 7, 4000000, 1000, 0, code.data(), 1000);
+    EXPECT_EQ(cache.find(same_key), spectrum);
+    auto other_spectrum = std::make_shared<volk_gnsssdr::vector<std::complex<float>>>(1000);
+    EXPECT_EQ(cache.insert(same_key, other_spectrum), spectrum);
+
+    // Different code contents never share a spectrum
+    code[10] = std::complex<float>(-1.0, 1.0);
+    const Acq_Fft_Code_Cache::Key other_key("1C", 7, 4000000, 1000, 0, code.data(), 1000);
+    EXPECT_EQ(cache.find(other_key), nullptr);
+
+    // Entries are released when no one holds them
+    stored.reset();
+    spectrum.reset();
+    EXPECT_EQ(cache.find(key), nullptr);
+    EXPECT_EQ(cache.size(), entries);
+}
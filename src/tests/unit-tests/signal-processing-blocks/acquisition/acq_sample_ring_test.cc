@@ -0,0 +1,53 @@
+/*!
+ * \file acq_sample_ring_test.cc
+ * \brief This file implements unit tests for the ring of resampled samples
+ * shared by the acquisition channels of a signal.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sample_ring.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <vector>
+
+
+TEST(AcqSampleRingTest, SnapshotsAreContiguousAcrossTheWrap)
+{
+    const size_t capacity = 1000;
+    Acq_Sample_Ring ring(capacity);
+    std::vector<std::complex<float>> samples(2500);
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            samples[n] = std::complex<float>(static_cast<float>(n), -static_cast<float>(n));
+        }
+
+    EXPECT_EQ(ring.snapshot(0, 10), nullptr);  // not written yet
+    ring.write(samples.data(), 700);
+    ring.write(samples.data() + 700, 900);
+    EXPECT_EQ(ring.written(), 1600U);
+
+    // the window [900, 1600) crosses the end of the buffer
+    const std::complex<float>* snapshot = ring.snapshot(900, 700);
+    ASSERT_NE(snapshot, nullptr);
+    for (size_t n = 0; n < 700; n++)
+        {
+            ASSERT_EQ(snapshot[n], samples[900 + n]);
+        }
+    EXPECT_TRUE(ring.intact(900));
+    EXPECT_EQ(ring.snapshot(500, 100), nullptr);   // already overwritten
+    EXPECT_EQ(ring.snapshot(1500, 200), nullptr);  // partially in the future
+
+    // a snapshot is not intact once the writer has gone capacity samples past it
+    ring.write(samples.data() + 1600, 400);
+    EXPECT_FALSE(ring.intact(900));
+    EXPECT_TRUE(ring.intact(1000));
+}
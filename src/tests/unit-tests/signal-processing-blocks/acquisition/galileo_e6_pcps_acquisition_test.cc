@@ -18,6 +18,7 @@
 
 #include "Galileo_E6.h"
 #include "concurrent_queue.h"
+#include "control_queue.h"
 #include "fir_filter.h"
 #include "galileo_e6_pcps_acquisition.h"
 #include "gnss_block_interface.h"
@@ -141,7 +142,7 @@ protected:
     void stop_queue();
 
     Concurrent_Queue<int> channel_internal_queue;
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
     gnss_shared_ptr<GalileoE6PcpsAcquisition> acquisition;
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
@@ -323,7 +324,7 @@ TEST_F(GalileoE6PcpsAcquisitionTest, ConnectAndRun)
     std::chrono::time_point<std::chrono::system_clock> begin, end;
     std::chrono::duration<double> elapsed_seconds(0);
 
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
     top_block = gr::make_top_block("Acquisition test");
 
     init();
@@ -362,7 +363,7 @@ TEST_F(GalileoE6PcpsAcquisitionTest, ValidationOfResults)
 
     std::shared_ptr<FirFilter> input_filter = std::make_shared<FirFilter>(config.get(), "InputFilter", 1, 1);
     auto msg_rx = GalileoE6PcpsAcquisitionTest_msg_rx_make(channel_internal_queue);
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
 
     ASSERT_NO_THROW({
         acquisition->set_channel(0);
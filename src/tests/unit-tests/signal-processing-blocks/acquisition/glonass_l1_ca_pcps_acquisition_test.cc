@@ -16,7 +16,7 @@
  * -----------------------------------------------------------------------------
  */
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "freq_xlating_fir_filter.h"
 #include "glonass_l1_ca_pcps_acquisition.h"
 #include "gnss_block_interface.h"
@@ -185,7 +185,7 @@ TEST_F(GlonassL1CaPcpsAcquisitionTest, ConnectAndRun)
     int nsamples = 62314;
     std::chrono::time_point<std::chrono::system_clock> begin, end;
     std::chrono::duration<double> elapsed_seconds(0);
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    std::shared_ptr<Control_Queue> queue = std::make_shared<Control_Queue>();
 
     top_block = gr::make_top_block("Acquisition test");
     init();
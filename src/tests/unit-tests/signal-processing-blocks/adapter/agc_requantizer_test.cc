@@ -0,0 +1,83 @@
+/*!
+ * \file agc_requantizer_test.cc
+ * \brief  This file implements tests for the Agc_Requantizer data type adapter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "agc_requantizer.h"
+#include "pack_2bit_samples.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+TEST(AgcRequantizerTest, FourBitLevelsFollowThePower)
+{
+    const int nsamples = 200000;
+    std::mt19937 gen(3);
+    std::normal_distribution<float> dist(0.0, 1000.0);  // 16-bit front end
+    std::vector<gr_complex> input(nsamples);
+    for (auto& x : input)
+        {
+            x = gr_complex(dist(gen), dist(gen));
+        }
+
+    auto top_block = gr::make_top_block("Requantizer test");
+    auto requantizer = make_agc_requantizer(4);
+    auto sink = gr::blocks::vector_sink_s::make(2);  // std::complex<short> items
+    top_block->connect(gr::blocks::vector_source_c::make(input), 0, requantizer, 0);
+    top_block->connect(requantizer, 0, sink, 0);
+    top_block->run();
+
+    const std::vector<int16_t> out = sink->data();
+    ASSERT_EQ(out.size(), static_cast<size_t>(2 * nsamples));
+    std::vector<int> histogram(16, 0);
+    for (const int16_t v : out)
+        {
+            // odd levels from -15 to 15
+            ASSERT_NE(v % 2, 0);
+            ASSERT_LE(std::abs(v), 15);
+            histogram[(v + 15) / 2]++;
+        }
+    // the optimum step for a Gaussian input uses every level, with the
+    // outermost ones being rare
+    for (int level = 0; level < 16; level++)
+        {
+            EXPECT_GT(histogram[level], 0) << "level " << 2 * level - 15;
+        }
+    EXPECT_LT(histogram[0] + histogram[15], 2 * nsamples * 3 / 100);
+    EXPECT_NEAR(requantizer->gain(), 1.0 / (0.3352 * 1000.0), 1e-4);
+}
+
+
+TEST(AgcRequantizerTest, PacksTwoBitSamples)
+{
+    const std::vector<int16_t> input = {1, 3, -3, -1, -1, -1, 3, 1};  // I and Q
+
+    auto top_block = gr::make_top_block("Packer test");
+    auto sink = gr::blocks::vector_sink_b::make();
+    auto packer = make_pack_2bit_samples();
+    top_block->connect(gr::blocks::vector_source_s::make(input, false, 2), 0, packer, 0);
+    top_block->connect(packer, 0, sink, 0);
+    top_block->run();
+
+    // codes 0, 1, 2, 3 from the least significant bits on
+    const std::vector<uint8_t> out = sink->data();
+    ASSERT_EQ(out.size(), 2U);
+    EXPECT_EQ(out[0], 0xE4);
+    EXPECT_EQ(out[1], 0x1F);
+}
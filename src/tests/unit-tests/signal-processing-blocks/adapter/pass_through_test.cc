@@ -19,7 +19,13 @@
 
 #include "in_memory_configuration.h"
 #include "pass_through.h"
+#include "signal_conditioner.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 
 
 TEST(PassThroughTest, Instantiate)
@@ -29,3 +35,41 @@ TEST(PassThroughTest, Instantiate)
     std::shared_ptr<Pass_Through> signal_conditioner = std::make_shared<Pass_Through>(config.get(), "Test", 1, 1);
     EXPECT_STREQ("gr_complex", signal_conditioner->item_type().c_str());
 }
+
+
+TEST(PassThroughTest, FusedInSignalConditioner)
+{
+    std::shared_ptr<ConfigurationInterface> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("DataTypeAdapter.item_type", "gr_complex");
+    config->set_property("InputFilter.item_type", "gr_complex");
+    config->set_property("InputFilter.inverted_spectrum", "true");
+    config->set_property("Resampler.item_type", "gr_complex");
+    SignalConditioner conditioner(std::make_shared<Pass_Through>(config.get(), "DataTypeAdapter", 1, 1),
+        std::make_shared<Pass_Through>(config.get(), "InputFilter", 1, 1),
+        std::make_shared<Pass_Through>(config.get(), "Resampler", 1, 1),
+        "SignalConditioner");
+
+    // the three stages run in a single block
+    ASSERT_NE(conditioner.fused_block(), nullptr);
+    EXPECT_EQ(conditioner.fused_block()->num_kernels(), 3U);
+    EXPECT_EQ(conditioner.get_left_block(), conditioner.get_right_block());
+
+    std::vector<gr_complex> input;
+    for (int n = 0; n < 10000; n++)
+        {
+            input.emplace_back(static_cast<float>(n), static_cast<float>(-2 * n));
+        }
+    auto top_block = gr::make_top_block("Fused conditioner test");
+    auto sink = gr::blocks::vector_sink_c::make();
+    conditioner.connect(top_block);
+    top_block->connect(gr::blocks::vector_source_c::make(input), 0, conditioner.get_left_block(), 0);
+    top_block->connect(conditioner.get_right_block(), 0, sink, 0);
+    top_block->run();
+
+    const std::vector<gr_complex> output = sink->data();
+    ASSERT_EQ(output.size(), input.size());
+    for (size_t n = 0; n < input.size(); n++)
+        {
+            ASSERT_EQ(output[n], std::conj(input[n]));
+        }
+}
@@ -0,0 +1,121 @@
+/*!
+ * \file beamformer_test.cc
+ * \brief Implements Unit Tests for the beamformer block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beamformer.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+
+TEST(BeamformerTest, StaticWeightsSixteenElements)
+{
+    const int elements = 16;
+    const int nsamples = 100000;  // long enough to be split among workers
+    std::mt19937 gen(1);
+    std::normal_distribution<float> dist(0.0, 1.0);
+
+    std::vector<gr_complex> weights;
+    for (int e = 0; e < elements; e++)
+        {
+            weights.emplace_back(dist(gen), dist(gen));
+        }
+    std::vector<std::vector<gr_complex>> inputs(elements, std::vector<gr_complex>(nsamples));
+    for (auto& input : inputs)
+        {
+            for (auto& x : input)
+                {
+                    x = gr_complex(dist(gen), dist(gen));
+                }
+        }
+
+    auto top_block = gr::make_top_block("Beamformer test");
+    auto bf = make_beamformer_sptr(elements, weights);
+    auto sink = gr::blocks::vector_sink_c::make();
+    for (int e = 0; e < elements; e++)
+        {
+            top_block->connect(gr::blocks::vector_source_c::make(inputs[e]), 0, bf, e);
+        }
+    top_block->connect(bf, 0, sink, 0);
+    top_block->run();
+
+    const std::vector<gr_complex> out = sink->data();
+    ASSERT_EQ(out.size(), static_cast<size_t>(nsamples));
+    for (int n = 0; n < nsamples; n++)
+        {
+            gr_complex expected(0.0, 0.0);
+            for (int e = 0; e < elements; e++)
+                {
+                    expected += inputs[e][n] * weights[e];
+                }
+            ASSERT_NEAR(std::abs(out[n] - expected), 0.0, 1e-3 * (1.0 + std::abs(expected))) << "at sample " << n;
+        }
+}
+
+
+TEST(BeamformerTest, PowerInversionCancelsInterference)
+{
+    const int elements = 4;
+    const int nsamples = 1 << 21;
+    std::mt19937 gen(2);
+    std::normal_distribution<float> noise(0.0, 0.01);
+    std::uniform_real_distribution<float> phase(0.0, 2.0 * M_PI);
+
+    // strong tone arriving with a different phase at each element, plus weak noise
+    std::vector<float> phases;
+    for (int e = 0; e < elements; e++)
+        {
+            phases.push_back(phase(gen));
+        }
+    std::vector<std::vector<gr_complex>> inputs(elements, std::vector<gr_complex>(nsamples));
+    for (int n = 0; n < nsamples; n++)
+        {
+            const float tone = 0.01 * static_cast<float>(n);
+            for (int e = 0; e < elements; e++)
+                {
+                    inputs[e][n] = std::polar(static_cast<float>(10.0), tone + phases[e]) + gr_complex(noise(gen), noise(gen));
+                }
+        }
+
+    auto top_block = gr::make_top_block("Beamformer test");
+    auto bf = make_beamformer_sptr(elements, std::vector<gr_complex>(), true, 4096, 16384);
+    auto sink = gr::blocks::vector_sink_c::make();
+    for (int e = 0; e < elements; e++)
+        {
+            top_block->connect(gr::blocks::vector_source_c::make(inputs[e]), 0, bf, e);
+        }
+    top_block->connect(bf, 0, sink, 0);
+    top_block->run();
+
+    const std::vector<gr_complex> out = sink->data();
+    ASSERT_EQ(out.size(), static_cast<size_t>(nsamples));
+    double power = 0.0;
+    const int tail = 100000;
+    for (int n = nsamples - tail; n < nsamples; n++)
+        {
+            power += std::norm(out[n]);
+        }
+    power /= tail;
+    // the interference power is 100; what is left must be near the noise floor
+    EXPECT_LT(power, 0.01);
+
+    const std::vector<gr_complex> weights = bf->get_weights();
+    ASSERT_EQ(weights.size(), static_cast<size_t>(elements));
+    EXPECT_NEAR(std::abs(weights[0] - gr_complex(1.0, 0.0)), 0.0, 1e-3);
+}
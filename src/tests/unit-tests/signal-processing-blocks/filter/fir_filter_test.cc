@@ -25,7 +25,7 @@
 #else
 #include <gnuradio/analog/sig_source_c.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "file_signal_source.h"
 #include "fir_filter.h"
 #include "gnss_block_factory.h"
@@ -36,7 +36,11 @@
 #include "interleaved_byte_to_complex_byte.h"
 #include "interleaved_short_to_complex_short.h"
 #include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 
 
 DEFINE_int32(filter_test_nsamples, 1000000, "Number of samples to filter in the tests (max: 2147483647)");
@@ -46,7 +50,7 @@ class FirFilterTest : public ::testing::Test
 protected:
     FirFilterTest() : item_size(sizeof(gr_complex))
     {
-        queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+        queue = std::make_shared<Control_Queue>();
         config = std::make_shared<InMemoryConfiguration>();
     }
     ~FirFilterTest() override = default;
@@ -56,7 +60,7 @@ protected:
     void configure_cbyte_gr_complex();
     void configure_gr_complex_gr_complex();
     void configure_cshort_cshort();
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
     size_t item_size;
@@ -382,3 +386,52 @@ TEST_F(FirFilterTest, ConnectAndRunCbyteGrcomplex)
     }) << "Failure running the top_block.";
     std::cout << "Filtered " << nsamples << " samples in " << elapsed_seconds.count() * 1e6 << " microseconds\n";
 }
+
+
+TEST_F(FirFilterTest, FftConvolutionMatchesTimeDomain)
+{
+    init();
+    configure_gr_complex_gr_complex();
+    config->supersede_property("InputFilter.number_of_taps", "101");
+    config->supersede_property("InputFilter.fft_min_taps", "64");
+    auto fft_filter = std::make_shared<FirFilter>(config.get(), "InputFilter", 1, 1);
+    config->supersede_property("InputFilter.fft_min_taps", "0");
+    auto time_filter = std::make_shared<FirFilter>(config.get(), "InputFilter", 1, 1);
+
+    std::vector<gr_complex> input(20000);
+    uint32_t state = 12345;
+    for (auto& sample : input)
+        {
+            state = state * 1664525U + 1013904223U;
+            const auto i = static_cast<float>(static_cast<int32_t>(state >> 16) - 32768) / 32768.0F;
+            state = state * 1664525U + 1013904223U;
+            const auto q = static_cast<float>(static_cast<int32_t>(state >> 16) - 32768) / 32768.0F;
+            sample = gr_complex(i, q);
+        }
+
+    top_block = gr::make_top_block("Fir filter test");
+    auto source = gr::blocks::vector_source_c::make(input);
+    auto fft_sink = gr::blocks::vector_sink_c::make();
+    auto time_sink = gr::blocks::vector_sink_c::make();
+    ASSERT_NO_THROW({
+        fft_filter->connect(top_block);
+        time_filter->connect(top_block);
+        top_block->connect(source, 0, fft_filter->get_left_block(), 0);
+        top_block->connect(source, 0, time_filter->get_left_block(), 0);
+        top_block->connect(fft_filter->get_right_block(), 0, fft_sink, 0);
+        top_block->connect(time_filter->get_right_block(), 0, time_sink, 0);
+    }) << "Failure connecting the top_block.";
+    EXPECT_NO_THROW(top_block->run());
+
+    // the FFT filter only outputs whole blocks, so its output can be shorter
+    const std::vector<gr_complex> fft_output = fft_sink->data();
+    const std::vector<gr_complex> time_output = time_sink->data();
+    ASSERT_GT(fft_output.size(), 0U);
+    ASSERT_LE(fft_output.size(), time_output.size());
+    float max_error = 0.0;
+    for (size_t n = 0; n < fft_output.size(); n++)
+        {
+            max_error = std::max(max_error, std::abs(fft_output[n] - time_output[n]));
+        }
+    EXPECT_LT(max_error, 1e-4);
+}
@@ -26,7 +26,7 @@
 #else
 #include <gnuradio/analog/sig_source_c.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "file_signal_source.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
@@ -45,7 +45,7 @@ class NotchFilterTest : public ::testing::Test
 protected:
     NotchFilterTest() : item_size(sizeof(gr_complex)), nsamples(FLAGS_notch_filter_test_nsamples)
     {
-        queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+        queue = std::make_shared<Control_Queue>();
         config = std::make_shared<InMemoryConfiguration>();
     }
     ~NotchFilterTest() override = default;
@@ -56,11 +56,11 @@ protected:
     void wait_message();
     void process_message();
     void stop_queue();
-    pmt::pmt_t message;
+    Control_Message message{};
 
     void init();
     void configure_gr_complex_gr_complex();
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
     size_t item_size;
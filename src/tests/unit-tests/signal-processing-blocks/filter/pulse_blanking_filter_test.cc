@@ -26,7 +26,7 @@
 #else
 #include <gnuradio/analog/sig_source_c.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "file_signal_source.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
@@ -35,7 +35,10 @@
 #include "in_memory_configuration.h"
 #include "pulse_blanking_filter.h"
 #include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
 #include <gtest/gtest.h>
+#include <vector>
 
 
 DEFINE_int32(pb_filter_test_nsamples, 1000000, "Number of samples to filter in the tests (max: 2147483647)");
@@ -45,7 +48,7 @@ class PulseBlankingFilterTest : public ::testing::Test
 protected:
     PulseBlankingFilterTest() : item_size(sizeof(gr_complex)), nsamples(FLAGS_pb_filter_test_nsamples)
     {
-        queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+        queue = std::make_shared<Control_Queue>();
         config = std::make_shared<InMemoryConfiguration>();
     }
     ~PulseBlankingFilterTest() override = default;
@@ -57,12 +60,12 @@ protected:
     void stop_queue();
     void init();
     void configure_gr_complex_gr_complex();
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
     size_t item_size;
     int nsamples;
-    pmt::pmt_t message;
+    Control_Message message{};
 };
 
 
@@ -200,3 +203,54 @@ TEST_F(PulseBlankingFilterTest, ConnectAndRunGrcomplex)
     ch_thread.join();
     std::cout << "Filtered " << nsamples << " gr_complex samples in " << elapsed_seconds.count() * 1e6 << " microseconds\n";
 }
+
+
+TEST_F(PulseBlankingFilterTest, CshortItemsMatchGrComplex)
+{
+    // noise, with a strong pulse after the noise floor estimation
+    const int length = 32;
+    const int segments = 200;
+    std::vector<int16_t> iq(2 * length * segments);
+    uint32_t state = 12345;
+    for (auto& component : iq)
+        {
+            state = state * 1664525U + 1013904223U;
+            component = static_cast<int16_t>(static_cast<int32_t>(state >> 24) - 128);
+        }
+    for (int n = 150 * length; n < 152 * length; n++)
+        {
+            iq[2 * n] = 20000;
+            iq[2 * n + 1] = -20000;
+        }
+    std::vector<gr_complex> samples(length * segments);
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            samples[n] = gr_complex(iq[2 * n], iq[2 * n + 1]);
+        }
+
+    top_block = gr::make_top_block("Pulse Blanking filter test");
+    auto complex_source = gr::blocks::vector_source_c::make(samples);
+    auto cshort_source = gr::blocks::vector_source_s::make(iq, false, 2);
+    auto complex_filter = make_pulse_blanking_cc(0.04, length, 100, 5000000);
+    auto cshort_filter = make_pulse_blanking_cc(0.04, length, 100, 5000000, true);
+    auto complex_sink = gr::blocks::vector_sink_c::make();
+    auto cshort_sink = gr::blocks::vector_sink_s::make(2);
+    ASSERT_NO_THROW({
+        top_block->connect(complex_source, 0, complex_filter, 0);
+        top_block->connect(complex_filter, 0, complex_sink, 0);
+        top_block->connect(cshort_source, 0, cshort_filter, 0);
+        top_block->connect(cshort_filter, 0, cshort_sink, 0);
+    }) << "Failure connecting the top_block.";
+    EXPECT_NO_THROW(top_block->run());
+
+    const std::vector<gr_complex> complex_output = complex_sink->data();
+    const std::vector<int16_t> cshort_output = cshort_sink->data();
+    ASSERT_EQ(2 * complex_output.size(), cshort_output.size());
+    ASSERT_GT(complex_output.size(), static_cast<size_t>(152 * length));
+    for (size_t n = 0; n < complex_output.size(); n++)
+        {
+            EXPECT_EQ(complex_output[n], gr_complex(cshort_output[2 * n], cshort_output[2 * n + 1]));
+        }
+    // the pulse is blanked
+    EXPECT_EQ(complex_output[150 * length], gr_complex(0.0, 0.0));
+}
@@ -0,0 +1,79 @@
+/*!
+ * \file allocation_counter_test.cc
+ * \brief This file implements unit tests for the Allocation_Counter class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "allocation_counter.h"
+#include <gtest/gtest.h>
+#include <boost/circular_buffer.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+TEST(AllocationCounterTest, CountsAllocationsOfTheScope)
+{
+    uint64_t allocations = 0;
+    {
+        const Allocation_Scope scope(&allocations);
+        auto v = std::vector<int>(100);
+        auto p = std::make_shared<double>(1.0);
+        v[0] = static_cast<int>(*p);
+    }
+    if (Allocation_Counter::enabled())
+        {
+            EXPECT_EQ(allocations, 2U);
+        }
+    else
+        {
+            EXPECT_EQ(allocations, 0U);
+        }
+}
+
+
+TEST(AllocationCounterTest, IgnoresOtherThreads)
+{
+    uint64_t allocations = 0;
+    std::thread worker;
+    {
+        const Allocation_Scope scope(nullptr);
+        worker = std::thread([&allocations]() {
+            const Allocation_Scope worker_scope(&allocations);
+            auto v = std::vector<int>(100);
+            v[0] = 1;
+        });
+    }
+    uint64_t main_allocations = 0;
+    {
+        const Allocation_Scope scope(&main_allocations);
+        worker.join();
+    }
+    EXPECT_EQ(main_allocations, 0U);
+    EXPECT_EQ(allocations, Allocation_Counter::enabled() ? 1U : 0U);
+}
+
+
+TEST(AllocationCounterTest, FullCircularBufferDoesNotAllocate)
+{
+    boost::circular_buffer<float> history;
+    history.set_capacity(10);
+    uint64_t allocations = 0;
+    {
+        const Allocation_Scope scope(&allocations);
+        for (int i = 0; i < 100; i++)
+            {
+                history.push_back(static_cast<float>(i));
+            }
+    }
+    EXPECT_EQ(allocations, 0U);
+}
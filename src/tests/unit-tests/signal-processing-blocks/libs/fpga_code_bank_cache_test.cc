@@ -0,0 +1,77 @@
+/*!
+ * \file fpga_code_bank_cache_test.cc
+ * \brief This file implements unit tests for the Fpga_Code_Bank_Cache class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fpga_code_bank_cache.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+
+TEST(FpgaCodeBankCacheTest, ReusesResidentCodes)
+{
+    Fpga_Code_Bank_Cache cache(2);
+    bool resident = true;
+    const uint32_t bank_1 = cache.assign(1, resident);
+    EXPECT_FALSE(resident);
+    const uint32_t bank_2 = cache.assign(2, resident);
+    EXPECT_FALSE(resident);
+    EXPECT_NE(bank_1, bank_2);
+
+    EXPECT_EQ(cache.assign(1, resident), bank_1);
+    EXPECT_TRUE(resident);
+    EXPECT_TRUE(cache.contains(2));
+    EXPECT_FALSE(cache.contains(3));
+}
+
+
+TEST(FpgaCodeBankCacheTest, EvictsTheLeastRecentlyUsedBank)
+{
+    Fpga_Code_Bank_Cache cache(2);
+    bool resident = false;
+    const uint32_t bank_1 = cache.assign(1, resident);
+    cache.assign(2, resident);
+    cache.assign(1, resident);  // 2 is now the least recently used
+
+    EXPECT_NE(cache.assign(3, resident), bank_1);
+    EXPECT_FALSE(resident);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+}
+
+
+TEST(FpgaCodeBankCacheTest, SkipsTheBusyBank)
+{
+    Fpga_Code_Bank_Cache cache(2);
+    bool resident = false;
+    const uint32_t bank_1 = cache.assign(1, resident);
+    cache.assign(2, resident);
+    cache.assign(2, resident);  // 1 is now the least recently used, but it is being searched
+
+    EXPECT_NE(cache.assign(3, resident, bank_1), bank_1);
+    EXPECT_TRUE(cache.contains(1));
+}
+
+
+TEST(FpgaCodeBankCacheTest, ForgetsEverythingAfterAReset)
+{
+    Fpga_Code_Bank_Cache cache(4);
+    bool resident = false;
+    cache.assign(1, resident);
+    EXPECT_TRUE(cache.contains(1));
+
+    Fpga_Code_Bank_Cache::invalidate_all();
+    EXPECT_FALSE(cache.contains(1));
+    cache.assign(1, resident);
+    EXPECT_FALSE(resident);
+}
@@ -0,0 +1,74 @@
+/*!
+ * \file gnss_circular_deque_test.cc
+ * \brief This file implements unit tests for the Gnss_circular_deque class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_circular_deque.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+
+
+TEST(GnssCircularDequeTest, DropsTheFirstElementsWhenFull)
+{
+    Gnss_circular_deque<int> deque(5, 3);  // stored in slots of 8 elements
+    EXPECT_EQ(deque.storage_size(), 24U);
+    for (int i = 0; i < 12; i++)
+        {
+            deque.push_back(1, i);
+        }
+    ASSERT_EQ(deque.size(1), 5U);
+    EXPECT_EQ(deque.size(0), 0U);
+    EXPECT_EQ(deque.size(2), 0U);
+    EXPECT_EQ(deque.front(1), 7);
+    EXPECT_EQ(deque.back(1), 11);
+    for (unsigned int pos = 0; pos < 5; pos++)
+        {
+            EXPECT_EQ(deque.get(1, pos), static_cast<int>(7 + pos));
+        }
+    deque.pop_front(1);
+    EXPECT_EQ(deque.size(1), 4U);
+    EXPECT_EQ(deque.front(1), 8);
+    EXPECT_THROW(deque.at(1, 4), std::out_of_range);
+    EXPECT_THROW(deque.at(3, 0), std::out_of_range);
+    deque.at(1, 3) = 42;
+    EXPECT_EQ(deque.back(1), 42);
+    deque.clear(1);
+    EXPECT_EQ(deque.size(1), 0U);
+    deque.reset();
+    EXPECT_EQ(deque.storage_size(), 0U);
+}
+
+
+TEST(GnssCircularDequeTest, IndexesEachChannelInItsOwnSlot)
+{
+    Gnss_circular_deque<int> deque(4, 2);
+    std::set<unsigned int> indexes;
+    for (int i = 0; i < 6; i++)
+        {
+            for (unsigned int ch = 0; ch < 2; ch++)
+                {
+                    const unsigned int index = deque.push_back(ch, i);
+                    EXPECT_EQ(index, deque.index(ch, deque.size(ch) - 1));
+                    EXPECT_EQ(index / 4, ch);
+                    if (i >= 2)
+                        {
+                            indexes.insert(index);
+                        }
+                }
+        }
+    EXPECT_EQ(indexes.size(), 8U);  // the last 4 elements of each channel use the whole storage
+    deque.reset(3, 1);
+    EXPECT_EQ(deque.storage_size(), 4U);
+    EXPECT_EQ(deque.size(0), 0U);
+}
@@ -0,0 +1,89 @@
+/*!
+ * \file gnss_code_table_test.cc
+ * \brief This file implements unit tests for the shared tables of packed
+ * primary codes
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_e1_signal_replica.h"
+#include "gnss_code_table.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+TEST(GnssCodeTableTest, GpsL1CaFirstChips)
+{
+    // First 10 chips of PRN 1 to 4, in octal, from IS-GPS-200 Table 3-Ia
+    const std::array<uint32_t, 4> first_chips = {01440, 01620, 01710, 01744};
+    for (uint32_t prn = 1; prn <= 4; prn++)
+        {
+            const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, prn);
+            ASSERT_NE(code, nullptr);
+            EXPECT_EQ(code->size(), 1023U);
+            for (uint32_t i = 0; i < 10; i++)
+                {
+                    const bool chip = ((first_chips[prn - 1] >> (9 - i)) & 1U) != 0U;
+                    EXPECT_EQ(code->value(i), chip ? 1 : -1);  // logic 1 is +1 in the replicas
+                }
+        }
+}
+
+
+TEST(GnssCodeTableTest, GalileoMemoryCodes)
+{
+    // E1-B PRN 1 starts with 0xF5
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GALILEO_E1_B, 1);
+    ASSERT_NE(code, nullptr);
+    EXPECT_EQ(code->size(), 4092U);
+    const std::array<int32_t, 8> expected = {-1, -1, -1, -1, 1, -1, 1, -1};
+    for (uint32_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ(code->value(i), expected[i]);
+        }
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GALILEO_E5A_I, 1)->size(), 10230U);
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GALILEO_E6_C, 50)->size(), 5115U);
+}
+
+
+TEST(GnssCodeTableTest, SharedAndBounded)
+{
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GPS_L5_I, 7), gnss_primary_code(Gnss_Code_Id::GPS_L5_I, 7));
+    EXPECT_NE(gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, 120), nullptr);
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, 0), nullptr);
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, 40), nullptr);
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::BEIDOU_B1I, 34), nullptr);
+    EXPECT_EQ(gnss_primary_code(Gnss_Code_Id::GALILEO_E1_C, 51), nullptr);
+}
+
+
+TEST(GnssCodeTableTest, GeneratorsExpandTheTable)
+{
+    const Gnss_Packed_Code* code = gnss_primary_code(Gnss_Code_Id::GPS_L1_CA, 5);
+    std::vector<int32_t> shifted(1023);
+    gps_l1_ca_code_gen_int(shifted, 5, 100);
+    for (uint32_t i = 0; i < 1023; i++)
+        {
+            EXPECT_EQ(shifted[i], code->value((i + 100) % 1023));
+        }
+
+    const Gnss_Packed_Code* e1c = gnss_primary_code(Gnss_Code_Id::GALILEO_E1_C, 11);
+    std::vector<float> sinboc(2 * 4092);
+    galileo_e1_code_gen_sinboc11_float(sinboc, {'1', 'C', '\0'}, 11);
+    for (uint32_t i = 0; i < 4092; i++)
+        {
+            EXPECT_EQ(sinboc[2 * i], static_cast<float>(e1c->value(i)));
+            EXPECT_EQ(sinboc[2 * i + 1], -static_cast<float>(e1c->value(i)));
+        }
+}
@@ -0,0 +1,168 @@
+/*!
+ * \file gnss_sdr_async_log_test.cc
+ * \brief This file implements unit tests for the Gnss_Sdr_Async_Logger and
+ * Gnss_Sdr_Log_Rate_Limit classes
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_async_log.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+class Recording_Logger : public google::base::Logger
+{
+public:
+    void Write(bool /*force_flush*/, time_t /*timestamp*/, const char* message, int message_len) override
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        messages.emplace_back(message, message_len);
+        std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+    }
+
+    void Flush() override
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        flushes++;
+    }
+
+    google::uint32 LogSize() override { return 0; }
+
+    std::vector<std::string> written()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return messages;
+    }
+
+    std::mutex mutex;
+    std::vector<std::string> messages;
+    int flushes{0};
+    int delay_us{0};
+};
+}  // namespace
+
+
+TEST(GnssSdrAsyncLoggerTest, WritesEveryMessageOfEachThreadInOrder)
+{
+    std::vector<Recording_Logger> loggers(NUM_SEVERITIES);
+    std::vector<google::base::Logger*> pointers;
+    for (auto& logger : loggers)
+        {
+            pointers.push_back(&logger);
+        }
+    const int threads = 4;
+    const int messages = 2000;
+    {
+        Gnss_Sdr_Async_Logger async_logger(pointers, threads * messages);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; t++)
+            {
+                producers.emplace_back([&async_logger, t]() {
+                    for (int i = 0; i < messages; i++)
+                        {
+                            const std::string message = std::to_string(t) + " " + std::to_string(i);
+                            async_logger.front_end(GLOG_INFO)->Write(false, 0, message.data(), static_cast<int>(message.size()));
+                        }
+                });
+            }
+        for (auto& producer : producers)
+            {
+                producer.join();
+            }
+        async_logger.flush();
+        EXPECT_EQ(async_logger.dropped(), 0U);
+    }
+    const std::vector<std::string> written = loggers[GLOG_INFO].written();
+    ASSERT_EQ(written.size(), static_cast<size_t>(threads * messages));
+    std::vector<int> next(threads, 0);
+    for (const auto& message : written)
+        {
+            const int t = std::stoi(message.substr(0, message.find(' ')));
+            EXPECT_EQ(std::stoi(message.substr(message.find(' ') + 1)), next[t]);
+            next[t]++;
+        }
+    EXPECT_GE(loggers[GLOG_INFO].flushes, 1);
+}
+
+
+TEST(GnssSdrAsyncLoggerTest, FullQueueDropsAndCounts)
+{
+    std::vector<Recording_Logger> loggers(NUM_SEVERITIES);
+    loggers[GLOG_WARNING].delay_us = 2000;
+    std::vector<google::base::Logger*> pointers;
+    for (auto& logger : loggers)
+        {
+            pointers.push_back(&logger);
+        }
+    uint64_t dropped = 0;
+    {
+        Gnss_Sdr_Async_Logger async_logger(pointers, 8);
+        const std::string message("warning");
+        for (int i = 0; i < 100; i++)
+            {
+                async_logger.front_end(GLOG_WARNING)->Write(false, 0, message.data(), static_cast<int>(message.size()));
+            }
+        dropped = async_logger.dropped();
+        EXPECT_GT(dropped, 0U);
+    }
+    EXPECT_EQ(loggers[GLOG_WARNING].written().size() + dropped, 100U);
+    const std::vector<std::string> notes = loggers[GLOG_INFO].written();
+    ASSERT_FALSE(notes.empty());
+    EXPECT_NE(notes.back().find("log messages dropped"), std::string::npos);
+}
+
+
+TEST(GnssSdrAsyncLoggerTest, FatalMessagesAreWrittenSynchronously)
+{
+    std::vector<Recording_Logger> loggers(NUM_SEVERITIES);
+    std::vector<google::base::Logger*> pointers;
+    for (auto& logger : loggers)
+        {
+            pointers.push_back(&logger);
+        }
+    Gnss_Sdr_Async_Logger async_logger(pointers, 16);
+    const std::string info("info");
+    const std::string fatal("fatal");
+    async_logger.front_end(GLOG_INFO)->Write(false, 0, info.data(), static_cast<int>(info.size()));
+    async_logger.front_end(GLOG_FATAL)->Write(true, 0, fatal.data(), static_cast<int>(fatal.size()));
+    EXPECT_EQ(loggers[GLOG_INFO].written(), std::vector<std::string>{info});
+    EXPECT_EQ(loggers[GLOG_FATAL].written(), std::vector<std::string>{fatal});
+    // glog then writes the fatal message to the lower severities
+    async_logger.front_end(GLOG_INFO)->Write(true, 0, fatal.data(), static_cast<int>(fatal.size()));
+    EXPECT_EQ(loggers[GLOG_INFO].written().size(), 2U);
+}
+
+
+TEST(GnssSdrLogRateLimitTest, OneMessagePerPeriod)
+{
+    int passed = 0;
+    for (int i = 0; i < 1000; i++)
+        {
+            if (GNSS_SDR_LOG_RATE_LIMIT_SITE().pass(60000))
+                {
+                    passed++;
+                }
+        }
+    EXPECT_EQ(passed, 1);
+
+    Gnss_Sdr_Log_Rate_Limit limit;
+    EXPECT_TRUE(limit.pass(20));
+    EXPECT_FALSE(limit.pass(20));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(limit.pass(20));
+}
@@ -0,0 +1,91 @@
+/*!
+ * \file gnss_sdr_block_stats_test.cc
+ * \brief This file implements unit tests for the work time histograms of
+ * the signal processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_block_stats.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+
+TEST(GnssBlockStatsTest, Histogram)
+{
+    Gnss_Block_Stats stats;
+    stats.record(500);             // < 1 us
+    stats.record(1500);            // [1, 2) us
+    stats.record(3000);            // [2, 4) us
+    stats.record(3999);            // [2, 4) us
+    stats.record(1000000);         // [512, 1024) us
+    stats.record(10000000000ULL);  // 10 s, beyond the last bound
+
+    const Gnss_Block_Stats::Snapshot s = stats.snapshot();
+    EXPECT_EQ(s.calls, 6U);
+    EXPECT_EQ(s.buckets[0], 1U);
+    EXPECT_EQ(s.buckets[1], 1U);
+    EXPECT_EQ(s.buckets[2], 2U);
+    EXPECT_EQ(s.buckets[10], 1U);
+    EXPECT_EQ(s.buckets[Gnss_Block_Stats::BUCKETS - 1], 1U);
+    EXPECT_EQ(s.total_ns, 500U + 1500U + 3000U + 3999U + 1000000U + 10000000000ULL);
+    EXPECT_EQ(s.max_ns, 10000000000ULL);
+
+    EXPECT_DOUBLE_EQ(Gnss_Block_Stats::bucket_upper_bound_s(0), 1e-6);
+    EXPECT_DOUBLE_EQ(Gnss_Block_Stats::bucket_upper_bound_s(2), 4e-6);
+    EXPECT_DOUBLE_EQ(s.quantile_s(0.5), 4e-6);
+    EXPECT_DOUBLE_EQ(s.quantile_s(0.8), 1024e-6);
+    EXPECT_DOUBLE_EQ(s.quantile_s(1.0), 10.0);
+    EXPECT_DOUBLE_EQ(Gnss_Block_Stats::Snapshot().quantile_s(0.5), 0.0);
+}
+
+
+TEST(GnssBlockStatsTest, TimerOnlyCountsWhenEnabled)
+{
+    Gnss_Block_Stats stats;
+    Gnss_Block_Stats::set_enabled(false);
+    {
+        const Gnss_Block_Work_Timer timer(&stats);
+    }
+    EXPECT_EQ(stats.snapshot().calls, 0U);
+
+    Gnss_Block_Stats::set_enabled(true);
+    {
+        const Gnss_Block_Work_Timer timer(&stats);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    {
+        const Gnss_Block_Work_Timer timer(nullptr);  // blocks without stats
+    }
+    Gnss_Block_Stats::set_enabled(false);
+    const Gnss_Block_Stats::Snapshot s = stats.snapshot();
+    EXPECT_EQ(s.calls, 1U);
+    EXPECT_GE(s.max_ns, 2000000U);
+}
+
+
+TEST(GnssBlockStatsTest, Registry)
+{
+    auto& registry = Gnss_Block_Stats_Registry::instance();
+    EXPECT_EQ(registry.find(-12345), nullptr);
+    std::shared_ptr<Gnss_Block_Stats> stats = registry.make(-12345);
+    stats->record(1000);
+    std::shared_ptr<Gnss_Block_Stats> found = registry.find(-12345);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->snapshot().calls, 1U);
+
+    // the registry does not keep the stats of destroyed blocks alive
+    stats.reset();
+    found.reset();
+    EXPECT_EQ(registry.find(-12345), nullptr);
+}
@@ -0,0 +1,88 @@
+/*!
+ * \file gnss_sdr_dump_writer_test.cc
+ * \brief This file implements unit tests for the Gnss_Sdr_Dump_Writer class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_dump_writer.h"
+#include "gnss_sdr_filesystem.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssSdrDumpWriterTest, WritesTheRecordsOfEachStreamInOrder)
+{
+    const std::string directory = "./dump_writer_test";
+    fs::create_directory(directory);
+    Gnss_Sdr_Dump_Writer writer;
+    const uint64_t records = 100000;
+    std::vector<std::thread> blocks;
+    for (int32_t channel = 0; channel < 4; channel++)
+        {
+            blocks.emplace_back([&writer, &directory, channel, records]() {
+                // a small ring, so that the blocks wait for the writer
+                auto stream = writer.open(directory + "/channel" + std::to_string(channel) + ".dat", 12, 1024);
+                ASSERT_TRUE(stream != nullptr);
+                for (uint64_t i = 0; i < records; i++)
+                    {
+                        Gnss_Sdr_Dump_Record<12> record;
+                        record.put(i).put(channel);
+                        stream->append(record.data());
+                    }
+                EXPECT_EQ(stream->close(), records * 12);
+            });
+        }
+    for (auto& block : blocks)
+        {
+            block.join();
+        }
+
+    for (int32_t channel = 0; channel < 4; channel++)
+        {
+            std::ifstream file(directory + "/channel" + std::to_string(channel) + ".dat", std::ios::binary);
+            uint64_t counter = 0;
+            int32_t value = 0;
+            for (uint64_t i = 0; i < records; i++)
+                {
+                    file.read(reinterpret_cast<char*>(&counter), sizeof(uint64_t));
+                    file.read(reinterpret_cast<char*>(&value), sizeof(int32_t));
+                    ASSERT_TRUE(file.good());
+                    ASSERT_EQ(counter, i);
+                    ASSERT_EQ(value, channel);
+                }
+            EXPECT_EQ(file.peek(), std::ifstream::traits_type::eof());
+        }
+
+    // one line per stream in the index
+    std::ifstream index(directory + "/gnss_sdr_dump_index.csv");
+    std::string line;
+    int lines = 0;
+    while (std::getline(index, line))
+        {
+            EXPECT_NE(line.find(",12,100000"), std::string::npos);
+            lines++;
+        }
+    EXPECT_EQ(lines, 4);
+    errorlib::error_code ec;
+    fs::remove_all(directory, ec);
+}
+
+
+TEST(GnssSdrDumpWriterTest, FailsOnAFileThatCannotBeCreated)
+{
+    Gnss_Sdr_Dump_Writer writer;
+    EXPECT_EQ(writer.open("./this_directory_does_not_exist/dump.dat", 8), nullptr);
+}
@@ -0,0 +1,75 @@
+/*!
+ * \file gnss_sdr_memory_accounting_test.cc
+ * \brief This file implements unit tests for the Gnss_Memory_Accounting class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_memory_accounting.h"
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cstdint>
+#include <thread>
+
+
+TEST(MemoryAccountingTest, ChargesVectorsToTheSubsystemOfTheScope)
+{
+    const int64_t before = Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Tracking).volk_bytes;
+    {
+        volk_gnsssdr::vector<float> buffer;
+        {
+            const Gnss_Memory_Tag_Scope scope(Gnss_Memory_Subsystem::Tracking);
+            buffer.resize(1000);
+        }
+        EXPECT_EQ(Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Tracking).volk_bytes - before, 1000 * static_cast<int64_t>(sizeof(float)));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % volk_gnsssdr_get_alignment(), 0U);
+    }
+    EXPECT_EQ(Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Tracking).volk_bytes, before);
+}
+
+
+TEST(MemoryAccountingTest, ReleasesFromAnotherThread)
+{
+    const int64_t before = Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Acquisition).volk_bytes;
+    auto* grid = new volk_gnsssdr::vector<double>();
+    {
+        const Gnss_Memory_Tag_Scope scope(Gnss_Memory_Subsystem::Acquisition);
+        grid->resize(64);
+    }
+    std::thread releaser([grid]() { delete grid; });
+    releaser.join();
+    EXPECT_EQ(Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Acquisition).volk_bytes, before);
+}
+
+
+TEST(MemoryAccountingTest, GaugeFollowsTheContainer)
+{
+    const int64_t before = Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Printers).gauge_bytes;
+    {
+        Gnss_Memory_Gauge gauge(Gnss_Memory_Subsystem::Printers);
+        gauge.set(300);
+        gauge.set(100);
+        const Gnss_Memory_Gauge copy(gauge);
+        EXPECT_EQ(Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Printers).gauge_bytes - before, 100);
+    }
+    EXPECT_EQ(Gnss_Memory_Accounting::snapshot(Gnss_Memory_Subsystem::Printers).gauge_bytes, before);
+}
+
+
+TEST(MemoryAccountingTest, SubsystemOfRole)
+{
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("Acquisition_1C"), Gnss_Memory_Subsystem::Acquisition);
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("Tracking_CH3"), Gnss_Memory_Subsystem::Tracking);
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("SignalSource1"), Gnss_Memory_Subsystem::Signal_Source);
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("InputFilter0"), Gnss_Memory_Subsystem::Signal_Conditioner);
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("PVT"), Gnss_Memory_Subsystem::PVT);
+    EXPECT_EQ(Gnss_Memory_Accounting::subsystem_of_role("Monitor"), Gnss_Memory_Subsystem::Other);
+}
@@ -0,0 +1,72 @@
+/*!
+ * \file gnss_sdr_monitor_ring_test.cc
+ * \brief This file implements unit tests for the shared memory ring of
+ * monitoring records
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_monitor_ring.h"
+#include "gnss_sdr_monitor_ring_writer.h"
+#include "gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+
+TEST(GnssMonitorRingTest, ReadersFollowTheWriter)
+{
+    const char* name = "/gnss-sdr-monitor-ring-test";
+    auto writer = std::make_unique<Gnss_Monitor_Ring_Writer>(name, GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro), 100);
+    ASSERT_TRUE(writer->is_open());
+
+    gnss_sdr_monitor_reader wrong_type{};
+    EXPECT_NE(gnss_sdr_monitor_ring_attach(&wrong_type, name, GNSS_SDR_MONITOR_RECORD_MONITOR_PVT, sizeof(Gnss_Synchro)), 0);
+    gnss_sdr_monitor_reader first{};
+    gnss_sdr_monitor_reader second{};
+    ASSERT_EQ(gnss_sdr_monitor_ring_attach(&first, name, GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro)), 0);
+    ASSERT_EQ(first.ring.header->capacity, 128U);
+
+    Gnss_Synchro record{};
+    for (int i = 0; i < 50; i++)
+        {
+            record.PRN = static_cast<uint32_t>(i);
+            writer->publish(&record);
+        }
+    // a reader only gets the records published after it attaches
+    ASSERT_EQ(gnss_sdr_monitor_ring_attach(&second, name, GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro)), 0);
+    for (int i = 50; i < 300; i++)
+        {
+            record.PRN = static_cast<uint32_t>(i);
+            writer->publish(&record);
+        }
+
+    // the first reader fell behind: it gets the last 128 records
+    Gnss_Synchro read{};
+    for (uint32_t i = 300 - 128; i < 300; i++)
+        {
+            ASSERT_EQ(gnss_sdr_monitor_ring_read(&first, &read), 1);
+            EXPECT_EQ(read.PRN, i);
+        }
+    EXPECT_EQ(gnss_sdr_monitor_ring_read(&first, &read), 0);
+    EXPECT_EQ(first.lost, 300U - 128U);
+    EXPECT_EQ(second.next, 50U);
+
+    // nothing new: returns after the timeout
+    gnss_sdr_monitor_ring_wait(&first, 10);
+    EXPECT_EQ(gnss_sdr_monitor_ring_read(&first, &read), 0);
+
+    // the receiver stops
+    writer.reset();
+    EXPECT_EQ(gnss_sdr_monitor_ring_read(&first, &read), -1);
+    gnss_sdr_monitor_ring_close(&first.ring);
+    gnss_sdr_monitor_ring_close(&second.ring);
+    EXPECT_NE(gnss_sdr_monitor_ring_attach(&first, name, GNSS_SDR_MONITOR_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro)), 0);
+}
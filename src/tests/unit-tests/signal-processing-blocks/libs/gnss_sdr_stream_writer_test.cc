@@ -0,0 +1,113 @@
+/*!
+ * \file gnss_sdr_stream_writer_test.cc
+ * \brief This file implements unit tests for the Gnss_Stream_Writer class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_stream_writer.h"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Fills a pipe, so that its consumer looks stalled. Returns the bytes written.
+size_t fill_pipe(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    size_t filled = 0;
+    const char byte = 'x';
+    while (write(fd, &byte, 1) == 1)
+        {
+            filled++;
+        }
+    return filled;
+}
+
+
+std::string read_bytes(int fd, size_t size)
+{
+    std::string data;
+    std::vector<char> buffer(size);
+    while (data.size() < size)
+        {
+            const ssize_t n = read(fd, buffer.data(), size - data.size());
+            if (n <= 0)
+                {
+                    break;
+                }
+            data.append(buffer.data(), static_cast<size_t>(n));
+        }
+    return data;
+}
+
+
+std::string message(int i)
+{
+    return "$MESSAGE," + std::to_string(100 + i) + "\r\n";  // 15 bytes
+}
+}  // namespace
+
+
+TEST(GnssStreamWriterTest, WritesEveryMessageInOrder)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const int n_messages = 200;
+    std::string expected;
+    {
+        Gnss_Stream_Writer writer;
+        ASSERT_TRUE(writer.add(fds[1], "test pipe"));
+        EXPECT_FALSE(writer.add(fds[1], "test pipe"));
+        for (int i = 0; i < n_messages; i++)
+            {
+                EXPECT_TRUE(writer.write(fds[1], message(i).data(), message(i).size()));
+                expected += message(i);
+            }
+        writer.remove(fds[1]);  // waits for the pending bytes
+        EXPECT_FALSE(writer.write(fds[1], message(0).data(), message(0).size()));
+    }
+    EXPECT_EQ(read_bytes(fds[0], expected.size()), expected);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+
+TEST(GnssStreamWriterTest, DropsWholeMessagesOfStalledStreams)
+{
+    for (const auto policy : {Gnss_Stream_Writer::Drop_Policy::Oldest, Gnss_Stream_Writer::Drop_Policy::Newest})
+        {
+            int fds[2];
+            ASSERT_EQ(pipe(fds), 0);
+            const size_t filled = fill_pipe(fds[1]);
+            Gnss_Stream_Writer writer;
+            ASSERT_TRUE(writer.add(fds[1], "stalled pipe", 50, policy));
+            EXPECT_FALSE(writer.write(fds[1], std::string(51, 'y').data(), 51));  // never fits
+            for (int i = 0; i < 10; i++)
+                {
+                    writer.write(fds[1], message(i).data(), message(i).size());
+                }
+            EXPECT_EQ(writer.dropped(fds[1]), 8U);
+
+            // the consumer wakes up
+            EXPECT_EQ(read_bytes(fds[0], filled), std::string(filled, 'x'));
+            const std::string kept = policy == Gnss_Stream_Writer::Drop_Policy::Oldest ? message(7) + message(8) + message(9) : message(0) + message(1) + message(2);
+            EXPECT_EQ(read_bytes(fds[0], kept.size()), kept);
+            writer.remove(fds[1]);
+            close(fds[0]);
+            close(fds[1]);
+        }
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file gnss_sdr_thread_pool_test.cc
+ * \brief This file implements unit tests for the Gnss_Thread_Pool class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssThreadPoolTest, ParallelForVisitsAllChunksOnce)
+{
+    Gnss_Thread_Pool pool(4);
+    std::vector<int> visits(1000, 0);
+    pool.parallel_for(visits.size(), [&visits](size_t i) { visits[i]++; });
+    for (const auto v : visits)
+        {
+            EXPECT_EQ(v, 1);
+        }
+}
+
+
+TEST(GnssThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    Gnss_Thread_Pool pool(2);
+    std::atomic<int> count{0};
+    pool.parallel_for(8, [&pool, &count](size_t) {
+        pool.parallel_for(8, [&count](size_t) { count++; });
+    });
+    EXPECT_EQ(count.load(), 64);
+}
+
+
+TEST(GnssThreadPoolTest, SubmittedTasksRunBeforeDestruction)
+{
+    std::atomic<int> count{0};
+    {
+        Gnss_Thread_Pool pool(3);
+        for (int i = 0; i < 100; i++)
+            {
+                pool.submit([&count]() { count++; });
+            }
+    }
+    EXPECT_EQ(count.load(), 100);
+}
+
+
+TEST(GnssThreadPoolTest, HigherPriorityTasksRunFirst)
+{
+    Gnss_Thread_Pool pool(1);
+    std::mutex gate_mutex;
+    std::vector<int> order;
+    {
+        // Keep the only worker busy while the rest of tasks are queued
+        std::unique_lock<std::mutex> gate(gate_mutex);
+        pool.submit([&gate_mutex]() { std::lock_guard<std::mutex> lock(gate_mutex); });
+        while (pool.pending() != 0)
+            {
+                std::this_thread::yield();
+            }
+        pool.submit([&order]() { order.push_back(0); }, 0);
+        pool.submit([&order]() { order.push_back(1); }, 0);
+        pool.submit([&order]() { order.push_back(2); }, 5);
+        EXPECT_EQ(pool.pending(), 3U);
+    }
+    while (pool.pending() != 0 || order.size() < 3)
+        {
+            std::this_thread::yield();
+        }
+    ASSERT_EQ(order.size(), 3U);
+    EXPECT_EQ(order[0], 2);
+    EXPECT_EQ(order[1], 0);
+    EXPECT_EQ(order[2], 1);
+}
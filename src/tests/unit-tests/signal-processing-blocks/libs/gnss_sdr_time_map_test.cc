@@ -0,0 +1,134 @@
+/*!
+ * \file gnss_sdr_time_map_test.cc
+ * \brief This file implements unit tests for the Gnss_Time_Map class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_time_map.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+
+namespace
+{
+Gnss_Time_Map::Segment time_map_segment(uint64_t first_sample, double tow_ms, int32_t week)
+{
+    Gnss_Time_Map::Segment segment;
+    segment.first_sample = first_sample;
+    segment.tow_ms = tow_ms;
+    segment.ms_per_sample = 1000.0 / 4e6;
+    segment.week = week;
+    return segment;
+}
+}  // namespace
+
+
+TEST(GnssTimeMapTest, InterpolatesInTheSegmentOfTheSample)
+{
+    Gnss_Time_Map time_map;
+    GnssTime time{};
+    EXPECT_EQ(time_map.version(), 0U);
+    EXPECT_FALSE(time_map.time_at(1000, time));
+
+    time_map.publish(time_map_segment(4000, 100000.0, 2200));
+    time_map.publish(time_map_segment(4004000, 101000.5, 2200));
+    EXPECT_EQ(time_map.version(), 2U);
+
+    EXPECT_FALSE(time_map.time_at(3999, time));
+    ASSERT_TRUE(time_map.time_at(6000, time));
+    EXPECT_EQ(time.week, 2200);
+    EXPECT_EQ(time.tow_ms, 100000);
+    EXPECT_DOUBLE_EQ(time.tow_ms_fraction, 0.5);
+
+    // the second segment corrects the drift of the first one
+    ASSERT_TRUE(time_map.time_at(4004000, time));
+    EXPECT_EQ(time.tow_ms, 101000);
+    EXPECT_DOUBLE_EQ(time.tow_ms_fraction, 0.5);
+}
+
+
+TEST(GnssTimeMapTest, FindsTheNewestSegmentBeforeASample)
+{
+    Gnss_Time_Map time_map(4);
+    Gnss_Time_Map::Segment segment;
+    EXPECT_FALSE(time_map.segment_before(100, segment));
+    for (uint64_t i = 1; i <= 6; i++)
+        {
+            time_map.publish(time_map_segment(i * 1000, static_cast<double>(i), 1));
+        }
+    ASSERT_TRUE(time_map.segment_before(3500, segment));
+    EXPECT_EQ(segment.first_sample, 3000U);
+    EXPECT_EQ(segment.version, 3U);
+    ASSERT_TRUE(time_map.segment_before(100000, segment));
+    EXPECT_EQ(segment.version, 6U);
+    // only the last 4 segments are kept
+    EXPECT_FALSE(time_map.segment_before(2500, segment));
+}
+
+
+TEST(GnssTimeMapTest, RestartsWhenTheSamplesGoBack)
+{
+    Gnss_Time_Map time_map;
+    Gnss_Time_Map::Segment segment;
+    time_map.publish(time_map_segment(5000, 10.0, 1));
+    time_map.publish(time_map_segment(1000, 20.0, 1));
+    EXPECT_EQ(time_map.version(), 2U);
+    EXPECT_FALSE(time_map.segment_before(1000, segment));
+    ASSERT_TRUE(time_map.segment_before(6000, segment));
+    EXPECT_EQ(segment.first_sample, 1000U);
+}
+
+
+TEST(GnssTimeMapTest, CrossesTheEndOfTheWeek)
+{
+    Gnss_Time_Map time_map;
+    GnssTime time{};
+    time_map.publish(time_map_segment(0, 604799999.0, 2200));
+    ASSERT_TRUE(time_map.time_at(8000, time));
+    EXPECT_EQ(time.week, 2201);
+    EXPECT_EQ(time.tow_ms, 1);
+}
+
+
+TEST(GnssTimeMapTest, ReadersSeeCompleteSegments)
+{
+    Gnss_Time_Map time_map(8);
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&]() {
+        uint64_t seen = 0;
+        while (!done.load())
+            {
+                const uint64_t version = time_map.version();
+                if (version == seen)
+                    {
+                        continue;
+                    }
+                Gnss_Time_Map::Segment segment;
+                if (!time_map.segment_before(UINT64_MAX, segment) or segment.version < version or
+                    segment.tow_ms != static_cast<double>(segment.first_sample) or segment.week != static_cast<int32_t>(segment.first_sample))
+                    {
+                        errors++;
+                    }
+                seen = segment.version;
+            }
+    });
+    for (uint64_t i = 1; i <= 20000; i++)
+        {
+            time_map.publish(time_map_segment(i, static_cast<double>(i), static_cast<int32_t>(i)));
+        }
+    done = true;
+    reader.join();
+    EXPECT_EQ(errors.load(), 0);
+}
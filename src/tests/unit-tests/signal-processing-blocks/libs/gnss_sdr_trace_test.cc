@@ -0,0 +1,70 @@
+/*!
+ * \file gnss_sdr_trace_test.cc
+ * \brief This file implements unit tests for the Gnss_Sdr_Tracer class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_trace.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+TEST(GnssSdrTracerTest, ZonesAreOnlyRecordedWhileStarted)
+{
+    Gnss_Sdr_Tracer& tracer = Gnss_Sdr_Tracer::instance();
+    tracer.start(100);
+    {
+        const Gnss_Sdr_Trace_Zone zone("outer");
+        const Gnss_Sdr_Trace_Zone inner("inner");
+    }
+    std::thread other([]() { const Gnss_Sdr_Trace_Zone zone("other_thread"); });
+    other.join();
+    tracer.stop();
+    {
+        const Gnss_Sdr_Trace_Zone zone("after_stop");
+    }
+    EXPECT_EQ(tracer.events(), 3U);
+    EXPECT_EQ(tracer.dropped(), 0U);
+
+    std::ostringstream out;
+    tracer.write(out);
+    const std::string json = out.str();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\""), 0U);
+    EXPECT_NE(json.find(R"("name":"outer","ph":"X")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"inner","ph":"X")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"other_thread","ph":"X")"), std::string::npos);
+    EXPECT_EQ(json.find("after_stop"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"thread_name","ph":"M")"), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+
+TEST(GnssSdrTracerTest, FullBuffersCountDroppedZones)
+{
+    Gnss_Sdr_Tracer& tracer = Gnss_Sdr_Tracer::instance();
+    tracer.start(5);
+    for (int i = 0; i < 8; i++)
+        {
+            const Gnss_Sdr_Trace_Zone zone("loop");
+        }
+    tracer.stop();
+    EXPECT_EQ(tracer.events(), 5U);
+    EXPECT_EQ(tracer.dropped(), 3U);
+
+    // a new start discards the previous zones
+    tracer.start(5);
+    tracer.stop();
+    EXPECT_EQ(tracer.events(), 0U);
+    EXPECT_EQ(tracer.dropped(), 0U);
+}
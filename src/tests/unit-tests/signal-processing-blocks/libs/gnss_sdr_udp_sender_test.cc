@@ -0,0 +1,63 @@
+/*!
+ * \file gnss_sdr_udp_sender_test.cc
+ * \brief This file implements unit tests for the Gnss_Udp_Sender class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_udp_sender.h"
+#include <boost/asio.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <vector>
+
+
+TEST(GnssUdpSenderTest, SendsEveryDatagramInOrder)
+{
+#if USE_BOOST_ASIO_IO_CONTEXT
+    boost::asio::io_context io_context;
+#else
+    boost::asio::io_service io_context;
+#endif
+    boost::asio::ip::udp::socket receiver(io_context,
+        boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    const int n_datagrams = 200;
+    {
+        Gnss_Udp_Sender sender({receiver.local_endpoint()});
+        for (int i = 0; i < n_datagrams; i++)
+            {
+                std::string datagram = sender.get_buffer();
+                EXPECT_TRUE(datagram.empty());
+                datagram = "datagram " + std::to_string(i);
+                sender.send(std::move(datagram));
+            }
+        EXPECT_EQ(sender.dropped(), 0U);
+    }  // the destructor sends what is still queued
+
+    std::array<char, 64> buffer{};
+    for (int i = 0; i < n_datagrams; i++)
+        {
+            const size_t length = receiver.receive(boost::asio::buffer(buffer));
+            EXPECT_EQ(std::string(buffer.data(), length), "datagram " + std::to_string(i));
+        }
+}
+
+
+TEST(GnssUdpSenderTest, IgnoresDatagramsWithoutEndpoints)
+{
+    Gnss_Udp_Sender idle({}, 4);
+    for (int i = 0; i < 10; i++)
+        {
+            idle.send("x");
+        }
+    EXPECT_EQ(idle.dropped(), 0U);
+}
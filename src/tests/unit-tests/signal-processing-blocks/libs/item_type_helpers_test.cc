@@ -19,6 +19,7 @@
 #include "item_type_helpers.h"
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <array>
 #include <random>
 
 class ItemTypeHelpersTest : public ::testing::Test
@@ -248,3 +249,31 @@ TEST_F(ItemTypeHelpersTest, CheckConversionsComplex)
     converter(float_array_out.data(), float_array_in.data(), N);
     EXPECT_TRUE(std::equal(float_array_in.begin(), float_array_in.begin() + N, float_array_out.begin()));
 }
+
+
+TEST_F(ItemTypeHelpersTest, CheckCompileTimeConversions)
+{
+    // same results as the converters selected from the item type names
+    std::array<int16_t, 2 * N> short_array_ref{};
+    convert_items(short_array_out.data(), byte_array_in.data(), 2 * N);
+    make_vector_converter("cbyte", "cshort")(short_array_ref.data(), byte_array_in.data(), N);
+    EXPECT_TRUE(std::equal(short_array_out.begin(), short_array_out.end(), short_array_ref.begin()));
+
+    std::array<float, 2 * N> float_array_ref{};
+    convert_items(float_array_out.data(), short_array_in.data(), N);
+    make_vector_converter("short", "float")(float_array_ref.data(), short_array_in.data(), N);
+    EXPECT_TRUE(std::equal(float_array_out.begin(), float_array_out.begin() + N, float_array_ref.begin()));
+
+    convert_items(byte_array_out.data(), float_array_in.data(), 2 * N);
+    std::array<int8_t, 2 * N> byte_array_ref{};
+    make_vector_converter("gr_complex", "cbyte")(byte_array_ref.data(), float_array_in.data(), N);
+    EXPECT_TRUE(std::equal(byte_array_out.begin(), byte_array_out.end(), byte_array_ref.begin()));
+
+    // types without a VOLK kernel are cast
+    std::array<double, 2 * N> double_array_out{};
+    convert_items(double_array_out.data(), short_array_in.data(), 2 * N);
+    for (size_t i = 0; i < 2 * N; i++)
+        {
+            EXPECT_EQ(double_array_out[i], static_cast<double>(short_array_in[i]));
+        }
+}
@@ -0,0 +1,148 @@
+/*!
+ * \file obs_carrier_smoothing_test.cc
+ * \brief Tests the carrier smoothing of the pseudoranges of an epoch
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include "gnss_synchro.h"
+#include "obs_carrier_smoothing.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+Gnss_Synchro make_obs(char system, const char* signal, uint32_t prn, double pseudorange_m, double phase_m, double freq_hz)
+{
+    Gnss_Synchro obs{};
+    obs.System = system;
+    std::memcpy(static_cast<void*>(obs.Signal), signal, 3);
+    obs.PRN = prn;
+    obs.Flag_valid_pseudorange = true;
+    obs.Pseudorange_m = pseudorange_m;
+    obs.Carrier_phase_rads = phase_m * TWO_PI * freq_hz / SPEED_OF_LIGHT_M_S;
+    return obs;
+}
+}  // namespace
+
+
+TEST(ObsCarrierSmoothingTest, MatchesHatchFilter)
+{
+    const double M = 100.0;
+    const uint32_t nchannels = 4;
+    Obs_Carrier_Smoothing smoothing(nchannels, M, false);
+    std::mt19937 gen(7);
+    std::normal_distribution<double> noise(0.0, 3.0);
+
+    std::vector<double> last_smooth(nchannels, 0.0);
+    std::vector<double> last_phase(nchannels, 0.0);
+    std::vector<bool> lock(nchannels, false);
+    for (int k = 0; k < 500; k++)
+        {
+            std::vector<Gnss_Synchro> epoch(nchannels);
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    const double range = 2.0e7 + 1000.0 * ch + 5.0 * k;
+                    epoch[ch] = make_obs('G', "1C", ch + 1, range + noise(gen), range, FREQ1);
+                    epoch[ch].Flag_valid_pseudorange = !(ch == 2 && k % 50 == 10);  // loss of lock
+                }
+            std::vector<Gnss_Synchro> expected = epoch;
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    if (!expected[ch].Flag_valid_pseudorange)
+                        {
+                            lock[ch] = false;
+                            continue;
+                        }
+                    const double phase = expected[ch].Carrier_phase_rads * (SPEED_OF_LIGHT_M_S / FREQ1) / TWO_PI;
+                    if (lock[ch])
+                        {
+                            expected[ch].Pseudorange_m = ((M - 1.0) / M) * (last_smooth[ch] + phase - last_phase[ch]) + expected[ch].Pseudorange_m / M;
+                        }
+                    last_smooth[ch] = expected[ch].Pseudorange_m;
+                    last_phase[ch] = phase;
+                    lock[ch] = true;
+                }
+            smoothing.smooth(epoch);
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    ASSERT_NEAR(epoch[ch].Pseudorange_m, expected[ch].Pseudorange_m, 1e-6) << "ch=" << ch << " k=" << k;
+                }
+        }
+}
+
+
+TEST(ObsCarrierSmoothingTest, RestartsOnSatelliteChange)
+{
+    Obs_Carrier_Smoothing smoothing(1, 10.0, false);
+    std::vector<Gnss_Synchro> epoch{make_obs('G', "1C", 5, 2.0e7, 2.0e7, FREQ1)};
+    smoothing.smooth(epoch);
+    epoch[0] = make_obs('G', "1C", 5, 2.0e7 + 10.0, 2.0e7, FREQ1);
+    smoothing.smooth(epoch);
+    EXPECT_NEAR(epoch[0].Pseudorange_m, 2.0e7 + 1.0, 1e-6);  // smoothed
+
+    epoch[0] = make_obs('G', "1C", 9, 2.3e7, 2.3e7, FREQ1);
+    smoothing.smooth(epoch);
+    EXPECT_DOUBLE_EQ(epoch[0].Pseudorange_m, 2.3e7);  // the filter restarts
+}
+
+
+TEST(ObsCarrierSmoothingTest, DivergenceFree)
+{
+    // the ionospheric delay of the code grows, and that of the phase decreases
+    const double M = 100.0;
+    const double gamma = (FREQ1 * FREQ1) / (FREQ5 * FREQ5);
+    Obs_Carrier_Smoothing single(2, M, false);
+    Obs_Carrier_Smoothing divergence_free(2, M, true);
+    double single_error = 0.0;
+    double divergence_free_error = 0.0;
+    for (int k = 0; k < 1000; k++)
+        {
+            const double range = 2.0e7 + 10.0 * k;
+            const double iono_l1 = 5.0 + 0.01 * k;
+            const double iono_l5 = gamma * iono_l1;
+            std::vector<Gnss_Synchro> epoch{
+                make_obs('G', "1C", 3, range + iono_l1, range - iono_l1, FREQ1),
+                make_obs('G', "L5", 3, range + iono_l5, range - iono_l5, FREQ5)};
+            std::vector<Gnss_Synchro> epoch_df = epoch;
+            single.smooth(epoch);
+            divergence_free.smooth(epoch_df);
+            single_error = epoch[0].Pseudorange_m - (range + iono_l1);
+            divergence_free_error = epoch_df[0].Pseudorange_m - (range + iono_l1);
+            ASSERT_NEAR(epoch_df[1].Pseudorange_m, range + iono_l5, 1e-5);
+        }
+    // the single frequency filter lags 2 * (M - 1) times the iono rate
+    EXPECT_NEAR(single_error, -2.0 * (M - 1.0) * 0.01, 0.05);
+    EXPECT_NEAR(divergence_free_error, 0.0, 1e-5);
+}
+
+
+TEST(ObsCarrierSmoothingTest, CarrierFrequency)
+{
+    Gnss_Synchro obs{};
+    std::memcpy(static_cast<void*>(obs.Signal), "1B", 3);
+    EXPECT_DOUBLE_EQ(Obs_Carrier_Smoothing::carrier_frequency_hz(obs), FREQ1);
+    std::memcpy(static_cast<void*>(obs.Signal), "7X", 3);
+    EXPECT_DOUBLE_EQ(Obs_Carrier_Smoothing::carrier_frequency_hz(obs), FREQ7);
+    std::memcpy(static_cast<void*>(obs.Signal), "B3", 3);
+    EXPECT_DOUBLE_EQ(Obs_Carrier_Smoothing::carrier_frequency_hz(obs), FREQ3_BDS);
+    std::memcpy(static_cast<void*>(obs.Signal), "2G", 3);
+    EXPECT_DOUBLE_EQ(Obs_Carrier_Smoothing::carrier_frequency_hz(obs), FREQ2_GLO);
+    std::memcpy(static_cast<void*>(obs.Signal), "XX", 3);
+    EXPECT_DOUBLE_EQ(Obs_Carrier_Smoothing::carrier_frequency_hz(obs), 0.0);
+}
@@ -0,0 +1,137 @@
+/*!
+ * \file obs_history_test.cc
+ * \brief Tests the interpolation of the tracking observables history against
+ * a linear scan of the history
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "obs_history.h"
+#include <boost/circular_buffer.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// interpolation by scanning the whole history for the nearest observable
+bool scan_interpolation(const boost::circular_buffer<Gnss_Synchro>& history, uint64_t rx_clock, double max_distance_s, Gnss_Synchro& interpolated_obs)
+{
+    int32_t nearest = -1;
+    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < history.size(); i++)
+        {
+            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(history[i].Tracking_sample_counter));
+            if (old_abs_diff > abs_diff)
+                {
+                    old_abs_diff = abs_diff;
+                    nearest = static_cast<int32_t>(i);
+                }
+        }
+    if (nearest == -1 || static_cast<double>(old_abs_diff) / static_cast<double>(history[nearest].fs) >= max_distance_s)
+        {
+            return false;
+        }
+    const int32_t neighbor = rx_clock > history[nearest].Tracking_sample_counter ? nearest + 1 : nearest - 1;
+    if (neighbor >= static_cast<int32_t>(history.size()) || neighbor < 0)
+        {
+            return false;
+        }
+    const Gnss_Synchro& t1 = history[std::min(nearest, neighbor)];
+    const Gnss_Synchro& t2 = history[std::max(nearest, neighbor)];
+    interpolated_obs = history[nearest];
+    const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
+    const double time_factor = (T_rx_s - t1.RX_time) / (t2.RX_time - t1.RX_time);
+    interpolated_obs.Carrier_phase_rads = t1.Carrier_phase_rads + (t2.Carrier_phase_rads - t1.Carrier_phase_rads) * time_factor;
+    interpolated_obs.Carrier_Doppler_hz = t1.Carrier_Doppler_hz + (t2.Carrier_Doppler_hz - t1.Carrier_Doppler_hz) * time_factor;
+    interpolated_obs.interp_TOW_ms = static_cast<double>(t1.TOW_at_current_symbol_ms) + (static_cast<double>(t2.TOW_at_current_symbol_ms) - static_cast<double>(t1.TOW_at_current_symbol_ms)) * time_factor;
+    return true;
+}
+}  // namespace
+
+
+TEST(ObsHistoryTest, MatchesScan)
+{
+    const uint32_t nchannels = 7;
+    const uint32_t capacity = 50;
+    const int64_t fs = 4000000;
+    const double T_rx_step_s = 0.02;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<uint64_t> jitter(0, 400);
+
+    Obs_History history(capacity, nchannels);
+    std::vector<boost::circular_buffer<Gnss_Synchro>> reference(nchannels, boost::circular_buffer<Gnss_Synchro>(capacity));
+    std::vector<uint64_t> sample_counter(nchannels);
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            sample_counter[ch] = 1000 * ch;
+        }
+
+    std::vector<Gnss_Synchro> epoch;
+    uint64_t rx_clock = 40000;
+    for (int32_t step = 0; step < 300; step++)
+        {
+            // channels get 1 ms observables, channel 0 stops for a while to leave a gap
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    while (sample_counter[ch] < rx_clock + 2 * 4000 && !(ch == 0 && step > 100 && step < 120))
+                        {
+                            Gnss_Synchro obs{};
+                            obs.PRN = ch + 1;
+                            obs.fs = fs;
+                            obs.Tracking_sample_counter = sample_counter[ch];
+                            obs.Carrier_phase_rads = 0.001 * static_cast<double>(sample_counter[ch]);
+                            obs.Carrier_Doppler_hz = 1000.0 + 0.5 * static_cast<double>(step);
+                            obs.TOW_at_current_symbol_ms = 1000 + static_cast<uint32_t>(sample_counter[ch] / 4000);
+                            const double rx_time_s = static_cast<double>(sample_counter[ch]) / static_cast<double>(fs);
+                            history.push_back(ch, obs, rx_time_s);
+                            obs.RX_time = rx_time_s;
+                            reference[ch].push_back(obs);
+                            sample_counter[ch] += 4000 + jitter(gen);
+                        }
+                }
+
+            const int32_t n_valid = history.interpolate(rx_clock, T_rx_step_s, epoch);
+            ASSERT_EQ(epoch.size(), nchannels);
+            int32_t n_expected = 0;
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    Gnss_Synchro expected{};
+                    const bool valid = scan_interpolation(reference[ch], rx_clock, T_rx_step_s, expected);
+                    ASSERT_EQ(epoch[ch].fs != 0, valid) << "ch " << ch << " step " << step;
+                    if (valid)
+                        {
+                            n_expected++;
+                            EXPECT_EQ(epoch[ch].Tracking_sample_counter, expected.Tracking_sample_counter);
+                            EXPECT_DOUBLE_EQ(epoch[ch].Carrier_phase_rads, expected.Carrier_phase_rads);
+                            EXPECT_DOUBLE_EQ(epoch[ch].Carrier_Doppler_hz, expected.Carrier_Doppler_hz);
+                            EXPECT_DOUBLE_EQ(epoch[ch].interp_TOW_ms, expected.interp_TOW_ms);
+                            EXPECT_DOUBLE_EQ(epoch[ch].RX_time, expected.RX_time);
+                        }
+                    else
+                        {
+                            EXPECT_EQ(epoch[ch].Channel_ID, static_cast<int32_t>(ch));
+                        }
+                }
+            EXPECT_EQ(n_valid, n_expected);
+            rx_clock += 80000;  // 20 ms
+        }
+
+    history.clear(3);
+    EXPECT_EQ(history.size(3), 0U);
+    history.interpolate(rx_clock, T_rx_step_s, epoch);
+    EXPECT_EQ(epoch[3].fs, 0);
+}
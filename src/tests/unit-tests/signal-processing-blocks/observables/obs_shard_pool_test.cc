@@ -0,0 +1,124 @@
+/*!
+ * \file obs_shard_pool_test.cc
+ * \brief Tests that the observables computed by channel shards in worker
+ * threads are those computed in a single thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "obs_history.h"
+#include "obs_shard_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+TEST(ObsShardPoolTest, RunsEveryChannelOnce)
+{
+    for (uint32_t threads = 1; threads <= 5; threads++)
+        {
+            const uint32_t nchannels = 13;
+            Obs_Shard_Pool pool(threads, nchannels);
+            EXPECT_LE(pool.shards(), threads);
+            std::vector<std::atomic<int32_t>> runs(nchannels);
+            for (int32_t k = 0; k < 100; k++)
+                {
+                    pool.run([&](uint32_t first_ch, uint32_t last_ch) {
+                        for (uint32_t ch = first_ch; ch < last_ch; ch++)
+                            {
+                                runs[ch]++;
+                            }
+                    });
+                }
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    EXPECT_EQ(runs[ch], 100) << "threads " << threads << " ch " << ch;
+                }
+        }
+}
+
+
+TEST(ObsShardPoolTest, SameAsSingleThread)
+{
+    const uint32_t nchannels = 200;
+    const uint32_t capacity = 50;
+    const int64_t fs = 4000000;
+    const double T_rx_step_s = 0.02;
+    std::mt19937 gen(99);
+    std::uniform_int_distribution<uint64_t> jitter(0, 400);
+
+    Obs_History single(capacity, nchannels);
+    Obs_History sharded(capacity, nchannels);
+    Obs_Shard_Pool pool(4, nchannels);
+    std::vector<uint64_t> sample_counter(nchannels);
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            sample_counter[ch] = 100 * ch;
+        }
+
+    uint64_t rx_clock = 40000;
+    for (int32_t step = 0; step < 100; step++)
+        {
+            std::vector<std::vector<Gnss_Synchro>> input(nchannels);
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    while (sample_counter[ch] < rx_clock + 2 * 4000 && (ch + step) % 17 != 0)
+                        {
+                            Gnss_Synchro obs{};
+                            obs.PRN = ch + 1;
+                            obs.fs = fs;
+                            obs.Tracking_sample_counter = sample_counter[ch];
+                            obs.Carrier_phase_rads = 0.001 * static_cast<double>(sample_counter[ch]);
+                            obs.TOW_at_current_symbol_ms = 1000 + static_cast<uint32_t>(sample_counter[ch] / 4000);
+                            input[ch].push_back(obs);
+                            sample_counter[ch] += 4000 + jitter(gen);
+                        }
+                }
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    for (const auto& obs : input[ch])
+                        {
+                            single.push_back(ch, obs, static_cast<double>(obs.Tracking_sample_counter) / static_cast<double>(fs));
+                        }
+                }
+            pool.run([&](uint32_t first_ch, uint32_t last_ch) {
+                for (uint32_t ch = first_ch; ch < last_ch; ch++)
+                    {
+                        for (const auto& obs : input[ch])
+                            {
+                                sharded.push_back(ch, obs, static_cast<double>(obs.Tracking_sample_counter) / static_cast<double>(fs));
+                            }
+                    }
+            });
+
+            std::vector<Gnss_Synchro> expected;
+            const int32_t n_expected = single.interpolate(rx_clock, T_rx_step_s, expected);
+            std::vector<Gnss_Synchro> epoch(nchannels);
+            std::atomic<int32_t> n_valid{0};
+            pool.run([&](uint32_t first_ch, uint32_t last_ch) {
+                n_valid += sharded.interpolate(rx_clock, T_rx_step_s, epoch, first_ch, last_ch);
+            });
+
+            ASSERT_EQ(n_valid, n_expected);
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    ASSERT_EQ(epoch[ch].fs, expected[ch].fs);
+                    ASSERT_EQ(epoch[ch].Tracking_sample_counter, expected[ch].Tracking_sample_counter);
+                    ASSERT_EQ(epoch[ch].Carrier_phase_rads, expected[ch].Carrier_phase_rads);
+                    ASSERT_EQ(epoch[ch].interp_TOW_ms, expected[ch].interp_TOW_ms);
+                    ASSERT_EQ(epoch[ch].Channel_ID, expected[ch].Channel_ID);
+                }
+            rx_clock += 80000;  // 20 ms
+        }
+}
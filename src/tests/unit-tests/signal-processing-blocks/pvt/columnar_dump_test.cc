@@ -0,0 +1,112 @@
+/*!
+ * \file columnar_dump_test.cc
+ * \brief Tests the chunked columnar dump file and its memory-mapped reader
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "columnar_dump.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+void write_columnar_dump(const std::string& filename, uint32_t records, size_t chunk_records)
+{
+    Columnar_Dump_Writer writer({{"tow", Columnar_Dump_Type::UINT32},
+                                    {"ns", Columnar_Dump_Type::UINT8},
+                                    {"x", Columnar_Dump_Type::DOUBLE}},
+        chunk_records);
+    writer.open(filename);
+    for (uint32_t i = 0; i < records; i++)
+        {
+            writer.set<uint32_t>(0, 1000 * i);
+            writer.set<uint8_t>(1, static_cast<uint8_t>(i % 13));
+            writer.set<double>(2, 0.5 * i);
+            writer.commit();
+        }
+    EXPECT_EQ(writer.num_records(), records);
+    writer.close();
+}
+}  // namespace
+
+
+TEST(ColumnarDumpTest, WriteAndRead)
+{
+    const std::string filename = "./columnar_dump_test.dat";
+    write_columnar_dump(filename, 2500, 1000);
+
+    Columnar_Dump_Reader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.columns().size(), 3U);
+    EXPECT_EQ(reader.columns()[2].name, "x");
+    EXPECT_EQ(reader.column_index("ns"), 1);
+    EXPECT_EQ(reader.column_index("none"), -1);
+    EXPECT_EQ(reader.num_records(), 2500U);
+    ASSERT_EQ(reader.num_chunks(), 3U);
+    EXPECT_EQ(reader.chunk_records(2), 500U);
+
+    for (uint32_t i = 0; i < 2500; i++)
+        {
+            uint32_t tow = 0;
+            uint8_t ns = 0;
+            double x = 0.0;
+            ASSERT_TRUE(reader.read(0, i, tow));
+            ASSERT_TRUE(reader.read(1, i, ns));
+            ASSERT_TRUE(reader.read(2, i, x));
+            EXPECT_EQ(tow, 1000 * i);
+            EXPECT_EQ(ns, i % 13);
+            EXPECT_EQ(x, 0.5 * i);
+        }
+    double x = 0.0;
+    EXPECT_FALSE(reader.read(2, 2500, x));
+    uint32_t wrong_type = 0;
+    EXPECT_FALSE(reader.read(2, 0, wrong_type));
+    reader.close();
+    std::remove(filename.c_str());
+}
+
+
+TEST(ColumnarDumpTest, ReadsUnclosedFile)
+{
+    const std::string filename = "./columnar_dump_test.dat";
+    write_columnar_dump(filename, 2500, 1000);
+
+    // drop the footer and the end of the last chunk, as if the receiver was killed
+    std::vector<char> bytes;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const size_t footer = 3 * 12 + 12;
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - footer - 100));
+    }
+
+    Columnar_Dump_Reader reader;
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_EQ(reader.num_chunks(), 2U);
+    EXPECT_EQ(reader.num_records(), 2000U);
+    double x = 0.0;
+    EXPECT_TRUE(reader.read(2, 1999, x));
+    EXPECT_EQ(x, 0.5 * 1999);
+    reader.close();
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE(reader.open("./columnar_dump_test_missing.dat"));
+}
@@ -0,0 +1,210 @@
+/*!
+ * \file compact_ephemeris_test.cc
+ * \brief Tests the compact, delta-encoded form of the ephemeris sent by the
+ * ephemeris monitor
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compact_ephemeris.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Broadcast parameters are integers times a power of two
+double scaled(std::mt19937& gen, int bits, int scale_exponent)
+{
+    std::uniform_int_distribution<int64_t> value(-(int64_t(1) << (bits - 1)), (int64_t(1) << (bits - 1)) - 1);
+    return std::ldexp(static_cast<double>(value(gen)), scale_exponent);
+}
+
+
+Gps_Ephemeris gps_ephemeris(std::mt19937& gen, uint32_t prn, int32_t iode, int32_t toe)
+{
+    Gps_Ephemeris eph;
+    eph.PRN = prn;
+    eph.M_0 = scaled(gen, 32, -31);
+    eph.delta_n = scaled(gen, 16, -43);
+    eph.ecc = std::fabs(scaled(gen, 32, -33));
+    eph.sqrtA = 5153.6 + std::fabs(scaled(gen, 20, -19));
+    eph.OMEGA_0 = scaled(gen, 32, -31);
+    eph.i_0 = scaled(gen, 32, -31);
+    eph.omega = scaled(gen, 32, -31);
+    eph.OMEGAdot = scaled(gen, 24, -43);
+    eph.idot = scaled(gen, 14, -43);
+    eph.Cuc = scaled(gen, 16, -29);
+    eph.Cus = scaled(gen, 16, -29);
+    eph.Crc = scaled(gen, 16, -5);
+    eph.Crs = scaled(gen, 16, -5);
+    eph.Cic = scaled(gen, 16, -29);
+    eph.Cis = scaled(gen, 16, -29);
+    eph.toe = toe;
+    eph.toc = toe;
+    eph.af0 = scaled(gen, 22, -31);
+    eph.af1 = scaled(gen, 16, -43);
+    eph.WN = 2200;
+    eph.tow = toe + 18;
+    eph.TGD = scaled(gen, 8, -31);
+    eph.IODC = iode;
+    eph.IODE_SF2 = iode;
+    eph.IODE_SF3 = iode;
+    eph.SV_accuracy = 2;
+    eph.code_on_L2 = 1;
+    eph.fit_interval_flag = false;
+    eph.antispoofing_flag = true;
+    return eph;
+}
+
+
+void expect_same(const Gps_Ephemeris& a, const Gps_Ephemeris& b)
+{
+    EXPECT_EQ(a.PRN, b.PRN);
+    EXPECT_EQ(a.M_0, b.M_0);
+    EXPECT_EQ(a.delta_n, b.delta_n);
+    EXPECT_EQ(a.ecc, b.ecc);
+    EXPECT_EQ(a.sqrtA, b.sqrtA);
+    EXPECT_EQ(a.OMEGA_0, b.OMEGA_0);
+    EXPECT_EQ(a.i_0, b.i_0);
+    EXPECT_EQ(a.omega, b.omega);
+    EXPECT_EQ(a.OMEGAdot, b.OMEGAdot);
+    EXPECT_EQ(a.idot, b.idot);
+    EXPECT_EQ(a.Cuc, b.Cuc);
+    EXPECT_EQ(a.Cis, b.Cis);
+    EXPECT_EQ(a.Crs, b.Crs);
+    EXPECT_EQ(a.toe, b.toe);
+    EXPECT_EQ(a.toc, b.toc);
+    EXPECT_EQ(a.af0, b.af0);
+    EXPECT_EQ(a.af1, b.af1);
+    EXPECT_EQ(a.WN, b.WN);
+    EXPECT_EQ(a.tow, b.tow);
+    EXPECT_EQ(a.TGD, b.TGD);
+    EXPECT_EQ(a.IODC, b.IODC);
+    EXPECT_EQ(a.IODE_SF2, b.IODE_SF2);
+    EXPECT_EQ(a.IODE_SF3, b.IODE_SF3);
+    EXPECT_EQ(a.SV_accuracy, b.SV_accuracy);
+    EXPECT_EQ(a.code_on_L2, b.code_on_L2);
+    EXPECT_EQ(a.fit_interval_flag, b.fit_interval_flag);
+    EXPECT_EQ(a.antispoofing_flag, b.antispoofing_flag);
+}
+}  // namespace
+
+
+TEST(CompactEphemerisTest, GpsRoundTrip)
+{
+    std::mt19937 gen(7);
+    Compact_Ephemeris_Encoder encoder(4);
+    Compact_Ephemeris_Decoder decoder;
+    std::string record;
+    size_t key_size = 0;
+    size_t delta_size = 0;
+    for (int32_t n = 0; n < 12; n++)
+        {
+            for (uint32_t prn = 1; prn <= 3; prn++)
+                {
+                    const Gps_Ephemeris eph = gps_ephemeris(gen, prn, n, 7200 * n);
+                    encoder.encode(eph, record);
+                    (n % 4 == 0 ? key_size : delta_size) += record.size();
+                    EXPECT_EQ(record[0], 'g');
+                    EXPECT_EQ((record[2] & 1) == 1, n % 4 == 0);
+                    Gps_Ephemeris decoded;
+                    ASSERT_TRUE(decoder.decode(record, decoded));
+                    expect_same(eph, decoded);
+                    Galileo_Ephemeris wrong_system;
+                    EXPECT_FALSE(decoder.decode(record, wrong_system));
+                }
+        }
+    // 3 key records and 9 deltas per satellite
+    EXPECT_LT(delta_size / 9, key_size / 3);
+    EXPECT_LT(key_size / 9, 23 * 8u + 11 * 4u);
+}
+
+
+TEST(CompactEphemerisTest, RecoversAfterLostRecord)
+{
+    std::mt19937 gen(1);
+    Compact_Ephemeris_Encoder encoder(3);
+    Compact_Ephemeris_Decoder decoder;
+    std::vector<std::string> records(7);
+    std::vector<Gps_Ephemeris> ephemeris;
+    for (int32_t n = 0; n < 7; n++)
+        {
+            ephemeris.push_back(gps_ephemeris(gen, 5, n, 7200 * n));
+            encoder.encode(ephemeris.back(), records[n]);
+        }
+
+    // records 0 and 3 and 6 are key records. Record 1 is lost.
+    Gps_Ephemeris decoded;
+    EXPECT_TRUE(decoder.decode(records[0], decoded));
+    EXPECT_FALSE(decoder.decode(records[2], decoded));
+    EXPECT_TRUE(decoder.decode(records[3], decoded));
+    expect_same(ephemeris[3], decoded);
+    EXPECT_TRUE(decoder.decode(records[4], decoded));
+    expect_same(ephemeris[4], decoded);
+
+    // A client that starts listening in the middle waits for a key record
+    Compact_Ephemeris_Decoder late_decoder;
+    EXPECT_FALSE(late_decoder.decode(records[5], decoded));
+    EXPECT_TRUE(late_decoder.decode(records[6], decoded));
+    expect_same(ephemeris[6], decoded);
+
+    // Truncated records are rejected
+    Compact_Ephemeris_Decoder other_decoder;
+    EXPECT_FALSE(other_decoder.decode(records[0].substr(0, records[0].size() - 1), decoded));
+    EXPECT_FALSE(other_decoder.decode(std::string("g"), decoded));
+}
+
+
+TEST(CompactEphemerisTest, GalileoRoundTrip)
+{
+    Compact_Ephemeris_Encoder encoder;
+    Compact_Ephemeris_Decoder decoder;
+    Galileo_Ephemeris eph;
+    eph.PRN = 36;
+    eph.IOD_nav = 17;
+    eph.IOD_ephemeris = 17;
+    eph.sqrtA = 5440.6;
+    eph.ecc = 1.5e-4;
+    eph.toe = 3600;
+    eph.WN = 1200;
+    eph.SISA = 107;
+    eph.BGD_E1E5b = -2.3e-9;
+    eph.E1B_DVS = true;
+    std::string record;
+    encoder.encode(eph, record);
+    EXPECT_EQ(record[0], 'e');
+
+    Galileo_Ephemeris decoded;
+    ASSERT_TRUE(decoder.decode(record, decoded));
+    EXPECT_EQ(decoded.PRN, eph.PRN);
+    EXPECT_EQ(decoded.IOD_nav, eph.IOD_nav);
+    EXPECT_EQ(decoded.sqrtA, eph.sqrtA);
+    EXPECT_EQ(decoded.ecc, eph.ecc);
+    EXPECT_EQ(decoded.toe, eph.toe);
+    EXPECT_EQ(decoded.SISA, eph.SISA);
+    EXPECT_EQ(decoded.BGD_E1E5b, eph.BGD_E1E5b);
+    EXPECT_EQ(decoded.E1B_DVS, eph.E1B_DVS);
+
+    // Only the issue of data and the reference time change
+    eph.IOD_nav = 18;
+    eph.toe = 4200;
+    encoder.encode(eph, record);
+    EXPECT_LT(record.size(), 10u);
+    ASSERT_TRUE(decoder.decode(record, decoded));
+    EXPECT_EQ(decoded.IOD_nav, 18);
+    EXPECT_EQ(decoded.toe, 4200);
+    EXPECT_EQ(decoded.sqrtA, eph.sqrtA);
+}
@@ -0,0 +1,72 @@
+/*!
+ * \file pvt_observables_test.cc
+ * \brief This file implements unit tests for the flat container of the
+ * observables of an epoch
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_observables.h"
+#include <gtest/gtest.h>
+#include <map>
+
+
+namespace
+{
+Gnss_Synchro observable(uint32_t prn)
+{
+    Gnss_Synchro obs{};
+    obs.PRN = prn;
+    return obs;
+}
+}  // namespace
+
+
+TEST(PvtObservablesTest, BehavesAsTheMap)
+{
+    Pvt_Observables observables(8);
+    std::map<int, Gnss_Synchro> reference;
+    for (int ch : {1, 3, 4, 7, 0, 5})  // out of order last
+        {
+            observables.insert(ch, observable(10 + ch));
+            reference.insert(std::pair<int, Gnss_Synchro>(ch, observable(10 + ch)));
+        }
+    observables.insert(3, observable(99));  // already there, kept
+    ASSERT_EQ(observables.size(), reference.size());
+    auto it = reference.cbegin();
+    for (const auto& obs : observables)
+        {
+            EXPECT_EQ(obs.first, it->first);
+            EXPECT_EQ(obs.second.PRN, it->second.PRN);
+            ++it;
+        }
+    EXPECT_EQ(observables.find(3)->second.PRN, 13U);
+    EXPECT_EQ(observables.find(2), observables.cend());
+    EXPECT_EQ(observables.find(42), observables.cend());
+    EXPECT_EQ(observables.to_map().size(), reference.size());
+}
+
+
+TEST(PvtObservablesTest, ClearKeepsTheStorage)
+{
+    Pvt_Observables observables(4);
+    observables.insert(2, observable(5));
+    const Gnss_Synchro* storage = &observables.cbegin()->second;
+    observables.clear();
+    EXPECT_TRUE(observables.empty());
+    EXPECT_EQ(observables.find(2), observables.cend());
+    observables.insert(0, observable(6));
+    EXPECT_EQ(&observables.cbegin()->second, storage);
+
+    Pvt_Observables copy(4);
+    copy = observables;
+    EXPECT_EQ(copy.find(0)->second.PRN, 6U);
+}
@@ -0,0 +1,64 @@
+/*!
+ * \file pvt_output_worker_test.cc
+ * \brief Tests the thread that runs the jobs of the PVT printers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_make_unique.h"
+#include "pvt_output_worker.h"
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <vector>
+
+
+TEST(PvtOutputWorkerTest, RunsInOrder)
+{
+    std::vector<int> done;
+    {
+        Pvt_Output_Worker worker("Test", 1000);
+        for (int i = 0; i < 100; i++)
+            {
+                worker.submit([&done, i] { done.push_back(i); });
+            }
+    }  // the destructor runs the pending jobs
+    ASSERT_EQ(done.size(), 100U);
+    for (int i = 0; i < 100; i++)
+        {
+            EXPECT_EQ(done[i], i);
+        }
+}
+
+
+TEST(PvtOutputWorkerTest, DropsOldest)
+{
+    std::vector<int> done;
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+    auto worker = std::make_unique<Pvt_Output_Worker>("Test", 3);
+    std::promise<void> started;
+    worker->submit([&started, released] {
+        started.set_value();
+        released.wait();  // a slow output
+    });
+    started.get_future().wait();
+    worker->submit([&done] { done.push_back(0); }, false);  // never dropped
+    for (int i = 1; i <= 5; i++)
+        {
+            worker->submit([&done, i] { done.push_back(i); });
+        }
+    EXPECT_EQ(worker->dropped(), 3U);
+    release.set_value();
+    worker.reset();
+    const std::vector<int> expected{0, 4, 5};
+    EXPECT_EQ(done, expected);
+}
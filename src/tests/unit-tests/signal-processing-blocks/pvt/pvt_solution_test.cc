@@ -0,0 +1,137 @@
+/*!
+ * \file pvt_solution_test.cc
+ * \brief Tests the position averaging of Pvt_Solution
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_solution.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+class Averaging_Pvt_Solution : public Pvt_Solution
+{
+public:
+    double get_hdop() const override { return 0.0; }
+    double get_vdop() const override { return 0.0; }
+    double get_pdop() const override { return 0.0; }
+    double get_gdop() const override { return 0.0; }
+};
+
+
+std::array<double, 3> ecef_position(int epoch)
+{
+    // a few meters around a point near Barcelona
+    return {4796983.0 + (epoch % 7) * 0.9, 160309.0 - (epoch % 5) * 1.3, 4187340.0 + (epoch % 3) * 2.1};
+}
+
+
+// Reference mean and sample covariance of latitude, longitude and height
+void brute_force_average(const std::vector<std::array<double, 3>> &llh,
+    std::array<double, 3> &mean,
+    std::array<std::array<double, 3>, 3> &covariance)
+{
+    mean = {};
+    covariance = {};
+    for (const auto &p : llh)
+        {
+            for (size_t i = 0; i < 3; i++)
+                {
+                    mean[i] += p[i] / static_cast<double>(llh.size());
+                }
+        }
+    for (const auto &p : llh)
+        {
+            for (size_t i = 0; i < 3; i++)
+                {
+                    for (size_t j = 0; j < 3; j++)
+                        {
+                            covariance[i][j] += (p[i] - mean[i]) * (p[j] - mean[j]) / static_cast<double>(llh.size() - 1);
+                        }
+                }
+        }
+}
+
+
+void expect_average(const Pvt_Solution &pvt, const std::vector<std::array<double, 3>> &llh)
+{
+    std::array<double, 3> mean{};
+    std::array<std::array<double, 3>, 3> covariance{};
+    brute_force_average(llh, mean, covariance);
+    ASSERT_EQ(pvt.get_num_averaged_positions(), llh.size());
+    EXPECT_NEAR(pvt.get_avg_latitude(), mean[0], 1e-11);
+    EXPECT_NEAR(pvt.get_avg_longitude(), mean[1], 1e-11);
+    EXPECT_NEAR(pvt.get_avg_height(), mean[2], 1e-7);
+    const std::array<double, 3> scale = {1e-15, 1e-15, 1e-8};  // deg^2, deg^2, m^2
+    const auto avg_covariance = pvt.get_avg_covariance();
+    for (size_t i = 0; i < 3; i++)
+        {
+            for (size_t j = 0; j < 3; j++)
+                {
+                    EXPECT_NEAR(avg_covariance[i][j], covariance[i][j], std::max(scale[i], scale[j]));
+                }
+        }
+}
+}  // namespace
+
+
+TEST(PvtSolutionAveragingTest, SlidingWindow)
+{
+    const int depth = 10;
+    Averaging_Pvt_Solution pvt;
+    pvt.set_averaging_depth(depth);
+    pvt.set_averaging_flag(true);
+    std::vector<std::array<double, 3>> llh;
+    for (int epoch = 0; epoch < 1000; epoch++)
+        {
+            pvt.set_rx_pos(ecef_position(epoch));
+            pvt.perform_pos_averaging();
+            llh.push_back({pvt.get_latitude(), pvt.get_longitude(), pvt.get_height()});
+            if (llh.size() > static_cast<size_t>(depth))
+                {
+                    llh.erase(llh.begin());
+                }
+            EXPECT_EQ(pvt.is_valid_position(), epoch >= depth - 1);
+            if (epoch > 0)
+                {
+                    expect_average(pvt, llh);
+                }
+        }
+}
+
+
+TEST(PvtSolutionAveragingTest, UnboundedAveraging)
+{
+    Averaging_Pvt_Solution pvt;
+    pvt.set_averaging_depth(0);
+    pvt.set_averaging_flag(true);
+    std::vector<std::array<double, 3>> llh;
+    for (int epoch = 0; epoch < 5000; epoch++)
+        {
+            pvt.set_rx_pos(ecef_position(epoch));
+            pvt.perform_pos_averaging();
+            EXPECT_TRUE(pvt.is_valid_position());
+            llh.push_back({pvt.get_latitude(), pvt.get_longitude(), pvt.get_height()});
+        }
+    expect_average(pvt, llh);
+
+    // changing the depth restarts the averaging
+    pvt.set_averaging_depth(3);
+    EXPECT_EQ(pvt.get_num_averaged_positions(), 0U);
+    pvt.perform_pos_averaging();
+    EXPECT_FALSE(pvt.is_valid_position());
+}
@@ -0,0 +1,158 @@
+/*!
+ * \file pvt_solver_engines_test.cc
+ * \brief Tests the additional PVT solvers fed with the epochs of another one
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_solver_engines.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_rtksvr.h"
+#include "rtklib_solver.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// Code observations of a GPS-like constellation, seen from rr with a clock
+// bias of 100 m
+std::shared_ptr<Rtklib_Epoch> synthetic_epoch(gtime_t time, const double* rr)
+{
+    auto epoch = std::make_shared<Rtklib_Epoch>();
+    nav_t& nav = epoch->nav;
+    nav.eph = epoch->eph.data();
+    nav.geph = epoch->geph.data();
+    for (int i = 0; i < MAXSAT; i++)
+        {
+            nav.lam[i][0] = SPEED_OF_LIGHT_M_S / FREQ1;
+            nav.lam[i][1] = SPEED_OF_LIGHT_M_S / FREQ2;
+        }
+    double pos[3];
+    ecef2pos(rr, pos);
+    for (int i = 0; i < 32; i++)
+        {
+            eph_t& eph = epoch->eph[nav.n];
+            eph = eph_t{};
+            eph.sat = satno(SYS_GPS, i + 1);
+            eph.iode = 1;
+            eph.week = 2199;
+            eph.toe = time;
+            eph.toc = time;
+            eph.ttr = time;
+            eph.toes = time2gpst(time, nullptr);
+            eph.A = 26560e3;
+            eph.e = 0.005;
+            eph.i0 = 55.0 * D2R;
+            eph.OMG0 = (i / 4) * 45.0 * D2R;
+            eph.M0 = (i % 4) * 90.0 * D2R + (i / 4) * 15.0 * D2R;
+            nav.n++;
+
+            obsd_t o{};
+            o.time = time;
+            o.sat = eph.sat;
+            o.rcv = 1;
+            o.code[0] = CODE_L1C;
+            double rs[6];
+            double dts[2];
+            double var;
+            int svh;
+            double e[3];
+            double azel[2];
+            double r = 0.07 * SPEED_OF_LIGHT_M_S;
+            for (int k = 0; k < 3; k++)
+                {
+                    ephpos(timeadd(time, -r / SPEED_OF_LIGHT_M_S), time, o.sat, &nav, -1, rs, dts, &var, &svh);
+                    r = geodist(rs, rr, e) + 100.0 - SPEED_OF_LIGHT_M_S * dts[0];
+                }
+            if (satazel(pos, e, azel) < 10.0 * D2R)
+                {
+                    nav.n--;
+                    continue;
+                }
+            o.P[0] = r;
+            epoch->obs[epoch->n_obs++] = o;
+        }
+    return epoch;
+}
+
+
+prcopt_t single_point_options()
+{
+    prcopt_t opt = PRCOPT_DEFAULT;
+    opt.mode = PMODE_SINGLE;
+    opt.nf = 1;
+    opt.elmin = 5.0 * D2R;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    return opt;
+}
+}  // namespace
+
+
+TEST(PvtSolverEnginesTest, SameFixAsTheSolverOfTheEpoch)
+{
+    std::vector<double> ep{2022, 3, 1, 12, 0, 0};
+    const gtime_t time = epoch2time(ep.data());
+    double pos[3] = {41.275 * D2R, 1.987 * D2R, 80.0};
+    double rr[3];
+    pos2ecef(pos, rr);
+    const std::shared_ptr<const Rtklib_Epoch> epoch = synthetic_epoch(time, rr);
+    ASSERT_GT(epoch->n_obs, 4);
+
+    const prcopt_t opt = single_point_options();
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    Rtklib_Solver solver(rtk, "", false, false);
+    ASSERT_TRUE(solver.solve_epoch(*epoch));
+
+    Pvt_Solver_Engines engines(opt, {PMODE_SINGLE, PMODE_SINGLE}, "", false, false, 4);
+    ASSERT_EQ(engines.size(), 2U);
+    engines.submit(epoch);
+    for (size_t i = 0; i < engines.size(); i++)
+        {
+            Monitor_Pvt fix;
+            bool solved = false;
+            for (int wait = 0; wait < 500 && !solved; wait++)
+                {
+                    solved = engines.get_monitor_pvt(i, fix);
+                    if (!solved)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                        }
+                }
+            ASSERT_TRUE(solved);
+            EXPECT_EQ(fix.pos_x, solver.pvt_sol.rr[0]);
+            EXPECT_EQ(fix.pos_y, solver.pvt_sol.rr[1]);
+            EXPECT_EQ(fix.pos_z, solver.pvt_sol.rr[2]);
+            EXPECT_NEAR(fix.pos_x, rr[0], 1e-3);
+            EXPECT_NEAR(fix.pos_y, rr[1], 1e-3);
+            EXPECT_NEAR(fix.pos_z, rr[2], 1e-3);
+        }
+    rtkfree(&rtk);
+}
+
+
+TEST(PvtSolverEnginesTest, Names)
+{
+    Pvt_Solver_Engines engines(single_point_options(), {PMODE_SINGLE, PMODE_PPP_KINEMA}, "", false, false, 1);
+    EXPECT_EQ(engines.name(0), "Single");
+    EXPECT_EQ(engines.name(1), "PPP_Kinematic");
+    EXPECT_EQ(engines.name(2), "");
+    Monitor_Pvt fix;
+    EXPECT_FALSE(engines.get_monitor_pvt(0, fix));
+    EXPECT_EQ(Pvt_Solver_Engines::mode_name(PMODE_STATIC), "Static");
+}
@@ -0,0 +1,127 @@
+/*!
+ * \file pvt_text_format_test.cc
+ * \brief Tests the number formatting of the PVT outputs against printf and
+ * the standard streams
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_text_format.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+void expect_as_printf(double x, uint32_t precision)
+{
+    char expected[400];
+    std::snprintf(expected, sizeof(expected), "%.*f", static_cast<int>(precision), x);
+    char buffer[FORMAT_BUFFER_SIZE];
+    const size_t length = format_fixed(x, precision, buffer);
+    if (length > 0)
+        {
+            EXPECT_EQ(std::string(expected), std::string(buffer, length)) << "x=" << x << " precision=" << precision;
+        }
+}
+}  // namespace
+
+
+TEST(PvtTextFormatTest, MatchesPrintf)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> pseudorange(1.9e7, 2.6e7);
+    std::uniform_real_distribution<double> phase(-3e8, 3e8);
+    std::uniform_real_distribution<double> doppler(-5000.0, 5000.0);
+    std::uniform_real_distribution<double> seconds(0.0, 60.0);
+    int32_t fast = 0;
+    for (int i = 0; i < 100000; i++)
+        {
+            const std::vector<double> values{pseudorange(gen), phase(gen), doppler(gen), seconds(gen)};
+            for (const double x : values)
+                {
+                    char buffer[FORMAT_BUFFER_SIZE];
+                    fast += format_fixed(x, 3, buffer) > 0 ? 1 : 0;
+                    expect_as_printf(x, 3);
+                }
+            expect_as_printf(seconds(gen), 7);
+            // KML, GPX and GeoJSON coordinates
+            expect_as_printf(phase(gen) * 3e-7, 14);
+            expect_as_printf(pseudorange(gen) * 1e-4, 14);
+        }
+    // the stream fallback is the exception
+    EXPECT_GT(fast, 399000);
+}
+
+
+TEST(PvtTextFormatTest, SpecialValues)
+{
+    const std::vector<double> values{0.0, -0.0, 1.0, -1.0, 0.0625, 0.0005, -0.0004, 0.9995, 9.99999999, 123456789.0125, 1e14, -99999999999999.9,
+        std::numeric_limits<double>::min()};
+    for (const double x : values)
+        {
+            for (uint32_t precision = 0; precision <= 15; precision++)
+                {
+                    expect_as_printf(x, precision);
+                }
+        }
+
+    // exact ties and values out of the fast path are left to the caller
+    char buffer[FORMAT_BUFFER_SIZE];
+    EXPECT_EQ(format_fixed(0.0625, 3, buffer), 0U);
+    EXPECT_EQ(format_fixed(std::numeric_limits<double>::quiet_NaN(), 3, buffer), 0U);
+    EXPECT_EQ(format_fixed(std::numeric_limits<double>::infinity(), 3, buffer), 0U);
+    EXPECT_EQ(format_fixed(1e15, 3, buffer), 0U);
+    EXPECT_EQ(format_fixed(1.0, 16, buffer), 0U);
+    EXPECT_EQ(std::string(buffer, format_fixed(-0.0, 3, buffer)), "-0.000");
+    EXPECT_EQ(std::string(buffer, format_fixed(20000000.0, 3, buffer)), "20000000.000");
+}
+
+
+TEST(PvtTextFormatTest, Integers)
+{
+    char buffer[FORMAT_BUFFER_SIZE];
+    for (const int64_t x : {int64_t(0), int64_t(7), int64_t(-42), int64_t(1234567890123), std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()})
+        {
+            EXPECT_EQ(std::string(buffer, format_integer(x, buffer)), std::to_string(x));
+        }
+}
+
+
+TEST(PvtTextFormatTest, BufferMatchesStream)
+{
+    Pvt_Text_Buffer text(14, 16);
+    std::ostringstream expected;
+    expected.setf(std::ios::fixed, std::ios::floatfield);
+    expected << std::setprecision(14);
+    for (int epoch = 0; epoch < 3; epoch++)
+        {
+            text.clear();
+            expected.str("");
+            const double values[] = {41.27486341033509, 1.98748691295545, 75.2 + epoch, 0.0625, -0.0, 1e20, std::numeric_limits<double>::quiet_NaN()};
+            text << "<coordinates>" << std::string("x") << ',' << static_cast<uint32_t>(epoch) << -3;
+            expected << "<coordinates>" << std::string("x") << ',' << static_cast<uint32_t>(epoch) << -3;
+            for (const double value : values)
+                {
+                    text << value << ", ";
+                    expected << value << ", ";
+                }
+            EXPECT_EQ(text.str(), expected.str());
+            EXPECT_EQ(text.size(), expected.str().size());
+        }
+}
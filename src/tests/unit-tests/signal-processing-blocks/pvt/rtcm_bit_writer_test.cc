@@ -0,0 +1,118 @@
+/*!
+ * \file rtcm_bit_writer_test.cc
+ * \brief Tests the RTCM 3 bit writer against the framing of strings of
+ * binary symbols
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bit_writer.h"
+#include <boost/crc.hpp>
+#include <gtest/gtest.h>
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Packs a string of '0' and '1' symbols, a multiple of 8 long, into bytes
+std::string rtcm_pack_bits(const std::string& bits)
+{
+    std::string bytes(bits.length() / 8, '\0');
+    for (size_t i = 0; i < bits.length(); i++)
+        {
+            if (bits[i] == '1')
+                {
+                    bytes[i / 8] = static_cast<char>(bytes[i / 8] | (0x80 >> (i % 8)));
+                }
+        }
+    return bytes;
+}
+
+
+// The transport layer as built from strings of binary symbols
+std::string rtcm_reference_frame(const std::string& data)
+{
+    const size_t length_bytes = (data.length() + 7) / 8;
+    const std::string content = std::string("11010011") + "000000" + std::bitset<10>(length_bytes).to_string() +
+                                data + std::string(8 * length_bytes - data.length(), '0');
+    const std::string bytes = rtcm_pack_bits(content);
+    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc;
+    crc.process_bytes(bytes.data(), bytes.size());
+    return bytes + rtcm_pack_bits(std::bitset<24>(crc.checksum()).to_string());
+}
+}  // namespace
+
+
+TEST(RtcmBitWriterTest, MatchesStringFraming)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<uint32_t> width(1, 64);
+    std::uniform_int_distribution<uint64_t> value;
+    Rtcm_Bit_Writer writer(16);
+    for (int message = 0; message < 200; message++)
+        {
+            writer.clear();
+            std::string data;
+            const int fields = message % 40;
+            for (int f = 0; f < fields; f++)
+                {
+                    const uint32_t n = width(gen);
+                    const uint64_t v = value(gen);
+                    writer.put(v, n);
+                    data += std::bitset<64>(v).to_string().substr(64 - n);
+                }
+            ASSERT_EQ(writer.size(), data.length());
+            EXPECT_EQ(writer.frame(), rtcm_reference_frame(data)) << "message " << message;
+        }
+}
+
+
+TEST(RtcmBitWriterTest, FieldsAndColumns)
+{
+    Rtcm_Bit_Writer writer;
+    const auto df1 = std::bitset<12>(1077);
+    const auto df2 = std::bitset<3>("101");
+    const auto wide = std::bitset<74>(std::string(37, '1') + std::string(37, '0'));
+    writer.put(df1);
+    writer.put(std::string("0110"));
+    writer.put(wide);
+
+    // two columns of three cells, filled cell by cell
+    const size_t first = writer.skip(3 * df2.size());
+    const size_t second = writer.skip(3 * df1.size());
+    for (uint32_t cell = 0; cell < 3; cell++)
+        {
+            writer.put_at(first + cell * df2.size(), df2);
+            writer.put_at(second + cell * df1.size(), std::bitset<12>(cell));
+        }
+    const std::string data = df1.to_string() + "0110" + wide.to_string() +
+                             df2.to_string() + df2.to_string() + df2.to_string() +
+                             std::bitset<12>(0).to_string() + std::bitset<12>(1).to_string() + std::bitset<12>(2).to_string();
+    EXPECT_EQ(writer.frame(), rtcm_reference_frame(data));
+
+    // clearing keeps no bits of the previous message
+    writer.clear();
+    writer.put(0, 5);
+    EXPECT_EQ(writer.frame(), rtcm_reference_frame("00000"));
+}
+
+
+TEST(RtcmBitWriterTest, Crc24q)
+{
+    // CRC-24Q check value
+    const std::string check("123456789");
+    EXPECT_EQ(Rtcm_Bit_Writer::crc24q(reinterpret_cast<const uint8_t*>(check.data()), check.size()), 0xCDE703U);
+    EXPECT_EQ(Rtcm_Bit_Writer::crc24q(nullptr, 0), 0U);
+}
@@ -18,7 +18,9 @@
 
 #include "Galileo_INAV.h"
 #include "rtcm.h"
+#include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
 
 TEST(RtcmTest, HexToBin)
@@ -628,3 +630,50 @@ TEST(RtcmTest, InstantiateServerWithoutClosing)
     std::string test3_bin = rtcm->hex_to_bin(test3);
     EXPECT_EQ(0, test3_bin.compare("11111111"));
 }
+
+
+TEST(RtcmTest, NtripCaster)
+{
+    auto rtcm = std::make_shared<Rtcm>(2111, 2112, "TEST");
+    rtcm->run_server();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));  // the queue reader connects to the server
+
+    b_io_context io_context;
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), 2112);
+
+    // sourcetable
+    boost::asio::ip::tcp::socket table_socket(io_context);
+    table_socket.connect(endpoint);
+    boost::asio::write(table_socket, boost::asio::buffer(std::string("GET / HTTP/1.1\r\nNtrip-Version: Ntrip/2.0\r\n\r\n")));
+    boost::asio::streambuf table_buffer;
+    boost::system::error_code ec;
+    boost::asio::read(table_socket, table_buffer, ec);  // until the caster closes
+    const std::string table(boost::asio::buffers_begin(table_buffer.data()), boost::asio::buffers_end(table_buffer.data()));
+    EXPECT_EQ(0U, table.find("HTTP/1.1 200 OK\r\n"));
+    EXPECT_NE(std::string::npos, table.find("STR;TEST;"));
+    EXPECT_NE(std::string::npos, table.find("ENDSOURCETABLE\r\n"));
+
+    // NTRIP 2.0 and 1.0 streams of the same messages
+    boost::asio::ip::tcp::socket v2_socket(io_context);
+    v2_socket.connect(endpoint);
+    boost::asio::write(v2_socket, boost::asio::buffer(std::string("GET /TEST HTTP/1.1\r\nNtrip-Version: Ntrip/2.0\r\n\r\n")));
+    boost::asio::ip::tcp::socket v1_socket(io_context);
+    v1_socket.connect(endpoint);
+    boost::asio::write(v1_socket, boost::asio::buffer(std::string("GET /TEST HTTP/1.0\r\nUser-Agent: NTRIP test\r\n\r\n")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    rtcm->send_message("Hello");
+
+    boost::asio::streambuf v2_buffer;
+    boost::asio::read_until(v2_socket, v2_buffer, "Hello\r\n");
+    const std::string v2(boost::asio::buffers_begin(v2_buffer.data()), boost::asio::buffers_end(v2_buffer.data()));
+    EXPECT_EQ(0U, v2.find("HTTP/1.1 200 OK\r\n"));
+    EXPECT_NE(std::string::npos, v2.find("Transfer-Encoding: chunked\r\n"));
+    EXPECT_NE(std::string::npos, v2.find("\r\n\r\n5\r\nHello\r\n"));
+
+    boost::asio::streambuf v1_buffer;
+    boost::asio::read_until(v1_socket, v1_buffer, "Hello");
+    const std::string v1(boost::asio::buffers_begin(v1_buffer.data()), boost::asio::buffers_end(v1_buffer.data()));
+    EXPECT_EQ(0, v1.compare("ICY 200 OK\r\n\r\nHello"));
+
+    rtcm->stop_server();
+}
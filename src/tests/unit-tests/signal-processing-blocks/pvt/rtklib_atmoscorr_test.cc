@@ -0,0 +1,120 @@
+/*!
+ * \file rtklib_atmoscorr_test.cc
+ * \brief Tests the memoized atmospheric corrections and the IONEX interpolation
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_ionex.h"
+#include "rtklib_pntpos.h"
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+
+TEST(RtklibAtmoscorrTest, MatchesModels)
+{
+    nav_t nav{};
+    const double ion_gps[8] = {0.1118e-07, 0.7451e-08, -0.5960e-07, -0.5960e-07, 0.9011e+05, 0.4915e+05, -0.1311e+06, -0.3277e+06};
+    for (int k = 0; k < 8; k++)
+        {
+            nav.ion_gps[k] = ion_gps[k];
+        }
+    const double ep[6] = {2021, 5, 17, 10, 30, 0};
+    const gtime_t time = epoch2time(ep);
+    std::mt19937 gen(60);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int n = 0; n < 200; n++)
+        {
+            const int sat = 1 + n % 32;
+            const double pos[3] = {(uniform(gen) - 0.5) * GNSS_PI, (uniform(gen) - 0.5) * 2.0 * GNSS_PI, uniform(gen) * 2000.0};
+            const double azel[2] = {uniform(gen) * 2.0 * GNSS_PI, (0.05 + 0.9 * uniform(gen)) * GNSS_PI / 2.0};
+            double dion[2];
+            double vion[2];
+            double dtrp[2];
+            double vtrp[2];
+            ASSERT_EQ(atmoscorr(time, &nav, sat, pos, azel, IONOOPT_BRDC, TROPOPT_SAAS, dion, vion, dtrp, vtrp), 1);
+            ASSERT_EQ(ionocorr(time, &nav, sat, pos, azel, IONOOPT_BRDC, dion + 1, vion + 1), 1);
+            ASSERT_EQ(tropcorr(time, &nav, pos, azel, TROPOPT_SAAS, dtrp + 1, vtrp + 1), 1);
+            EXPECT_EQ(dion[0], dion[1]);
+            EXPECT_EQ(vion[0], vion[1]);
+            EXPECT_EQ(dtrp[0], dtrp[1]);
+            EXPECT_EQ(vtrp[0], vtrp[1]);
+
+            // a receiver that moved within the tolerances reuses the corrections
+            const double pos2[3] = {pos[0] + 0.9 * ATMOS_MEMO_DPOS / RE_WGS84, pos[1], pos[2] - 0.9 * ATMOS_MEMO_DPOS};
+            const double azel2[2] = {azel[0], azel[1] + 0.9 * ATMOS_MEMO_DANG};
+            ASSERT_EQ(atmoscorr(time, &nav, sat, pos2, azel2, IONOOPT_BRDC, TROPOPT_SAAS, dion, vion, dtrp, vtrp), 1);
+            EXPECT_EQ(dtrp[0], dtrp[1]);
+            ASSERT_EQ(ionocorr(time, &nav, sat, pos2, azel2, IONOOPT_BRDC, dion + 1, vion + 1), 1);
+            ASSERT_EQ(tropcorr(time, &nav, pos2, azel2, TROPOPT_SAAS, dtrp + 1, vtrp + 1), 1);
+            EXPECT_NEAR(dion[0], dion[1], 5e-4);
+            EXPECT_NEAR(dtrp[0], dtrp[1], 5e-4);
+
+            // but not the corrections of another option
+            ASSERT_EQ(atmoscorr(time, &nav, sat, pos2, azel2, IONOOPT_OFF, TROPOPT_OFF, dion, vion, dtrp, vtrp), 1);
+            EXPECT_EQ(dion[0], 0.0);
+            EXPECT_EQ(dtrp[0], 0.0);
+        }
+}
+
+
+TEST(RtklibAtmoscorrTest, IonTecMatchesIondelay)
+{
+    nav_t nav{};
+    const double lats[3] = {87.5, -87.5, -2.5};
+    const double lons[3] = {-180.0, 180.0, 5.0};
+    const double hgts[3] = {450.0, 450.0, 0.0};
+    const double ep[6] = {2021, 5, 17, 0, 0, 0};
+    const gtime_t time0 = epoch2time(ep);
+    for (int m = 0; m < 3; m++)
+        {
+            tec_t *tec = addtec(lats, lons, hgts, 6371.0, &nav);
+            ASSERT_NE(tec, nullptr);
+            tec->time = timeadd(time0, 7200.0 * m);
+            const int n = tec->ndata[0] * tec->ndata[1] * tec->ndata[2];
+            for (int k = 0; k < n; k++)
+                {
+                    tec->data[k] = 10.0 + 5.0 * std::sin(0.01 * k + m) + m;
+                    tec->rms[k] = static_cast<float>(1.0 + 0.1 * std::cos(0.02 * k));
+                }
+        }
+    std::mt19937 gen(61);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int n = 0; n < 200; n++)
+        {
+            const gtime_t time = timeadd(time0, uniform(gen) * 14000.0);
+            const double pos[3] = {(uniform(gen) - 0.5) * GNSS_PI * 0.9, (uniform(gen) - 0.5) * 2.0 * GNSS_PI, 100.0};
+            const double azel[2] = {uniform(gen) * 2.0 * GNSS_PI, (0.05 + 0.9 * uniform(gen)) * GNSS_PI / 2.0};
+            const int opt = n % 4;
+            double delay;
+            double var;
+            ASSERT_EQ(iontec(time, &nav, pos, azel, opt, &delay, &var), 1);
+
+            // reference: each grid on its own, then linear interpolation by time
+            const int i = timediff(time, nav.tec[1].time) < 0.0 ? 1 : 2;
+            double dels[2];
+            double vars[2];
+            ASSERT_EQ(iondelay(time, nav.tec + i - 1, pos, azel, opt, dels, vars), 1);
+            ASSERT_EQ(iondelay(time, nav.tec + i, pos, azel, opt, dels + 1, vars + 1), 1);
+            const double a = timediff(time, nav.tec[i - 1].time) / timediff(nav.tec[i].time, nav.tec[i - 1].time);
+            EXPECT_NEAR(delay, dels[0] * (1.0 - a) + dels[1] * a, 1e-12);
+            EXPECT_NEAR(var, vars[0] * (1.0 - a) + vars[1] * a, 1e-12);
+        }
+    for (int m = 0; m < nav.nt; m++)
+        {
+            free(nav.tec[m].data);
+            free(nav.tec[m].rms);
+        }
+    free(nav.tec);
+}
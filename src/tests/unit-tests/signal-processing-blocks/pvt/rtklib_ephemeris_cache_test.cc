@@ -0,0 +1,81 @@
+/*!
+ * \file rtklib_ephemeris_cache_test.cc
+ * \brief This file implements unit tests for the cache of ephemerides
+ * converted to RTKLIB structures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "rtklib_conversions.h"
+#include <gtest/gtest.h>
+
+
+TEST(RtklibEphemerisCacheTest, ConvertsOncePerIssue)
+{
+    Rtklib_Ephemeris_Cache cache;
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 5;
+    gps_eph.WN = 2100;
+    gps_eph.toe = 7200;
+    gps_eph.toc = 7200;
+    gps_eph.tow = 6000;
+    gps_eph.sqrtA = 5153.6;
+    gps_eph.IODE_SF2 = 10;
+
+    const eph_t& first = cache.convert(gps_eph, false);
+    const eph_t expected = eph_to_rtklib(gps_eph, false);
+    EXPECT_EQ(first.sat, expected.sat);
+    EXPECT_EQ(first.week, expected.week);
+    EXPECT_DOUBLE_EQ(first.A, expected.A);
+    EXPECT_EQ(first.toe.time, expected.toe.time);
+    EXPECT_EQ(cache.conversions(), 1U);
+
+    for (int epoch = 0; epoch < 10; epoch++)
+        {
+            cache.convert(gps_eph, false);
+        }
+    EXPECT_EQ(cache.conversions(), 1U);
+
+    // new issue of data
+    gps_eph.IODE_SF2 = 11;
+    gps_eph.toe = 14400;
+    const eph_t& second = cache.convert(gps_eph, false);
+    EXPECT_EQ(cache.conversions(), 2U);
+    EXPECT_EQ(second.toe.time, eph_to_rtklib(gps_eph, false).toe.time);
+
+    // the pre-2009 week adjustment is part of the conversion
+    cache.convert(gps_eph, true);
+    EXPECT_EQ(cache.conversions(), 3U);
+}
+
+
+TEST(RtklibEphemerisCacheTest, SlotsPerSatellite)
+{
+    Rtklib_Ephemeris_Cache cache;
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 11;
+    gps_eph.WN = 2100;
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 11;
+    gal_eph.WN = 1076;
+
+    EXPECT_EQ(cache.convert(gps_eph, false).sat, 11);
+    EXPECT_EQ(cache.convert(gal_eph).sat, 11 + NSATGPS + NSATGLO);
+    cache.convert(gps_eph, false);
+    cache.convert(gal_eph);
+    EXPECT_EQ(cache.conversions(), 2U);
+
+    cache.clear();
+    cache.convert(gps_eph, false);
+    EXPECT_EQ(cache.conversions(), 3U);
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file rtklib_ephemeris_interp_test.cc
+ * \brief Tests the interpolated broadcast satellite states against ephpos()
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+
+TEST(RtklibEphemerisInterpTest, MatchesEphpos)
+{
+    std::vector<double> ep{2020, 1, 1, 2, 0, 0};
+    const gtime_t toe = epoch2time(ep.data());
+
+    std::vector<eph_t> eph(1);
+    eph[0].sat = satno(SYS_GPS, 5);
+    eph[0].iode = 10;
+    eph[0].toe = toe;
+    eph[0].toc = toe;
+    eph[0].ttr = toe;
+    eph[0].toes = time2gpst(toe, nullptr);
+    eph[0].A = 26560e3;
+    eph[0].e = 0.01;
+    eph[0].i0 = 0.95;
+    eph[0].OMG0 = 1.0;
+    eph[0].omg = 0.5;
+    eph[0].M0 = 0.2;
+    eph[0].deln = 4e-9;
+    eph[0].OMGd = -8e-9;
+    eph[0].idot = 1e-10;
+    eph[0].cuc = 1e-6;
+    eph[0].cus = 5e-6;
+    eph[0].crc = 200.0;
+    eph[0].crs = 50.0;
+    eph[0].cic = 1e-7;
+    eph[0].cis = 1e-7;
+    eph[0].f0 = 1e-4;
+    eph[0].f1 = 1e-11;
+
+    std::vector<geph_t> geph(1);
+    geph[0].sat = satno(SYS_GLO, 3);
+    geph[0].iode = 1;
+    geph[0].toe = toe;
+    geph[0].tof = toe;
+    geph[0].pos[0] = 10000e3;
+    geph[0].pos[1] = -20000e3;
+    geph[0].pos[2] = 8000e3;
+    geph[0].vel[0] = 2000.0;
+    geph[0].vel[1] = 500.0;
+    geph[0].vel[2] = -2500.0;
+    geph[0].taun = 1e-5;
+    geph[0].gamn = 1e-12;
+
+    nav_t nav{};
+    nav.eph = eph.data();
+    nav.n = 1;
+    nav.nmax = 1;
+    nav.geph = geph.data();
+    nav.ng = 1;
+    nav.ngmax = 1;
+
+    for (const int sat : {eph[0].sat, geph[0].sat})
+        {
+            for (double t = -1700.0; t < 1700.0; t += 0.37)
+                {
+                    const gtime_t time = timeadd(toe, t);
+                    double rs[6];
+                    double dts[2];
+                    double var;
+                    int svh;
+                    double rs_interp[6];
+                    double dts_interp[2];
+                    double var_interp;
+                    int svh_interp;
+                    ASSERT_EQ(ephpos(time, time, sat, &nav, -1, rs, dts, &var, &svh), 1);
+                    ASSERT_EQ(ephpos_interp(time, time, sat, &nav, rs_interp, dts_interp, &var_interp, &svh_interp), 1);
+                    for (int j = 0; j < 3; j++)
+                        {
+                            ASSERT_NEAR(rs[j], rs_interp[j], 1e-3) << "sat=" << sat << " t=" << t;
+                            ASSERT_NEAR(rs[j + 3], rs_interp[j + 3], 1e-3) << "sat=" << sat << " t=" << t;
+                        }
+                    ASSERT_NEAR(dts[0], dts_interp[0], 1e-14);
+                    EXPECT_EQ(svh, svh_interp);
+                }
+        }
+}
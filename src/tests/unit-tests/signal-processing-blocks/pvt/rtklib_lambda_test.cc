@@ -0,0 +1,87 @@
+/*!
+ * \file rtklib_lambda_test.cc
+ * \brief Tests the LAMBDA estimation starting from a previous reduction
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_lambda.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// float ambiguities as strongly correlated as double-differenced ones: large
+// errors along three position directions (G, n x 3), small ones for each
+// ambiguity
+void float_ambiguities(int n, const std::vector<double>& G, double scale, std::mt19937& gen, std::vector<double>& a, std::vector<double>& Q)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double p[3];
+    for (auto& x : p)
+        {
+            x = 10.0 * normal(gen);
+        }
+    a.assign(n, 0.0);
+    Q.assign(n * n, 0.0);
+    for (int i = 0; i < n; i++)
+        {
+            for (int k = 0; k < 3; k++)
+                {
+                    a[i] += scale * G[i + k * n] * p[k];
+                    for (int j = 0; j < n; j++)
+                        {
+                            Q[i + j * n] += scale * scale * 100.0 * G[i + k * n] * G[j + k * n];
+                        }
+                }
+            a[i] += std::round(100.0 * normal(gen)) + 0.05 * normal(gen);
+            Q[i + i * n] += 0.01;
+        }
+}
+}  // namespace
+
+
+TEST(RtklibLambdaTest, ReuseMatchesLambda)
+{
+    std::mt19937 gen(54);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (const int n : {4, 10, 16})
+        {
+            std::vector<double> G(n * 3);
+            for (auto& g : G)
+                {
+                    g = normal(gen);
+                }
+            std::vector<double> a;
+            std::vector<double> Q;
+            std::vector<double> Z(n * n);
+            for (int epoch = 0; epoch < 10; epoch++)
+                {
+                    // the same ambiguities, better determined in each epoch
+                    float_ambiguities(n, G, 1.0 - 0.1 * epoch, gen, a, Q);
+                    std::vector<double> F(n * 2);
+                    std::vector<double> F_reuse(n * 2);
+                    double s[2];
+                    double s_reuse[2];
+                    ASSERT_EQ(lambda(n, 2, a.data(), Q.data(), F.data(), s), 0);
+                    ASSERT_EQ(lambda_reuse(n, 2, a.data(), Q.data(), F_reuse.data(), s_reuse, Z.data(), epoch > 0), 0);
+                    for (int i = 0; i < 2 * n; i++)
+                        {
+                            EXPECT_NEAR(F[i], F_reuse[i], 1e-6) << "n=" << n << " epoch=" << epoch;
+                        }
+                    EXPECT_NEAR(s[0], s_reuse[0], 1e-9 * s[0]);
+                    EXPECT_NEAR(s[1], s_reuse[1], 1e-9 * s[1]);
+                }
+        }
+}
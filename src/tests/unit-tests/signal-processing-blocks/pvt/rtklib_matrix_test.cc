@@ -0,0 +1,165 @@
+/*!
+ * \file rtklib_matrix_test.cc
+ * \brief Tests the RTKLIB matrix inversion, least squares and Kalman filter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+
+TEST(RtklibMatrixTest, Matinv)
+{
+    std::mt19937 gen(56);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (int n = 1; n <= 20; n++)
+        {
+            std::vector<double> A(n * n);
+            for (auto& a : A)
+                {
+                    a = normal(gen);
+                }
+            std::vector<double> A_inv(A);
+            ASSERT_EQ(matinv(A_inv.data(), n), 0);
+            std::vector<double> I(n * n);
+            matmul("NN", n, n, n, 1.0, A.data(), A_inv.data(), 0.0, I.data());
+            for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                        {
+                            EXPECT_NEAR(I[i + j * n], i == j ? 1.0 : 0.0, 1e-9) << "n=" << n;
+                        }
+                }
+        }
+}
+
+
+TEST(RtklibMatrixTest, MatinvSingular)
+{
+    for (int n = 2; n <= 12; n++)
+        {
+            std::vector<double> A(n * n, 1.0);  // rank 1
+            EXPECT_NE(matinv(A.data(), n), 0) << "n=" << n;
+        }
+}
+
+
+TEST(RtklibMatrixTest, Lsq)
+{
+    std::mt19937 gen(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (int n = 1; n <= 12; n++)
+        {
+            const int m = 3 * n;
+            std::vector<double> A(n * m);
+            std::vector<double> x_true(n);
+            std::vector<double> y(m);
+            for (auto& a : A)
+                {
+                    a = normal(gen);
+                }
+            for (auto& x : x_true)
+                {
+                    x = 100.0 * normal(gen);
+                }
+            matmul("TN", m, 1, n, 1.0, A.data(), x_true.data(), 0.0, y.data());
+            std::vector<double> x(n);
+            std::vector<double> Q(n * n);
+            ASSERT_EQ(lsq(A.data(), y.data(), n, m, x.data(), Q.data()), 0);
+            for (int i = 0; i < n; i++)
+                {
+                    EXPECT_NEAR(x[i], x_true[i], 1e-8) << "n=" << n;
+                }
+
+            // Q is the inverse of A*A'
+            std::vector<double> N(n * n);
+            std::vector<double> I(n * n);
+            matmul("NT", n, n, m, 1.0, A.data(), A.data(), 0.0, N.data());
+            matmul("NN", n, n, n, 1.0, N.data(), Q.data(), 0.0, I.data());
+            for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                        {
+                            EXPECT_NEAR(I[i + j * n], i == j ? 1.0 : 0.0, 1e-9) << "n=" << n;
+                        }
+                }
+        }
+}
+
+
+TEST(RtklibMatrixTest, Filter)
+{
+    std::mt19937 gen(57);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_int_distribution<int> state(5, 39);
+    const int n = 40;
+    const int m = 12;
+
+    // covariance of the states, and measurements of the first five states
+    // (position, clock and tropos) and of one more (the satellite ambiguity)
+    std::vector<double> G(n * n);
+    std::vector<double> P(n * n);
+    for (auto& g : G)
+        {
+            g = normal(gen);
+        }
+    matmul("NT", n, n, n, 0.1, G.data(), G.data(), 0.0, P.data());
+    std::vector<double> x(n);
+    for (auto& s : x)
+        {
+            s = 1.0 + normal(gen);
+        }
+    std::vector<double> H(n * m, 0.0);
+    std::vector<double> v(m);
+    std::vector<double> R(m * m, 0.0);
+    for (int j = 0; j < m; j++)
+        {
+            for (int i = 0; i < 5; i++)
+                {
+                    H[i + j * n] = normal(gen);
+                }
+            H[state(gen) + j * n] = 1.0;
+            v[j] = normal(gen);
+            R[j + j * m] = 0.01;
+        }
+
+    // dense update: K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P
+    std::vector<double> F(n * m);
+    std::vector<double> Q(R);
+    std::vector<double> K(n * m);
+    std::vector<double> I(n * n, 0.0);
+    std::vector<double> xp(x);
+    std::vector<double> Pp(n * n);
+    for (int i = 0; i < n; i++)
+        {
+            I[i + i * n] = 1.0;
+        }
+    matmul("NN", n, m, n, 1.0, P.data(), H.data(), 0.0, F.data());
+    matmul("TN", m, m, n, 1.0, H.data(), F.data(), 1.0, Q.data());
+    ASSERT_EQ(matinv(Q.data(), m), 0);
+    matmul("NN", n, m, m, 1.0, F.data(), Q.data(), 0.0, K.data());
+    matmul("NN", n, 1, m, 1.0, K.data(), v.data(), 1.0, xp.data());
+    matmul("NT", n, n, m, -1.0, K.data(), H.data(), 1.0, I.data());
+    matmul("NN", n, n, n, 1.0, I.data(), P.data(), 0.0, Pp.data());
+
+    ASSERT_EQ(filter(x.data(), P.data(), H.data(), v.data(), R.data(), n, m), 0);
+    for (int i = 0; i < n; i++)
+        {
+            EXPECT_NEAR(x[i], xp[i], 1e-9);
+            for (int j = 0; j < n; j++)
+                {
+                    EXPECT_NEAR(P[i + j * n], Pp[i + j * n], 1e-9);
+                }
+        }
+}
@@ -0,0 +1,156 @@
+/*!
+ * \file rtklib_rtkposrovers_test.cc
+ * \brief Tests the positioning of many rovers in parallel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_rtksvr.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+const int NUM_SATS = 32;
+const int NUM_ROVERS = 12;
+
+
+// a GPS-like constellation: 8 planes of 4 satellites
+std::vector<eph_t> constellation(gtime_t toe)
+{
+    std::vector<eph_t> eph(NUM_SATS);
+    for (int i = 0; i < NUM_SATS; i++)
+        {
+            eph[i].sat = satno(SYS_GPS, i + 1);
+            eph[i].iode = 1;
+            eph[i].toe = toe;
+            eph[i].toc = toe;
+            eph[i].ttr = toe;
+            eph[i].toes = time2gpst(toe, nullptr);
+            eph[i].A = 26560e3;
+            eph[i].e = 0.005;
+            eph[i].i0 = 55.0 * D2R;
+            eph[i].OMG0 = (i / 4) * 45.0 * D2R;
+            eph[i].M0 = (i % 4) * 90.0 * D2R + (i / 4) * 15.0 * D2R;
+        }
+    return eph;
+}
+
+
+// code observations of a receiver at rr, with its clock bias (m)
+std::vector<obsd_t> observations(gtime_t time, const double *rr, double clock, const nav_t *nav)
+{
+    std::vector<obsd_t> obs;
+    double pos[3];
+    ecef2pos(rr, pos);
+    for (int i = 0; i < NUM_SATS; i++)
+        {
+            obsd_t o{};
+            o.time = time;
+            o.sat = nav->eph[i].sat;
+            o.rcv = 1;
+            o.code[0] = CODE_L1C;
+            double rs[6];
+            double dts[2];
+            double var;
+            int svh;
+            double e[3];
+            double azel[2];
+            double r = 0.07 * SPEED_OF_LIGHT_M_S;
+            for (int k = 0; k < 3; k++)
+                {
+                    ephpos(timeadd(time, -r / SPEED_OF_LIGHT_M_S), time, o.sat, nav, -1, rs, dts, &var, &svh);
+                    r = geodist(rs, rr, e) + clock - SPEED_OF_LIGHT_M_S * dts[0];
+                }
+            if (satazel(pos, e, azel) < 10.0 * D2R)
+                {
+                    continue;
+                }
+            o.P[0] = r;
+            obs.push_back(o);
+        }
+    return obs;
+}
+}  // namespace
+
+
+TEST(RtklibRtkposRoversTest, SameAsOneRoverAtATime)
+{
+    std::vector<double> ep{2022, 3, 1, 12, 0, 0};
+    const gtime_t toe = epoch2time(ep.data());
+    std::vector<eph_t> eph = constellation(toe);
+    auto nav = std::make_unique<nav_t>();
+    nav->eph = eph.data();
+    nav->n = nav->nmax = NUM_SATS;
+    for (int i = 0; i < MAXSAT; i++)
+        {
+            nav->lam[i][0] = SPEED_OF_LIGHT_M_S / FREQ1;
+            nav->lam[i][1] = SPEED_OF_LIGHT_M_S / FREQ2;
+        }
+
+    prcopt_t opt = PRCOPT_DEFAULT;
+    opt.mode = PMODE_SINGLE;
+    opt.nf = 1;
+    opt.elmin = 5.0 * D2R;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+
+    std::vector<std::vector<double>> rr(NUM_ROVERS);
+    for (int i = 0; i < NUM_ROVERS; i++)
+        {
+            double pos[3] = {(40.0 - i) * D2R, (i * 7.0 - 30.0) * D2R, 100.0 * i};
+            rr[i].resize(3);
+            pos2ecef(pos, rr[i].data());
+        }
+
+    std::vector<rtk_t> rtk1(NUM_ROVERS);
+    std::vector<rtk_t> rtk4(NUM_ROVERS);
+    for (int i = 0; i < NUM_ROVERS; i++)
+        {
+            rtkinit(&rtk1[i], &opt);
+            rtkinit(&rtk4[i], &opt);
+        }
+    const std::vector<obsd_t> no_base;
+    obs_t base{};
+    for (int epoch = 0; epoch < 5; epoch++)
+        {
+            const gtime_t time = timeadd(toe, epoch);
+            std::vector<std::vector<obsd_t>> data(NUM_ROVERS);
+            std::vector<obs_t> rov(NUM_ROVERS);
+            for (int i = 0; i < NUM_ROVERS; i++)
+                {
+                    data[i] = observations(time, rr[i].data(), 100.0 * i, nav.get());
+                    rov[i].n = static_cast<int>(data[i].size());
+                    rov[i].data = data[i].data();
+                }
+            EXPECT_EQ(rtkposrovers(rtk1.data(), NUM_ROVERS, rov.data(), &base, nav.get(), 1), NUM_ROVERS);
+            EXPECT_EQ(rtkposrovers(rtk4.data(), NUM_ROVERS, rov.data(), &base, nav.get(), 4), NUM_ROVERS);
+            for (int i = 0; i < NUM_ROVERS; i++)
+                {
+                    for (int k = 0; k < 3; k++)
+                        {
+                            EXPECT_NEAR(rtk1[i].sol.rr[k], rr[i][k], 1e-3);
+                            EXPECT_EQ(rtk1[i].sol.rr[k], rtk4[i].sol.rr[k]);
+                        }
+                }
+        }
+    for (int i = 0; i < NUM_ROVERS; i++)
+        {
+            rtkfree(&rtk1[i]);
+            rtkfree(&rtk4[i]);
+        }
+}
@@ -0,0 +1,131 @@
+/*!
+ * \file rtklib_sbas_cache_test.cc
+ * \brief Tests the cached SBAS satellite and ionospheric corrections
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkcmn.h"
+#include "rtklib_sbas.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+
+namespace
+{
+// Feeds a message without corrections (type 10), which only gives nav a new revision
+void update_revision(nav_t *nav, gtime_t time)
+{
+    sbsmsg_t msg{};
+    msg.week = 2000;
+    msg.tow = static_cast<int>(time2gpst(time, nullptr));
+    msg.msg[1] = 10 << 2;
+    const unsigned int rev = nav->sbsrev;
+    sbsupdatecorr(&msg, nav);
+    EXPECT_NE(nav->sbsrev, rev);
+    EXPECT_NE(nav->sbsrev, 0U);
+}
+
+
+// Vertical delays of the cell 40-45N, 0-5E
+void set_igps(nav_t *nav, gtime_t time, float delay)
+{
+    const short lats[4] = {40, 45, 40, 45};
+    const short lons[4] = {0, 0, 5, 5};
+    nav->sbsion[0].nigp = 4;
+    for (int i = 0; i < 4; i++)
+        {
+            nav->sbsion[0].igp[i].t0 = time;
+            nav->sbsion[0].igp[i].lat = lats[i];
+            nav->sbsion[0].igp[i].lon = lons[i];
+            nav->sbsion[0].igp[i].give = 5;
+            nav->sbsion[0].igp[i].delay = delay + static_cast<float>(i);
+        }
+}
+}  // namespace
+
+
+TEST(RtklibSbasCacheTest, IonosphericCorrections)
+{
+    auto nav = std::make_unique<nav_t>();
+    const double ep[6] = {2018, 5, 1, 12, 0, 0};
+    const gtime_t time = epoch2time(ep);
+    set_igps(nav.get(), time, 2.0F);
+    const double azel[2] = {0.0, GNSS_PI / 2.0};
+    double delay[2][5];
+    double var[2][5];
+    for (int n = 0; n < 5; n++)
+        {
+            const double pos[3] = {(41.0 + 0.7 * n) * D2R, (1.0 + 0.5 * n) * D2R, 100.0};
+            ASSERT_EQ(sbsioncorr(time, nav.get(), pos, azel, &delay[0][n], &var[0][n]), 1);  // without revision, not cached
+            EXPECT_GT(delay[0][n], 2.0);
+        }
+    update_revision(nav.get(), time);
+    for (int k = 0; k < 2; k++)
+        {
+            for (int n = 0; n < 5; n++)
+                {
+                    const double pos[3] = {(41.0 + 0.7 * n) * D2R, (1.0 + 0.5 * n) * D2R, 100.0};
+                    ASSERT_EQ(sbsioncorr(time, nav.get(), pos, azel, &delay[1][n], &var[1][n]), 1);
+                    EXPECT_EQ(delay[1][n], delay[0][n]);
+                    EXPECT_EQ(var[1][n], var[0][n]);
+                }
+        }
+
+    // new delays are used once their message arrives
+    set_igps(nav.get(), time, 4.0F);
+    update_revision(nav.get(), time);
+    const double pos[3] = {41.0 * D2R, 1.0 * D2R, 100.0};
+    ASSERT_EQ(sbsioncorr(time, nav.get(), pos, azel, &delay[1][0], &var[1][0]), 1);
+    EXPECT_NEAR(delay[1][0] - delay[0][0], 2.0, 0.1);
+
+    // and a cell without igps has no correction
+    const double far[3] = {-30.0 * D2R, 100.0 * D2R, 100.0};
+    EXPECT_EQ(sbsioncorr(time, nav.get(), far, azel, &delay[1][0], &var[1][0]), 0);
+}
+
+
+TEST(RtklibSbasCacheTest, SatelliteCorrections)
+{
+    auto nav = std::make_unique<nav_t>();
+    const double ep[6] = {2018, 5, 1, 12, 0, 0};
+    const gtime_t time = epoch2time(ep);
+    const int sat = 5;
+    nav->sbssat.nsat = 1;
+    nav->sbssat.sat[0].sat = sat;
+    nav->sbssat.sat[0].lcorr.t0 = time;
+    nav->sbssat.sat[0].lcorr.dpos[0] = 1.5;
+    nav->sbssat.sat[0].lcorr.daf0 = 1e-9;
+    nav->sbssat.sat[0].fcorr.t0 = time;
+    nav->sbssat.sat[0].fcorr.prc = 3.0;
+    nav->sbssat.sat[0].fcorr.udre = 5;
+    update_revision(nav.get(), time);
+    for (int k = 0; k < 3; k++)
+        {
+            double rs[6] = {};
+            double dts[2] = {};
+            double var = 0.0;
+            ASSERT_EQ(sbssatcorr(time, sat, nav.get(), rs, dts, &var), 1);
+            EXPECT_EQ(rs[0], 1.5);
+            EXPECT_DOUBLE_EQ(dts[0], 1e-9 + 3.0 / SPEED_OF_LIGHT_M_S);
+            EXPECT_GT(var, 0.0);
+        }
+    double rs[6] = {};
+    double dts[2] = {};
+    double var = 0.0;
+    EXPECT_EQ(sbssatcorr(time, sat + 1, nav.get(), rs, dts, &var), 0);
+
+    // a new fast correction is used once its message arrives
+    nav->sbssat.sat[0].fcorr.prc = -3.0;
+    update_revision(nav.get(), time);
+    ASSERT_EQ(sbssatcorr(time, sat, nav.get(), rs, dts, &var), 1);
+    EXPECT_DOUBLE_EQ(dts[0], 1e-9 - 3.0 / SPEED_OF_LIGHT_M_S);
+}
@@ -0,0 +1,82 @@
+/*!
+ * \file rtklib_solver_warm_start_test.cc
+ * \brief Tests the save and load of the warm start data of the PVT solver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkpos.h"
+#include "rtklib_rtksvr.h"
+#include "rtklib_solver.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+TEST(RtklibSolverWarmStartTest, SaveAndLoad)
+{
+    const std::string file_name = "./warm_start_test.bin";
+    prcopt_t opt = PRCOPT_DEFAULT;
+    opt.mode = PMODE_DGPS;
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    {
+        Rtklib_Solver solver(rtk, "", false, false);
+        Gps_Ephemeris eph;
+        eph.PRN = 7;
+        eph.toe = 345600;
+        eph.sqrtA = 5153.7;
+        eph.M_0 = 1.25;
+        solver.gps_ephemeris_map[eph.PRN] = eph;
+        Galileo_Ephemeris gal_eph;
+        gal_eph.PRN = 11;
+        gal_eph.toe = 345000;
+        solver.galileo_ephemeris_map[gal_eph.PRN] = gal_eph;
+        solver.gps_iono.alpha0 = 1.1e-8;
+        solver.gps_iono.valid = true;
+        solver.gps_utc_model.DeltaT_LS = 18;
+        ASSERT_TRUE(solver.save_warm_start(file_name));
+    }
+
+    Rtklib_Solver restarted(rtk, "", false, false);
+    ASSERT_TRUE(restarted.load_warm_start(file_name));
+    ASSERT_EQ(restarted.gps_ephemeris_map.size(), 1U);
+    EXPECT_EQ(restarted.gps_ephemeris_map[7].toe, 345600);
+    EXPECT_DOUBLE_EQ(restarted.gps_ephemeris_map[7].sqrtA, 5153.7);
+    EXPECT_DOUBLE_EQ(restarted.gps_ephemeris_map[7].M_0, 1.25);
+    ASSERT_EQ(restarted.galileo_ephemeris_map.size(), 1U);
+    EXPECT_EQ(restarted.galileo_ephemeris_map[11].toe, 345000);
+    EXPECT_DOUBLE_EQ(restarted.gps_iono.alpha0, 1.1e-8);
+    EXPECT_TRUE(restarted.gps_iono.valid);
+    EXPECT_EQ(restarted.gps_utc_model.DeltaT_LS, 18);
+    std::remove(file_name.c_str());
+    rtkfree(&rtk);
+}
+
+
+TEST(RtklibSolverWarmStartTest, BadFile)
+{
+    const std::string file_name = "./warm_start_bad_test.bin";
+    prcopt_t opt = PRCOPT_DEFAULT;
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    Rtklib_Solver solver(rtk, "", false, false);
+    EXPECT_FALSE(solver.load_warm_start(file_name));
+    {
+        std::ofstream ofs(file_name.c_str());
+        ofs << "not a warm start file";
+    }
+    EXPECT_FALSE(solver.load_warm_start(file_name));
+    EXPECT_TRUE(solver.gps_ephemeris_map.empty());
+    std::remove(file_name.c_str());
+    rtkfree(&rtk);
+}
@@ -0,0 +1,70 @@
+/*!
+ * \file rtklib_time_conversions_test.cc
+ * \brief This file implements unit tests for the RTKLIB time system
+ * conversions
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+
+
+TEST(RtklibTimeConversionsTest, TimeReferences)
+{
+    const double gpst0[] = {1980, 1, 6, 0, 0, 0};
+    const double gst0[] = {1999, 8, 22, 0, 0, 0};
+    const double bdt0[] = {2006, 1, 1, 0, 0, 0};
+    EXPECT_EQ(gpst2time(0, 0.0).time, epoch2time(gpst0).time);
+    EXPECT_EQ(gst2time(0, 0.0).time, epoch2time(gst0).time);
+    EXPECT_EQ(bdt2time(0, 0.0).time, epoch2time(bdt0).time);
+
+    int week = 0;
+    const gtime_t t = gpst2time(2200, 345600.25);
+    EXPECT_DOUBLE_EQ(time2gpst(t, &week), 345600.25);
+    EXPECT_EQ(week, 2200);
+    EXPECT_DOUBLE_EQ(time2gst(gst2time(1176, 100.5), &week), 100.5);
+    EXPECT_EQ(week, 1176);
+    EXPECT_DOUBLE_EQ(time2bdt(bdt2time(844, 7.0), &week), 7.0);
+    EXPECT_EQ(week, 844);
+}
+
+
+TEST(RtklibTimeConversionsTest, LeapSeconds)
+{
+    // 18 s since 2017/1/1, 17 s since 2015/7/1
+    const double ep_2020[] = {2020, 3, 1, 12, 0, 0};
+    const gtime_t utc_2020 = epoch2time(ep_2020);
+    EXPECT_DOUBLE_EQ(timediff(utc2gpst(utc_2020), utc_2020), 18.0);
+    EXPECT_DOUBLE_EQ(timediff(gpst2utc(utc2gpst(utc_2020)), utc_2020), 0.0);
+
+    const double ep_2016[] = {2016, 6, 30, 23, 59, 59};
+    const gtime_t utc_2016 = epoch2time(ep_2016);
+    EXPECT_DOUBLE_EQ(timediff(utc2gpst(utc_2016), utc_2016), 17.0);
+
+    // first second of 2017 in UTC
+    const double ep_2017[] = {2017, 1, 1, 0, 0, 0};
+    const gtime_t utc_2017 = epoch2time(ep_2017);
+    EXPECT_DOUBLE_EQ(timediff(utc2gpst(utc_2017), utc_2017), 18.0);
+    EXPECT_DOUBLE_EQ(timediff(gpst2utc(timeadd(utc_2017, 18.0)), utc_2017), 0.0);
+}
+
+
+TEST(RtklibTimeConversionsTest, EpochTime)
+{
+    const gtime_t t = gpst2time(2200, 3600.5);
+    epoch_time_t et{};
+    epoch_time(t, &et);
+    EXPECT_EQ(et.week, 2200);
+    EXPECT_DOUBLE_EQ(et.tow, 3600.5);
+    EXPECT_DOUBLE_EQ(timediff(et.gpst, t), 0.0);
+    EXPECT_DOUBLE_EQ(timediff(et.utc, gpst2utc(t)), 0.0);
+}
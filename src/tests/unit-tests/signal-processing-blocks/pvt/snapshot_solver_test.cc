@@ -0,0 +1,133 @@
+/*!
+ * \file snapshot_solver_test.cc
+ * \brief Tests the coarse-time fix of Snapshot_Solver with a simulated
+ * constellation
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gps_ephemeris.h"
+#include "snapshot_solver.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+const std::array<double, 3> RX_POSITION{{4796983.5, 160308.8, 4187340.4}};  // ECEF [m]
+constexpr double RX_TIME_S = 345678.25;                                      // TOW of the reference sample [s]
+constexpr double CLOCK_BIAS_M = 123456.7;
+
+
+// Six orbital planes, four satellites each
+std::map<int, Gps_Ephemeris> constellation()
+{
+    std::map<int, Gps_Ephemeris> ephemeris;
+    for (int plane = 0; plane < 6; plane++)
+        {
+            for (int slot = 0; slot < 4; slot++)
+                {
+                    Gps_Ephemeris eph;
+                    eph.PRN = static_cast<uint32_t>(plane * 4 + slot + 1);
+                    eph.sqrtA = 5153.7;
+                    eph.ecc = 0.005;
+                    eph.i_0 = 55.0 * D2R;
+                    eph.OMEGA_0 = plane * 60.0 * D2R;
+                    eph.M_0 = (slot * 90.0 + plane * 15.0) * D2R;
+                    eph.OMEGAdot = -8.0e-9;
+                    eph.toe = 345600;
+                    eph.toc = 345600;
+                    eph.af0 = 1.0e-5 * (slot - 1.5);
+                    eph.af1 = 1.0e-12;
+                    ephemeris[static_cast<int>(eph.PRN)] = eph;
+                }
+        }
+    return ephemeris;
+}
+
+
+// Code delays of the satellites above 10 degrees of elevation
+std::vector<Snapshot_Solver::Measurement> measurements(std::map<int, Gps_Ephemeris> ephemeris)
+{
+    std::vector<Snapshot_Solver::Measurement> result;
+    const double up_norm = std::sqrt(RX_POSITION[0] * RX_POSITION[0] + RX_POSITION[1] * RX_POSITION[1] + RX_POSITION[2] * RX_POSITION[2]);
+    for (auto& entry : ephemeris)
+        {
+            auto& eph = entry.second;
+            double range = 0.07 * SPEED_OF_LIGHT_M_S;
+            std::array<double, 3> los{};
+            for (int i = 0; i < 5; i++)
+                {
+                    const double tau = range / SPEED_OF_LIGHT_M_S;
+                    eph.satellitePosition(RX_TIME_S - tau);
+                    const double theta = GNSS_OMEGA_EARTH_DOT * tau;
+                    const std::array<double, 3> sat{{std::cos(theta) * eph.satpos_X + std::sin(theta) * eph.satpos_Y,
+                        -std::sin(theta) * eph.satpos_X + std::cos(theta) * eph.satpos_Y, eph.satpos_Z}};
+                    range = 0.0;
+                    for (int j = 0; j < 3; j++)
+                        {
+                            los[j] = sat[j] - RX_POSITION[j];
+                            range += los[j] * los[j];
+                        }
+                    range = std::sqrt(range);
+                }
+            const double sin_elevation = (los[0] * RX_POSITION[0] + los[1] * RX_POSITION[1] + los[2] * RX_POSITION[2]) / (range * up_norm);
+            if (sin_elevation < std::sin(10.0 * D2R))
+                {
+                    continue;
+                }
+            const double pseudorange = range + CLOCK_BIAS_M - SPEED_OF_LIGHT_M_S * eph.sv_clock_drift(RX_TIME_S - range / SPEED_OF_LIGHT_M_S);
+            Snapshot_Solver::Measurement measurement;
+            measurement.PRN = eph.PRN;
+            measurement.code_delay_s = std::fmod(pseudorange / SPEED_OF_LIGHT_M_S, 1e-3);
+            result.push_back(measurement);
+        }
+    return result;
+}
+
+
+double distance(const std::array<double, 3>& a, const std::array<double, 3>& b)
+{
+    return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+}
+}  // namespace
+
+
+TEST(SnapshotSolverTest, CoarseTimeFix)
+{
+    const auto ephemeris = constellation();
+    const auto code_delays = measurements(ephemeris);
+    ASSERT_GE(code_delays.size(), 5U);
+
+    Snapshot_Solver solver(ephemeris);
+    // a priori position 60 km away and time 20 s late
+    const std::array<double, 3> approx_position{{RX_POSITION[0] + 40000.0, RX_POSITION[1] - 30000.0, RX_POSITION[2] + 30000.0}};
+    const Snapshot_Solver::Solution solution = solver.solve(code_delays, RX_TIME_S + 20.0, approx_position);
+    ASSERT_TRUE(solution.valid);
+    EXPECT_EQ(solution.satellites, code_delays.size());
+    EXPECT_LT(distance(solution.position_ecef_m, RX_POSITION), 0.01);
+    EXPECT_NEAR(solution.rx_time_s, RX_TIME_S, 1e-6);
+    EXPECT_LT(solution.residual_rms_m, 0.01);
+}
+
+
+TEST(SnapshotSolverTest, NeedsFiveSatellites)
+{
+    const auto ephemeris = constellation();
+    auto code_delays = measurements(ephemeris);
+    code_delays.resize(4);
+    Snapshot_Solver solver(ephemeris);
+    EXPECT_FALSE(solver.solve(code_delays, RX_TIME_S, RX_POSITION).valid);
+}
@@ -0,0 +1,111 @@
+/*!
+ * \file rational_resampler_test.cc
+ * \brief Implements Unit Tests for the polyphase rational resampler.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_resampling_ratio.h"
+#include "in_memory_configuration.h"
+#include "rational_resampler_cc.h"
+#include "rational_resampler_conditioner.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+
+TEST(RationalResamplerTest, RatioSelection)
+{
+    Resampling_Ratio ratio = resampling_ratio(8000000.0, 5000000.0, 1024);
+    EXPECT_EQ(ratio.interpolation, 5U);
+    EXPECT_EQ(ratio.decimation, 8U);
+
+    ratio = resampling_ratio(26000000.0, 4092000.0, 1024);
+    EXPECT_EQ(ratio.interpolation, 1023U);
+    EXPECT_EQ(ratio.decimation, 6500U);
+
+    // integer decimation, as the automatic acquisition resampler always did
+    ratio = acquisition_resampling_ratio(6250000, 2000000.0, 1);
+    EXPECT_EQ(ratio.interpolation, 1U);
+    EXPECT_EQ(ratio.decimation, 2U);
+
+    // a rational ratio gets much closer to the required rate
+    ratio = acquisition_resampling_ratio(6250000, 2000000.0, 16);
+    EXPECT_EQ(ratio.interpolation, 8U);
+    EXPECT_EQ(ratio.decimation, 25U);
+    EXPECT_DOUBLE_EQ(ratio.output_rate(6250000.0), 2000000.0);
+
+    ratio = acquisition_resampling_ratio(2000000, 2000000.0, 16);
+    EXPECT_EQ(ratio.interpolation, 1U);
+    EXPECT_EQ(ratio.decimation, 1U);
+}
+
+
+TEST(RationalResamplerTest, ToneIsResampled)
+{
+    const double fs_in = 8000000.0;
+    const double freq = 150000.0;
+    const int nsamples = 200000;
+    std::vector<gr_complex> input(nsamples);
+    for (int n = 0; n < nsamples; n++)
+        {
+            input[n] = std::polar(1.0F, static_cast<float>(2.0 * M_PI * freq * n / fs_in));
+        }
+
+    auto top_block = gr::make_top_block("rational_resampler_cc_test");
+    auto resampler = make_rational_resampler_cc(5, 8);
+    auto source = gr::blocks::vector_source_c::make(input);
+    auto sink = gr::blocks::vector_sink_c::make();
+    top_block->connect(source, 0, resampler, 0);
+    top_block->connect(resampler, 0, sink, 0);
+    top_block->run();
+
+    const std::vector<gr_complex> output = sink->data();
+    EXPECT_NEAR(static_cast<double>(output.size()), nsamples * 5.0 / 8.0, 2.0);
+
+    // output n is input n * 8 / 5, delayed by the filter
+    const double delay = resampler->delay();
+    for (size_t n = 1000; n < output.size() - 1000; n++)
+        {
+            const double t = static_cast<double>(n) * 8.0 / 5.0 - delay;
+            const gr_complex expected = std::polar(1.0F, static_cast<float>(2.0 * M_PI * freq * t / fs_in));
+            ASSERT_NEAR(std::abs(output[n] - expected), 0.0, 1e-2) << "at sample " << n;
+        }
+}
+
+
+TEST(RationalResamplerTest, ConditionerOutputRate)
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("Resampler.sample_freq_in", "6250000");
+    config->set_property("Resampler.sample_freq_out", "4000000");
+    config->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+    auto conditioner = std::make_shared<RationalResamplerConditioner>(config.get(), "Resampler", 1, 1);
+    EXPECT_EQ("Rational_Resampler", conditioner->implementation());
+
+    const int nsamples = 62500;
+    auto top_block = gr::make_top_block("rational_resampler_conditioner_test");
+    auto source = gr::blocks::vector_source_c::make(std::vector<gr_complex>(nsamples, gr_complex(1.0, 0.0)));
+    auto sink = gr::blocks::vector_sink_c::make();
+    conditioner->connect(top_block);
+    top_block->connect(source, 0, conditioner->get_left_block(), 0);
+    top_block->connect(conditioner->get_right_block(), 0, sink, 0);
+    top_block->run();
+
+    EXPECT_NEAR(static_cast<double>(sink->data().size()), 40000.0, 2.0);
+    // unit gain at DC, once the filter has been filled
+    EXPECT_NEAR(std::abs(sink->data()[20000]), 1.0, 1e-2);
+}
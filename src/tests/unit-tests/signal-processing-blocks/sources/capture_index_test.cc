@@ -0,0 +1,53 @@
+/*!
+ * \file capture_index_test.cc
+ * \brief  This file implements unit tests for the capture index.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capture_index.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+
+TEST(CaptureIndexTest, FindsTheRecordBeforeTheRequestedTime)
+{
+    const std::string filename("./capture_index_test.idx");
+    {
+        CaptureIndexWriter writer;
+        ASSERT_TRUE(writer.open(filename, 1000, 4));
+        // one record per second, across a week rollover
+        writer.write(0, 2200, 604798000);
+        writer.write(4000000, 2200, 604799000);
+        writer.write(8000000, 2201, 0);
+    }
+
+    CaptureIndex index;
+    ASSERT_TRUE(index.load(filename));
+    EXPECT_FALSE(index.empty());
+
+    CaptureIndexRecord record{};
+    EXPECT_FALSE(index.find(2200, 604797.5, record));
+
+    ASSERT_TRUE(index.find(2200, 604799.5, record));
+    EXPECT_EQ(record.item, 4001000U);
+    EXPECT_EQ(record.byte_offset, 4001000U * 4);
+    EXPECT_EQ(record.week, 2200);
+    EXPECT_EQ(record.tow_ms, 604799000);
+
+    ASSERT_TRUE(index.find(2201, 10.0, record));
+    EXPECT_EQ(record.item, 8001000U);
+    EXPECT_DOUBLE_EQ(CaptureIndex::record_time_s(record), 2201.0 * 604800.0);
+
+    std::remove(filename.c_str());
+    EXPECT_FALSE(index.load(filename));
+}
@@ -0,0 +1,104 @@
+/*!
+ * \file compressed_capture_test.cc
+ * \brief  This file implements unit tests for the compressed capture format.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_capture.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+TEST(CompressedCaptureTest, HeaderRoundTrip)
+{
+    CompressedCaptureHeader header;
+    header.item_type = "ishort";
+    header.metadata = "freq=1575420000\n";
+    header.sampling_frequency = 4000000;
+    header.item_size = 2;
+    header.chunk_items = 4096;
+
+    std::stringstream file;
+    ASSERT_TRUE(header.write(file));
+    EXPECT_EQ(file.str().size(), CompressedCaptureHeader::SIZE + header.metadata.size());
+
+    // the total number of items is updated in place when the recording ends
+    header.total_items = 123456;
+    file.seekp(0);
+    ASSERT_TRUE(header.write(file));
+    EXPECT_EQ(file.str().size(), CompressedCaptureHeader::SIZE + header.metadata.size());
+
+    CompressedCaptureHeader read_header;
+    ASSERT_TRUE(read_header.read(file));
+    EXPECT_EQ(read_header.item_type, "ishort");
+    EXPECT_EQ(read_header.metadata, header.metadata);
+    EXPECT_EQ(read_header.sampling_frequency, 4000000);
+    EXPECT_EQ(read_header.total_items, 123456U);
+    EXPECT_EQ(read_header.item_size, 2U);
+    EXPECT_EQ(read_header.chunk_items, 4096U);
+
+    std::stringstream not_a_capture("this is not a compressed capture, just some text that is long enough to fill a header");
+    EXPECT_FALSE(read_header.read(not_a_capture));
+}
+
+
+TEST(CompressedCaptureTest, ChunkRoundTrip)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> noise(-2, 1);
+
+    // two-bit like samples compress, white noise over all the bits does not
+    CompressedCaptureChunk compressible;
+    CompressedCaptureChunk incompressible;
+    compressible.first_item = 0;
+    incompressible.first_item = 65536;
+    for (int i = 0; i < 65536; i++)
+        {
+            compressible.raw.push_back(static_cast<char>(noise(generator)));
+            incompressible.raw.push_back(static_cast<char>(generator()));
+        }
+    ASSERT_TRUE(compressible.compress(3));
+    ASSERT_TRUE(incompressible.compress(3));
+    EXPECT_LT(compressible.stored.size(), compressible.raw.size());
+    EXPECT_EQ(incompressible.stored.size(), incompressible.raw.size());
+
+    std::stringstream file;
+    ASSERT_TRUE(compressible.write(file));
+    ASSERT_TRUE(incompressible.write(file));
+
+    CompressedCaptureChunk chunk;
+    ASSERT_TRUE(chunk.read(file));
+    ASSERT_TRUE(chunk.decompress());
+    EXPECT_EQ(chunk.first_item, 0U);
+    EXPECT_EQ(chunk.raw, compressible.raw);
+
+    ASSERT_TRUE(chunk.read(file));
+    ASSERT_TRUE(chunk.decompress());
+    EXPECT_EQ(chunk.first_item, 65536U);
+    EXPECT_EQ(chunk.raw, incompressible.raw);
+    EXPECT_FALSE(chunk.read(file));
+
+    // skipping reads only the chunk headers
+    file.clear();
+    file.seekg(0);
+    ASSERT_TRUE(chunk.skip(file));
+    EXPECT_EQ(chunk.raw_bytes(), 65536U);
+    ASSERT_TRUE(chunk.read(file));
+    EXPECT_EQ(chunk.first_item, 65536U);
+
+    // a corrupted chunk fails its checksum
+    chunk.stored[100] ^= 0x01;
+    EXPECT_FALSE(chunk.decompress());
+}
@@ -15,7 +15,7 @@
  * -----------------------------------------------------------------------------
  */
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "file_signal_source.h"
 #include "gnss_sdr_make_unique.h"
 #include "in_memory_configuration.h"
@@ -25,7 +25,7 @@
 
 TEST(FileSignalSource, Instantiate)
 {
-    auto queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    auto queue = std::make_shared<Control_Queue>();
     auto config = std::make_shared<InMemoryConfiguration>();
 
     config->set_property("Test.samples", "0");
@@ -44,7 +44,7 @@ TEST(FileSignalSource, Instantiate)
 
 TEST(FileSignalSource, InstantiateFileNotExists)
 {
-    auto queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    auto queue = std::make_shared<Control_Queue>();
     auto config = std::make_shared<InMemoryConfiguration>();
 
     config->set_property("Test.samples", "0");
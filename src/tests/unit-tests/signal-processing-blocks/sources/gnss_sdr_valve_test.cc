@@ -24,14 +24,13 @@
 #else
 #include <gnuradio/analog/sig_source_f.h>
 #endif
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "gnss_sdr_valve.h"
 #include <gnuradio/blocks/null_sink.h>
-#include <pmt/pmt.h>
 
 TEST(ValveTest, CheckEventSentAfter100Samples)
 {
-    auto queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    auto queue = std::make_shared<Control_Queue>();
 
     auto top_block = gr::make_top_block("gnss_sdr_valve_test");
 
@@ -40,7 +39,7 @@ TEST(ValveTest, CheckEventSentAfter100Samples)
     auto sink = gr::blocks::null_sink::make(sizeof(float));
 
     bool expected0 = false;
-    pmt::pmt_t msg;
+    Control_Message msg{};
     EXPECT_EQ(expected0, queue->timed_wait_and_pop(msg, 100));
 
     top_block->connect(source, 0, valve, 0);
@@ -0,0 +1,165 @@
+/*!
+ * \file labsat_decoder_test.cc
+ * \brief Tests the table-driven LabSat decoding against a bit by bit decoding
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "labsat_decoder.h"
+#include <gtest/gtest.h>
+#include <bitset>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// LabSat 2 and 3 samples of a 16-bit word, as (I, Q) levels
+std::vector<std::complex<float>> bitwise_word(int16_t word, int bits_per_sample)
+{
+    const std::bitset<16> bs(word);
+    std::vector<std::complex<float>> samples;
+    if (bits_per_sample == 2)
+        {
+            for (int i = 0; i < 8; i++)
+                {
+                    samples.emplace_back(bs[15 - 2 * i] ? 1.0F : -1.0F, bs[14 - 2 * i] ? 1.0F : -1.0F);
+                }
+        }
+    else
+        {
+            for (int i = 0; i < 4; i++)
+                {
+                    const float I = bs[15 - 4 * i] ? (bs[13 - 4 * i] ? -1.0F : -2.0F) : (bs[13 - 4 * i] ? 2.0F : 1.0F);
+                    const float Q = bs[14 - 4 * i] ? (bs[12 - 4 * i] ? -1.0F : -2.0F) : (bs[12 - 4 * i] ? 2.0F : 1.0F);
+                    samples.emplace_back(I, Q);
+                }
+        }
+    return samples;
+}
+
+
+// LabSat 3 Wideband component of qua bits, MSB first, from the reversed register
+float bitwise_ls3w_level(const std::bitset<64>& bs, int bit_offset, int qua)
+{
+    int code = 0;
+    for (int b = 0; b < qua; b++)
+        {
+            code = (code << 1) | (bs[bit_offset + b] ? 1 : 0);
+        }
+    const std::vector<std::vector<float>> levels{{1.0F, -1.0F},
+        {0.5F, 1.0F, -1.0F, -0.5F},
+        {0.25F, 0.5F, 0.75F, 1.0F, -1.0F, -0.75F, -0.5F, -0.25F}};
+    return levels[qua - 1][code];
+}
+
+
+std::vector<std::complex<float>> bitwise_register(uint64_t reg, int qua, int sft, int spare_bits, int samples_per_register, int channel_offset)
+{
+    std::bitset<64> bs(reg);
+    for (std::size_t i = 0; i < 32; ++i)
+        {
+            const bool t = bs[i];
+            bs[i] = bs[64 - i - 1];
+            bs[64 - i - 1] = t;
+        }
+    std::vector<std::complex<float>> samples;
+    for (int i = 0; i < samples_per_register; i++)
+        {
+            const int bit_offset = spare_bits + i * sft + channel_offset;
+            samples.emplace_back(bitwise_ls3w_level(bs, bit_offset, qua), bitwise_ls3w_level(bs, bit_offset + qua, qua));
+        }
+    return samples;
+}
+}  // namespace
+
+
+TEST(LabsatDecoderTest, Labsat23Words)
+{
+    std::vector<int16_t> words;
+    for (int w = -32768; w < 32768; w++)
+        {
+            words.push_back(static_cast<int16_t>(w));
+        }
+    Labsat_Decoder<std::complex<float>> decoder;
+    Labsat_Decoder<std::complex<int16_t>> decoder_16sc;
+    Labsat_Decoder<std::complex<int8_t>> decoder_8sc;
+    for (int bits_per_sample : {2, 4})
+        {
+            const int samples_per_word = 16 / bits_per_sample;
+            std::vector<std::complex<float>> out(words.size() * samples_per_word);
+            std::vector<std::complex<int16_t>> out_16sc(out.size());
+            std::vector<std::complex<int8_t>> out_8sc(out.size());
+            EXPECT_EQ(decoder.decode_words(words.data(), words.size(), bits_per_sample, out.data()), out.size());
+            EXPECT_EQ(decoder_16sc.decode_words(words.data(), words.size(), bits_per_sample, out_16sc.data()), out.size());
+            EXPECT_EQ(decoder_8sc.decode_words(words.data(), words.size(), bits_per_sample, out_8sc.data()), out.size());
+            for (size_t w = 0; w < words.size(); w++)
+                {
+                    const auto expected = bitwise_word(words[w], bits_per_sample);
+                    for (int s = 0; s < samples_per_word; s++)
+                        {
+                            const size_t n = w * samples_per_word + s;
+                            ASSERT_EQ(out[n], expected[s]);
+                            ASSERT_EQ(out_16sc[n].real(), expected[s].real());
+                            ASSERT_EQ(out_16sc[n].imag(), expected[s].imag());
+                            ASSERT_EQ(out_8sc[n].real(), expected[s].real());
+                            ASSERT_EQ(out_8sc[n].imag(), expected[s].imag());
+                        }
+                }
+        }
+}
+
+
+TEST(LabsatDecoderTest, Labsat3WidebandRegisters)
+{
+    std::mt19937_64 gen(3);
+    std::vector<uint64_t> registers(256);
+    for (auto& reg : registers)
+        {
+            reg = gen();
+        }
+    // QUA, CHN, samples per register, as in labsat23_source
+    const std::vector<std::vector<int>> formats{{1, 1, 32}, {1, 2, 16}, {1, 3, 10}, {2, 1, 16}, {2, 2, 8}, {2, 3, 5}, {3, 1, 10}, {3, 2, 5}, {3, 3, 3}, {1, 1, 30}, {2, 2, 7}};
+    for (const auto& format : formats)
+        {
+            const int qua = format[0];
+            const int chn = format[1];
+            const int samples_per_register = format[2];
+            const int sft = 2 * qua * chn;
+            const int spare_bits = 64 - samples_per_register * qua * 2;
+            Labsat_Decoder<std::complex<float>> decoder;
+            Labsat_Decoder<std::complex<int8_t>> decoder_8sc;
+            decoder.set_ls3w_format(qua, sft, spare_bits, samples_per_register);
+            decoder_8sc.set_ls3w_format(qua, sft, spare_bits, samples_per_register);
+            const float levels = static_cast<float>(1 << (qua - 1));
+            for (int channel = 0; channel < chn; channel++)
+                {
+                    const int channel_offset = channel * qua * 2;
+                    std::vector<std::complex<float>> out(registers.size() * samples_per_register);
+                    std::vector<std::complex<int8_t>> out_8sc(out.size());
+                    EXPECT_EQ(decoder.decode_ls3w_registers(registers.data(), registers.size(), channel_offset, out.data()), out.size());
+                    EXPECT_EQ(decoder_8sc.decode_ls3w_registers(registers.data(), registers.size(), channel_offset, out_8sc.data()), out.size());
+                    for (size_t r = 0; r < registers.size(); r++)
+                        {
+                            const auto expected = bitwise_register(registers[r], qua, sft, spare_bits, samples_per_register, channel_offset);
+                            for (int s = 0; s < samples_per_register; s++)
+                                {
+                                    const size_t n = r * samples_per_register + s;
+                                    ASSERT_EQ(out[n], expected[s]);
+                                    ASSERT_EQ(out_8sc[n].real(), expected[s].real() * levels);
+                                    ASSERT_EQ(out_8sc[n].imag(), expected[s].imag() * levels);
+                                }
+                        }
+                }
+        }
+}
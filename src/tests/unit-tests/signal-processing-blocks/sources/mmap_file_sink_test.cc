@@ -0,0 +1,58 @@
+/*!
+ * \file mmap_file_sink_test.cc
+ * \brief Tests the memory-mapped file sink against the memory-mapped file
+ * source.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_sink.h"
+#include "mmap_file_source.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+TEST(MmapFileSinkTest, WritesAcrossWindowsAndTruncates)
+{
+    const std::string filename = "mmap_file_sink_test.dat";
+    // a bit more than one 128 MiB window of gr_complex samples
+    const size_t nsamples = 17 * 1024 * 1024 + 12345;
+    std::vector<gr_complex> samples(nsamples);
+    for (size_t n = 0; n < nsamples; n++)
+        {
+            samples[n] = gr_complex(static_cast<float>(n % 65536), -static_cast<float>(n % 1000));
+        }
+
+    {
+        auto top_block = gr::make_top_block("mmap_file_sink test");
+        top_block->connect(gr::blocks::vector_source_c::make(samples), 0, make_mmap_file_sink(sizeof(gr_complex), filename), 0);
+        top_block->run();
+    }
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(static_cast<size_t>(file.tellg()), nsamples * sizeof(gr_complex));
+    file.close();
+
+    auto top_block = gr::make_top_block("mmap_file_source test");
+    auto sink = gr::blocks::vector_sink_c::make();
+    top_block->connect(make_mmap_file_source(sizeof(gr_complex), filename, 0, false), 0, sink, 0);
+    top_block->run();
+    EXPECT_TRUE(sink->data() == samples);
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file shm_ring_test.cc
+ * \brief  This file implements unit tests for the shared memory ring buffer.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_shm_ring.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+
+TEST(ShmRingTest, WritesWrapAroundAndOverrunsAreCounted)
+{
+    const char* name = "/gnss-sdr-shm-ring-test";
+    gnss_sdr_shm_ring consumer{};
+    gnss_sdr_shm_ring producer{};
+    ASSERT_EQ(gnss_sdr_shm_ring_create(&consumer, name, 100000, 4), 0);
+    ASSERT_EQ(consumer.header->capacity, 131072U);
+    ASSERT_EQ(gnss_sdr_shm_ring_attach(&producer, name), 0);
+
+    std::vector<uint32_t> samples(10000);
+    std::iota(samples.begin(), samples.end(), 0);
+    const size_t bytes = samples.size() * sizeof(uint32_t);
+
+    uint32_t expected = 0;
+    for (int n = 0; n < 10; n++)
+        {
+            // three writes fit in the buffer, the fourth one is dropped
+            EXPECT_EQ(gnss_sdr_shm_ring_write(&producer, samples.data(), bytes), 0);
+            EXPECT_EQ(gnss_sdr_shm_ring_write(&producer, samples.data(), bytes), 0);
+            EXPECT_EQ(gnss_sdr_shm_ring_write(&producer, samples.data(), bytes), 0);
+            EXPECT_EQ(gnss_sdr_shm_ring_write(&producer, samples.data(), bytes), -1);
+            ASSERT_EQ(gnss_sdr_shm_ring_readable(&consumer), 3 * bytes);
+
+            // the read region is contiguous also across the end of the buffer
+            const auto* data = static_cast<const uint32_t*>(gnss_sdr_shm_ring_read_ptr(&consumer));
+            for (size_t i = 0; i < 3 * samples.size(); i++)
+                {
+                    ASSERT_EQ(data[i], expected);
+                    expected = (expected + 1) % samples.size();
+                }
+            gnss_sdr_shm_ring_release(&consumer, 3 * bytes);
+        }
+    EXPECT_EQ(consumer.header->overruns, 10U);
+    EXPECT_EQ(consumer.header->dropped_bytes, 10U * bytes);
+
+    // nothing to read: returns after the timeout
+    gnss_sdr_shm_ring_wait(&consumer, 10);
+    EXPECT_EQ(gnss_sdr_shm_ring_readable(&consumer), 0U);
+
+    gnss_sdr_shm_ring_close(&producer);
+    gnss_sdr_shm_ring_close(&consumer);
+    shm_unlink(name);
+    EXPECT_NE(gnss_sdr_shm_ring_attach(&producer, name), 0);
+}
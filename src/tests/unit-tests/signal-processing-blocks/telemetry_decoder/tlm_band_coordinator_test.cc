@@ -0,0 +1,71 @@
+/*!
+ * \file tlm_band_coordinator_test.cc
+ * \brief This file implements unit tests for the Tlm_Band_Coordinator class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_band_coordinator.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST(TlmBandCoordinatorTest, FirstClaimDecodes)
+{
+    Tlm_Band_Coordinator coordinator;
+    EXPECT_FALSE(coordinator.decoded_elsewhere(11, 0));
+    EXPECT_TRUE(coordinator.claim(11, 3));
+    EXPECT_TRUE(coordinator.claim(11, 3));  // a new ephemeris in the same channel
+    EXPECT_FALSE(coordinator.claim(11, 7));
+    EXPECT_FALSE(coordinator.decoded_elsewhere(11, 3));
+    EXPECT_TRUE(coordinator.decoded_elsewhere(11, 7));
+    EXPECT_FALSE(coordinator.decoded_elsewhere(12, 7));
+
+    // only the claiming channel releases the satellite
+    coordinator.release(11, 7);
+    EXPECT_TRUE(coordinator.decoded_elsewhere(11, 7));
+    coordinator.release(11, 3);
+    EXPECT_FALSE(coordinator.decoded_elsewhere(11, 7));
+    EXPECT_TRUE(coordinator.claim(11, 7));
+
+    // out of range PRNs are always decoded
+    EXPECT_FALSE(coordinator.claim(64, 1));
+    EXPECT_FALSE(coordinator.decoded_elsewhere(64, 2));
+}
+
+
+TEST(TlmBandCoordinatorTest, OneClaimPerSatellite)
+{
+    Tlm_Band_Coordinator coordinator;
+    const int32_t n_channels = 8;
+    std::atomic<int32_t> claims{0};
+    std::vector<std::thread> threads;
+    for (int32_t channel = 0; channel < n_channels; channel++)
+        {
+            threads.emplace_back([&coordinator, &claims, channel]() {
+                for (uint32_t prn = 1; prn < 37; prn++)
+                    {
+                        if (coordinator.claim(prn, channel))
+                            {
+                                claims++;
+                            }
+                    }
+            });
+        }
+    for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    EXPECT_EQ(claims.load(), 36);
+}
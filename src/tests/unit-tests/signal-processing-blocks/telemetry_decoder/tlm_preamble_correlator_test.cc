@@ -0,0 +1,105 @@
+/*!
+ * \file tlm_preamble_correlator_test.cc
+ * \brief Tests the incremental preamble correlator against the loop it replaces
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_preamble_correlator.h"
+#include <boost/circular_buffer.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+int32_t loop_correlation(const boost::circular_buffer<float>& history, const std::vector<int32_t>& preamble)
+{
+    int32_t corr_value = 0;
+    for (size_t i = 0; i < preamble.size(); i++)
+        {
+            if (history[i] < 0.0)
+                {
+                    corr_value -= preamble[i];
+                }
+            else
+                {
+                    corr_value += preamble[i];
+                }
+        }
+    return corr_value;
+}
+
+
+void check_against_loop(uint32_t preamble_length, uint32_t capacity)
+{
+    std::mt19937 gen(preamble_length * 1000 + capacity);
+    std::uniform_int_distribution<int32_t> coin(0, 1);
+    std::normal_distribution<float> noise(0.0, 1.0);
+
+    std::vector<int32_t> preamble(preamble_length);
+    for (auto& p : preamble)
+        {
+            p = coin(gen) ? 1 : -1;
+        }
+    Tlm_Preamble_Correlator correlator;
+    correlator.set_preamble(preamble.data(), static_cast<int32_t>(preamble.size()));
+    correlator.set_capacity(capacity);
+    boost::circular_buffer<float> history(capacity);
+
+    for (uint32_t n = 0; n < 5 * capacity + 7; n++)
+        {
+            // inserts the preamble from time to time, so that there are matches
+            const float symbol = (n % capacity < preamble_length) ? static_cast<float>(preamble[n % capacity]) : noise(gen);
+            history.push_back(symbol);
+            correlator.push(symbol);
+            ASSERT_EQ(correlator.size(), history.size());
+            if (history.size() >= preamble_length)
+                {
+                    ASSERT_EQ(correlator.correlation(), loop_correlation(history, preamble)) << "P=" << preamble_length << " C=" << capacity << " n=" << n;
+                }
+        }
+}
+}  // namespace
+
+
+TEST(TlmPreambleCorrelatorTest, MatchesLoop)
+{
+    check_against_loop(8, 308);    // GPS L1 C/A
+    check_against_loop(10, 261);   // Galileo INAV
+    check_against_loop(11, 311);   // BeiDou DNAV
+    check_against_loop(30, 2000);  // GLONASS GNAV
+    check_against_loop(70, 100);   // multiword window
+    check_against_loop(64, 64);    // window as long as the history
+    check_against_loop(1, 3);
+}
+
+
+TEST(TlmPreambleCorrelatorTest, Clear)
+{
+    const std::vector<int32_t> preamble{1, -1, -1, 1};
+    Tlm_Preamble_Correlator correlator;
+    correlator.set_preamble(preamble.data(), static_cast<int32_t>(preamble.size()));
+    correlator.set_capacity(6);
+    for (int i = 0; i < 9; i++)
+        {
+            correlator.push(-1.0);
+        }
+    correlator.clear();
+    EXPECT_EQ(correlator.size(), 0U);
+    for (const auto p : preamble)
+        {
+            correlator.push(static_cast<float>(-p));
+        }
+    EXPECT_EQ(correlator.correlation(), -4);
+}
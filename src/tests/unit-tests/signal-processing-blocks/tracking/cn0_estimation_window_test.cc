@@ -0,0 +1,64 @@
+/*!
+ * \file cn0_estimation_window_test.cc
+ * \brief This file implements unit tests for the sliding window C/N0
+ * estimators
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "lock_detectors.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+
+TEST(Cn0EstimationWindowTest, MatchesBatchEstimators)
+{
+    const int window = 20;
+    const float T = 0.001;
+    std::mt19937 gen(3);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::vector<gr_complex> prompts;
+    Cn0_Estimation_Window estimator(window);
+    for (int k = 0; k < 1000; k++)
+        {
+            const float bit = ((k / 20) % 3 == 0) ? -1.0 : 1.0;
+            prompts.emplace_back(8.0F * bit + noise(gen), noise(gen));
+            estimator.push(prompts.back());
+            if (k < window - 1)
+                {
+                    EXPECT_FALSE(estimator.full());
+                    continue;
+                }
+            ASSERT_TRUE(estimator.full());
+            const gr_complex* last = prompts.data() + prompts.size() - window;
+            EXPECT_NEAR(estimator.cn0_m2m4(T), cn0_m2m4_estimator(last, window, T), 1e-3);
+            EXPECT_NEAR(estimator.cn0_svn(T), cn0_svn_estimator(last, window, T), 1e-3);
+        }
+}
+
+
+TEST(Cn0EstimationWindowTest, Reset)
+{
+    Cn0_Estimation_Window estimator(4);
+    for (int k = 0; k < 6; k++)
+        {
+            estimator.push(gr_complex(100.0, 0.0));
+        }
+    estimator.reset();
+    const std::vector<gr_complex> prompts = {{5.0, 1.0}, {-5.0, 0.5}, {4.0, -1.0}, {6.0, 0.0}};
+    for (const auto& p : prompts)
+        {
+            estimator.push(p);
+        }
+    EXPECT_TRUE(estimator.full());
+    EXPECT_NEAR(estimator.cn0_svn(0.001), cn0_svn_estimator(prompts.data(), 4, 0.001), 1e-3);
+}
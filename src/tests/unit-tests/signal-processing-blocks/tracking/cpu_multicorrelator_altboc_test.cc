@@ -0,0 +1,75 @@
+/*!
+ * \file cpu_multicorrelator_altboc_test.cc
+ * \brief This file implements unit tests for the Galileo E5 AltBOC
+ * replica and dual-sideband multicorrelator
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_E5a.h"
+#include "Galileo_E5b.h"
+#include "cpu_multicorrelator_altboc.h"
+#include "galileo_e5_signal_replica.h"
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <complex>
+#include <cstdint>
+
+
+TEST(CpuMulticorrelatorAltbocTest, ConstantEnvelopeReplica)
+{
+    constexpr int32_t length = GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP * GALILEO_E5A_CODE_LENGTH_CHIPS;
+    volk_gnsssdr::vector<std::complex<float>> e5a(length);
+    galileo_e5_altboc_sideband_code_gen_complex(e5a, 1, {'5', 'Q', '\0'});
+    for (int32_t n = 0; n < length; n++)
+        {
+            EXPECT_NEAR(std::norm(e5a[n]), 1.7071068F, 1e-5F);
+        }
+}
+
+
+TEST(CpuMulticorrelatorAltbocTest, SeparatesTheSidebands)
+{
+    constexpr int32_t length = GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP * GALILEO_E5A_CODE_LENGTH_CHIPS;
+    constexpr int32_t n_correlators = 3;
+    volk_gnsssdr::vector<std::complex<float>> e5a(length);
+    volk_gnsssdr::vector<std::complex<float>> e5b(length);
+    galileo_e5_altboc_sideband_code_gen_complex(e5a, 11, {'5', 'Q', '\0'});
+    galileo_e5_altboc_sideband_code_gen_complex(e5b, 11, {'7', 'Q', '\0'});
+
+    // Received E5a pilot only, one sample per local code sample
+    volk_gnsssdr::vector<std::complex<float>> in(length);
+    for (int32_t n = 0; n < length; n++)
+        {
+            in[n] = std::conj(e5a[n]);
+        }
+
+    // Early, Prompt and Late, half a chip apart
+    volk_gnsssdr::vector<float> shifts(n_correlators);
+    shifts[0] = -0.5F * GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP;
+    shifts[1] = 0.0F;
+    shifts[2] = 0.5F * GALILEO_E5_ALTBOC_SAMPLES_PER_CHIP;
+    volk_gnsssdr::vector<std::complex<float>> corr(2 * n_correlators);
+
+    Cpu_Multicorrelator_Altboc correlator;
+    correlator.init(length, n_correlators);
+    correlator.set_local_code_and_taps(length, e5a.data(), e5b.data(), shifts.data());
+    correlator.set_input_output_vectors(corr.data(), in.data());
+    correlator.Carrier_wipeoff_multicorrelator_resampler(0.0, 0.0, 0.0, 1.0, length);
+
+    const float prompt_e5a = std::abs(corr[1]);
+    EXPECT_NEAR(prompt_e5a, 1.7071068F * static_cast<float>(length), 0.01F * static_cast<float>(length));
+    EXPECT_LT(std::abs(corr[0]), 0.75F * prompt_e5a);
+    EXPECT_NEAR(std::abs(corr[0]), std::abs(corr[2]), 0.01F * prompt_e5a);
+    EXPECT_LT(std::abs(corr[n_correlators + 1]), 0.05F * prompt_e5a);
+    EXPECT_NEAR(correlator.sideband_power(1), std::norm(corr[1]) + std::norm(corr[n_correlators + 1]), 1e-3F * std::norm(corr[1]));
+    correlator.free();
+}
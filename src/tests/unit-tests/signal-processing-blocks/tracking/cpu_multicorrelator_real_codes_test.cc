@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <chrono>
+#include <cmath>
 #include <complex>
 #include <random>
 #include <thread>
@@ -252,3 +253,110 @@ TEST(CpuMulticorrelatorRealCodesTest, MeasureExecutionTimeAlloc)
             correlator_pool[n]->free();
         }
 }
+
+
+TEST(CpuMulticorrelatorRealCodesTest, CodeTablesMatchResampler)
+{
+    const int n_correlator_taps = 3;
+    const int vector_length = 4000;
+    const float code_phase_step_chips = 0.2557;
+    volk_gnsssdr::vector<float> ca_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(ca_code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips(n_correlator_taps);
+    local_code_shift_chips[0] = -0.5;
+    local_code_shift_chips[1] = 0.0;
+    local_code_shift_chips[2] = 0.5;
+
+    // Input signal aligned with the prompt correlator for a remnant code phase of 0.4 chips
+    const float rem_code_phase_chips = 0.4;
+    volk_gnsssdr::vector<gr_complex> in_cpu(vector_length);
+    for (int n = 0; n < vector_length; n++)
+        {
+            const auto chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n) - rem_code_phase_chips + GPS_L1_CA_CODE_LENGTH_CHIPS));
+            in_cpu[n] = gr_complex(ca_code[chip % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)], 0.0);
+        }
+
+    volk_gnsssdr::vector<gr_complex> resampled_outs(n_correlator_taps);
+    volk_gnsssdr::vector<gr_complex> table_outs(n_correlator_taps);
+    Cpu_Multicorrelator_Real_Codes resampled;
+    Cpu_Multicorrelator_Real_Codes tables;
+    resampled.init(vector_length, n_correlator_taps);
+    tables.init(vector_length, n_correlator_taps);
+    tables.set_code_tables(16, code_phase_step_chips);
+    resampled.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), ca_code.data(), local_code_shift_chips.data());
+    tables.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), ca_code.data(), local_code_shift_chips.data());
+    resampled.set_input_output_vectors(resampled_outs.data(), in_cpu.data());
+    tables.set_input_output_vectors(table_outs.data(), in_cpu.data());
+
+    resampled.Carrier_wipeoff_multicorrelator_resampler(0.0, 0.0, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length);
+    tables.Carrier_wipeoff_multicorrelator_resampler(0.0, 0.0, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length);
+
+    // The table start phase is within 1/32 chip of the resampler one
+    for (int n = 0; n < n_correlator_taps; n++)
+        {
+            EXPECT_NEAR(std::abs(resampled_outs[n]), std::abs(table_outs[n]), 0.05 * vector_length);
+        }
+    EXPECT_GT(std::abs(table_outs[1]), 0.9 * vector_length);
+
+    resampled.free();
+    tables.free();
+}
+
+
+TEST(CpuMulticorrelatorRealCodesTest, FusedHighDynamicsMatchesResampler)
+{
+    const int n_correlator_taps = 3;
+    const int vector_length = 4000;
+    const float code_phase_step_chips = 0.2557;
+    const float phase_step_rad = 0.01;
+    volk_gnsssdr::vector<float> ca_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(ca_code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips(n_correlator_taps);
+    local_code_shift_chips[0] = -0.5;
+    local_code_shift_chips[1] = 0.0;
+    local_code_shift_chips[2] = 0.5;
+
+    // Input signal aligned with the prompt correlator, with a carrier of phase_step_rad per sample
+    const float rem_code_phase_chips = 0.4;
+    volk_gnsssdr::vector<gr_complex> in_cpu(vector_length);
+    for (int n = 0; n < vector_length; n++)
+        {
+            const auto chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n) - rem_code_phase_chips + GPS_L1_CA_CODE_LENGTH_CHIPS));
+            in_cpu[n] = ca_code[chip % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)] * std::exp(gr_complex(0.0, phase_step_rad * static_cast<float>(n)));
+        }
+
+    volk_gnsssdr::vector<gr_complex> resampled_outs(n_correlator_taps);
+    volk_gnsssdr::vector<gr_complex> fused_outs(n_correlator_taps);
+    volk_gnsssdr::vector<gr_complex> range_outs(n_correlator_taps);
+    Cpu_Multicorrelator_Real_Codes resampled;
+    Cpu_Multicorrelator_Real_Codes fused;
+    resampled.set_high_dynamics_resampler(false);
+    fused.set_high_dynamics_resampler(true);
+    resampled.init(vector_length, n_correlator_taps);
+    fused.init(vector_length, n_correlator_taps);
+    resampled.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), ca_code.data(), local_code_shift_chips.data());
+    fused.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), ca_code.data(), local_code_shift_chips.data());
+    resampled.set_input_output_vectors(resampled_outs.data(), in_cpu.data());
+    fused.set_input_output_vectors(fused_outs.data(), in_cpu.data());
+
+    resampled.Carrier_wipeoff_multicorrelator_resampler(0.0, phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length);
+    fused.Carrier_wipeoff_multicorrelator_resampler(0.0, phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length);
+    for (int n = 0; n < n_correlator_taps; n++)
+        {
+            EXPECT_NEAR(std::abs(resampled_outs[n] - fused_outs[n]), 0.0, 1e-3 * vector_length);
+        }
+    EXPECT_GT(std::abs(fused_outs[1]), 0.9 * vector_length);
+
+    // Correlating in two ranges gives the same result
+    fused.set_input_output_vectors(range_outs.data(), in_cpu.data());
+    fused.update_local_code(vector_length, rem_code_phase_chips, code_phase_step_chips, 0.0);
+    fused.Carrier_wipeoff_multicorrelator_range(0.0, phase_step_rad, 0.0, 0, 1000);
+    fused.Carrier_wipeoff_multicorrelator_range(0.0, phase_step_rad, 0.0, 1000, vector_length - 1000);
+    for (int n = 0; n < n_correlator_taps; n++)
+        {
+            EXPECT_NEAR(std::abs(range_outs[n] - fused_outs[n]), 0.0, 1e-3 * vector_length);
+        }
+
+    resampled.free();
+    fused.free();
+}
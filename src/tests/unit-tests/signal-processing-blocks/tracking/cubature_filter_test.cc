@@ -42,6 +42,22 @@ private:
     arma::mat coeff_mat;
 };
 
+class BatchedModel : public ModelFunction
+{
+public:
+    explicit BatchedModel(const arma::mat& coeff) : coeff_mat(coeff){};
+    arma::vec operator()(const arma::vec& input) override { return coeff_mat * input; };
+    arma::mat evaluate_columns(const arma::mat& points) override
+    {
+        calls++;
+        return coeff_mat * points;
+    };
+    int calls{0};
+
+private:
+    arma::mat coeff_mat;
+};
+
 TEST(CubatureFilterComputationTest, CubatureFilterTest)
 {
     CubatureFilter kf_cubature;
@@ -146,3 +162,35 @@ TEST(CubatureFilterComputationTest, CubatureFilterTest)
             delete measurement_function;
         }
 }
+
+
+TEST(CubatureFilterComputationTest, BatchedModelFunction)
+{
+    const arma::mat kf_F = {{1.0, 0.001}, {0.0, 1.0}};
+    const arma::mat kf_H = {{1.0, 0.0}};
+    const arma::mat kf_Q = 1e-4 * arma::eye(2, 2);
+    const arma::mat kf_R = {{0.01}};
+    const arma::vec kf_x = {1.0, 2.0};
+    const arma::mat kf_P_x = {{0.5, 0.1}, {0.1, 0.3}};
+    const arma::vec kf_y = {1.2};
+
+    // the models evaluated one point at a time, and all the points at once
+    TransitionModel transition_function(kf_F);
+    MeasurementModel measurement_function(kf_H);
+    BatchedModel batched_transition_function(kf_F);
+    BatchedModel batched_measurement_function(kf_H);
+    CubatureFilter kf_sequential;
+    CubatureFilter kf_batched;
+
+    kf_sequential.predict_sequential(kf_x, kf_P_x, &transition_function, kf_Q);
+    kf_batched.predict_sequential(kf_x, kf_P_x, &batched_transition_function, kf_Q);
+    EXPECT_EQ(batched_transition_function.calls, 1);
+    EXPECT_TRUE(arma::approx_equal(kf_batched.get_x_pred(), kf_sequential.get_x_pred(), "absdiff", 1e-9));
+    EXPECT_TRUE(arma::approx_equal(kf_batched.get_P_x_pred(), kf_sequential.get_P_x_pred(), "absdiff", 1e-9));
+
+    kf_sequential.update_sequential(kf_y, kf_sequential.get_x_pred(), kf_sequential.get_P_x_pred(), &measurement_function, kf_R);
+    kf_batched.update_sequential(kf_y, kf_batched.get_x_pred(), kf_batched.get_P_x_pred(), &batched_measurement_function, kf_R);
+    EXPECT_EQ(batched_measurement_function.calls, 1);
+    EXPECT_TRUE(arma::approx_equal(kf_batched.get_x_est(), kf_sequential.get_x_est(), "absdiff", 1e-9));
+    EXPECT_TRUE(arma::approx_equal(kf_batched.get_P_x_est(), kf_sequential.get_P_x_est(), "absdiff", 1e-9));
+}
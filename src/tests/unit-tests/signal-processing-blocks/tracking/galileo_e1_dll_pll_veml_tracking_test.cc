@@ -17,7 +17,7 @@
  */
 
 
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "galileo_e1_dll_pll_veml_tracking.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
@@ -52,7 +52,7 @@ protected:
 
     void init();
 
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
     gr::top_block_sptr top_block;
     std::shared_ptr<GNSSBlockFactory> factory;
     std::shared_ptr<InMemoryConfiguration> config;
@@ -99,7 +99,7 @@ TEST_F(GalileoE1DllPllVemlTrackingInternalTest, ConnectAndRun)
     std::chrono::time_point<std::chrono::system_clock> end;
     std::chrono::duration<double> elapsed_seconds(0);
     init();
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
     top_block = gr::make_top_block("Tracking test");
 
     // Example using smart pointers and the block factory
@@ -147,7 +147,7 @@ TEST_F(GalileoE1DllPllVemlTrackingInternalTest, ValidationOfResults)
     int num_samples = 80000000;           // 8 Msps
     unsigned int skiphead_sps = 8000000;  // 8 Msps
     init();
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
     top_block = gr::make_top_block("Tracking test");
 
     // Example using smart pointers and the block factory
@@ -0,0 +1,112 @@
+/*!
+ * \file glonass_fdma_channelizer_test.cc
+ * \brief This file implements unit tests for the shared GLONASS FDMA
+ * channelizer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "glonass_fdma_channelizer.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+// Tone at the frequency of a slot plus an offset, starting at absolute sample first
+std::vector<std::complex<float>> slot_tone(int64_t fs, int32_t slot, double offset_hz, uint64_t first, int32_t n)
+{
+    std::vector<std::complex<float>> tone(n);
+    for (int32_t i = 0; i < n; i++)
+        {
+            const double t = static_cast<double>(first + i) / static_cast<double>(fs);
+            const double phase = TWO_PI * (slot * 562500.0 + offset_hz) * t;
+            tone[i] = std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+    return tone;
+}
+}  // namespace
+
+
+TEST(GlonassFdmaChannelizerTest, TranslatesSlotToBaseband)
+{
+    const int64_t fs = 12500000;
+    const int32_t decimation = 5;
+    Glonass_Fdma_Channelizer channelizer(fs, 562500, decimation);
+
+    const uint64_t first = 1000003;  // not a multiple of the decimation
+    const int32_t n = 12500;
+    const std::vector<std::complex<float>> in = slot_tone(fs, -3, 0.0, first, n);
+    std::vector<std::complex<float>> out(n / decimation + 1);
+    uint64_t first_output = 0;
+    const int32_t n_out = channelizer.translate(-3, first, in.data(), n, out.data(), first_output);
+
+    EXPECT_EQ(first_output, (first + decimation - 1) / decimation);
+    EXPECT_EQ(n_out, static_cast<int32_t>((first + n) / decimation - first_output));
+    for (int32_t j = 0; j < n_out; j++)
+        {
+            // a slot tone becomes a constant, summed over the dump
+            EXPECT_NEAR(out[j].real(), static_cast<float>(decimation), 1e-3);
+            EXPECT_NEAR(out[j].imag(), 0.0, 1e-3);
+        }
+}
+
+
+TEST(GlonassFdmaChannelizerTest, SharedBetweenChannels)
+{
+    const int64_t fs = 12500000;
+    const int32_t decimation = 4;
+    Glonass_Fdma_Channelizer channelizer(fs, 562500, decimation);
+
+    const uint64_t first = 40000;
+    const int32_t n = 8000;
+    const std::vector<std::complex<float>> in = slot_tone(fs, 2, 1000.0, first, 2 * n);
+    std::vector<std::complex<float>> a(n);
+    std::vector<std::complex<float>> b(n);
+    uint64_t first_a = 0;
+    uint64_t first_b = 0;
+
+    const int32_t n_a = channelizer.translate(2, first, in.data(), n, a.data(), first_a);
+    EXPECT_EQ(channelizer.computed_samples(), static_cast<uint64_t>(n_a));
+
+    // a second channel, a few samples behind, reuses the samples of the first
+    const int32_t n_b = channelizer.translate(2, first + 6, in.data() + 6, n - 6, b.data(), first_b);
+    EXPECT_EQ(channelizer.computed_samples(), static_cast<uint64_t>(n_a));
+    ASSERT_EQ(first_b, first_a + 2);
+    for (int32_t j = 0; j < n_b; j++)
+        {
+            EXPECT_EQ(b[j], a[j + 2]);
+        }
+
+    // the next block of the first channel continues the phase
+    const int32_t n_c = channelizer.translate(2, first + n, in.data() + n, n, b.data(), first_b);
+    EXPECT_EQ(channelizer.computed_samples(), static_cast<uint64_t>(n_a + n_c));
+    const std::complex<float> step = b[0] / a[n_a - 1];
+    const double expected_step = TWO_PI * 1000.0 * decimation / static_cast<double>(fs);
+    EXPECT_NEAR(std::arg(step), expected_step, 1e-4);
+}
+
+
+TEST(GlonassFdmaChannelizerTest, SharedInstances)
+{
+    const int stream_a = 0;
+    const int stream_b = 0;
+    auto a1 = Glonass_Fdma_Channelizer::shared(&stream_a, 12500000, 562500, 4);
+    auto a2 = Glonass_Fdma_Channelizer::shared(&stream_a, 12500000, 562500, 4);
+    auto b = Glonass_Fdma_Channelizer::shared(&stream_b, 12500000, 562500, 4);
+    EXPECT_EQ(a1, a2);
+    EXPECT_NE(a1, b);
+    EXPECT_EQ(a1->decimation(), 4);
+}
@@ -19,11 +19,13 @@
 #include "cuda_multicorrelator.h"
 #include "gps_sdr_signal_replica.h"
 #include <chrono>
+#include <cmath>
 #include <complex>
 #include <cuda.h>
 #include <cuda_profiler_api.h>
 #include <cuda_runtime.h>
 #include <thread>
+#include <vector>
 
 
 DEFINE_int32(gpu_multicorrelator_iterations_test, 1000, "Number of averaged iterations in GPU multicorrelator test timing test");
@@ -148,3 +150,73 @@ TEST(GpuMulticorrelatorTest, MeasureExecutionTime)
             correlator_pool[n]->free_cuda();
         }
 }
+
+
+TEST(GpuMulticorrelatorTest, SampleRingMatchesReference)
+{
+    const int d_n_correlator_taps = 3;
+    const int correlation_size = 4096;
+    gr_complex* d_ca_code;
+    gr_complex* in_gpu;
+    gr_complex* d_correlator_outs;
+    float* d_local_code_shift_chips;
+    cudaSetDeviceFlags(cudaDeviceMapHost);
+    cudaHostAlloc(reinterpret_cast<void**>(&d_ca_code), (static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) * sizeof(gr_complex)), cudaHostAllocMapped | cudaHostAllocWriteCombined);
+    cudaHostAlloc(reinterpret_cast<void**>(&d_local_code_shift_chips), d_n_correlator_taps * sizeof(float), cudaHostAllocMapped | cudaHostAllocWriteCombined);
+    cudaHostAlloc(reinterpret_cast<void**>(&in_gpu), correlation_size * sizeof(gr_complex), cudaHostAllocMapped | cudaHostAllocWriteCombined);
+    cudaHostAlloc(reinterpret_cast<void**>(&d_correlator_outs), sizeof(gr_complex) * d_n_correlator_taps, cudaHostAllocMapped | cudaHostAllocWriteCombined);
+
+    gps_l1_ca_code_gen_complex(own::span<gr_complex>(d_ca_code, static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)), 1, 0);
+    // a stream of several correlations, so that the ring wraps around
+    std::vector<gr_complex> stream(20 * correlation_size);
+    for (auto& sample : stream)
+        {
+            sample = std::complex<float>(static_cast<float>(rand()) / static_cast<float>(RAND_MAX), static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+        }
+    d_local_code_shift_chips[0] = -0.5;
+    d_local_code_shift_chips[1] = 0.0;
+    d_local_code_shift_chips[2] = 0.5;
+
+    cuda_multicorrelator correlator;
+    correlator.init_cuda_integrated_resampler(correlation_size, GPS_L1_CA_CODE_LENGTH_CHIPS, d_n_correlator_taps);
+    correlator.set_input_output_vectors(d_correlator_outs, in_gpu);
+    correlator.set_sample_ring(8 * correlation_size, 2);
+    correlator.set_local_code_and_taps(GPS_L1_CA_CODE_LENGTH_CHIPS, d_ca_code, d_local_code_shift_chips, d_n_correlator_taps);
+
+    const float rem_carrier_phase_rad = 0.2;
+    const float phase_step_rad = 0.1;
+    const float code_phase_step_chips = 0.3;
+    const float rem_code_phase_chips = 0.4;
+    for (size_t sample_index = 0; sample_index + correlation_size <= stream.size(); sample_index += correlation_size)
+        {
+            ASSERT_TRUE(correlator.Carrier_wipeoff_multicorrelator_resampler_ring_cuda(sample_index, &stream[sample_index],
+                rem_carrier_phase_rad, phase_step_rad, code_phase_step_chips, rem_code_phase_chips, correlation_size, d_n_correlator_taps));
+            for (int n = 0; n < d_n_correlator_taps; n++)
+                {
+                    // same carrier wipe-off and code resampling as the kernel, in double precision
+                    std::complex<double> expected(0.0, 0.0);
+                    for (int pos = 0; pos < correlation_size; pos++)
+                        {
+                            double chip = std::fmod(code_phase_step_chips * pos + d_local_code_shift_chips[n] - rem_code_phase_chips, GPS_L1_CA_CODE_LENGTH_CHIPS);
+                            if (chip < 0.0)
+                                {
+                                    chip += GPS_L1_CA_CODE_LENGTH_CHIPS - 1;
+                                }
+                            expected += std::complex<double>(stream[sample_index + pos]) *
+                                        std::polar(1.0, -(rem_carrier_phase_rad + pos * static_cast<double>(phase_step_rad))) *
+                                        std::complex<double>(d_ca_code[static_cast<int>(std::floor(chip))]);
+                        }
+                    EXPECT_NEAR(expected.real(), d_correlator_outs[n].real(), 1e-3 * correlation_size);
+                    EXPECT_NEAR(expected.imag(), d_correlator_outs[n].imag(), 1e-3 * correlation_size);
+                }
+        }
+    // samples that have been overwritten are not served from the ring
+    EXPECT_FALSE(correlator.Carrier_wipeoff_multicorrelator_resampler_ring_cuda(0, stream.data(),
+        rem_carrier_phase_rad, phase_step_rad, code_phase_step_chips, rem_code_phase_chips, correlation_size, d_n_correlator_taps));
+
+    correlator.free_cuda();
+    cudaFreeHost(in_gpu);
+    cudaFreeHost(d_correlator_outs);
+    cudaFreeHost(d_local_code_shift_chips);
+    cudaFreeHost(d_ca_code);
+}
@@ -0,0 +1,149 @@
+/*!
+ * \file secondary_code_sync_test.cc
+ * \brief Tests the bit-packed secondary code synchronization against the
+ * character loop it replaces
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "secondary_code_sync.h"
+#include <boost/circular_buffer.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+
+namespace
+{
+// correlation of the symbols with the code rotated by shift chips
+int32_t loop_correlation(const boost::circular_buffer<float>& history, const std::string& code, uint32_t shift)
+{
+    int32_t corr_value = 0;
+    for (uint32_t i = 0; i < code.size(); i++)
+        {
+            const bool zero = code[(i + shift) % code.size()] == '0';
+            if (history[i] < 0.0)
+                {
+                    corr_value += zero ? 1 : -1;
+                }
+            else
+                {
+                    corr_value += zero ? -1 : 1;
+                }
+        }
+    return corr_value;
+}
+
+
+void check_against_loop(const std::string& code, uint32_t shift_step)
+{
+    std::mt19937 gen(static_cast<uint32_t>(code.size() * 100 + shift_step));
+    std::uniform_int_distribution<uint32_t> start(0, static_cast<uint32_t>(code.size()) - 1);
+    std::uniform_int_distribution<int32_t> coin(0, 1);
+    std::uniform_int_distribution<int32_t> error(0, 199);
+    std::normal_distribution<float> amplitude(1.0, 0.1);
+
+    Secondary_Code_Sync sync;
+    sync.set_code(code, shift_step);
+    boost::circular_buffer<float> history(code.size());
+    int32_t locks = 0;
+    for (int32_t run = 0; run < 20; run++)
+        {
+            sync.clear();
+            history.clear();
+            // the code from a random chip, with a few sign errors and a
+            // random PLL phase
+            uint32_t chip = start(gen);
+            const float phase = coin(gen) ? 1.0F : -1.0F;
+            for (uint32_t n = 0; n < 3 * code.size(); n++)
+                {
+                    float symbol = phase * amplitude(gen) * (code[chip] == '0' ? -1.0F : 1.0F);
+                    if (error(gen) == 0)
+                        {
+                            symbol = -symbol;
+                        }
+                    chip = (chip + 1) % code.size();
+                    sync.push(symbol);
+                    history.push_back(symbol);
+                    ASSERT_EQ(sync.full(), history.full());
+                    if (!history.full())
+                        {
+                            continue;
+                        }
+                    uint32_t expected_shift = 0;
+                    bool expected_found = false;
+                    bool expected_inverted = false;
+                    for (uint32_t s = 0; s < code.size() && !expected_found; s += shift_step)
+                        {
+                            const int32_t corr = loop_correlation(history, code, s);
+                            if (std::abs(corr) == static_cast<int32_t>(code.size()))
+                                {
+                                    expected_found = true;
+                                    expected_shift = s;
+                                    expected_inverted = corr < 0;
+                                }
+                        }
+                    uint32_t shift = 0;
+                    bool inverted = false;
+                    ASSERT_EQ(sync.find(shift, inverted), expected_found);
+                    if (expected_found)
+                        {
+                            EXPECT_EQ(shift, expected_shift);
+                            EXPECT_EQ(inverted, expected_inverted);
+                            locks++;
+                        }
+                }
+        }
+    EXPECT_GT(locks, 0);
+}
+}  // namespace
+
+
+TEST(SecondaryCodeSyncTest, MatchesTheLoopAtAllShifts)
+{
+    check_against_loop(GALILEO_E1_C_SECONDARY_CODE, 1);
+}
+
+
+TEST(SecondaryCodeSyncTest, MatchesTheLoopAtDataSymbolShifts)
+{
+    // E5a-Q code of 100 chips, E5a-I symbols of 20 chips
+    check_against_loop(GALILEO_E5A_Q_SECONDARY_CODE[0], 20);
+}
+
+
+TEST(SecondaryCodeSyncTest, PreambleOnlyAtItsStart)
+{
+    const std::string preamble("0000011111000001111111111");
+    Secondary_Code_Sync sync;
+    sync.set_code(preamble, static_cast<uint32_t>(preamble.size()));
+    uint32_t shift = 0;
+    bool inverted = true;
+    // the preamble from its sixth symbol does not lock
+    for (uint32_t i = 0; i < preamble.size(); i++)
+        {
+            sync.push(preamble[(i + 5) % preamble.size()] == '0' ? -1.0F : 1.0F);
+        }
+    EXPECT_TRUE(sync.full());
+    EXPECT_FALSE(sync.find(shift, inverted));
+    // the next symbols complete it
+    for (uint32_t i = 5; i < preamble.size(); i++)
+        {
+            sync.push(preamble[i] == '0' ? -1.0F : 1.0F);
+        }
+    EXPECT_TRUE(sync.find(shift, inverted));
+    EXPECT_EQ(shift, 0U);
+    EXPECT_FALSE(inverted);
+}
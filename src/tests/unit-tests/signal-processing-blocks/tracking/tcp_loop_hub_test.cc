@@ -0,0 +1,115 @@
+/*!
+ * \file tcp_loop_hub_test.cc
+ * \brief This file implements unit tests for the Tcp_Loop_Hub class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tcp_communication.h"
+#include "tcp_loop_hub.h"
+#include <boost/asio.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+
+TEST(TcpLoopHubTest, BatchesThePacketsOfAllTheChannels)
+{
+    const size_t port = 2460;
+    const uint32_t n_channels = 8;
+    size_t messages = 0;
+    std::promise<void> first_epoch_done;
+    std::future<void> first_epoch = first_epoch_done.get_future();
+
+    // External loop: answers each packet with its channel as code error, once
+    // all the channels have run their first epoch
+    std::thread external_loop([&messages, &first_epoch, port, n_channels]() {
+        b_io_context io_context;
+        boost::asio::ip::tcp::socket socket(io_context);
+        const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), static_cast<uint16_t>(port));
+        for (int attempt = 0; attempt < 100; attempt++)
+            {
+                boost::system::error_code ec;
+                socket.connect(endpoint, ec);
+                if (!ec)
+                    {
+                        break;
+                    }
+                socket.close();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        uint32_t received = 0;
+        std::vector<char> answers;
+        while (received < n_channels)
+            {
+                uint32_t count = 0;
+                boost::asio::read(socket, boost::asio::buffer(&count, sizeof(count)));
+                for (uint32_t i = 0; i < count; i++)
+                    {
+                        std::array<uint32_t, 2> header{};
+                        boost::asio::read(socket, boost::asio::buffer(header));
+                        std::vector<float> values(header[1]);
+                        boost::asio::read(socket, boost::asio::buffer(values));
+                        const std::array<float, 4> answer{{values[0], static_cast<float>(header[0]), 0.5F, 1000.0F}};
+                        answers.insert(answers.end(), reinterpret_cast<char *>(&header[0]), reinterpret_cast<char *>(&header[0]) + sizeof(uint32_t));
+                        answers.insert(answers.end(), reinterpret_cast<const char *>(answer.data()), reinterpret_cast<const char *>(answer.data()) + sizeof(answer));
+                    }
+                received += count;
+                messages++;
+            }
+        first_epoch.wait();
+        boost::asio::write(socket, boost::asio::buffer(&received, sizeof(received)));
+        boost::asio::write(socket, boost::asio::buffer(answers));
+    });
+
+    {
+        std::vector<Tcp_Communication> channels(n_channels);
+        for (uint32_t channel = 0; channel < n_channels; channel++)
+            {
+                channels[channel].connect_batched_loop(port, channel);
+            }
+        for (uint32_t channel = 0; channel < n_channels; channel++)
+            {
+                // no answer yet: the acquisition Doppler, uncorrected
+                Tcp_Packet_Data data;
+                boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> packet = {{1, 0, 0, 0, 0, 0, 0, 250, 1}};
+                channels[channel].send_receive_tcp_packet_gps_l1_ca(packet, &data);
+                EXPECT_FLOAT_EQ(data.proc_pack_code_error, 0.0);
+                EXPECT_FLOAT_EQ(data.proc_pack_carrier_doppler_hz, 250.0);
+            }
+        first_epoch_done.set_value();
+        external_loop.join();
+        EXPECT_LE(messages, static_cast<size_t>(n_channels));
+
+        // the answers are picked up at the next epoch of each channel
+        for (uint32_t channel = 0; channel < n_channels; channel++)
+            {
+                Tcp_Packet_Data data;
+                for (int attempt = 0; attempt < 100 and data.proc_pack_carrier_doppler_hz != 1000.0; attempt++)
+                    {
+                        boost::array<float, NUM_TX_VARIABLES_GPS_L1_CA> packet = {{2, 0, 0, 0, 0, 0, 0, 250, 1}};
+                        channels[channel].send_receive_tcp_packet_gps_l1_ca(packet, &data);
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                EXPECT_FLOAT_EQ(data.proc_pack_code_error, static_cast<float>(channel));
+                EXPECT_FLOAT_EQ(data.proc_pack_carr_error, 0.5);
+                EXPECT_FLOAT_EQ(data.proc_pack_carrier_doppler_hz, 1000.0);
+            }
+        for (uint32_t channel = 0; channel < n_channels; channel++)
+            {
+                channels[channel].close_tcp_connection(port);
+            }
+    }
+}
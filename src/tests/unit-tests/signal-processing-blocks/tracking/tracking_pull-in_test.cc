@@ -22,7 +22,7 @@
 #include "Galileo_E1.h"
 #include "Galileo_E5a.h"
 #include "acquisition_msg_rx.h"
-#include "concurrent_queue.h"
+#include "control_queue.h"
 #include "galileo_e1_pcps_ambiguous_acquisition.h"
 #include "galileo_e5a_noncoherent_iq_acquisition_caf.h"
 #include "galileo_e5a_pcps_acquisition.h"
@@ -223,7 +223,7 @@ public:
     Gnss_Synchro gnss_synchro;
     size_t item_size;
 
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
 };
 
 
@@ -782,7 +782,7 @@ TEST_F(TrackingPullInTest, ValidationOfResults)
         }
 
     // create the msg queue for valve
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
     long long int acq_to_trk_delay_samples = ceil(static_cast<double>(FLAGS_fs_gen_sps) * FLAGS_acq_to_trk_delay_s);
     auto resetable_valve_ = gnss_sdr_make_valve(sizeof(gr_complex), acq_to_trk_delay_samples, queue.get(), false);
 
@@ -864,7 +864,7 @@ TEST_F(TrackingPullInTest, ValidationOfResults)
                                         top_block_trk->start();
                                         std::cout << " Waiting for valve...\n";
                                         // wait the valve message indicating the circulation of the amount of samples of the delay
-                                        pmt::pmt_t msg;
+                                        Control_Message msg{};
                                         queue->wait_and_pop(msg);
                                         std::cout << " Starting tracking...\n";
                                         tracking->start_tracking();
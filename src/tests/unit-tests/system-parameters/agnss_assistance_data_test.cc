@@ -0,0 +1,93 @@
+/*!
+ * \file agnss_assistance_data_test.cc
+ * \brief This file implements unit tests for the binary assistance file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "agnss_assistance_data.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+
+TEST(AgnssAssistanceDataTest, SaveAndLoad)
+{
+    const std::string filename = "./agnss_assistance_data_test.bin";
+    Agnss_Assistance_Data saved;
+    for (int prn = 1; prn <= 32; prn++)
+        {
+            Gps_Ephemeris eph;
+            eph.PRN = prn;
+            eph.sqrtA = 5153.0 + prn;
+            saved.gps_ephemeris_map[prn] = eph;
+        }
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 11;
+    gal_eph.ecc = 1.5e-4;
+    saved.gal_ephemeris_map[11] = gal_eph;
+    Glonass_Gnav_Ephemeris glo_eph;
+    glo_eph.PRN = 3;
+    saved.glonass_gnav_ephemeris_map[3] = glo_eph;
+    saved.gps_iono.alpha0 = 1.1e-8;
+    saved.gps_iono.valid = true;
+    saved.gal_utc.A0 = 2.5e-9;
+    saved.ref_time.tow = 345600.0;
+    saved.ref_time.valid = true;
+    ASSERT_TRUE(saved.save(filename));
+    EXPECT_NE(saved.creation_time, 0);
+
+    Agnss_Assistance_Data loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    EXPECT_FALSE(loaded.empty());
+    EXPECT_EQ(loaded.creation_time, saved.creation_time);
+    ASSERT_EQ(loaded.gps_ephemeris_map.size(), 32U);
+    EXPECT_DOUBLE_EQ(loaded.gps_ephemeris_map.at(7).sqrtA, 5160.0);
+    EXPECT_DOUBLE_EQ(loaded.gal_ephemeris_map.at(11).ecc, 1.5e-4);
+    EXPECT_EQ(loaded.glonass_gnav_ephemeris_map.at(3).PRN, 3U);
+    EXPECT_TRUE(loaded.gps_iono.valid);
+    EXPECT_DOUBLE_EQ(loaded.gps_iono.alpha0, 1.1e-8);
+    EXPECT_DOUBLE_EQ(loaded.gal_utc.A0, 2.5e-9);
+    EXPECT_TRUE(loaded.ref_time.valid);
+    EXPECT_TRUE(loaded.gps_cnav_ephemeris_map.empty());
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(AgnssAssistanceDataTest, RejectsTruncatedFiles)
+{
+    const std::string filename = "./agnss_assistance_data_test.bin";
+    const std::string truncated_filename = "./agnss_assistance_data_test_truncated.bin";
+    Agnss_Assistance_Data saved;
+    Gps_Ephemeris eph;
+    eph.PRN = 1;
+    saved.gps_ephemeris_map[1] = eph;
+    ASSERT_TRUE(saved.save(filename));
+    {
+        std::ifstream in(filename, std::ios::binary);
+        const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(truncated_filename, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+
+    Agnss_Assistance_Data loaded;
+    loaded.gps_iono.valid = true;
+    EXPECT_FALSE(loaded.load(truncated_filename));
+    EXPECT_FALSE(loaded.load("./agnss_assistance_data_test_missing.bin"));
+    EXPECT_TRUE(loaded.gps_iono.valid);  // left untouched
+    EXPECT_TRUE(loaded.empty());
+
+    std::remove(filename.c_str());
+    std::remove(truncated_filename.c_str());
+}
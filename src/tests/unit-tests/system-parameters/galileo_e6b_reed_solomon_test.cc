@@ -18,6 +18,8 @@
 #include "gnss_sdr_make_unique.h"
 #include "reed_solomon.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 
 
 TEST(ReedSolomonE6BTest, EncodeWithGenMatrix)
@@ -760,3 +762,103 @@ TEST(ReedSolomonE6BTest, DecodeErasure)
     std::vector<uint8_t> decoded(encoded_input.begin(), encoded_input.begin() + 32);
     EXPECT_TRUE(expected_output == decoded);
 }
+
+
+TEST(ReedSolomonE6BTest, DecodeErasureMatrix)
+{
+    auto rs = std::make_unique<ReedSolomon>();
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> symbol(0, 255);
+    constexpr size_t columns = 53;
+
+    // Messages of 32 pages and shorter ones, received at random PIDs
+    for (size_t k : {32, 11, 1})
+        {
+            std::vector<std::vector<uint8_t>> codewords;
+            for (size_t col = 0; col < columns; col++)
+                {
+                    std::vector<uint8_t> message(32, 0);
+                    for (size_t i = 0; i < k; i++)
+                        {
+                            message[i] = static_cast<uint8_t>(symbol(gen));
+                        }
+                    codewords.push_back(rs->encode_with_generator_matrix(message));
+                }
+
+            std::vector<int> candidates;
+            for (int position = 0; position < 255; position++)
+                {
+                    if (position < static_cast<int>(k) || position >= 32)
+                        {
+                            candidates.push_back(position);
+                        }
+                }
+            std::shuffle(candidates.begin(), candidates.end(), gen);
+            std::vector<int> received_positions(candidates.begin(), candidates.begin() + k);
+            std::sort(received_positions.begin(), received_positions.end());
+
+            std::vector<uint8_t> decoding_matrix;
+            ASSERT_TRUE(rs->get_erasure_decoding_matrix(received_positions, decoding_matrix));
+
+            // rows of received symbols, as the HAS pages
+            std::vector<std::vector<uint8_t>> pages(k, std::vector<uint8_t>(columns));
+            std::vector<const uint8_t*> received;
+            for (size_t j = 0; j < k; j++)
+                {
+                    for (size_t col = 0; col < columns; col++)
+                        {
+                            pages[j][col] = codewords[col][received_positions[j]];
+                        }
+                    received.push_back(pages[j].data());
+                }
+            std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(columns, 0xFF));
+            rs->decode_with_erasure_matrix(decoding_matrix, received, columns, decoded);
+
+            for (size_t col = 0; col < columns; col++)
+                {
+                    for (size_t i = 0; i < k; i++)
+                        {
+                            EXPECT_EQ(decoded[i][col], codewords[col][i]);
+                        }
+                }
+
+            // Same result as the erasure decoding of the whole column
+            std::vector<int> erasure_positions;
+            for (int position = 0; position < 255; position++)
+                {
+                    if (position < 32 && position >= static_cast<int>(k))
+                        {
+                            continue;  // known to be zero
+                        }
+                    if (!std::binary_search(received_positions.begin(), received_positions.end(), position))
+                        {
+                            erasure_positions.push_back(position);
+                        }
+                }
+            std::vector<uint8_t> column(255, 0);
+            for (size_t j = 0; j < k; j++)
+                {
+                    column[received_positions[j]] = pages[j][0];
+                }
+            EXPECT_GE(rs->decode(column, erasure_positions), 0);
+            for (size_t i = 0; i < k; i++)
+                {
+                    EXPECT_EQ(column[i], decoded[i][0]);
+                }
+        }
+}
+
+
+TEST(ReedSolomonE6BTest, DecodeErasureMatrixWrongPositions)
+{
+    auto rs = std::make_unique<ReedSolomon>();
+    std::vector<uint8_t> decoding_matrix;
+
+    // a page between the message size and 32 carries no information
+    EXPECT_FALSE(rs->get_erasure_decoding_matrix({0, 1, 4}, decoding_matrix));
+    EXPECT_FALSE(rs->get_erasure_decoding_matrix({0, 0, 40}, decoding_matrix));
+    EXPECT_FALSE(rs->get_erasure_decoding_matrix({0, 255}, decoding_matrix));
+    EXPECT_FALSE(rs->get_erasure_decoding_matrix(std::vector<int>(33, 40), decoding_matrix));
+    EXPECT_TRUE(rs->get_erasure_decoding_matrix({0, 1, 2}, decoding_matrix));
+    EXPECT_EQ(decoding_matrix, std::vector<uint8_t>({1, 0, 0, 0, 1, 0, 0, 0, 1}));
+}
@@ -0,0 +1,68 @@
+/*!
+ * \file gnss_nav_bits_test.cc
+ * \brief This file implements unit tests for the extraction of navigation
+ * message fields from packed frames
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_nav_bits.h"
+#include <gtest/gtest.h>
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+
+TEST(GnssNavBitsTest, FieldsAcrossWords)
+{
+    // 0xABCD at positions 57 to 72, across the first two 64-bit words
+    Gnss_Nav_Bits<128> bits;
+    bits.set_bits(57, 16, 0xABCD);
+    EXPECT_EQ(bits.read_unsigned(Gnss_Nav_Field({57, 16})), 0xABCDU);
+    EXPECT_EQ(bits.read_unsigned(Gnss_Nav_Field({57, 8}, {65, 8})), 0xABCDU);
+    EXPECT_EQ(bits.read_unsigned(Gnss_Nav_Field({65, 8}, {57, 8})), 0xCDABU);
+    EXPECT_TRUE(bits.read_bool(Gnss_Nav_Field({57, 1})));
+    EXPECT_FALSE(bits.read_bool(Gnss_Nav_Field({58, 1})));
+
+    // Fields beyond the end of the frame read as zero
+    EXPECT_EQ(bits.read_unsigned(Gnss_Nav_Field({120, 10})), 0U);
+}
+
+
+TEST(GnssNavBitsTest, SignedFields)
+{
+    Gnss_Nav_Bits<30> bits(std::string("111101"
+                                       "0000000000000000000000"
+                                       "10"));
+    EXPECT_EQ(bits.read_signed(Gnss_Nav_Field({1, 6})), -3);
+    EXPECT_EQ(bits.read_signed(Gnss_Nav_Field({5, 2})), 1);
+    EXPECT_EQ(bits.read_signed(Gnss_Nav_Field({1, 2}, {29, 2})), -2);
+
+    // Sign and magnitude in each slice, as in GLONASS
+    EXPECT_EQ(bits.read_sign_magnitude(Gnss_Nav_Field({1, 6})), -29);
+    EXPECT_EQ(bits.read_sign_magnitude(Gnss_Nav_Field({6, 3})), 0);
+}
+
+
+TEST(GnssNavBitsTest, SameAsBitset)
+{
+    const std::string frame("1011001110001111000011111000001111110000000111111100000000");
+    const std::bitset<64> reference(frame);
+    const Gnss_Nav_Bits<64> from_string(frame);
+    const Gnss_Nav_Bits<64> from_bitset(reference);
+    const size_t offset = 64 - frame.size();  // a short string fills the last positions
+    for (int32_t p = 1; p <= 64; p++)
+        {
+            EXPECT_EQ(from_string.bit(p), reference[64 - p]);
+            EXPECT_EQ(from_bitset.bit(p), reference[64 - p]);
+        }
+    EXPECT_EQ(from_string.read_unsigned(Gnss_Nav_Field({static_cast<int32_t>(offset) + 1, 8})), 0xB3U);
+}
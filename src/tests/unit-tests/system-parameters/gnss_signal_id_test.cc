@@ -0,0 +1,64 @@
+/*!
+ * \file gnss_signal_id_test.cc
+ * \brief This file implements unit tests for the compact signal identifiers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_signal.h"
+#include "gnss_signal_id.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+static_assert(gnss_signal_code("7X") == Gnss_Signal_Code::SIG_7X, "signal codes are looked up at compile time");
+
+
+TEST(GnssSignalIdTest, PerfectHashOfTheSignalCodes)
+{
+    const std::vector<std::string> signals = {"1C", "2S", "L5", "1B", "5X", "7X", "E6", "1G", "2G", "B1", "B3"};
+    std::unordered_set<int> codes;
+    for (const auto& signal : signals)
+        {
+            const Gnss_Signal_Code code = gnss_signal_code(signal.c_str());
+            EXPECT_NE(code, Gnss_Signal_Code::UNKNOWN) << signal;
+            codes.insert(static_cast<int>(code));
+        }
+    EXPECT_EQ(codes.size(), signals.size());
+    EXPECT_EQ(gnss_signal_code("1X"), Gnss_Signal_Code::UNKNOWN);
+    EXPECT_EQ(gnss_signal_code("B2"), Gnss_Signal_Code::UNKNOWN);
+    EXPECT_EQ(gnss_signal_code(""), Gnss_Signal_Code::UNKNOWN);
+}
+
+
+TEST(GnssSignalIdTest, PackedFields)
+{
+    const Gnss_Signal_Id id('R', "2G", 24);
+    EXPECT_EQ(id.system(), 'R');
+    EXPECT_EQ(id.code(), Gnss_Signal_Code::SIG_2G);
+    EXPECT_EQ(id.prn(), 24U);
+    EXPECT_EQ(id.signal(), Gnss_Signal_Id('R', "2G", 0));
+    EXPECT_NE(Gnss_Signal_Id('G', "1C", 120), Gnss_Signal_Id('S', "1C", 120));
+    EXPECT_EQ(Gnss_Signal_Id('C', "B3", 63).prn(), 63U);
+}
+
+
+TEST(GnssSignalIdTest, SignalsCompareByIdentifier)
+{
+    const Gnss_Signal e1(Gnss_Satellite("Galileo", 11), "1B");
+    const Gnss_Signal e5a(Gnss_Satellite("Galileo", 11), "5X");
+    EXPECT_EQ(e1.get_id(), Gnss_Signal_Id('E', "1B", 11));
+    EXPECT_TRUE(e1 == Gnss_Signal(Gnss_Satellite("Galileo", 11), "1B"));
+    EXPECT_FALSE(e1 == e5a);
+    EXPECT_EQ(Gnss_Signal("5X").get_id().code(), Gnss_Signal_Code::SIG_5X);
+}
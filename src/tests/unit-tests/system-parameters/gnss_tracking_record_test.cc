@@ -0,0 +1,64 @@
+/*!
+ * \file gnss_tracking_record_test.cc
+ * \brief Tests of the compact tracking to telemetry record
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_tracking_record.h"
+#include <array>
+
+TEST(GnssTrackingRecordTest, RoundTrip)
+{
+    Gnss_Synchro synchro{};
+    synchro.System = 'E';
+    synchro.Signal[0] = '1';
+    synchro.Signal[1] = 'B';
+    synchro.PRN = 11;
+    synchro.Channel_ID = 7;
+    synchro.fs = 4000000;
+    synchro.Prompt_I = -1250.5;
+    synchro.Prompt_Q = 31.25;
+    synchro.CN0_dB_hz = 44.5;
+    synchro.Carrier_Doppler_hz = -2345.678901234;
+    synchro.Carrier_phase_rads = 123456789.123456789;
+    synchro.Code_phase_samples = 0.123456789;
+    synchro.Tracking_sample_counter = 12345678901234ULL;
+    synchro.correlation_length_ms = 4;
+    synchro.Flag_valid_symbol_output = true;
+    synchro.Flag_PLL_180_deg_phase_locked = true;
+
+    std::array<Gnss_Tracking_Record, 2> records{};
+    write_tracking_item(records.data(), 1, true, synchro);
+    const Gnss_Synchro result = read_tracking_item(records.data(), 1, true);
+
+    EXPECT_EQ(sizeof(Gnss_Tracking_Record), 64U);
+    EXPECT_LT(tracking_item_size(true), tracking_item_size(false));
+    EXPECT_EQ(result.System, 'E');
+    EXPECT_EQ(result.Signal[0], '1');
+    EXPECT_EQ(result.Signal[1], 'B');
+    EXPECT_EQ(result.Signal[2], '\0');
+    EXPECT_EQ(result.PRN, 11U);
+    EXPECT_EQ(result.Channel_ID, 7);
+    EXPECT_EQ(result.fs, 4000000);
+    EXPECT_EQ(result.Prompt_I, -1250.5);
+    EXPECT_EQ(result.Prompt_Q, 31.25);
+    EXPECT_EQ(result.CN0_dB_hz, 44.5);
+    // the values that accumulate keep their full precision
+    EXPECT_EQ(result.Carrier_Doppler_hz, synchro.Carrier_Doppler_hz);
+    EXPECT_EQ(result.Carrier_phase_rads, synchro.Carrier_phase_rads);
+    EXPECT_EQ(result.Code_phase_samples, synchro.Code_phase_samples);
+    EXPECT_EQ(result.Tracking_sample_counter, synchro.Tracking_sample_counter);
+    EXPECT_EQ(result.correlation_length_ms, 4);
+    EXPECT_TRUE(result.Flag_valid_symbol_output);
+    EXPECT_TRUE(result.Flag_PLL_180_deg_phase_locked);
+    EXPECT_FALSE(result.Flag_valid_acquisition);
+}
@@ -0,0 +1,421 @@
+/*!
+ * \file acq_sweep.cc
+ * \brief Sweep of acquisition parameters over a recorded file, reporting the
+ * detection probability and the processing time of each configuration
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sweep.h"
+#include "acquisition_interface.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "gnss_sdr_block_stats.h"
+#include "gnss_sdr_filesystem.h"
+#include "gnss_synchro.h"
+#include <glog/logging.h>
+#include <gnuradio/block.h>
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/skiphead.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/top_block.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if HAS_GENERIC_LAMBDA
+#else
+#include <boost/bind/bind.hpp>
+#endif
+
+#if PMT_USES_BOOST_ANY
+#include <boost/any.hpp>
+namespace wht = boost;
+#else
+#include <any>
+namespace wht = std;
+#endif
+
+
+namespace
+{
+// the factory and the code generators are not meant to be used concurrently
+std::mutex construction_mutex;
+
+// samples fed after the longest search, so that the block reaches a decision
+const uint32_t SEARCH_MARGIN_MS = 10;
+
+class acq_sweep_msg_rx;
+
+using acq_sweep_msg_rx_sptr = gnss_shared_ptr<acq_sweep_msg_rx>;
+
+acq_sweep_msg_rx_sptr acq_sweep_msg_rx_make();
+
+
+/*
+ * Receiver of the events of the acquisition block: 1 for a positive
+ * acquisition, 2 for a negative one
+ */
+class acq_sweep_msg_rx : public gr::block
+{
+public:
+    int rx_message{0};
+
+private:
+    friend acq_sweep_msg_rx_sptr acq_sweep_msg_rx_make();
+    acq_sweep_msg_rx();
+    void msg_handler_events(const pmt::pmt_t& msg);
+};
+
+
+acq_sweep_msg_rx_sptr acq_sweep_msg_rx_make()
+{
+    return acq_sweep_msg_rx_sptr(new acq_sweep_msg_rx());
+}
+
+
+acq_sweep_msg_rx::acq_sweep_msg_rx()
+    : gr::block("acq_sweep_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"),
+#if HAS_GENERIC_LAMBDA
+        [this](auto&& PH1) { msg_handler_events(PH1); });
+#else
+#if USE_BOOST_BIND_PLACEHOLDERS
+        boost::bind(&acq_sweep_msg_rx::msg_handler_events, this, boost::placeholders::_1));
+#else
+        boost::bind(&acq_sweep_msg_rx::msg_handler_events, this, _1));
+#endif
+#endif
+}
+
+
+void acq_sweep_msg_rx::msg_handler_events(const pmt::pmt_t& msg)
+{
+    try
+        {
+            rx_message = static_cast<int>(pmt::to_long(msg));
+        }
+    catch (const wht::bad_any_cast& e)
+        {
+            LOG(WARNING) << "msg_handler_events Bad any_cast: " << e.what();
+            rx_message = 0;
+        }
+}
+
+
+std::string to_property(double value)
+{
+    std::ostringstream ss;
+    ss.precision(9);
+    ss << value;
+    return ss.str();
+}
+
+
+size_t item_size(const std::string& item_type)
+{
+    if (item_type == "gr_complex")
+        {
+            return sizeof(gr_complex);
+        }
+    if (item_type == "cshort")
+        {
+            return 2 * sizeof(int16_t);
+        }
+    if (item_type == "cbyte")
+        {
+            return 2 * sizeof(int8_t);
+        }
+    throw std::invalid_argument("Unsupported item type " + item_type + ", the sweep reads gr_complex, cshort or cbyte samples");
+}
+
+
+char signal_system(const std::string& signal)
+{
+    const std::map<std::string, char> systems{
+        {"1C", 'G'}, {"2S", 'G'}, {"L5", 'G'},
+        {"1B", 'E'}, {"5X", 'E'}, {"7X", 'E'}, {"E6", 'E'},
+        {"1G", 'R'}, {"2G", 'R'},
+        {"B1", 'C'}, {"B3", 'C'}};
+    const auto it = systems.find(signal);
+    if (it == systems.cend())
+        {
+            throw std::invalid_argument("Unknown signal " + signal);
+        }
+    return it->second;
+}
+}  // namespace
+
+
+std::string Acq_Sweep_Point::name() const
+{
+    std::ostringstream ss;
+    ss << "pfa=" << pfa << " doppler_step=" << doppler_step
+       << " coherent_integration_time_ms=" << coherent_integration_time_ms
+       << " max_dwells=" << max_dwells;
+    return ss.str();
+}
+
+
+Acq_Sweep::Acq_Sweep(const FileConfiguration& configuration, const std::string& signal)
+    : configuration_(configuration),
+      role_("Acquisition_" + signal),
+      signal_(signal),
+      filename_(configuration.property("SignalSource.filename", std::string("../data/example_capture.dat"))),
+      system_(signal_system(signal))
+{
+    const std::string item_type = configuration_.property("SignalSource.item_type", std::string("gr_complex"));
+    item_size_ = item_size(item_type);
+    fs_ = configuration_.property("GNSS-SDR.internal_fs_sps", configuration_.property("SignalSource.sampling_frequency", static_cast<int64_t>(4000000)));
+    bit_transition_flag_ = configuration_.property(role_ + ".bit_transition_flag", false);
+
+    // The samples go straight from the file to the acquisition block, which
+    // decides before returning from work()
+    configuration_.set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs_));
+    configuration_.set_property(role_ + ".item_type", item_type);
+    configuration_.set_property(role_ + ".blocking", "true");
+    configuration_.set_property(role_ + ".dump", "false");
+    configuration_.set_property(role_ + ".enable_monitor_output", "false");
+    if (configuration_.property(role_ + ".implementation", std::string()).empty())
+        {
+            configuration_.set_property(role_ + ".implementation", "GPS_L1_CA_PCPS_Acquisition");
+        }
+
+    Gnss_Block_Stats::set_enabled(true);
+}
+
+
+uint32_t Acq_Sweep::search_length_ms(const Acq_Sweep_Point& point) const
+{
+    return point.coherent_integration_time_ms * point.max_dwells * (bit_transition_flag_ ? 2U : 1U) + SEARCH_MARGIN_MS;
+}
+
+
+uint32_t Acq_Sweep::max_trials(const std::vector<Acq_Sweep_Point>& points, uint32_t skip_ms) const
+{
+    uint32_t segment_ms = 0;
+    for (const auto& point : points)
+        {
+            segment_ms = std::max(segment_ms, search_length_ms(point));
+        }
+    errorlib::error_code ec;
+    const auto file_size = fs::file_size(filename_, ec);
+    if (ec or segment_ms == 0)
+        {
+            return 0;
+        }
+    const auto samples = static_cast<uint64_t>(file_size) / item_size_;
+    const auto skip = static_cast<uint64_t>(skip_ms) * fs_ / 1000;
+    const auto segment = static_cast<uint64_t>(segment_ms) * fs_ / 1000;
+    return samples <= skip ? 0 : static_cast<uint32_t>((samples - skip) / segment);
+}
+
+
+std::vector<Acq_Sweep_Result> Acq_Sweep::run(const std::vector<Acq_Sweep_Point>& points,
+    const std::vector<uint32_t>& prns,
+    uint32_t trials,
+    uint32_t skip_ms,
+    size_t threads)
+{
+    // Every point searches the same segments, spaced by the longest search
+    uint32_t segment_ms = 0;
+    for (const auto& point : points)
+        {
+            segment_ms = std::max(segment_ms, search_length_ms(point));
+        }
+    const auto skip = static_cast<uint64_t>(skip_ms) * fs_ / 1000;
+    const auto segment = static_cast<uint64_t>(segment_ms) * fs_ / 1000;
+
+    std::vector<Acq_Sweep_Result> results(points.size());
+    for (size_t p = 0; p < points.size(); p++)
+        {
+            results[p].point = points[p];
+            results[p].detections = std::vector<uint32_t>(prns.size(), 0U);
+            results[p].trials = trials;
+        }
+
+    const size_t jobs = points.size() * prns.size() * trials;
+    std::atomic<size_t> next_job{0};
+    std::mutex results_mutex;
+    auto worker = [&]() {
+        for (size_t job = next_job++; job < jobs; job = next_job++)
+            {
+                const size_t p = job / (prns.size() * trials);
+                const size_t n = (job / trials) % prns.size();
+                const size_t t = job % trials;
+                const Acq_Sweep_Point& point = points[p];
+                const auto nsamples = static_cast<uint64_t>(search_length_ms(point)) * fs_ / 1000;
+                double work_time_s = 0.0;
+                const bool detected = search(point, prns[n], skip + t * segment, nsamples, work_time_s);
+
+                std::lock_guard<std::mutex> lock(results_mutex);
+                Acq_Sweep_Result& result = results[p];
+                result.detections[n] += detected ? 1U : 0U;
+                result.searches++;
+                result.work_time_s += work_time_s;
+                result.max_search_time_s = std::max(result.max_search_time_s, work_time_s);
+            }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t w = 1; w < std::min(std::max(threads, static_cast<size_t>(1)), jobs); w++)
+        {
+            workers.emplace_back(worker);
+        }
+    worker();
+    for (auto& w : workers)
+        {
+            w.join();
+        }
+    return results;
+}
+
+
+bool Acq_Sweep::search(const Acq_Sweep_Point& point, uint32_t prn, uint64_t first_sample, uint64_t nsamples, double& work_time_s)
+{
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = system_;
+    signal_.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = prn;
+
+    auto top_block = gr::make_top_block("Acquisition sweep");
+    std::shared_ptr<AcquisitionInterface> acquisition;
+    acq_sweep_msg_rx_sptr msg_rx;
+    {
+        FileConfiguration configuration(configuration_);
+        if (point.pfa > 0.0)
+            {
+                configuration.set_property(role_ + ".pfa", to_property(point.pfa));
+            }
+        configuration.set_property(role_ + ".doppler_step", to_property(point.doppler_step));
+        configuration.set_property(role_ + ".coherent_integration_time_ms", std::to_string(point.coherent_integration_time_ms));
+        configuration.set_property(role_ + ".max_dwells", std::to_string(point.max_dwells));
+
+        std::lock_guard<std::mutex> lock(construction_mutex);
+        GNSSBlockFactory factory;
+        std::shared_ptr<GNSSBlockInterface> block = factory.GetBlock(&configuration, role_, 1, 0);
+        acquisition = std::dynamic_pointer_cast<AcquisitionInterface>(block);
+        if (!acquisition)
+            {
+                throw std::runtime_error("The implementation of " + role_ + " is not an acquisition block");
+            }
+        msg_rx = acq_sweep_msg_rx_make();
+
+        auto file_source = gr::blocks::file_source::make(item_size_, filename_.c_str(), false);
+        auto skiphead = gr::blocks::skiphead::make(item_size_, first_sample);
+        auto head = gr::blocks::head::make(item_size_, nsamples);
+        acquisition->set_channel(0);
+        acquisition->set_gnss_synchro(&gnss_synchro);
+        acquisition->connect(top_block);
+        top_block->connect(file_source, 0, skiphead, 0);
+        top_block->connect(skiphead, 0, head, 0);
+        top_block->connect(head, 0, acquisition->get_left_block(), 0);
+        top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+        acquisition->set_local_code();
+        acquisition->set_state(1);  // start at the first sample of the segment
+        acquisition->init();
+    }
+
+    top_block->run();
+
+    const auto stats = Gnss_Block_Stats_Registry::instance().find(acquisition->get_right_block()->unique_id());
+    work_time_s = stats ? static_cast<double>(stats->snapshot().total_ns) * 1e-9 : 0.0;
+    if (msg_rx->rx_message == 0)
+        {
+            LOG(WARNING) << "No decision for PRN " << prn << " with " << point.name()
+                         << " in a segment of " << nsamples << " samples";
+        }
+    return msg_rx->rx_message == 1;
+}
+
+
+std::vector<uint32_t> parse_prn_list(const std::string& list)
+{
+    std::vector<uint32_t> prns;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            if (item.empty())
+                {
+                    continue;
+                }
+            const size_t dash = item.find('-');
+            const auto first = static_cast<uint32_t>(std::stoul(item.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(item.substr(dash + 1)));
+            for (uint32_t prn = first; prn <= last; prn++)
+                {
+                    prns.push_back(prn);
+                }
+        }
+    std::sort(prns.begin(), prns.end());
+    prns.erase(std::unique(prns.begin(), prns.end()), prns.end());
+    return prns;
+}
+
+
+std::vector<double> parse_number_list(const std::string& list)
+{
+    std::vector<double> numbers;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+                {
+                    numbers.push_back(std::stod(item));
+                }
+        }
+    return numbers;
+}
+
+
+std::vector<uint32_t> reference_present_prns(const std::vector<Acq_Sweep_Result>& results, const std::vector<uint32_t>& prns)
+{
+    const Acq_Sweep_Result* best = nullptr;
+    uint32_t best_detections = 0;
+    for (const auto& result : results)
+        {
+            uint32_t detections = 0;
+            for (auto d : result.detections)
+                {
+                    detections += d;
+                }
+            if (best == nullptr or detections > best_detections)
+                {
+                    best = &result;
+                    best_detections = detections;
+                }
+        }
+    std::vector<uint32_t> present;
+    if (best != nullptr)
+        {
+            for (size_t n = 0; n < prns.size() and n < best->detections.size(); n++)
+                {
+                    if (2 * best->detections[n] > best->trials)
+                        {
+                            present.push_back(prns[n]);
+                        }
+                }
+        }
+    return present;
+}
@@ -0,0 +1,120 @@
+/*!
+ * \file acq_sweep.h
+ * \brief Sweep of acquisition parameters over a recorded file, reporting the
+ * detection probability and the processing time of each configuration
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SWEEP_H
+#define GNSS_SDR_ACQ_SWEEP_H
+
+#include "file_configuration.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief One point of the grid of acquisition parameters
+ */
+class Acq_Sweep_Point
+{
+public:
+    float pfa{0.0};
+    float doppler_step{250.0};
+    uint32_t coherent_integration_time_ms{1U};
+    uint32_t max_dwells{1U};
+
+    std::string name() const;
+};
+
+
+/*!
+ * \brief Outcome of all the searches made with one Acq_Sweep_Point
+ */
+class Acq_Sweep_Result
+{
+public:
+    Acq_Sweep_Point point;
+    std::vector<uint32_t> detections;  // per searched PRN, over all the trials
+    uint32_t trials{0};
+    uint32_t searches{0};
+    double work_time_s{0.0};  // time spent in the acquisition block
+    double max_search_time_s{0.0};
+
+    double mean_search_time_s() const { return searches == 0 ? 0.0 : work_time_s / searches; }
+};
+
+
+/*!
+ * \brief Runs pcps_acquisition over segments of a recorded file for every
+ * point of a grid of parameters, searching each PRN of a list once per
+ * segment.
+ *
+ * The signal is read from SignalSource.filename, and it must already be at
+ * baseband at GNSS-SDR.internal_fs_sps (the signal conditioner is not
+ * used). The rest of the acquisition parameters are taken from the
+ * Acquisition_<signal> section of the configuration. The searches run in
+ * parallel, one flowgraph with a single acquisition block per worker, so
+ * that the time each block spends in work() stands for its CPU time.
+ */
+class Acq_Sweep
+{
+public:
+    Acq_Sweep(const FileConfiguration& configuration, const std::string& signal);
+
+    /*!
+     * \brief Number of segments of the file long enough for the longest
+     * search of the grid, after skip_ms
+     */
+    uint32_t max_trials(const std::vector<Acq_Sweep_Point>& points, uint32_t skip_ms) const;
+
+    std::vector<Acq_Sweep_Result> run(const std::vector<Acq_Sweep_Point>& points,
+        const std::vector<uint32_t>& prns,
+        uint32_t trials,
+        uint32_t skip_ms,
+        size_t threads);
+
+private:
+    bool search(const Acq_Sweep_Point& point, uint32_t prn, uint64_t first_sample, uint64_t nsamples, double& work_time_s);
+    uint32_t search_length_ms(const Acq_Sweep_Point& point) const;
+
+    FileConfiguration configuration_;
+    std::string role_;
+    std::string signal_;
+    std::string filename_;
+    size_t item_size_;
+    int64_t fs_;
+    char system_;
+    bool bit_transition_flag_;
+};
+
+
+/*!
+ * \brief Parses a comma-separated list of PRNs and ranges, as in "1-5,7"
+ */
+std::vector<uint32_t> parse_prn_list(const std::string& list);
+
+/*!
+ * \brief Parses a comma-separated list of numbers
+ */
+std::vector<double> parse_number_list(const std::string& list);
+
+/*!
+ * \brief PRNs detected in more than half of the trials by the point with the
+ * most detections, taken as the ones present in the signal when they are
+ * not known
+ */
+std::vector<uint32_t> reference_present_prns(const std::vector<Acq_Sweep_Result>& results, const std::vector<uint32_t>& prns);
+
+
+#endif  // GNSS_SDR_ACQ_SWEEP_H
@@ -0,0 +1,217 @@
+/*!
+ * \file main.cc
+ * \brief Main file of the acquisition parameter sweep program.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sweep.h"
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include "gps_acq_assist.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(signal, "1C", "Signal to acquire, as in the Acquisition_<signal> section of the configuration file.");
+DEFINE_string(prns, "1-32", "Comma-separated list of PRNs and ranges of PRNs to search, as in 1-5,7.");
+DEFINE_string(present_prns, "", "PRNs present in the signal. If empty, those detected in most trials by the most sensitive configuration.");
+DEFINE_string(pfa, "", "Comma-separated list of probabilities of false alarm to sweep. Empty to use the one in the configuration file.");
+DEFINE_string(doppler_step, "", "Comma-separated list of Doppler steps [Hz] to sweep. Empty to use the one in the configuration file.");
+DEFINE_string(coherent_integration_time_ms, "", "Comma-separated list of coherent integration times [ms] to sweep. Empty to use the one in the configuration file.");
+DEFINE_string(max_dwells, "", "Comma-separated list of maximum numbers of dwells to sweep. Empty to use the one in the configuration file.");
+DEFINE_int32(trials, 10, "Number of segments of the file searched with each configuration.");
+DEFINE_int32(skip_ms, 0, "Time at the beginning of the file that is not searched [ms].");
+DEFINE_int32(threads, 0, "Number of searches run in parallel. 0 for one per core.");
+DEFINE_double(min_pd, 0.9, "Detection probability required to recommend a configuration.");
+DEFINE_string(csv, "", "If not empty, file where the results are written in CSV format.");
+
+// used by the assisted acquisition blocks linked with the block factory
+Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
+Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+
+
+namespace
+{
+template <typename T>
+std::vector<T> sweep_values(const std::string& list, T configured)
+{
+    std::vector<T> values;
+    for (double v : parse_number_list(list))
+        {
+            values.push_back(static_cast<T>(v));
+        }
+    if (values.empty())
+        {
+            values.push_back(configured);
+        }
+    return values;
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\nAcquisition parameter sweep over a file of recorded samples\n") +
+        "Copyright (C) 2010-2022 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License\n \n" +
+        "Usage: \n" +
+        "   acq-sweep --config_file=<file> --pfa=0.01,0.001 --coherent_integration_time_ms=1,2,4\n");
+
+    gflags::SetUsageMessage(intro_help);
+    google::SetVersionString(GNSS_SDR_VERSION);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    int return_code = 0;
+    try
+        {
+            const FileConfiguration configuration(FLAGS_config_file);
+            const std::string role = "Acquisition_" + FLAGS_signal;
+
+            Acq_Sweep_Point configured;
+            configured.pfa = configuration.property(role + ".pfa", configured.pfa);
+            configured.doppler_step = configuration.property(role + ".doppler_step", configured.doppler_step);
+            configured.coherent_integration_time_ms = configuration.property(role + ".coherent_integration_time_ms", configured.coherent_integration_time_ms);
+            configured.max_dwells = configuration.property(role + ".max_dwells", configured.max_dwells);
+
+            std::vector<Acq_Sweep_Point> points;
+            for (auto pfa : sweep_values(FLAGS_pfa, configured.pfa))
+                {
+                    for (auto doppler_step : sweep_values(FLAGS_doppler_step, configured.doppler_step))
+                        {
+                            for (auto coherent_ms : sweep_values(FLAGS_coherent_integration_time_ms, configured.coherent_integration_time_ms))
+                                {
+                                    for (auto max_dwells : sweep_values(FLAGS_max_dwells, configured.max_dwells))
+                                        {
+                                            Acq_Sweep_Point point;
+                                            point.pfa = pfa;
+                                            point.doppler_step = doppler_step;
+                                            point.coherent_integration_time_ms = std::max(1U, coherent_ms);
+                                            point.max_dwells = std::max(1U, max_dwells);
+                                            points.push_back(point);
+                                        }
+                                }
+                        }
+                }
+
+            const std::vector<uint32_t> prns = parse_prn_list(FLAGS_prns);
+            Acq_Sweep sweep(configuration, FLAGS_signal);
+            const auto available_trials = sweep.max_trials(points, static_cast<uint32_t>(std::max(0, FLAGS_skip_ms)));
+            const auto trials = std::min(static_cast<uint32_t>(std::max(0, FLAGS_trials)), available_trials);
+            if (trials == 0 or prns.empty())
+                {
+                    std::cerr << "Nothing to search: " << available_trials << " segments available in the file, "
+                              << prns.size() << " PRNs\n";
+                    return 1;
+                }
+            if (trials < static_cast<uint32_t>(FLAGS_trials))
+                {
+                    std::cout << "The file only holds " << trials << " segments for the longest search\n";
+                }
+            const size_t threads = FLAGS_threads > 0 ? static_cast<size_t>(FLAGS_threads) : std::max(1U, std::thread::hardware_concurrency());
+
+            std::cout << "Searching " << prns.size() << " PRNs in " << trials << " segments with "
+                      << points.size() << " configurations, " << threads << " searches in parallel\n";
+            const std::vector<Acq_Sweep_Result> results = sweep.run(points, prns, trials, static_cast<uint32_t>(std::max(0, FLAGS_skip_ms)), threads);
+
+            const std::vector<uint32_t> present = FLAGS_present_prns.empty() ? reference_present_prns(results, prns) : parse_prn_list(FLAGS_present_prns);
+            std::cout << "PRNs taken as present:";
+            for (auto prn : present)
+                {
+                    std::cout << " " << prn;
+                }
+            std::cout << '\n';
+
+            std::ofstream csv;
+            if (!FLAGS_csv.empty())
+                {
+                    csv.open(FLAGS_csv);
+                    csv << "pfa,doppler_step,coherent_integration_time_ms,max_dwells,pd,false_alarm_rate,mean_search_time_s,max_search_time_s\n";
+                }
+
+            // cheapest first
+            std::vector<size_t> order(results.size());
+            for (size_t p = 0; p < order.size(); p++)
+                {
+                    order[p] = p;
+                }
+            std::sort(order.begin(), order.end(), [&results](size_t a, size_t b) { return results[a].mean_search_time_s() < results[b].mean_search_time_s(); });
+
+            const Acq_Sweep_Result* recommended = nullptr;
+            std::cout << std::fixed;
+            std::cout << "      Pd   false alarms   time/search [ms]   configuration\n";
+            for (size_t p : order)
+                {
+                    const Acq_Sweep_Result& result = results[p];
+                    uint32_t hits = 0;
+                    uint32_t false_alarms = 0;
+                    for (size_t n = 0; n < prns.size(); n++)
+                        {
+                            const bool is_present = std::find(present.cbegin(), present.cend(), prns[n]) != present.cend();
+                            (is_present ? hits : false_alarms) += result.detections[n];
+                        }
+                    const double pd = present.empty() ? 0.0 : static_cast<double>(hits) / (present.size() * result.trials);
+                    const size_t absent = prns.size() - std::min(prns.size(), present.size());
+                    const double false_alarm_rate = absent == 0 ? 0.0 : static_cast<double>(false_alarms) / (absent * result.trials);
+                    if (recommended == nullptr and pd >= FLAGS_min_pd)
+                        {
+                            recommended = &result;
+                        }
+                    std::cout << std::setprecision(3) << std::setw(8) << pd << std::setw(15) << false_alarm_rate
+                              << std::setw(19) << result.mean_search_time_s() * 1e3 << "   " << result.point.name() << '\n';
+                    if (csv.is_open())
+                        {
+                            csv << result.point.pfa << ',' << result.point.doppler_step << ',' << result.point.coherent_integration_time_ms << ','
+                                << result.point.max_dwells << ',' << pd << ',' << false_alarm_rate << ','
+                                << result.mean_search_time_s() << ',' << result.max_search_time_s << '\n';
+                        }
+                }
+
+            if (recommended != nullptr)
+                {
+                    std::cout << "Cheapest configuration with Pd >= " << std::setprecision(2) << FLAGS_min_pd << ": " << recommended->point.name() << '\n';
+                }
+            else
+                {
+                    std::cout << "No configuration reaches Pd >= " << std::setprecision(2) << FLAGS_min_pd << '\n';
+                    return_code = 2;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Error: " << e.what() << '\n';
+            return_code = 1;
+        }
+
+    gflags::ShutDownCommandLineFlags();
+    google::ShutdownGoogleLogging();
+    return return_code;
+}
@@ -17,22 +17,30 @@
 
 #include "front_end_cal.h"
 #include "GPS_L1_CA.h"  // for GPS_L1_FREQ_HZ
+#include "acq_batch_engine.h"
 #include "concurrent_map.h"
 #include "configuration_interface.h"
+#include "gnss_sdr_fft_pool.h"
 #include "gnss_sdr_supl_client.h"
+#include "gnss_signal_replica.h"
 #include "gps_acq_assist.h"  // for Gps_Acq_Assist
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
+#include "gps_sdr_signal_replica.h"
 #include "gps_utc_model.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
-#include <algorithm>  // for min
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>  // for min, nth_element
 #include <cmath>
+#include <cstddef>  // for ptrdiff_t
 #include <iostream>  // for operator<<
 #include <map>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 extern Concurrent_Map<Gps_Ephemeris> global_gps_ephemeris_map;
 extern Concurrent_Map<Gps_Iono> global_gps_iono_map;
@@ -377,3 +385,143 @@ void FrontEndCal::GPS_L1_front_end_model_E4000(double f_bb_true_Hz, double f_bb_
     *estimated_fs_Hz = frac * (f_osc_n + f_osc_err_hz);
     *estimated_f_if_Hz = f_rf_err;
 }
+
+
+std::map<int, double> FrontEndCal::batch_acquisition(const std::vector<std::complex<float>> &samples,
+    int64_t fs_hz, const std::vector<unsigned int> &prns, int doppler_max_hz, int doppler_step_hz,
+    unsigned int noncoherent_periods, float threshold, std::map<int, double> *code_delay_s) const
+{
+    std::map<int, double> doppler_measurements_map;
+    const auto fft_size = static_cast<uint32_t>(std::round(static_cast<double>(fs_hz) / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+    const auto periods = std::min<size_t>(noncoherent_periods, samples.size() / fft_size);
+    if (fft_size == 0 or periods == 0 or prns.empty() or doppler_step_hz <= 0)
+        {
+            return doppler_measurements_map;
+        }
+
+    // Doppler wipe-off of each bin of the grid
+    const auto num_doppler_bins = static_cast<uint32_t>(2 * doppler_max_hz / doppler_step_hz + 1);
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> grid_doppler_wipeoffs(num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(fft_size));
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            const int doppler = -doppler_max_hz + doppler_step_hz * static_cast<int>(doppler_index);
+            complex_exp_gen_conj(grid_doppler_wipeoffs[doppler_index], doppler, static_cast<double>(fs_hz));
+        }
+
+    // Conjugated spectrum of the code of each PRN
+    std::vector<volk_gnsssdr::vector<std::complex<float>>> fft_codes(prns.size(), volk_gnsssdr::vector<std::complex<float>>(fft_size));
+    std::vector<volk_gnsssdr::vector<volk_gnsssdr::vector<float>>> grids(prns.size(),
+        volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(num_doppler_bins, volk_gnsssdr::vector<float>(fft_size)));
+    {
+        auto fft = Gnss_Fft_Plan_Pool::instance().get_fwd(fft_size);
+        for (size_t i = 0; i < prns.size(); i++)
+            {
+                std::fill_n(fft->get_inbuf(), fft_size, std::complex<float>(0.0, 0.0));
+                gps_l1_ca_code_gen_complex_sampled(own::span<std::complex<float>>(fft->get_inbuf(), fft_size), prns[i], static_cast<int32_t>(fs_hz), 0);
+                fft->execute();
+                volk_32fc_conjugate_32fc(fft_codes[i].data(), fft->get_outbuf(), fft_size);
+            }
+    }
+
+    // All the PRNs share the wipe-off and forward FFT of each code period
+    auto engine = std::make_shared<Acq_Batch_Engine>(fft_size, fft_size, 0);
+    std::vector<Acq_Batch_Engine::Job> jobs(prns.size());
+    std::vector<Acq_Batch_Engine::Job *> batch(prns.size());
+    for (size_t period = 0; period < periods; period++)
+        {
+            for (size_t i = 0; i < prns.size(); i++)
+                {
+                    jobs[i].input = samples.data() + period * fft_size;
+                    jobs[i].fft_code = fft_codes[i].data();
+                    jobs[i].magnitude_grid = &grids[i];
+                    jobs[i].accumulate = (period > 0);
+                    batch[i] = &jobs[i];
+                }
+            engine->search(batch, grid_doppler_wipeoffs);
+        }
+
+    for (size_t i = 0; i < prns.size(); i++)
+        {
+            const auto &grid = grids[i];
+            float peak = 0.0;
+            double sum = 0.0;
+            uint32_t peak_doppler_index = 0;
+            uint32_t peak_delay = 0;
+            for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+                {
+                    for (uint32_t delay = 0; delay < fft_size; delay++)
+                        {
+                            sum += grid[doppler_index][delay];
+                            if (grid[doppler_index][delay] > peak)
+                                {
+                                    peak = grid[doppler_index][delay];
+                                    peak_doppler_index = doppler_index;
+                                    peak_delay = delay;
+                                }
+                        }
+                }
+            const double mean = sum / (static_cast<double>(num_doppler_bins) * fft_size);
+            if (mean <= 0.0 or peak / mean < threshold)
+                {
+                    continue;
+                }
+            // Parabola through the bins around the peak, at the code delay of the peak
+            double offset_bins = 0.0;
+            if (peak_doppler_index > 0 and peak_doppler_index + 1 < num_doppler_bins)
+                {
+                    const double left = grid[peak_doppler_index - 1][peak_delay];
+                    const double right = grid[peak_doppler_index + 1][peak_delay];
+                    const double denominator = left - 2.0 * peak + right;
+                    if (denominator < 0.0)
+                        {
+                            offset_bins = 0.5 * (left - right) / denominator;
+                        }
+                }
+            const double doppler_hz = -doppler_max_hz + doppler_step_hz * (static_cast<double>(peak_doppler_index) + offset_bins);
+            LOG(INFO) << "Batch acquisition of PRN " << prns[i] << ": peak to mean ratio " << peak / mean << ", Doppler " << doppler_hz << " Hz";
+            doppler_measurements_map[static_cast<int>(prns[i])] = doppler_hz;
+            if (code_delay_s != nullptr)
+                {
+                    // Same parabola along the (circular) code delays
+                    double offset_samples = 0.0;
+                    const double early = grid[peak_doppler_index][(peak_delay + fft_size - 1) % fft_size];
+                    const double late = grid[peak_doppler_index][(peak_delay + 1) % fft_size];
+                    const double denominator = early - 2.0 * peak + late;
+                    if (denominator < 0.0)
+                        {
+                            offset_samples = 0.5 * (early - late) / denominator;
+                        }
+                    const double delay_samples = std::fmod(static_cast<double>(peak_delay) + offset_samples + fft_size, static_cast<double>(fft_size));
+                    (*code_delay_s)[static_cast<int>(prns[i])] = delay_samples / static_cast<double>(fs_hz);
+                }
+        }
+    return doppler_measurements_map;
+}
+
+
+double FrontEndCal::estimate_frequency_offset(const std::map<int, double> &measured_doppler_hz,
+    const std::map<int, double> &predicted_doppler_hz)
+{
+    std::vector<double> differences;
+    for (const auto &measured : measured_doppler_hz)
+        {
+            const auto predicted = predicted_doppler_hz.find(measured.first);
+            if (predicted != predicted_doppler_hz.cend())
+                {
+                    differences.push_back(measured.second - predicted->second);
+                }
+        }
+    if (differences.empty())
+        {
+            throw std::logic_error("No predicted Doppler for the measured satellites");
+        }
+    const size_t middle = differences.size() / 2;
+    std::nth_element(differences.begin(), differences.begin() + static_cast<std::ptrdiff_t>(middle), differences.end());
+    if (differences.size() % 2 == 1)
+        {
+            return differences[middle];
+        }
+    const double upper = differences[middle];
+    const double lower = *std::max_element(differences.begin(), differences.begin() + static_cast<std::ptrdiff_t>(middle));
+    return 0.5 * (lower + upper);
+}
@@ -19,8 +19,12 @@
 #define GNSS_SDR_FRONT_END_CAL_H
 
 #include <armadillo>
+#include <complex>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 class ConfigurationInterface;
 
@@ -68,6 +72,28 @@ public:
      */
     void GPS_L1_front_end_model_E4000(double f_bb_true_Hz, double f_bb_meas_Hz, double fs_nominal_hz, double *estimated_fs_Hz, double *estimated_f_if_Hz, double *f_osc_err_ppm);
 
+    /*!
+     * \brief Searches the GPS L1 C/A signals of prns in samples, all of them
+     * in a single batch of the batched acquisition engine. Coherent
+     * integrations of one code period are added for noncoherent_periods
+     * periods, over a grid of +/- doppler_max_hz.
+     * Returns the Doppler [Hz] of the PRNs whose peak to grid mean ratio
+     * exceeds threshold, interpolated between the bins around the peak.
+     * If code_delay_s is not null, it gets the time [s] from the first
+     * sample to the start of the code of those PRNs, interpolated likewise.
+     */
+    std::map<int, double> batch_acquisition(const std::vector<std::complex<float>> &samples,
+        int64_t fs_hz, const std::vector<unsigned int> &prns, int doppler_max_hz, int doppler_step_hz,
+        unsigned int noncoherent_periods, float threshold, std::map<int, double> *code_delay_s = nullptr) const;
+
+    /*!
+     * \brief Frequency offset [Hz] common to the measured Doppler of all the
+     * satellites with respect to the predicted one, as the median of their
+     * differences, so that a wrong detection does not bias it
+     */
+    static double estimate_frequency_offset(const std::map<int, double> &measured_doppler_hz,
+        const std::map<int, double> &predicted_doppler_hz);
+
 private:
     std::shared_ptr<ConfigurationInterface> configuration_;
 
@@ -23,8 +23,10 @@
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "configuration_interface.h"  // for Configuration...
+#include "control_queue.h"
 #include "file_configuration.h"
 #include "front_end_cal.h"
+#include "geofunctions.h"  // for pv_Geo_to_ECEF, cart2geo
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"  // for GNSSBlockInte...
 #include "gnss_sdr_filesystem.h"
@@ -37,7 +39,8 @@
 #include "gps_l1_ca_pcps_acquisition_fine_doppler.h"
 #include "gps_utc_model.h"
 #include "signal_source_interface.h"  // for SignalSourceInterface
-#include <boost/any.hpp>              // for bad_any_cast
+#include "snapshot_solver.h"
+#include <boost/any.hpp>  // for bad_any_cast
 #include <boost/exception/exception.hpp>
 #include <boost/lexical_cast.hpp>
 #include <gflags/gflags.h>
@@ -54,12 +57,14 @@
 #include <gnuradio/top_block.h>
 #include <pmt/pmt.h>        // for pmt_t, to_long
 #include <pmt/pmt_sugar.h>  // for mp
+#include <array>
 #include <chrono>
 #include <cmath>  // for round
 #include <cstdint>
 #include <cstdlib>
 #include <ctime>  // for ctime
 #include <exception>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -89,6 +94,13 @@ using namespace google;
 
 DECLARE_string(log_dir);
 
+DEFINE_bool(fast, false, "Searches all the visible PRNs at once in the capture with the batched acquisition engine, and solves for the frequency offset common to all of them, instead of the serial acquisition of each PRN.");
+
+DEFINE_bool(snapshot, false, "Also solves a coarse-time position fix from the code phases of the --fast acquisition (implies --fast). The reference time of the assistance and GNSS-SDR.init_latitude_deg, init_longitude_deg and init_altitude_m must be good to about a minute and 100 km.");
+
+// Code periods added non-coherently by the fast calibration
+constexpr unsigned int FAST_NONCOHERENT_PERIODS = 10;
+
 Concurrent_Map<Gps_Ephemeris> global_gps_ephemeris_map;
 Concurrent_Map<Gps_Iono> global_gps_iono_map;
 Concurrent_Map<Gps_Utc_Model> global_gps_utc_model_map;
@@ -194,9 +206,9 @@ bool front_end_capture(const std::shared_ptr<ConfigurationInterface>& configurat
 
     gr::top_block_sptr top_block;
     GNSSBlockFactory block_factory;
-    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue;
+    std::shared_ptr<Control_Queue> queue;
 
-    queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    queue = std::make_shared<Control_Queue>();
     top_block = gr::make_top_block("Acquisition test");
 
     try
@@ -266,94 +278,9 @@ static time_t utc_time(int week, int64_t tow)
 }
 
 
-int main(int argc, char** argv)
+static void serial_acquisition(const std::shared_ptr<ConfigurationInterface>& configuration, std::map<int, double>& doppler_measurements_map)
 {
-    const std::string intro_help(
-        std::string("\n RTL-SDR E4000 RF front-end center frequency and sampling rate calibration tool that uses GPS signals\n") +
-        "Copyright (C) 2010-2019 (see AUTHORS file for a list of contributors)\n" +
-        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
-        "See COPYING file to see a copy of the General Public License\n \n");
-
-    gflags::SetUsageMessage(intro_help);
-    google::SetVersionString(FRONT_END_CAL_VERSION);
-    gflags::ParseCommandLineFlags(&argc, &argv, true);
-
-    std::cout << "Initializing... Please wait.\n";
-
-    google::InitGoogleLogging(argv[0]);
-    if (FLAGS_log_dir.empty())
-        {
-            std::cout << "Logging will be done at "
-                      << "/tmp"
-                      << '\n'
-                      << "Use front-end-cal --log_dir=/path/to/log to change that."
-                      << '\n';
-        }
-    else
-        {
-            const fs::path p(FLAGS_log_dir);
-            if (!fs::exists(p))
-                {
-                    std::cout << "The path "
-                              << FLAGS_log_dir
-                              << " does not exist, attempting to create it"
-                              << '\n';
-                    fs::create_directory(p);
-                }
-            std::cout << "Logging with be done at "
-                      << FLAGS_log_dir << '\n';
-        }
-
-    // 0. Instantiate the FrontEnd Calibration class
-    FrontEndCal front_end_cal;
-
-    // 1. Load configuration parameters from config file
-    std::shared_ptr<ConfigurationInterface> configuration = std::make_shared<FileConfiguration>(FLAGS_config_file);
-    front_end_cal.set_configuration(configuration);
-
-    // 2. Get SUPL information from server: Ephemeris record, assistance info and TOW
-    try
-        {
-            if (front_end_cal.get_ephemeris() == true)
-                {
-                    std::cout << "SUPL data received OK!\n";
-                }
-            else
-                {
-                    std::cout << "Failure connecting to SUPL server\n";
-                }
-        }
-    catch (const boost::exception& e)
-        {
-            std::cout << "Failure connecting to SUPL server\n";
-        }
-
-    // 3. Capture some front-end samples to hard disk
-    try
-        {
-            if (front_end_capture(configuration))
-                {
-                    std::cout << "Front-end RAW samples captured\n";
-                }
-            else
-                {
-                    std::cout << "Failure capturing front-end samples\n";
-                }
-        }
-    catch (const boost::bad_lexical_cast& e)
-        {
-            std::cout << "Exception caught while capturing samples (bad lexical cast)\n";
-        }
-    catch (const std::exception& e)
-        {
-            std::cout << "Exception caught while capturing samples: " << e.what() << '\n';
-        }
-    catch (...)
-        {
-            std::cout << "Unexpected exception\n";
-        }
-
-    // 4. Setup GNU Radio flowgraph (file_source -> Acquisition_10m)
+    // Setup GNU Radio flowgraph (file_source -> Acquisition_10m)
     gr::top_block_sptr top_block;
     top_block = gr::make_top_block("Acquisition test");
 
@@ -365,7 +292,6 @@ int main(int argc, char** argv)
     signal.copy(gnss_synchro.Signal, 2, 0);
     gnss_synchro.PRN = 1;
 
-    int64_t fs_in_ = configuration->property("GNSS-SDR.internal_fs_sps", 2048000);
     configuration->set_property("Acquisition.max_dwells", "10");
 
     auto acquisition = std::make_shared<GpsL1CaPcpsAcquisitionFineDoppler>(configuration.get(), "Acquisition", 1, 1);
@@ -404,22 +330,13 @@ int main(int argc, char** argv)
             std::cout << "Failure connecting the GNU Radio blocks: " << e.what() << '\n';
         }
 
-    // 5. Run the flowgraph
+    // Run the flowgraph
     // Get visible GPS satellites (positive acquisitions with Doppler measurements)
     // Compute Doppler estimations
 
     // todo: Fix the front-end cal to support new channel internal message system (no more external queues)
-    std::map<int, double> doppler_measurements_map;
-    std::map<int, double> cn0_measurements_map;
-
     std::thread ch_thread;
 
-    // record startup time
-    std::chrono::time_point<std::chrono::system_clock> start;
-    std::chrono::time_point<std::chrono::system_clock> end;
-    std::chrono::duration<double> elapsed_seconds{};
-    start = std::chrono::system_clock::now();
-
     bool start_msg = true;
 
     for (unsigned int PRN = 1; PRN < 33; PRN++)
@@ -485,6 +402,196 @@ int main(int argc, char** argv)
             std::cout.flush();
         }
     std::cout << "]\n";
+}
+
+
+static void fast_acquisition(const std::shared_ptr<ConfigurationInterface>& configuration, const FrontEndCal& front_end_cal, std::map<int, double>& doppler_measurements_map, std::map<int, double>* code_delay_map)
+{
+    const int64_t fs_in_ = configuration->property("GNSS-SDR.internal_fs_sps", 2048000);
+    const auto samples_per_code = static_cast<size_t>(round(fs_in_ / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+
+    // Read the capture at once
+    std::vector<gr_complex> samples(samples_per_code * FAST_NONCOHERENT_PERIODS);
+    std::ifstream capture("tmp_capture.dat", std::ios::binary);
+    capture.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(gr_complex)));
+    samples.resize(static_cast<size_t>(capture.gcount()) / sizeof(gr_complex));
+
+    // Only the satellites with assistance data, if any
+    std::vector<unsigned int> prns;
+    for (const auto& eph : global_gps_ephemeris_map.get_map_copy())
+        {
+            prns.push_back(eph.second.PRN);
+        }
+    if (prns.empty())
+        {
+            for (unsigned int PRN = 1; PRN < 33; PRN++)
+                {
+                    prns.push_back(PRN);
+                }
+        }
+
+    std::cout << "Searching for " << prns.size() << " GPS Satellites in L1 band at once...\n";
+    doppler_measurements_map = front_end_cal.batch_acquisition(samples, fs_in_, prns,
+        configuration->property("Acquisition.doppler_max", 10000),
+        configuration->property("Acquisition.doppler_step", 250),
+        FAST_NONCOHERENT_PERIODS,
+        configuration->property("Acquisition.fast_threshold", 4.0F),
+        code_delay_map);
+    std::cout << "[";
+    for (const auto& prn : prns)
+        {
+            if (doppler_measurements_map.count(static_cast<int>(prn)) != 0)
+                {
+                    std::cout << " " << prn << " ";
+                }
+            else
+                {
+                    std::cout << " . ";
+                }
+        }
+    std::cout << "]\n";
+}
+
+
+static void snapshot_fix(const std::map<int, double>& code_delay_map, double approx_tow, double lat_deg, double lon_deg, double altitude_m)
+{
+    std::vector<Snapshot_Solver::Measurement> measurements;
+    for (const auto& it : code_delay_map)
+        {
+            Snapshot_Solver::Measurement measurement;
+            measurement.PRN = static_cast<uint32_t>(it.first);
+            measurement.code_delay_s = it.second;
+            measurements.push_back(measurement);
+        }
+
+    arma::vec r_eb_e;
+    arma::vec v_eb_e;
+    pv_Geo_to_ECEF(degtorad(lat_deg), degtorad(lon_deg), altitude_m, arma::vec(3, arma::fill::zeros), r_eb_e, v_eb_e);
+    const std::array<double, 3> approx_position{r_eb_e(0), r_eb_e(1), r_eb_e(2)};
+
+    Snapshot_Solver solver(global_gps_ephemeris_map.get_map_copy());
+    const Snapshot_Solver::Solution fix = solver.solve(measurements, approx_tow, approx_position);
+    if (!fix.valid)
+        {
+            std::cout << "Snapshot position fix not available with " << measurements.size() << " satellites (at least 5 needed).\n";
+            return;
+        }
+    const arma::vec LLH = LLH_to_deg(cart2geo(arma::vec{fix.position_ecef_m[0], fix.position_ecef_m[1], fix.position_ecef_m[2]}, 4));
+    std::cout << std::setiosflags(std::ios::fixed) << "Snapshot position fix with " << fix.satellites << " satellites:\n";
+    std::cout << std::setprecision(7) << "Latitude=" << LLH(0) << " [º]\n";
+    std::cout << "Longitude=" << LLH(1) << " [º]\n";
+    std::cout << std::setprecision(2) << "Altitude=" << LLH(2) << " [m]\n";
+    std::cout << std::setprecision(6) << "GPS TOW=" << fix.rx_time_s << " [s]\n";
+    std::cout << std::setprecision(2) << "Residual RMS=" << fix.residual_rms_m << " [m]\n";
+}
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n RTL-SDR E4000 RF front-end center frequency and sampling rate calibration tool that uses GPS signals\n") +
+        "Copyright (C) 2010-2019 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License\n \n");
+
+    gflags::SetUsageMessage(intro_help);
+    google::SetVersionString(FRONT_END_CAL_VERSION);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    std::cout << "Initializing... Please wait.\n";
+
+    google::InitGoogleLogging(argv[0]);
+    if (FLAGS_log_dir.empty())
+        {
+            std::cout << "Logging will be done at "
+                      << "/tmp"
+                      << '\n'
+                      << "Use front-end-cal --log_dir=/path/to/log to change that."
+                      << '\n';
+        }
+    else
+        {
+            const fs::path p(FLAGS_log_dir);
+            if (!fs::exists(p))
+                {
+                    std::cout << "The path "
+                              << FLAGS_log_dir
+                              << " does not exist, attempting to create it"
+                              << '\n';
+                    fs::create_directory(p);
+                }
+            std::cout << "Logging with be done at "
+                      << FLAGS_log_dir << '\n';
+        }
+
+    // 0. Instantiate the FrontEnd Calibration class
+    FrontEndCal front_end_cal;
+
+    // 1. Load configuration parameters from config file
+    std::shared_ptr<ConfigurationInterface> configuration = std::make_shared<FileConfiguration>(FLAGS_config_file);
+    front_end_cal.set_configuration(configuration);
+
+    // 2. Get SUPL information from server: Ephemeris record, assistance info and TOW
+    try
+        {
+            if (front_end_cal.get_ephemeris() == true)
+                {
+                    std::cout << "SUPL data received OK!\n";
+                }
+            else
+                {
+                    std::cout << "Failure connecting to SUPL server\n";
+                }
+        }
+    catch (const boost::exception& e)
+        {
+            std::cout << "Failure connecting to SUPL server\n";
+        }
+
+    // 3. Capture some front-end samples to hard disk
+    try
+        {
+            if (front_end_capture(configuration))
+                {
+                    std::cout << "Front-end RAW samples captured\n";
+                }
+            else
+                {
+                    std::cout << "Failure capturing front-end samples\n";
+                }
+        }
+    catch (const boost::bad_lexical_cast& e)
+        {
+            std::cout << "Exception caught while capturing samples (bad lexical cast)\n";
+        }
+    catch (const std::exception& e)
+        {
+            std::cout << "Exception caught while capturing samples: " << e.what() << '\n';
+        }
+    catch (...)
+        {
+            std::cout << "Unexpected exception\n";
+        }
+
+    // 4. Search the visible GPS satellites in the capture (positive acquisitions with Doppler measurements)
+    std::map<int, double> doppler_measurements_map;
+    const int64_t fs_in_ = configuration->property("GNSS-SDR.internal_fs_sps", 2048000);
+
+    // record startup time
+    std::chrono::time_point<std::chrono::system_clock> start;
+    std::chrono::time_point<std::chrono::system_clock> end;
+    std::chrono::duration<double> elapsed_seconds{};
+    start = std::chrono::system_clock::now();
+
+    std::map<int, double> code_delay_map;
+    if (FLAGS_fast or FLAGS_snapshot)
+        {
+            fast_acquisition(configuration, front_end_cal, doppler_measurements_map, FLAGS_snapshot ? &code_delay_map : nullptr);
+        }
+    else
+        {
+            serial_acquisition(configuration, doppler_measurements_map);
+        }
 
     // report the elapsed time
     end = std::chrono::system_clock::now();
@@ -493,7 +600,7 @@ int main(int argc, char** argv)
               << elapsed_seconds.count()
               << " [seconds]\n";
 
-    // 6. find TOW from SUPL assistance
+    // 5. find TOW from SUPL assistance
     double current_TOW = 0;
     try
         {
@@ -538,6 +645,11 @@ int main(int argc, char** argv)
     std::cout << "Longitude=" << lon_deg << " [º]\n";
     std::cout << "Altitude=" << altitude_m << " [m]\n";
 
+    if (FLAGS_snapshot)
+        {
+            snapshot_fix(code_delay_map, current_TOW, lat_deg, lon_deg, altitude_m);
+        }
+
     if (doppler_measurements_map.empty())
         {
             std::cout << "Sorry, no GPS satellites detected in the front-end capture, please check the antenna setup...\n";
@@ -549,6 +661,7 @@ int main(int argc, char** argv)
     std::map<int, double> f_if_estimation_Hz_map;
     std::map<int, double> f_fs_estimation_Hz_map;
     std::map<int, double> f_ppm_estimation_Hz_map;
+    std::map<int, double> predicted_doppler_map;
 
     std::cout << std::setiosflags(std::ios::fixed) << std::setprecision(2) << "Doppler analysis results:\n";
 
@@ -561,7 +674,8 @@ int main(int argc, char** argv)
                     double doppler_estimated_hz;
                     doppler_estimated_hz = front_end_cal.estimate_doppler_from_eph(it.first, current_TOW, lat_deg, lon_deg, altitude_m);
                     std::cout << "  " << it.first << "   " << it.second << "   " << doppler_estimated_hz << '\n';
-                    // 7. Compute front-end IF and sampling frequency estimation
+                    predicted_doppler_map[it.first] = doppler_estimated_hz;
+                    // 6. Compute front-end IF and sampling frequency estimation
                     // Compare with the measurements and compute clock drift using FE model
                     double estimated_fs_Hz;
                     double estimated_f_if_Hz;
@@ -603,6 +717,13 @@ int main(int argc, char** argv)
     mean_fs_Hz /= n_elements;
     mean_osc_err_ppm /= n_elements;
 
+    if ((FLAGS_fast or FLAGS_snapshot) and !predicted_doppler_map.empty())
+        {
+            // Solve for the offset common to all the satellites, and apply the model once
+            const double frequency_offset_hz = FrontEndCal::estimate_frequency_offset(doppler_measurements_map, predicted_doppler_map);
+            front_end_cal.GPS_L1_front_end_model_E4000(0.0, frequency_offset_hz, fs_in_, &mean_fs_Hz, &mean_f_if_Hz, &mean_osc_err_ppm);
+        }
+
     std::cout << std::setiosflags(std::ios::fixed) << std::setprecision(2) << "Parameters estimation for Elonics E4000 Front-End:\n";
 
     std::cout << "Sampling frequency =" << mean_fs_Hz << " [Hz]\n";
@@ -13,37 +13,101 @@
  * -----------------------------------------------------------------------------
  */
 
+#include "nav_msg_column_writer.h"
+#include "nav_msg_deduplicator.h"
 #include "nav_msg_udp_listener.h"
 #include <boost/lexical_cast.hpp>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const size_t BATCH_SIZE = 64;               // datagrams read per system call
+const size_t DEDUPLICATION_WINDOW = 65536;  // distinct navigation words remembered
+const size_t ROWS_PER_BLOCK = 1000;          // rows written to the output file at once
+std::mutex print_mutex;
+
+void receive_messages(unsigned short port, bool reuse_port, Nav_Msg_Deduplicator &deduplicator, Nav_Msg_Column_Writer *writer)
+{
+    Nav_Msg_Udp_Listener udp_listener(port, reuse_port);
+    std::vector<gnss_sdr::navMsg> messages;
+    while (true)
+        {
+            const size_t received = udp_listener.receive_and_parse_nav_messages(messages, BATCH_SIZE);
+            for (size_t i = 0; i < received; i++)
+                {
+                    if (!deduplicator.is_new(messages[i]))
+                        {
+                            continue;
+                        }
+                    if (writer != nullptr)
+                        {
+                            writer->append(messages[i]);
+                        }
+                    else
+                        {
+                            std::lock_guard<std::mutex> lock(print_mutex);
+                            udp_listener.print_message(messages[i]);
+                        }
+                }
+            // write what is pending when the traffic is low, the blocks
+            // are only full under load
+            if (writer != nullptr and received < BATCH_SIZE)
+                {
+                    writer->flush();
+                }
+        }
+}
+}  // namespace
 
 int main(int argc, char *argv[])
 {
     try
         {
             // Check command line arguments.
-            if (argc != 2)
+            if (argc < 2 || argc > 4)
                 {
                     // Print help.
-                    std::cerr << "Usage: nav_msg_listener <port>\n";
+                    std::cerr << "Usage: nav_msg_listener <port> [threads] [output.csv]\n";
                     return 1;
                 }
 
             unsigned short port = boost::lexical_cast<unsigned short>(argv[1]);
-            Nav_Msg_Udp_Listener udp_listener(port);
-
-            while (true)
+            unsigned int n_threads = 1;
+            if (argc > 2)
                 {
-                    gnss_sdr::navMsg message;
-                    if (udp_listener.receive_and_parse_nav_message(message))
+                    n_threads = boost::lexical_cast<unsigned int>(argv[2]);
+                    if (n_threads == 0)
                         {
-                            udp_listener.print_message(message);
+                            n_threads = std::thread::hardware_concurrency();
                         }
-                    else
+                }
+
+            std::unique_ptr<Nav_Msg_Column_Writer> writer;
+            if (argc > 3)
+                {
+                    writer = std::unique_ptr<Nav_Msg_Column_Writer>(new Nav_Msg_Column_Writer(argv[3], ROWS_PER_BLOCK));
+                    if (!writer->is_open())
                         {
-                            std::cout << "Error: the message cannot be parsed." << std::endl;
+                            std::cerr << "Error: cannot open " << argv[3] << '\n';
+                            return 1;
                         }
                 }
+
+            Nav_Msg_Deduplicator deduplicator(DEDUPLICATION_WINDOW);
+            std::vector<std::thread> threads;
+            for (unsigned int i = 0; i < n_threads; i++)
+                {
+                    threads.emplace_back(receive_messages, port, n_threads > 1, std::ref(deduplicator), writer.get());
+                }
+            for (auto &thread : threads)
+                {
+                    thread.join();
+                }
         }
     catch (std::exception &e)
         {
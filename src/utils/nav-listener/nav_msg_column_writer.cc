@@ -0,0 +1,78 @@
+/*!
+ * \file nav_msg_column_writer.cc
+ * \brief Stores the navigation messages in a file, column by column
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2021  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "nav_msg_column_writer.h"
+#include <sstream>
+
+Nav_Msg_Column_Writer::Nav_Msg_Column_Writer(const std::string &file_name, size_t block_rows)
+    : d_file(file_name, std::ios::out | std::ios::trunc),
+      d_block_rows(block_rows == 0 ? 1 : block_rows)
+{
+    d_system.reserve(d_block_rows);
+    d_signal.reserve(d_block_rows);
+    d_prn.reserve(d_block_rows);
+    d_tow_ms.reserve(d_block_rows);
+    d_nav_message.reserve(d_block_rows);
+    if (d_file.is_open())
+        {
+            d_file << "system,signal,prn,tow_at_current_symbol_ms,nav_message\n";
+        }
+}
+
+Nav_Msg_Column_Writer::~Nav_Msg_Column_Writer()
+{
+    flush();
+}
+
+void Nav_Msg_Column_Writer::append(const gnss_sdr::navMsg &message)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_system.push_back(message.system());
+    d_signal.push_back(message.signal());
+    d_prn.push_back(message.prn());
+    d_tow_ms.push_back(message.tow_at_current_symbol_ms());
+    d_nav_message.push_back(message.nav_message());
+    if (d_prn.size() >= d_block_rows)
+        {
+            write_block();
+        }
+}
+
+void Nav_Msg_Column_Writer::flush()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    write_block();
+    d_file.flush();
+}
+
+void Nav_Msg_Column_Writer::write_block()
+{
+    if (d_file.is_open() and !d_prn.empty())
+        {
+            // formatted in memory first, and written with a single call
+            std::ostringstream block;
+            for (size_t i = 0; i < d_prn.size(); i++)
+                {
+                    block << d_system[i] << ',' << d_signal[i] << ',' << d_prn[i] << ','
+                          << d_tow_ms[i] << ',' << d_nav_message[i] << '\n';
+                }
+            d_file << block.str();
+        }
+    d_system.clear();
+    d_signal.clear();
+    d_prn.clear();
+    d_tow_ms.clear();
+    d_nav_message.clear();
+}
@@ -0,0 +1,61 @@
+/*!
+ * \file nav_msg_column_writer.h
+ * \brief Stores the navigation messages in a file, column by column
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2021  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NAV_MSG_COLUMN_WRITER_H
+#define GNSS_SDR_NAV_MSG_COLUMN_WRITER_H
+
+#include "nav_message.pb.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Collects the messages of all the listener threads in one column per
+ * field (system, signal, PRN, TOW and bits), and appends them to a CSV file
+ * every block_rows rows, which loads directly into a columnar store. Shared
+ * by all the listener threads.
+ */
+class Nav_Msg_Column_Writer
+{
+public:
+    Nav_Msg_Column_Writer(const std::string &file_name, size_t block_rows);
+    ~Nav_Msg_Column_Writer();
+
+    bool is_open() const { return d_file.is_open(); }
+
+    void append(const gnss_sdr::navMsg &message);
+
+    /*!
+     * \brief Writes the rows not written yet
+     */
+    void flush();
+
+private:
+    void write_block();
+
+    std::mutex d_mutex;
+    std::ofstream d_file;
+    size_t d_block_rows;
+    std::vector<std::string> d_system;
+    std::vector<std::string> d_signal;
+    std::vector<int32_t> d_prn;
+    std::vector<int32_t> d_tow_ms;
+    std::vector<std::string> d_nav_message;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*!
+ * \file nav_msg_deduplicator.cc
+ * \brief Drops the navigation messages already received from another receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2021  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "nav_msg_deduplicator.h"
+#include <utility>
+
+Nav_Msg_Deduplicator::Nav_Msg_Deduplicator(size_t capacity)
+    : d_capacity(capacity == 0 ? 1 : capacity)
+{
+    d_seen.reserve(d_capacity);
+}
+
+bool Nav_Msg_Deduplicator::is_new(const gnss_sdr::navMsg &message)
+{
+    std::string key = make_key(message);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_seen.count(key) != 0)
+        {
+            d_duplicates++;
+            return false;
+        }
+    if (d_order.size() == d_capacity)
+        {
+            d_seen.erase(d_order.front());
+            d_order.pop_front();
+        }
+    d_seen.insert(key);
+    d_order.push_back(std::move(key));
+    return true;
+}
+
+uint64_t Nav_Msg_Deduplicator::duplicates() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_duplicates;
+}
+
+std::string Nav_Msg_Deduplicator::make_key(const gnss_sdr::navMsg &message)
+{
+    std::string key;
+    key.reserve(message.system().size() + message.signal().size() + message.nav_message().size() + 24);
+    key += message.system();
+    key += '|';
+    key += message.signal();
+    key += '|';
+    key += std::to_string(message.prn());
+    key += '|';
+    key += std::to_string(message.tow_at_current_symbol_ms());
+    key += '|';
+    key += message.nav_message();
+    return key;
+}
@@ -0,0 +1,54 @@
+/*!
+ * \file nav_msg_deduplicator.h
+ * \brief Drops the navigation messages already received from another receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2021  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NAV_MSG_DEDUPLICATOR_H
+#define GNSS_SDR_NAV_MSG_DEDUPLICATOR_H
+
+#include "nav_message.pb.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+/*!
+ * \brief Remembers the last capacity distinct navigation words (system,
+ * signal, PRN, TOW and bits), so that the same word decoded by many receivers
+ * is stored only once. Shared by all the listener threads.
+ */
+class Nav_Msg_Deduplicator
+{
+public:
+    explicit Nav_Msg_Deduplicator(size_t capacity);
+
+    /*!
+     * \brief True the first time that this navigation word is seen
+     */
+    bool is_new(const gnss_sdr::navMsg &message);
+
+    uint64_t duplicates() const;
+
+private:
+    static std::string make_key(const gnss_sdr::navMsg &message);
+
+    mutable std::mutex d_mutex;
+    std::unordered_set<std::string> d_seen;
+    std::deque<std::string> d_order;  // oldest first, for the eviction
+    size_t d_capacity;
+    uint64_t d_duplicates{0};
+};
+
+#endif
@@ -18,11 +18,27 @@
 #include <sstream>
 #include <string>
 
-Nav_Msg_Udp_Listener::Nav_Msg_Udp_Listener(unsigned short port)
+#if defined(__linux__)
+#include <sys/socket.h>  // for recvmmsg, mmsghdr
+#include <sys/uio.h>     // for iovec
+#endif
+
+Nav_Msg_Udp_Listener::Nav_Msg_Udp_Listener(unsigned short port, bool reuse_port)
     : socket{io_service}, endpoint{boost::asio::ip::udp::v4(), port}
 {
     socket.open(endpoint.protocol(), error);  // Open socket.
-    socket.bind(endpoint, error);             // Bind the socket to the given local endpoint.
+#if defined(SO_REUSEPORT)
+    if (reuse_port)
+        {
+            socket.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), error);
+        }
+#else
+    if (reuse_port)
+        {
+            std::cerr << "Warning: SO_REUSEPORT is not available, only one listener will receive data.\n";
+        }
+#endif
+    socket.bind(endpoint, error);  // Bind the socket to the given local endpoint.
 }
 
 /**
@@ -42,6 +58,61 @@ bool Nav_Msg_Udp_Listener::receive_and_parse_nav_message(gnss_sdr::navMsg &messa
     return message.ParseFromString(data);
 }
 
+size_t Nav_Msg_Udp_Listener::receive_and_parse_nav_messages(std::vector<gnss_sdr::navMsg> &messages, size_t max_messages)
+{
+    if (max_messages == 0)
+        {
+            max_messages = 1;
+        }
+    if (messages.size() < max_messages)
+        {
+            messages.resize(max_messages);
+        }
+    if (d_buffers.size() < max_messages * MAX_DATAGRAM_LENGTH)
+        {
+            d_buffers.resize(max_messages * MAX_DATAGRAM_LENGTH);
+        }
+
+    size_t parsed = 0;
+#if defined(__linux__)
+    std::vector<struct mmsghdr> headers(max_messages);
+    std::vector<struct iovec> iovecs(max_messages);
+    for (size_t i = 0; i < max_messages; i++)
+        {
+            iovecs[i].iov_base = &d_buffers[i * MAX_DATAGRAM_LENGTH];
+            iovecs[i].iov_len = MAX_DATAGRAM_LENGTH;
+            headers[i] = {};
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+    // Blocks for the first datagram, then takes the ones already queued
+    const int received = recvmmsg(socket.native_handle(), headers.data(), static_cast<unsigned int>(max_messages), MSG_WAITFORONE, nullptr);
+    for (int i = 0; i < received; i++)
+        {
+            if (messages[parsed].ParseFromArray(&d_buffers[i * MAX_DATAGRAM_LENGTH], static_cast<int>(headers[i].msg_len)))
+                {
+                    parsed++;
+                }
+            else
+                {
+                    d_parse_errors++;
+                }
+        }
+#else
+    const size_t bytes = socket.receive(boost::asio::buffer(d_buffers.data(), MAX_DATAGRAM_LENGTH));
+    if (messages[0].ParseFromArray(d_buffers.data(), static_cast<int>(bytes)))
+        {
+            parsed = 1;
+        }
+    else
+        {
+            d_parse_errors++;
+        }
+#endif
+    return parsed;
+}
+
 /*
  * !\brief prints navigation message content
  * \param[in] message nav message to be printed
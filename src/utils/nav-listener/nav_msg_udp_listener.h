@@ -18,19 +18,42 @@
 
 #include "nav_message.pb.h"
 #include <boost/asio.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 class Nav_Msg_Udp_Listener
 {
 public:
-    explicit Nav_Msg_Udp_Listener(unsigned short port);
+    /*!
+     * \brief Binds to port. With reuse_port, several listeners (one per
+     * thread) can bind to the same port, and the kernel spreads the incoming
+     * datagrams among them.
+     */
+    explicit Nav_Msg_Udp_Listener(unsigned short port, bool reuse_port = false);
     void print_message(gnss_sdr::navMsg &message) const;
     bool receive_and_parse_nav_message(gnss_sdr::navMsg &message);
 
+    /*!
+     * \brief Blocks until a datagram is received, then reads up to
+     * max_messages of the ones already queued with a single system call
+     * (recvmmsg on Linux) and parses them into messages. Returns the number
+     * of parsed messages. Datagrams that cannot be parsed are counted in
+     * parse_errors().
+     */
+    size_t receive_and_parse_nav_messages(std::vector<gnss_sdr::navMsg> &messages, size_t max_messages);
+
+    uint64_t parse_errors() const { return d_parse_errors; }
+
 private:
+    static const size_t MAX_DATAGRAM_LENGTH = 8192;
+
     boost::asio::io_service io_service;
     boost::asio::ip::udp::socket socket;
     boost::system::error_code error;
     boost::asio::ip::udp::endpoint endpoint;
+    std::vector<char> d_buffers;
+    uint64_t d_parse_errors{0};
 };
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "gnuplot_i.h"
 #include "obsdiff_flags.h"
+#include "obsdiff_stream.h"
 #include <armadillo>
 // Classes for handling observations RINEX files (data)
 #include <gpstk/Rinex3ObsData.hpp>
@@ -1684,6 +1685,13 @@ int main(int argc, char** argv)
 {
     std::cout << "Running RINEX observables difference tool...\n";
     gflags::ParseCommandLineFlags(&argc, &argv, true);
+    if (FLAGS_stream_compare)
+        {
+            const int res = RINEX_stream_diff(FLAGS_base_rinex_obs, FLAGS_rover_rinex_obs, FLAGS_skip_obs_transitory_s,
+                static_cast<unsigned int>(std::max(FLAGS_threads, 0)), static_cast<size_t>(std::max(FLAGS_stream_queue_epochs, 1)), FLAGS_stream_csv);
+            gflags::ShutDownCommandLineFlags();
+            return res;
+        }
     if (FLAGS_single_diff)
         {
             if (FLAGS_dupli_sat)
@@ -33,5 +33,9 @@ DEFINE_string(rover_rinex_obs, "base.obs", "Filename of test RINEX observation f
 DEFINE_string(system, "G", "GNSS satellite system: G for GPS, E for Galileo");
 DEFINE_string(signal, "1C", "GNSS signal: 1C for GPS L1 CA, 1B for Galileo E1");
 DEFINE_bool(remove_rx_clock_error, false, "Compute and remove the receivers clock error prior to compute observable differences (requires a valid RINEX nav file for both receivers)");
+DEFINE_bool(stream_compare, false, "Compare all the satellites and signals of the base and rover RINEX files epoch by epoch, in parallel and with bounded memory");
+DEFINE_int32(threads, 0, "Number of worker threads of the streaming comparison. 0 uses one per available core");
+DEFINE_int32(stream_queue_epochs, 256, "Maximum number of epochs queued between the stages of the streaming comparison");
+DEFINE_string(stream_csv, "", "If not empty, file where the statistics of the streaming comparison are written as CSV");
 
 #endif
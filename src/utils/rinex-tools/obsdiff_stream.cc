@@ -0,0 +1,403 @@
+/*!
+ * \file obsdiff_stream.cc
+ * \brief Streaming, multithreaded comparison of two RINEX observation files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obsdiff_stream.h"
+#include <gpstk/GPSWeekSecond.hpp>
+#include <gpstk/Rinex3ObsData.hpp>
+#include <gpstk/Rinex3ObsHeader.hpp>
+#include <gpstk/Rinex3ObsStream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Two epochs closer than this are the same epoch [s]
+constexpr double EPOCH_TOLERANCE_S = 1e-3;
+
+
+/*
+ * Queue with a maximum size. push() blocks while it is full, and pop()
+ * while it is empty and not closed.
+ */
+template <typename T>
+class Bounded_Queue
+{
+public:
+    explicit Bounded_Queue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    void push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return items_.size() < capacity_ or closed_; });
+        if (closed_)
+            {
+                return;
+            }
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !items_.empty() or closed_; });
+        if (items_.empty())
+            {
+                return false;
+            }
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    // the items already queued can still be popped
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    size_t capacity_;
+    bool closed_{false};
+};
+
+
+/*
+ * Satellite and observation type in one integer: system character,
+ * satellite number and the three characters of the RINEX 3 observation code
+ */
+uint64_t obs_key(char system, int sat_id, const std::string& obs_type)
+{
+    uint64_t key = (static_cast<uint64_t>(static_cast<unsigned char>(system)) << 48) |
+                   (static_cast<uint64_t>(sat_id & 0xFFFF) << 32);
+    for (size_t i = 0; i < 3 and i < obs_type.size(); i++)
+        {
+            key |= static_cast<uint64_t>(static_cast<unsigned char>(obs_type[i])) << (16 - 8 * i);
+        }
+    return key;
+}
+
+
+std::string sat_name(uint64_t key)
+{
+    std::stringstream name;
+    name << static_cast<char>((key >> 48) & 0xFF) << std::setw(2) << std::setfill('0') << ((key >> 32) & 0xFFFF);
+    return name.str();
+}
+
+
+std::string obs_name(uint64_t key)
+{
+    return std::string{static_cast<char>((key >> 16) & 0xFF), static_cast<char>((key >> 8) & 0xFF), static_cast<char>(key & 0xFF)};
+}
+
+
+const char* obs_unit(uint64_t key)
+{
+    switch (static_cast<char>((key >> 16) & 0xFF))
+        {
+        case 'C':
+            return "m";
+        case 'L':
+            return "cycles";
+        case 'D':
+            return "Hz";
+        case 'S':
+            return "dB-Hz";
+        default:
+            return "";
+        }
+}
+
+
+struct Epoch
+{
+    double time_s{0.0};                             // GPS seconds since the beginning of the GPS time
+    std::vector<std::pair<uint64_t, double>> obs;  // sorted by key
+};
+
+
+struct Diff_Sample
+{
+    uint64_t key;
+    double diff;
+};
+
+
+// Running statistics of the differences of one satellite and observation type
+struct Diff_Stats
+{
+    uint64_t count{0};
+    double first{0.0};
+    double mean{0.0};
+    double m2{0.0};
+    double max_abs{0.0};
+
+    void add(double diff, bool relative)
+    {
+        if (count == 0)
+            {
+                first = diff;
+            }
+        const double value = relative ? diff - first : diff;
+        count++;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+        max_abs = std::max(max_abs, std::abs(value));
+    }
+
+    double stdev() const { return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0; }
+    double rms() const { return count > 0 ? std::sqrt(mean * mean + m2 / static_cast<double>(count)) : 0.0; }
+};
+
+
+void read_epochs(const std::string& rinex_file, Bounded_Queue<Epoch>* queue, std::atomic<bool>* failed)
+{
+    try
+        {
+            gpstk::Rinex3ObsStream stream(rinex_file.c_str());
+            if (!stream)
+                {
+                    std::cerr << "Unable to open RINEX Obs file " << rinex_file << '\n';
+                    failed->store(true);
+                    queue->close();
+                    return;
+                }
+            gpstk::Rinex3ObsHeader header;
+            gpstk::Rinex3ObsData data;
+            stream >> header;
+            while (stream >> data)
+                {
+                    if (data.epochFlag != 0 and data.epochFlag != 1)
+                        {
+                            continue;  // header records or events, not observations
+                        }
+                    const gpstk::GPSWeekSecond gps_time(data.time);
+                    Epoch epoch;
+                    epoch.time_s = static_cast<double>(gps_time.week) * 604800.0 + gps_time.sow;
+                    for (const auto& sat_obs : data.obs)
+                        {
+                            const char system = sat_obs.first.systemChar();
+                            const auto types = header.mapObsTypes.find(std::string(1, system));
+                            if (types == header.mapObsTypes.end())
+                                {
+                                    continue;
+                                }
+                            const size_t n = std::min(sat_obs.second.size(), types->second.size());
+                            for (size_t i = 0; i < n; i++)
+                                {
+                                    const double value = sat_obs.second[i].data;
+                                    if (value != 0.0)  // blank fields are read as zero
+                                        {
+                                            epoch.obs.emplace_back(obs_key(system, sat_obs.first.id, types->second[i].asString()), value);
+                                        }
+                                }
+                        }
+                    std::sort(epoch.obs.begin(), epoch.obs.end());
+                    queue->push(std::move(epoch));
+                }
+        }
+    catch (const gpstk::Exception& e)
+        {
+            std::cerr << "Error reading " << rinex_file << ": " << e << '\n';
+            failed->store(true);
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Error reading " << rinex_file << ": " << e.what() << '\n';
+            failed->store(true);
+        }
+    queue->close();
+}
+
+
+void accumulate(Bounded_Queue<std::vector<Diff_Sample>>* queue, std::map<uint64_t, Diff_Stats>* stats)
+{
+    std::vector<Diff_Sample> batch;
+    while (queue->pop(batch))
+        {
+            for (const auto& sample : batch)
+                {
+                    // carrier phases are compared from the first common epoch on
+                    (*stats)[sample.key].add(sample.diff, obs_name(sample.key)[0] == 'L');
+                }
+        }
+}
+}  // namespace
+
+
+int RINEX_stream_diff(const std::string& base_rinex_obs,
+    const std::string& rover_rinex_obs,
+    double skip_transitory_s,
+    unsigned int num_threads,
+    size_t max_queued_epochs,
+    const std::string& csv_file)
+{
+    if (num_threads == 0)
+        {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+    std::cout << "Comparing " << rover_rinex_obs << " with " << base_rinex_obs
+              << " (streaming, " << num_threads << " worker threads)\n";
+
+    std::atomic<bool> read_failed{false};
+    Bounded_Queue<Epoch> base_queue(max_queued_epochs);
+    Bounded_Queue<Epoch> rover_queue(max_queued_epochs);
+    std::thread base_reader(read_epochs, base_rinex_obs, &base_queue, &read_failed);
+    std::thread rover_reader(read_epochs, rover_rinex_obs, &rover_queue, &read_failed);
+
+    // each worker owns the satellite and signal pairs with key % num_threads equal to its index
+    std::vector<std::unique_ptr<Bounded_Queue<std::vector<Diff_Sample>>>> worker_queues;
+    std::vector<std::map<uint64_t, Diff_Stats>> worker_stats(num_threads);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < num_threads; i++)
+        {
+            worker_queues.push_back(std::make_unique<Bounded_Queue<std::vector<Diff_Sample>>>(max_queued_epochs));
+            workers.emplace_back(accumulate, worker_queues.back().get(), &worker_stats[i]);
+        }
+
+    // align the epochs of both files and send the differences to the workers
+    uint64_t common_epochs = 0;
+    double first_common_time_s = -1.0;
+    Epoch base;
+    Epoch rover;
+    bool has_base = base_queue.pop(base);
+    bool has_rover = rover_queue.pop(rover);
+    while (has_base and has_rover)
+        {
+            if (base.time_s < rover.time_s - EPOCH_TOLERANCE_S)
+                {
+                    has_base = base_queue.pop(base);
+                    continue;
+                }
+            if (rover.time_s < base.time_s - EPOCH_TOLERANCE_S)
+                {
+                    has_rover = rover_queue.pop(rover);
+                    continue;
+                }
+            if (first_common_time_s < 0.0)
+                {
+                    first_common_time_s = rover.time_s;
+                }
+            if (rover.time_s >= first_common_time_s + skip_transitory_s)
+                {
+                    common_epochs++;
+                    std::vector<std::vector<Diff_Sample>> batches(num_threads);
+                    auto b = base.obs.cbegin();
+                    for (const auto& r : rover.obs)
+                        {
+                            while (b != base.obs.cend() and b->first < r.first)
+                                {
+                                    ++b;
+                                }
+                            if (b != base.obs.cend() and b->first == r.first)
+                                {
+                                    batches[r.first % num_threads].push_back({r.first, r.second - b->second});
+                                }
+                        }
+                    for (unsigned int i = 0; i < num_threads; i++)
+                        {
+                            if (!batches[i].empty())
+                                {
+                                    worker_queues[i]->push(std::move(batches[i]));
+                                }
+                        }
+                }
+            has_base = base_queue.pop(base);
+            has_rover = rover_queue.pop(rover);
+        }
+
+    // stop the readers if one file ended before the other
+    base_queue.close();
+    rover_queue.close();
+    base_reader.join();
+    rover_reader.join();
+    for (unsigned int i = 0; i < num_threads; i++)
+        {
+            worker_queues[i]->close();
+            workers[i].join();
+        }
+
+    if (read_failed or common_epochs == 0)
+        {
+            std::cerr << "No common epochs to compare\n";
+            return 1;
+        }
+
+    std::map<uint64_t, Diff_Stats> stats;
+    for (auto& partial : worker_stats)
+        {
+            stats.insert(partial.begin(), partial.end());
+        }
+
+    std::cout << "Compared " << common_epochs << " common epochs after skipping " << skip_transitory_s << " [s]\n";
+    std::cout << "SAT OBS     count           mean          stdev            rms        max_abs unit\n";
+    std::cout << std::setprecision(6) << std::scientific;
+    for (const auto& entry : stats)
+        {
+            const Diff_Stats& s = entry.second;
+            std::cout << sat_name(entry.first) << ' ' << obs_name(entry.first) << ' '
+                      << std::setw(9) << s.count << ' '
+                      << std::setw(14) << s.mean << ' '
+                      << std::setw(14) << s.stdev() << ' '
+                      << std::setw(14) << s.rms() << ' '
+                      << std::setw(14) << s.max_abs << ' '
+                      << obs_unit(entry.first) << '\n';
+        }
+    std::cout << std::defaultfloat;
+
+    if (!csv_file.empty())
+        {
+            std::ofstream csv(csv_file);
+            if (!csv.is_open())
+                {
+                    std::cerr << "Unable to write " << csv_file << '\n';
+                    return 1;
+                }
+            csv << "sat,obs,count,mean,stdev,rms,max_abs,unit\n"
+                << std::setprecision(12);
+            for (const auto& entry : stats)
+                {
+                    const Diff_Stats& s = entry.second;
+                    csv << sat_name(entry.first) << ',' << obs_name(entry.first) << ',' << s.count << ','
+                        << s.mean << ',' << s.stdev() << ',' << s.rms() << ',' << s.max_abs << ','
+                        << obs_unit(entry.first) << '\n';
+                }
+        }
+    return 0;
+}
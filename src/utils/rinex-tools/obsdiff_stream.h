@@ -0,0 +1,45 @@
+/*!
+ * \file obsdiff_stream.h
+ * \brief Streaming, multithreaded comparison of two RINEX observation files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBSDIFF_STREAM_H
+#define GNSS_SDR_OBSDIFF_STREAM_H
+
+#include <cstddef>
+#include <string>
+
+
+/*!
+ * \brief Compares, for every satellite and observation type present in both
+ * files, the observations of the epochs common to the base and the rover
+ * RINEX files, and prints the statistics of the differences (rover - base).
+ *
+ * The files are read epoch by epoch, each one by its own thread, and the
+ * differences are accumulated by num_threads workers, each one owning a
+ * subset of the satellite and signal pairs. At most max_queued_epochs epochs
+ * are kept in memory between the stages, whatever the length of the files.
+ * Carrier phase differences are relative to the first common epoch, since
+ * the ambiguities of the two receivers are different.
+ *
+ * If csv_file is not empty, the statistics are also written there. Returns 0
+ * on success, or 1 if a file cannot be read or has no common epochs.
+ */
+int RINEX_stream_diff(const std::string& base_rinex_obs,
+    const std::string& rover_rinex_obs,
+    double skip_transitory_s,
+    unsigned int num_threads,
+    size_t max_queued_epochs,
+    const std::string& csv_file);
+
+#endif  // GNSS_SDR_OBSDIFF_STREAM_H
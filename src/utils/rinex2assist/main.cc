@@ -1,6 +1,6 @@
 /*!
  * \file main.cc
- * \brief converts navigation RINEX files into XML files for Assisted GNSS.
+ * \brief converts navigation RINEX files into XML or binary files for Assisted GNSS.
  * \author Carles Fernandez-Prades, 2018. cfernandez(at)cttc.cat
  *
  *
@@ -16,6 +16,7 @@
  */
 
 
+#include "agnss_assistance_data.h"
 #include "galileo_ephemeris.h"  // IWYU pragma: keep
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
@@ -42,15 +43,17 @@ using namespace google;
 }
 #endif
 
+DEFINE_string(binary, "", "If set, writes all the assistance data to a single binary file with this name, to be read with GNSS-SDR.AGNSS_binary_file, instead of the XML files.");
+
 int main(int argc, char** argv)
 {
     const std::string intro_help(
-        std::string("\n rinex2assist converts navigation RINEX files into XML files for Assisted GNSS\n") +
+        std::string("\n rinex2assist converts navigation RINEX files into XML or binary files for Assisted GNSS\n") +
         "Copyright (C) 2018 (see AUTHORS file for a list of contributors)\n" +
         "This program comes with ABSOLUTELY NO WARRANTY;\n" +
         "See COPYING file to see a copy of the General Public License.\n \n" +
         "Usage: \n" +
-        "   rinex2assist <RINEX Nav file input>");
+        "   rinex2assist [-binary=<output file>] <RINEX Nav file input>");
 
     gflags::SetUsageMessage(intro_help);
     google::SetVersionString("1.0");
@@ -60,7 +63,7 @@ int main(int argc, char** argv)
         {
             std::cerr << "Usage:\n";
             std::cerr << "   " << argv[0]
-                      << " <RINEX Nav file input>"
+                      << " [-binary=<output file>] <RINEX Nav file input>"
                       << '\n';
             gflags::ShutDownCommandLineFlags();
             return 1;
@@ -311,6 +314,39 @@ int main(int argc, char** argv)
             return 1;
         }
 
+    // Write binary file
+    if (!FLAGS_binary.empty())
+        {
+            Agnss_Assistance_Data assistance;
+            assistance.gps_ephemeris_map = eph_map;
+            assistance.gal_ephemeris_map = eph_gal_map;
+            if (gps_utc_model.valid)
+                {
+                    assistance.gps_utc = gps_utc_model;
+                }
+            if (gps_iono.valid)
+                {
+                    assistance.gps_iono = gps_iono;
+                }
+            if (gal_utc_model.A0 != 0)
+                {
+                    assistance.gal_utc = gal_utc_model;
+                }
+            if (gal_iono.ai0 != 0)
+                {
+                    assistance.gal_iono = gal_iono;
+                }
+            if (!assistance.save(FLAGS_binary))
+                {
+                    std::cerr << "Problem creating the binary file " << FLAGS_binary << '\n';
+                    gflags::ShutDownCommandLineFlags();
+                    return 1;
+                }
+            std::cout << "Generated file: " << FLAGS_binary << '\n';
+            gflags::ShutDownCommandLineFlags();
+            return 0;
+        }
+
     // Write XML ephemeris
     if (i != 0)
         {
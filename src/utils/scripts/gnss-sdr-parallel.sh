@@ -0,0 +1,255 @@
+#!/bin/sh
+# GNSS-SDR shell script that post-processes a recorded file faster than real
+# time, by splitting it into time segments that are processed by independent
+# GNSS-SDR instances running in parallel. The RINEX files produced by each
+# segment are then stitched together.
+#
+# usage: ./gnss-sdr-parallel.sh [options] -c config_file.conf
+#
+#   -c file    GNSS-SDR configuration file (mandatory). It must configure a
+#              file-based SignalSource (e.g. File_Signal_Source).
+#   -b binary  GNSS-SDR executable (default: gnss-sdr)
+#   -j jobs    number of instances running at the same time (default: 4)
+#   -n number  number of segments (default: the number of jobs)
+#   -w seconds warm-up of each segment: it starts that many seconds before its
+#              nominal start, so that its observables are already available
+#              when the previous segment ends (default: 60)
+#   -a dir     directory with Assisted GNSS XML files (gps_ephemeris.xml,
+#              gal_ephemeris.xml, gps_utc_model.xml, ...), e.g. obtained with
+#              rinex2assist from the broadcast navigation file of the day. If
+#              given, all the segments are warm-started with them.
+#   -t seconds duration of the file. Only needed if it cannot be computed from
+#              the item type and sampling frequency of the configuration.
+#   -o dir     output directory (default: ./gnss-sdr-parallel)
+#
+# Each segment runs in its own subdirectory of the output directory, where its
+# log and its outputs are written. In the stitched RINEX observation file, each
+# segment contributes the epochs after the last one of the previous segment.
+# Navigation records are merged, discarding duplicates. Only RINEX 3 files are
+# stitched, so PVT.rinex_version=3 is forced in all segments.
+
+# SPDX-FileCopyrightText: 2022 Carles Fernandez-Prades <carles.fernandez(at)cttc.es>
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+GNSS_SDR=gnss-sdr
+CONFIG=
+JOBS=4
+SEGMENTS=
+WARM_UP=60
+ASSIST_DIR=
+DURATION=
+OUTPUT_DIR=./gnss-sdr-parallel
+BASE_NAME=gnss-sdr
+
+usage() {
+    sed -n '6,27p' "$0" | sed 's/^# \{0,1\}//'
+    exit 1
+}
+
+while getopts "c:b:j:n:w:a:t:o:h" opt; do
+    case $opt in
+    c) CONFIG=$OPTARG ;;
+    b) GNSS_SDR=$OPTARG ;;
+    j) JOBS=$OPTARG ;;
+    n) SEGMENTS=$OPTARG ;;
+    w) WARM_UP=$OPTARG ;;
+    a) ASSIST_DIR=$OPTARG ;;
+    t) DURATION=$OPTARG ;;
+    o) OUTPUT_DIR=$OPTARG ;;
+    *) usage ;;
+    esac
+done
+
+if [ -z "$CONFIG" ] || [ ! -f "$CONFIG" ]; then
+    echo "Please specify an existing configuration file with -c"
+    usage
+fi
+if [ -z "$SEGMENTS" ]; then
+    SEGMENTS=$JOBS
+fi
+
+# Value of a property in the configuration file (the last one, if repeated)
+conf_get() {
+    awk -v key="$1" '
+        { sub(/[;#].*$/, "") }
+        index($0, "=") > 0 {
+            name = substr($0, 1, index($0, "=") - 1)
+            value = substr($0, index($0, "=") + 1)
+            gsub(/^[ \t]+|[ \t\r]+$/, "", name)
+            gsub(/^[ \t]+|[ \t\r]+$/, "", value)
+            if (name == key) { result = value }
+        }
+        END { print result }' "$CONFIG"
+}
+
+absolute_path() {
+    (cd "$(dirname "$1")" && echo "$(pwd)/$(basename "$1")")
+}
+
+FILENAME=$(conf_get SignalSource.filename)
+SAMPLING_FREQUENCY=$(conf_get SignalSource.sampling_frequency)
+ITEM_TYPE=$(conf_get SignalSource.item_type)
+HEADER_SIZE=$(conf_get SignalSource.header_size)
+[ -z "$ITEM_TYPE" ] && ITEM_TYPE=short
+[ -z "$HEADER_SIZE" ] && HEADER_SIZE=0
+
+if [ -z "$FILENAME" ] || [ ! -f "$FILENAME" ]; then
+    echo "SignalSource.filename=$FILENAME is not an existing file"
+    exit 1
+fi
+if [ -z "$SAMPLING_FREQUENCY" ]; then
+    echo "SignalSource.sampling_frequency is not set"
+    exit 1
+fi
+FILENAME=$(absolute_path "$FILENAME")
+CONFIG=$(absolute_path "$CONFIG")
+
+# Size of each file item, and number of items per sample
+case $ITEM_TYPE in
+gr_complex) ITEM_SIZE=8 ITEMS_PER_SAMPLE=1 ;;
+float) ITEM_SIZE=4 ITEMS_PER_SAMPLE=1 ;;
+short) ITEM_SIZE=2 ITEMS_PER_SAMPLE=1 ;;
+ishort) ITEM_SIZE=2 ITEMS_PER_SAMPLE=2 ;;
+byte) ITEM_SIZE=1 ITEMS_PER_SAMPLE=1 ;;
+ibyte) ITEM_SIZE=1 ITEMS_PER_SAMPLE=2 ;;
+*)
+    if [ -z "$DURATION" ]; then
+        echo "Cannot compute the duration of the file for item_type=$ITEM_TYPE, please give it with -t"
+        exit 1
+    fi
+    ITEM_SIZE=1 ITEMS_PER_SAMPLE=1
+    ;;
+esac
+
+if [ -z "$DURATION" ]; then
+    FILE_SIZE=$(wc -c <"$FILENAME")
+    DURATION=$(awk -v size="$FILE_SIZE" -v item="$ITEM_SIZE" -v n="$ITEMS_PER_SAMPLE" -v header="$HEADER_SIZE" -v fs="$SAMPLING_FREQUENCY" \
+        'BEGIN { printf "%.3f", (size / item - header) / n / fs }')
+fi
+
+echo "Processing $FILENAME ($DURATION s) in $SEGMENTS segments, $JOBS at a time"
+mkdir -p "$OUTPUT_DIR" || exit 1
+OUTPUT_DIR=$(cd "$OUTPUT_DIR" && pwd)
+
+# Prepare the configuration of each segment. The overrides are appended in a
+# new [GNSS-SDR] section, since the last value of a repeated property is used.
+k=0
+while [ "$k" -lt "$SEGMENTS" ]; do
+    SEGMENT_DIR="$OUTPUT_DIR/segment_$k"
+    mkdir -p "$SEGMENT_DIR"
+    awk -v k="$k" -v n="$SEGMENTS" -v duration="$DURATION" -v warm_up="$WARM_UP" -v fs="$SAMPLING_FREQUENCY" -v items="$ITEMS_PER_SAMPLE" -v dir="$SEGMENT_DIR" '
+        BEGIN {
+            start = k * duration / n
+            end = (k + 1) * duration / n
+            skip = start - warm_up
+            if (skip < 0) { skip = 0 }
+            print ""
+            print "[GNSS-SDR]"
+            printf "SignalSource.seconds_to_skip=%.6f\n", skip
+            # the last segment reads up to the end of the file
+            if (k < n - 1) { printf "SignalSource.samples=%.0f\n", (end - skip) * fs * items }
+            else { print "SignalSource.samples=0" }
+            print "SignalSource.repeat=false"
+            print "PVT.rinex_version=3"
+            print "PVT.output_path=" dir
+            split("rinex xml kml gpx geojson", outputs, " ")
+            for (i = 1; i <= 5; i++) { print "PVT." outputs[i] "_output_path=" dir }
+            print "PVT.nmea_output_file_path=" dir
+            print "PVT.rtcm_output_file_path=" dir
+        }' >"$SEGMENT_DIR/overrides.conf"
+    if [ -n "$ASSIST_DIR" ]; then
+        ASSIST_DIR_ABS=$(cd "$ASSIST_DIR" && pwd)
+        {
+            echo "GNSS-SDR.AGNSS_XML_enabled=true"
+            for xml in gps_ephemeris gps_utc_model gps_iono gps_cnav_ephemeris gps_almanac gal_ephemeris gal_utc_model gal_iono gal_almanac; do
+                echo "GNSS-SDR.AGNSS_${xml}_xml=$ASSIST_DIR_ABS/$xml.xml"
+            done
+            echo "GNSS-SDR.AGNSS_cnav_utc_model_xml=$ASSIST_DIR_ABS/gps_cnav_utc_model.xml"
+            echo "GNSS-SDR.AGNSS_glo_ephemeris_xml=$ASSIST_DIR_ABS/glo_gnav_ephemeris.xml"
+            echo "GNSS-SDR.AGNSS_glo_utc_model_xml=$ASSIST_DIR_ABS/glo_utc_model.xml"
+        } >>"$SEGMENT_DIR/overrides.conf"
+    fi
+    cat "$CONFIG" "$SEGMENT_DIR/overrides.conf" >"$SEGMENT_DIR/gnss-sdr.conf"
+    cat >"$SEGMENT_DIR/run.sh" <<EOF
+#!/bin/sh
+cd "$SEGMENT_DIR" || exit 1
+"$GNSS_SDR" --config_file="$SEGMENT_DIR/gnss-sdr.conf" --signal_source="$FILENAME" --RINEX_name=$BASE_NAME --keyboard=false --log_dir="$SEGMENT_DIR" >gnss-sdr.log 2>&1
+echo \$? >exit_status
+EOF
+    k=$((k + 1))
+done
+
+# Run the segments, at most JOBS of them at a time
+k=0
+while [ "$k" -lt "$SEGMENTS" ]; do
+    echo "$k"
+    k=$((k + 1))
+done | xargs -P "$JOBS" -I{} sh "$OUTPUT_DIR/segment_{}/run.sh"
+
+k=0
+while [ "$k" -lt "$SEGMENTS" ]; do
+    if [ "$(cat "$OUTPUT_DIR/segment_$k/exit_status" 2>/dev/null)" != "0" ]; then
+        echo "Warning: segment $k did not finish correctly, see $OUTPUT_DIR/segment_$k/gnss-sdr.log"
+    fi
+    k=$((k + 1))
+done
+
+# Stitch the RINEX observation files: the header of the first segment, and
+# then the epochs of each segment later than those already written. Epoch
+# records of RINEX 3 have fixed width, so they can be compared as strings.
+stitch_obs() {
+    awk '
+        FNR == 1 { file++; in_header = 1 }
+        in_header {
+            if (file == 1) { print }
+            if (index($0, "END OF HEADER") > 0) { in_header = 0 }
+            next
+        }
+        /^>/ {
+            epoch = substr($0, 3, 27)
+            keep = (last == "" || epoch > last)
+            if (keep) { last = epoch }
+        }
+        keep { print }' "$@"
+}
+
+# Merge the RINEX navigation files: the header of the first segment, and then
+# each navigation record that has not been written yet.
+stitch_nav() {
+    awk '
+        function flush() {
+            if (record != "" && !(record in seen)) { seen[record] = 1; print record }
+            record = ""
+        }
+        FNR == 1 { flush(); file++; in_header = 1 }
+        in_header {
+            if (file == 1) { print }
+            if (index($0, "END OF HEADER") > 0) { in_header = 0 }
+            next
+        }
+        /^[GREJCIS][ 0-9][0-9] / { flush(); record = $0; next }
+        { record = record "\n" $0 }
+        END { flush() }' "$@"
+}
+
+for rinex in "$OUTPUT_DIR"/segment_*/"$BASE_NAME".[0-9][0-9][A-Z]; do
+    [ -f "$rinex" ] && basename "$rinex"
+done | sort -u | while read -r name; do
+    files=
+    k=0
+    while [ "$k" -lt "$SEGMENTS" ]; do
+        [ -f "$OUTPUT_DIR/segment_$k/$name" ] && files="$files $OUTPUT_DIR/segment_$k/$name"
+        k=$((k + 1))
+    done
+    case $name in
+    *O)
+        # shellcheck disable=SC2086
+        stitch_obs $files >"$OUTPUT_DIR/$name"
+        ;;
+    *)
+        # shellcheck disable=SC2086
+        stitch_nav $files >"$OUTPUT_DIR/$name"
+        ;;
+    esac
+    echo "Stitched $OUTPUT_DIR/$name"
+done
@@ -0,0 +1,138 @@
+/*!
+ * \file main.cc
+ * \brief Main file of the tracking replay program.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_map.h"
+#include "concurrent_queue.h"
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include "gps_acq_assist.h"
+#include "tracking_replay.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(record_dir, "", "Directory written by a receiver run with GNSS-SDR.tracking_replay_record_dir.");
+DEFINE_int32(channels, 0, "Number of channels to replay. 0 for one per recorded acquisition. If there are more channels than acquisitions, these are replayed again in order.");
+DEFINE_int32(threads, 0, "Number of channels replayed in parallel. 0 for one per core.");
+DEFINE_int32(duration_ms, 0, "Maximum tracking time of each channel [ms]. 0 to track until the end of the recording.");
+DEFINE_string(summary, "", "If not empty, file where the hash of the outputs of each channel is written.");
+DEFINE_string(reference, "", "If not empty, summary of a previous run that the outputs must match.");
+DEFINE_string(dump_dir, "", "If not empty, directory where the outputs of each channel are written in CSV format.");
+
+// used by the assisted acquisition blocks linked with the block factory
+Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
+Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\nReplay of the tracking stage over recorded tracking inputs and acquisitions\n") +
+        "Copyright (C) 2010-2022 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License\n \n" +
+        "Usage: \n" +
+        "   tracking-replay --config_file=<file> --record_dir=<dir> --channels=<N> --threads=<M>\n");
+
+    gflags::SetUsageMessage(intro_help);
+    google::SetVersionString(GNSS_SDR_VERSION);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    int return_code = 0;
+    try
+        {
+            const FileConfiguration configuration(FLAGS_config_file);
+            Tracking_Replay replay(configuration, FLAGS_record_dir);
+            if (replay.acquisitions().empty())
+                {
+                    std::cerr << "No acquisitions recorded in " << FLAGS_record_dir << '\n';
+                    return 1;
+                }
+            const size_t channels = FLAGS_channels > 0 ? static_cast<size_t>(FLAGS_channels) : replay.acquisitions().size();
+            const size_t threads = FLAGS_threads > 0 ? static_cast<size_t>(FLAGS_threads) : std::max(1U, std::thread::hardware_concurrency());
+
+            std::cout << "Replaying " << channels << " channels from " << replay.acquisitions().size()
+                      << " recorded acquisitions on " << threads << " threads\n";
+            const auto start = std::chrono::steady_clock::now();
+            const std::vector<Tracking_Replay_Result> results = replay.run(channels, threads, static_cast<uint32_t>(std::max(0, FLAGS_duration_ms)), FLAGS_dump_dir);
+            const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+
+            double signal_time_s = 0.0;
+            double work_time_s = 0.0;
+            std::cout << std::fixed;
+            for (size_t job = 0; job < results.size(); job++)
+                {
+                    const Tracking_Replay_Result& result = results[job];
+                    signal_time_s += result.signal_time_s;
+                    work_time_s += result.work_time_s;
+                    std::cout << "Channel " << job << ": " << std::string(result.acquisition.Signal, 2) << " PRN " << result.acquisition.PRN
+                              << ", " << std::setprecision(3) << result.signal_time_s << " s tracked, "
+                              << result.valid_items << " valid outputs, " << result.work_time_s << " s in work(), hash "
+                              << std::hex << std::setw(16) << std::setfill('0') << result.hash << std::dec << std::setfill(' ') << '\n';
+                }
+            std::cout << std::setprecision(3) << signal_time_s << " channel-seconds tracked in " << wall_time.count()
+                      << " s (" << (wall_time.count() > 0.0 ? signal_time_s / wall_time.count() : 0.0) << " times real time, "
+                      << work_time_s << " s in the tracking blocks)\n";
+
+            if (!FLAGS_summary.empty() and !save_tracking_replay_summary(FLAGS_summary, results))
+                {
+                    std::cerr << "Could not write " << FLAGS_summary << '\n';
+                    return_code = 1;
+                }
+            if (!FLAGS_reference.empty())
+                {
+                    const int differences = compare_tracking_replay_summary(FLAGS_reference, results);
+                    if (differences < 0)
+                        {
+                            std::cerr << "Could not read " << FLAGS_reference << '\n';
+                            return_code = 1;
+                        }
+                    else if (differences > 0)
+                        {
+                            std::cout << differences << " channels differ from " << FLAGS_reference << '\n';
+                            return_code = 2;
+                        }
+                    else
+                        {
+                            std::cout << "The outputs match " << FLAGS_reference << '\n';
+                        }
+                }
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Error: " << e.what() << '\n';
+            return_code = 1;
+        }
+
+    gflags::ShutDownCommandLineFlags();
+    google::ShutdownGoogleLogging();
+    return return_code;
+}
@@ -0,0 +1,306 @@
+/*!
+ * \file tracking_replay.cc
+ * \brief Replay of the tracking stage of the receiver from recorded tracking
+ * inputs and acquisitions
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_replay.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "gnss_sdr_acquisition_record.h"
+#include "gnss_sdr_block_stats.h"
+#include "tracking_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/skiphead.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/sync_block.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+
+namespace
+{
+// the factory and the code generators are not meant to be used concurrently
+std::mutex construction_mutex;
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+template <typename T>
+void hash_value(uint64_t& hash, const T& value)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (auto b : bytes)
+        {
+            hash = (hash ^ b) * FNV_PRIME;
+        }
+}
+
+
+class tracking_replay_sink;
+
+using tracking_replay_sink_sptr = gnss_shared_ptr<tracking_replay_sink>;
+
+tracking_replay_sink_sptr tracking_replay_sink_make(const std::string& dump_filename);
+
+
+/*
+ * Counts and hashes (FNV-1a) the members of Gnss_Synchro set by the
+ * tracking blocks, one by one, so that the padding of the class does not
+ * enter the hash
+ */
+class tracking_replay_sink : public gr::sync_block
+{
+public:
+    int work(int noutput_items, gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items __attribute__((unused)))
+    {
+        const auto* in = reinterpret_cast<const Gnss_Synchro*>(input_items[0]);
+        for (int n = 0; n < noutput_items; n++)
+            {
+                const Gnss_Synchro& gs = in[n];
+                hash_value(d_hash, gs.Tracking_sample_counter);
+                hash_value(d_hash, gs.fs);
+                hash_value(d_hash, gs.Prompt_I);
+                hash_value(d_hash, gs.Prompt_Q);
+                hash_value(d_hash, gs.CN0_dB_hz);
+                hash_value(d_hash, gs.Carrier_Doppler_hz);
+                hash_value(d_hash, gs.Carrier_phase_rads);
+                hash_value(d_hash, gs.Code_phase_samples);
+                hash_value(d_hash, gs.correlation_length_ms);
+                hash_value(d_hash, gs.Flag_valid_symbol_output);
+                d_valid_items += gs.Flag_valid_symbol_output ? 1 : 0;
+                d_last_sample_counter = gs.Tracking_sample_counter;
+                if (d_dump.is_open())
+                    {
+                        d_dump << gs.Tracking_sample_counter << ',' << gs.fs << ',' << gs.Prompt_I << ',' << gs.Prompt_Q << ','
+                               << gs.CN0_dB_hz << ',' << gs.Carrier_Doppler_hz << ',' << gs.Carrier_phase_rads << ','
+                               << gs.Code_phase_samples << ',' << gs.correlation_length_ms << ',' << gs.Flag_valid_symbol_output << '\n';
+                    }
+            }
+        d_items += noutput_items;
+        return noutput_items;
+    }
+
+    uint64_t d_items{0};
+    uint64_t d_valid_items{0};
+    uint64_t d_hash{FNV_OFFSET_BASIS};
+    uint64_t d_last_sample_counter{0};
+
+private:
+    friend tracking_replay_sink_sptr tracking_replay_sink_make(const std::string& dump_filename);
+
+    explicit tracking_replay_sink(const std::string& dump_filename)
+        : gr::sync_block("tracking_replay_sink",
+              gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
+              gr::io_signature::make(0, 0, 0))
+    {
+        if (!dump_filename.empty())
+            {
+                d_dump.open(dump_filename);
+                d_dump << std::setprecision(17);
+            }
+    }
+
+    std::ofstream d_dump;
+};
+
+
+tracking_replay_sink_sptr tracking_replay_sink_make(const std::string& dump_filename)
+{
+    return tracking_replay_sink_sptr(new tracking_replay_sink(dump_filename));
+}
+}  // namespace
+
+
+Tracking_Replay::Tracking_Replay(const FileConfiguration& configuration, std::string record_dir)
+    : configuration_(configuration),
+      record_dir_(std::move(record_dir))
+{
+    const std::string acquisitions_file = record_dir_ + "/acquisitions.xml";
+    if (!Gnss_Sdr_Acquisition_Record::load(acquisitions_file, acquisitions_))
+        {
+            throw std::runtime_error("Could not read the acquisitions in " + acquisitions_file);
+        }
+    const double fs_deprecated = configuration_.property("GNSS-SDR.internal_fs_hz", 0.0);
+    fs_ = static_cast<int64_t>(configuration_.property("GNSS-SDR.internal_fs_sps", fs_deprecated));
+    if (fs_ <= 0)
+        {
+            throw std::runtime_error("The configuration does not set GNSS-SDR.internal_fs_sps");
+        }
+    Gnss_Block_Stats::set_enabled(true);
+}
+
+
+std::vector<Tracking_Replay_Result> Tracking_Replay::run(size_t channels, size_t threads, uint32_t duration_ms, const std::string& dump_dir)
+{
+    std::vector<Tracking_Replay_Result> results(acquisitions_.empty() ? 0 : channels);
+    std::atomic<size_t> next_job{0};
+    auto worker = [&]() {
+        for (size_t job = next_job++; job < results.size(); job = next_job++)
+            {
+                results[job] = replay(job, acquisitions_[job % acquisitions_.size()], duration_ms, dump_dir);
+            }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t w = 1; w < std::min(std::max(threads, static_cast<size_t>(1)), results.size()); w++)
+        {
+            workers.emplace_back(worker);
+        }
+    worker();
+    for (auto& w : workers)
+        {
+            w.join();
+        }
+    return results;
+}
+
+
+Tracking_Replay_Result Tracking_Replay::replay(size_t job, const Gnss_Synchro& acquisition, uint32_t duration_ms, const std::string& dump_dir)
+{
+    Tracking_Replay_Result result;
+    result.acquisition = acquisition;
+
+    // The samples before the acquisition are skipped, so the tracking
+    // starts with a sample stamp of zero, and does not depend on the time
+    // at which the receiver started it
+    Gnss_Synchro gnss_synchro = acquisition;
+    gnss_synchro.Channel_ID = static_cast<int32_t>(job);
+    gnss_synchro.Acq_samplestamp_samples = 0ULL;
+    const std::string signal(acquisition.Signal, 2);
+    const std::string role = "Tracking_" + signal;
+    const int rf_channel = configuration_.property("Channel" + std::to_string(acquisition.Channel_ID) + ".RF_channel_ID", 0);
+    const std::string filename = record_dir_ + "/signal_conditioner_" + std::to_string(rf_channel) + ".dat";
+    const std::string dump_filename = dump_dir.empty() ? std::string() : dump_dir + "/replay_" + std::to_string(job) + ".csv";
+
+    auto top_block = gr::make_top_block("Tracking replay");
+    std::shared_ptr<TrackingInterface> tracking;
+    tracking_replay_sink_sptr sink;
+    {
+        std::lock_guard<std::mutex> lock(construction_mutex);
+        GNSSBlockFactory factory;
+        std::shared_ptr<GNSSBlockInterface> block = factory.GetBlock(&configuration_, role, 1, 1);
+        tracking = std::dynamic_pointer_cast<TrackingInterface>(block);
+        if (!tracking)
+            {
+                throw std::runtime_error("The implementation of " + role + " is not a tracking block");
+            }
+        sink = tracking_replay_sink_make(dump_filename);
+
+        auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), filename.c_str(), false);
+        auto skiphead = gr::blocks::skiphead::make(sizeof(gr_complex), acquisition.Acq_samplestamp_samples);
+        tracking->set_channel(gnss_synchro.Channel_ID);
+        tracking->set_gnss_synchro(&gnss_synchro);
+        tracking->connect(top_block);
+        top_block->connect(file_source, 0, skiphead, 0);
+        if (duration_ms > 0)
+            {
+                auto head = gr::blocks::head::make(sizeof(gr_complex), static_cast<uint64_t>(duration_ms) * fs_ / 1000);
+                top_block->connect(skiphead, 0, head, 0);
+                top_block->connect(head, 0, tracking->get_left_block(), 0);
+            }
+        else
+            {
+                top_block->connect(skiphead, 0, tracking->get_left_block(), 0);
+            }
+        top_block->connect(tracking->get_right_block(), 0, sink, 0);
+    }
+
+    tracking->start_tracking();
+    top_block->run();
+
+    const auto stats = Gnss_Block_Stats_Registry::instance().find(tracking->get_right_block()->unique_id());
+    result.work_time_s = stats ? static_cast<double>(stats->snapshot().total_ns) * 1e-9 : 0.0;
+    result.items = sink->d_items;
+    result.valid_items = sink->d_valid_items;
+    result.hash = sink->d_hash;
+    result.signal_time_s = static_cast<double>(sink->d_last_sample_counter) / static_cast<double>(fs_);
+    return result;
+}
+
+
+bool save_tracking_replay_summary(const std::string& filename, const std::vector<Tracking_Replay_Result>& results)
+{
+    std::ofstream summary(filename);
+    if (!summary.is_open())
+        {
+            return false;
+        }
+    for (size_t job = 0; job < results.size(); job++)
+        {
+            const Tracking_Replay_Result& result = results[job];
+            summary << job << ' ' << std::string(result.acquisition.Signal, 2) << ' ' << result.acquisition.PRN << ' '
+                    << result.acquisition.Acq_samplestamp_samples << ' ' << result.items << ' '
+                    << std::hex << std::setw(16) << std::setfill('0') << result.hash << std::dec << std::setfill(' ') << '\n';
+        }
+    return true;
+}
+
+
+int compare_tracking_replay_summary(const std::string& filename, const std::vector<Tracking_Replay_Result>& results)
+{
+    std::ifstream summary(filename);
+    if (!summary.is_open())
+        {
+            return -1;
+        }
+    std::map<size_t, std::tuple<uint64_t, uint64_t>> reference;  // job -> items, hash
+    std::string line;
+    while (std::getline(summary, line))
+        {
+            std::istringstream ss(line);
+            size_t job;
+            std::string signal;
+            uint32_t prn;
+            uint64_t stamp;
+            uint64_t items;
+            uint64_t hash;
+            if (ss >> job >> signal >> prn >> stamp >> items >> std::hex >> hash)
+                {
+                    reference[job] = std::make_tuple(items, hash);
+                }
+        }
+
+    int differences = 0;
+    for (size_t job = 0; job < results.size(); job++)
+        {
+            const auto it = reference.find(job);
+            if (it == reference.cend())
+                {
+                    continue;
+                }
+            if (std::get<0>(it->second) != results[job].items or std::get<1>(it->second) != results[job].hash)
+                {
+                    differences++;
+                    LOG(WARNING) << "Replay " << job << " differs from " << filename;
+                }
+        }
+    return differences;
+}
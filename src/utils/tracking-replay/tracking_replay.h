@@ -0,0 +1,98 @@
+/*!
+ * \file tracking_replay.h
+ * \brief Replay of the tracking stage of the receiver from recorded tracking
+ * inputs and acquisitions
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_REPLAY_H
+#define GNSS_SDR_TRACKING_REPLAY_H
+
+#include "file_configuration.h"
+#include "gnss_synchro.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Outcome of the replay of one tracking channel
+ */
+class Tracking_Replay_Result
+{
+public:
+    Gnss_Synchro acquisition{};
+    uint64_t items{0};        // tracking outputs
+    uint64_t valid_items{0};  // with Flag_valid_symbol_output
+    uint64_t hash{0};         // of the outputs, see Tracking_Replay
+    double work_time_s{0.0};  // time spent in the tracking block
+    double signal_time_s{0.0};
+};
+
+
+/*!
+ * \brief Runs the tracking blocks of the configuration again on the samples
+ * and acquisitions recorded by a receiver run with
+ * GNSS-SDR.tracking_replay_record_dir.
+ *
+ * Each replayed channel gets its own flowgraph: the recorded input of its
+ * signal conditioner from the sample of the acquisition onwards, the
+ * tracking block, started from the recorded acquisition before the first
+ * sample, and a sink that hashes the outputs. Since a tracking block only
+ * depends on its input samples and its acquisition, the outputs do not
+ * depend on the scheduling, and the files are read as fast as the tracking
+ * can process them. The hash covers the members of Gnss_Synchro set by the
+ * tracking, value by value, so the outputs of two builds can be compared
+ * bit by bit.
+ */
+class Tracking_Replay
+{
+public:
+    Tracking_Replay(const FileConfiguration& configuration, std::string record_dir);
+
+    const std::vector<Gnss_Synchro>& acquisitions() const { return acquisitions_; }
+
+    /*!
+     * \brief Replays channels channels, taking the recorded acquisitions in
+     * order (and again from the first one if there are less), on threads
+     * threads. If duration_ms is not zero, each channel tracks at most that
+     * long. If dump_dir is not empty, the hashed values of each channel are
+     * also written there, one line per output, to find where two runs
+     * diverge.
+     */
+    std::vector<Tracking_Replay_Result> run(size_t channels, size_t threads, uint32_t duration_ms, const std::string& dump_dir);
+
+private:
+    Tracking_Replay_Result replay(size_t job, const Gnss_Synchro& acquisition, uint32_t duration_ms, const std::string& dump_dir);
+
+    FileConfiguration configuration_;
+    std::string record_dir_;
+    std::vector<Gnss_Synchro> acquisitions_;
+    int64_t fs_;
+};
+
+
+/*!
+ * \brief Writes one line per result: job, signal, PRN, acquisition sample
+ * stamp, outputs and hash
+ */
+bool save_tracking_replay_summary(const std::string& filename, const std::vector<Tracking_Replay_Result>& results);
+
+/*!
+ * \brief Compares the results with a summary written by
+ * save_tracking_replay_summary(), and returns the number of channels that
+ * differ, or -1 if the file cannot be read
+ */
+int compare_tracking_replay_summary(const std::string& filename, const std::vector<Tracking_Replay_Result>& results);
+
+
+#endif  // GNSS_SDR_TRACKING_REPLAY_H